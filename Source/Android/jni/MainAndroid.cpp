@@ -15,6 +15,7 @@
 #include <thread>
 
 #include "ButtonManager.h"
+#include "PerformanceGovernor.h"
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonPaths.h"
@@ -802,6 +803,7 @@ JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_Run(JNIEnv*
       std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP));
       time_waited += WAIT_STEP;
     }
+    PerformanceGovernor::Start();
     while (Core::IsRunning())
     {
       guard.unlock();
@@ -811,6 +813,7 @@ JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_Run(JNIEnv*
     }
   }
 
+  PerformanceGovernor::Stop();
   Core::Shutdown();
   UICommon::Shutdown();
   guard.unlock();
@@ -0,0 +1,171 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "PerformanceGovernor.h"
+
+#include <android/log.h>
+#include <chrono>
+#include <cmath>
+#include <dlfcn.h>
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/Thread.h"
+
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Core.h"
+
+#include "VideoCommon/RenderBase.h"
+
+#define GOVERNOR_TAG "DolphinEmuGovernor"
+
+namespace PerformanceGovernor
+{
+namespace
+{
+// The thermal API is only available from Android 10 on, and the headroom forecast from Android 12
+// on, so both are looked up at runtime.
+using AcquireManagerFunc = void* (*)();
+using ReleaseManagerFunc = void (*)(void*);
+using GetCurrentThermalStatusFunc = int (*)(void*);
+using GetThermalHeadroomFunc = float (*)(void*, int);
+
+// Values of AThermalStatus.
+constexpr int THERMAL_STATUS_LIGHT = 1;
+constexpr int THERMAL_STATUS_MODERATE = 2;
+
+// The headroom may not be queried more than once per second. A headroom of 1 is where the device
+// starts to throttle heavily.
+constexpr auto POLL_INTERVAL = std::chrono::seconds(2);
+constexpr int FORECAST_SECONDS = 10;
+constexpr float HOT_HEADROOM = 0.9f;
+constexpr float COOL_HEADROOM = 0.7f;
+
+// Lowering the resolution takes a while to show up in the temperature, so the governor waits
+// between the steps, and only restores it once the device has stayed cool for a while.
+constexpr int POLLS_BETWEEN_STEPS = 5;
+constexpr int COOL_POLLS_BEFORE_RESTORE = 15;
+
+AcquireManagerFunc s_acquire_manager;
+ReleaseManagerFunc s_release_manager;
+GetCurrentThermalStatusFunc s_get_current_thermal_status;
+GetThermalHeadroomFunc s_get_thermal_headroom;
+
+std::thread s_thread;
+Common::Flag s_running;
+Common::Event s_stop_event;
+bool s_lowered_resolution = false;
+
+bool LoadThermalFunctions()
+{
+  void* library = dlopen("libandroid.so", RTLD_NOW);
+  if (!library)
+    return false;
+
+  s_acquire_manager =
+      reinterpret_cast<AcquireManagerFunc>(dlsym(library, "AThermal_acquireManager"));
+  s_release_manager =
+      reinterpret_cast<ReleaseManagerFunc>(dlsym(library, "AThermal_releaseManager"));
+  s_get_current_thermal_status = reinterpret_cast<GetCurrentThermalStatusFunc>(
+      dlsym(library, "AThermal_getCurrentThermalStatus"));
+  s_get_thermal_headroom =
+      reinterpret_cast<GetThermalHeadroomFunc>(dlsym(library, "AThermal_getThermalHeadroom"));
+  return s_acquire_manager && s_release_manager && s_get_current_thermal_status;
+}
+
+// Runs on the host thread.
+void LowerResolution()
+{
+  if (!g_renderer)
+    return;
+
+  const unsigned int scale = g_renderer->GetEFBScale();
+  if (scale <= 1)
+    return;
+
+  Config::SetCurrent(Config::GFX_EFB_SCALE, static_cast<int>(scale - 1));
+  s_lowered_resolution = true;
+  __android_log_print(ANDROID_LOG_INFO, GOVERNOR_TAG, "Lowered the EFB scale to %u", scale - 1);
+}
+
+// Runs on the host thread.
+void RestoreResolution()
+{
+  if (!s_lowered_resolution)
+    return;
+
+  const Config::ConfigLocation& location = Config::GFX_EFB_SCALE.location;
+  Config::GetLayer(Config::LayerType::CurrentRun)
+      ->DeleteKey(location.system, location.section, location.key);
+  Config::InvokeConfigChangedCallbacks();
+  s_lowered_resolution = false;
+  __android_log_print(ANDROID_LOG_INFO, GOVERNOR_TAG, "Restored the EFB scale");
+}
+
+void GovernorThread()
+{
+  Common::SetCurrentThreadName("Performance governor");
+
+  void* manager = s_acquire_manager();
+  if (!manager)
+    return;
+
+  int polls_since_step = POLLS_BETWEEN_STEPS;
+  int cool_polls = 0;
+  while (!s_stop_event.WaitFor(POLL_INTERVAL))
+  {
+    const int status = s_get_current_thermal_status(manager);
+    // The forecast is NaN until the device has collected enough samples.
+    const float headroom =
+        s_get_thermal_headroom ? s_get_thermal_headroom(manager, FORECAST_SECONDS) : NAN;
+    const bool hot = status >= THERMAL_STATUS_MODERATE || headroom >= HOT_HEADROOM;
+    const bool cool = status < THERMAL_STATUS_LIGHT && !(headroom >= COOL_HEADROOM);
+
+    polls_since_step++;
+    if (hot)
+    {
+      cool_polls = 0;
+      if (polls_since_step >= POLLS_BETWEEN_STEPS)
+      {
+        polls_since_step = 0;
+        Core::QueueHostJob(LowerResolution);
+      }
+    }
+    else if (cool && ++cool_polls == COOL_POLLS_BEFORE_RESTORE)
+    {
+      Core::QueueHostJob(RestoreResolution);
+    }
+    else if (!cool)
+    {
+      cool_polls = 0;
+    }
+  }
+
+  s_release_manager(manager);
+}
+}  // Anonymous namespace
+
+void Start()
+{
+  if (s_running.IsSet() || !LoadThermalFunctions())
+    return;
+
+  s_lowered_resolution = false;
+  s_stop_event.Reset();
+  s_running.Set();
+  s_thread = std::thread(GovernorThread);
+}
+
+void Stop()
+{
+  if (!s_running.TestAndClear())
+    return;
+
+  s_stop_event.Set();
+  s_thread.join();
+}
+}  // namespace PerformanceGovernor
@@ -0,0 +1,14 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// Watches the thermal state of the device while a game runs, and lowers the internal resolution
+// when the device is about to throttle, rather than letting the clock speeds drop under a load
+// which can't be sustained. The resolution is restored once the device has cooled down.
+namespace PerformanceGovernor
+{
+void Start();
+void Stop();
+}
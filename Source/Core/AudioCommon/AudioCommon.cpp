@@ -16,6 +16,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
+#include "Core/RunAhead.h"
 
 // This shouldn't be a global, at least not here.
 std::unique_ptr<SoundStream> g_sound_stream;
@@ -177,7 +178,8 @@ void SendAIBuffer(const short* samples, unsigned int num_samples)
 
   Mixer* pMixer = g_sound_stream->GetMixer();
 
-  if (pMixer && samples)
+  // The samples of fields that are run ahead are played when the fields are emulated for real.
+  if (pMixer && samples && !RunAhead::IsRunningAhead())
   {
     pMixer->PushSamples(samples, num_samples);
   }
@@ -10,9 +10,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
-#include <cstring>
 #include <functional>
-#include <numeric>
 #include <vector>
 
 #include "AudioCommon/DPL2Decoder.h"
@@ -34,41 +32,27 @@ static float l_fwr, r_fwr, lpr_fwr, lmr_fwr;
 static std::vector<float> fwrbuf_l, fwrbuf_r;
 static float adapt_l_gain, adapt_r_gain, adapt_lpr_gain, adapt_lmr_gain;
 static std::vector<float> lf, rf, lr, rr, cf, cr;
-static float LFE_buf[256];
-static unsigned int lfe_pos;
+// The input of the LFE low-pass filter: the last len125 - 1 samples of the previous block,
+// followed by the samples of the current block.
+static std::vector<float> lfe_history;
 static std::vector<float> filter_coefs_lfe;
 static unsigned int len125;
 
-template <class T>
-static float DotProduct(int count, const T* buf, const std::vector<float>& coeffs, int offset)
+// Four independent sums let the compiler keep several multiply-adds in flight, or vectorize them.
+static float DotProduct(const float* buf, const float* coeffs, unsigned int count)
 {
-  return std::inner_product(buf, buf + count, coeffs.begin() + offset, T(0));
-}
-
-template <class T>
-static T FIRFilter(const T* buf, int pos, int len, int count, const std::vector<float>& coeffs)
-{
-  int count1, count2;
-
-  if (pos >= count)
+  float sums[4] = {};
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
   {
-    pos -= count;
-    count1 = count;
-    count2 = 0;
+    sums[0] += buf[i + 0] * coeffs[i + 0];
+    sums[1] += buf[i + 1] * coeffs[i + 1];
+    sums[2] += buf[i + 2] * coeffs[i + 2];
+    sums[3] += buf[i + 3] * coeffs[i + 3];
   }
-  else
-  {
-    count2 = pos;
-    count1 = count - pos;
-    pos = len - count1;
-  }
-
-  // high part of window
-  const T* ptr = &buf[pos];
-
-  float r1 = DotProduct(count1, ptr, coeffs, 0);
-  float r2 = DotProduct(count2, buf, coeffs, count1);
-  return T(r1 + r2);
+  for (; i < count; ++i)
+    sums[0] += buf[i] * coeffs[i];
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
 }
 
 /*
@@ -167,8 +151,7 @@ static void OnSeek()
   std::fill(rr.begin(), rr.end(), 0.0f);
   std::fill(cf.begin(), cf.end(), 0.0f);
   std::fill(cr.begin(), cr.end(), 0.0f);
-  lfe_pos = 0;
-  memset(LFE_buf, 0, sizeof(LFE_buf));
+  std::fill(lfe_history.begin(), lfe_history.end(), 0.0f);
 }
 
 static void Done()
@@ -176,6 +159,7 @@ static void Done()
   OnSeek();
 
   filter_coefs_lfe.clear();
+  lfe_history.clear();
 }
 
 static std::vector<float> CalculateCoefficients125HzLowpass(int rate)
@@ -188,6 +172,10 @@ static std::vector<float> CalculateCoefficients125HzLowpass(int rate)
   {
     coeffs[i] *= M3_01DB;
   }
+  // The decoder this comes from applied the first tap to the newest sample and the others to the
+  // older samples, oldest first. Rotating the taps keeps that while letting the filter run over
+  // the history from oldest to newest.
+  std::rotate(coeffs.begin(), coeffs.begin() + 1, coeffs.end());
   return coeffs;
 }
 
@@ -291,6 +279,9 @@ void DPL2Decode(float* samples, int numsamples, float* out)
 
   int cur = 0;
 
+  if (numsamples <= 0)
+    return;
+
   if (olddelay != cfg_delay || oldfreq != fmt_freq)
   {
     Done();
@@ -307,10 +298,12 @@ void DPL2Decode(float* samples, int numsamples, float* out)
     cf.resize(dlbuflen);
     cr.resize(dlbuflen);
     filter_coefs_lfe = CalculateCoefficients125HzLowpass(fmt_freq);
-    lfe_pos = 0;
-    memset(LFE_buf, 0, sizeof(LFE_buf));
+    lfe_history.assign(len125 - 1, 0.0f);
   }
 
+  lfe_history.resize(len125 - 1 + numsamples);
+  float* lfe_in = &lfe_history[len125 - 1];
+
   float* in = samples;                           // Input audio data
   float* end = in + numsamples * fmt_nchannels;  // Loop end
 
@@ -336,13 +329,7 @@ void DPL2Decode(float* samples, int numsamples, float* out)
     out[cur + 0] = lf[k];
     out[cur + 1] = rf[k];
     out[cur + 2] = cf[k];
-    LFE_buf[lfe_pos] = (lf[k] + rf[k] + 2.0f * cf[k] + lr[k] + rr[k]) / 2.0f;
-    out[cur + 3] = FIRFilter(LFE_buf, lfe_pos, len125, len125, filter_coefs_lfe);
-    lfe_pos++;
-    if (lfe_pos == len125)
-    {
-      lfe_pos = 0;
-    }
+    *lfe_in++ = (lf[k] + rf[k] + 2.0f * cf[k] + lr[k] + rr[k]) / 2.0f;
     out[cur + 4] = lr[k];
     out[cur + 5] = rr[k];
     // Next sample...
@@ -354,6 +341,12 @@ void DPL2Decode(float* samples, int numsamples, float* out)
       cyc_pos += dlbuflen;
     }
   }
+
+  // The matrix decoder depends on the previous sample, but the LFE filter doesn't, so it runs
+  // over the whole block at once.
+  for (int i = 0; i < numsamples; ++i)
+    out[i * 6 + 3] = DotProduct(&lfe_history[i], filter_coefs_lfe.data(), len125);
+  std::copy(lfe_history.end() - (len125 - 1), lfe_history.end(), lfe_history.begin());
 }
 
 void DPL2Reset()
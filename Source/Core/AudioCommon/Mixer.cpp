@@ -38,8 +38,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // so we will just ignore new written data while interpolating.
   // Without this cache, the compiler wouldn't be allowed to optimize the
   // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  u32 indexW = m_indexW.load(std::memory_order_acquire);
 
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
@@ -51,15 +51,14 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   {
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
-    u32 low_waterwark = m_input_sample_rate * SConfig::GetInstance().iTimingVariance / 1000;
-    low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
+    const u32 low_waterwark = TargetSamples();
 
     m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
     float offset = (m_numLeftI - low_waterwark) * CONTROL_FACTOR;
-    if (offset > MAX_FREQ_SHIFT)
-      offset = MAX_FREQ_SHIFT;
-    if (offset < -MAX_FREQ_SHIFT)
-      offset = -MAX_FREQ_SHIFT;
+    const float max_shift = SConfig::GetInstance().m_audio_pacing ?
+                                aid_sample_rate * MAX_PACING_FREQ_SHIFT :
+                                static_cast<float>(MAX_FREQ_SHIFT);
+    offset = MathUtil::Clamp(offset, -max_shift, max_shift);
 
     aid_sample_rate = (aid_sample_rate + offset) * emulationspeed;
   }
@@ -112,7 +111,7 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   }
 
   // Flush cached variable
-  m_indexR.store(indexR);
+  m_indexR.store(indexR, std::memory_order_release);
 
   return actual_sample_count;
 }
@@ -123,6 +122,7 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
     return 0;
 
   memset(samples, 0, num_samples * 2 * sizeof(short));
+  m_last_request_size.store(num_samples, std::memory_order_relaxed);
 
   if (SConfig::GetInstance().m_audio_stretch)
   {
@@ -145,7 +145,11 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true);
+    // Only the start of a gap is counted, so that a paused emulation counts as one underrun.
+    const bool starved = m_dma_mixer.Mix(samples, num_samples, true) < num_samples;
+    if (starved && !m_starved)
+      m_underruns.fetch_add(1, std::memory_order_relaxed);
+    m_starved = starved;
     m_streaming_mixer.Mix(samples, num_samples, true);
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true);
     m_is_stretching = false;
@@ -154,6 +158,23 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   return num_samples;
 }
 
+Mixer::Statistics Mixer::GetStatistics() const
+{
+  const unsigned int buffered = m_dma_mixer.BufferedSamples();
+  Statistics stats;
+  stats.fill_level = static_cast<float>(buffered) / MAX_SAMPLES;
+  stats.latency_ms = 1000.0f * buffered / m_dma_mixer.GetInputSampleRate() +
+                     1000.0f * m_last_request_size.load(std::memory_order_relaxed) / m_sampleRate;
+  stats.underruns = m_underruns.load(std::memory_order_relaxed);
+  return stats;
+}
+
+float Mixer::GetDMABufferFill() const
+{
+  const unsigned int target = std::max(m_dma_mixer.TargetSamples(), 1u);
+  return static_cast<float>(m_dma_mixer.BufferedSamples()) / target;
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
@@ -180,11 +201,12 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
   // Cache access in non-volatile variable
   // indexR isn't allowed to cache in the audio throttling loop as it
   // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  if (num_samples * 2 + ((indexW - m_indexR.load(std::memory_order_acquire)) & INDEX_MASK) >=
+      MAX_SAMPLES * 2)
     return;
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
@@ -201,7 +223,7 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
     memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
   }
 
-  m_indexW.fetch_add(num_samples * 2);
+  m_indexW.store(indexW + num_samples * 2, std::memory_order_release);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
@@ -349,9 +371,20 @@ void Mixer::MixerFifo::SetVolume(unsigned int lvolume, unsigned int rvolume)
   m_RVolume.store(rvolume + (rvolume >> 7));
 }
 
+unsigned int Mixer::MixerFifo::BufferedSamples() const
+{
+  return ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
+}
+
+unsigned int Mixer::MixerFifo::TargetSamples() const
+{
+  const u32 target = m_input_sample_rate * SConfig::GetInstance().iTimingVariance / 1000;
+  return std::min(target, MAX_SAMPLES / 2);
+}
+
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
-  unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
+  unsigned int samples_in_fifo = BufferedSamples();
   if (samples_in_fifo <= 1)
     return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
   return (samples_in_fifo - 1) * m_mixer->m_sampleRate / m_input_sample_rate;
@@ -14,6 +14,16 @@
 class Mixer final
 {
 public:
+  struct Statistics
+  {
+    // How full the FIFO of the DSP's DMA audio is, from 0 to 1.
+    float fill_level;
+    // How long a sample from the DMA takes to reach the backend, including the backend's buffer.
+    float latency_ms;
+    // How many times the backend asked for more samples than the DMA FIFO had.
+    u32 underruns;
+  };
+
   explicit Mixer(unsigned int BackendSampleRate);
   ~Mixer();
 
@@ -40,12 +50,20 @@ public:
 
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
+  Statistics GetStatistics() const;
+  // How much DMA audio is waiting to be mixed, relative to the amount that the resampler aims to
+  // keep buffered. Called from the CPU thread to let the audio backend pace the emulation.
+  float GetDMABufferFill() const;
+
 private:
   static constexpr u32 MAX_SAMPLES = 1024 * 4;  // 128 ms
   static constexpr u32 INDEX_MASK = MAX_SAMPLES * 2 - 1;
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
+  // When the audio backend paces the emulation, the FIFO stays close to its target fill level, so
+  // the resampler only has to absorb the drift between the emulated and the host audio clock.
+  static constexpr float MAX_PACING_FREQ_SHIFT = 0.005f;  // Relative to the input sample rate
 
   class MixerFifo final
   {
@@ -59,13 +77,18 @@ private:
     unsigned int GetInputSampleRate() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     unsigned int AvailableSamples() const;
+    unsigned int BufferedSamples() const;
+    unsigned int TargetSamples() const;
 
   private:
     Mixer* m_mixer;
     unsigned m_input_sample_rate;
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
-    std::atomic<u32> m_indexW{0};
-    std::atomic<u32> m_indexR{0};
+    // The emulation thread only writes m_indexW and the audio thread only writes m_indexR. They
+    // are kept on separate cache lines so that the two threads don't keep taking the line away
+    // from each other.
+    alignas(64) std::atomic<u32> m_indexW{0};
+    alignas(64) std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
@@ -91,4 +114,8 @@ private:
 
   // Current rate of emulation (1.0 = 100% speed)
   std::atomic<float> m_speed{0.0f};
+
+  std::atomic<u32> m_last_request_size{0};
+  std::atomic<u32> m_underruns{0};
+  bool m_starved = false;
 };
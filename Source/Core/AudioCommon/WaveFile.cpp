@@ -4,7 +4,9 @@
 
 #include "AudioCommon/WaveFile.h"
 
+#include <sstream>
 #include <string>
+#include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
@@ -12,6 +14,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/ConfigManager.h"
 
 constexpr size_t WaveFileWriter::BUFFER_SIZE;
@@ -26,6 +29,19 @@ WaveFileWriter::~WaveFileWriter()
 }
 
 bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRate)
+{
+  if (!OpenFile(filename, HLESampleRate))
+    return false;
+
+  pending.clear();
+  pending.reserve(BUFFER_SIZE);
+  pending_sample_rate = HLESampleRate;
+  writer_exit.Clear();
+  writer_thread = std::thread(&WaveFileWriter::WriterThread, this);
+  return true;
+}
+
+bool WaveFileWriter::OpenFile(const std::string& filename, unsigned int HLESampleRate)
 {
   // Ask to delete file
   if (File::Exists(filename))
@@ -94,6 +110,22 @@ bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRa
 
 void WaveFileWriter::Stop()
 {
+  if (writer_thread.joinable())
+  {
+    FlushPending();
+    writer_exit.Set();
+    chunk_event.Set();
+    writer_thread.join();
+  }
+
+  CloseFile();
+}
+
+void WaveFileWriter::CloseFile()
+{
+  if (!file)
+    return;
+
   // u32 file_size = (u32)ftello(file);
   file.Seek(4, SEEK_SET);
   Write(audio_size + 36);
@@ -116,11 +148,11 @@ void WaveFileWriter::Write4(const char* ptr)
 
 void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count, int sample_rate)
 {
-  if (!file)
+  if (!writer_thread.joinable())
+  {
     PanicAlertT("WaveFileWriter - file not open.");
-
-  if (count > BUFFER_SIZE * 2)
-    PanicAlert("WaveFileWriter - buffer too small (count = %u).", count);
+    return;
+  }
 
   if (skip_silence)
   {
@@ -136,23 +168,67 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count, int
       return;
   }
 
+  // Samples at a different rate go to a new file, so they can't share a chunk with the others.
+  if (sample_rate != pending_sample_rate)
+  {
+    FlushPending();
+    pending_sample_rate = sample_rate;
+  }
+
   for (u32 i = 0; i < count; i++)
   {
     // Flip the audio channels from RL to LR
-    conv_buffer[2 * i] = Common::swap16((u16)sample_data[2 * i + 1]);
-    conv_buffer[2 * i + 1] = Common::swap16((u16)sample_data[2 * i]);
+    pending.push_back(Common::swap16((u16)sample_data[2 * i + 1]));
+    pending.push_back(Common::swap16((u16)sample_data[2 * i]));
+  }
+
+  if (pending.size() >= BUFFER_SIZE)
+    FlushPending();
+}
+
+void WaveFileWriter::FlushPending()
+{
+  if (pending.empty())
+    return;
+
+  chunks.Push(Chunk{pending_sample_rate, std::move(pending)});
+  chunk_event.Set();
+  pending = std::vector<short>();
+  pending.reserve(BUFFER_SIZE);
+}
+
+void WaveFileWriter::WriterThread()
+{
+  Common::SetCurrentThreadName("Audio Dump Writer");
+
+  Chunk chunk;
+  while (!writer_exit.IsSet())
+  {
+    chunk_event.Wait();
+    while (chunks.Pop(chunk))
+      WriteChunk(chunk);
   }
 
-  if (sample_rate != current_sample_rate)
+  // Stop() flushes the last chunk before it asks this thread to exit.
+  while (chunks.Pop(chunk))
+    WriteChunk(chunk);
+}
+
+void WaveFileWriter::WriteChunk(const Chunk& chunk)
+{
+  if (chunk.sample_rate != current_sample_rate)
   {
-    Stop();
+    CloseFile();
     file_index++;
     std::stringstream filename;
     filename << File::GetUserPath(D_DUMPAUDIO_IDX) << basename << file_index << ".wav";
-    Start(filename.str(), sample_rate);
-    current_sample_rate = sample_rate;
+    OpenFile(filename.str(), chunk.sample_rate);
+    current_sample_rate = chunk.sample_rate;
   }
 
-  file.WriteBytes(conv_buffer.data(), count * 4);
-  audio_size += count * 4;
+  if (!file)
+    return;
+
+  file.WriteBytes(chunk.samples.data(), chunk.samples.size() * sizeof(short));
+  audio_size += static_cast<u32>(chunk.samples.size() * sizeof(short));
 }
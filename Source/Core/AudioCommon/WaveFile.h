@@ -10,15 +10,21 @@
 // The float variant will convert from -1.0-1.0 range and clamp.
 // Alternatively, AddSamplesBE for big endian wave data.
 // If Stop is not called when it destructs, the destructor will call Stop().
+// The samples are converted and batched on the calling thread, and written to disk by a
+// background thread, so that a slow disk doesn't hold up the emulation while dumping.
 // ---------------------------------------------------------------------------------
 
 #pragma once
 
-#include <array>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/FifoQueue.h"
 #include "Common/File.h"
+#include "Common/Flag.h"
 #include "Common/NonCopyable.h"
 
 class WaveFileWriter : NonCopyable
@@ -34,15 +40,36 @@ public:
   void AddStereoSamplesBE(const short* sample_data, u32 count, int sample_rate);  // big endian
   u32 GetAudioSize() const { return audio_size; }
 private:
+  // The number of shorts that are batched before they are handed to the writer thread.
   static constexpr size_t BUFFER_SIZE = 32 * 1024;
 
+  struct Chunk
+  {
+    int sample_rate;
+    std::vector<short> samples;
+  };
+
+  bool OpenFile(const std::string& filename, unsigned int sample_rate);
+  void CloseFile();
+  void FlushPending();
+  void WriterThread();
+  void WriteChunk(const Chunk& chunk);
+
   File::IOFile file;
   bool skip_silence = false;
   u32 audio_size = 0;
-  std::array<short, BUFFER_SIZE> conv_buffer{};
   void Write(u32 value);
   void Write4(const char* ptr);
   std::string basename;
   int current_sample_rate;
   int file_index = 0;
+
+  // Owned by the calling thread.
+  std::vector<short> pending;
+  int pending_sample_rate = 0;
+
+  Common::FifoQueue<Chunk, false> chunks;
+  Common::Event chunk_event;
+  Common::Flag writer_exit;
+  std::thread writer_thread;
 };
@@ -2,12 +2,17 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <string>
 
 #include "Common/Analytics.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 
@@ -59,6 +64,32 @@ void AppendType(std::string* out, TypeId type)
 {
   out->push_back(static_cast<u8>(type));
 }
+
+// Reports which are sent within this time of each other go out back to back, so that they share
+// one connection rather than each opening one after it was closed for being idle.
+constexpr std::chrono::seconds BATCH_DELAY{2};
+// When the backend fails, the next attempt waits this long, doubling up to the maximum.
+constexpr std::chrono::minutes MIN_RETRY_DELAY{1};
+constexpr std::chrono::minutes MAX_RETRY_DELAY{60};
+// The oldest reports are dropped when the offline queue grows beyond this.
+constexpr size_t OFFLINE_QUEUE_SIZE_LIMIT = 100;
+constexpr char OFFLINE_REPORT_EXTENSION[] = ".bin";
+
+// Returns the file names of the reports in the offline queue, oldest first.
+std::vector<std::string> GetOfflineReportNames(const std::string& directory)
+{
+  std::vector<std::string> names;
+  if (directory.empty() || !File::IsDirectory(directory))
+    return names;
+
+  for (const File::FSTEntry& entry : File::ScanDirectoryTree(directory, false).children)
+  {
+    if (!entry.isDirectory && StringEndsWith(entry.virtualName, OFFLINE_REPORT_EXTENSION))
+      names.push_back(entry.virtualName);
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
 }  // namespace
 
 AnalyticsReportBuilder::AnalyticsReportBuilder()
@@ -138,45 +169,138 @@ void AnalyticsReporter::Send(AnalyticsReportBuilder&& report)
 #endif
 }
 
+void AnalyticsReporter::SetOfflineQueueDirectory(const std::string& directory)
+{
+  {
+    std::lock_guard<std::mutex> lk(m_offline_queue_lock);
+    m_offline_queue_directory = directory;
+
+    // Report files are numbered, so that they are sent in the order they were stored in.
+    const std::vector<std::string> names = GetOfflineReportNames(directory);
+    m_next_offline_report_id =
+        names.empty() ? 0 : std::strtoull(names.back().c_str(), nullptr, 16) + 1;
+  }
+
+  m_reporter_event.Set();  // In case reports are left over from an earlier session.
+}
+
+void AnalyticsReporter::StoreOfflineReport(const std::string& report)
+{
+  std::lock_guard<std::mutex> lk(m_offline_queue_lock);
+  if (m_offline_queue_directory.empty() || !File::CreateFullPath(m_offline_queue_directory))
+    return;
+
+  const std::string name =
+      StringFromFormat("%016" PRIx64 "%s", m_next_offline_report_id++, OFFLINE_REPORT_EXTENSION);
+  File::WriteStringToFile(report, m_offline_queue_directory + name);
+
+  const std::vector<std::string> names = GetOfflineReportNames(m_offline_queue_directory);
+  for (size_t i = OFFLINE_QUEUE_SIZE_LIMIT; i < names.size(); ++i)
+    File::Delete(m_offline_queue_directory + names[i - OFFLINE_QUEUE_SIZE_LIMIT]);
+}
+
+std::vector<std::string> AnalyticsReporter::GetOfflineReportPaths()
+{
+  std::lock_guard<std::mutex> lk(m_offline_queue_lock);
+  std::vector<std::string> paths = GetOfflineReportNames(m_offline_queue_directory);
+  for (std::string& path : paths)
+    path = m_offline_queue_directory + path;
+  return paths;
+}
+
+void AnalyticsReporter::StoreQueuedReports()
+{
+  std::string report;
+  while (m_reports_queue.Pop(report))
+    StoreOfflineReport(report);
+}
+
+bool AnalyticsReporter::SendOfflineReports(AnalyticsReportingBackend* backend)
+{
+  for (const std::string& path : GetOfflineReportPaths())
+  {
+    if (m_reporter_stop_request.IsSet())
+      return true;
+
+    std::string report;
+    if (File::ReadFileToString(path, report) && !backend->Send(std::move(report)))
+      return false;
+    File::Delete(path);
+  }
+  return true;
+}
+
+bool AnalyticsReporter::SendQueuedReports(AnalyticsReportingBackend* backend)
+{
+  std::string report;
+  while (!m_reporter_stop_request.IsSet() && m_reports_queue.Pop(report))
+  {
+    if (!backend->Send(report))
+    {
+      // The reports behind it would most likely fail as well.
+      StoreOfflineReport(report);
+      StoreQueuedReports();
+      return false;
+    }
+  }
+  return true;
+}
+
 void AnalyticsReporter::ThreadProc()
 {
   Common::SetCurrentThreadName("Analytics");
+
+  std::chrono::milliseconds retry_delay = MIN_RETRY_DELAY;
+  bool retry_pending = false;
   while (true)
   {
-    m_reporter_event.Wait();
+    if (retry_pending)
+      m_reporter_event.WaitFor(retry_delay);
+    else
+      m_reporter_event.Wait();
+
+    const auto batch_end = std::chrono::steady_clock::now() + BATCH_DELAY;
+    while (!m_reporter_stop_request.IsSet() &&
+           m_reporter_event.WaitFor(batch_end - std::chrono::steady_clock::now()))
+    {
+    }
+
+    std::shared_ptr<AnalyticsReportingBackend> backend(m_backend);
     if (m_reporter_stop_request.IsSet())
     {
+      // Keep what hasn't been sent yet for the next session, but only with the user's consent,
+      // which is what a backend stands for.
+      if (backend)
+        StoreQueuedReports();
       return;
     }
 
-    while (!m_reports_queue.Empty())
+    if (!backend)
     {
-      std::shared_ptr<AnalyticsReportingBackend> backend(m_backend);
+      retry_pending = false;
+      continue;
+    }
 
-      if (backend)
-      {
-        std::string report;
-        m_reports_queue.Pop(report);
-        backend->Send(std::move(report));
-      }
-      else
-      {
-        break;
-      }
-
-      // Recheck after each report sent.
-      if (m_reporter_stop_request.IsSet())
-      {
-        return;
-      }
+    // Reports from the offline queue go first, since they are older.
+    if (SendOfflineReports(backend.get()) && SendQueuedReports(backend.get()))
+    {
+      retry_pending = false;
+      retry_delay = MIN_RETRY_DELAY;
+    }
+    else
+    {
+      if (retry_pending)
+        retry_delay = std::min<std::chrono::milliseconds>(retry_delay * 2, MAX_RETRY_DELAY);
+      retry_pending = true;
     }
   }
 }
 
-void StdoutAnalyticsBackend::Send(std::string report)
+bool StdoutAnalyticsBackend::Send(std::string report)
 {
   printf("Analytics report sent:\n%s",
          HexDump(reinterpret_cast<const u8*>(report.data()), report.size()).c_str());
+  return true;
 }
 
 HttpAnalyticsBackend::HttpAnalyticsBackend(const std::string& endpoint) : m_endpoint(endpoint)
@@ -185,10 +309,9 @@ HttpAnalyticsBackend::HttpAnalyticsBackend(const std::string& endpoint) : m_endp
 
 HttpAnalyticsBackend::~HttpAnalyticsBackend() = default;
 
-void HttpAnalyticsBackend::Send(std::string report)
+bool HttpAnalyticsBackend::Send(std::string report)
 {
-  if (m_http.IsValid())
-    m_http.Post(m_endpoint, report);
+  return m_http.IsValid() && m_http.Post(m_endpoint, report).has_value();
 }
 
 }  // namespace Common
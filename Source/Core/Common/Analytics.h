@@ -47,8 +47,9 @@ class AnalyticsReportingBackend
 {
 public:
   virtual ~AnalyticsReportingBackend() {}
-  // Called from the AnalyticsReporter backend thread.
-  virtual void Send(std::string report) = 0;
+  // Called from the AnalyticsReporter backend thread. Returns false if the report could not be
+  // delivered, in which case it is kept and sent again later.
+  virtual bool Send(std::string report) = 0;
 };
 
 // Builder object for an analytics report.
@@ -148,8 +149,21 @@ public:
 
   // For convenience.
   void Send(AnalyticsReportBuilder& report) { Send(std::move(report)); }
+
+  // Sets a directory where reports are stored while they can't be delivered, e.g. because the
+  // host is offline, and at shutdown. They are sent from there once the backend works again.
+  // Without one, such reports are dropped.
+  void SetOfflineQueueDirectory(const std::string& directory);
+
 protected:
   void ThreadProc();
+  // Each of these returns false if the backend failed, with the reports which are left stored
+  // in the offline queue.
+  bool SendOfflineReports(AnalyticsReportingBackend* backend);
+  bool SendQueuedReports(AnalyticsReportingBackend* backend);
+  void StoreQueuedReports();
+  void StoreOfflineReport(const std::string& report);
+  std::vector<std::string> GetOfflineReportPaths();
 
   std::shared_ptr<AnalyticsReportingBackend> m_backend;
   AnalyticsReportBuilder m_base_builder;
@@ -158,6 +172,10 @@ protected:
   Common::Event m_reporter_event;
   Common::Flag m_reporter_stop_request;
   FifoQueue<std::string> m_reports_queue;
+
+  std::mutex m_offline_queue_lock;
+  std::string m_offline_queue_directory;
+  u64 m_next_offline_report_id = 0;
 };
 
 // Analytics backend to be used for debugging purpose, which dumps reports to
@@ -165,7 +183,7 @@ protected:
 class StdoutAnalyticsBackend : public AnalyticsReportingBackend
 {
 public:
-  void Send(std::string report) override;
+  bool Send(std::string report) override;
 };
 
 // Analytics backend that POSTs data to a remote HTTP(s) endpoint. WARNING:
@@ -176,10 +194,11 @@ public:
   HttpAnalyticsBackend(const std::string& endpoint);
   ~HttpAnalyticsBackend() override;
 
-  void Send(std::string report) override;
+  bool Send(std::string report) override;
 
 protected:
   std::string m_endpoint;
+  // Kept for the lifetime of the backend, so that its connection is reused for every report.
   HttpRequest m_http{std::chrono::seconds{5}};
 };
 
@@ -45,6 +45,9 @@ struct CPUInfo
   bool bFMA = false;
   bool bFMA4 = false;
   bool bAES = false;
+  // SHA-NI on x86, the SHA1 and SHA2 instructions of the crypto extensions on ARMv8
+  bool bSHA1 = false;
+  bool bSHA2 = false;
   // FXSAVE/FXRSTOR
   bool bFXSR = false;
   bool bMOVBE = false;
@@ -59,8 +62,6 @@ struct CPUInfo
   bool bFP = false;
   bool bASIMD = false;
   bool bCRC32 = false;
-  bool bSHA1 = false;
-  bool bSHA2 = false;
 
   // Call Detect()
   explicit CPUInfo();
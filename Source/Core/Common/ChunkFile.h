@@ -52,6 +52,17 @@
 #error No version of is_trivially_copyable
 #endif
 
+// Containers of these types are serialized with a single copy of all of their elements, instead of
+// element by element. This doesn't change the layout of the savestate, since that is how
+// PointerWrap::Do serializes each of the elements anyway. bool is the exception, as it is always
+// serialized as a u8.
+template <typename T>
+struct IsBulkCopyable
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                       !std::is_same<typename std::remove_cv<T>::type, bool>::value>
+{
+};
+
 // Wrapper class
 class PointerWrap
 {
@@ -64,6 +75,14 @@ public:
     MODE_VERIFY,    // compare
   };
 
+  // A copy into the savestate which DoBulkArray left for the caller to do.
+  struct DeferredCopy
+  {
+    u8* dest;
+    const u8* src;
+    size_t size;
+  };
+
   u8** ptr;
   Mode mode;
 
@@ -71,6 +90,16 @@ public:
   PointerWrap(u8** ptr_, Mode mode_) : ptr(ptr_), mode(mode_) {}
   void SetMode(Mode mode_) { mode = mode_; }
   Mode GetMode() const { return mode; }
+  // While saving, DoBulkArray adds its copies to this list instead of doing them.
+  void SetDeferredCopies(std::vector<DeferredCopy>* copies) { deferred_copies = copies; }
+  // Lets saving go straight into a buffer whose size is only a guess. When the savestate would
+  // go past the end, the rest of it is measured instead, and WriteOverflowed() returns true.
+  void SetWriteEnd(u8* end)
+  {
+    write_end = end;
+    write_overflowed = false;
+  }
+  bool WriteOverflowed() const { return write_overflowed; }
   template <typename K, class V>
   void Do(std::map<K, V>& x)
   {
@@ -179,6 +208,26 @@ public:
     DoArray(arr, static_cast<u32>(N));
   }
 
+  // For large arrays which stay unchanged until the savestate is complete, like emulated memory.
+  // Lets the copies of those, which make up most of a savestate, be done in parallel.
+  template <typename T>
+  void DoBulkArray(T* x, u32 count)
+  {
+    static_assert(IsTriviallyCopyable(T), "Only sane for trivially copyable types");
+    const u32 size = count * sizeof(T);
+    if (mode == MODE_WRITE)
+      CheckWriteEnd(size);
+    if (mode == MODE_WRITE && deferred_copies)
+    {
+      deferred_copies->push_back({*ptr, reinterpret_cast<const u8*>(x), size});
+      *ptr += size;
+    }
+    else
+    {
+      DoVoid(x, size);
+    }
+  }
+
   void Do(Common::Flag& flag)
   {
     bool s = flag.IsSet();
@@ -271,6 +320,43 @@ private:
     DoEachElement(x, [](PointerWrap& p, typename T::value_type& elem) { p.Do(elem); });
   }
 
+  template <typename T>
+  void DoContainer(std::vector<T>& x)
+  {
+    DoContiguousContainer(x, IsBulkCopyable<T>());
+  }
+
+  template <typename T>
+  void DoContainer(std::basic_string<T>& x)
+  {
+    DoContiguousContainer(x, IsBulkCopyable<T>());
+  }
+
+  template <typename T>
+  void DoContiguousContainer(T& x, std::false_type)
+  {
+    DoEachElement(x, [](PointerWrap& p, typename T::value_type& elem) { p.Do(elem); });
+  }
+
+  template <typename T>
+  void DoContiguousContainer(T& x, std::true_type)
+  {
+    u32 size = static_cast<u32>(x.size());
+    Do(size);
+    x.resize(size);
+    if (size)
+      DoVoid(&x[0], size * sizeof(typename T::value_type));
+  }
+
+  void CheckWriteEnd(u32 size)
+  {
+    if (write_end && static_cast<size_t>(write_end - *ptr) < size)
+    {
+      mode = MODE_MEASURE;
+      write_overflowed = true;
+    }
+  }
+
   __forceinline void DoVoid(void* data, u32 size)
   {
     switch (mode)
@@ -280,7 +366,9 @@ private:
       break;
 
     case MODE_WRITE:
-      memcpy(*ptr, data, size);
+      CheckWriteEnd(size);
+      if (mode == MODE_WRITE)
+        memcpy(*ptr, data, size);
       break;
 
     case MODE_MEASURE:
@@ -295,4 +383,9 @@ private:
 
     *ptr += size;
   }
+
+private:
+  std::vector<DeferredCopy>* deferred_copies = nullptr;
+  u8* write_end = nullptr;
+  bool write_overflowed = false;
 };
@@ -55,6 +55,7 @@
 #define MAPS_DIR "Maps"
 #define CACHE_DIR "Cache"
 #define SHADERCACHE_DIR "Shaders"
+#define JITCACHE_DIR "JIT"
 #define STATESAVES_DIR "StateSaves"
 #define SCREENSHOTS_DIR "ScreenShots"
 #define LOAD_DIR "Load"
@@ -97,6 +98,8 @@
 
 // Files in the directory returned by GetUserPath(D_LOGS_IDX)
 #define MAIN_LOG "dolphin.log"
+#define TRACE_LOG "dolphin.trace"
+#define NULL_VIDEO_PROFILE "NullVideoProfile.txt"
 
 // Files in the directory returned by GetUserPath(D_WIISYSCONF_IDX)
 #define WII_SYSCONF "SYSCONF"
@@ -109,6 +112,7 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define MEMORYWATCHER_VALUES "Values.bin"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
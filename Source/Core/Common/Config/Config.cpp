@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
 #include <list>
 #include <map>
 #include <tuple>
@@ -14,6 +16,7 @@ namespace Config
 {
 static Layers s_layers;
 static std::list<ConfigChangedCallback> s_callbacks;
+static std::atomic<u32> s_config_version{1};
 
 void InvokeConfigChangedCallbacks();
 
@@ -30,6 +33,7 @@ Layers* GetLayers()
 void AddLayer(std::unique_ptr<Layer> layer)
 {
   s_layers[layer->GetLayer()] = std::move(layer);
+  IncrementConfigVersion();
   InvokeConfigChangedCallbacks();
 }
 
@@ -48,6 +52,7 @@ Layer* GetLayer(LayerType layer)
 void RemoveLayer(LayerType layer)
 {
   s_layers.erase(layer);
+  IncrementConfigVersion();
   InvokeConfigChangedCallbacks();
 }
 bool LayerExists(LayerType layer)
@@ -66,6 +71,18 @@ void InvokeConfigChangedCallbacks()
     callback();
 }
 
+u32 GetConfigVersion()
+{
+  return s_config_version.load(std::memory_order_acquire);
+}
+
+void IncrementConfigVersion()
+{
+  // Zero is skipped, since it marks CachedValues which haven't been read yet.
+  if (s_config_version.fetch_add(1, std::memory_order_acq_rel) == std::numeric_limits<u32>::max())
+    s_config_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
 // Explicit load and save of layers
 void Load()
 {
@@ -85,17 +102,20 @@ void Init()
   ClearCurrentRunLayer();
   // This layer always has to exist
   s_layers[LayerType::Meta] = std::make_unique<RecursiveLayer>();
+  IncrementConfigVersion();
 }
 
 void Shutdown()
 {
   s_layers.clear();
   s_callbacks.clear();
+  IncrementConfigVersion();
 }
 
 void ClearCurrentRunLayer()
 {
   s_layers[LayerType::CurrentRun] = std::make_unique<Layer>(LayerType::CurrentRun);
+  IncrementConfigVersion();
 }
 
 static const std::map<System, std::string> system_to_name = {
@@ -4,11 +4,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 
+#include "Common/CommonTypes.h"
 #include "Common/Config/Enums.h"
 #include "Common/Config/Layer.h"
 #include "Common/Config/Section.h"
@@ -50,6 +54,10 @@ bool LayerExists(LayerType layer);
 void AddConfigChangedCallback(ConfigChangedCallback func);
 void InvokeConfigChangedCallbacks();
 
+// Changes whenever a value in any layer changes, or a layer is added or removed.
+u32 GetConfigVersion();
+void IncrementConfigVersion();
+
 // Explicit load and save of layers
 void Load();
 void Save();
@@ -90,8 +98,11 @@ LayerType GetActiveLayerForConfig(const ConfigInfo<T>& info)
 template <typename T>
 void Set(LayerType layer, const ConfigInfo<T>& info, const T& value)
 {
+  // Settings dialogs write back every value when they're saved, and most of those don't change.
+  const u32 version = GetConfigVersion();
   GetLayer(layer)->Set(info, value);
-  InvokeConfigChangedCallbacks();
+  if (GetConfigVersion() != version)
+    InvokeConfigChangedCallbacks();
 }
 
 template <typename T>
@@ -114,4 +125,43 @@ void SetBaseOrCurrent(const ConfigInfo<T>& info, const T& value)
   else
     Set<T>(LayerType::CurrentRun, info, value);
 }
+
+// A setting which is read often, for example on every frame. The value is only looked up in the
+// layers again after the configuration has changed, so reading an unchanged setting costs two
+// atomic loads instead of several string-keyed map lookups. T must fit into 32 bits, so that the
+// value can be stored together with the version it was read at.
+template <typename T>
+class CachedValue
+{
+public:
+  static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(u32),
+                "CachedValue only supports small trivially copyable types");
+
+  explicit CachedValue(const ConfigInfo<T>& info) : m_info(info) {}
+
+  T Get() const
+  {
+    const u32 version = GetConfigVersion();
+    u64 entry = m_entry.load(std::memory_order_relaxed);
+    if (static_cast<u32>(entry >> 32) != version)
+    {
+      const T value = Config::Get(m_info);
+      u32 bits = 0;
+      std::memcpy(&bits, &value, sizeof(T));
+      entry = static_cast<u64>(version) << 32 | bits;
+      m_entry.store(entry, std::memory_order_relaxed);
+    }
+
+    const u32 bits = static_cast<u32>(entry);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+
+private:
+  const ConfigInfo<T> m_info;
+  // The version in the upper half and the value in the lower half. Versions start at 1, so the
+  // initial entry is always out of date.
+  mutable std::atomic<u64> m_entry{0};
+};
 }
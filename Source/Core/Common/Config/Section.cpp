@@ -36,6 +36,7 @@ bool Section::Delete(const std::string& key)
 
   m_deleted_keys.push_back(key);
   m_dirty = true;
+  IncrementConfigVersion();
   return true;
 }
 
@@ -46,11 +47,13 @@ void Section::Set(const std::string& key, const std::string& value)
   {
     it->second = value;
     m_dirty = true;
+    IncrementConfigVersion();
   }
   else if (it == m_values.end())
   {
     m_values[key] = value;
     m_dirty = true;
+    IncrementConfigVersion();
   }
 }
 
@@ -97,6 +100,7 @@ void Section::SetLines(const std::vector<std::string>& lines)
 {
   m_lines = lines;
   m_dirty = true;
+  IncrementConfigVersion();
 }
 
 bool Section::Get(const std::string& key, std::string* value,
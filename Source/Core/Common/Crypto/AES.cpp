@@ -2,14 +2,209 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
+#include <cstring>
 #include <mbedtls/aes.h>
+#include <memory>
 
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
 #include "Common/Crypto/AES.h"
+#include "Common/Intrinsics.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+#if defined(_M_ARM_64) && (defined(__GNUC__) || defined(__clang__))
+#define FUNCTION_TARGET_CRYPTO [[gnu::target("+crypto")]]
+#else
+#define FUNCTION_TARGET_CRYPTO
+#endif
 
 namespace Common
 {
 namespace AES
 {
+constexpr size_t NUM_ROUND_KEYS = 11;
+
+// Decrypting several blocks at once keeps the AES units busy: CBC decryption of one block doesn't
+// depend on the decryption of the previous one, only on its ciphertext.
+constexpr size_t PARALLEL_BLOCKS = 8;
+
+class ContextGeneric final : public Context
+{
+public:
+  ContextGeneric(Mode mode, const u8* key) : m_mode(mode)
+  {
+    mbedtls_aes_init(&m_context);
+    if (mode == Mode::Encrypt)
+      mbedtls_aes_setkey_enc(&m_context, key, 128);
+    else
+      mbedtls_aes_setkey_dec(&m_context, key, 128);
+  }
+
+  ~ContextGeneric() { mbedtls_aes_free(&m_context); }
+
+  void Crypt(const u8* iv, const u8* in, u8* out, size_t size) const override
+  {
+    std::array<u8, BLOCK_SIZE> iv_copy;
+    std::memcpy(iv_copy.data(), iv, BLOCK_SIZE);
+    mbedtls_aes_crypt_cbc(&m_context, m_mode == Mode::Encrypt ? MBEDTLS_AES_ENCRYPT :
+                                                                MBEDTLS_AES_DECRYPT,
+                          size, iv_copy.data(), in, out);
+  }
+
+private:
+  Mode m_mode;
+  // mbedtls takes a non-const pointer, but doesn't modify the context when encrypting.
+  mutable mbedtls_aes_context m_context;
+};
+
+#if defined(_M_X86)
+FUNCTION_TARGET_AES
+static void DecryptCBCHardware(const u8* round_keys, const u8* iv, const u8* in, u8* out,
+                               size_t num_blocks)
+{
+  __m128i keys[NUM_ROUND_KEYS];
+  for (size_t i = 0; i < NUM_ROUND_KEYS; ++i)
+    keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_keys + i * BLOCK_SIZE));
+
+  __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  size_t block = 0;
+  for (; block + PARALLEL_BLOCKS <= num_blocks; block += PARALLEL_BLOCKS)
+  {
+    __m128i ciphertext[PARALLEL_BLOCKS];
+    __m128i state[PARALLEL_BLOCKS];
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+    {
+      ciphertext[i] =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (block + i) * BLOCK_SIZE));
+      state[i] = _mm_xor_si128(ciphertext[i], keys[0]);
+    }
+    for (size_t round = 1; round < NUM_ROUND_KEYS - 1; ++round)
+    {
+      for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+        state[i] = _mm_aesdec_si128(state[i], keys[round]);
+    }
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+    {
+      state[i] = _mm_aesdeclast_si128(state[i], keys[NUM_ROUND_KEYS - 1]);
+      state[i] = _mm_xor_si128(state[i], i == 0 ? previous : ciphertext[i - 1]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (block + i) * BLOCK_SIZE), state[i]);
+    }
+    previous = ciphertext[PARALLEL_BLOCKS - 1];
+  }
+
+  for (; block < num_blocks; ++block)
+  {
+    const __m128i ciphertext =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + block * BLOCK_SIZE));
+    __m128i state = _mm_xor_si128(ciphertext, keys[0]);
+    for (size_t round = 1; round < NUM_ROUND_KEYS - 1; ++round)
+      state = _mm_aesdec_si128(state, keys[round]);
+    state = _mm_aesdeclast_si128(state, keys[NUM_ROUND_KEYS - 1]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + block * BLOCK_SIZE),
+                     _mm_xor_si128(state, previous));
+    previous = ciphertext;
+  }
+}
+#elif defined(_M_ARM_64)
+// AESD adds the round key before the inverse rounds instead of after them like AESDEC on x86,
+// so the round keys are applied one step earlier and the last one is added separately.
+FUNCTION_TARGET_CRYPTO
+static uint8x16_t DecryptBlockHardware(uint8x16_t state, const uint8x16_t* keys)
+{
+  for (size_t round = 0; round < NUM_ROUND_KEYS - 2; ++round)
+    state = vaesimcq_u8(vaesdq_u8(state, keys[round]));
+  state = vaesdq_u8(state, keys[NUM_ROUND_KEYS - 2]);
+  return veorq_u8(state, keys[NUM_ROUND_KEYS - 1]);
+}
+
+FUNCTION_TARGET_CRYPTO
+static void DecryptCBCHardware(const u8* round_keys, const u8* iv, const u8* in, u8* out,
+                               size_t num_blocks)
+{
+  uint8x16_t keys[NUM_ROUND_KEYS];
+  for (size_t i = 0; i < NUM_ROUND_KEYS; ++i)
+    keys[i] = vld1q_u8(round_keys + i * BLOCK_SIZE);
+
+  uint8x16_t previous = vld1q_u8(iv);
+  size_t block = 0;
+  for (; block + PARALLEL_BLOCKS <= num_blocks; block += PARALLEL_BLOCKS)
+  {
+    uint8x16_t ciphertext[PARALLEL_BLOCKS];
+    uint8x16_t state[PARALLEL_BLOCKS];
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+    {
+      ciphertext[i] = vld1q_u8(in + (block + i) * BLOCK_SIZE);
+      state[i] = ciphertext[i];
+    }
+    for (size_t round = 0; round < NUM_ROUND_KEYS - 2; ++round)
+    {
+      for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+        state[i] = vaesimcq_u8(vaesdq_u8(state[i], keys[round]));
+    }
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+    {
+      state[i] = vaesdq_u8(state[i], keys[NUM_ROUND_KEYS - 2]);
+      state[i] = veorq_u8(state[i], keys[NUM_ROUND_KEYS - 1]);
+      state[i] = veorq_u8(state[i], i == 0 ? previous : ciphertext[i - 1]);
+      vst1q_u8(out + (block + i) * BLOCK_SIZE, state[i]);
+    }
+    previous = ciphertext[PARALLEL_BLOCKS - 1];
+  }
+
+  for (; block < num_blocks; ++block)
+  {
+    const uint8x16_t ciphertext = vld1q_u8(in + block * BLOCK_SIZE);
+    vst1q_u8(out + block * BLOCK_SIZE,
+             veorq_u8(DecryptBlockHardware(ciphertext, keys), previous));
+    previous = ciphertext;
+  }
+}
+#endif
+
+#if defined(_M_X86) || defined(_M_ARM_64)
+class ContextHardwareDecrypt final : public Context
+{
+public:
+  explicit ContextHardwareDecrypt(const u8* key)
+  {
+    // mbedtls stores the round keys of the equivalent inverse cipher in the order in which they
+    // are used, with the same layout as the AES instructions expect.
+    mbedtls_aes_context context;
+    mbedtls_aes_init(&context);
+    mbedtls_aes_setkey_dec(&context, key, 128);
+    std::memcpy(m_round_keys.data(), context.rk, m_round_keys.size());
+    mbedtls_aes_free(&context);
+  }
+
+  void Crypt(const u8* iv, const u8* in, u8* out, size_t size) const override
+  {
+    DecryptCBCHardware(m_round_keys.data(), iv, in, out, size / BLOCK_SIZE);
+  }
+
+private:
+  std::array<u8, NUM_ROUND_KEYS * BLOCK_SIZE> m_round_keys;
+};
+#endif
+
+std::unique_ptr<Context> CreateContextEncrypt(const u8* key)
+{
+  // CBC encryption can't be parallelized, and mbedtls already uses AES-NI for single blocks.
+  return std::make_unique<ContextGeneric>(Mode::Encrypt, key);
+}
+
+std::unique_ptr<Context> CreateContextDecrypt(const u8* key)
+{
+#if defined(_M_X86) || defined(_M_ARM_64)
+  if (cpu_info.bAES)
+    return std::make_unique<ContextHardwareDecrypt>(key);
+#endif
+  return std::make_unique<ContextGeneric>(Mode::Decrypt, key);
+}
+
 std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode)
 {
   mbedtls_aes_context aes_ctx;
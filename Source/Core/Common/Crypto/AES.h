@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -18,6 +19,24 @@ enum class Mode
   Decrypt,
   Encrypt,
 };
+
+constexpr size_t BLOCK_SIZE = 16;
+
+// An AES-128 key which is set up once and can then be used for any number of CBC operations.
+// Decryption uses the AES instructions of the host (AES-NI or the ARMv8 crypto extensions) when
+// they are available. Crypt doesn't modify the context, so it can be used by several threads.
+class Context
+{
+public:
+  virtual ~Context() = default;
+
+  // size must be a multiple of BLOCK_SIZE. in and out may be the same buffer.
+  virtual void Crypt(const u8* iv, const u8* in, u8* out, size_t size) const = 0;
+};
+
+std::unique_ptr<Context> CreateContextEncrypt(const u8* key);
+std::unique_ptr<Context> CreateContextDecrypt(const u8* key);
+
 std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode);
 
 // Convenience functions
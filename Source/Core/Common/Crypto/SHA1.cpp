@@ -0,0 +1,257 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Crypto/SHA1.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mbedtls/sha1.h>
+#include <memory>
+#include <utility>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+#include "Common/Swap.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+#if defined(_M_ARM_64) && (defined(__GNUC__) || defined(__clang__))
+#define FUNCTION_TARGET_CRYPTO [[gnu::target("+crypto")]]
+#else
+#define FUNCTION_TARGET_CRYPTO
+#endif
+
+namespace Common
+{
+namespace SHA1
+{
+constexpr size_t BLOCK_SIZE = 64;
+
+class ContextGeneric final : public Context
+{
+public:
+  ContextGeneric()
+  {
+    mbedtls_sha1_init(&m_context);
+    mbedtls_sha1_starts(&m_context);
+  }
+
+  ~ContextGeneric() { mbedtls_sha1_free(&m_context); }
+
+  void Update(const u8* msg, size_t len) override { mbedtls_sha1_update(&m_context, msg, len); }
+
+  Digest Finish() override
+  {
+    Digest digest;
+    mbedtls_sha1_finish(&m_context, digest.data());
+    return digest;
+  }
+
+private:
+  mbedtls_sha1_context m_context;
+};
+
+#if defined(_M_X86)
+// Each group does four of the 80 rounds. The message schedule for the later groups is computed
+// a few groups ahead, interleaved with the rounds, and the two E registers take turns.
+template <int Group>
+FUNCTION_TARGET_SHA static void RoundGroupHardware(__m128i* abcd, __m128i* e, __m128i* msg)
+{
+  const __m128i current = msg[Group % 4];
+  if (Group == 0)
+    e[0] = _mm_add_epi32(e[0], current);
+  else
+    e[Group % 2] = _mm_sha1nexte_epu32(e[Group % 2], current);
+  e[(Group + 1) % 2] = *abcd;
+
+  if (Group >= 3 && Group <= 18)
+    msg[(Group + 1) % 4] = _mm_sha1msg2_epu32(msg[(Group + 1) % 4], current);
+  *abcd = _mm_sha1rnds4_epu32(*abcd, e[Group % 2], Group / 5);
+  if (Group >= 1 && Group <= 16)
+    msg[(Group + 3) % 4] = _mm_sha1msg1_epu32(msg[(Group + 3) % 4], current);
+  if (Group >= 2 && Group <= 17)
+    msg[(Group + 2) % 4] = _mm_xor_si128(msg[(Group + 2) % 4], current);
+}
+
+template <int... Groups>
+FUNCTION_TARGET_SHA static void RoundsHardware(__m128i* abcd, __m128i* e, __m128i* msg,
+                                               std::integer_sequence<int, Groups...>)
+{
+  // Expands to the groups in order, without needing C++17 fold expressions.
+  const int expand[] = {(RoundGroupHardware<Groups>(abcd, e, msg), 0)...};
+  static_cast<void>(expand);
+}
+
+FUNCTION_TARGET_SHA
+static void ProcessBlocksHardware(u32* state, const u8* data, size_t num_blocks)
+{
+  // The message words are big endian, and the instructions expect A in the highest lane.
+  const __m128i byte_swap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+  __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+  __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+  for (; num_blocks; --num_blocks, data += BLOCK_SIZE)
+  {
+    const __m128i abcd_saved = abcd;
+    const __m128i e0_saved = e0;
+
+    __m128i msg[4];
+    for (size_t i = 0; i < 4; ++i)
+    {
+      msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)),
+                                byte_swap);
+    }
+
+    __m128i e[2] = {e0, _mm_setzero_si128()};
+    RoundsHardware(&abcd, e, msg, std::make_integer_sequence<int, 20>());
+
+    e0 = _mm_sha1nexte_epu32(e[0], e0_saved);
+    abcd = _mm_add_epi32(abcd, abcd_saved);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+  state[4] = static_cast<u32>(_mm_extract_epi32(e0, 3));
+}
+#elif defined(_M_ARM_64)
+FUNCTION_TARGET_CRYPTO
+static void ProcessBlocksHardware(u32* state, const u8* data, size_t num_blocks)
+{
+  static constexpr u32 ROUND_CONSTANTS[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6};
+
+  uint32x4_t abcd = vld1q_u32(state);
+  u32 e = state[4];
+
+  for (; num_blocks; --num_blocks, data += BLOCK_SIZE)
+  {
+    const uint32x4_t abcd_saved = abcd;
+    const u32 e_saved = e;
+
+    uint32x4_t msg[4];
+    for (size_t i = 0; i < 4; ++i)
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+
+    // Each group does four of the 80 rounds, and computes the message words for the group which
+    // comes four groups later.
+    for (size_t group = 0; group < 20; ++group)
+    {
+      const uint32x4_t wk = vaddq_u32(msg[group % 4], vdupq_n_u32(ROUND_CONSTANTS[group / 5]));
+      const u32 next_e = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+      if (group < 5)
+        abcd = vsha1cq_u32(abcd, e, wk);
+      else if (group >= 10 && group < 15)
+        abcd = vsha1mq_u32(abcd, e, wk);
+      else
+        abcd = vsha1pq_u32(abcd, e, wk);
+      e = next_e;
+
+      if (group < 16)
+      {
+        msg[group % 4] = vsha1su1q_u32(
+            vsha1su0q_u32(msg[group % 4], msg[(group + 1) % 4], msg[(group + 2) % 4]),
+            msg[(group + 3) % 4]);
+      }
+    }
+
+    abcd = vaddq_u32(abcd, abcd_saved);
+    e += e_saved;
+  }
+
+  vst1q_u32(state, abcd);
+  state[4] = e;
+}
+#endif
+
+#if defined(_M_X86) || defined(_M_ARM_64)
+class ContextHardware final : public Context
+{
+public:
+  void Update(const u8* msg, size_t len) override
+  {
+    m_total_len += len;
+
+    if (m_buffer_len)
+    {
+      const size_t copy_len = std::min(len, BLOCK_SIZE - m_buffer_len);
+      std::memcpy(m_buffer.data() + m_buffer_len, msg, copy_len);
+      m_buffer_len += copy_len;
+      msg += copy_len;
+      len -= copy_len;
+      if (m_buffer_len < BLOCK_SIZE)
+        return;
+
+      ProcessBlocksHardware(m_state.data(), m_buffer.data(), 1);
+      m_buffer_len = 0;
+    }
+
+    const size_t num_blocks = len / BLOCK_SIZE;
+    if (num_blocks)
+      ProcessBlocksHardware(m_state.data(), msg, num_blocks);
+
+    m_buffer_len = len % BLOCK_SIZE;
+    std::memcpy(m_buffer.data(), msg + num_blocks * BLOCK_SIZE, m_buffer_len);
+  }
+
+  Digest Finish() override
+  {
+    // The message is padded with a one bit and zeroes, and ends with its length in bits.
+    constexpr size_t LENGTH_OFFSET = BLOCK_SIZE - sizeof(u64);
+    const u64 bit_len = Common::swap64(m_total_len * 8);
+
+    m_buffer[m_buffer_len++] = 0x80;
+    if (m_buffer_len > LENGTH_OFFSET)
+    {
+      std::memset(m_buffer.data() + m_buffer_len, 0, BLOCK_SIZE - m_buffer_len);
+      ProcessBlocksHardware(m_state.data(), m_buffer.data(), 1);
+      m_buffer_len = 0;
+    }
+    std::memset(m_buffer.data() + m_buffer_len, 0, LENGTH_OFFSET - m_buffer_len);
+    std::memcpy(m_buffer.data() + LENGTH_OFFSET, &bit_len, sizeof(bit_len));
+    ProcessBlocksHardware(m_state.data(), m_buffer.data(), 1);
+
+    Digest digest;
+    for (size_t i = 0; i < m_state.size(); ++i)
+    {
+      const u32 word = Common::swap32(m_state[i]);
+      std::memcpy(digest.data() + i * sizeof(u32), &word, sizeof(u32));
+    }
+    return digest;
+  }
+
+private:
+  std::array<u32, 5> m_state = {{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0}};
+  std::array<u8, BLOCK_SIZE> m_buffer;
+  size_t m_buffer_len = 0;
+  u64 m_total_len = 0;
+};
+#endif
+
+std::unique_ptr<Context> CreateContext()
+{
+#if defined(_M_X86)
+  if (cpu_info.bSHA1 && cpu_info.bSSE4_1)
+    return std::make_unique<ContextHardware>();
+#elif defined(_M_ARM_64)
+  if (cpu_info.bSHA1)
+    return std::make_unique<ContextHardware>();
+#endif
+  return std::make_unique<ContextGeneric>();
+}
+
+Digest CalculateDigest(const u8* msg, size_t len)
+{
+  std::unique_ptr<Context> context = CreateContext();
+  context->Update(msg, len);
+  return context->Finish();
+}
+
+Digest CalculateDigest(const std::vector<u8>& msg)
+{
+  return CalculateDigest(msg.data(), msg.size());
+}
+}  // namespace SHA1
+}  // namespace Common
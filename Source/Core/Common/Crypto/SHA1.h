@@ -0,0 +1,39 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+namespace SHA1
+{
+constexpr size_t DIGEST_LEN = 20;
+using Digest = std::array<u8, DIGEST_LEN>;
+
+// Hashes data which is passed in pieces. Uses the SHA instructions of the host (SHA-NI or the
+// ARMv8 crypto extensions) when they are available.
+class Context
+{
+public:
+  virtual ~Context() = default;
+
+  virtual void Update(const u8* msg, size_t len) = 0;
+  void Update(const std::vector<u8>& msg) { Update(msg.data(), msg.size()); }
+  // The context can't be updated any more afterwards.
+  virtual Digest Finish() = 0;
+};
+
+std::unique_ptr<Context> CreateContext();
+
+Digest CalculateDigest(const u8* msg, size_t len);
+Digest CalculateDigest(const std::vector<u8>& msg);
+}  // namespace SHA1
+}  // namespace Common
@@ -64,6 +64,7 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERVALUES_IDX,
   F_WIISDCARD_IDX,
   NUM_PATH_INDICES
 };
@@ -99,6 +100,9 @@ public:
   bool IsFile() const;
   // Returns the size of a file (or returns 0 if the path doesn't refer to a file)
   u64 GetSize() const;
+  // Returns the time of the last modification in seconds since the epoch (or 0 if the path
+  // doesn't exist)
+  u64 GetModificationTime() const;
 
 private:
   struct stat m_stat;
@@ -0,0 +1,181 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// A hash map for integer keys which stores its entries in flat arrays.
+//
+// It uses open addressing with linear probing, and backward shift deletion instead of
+// tombstones, so lookups stay short even with lots of insertions and removals. This makes it a
+// good fit for hot lookup tables indexed by guest addresses, where node based containers like
+// std::map spend most of their time chasing pointers.
+//
+// Unlike the standard containers, inserting or erasing an entry may move other entries, so
+// pointers and references to values are only valid until the next modification of the map.
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename K, typename V>
+class FlatHashMap
+{
+  static_assert(std::is_integral<K>::value, "FlatHashMap only supports integer keys");
+
+public:
+  FlatHashMap() = default;
+
+  size_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+  V* Find(K key)
+  {
+    if (m_size == 0)
+      return nullptr;
+
+    for (size_t i = Home(key);; i = (i + 1) & m_mask)
+    {
+      if (!m_used[i])
+        return nullptr;
+      if (m_keys[i] == key)
+        return &m_values[i];
+    }
+  }
+
+  const V* Find(K key) const { return const_cast<FlatHashMap*>(this)->Find(key); }
+  bool Contains(K key) const { return Find(key) != nullptr; }
+
+  // Returns the value for the key, inserting a default constructed one if there is none yet.
+  V& operator[](K key)
+  {
+    if (V* value = Find(key))
+      return *value;
+
+    if ((m_size + 1) * 2 > m_keys.size())
+      Rehash(m_keys.empty() ? INITIAL_CAPACITY : m_keys.size() * 2);
+
+    size_t i = Home(key);
+    while (m_used[i])
+      i = (i + 1) & m_mask;
+
+    m_keys[i] = key;
+    m_used[i] = true;
+    m_values[i] = V();
+    m_size++;
+    return m_values[i];
+  }
+
+  bool Erase(K key)
+  {
+    if (m_size == 0)
+      return false;
+
+    size_t i = Home(key);
+    while (true)
+    {
+      if (!m_used[i])
+        return false;
+      if (m_keys[i] == key)
+        break;
+      i = (i + 1) & m_mask;
+    }
+
+    // Shift back the following entries of the same probe sequence, so that lookups never
+    // encounter a hole before reaching their entry.
+    size_t hole = i;
+    for (size_t j = (hole + 1) & m_mask; m_used[j]; j = (j + 1) & m_mask)
+    {
+      const size_t home = Home(m_keys[j]);
+      const bool movable = hole <= j ? (home <= hole || home > j) : (home <= hole && home > j);
+      if (movable)
+      {
+        m_keys[hole] = m_keys[j];
+        m_values[hole] = std::move(m_values[j]);
+        hole = j;
+      }
+    }
+
+    m_used[hole] = false;
+    m_values[hole] = V();
+    m_size--;
+    return true;
+  }
+
+  void Clear()
+  {
+    m_keys.clear();
+    m_values.clear();
+    m_used.clear();
+    m_mask = 0;
+    m_size = 0;
+  }
+
+  // Calls f(key, value) for every entry, in no particular order.
+  // The map must not be modified while doing so.
+  template <typename F>
+  void ForEach(F f)
+  {
+    for (size_t i = 0; i < m_keys.size(); ++i)
+    {
+      if (m_used[i])
+        f(m_keys[i], m_values[i]);
+    }
+  }
+
+  template <typename F>
+  void ForEach(F f) const
+  {
+    for (size_t i = 0; i < m_keys.size(); ++i)
+    {
+      if (m_used[i])
+        f(m_keys[i], m_values[i]);
+    }
+  }
+
+private:
+  static constexpr size_t INITIAL_CAPACITY = 16;
+
+  size_t Home(K key) const
+  {
+    // Fibonacci hashing, which spreads out keys with many trailing zero bits (like aligned
+    // addresses) well.
+    return static_cast<size_t>((static_cast<u64>(key) * 0x9E3779B97F4A7C15ULL) >> 32) & m_mask;
+  }
+
+  void Rehash(size_t capacity)
+  {
+    std::vector<K> keys(capacity);
+    std::vector<V> values(capacity);
+    std::vector<u8> used(capacity);
+    std::swap(keys, m_keys);
+    std::swap(values, m_values);
+    std::swap(used, m_used);
+    m_mask = capacity - 1;
+
+    for (size_t j = 0; j < keys.size(); ++j)
+    {
+      if (!used[j])
+        continue;
+
+      size_t i = Home(keys[j]);
+      while (m_used[i])
+        i = (i + 1) & m_mask;
+      m_keys[i] = keys[j];
+      m_values[i] = std::move(values[j]);
+      m_used[i] = true;
+    }
+  }
+
+  std::vector<K> m_keys;
+  std::vector<V> m_values;
+  std::vector<u8> m_used;
+  size_t m_mask = 0;
+  size_t m_size = 0;
+};
+}  // namespace Common
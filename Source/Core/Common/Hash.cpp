@@ -5,6 +5,7 @@
 #include "Common/Hash.h"
 #include <algorithm>
 #include <cstring>
+#include <xxhash.h>
 #include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
 #include "Common/Intrinsics.h"
@@ -612,6 +613,18 @@ u64 GetHashHiresTexture(const u8* src, u32 len, u32 samples)
 }
 #endif
 
+// Used instead of MurmurHash3 when the CPU has no CRC32 instruction. xxHash is roughly twice as
+// fast when the whole buffer is hashed, but sampling needs the MurmurHash3 loop, which only reads
+// some of the blocks. Like the other hash functions, this is only used for keys which are never
+// stored, so the values may change.
+static u64 GetXXHash64(const u8* src, u32 len, u32 samples)
+{
+  if (samples != 0)
+    return GetMurmurHash3(src, len, samples);
+
+  return XXH64(src, len, 0);
+}
+
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
   return ptrHashFunction(src, len, samples);
@@ -634,6 +647,6 @@ void SetHash64Function()
   else
 #endif
   {
-    ptrHashFunction = &GetMurmurHash3;
+    ptrHashFunction = &GetXXHash64;
   }
 }
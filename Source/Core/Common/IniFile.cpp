@@ -393,80 +393,100 @@ void IniFile::SortSections()
   sections.sort();
 }
 
+// Narrows [*begin, *end) to exclude the characters that StripSpaces removes.
+static void StripSpacesInPlace(const char** begin, const char** end)
+{
+  const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+  while (*begin != *end && is_space(**begin))
+    ++*begin;
+  while (*end != *begin && is_space(*(*end - 1)))
+    --*end;
+}
+
 bool IniFile::Load(const std::string& filename, bool keep_current_data)
 {
   if (!keep_current_data)
     sections.clear();
   // first section consists of the comments before the first real section
 
-  // Open file
-  std::ifstream in;
-  File::OpenFStream(in, filename, std::ios::in);
-
-  if (in.fail())
+  // The whole file is read at once and split into lines in place, which is much faster than
+  // reading it line by line through a stream. Game INIs are loaded for every game in the game
+  // list, so this adds up.
+  std::string contents;
+  if (!File::ReadFileToString(filename, contents))
     return false;
 
+  const char* position = contents.data();
+  const char* const contents_end = contents.data() + contents.size();
+
+  // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
+  if (contents.compare(0, 3, "\xEF\xBB\xBF") == 0)
+    position += 3;
+
   Section* current_section = nullptr;
-  bool first_line = true;
-  while (!in.eof())
+  std::string key, value;
+  while (position != contents_end)
   {
-    std::string line;
+    const char* line_begin = position;
+    const char* line_end = std::find(line_begin, contents_end, '\n');
+    position = line_end == contents_end ? line_end : line_end + 1;
+
+    // Check for CRLF eol and convert it to LF
+    if (line_end != line_begin && *(line_end - 1) == '\r')
+      --line_end;
 
-    if (!std::getline(in, line))
+    if (line_begin == line_end)
+      continue;
+
+    if (*line_begin == '[')
     {
-      if (in.eof())
-        return true;
-      else
-        return false;
+      const char* section_end = std::find(line_begin, line_end, ']');
+      if (section_end != line_end)
+      {
+        // New section!
+        current_section = GetOrCreateSection(std::string(line_begin + 1, section_end));
+      }
+      continue;
     }
 
-    // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
-    if (first_line && line.substr(0, 3) == "\xEF\xBB\xBF")
-      line = line.substr(3);
-    first_line = false;
+    if (!current_section)
+      continue;
 
-#ifndef _WIN32
-    // Check for CRLF eol and convert it to LF
-    if (!line.empty() && line.back() == '\r')
+    // Lines starting with '$', '*' or '+' are kept verbatim, as are comments and lines which
+    // aren't key/value pairs. Kind of a hack, but the support for raw lines inside an INI is a
+    // hack anyway.
+    const char* equals = std::find(line_begin, line_end, '=');
+    if (*line_begin == '#' || *line_begin == '$' || *line_begin == '+' || *line_begin == '*' ||
+        equals == line_end)
     {
-      line.pop_back();
+      current_section->m_lines.emplace_back(line_begin, line_end);
+      continue;
     }
-#endif
 
-    if (line.size() > 0)
+    const char* key_begin = line_begin;
+    const char* key_end = equals;
+    StripSpacesInPlace(&key_begin, &key_end);
+    const char* value_begin = equals + 1;
+    const char* value_end = line_end;
+    StripSpacesInPlace(&value_begin, &value_end);
+    // StripQuotes
+    if (value_begin != value_end && *value_begin == '"' && *(value_end - 1) == '"')
     {
-      if (line[0] == '[')
-      {
-        size_t endpos = line.find(']');
-
-        if (endpos != std::string::npos)
-        {
-          // New section!
-          std::string sub = line.substr(1, endpos - 1);
-          current_section = GetOrCreateSection(sub);
-        }
-      }
-      else
-      {
-        if (current_section)
-        {
-          std::string key, value;
-          ParseLine(line, &key, &value);
-
-          // Lines starting with '$', '*' or '+' are kept verbatim.
-          // Kind of a hack, but the support for raw lines inside an
-          // INI is a hack anyway.
-          if ((key == "" && value == "") ||
-              (line.size() >= 1 && (line[0] == '$' || line[0] == '+' || line[0] == '*')))
-            current_section->m_lines.push_back(line);
-          else
-            current_section->Set(key, value);
-        }
-      }
+      ++value_begin;
+      value_end = std::max(value_begin, value_end - 1);
     }
+
+    if (key_begin == key_end && value_begin == value_end)
+    {
+      current_section->m_lines.emplace_back(line_begin, line_end);
+      continue;
+    }
+
+    key.assign(key_begin, key_end);
+    value.assign(value_begin, value_end);
+    current_section->Set(key, value);
   }
 
-  in.close();
   return true;
 }
 
@@ -4,13 +4,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
-#include <fstream>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
+#include "Common/File.h"
 #include "Common/FileUtil.h"
 
 // On disk format:
@@ -53,8 +56,6 @@ public:
   // return number of read entries
   u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
   {
-    using std::ios_base;
-
 // Since we're reading/writing directly to the storage of K instances,
 // K must be trivially copyable. TODO: Remove #if once GCC 5.0 is a
 // minimum requirement.
@@ -69,74 +70,63 @@ public:
     Close();
     m_num_entries = 0;
 
-    // try opening for reading/writing
-    File::OpenFStream(m_file, filename, ios_base::in | ios_base::out | ios_base::binary);
-
-    m_file.seekg(0, std::ios::end);
-    std::fstream::pos_type end_pos = m_file.tellg();
-    m_file.seekg(0, std::ios::beg);
-    std::fstream::pos_type start_pos = m_file.tellg();
-    std::streamoff file_size = end_pos - start_pos;
-
     m_header.Init();
-    if (m_file.is_open() && ValidateHeader())
+
+    // The whole file is read with a single call and parsed from memory. Reading every entry with
+    // several small reads of its own made caches with many entries slow to load.
+    std::vector<u8> data;
+    if (m_file.Open(filename, "r+b") && ReadFile(&data) && ValidateHeader(data))
     {
       // good header, read some key/value pairs
       K key;
+      std::vector<V> value;
 
-      V* value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-
-      std::fstream::pos_type last_pos = m_file.tellg();
-
-      while (Read(&value_size))
+      size_t entry_offset = sizeof(Header);
+      while (true)
       {
-        std::streamoff next_extent = (last_pos - start_pos) + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
+        size_t offset = entry_offset;
+        u32 value_size;
+        u32 entry_number;
 
-        delete[] value;
-        value = new V[value_size];
-
-        // read key/value and pass to reader
-        if (Read(&key) && Read(value, value_size) && Read(&entry_number) &&
-            entry_number == m_num_entries + 1)
+        if (!Take(data, &offset, &value_size) || !Take(data, &offset, &key) ||
+            value_size > (data.size() - offset) / sizeof(V))
         {
-          reader.Read(key, value, value_size);
+          break;
         }
-        else
+
+        value.resize(value_size);
+        if (!Take(data, &offset, value.data(), value_size) ||
+            !Take(data, &offset, &entry_number) || entry_number != m_num_entries + 1)
         {
           break;
         }
 
+        reader.Read(key, value.data(), value_size);
+
         m_num_entries++;
-        last_pos = m_file.tellg();
+        entry_offset = offset;
       }
-      m_file.seekp(last_pos);
-      m_file.clear();
 
-      delete[] value;
+      // An entry is only complete once its number has been written after it. Anything after the
+      // last complete entry was left by an append which didn't finish, and is cut off so that
+      // new entries directly follow the ones which were read.
+      if (entry_offset != data.size())
+        m_file.Resize(entry_offset);
+      m_file.Seek(entry_offset, SEEK_SET);
+
       return m_num_entries;
     }
 
     // failed to open file for reading or bad header
     // close and recreate file
     Close();
-    m_file.open(filename, ios_base::out | ios_base::trunc | ios_base::binary);
+    m_file.Open(filename, "wb");
     WriteHeader();
     return 0;
   }
 
-  void Sync() { m_file.flush(); }
-  void Close()
-  {
-    if (m_file.is_open())
-      m_file.close();
-    // clear any error flags
-    m_file.clear();
-  }
-
+  void Sync() { m_file.Flush(); }
+  void Close() { m_file.Close(); }
   // Appends a key-value pair to the store.
   void Append(const K& key, const V* value, u32 value_size)
   {
@@ -151,24 +141,35 @@ public:
 
 private:
   void WriteHeader() { Write(&m_header); }
-  bool ValidateHeader()
+  bool ReadFile(std::vector<u8>* data)
   {
-    char file_header[sizeof(Header)];
+    data->resize(m_file.GetSize());
+    return data->size() >= sizeof(Header) && m_file.ReadBytes(data->data(), data->size());
+  }
 
-    return (Read(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
+  bool ValidateHeader(const std::vector<u8>& data) const
+  {
+    return !memcmp(&m_header, data.data(), sizeof(Header));
   }
 
   template <typename D>
   bool Write(const D* data, u32 count = 1)
   {
-    return m_file.write((const char*)data, count * sizeof(D)).good();
+    return m_file.WriteArray(data, count);
   }
 
+  // Copies count D from data at offset, and advances offset past them.
   template <typename D>
-  bool Read(const D* data, u32 count = 1)
+  static bool Take(const std::vector<u8>& data, size_t* offset, D* out, u32 count = 1)
   {
-    return m_file.read((char*)data, count * sizeof(D)).good();
+    const size_t size = count * sizeof(D);
+    if (data.size() - *offset < size)
+      return false;
+
+    if (size != 0)
+      std::memcpy(out, data.data() + *offset, size);
+    *offset += size;
+    return true;
   }
 
   struct Header
@@ -187,6 +188,6 @@ private:
 
   } m_header;
 
-  std::fstream m_file;
+  File::IOFile m_file;
   u32 m_num_entries;
 };
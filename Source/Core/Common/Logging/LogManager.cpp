@@ -7,6 +7,8 @@
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
@@ -15,9 +17,13 @@
 #include "Common/Logging/Log.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 
 constexpr size_t MAX_MSGLEN = 1024;
+// Threads which log in asynchronous mode wait for the writer thread once this many messages are
+// pending, which keeps the memory usage bounded when an output can't keep up.
+constexpr size_t MAX_PENDING_MESSAGES = 0x10000;
 
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_FILE{
     {Config::System::Logger, "Options", "WriteToFile"}, false};
@@ -26,6 +32,8 @@ const Config::ConfigInfo<bool> LOGGER_WRITE_TO_CONSOLE{
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
 const Config::ConfigInfo<int> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"}, 0};
+const Config::ConfigInfo<bool> LOGGER_WRITE_ASYNC{
+    {Config::System::Logger, "Options", "WriteAsynchronously"}, false};
 
 class FileLogListener : public LogListener
 {
@@ -148,10 +156,14 @@ LogManager::LogManager()
         Config::ConfigInfo<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  SetAsync(Config::Get(LOGGER_WRITE_ASYNC));
 }
 
 LogManager::~LogManager()
 {
+  SetAsync(false);
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -165,6 +177,7 @@ void LogManager::SaveSettings()
   Config::SetBaseOrCurrent(LOGGER_WRITE_TO_WINDOW,
                            IsListenerEnabled(LogListener::LOG_WINDOW_LISTENER));
   Config::SetBaseOrCurrent(LOGGER_VERBOSITY, static_cast<int>(GetLogLevel()));
+  Config::SetBaseOrCurrent(LOGGER_WRITE_ASYNC, IsAsync());
 
   for (const auto& container : m_log)
     Config::SetBaseOrCurrent({{Config::System::Logger, "Logs", container.m_short_name}, false},
@@ -192,9 +205,82 @@ void LogManager::LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE
       StringFromFormat("%s %s:%u %c[%s]: %s\n", Common::Timer::GetTimeFormatted().c_str(), file,
                        line, LogTypes::LOG_LEVEL_TO_CHAR[(int)level], GetShortName(type), temp);
 
+  if (m_async)
+  {
+    std::unique_lock<std::mutex> lk(m_pending_lock);
+    m_pending_cv.wait(lk, [this] {
+      return m_pending_messages.size() < MAX_PENDING_MESSAGES || !m_writer_running;
+    });
+    if (m_writer_running)
+    {
+      m_pending_messages.push_back(PendingMessage{level, std::move(msg)});
+      m_pending_cv.notify_all();
+      return;
+    }
+  }
+
+  WriteToListeners(level, msg.c_str());
+}
+
+void LogManager::WriteToListeners(LogTypes::LOG_LEVELS level, const char* msg)
+{
   for (auto listener_id : m_listener_ids)
     if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+      m_listeners[listener_id]->Log(level, msg);
+}
+
+void LogManager::WriterThread()
+{
+  Common::SetCurrentThreadName("Log Writer");
+
+  std::vector<PendingMessage> messages;
+  std::unique_lock<std::mutex> lk(m_pending_lock);
+  while (true)
+  {
+    m_pending_cv.wait(lk, [this] { return !m_pending_messages.empty() || !m_writer_running; });
+    if (m_pending_messages.empty())
+      return;
+
+    // The whole batch is taken at once, so that the listeners run without the lock held.
+    messages.swap(m_pending_messages);
+    m_pending_cv.notify_all();
+    lk.unlock();
+
+    for (const PendingMessage& message : messages)
+      WriteToListeners(message.level, message.text.c_str());
+    messages.clear();
+
+    lk.lock();
+  }
+}
+
+void LogManager::SetAsync(bool async)
+{
+  if (async == m_async)
+    return;
+
+  if (async)
+  {
+    std::lock_guard<std::mutex> lk(m_pending_lock);
+    m_writer_running = true;
+    m_writer_thread = std::thread(&LogManager::WriterThread, this);
+    m_async = true;
+    return;
+  }
+
+  m_async = false;
+  {
+    std::lock_guard<std::mutex> lk(m_pending_lock);
+    m_writer_running = false;
+  }
+  m_pending_cv.notify_all();
+  // The writer thread only exits once everything that was queued has been written.
+  m_writer_thread.join();
+}
+
+bool LogManager::IsAsync() const
+{
+  return m_async;
 }
 
 LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
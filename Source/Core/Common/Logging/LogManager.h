@@ -5,7 +5,13 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/Logging/Log.h"
@@ -53,6 +59,11 @@ public:
   void EnableListener(LogListener::LISTENER id, bool enable);
   bool IsListenerEnabled(LogListener::LISTENER id) const;
 
+  // In asynchronous mode, messages are only formatted by the thread which logs them, and are
+  // passed to the listeners by a writer thread so that slow outputs don't hold up emulation.
+  void SetAsync(bool async);
+  bool IsAsync() const;
+
   void SaveSettings();
 
 private:
@@ -63,12 +74,28 @@ private:
     bool m_enable = false;
   };
 
+  struct PendingMessage
+  {
+    LogTypes::LOG_LEVELS level;
+    std::string text;
+  };
+
   LogManager();
   ~LogManager();
 
+  void WriteToListeners(LogTypes::LOG_LEVELS level, const char* msg);
+  void WriterThread();
+
   LogTypes::LOG_LEVELS m_level;
   std::array<LogContainer, LogTypes::NUMBER_OF_LOGS> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  std::atomic<bool> m_async{false};
+  std::mutex m_pending_lock;
+  std::condition_variable m_pending_cv;
+  std::vector<PendingMessage> m_pending_messages;
+  bool m_writer_running = false;
+  std::thread m_writer_thread;
 };
@@ -0,0 +1,186 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Logging/Trace.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+namespace Trace
+{
+// The file starts with the magic and the version, followed by chunks which each start with a
+// ChunkType and a u32 size. Record chunks contain size records, and name chunks contain a u32
+// event, a u32 ID and then size bytes of name. Everything is stored in host byte order.
+constexpr u32 TRACE_MAGIC = 0x43525444;  // "DTRC"
+constexpr u32 TRACE_VERSION = 1;
+
+enum ChunkType : u32
+{
+  CHUNK_RECORDS = 0,
+  CHUNK_NAME = 1,
+};
+
+// The number of records a thread collects before handing them to the writer thread.
+constexpr size_t BUFFER_SIZE = 0x4000;
+
+std::atomic<bool> g_enabled{false};
+
+struct ThreadBuffer
+{
+  std::vector<Record> records;
+  u16 thread;
+};
+
+static std::mutex s_mutex;
+static std::condition_variable s_cv;
+static File::IOFile s_file;
+static std::vector<std::vector<Record>> s_full_buffers;
+static std::vector<std::unique_ptr<ThreadBuffer>> s_thread_buffers;
+static std::map<std::pair<u16, u32>, std::string> s_names;
+static bool s_writer_exit = false;
+static std::thread s_writer_thread;
+
+// Incremented by every Stop, so that threads don't keep using the buffer of an earlier trace.
+static std::atomic<u32> s_session{1};
+static std::chrono::steady_clock::time_point s_start_time;
+
+static thread_local ThreadBuffer* t_buffer = nullptr;
+static thread_local u32 t_session = 0;
+
+static void WriteRecords(const std::vector<Record>& records)
+{
+  const u32 header[] = {CHUNK_RECORDS, static_cast<u32>(records.size())};
+  s_file.WriteArray(header, 2);
+  s_file.WriteArray(records.data(), records.size());
+}
+
+static void WriterThread()
+{
+  Common::SetCurrentThreadName("Trace Writer");
+
+  std::unique_lock<std::mutex> lk(s_mutex);
+  while (true)
+  {
+    s_cv.wait(lk, [] { return !s_full_buffers.empty() || s_writer_exit; });
+    if (s_full_buffers.empty())
+      return;
+
+    std::vector<std::vector<Record>> buffers;
+    buffers.swap(s_full_buffers);
+    lk.unlock();
+
+    for (const std::vector<Record>& records : buffers)
+      WriteRecords(records);
+
+    lk.lock();
+  }
+}
+
+bool Start(const std::string& path)
+{
+  Stop();
+
+  if (!s_file.Open(path, "wb"))
+  {
+    ERROR_LOG(COMMON, "Failed to open trace file %s", path.c_str());
+    return false;
+  }
+
+  const u32 header[] = {TRACE_MAGIC, TRACE_VERSION};
+  s_file.WriteArray(header, 2);
+
+  s_writer_exit = false;
+  s_writer_thread = std::thread(WriterThread);
+  s_start_time = std::chrono::steady_clock::now();
+  g_enabled.store(true, std::memory_order_release);
+  NOTICE_LOG(COMMON, "Started writing trace to %s", path.c_str());
+  return true;
+}
+
+void Stop()
+{
+  if (!s_file.IsOpen())
+    return;
+
+  g_enabled.store(false, std::memory_order_release);
+
+  {
+    std::lock_guard<std::mutex> lk(s_mutex);
+    for (const auto& buffer : s_thread_buffers)
+    {
+      if (!buffer->records.empty())
+        s_full_buffers.push_back(std::move(buffer->records));
+    }
+    s_thread_buffers.clear();
+    ++s_session;
+    s_writer_exit = true;
+  }
+  s_cv.notify_all();
+  s_writer_thread.join();
+
+  std::lock_guard<std::mutex> lk(s_mutex);
+  for (const auto& entry : s_names)
+  {
+    const u32 header[] = {CHUNK_NAME, static_cast<u32>(entry.second.size()), entry.first.first,
+                          entry.first.second};
+    s_file.WriteArray(header, 4);
+    s_file.WriteBytes(entry.second.data(), entry.second.size());
+  }
+  s_file.Close();
+}
+
+void Write(Event event, u64 arg0, u32 arg1)
+{
+  const u64 time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - s_start_time)
+                          .count();
+
+  if (t_session != s_session.load(std::memory_order_relaxed))
+  {
+    std::lock_guard<std::mutex> lk(s_mutex);
+    // Tracing may have stopped in the meantime, in which case the buffer would never be written.
+    if (!IsEnabled())
+      return;
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->records.reserve(BUFFER_SIZE);
+    buffer->thread = static_cast<u16>(s_thread_buffers.size());
+    t_buffer = buffer.get();
+    t_session = s_session.load(std::memory_order_relaxed);
+    s_thread_buffers.push_back(std::move(buffer));
+  }
+
+  t_buffer->records.push_back(
+      Record{time_ns, arg0, arg1, static_cast<u16>(event), t_buffer->thread});
+
+  if (t_buffer->records.size() == BUFFER_SIZE)
+  {
+    std::vector<Record> new_records;
+    new_records.reserve(BUFFER_SIZE);
+    {
+      std::lock_guard<std::mutex> lk(s_mutex);
+      s_full_buffers.push_back(std::move(t_buffer->records));
+    }
+    s_cv.notify_one();
+    t_buffer->records = std::move(new_records);
+  }
+}
+
+void SetName(Event event, u32 id, const std::string& name)
+{
+  std::lock_guard<std::mutex> lk(s_mutex);
+  s_names[{static_cast<u16>(event), id}] = name;
+}
+}  // namespace Trace
@@ -0,0 +1,72 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// A binary event tracer for hot paths, where text logging would change the timing that is being
+// investigated. Every event is stored as a small fixed-size record in a buffer of the thread that
+// traces it, and full buffers are written to disk by a separate thread.
+//
+// Tools/trace-to-json.py converts a trace into the JSON format that chrome://tracing and Perfetto
+// display as a timeline.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace Trace
+{
+// Stored in the trace file, so new events must only be added at the end, and the decoder needs
+// to know about them.
+enum class Event : u16
+{
+  CoreTimingBegin,  // arg0: userdata, arg1: event type ID
+  CoreTimingEnd,
+  MMIORead,   // arg0: address, arg1: value
+  MMIOWrite,  // arg0: address, arg1: value
+  IPCRequestBegin,  // arg0: request address, arg1: command
+  IPCRequestEnd,
+  IPCReply,     // arg0: request address
+  DVDRequest,   // arg0: DVD offset, arg1: length
+  DVDReadBegin,  // arg0: DVD offset, arg1: length
+  DVDReadEnd,
+  FifoCommand,  // arg0: opcode, arg1: 1 if in a display list
+};
+
+struct Record
+{
+  u64 time_ns;
+  u64 arg0;
+  u32 arg1;
+  u16 event;
+  u16 thread;
+};
+static_assert(sizeof(Record) == 24, "Trace records are stored in files");
+
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// Starts writing a new trace to the given file. Returns false if it couldn't be opened.
+bool Start(const std::string& path);
+// Writes out all remaining records. No thread may be tracing anymore when this is called.
+void Stop();
+
+void Write(Event event, u64 arg0, u32 arg1);
+
+// Gives a readable name to an ID which is used as arg1 of an event (like CoreTiming event types).
+// Names are kept across traces, so they can be set before tracing starts.
+void SetName(Event event, u32 id, const std::string& name);
+}  // namespace Trace
+
+#define TRACE_EVENT(event, arg0, arg1)                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (Trace::IsEnabled())                                                                        \
+      Trace::Write(Trace::Event::event, static_cast<u64>(arg0), static_cast<u32>(arg1));           \
+  } while (0)
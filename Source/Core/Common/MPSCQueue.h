@@ -0,0 +1,105 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// A bounded lock-free queue for multiple writers and a single reader.
+//
+// The elements are stored in a fixed ring of cells, each of which has a sequence number that tells
+// writers whether it is free and the reader whether it has been filled yet. Writers claim a cell
+// with a single compare-and-swap on the write position, so they never block each other for longer
+// than it takes to copy an element. When the ring is full, Push() fails instead of waiting, and the
+// caller has to decide what to do with the element.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Common
+{
+template <typename T, size_t Capacity>
+class MPSCQueue
+{
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "MPSCQueue capacity must be a power of two");
+
+public:
+  MPSCQueue()
+  {
+    for (size_t i = 0; i < Capacity; ++i)
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  // Can be called from any thread. Returns false if the queue is full.
+  template <typename Arg>
+  bool Push(Arg&& value)
+  {
+    size_t pos = m_write_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Cell& cell = m_cells[pos & MASK];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence - pos);
+      if (diff == 0)
+      {
+        // The cell is free; try to claim it. On failure, pos is updated to the current position.
+        if (m_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          cell.value = std::forward<Arg>(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        // The reader hasn't consumed the element from the previous lap yet.
+        return false;
+      }
+      else
+      {
+        // Another writer claimed the cell first.
+        pos = m_write_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Must only be called from the reader thread. Returns false if the queue is empty, or if the
+  // next element is still being written.
+  bool Pop(T& value)
+  {
+    Cell& cell = m_cells[m_read_pos & MASK];
+    if (cell.sequence.load(std::memory_order_acquire) != m_read_pos + 1)
+      return false;
+
+    value = std::move(cell.value);
+    cell.sequence.store(m_read_pos + Capacity, std::memory_order_release);
+    m_read_pos++;
+    return true;
+  }
+
+  // Must only be called from the reader thread.
+  bool Empty() const
+  {
+    return m_cells[m_read_pos & MASK].sequence.load(std::memory_order_acquire) != m_read_pos + 1;
+  }
+
+  static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+  static constexpr size_t MASK = Capacity - 1;
+
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::array<Cell, Capacity> m_cells;
+  // Keep the positions on separate cache lines, so that writers and the reader don't keep
+  // stealing the line from each other.
+  alignas(64) std::atomic<size_t> m_write_pos{0};
+  alignas(64) size_t m_read_pos = 0;
+};
+}  // namespace Common
@@ -0,0 +1,43 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/NonCopyable.h"
+
+namespace Common
+{
+// Maps a whole file read-only into memory. The pages are only read from disk when they are first
+// accessed, and the OS can drop them again under memory pressure, which makes this cheaper than
+// reading large files which are only partially used.
+class MappedFile final : NonCopyable
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  bool Open(const std::string& filename);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+
+private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+
+#ifdef _WIN32
+  HANDLE m_mapping = nullptr;
+#endif
+};
+}  // namespace Common
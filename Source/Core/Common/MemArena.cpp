@@ -7,10 +7,12 @@
 #include <set>
 #include <string>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -150,13 +152,17 @@ u8* MemArena::FindMemoryBase()
 #else
   const int flags = MAP_ANON | MAP_PRIVATE;
 #endif
-  void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  // Align the base to the huge page size, so that the views of emulated RAM can be backed by
+  // huge pages.
+  const size_t reserved_size = memory_size + Common::HUGE_PAGE_SIZE;
+  void* base = mmap(nullptr, reserved_size, PROT_NONE, flags, -1, 0);
   if (base == MAP_FAILED)
   {
     PanicAlert("Failed to map enough memory space: %s", LastStrerrorString().c_str());
     return nullptr;
   }
-  munmap(base, memory_size);
-  return static_cast<u8*>(base);
+  munmap(base, reserved_size);
+  return reinterpret_cast<u8*>(
+      Common::AlignUp(reinterpret_cast<uintptr_t>(base), Common::HUGE_PAGE_SIZE));
 #endif
 }
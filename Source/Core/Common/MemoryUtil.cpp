@@ -149,6 +149,18 @@ void UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute)
 #endif
 }
 
+bool AdviseHugePages(void* ptr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+  // This fails if the kernel was built without transparent huge pages. If they are merely
+  // disabled in /sys/kernel/mm/transparent_hugepage, it succeeds but has no effect.
+  if (madvise(ptr, size, MADV_HUGEPAGE) == 0)
+    return true;
+  INFO_LOG(MEMMAP, "Huge pages are not available: %s", LastStrerrorString().c_str());
+#endif
+  return false;
+}
+
 size_t MemPhysical()
 {
 #ifdef _WIN32
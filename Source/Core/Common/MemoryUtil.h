@@ -9,6 +9,8 @@
 
 namespace Common
 {
+constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+
 void* AllocateExecutableMemory(size_t size);
 void* AllocateMemoryPages(size_t size);
 void FreeMemoryPages(void* ptr, size_t size);
@@ -17,6 +19,10 @@ void FreeAlignedMemory(void* ptr);
 void ReadProtectMemory(void* ptr, size_t size);
 void WriteProtectMemory(void* ptr, size_t size, bool executable = false);
 void UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute = false);
+// Asks the OS to back the given memory with huge pages, which only covers the parts that are
+// aligned to HUGE_PAGE_SIZE. Returns false if that isn't supported, in which case the memory
+// keeps working with normal pages.
+bool AdviseHugePages(void* ptr, size_t size);
 size_t MemPhysical();
 
 }  // namespace Common
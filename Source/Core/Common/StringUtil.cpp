@@ -156,6 +156,21 @@ std::string StringFromFormat(const char* format, ...)
   return res;
 }
 
+void AppendFromFormatV(std::string* out, const char* format, va_list args)
+{
+  char buffer[1024];
+  va_list args_copy;
+  va_copy(args_copy, args);
+  const bool fits = CharArrayFromFormatV(buffer, sizeof(buffer), format, args_copy);
+  va_end(args_copy);
+
+  // This also takes the slow path for empty strings, which CharArrayFromFormatV reports as failed.
+  if (fits)
+    out->append(buffer);
+  else
+    out->append(StringFromFormatV(format, args));
+}
+
 std::string StringFromFormatV(const char* format, va_list args)
 {
   char* buf = nullptr;
@@ -23,6 +23,10 @@ std::string StringFromFormat(const char* format, ...)
 #endif
     ;
 
+// Appends the formatted string to out. Short strings are formatted on the stack, so this doesn't
+// need a temporary allocation unlike out += StringFromFormatV(format, args).
+void AppendFromFormatV(std::string* out, const char* format, va_list args);
+
 // Cheap!
 bool CharArrayFromFormatV(char* out, int outsize, const char* format, va_list args);
 
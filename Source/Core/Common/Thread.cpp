@@ -3,8 +3,13 @@
 // Refer to the license.txt file included.
 
 #include "Common/Thread.h"
+
+#include <algorithm>
+#include <utility>
+
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Timer.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -12,6 +17,16 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sched.h>
+#include <set>
+#include <string>
+#endif
+
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined BSD4_4 || defined __FreeBSD__ || defined __OpenBSD__
@@ -38,6 +53,21 @@ int CurrentThreadId()
 #endif
 }
 
+#if defined _WIN32 || defined __linux__
+// Takes (performance rank, logical CPU) pairs, one per physical core.
+static std::vector<int> SortCoresByRank(std::vector<std::pair<int, int>> cores)
+{
+  std::stable_sort(cores.begin(), cores.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  std::vector<int> cpus;
+  cpus.reserve(cores.size());
+  for (const auto& core : cores)
+    cpus.push_back(core.second);
+  return cpus;
+}
+#endif
+
 #ifdef _WIN32
 
 void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask)
@@ -50,12 +80,114 @@ void SetCurrentThreadAffinity(u32 mask)
   SetThreadAffinityMask(GetCurrentThread(), mask);
 }
 
+std::vector<int> GetPhysicalCores()
+{
+  DWORD_PTR process_mask, system_mask;
+  GROUP_AFFINITY thread_group;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask) ||
+      !GetThreadGroupAffinity(GetCurrentThread(), &thread_group))
+  {
+    return {};
+  }
+
+  DWORD size = 0;
+  GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &size);
+  std::vector<u8> buffer(size);
+  if (!GetLogicalProcessorInformationEx(
+          RelationProcessorCore,
+          reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data()), &size))
+  {
+    return {};
+  }
+
+  std::vector<std::pair<int, int>> cores;
+  for (DWORD offset = 0; offset < size;)
+  {
+    const auto* info =
+        reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+    offset += info->Size;
+
+    // Affinity masks only refer to the processor group the process runs in.
+    const GROUP_AFFINITY& group = info->Processor.GroupMask[0];
+    const KAFFINITY allowed = group.Mask & process_mask;
+    if (group.Group != thread_group.Group || allowed == 0)
+      continue;
+
+    int cpu = 0;
+    while (!((allowed >> cpu) & 1))
+      ++cpu;
+    // A higher efficiency class means a faster core.
+    cores.emplace_back(info->Processor.EfficiencyClass, cpu);
+  }
+  return SortCoresByRank(std::move(cores));
+}
+
+bool SetCurrentThreadAffinityToCPU(int cpu)
+{
+  return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+}
+
 // Supporting functions
 void SleepCurrentThread(int ms)
 {
   Sleep(ms);
 }
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace
+{
+class WaitableTimer
+{
+public:
+  // High resolution timers need Windows 10 1803, older versions get a regular one.
+  WaitableTimer()
+      : m_handle(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                        TIMER_ALL_ACCESS))
+  {
+    if (!m_handle)
+      m_handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+  }
+  ~WaitableTimer()
+  {
+    if (m_handle)
+      CloseHandle(m_handle);
+  }
+  WaitableTimer(const WaitableTimer&) = delete;
+  WaitableTimer& operator=(const WaitableTimer&) = delete;
+
+  bool Wait(u64 us)
+  {
+    // Negative due times are relative, in units of 100 ns.
+    LARGE_INTEGER due_time;
+    due_time.QuadPart = -static_cast<LONGLONG>(us * 10);
+    if (!m_handle || !SetWaitableTimer(m_handle, &due_time, 0, nullptr, nullptr, FALSE))
+      return false;
+    return WaitForSingleObject(m_handle, INFINITE) == WAIT_OBJECT_0;
+  }
+
+private:
+  HANDLE m_handle;
+};
+}  // Anonymous namespace
+
+void SleepCurrentThreadUntil(u64 time_us, u64 spin_us)
+{
+  static thread_local WaitableTimer timer;
+
+  const u64 now = Timer::GetTimeUs();
+  if (time_us > now + spin_us)
+  {
+    const u64 sleep_us = time_us - spin_us - now;
+    if (!timer.Wait(sleep_us))
+      Sleep(static_cast<DWORD>(sleep_us / 1000));
+  }
+  while (Timer::GetTimeUs() < time_us)
+    YieldCPU();
+}
+
 void SwitchCurrentThread()
 {
   SwitchToThread();
@@ -119,11 +251,134 @@ void SetCurrentThreadAffinity(u32 mask)
   SetThreadAffinity(pthread_self(), mask);
 }
 
+#ifdef __linux__
+static bool ReadSysfsLine(const std::string& path, std::string* line)
+{
+  std::ifstream file(path);
+  return file && std::getline(file, *line);
+}
+
+// Parses a list of CPUs in the format sysfs uses, like "0-3,8".
+static std::set<int> ParseCPUList(const std::string& list)
+{
+  std::set<int> cpus;
+  size_t pos = 0;
+  while (pos < list.size())
+  {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos)
+      end = list.size();
+
+    const std::string range = list.substr(pos, end - pos);
+    const size_t dash = range.find('-');
+    const int first = std::atoi(range.c_str());
+    const int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+    for (int cpu = first; cpu <= last; ++cpu)
+      cpus.insert(cpu);
+
+    pos = end + 1;
+  }
+  return cpus;
+}
+
+std::vector<int> GetPhysicalCores()
+{
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return {};
+
+  // Hybrid Intel CPUs list their P-cores here. Other hybrid CPUs report a cpu_capacity for every
+  // core instead, which is higher for the faster ones. Older ARM kernels, like those of many
+  // Android devices, only tell the big cores apart from the LITTLE ones by their clock speed.
+  std::string p_core_list;
+  const std::set<int> p_cores = ReadSysfsLine("/sys/devices/cpu_core/cpus", &p_core_list) ?
+                                    ParseCPUList(p_core_list) :
+                                    std::set<int>();
+
+  std::set<std::string> seen_cores;
+  std::vector<std::pair<int, int>> cores;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (!CPU_ISSET(cpu, &allowed))
+      continue;
+
+    const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    std::string siblings;
+    if (!ReadSysfsLine(dir + "/topology/thread_siblings_list", &siblings))
+      return {};
+    if (!seen_cores.insert(siblings).second)
+      continue;
+
+    std::string capacity;
+    int rank = 0;
+    std::string max_freq;
+    if (ReadSysfsLine(dir + "/cpu_capacity", &capacity))
+      rank = std::atoi(capacity.c_str());
+    else if (p_cores.count(cpu))
+      rank = 1;
+    else if (ReadSysfsLine(dir + "/cpufreq/cpuinfo_max_freq", &max_freq))
+      rank = std::atoi(max_freq.c_str());
+    cores.emplace_back(rank, cpu);
+  }
+  return SortCoresByRank(std::move(cores));
+}
+
+bool SetCurrentThreadAffinityToCPU(int cpu)
+{
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+    return false;
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+#ifdef ANDROID
+  // Bionic has no pthread_setaffinity_np, but on Linux the affinity is a property of the thread.
+  return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#else
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#endif
+}
+#else
+// macOS only supports affinity hints between threads, not placing them on specific cores.
+std::vector<int> GetPhysicalCores()
+{
+  return {};
+}
+
+bool SetCurrentThreadAffinityToCPU(int cpu)
+{
+  return false;
+}
+#endif
+
 void SleepCurrentThread(int ms)
 {
   usleep(1000 * ms);
 }
 
+void SleepCurrentThreadUntil(u64 time_us, u64 spin_us)
+{
+  const u64 now = Timer::GetTimeUs();
+  if (time_us > now + spin_us)
+  {
+#ifdef __linux__
+    // Timer::GetTimeUs uses CLOCK_MONOTONIC here, so the wakeup time can be absolute, which
+    // doesn't drift when the sleep is interrupted.
+    const u64 wake_us = time_us - spin_us;
+    timespec wake_time;
+    wake_time.tv_sec = static_cast<time_t>(wake_us / 1000000);
+    wake_time.tv_nsec = static_cast<long>(wake_us % 1000000 * 1000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_time, nullptr) == EINTR)
+    {
+    }
+#else
+    usleep(static_cast<useconds_t>(time_us - spin_us - now));
+#endif
+  }
+  while (Timer::GetTimeUs() < time_us)
+    YieldCPU();
+}
+
 void SwitchCurrentThread()
 {
   usleep(1000 * 1);
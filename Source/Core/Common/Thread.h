@@ -5,6 +5,7 @@
 #pragma once
 
 #include <thread>
+#include <vector>
 
 // Don't include Common.h here as it will break LogManager
 #include "Common/CommonTypes.h"
@@ -23,7 +24,18 @@ int CurrentThreadId();
 void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask);
 void SetCurrentThreadAffinity(u32 mask);
 
+// Returns one logical CPU of every physical core that the process is allowed to run on, with the
+// cores of the fastest kind (like the P-cores of a hybrid CPU) first. Hyperthreading siblings
+// share a physical core, so only one of them is listed. The list is empty if the topology can't
+// be queried on this host.
+std::vector<int> GetPhysicalCores();
+// Unlike SetCurrentThreadAffinity, this also works for CPUs past the first 32.
+bool SetCurrentThreadAffinityToCPU(int cpu);
+
 void SleepCurrentThread(int ms);
+// Sleeps until Timer::GetTimeUs() reaches time_us. The last spin_us microseconds are spent
+// spinning instead, which makes the wakeup precise even where the OS timers are coarse.
+void SleepCurrentThreadUntil(u64 time_us, u64 spin_us);
 void SwitchCurrentThread();  // On Linux, this is equal to sleep 1ms
 
 // Use this function during a spin-wait to make the current thread
@@ -0,0 +1,109 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+namespace ThreadPool
+{
+namespace
+{
+constexpr size_t NUM_PRIORITIES = static_cast<size_t>(TaskPriority::Low) + 1;
+
+class Pool
+{
+public:
+  Pool()
+  {
+    const size_t num_threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    for (size_t i = 0; i < num_threads; ++i)
+      m_threads.emplace_back(&Pool::ThreadLoop, this);
+  }
+
+  ~Pool()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_exit = true;
+    }
+    m_cv.notify_all();
+    for (std::thread& thread : m_threads)
+      thread.join();
+  }
+
+  void Submit(TaskPriority priority, std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_queues[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
+    m_cv.notify_one();
+  }
+
+  size_t GetNumThreads() const { return m_threads.size(); }
+
+private:
+  void ThreadLoop()
+  {
+    SetCurrentThreadName("Worker");
+
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+      auto queue = m_queues.end();
+      m_cv.wait(lk, [&] {
+        queue = std::find_if(m_queues.begin(), m_queues.end(),
+                             [](const auto& tasks) { return !tasks.empty(); });
+        return m_exit || queue != m_queues.end();
+      });
+      // Tasks which are still queued at exit are dropped.
+      if (m_exit)
+        return;
+
+      std::function<void()> task = std::move(queue->front());
+      queue->pop_front();
+
+      lk.unlock();
+      task();
+      lk.lock();
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::array<std::deque<std::function<void()>>, NUM_PRIORITIES> m_queues;
+  bool m_exit = false;
+};
+
+Pool& GetPool()
+{
+  static Pool pool;
+  return pool;
+}
+}  // Anonymous namespace
+
+void Submit(TaskPriority priority, std::function<void()> task)
+{
+  GetPool().Submit(priority, std::move(task));
+}
+
+size_t GetNumThreads()
+{
+  return GetPool().GetNumThreads();
+}
+}  // namespace ThreadPool
+}  // namespace Common
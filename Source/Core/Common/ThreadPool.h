@@ -0,0 +1,37 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace Common
+{
+enum class TaskPriority
+{
+  // Work that the emulation is waiting for, like the helpers of a video backend.
+  High,
+  // Background work which should be done soon, like compressing a savestate.
+  Normal,
+  // Work that nobody is waiting for, like scanning the game list.
+  Low,
+};
+
+// A set of worker threads which is shared by everything that runs short tasks in the
+// background, so that the host's cores aren't oversubscribed by a separate set of threads for
+// every user. There is one thread fewer than the host has cores, and they are started when the
+// first task is submitted.
+//
+// Tasks shouldn't block for long, since that keeps a thread from running other tasks. Anything
+// that waits for I/O or for another thread should get a thread of its own.
+namespace ThreadPool
+{
+// Queued tasks are started in the order of their priority, and then in the order they were
+// submitted in.
+void Submit(TaskPriority priority, std::function<void()> task);
+
+size_t GetNumThreads();
+}  // namespace ThreadPool
+}  // namespace Common
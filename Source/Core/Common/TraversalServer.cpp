@@ -1,16 +1,21 @@
 // This file is public domain, in case it's useful to anyone. -comex
 
 // The central server implementation.
+#include <algorithm>
 #include <arpa/inet.h>
+#include <array>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <fcntl.h>
+#include <functional>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/socket.h>
-#include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <unordered_map>
 #include <utility>
@@ -20,6 +25,24 @@
 #define DEBUG 0
 #define NUMBER_OF_TRIES 5
 
+// All times are in microseconds.
+static const u64 RESEND_INTERVAL = 300000;
+static const u64 EXPIRY_TIME = 30 * 1000000;  // 30s
+
+// Resends are scheduled on a timer wheel, so that each tick only looks at the packets which are
+// due then rather than at all of them. The wheel has to span the longest resend interval.
+static const u64 TICK_LENGTH = 100000;
+static const size_t WHEEL_SLOTS = 64;
+static_assert(WHEEL_SLOTS * TICK_LENGTH > RESEND_INTERVAL * NUMBER_OF_TRIES,
+              "the timer wheel is too short");
+
+// The tables are split into shards, so that expired hosts can be evicted a shard per tick
+// instead of in one sweep over every host, and so that no single rehash has to move them all.
+static const size_t NUMBER_OF_SHARDS = 64;
+
+// Number of datagrams which are received or sent with a single system call.
+static const size_t BATCH_SIZE = 64;
+
 static u64 currentTime;
 
 struct OutgoingPacketInfo
@@ -50,7 +73,6 @@ EvictFindResult<V> EvictFind(std::unordered_map<K, EvictEntry<V>>& map, const K&
                              bool refresh = false)
 {
 retry:
-  const u64 expiryTime = 30 * 1000000;  // 30s
   EvictFindResult<V> result;
   if (map.bucket_count())
   {
@@ -58,7 +80,7 @@ retry:
     auto it = map.begin(bucket);
     for (; it != map.end(bucket); ++it)
     {
-      if (currentTime - it->second.updateTime > expiryTime)
+      if (currentTime - it->second.updateTime > EXPIRY_TIME)
       {
         map.erase(it->first);
         goto retry;
@@ -94,6 +116,32 @@ V* EvictSet(std::unordered_map<K, EvictEntry<V>>& map, const K& key)
   return &result.value;
 }
 
+template <typename K, typename V>
+void EvictExpired(std::unordered_map<K, EvictEntry<V>>& map)
+{
+  for (auto it = map.begin(); it != map.end();)
+  {
+    if (currentTime - it->second.updateTime > EXPIRY_TIME)
+      it = map.erase(it);
+    else
+      ++it;
+  }
+}
+
+template <typename K, typename V>
+class ShardedMap
+{
+public:
+  std::unordered_map<K, V>& Shard(const K& key)
+  {
+    return m_shards[std::hash<K>()(key) % NUMBER_OF_SHARDS];
+  }
+  std::unordered_map<K, V>& ShardAt(size_t index) { return m_shards[index]; }
+
+private:
+  std::array<std::unordered_map<K, V>, NUMBER_OF_SHARDS> m_shards;
+};
+
 namespace std
 {
 template <>
@@ -107,10 +155,24 @@ struct hash<TraversalHostId>
 };
 }
 
+struct OutgoingDatagram
+{
+  TraversalPacket packet;
+  sockaddr_in6 dest;
+};
+
 static int sock;
 static int urandomFd;
-static std::unordered_map<TraversalRequestId, OutgoingPacketInfo> outgoingPackets;
-static std::unordered_map<TraversalHostId, EvictEntry<TraversalInetAddress>> connectedClients;
+static ShardedMap<TraversalRequestId, OutgoingPacketInfo> outgoingPackets;
+static ShardedMap<TraversalHostId, EvictEntry<TraversalInetAddress>> connectedClients;
+// Packets which have been allocated but not sent yet.
+static std::vector<TraversalRequestId> newPackets;
+static std::array<std::vector<TraversalRequestId>, WHEEL_SLOTS> resendWheel;
+static size_t wheelPos;
+// The time at which the current slot of the wheel became due.
+static u64 wheelTime;
+// Datagrams are queued up, and sent in batches once all received ones are handled.
+static std::vector<OutgoingDatagram> sendQueue;
 
 static TraversalInetAddress MakeInetAddress(const sockaddr_in6& addr)
 {
@@ -194,23 +256,67 @@ static const char* SenderName(sockaddr_in6* addr)
   return buf;
 }
 
-static void TrySend(const void* buffer, size_t size, sockaddr_in6* addr)
+static void TrySend(const TraversalPacket& packet, const sockaddr_in6& addr)
 {
 #if DEBUG
-  printf("-> %d %llu %s\n", ((TraversalPacket*)buffer)->type,
-         (long long)((TraversalPacket*)buffer)->requestId, SenderName(addr));
+  printf("-> %d %llu %s\n", packet.type, (long long)packet.requestId, SenderName(&addr));
 #endif
-  if ((size_t)sendto(sock, buffer, size, 0, (sockaddr*)addr, sizeof(*addr)) != size)
+  sendQueue.push_back({packet, addr});
+}
+
+static void FlushSends()
+{
+#ifdef __linux__
+  std::array<mmsghdr, BATCH_SIZE> msgs;
+  std::array<iovec, BATCH_SIZE> iovs;
+  for (size_t start = 0; start < sendQueue.size(); start += BATCH_SIZE)
   {
-    perror("sendto");
+    const size_t count = std::min(BATCH_SIZE, sendQueue.size() - start);
+    for (size_t i = 0; i < count; i++)
+    {
+      OutgoingDatagram& datagram = sendQueue[start + i];
+      iovs[i].iov_base = &datagram.packet;
+      iovs[i].iov_len = sizeof(datagram.packet);
+      memset(&msgs[i], 0, sizeof(msgs[i]));
+      msgs[i].msg_hdr.msg_name = &datagram.dest;
+      msgs[i].msg_hdr.msg_namelen = sizeof(datagram.dest);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // sendmmsg stops at the first datagram which fails, so skip over that one and carry on.
+    size_t sent = 0;
+    while (sent < count)
+    {
+      int rv = sendmmsg(sock, &msgs[sent], count - sent, 0);
+      if (rv < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        perror("sendmmsg");
+        rv = 1;
+      }
+      sent += rv;
+    }
+  }
+#else
+  for (OutgoingDatagram& datagram : sendQueue)
+  {
+    if ((size_t)sendto(sock, &datagram.packet, sizeof(datagram.packet), 0,
+                       (sockaddr*)&datagram.dest, sizeof(datagram.dest)) != sizeof(datagram.packet))
+    {
+      perror("sendto");
+    }
   }
+#endif
+  sendQueue.clear();
 }
 
 static TraversalPacket* AllocPacket(const sockaddr_in6& dest, TraversalRequestId misc = 0)
 {
   TraversalRequestId requestId;
   GetRandomBytes(&requestId, sizeof(requestId));
-  OutgoingPacketInfo* info = &outgoingPackets[requestId];
+  OutgoingPacketInfo* info = &outgoingPackets.Shard(requestId)[requestId];
   info->dest = dest;
   info->misc = misc;
   info->tries = 0;
@@ -218,40 +324,62 @@ static TraversalPacket* AllocPacket(const sockaddr_in6& dest, TraversalRequestId
   TraversalPacket* result = &info->packet;
   memset(result, 0, sizeof(*result));
   result->requestId = requestId;
+  newPackets.push_back(requestId);
   return result;
 }
 
+static void ScheduleResend(TraversalRequestId requestId, u64 time)
+{
+  // Round up, so that a packet is never resent early.
+  size_t ticks = 1;
+  if (time > wheelTime)
+    ticks = (size_t)std::max<u64>((time - wheelTime + TICK_LENGTH - 1) / TICK_LENGTH, 1);
+  ticks = std::min(ticks, WHEEL_SLOTS - 1);
+  resendWheel[(wheelPos + ticks) % WHEEL_SLOTS].push_back(requestId);
+}
+
 static void SendPacket(OutgoingPacketInfo* info)
 {
   info->tries++;
   info->sendTime = currentTime;
-  TrySend(&info->packet, sizeof(info->packet), &info->dest);
+  TrySend(info->packet, info->dest);
+  ScheduleResend(info->packet.requestId, currentTime + RESEND_INTERVAL * info->tries);
 }
 
 static void ResendPackets()
 {
   std::vector<std::pair<TraversalInetAddress, TraversalRequestId>> todoFailures;
-  todoFailures.clear();
-  for (auto it = outgoingPackets.begin(); it != outgoingPackets.end();)
+  while (currentTime - wheelTime >= TICK_LENGTH)
   {
-    OutgoingPacketInfo* info = &it->second;
-    if (currentTime - info->sendTime >= (u64)(300000 * info->tries))
+    wheelTime += TICK_LENGTH;
+    wheelPos = (wheelPos + 1) % WHEEL_SLOTS;
+
+    std::vector<TraversalRequestId> due;
+    due.swap(resendWheel[wheelPos]);
+    for (TraversalRequestId requestId : due)
     {
+      auto& shard = outgoingPackets.Shard(requestId);
+      auto it = shard.find(requestId);
+      // It has been acked in the meantime.
+      if (it == shard.end())
+        continue;
+
+      OutgoingPacketInfo* info = &it->second;
       if (info->tries >= NUMBER_OF_TRIES)
       {
         if (info->packet.type == TraversalPacketPleaseSendPacket)
         {
           todoFailures.push_back(std::make_pair(info->packet.pleaseSendPacket.address, info->misc));
         }
-        it = outgoingPackets.erase(it);
-        continue;
+        shard.erase(it);
       }
       else
       {
         SendPacket(info);
       }
     }
-    ++it;
+
+    EvictExpired(connectedClients.ShardAt(wheelPos % NUMBER_OF_SHARDS));
   }
 
   for (const auto& p : todoFailures)
@@ -263,6 +391,18 @@ static void ResendPackets()
   }
 }
 
+static void SendNewPackets()
+{
+  for (TraversalRequestId requestId : newPackets)
+  {
+    auto& shard = outgoingPackets.Shard(requestId);
+    auto it = shard.find(requestId);
+    if (it != shard.end())
+      SendPacket(&it->second);
+  }
+  newPackets.clear();
+}
+
 static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
 {
 #if DEBUG
@@ -273,8 +413,9 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
   {
   case TraversalPacketAck:
   {
-    auto it = outgoingPackets.find(packet->requestId);
-    if (it == outgoingPackets.end())
+    auto& shard = outgoingPackets.Shard(packet->requestId);
+    auto it = shard.find(packet->requestId);
+    if (it == shard.end())
       break;
 
     OutgoingPacketInfo* info = &it->second;
@@ -296,12 +437,12 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
       }
     }
 
-    outgoingPackets.erase(it);
+    shard.erase(it);
     break;
   }
   case TraversalPacketPing:
   {
-    auto r = EvictFind(connectedClients, packet->ping.hostId, true);
+    auto r = EvictFind(connectedClients.Shard(packet->ping.hostId), packet->ping.hostId, true);
     packetOk = r.found;
     break;
   }
@@ -320,12 +461,14 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
       GetRandomHostId(&hostId);
       while (true)
       {
-        auto r = EvictFind(connectedClients, hostId);
+        auto& shard = connectedClients.Shard(hostId);
+        auto r = EvictFind(shard, hostId);
         if (!r.found)
         {
-          iaddr = EvictSet(connectedClients, hostId);
+          iaddr = EvictSet(shard, hostId);
           break;
         }
+        GetRandomHostId(&hostId);
       }
 
       *iaddr = MakeInetAddress(*addr);
@@ -338,7 +481,7 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
   case TraversalPacketConnectPlease:
   {
     TraversalHostId& hostId = packet->connectPlease.hostId;
-    auto r = EvictFind(connectedClients, hostId);
+    auto r = EvictFind(connectedClients.Shard(hostId), hostId);
     if (!r.found)
     {
       TraversalPacket* reply = AllocPacket(*addr);
@@ -363,7 +506,83 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
     ack.type = TraversalPacketAck;
     ack.requestId = packet->requestId;
     ack.ack.ok = packetOk;
-    TrySend(&ack, sizeof(ack), addr);
+    TrySend(ack, *addr);
+  }
+}
+
+static void UpdateCurrentTime()
+{
+  timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+  {
+    perror("clock_gettime");
+    exit(1);
+  }
+  currentTime = (u64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void HandleReceivedPacket(TraversalPacket* packet, size_t size, sockaddr_in6* addr)
+{
+  if (size < sizeof(*packet))
+    fprintf(stderr, "received short packet from %s\n", SenderName(addr));
+  else
+    HandlePacket(packet, addr);
+}
+
+// Handles all packets which are waiting on the socket. Returns false on fatal errors.
+static bool ReceivePackets()
+{
+  static std::array<TraversalPacket, BATCH_SIZE> packets;
+  static std::array<sockaddr_in6, BATCH_SIZE> addrs;
+
+  while (true)
+  {
+#ifdef __linux__
+    std::array<mmsghdr, BATCH_SIZE> msgs;
+    std::array<iovec, BATCH_SIZE> iovs;
+    for (size_t i = 0; i < BATCH_SIZE; i++)
+    {
+      iovs[i].iov_base = &packets[i];
+      iovs[i].iov_len = sizeof(packets[i]);
+      memset(&msgs[i], 0, sizeof(msgs[i]));
+      msgs[i].msg_hdr.msg_name = &addrs[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int rv = recvmmsg(sock, msgs.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (rv < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return true;
+      perror("recvmmsg");
+      return false;
+    }
+    for (int i = 0; i < rv; i++)
+      HandleReceivedPacket(&packets[i], msgs[i].msg_len, &addrs[i]);
+    if ((size_t)rv < BATCH_SIZE)
+      return true;
+#else
+    for (size_t i = 0; i < BATCH_SIZE; i++)
+    {
+      socklen_t addrLen = sizeof(addrs[i]);
+      ssize_t rv = recvfrom(sock, &packets[i], sizeof(packets[i]), MSG_DONTWAIT,
+                            (sockaddr*)&addrs[i], &addrLen);
+      if (rv < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+          return true;
+        perror("recvfrom");
+        return false;
+      }
+      HandleReceivedPacket(&packets[i], (size_t)rv, &addrs[i]);
+    }
+#endif
   }
 }
 
@@ -409,46 +628,27 @@ int main()
     return 1;
   }
 
-  timeval tv;
-  tv.tv_sec = 0;
-  tv.tv_usec = 300000;
-  rv = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-  if (rv < 0)
-  {
-    perror("setsockopt SO_RCVTIMEO");
-    return 1;
-  }
+  UpdateCurrentTime();
+  wheelTime = currentTime;
 
   while (true)
   {
-    sockaddr_in6 raddr;
-    socklen_t addrLen = sizeof(raddr);
-    TraversalPacket packet;
-    // note: switch to recvmmsg (yes, mmsg) if this becomes
-    // expensive
-    rv = recvfrom(sock, &packet, sizeof(packet), 0, (sockaddr*)&raddr, &addrLen);
-    if (gettimeofday(&tv, nullptr) < 0)
-    {
-      perror("gettimeofday");
-      exit(1);
-    }
-    currentTime = (u64)tv.tv_sec * 1000000 + tv.tv_usec;
-    if (rv < 0)
-    {
-      if (errno != EINTR && errno != EAGAIN)
-      {
-        perror("recvfrom");
-        return 1;
-      }
-    }
-    else if ((size_t)rv < sizeof(packet))
-    {
-      fprintf(stderr, "received short packet from %s\n", SenderName(&raddr));
-    }
-    else
+    // Sleep until a packet arrives or the next slot of the timer wheel is due.
+    const u64 nextTick = wheelTime + TICK_LENGTH;
+    const int timeout = nextTick > currentTime ? (int)((nextTick - currentTime + 999) / 1000) : 0;
+    pollfd pfd = {sock, POLLIN, 0};
+    rv = poll(&pfd, 1, timeout);
+    if (rv < 0 && errno != EINTR)
     {
-      HandlePacket(&packet, &raddr);
+      perror("poll");
+      return 1;
     }
+
+    UpdateCurrentTime();
+    if (rv > 0 && !ReceivePackets())
+      return 1;
     ResendPackets();
+    SendNewPackets();
+    FlushSends();
   }
 }
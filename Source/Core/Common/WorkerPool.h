@@ -0,0 +1,87 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "Common/ThreadPool.h"
+
+namespace Common
+{
+// Runs the same job over a range of indices, on up to num_workers threads of the shared
+// ThreadPool as well as on the thread which submitted it.
+class WorkerPool
+{
+public:
+  explicit WorkerPool(size_t num_workers, TaskPriority priority = TaskPriority::Normal)
+      : m_num_workers(num_workers), m_priority(priority)
+  {
+  }
+
+  size_t GetNumWorkers() const { return m_num_workers; }
+
+  // Calls job(i) for every i in [0, count), and returns once all of them are done.
+  // Each index is only handed to a single thread.
+  void Run(size_t count, const std::function<void(size_t)>& job)
+  {
+    if (count == 0)
+      return;
+
+    // The submitting thread always takes part, so the job finishes even if all threads of the
+    // pool are busy. Helpers which only start afterwards find no indices left and just return,
+    // which is why they share ownership of the state but never touch the job then.
+    auto state = std::make_shared<RunState>();
+    state->job = &job;
+    state->count = count;
+
+    const size_t num_helpers = std::min(m_num_workers, count - 1);
+    for (size_t i = 0; i < num_helpers; ++i)
+      ThreadPool::Submit(m_priority, [state] { RunJobs(state.get()); });
+
+    RunJobs(state.get());
+
+    std::unique_lock<std::mutex> lk(state->mutex);
+    state->done_cv.wait(lk, [&] { return state->done == state->count; });
+  }
+
+private:
+  struct RunState
+  {
+    const std::function<void(size_t)>* job = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next_index{0};
+    size_t done = 0;
+    std::mutex mutex;
+    std::condition_variable done_cv;
+  };
+
+  static void RunJobs(RunState* state)
+  {
+    size_t finished = 0;
+    for (size_t i = state->next_index++; i < state->count; i = state->next_index++)
+    {
+      (*state->job)(i);
+      ++finished;
+    }
+
+    if (finished == 0)
+      return;
+
+    std::lock_guard<std::mutex> lk(state->mutex);
+    state->done += finished;
+    if (state->done == state->count)
+      state->done_cv.notify_one();
+  }
+
+  size_t m_num_workers;
+  TaskPriority m_priority;
+};
+}  // namespace Common
@@ -1176,6 +1176,19 @@ public:
     auto trampoline = &XEmitter::CallLambdaTrampoline<T, Args...>;
     ABI_CallFunctionPC(trampoline, reinterpret_cast<const void*>(f), p1);
   }
+
+  template <typename... Args>
+  void ABI_CallLambdaCA(int bits, const std::function<void(Args...)>* f, u32 p1,
+                        const Gen::OpArg& arg2)
+  {
+    auto trampoline = &XEmitter::CallLambdaTrampoline<void, Args...>;
+    // Move the value first, as it may live in one of the other parameter registers.
+    if (!arg2.IsSimpleReg(ABI_PARAM3))
+      MOV(bits, R(ABI_PARAM3), arg2);
+    MOV(64, R(ABI_PARAM1), Imm64(reinterpret_cast<u64>(f)));
+    MOV(32, R(ABI_PARAM2), Imm32(p1));
+    ABI_CallFunction(trampoline);
+  }
 };  // class XEmitter
 
 class X64CodeBlock : public CodeBlock<XEmitter>
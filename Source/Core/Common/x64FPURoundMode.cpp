@@ -19,7 +19,8 @@ void SetRoundMode(int mode)
 {
   // Convert PowerPC to native rounding mode.
   static const int rounding_mode_lut[] = {FE_TONEAREST, FE_TOWARDZERO, FE_UPWARD, FE_DOWNWARD};
-  fesetround(rounding_mode_lut[mode]);
+  if (fegetround() != rounding_mode_lut[mode])
+    fesetround(rounding_mode_lut[mode]);
 }
 
 void SetPrecisionMode(PrecisionMode /* mode */)
@@ -46,7 +47,12 @@ void SetSIMDMode(int rounding_mode, bool non_ieee_mode)
   {
     csr |= FTZ;
   }
-  _mm_setcsr(csr);
+  // Writing MXCSR is much slower than reading it, and games often rewrite FPSCR with the mode
+  // it already has. The sticky exception flags in the low bits don't matter, as all exceptions
+  // are masked.
+  const u32 EXCEPTION_FLAGS = 0x3F;
+  if ((_mm_getcsr() & ~EXCEPTION_FLAGS) != csr)
+    _mm_setcsr(csr);
 }
 
 void SaveSIMDState()
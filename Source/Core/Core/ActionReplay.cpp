@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cinttypes>
 #include <cstdarg>
 #include <iterator>
 #include <mutex>
@@ -36,6 +37,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Timer.h"
 
 #include "Core/ARDecrypt.h"
 #include "Core/ConfigManager.h"
@@ -79,9 +81,54 @@ enum
   SUB_MASTER_CODE = 0x03,
 };
 
+namespace
+{
+enum class OpType : u8
+{
+  Nothing,
+  End,
+  RamWrite,
+  WriteToPointer,
+  Add,
+  Conditional,
+  FillAndSlide,
+  MemoryCopy,
+};
+
+// One line of a code, decoded ahead of time.
+struct CompiledOp
+{
+  OpType type;
+  u8 size;
+  u8 compare;
+  u32 address;
+  u32 data;
+  // Fill and slide and memory copies
+  u32 count;
+  s32 address_step;
+  s32 value_step;
+  // The index of the line to continue at, and for conditionals, the one if they are false.
+  u32 next;
+  u32 next_if_false;
+};
+
+struct ActiveCode
+{
+  ARCode code;
+  // Only used if the code could be compiled, which fails for codes with lines that the
+  // interpreter stops at with an error.
+  std::vector<CompiledOp> ops;
+  bool compiled;
+};
+}  // Anonymous namespace
+
+// Running the codes taking longer than this during a frame is logged once per set of codes.
+constexpr u64 SLOW_RUN_TIME_US = 1000;
+
 // General lock. Protects codes list and internal log.
 static std::mutex s_lock;
-static std::vector<ARCode> s_active_codes;
+static std::vector<ActiveCode> s_active_codes;
+static bool s_slow_run_logged = false;
 static std::vector<std::string> s_internal_log;
 static std::atomic<bool> s_use_internal_log{false};
 // pointer to the code currently being run, (used by log messages that include the code name)
@@ -107,6 +154,16 @@ struct ARAddr
   operator u32() const { return address; }
 };
 
+static bool CompileCode(const ARCode& arcode, std::vector<CompiledOp>* ops);
+
+static ActiveCode MakeActiveCode(ARCode code)
+{
+  ActiveCode active_code;
+  active_code.compiled = CompileCode(code, &active_code.ops);
+  active_code.code = std::move(code);
+  return active_code;
+}
+
 // ----------------------
 // AR Remote Functions
 void ApplyCodes(const std::vector<ARCode>& codes)
@@ -116,9 +173,13 @@ void ApplyCodes(const std::vector<ARCode>& codes)
 
   std::lock_guard<std::mutex> guard(s_lock);
   s_disable_logging = false;
+  s_slow_run_logged = false;
   s_active_codes.clear();
-  std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
-               [](const ARCode& code) { return code.active; });
+  for (const ARCode& code : codes)
+  {
+    if (code.active)
+      s_active_codes.push_back(MakeActiveCode(code));
+  }
   s_active_codes.shrink_to_fit();
 }
 
@@ -131,7 +192,8 @@ void AddCode(ARCode code)
   {
     std::lock_guard<std::mutex> guard(s_lock);
     s_disable_logging = false;
-    s_active_codes.emplace_back(std::move(code));
+    s_slow_run_logged = false;
+    s_active_codes.push_back(MakeActiveCode(std::move(code)));
   }
 }
 
@@ -931,6 +993,247 @@ static bool RunCodeLocked(const ARCode& arcode)
   return true;
 }
 
+// Decodes every line of a code once, and resolves how many lines a conditional skips into the
+// line to continue at. Each line is decoded on its own, since a skip can land on the operand of
+// a zero code, which is then run as a code of its own.
+static bool CompileCode(const ARCode& arcode, std::vector<CompiledOp>* ops)
+{
+  const u32 num_lines = static_cast<u32>(arcode.ops.size());
+  ops->resize(num_lines);
+
+  for (u32 i = 0; i < num_lines; ++i)
+  {
+    const ARAddr addr(arcode.ops[i].cmd_addr);
+    const u32 data = arcode.ops[i].value;
+
+    CompiledOp& op = (*ops)[i];
+    op = {};
+    op.address = addr.GCAddress();
+    op.size = addr.size;
+    op.data = data;
+    op.next = i + 1;
+
+    // ActionReplay program self modification codes
+    if (addr >= 0x00002000 && addr < 0x00003000)
+      return false;
+
+    if (0x0 == addr)
+    {
+      switch (data >> 29)
+      {
+      case ZCODE_END:
+        op.type = OpType::End;
+        break;
+
+      case ZCODE_NORM:
+        op.type = OpType::Nothing;
+        break;
+
+      case ZCODE_04:
+      {
+        // The zero code applies to the line after it, and does nothing if there is none.
+        op.type = OpType::Nothing;
+        if (i + 1 == num_lines)
+          break;
+
+        const ARAddr operand_addr(arcode.ops[i + 1].cmd_addr);
+        const u32 operand_data = arcode.ops[i + 1].value;
+        op.next = i + 2;
+        if (0x3 == ((data >> 25) & 0x03))
+        {
+          if ((operand_data & ~0x7FFF) != 0)
+            return false;
+
+          op.type = OpType::MemoryCopy;
+          op.address = data | 0x06000000;
+          op.data = operand_addr.GCAddress();
+          op.count = static_cast<u8>(operand_data & 0x7FFF);
+        }
+        else
+        {
+          op.size = ARAddr(data).size;
+          if (op.size == DATATYPE_32BIT_FLOAT)
+            return false;
+
+          op.type = OpType::FillAndSlide;
+          op.address = ARAddr(data).GCAddress();
+          op.data = operand_addr;
+          op.count = static_cast<u8>((operand_data & 0xFF0000) >> 16);
+          op.address_step = static_cast<s16>(operand_data & 0xFFFF) * (1 << op.size);
+          op.value_step = static_cast<s8>(operand_data >> 24);
+        }
+        break;
+      }
+
+      default:
+        return false;
+      }
+      continue;
+    }
+
+    if (addr.type == 0x00)
+    {
+      switch (addr.subtype)
+      {
+      case SUB_RAM_WRITE:
+        op.type = OpType::RamWrite;
+        break;
+      case SUB_WRITE_POINTER:
+        op.type = OpType::WriteToPointer;
+        break;
+      case SUB_ADD_CODE:
+        op.type = OpType::Add;
+        break;
+      default:
+        return false;
+      }
+      continue;
+    }
+
+    op.type = OpType::Conditional;
+    op.compare = addr.type;
+    switch (addr.subtype)
+    {
+    case CONDTIONAL_ONE_LINE:
+    case CONDTIONAL_TWO_LINES:
+      op.next_if_false = std::min(i + 2 + addr.subtype, num_lines);
+      break;
+
+    case CONDTIONAL_ALL_LINES_UNTIL:
+    {
+      // Skip lines until a "00000000 40000000" line is reached, including that one.
+      const auto end_if = std::find(arcode.ops.begin() + i + 1, arcode.ops.end(),
+                                    AREntry(0, 0x40000000));
+      op.next_if_false = static_cast<u32>(std::min<size_t>(
+          std::distance(arcode.ops.begin(), end_if) + 1, num_lines));
+      break;
+    }
+
+    default:
+      op.next_if_false = num_lines;
+      break;
+    }
+  }
+
+  return true;
+}
+
+static u32 ReadValue(u8 size, u32 address)
+{
+  switch (size)
+  {
+  case DATATYPE_8BIT:
+    return PowerPC::HostRead_U8(address);
+  case DATATYPE_16BIT:
+    return PowerPC::HostRead_U16(address);
+  default:
+    return PowerPC::HostRead_U32(address);
+  }
+}
+
+static void WriteValue(u8 size, u32 value, u32 address)
+{
+  switch (size)
+  {
+  case DATATYPE_8BIT:
+    PowerPC::HostWrite_U8(value & 0xFF, address);
+    break;
+  case DATATYPE_16BIT:
+    PowerPC::HostWrite_U16(value & 0xFFFF, address);
+    break;
+  default:
+    PowerPC::HostWrite_U32(value, address);
+    break;
+  }
+}
+
+// Does the same as RunCodeLocked, without decoding the lines or logging what they do.
+static void RunCompiledCode(const std::vector<CompiledOp>& ops)
+{
+  for (u32 i = 0; i < ops.size();)
+  {
+    const CompiledOp& op = ops[i];
+    i = op.next;
+
+    switch (op.type)
+    {
+    case OpType::Nothing:
+      break;
+
+    case OpType::End:
+      return;
+
+    case OpType::RamWrite:
+      if (op.size == DATATYPE_8BIT)
+      {
+        for (u32 j = 0; j <= op.data >> 8; ++j)
+          PowerPC::HostWrite_U8(op.data & 0xFF, op.address + j);
+      }
+      else if (op.size == DATATYPE_16BIT)
+      {
+        for (u32 j = 0; j <= op.data >> 16; ++j)
+          PowerPC::HostWrite_U16(op.data & 0xFFFF, op.address + j * 2);
+      }
+      else
+      {
+        PowerPC::HostWrite_U32(op.data, op.address);
+      }
+      break;
+
+    case OpType::WriteToPointer:
+    {
+      const u32 ptr = PowerPC::HostRead_U32(op.address);
+      if (op.size == DATATYPE_8BIT)
+        PowerPC::HostWrite_U8(op.data & 0xFF, ptr + (op.data >> 8));
+      else if (op.size == DATATYPE_16BIT)
+        PowerPC::HostWrite_U16(op.data & 0xFFFF, ptr + ((op.data >> 16) << 1));
+      else
+        PowerPC::HostWrite_U32(op.data, ptr);
+      break;
+    }
+
+    case OpType::Add:
+      if (op.size == DATATYPE_32BIT_FLOAT)
+      {
+        const u32 read = PowerPC::HostRead_U32(op.address);
+        const float fread = reinterpret_cast<const float&>(read) + static_cast<float>(op.data);
+        PowerPC::HostWrite_U32(reinterpret_cast<const u32&>(fread), op.address);
+      }
+      else
+      {
+        WriteValue(op.size, ReadValue(op.size, op.address) + op.data, op.address);
+      }
+      break;
+
+    case OpType::Conditional:
+    {
+      const u32 mask = op.size == DATATYPE_8BIT ? 0xFF : op.size == DATATYPE_16BIT ? 0xFFFF : ~0u;
+      if (!CompareValues(ReadValue(op.size, op.address), op.data & mask, op.compare))
+        i = op.next_if_false;
+      break;
+    }
+
+    case OpType::FillAndSlide:
+    {
+      u32 value = op.data;
+      u32 address = op.address;
+      for (u32 j = 0; j < op.count; ++j)
+      {
+        WriteValue(op.size, value, address);
+        address += op.address_step;
+        value += op.value_step;
+      }
+      break;
+    }
+
+    case OpType::MemoryCopy:
+      for (u32 j = 0; j < op.count; ++j)
+        PowerPC::HostWrite_U8(PowerPC::HostRead_U8(op.data + j), op.address + j);
+      break;
+    }
+  }
+}
+
 void RunAllActive()
 {
   if (!SConfig::GetInstance().bEnableCheats)
@@ -940,14 +1243,32 @@ void RunAllActive()
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard<std::mutex> guard(s_lock);
+  const u64 start_time = Common::Timer::GetTimeUs();
+
+  // The codes are interpreted the first time they run, so that what they do can be logged.
+  const bool interpret = !s_disable_logging;
   s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
+                                      [interpret](const ActiveCode& code) {
+                                        if (code.compiled && !interpret)
+                                        {
+                                          RunCompiledCode(code.ops);
+                                          return false;
+                                        }
+
+                                        bool success = RunCodeLocked(code.code);
                                         LogInfo("\n");
                                         return !success;
                                       }),
                        s_active_codes.end());
   s_disable_logging = true;
+
+  const u64 run_time = Common::Timer::GetTimeUs() - start_time;
+  if (run_time > SLOW_RUN_TIME_US && !s_slow_run_logged)
+  {
+    WARN_LOG(ACTIONREPLAY, "Running %zu Action Replay codes took %" PRIu64 " us this frame",
+             s_active_codes.size(), run_time);
+    s_slow_run_logged = true;
+  }
 }
 
 }  // namespace ActionReplay
@@ -17,6 +17,7 @@
 #include "Common/CPUDetect.h"
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/GCPad.h"
@@ -30,6 +31,7 @@
 namespace
 {
 constexpr const char* ANALYTICS_ENDPOINT = "https://analytics.dolphin-emu.org/report";
+constexpr const char* ANALYTICS_OFFLINE_QUEUE_DIR = "Analytics/";
 }  // namespace
 
 std::mutex DolphinAnalytics::s_instance_mutex;
@@ -37,6 +39,7 @@ std::shared_ptr<DolphinAnalytics> DolphinAnalytics::s_instance;
 
 DolphinAnalytics::DolphinAnalytics()
 {
+  m_reporter.SetOfflineQueueDirectory(File::GetUserPath(D_CACHE_IDX) + ANALYTICS_OFFLINE_QUEUE_DIR);
   ReloadConfig();
   MakeBaseBuilder();
 }
@@ -44,6 +44,7 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SignatureDB/SignatureDB.h"
 
 #include "DiscIO/Enums.h"
 #include "DiscIO/NANDContentLoader.h"
@@ -69,7 +70,7 @@ std::unique_ptr<BootParameters> BootParameters::GenerateFromFile(const std::stri
   std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
   static const std::unordered_set<std::string> disc_image_extensions = {
-      {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".dol", ".elf"}};
+      {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".wcz", ".dol", ".elf"}};
   if (disc_image_extensions.find(extension) != disc_image_extensions.end() || is_drive)
   {
     std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateVolumeFromFilename(path);
@@ -181,6 +182,21 @@ bool CBoot::LoadMapFromFilename()
   return false;
 }
 
+bool CBoot::FindLibraryFunctions()
+{
+  if (!SConfig::GetInstance().bHLELibraryFunctions)
+    return false;
+
+  SignatureDB db(SignatureDB::HandlerType::DSY);
+  if (!db.Load(File::GetSysDirectory() + TOTALDB))
+    return false;
+
+  PPCAnalyst::FindFunctions(0x80000000, 0x81800000, &g_symbolDB);
+  db.Apply(&g_symbolDB);
+  UpdateDebugger_MapLoaded();
+  return true;
+}
+
 // If ipl.bin is not found, this function does *some* of what BS1 does:
 // loading IPL(BS2) and jumping to it.
 // It does not initialize the hardware or anything else like BS1 does.
@@ -310,7 +326,7 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
 
       // Try to load the symbol map if there is one, and then scan it for
       // and eventually replace code
-      if (LoadMapFromFilename())
+      if (LoadMapFromFilename() || FindLibraryFunctions())
         HLE::PatchFunctions();
 
       return true;
@@ -348,7 +364,7 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
 
       PC = executable.reader->GetEntryPoint();
 
-      if (executable.reader->LoadSymbols() || LoadMapFromFilename())
+      if (executable.reader->LoadSymbols() || LoadMapFromFilename() || FindLibraryFunctions())
       {
         UpdateDebugger_MapLoaded();
         HLE::PatchFunctions();
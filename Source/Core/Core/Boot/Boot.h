@@ -92,6 +92,10 @@ public:
   static bool LoadMapFromFilename();
 
 private:
+  // Names functions with the signature database so that HLE can replace library functions in
+  // games without a symbol map. Only done when bHLELibraryFunctions is set.
+  static bool FindLibraryFunctions();
+
   static bool DVDRead(const DiscIO::Volume& volume, u64 dvd_offset, u32 output_address, u32 length,
                       const DiscIO::Partition& partition);
   static void RunFunction(u32 address);
@@ -81,8 +81,11 @@ private:
   bool bAccurateNaNs;
   bool bMMU;
   bool bDCBZOFF;
+  bool bAccurateCPUCache;
+  bool bHLELibraryFunctions;
   bool bLowDCBZHack;
   bool m_EnableJIT;
+  int iDSPThreadSyncCycles;
   bool bSyncGPU;
   bool bFastDiscSpeed;
   bool bDSPHLE;
@@ -112,7 +115,10 @@ void ConfigCache::SaveConfig(const SConfig& config)
   bAccurateNaNs = config.bAccurateNaNs;
   bMMU = config.bMMU;
   bDCBZOFF = config.bDCBZOFF;
+  bAccurateCPUCache = config.bAccurateCPUCache;
+  bHLELibraryFunctions = config.bHLELibraryFunctions;
   m_EnableJIT = config.m_DSPEnableJIT;
+  iDSPThreadSyncCycles = config.m_DSPThreadSyncCycles;
   bSyncGPU = config.bSyncGPU;
   bFastDiscSpeed = config.bFastDiscSpeed;
   bDSPHLE = config.bDSPHLE;
@@ -152,8 +158,11 @@ void ConfigCache::RestoreConfig(SConfig* config)
   config->bAccurateNaNs = bAccurateNaNs;
   config->bMMU = bMMU;
   config->bDCBZOFF = bDCBZOFF;
+  config->bAccurateCPUCache = bAccurateCPUCache;
+  config->bHLELibraryFunctions = bHLELibraryFunctions;
   config->bLowDCBZHack = bLowDCBZHack;
   config->m_DSPEnableJIT = m_EnableJIT;
+  config->m_DSPThreadSyncCycles = iDSPThreadSyncCycles;
   config->bSyncGPU = bSyncGPU;
   config->bFastDiscSpeed = bFastDiscSpeed;
   config->bDSPHLE = bDSPHLE;
@@ -251,6 +260,9 @@ bool BootCore(std::unique_ptr<BootParameters> boot)
     core_section->Get("MMU", &StartUp.bMMU, StartUp.bMMU);
     core_section->Get("DCBZ", &StartUp.bDCBZOFF, StartUp.bDCBZOFF);
     core_section->Get("LowDCBZHack", &StartUp.bLowDCBZHack, StartUp.bLowDCBZHack);
+    core_section->Get("AccurateCPUCache", &StartUp.bAccurateCPUCache, StartUp.bAccurateCPUCache);
+    core_section->Get("HLELibraryFunctions", &StartUp.bHLELibraryFunctions,
+                      StartUp.bHLELibraryFunctions);
     core_section->Get("SyncGPU", &StartUp.bSyncGPU, StartUp.bSyncGPU);
     core_section->Get("FastDiscSpeed", &StartUp.bFastDiscSpeed, StartUp.bFastDiscSpeed);
     core_section->Get("DSPHLE", &StartUp.bDSPHLE, StartUp.bDSPHLE);
@@ -264,6 +276,8 @@ bool BootCore(std::unique_ptr<BootParameters> boot)
     if (dsp_section->Get("Volume", &StartUp.m_Volume, StartUp.m_Volume))
       config_cache.bSetVolume = true;
     dsp_section->Get("EnableJIT", &StartUp.m_DSPEnableJIT, StartUp.m_DSPEnableJIT);
+    dsp_section->Get("ThreadSyncCycles", &StartUp.m_DSPThreadSyncCycles,
+                     StartUp.m_DSPThreadSyncCycles);
     dsp_section->Get("Backend", &StartUp.sBackend, StartUp.sBackend);
     VideoBackendBase::ActivateBackend(StartUp.m_strVideoBackend);
     core_section->Get("GPUDeterminismMode", &StartUp.m_strGPUDeterminismMode,
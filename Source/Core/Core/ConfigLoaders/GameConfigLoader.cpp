@@ -120,6 +120,7 @@ static const INIToLocationMap& GetINIToLocationMap()
       {{"Video", "PH_ZNear"}, {Config::GFX_PROJECTION_HACK_ZNEAR.location}},
       {{"Video", "PH_ZFar"}, {Config::GFX_PROJECTION_HACK_ZFAR.location}},
       {{"Video", "PerfQueriesEnable"}, {Config::GFX_PERF_QUERIES_ENABLE.location}},
+      {{"Video", "PerfQueriesDelayed"}, {Config::GFX_PERF_QUERIES_DELAYED.location}},
 
       {{"Core", "ProgressiveScan"}, {Config::SYSCONF_PROGRESSIVE_SCAN.location}},
       {{"Core", "PAL60"}, {Config::SYSCONF_PAL60.location}},
@@ -23,7 +23,8 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
   const static std::vector<Config::ConfigLocation> s_setting_saveable{
       // Graphics.Hardware
 
-      Config::GFX_VSYNC.location, Config::GFX_ADAPTER.location,
+      Config::GFX_VSYNC.location, Config::GFX_NON_BLOCKING_PRESENT.location,
+      Config::GFX_ADAPTER.location,
 
       // Graphics.Settings
 
@@ -31,30 +32,36 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_CROP.location, Config::GFX_USE_XFB.location, Config::GFX_USE_REAL_XFB.location,
       Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES.location, Config::GFX_SHOW_FPS.location,
       Config::GFX_SHOW_NETPLAY_PING.location, Config::GFX_SHOW_NETPLAY_MESSAGES.location,
+      Config::GFX_SHOW_AUDIO_STATS.location,
       Config::GFX_LOG_RENDER_TIME_TO_FILE.location, Config::GFX_OVERLAY_STATS.location,
+      Config::GFX_OVERLAY_STAGE_TIMINGS.location,
       Config::GFX_OVERLAY_PROJ_STATS.location, Config::GFX_DUMP_TEXTURES.location,
       Config::GFX_HIRES_TEXTURES.location, Config::GFX_CONVERT_HIRES_TEXTURES.location,
-      Config::GFX_CACHE_HIRES_TEXTURES.location, Config::GFX_DUMP_EFB_TARGET.location,
+      Config::GFX_CACHE_HIRES_TEXTURES.location, Config::GFX_ASYNC_HIRES_TEXTURES.location,
+      Config::GFX_PNG_COMPRESSION_LEVEL.location, Config::GFX_DUMP_EFB_TARGET.location,
       Config::GFX_DUMP_FRAMES_AS_IMAGES.location, Config::GFX_FREE_LOOK.location,
       Config::GFX_USE_FFV1.location, Config::GFX_DUMP_FORMAT.location,
       Config::GFX_DUMP_CODEC.location, Config::GFX_DUMP_PATH.location,
       Config::GFX_BITRATE_KBPS.location, Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS.location,
       Config::GFX_ENABLE_GPU_TEXTURE_DECODING.location, Config::GFX_ENABLE_PIXEL_LIGHTING.location,
       Config::GFX_FAST_DEPTH_CALC.location, Config::GFX_MSAA.location, Config::GFX_SSAA.location,
-      Config::GFX_EFB_SCALE.location, Config::GFX_TEXFMT_OVERLAY_ENABLE.location,
+      Config::GFX_EFB_SCALE.location, Config::GFX_DYNAMIC_RESOLUTION_FRAME_TIME.location,
+      Config::GFX_TEXFMT_OVERLAY_ENABLE.location,
       Config::GFX_TEXFMT_OVERLAY_CENTER.location, Config::GFX_ENABLE_WIREFRAME.location,
       Config::GFX_DISABLE_FOG.location, Config::GFX_BORDERLESS_FULLSCREEN.location,
       Config::GFX_ENABLE_VALIDATION_LAYER.location, Config::GFX_BACKEND_MULTITHREADING.location,
-      Config::GFX_COMMAND_BUFFER_EXECUTE_INTERVAL.location, Config::GFX_SHADER_CACHE.location,
+      Config::GFX_COMMAND_BUFFER_EXECUTE_INTERVAL.location,
+      Config::GFX_COMMAND_RECORDING_THREADS.location, Config::GFX_SHADER_CACHE.location,
       Config::GFX_BACKGROUND_SHADER_COMPILING.location,
       Config::GFX_DISABLE_SPECIALIZED_SHADERS.location,
       Config::GFX_PRECOMPILE_UBER_SHADERS.location, Config::GFX_SHADER_COMPILER_THREADS.location,
-      Config::GFX_SHADER_PRECOMPILER_THREADS.location,
+      Config::GFX_SHADER_PRECOMPILER_THREADS.location, Config::GFX_VERTEX_LOADER_THREADS.location,
+      Config::GFX_VERTEX_LOADER_CACHE.location,
 
       Config::GFX_SW_ZCOMPLOC.location, Config::GFX_SW_ZFREEZE.location,
       Config::GFX_SW_DUMP_OBJECTS.location, Config::GFX_SW_DUMP_TEV_STAGES.location,
       Config::GFX_SW_DUMP_TEV_TEX_FETCHES.location, Config::GFX_SW_DRAW_START.location,
-      Config::GFX_SW_DRAW_END.location,
+      Config::GFX_SW_DRAW_END.location, Config::GFX_SW_RASTERIZER_THREADS.location,
 
       // Graphics.Enhancements
 
@@ -70,10 +77,12 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
 
       // Graphics.Hacks
 
-      Config::GFX_HACK_EFB_ACCESS_ENABLE.location, Config::GFX_HACK_BBOX_ENABLE.location,
+      Config::GFX_HACK_EFB_ACCESS_ENABLE.location, Config::GFX_HACK_EFB_DEFER_INVALIDATION.location,
+      Config::GFX_HACK_BBOX_ENABLE.location,
       Config::GFX_HACK_BBOX_PREFER_STENCIL_IMPLEMENTATION.location,
+      Config::GFX_HACK_BBOX_DEFER_READBACK.location,
       Config::GFX_HACK_FORCE_PROGRESSIVE.location, Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM.location,
-      Config::GFX_HACK_COPY_EFB_ENABLED.location,
+      Config::GFX_HACK_COPY_EFB_ENABLED.location, Config::GFX_HACK_DEFER_EFB_COPIES.location,
       Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES.location,
       Config::GFX_HACK_VERTEX_ROUDING.location,
 
@@ -82,6 +91,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_PROJECTION_HACK.location, Config::GFX_PROJECTION_HACK_SZNEAR.location,
       Config::GFX_PROJECTION_HACK_SZFAR.location, Config::GFX_PROJECTION_HACK_ZNEAR.location,
       Config::GFX_PROJECTION_HACK_ZFAR.location, Config::GFX_PERF_QUERIES_ENABLE.location,
+      Config::GFX_PERF_QUERIES_DELAYED.location,
 
   };
 
@@ -4,10 +4,14 @@
 
 #include "Core/ConfigManager.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cinttypes>
 #include <climits>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <sstream>
 #include <variant>
 
@@ -237,15 +241,35 @@ void SConfig::SaveCoreSettings(IniFile& ini)
 
   core->Set("SkipIPL", bHLE_BS2);
   core->Set("TimingVariance", iTimingVariance);
+  core->Set("ThrottleSpinTime", iThrottleSpinTime);
   core->Set("CPUCore", iCPUCore);
   core->Set("Fastmem", bFastmem);
+  core->Set("HugePages", bHugePages);
+  core->Set("PinThreads", bPinThreads);
   core->Set("CPUThread", bCPUThread);
+  core->Set("JITBlockDiskCache", bJITBlockDiskCache);
+  core->Set("JITTieredCompilation", bJITTieredCompilation);
+  core->Set("JITTierUpThreshold", iJITTierUpThreshold);
+  core->Set("JITSuperblocks", bJITSuperblocks);
+  core->Set("JITCrossBlockLiveness", bJITCrossBlockLiveness);
+  core->Set("JITSpinLoopDetection", bJITSpinLoopDetection);
+  core->Set("JITLoadForwarding", bJITLoadForwarding);
+  core->Set("InterpreterPredecode", bInterpreterPredecode);
   core->Set("DSPHLE", bDSPHLE);
   core->Set("SyncOnSkipIdle", bSyncGPUOnSkipIdleHack);
   core->Set("SyncGPU", bSyncGPU);
   core->Set("SyncGpuMaxDistance", iSyncGpuMaxDistance);
   core->Set("SyncGpuMinDistance", iSyncGpuMinDistance);
+  core->Set("SyncGpuAdaptive", bSyncGpuAdaptive);
   core->Set("SyncGpuOverclock", fSyncGpuOverclock);
+  core->Set("FifoDecoderThread", bFifoDecoderThread);
+  core->Set("DisplayListCache", bDisplayListCache);
+  core->Set("Rewind", bRewind);
+  core->Set("RewindInterval", iRewindInterval);
+  core->Set("RewindMemoryMB", iRewindMemoryMB);
+  core->Set("RunAheadFrames", iRunAheadFrames);
+  core->Set("PersistentSession", bPersistentSession);
+  core->Set("SmallSavestates", bSmallSavestates);
   core->Set("FPRF", bFPRF);
   core->Set("AccurateNaNs", bAccurateNaNs);
   core->Set("DefaultISO", m_strDefaultISO);
@@ -256,6 +280,7 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("AudioLatency", iLatency);
   core->Set("AudioStretch", m_audio_stretch);
   core->Set("AudioStretchMaxLatency", m_audio_stretch_max_latency);
+  core->Set("AudioPacing", m_audio_pacing);
   core->Set("MemcardAPath", m_strMemoryCardA);
   core->Set("MemcardBPath", m_strMemoryCardB);
   core->Set("AgpCartAPath", m_strGbaCartA);
@@ -311,6 +336,8 @@ void SConfig::SaveDSPSettings(IniFile& ini)
   dsp->Set("Backend", sBackend);
   dsp->Set("Volume", m_Volume);
   dsp->Set("CaptureLog", m_DSPCaptureLog);
+  dsp->Set("ThreadSyncCycles", m_DSPThreadSyncCycles);
+  dsp->Set("ZeldaParallelVoices", m_DSPZeldaParallelVoices);
 }
 
 void SConfig::SaveInputSettings(IniFile& ini)
@@ -318,6 +345,7 @@ void SConfig::SaveInputSettings(IniFile& ini)
   IniFile::Section* input = ini.GetOrCreateSection("Input");
 
   input->Set("BackgroundInput", m_BackgroundInput);
+  input->Set("PollingRate", m_InputPollingRate);
 }
 
 void SConfig::SaveFifoPlayerSettings(IniFile& ini)
@@ -526,9 +554,25 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("CPUCore", &iCPUCore, PowerPC::CORE_INTERPRETER);
 #endif
   core->Get("Fastmem", &bFastmem, true);
+  core->Get("HugePages", &bHugePages, false);
+#ifdef ANDROID
+  // Keeps the emulation threads off the LITTLE cores of big.LITTLE CPUs.
+  core->Get("PinThreads", &bPinThreads, true);
+#else
+  core->Get("PinThreads", &bPinThreads, false);
+#endif
   core->Get("DSPHLE", &bDSPHLE, true);
   core->Get("TimingVariance", &iTimingVariance, 40);
+  core->Get("ThrottleSpinTime", &iThrottleSpinTime, 200);
   core->Get("CPUThread", &bCPUThread, true);
+  core->Get("JITBlockDiskCache", &bJITBlockDiskCache, false);
+  core->Get("JITTieredCompilation", &bJITTieredCompilation, false);
+  core->Get("JITTierUpThreshold", &iJITTierUpThreshold, 64);
+  core->Get("JITSuperblocks", &bJITSuperblocks, false);
+  core->Get("JITCrossBlockLiveness", &bJITCrossBlockLiveness, false);
+  core->Get("JITSpinLoopDetection", &bJITSpinLoopDetection, false);
+  core->Get("JITLoadForwarding", &bJITLoadForwarding, false);
+  core->Get("InterpreterPredecode", &bInterpreterPredecode, false);
   core->Get("SyncOnSkipIdle", &bSyncGPUOnSkipIdleHack, true);
   core->Get("DefaultISO", &m_strDefaultISO);
   core->Get("EnableCheats", &bEnableCheats, false);
@@ -538,6 +582,7 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("AudioLatency", &iLatency, 20);
   core->Get("AudioStretch", &m_audio_stretch, false);
   core->Get("AudioStretchMaxLatency", &m_audio_stretch_max_latency, 80);
+  core->Get("AudioPacing", &m_audio_pacing, false);
   core->Get("MemcardAPath", &m_strMemoryCardA);
   core->Get("MemcardBPath", &m_strMemoryCardB);
   core->Get("AgpCartAPath", &m_strGbaCartA);
@@ -564,10 +609,21 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("SyncGPU", &bSyncGPU, false);
   core->Get("SyncGpuMaxDistance", &iSyncGpuMaxDistance, 200000);
   core->Get("SyncGpuMinDistance", &iSyncGpuMinDistance, -200000);
+  core->Get("SyncGpuAdaptive", &bSyncGpuAdaptive, false);
   core->Get("SyncGpuOverclock", &fSyncGpuOverclock, 1.0f);
+  core->Get("FifoDecoderThread", &bFifoDecoderThread, false);
+  core->Get("DisplayListCache", &bDisplayListCache, false);
+  core->Get("Rewind", &bRewind, false);
+  core->Get("RewindInterval", &iRewindInterval, 60);
+  core->Get("RewindMemoryMB", &iRewindMemoryMB, 256);
+  core->Get("RunAheadFrames", &iRunAheadFrames, 0);
+  core->Get("PersistentSession", &bPersistentSession, false);
+  core->Get("SmallSavestates", &bSmallSavestates, false);
   core->Get("FastDiscSpeed", &bFastDiscSpeed, false);
   core->Get("DCBZ", &bDCBZOFF, false);
   core->Get("LowDCBZHack", &bLowDCBZHack, false);
+  core->Get("AccurateCPUCache", &bAccurateCPUCache, false);
+  core->Get("HLELibraryFunctions", &bHLELibraryFunctions, false);
   core->Get("FPRF", &bFPRF, false);
   core->Get("AccurateNaNs", &bAccurateNaNs, false);
   core->Get("EmulationSpeed", &m_EmulationSpeed, 1.0f);
@@ -606,6 +662,8 @@ void SConfig::LoadDSPSettings(IniFile& ini)
   dsp->Get("Backend", &sBackend, AudioCommon::GetDefaultSoundBackend());
   dsp->Get("Volume", &m_Volume, 100);
   dsp->Get("CaptureLog", &m_DSPCaptureLog, false);
+  dsp->Get("ThreadSyncCycles", &m_DSPThreadSyncCycles, 0);
+  dsp->Get("ZeldaParallelVoices", &m_DSPZeldaParallelVoices, false);
 
   m_IsMuted = false;
 }
@@ -615,6 +673,7 @@ void SConfig::LoadInputSettings(IniFile& ini)
   IniFile::Section* input = ini.GetOrCreateSection("Input");
 
   input->Get("BackgroundInput", &m_BackgroundInput, false);
+  input->Get("PollingRate", &m_InputPollingRate, 0);
 }
 
 void SConfig::LoadFifoPlayerSettings(IniFile& ini)
@@ -767,18 +826,28 @@ void SConfig::LoadDefaults()
 
   iCPUCore = PowerPC::DefaultCPUCore();
   iTimingVariance = 40;
+  iThrottleSpinTime = 200;
   bCPUThread = false;
   bSyncGPUOnSkipIdleHack = true;
   bRunCompareServer = false;
   bDSPHLE = true;
   bFastmem = true;
+  bHugePages = false;
+#ifdef ANDROID
+  bPinThreads = true;
+#else
+  bPinThreads = false;
+#endif
   bFPRF = false;
   bAccurateNaNs = false;
   bMMU = false;
   bDCBZOFF = false;
   bLowDCBZHack = false;
+  bAccurateCPUCache = false;
+  bHLELibraryFunctions = false;
   iBBDumpPort = -1;
   bSyncGPU = false;
+  bSyncGpuAdaptive = false;
   bFastDiscSpeed = false;
   m_strWiiSDCardPath = File::GetUserPath(F_WIISDCARD_IDX);
   bEnableMemcardSdWriting = true;
@@ -789,6 +858,7 @@ void SConfig::LoadDefaults()
   iLatency = 20;
   m_audio_stretch = false;
   m_audio_stretch_max_latency = 80;
+  m_audio_pacing = false;
 
   iPosX = INT_MIN;
   iPosY = INT_MIN;
@@ -1034,11 +1104,51 @@ IniFile SConfig::LoadGameIni() const
   return LoadGameIni(GetGameID(), m_revision);
 }
 
+// Most of the candidate names of a game don't exist in the Sys GameSettings directory, which
+// holds well over a thousand files and is looked up for every game in the game list. It never
+// changes while Dolphin is running, so its contents are listed once instead of trying to open
+// every candidate. Names are lowercased, since not all file systems are case sensitive.
+static std::string LowercaseFilename(std::string filename)
+{
+  std::transform(filename.begin(), filename.end(), filename.begin(),
+                 [](char c) { return static_cast<char>(std::tolower(static_cast<u8>(c))); });
+  return filename;
+}
+
+static bool SysGameIniExists(const std::string& filename)
+{
+  static std::mutex s_mutex;
+  static std::set<std::string> s_filenames;
+  static bool s_scanned = false;
+
+  std::lock_guard<std::mutex> lk(s_mutex);
+  if (!s_scanned)
+  {
+    const File::FSTEntry entries =
+        File::ScanDirectoryTree(File::GetSysDirectory() + GAMESETTINGS_DIR, false);
+    for (const File::FSTEntry& entry : entries.children)
+    {
+      if (!entry.isDirectory)
+        s_filenames.insert(LowercaseFilename(entry.virtualName));
+    }
+    s_scanned = true;
+  }
+  return s_filenames.count(LowercaseFilename(filename)) != 0;
+}
+
+static void LoadSysGameIni(IniFile* game_ini, const std::string& id, std::optional<u16> revision)
+{
+  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
+  {
+    if (SysGameIniExists(filename))
+      game_ini->Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+  }
+}
+
 IniFile SConfig::LoadDefaultGameIni(const std::string& id, std::optional<u16> revision)
 {
   IniFile game_ini;
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+  LoadSysGameIni(&game_ini, id, revision);
   return game_ini;
 }
 
@@ -1053,8 +1163,7 @@ IniFile SConfig::LoadLocalGameIni(const std::string& id, std::optional<u16> revi
 IniFile SConfig::LoadGameIni(const std::string& id, std::optional<u16> revision)
 {
   IniFile game_ini;
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+  LoadSysGameIni(&game_ini, id, revision);
   for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
     game_ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
   return game_ini;
@@ -91,12 +91,29 @@ struct SConfig : NonCopyable
   bool bJITPairedOff = false;
   bool bJITSystemRegistersOff = false;
   bool bJITBranchOff = false;
+  bool bJITBlockDiskCache = false;
+  bool bJITTieredCompilation = false;
+  int iJITTierUpThreshold = 64;
+  bool bJITSuperblocks = false;
+  bool bJITCrossBlockLiveness = false;
+  bool bJITSpinLoopDetection = false;
+  bool bJITLoadForwarding = false;
+  bool bInterpreterPredecode = false;
 
   bool bFastmem;
+  // Asks the host to back emulated RAM and the JIT code space with huge pages, which reduces TLB
+  // misses. Currently only has an effect on Linux with transparent huge pages.
+  bool bHugePages = false;
+  // Gives the CPU, GPU and DSP LLE threads a physical core each, so that the scheduler doesn't
+  // migrate them. Only the cores the process is allowed to run on are used.
+  bool bPinThreads = false;
   bool bFPRF = false;
   bool bAccurateNaNs = false;
 
   int iTimingVariance = 40;  // in milli secounds
+  // The end of every wait of the speed limiter spins for this many microseconds instead of
+  // sleeping, which hides the wakeup latency of the OS.
+  int iThrottleSpinTime = 200;
   bool bCPUThread = true;
   bool bDSPThread = false;
   bool bDSPHLE = true;
@@ -111,6 +128,7 @@ struct SConfig : NonCopyable
   int iLatency = 20;
   bool m_audio_stretch = false;
   int m_audio_stretch_max_latency = 80;
+  bool m_audio_pacing = false;
 
   bool bRunCompareServer = false;
   bool bRunCompareClient = false;
@@ -118,13 +136,37 @@ struct SConfig : NonCopyable
   bool bMMU = false;
   bool bDCBZOFF = false;
   bool bLowDCBZHack = false;
+  bool bAccurateCPUCache = false;
+  bool bHLELibraryFunctions = false;
   int iBBDumpPort = 0;
   bool bFastDiscSpeed = false;
 
   bool bSyncGPU = false;
   int iSyncGpuMaxDistance;
   int iSyncGpuMinDistance;
+  // Tunes the distance at run time, using SyncGpuMaxDistance as the upper limit.
+  bool bSyncGpuAdaptive = false;
   float fSyncGpuOverclock;
+  bool bFifoDecoderThread = false;
+  // Keeps the parsed commands of display lists around for when they're called again.
+  bool bDisplayListCache = false;
+
+  // Rewind takes a savestate every iRewindInterval VI fields and keeps as many as fit in
+  // iRewindMemoryMB.
+  bool bRewind = false;
+  int iRewindInterval = 60;
+  int iRewindMemoryMB = 256;
+
+  // Run-ahead emulates this many VI fields past the one that is shown and rolls them back every
+  // field, which hides that many fields of the game's own input lag. Single core only.
+  int iRunAheadFrames = 0;
+
+  // Lets the video backend keep its host device, swap chain and compiled shaders from one boot
+  // to the next, for hosts which boot many games or tests in a row on the same render window.
+  bool bPersistentSession = false;
+
+  // Compress savestates with zlib instead of LZO, which is slower but makes them smaller.
+  bool bSmallSavestates = false;
 
   int SelectedLanguage = 0;
   bool bOverrideGCLanguage = false;
@@ -191,6 +233,10 @@ struct SConfig : NonCopyable
 
   std::string m_perfDir;
 
+  // Set from the command line: the JIT warm-up list to compile blocks from at boot, and to
+  // update at shutdown. See JitInterface::ReadWarmupList.
+  std::string m_strJITWarmupList;
+
   std::string m_debugger_game_id;
   // TODO: remove this as soon as the ticket view hack in IOS/ES/Views is dropped.
   bool m_disc_booted_from_game_list = false;
@@ -287,6 +333,8 @@ struct SConfig : NonCopyable
   bool m_ShowFrameCount;
   bool m_ShowRTC;
   std::string m_strMovieAuthor;
+  // The number of frames which aren't drawn or presented for every one that is, while the speed
+  // limit is off.
   unsigned int m_FrameSkip;
   bool m_DumpFrames;
   bool m_DumpFramesSilent;
@@ -299,6 +347,10 @@ struct SConfig : NonCopyable
   // DSP settings
   bool m_DSPEnableJIT;
   bool m_DSPCaptureLog;
+  // How many DSP cycles the DSP LLE thread may fall behind the CPU before the CPU waits for it.
+  int m_DSPThreadSyncCycles;
+  // Render the voices of the Zelda ucode HLE on several threads.
+  bool m_DSPZeldaParallelVoices;
   bool m_DumpAudio;
   bool m_DumpAudioSilent;
   bool m_IsMuted;
@@ -308,6 +360,9 @@ struct SConfig : NonCopyable
 
   // Input settings
   bool m_BackgroundInput;
+  // How often per second the GameCube controllers are polled on a thread of their own, or 0 to
+  // poll them on the CPU thread whenever the game reads them.
+  u32 m_InputPollingRate;
   bool m_AdapterRumble[4];
   bool m_AdapterKonga[4];
 
@@ -24,6 +24,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
 #include "Common/Logging/LogManager.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
@@ -33,6 +34,8 @@
 
 #include "Core/Analytics.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
@@ -71,9 +74,11 @@
 #include "InputCommon/GCAdapter.h"
 
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoConfig.h"
 
 // Android and OSX haven't implemented the keyword yet.
 #if defined __ANDROID__ || defined __APPLE__
@@ -90,6 +95,9 @@ static bool s_wants_determinism;
 static Common::Timer s_timer;
 static std::atomic<u32> s_drawn_frame;
 static std::atomic<u32> s_drawn_video;
+// When the emulation thread started, to log how long it took until the first frame was drawn
+static u64 s_boot_start_time;
+static Common::Flag s_first_frame_drawn;
 
 static bool s_is_stopping = false;
 static bool s_hardware_initialized = false;
@@ -326,10 +334,32 @@ static void CPUSetInitialExecutionState()
   });
 }
 
+void PinCurrentThread(HotThread thread)
+{
+  if (!SConfig::GetInstance().bPinThreads)
+    return;
+
+  static const char* const names[] = {"CPU", "GPU", "DSP"};
+  const size_t index = static_cast<size_t>(thread);
+  const std::vector<int> cores = Common::GetPhysicalCores();
+  if (index >= cores.size())
+  {
+    WARN_LOG(CORE, "Not pinning the %s thread, only %zu physical cores are available",
+             names[index], cores.size());
+    return;
+  }
+
+  if (Common::SetCurrentThreadAffinityToCPU(cores[index]))
+    INFO_LOG(CORE, "Pinned the %s thread to CPU %d", names[index], cores[index]);
+  else
+    WARN_LOG(CORE, "Failed to pin the %s thread to CPU %d", names[index], cores[index]);
+}
+
 // Create the CPU thread, which is a CPU + Video thread in Single Core mode.
 static void CpuThread()
 {
   DeclareAsCPUThread();
+  PinCurrentThread(HotThread::CPU);
 
   const SConfig& _CoreParameter = SConfig::GetInstance();
 
@@ -401,6 +431,7 @@ static void CpuThread()
 static void FifoPlayerThread()
 {
   DeclareAsCPUThread();
+  PinCurrentThread(HotThread::CPU);
   const SConfig& _CoreParameter = SConfig::GetInstance();
 
   if (_CoreParameter.bCPUThread)
@@ -471,13 +502,33 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
 
   Common::SetCurrentThreadName("Emuthread - Starting");
 
+  s_boot_start_time = Common::Timer::GetTimeUs();
+  s_first_frame_drawn.Clear();
+  u64 phase_start_time = s_boot_start_time;
+  const auto end_boot_phase = [&phase_start_time](const char* phase) {
+    const u64 now = Common::Timer::GetTimeUs();
+    INFO_LOG(BOOT, "%s took %.1f ms", phase, (now - phase_start_time) / 1000.0);
+    phase_start_time = now;
+  };
+
+  // Nothing else during the boot depends on the list of custom textures, so the texture
+  // directory is scanned while the hardware and the video backend are initialized.
+  if (Config::Get(Config::GFX_HIRES_TEXTURES))
+    HiresTexture::StartIndexing(core_parameter.GetGameID());
+
   // For a time this acts as the CPU thread...
   DeclareAsCPUThread();
 
   Movie::Init(*boot);
   Common::ScopeGuard movie_guard{Movie::Shutdown};
 
+  // The trace is only finished once HW::Shutdown has stopped the threads which write to it.
+  if (Config::Get(Config::MAIN_WRITE_TRACE))
+    Trace::Start(File::GetUserPath(D_LOGS_IDX) + TRACE_LOG);
+  Common::ScopeGuard trace_guard{Trace::Stop};
+
   HW::Init();
+  end_boot_phase("Hardware initialization");
   Common::ScopeGuard hw_guard{[] {
     // We must set up this flag before executing HW::Shutdown()
     s_hardware_initialized = false;
@@ -502,6 +553,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     return;
   }
   Common::ScopeGuard video_guard{[] { g_video_backend->Shutdown(); }};
+  end_boot_phase("Video backend initialization");
 
   OSD::AddMessage("Dolphin " + g_video_backend->GetName() + " Video Backend.", 5000);
 
@@ -515,6 +567,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     PanicAlert("Failed to initialize DSP emulation!");
     return;
   }
+  end_boot_phase("DSP initialization");
 
   bool init_controllers = false;
   if (!g_controller_interface.IsInit())
@@ -542,7 +595,10 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
       Wiimote::LoadConfig();
   }
 
+  Pad::StartPolling(SConfig::GetInstance().m_InputPollingRate);
+
   Common::ScopeGuard controller_guard{[init_controllers] {
+    Pad::StopPolling();
     if (!init_controllers)
       return;
 
@@ -552,8 +608,11 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     g_controller_interface.Shutdown();
   }};
 
+  end_boot_phase("Controller initialization");
+
   AudioCommon::InitSoundStream();
   Common::ScopeGuard audio_guard{AudioCommon::ShutdownSoundStream};
+  end_boot_phase("Audio initialization");
 
   // The hardware is initialized.
   s_hardware_initialized = true;
@@ -574,6 +633,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
 
   if (!CBoot::BootUp(std::move(boot)))
     return;
+  end_boot_phase("Loading the game");
 
   // This adds the SyncGPU handler to CoreTiming, so now CoreTiming::Advance might block.
   Fifo::Prepare();
@@ -604,12 +664,14 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     Common::SetCurrentThreadName("Video thread");
 
     g_video_backend->Video_Prepare();
+    end_boot_phase("Video backend preparation");
     Host_Message(WM_USER_CREATE);
 
     // Spawn the CPU thread
     s_cpu_thread = std::thread(cpuThreadFunc);
 
     // become the GPU thread
+    PinCurrentThread(HotThread::GPU);
     Fifo::RunGpuLoop();
 
     // We have now exited the Video Loop
@@ -858,6 +920,12 @@ void Callback_VideoCopiedToXFB(bool video_update)
   if (video_update)
     s_drawn_frame++;
 
+  if (s_first_frame_drawn.TestAndSet())
+  {
+    NOTICE_LOG(BOOT, "First frame drawn %.1f ms after the boot started",
+               (Common::Timer::GetTimeUs() - s_boot_start_time) / 1000.0);
+  }
+
   Movie::FrameUpdate();
 }
 
@@ -931,6 +999,16 @@ void UpdateTitle()
   {
     Mixer* pMixer = g_sound_stream->GetMixer();
     pMixer->UpdateSpeed((float)Speed / 100);
+
+    if (g_ActiveConfig.bShowAudioStats)
+    {
+      const Mixer::Statistics stats = pMixer->GetStatistics();
+      OSD::AddTypedMessage(OSD::MessageType::AudioStatistics,
+                           StringFromFormat("Audio: %.0f%% buffered - %.0f ms - %u underruns",
+                                            stats.fill_level * 100, stats.latency_ms,
+                                            stats.underruns),
+                           OSD::Duration::SHORT, OSD::Color::CYAN);
+    }
   }
 
   Host_UpdateTitle(message);
@@ -947,6 +1025,9 @@ void Shutdown()
   if (s_emu_thread.joinable())
     s_emu_thread.join();
 
+  if (g_video_backend)
+    g_video_backend->ReleasePersistentState();
+
   // Make sure there's nothing left over in case we're about to exit.
   HostDispatchJobs();
 }
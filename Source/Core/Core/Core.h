@@ -41,6 +41,17 @@ void Shutdown();
 void DeclareAsCPUThread();
 void UndeclareAsCPUThread();
 
+// The threads which run emulation all the time, in the order they get cores in.
+enum class HotThread
+{
+  CPU,
+  GPU,
+  DSP,
+};
+// Pins the calling thread to a physical core of its own if thread pinning is enabled. Does nothing
+// if the host doesn't have enough cores left.
+void PinCurrentThread(HotThread thread);
+
 std::string StopMessage(bool, const std::string&);
 
 bool IsRunning();
@@ -15,6 +15,8 @@
 #include "Common/ChunkFile.h"
 #include "Common/FifoQueue.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
+#include "Common/MPSCQueue.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 
@@ -31,6 +33,7 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  u32 trace_id;
 };
 
 struct Event
@@ -51,33 +54,74 @@ static bool operator<(const Event& left, const Event& right)
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
 }
 
-// unordered_map stores each element separately as a linked list node so pointers to elements
-// remain stable regardless of rehashes/resizing.
-static std::unordered_map<std::string, EventType> s_event_types;
+static constexpr size_t TS_RING_SIZE = 1024;
+static constexpr int MAX_SLICE_LENGTH = 20000;
 
-// STATE_TO_SAVE
-// The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-// We don't use std::priority_queue because we need to be able to serialize, unserialize and
-// erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-// by the standard adaptor class.
-static std::vector<Event> s_event_queue;
-static u64 s_event_fifo_id;
-static std::mutex s_ts_write_lock;
-static Common::FifoQueue<Event, false> s_ts_queue;
+// The scheduler of one emulated console.
+struct Instance
+{
+  // These really shouldn't be global, but jit64 accesses them directly
+  Globals globals{};
 
-static float s_last_OC_factor;
-static constexpr int MAX_SLICE_LENGTH = 20000;
+  // unordered_map stores each element separately as a linked list node so pointers to elements
+  // remain stable regardless of rehashes/resizing.
+  std::unordered_map<std::string, EventType> event_types;
 
-static s64 s_idled_cycles;
-static u32 s_fake_dec_start_value;
-static u64 s_fake_dec_start_ticks;
+  // STATE_TO_SAVE
+  // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
+  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
+  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
+  // by the standard adaptor class.
+  std::vector<Event> event_queue;
+  u64 event_fifo_id = 0;
 
-// Are we in a function that has been called from Advance()
-static bool s_is_global_timer_sane;
+  // Events scheduled from other threads go through a lock-free ring, which is drained into the
+  // main queue by MoveEvents(). Only when the CPU thread has fallen so far behind that the ring is
+  // full do they go to the mutex-protected overflow queue instead.
+  Common::MPSCQueue<Event, TS_RING_SIZE> ts_ring;
+  std::mutex ts_write_lock;
+  Common::FifoQueue<Event, false> ts_queue;
 
-Globals g;
+  float last_OC_factor = 1.0f;
 
-static EventType* s_ev_lost = nullptr;
+  s64 idled_cycles = 0;
+  u32 fake_dec_start_value = 0;
+  u64 fake_dec_start_ticks = 0;
+
+  // Are we in a function that has been called from Advance()
+  bool is_global_timer_sane = false;
+
+  EventType* ev_lost = nullptr;
+};
+
+static Instance s_default_instance;
+static thread_local Instance* s_instance = &s_default_instance;
+
+Instance* CreateInstance()
+{
+  return new Instance;
+}
+
+void DestroyInstance(Instance* instance)
+{
+  _assert_msg_(POWERPC, instance != s_instance, "Destroying the current CoreTiming instance");
+  delete instance;
+}
+
+void SetCurrentInstance(Instance* instance)
+{
+  s_instance = instance ? instance : &s_default_instance;
+}
+
+Instance* GetCurrentInstance()
+{
+  return s_instance;
+}
+
+Globals& GetGlobals()
+{
+  return s_instance->globals;
+}
 
 static void EmptyTimedCallback(u64 userdata, s64 cyclesLate)
 {
@@ -90,59 +134,66 @@ static void EmptyTimedCallback(u64 userdata, s64 cyclesLate)
 //
 // Technically it might be more accurate to call this changing the IPC instead of the CPU speed,
 // but the effect is largely the same.
-static int DowncountToCycles(int downcount)
+static int DowncountToCycles(const Instance& inst, int downcount)
 {
-  return static_cast<int>(downcount * g.last_OC_factor_inverted);
+  return static_cast<int>(downcount * inst.globals.last_OC_factor_inverted);
 }
 
-static int CyclesToDowncount(int cycles)
+static int CyclesToDowncount(const Instance& inst, int cycles)
 {
-  return static_cast<int>(cycles * s_last_OC_factor);
+  return static_cast<int>(cycles * inst.last_OC_factor);
 }
 
 EventType* RegisterEvent(const std::string& name, TimedCallback callback)
 {
+  Instance& inst = *s_instance;
   // check for existing type with same name.
   // we want event type names to remain unique so that we can use them for serialization.
-  _assert_msg_(POWERPC, s_event_types.find(name) == s_event_types.end(),
+  _assert_msg_(POWERPC, inst.event_types.find(name) == inst.event_types.end(),
                "CoreTiming Event \"%s\" is already registered. Events should only be registered "
                "during Init to avoid breaking save states.",
                name.c_str());
 
-  auto info = s_event_types.emplace(name, EventType{callback, nullptr});
+  const u32 trace_id = static_cast<u32>(inst.event_types.size());
+  auto info = inst.event_types.emplace(name, EventType{callback, nullptr, trace_id});
   EventType* event_type = &info.first->second;
   event_type->name = &info.first->first;
+  Trace::SetName(Trace::Event::CoreTimingBegin, trace_id, name);
   return event_type;
 }
 
 void UnregisterAllEvents()
 {
-  _assert_msg_(POWERPC, s_event_queue.empty(), "Cannot unregister events with events pending");
-  s_event_types.clear();
+  Instance& inst = *s_instance;
+  _assert_msg_(POWERPC, inst.event_queue.empty(), "Cannot unregister events with events pending");
+  inst.event_types.clear();
 }
 
 void Init()
 {
-  s_last_OC_factor = SConfig::GetInstance().m_OCEnable ? SConfig::GetInstance().m_OCFactor : 1.0f;
-  g.last_OC_factor_inverted = 1.0f / s_last_OC_factor;
-  PowerPC::ppcState.downcount = CyclesToDowncount(MAX_SLICE_LENGTH);
-  g.slice_length = MAX_SLICE_LENGTH;
-  g.global_timer = 0;
-  s_idled_cycles = 0;
+  Instance& inst = *s_instance;
+  inst.last_OC_factor =
+      SConfig::GetInstance().m_OCEnable ? SConfig::GetInstance().m_OCFactor : 1.0f;
+  inst.globals.last_OC_factor_inverted = 1.0f / inst.last_OC_factor;
+  PowerPC::ppcState.downcount = CyclesToDowncount(inst, MAX_SLICE_LENGTH);
+  inst.globals.slice_length = MAX_SLICE_LENGTH;
+  inst.globals.global_timer = 0;
+  inst.idled_cycles = 0;
 
   // The time between CoreTiming being intialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
   // executing the first PPC cycle of each slice to prepare the slice length and downcount for
   // that slice.
-  s_is_global_timer_sane = true;
+  inst.is_global_timer_sane = true;
 
-  s_event_fifo_id = 0;
-  s_ev_lost = RegisterEvent("_lost_event", &EmptyTimedCallback);
+  inst.event_fifo_id = 0;
+  inst.ev_lost = RegisterEvent("_lost_event", &EmptyTimedCallback);
 }
 
 void Shutdown()
 {
-  std::lock_guard<std::mutex> lk(s_ts_write_lock);
+  Instance& inst = *s_instance;
+  std::lock_guard<std::mutex> lk(inst.ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -150,22 +201,23 @@ void Shutdown()
 
 void DoState(PointerWrap& p)
 {
-  std::lock_guard<std::mutex> lk(s_ts_write_lock);
-  p.Do(g.slice_length);
-  p.Do(g.global_timer);
-  p.Do(s_idled_cycles);
-  p.Do(s_fake_dec_start_value);
-  p.Do(s_fake_dec_start_ticks);
-  p.Do(g.fake_TB_start_value);
-  p.Do(g.fake_TB_start_ticks);
-  p.Do(s_last_OC_factor);
-  g.last_OC_factor_inverted = 1.0f / s_last_OC_factor;
-  p.Do(s_event_fifo_id);
+  Instance& inst = *s_instance;
+  std::lock_guard<std::mutex> lk(inst.ts_write_lock);
+  p.Do(inst.globals.slice_length);
+  p.Do(inst.globals.global_timer);
+  p.Do(inst.idled_cycles);
+  p.Do(inst.fake_dec_start_value);
+  p.Do(inst.fake_dec_start_ticks);
+  p.Do(inst.globals.fake_TB_start_value);
+  p.Do(inst.globals.fake_TB_start_ticks);
+  p.Do(inst.last_OC_factor);
+  inst.globals.last_OC_factor_inverted = 1.0f / inst.last_OC_factor;
+  p.Do(inst.event_fifo_id);
 
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(s_event_queue, [](PointerWrap& pw, Event& ev) {
+  p.DoEachElement(inst.event_queue, [&inst](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -182,8 +234,8 @@ void DoState(PointerWrap& p)
     pw.Do(name);
     if (pw.GetMode() == PointerWrap::MODE_READ)
     {
-      auto itr = s_event_types.find(name);
-      if (itr != s_event_types.end())
+      auto itr = inst.event_types.find(name);
+      if (itr != inst.event_types.end())
       {
         ev.type = &itr->second;
       }
@@ -192,7 +244,7 @@ void DoState(PointerWrap& p)
         WARN_LOG(POWERPC,
                  "Lost event from savestate because its type, \"%s\", has not been registered.",
                  name.c_str());
-        ev.type = s_ev_lost;
+        ev.type = inst.ev_lost;
       }
     }
   });
@@ -202,34 +254,38 @@ void DoState(PointerWrap& p)
   // The exact layout of the heap in memory is implementation defined, therefore it is platform
   // and library version specific.
   if (p.GetMode() == PointerWrap::MODE_READ)
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    std::make_heap(inst.event_queue.begin(), inst.event_queue.end(), std::greater<Event>());
 }
 
 // This should only be called from the CPU thread. If you are calling
 // it from any other thread, you are doing something evil
 u64 GetTicks()
 {
-  u64 ticks = static_cast<u64>(g.global_timer);
-  if (!s_is_global_timer_sane)
+  Instance& inst = *s_instance;
+  u64 ticks = static_cast<u64>(inst.globals.global_timer);
+  if (!inst.is_global_timer_sane)
   {
-    int downcount = DowncountToCycles(PowerPC::ppcState.downcount);
-    ticks += g.slice_length - downcount;
+    int downcount = DowncountToCycles(inst, PowerPC::ppcState.downcount);
+    ticks += inst.globals.slice_length - downcount;
   }
   return ticks;
 }
 
 u64 GetIdleTicks()
 {
-  return static_cast<u64>(s_idled_cycles);
+  Instance& inst = *s_instance;
+  return static_cast<u64>(inst.idled_cycles);
 }
 
 void ClearPendingEvents()
 {
-  s_event_queue.clear();
+  Instance& inst = *s_instance;
+  inst.event_queue.clear();
 }
 
 void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata, FromThread from)
 {
+  Instance& inst = *s_instance;
   _assert_msg_(POWERPC, event_type, "Event type is nullptr, will crash now.");
 
   bool from_cpu_thread;
@@ -249,11 +305,11 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     s64 timeout = GetTicks() + cycles_into_future;
 
     // If this event needs to be scheduled before the next advance(), force one early
-    if (!s_is_global_timer_sane)
+    if (!inst.is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    inst.event_queue.emplace_back(Event{timeout, inst.event_fifo_id++, userdata, event_type});
+    std::push_heap(inst.event_queue.begin(), inst.event_queue.end(), std::greater<Event>());
   }
   else
   {
@@ -264,21 +320,26 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
                 event_type->name->c_str());
     }
 
-    std::lock_guard<std::mutex> lk(s_ts_write_lock);
-    s_ts_queue.Push(Event{g.global_timer + cycles_into_future, 0, userdata, event_type});
+    const Event ev{inst.globals.global_timer + cycles_into_future, 0, userdata, event_type};
+    if (!inst.ts_ring.Push(ev))
+    {
+      std::lock_guard<std::mutex> lk(inst.ts_write_lock);
+      inst.ts_queue.Push(ev);
+    }
   }
 }
 
 void RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(s_event_queue.begin(), s_event_queue.end(),
+  Instance& inst = *s_instance;
+  auto itr = std::remove_if(inst.event_queue.begin(), inst.event_queue.end(),
                             [&](const Event& e) { return e.type == event_type; });
 
   // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != s_event_queue.end())
+  if (itr != inst.event_queue.end())
   {
-    s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    inst.event_queue.erase(itr, inst.event_queue.end());
+    std::make_heap(inst.event_queue.begin(), inst.event_queue.end(), std::greater<Event>());
   }
 }
 
@@ -290,58 +351,87 @@ void RemoveAllEvents(EventType* event_type)
 
 void ForceExceptionCheck(s64 cycles)
 {
+  Instance& inst = *s_instance;
   cycles = std::max<s64>(0, cycles);
-  if (DowncountToCycles(PowerPC::ppcState.downcount) > cycles)
+  if (DowncountToCycles(inst, PowerPC::ppcState.downcount) > cycles)
   {
     // downcount is always (much) smaller than MAX_INT so we can safely cast cycles to an int here.
-    // Account for cycles already executed by adjusting the g.slice_length
-    g.slice_length -= DowncountToCycles(PowerPC::ppcState.downcount) - static_cast<int>(cycles);
-    PowerPC::ppcState.downcount = CyclesToDowncount(static_cast<int>(cycles));
+    // Account for cycles already executed by adjusting the slice_length
+    inst.globals.slice_length -=
+        DowncountToCycles(inst, PowerPC::ppcState.downcount) - static_cast<int>(cycles);
+    PowerPC::ppcState.downcount = CyclesToDowncount(inst, static_cast<int>(cycles));
   }
 }
 
 void MoveEvents()
 {
-  for (Event ev; s_ts_queue.Pop(ev);)
+  Instance& inst = *s_instance;
+  const size_t old_size = inst.event_queue.size();
+
+  // Drain the ring before the overflow queue, as anything in the latter was pushed while the ring
+  // was full.
+  for (Event ev; inst.ts_ring.Pop(ev);)
+  {
+    ev.fifo_order = inst.event_fifo_id++;
+    inst.event_queue.emplace_back(std::move(ev));
+  }
+  for (Event ev; inst.ts_queue.Pop(ev);)
+  {
+    ev.fifo_order = inst.event_fifo_id++;
+    inst.event_queue.emplace_back(std::move(ev));
+  }
+
+  // Insert the new events into the heap as a batch. Rebuilding the whole heap is linear in its
+  // size, so it only pays off once the batch is larger than what was already queued.
+  const size_t added = inst.event_queue.size() - old_size;
+  if (added > old_size)
+  {
+    std::make_heap(inst.event_queue.begin(), inst.event_queue.end(), std::greater<Event>());
+  }
+  else
   {
-    ev.fifo_order = s_event_fifo_id++;
-    s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    for (size_t i = old_size + 1; i <= inst.event_queue.size(); ++i)
+      std::push_heap(inst.event_queue.begin(), inst.event_queue.begin() + i, std::greater<Event>());
   }
 }
 
 void Advance()
 {
+  Instance& inst = *s_instance;
   MoveEvents();
 
-  int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
-  g.global_timer += cyclesExecuted;
-  s_last_OC_factor = SConfig::GetInstance().m_OCEnable ? SConfig::GetInstance().m_OCFactor : 1.0f;
-  g.last_OC_factor_inverted = 1.0f / s_last_OC_factor;
-  g.slice_length = MAX_SLICE_LENGTH;
+  int cyclesExecuted =
+      inst.globals.slice_length - DowncountToCycles(inst, PowerPC::ppcState.downcount);
+  inst.globals.global_timer += cyclesExecuted;
+  inst.last_OC_factor =
+      SConfig::GetInstance().m_OCEnable ? SConfig::GetInstance().m_OCFactor : 1.0f;
+  inst.globals.last_OC_factor_inverted = 1.0f / inst.last_OC_factor;
+  inst.globals.slice_length = MAX_SLICE_LENGTH;
 
-  s_is_global_timer_sane = true;
+  inst.is_global_timer_sane = true;
 
-  while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
+  while (!inst.event_queue.empty() && inst.event_queue.front().time <= inst.globals.global_timer)
   {
-    Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-    s_event_queue.pop_back();
+    Event evt = std::move(inst.event_queue.front());
+    std::pop_heap(inst.event_queue.begin(), inst.event_queue.end(), std::greater<Event>());
+    inst.event_queue.pop_back();
     // NOTICE_LOG(POWERPC, "[Scheduler] %-20s (%lld, %lld)", evt.type->name->c_str(),
-    //            g.global_timer, evt.time);
-    evt.type->callback(evt.userdata, g.global_timer - evt.time);
+    //            inst.globals.global_timer, evt.time);
+    TRACE_EVENT(CoreTimingBegin, evt.userdata, evt.type->trace_id);
+    evt.type->callback(evt.userdata, inst.globals.global_timer - evt.time);
+    TRACE_EVENT(CoreTimingEnd, evt.userdata, evt.type->trace_id);
   }
 
-  s_is_global_timer_sane = false;
+  inst.is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!s_event_queue.empty())
+  if (!inst.event_queue.empty())
   {
-    g.slice_length = static_cast<int>(
-        std::min<s64>(s_event_queue.front().time - g.global_timer, MAX_SLICE_LENGTH));
+    inst.globals.slice_length = static_cast<int>(
+        std::min<s64>(inst.event_queue.front().time - inst.globals.global_timer, MAX_SLICE_LENGTH));
   }
 
-  PowerPC::ppcState.downcount = CyclesToDowncount(g.slice_length);
+  PowerPC::ppcState.downcount = CyclesToDowncount(inst, inst.globals.slice_length);
 
   // Check for any external exceptions.
   // It's important to do this after processing events otherwise any exceptions will be delayed
@@ -352,27 +442,30 @@ void Advance()
 
 void LogPendingEvents()
 {
-  auto clone = s_event_queue;
+  Instance& inst = *s_instance;
+  auto clone = inst.event_queue;
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
-    INFO_LOG(POWERPC, "PENDING: Now: %" PRId64 " Pending: %" PRId64 " Type: %s", g.global_timer,
-             ev.time, ev.type->name->c_str());
+    INFO_LOG(POWERPC, "PENDING: Now: %" PRId64 " Pending: %" PRId64 " Type: %s",
+             inst.globals.global_timer, ev.time, ev.type->name->c_str());
   }
 }
 
 // Should only be called from the CPU thread after the PPC clock has changed
 void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
 {
-  for (Event& ev : s_event_queue)
+  Instance& inst = *s_instance;
+  for (Event& ev : inst.event_queue)
   {
-    const s64 ticks = (ev.time - g.global_timer) * new_ppc_clock / old_ppc_clock;
-    ev.time = g.global_timer + ticks;
+    const s64 ticks = (ev.time - inst.globals.global_timer) * new_ppc_clock / old_ppc_clock;
+    ev.time = inst.globals.global_timer + ticks;
   }
 }
 
 void Idle()
 {
+  Instance& inst = *s_instance;
   if (SConfig::GetInstance().bSyncGPUOnSkipIdleHack)
   {
     // When the FIFO is processing data we must not advance because in this way
@@ -381,16 +474,17 @@ void Idle()
     Fifo::FlushGpu();
   }
 
-  s_idled_cycles += DowncountToCycles(PowerPC::ppcState.downcount);
+  inst.idled_cycles += DowncountToCycles(inst, PowerPC::ppcState.downcount);
   PowerPC::ppcState.downcount = 0;
 }
 
 std::string GetScheduledEventsSummary()
 {
+  Instance& inst = *s_instance;
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = s_event_queue;
+  auto clone = inst.event_queue;
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -402,42 +496,50 @@ std::string GetScheduledEventsSummary()
 
 u32 GetFakeDecStartValue()
 {
-  return s_fake_dec_start_value;
+  Instance& inst = *s_instance;
+  return inst.fake_dec_start_value;
 }
 
 void SetFakeDecStartValue(u32 val)
 {
-  s_fake_dec_start_value = val;
+  Instance& inst = *s_instance;
+  inst.fake_dec_start_value = val;
 }
 
 u64 GetFakeDecStartTicks()
 {
-  return s_fake_dec_start_ticks;
+  Instance& inst = *s_instance;
+  return inst.fake_dec_start_ticks;
 }
 
 void SetFakeDecStartTicks(u64 val)
 {
-  s_fake_dec_start_ticks = val;
+  Instance& inst = *s_instance;
+  inst.fake_dec_start_ticks = val;
 }
 
 u64 GetFakeTBStartValue()
 {
-  return g.fake_TB_start_value;
+  Instance& inst = *s_instance;
+  return inst.globals.fake_TB_start_value;
 }
 
 void SetFakeTBStartValue(u64 val)
 {
-  g.fake_TB_start_value = val;
+  Instance& inst = *s_instance;
+  inst.globals.fake_TB_start_value = val;
 }
 
 u64 GetFakeTBStartTicks()
 {
-  return g.fake_TB_start_ticks;
+  Instance& inst = *s_instance;
+  return inst.globals.fake_TB_start_ticks;
 }
 
 void SetFakeTBStartTicks(u64 val)
 {
-  g.fake_TB_start_ticks = val;
+  Instance& inst = *s_instance;
+  inst.globals.fake_TB_start_ticks = val;
 }
 
 }  // namespace
@@ -33,7 +33,20 @@ struct Globals
   u64 fake_TB_start_ticks;
   float last_OC_factor_inverted;
 };
-extern Globals g;
+
+// The scheduler of one emulated console. All of the functions below work on the calling thread's
+// current instance. That is a default instance shared by the whole process, unless the thread
+// made another one current, so a host can run several consoles on separate threads.
+struct Instance;
+Instance* CreateInstance();
+void DestroyInstance(Instance* instance);
+// nullptr makes the default instance current again.
+void SetCurrentInstance(Instance* instance);
+Instance* GetCurrentInstance();
+
+// The globals of the current instance. JIT code reads them at the address it was compiled with,
+// so it must run on a thread with the same current instance.
+Globals& GetGlobals();
 
 // CoreTiming begins at the boundary of timing slice -1. An initial call to Advance() is
 // required to end slice -1 and start slice 0 before the first cycle of code is executed.
@@ -4,15 +4,118 @@
 
 #include "Core/DSP/DSPAccelerator.h"
 
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 
 #include "Core/DSP/DSPCore.h"
 #include "Core/DSP/DSPHost.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP
 {
+// Applies the predictor to an already scaled sample.
+static s16 ADPCM_Predict(int scaled_sample, s32 coef1, s32 coef2, s16 yn1, s16 yn2)
+{
+  // 0x400 = 0.5  in 11-bit fixed point
+  int val = scaled_sample + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+  return MathUtil::Clamp(val, -0x7FFF, 0x7FFF);
+}
+
+// Sign extends and scales all 16 nibbles of a frame (including the header's). The predictor
+// depends on the previous outputs and stays serial, but this part can be done for the whole frame
+// at once.
+#if defined(_M_X86)
+FUNCTION_TARGET_SSR41
+static void ScaleADPCMNibbles_SSE41(s32* dst, const u8* frame, int shift)
+{
+  const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(frame));
+  const __m128i low_mask = _mm_set1_epi8(0xF);
+  const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask);
+  const __m128i lo = _mm_and_si128(bytes, low_mask);
+  // The high nibble of each byte comes first.
+  __m128i nibbles = _mm_unpacklo_epi8(hi, lo);
+  const __m128i sign = _mm_set1_epi8(8);
+  nibbles = _mm_sub_epi8(_mm_xor_si128(nibbles, sign), sign);
+
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  for (int i = 0; i < 4; ++i)
+  {
+    const __m128i samples = _mm_sll_epi32(_mm_cvtepi8_epi32(nibbles), count);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), samples);
+    nibbles = _mm_srli_si128(nibbles, 4);
+  }
+}
+#elif defined(_M_ARM_64)
+static void ScaleADPCMNibbles_NEON(s32* dst, const u8* frame, int shift)
+{
+  const uint8x8_t bytes = vld1_u8(frame);
+  // The high nibble of each byte comes first.
+  const uint8x8x2_t zipped = vzip_u8(vshr_n_u8(bytes, 4), vand_u8(bytes, vdup_n_u8(0xF)));
+  const uint8x16_t sign = vdupq_n_u8(8);
+  const int8x16_t nibbles = vreinterpretq_s8_u8(
+      vsubq_u8(veorq_u8(vcombine_u8(zipped.val[0], zipped.val[1]), sign), sign));
+
+  const int32x4_t count = vdupq_n_s32(shift);
+  const int16x8_t lo = vmovl_s8(vget_low_s8(nibbles));
+  const int16x8_t hi = vmovl_s8(vget_high_s8(nibbles));
+  vst1q_s32(dst + 0, vshlq_s32(vmovl_s16(vget_low_s16(lo)), count));
+  vst1q_s32(dst + 4, vshlq_s32(vmovl_s16(vget_high_s16(lo)), count));
+  vst1q_s32(dst + 8, vshlq_s32(vmovl_s16(vget_low_s16(hi)), count));
+  vst1q_s32(dst + 12, vshlq_s32(vmovl_s16(vget_high_s16(hi)), count));
+}
+#endif
+
+static void ScaleADPCMNibbles(s32* dst, const u8* frame, int shift)
+{
+#if defined(_M_X86)
+  if (cpu_info.bSSE4_1)
+  {
+    ScaleADPCMNibbles_SSE41(dst, frame, shift);
+    return;
+  }
+#elif defined(_M_ARM_64)
+  ScaleADPCMNibbles_NEON(dst, frame, shift);
+  return;
+#endif
+
+  for (int i = 0; i < 16; ++i)
+  {
+    int temp = (i & 1) ? (frame[i >> 1] & 0xF) : (frame[i >> 1] >> 4);
+    if (temp >= 8)
+      temp -= 16;
+    dst[i] = temp * (1 << shift);
+  }
+}
+
+void DecodeADPCMFrame(s16* dst, const u8* frame, u32 first, u32 count, const s16* coefs,
+                      u16 pred_scale, s16* yn1, s16* yn2)
+{
+  s32 scaled[16];
+  ScaleADPCMNibbles(scaled, frame, pred_scale & 0xF);
+
+  const int coef_idx = (pred_scale >> 4) & 0x7;
+  const s32 coef1 = coefs[coef_idx * 2 + 0];
+  const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+  s16 h1 = *yn1;
+  s16 h2 = *yn2;
+  for (u32 i = first; i < first + count; ++i)
+  {
+    const s16 val = ADPCM_Predict(scaled[i], coef1, coef2, h1, h2);
+    h2 = h1;
+    h1 = val;
+    *dst++ = val;
+  }
+  *yn1 = h1;
+  *yn2 = h2;
+}
+
 // The hardware adpcm decoder :)
 static s16 ADPCM_Step(u32& _rSamplePos)
 {
@@ -36,11 +139,8 @@ static s16 ADPCM_Step(u32& _rSamplePos)
   if (temp >= 8)
     temp -= 16;
 
-  // 0x400 = 0.5  in 11-bit fixed point
-  int val =
-      (scale * temp) +
-      ((0x400 + coef1 * (s16)g_dsp.ifx_regs[DSP_YN1] + coef2 * (s16)g_dsp.ifx_regs[DSP_YN2]) >> 11);
-  val = MathUtil::Clamp(val, -0x7FFF, 0x7FFF);
+  s16 val = ADPCM_Predict(scale * temp, coef1, coef2, g_dsp.ifx_regs[DSP_YN1],
+                          g_dsp.ifx_regs[DSP_YN2]);
 
   g_dsp.ifx_regs[DSP_YN2] = g_dsp.ifx_regs[DSP_YN1];
   g_dsp.ifx_regs[DSP_YN1] = val;
@@ -8,6 +8,14 @@
 
 namespace DSP
 {
+// Decodes the samples at nibbles [first, first + count) of an ADPCM frame, which must not
+// include the two header nibbles. <frame> holds the 8 bytes of the frame: the predictor/scale
+// header followed by 14 4-bit samples. pred_scale is passed separately because it does not
+// always come from the header (e.g. after looping in the middle of a frame). yn1 and yn2 hold the
+// decoder history and are updated.
+void DecodeADPCMFrame(s16* dst, const u8* frame, u32 first, u32 count, const s16* coefs,
+                      u16 pred_scale, s16* yn1, s16* yn2);
+
 u16 dsp_read_accelerator();
 
 u16 dsp_read_aram_d3();
@@ -4,11 +4,13 @@
 
 #include "Core/DSP/DSPAnalyzer.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 
 #include "Common/Logging/Log.h"
 
+#include "Core/DSP/DSPCore.h"
 #include "Core/DSP/DSPMemoryMap.h"
 #include "Core/DSP/DSPTables.h"
 
@@ -23,51 +25,90 @@ constexpr size_t ISPACE = 65536;
 // Holds data about all instructions in RAM.
 std::array<u8, ISPACE> code_flags;
 
-// Good candidates for idle skipping is mail wait loops. If we're time slicing
-// between the main CPU and the DSP, if the DSP runs into one of these, it might
-// as well give up its time slice immediately, after executing once.
-
-// Max signature length is 6. A 0 in a signature is ignored.
-constexpr size_t NUM_IDLE_SIGS = 8;
-constexpr size_t MAX_IDLE_SIG_SIZE = 6;
-
-// 0xFFFF means ignore.
-constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
-    // From AX:
-    {0x26fc,          // LRS   $30, @DMBH
-     0x02c0, 0x8000,  // ANDCF $30, #0x8000
-     0x029d, 0xFFFF,  // JLZ 0x027a
-     0, 0},           // RET
-    {0x27fc,          // LRS   $31, @DMBH
-     0x03c0, 0x8000,  // ANDCF $31, #0x8000
-     0x029d, 0xFFFF,  // JLZ 0x027a
-     0, 0},           // RET
-    {0x26fe,          // LRS   $30, @CMBH
-     0x02c0, 0x8000,  // ANDCF $30, #0x8000
-     0x029c, 0xFFFF,  // JLNZ 0x0280
-     0, 0},           // RET
-    {0x27fe,          // LRS   $31, @CMBH
-     0x03c0, 0x8000,  // ANDCF $31, #0x8000
-     0x029c, 0xFFFF,  // JLNZ 0x0280
-     0, 0},           // RET
-    {0x26fc,          // LRS  $AC0.M, @DMBH
-     0x02a0, 0x8000,  // ANDF $AC0.M, #0x8000
-     0x029c, 0xFFFF,  // JLNZ 0x????
-     0, 0},
-    {0x27fc,          // LRS  $AC1.M, @DMBH
-     0x03a0, 0x8000,  // ANDF $AC1.M, #0x8000
-     0x029c, 0xFFFF,  // JLNZ 0x????
-     0, 0},
-    // From Zelda:
-    {0x00de, 0xFFFE,  // LR    $AC0.M, @CMBH
-     0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
-     0x029c, 0xFFFF,  // JLNZ 0x05cf
-     0},
-    // From Zelda - experimental
-    {0x00da, 0x0352,  // LR     $AX0.H, @0x0352
-     0x8600,          // TSTAXH $AX0.H
-     0x0295, 0xFFFF,  // JZ    0x????
-     0, 0}};
+// Good candidates for idle skipping are loops that wait for mail or for an interrupt. If we're
+// time slicing between the main CPU and the DSP, if the DSP runs into one of these, it might as
+// well give up its time slice immediately, after executing once.
+//
+// Rather than matching the loops of known ucodes, we look for short loops that only read the
+// mailboxes or DRAM into registers and test them. Nothing changes the values they read but the
+// CPU or an interrupt handler, and running such a loop any number of times has the same effect
+// as running it once, so skipping iterations is safe.
+constexpr size_t MAX_IDLE_LOOP_INSTRUCTIONS = 8;
+
+// Whether reading the address has no side effects.
+bool IsPolledAddress(u16 address)
+{
+  return address < DSP_DRAM_SIZE || address == (0xff00 | DSP_DMBH) ||
+         address == (0xff00 | DSP_CMBH);
+}
+
+// Whether executing the instruction again gives the same result as the first time, because it
+// only loads a polled address into a register or only sets flags.
+bool IsIdleLoopInstruction(UDSPInstruction inst, const DSPOPCTemplate* opcode, u16 addr)
+{
+  // Extension opcodes other than the "no operation" ones load, store or change registers.
+  if (opcode->extended && (inst & 0x00fc) != 0)
+    return false;
+
+  switch (opcode->opcode)
+  {
+  case 0x00c0:  // LR $D, @M
+    // Loading the stack registers or $sr has side effects, so only the AX and accumulator
+    // registers are allowed, which are all that LRS can load to anyway.
+    return (inst & 0x001f) >= 0x18 && IsPolledAddress(dsp_imem_read(addr + 1));
+  case 0x2000:  // LRS $(D+24), @M
+    // The ucodes all leave $cr at 0xff, so this reads the hardware registers.
+    return IsPolledAddress(0xff00 | (inst & 0x00ff));
+  case 0x0280:  // CMPI $acD, #I
+  case 0x02a0:  // ANDF $acD.m, #I
+  case 0x02c0:  // ANDCF $acD.m, #I
+  case 0x8200:  // CMP
+  case 0x8600:  // TSTAXH $axR.h
+  case 0xb100:  // TST $acR
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Returns the address after the end of the idle loop that starts at the address, or 0 if there
+// is none.
+u16 FindIdleLoopEnd(u16 start_addr)
+{
+  u16 addr = start_addr;
+  u16 exit_addr = start_addr;
+  for (size_t i = 0; i < MAX_IDLE_LOOP_INSTRUCTIONS; i++)
+  {
+    const UDSPInstruction inst = dsp_imem_read(addr);
+    const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+    if (!opcode)
+      return 0;
+
+    if ((inst & 0xfff0) == 0x0290)
+    {
+      // JMPcc, which either jumps back to the start of the loop or leaves it.
+      const u16 target = dsp_imem_read(addr + 1);
+      if (target == start_addr)
+      {
+        const u16 end_addr = addr + opcode->size;
+        // Jumps into the middle of the loop would make it do something else.
+        if (exit_addr > start_addr && exit_addr < end_addr)
+          return 0;
+        return end_addr;
+      }
+      // Code after an unconditional jump elsewhere isn't part of the loop.
+      if (opcode->uncond_branch || (target > start_addr && target <= addr))
+        return 0;
+      exit_addr = std::max(exit_addr, target);
+    }
+    else if (!IsIdleLoopInstruction(inst, opcode, addr))
+    {
+      return 0;
+    }
+    addr += opcode->size;
+  }
+  return 0;
+}
 
 void Reset()
 {
@@ -130,27 +171,21 @@ void AnalyzeRange(u16 start_addr, u16 end_addr)
   }
 
   // Next, we'll scan for potential idle skips.
-  for (size_t s = 0; s < NUM_IDLE_SIGS; s++)
+  size_t idle_loops = 0;
+  for (u16 addr = start_addr; addr < end_addr; addr++)
   {
-    for (u16 addr = start_addr; addr < end_addr; addr++)
+    if (!(code_flags[addr] & CODE_START_OF_INST))
+      continue;
+
+    const u16 loop_end = FindIdleLoopEnd(addr);
+    if (loop_end != 0)
     {
-      bool found = false;
-      for (size_t i = 0; i < MAX_IDLE_SIG_SIZE + 1; i++)
-      {
-        if (idle_skip_sigs[s][i] == 0)
-          found = true;
-        if (idle_skip_sigs[s][i] == 0xFFFF)
-          continue;
-        if (idle_skip_sigs[s][i] != dsp_imem_read(static_cast<u16>(addr + i)))
-          break;
-      }
-      if (found)
-      {
-        INFO_LOG(DSPLLE, "Idle skip location found at %02x (sigNum:%zu)", addr, s + 1);
-        code_flags[addr] |= CODE_IDLE_SKIP;
-      }
+      INFO_LOG(DSPLLE, "Idle loop found at %04x-%04x", addr, loop_end - 1);
+      code_flags[addr] |= CODE_IDLE_SKIP;
+      idle_loops++;
     }
   }
+  NOTICE_LOG(DSPLLE, "Found %zu idle loops in %04x-%04x", idle_loops, start_addr, end_addr - 1);
   INFO_LOG(DSPLLE, "Finished analysis.");
 }
 }  // Anonymous namespace
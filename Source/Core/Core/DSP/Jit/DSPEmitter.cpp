@@ -76,14 +76,28 @@ void DSPEmitter::DoState(PointerWrap& p)
 
 void DSPEmitter::ClearIRAM()
 {
-  for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
+  // Instead of throwing away the code of the ucode which is being replaced, keep it in the code
+  // space. Games switch between the same few ucodes over and over, and this way switching back
+  // doesn't need any recompilation. The ROM blocks can be linked to the IRAM ones, so they are
+  // saved and restored along with them.
+  if (!m_current_iram.empty())
+    SaveUCodeBlocks();
+
+  if (GetSpaceLeft() < COMPILED_CODE_SIZE / 4)
   {
-    m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
-    m_block_links[i] = nullptr;
-    m_block_size[i] = 0;
-    m_unresolved_jumps[i].clear();
+    // Start from scratch once the code space is running low. The code space itself is only
+    // cleared after RunCycles, as we may still be executing a block right now.
+    ResetBlocks();
+    m_ucode_cache.clear();
+    g_dsp.reset_dspjit_codespace = true;
   }
-  g_dsp.reset_dspjit_codespace = true;
+  else if (!RestoreUCodeBlocks())
+  {
+    ResetBlocks();
+  }
+
+  m_current_ucode_crc = g_dsp.iram_crc;
+  m_current_iram.assign(g_dsp.iram, g_dsp.iram + DSP_IRAM_SIZE);
 }
 
 void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
@@ -92,6 +106,13 @@ void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
   CompileDispatcher();
   m_stub_entry_point = CompileStub();
 
+  ResetBlocks();
+  m_ucode_cache.clear();
+  g_dsp.reset_dspjit_codespace = false;
+}
+
+void DSPEmitter::ResetBlocks()
+{
   for (size_t i = 0; i < MAX_BLOCKS; i++)
   {
     m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
@@ -99,7 +120,43 @@ void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
     m_block_size[i] = 0;
     m_unresolved_jumps[i].clear();
   }
-  g_dsp.reset_dspjit_codespace = false;
+}
+
+void DSPEmitter::SaveUCodeBlocks()
+{
+  CachedUCode& cached = m_ucode_cache[m_current_ucode_crc];
+  cached.iram = m_current_iram;
+  cached.blocks.clear();
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
+  {
+    if (m_blocks[i] != (DSPCompiledCode)m_stub_entry_point)
+    {
+      cached.blocks.push_back(
+          {static_cast<u16>(i), m_block_size[i], m_blocks[i], m_block_links[i]});
+    }
+  }
+}
+
+bool DSPEmitter::RestoreUCodeBlocks()
+{
+  const auto it = m_ucode_cache.find(g_dsp.iram_crc);
+  if (it == m_ucode_cache.end() ||
+      !std::equal(it->second.iram.begin(), it->second.iram.end(), g_dsp.iram))
+  {
+    return false;
+  }
+
+  ResetBlocks();
+  for (const CachedBlock& block : it->second.blocks)
+  {
+    m_blocks[block.address] = block.code;
+    m_block_links[block.address] = block.link;
+    m_block_size[block.address] = block.size;
+  }
+
+  INFO_LOG(DSPLLE, "Restored %zu DSP JIT blocks for ucode %08x", it->second.blocks.size(),
+           g_dsp.iram_crc);
+  return true;
 }
 
 // Must go out of block if exception is detected
@@ -7,6 +7,7 @@
 #include <array>
 #include <cstddef>
 #include <list>
+#include <map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -210,6 +211,25 @@ public:
   std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
 
 private:
+  // The blocks compiled for a ucode, saved when it gets replaced so that they can be reused if the
+  // same ucode is loaded again.
+  struct CachedBlock
+  {
+    u16 address;
+    u16 size;
+    DSPCompiledCode code;
+    Block link;
+  };
+  struct CachedUCode
+  {
+    std::vector<u16> iram;
+    std::vector<CachedBlock> blocks;
+  };
+
+  void ResetBlocks();
+  void SaveUCodeBlocks();
+  bool RestoreUCodeBlocks();
+
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
 
@@ -291,6 +311,7 @@ private:
   void popExtValueToReg();
   void pushExtValueFromMem(u16 dreg, u16 sreg);
   void pushExtValueFromMem2(u16 dreg, u16 sreg);
+  void pushExtValueFromMem2SameArea(u16 dreg, u16 sreg);
 
   // Multiplier helpers
   void multiply();
@@ -309,6 +330,12 @@ private:
   std::vector<Block> m_block_links;
   Block m_block_link_entry;
 
+  // Keyed by the CRC of the ucode upload (g_dsp.iram_crc). The IRAM contents are compared as well
+  // before restoring, as only the uploaded part is hashed.
+  std::map<u32, CachedUCode> m_ucode_cache;
+  u32 m_current_ucode_crc = 0;
+  std::vector<u16> m_current_iram;
+
   u16 m_cycles_left = 0;
 
   // The index of the last stored ext value (compile time).
@@ -377,22 +377,7 @@ void DSPEmitter::ld(const UDSPInstruction opc)
 
   pushExtValueFromMem((dreg << 1) + DSP_REG_AXL0, sreg);
 
-  // 	if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);
-  SetJumpTarget(not_equal);  // else
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea((rreg << 1) + DSP_REG_AXL1, sreg);
 
   increment_addr_reg(sreg);
 
@@ -408,22 +393,7 @@ void DSPEmitter::ldax(const UDSPInstruction opc)
 
   pushExtValueFromMem(rreg + DSP_REG_AXH0, sreg);
 
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  // if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);  // else
-  SetJumpTarget(not_equal);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea(rreg + DSP_REG_AXL0, sreg);
 
   increment_addr_reg(sreg);
 
@@ -440,22 +410,7 @@ void DSPEmitter::ldn(const UDSPInstruction opc)
 
   pushExtValueFromMem((dreg << 1) + DSP_REG_AXL0, sreg);
 
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  // if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);
-  SetJumpTarget(not_equal);  // else
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea((rreg << 1) + DSP_REG_AXL1, sreg);
 
   increase_addr_reg(sreg, sreg);
 
@@ -471,22 +426,7 @@ void DSPEmitter::ldaxn(const UDSPInstruction opc)
 
   pushExtValueFromMem(rreg + DSP_REG_AXH0, sreg);
 
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  // if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);  // else
-  SetJumpTarget(not_equal);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea(rreg + DSP_REG_AXL0, sreg);
 
   increase_addr_reg(sreg, sreg);
 
@@ -503,22 +443,7 @@ void DSPEmitter::ldm(const UDSPInstruction opc)
 
   pushExtValueFromMem((dreg << 1) + DSP_REG_AXL0, sreg);
 
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  // if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);
-  SetJumpTarget(not_equal);  // else
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea((rreg << 1) + DSP_REG_AXL1, sreg);
 
   increment_addr_reg(sreg);
 
@@ -534,22 +459,7 @@ void DSPEmitter::ldaxm(const UDSPInstruction opc)
 
   pushExtValueFromMem(rreg + DSP_REG_AXH0, sreg);
 
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  // if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);  // else
-  SetJumpTarget(not_equal);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea(rreg + DSP_REG_AXL0, sreg);
 
   increment_addr_reg(sreg);
 
@@ -566,22 +476,7 @@ void DSPEmitter::ldnm(const UDSPInstruction opc)
 
   pushExtValueFromMem((dreg << 1) + DSP_REG_AXL0, sreg);
 
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  // if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);
-  SetJumpTarget(not_equal);  // else
-  pushExtValueFromMem2((rreg << 1) + DSP_REG_AXL1, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea((rreg << 1) + DSP_REG_AXL1, sreg);
 
   increase_addr_reg(sreg, sreg);
 
@@ -597,22 +492,7 @@ void DSPEmitter::ldaxnm(const UDSPInstruction opc)
 
   pushExtValueFromMem(rreg + DSP_REG_AXH0, sreg);
 
-  X64Reg tmp = m_gpr.GetFreeXReg();
-  // if (IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3])) {
-  dsp_op_read_reg(sreg, RCX);
-  dsp_op_read_reg(DSP_REG_AR3, tmp);
-  XOR(16, R(ECX), R(tmp));
-  m_gpr.PutXReg(tmp);
-  DSPJitRegCache c(m_gpr);
-  TEST(16, R(ECX), Imm16(0xfc00));
-  FixupBranch not_equal = J_CC(CC_NE, true);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, sreg);
-  m_gpr.FlushRegs(c);
-  FixupBranch after = J(true);  // else
-  SetJumpTarget(not_equal);
-  pushExtValueFromMem2(rreg + DSP_REG_AXL0, DSP_REG_AR3);
-  m_gpr.FlushRegs(c);
-  SetJumpTarget(after);
+  pushExtValueFromMem2SameArea(rreg + DSP_REG_AXL0, sreg);
 
   increase_addr_reg(sreg, sreg);
 
@@ -654,6 +534,31 @@ void DSPEmitter::pushExtValueFromMem2(u16 dreg, u16 sreg)
   m_store_index2 = dreg;
 }
 
+// Like pushExtValueFromMem2, but reads from the address in $ar3 unless it is in the same memory
+// area as the one in g_dsp.r[sreg]. The address is selected with a CMOV rather than by
+// emitting the read twice behind a branch.
+void DSPEmitter::pushExtValueFromMem2SameArea(u16 dreg, u16 sreg)
+{
+  // u16 addr = IsSameMemArea(g_dsp.r[sreg], g_dsp.r[DSP_REG_AR3]) ? g_dsp.r[sreg] :
+  //                                                                  g_dsp.r[DSP_REG_AR3];
+  X64Reg tmp1 = m_gpr.GetFreeXReg();
+
+  dsp_op_read_reg(DSP_REG_AR3, tmp1, RegisterExtension::Zero);
+  dsp_op_read_reg(sreg, RCX, RegisterExtension::Zero);
+  MOV(32, R(EAX), R(ECX));
+  XOR(32, R(EAX), R(tmp1));
+  TEST(32, R(EAX), Imm32(0xfc00));
+  CMOVcc(32, tmp1, R(ECX), CC_Z);
+  dmem_read(tmp1);
+
+  m_gpr.PutXReg(tmp1);
+
+  SHL(32, R(EAX), Imm8(16));
+  OR(32, R(EBX), R(EAX));
+
+  m_store_index2 = dreg;
+}
+
 void DSPEmitter::popExtValueToReg()
 {
   // in practice, we rarely ever have a non-NX main op
@@ -5,18 +5,29 @@
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <zlib.h>
+
 #include "Common/File.h"
+#include "Common/Logging/Log.h"
 
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 4,
+  VERSION_NUMBER = 5,
   MIN_LOADER_VERSION = 1,
+  // Compressed frames were added in version 5.
+  MIN_COMPRESSED_LOADER_VERSION = 5,
 };
 
 #pragma pack(push, 1)
@@ -66,8 +77,268 @@ struct FileMemoryUpdate
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
+// Takes the place of FileFrameInfo in compressed files. The chunk holds the FIFO data, followed by
+// the list of memory updates, followed by the data of the updates, with the offsets of the
+// updates relative to the start of the chunk.
+struct FileCompressedFrameInfo
+{
+  u64 chunkOffset;
+  u32 chunkSize;
+  u32 uncompressedSize;
+  u32 fifoDataSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u32 numMemoryUpdates;
+  u8 reserved[32];
+};
+static_assert(sizeof(FileCompressedFrameInfo) == sizeof(FileFrameInfo),
+              "FileCompressedFrameInfo should be the same size as FileFrameInfo");
+
 #pragma pack(pop)
 
+static std::vector<u8> SerializeFrame(const FifoFrameInfo& frame)
+{
+  size_t size = frame.fifoData.size() + frame.memoryUpdates.size() * sizeof(FileMemoryUpdate);
+  for (const MemoryUpdate& update : frame.memoryUpdates)
+    size += update.data.size();
+
+  std::vector<u8> chunk(size);
+  std::copy(frame.fifoData.begin(), frame.fifoData.end(), chunk.begin());
+
+  size_t update_offset = frame.fifoData.size();
+  size_t data_offset = update_offset + frame.memoryUpdates.size() * sizeof(FileMemoryUpdate);
+  for (const MemoryUpdate& update : frame.memoryUpdates)
+  {
+    FileMemoryUpdate dst_update = {};
+    dst_update.address = update.address;
+    dst_update.dataOffset = data_offset;
+    dst_update.dataSize = static_cast<u32>(update.data.size());
+    dst_update.fifoPosition = update.fifoPosition;
+    dst_update.type = update.type;
+    std::memcpy(&chunk[update_offset], &dst_update, sizeof(FileMemoryUpdate));
+    std::copy(update.data.begin(), update.data.end(), chunk.begin() + data_offset);
+
+    update_offset += sizeof(FileMemoryUpdate);
+    data_offset += update.data.size();
+  }
+
+  return chunk;
+}
+
+static bool DeserializeFrame(const std::vector<u8>& chunk, const FileCompressedFrameInfo& info,
+                             FifoFrameInfo* frame)
+{
+  const size_t updates_end =
+      size_t(info.fifoDataSize) + size_t(info.numMemoryUpdates) * sizeof(FileMemoryUpdate);
+  if (updates_end > chunk.size())
+    return false;
+
+  frame->fifoData.assign(chunk.begin(), chunk.begin() + info.fifoDataSize);
+  frame->fifoStart = info.fifoStart;
+  frame->fifoEnd = info.fifoEnd;
+  frame->memoryUpdates.resize(info.numMemoryUpdates);
+  for (u32 i = 0; i < info.numMemoryUpdates; ++i)
+  {
+    FileMemoryUpdate src_update;
+    std::memcpy(&src_update, &chunk[info.fifoDataSize + i * sizeof(FileMemoryUpdate)],
+                sizeof(FileMemoryUpdate));
+    if (src_update.dataOffset > chunk.size() ||
+        src_update.dataSize > chunk.size() - src_update.dataOffset)
+    {
+      return false;
+    }
+
+    MemoryUpdate& dst_update = frame->memoryUpdates[i];
+    dst_update.address = src_update.address;
+    dst_update.fifoPosition = src_update.fifoPosition;
+    dst_update.type = static_cast<MemoryUpdate::Type>(src_update.type);
+    dst_update.data.assign(chunk.begin() + src_update.dataOffset,
+                           chunk.begin() + src_update.dataOffset + src_update.dataSize);
+  }
+
+  return true;
+}
+
+// Appends the compressed chunk of a frame to the end of the file.
+static bool WriteCompressedFrame(const FifoFrameInfo& frame, File::IOFile& file,
+                                 FileCompressedFrameInfo* info)
+{
+  const std::vector<u8> chunk = SerializeFrame(frame);
+  uLongf chunkSize = compressBound(static_cast<uLong>(chunk.size()));
+  std::vector<u8> compressedChunk(chunkSize);
+  if (compress(compressedChunk.data(), &chunkSize, chunk.data(),
+               static_cast<uLong>(chunk.size())) != Z_OK)
+  {
+    return false;
+  }
+
+  file.Seek(0, SEEK_END);
+  *info = {};
+  info->chunkOffset = file.Tell();
+  info->chunkSize = static_cast<u32>(chunkSize);
+  info->uncompressedSize = static_cast<u32>(chunk.size());
+  info->fifoDataSize = static_cast<u32>(frame.fifoData.size());
+  info->fifoStart = frame.fifoStart;
+  info->fifoEnd = frame.fifoEnd;
+  info->numMemoryUpdates = static_cast<u32>(frame.memoryUpdates.size());
+  return file.WriteBytes(compressedChunk.data(), chunkSize);
+}
+
+// Reads the frames of a compressed file as they are needed. A worker thread decompresses the
+// frames after the one which was requested last, so that they are usually ready by the time the
+// player gets to them. Once the cache is full, the frames furthest behind the requested one are
+// dropped first, then the ones furthest ahead of it.
+class FifoDataFile::FrameStream
+{
+public:
+  FrameStream(File::IOFile file, std::vector<FileCompressedFrameInfo> frames)
+      : m_frames(std::move(frames)), m_file(std::move(file))
+  {
+    m_thread = std::thread(&FrameStream::ReadAheadLoop, this);
+  }
+
+  ~FrameStream()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_exit = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+  }
+
+  u32 GetFrameCount() const { return static_cast<u32>(m_frames.size()); }
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame)
+  {
+    std::shared_ptr<const FifoFrameInfo> data;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_position = frame;
+      auto iter = m_cache.find(frame);
+      if (iter != m_cache.end())
+        data = iter->second;
+    }
+    m_cv.notify_one();
+    if (data)
+      return data;
+
+    data = ReadFrame(frame);
+    std::lock_guard<std::mutex> lk(m_mutex);
+    AddToCache(frame, data);
+    return data;
+  }
+
+private:
+  static constexpr u32 READ_AHEAD_FRAMES = 8;
+  static constexpr size_t MAX_CACHE_SIZE = 256 * 1024 * 1024;
+
+  std::shared_ptr<const FifoFrameInfo> ReadFrame(u32 frame)
+  {
+    const FileCompressedFrameInfo& info = m_frames[frame];
+    std::vector<u8> compressed(info.chunkSize);
+    bool read;
+    {
+      std::lock_guard<std::mutex> lk(m_file_mutex);
+      read = m_file.Seek(info.chunkOffset, SEEK_SET) &&
+             m_file.ReadBytes(compressed.data(), compressed.size());
+    }
+
+    std::vector<u8> chunk(info.uncompressedSize);
+    uLongf size = static_cast<uLongf>(chunk.size());
+    auto data = std::make_shared<FifoFrameInfo>();
+    if (!read ||
+        uncompress(chunk.data(), &size, compressed.data(), static_cast<uLong>(compressed.size())) !=
+            Z_OK ||
+        size != chunk.size() || !DeserializeFrame(chunk, info, data.get()))
+    {
+      // Play back an empty frame rather than garbage.
+      ERROR_LOG(CORE, "Failed to read frame %u of the FIFO log", frame);
+      data = std::make_shared<FifoFrameInfo>();
+      data->fifoStart = info.fifoStart;
+      data->fifoEnd = info.fifoEnd;
+    }
+
+    return data;
+  }
+
+  // m_mutex must be held.
+  void AddToCache(u32 frame, std::shared_ptr<const FifoFrameInfo> data)
+  {
+    if (!m_cache.emplace(frame, std::move(data)).second)
+      return;
+
+    m_cache_size += m_frames[frame].uncompressedSize;
+    while (m_cache_size > MAX_CACHE_SIZE && m_cache.size() > 1)
+    {
+      auto iter = m_cache.begin();
+      if (iter->first >= m_position)
+        iter = std::prev(m_cache.end());
+      if (iter->first == m_position)
+        break;
+
+      m_cache_size -= m_frames[iter->first].uncompressedSize;
+      m_cache.erase(iter);
+    }
+  }
+
+  // m_mutex must be held.
+  bool FindFrameToReadAhead(u32* frame) const
+  {
+    for (u32 i = 1; i <= READ_AHEAD_FRAMES && m_position + i < m_frames.size(); ++i)
+    {
+      const u32 next = m_position + i;
+      if (m_cache.count(next))
+        continue;
+
+      // Stop once the cache would be full, or the frame would just be dropped again.
+      if (m_cache_size + m_frames[next].uncompressedSize > MAX_CACHE_SIZE)
+        return false;
+
+      *frame = next;
+      return true;
+    }
+
+    return false;
+  }
+
+  void ReadAheadLoop()
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+      u32 frame = 0;
+      m_cv.wait(lk, [&] { return m_exit || FindFrameToReadAhead(&frame); });
+      if (m_exit)
+        return;
+
+      lk.unlock();
+      std::shared_ptr<const FifoFrameInfo> data = ReadFrame(frame);
+      lk.lock();
+      AddToCache(frame, std::move(data));
+    }
+  }
+
+  const std::vector<FileCompressedFrameInfo> m_frames;
+
+  std::mutex m_file_mutex;
+  File::IOFile m_file;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::map<u32, std::shared_ptr<const FifoFrameInfo>> m_cache;
+  size_t m_cache_size = 0;
+  u32 m_position = 0;
+  bool m_exit = false;
+  std::thread m_thread;
+};
+
+struct FifoDataFile::StreamWriter
+{
+  File::IOFile file;
+  std::vector<FileCompressedFrameInfo> frames;
+  bool ok = true;
+};
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -89,10 +360,36 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  if (m_StreamWriter)
+  {
+    FileCompressedFrameInfo info;
+    if (WriteCompressedFrame(frameInfo, m_StreamWriter->file, &info))
+      m_StreamWriter->frames.push_back(info);
+    else
+      m_StreamWriter->ok = false;
+    return;
+  }
+
+  m_Frames.push_back(std::make_shared<const FifoFrameInfo>(frameInfo));
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (m_FrameStream)
+    return m_FrameStream->GetFrame(frame);
+
+  return m_Frames[frame];
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  if (m_FrameStream)
+    return m_FrameStream->GetFrameCount();
+
+  return static_cast<u32>(m_Frames.size());
 }
 
-bool FifoDataFile::Save(const std::string& filename)
+bool FifoDataFile::Save(const std::string& filename, bool compressed)
 {
   File::IOFile file;
   if (!file.Open(filename, "wb"))
@@ -102,9 +399,87 @@ bool FifoDataFile::Save(const std::string& filename)
   PadFile(sizeof(FileHeader), file);
 
   // Add space for frame list
+  const u32 frameCount = GetFrameCount();
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(frameCount * sizeof(FileFrameInfo), file);
 
+  WriteRegistersAndHeader(frameListOffset, frameCount, compressed, file);
+
+  // Write frames list
+  for (u32 i = 0; i < frameCount; ++i)
+  {
+    const std::shared_ptr<const FifoFrameInfo> frame = GetFrame(i);
+    const FifoFrameInfo& srcFrame = *frame;
+    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
+
+    if (compressed)
+    {
+      FileCompressedFrameInfo dstFrame;
+      if (!WriteCompressedFrame(srcFrame, file, &dstFrame))
+        return false;
+
+      file.Seek(frameOffset, SEEK_SET);
+      file.WriteBytes(&dstFrame, sizeof(FileCompressedFrameInfo));
+      continue;
+    }
+
+    // Write FIFO data
+    file.Seek(0, SEEK_END);
+    u64 dataOffset = file.Tell();
+    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+
+    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+
+    FileFrameInfo dstFrame;
+    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
+    dstFrame.fifoDataOffset = dataOffset;
+    dstFrame.fifoStart = srcFrame.fifoStart;
+    dstFrame.fifoEnd = srcFrame.fifoEnd;
+    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
+    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+
+    // Write frame info
+    file.Seek(frameOffset, SEEK_SET);
+    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+  }
+
+  if (!file.Close())
+    return false;
+
+  return true;
+}
+
+bool FifoDataFile::StartStreamingSave(const std::string& filename)
+{
+  auto writer = std::make_unique<StreamWriter>();
+  if (!writer->file.Open(filename, "wb"))
+    return false;
+
+  // Add space for header
+  PadFile(sizeof(FileHeader), writer->file);
+
+  m_StreamWriter = std::move(writer);
+  return true;
+}
+
+bool FifoDataFile::FinishStreamingSave()
+{
+  std::unique_ptr<StreamWriter> writer = std::move(m_StreamWriter);
+
+  // The frame list goes after the chunks, since its size isn't known until the end.
+  writer->file.Seek(0, SEEK_END);
+  const u64 frameListOffset = writer->file.Tell();
+  writer->file.WriteArray(writer->frames.data(), writer->frames.size());
+
+  WriteRegistersAndHeader(frameListOffset, static_cast<u32>(writer->frames.size()), true,
+                          writer->file);
+
+  return writer->ok && writer->file.Close();
+}
+
+void FifoDataFile::WriteRegistersAndHeader(u64 frameListOffset, u32 frameCount, bool compressed,
+                                           File::IOFile& file)
+{
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem, BP_MEM_SIZE);
 
@@ -124,7 +499,7 @@ bool FifoDataFile::Save(const std::string& filename)
   FileHeader header;
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = compressed ? MIN_COMPRESSED_LOADER_VERSION : MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -142,43 +517,14 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frameCount;
 
-  header.flags = m_Flags;
+  header.flags = m_Flags & ~FLAG_COMPRESSED_FRAMES;
+  if (compressed)
+    header.flags |= FLAG_COMPRESSED_FRAMES;
 
   file.Seek(0, SEEK_SET);
   file.WriteBytes(&header, sizeof(FileHeader));
-
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, SEEK_SET);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
-  }
-
-  if (!file.Close())
-    return false;
-
-  return true;
 }
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
@@ -233,6 +579,18 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     file.ReadArray(dataFile->m_TexMem, size);
   }
 
+  // Compressed frames are only read when they are played back.
+  if (header.flags & FLAG_COMPRESSED_FRAMES)
+  {
+    std::vector<FileCompressedFrameInfo> frames(header.frameCount);
+    file.Seek(header.frameListOffset, SEEK_SET);
+    if (!file.ReadArray(frames.data(), frames.size()))
+      return nullptr;
+
+    dataFile->m_FrameStream = std::make_unique<FrameStream>(std::move(file), std::move(frames));
+    return dataFile;
+  }
+
   // Read frames
   for (u32 i = 0; i < header.frameCount; ++i)
   {
@@ -252,7 +610,7 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
                       dstFrame.memoryUpdates, file);
 
-    dataFile->AddFrame(dstFrame);
+    dataFile->m_Frames.push_back(std::make_shared<const FifoFrameInfo>(std::move(dstFrame)));
   }
 
   file.Close();
@@ -67,19 +67,34 @@ public:
   u32* GetXFRegs() { return m_XFRegs; }
   u8* GetTexMem() { return m_TexMem; }
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
-  bool Save(const std::string& filename);
+  // The frames of compressed files are only kept in memory around the playback position, so the
+  // returned pointer has to be held on to while the frame is used.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // Compressed files store every frame as a separate zlib-compressed chunk, which is read and
+  // decompressed while playing back instead of loading the whole file into memory.
+  bool Save(const std::string& filename, bool compressed = false);
+  // Saves a compressed file while frames are still being added. Every frame added in between is
+  // written to the file right away instead of being kept in memory. The register state is written
+  // when the save is finished, so it has to be set by then.
+  bool StartStreamingSave(const std::string& filename);
+  bool FinishStreamingSave();
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    FLAG_COMPRESSED_FRAMES = 2,
   };
 
+  class FrameStream;
+  struct StreamWriter;
+
   void PadFile(size_t numBytes, File::IOFile& file);
+  void WriteRegistersAndHeader(u64 frameListOffset, u32 frameCount, bool compressed,
+                               File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
@@ -97,5 +112,7 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  std::vector<std::shared_ptr<const FifoFrameInfo>> m_Frames;
+  std::unique_ptr<FrameStream> m_FrameStream;
+  std::unique_ptr<StreamWriter> m_StreamWriter;
 };
@@ -4,6 +4,7 @@
 
 #include "Core/FifoPlayer/FifoPlaybackAnalyzer.h"
 
+#include <memory>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -40,7 +41,8 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frameIdx = 0; frameIdx < file->GetFrameCount(); ++frameIdx)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frameIdx);
+    const std::shared_ptr<const FifoFrameInfo> frame_data = file->GetFrame(frameIdx);
+    const FifoFrameInfo& frame = *frame_data;
     AnalyzedFrameInfo& analyzed = frameInfo[frameIdx];
 
     s_DrawingObject = false;
@@ -89,6 +89,9 @@ public:
   // If enabled then all memory updates happen at once before the first frame
   // Default is disabled
   void SetEarlyMemoryUpdates(bool enabled) { m_EarlyMemoryUpdates = enabled; }
+  // Number of times the frame range is played back before stopping, for benchmarking.
+  // Zero plays it back once, or forever if looping is enabled.
+  void SetPlaybackCount(u32 count) { m_PlaybackCount = count; }
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback) { m_FileLoadedCb = callback; }
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = callback; }
@@ -144,6 +147,9 @@ private:
 
   bool m_EarlyMemoryUpdates = false;
 
+  u32 m_PlaybackCount = 0;
+  u32 m_CompletedPlaybacks = 0;
+
   u64 m_CyclesPerFrame = 0;
   u32 m_ElapsedCycles = 0;
   u32 m_FrameFifoSize = 0;
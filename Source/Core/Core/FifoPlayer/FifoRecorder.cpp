@@ -6,7 +6,10 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <utility>
 
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
@@ -23,17 +26,44 @@ FifoRecorder::FifoRecorder() = default;
 FifoRecorder::~FifoRecorder()
 {
   m_IsRecording = false;
+  StopWriterThread();
 }
 
 void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 {
   std::lock_guard<std::recursive_mutex> lk(sMutex);
 
+  StopWriterThread();
   delete m_File;
 
-  FifoAnalyzer::Init();
-
   m_File = new FifoDataFile;
+  StartRecordingInternal(numFrames, finishedCb);
+}
+
+bool FifoRecorder::StartRecordingToFile(const std::string& filename, s32 numFrames,
+                                        CallbackFunc finishedCb)
+{
+  std::lock_guard<std::recursive_mutex> lk(sMutex);
+
+  StopWriterThread();
+  delete m_File;
+  m_File = nullptr;
+
+  m_StreamFile = std::make_unique<FifoDataFile>();
+  if (!m_StreamFile->StartStreamingSave(filename))
+  {
+    m_StreamFile.reset();
+    return false;
+  }
+
+  m_WriterThread = std::thread(&FifoRecorder::WriterThreadFunc, this);
+  StartRecordingInternal(numFrames, finishedCb);
+  return true;
+}
+
+void FifoRecorder::StartRecordingInternal(s32 numFrames, CallbackFunc finishedCb)
+{
+  FifoAnalyzer::Init();
 
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
@@ -53,7 +83,10 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
   std::fill(m_Ram.begin(), m_Ram.end(), 0);
   std::fill(m_ExRam.begin(), m_ExRam.end(), 0);
 
-  m_File->SetIsWii(SConfig::GetInstance().bWii);
+  if (m_File)
+    m_File->SetIsWii(SConfig::GetInstance().bWii);
+  else
+    m_StreamFile->SetIsWii(SConfig::GetInstance().bWii);
 
   if (!m_IsRecording)
   {
@@ -71,6 +104,51 @@ void FifoRecorder::StopRecording()
   m_RequestedRecordingEnd = true;
 }
 
+void FifoRecorder::StopWriterThread()
+{
+  if (!m_WriterThread.joinable())
+    return;
+
+  // Finish the file with the frames queued so far if the recording didn't end by itself.
+  m_IsRecording = false;
+  m_StopWriter.Set();
+  m_FramesQueuedEvent.Set();
+
+  m_WriterThread.join();
+  m_StopWriter.Clear();
+  m_QueuedFrames.Clear();
+  m_StreamFile.reset();
+}
+
+void FifoRecorder::WriterThreadFunc()
+{
+  Common::SetCurrentThreadName("FIFO recorder writer");
+
+  while (true)
+  {
+    m_FramesQueuedEvent.Wait();
+
+    std::unique_ptr<FifoFrameInfo> frame;
+    bool finished = false;
+    while (!finished && m_QueuedFrames.Pop(frame))
+    {
+      if (frame)
+        m_StreamFile->AddFrame(*frame);
+      else
+        finished = true;
+    }
+
+    if (finished || m_StopWriter.IsSet())
+      break;
+  }
+
+  if (!m_StreamFile->FinishStreamingSave())
+    PanicAlert("FifoRecorder: Failed to write the FIFO log");
+
+  if (m_FinishedCb)
+    m_FinishedCb();
+}
+
 void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 {
   if (!m_SkipNextData)
@@ -90,7 +168,22 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
     memcpy(&m_FifoData[currentSize], data, size);
   }
 
-  if (m_FrameEnded && m_FifoData.size() > 0)
+  if (m_FrameEnded && m_FifoData.size() > 0 && m_StreamFile)
+  {
+    // Hand the frame over to the writer thread without copying it.
+    m_CurrentFrame.fifoData = std::move(m_FifoData);
+    m_QueuedFrames.Push(std::make_unique<FifoFrameInfo>(std::move(m_CurrentFrame)));
+
+    // m_SkipFutureData is only set at this point once the last frame has ended.
+    if (m_SkipFutureData)
+      m_QueuedFrames.Push(nullptr);
+    m_FramesQueuedEvent.Set();
+
+    m_CurrentFrame.memoryUpdates.clear();
+    m_FifoData.clear();
+    m_FrameEnded = false;
+  }
+  else if (m_FrameEnded && m_FifoData.size() > 0)
   {
     m_CurrentFrame.fifoData = m_FifoData;
 
@@ -198,16 +291,18 @@ void FifoRecorder::SetVideoMemory(const u32* bpMem, const u32* cpMem, const u32*
 {
   std::lock_guard<std::recursive_mutex> lk(sMutex);
 
-  if (m_File)
+  // The writer thread only reads the registers of a streamed file once the last frame is queued.
+  FifoDataFile* file = m_File ? m_File : m_StreamFile.get();
+  if (file)
   {
-    memcpy(m_File->GetBPMem(), bpMem, FifoDataFile::BP_MEM_SIZE * 4);
-    memcpy(m_File->GetCPMem(), cpMem, FifoDataFile::CP_MEM_SIZE * 4);
-    memcpy(m_File->GetXFMem(), xfMem, FifoDataFile::XF_MEM_SIZE * 4);
+    memcpy(file->GetBPMem(), bpMem, FifoDataFile::BP_MEM_SIZE * 4);
+    memcpy(file->GetCPMem(), cpMem, FifoDataFile::CP_MEM_SIZE * 4);
+    memcpy(file->GetXFMem(), xfMem, FifoDataFile::XF_MEM_SIZE * 4);
 
     u32 xfRegsCopySize = std::min((u32)FifoDataFile::XF_REGS_SIZE, xfRegsSize);
-    memcpy(m_File->GetXFRegs(), xfRegs, xfRegsCopySize * 4);
+    memcpy(file->GetXFRegs(), xfRegs, xfRegsCopySize * 4);
 
-    memcpy(m_File->GetTexMem(), texMem, FifoDataFile::TEX_MEM_SIZE);
+    memcpy(file->GetTexMem(), texMem, FifoDataFile::TEX_MEM_SIZE);
   }
 
   FifoRecordAnalyzer::Initialize(cpMem);
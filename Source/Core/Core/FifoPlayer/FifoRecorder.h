@@ -4,8 +4,14 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include "Common/Event.h"
+#include "Common/FifoQueue.h"
+#include "Common/Flag.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 class FifoRecorder
@@ -17,6 +23,11 @@ public:
   ~FifoRecorder();
 
   void StartRecording(s32 numFrames, CallbackFunc finishedCb);
+  // Records into a compressed file instead of memory. Finished frames are handed to a writer
+  // thread, which compresses them and writes them out, so the video thread never copies or saves
+  // a frame. GetRecordedFile() returns nullptr for these recordings, and finishedCb is called from
+  // the writer thread once the file is complete.
+  bool StartRecordingToFile(const std::string& filename, s32 numFrames, CallbackFunc finishedCb);
   void StopRecording();
 
   FifoDataFile* GetRecordedFile() const { return m_File; }
@@ -44,6 +55,10 @@ public:
   static FifoRecorder& GetInstance();
 
 private:
+  void StartRecordingInternal(s32 numFrames, CallbackFunc finishedCb);
+  void StopWriterThread();
+  void WriterThreadFunc();
+
   // Accessed from both GUI and video threads
 
   // True if video thread should send data
@@ -56,6 +71,13 @@ private:
 
   FifoDataFile* volatile m_File = nullptr;
 
+  // Accessed from the video and writer threads. A null frame ends the recording.
+  std::unique_ptr<FifoDataFile> m_StreamFile;
+  Common::FifoQueue<std::unique_ptr<FifoFrameInfo>, false> m_QueuedFrames;
+  Common::Event m_FramesQueuedEvent;
+  Common::Flag m_StopWriter;
+  std::thread m_WriterThread;
+
   // Accessed only from video thread
 
   bool m_SkipNextData = true;
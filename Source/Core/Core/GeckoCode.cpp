@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <tuple>
 #include <vector>
@@ -16,6 +17,7 @@
 
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 
 namespace Gecko
@@ -58,22 +60,265 @@ enum class Installation
 };
 
 static Installation s_code_handler_installed = Installation::Uninstalled;
-// the currently active codes
+// the currently active codes which are run by the code handler
 static std::vector<GeckoCode> s_active_codes;
+// the currently active codes which are run by RunNativeCodes
+static std::shared_ptr<const std::vector<GeckoCode>> s_native_codes;
 static std::mutex s_active_codes_lock;
 
+namespace
+{
+// What the code handler keeps track of while it goes through the code list.
+struct NativeState
+{
+  u32 base_address = 0x80000000;
+  u32 pointer_address = 0x80000000;
+  // Bit 0 is set while the codes are skipped because of a false condition, and every if code
+  // pushes its result on top of the ones of the codes it is nested in.
+  u32 skip = 0;
+};
+}  // Anonymous namespace
+
+// Whether every line of a code is one of the code types which RunNativeCodes implements: RAM
+// writes and fills, string writes, conditionals, setting and loading the base address and the
+// pointer, and terminators. Everything else, such as ASM insertion, Gecko registers and flow
+// control, is left to the code handler.
+static bool IsNativelySupported(const GeckoCode& gcode)
+{
+  for (size_t i = 0; i < gcode.codes.size(); ++i)
+  {
+    const GeckoCode::Code& code = gcode.codes[i];
+    const u32 type = code.address >> 24;
+
+    if (type < 0x20 && (type & 0x0E) <= 0x06)
+    {
+      // String writes are followed by the lines holding the string.
+      if ((type & 0x0E) == 0x06)
+        i += (code.data + CODE_SIZE - 1) / CODE_SIZE;
+      continue;
+    }
+
+    if (type >= 0x20 && type < 0x40)
+      continue;
+
+    if (type == 0x40 || type == 0x42 || type == 0x48 || type == 0x4A)
+    {
+      const u32 add = code.address >> 20 & 0xF;
+      const u32 base = code.address >> 16 & 0xF;
+      const u32 use_register = code.address >> 12 & 0xF;
+      if (add > 1 || base > 2 || use_register != 0)
+        return false;
+      continue;
+    }
+
+    if (type != 0xE0 && type != 0xE2 && type != 0xF0)
+      return false;
+  }
+
+  return true;
+}
+
+// Only writes which change memory can modify code, so the JIT only has to drop the blocks
+// covering those.
+static void InvalidateCode(u32 address, u32 size)
+{
+  for (u32 line = address & ~0x1f; line < address + size; line += 32)
+  {
+    PowerPC::ppcState.iCache.Invalidate(line);
+    JitInterface::InvalidateICache(line, 32, false);
+  }
+}
+
+static void WriteU8(u8 value, u32 address)
+{
+  if (!PowerPC::HostIsRAMAddress(address) || PowerPC::HostRead_U8(address) == value)
+    return;
+
+  PowerPC::HostWrite_U8(value, address);
+  InvalidateCode(address, sizeof(u8));
+}
+
+static void WriteU16(u16 value, u32 address)
+{
+  if (!PowerPC::HostIsRAMAddress(address) || PowerPC::HostRead_U16(address) == value)
+    return;
+
+  PowerPC::HostWrite_U16(value, address);
+  InvalidateCode(address, sizeof(u16));
+}
+
+static void WriteU32(u32 value, u32 address)
+{
+  if (!PowerPC::HostIsRAMAddress(address) || PowerPC::HostRead_U32(address) == value)
+    return;
+
+  PowerPC::HostWrite_U32(value, address);
+  InvalidateCode(address, sizeof(u32));
+}
+
+static bool CheckCondition(u32 type, u32 address, u32 data)
+{
+  if (!PowerPC::HostIsRAMAddress(address))
+    return false;
+
+  u32 value;
+  u32 compared;
+  if ((type & 0x08) == 0)
+  {
+    value = PowerPC::HostRead_U32(address);
+    compared = data;
+  }
+  else
+  {
+    value = PowerPC::HostRead_U16(address) & ~(data >> 16);
+    compared = data & 0xFFFF;
+  }
+
+  switch (type & 0x06)
+  {
+  case 0x00:
+    return value == compared;
+  case 0x02:
+    return value != compared;
+  case 0x04:
+    return value > compared;
+  default:
+    return value < compared;
+  }
+}
+
+// Runs one line of a code and returns the number of lines it takes up, or 0 at the end of the
+// code list. Refer to "codehandleronly.s" from Gecko OS for what each code type does.
+static size_t RunNativeCode(const GeckoCode& gcode, size_t index, NativeState* state)
+{
+  const GeckoCode::Code& code = gcode.codes[index];
+  const u32 type = code.address >> 24;
+  const bool skipped = (state->skip & 1) != 0;
+  const u32 base = (type & 0x10) ? state->pointer_address : state->base_address;
+  const u32 address = base + (code.address & 0x01FFFFFF);
+
+  if (type < 0x20)
+  {
+    switch (type & 0x0E)
+    {
+    case 0x00:
+      for (u32 i = 0; !skipped && i <= code.data >> 16; ++i)
+        WriteU8(static_cast<u8>(code.data), address + i);
+      return 1;
+    case 0x02:
+      for (u32 i = 0; !skipped && i <= code.data >> 16; ++i)
+        WriteU16(static_cast<u16>(code.data), address + i * sizeof(u16));
+      return 1;
+    case 0x04:
+      if (!skipped)
+        WriteU32(code.data, address);
+      return 1;
+    default:
+    {
+      for (u32 i = 0; !skipped && i < code.data; ++i)
+      {
+        const size_t line = index + 1 + i / CODE_SIZE;
+        if (line >= gcode.codes.size())
+          break;
+        const u32 word = (i % CODE_SIZE) < 4 ? gcode.codes[line].address : gcode.codes[line].data;
+        WriteU8(static_cast<u8>(word >> (24 - (i % 4) * 8)), address + i);
+      }
+      return 1 + (code.data + CODE_SIZE - 1) / CODE_SIZE;
+    }
+    }
+  }
+
+  if (type < 0x40)
+  {
+    // The lowest bit of the address makes the code end the previous conditional first.
+    if (code.address & 1)
+      state->skip >>= 1;
+    const bool skip = (state->skip & 1) != 0 || !CheckCondition(type, address & ~1, code.data);
+    state->skip = state->skip << 1 | (skip ? 1 : 0);
+    return 1;
+  }
+
+  if (type < 0xE0)
+  {
+    if (skipped)
+      return 1;
+
+    u32 value = code.data;
+    if ((code.address >> 16 & 0xF) == 1)
+      value += state->base_address;
+    else if ((code.address >> 16 & 0xF) == 2)
+      value += state->pointer_address;
+
+    // Loads read the address from memory, while sets use it directly.
+    if ((type & 0x02) == 0)
+      value = PowerPC::HostIsRAMAddress(value) ? PowerPC::HostRead_U32(value) : 0;
+
+    u32& target = (type & 0x08) ? state->pointer_address : state->base_address;
+    target = (code.address >> 20 & 0xF) ? target + value : value;
+    return 1;
+  }
+
+  if (type == 0xE0)
+  {
+    state->skip = 0;
+  }
+  else if (type == 0xE2)
+  {
+    state->skip >>= code.address & 0xFF;
+    // An else only makes the codes run if the conditional it belongs to is nested in a true one.
+    if ((code.address >> 20 & 0xF) == 1 && (state->skip & 2) == 0)
+      state->skip ^= 1;
+  }
+  else
+  {
+    return 0;
+  }
+
+  if (code.data >> 16)
+    state->base_address = code.data & 0xFFFF0000;
+  if (code.data & 0xFFFF)
+    state->pointer_address = code.data << 16;
+  return 1;
+}
+
+// Applies the codes directly instead of having the emulated CPU run the code handler for them,
+// which also means that the JIT only has to recompile the blocks that they actually change.
+static void RunNativeCodes(const std::vector<GeckoCode>& gcodes)
+{
+  NativeState state;
+  for (const GeckoCode& gcode : gcodes)
+  {
+    for (size_t i = 0; i < gcode.codes.size();)
+    {
+      const size_t lines = RunNativeCode(gcode, i, &state);
+      if (lines == 0)
+        return;
+      i += lines;
+    }
+  }
+}
+
 void SetActiveCodes(const std::vector<GeckoCode>& gcodes)
 {
   std::lock_guard<std::mutex> lk(s_active_codes_lock);
 
   s_active_codes.clear();
+  auto native_codes = std::make_shared<std::vector<GeckoCode>>();
   if (SConfig::GetInstance().bEnableCheats)
   {
-    s_active_codes.reserve(gcodes.size());
-    std::copy_if(gcodes.begin(), gcodes.end(), std::back_inserter(s_active_codes),
-                 [](const GeckoCode& code) { return code.enabled; });
+    for (const GeckoCode& gcode : gcodes)
+    {
+      if (!gcode.enabled)
+        continue;
+
+      if (IsNativelySupported(gcode))
+        native_codes->push_back(gcode);
+      else
+        s_active_codes.push_back(gcode);
+    }
   }
   s_active_codes.shrink_to_fit();
+  s_native_codes = std::move(native_codes);
 
   s_code_handler_installed = Installation::Uninstalled;
 }
@@ -189,6 +434,7 @@ void Shutdown()
 {
   std::lock_guard<std::mutex> codes_lock(s_active_codes_lock);
   s_active_codes.clear();
+  s_native_codes.reset();
   s_code_handler_installed = Installation::Uninstalled;
 }
 
@@ -198,6 +444,14 @@ void RunCodeHandler()
     return;
 
   // NOTE: Need to release the lock because of GUI deadlocks with PanicAlert in HostWrite_*
+  std::shared_ptr<const std::vector<GeckoCode>> native_codes;
+  {
+    std::lock_guard<std::mutex> codes_lock(s_active_codes_lock);
+    native_codes = s_native_codes;
+  }
+  if (native_codes)
+    RunNativeCodes(*native_codes);
+
   {
     std::lock_guard<std::mutex> codes_lock(s_active_codes_lock);
     if (s_code_handler_installed != Installation::Installed)
@@ -11,6 +11,8 @@
 
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
+#include "Core/HLE/HLE_Library.h"
+#include "Core/HLE/HLE_Math.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
 #include "Core/HW/Memmap.h"
@@ -70,6 +72,43 @@ static const SPatch OSPatches[] = {
     {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HLE_HOOK_START,   HLE_TYPE_DEBUG}, // used for early init things (normally)
     {"__write_console",              HLE_OS::HLE_write_console,             HLE_HOOK_START,   HLE_TYPE_DEBUG}, // used by sysmenu (+more?)
 
+    // Hot library functions
+    {"memcpy",                       HLE_Library::HLE_memcpy,               HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"memset",                       HLE_Library::HLE_memset,               HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"DCFlushRange",                 HLE_Library::HLE_DCFlushRange,         HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"DCFlushRangeNoSync",           HLE_Library::HLE_DCFlushRange,         HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"DCStoreRange",                 HLE_Library::HLE_DCStoreRange,         HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"DCStoreRangeNoSync",           HLE_Library::HLE_DCStoreRange,         HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"DCInvalidateRange",            HLE_Library::HLE_DCInvalidateRange,    HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+
+    {"PSMTXIdentity",                HLE_Math::HLE_PSMTXIdentity,           HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXCopy",                    HLE_Math::HLE_PSMTXCopy,               HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXConcat",                  HLE_Math::HLE_PSMTXConcat,             HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXTranspose",               HLE_Math::HLE_PSMTXTranspose,          HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXScale",                   HLE_Math::HLE_PSMTXScale,              HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXTrans",                   HLE_Math::HLE_PSMTXTrans,              HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXMultVec",                 HLE_Math::HLE_PSMTXMultVec,            HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXMultVecSR",               HLE_Math::HLE_PSMTXMultVecSR,          HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSMTXMultVecArray",            HLE_Math::HLE_PSMTXMultVecArray,       HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECAdd",                     HLE_Math::HLE_PSVECAdd,                HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECSubtract",                HLE_Math::HLE_PSVECSubtract,           HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECScale",                   HLE_Math::HLE_PSVECScale,              HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECNormalize",               HLE_Math::HLE_PSVECNormalize,          HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECSquareMag",               HLE_Math::HLE_PSVECSquareMag,          HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECMag",                     HLE_Math::HLE_PSVECMag,                HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECDotProduct",              HLE_Math::HLE_PSVECDotProduct,         HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECCrossProduct",            HLE_Math::HLE_PSVECCrossProduct,       HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECSquareDistance",          HLE_Math::HLE_PSVECSquareDistance,     HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"PSVECDistance",                HLE_Math::HLE_PSVECDistance,           HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+
+    {"GXPosition3f32",               HLE_Library::HLE_GXPosition3f32,       HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"GXPosition2f32",               HLE_Library::HLE_GXPosition2f32,       HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"GXPosition3s16",               HLE_Library::HLE_GXPosition3s16,       HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"GXNormal3f32",                 HLE_Library::HLE_GXNormal3f32,         HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"GXColor4u8",                   HLE_Library::HLE_GXColor4u8,           HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"GXColor1u32",                  HLE_Library::HLE_GXColor1u32,          HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+    {"GXTexCoord2f32",               HLE_Library::HLE_GXTexCoord2f32,       HLE_HOOK_REPLACE, HLE_TYPE_LIBRARY},
+
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HLE_HOOK_START,   HLE_TYPE_FIXED},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HLE_HOOK_REPLACE, HLE_TYPE_FIXED},
     {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HLE_HOOK_REPLACE, HLE_TYPE_FIXED} // apploader needs OSReport-like function
@@ -133,6 +172,9 @@ void PatchFunctions()
     if (OSPatches[i].flags == HLE_TYPE_FIXED)
       continue;
 
+    if (OSPatches[i].flags == HLE_TYPE_LIBRARY && !SConfig::GetInstance().bHLELibraryFunctions)
+      continue;
+
     for (const auto& symbol : g_symbolDB.GetSymbolsFromName(OSPatches[i].m_szPatchName))
     {
       for (u32 addr = symbol->address; addr < symbol->address + symbol->size; addr += 4)
@@ -214,6 +256,10 @@ int GetFunctionFlagsByIndex(u32 index)
 
 bool IsEnabled(int flags)
 {
+  // The library replacements don't handle page faults, and they would skip memchecks.
+  if (flags == HLE::HLE_TYPE_LIBRARY)
+    return !SConfig::GetInstance().bMMU && !PowerPC::memchecks.HasAny();
+
   return flags != HLE::HLE_TYPE_DEBUG || SConfig::GetInstance().bEnableDebugging ||
          PowerPC::GetMode() == PowerPC::CoreMode::Interpreter;
 }
@@ -0,0 +1,221 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HLE/HLE_Library.h"
+
+#include <cstring>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/GPFifo.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace HLE_Library
+{
+// Returns a host pointer for [address, address + size) if the whole range is RAM which the BATs
+// map contiguously, as they do for the usual 0x80000000 and 0xC0000000 mirrors. Pages with
+// memchecks and RAM behind the emulated data cache never qualify, see UpdateBATs.
+static u8* GetRAMPointer(u32 address, u32 size)
+{
+  const u32 last = address + size - 1;
+  if (size == 0 || last < address)
+    return nullptr;
+
+  u8* const pointer = PowerPC::GetOptimizableRAMPointer(address, 1);
+  if (!pointer)
+    return nullptr;
+
+  for (u32 page = (address >> PowerPC::BAT_INDEX_SHIFT) + 1;
+       page <= (last >> PowerPC::BAT_INDEX_SHIFT); ++page)
+  {
+    const u32 page_address = page << PowerPC::BAT_INDEX_SHIFT;
+    if (PowerPC::GetOptimizableRAMPointer(page_address, 1) != pointer + (page_address - address))
+      return nullptr;
+  }
+
+  // A BAT page can be larger than the memory behind it.
+  if (PowerPC::GetOptimizableRAMPointer(last, 1) != pointer + (last - address))
+    return nullptr;
+
+  return pointer;
+}
+
+// Anything else (MMIO, the EFB, the locked cache...) takes the same path as the guest code would.
+void ReadFromGuest(u32 address, void* data, u32 size)
+{
+  if (const u8* pointer = GetRAMPointer(address, size))
+  {
+    std::memcpy(data, pointer, size);
+    return;
+  }
+
+  u8* bytes = static_cast<u8*>(data);
+  for (u32 i = 0; i < size; ++i)
+    bytes[i] = PowerPC::Read_U8(address + i);
+}
+
+void WriteToGuest(u32 address, const void* data, u32 size)
+{
+  if (u8* pointer = GetRAMPointer(address, size))
+  {
+    std::memcpy(pointer, data, size);
+    return;
+  }
+
+  const u8* bytes = static_cast<const u8*>(data);
+  for (u32 i = 0; i < size; ++i)
+    PowerPC::Write_U8(bytes[i], address + i);
+}
+
+static float GetFloatArgument(int index)
+{
+  return static_cast<float>(rPS0(index));
+}
+
+static u32 GetFloatArgumentBits(int index)
+{
+  const float value = GetFloatArgument(index);
+  u32 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// void* memcpy(void* dst, const void* src, size_t n)
+void HLE_memcpy()
+{
+  const u32 dst = GPR(3);
+  const u32 src = GPR(4);
+  const u32 size = GPR(5);
+
+  u8* dst_pointer = GetRAMPointer(dst, size);
+  const u8* src_pointer = GetRAMPointer(src, size);
+  if (dst_pointer && src_pointer)
+  {
+    std::memmove(dst_pointer, src_pointer, size);
+  }
+  else
+  {
+    for (u32 i = 0; i < size; ++i)
+      PowerPC::Write_U8(PowerPC::Read_U8(src + i), dst + i);
+  }
+
+  NPC = LR;
+}
+
+// void* memset(void* dst, int c, size_t n)
+void HLE_memset()
+{
+  const u32 dst = GPR(3);
+  const u8 value = static_cast<u8>(GPR(4));
+  const u32 size = GPR(5);
+
+  if (u8* pointer = GetRAMPointer(dst, size))
+  {
+    std::memset(pointer, value, size);
+  }
+  else
+  {
+    for (u32 i = 0; i < size; ++i)
+      PowerPC::Write_U8(value, dst + i);
+  }
+
+  NPC = LR;
+}
+
+// void DCFlushRange(void* addr, u32 nBytes), and the same for DCStoreRange and
+// DCInvalidateRange. The loops of dcbf/dcbst/dcbi only matter for the JIT cache, unless the data
+// cache is emulated.
+template <void (*LineOperation)(u32)>
+static void DataCacheRange()
+{
+  const u32 address = GPR(3);
+  const u32 size = GPR(4);
+  NPC = LR;
+
+  if (size == 0)
+    return;
+
+  const u32 start = address & ~31;
+  const u32 end = Common::AlignUp(address + size, 32);
+  JitInterface::InvalidateICache(start, end - start, false);
+
+  if (SConfig::GetInstance().bAccurateCPUCache)
+  {
+    for (u32 line = start; line != end; line += 32)
+      LineOperation(line);
+  }
+}
+
+void HLE_DCFlushRange()
+{
+  DataCacheRange<PowerPC::FlushCacheLine>();
+}
+
+void HLE_DCStoreRange()
+{
+  DataCacheRange<PowerPC::StoreCacheLine>();
+}
+
+void HLE_DCInvalidateRange()
+{
+  DataCacheRange<PowerPC::InvalidateCacheLine>();
+}
+
+// The GX vertex helpers which games didn't get inlined, writing straight to the gather pipe.
+
+void HLE_GXPosition3f32()
+{
+  GPFifo::Write32(GetFloatArgumentBits(1));
+  GPFifo::Write32(GetFloatArgumentBits(2));
+  GPFifo::Write32(GetFloatArgumentBits(3));
+  NPC = LR;
+}
+
+void HLE_GXPosition2f32()
+{
+  GPFifo::Write32(GetFloatArgumentBits(1));
+  GPFifo::Write32(GetFloatArgumentBits(2));
+  NPC = LR;
+}
+
+void HLE_GXPosition3s16()
+{
+  GPFifo::Write16(static_cast<u16>(GPR(3)));
+  GPFifo::Write16(static_cast<u16>(GPR(4)));
+  GPFifo::Write16(static_cast<u16>(GPR(5)));
+  NPC = LR;
+}
+
+void HLE_GXNormal3f32()
+{
+  GPFifo::Write32(GetFloatArgumentBits(1));
+  GPFifo::Write32(GetFloatArgumentBits(2));
+  GPFifo::Write32(GetFloatArgumentBits(3));
+  NPC = LR;
+}
+
+void HLE_GXColor4u8()
+{
+  GPFifo::Write8(static_cast<u8>(GPR(3)));
+  GPFifo::Write8(static_cast<u8>(GPR(4)));
+  GPFifo::Write8(static_cast<u8>(GPR(5)));
+  GPFifo::Write8(static_cast<u8>(GPR(6)));
+  NPC = LR;
+}
+
+void HLE_GXColor1u32()
+{
+  GPFifo::Write32(GPR(3));
+  NPC = LR;
+}
+
+void HLE_GXTexCoord2f32()
+{
+  GPFifo::Write32(GetFloatArgumentBits(1));
+  GPFifo::Write32(GetFloatArgumentBits(2));
+  NPC = LR;
+}
+}
@@ -0,0 +1,31 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Native replacements for hot SDK and libc functions. They are only used when
+// bHLELibraryFunctions is set, see HLE::IsEnabled.
+namespace HLE_Library
+{
+// Copy between guest memory and a host buffer, with the data in guest byte order.
+void ReadFromGuest(u32 address, void* data, u32 size);
+void WriteToGuest(u32 address, const void* data, u32 size);
+
+void HLE_memcpy();
+void HLE_memset();
+
+void HLE_DCFlushRange();
+void HLE_DCStoreRange();
+void HLE_DCInvalidateRange();
+
+void HLE_GXPosition3f32();
+void HLE_GXPosition2f32();
+void HLE_GXPosition3s16();
+void HLE_GXNormal3f32();
+void HLE_GXColor4u8();
+void HLE_GXColor1u32();
+void HLE_GXTexCoord2f32();
+}
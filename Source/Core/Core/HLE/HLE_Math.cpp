@@ -0,0 +1,266 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HLE/HLE_Math.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/HLE/HLE_Library.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace HLE_Math
+{
+// Mtx is float[3][4], row-major. Vec is float[3].
+using Mtx = std::array<float, 12>;
+using Vec = std::array<float, 3>;
+
+template <size_t N>
+static std::array<float, N> ReadFloats(u32 address)
+{
+  std::array<u32, N> words;
+  HLE_Library::ReadFromGuest(address, words.data(), sizeof(words));
+
+  std::array<float, N> values;
+  for (size_t i = 0; i < N; ++i)
+  {
+    const u32 word = Common::swap32(words[i]);
+    std::memcpy(&values[i], &word, sizeof(float));
+  }
+  return values;
+}
+
+template <size_t N>
+static void WriteFloats(u32 address, const std::array<float, N>& values)
+{
+  std::array<u32, N> words;
+  for (size_t i = 0; i < N; ++i)
+  {
+    u32 word;
+    std::memcpy(&word, &values[i], sizeof(float));
+    words[i] = Common::swap32(word);
+  }
+  HLE_Library::WriteToGuest(address, words.data(), sizeof(words));
+}
+
+static float GetFloatArgument(int index)
+{
+  return static_cast<float>(rPS0(index));
+}
+
+static void ReturnFloat(float value)
+{
+  rPS0(1) = value;
+  rPS1(1) = value;
+  NPC = LR;
+}
+
+static Vec MultVec(const Mtx& m, const Vec& v, bool translate)
+{
+  Vec result;
+  for (int i = 0; i < 3; ++i)
+  {
+    result[i] = m[i * 4 + 0] * v[0] + m[i * 4 + 1] * v[1] + m[i * 4 + 2] * v[2];
+    if (translate)
+      result[i] += m[i * 4 + 3];
+  }
+  return result;
+}
+
+static float Dot(const Vec& a, const Vec& b)
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// void PSMTXIdentity(Mtx m)
+void HLE_PSMTXIdentity()
+{
+  WriteFloats<12>(GPR(3), {{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0}});
+  NPC = LR;
+}
+
+// void PSMTXCopy(const Mtx src, Mtx dst)
+void HLE_PSMTXCopy()
+{
+  WriteFloats(GPR(4), ReadFloats<12>(GPR(3)));
+  NPC = LR;
+}
+
+// void PSMTXConcat(const Mtx a, const Mtx b, Mtx ab), where ab may alias a or b
+void HLE_PSMTXConcat()
+{
+  const Mtx a = ReadFloats<12>(GPR(3));
+  const Mtx b = ReadFloats<12>(GPR(4));
+
+  Mtx ab;
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      ab[i * 4 + j] =
+          a[i * 4 + 0] * b[0 * 4 + j] + a[i * 4 + 1] * b[1 * 4 + j] + a[i * 4 + 2] * b[2 * 4 + j];
+    }
+    ab[i * 4 + 3] += a[i * 4 + 3];
+  }
+
+  WriteFloats(GPR(5), ab);
+  NPC = LR;
+}
+
+// void PSMTXTranspose(const Mtx src, Mtx xPose)
+void HLE_PSMTXTranspose()
+{
+  const Mtx src = ReadFloats<12>(GPR(3));
+
+  Mtx xpose;
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+      xpose[i * 4 + j] = src[j * 4 + i];
+    xpose[i * 4 + 3] = 0;
+  }
+
+  WriteFloats(GPR(4), xpose);
+  NPC = LR;
+}
+
+// void PSMTXScale(Mtx m, f32 xS, f32 yS, f32 zS)
+void HLE_PSMTXScale()
+{
+  const float x = GetFloatArgument(1);
+  const float y = GetFloatArgument(2);
+  const float z = GetFloatArgument(3);
+  WriteFloats<12>(GPR(3), {{x, 0, 0, 0, 0, y, 0, 0, 0, 0, z, 0}});
+  NPC = LR;
+}
+
+// void PSMTXTrans(Mtx m, f32 xT, f32 yT, f32 zT)
+void HLE_PSMTXTrans()
+{
+  const float x = GetFloatArgument(1);
+  const float y = GetFloatArgument(2);
+  const float z = GetFloatArgument(3);
+  WriteFloats<12>(GPR(3), {{1, 0, 0, x, 0, 1, 0, y, 0, 0, 1, z}});
+  NPC = LR;
+}
+
+// void PSMTXMultVec(const Mtx m, const Vec* src, Vec* dst)
+void HLE_PSMTXMultVec()
+{
+  WriteFloats(GPR(5), MultVec(ReadFloats<12>(GPR(3)), ReadFloats<3>(GPR(4)), true));
+  NPC = LR;
+}
+
+// void PSMTXMultVecSR(const Mtx m, const Vec* src, Vec* dst)
+void HLE_PSMTXMultVecSR()
+{
+  WriteFloats(GPR(5), MultVec(ReadFloats<12>(GPR(3)), ReadFloats<3>(GPR(4)), false));
+  NPC = LR;
+}
+
+// void PSMTXMultVecArray(const Mtx m, const Vec* srcBase, Vec* dstBase, u32 count)
+void HLE_PSMTXMultVecArray()
+{
+  const Mtx m = ReadFloats<12>(GPR(3));
+  const u32 src = GPR(4);
+  const u32 dst = GPR(5);
+  const u32 count = GPR(6);
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    const u32 offset = i * static_cast<u32>(sizeof(Vec));
+    WriteFloats(dst + offset, MultVec(m, ReadFloats<3>(src + offset), true));
+  }
+  NPC = LR;
+}
+
+// void PSVECAdd(const Vec* a, const Vec* b, Vec* ab)
+void HLE_PSVECAdd()
+{
+  const Vec a = ReadFloats<3>(GPR(3));
+  const Vec b = ReadFloats<3>(GPR(4));
+  WriteFloats<3>(GPR(5), {{a[0] + b[0], a[1] + b[1], a[2] + b[2]}});
+  NPC = LR;
+}
+
+// void PSVECSubtract(const Vec* a, const Vec* b, Vec* a_b)
+void HLE_PSVECSubtract()
+{
+  const Vec a = ReadFloats<3>(GPR(3));
+  const Vec b = ReadFloats<3>(GPR(4));
+  WriteFloats<3>(GPR(5), {{a[0] - b[0], a[1] - b[1], a[2] - b[2]}});
+  NPC = LR;
+}
+
+// void PSVECScale(const Vec* src, Vec* dst, f32 scale)
+void HLE_PSVECScale()
+{
+  const Vec v = ReadFloats<3>(GPR(3));
+  const float scale = GetFloatArgument(1);
+  WriteFloats<3>(GPR(4), {{v[0] * scale, v[1] * scale, v[2] * scale}});
+  NPC = LR;
+}
+
+// void PSVECNormalize(const Vec* src, Vec* unit)
+// The SDK refines frsqrte with one Newton-Raphson step, which can be off in the last bit or so.
+void HLE_PSVECNormalize()
+{
+  const Vec v = ReadFloats<3>(GPR(3));
+  const float scale = 1.0f / std::sqrt(Dot(v, v));
+  WriteFloats<3>(GPR(4), {{v[0] * scale, v[1] * scale, v[2] * scale}});
+  NPC = LR;
+}
+
+// f32 PSVECSquareMag(const Vec* v)
+void HLE_PSVECSquareMag()
+{
+  const Vec v = ReadFloats<3>(GPR(3));
+  ReturnFloat(Dot(v, v));
+}
+
+// f32 PSVECMag(const Vec* v)
+void HLE_PSVECMag()
+{
+  const Vec v = ReadFloats<3>(GPR(3));
+  ReturnFloat(std::sqrt(Dot(v, v)));
+}
+
+// f32 PSVECDotProduct(const Vec* a, const Vec* b)
+void HLE_PSVECDotProduct()
+{
+  ReturnFloat(Dot(ReadFloats<3>(GPR(3)), ReadFloats<3>(GPR(4))));
+}
+
+// void PSVECCrossProduct(const Vec* a, const Vec* b, Vec* axb)
+void HLE_PSVECCrossProduct()
+{
+  const Vec a = ReadFloats<3>(GPR(3));
+  const Vec b = ReadFloats<3>(GPR(4));
+  WriteFloats<3>(GPR(5), {{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+                           a[0] * b[1] - a[1] * b[0]}});
+  NPC = LR;
+}
+
+static float SquareDistance(const Vec& a, const Vec& b)
+{
+  const Vec d = {{a[0] - b[0], a[1] - b[1], a[2] - b[2]}};
+  return Dot(d, d);
+}
+
+// f32 PSVECSquareDistance(const Vec* a, const Vec* b)
+void HLE_PSVECSquareDistance()
+{
+  ReturnFloat(SquareDistance(ReadFloats<3>(GPR(3)), ReadFloats<3>(GPR(4))));
+}
+
+// f32 PSVECDistance(const Vec* a, const Vec* b)
+void HLE_PSVECDistance()
+{
+  ReturnFloat(std::sqrt(SquareDistance(ReadFloats<3>(GPR(3)), ReadFloats<3>(GPR(4)))));
+}
+}
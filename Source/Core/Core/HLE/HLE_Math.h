@@ -0,0 +1,30 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// Native replacements for the paired single matrix and vector functions of the SDK's MTX library.
+namespace HLE_Math
+{
+void HLE_PSMTXIdentity();
+void HLE_PSMTXCopy();
+void HLE_PSMTXConcat();
+void HLE_PSMTXTranspose();
+void HLE_PSMTXScale();
+void HLE_PSMTXTrans();
+void HLE_PSMTXMultVec();
+void HLE_PSMTXMultVecSR();
+void HLE_PSMTXMultVecArray();
+
+void HLE_PSVECAdd();
+void HLE_PSVECSubtract();
+void HLE_PSVECScale();
+void HLE_PSVECNormalize();
+void HLE_PSVECSquareMag();
+void HLE_PSVECMag();
+void HLE_PSVECDotProduct();
+void HLE_PSVECCrossProduct();
+void HLE_PSVECSquareDistance();
+void HLE_PSVECDistance();
+}
@@ -12,15 +12,24 @@
 #error AXVoice.h included without specifying version
 #endif
 
+#include <algorithm>
+#include <array>
 #include <functional>
 
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MathUtil.h"
+#include "Core/DSP/DSPAccelerator.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP
 {
 namespace HLE
@@ -306,6 +315,70 @@ u16 AcceleratorGetSample()
   return ret;
 }
 
+// Reads <count> samples from the simulated accelerator. This gives the same
+// results as calling AcceleratorGetSample <count> times, but the ADPCM samples
+// which belong to the same frame and don't reach the end address are decoded
+// at once.
+void AcceleratorGetSamples(s16* output, u32 count)
+{
+  while (count)
+  {
+    u32 decoded = 0;
+    if (!acc_end_reached && acc_pb->audio_addr.sample_format == 0x00)
+    {
+      u32 addr = *acc_cur_addr;
+      if ((addr & 15) == 0)
+      {
+        acc_pb->adpcm.pred_scale = DSP::ReadARAM((addr & ~15) >> 1);
+        addr += 2;
+        *acc_cur_addr = addr;
+      }
+
+      u32 step_size_bytes;
+      switch (acc_end_addr & 15)
+      {
+      case 0:  // Tom and Jerry
+        step_size_bytes = 1;
+        break;
+      case 1:  // Blazing Angels
+        step_size_bytes = 0;
+        break;
+      default:
+        step_size_bytes = 2;
+        break;
+      }
+
+      // Stop before the sample after which the end address is reached, the
+      // single sample path handles looping.
+      u32 run = std::min<u32>(count, 16 - (addr & 15));
+      const u32 end_trigger_addr = acc_end_addr + step_size_bytes - 1;
+      if (end_trigger_addr > addr && end_trigger_addr - addr <= run)
+        run = end_trigger_addr - addr - 1;
+
+      if (run)
+      {
+        u8 frame[8];
+        for (u32 i = 0; i < 8; ++i)
+          frame[i] = DSP::ReadARAM(((addr & ~15) >> 1) + i);
+
+        DSP::DecodeADPCMFrame(output, frame, addr & 15, run, acc_pb->adpcm.coefs,
+                              acc_pb->adpcm.pred_scale, &acc_pb->adpcm.yn1, &acc_pb->adpcm.yn2);
+        *acc_cur_addr = addr + run;
+        decoded = run;
+      }
+    }
+
+    if (!decoded)
+    {
+      *output = AcceleratorGetSample();
+      decoded = 1;
+    }
+
+    output += decoded;
+    count -= decoded;
+  }
+}
+
 // Reads samples from the input callback, resamples them to <count> samples at
 // the wanted sample rate (computed from the ratio, see below).
 //
@@ -450,9 +523,24 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  // The number of input samples the resampler consumes only depends on the
+  // position and ratio, so they can be decoded up front.
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  u64 input_count = count;
+  if (pb.src_type == SRCTYPE_LINEAR || pb.src_type == SRCTYPE_POLYPHASE)
+    input_count = (pb.src.cur_addr_frac + static_cast<u64>(count) * ratio) >> 16;
+
+  std::array<s16, 0x400> input_samples;
+  std::function<s16(u32)> input_callback = [](u32) { return AcceleratorGetSample(); };
+  if (input_count <= input_samples.size())
+  {
+    AcceleratorGetSamples(input_samples.data(), static_cast<u32>(input_count));
+    input_callback = [&input_samples](u32 i) { return input_samples[i]; };
+  }
+
+  u32 curr_pos = ResampleAudio(input_callback, samples, count, pb.src.last_samples,
+                               pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position in the PB.
@@ -460,9 +548,101 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.audio_addr.cur_addr_lo = (u16)(cur_addr & 0xFFFF);
 }
 
+// Multiplies the samples by a volume which is ramped by <volume_delta> after
+// each sample, and clamps the results. The volume wraps around like the 16 bit
+// DSP register does. Input and output may be the same buffer. Returns the
+// volume after the last sample.
+#if defined(_M_X86)
+FUNCTION_TARGET_SSR41
+u16 RampVolume_SSE41(s16* output, const s16* input, u32 count, u16 volume, u16 volume_delta)
+{
+  // Eight volumes at a time, one per lane.
+  __m128i vol = _mm_add_epi16(
+      _mm_set1_epi16(volume),
+      _mm_mullo_epi16(_mm_set1_epi16(volume_delta), _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7)));
+  const __m128i vol_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  const __m128i min = _mm_set1_epi16(-32767);
+
+  u32 i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const __m128i lo = _mm_mullo_epi32(_mm_cvtepi16_epi32(in), _mm_cvtepu16_epi32(vol));
+    const __m128i hi = _mm_mullo_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(in, 8)),
+                                       _mm_cvtepu16_epi32(_mm_srli_si128(vol, 8)));
+    // The pack saturates to [-32768, 32767], the max takes care of the lower bound.
+    const __m128i samples =
+        _mm_max_epi16(_mm_packs_epi32(_mm_srai_epi32(lo, 15), _mm_srai_epi32(hi, 15)), min);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), samples);
+    vol = _mm_add_epi16(vol, vol_step);
+  }
+  volume += volume_delta * i;
+
+  for (; i < count; ++i)
+  {
+    output[i] = MathUtil::Clamp((input[i] * volume) >> 15, -32767, 32767);
+    volume += volume_delta;
+  }
+  return volume;
+}
+#elif defined(_M_ARM_64)
+u16 RampVolume_NEON(s16* output, const s16* input, u32 count, u16 volume, u16 volume_delta)
+{
+  static const u16 lane_steps[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  uint16x8_t vol =
+      vmlaq_u16(vdupq_n_u16(volume), vdupq_n_u16(volume_delta), vld1q_u16(lane_steps));
+  const uint16x8_t vol_step = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+  const int16x8_t min = vdupq_n_s16(-32767);
+
+  u32 i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t in = vld1q_s16(input + i);
+    const int32x4_t lo = vmulq_s32(vmovl_s16(vget_low_s16(in)),
+                                   vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vol))));
+    const int32x4_t hi = vmulq_s32(vmovl_s16(vget_high_s16(in)),
+                                   vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(vol))));
+    // The narrowing shift saturates to [-32768, 32767], the max takes care of the lower bound.
+    const int16x8_t samples =
+        vmaxq_s16(vcombine_s16(vqshrn_n_s32(lo, 15), vqshrn_n_s32(hi, 15)), min);
+    vst1q_s16(output + i, samples);
+    vol = vaddq_u16(vol, vol_step);
+  }
+  volume += volume_delta * i;
+
+  for (; i < count; ++i)
+  {
+    output[i] = MathUtil::Clamp((input[i] * volume) >> 15, -32767, 32767);
+    volume += volume_delta;
+  }
+  return volume;
+}
+#endif
+
+u16 RampVolume(s16* output, const s16* input, u32 count, u16 volume, u16 volume_delta)
+{
+#if defined(_M_X86)
+  if (cpu_info.bSSE4_1)
+    return RampVolume_SSE41(output, input, count, volume, volume_delta);
+#elif defined(_M_ARM_64)
+  return RampVolume_NEON(output, input, count, volume, volume_delta);
+#endif
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    // The product of a s16 and a u16 always fits in 32 bits.
+    output[i] = MathUtil::Clamp((input[i] * volume) >> 15, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+  return volume;
+}
+
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
 {
+  if (count == 0)
+    return;
+
   u16& volume = pvol[0];
   u16 volume_delta = pvol[1];
 
@@ -472,18 +652,13 @@ void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ra
   if (!ramp)
     volume_delta = 0;
 
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = MathUtil::Clamp((s32)sample, -32767, 32767);  // -32768 ?
+  s16 samples[MAX_SAMPLES_PER_FRAME];
+  volume = RampVolume(samples, input, count, volume, volume_delta);
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
+  for (u32 i = 0; i < count; ++i)
+    out[i] += samples[i];
 
-    *dpop = (s16)sample;
-  }
+  *dpop = samples[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -509,12 +684,8 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    samples[i] = MathUtil::Clamp(((s32)samples[i] * pb.vol_env.cur_volume) >> 15, -32767,
-                                 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = RampVolume(samples, samples, count, pb.vol_env.cur_volume,
+                                     static_cast<u16>(pb.vol_env.cur_volume_delta));
 
   // Optionally, execute a low pass filter
   // TODO: LPF code is currently broken, causing Super Monkey Ball sound
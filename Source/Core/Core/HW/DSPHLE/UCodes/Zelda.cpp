@@ -4,13 +4,20 @@
 
 #include "Core/HW/DSPHLE/UCodes/Zelda.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <thread>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/ConfigManager.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
@@ -124,6 +131,7 @@ ZeldaUCode::ZeldaUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc)
 
   m_flags = it->second;
   m_renderer.SetFlags(m_flags);
+  m_renderer.SetParallelVoices(SConfig::GetInstance().m_DSPZeldaParallelVoices);
 
   INFO_LOG(DSPHLE, "Zelda UCode loaded, crc=%08x, flags=%08x", crc, m_flags);
 }
@@ -636,7 +644,10 @@ void ZeldaUCode::RenderAudio()
       // If we are not meant to render this voice yet, go back to message
       // processing.
       if (m_rendering_curr_voice >= m_sync_max_voice_id)
+      {
+        m_renderer.RenderPendingVoices();
         return;
+      }
 
       // Test the sync flag for this voice, skip it if not set.
       u16 flags = m_sync_voice_skip_flags[m_rendering_curr_voice >> 4];
@@ -1161,7 +1172,201 @@ ZeldaAudioRenderer::MixingBuffer* ZeldaAudioRenderer::BufferForID(u16 buffer_id)
   }
 }
 
+// Runs the same job over a range of indices, on a few worker threads as well
+// as on the thread which submitted it.
+class ZeldaAudioRenderer::VoicePool
+{
+public:
+  explicit VoicePool(size_t num_workers)
+  {
+    for (size_t i = 0; i < num_workers; ++i)
+      m_workers.emplace_back(&VoicePool::WorkerLoop, this);
+  }
+
+  ~VoicePool()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_exit = true;
+    }
+    m_work_cv.notify_all();
+    for (std::thread& worker : m_workers)
+      worker.join();
+  }
+
+  // Calls job(i) for every i in [0, count), and returns once all of them are done.
+  void Run(size_t count, const std::function<void(size_t)>& job)
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_job = &job;
+      m_count = count;
+      m_next_index.store(0);
+      m_busy_workers = m_workers.size();
+      m_generation++;
+    }
+    m_work_cv.notify_all();
+
+    RunJobs();
+
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_done_cv.wait(lk, [this] { return m_busy_workers == 0; });
+    m_job = nullptr;
+  }
+
+private:
+  void WorkerLoop()
+  {
+    u64 seen_generation = 0;
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+      m_work_cv.wait(lk, [&] { return m_exit || m_generation != seen_generation; });
+      if (m_exit)
+        return;
+      seen_generation = m_generation;
+
+      lk.unlock();
+      RunJobs();
+      lk.lock();
+
+      if (--m_busy_workers == 0)
+        m_done_cv.notify_one();
+    }
+  }
+
+  void RunJobs()
+  {
+    for (size_t i = m_next_index++; i < m_count; i = m_next_index++)
+      (*m_job)(i);
+  }
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  const std::function<void(size_t)>* m_job = nullptr;
+  size_t m_count = 0;
+  std::atomic<size_t> m_next_index{0};
+  size_t m_busy_workers = 0;
+  u64 m_generation = 0;
+  bool m_exit = false;
+};
+
+const std::array<ZeldaAudioRenderer::MixingBuffer ZeldaAudioRenderer::*,
+                 ZeldaAudioRenderer::NUM_MIXING_BUFFERS>
+    ZeldaAudioRenderer::s_mixing_buffers = {{
+        &ZeldaAudioRenderer::m_buf_front_left, &ZeldaAudioRenderer::m_buf_front_right,
+        &ZeldaAudioRenderer::m_buf_back_left, &ZeldaAudioRenderer::m_buf_back_right,
+        &ZeldaAudioRenderer::m_buf_front_left_reverb,
+        &ZeldaAudioRenderer::m_buf_front_right_reverb,
+        &ZeldaAudioRenderer::m_buf_back_left_reverb, &ZeldaAudioRenderer::m_buf_back_right_reverb,
+        &ZeldaAudioRenderer::m_buf_unk0_reverb, &ZeldaAudioRenderer::m_buf_unk1_reverb,
+        &ZeldaAudioRenderer::m_buf_unk0, &ZeldaAudioRenderer::m_buf_unk1,
+        &ZeldaAudioRenderer::m_buf_unk2,
+    }};
+
+ZeldaAudioRenderer::ZeldaAudioRenderer() = default;
+ZeldaAudioRenderer::~ZeldaAudioRenderer() = default;
+
+void ZeldaAudioRenderer::SetParallelVoices(bool enabled)
+{
+  m_voice_pool.reset();
+
+  // The thread submitting a batch renders voices as well, so with a single
+  // hardware thread there is nothing to gain.
+  const unsigned int num_threads = std::thread::hardware_concurrency();
+  if (enabled && num_threads > 1)
+    m_voice_pool = std::make_unique<VoicePool>(std::min(num_threads - 1, 3u));
+}
+
 void ZeldaAudioRenderer::AddVoice(u16 voice_id)
+{
+  if (m_voice_pool)
+    m_pending_voices.push_back(voice_id);
+  else
+    RenderVoice(voice_id, nullptr);
+}
+
+void ZeldaAudioRenderer::RenderPendingVoices()
+{
+  size_t begin = 0;
+  while (begin < m_pending_voices.size())
+  {
+    size_t end = begin;
+    while (end < m_pending_voices.size() && !ReadsMixingBuffers(m_pending_voices[end]))
+      end++;
+
+    RenderVoiceBatch(begin, end);
+    if (end < m_pending_voices.size())
+      RenderVoice(m_pending_voices[end++], nullptr);
+
+    begin = end;
+  }
+  m_pending_voices.clear();
+}
+
+bool ZeldaAudioRenderer::ReadsMixingBuffers(u16 voice_id)
+{
+  VPB vpb;
+  FetchVPB(voice_id, &vpb);
+  return vpb.enabled && !vpb.done && !vpb.use_constant_sample &&
+         vpb.samples_source_type == VPB::SRC_CONST_PATTERN_0_VARIABLE_STEP;
+}
+
+void ZeldaAudioRenderer::RenderVoiceBatch(size_t begin, size_t end)
+{
+  const size_t count = end - begin;
+  if (count == 0)
+    return;
+
+  if (m_voice_outputs.size() < count)
+    m_voice_outputs.resize(count);
+
+  m_voice_pool->Run(count, [this, begin](size_t i) {
+    m_voice_outputs[i].used_mask = 0;
+    RenderVoice(m_pending_voices[begin + i], &m_voice_outputs[i]);
+  });
+
+  // Mixing wraps around on overflow, so adding up the private buffers gives
+  // exactly the same result as mixing each voice into the shared buffers.
+  for (size_t i = 0; i < count; ++i)
+  {
+    const VoiceOutput& output = m_voice_outputs[i];
+    for (size_t j = 0; j < NUM_MIXING_BUFFERS; ++j)
+    {
+      if (!(output.used_mask & (1 << j)))
+        continue;
+
+      MixingBuffer& dst = this->*s_mixing_buffers[j];
+      for (size_t k = 0; k < dst.size(); ++k)
+        dst[k] += output.buffers[j][k];
+    }
+  }
+}
+
+ZeldaAudioRenderer::MixingBuffer* ZeldaAudioRenderer::MixTarget(MixingBuffer* buffer,
+                                                                VoiceOutput* output)
+{
+  if (!output)
+    return buffer;
+
+  for (size_t i = 0; i < NUM_MIXING_BUFFERS; ++i)
+  {
+    if (&(this->*s_mixing_buffers[i]) != buffer)
+      continue;
+
+    if (!(output->used_mask & (1 << i)))
+    {
+      output->buffers[i].fill(0);
+      output->used_mask |= 1 << i;
+    }
+    return &output->buffers[i];
+  }
+  return buffer;
+}
+
+void ZeldaAudioRenderer::RenderVoice(u16 voice_id, VoiceOutput* output)
 {
   VPB vpb;
   FetchVPB(voice_id, &vpb);
@@ -1239,7 +1444,8 @@ void ZeldaAudioRenderer::AddVoice(u16 voice_id)
     };
     for (const auto& buffer : buffers)
     {
-      AddBuffersWithVolumeRamp(buffer.buffer, input_samples, buffer.volume << 16,
+      AddBuffersWithVolumeRamp(MixTarget(buffer.buffer, output), input_samples,
+                               buffer.volume << 16,
                                (buffer.volume_delta << 16) / (s32)buffer.buffer->size());
     }
 
@@ -1293,7 +1499,7 @@ void ZeldaAudioRenderer::AddVoice(u16 voice_id)
         continue;
       }
 
-      s32 new_volume = AddBuffersWithVolumeRamp(dst_buffer, input_samples,
+      s32 new_volume = AddBuffersWithVolumeRamp(MixTarget(dst_buffer, output), input_samples,
                                                 vpb.channels[i].current_volume << 16, volume_step);
       vpb.channels[i].current_volume = new_volume >> 16;
     }
@@ -1309,6 +1515,8 @@ void ZeldaAudioRenderer::AddVoice(u16 voice_id)
 
 void ZeldaAudioRenderer::FinalizeFrame()
 {
+  RenderPendingVoices();
+
   // TODO: Dolby mixing.
 
   ApplyVolumeInPlace_4_12(&m_buf_front_left, m_output_volume);
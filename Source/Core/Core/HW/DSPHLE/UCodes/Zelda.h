@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
@@ -19,10 +21,18 @@ class DSPHLE;
 class ZeldaAudioRenderer
 {
 public:
+  ZeldaAudioRenderer();
+  ~ZeldaAudioRenderer();
+
   void PrepareFrame();
   void AddVoice(u16 voice_id);
   void FinalizeFrame();
 
+  // When enabled, AddVoice only queues voices, and they get rendered on several threads by
+  // RenderPendingVoices (or FinalizeFrame). The output is identical to rendering them one by one.
+  void SetParallelVoices(bool enabled);
+  void RenderPendingVoices();
+
   void SetFlags(u32 flags) { m_flags = flags; }
   void SetSineTable(std::array<s16, 0x80>&& sine_table) { m_sine_table = sine_table; }
   void SetConstPatterns(std::array<s16, 0x100>&& patterns) { m_const_patterns = patterns; }
@@ -38,6 +48,7 @@ public:
 
 private:
   struct VPB;
+  class VoicePool;
 
   // See Zelda.cpp for the list of possible flags.
   u32 m_flags;
@@ -130,6 +141,32 @@ private:
   // buffers. Returns nullptr if no match is found.
   MixingBuffer* BufferForID(u16 buffer_id);
 
+  // Private copies of the mixing buffers, which a voice rendered on a worker
+  // thread mixes into. used_mask has a bit set for each buffer that has been
+  // written to.
+  static constexpr size_t NUM_MIXING_BUFFERS = 13;
+  static const std::array<MixingBuffer ZeldaAudioRenderer::*, NUM_MIXING_BUFFERS> s_mixing_buffers;
+  struct VoiceOutput
+  {
+    std::array<MixingBuffer, NUM_MIXING_BUFFERS> buffers;
+    u16 used_mask;
+  };
+  // Returns the buffer a voice should mix into instead of the given one.
+  MixingBuffer* MixTarget(MixingBuffer* buffer, VoiceOutput* output);
+
+  // Renders a voice, mixing it either into the shared buffers (output ==
+  // nullptr) or into a private set of buffers.
+  void RenderVoice(u16 voice_id, VoiceOutput* output);
+  // Whether the voice uses the mixing buffers as an input, and so has to be
+  // rendered after all the voices before it have been mixed.
+  bool ReadsMixingBuffers(u16 voice_id);
+  // Renders m_pending_voices[begin, end) in parallel.
+  void RenderVoiceBatch(size_t begin, size_t end);
+
+  std::unique_ptr<VoicePool> m_voice_pool;
+  std::vector<u16> m_pending_voices;
+  std::vector<VoiceOutput> m_voice_outputs;
+
   // Base address where VPBs are stored linearly in RAM.
   u32 m_vpb_base_addr;
   void FetchVPB(u16 voice_id, VPB* vpb);
@@ -4,6 +4,7 @@
 
 #include "Core/HW/DSPLLE/DSPLLE.h"
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -90,6 +91,7 @@ void DSPLLE::DoState(PointerWrap& p)
 void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 {
   Common::SetCurrentThreadName("DSP thread");
+  Core::PinCurrentThread(Core::HotThread::DSP);
 
   while (dsp_lle->m_is_running.IsSet())
   {
@@ -105,7 +107,10 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
       {
         DSP::Interpreter::RunCyclesThread(cycles);
       }
-      dsp_lle->m_cycle_count.store(0);
+      // The CPU may have handed out more cycles in the meantime, so only take away the ones
+      // which have been run.
+      dsp_lle->m_cycle_count.fetch_sub(cycles);
+      s_ppc_event.Set();
     }
     else
     {
@@ -181,6 +186,7 @@ bool DSPLLE::Initialize(bool wii, bool dsp_thread)
 
   m_wii = wii;
   m_is_dsp_on_thread = dsp_thread;
+  m_sync_cycles = static_cast<u32>(std::max(SConfig::GetInstance().m_DSPThreadSyncCycles, 0));
 
   // DSPLLE directly accesses the fastmem arena.
   // TODO: The fastmem arena is only supposed to be used by the JIT:
@@ -317,8 +323,11 @@ void DSPLLE::DSP_Update(int cycles)
   }
   else
   {
-    // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
-    s_ppc_event.Wait();
+    // The cycles are handed to the DSP thread as credit, and the CPU only waits for the thread
+    // once it has fallen more than m_sync_cycles behind. With the default of 0, the thread has to
+    // finish the previous batch before it gets the next one.
+    while (m_cycle_count.load() > m_sync_cycles && m_is_running.IsSet())
+      s_ppc_event.Wait();
     m_cycle_count.fetch_add(dsp_cycles);
     s_dsp_event.Set();
   }
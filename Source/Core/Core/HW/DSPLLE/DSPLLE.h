@@ -47,7 +47,9 @@ private:
   std::mutex m_dsp_thread_mutex;
   bool m_is_dsp_on_thread = false;
   Common::Flag m_is_running;
+  // DSP cycles the CPU has handed to the DSP thread which it hasn't run yet.
   std::atomic<u32> m_cycle_count{};
+  u32 m_sync_cycles = 0;
 };
 }  // namespace LLE
 }  // namespace DSP
@@ -32,6 +32,7 @@
 #include "Core/IOS/DI/DI.h"
 #include "Core/IOS/IOS.h"
 #include "Core/Movie.h"
+#include "Core/RunAhead.h"
 
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
@@ -346,7 +347,8 @@ static void DTKStreamingCallback(const std::vector<u8>& audio_data, s64 cycles_l
   // Send audio to the mixer.
   std::vector<s16> temp_pcm(s_pending_samples * 2, 0);
   ProcessDTKSamples(&temp_pcm, audio_data);
-  g_sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(), s_pending_samples);
+  if (!RunAhead::IsRunningAhead())
+    g_sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(), s_pending_samples);
 
   // Determine which audio data to read next.
   static const int MAXIMUM_SAMPLES = 48000 / 2000 * 7;  // 3.5ms of 48kHz samples
@@ -4,7 +4,10 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
+#include <array>
 #include <cinttypes>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -19,6 +22,7 @@
 #include "Common/FifoQueue.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
@@ -61,7 +65,59 @@ struct ReadRequest
   u64 realtime_done_us;
 };
 
-using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
+struct ReadResult
+{
+  ReadRequest request;
+  std::vector<u8> buffer;
+
+  // Set instead of buffer when the data can be copied straight from the disc image
+  // (see DiscIO::Volume::GetDirectPointer).
+  std::shared_ptr<const u8> direct_data;
+};
+
+// The format which results are savestated in.
+using SavedReadResult = std::pair<ReadRequest, std::vector<u8>>;
+
+struct QueuedRequest
+{
+  ReadRequest request;
+
+  // The emulated time at which FinishRead needs the result. The DVD thread reads whichever
+  // request is needed first instead of going in the order that the requests were made.
+  u64 deadline_ticks;
+};
+
+// Adjacent and overlapping requests are merged into one read of at most this size.
+static constexpr u64 MAX_COALESCED_READ_SIZE = 0x200000;
+
+// Recently read data is cached in blocks of the size of a DVD ECC block, because games often
+// read the same small pieces of a disc (like file system tables) over and over.
+static constexpr u64 CACHE_BLOCK_SIZE = 0x8000;
+static constexpr size_t NUM_CACHE_BLOCKS = 64;
+// Larger reads are usually of data that is streamed and won't be read again soon, so they
+// don't go through the cache, which would otherwise lose the data that is worth keeping.
+static constexpr u64 MAX_CACHED_READ_SIZE = 0x20000;
+
+// Audio streaming reads a few blocks at a time while it plays through a region of the disc, so
+// the DVD thread reads ahead of it into a separate buffer whenever it has nothing else to do.
+// This is about 2.4 seconds of audio.
+static constexpr u64 STREAM_READ_AHEAD_SIZE = 0x20000;
+
+struct StreamBuffer
+{
+  u64 offset = std::numeric_limits<u64>::max();
+  std::vector<u8> data;
+  // Where the stream is expected to continue.
+  u64 position = std::numeric_limits<u64>::max();
+};
+
+struct CachedBlock
+{
+  DiscIO::Partition partition;
+  u64 offset = std::numeric_limits<u64>::max();
+  u64 last_used = 0;
+  std::vector<u8> data;
+};
 
 static void StartDVDThread();
 static void StopDVDThread();
@@ -83,12 +139,20 @@ static Common::Event s_request_queue_expanded;    // Is set by CPU thread
 static Common::Event s_result_queue_expanded;     // Is set by DVD thread
 static Common::Flag s_dvd_thread_exiting(false);  // Is set by CPU thread
 
-static Common::FifoQueue<ReadRequest, false> s_request_queue;
+static Common::FifoQueue<QueuedRequest, false> s_request_queue;
 static Common::FifoQueue<ReadResult, false> s_result_queue;
 static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Only used by the DVD thread, or while it is stopped.
+static std::array<CachedBlock, NUM_CACHE_BLOCKS> s_cache;
+static u64 s_cache_counter = 0;
+static StreamBuffer s_stream_buffer;
+
+// Written by TouchPages so that the compiler can't skip the reads.
+static volatile u8 s_touch_pages_sum;
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -112,10 +176,22 @@ static void StartDVDThread()
   s_dvd_thread = std::thread(DVDThread);
 }
 
+static void ClearCache()
+{
+  for (CachedBlock& block : s_cache)
+  {
+    block.offset = std::numeric_limits<u64>::max();
+    block.data.clear();
+    block.data.shrink_to_fit();
+  }
+  s_stream_buffer = StreamBuffer();
+}
+
 void Stop()
 {
   StopDVDThread();
   s_disc.reset();
+  ClearCache();
   FileMonitor::SetFileSystem(nullptr);
 }
 
@@ -144,10 +220,25 @@ void DoState(PointerWrap& p)
   // This won't affect the behavior of FinishRead.
   ReadResult result;
   while (s_result_queue.Pop(result))
-    s_result_map.emplace(result.first.id, std::move(result));
+    s_result_map.emplace(result.request.id, std::move(result));
 
-  // Both queues are now empty, so we don't need to savestate them.
-  p.Do(s_result_map);
+  // Both queues are now empty, so we don't need to savestate them. Results which point into the
+  // disc image are copied, so that the savestate contains their data.
+  std::map<u64, SavedReadResult> saved_results;
+  for (auto& entry : s_result_map)
+  {
+    ReadResult& r = entry.second;
+    if (r.direct_data)
+      r.buffer.assign(r.direct_data.get(), r.direct_data.get() + r.request.length);
+    saved_results.emplace(entry.first, SavedReadResult(r.request, std::move(r.buffer)));
+  }
+  p.Do(saved_results);
+  s_result_map.clear();
+  for (auto& entry : saved_results)
+  {
+    s_result_map.emplace(entry.first,
+                         ReadResult{entry.second.first, std::move(entry.second.second), nullptr});
+  }
   p.Do(s_next_id);
 
   // s_disc isn't savestated (because it points to files on the
@@ -185,6 +276,7 @@ void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
   s_disc = std::move(disc);
+  ClearCache();
   FileMonitor::SetFileSystem(s_disc.get());
 }
 
@@ -269,13 +361,16 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   request.partition = partition;
   request.reply_type = reply_type;
 
+  TRACE_EVENT(DVDRequest, dvd_offset, length);
+
   u64 id = s_next_id++;
   request.id = id;
 
   request.time_started_ticks = CoreTiming::GetTicks();
   request.realtime_started_us = Common::Timer::GetTimeUs();
 
-  s_request_queue.Push(std::move(request));
+  const u64 deadline_ticks = request.time_started_ticks + ticks_until_completion;
+  s_request_queue.Push(QueuedRequest{std::move(request), deadline_ticks});
   s_request_queue_expanded.Set();
 
   CoreTiming::ScheduleEvent(ticks_until_completion, s_finish_read, id);
@@ -307,16 +402,16 @@ static void FinishRead(u64 id, s64 cycles_late)
       while (!s_result_queue.Pop(result))
         s_result_queue_expanded.Wait();
 
-      if (result.first.id == id)
+      if (result.request.id == id)
         break;
       else
-        s_result_map.emplace(result.first.id, std::move(result));
+        s_result_map.emplace(result.request.id, std::move(result));
     }
   }
   // We have now obtained the right ReadResult.
 
-  const ReadRequest& request = result.first;
-  const std::vector<u8>& buffer = result.second;
+  const ReadRequest& request = result.request;
+  const std::vector<u8>& buffer = result.buffer;
 
   DEBUG_LOG(DVDINTERFACE, "Disc has been read. Real time: %" PRIu64 " us. "
                           "Real time including delay: %" PRIu64 " us. "
@@ -326,7 +421,7 @@ static void FinishRead(u64 id, s64 cycles_late)
             (CoreTiming::GetTicks() - request.time_started_ticks) /
                 (SystemTimers::GetTicksPerSecond() / 1000000));
 
-  if (buffer.empty())
+  if (buffer.empty() && !result.direct_data)
   {
     PanicAlertT("The disc could not be read (at 0x%" PRIx64 " - 0x%" PRIx64 ").",
                 request.dvd_offset, request.dvd_offset + request.length);
@@ -334,7 +429,10 @@ static void FinishRead(u64 id, s64 cycles_late)
   else
   {
     if (request.copy_to_ram)
-      Memory::CopyToEmu(request.output_address, buffer.data(), request.length);
+    {
+      const u8* data = result.direct_data ? result.direct_data.get() : buffer.data();
+      Memory::CopyToEmu(request.output_address, data, request.length);
+    }
   }
 
   // Notify the emulated software that the command has been executed
@@ -342,34 +440,243 @@ static void FinishRead(u64 id, s64 cycles_late)
                                        buffer);
 }
 
-static void DVDThread()
+// Makes the OS load the data from the disk now, on the DVD thread, so that the CPU thread
+// doesn't stall on page faults when it copies the data into emulated RAM later.
+static void TouchPages(const u8* data, u32 length)
 {
-  Common::SetCurrentThreadName("DVD thread");
+  static constexpr u32 PAGE_SIZE = 0x1000;
+  u8 sum = 0;
+  for (u32 i = 0; i < length; i += PAGE_SIZE)
+    sum += static_cast<const volatile u8*>(data)[i];
+  if (length)
+    sum += static_cast<const volatile u8*>(data)[length - 1];
+  s_touch_pages_sum = sum;
+}
 
-  while (true)
+static const CachedBlock* GetCachedBlock(u64 offset, const DiscIO::Partition& partition)
+{
+  auto it = std::find_if(s_cache.begin(), s_cache.end(), [&](const CachedBlock& block) {
+    return block.offset == offset && block.partition == partition;
+  });
+  if (it == s_cache.end())
+  {
+    it = std::min_element(s_cache.begin(), s_cache.end(),
+                          [](const CachedBlock& a, const CachedBlock& b) {
+                            return a.last_used < b.last_used;
+                          });
+    it->partition = partition;
+    it->offset = offset;
+    it->data.resize(CACHE_BLOCK_SIZE);
+    if (!s_disc->Read(offset, CACHE_BLOCK_SIZE, it->data.data(), partition))
+    {
+      it->offset = std::numeric_limits<u64>::max();
+      return nullptr;
+    }
+  }
+
+  it->last_used = ++s_cache_counter;
+  return &*it;
+}
+
+static bool ReadFromDisc(u64 offset, u64 length, u8* out, const DiscIO::Partition& partition,
+                         bool use_cache)
+{
+  if (!use_cache || length > MAX_CACHED_READ_SIZE)
+    return s_disc->Read(offset, length, out, partition);
+
+  const u64 end = offset + length;
+  for (u64 block_offset = offset / CACHE_BLOCK_SIZE * CACHE_BLOCK_SIZE; block_offset < end;
+       block_offset += CACHE_BLOCK_SIZE)
+  {
+    // A block can fail to be read in full if it is at the end of the disc or partition.
+    const CachedBlock* block = GetCachedBlock(block_offset, partition);
+    if (!block)
+      return s_disc->Read(offset, length, out, partition);
+
+    const u64 copy_start = std::max(offset, block_offset);
+    const u64 copy_end = std::min(end, block_offset + CACHE_BLOCK_SIZE);
+    std::copy(block->data.begin() + (copy_start - block_offset),
+              block->data.begin() + (copy_end - block_offset), out + (copy_start - offset));
+  }
+
+  return true;
+}
+
+// Refills the stream buffer from the position where the stream is expected to continue. Returns
+// false if nothing could be read there.
+static bool FillStreamBuffer()
+{
+  const u64 disc_size = s_disc->GetSize();
+  const u64 offset = s_stream_buffer.position;
+  if (offset >= disc_size)
+    return false;
+
+  std::vector<u8> data(std::min(STREAM_READ_AHEAD_SIZE, disc_size - offset));
+  TRACE_EVENT(DVDReadBegin, offset, data.size());
+  const bool success = s_disc->Read(offset, data.size(), data.data(), DiscIO::PARTITION_NONE);
+  TRACE_EVENT(DVDReadEnd, offset, data.size());
+  if (!success)
+    return false;
+
+  s_stream_buffer.offset = offset;
+  s_stream_buffer.data = std::move(data);
+  return true;
+}
+
+// Whether less than half of the read-ahead is left in the stream buffer.
+static bool StreamBufferNeedsRefill()
+{
+  const StreamBuffer& buffer = s_stream_buffer;
+  if (buffer.position == std::numeric_limits<u64>::max())
+    return false;
+  return buffer.position < buffer.offset ||
+         buffer.position + STREAM_READ_AHEAD_SIZE / 2 > buffer.offset + buffer.data.size();
+}
+
+static bool ReadStream(u64 offset, u64 length, u8* out)
+{
+  StreamBuffer& buffer = s_stream_buffer;
+  buffer.position = offset;
+  if (offset < buffer.offset || offset + length > buffer.offset + buffer.data.size())
   {
-    s_request_queue_expanded.Wait();
+    if (!FillStreamBuffer() || length > buffer.data.size())
+      return s_disc->Read(offset, length, out, DiscIO::PARTITION_NONE);
+  }
+
+  const auto start = buffer.data.begin() + (offset - buffer.offset);
+  std::copy(start, start + length, out);
+  buffer.position = offset + length;
+  return true;
+}
 
-    if (s_dvd_thread_exiting.IsSet())
+static void PushResult(ReadResult result)
+{
+  result.request.realtime_done_us = Common::Timer::GetTimeUs();
+  s_result_queue.Push(std::move(result));
+  s_result_queue_expanded.Set();
+}
+
+// Handles the pending request which is needed first, along with any other pending requests that
+// can be read together with it.
+static void ProcessRequests(std::vector<QueuedRequest>* pending)
+{
+  auto first = std::min_element(pending->begin(), pending->end(),
+                                [](const QueuedRequest& a, const QueuedRequest& b) {
+                                  return a.deadline_ticks < b.deadline_ticks;
+                                });
+  std::vector<QueuedRequest> group{std::move(*first)};
+  pending->erase(first);
+
+  const ReadRequest& lead = group.front().request;
+  const DiscIO::Partition partition = lead.partition;
+  FileMonitor::Log(lead.dvd_offset, partition);
+
+  if (lead.reply_type == DVDInterface::ReplyType::DTK)
+  {
+    std::vector<u8> buffer(lead.length);
+    if (!ReadStream(lead.dvd_offset, lead.length, buffer.data()))
+      buffer.clear();
+    PushResult(ReadResult{std::move(group.front().request), std::move(buffer), nullptr});
+    return;
+  }
+
+  // Reads into emulated RAM are copied straight from the disc image when it is memory-mapped,
+  // which saves reading the data into a buffer first.
+  if (lead.copy_to_ram)
+  {
+    std::shared_ptr<const u8> direct_data =
+        s_disc->GetDirectPointer(lead.dvd_offset, lead.length, partition);
+    if (direct_data)
+    {
+      TRACE_EVENT(DVDReadBegin, lead.dvd_offset, lead.length);
+      TouchPages(direct_data.get(), lead.length);
+      TRACE_EVENT(DVDReadEnd, lead.dvd_offset, lead.length);
+      PushResult(ReadResult{std::move(group.front().request), {}, std::move(direct_data)});
       return;
+    }
+  }
 
-    ReadRequest request;
-    while (s_request_queue.Pop(request))
+  u64 start = lead.dvd_offset;
+  u64 end = lead.dvd_offset + lead.length;
+  bool merged = true;
+  while (merged)
+  {
+    merged = false;
+    for (auto it = pending->begin(); it != pending->end(); ++it)
     {
-      FileMonitor::Log(request.dvd_offset, request.partition);
+      const ReadRequest& request = it->request;
+      const u64 request_end = request.dvd_offset + request.length;
+      if (request.reply_type == DVDInterface::ReplyType::DTK || request.partition != partition ||
+          request.dvd_offset > end || request_end < start ||
+          std::max(end, request_end) - std::min(start, request.dvd_offset) >
+              MAX_COALESCED_READ_SIZE)
+      {
+        continue;
+      }
+
+      FileMonitor::Log(request.dvd_offset, partition);
+      start = std::min(start, request.dvd_offset);
+      end = std::max(end, request_end);
+      group.push_back(std::move(*it));
+      pending->erase(it);
+      merged = true;
+      break;
+    }
+  }
 
-      std::vector<u8> buffer(request.length);
-      if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+  // Data that isn't copied to emulated RAM usually won't be read again, so it shouldn't evict
+  // anything.
+  const bool use_cache = std::all_of(group.begin(), group.end(), [](const QueuedRequest& queued) {
+    return queued.request.copy_to_ram;
+  });
+
+  std::vector<u8> data(end - start);
+  TRACE_EVENT(DVDReadBegin, start, data.size());
+  const bool success = ReadFromDisc(start, data.size(), data.data(), partition, use_cache);
+  TRACE_EVENT(DVDReadEnd, start, data.size());
+
+  std::stable_sort(group.begin(), group.end(), [](const QueuedRequest& a, const QueuedRequest& b) {
+    return a.deadline_ticks < b.deadline_ticks;
+  });
+  for (QueuedRequest& queued : group)
+  {
+    std::vector<u8> buffer;
+    if (success)
+    {
+      const auto request_start = data.begin() + (queued.request.dvd_offset - start);
+      buffer.assign(request_start, request_start + queued.request.length);
+    }
+    PushResult(ReadResult{std::move(queued.request), std::move(buffer), nullptr});
+  }
+}
+
+static void DVDThread()
+{
+  Common::SetCurrentThreadName("DVD thread");
+
+  // Requests which have been taken from s_request_queue but not handled yet. These are always
+  // handled before the thread exits, so that WaitUntilIdle only needs to check the queue.
+  std::vector<QueuedRequest> pending;
 
-      request.realtime_done_us = Common::Timer::GetTimeUs();
+  while (true)
+  {
+    if (pending.empty())
+    {
+      if (StreamBufferNeedsRefill() && !FillStreamBuffer())
+        s_stream_buffer.position = std::numeric_limits<u64>::max();
 
-      s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
-      s_result_queue_expanded.Set();
+      s_request_queue_expanded.Wait();
 
       if (s_dvd_thread_exiting.IsSet())
         return;
     }
+
+    QueuedRequest request;
+    while (s_request_queue.Pop(request))
+      pending.push_back(std::move(request));
+
+    if (!pending.empty())
+      ProcessRequests(&pending);
   }
 }
 }
@@ -113,11 +113,7 @@ bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
     ERROR_LOG(SP1, "SendFrame(): expected to write %d bytes, instead wrote %d", size, writtenBytes);
     return false;
   }
-  else
-  {
-    SendComplete();
-    return true;
-  }
+  return true;
 #else
   NOTIMPLEMENTED("SendFrame");
   return false;
@@ -127,6 +123,7 @@ bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
 #ifdef __linux__
 static void ReadThreadHandler(CEXIETHERNET* self)
 {
+  std::vector<u8> buffer(BBA_RECV_SIZE);
   while (!self->readThreadShutdown.IsSet())
   {
     fd_set rfds;
@@ -139,7 +136,7 @@ static void ReadThreadHandler(CEXIETHERNET* self)
     if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
       continue;
 
-    int readBytes = read(self->fd, self->mRecvBuffer.get(), BBA_RECV_SIZE);
+    int readBytes = read(self->fd, buffer.data(), BBA_RECV_SIZE);
     if (readBytes < 0)
     {
       ERROR_LOG(SP1, "Failed to read from BBA, err=%d", readBytes);
@@ -147,9 +144,8 @@ static void ReadThreadHandler(CEXIETHERNET* self)
     else if (self->readEnabled.IsSet())
     {
       DEBUG_LOG(SP1, "Read data: %s",
-                ArrayToString(self->mRecvBuffer.get(), readBytes, 0x10).c_str());
-      self->mRecvBufferLength = readBytes;
-      self->RecvHandlePacket();
+                ArrayToString(buffer.data(), readBytes, 0x10).c_str());
+      self->QueueReceivedFrame(buffer.data(), readBytes);
     }
   }
 }
@@ -265,12 +265,13 @@ bool CEXIETHERNET::IsActivated()
 
 static void ReadThreadHandler(CEXIETHERNET* self)
 {
+  std::vector<u8> buffer(BBA_RECV_SIZE);
   while (!self->readThreadShutdown.IsSet())
   {
     DWORD transferred;
 
     // Read from TAP into internal buffer.
-    if (ReadFile(self->mHAdapter, self->mRecvBuffer.get(), BBA_RECV_SIZE, &transferred,
+    if (ReadFile(self->mHAdapter, buffer.data(), BBA_RECV_SIZE, &transferred,
                  &self->mReadOverlapped))
     {
       // Returning immediately is not likely to happen, but if so, reset the event state manually.
@@ -298,13 +299,12 @@ static void ReadThreadHandler(CEXIETHERNET* self)
       }
     }
 
-    // Copy to BBA buffer, and fire interrupt if enabled.
+    // Hand the frame to the CPU thread, which copies it to the BBA buffer.
     DEBUG_LOG(SP1, "Received %u bytes:\n %s", transferred,
-              ArrayToString(self->mRecvBuffer.get(), transferred, 0x10).c_str());
+              ArrayToString(buffer.data(), transferred, 0x10).c_str());
     if (self->readEnabled.IsSet())
     {
-      self->mRecvBufferLength = transferred;
-      self->RecvHandlePacket();
+      self->QueueReceivedFrame(buffer.data(), transferred);
     }
   }
 }
@@ -344,8 +344,6 @@ bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
     }
   }
 
-  // Always report the packet as being sent successfully, even though it might be a lie
-  SendComplete();
   return true;
 }
 
@@ -4,13 +4,17 @@
 
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Network.h"
+#include "Common/Thread.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/EXI/EXI.h"
@@ -57,10 +61,16 @@ CEXIETHERNET::CEXIETHERNET()
 #elif defined(__linux__) || defined(__APPLE__)
   fd = -1;
 #endif
+
+  m_send_thread = std::thread(&CEXIETHERNET::SendThread, this);
 }
 
 CEXIETHERNET::~CEXIETHERNET()
 {
+  m_send_thread_shutdown.Set();
+  m_send_event.Set();
+  m_send_thread.join();
+
   Deactivate();
 }
 
@@ -80,6 +90,8 @@ bool CEXIETHERNET::IsPresent() const
 
 bool CEXIETHERNET::IsInterruptSet()
 {
+  // The read thread requests an interrupt update when frames arrive, which ends up here.
+  DeliverReceivedFrames();
   return !!(exi_status.interrupt & exi_status.interrupt_mask);
 }
 
@@ -395,7 +407,57 @@ void CEXIETHERNET::DirectFIFOWrite(const u8* data, u32 size)
 
 void CEXIETHERNET::SendFromDirectFIFO()
 {
-  SendFrame(tx_fifo.get(), *(u16*)&mBbaMem[BBA_TXFIFOCNT]);
+  // The frame is always reported as sent, even though the host might still fail to send it.
+  if (IsActivated())
+  {
+    const u16 size = *(u16*)&mBbaMem[BBA_TXFIFOCNT];
+    m_send_queue.Push(std::vector<u8>(tx_fifo.get(), tx_fifo.get() + size));
+    m_send_event.Set();
+  }
+  SendComplete();
+}
+
+void CEXIETHERNET::SendThread()
+{
+  Common::SetCurrentThreadName("BBA Send");
+
+  while (true)
+  {
+    m_send_event.Wait();
+
+    std::vector<u8> frame;
+    while (m_send_queue.Pop(frame))
+      SendFrame(frame.data(), static_cast<u32>(frame.size()));
+
+    if (m_send_thread_shutdown.IsSet())
+      return;
+  }
+}
+
+void CEXIETHERNET::QueueReceivedFrame(const u8* frame, u32 size)
+{
+  m_recv_queue.Push(std::vector<u8>(frame, frame + size));
+  if (!m_recv_pending.exchange(true))
+    ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::NON_CPU, 0);
+}
+
+void CEXIETHERNET::DeliverReceivedFrames()
+{
+  // Cleared first, so that a frame which arrives while the queue is drained schedules another
+  // update instead of waiting for the next one.
+  m_recv_pending = false;
+
+  std::vector<u8> frame;
+  while (m_recv_queue.Pop(frame))
+  {
+    // Frames that arrive while receiving is stopped are dropped, like on the real adapter.
+    if (!(mBbaMem[BBA_NCRA] & NCRA_SR))
+      continue;
+
+    mRecvBufferLength = std::min<u32>(static_cast<u32>(frame.size()), BBA_RECV_SIZE);
+    std::copy_n(frame.begin(), mRecvBufferLength, mRecvBuffer.get());
+    RecvHandlePacket();
+  }
 }
 
 void CEXIETHERNET::SendFromPacketBuffer()
@@ -578,7 +640,7 @@ bool CEXIETHERNET::RecvHandlePacket()
     mBbaMem[BBA_IR] |= INT_R;
 
     exi_status.interrupt |= exi_status.TRANSFER;
-    ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::NON_CPU, 0);
+    ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::CPU, 0);
   }
   else
   {
@@ -12,6 +12,8 @@
 #include <Windows.h>
 #endif
 
+#include "Common/Event.h"
+#include "Common/FifoQueue.h"
 #include "Common/Flag.h"
 #include "Core/HW/EXI/EXI_Device.h"
 
@@ -307,10 +309,25 @@ public:
   bool RecvMACFilter();
   void inc_rwp();
   bool RecvHandlePacket();
+  // Called by the read thread. The frames are delivered on the CPU thread, all the ones that have
+  // arrived by then at once.
+  void QueueReceivedFrame(const u8* frame, u32 size);
+  void DeliverReceivedFrames();
+  void SendThread();
 
   std::unique_ptr<u8[]> mBbaMem;
   std::unique_ptr<u8[]> tx_fifo;
 
+  Common::FifoQueue<std::vector<u8>, false> m_recv_queue;
+  std::atomic<bool> m_recv_pending{false};
+
+  // Frames are written to the TAP device by a thread of their own, so that the CPU thread never
+  // waits for the host's network stack.
+  Common::FifoQueue<std::vector<u8>, false> m_send_queue;
+  Common::Event m_send_event;
+  Common::Flag m_send_thread_shutdown;
+  std::thread m_send_thread;
+
   // TAP interface
   bool Activate();
   void Deactivate();
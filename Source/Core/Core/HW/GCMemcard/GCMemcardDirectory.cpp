@@ -310,7 +310,7 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
       m_last_block_address = (u8*)&m_bat2;
       break;
     default:
-      m_last_block = SaveAreaRW(block, true);
+      m_last_block = SaveAreaRW(block);
       if (m_last_block == -1)
       {
         PanicAlertT("Report: GCIFolder Writing to unallocated block 0x%x", block);
@@ -319,7 +319,20 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
     }
   }
 
-  memcpy(m_last_block_address + offset, src_address, length);
+  // Games often write back save blocks that haven't changed. Only a save whose blocks actually
+  // changed has to be written to its GCI file again.
+  if (block >= MC_FST_BLOCKS)
+  {
+    if (memcmp(m_last_block_address + offset, src_address, length) != 0)
+    {
+      memcpy(m_last_block_address + offset, src_address, length);
+      m_saves[m_last_save].m_dirty = true;
+    }
+  }
+  else
+  {
+    memcpy(m_last_block_address + offset, src_address, length);
+  }
 
   l.unlock();
   if (extra)
@@ -459,6 +472,7 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
 
         m_last_block = block;
         m_last_block_address = m_saves[i].m_save_data[idx].block;
+        m_last_save = i;
         return m_last_block;
       }
     }
@@ -522,8 +536,17 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
 
 void GCMemcardDirectory::FlushToFile()
 {
+  struct PendingWrite
+  {
+    std::string filename;
+    std::vector<u8> data;
+  };
+  std::vector<PendingWrite> writes;
+  std::vector<std::string> deletions;
+
+  // Only copying the saves happens under the lock, so that the emulated memory card isn't
+  // blocked while the files are written.
   std::unique_lock<std::mutex> l(m_write_mutex);
-  int errors = 0;
   DEntry invalid;
   for (u16 i = 0; i < m_saves.size(); ++i)
   {
@@ -557,36 +580,19 @@ void GCMemcardDirectory::FlushToFile()
                         default_save_name.c_str());
           m_saves[i].m_filename = default_save_name;
         }
-        File::IOFile gci(m_saves[i].m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&m_saves[i].m_gci_header, DENTRY_SIZE);
-          gci.WriteBytes(m_saves[i].m_save_data.data(), BLOCK_SIZE * m_saves[i].m_save_data.size());
 
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(
-                StringFromFormat("Wrote save contents to %s", m_saves[i].m_filename.c_str()), 4000);
-          }
-          else
-          {
-            ++errors;
-            Core::DisplayMessage(StringFromFormat("Failed to write save contents to %s",
-                                                  m_saves[i].m_filename.c_str()),
-                                 4000);
-            ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s",
-                      m_saves[i].m_filename.c_str());
-          }
-        }
+        PendingWrite write;
+        write.filename = m_saves[i].m_filename;
+        write.data.resize(DENTRY_SIZE + BLOCK_SIZE * m_saves[i].m_save_data.size());
+        memcpy(write.data.data(), &m_saves[i].m_gci_header, DENTRY_SIZE);
+        memcpy(write.data.data() + DENTRY_SIZE, m_saves[i].m_save_data.data(),
+               BLOCK_SIZE * m_saves[i].m_save_data.size());
+        writes.push_back(std::move(write));
       }
       else if (m_saves[i].m_filename.length() != 0)
       {
         m_saves[i].m_dirty = false;
-        std::string& old_name = m_saves[i].m_filename;
-        std::string deleted_name = old_name + ".deleted";
-        if (File::Exists(deleted_name))
-          File::Delete(deleted_name);
-        File::Rename(old_name, deleted_name);
+        deletions.push_back(std::move(m_saves[i].m_filename));
         m_saves[i].m_filename.clear();
         m_saves[i].m_save_data.clear();
         m_saves[i].m_used_blocks.clear();
@@ -604,6 +610,43 @@ void GCMemcardDirectory::FlushToFile()
       INFO_LOG(EXPANSIONINTERFACE, "Flushing savedata to disk for %s",
                m_saves[i].m_filename.c_str());
       m_saves[i].m_save_data.clear();
+      if (m_last_save == i)
+        m_last_block = -1;
+    }
+  }
+  l.unlock();
+
+  for (const std::string& old_name : deletions)
+  {
+    std::string deleted_name = old_name + ".deleted";
+    if (File::Exists(deleted_name))
+      File::Delete(deleted_name);
+    File::Rename(old_name, deleted_name);
+  }
+
+  // Every file is written to a temporary file first and then renamed over the old one, so that
+  // a crash or a full disk can't leave a half-written save behind.
+  for (const PendingWrite& write : writes)
+  {
+    const std::string temp_name = write.filename + ".tmp";
+    bool success;
+    {
+      File::IOFile gci(temp_name, "wb");
+      success = gci.WriteBytes(write.data.data(), write.data.size());
+    }
+    success = success && File::RenameSync(temp_name, write.filename);
+
+    if (success)
+    {
+      Core::DisplayMessage(StringFromFormat("Wrote save contents to %s", write.filename.c_str()),
+                           4000);
+    }
+    else
+    {
+      File::Delete(temp_name);
+      Core::DisplayMessage(
+          StringFromFormat("Failed to write save contents to %s", write.filename.c_str()), 4000);
+      ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s", write.filename.c_str());
     }
   }
 #if _WRITE_MC_HEADER
@@ -42,6 +42,8 @@ private:
   u32 m_game_id;
   s32 m_last_block;
   u8* m_last_block_address;
+  // The index of the save which m_last_block belongs to, if it is in the save area.
+  s32 m_last_save = -1;
 
   Header m_hdr;
   Directory m_dir1, m_dir2;
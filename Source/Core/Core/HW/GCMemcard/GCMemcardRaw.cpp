@@ -4,12 +4,14 @@
 
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -25,9 +27,52 @@
 #define SIZE_TO_Mb (1024 * 8 * 16)
 #define MC_HDR_SIZE 0xA000
 
+// Changed blocks are written to a journal before the card file is updated in place. The journal
+// only appears under its final name once it is complete, so if it exists when a card is opened,
+// the previous update of the card file may have been interrupted and is redone from it.
+static const u32 JOURNAL_MAGIC = 0x4A434D44;  // "DMCJ"
+
+static std::string GetJournalPath(const std::string& filename)
+{
+  return filename + ".journal";
+}
+
+static void ReplayJournal(const std::string& filename)
+{
+  const std::string journal_path = GetJournalPath(filename);
+  File::IOFile journal(journal_path, "rb");
+  if (!journal)
+    return;
+
+  u32 header[2];
+  File::IOFile file(filename, "r+b");
+  if (journal.ReadArray(header, 2) && header[0] == JOURNAL_MAGIC && file &&
+      file.GetSize() == header[1])
+  {
+    NOTICE_LOG(EXPANSIONINTERFACE, "Replaying the journal of memory card %s", filename.c_str());
+    std::vector<u8> data;
+    u32 run[2];
+    while (journal.ReadArray(run, 2) && run[0] <= header[1] && run[1] <= header[1] - run[0])
+    {
+      data.resize(run[1]);
+      if (!journal.ReadBytes(data.data(), data.size()))
+        break;
+      file.Seek(run[0], SEEK_SET);
+      file.WriteBytes(data.data(), data.size());
+    }
+    file.Flush();
+  }
+
+  journal.Close();
+  file.Close();
+  File::Delete(journal_path);
+}
+
 MemoryCard::MemoryCard(const std::string& filename, int card_index, u16 size_mbits)
     : MemoryCardBase(card_index, size_mbits), m_filename(filename)
 {
+  ReplayJournal(m_filename);
+
   File::IOFile file(m_filename, "rb");
   if (file)
   {
@@ -58,6 +103,7 @@ MemoryCard::MemoryCard(const std::string& filename, int card_index, u16 size_mbi
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
   m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  m_dirty_blocks.resize((m_memory_card_size + BLOCK_SIZE - 1) / BLOCK_SIZE);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
@@ -127,11 +173,22 @@ void MemoryCard::FlushThread()
       return;
     }
 
+    // A new or resized file has to be written in full.
+    const bool whole_card = file.GetSize() != m_memory_card_size;
+    std::vector<DirtyRun> runs;
     {
       std::unique_lock<std::mutex> l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      runs = TakeDirtyRuns(whole_card);
+    }
+
+    if (whole_card)
+    {
+      file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
+    }
+    else if (!runs.empty() && !WriteRuns(file, runs))
+    {
+      ERROR_LOG(EXPANSIONINTERFACE, "Failed to update memory card %s", m_filename.c_str());
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
 
     if (!do_exit)
     {
@@ -152,6 +209,79 @@ void MemoryCard::MakeDirty()
   m_dirty.Set();
 }
 
+void MemoryCard::MarkBlocksDirty(u32 address, u32 length)
+{
+  if (length == 0 || address >= m_memory_card_size)
+    return;
+
+  const u32 end = std::min(address + length, m_memory_card_size);
+  const u32 end_block = std::min<u32>((end + BLOCK_SIZE - 1) / BLOCK_SIZE,
+                                      static_cast<u32>(m_dirty_blocks.size()));
+  for (u32 block = address / BLOCK_SIZE; block < end_block; ++block)
+    m_dirty_blocks[block] = true;
+}
+
+// Copies the dirty blocks to the flush buffer and returns them as runs of adjacent blocks, which
+// are written with one call each.
+std::vector<MemoryCard::DirtyRun> MemoryCard::TakeDirtyRuns(bool whole_card)
+{
+  std::vector<DirtyRun> runs;
+  for (u32 block = 0; block < m_dirty_blocks.size(); ++block)
+  {
+    if (!whole_card && !m_dirty_blocks[block])
+      continue;
+
+    m_dirty_blocks[block] = false;
+    const u32 offset = block * BLOCK_SIZE;
+    const u32 size = std::min<u32>(BLOCK_SIZE, m_memory_card_size - offset);
+    memcpy(&m_flush_buffer[offset], &m_memcard_data[offset], size);
+
+    if (!runs.empty() && runs.back().offset + runs.back().size == offset)
+      runs.back().size += size;
+    else
+      runs.push_back(DirtyRun{offset, size});
+  }
+  return runs;
+}
+
+bool MemoryCard::WriteRuns(File::IOFile& file, const std::vector<DirtyRun>& runs)
+{
+  const std::string journal_path = GetJournalPath(m_filename);
+  const std::string temp_path = journal_path + ".tmp";
+  {
+    File::IOFile journal(temp_path, "wb");
+    const u32 header[2] = {JOURNAL_MAGIC, m_memory_card_size};
+    bool success = journal.WriteArray(header, 2);
+    for (const DirtyRun& run : runs)
+    {
+      const u32 run_header[2] = {run.offset, run.size};
+      success = success && journal.WriteArray(run_header, 2) &&
+                journal.WriteBytes(&m_flush_buffer[run.offset], run.size);
+    }
+    if (!success)
+    {
+      journal.Close();
+      File::Delete(temp_path);
+      return false;
+    }
+  }
+  if (!File::RenameSync(temp_path, journal_path))
+    return false;
+
+  for (const DirtyRun& run : runs)
+  {
+    file.Seek(run.offset, SEEK_SET);
+    file.WriteBytes(&m_flush_buffer[run.offset], run.size);
+  }
+  file.Flush();
+
+  // If the update failed, the journal is kept so that it is redone the next time.
+  if (!file.IsGood())
+    return false;
+  File::Delete(journal_path);
+  return true;
+}
+
 s32 MemoryCard::Read(u32 src_address, s32 length, u8* dest_address)
 {
   if (!IsAddressInBounds(src_address))
@@ -175,6 +305,7 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memcpy(&m_memcard_data[dest_address], src_address, length);
+    MarkBlocksDirty(dest_address, length);
   }
   MakeDirty();
   return length;
@@ -191,6 +322,7 @@ void MemoryCard::ClearBlock(u32 address)
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memset(&m_memcard_data[address], 0xFF, BLOCK_SIZE);
+    MarkBlocksDirty(address, BLOCK_SIZE);
   }
   MakeDirty();
 }
@@ -200,6 +332,7 @@ void MemoryCard::ClearAll()
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    MarkBlocksDirty(0, m_memory_card_size);
   }
   MakeDirty();
 }
@@ -209,4 +342,11 @@ void MemoryCard::DoState(PointerWrap& p)
   p.Do(m_card_index);
   p.Do(m_memory_card_size);
   p.DoArray(&m_memcard_data[0], m_memory_card_size);
+
+  // A loaded state can differ from the file anywhere, so all of it is written on the next flush.
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    std::unique_lock<std::mutex> l(m_flush_mutex);
+    MarkBlocksDirty(0, m_memory_card_size);
+  }
 }
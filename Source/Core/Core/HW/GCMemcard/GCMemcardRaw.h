@@ -8,12 +8,19 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
+
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 
 class PointerWrap;
 
+namespace File
+{
+class IOFile;
+}
+
 class MemoryCard : public MemoryCardBase
 {
 public:
@@ -29,9 +36,23 @@ public:
   void DoState(PointerWrap& p) override;
 
 private:
+  struct DirtyRun
+  {
+    u32 offset;
+    u32 size;
+  };
+
+  // Require m_flush_mutex to be held.
+  void MarkBlocksDirty(u32 address, u32 length);
+  std::vector<DirtyRun> TakeDirtyRuns(bool whole_card);
+
+  bool WriteRuns(File::IOFile& file, const std::vector<DirtyRun>& runs);
+
   std::string m_filename;
   std::unique_ptr<u8[]> m_memcard_data;
   std::unique_ptr<u8[]> m_flush_buffer;
+  // Which blocks have changed since the last flush. Only those are written to the file.
+  std::vector<bool> m_dirty_blocks;
   std::thread m_flush_thread;
   std::mutex m_flush_mutex;
   Common::Event m_flush_trigger;
@@ -4,9 +4,17 @@
 
 #include "Core/HW/GCPad.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <thread>
 
 #include "Common/Common.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/Thread.h"
 #include "Core/HW/GCPadEmu.h"
 #include "InputCommon/ControllerEmu/ControlGroup/ControlGroup.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
@@ -16,6 +24,46 @@
 namespace Pad
 {
 static InputConfig s_config("GCPadNew", _trans("Pad"), "GCPad");
+
+using Snapshot = std::array<GCPadStatus, 4>;
+
+// Triple buffer between the polling thread and the CPU thread. Each of them owns one of the
+// snapshots, and they exchange theirs with the one in the middle, which is marked as fresh when
+// the polling thread puts a new one there.
+static std::array<Snapshot, 3> s_snapshots;
+static std::atomic<u32> s_middle_snapshot;
+static u32 s_polling_snapshot;
+static u32 s_reading_snapshot;
+constexpr u32 FRESH_SNAPSHOT = 4;
+
+static std::thread s_polling_thread;
+static Common::Flag s_polling;
+static Common::Event s_stop_polling;
+
+static GCPadStatus ReadController(int pad_num)
+{
+  return static_cast<GCPad*>(s_config.GetController(pad_num))->GetInput();
+}
+
+static void PollingThread(u32 rate)
+{
+  Common::SetCurrentThreadName("Input polling thread");
+
+  const auto interval = std::chrono::microseconds(1000000 / rate);
+  auto next_poll = std::chrono::steady_clock::now();
+  do
+  {
+    g_controller_interface.UpdateInput();
+
+    Snapshot& snapshot = s_snapshots[s_polling_snapshot];
+    for (int i = 0; i < 4; ++i)
+      snapshot[i] = ReadController(i);
+    s_polling_snapshot = s_middle_snapshot.exchange(s_polling_snapshot | FRESH_SNAPSHOT) & 3;
+
+    // If polling took longer than the interval, don't try to catch up.
+    next_poll = std::max(next_poll + interval, std::chrono::steady_clock::now());
+  } while (!s_stop_polling.WaitFor(next_poll - std::chrono::steady_clock::now()));
+}
 InputConfig* GetConfig()
 {
   return &s_config;
@@ -45,9 +93,45 @@ void LoadConfig()
   s_config.LoadConfig(true);
 }
 
+void StartPolling(u32 rate)
+{
+  if (rate == 0 || s_polling.IsSet())
+    return;
+
+  // Until the first snapshot is there, the controllers read as idle.
+  for (Snapshot& snapshot : s_snapshots)
+    snapshot.fill(GCPadStatus{});
+  s_middle_snapshot = 0;
+  s_polling_snapshot = 1;
+  s_reading_snapshot = 2;
+
+  s_stop_polling.Reset();
+  s_polling.Set();
+  s_polling_thread = std::thread(PollingThread, rate);
+}
+
+void StopPolling()
+{
+  if (!s_polling.TestAndClear())
+    return;
+
+  s_stop_polling.Set();
+  s_polling_thread.join();
+}
+
+bool IsPolling()
+{
+  return s_polling.IsSet();
+}
+
 GCPadStatus GetStatus(int pad_num)
 {
-  return static_cast<GCPad*>(s_config.GetController(pad_num))->GetInput();
+  if (!s_polling.IsSet())
+    return ReadController(pad_num);
+
+  if (s_middle_snapshot.load() & FRESH_SNAPSHOT)
+    s_reading_snapshot = s_middle_snapshot.exchange(s_reading_snapshot) & 3;
+  return s_snapshots[s_reading_snapshot][pad_num];
 }
 
 ControllerEmu::ControlGroup* GetGroup(int pad_num, PadGroup group)
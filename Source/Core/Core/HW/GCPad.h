@@ -24,6 +24,13 @@ void LoadConfig();
 
 InputConfig* GetConfig();
 
+// While polling, a thread reads all controllers at the given rate, and GetStatus returns the
+// newest of those snapshots instead of reading the devices itself.
+void StartPolling(u32 rate);
+void StopPolling();
+bool IsPolling();
+
+// Must only be called from the CPU thread.
 GCPadStatus GetStatus(int pad_num);
 ControllerEmu::ControlGroup* GetGroup(int pad_num, PadGroup group);
 void Rumble(int pad_num, ControlState strength);
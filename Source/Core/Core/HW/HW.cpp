@@ -23,6 +23,8 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
 #include "Core/IOS/IOS.h"
+#include "Core/Rewind.h"
+#include "Core/RunAhead.h"
 #include "Core/State.h"
 #include "Core/WiiRoot.h"
 
@@ -47,6 +49,7 @@ void Init()
   GPFifo::Init();
   CPU::Init(SConfig::GetInstance().iCPUCore);
   SystemTimers::Init();
+  RunAhead::Init();
 
   if (SConfig::GetInstance().bWii)
   {
@@ -74,6 +77,8 @@ void Shutdown()
   AudioInterface::Shutdown();
 
   State::Shutdown();
+  Rewind::Clear();
+  RunAhead::Shutdown();
   CoreTiming::Shutdown();
 }
 
@@ -4,6 +4,7 @@
 
 #include "Core/HW/MMIO.h"
 
+#include <cstdint>
 #include <functional>
 
 #include "Common/Assert.h"
@@ -196,6 +197,80 @@ WriteHandlingMethod<T>* InvalidWrite()
   });
 }
 
+// Flattened description of a handling method, filled by the visitor below. This
+// is what the handlers dispatch on, and what the size converters use to merge
+// simple handlers into a single simple handler.
+template <typename T>
+struct MethodInfo
+{
+  DispatchKind kind = DispatchKind::Complex;
+  T value = 0;
+  T* ptr = nullptr;
+  u32 mask = 0;
+  const std::function<T(u32)>* read_lambda = nullptr;
+  const std::function<void(u32, T)>* write_lambda = nullptr;
+};
+
+template <typename T>
+class MethodInfoVisitor : public ReadHandlingMethodVisitor<T>, public WriteHandlingMethodVisitor<T>
+{
+public:
+  virtual ~MethodInfoVisitor() = default;
+
+  void VisitConstant(T value) override
+  {
+    info.kind = DispatchKind::Constant;
+    info.value = value;
+  }
+
+  void VisitNop() override { info.kind = DispatchKind::Nop; }
+  void VisitDirect(const T* addr, u32 mask) override { VisitDirect(const_cast<T*>(addr), mask); }
+  void VisitDirect(T* addr, u32 mask) override
+  {
+    info.kind = DispatchKind::Direct;
+    info.ptr = addr;
+    info.mask = mask;
+  }
+
+  void VisitComplex(const std::function<T(u32)>* lambda) override
+  {
+    info.kind = DispatchKind::Complex;
+    info.read_lambda = lambda;
+  }
+
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    info.kind = DispatchKind::Complex;
+    info.write_lambda = lambda;
+  }
+
+  MethodInfo<T> info;
+};
+
+template <typename T>
+MethodInfo<T> GetMethodInfo(const ReadHandlingMethod<T>& method)
+{
+  MethodInfoVisitor<T> v;
+  method.AcceptReadVisitor(v);
+  return v.info;
+}
+
+template <typename T>
+MethodInfo<T> GetMethodInfo(const WriteHandlingMethod<T>& method)
+{
+  MethodInfoVisitor<T> v;
+  method.AcceptWriteVisitor(v);
+  return v.info;
+}
+
+template <typename T, typename Handler>
+MethodInfo<T> GetMethodInfo(Handler* handler)
+{
+  MethodInfoVisitor<T> v;
+  handler->Visit(v);
+  return v.info;
+}
+
 // Converters to larger and smaller size. Probably the most complex of these
 // handlers to implement. They do not define new handling method types but
 // instead will internally use the types defined above.
@@ -229,17 +304,31 @@ struct LargerAccessSize<u16>
   typedef u32 value;
 };
 
+// When both halves are constant, or direct accesses to the two halves of the
+// same larger variable, the combined handler is of the same kind. Note that the
+// halves of a variable are laid out in host (little endian) order.
 template <typename T>
 ReadHandlingMethod<T>* ReadToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
 {
   typedef typename SmallerAccessSize<T>::value ST;
+  constexpr u32 shift = 8 * sizeof(ST);
 
   ReadHandler<ST>* high_part = &mmio->GetHandlerForRead<ST>(high_part_addr);
   ReadHandler<ST>* low_part = &mmio->GetHandlerForRead<ST>(low_part_addr);
 
-  // TODO(delroth): optimize
+  const MethodInfo<ST> high = GetMethodInfo<ST>(high_part);
+  const MethodInfo<ST> low = GetMethodInfo<ST>(low_part);
+  if (high.kind == DispatchKind::Constant && low.kind == DispatchKind::Constant)
+    return Constant<T>(static_cast<T>(high.value) << shift | low.value);
+  if (high.kind == DispatchKind::Direct && low.kind == DispatchKind::Direct &&
+      high.ptr == low.ptr + 1 && reinterpret_cast<uintptr_t>(low.ptr) % sizeof(T) == 0)
+  {
+    const u32 mask = (high.mask & ST(~0)) << shift | (low.mask & ST(~0));
+    return DirectRead<T>(reinterpret_cast<const T*>(low.ptr), mask);
+  }
+
   return ComplexRead<T>([=](u32 addr) {
-    return ((T)high_part->Read(high_part_addr) << (8 * sizeof(ST))) | low_part->Read(low_part_addr);
+    return ((T)high_part->Read(high_part_addr) << shift) | low_part->Read(low_part_addr);
   });
 }
 
@@ -247,13 +336,24 @@ template <typename T>
 WriteHandlingMethod<T>* WriteToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
 {
   typedef typename SmallerAccessSize<T>::value ST;
+  constexpr u32 shift = 8 * sizeof(ST);
 
   WriteHandler<ST>* high_part = &mmio->GetHandlerForWrite<ST>(high_part_addr);
   WriteHandler<ST>* low_part = &mmio->GetHandlerForWrite<ST>(low_part_addr);
 
-  // TODO(delroth): optimize
+  const MethodInfo<ST> high = GetMethodInfo<ST>(high_part);
+  const MethodInfo<ST> low = GetMethodInfo<ST>(low_part);
+  if (high.kind == DispatchKind::Nop && low.kind == DispatchKind::Nop)
+    return Nop<T>();
+  if (high.kind == DispatchKind::Direct && low.kind == DispatchKind::Direct &&
+      high.ptr == low.ptr + 1 && reinterpret_cast<uintptr_t>(low.ptr) % sizeof(T) == 0)
+  {
+    const u32 mask = (high.mask & ST(~0)) << shift | (low.mask & ST(~0));
+    return DirectWrite<T>(reinterpret_cast<T*>(low.ptr), mask);
+  }
+
   return ComplexWrite<T>([=](u32 addr, T val) {
-    high_part->Write(high_part_addr, val >> (8 * sizeof(ST)));
+    high_part->Write(high_part_addr, val >> shift);
     low_part->Write(low_part_addr, (ST)val);
   });
 }
@@ -265,7 +365,15 @@ ReadHandlingMethod<T>* ReadToLarger(Mapping* mmio, u32 larger_addr, u32 shift)
 
   ReadHandler<LT>* large = &mmio->GetHandlerForRead<LT>(larger_addr);
 
-  // TODO(delroth): optimize
+  const MethodInfo<LT> info = GetMethodInfo<LT>(large);
+  if (info.kind == DispatchKind::Constant)
+    return Constant<T>(static_cast<T>(info.value >> shift));
+  if (info.kind == DispatchKind::Direct && shift % (8 * sizeof(T)) == 0)
+  {
+    const T* part = reinterpret_cast<const T*>(info.ptr) + shift / (8 * sizeof(T));
+    return DirectRead<T>(part, (info.mask >> shift) & T(~0));
+  }
+
   return ComplexRead<T>(
       [large, shift](u32 addr) { return large->Read(addr & ~(sizeof(LT) - 1)) >> shift; });
 }
@@ -303,28 +411,12 @@ void ReadHandler<T>::ResetMethod(ReadHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public ReadHandlingMethodVisitor<T>
-  {
-    virtual ~FuncCreatorVisitor() = default;
-
-    std::function<T(u32)> ret;
-
-    void VisitConstant(T value) override
-    {
-      ret = [value](u32) { return value; };
-    }
-
-    void VisitDirect(const T* addr, u32 mask) override
-    {
-      ret = [addr, mask](u32) { return *addr & mask; };
-    }
-
-    void VisitComplex(const std::function<T(u32)>* lambda) override { ret = *lambda; }
-  };
-
-  FuncCreatorVisitor v;
-  Visit(v);
-  m_ReadFunc = v.ret;
+  MethodInfo<T> info = GetMethodInfo(*m_Method);
+  m_Kind = info.kind;
+  m_Value = info.value;
+  m_Ptr = info.ptr;
+  m_Mask = info.mask;
+  m_ReadFunc = info.kind == DispatchKind::Complex ? *info.read_lambda : nullptr;
 }
 
 template <typename T>
@@ -357,28 +449,11 @@ void WriteHandler<T>::ResetMethod(WriteHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public WriteHandlingMethodVisitor<T>
-  {
-    virtual ~FuncCreatorVisitor() = default;
-
-    std::function<void(u32, T)> ret;
-
-    void VisitNop() override
-    {
-      ret = [](u32, T) {};
-    }
-
-    void VisitDirect(T* ptr, u32 mask) override
-    {
-      ret = [ptr, mask](u32, T val) { *ptr = val & mask; };
-    }
-
-    void VisitComplex(const std::function<void(u32, T)>* lambda) override { ret = *lambda; }
-  };
-
-  FuncCreatorVisitor v;
-  Visit(v);
-  m_WriteFunc = v.ret;
+  MethodInfo<T> info = GetMethodInfo(*m_Method);
+  m_Kind = info.kind;
+  m_Ptr = info.ptr;
+  m_Mask = info.mask;
+  m_WriteFunc = info.kind == DispatchKind::Complex ? *info.write_lambda : nullptr;
 }
 
 // Define all the public specializations that are exported in MMIOHandlers.h.
@@ -11,6 +11,7 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Trace.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/MMIOHandlers.h"
 
@@ -127,12 +128,15 @@ public:
   template <typename Unit>
   Unit Read(u32 addr)
   {
-    return GetHandlerForRead<Unit>(addr).Read(addr);
+    const Unit val = GetHandlerForRead<Unit>(addr).Read(addr);
+    TRACE_EVENT(MMIORead, addr, val);
+    return val;
   }
 
   template <typename Unit>
   void Write(u32 addr, Unit val)
   {
+    TRACE_EVENT(MMIOWrite, addr, val);
     GetHandlerForWrite<Unit>(addr).Write(addr, val);
   }
 
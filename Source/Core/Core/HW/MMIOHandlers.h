@@ -82,7 +82,8 @@ WriteHandlingMethod<T>* InvalidWrite();
 // Internally, these size conversion functions have some magic to make the
 // combined handlers as fast as possible. For example, if the two underlying
 // u16 handlers for a u32 reads are Direct to consecutive memory addresses,
-// they can be transformed into a Direct u32 access.
+// they can be transformed into a Direct u32 access. This is decided when the
+// converter is created, so the underlying handlers must be registered first.
 //
 // Warning: unlike the other handling methods, *ToSmaller are obviously not
 // available for u8, and *ToLarger are not available for u32.
@@ -114,6 +115,18 @@ public:
   virtual void VisitComplex(const std::function<void(u32, T)>* lambda) = 0;
 };
 
+// How a handler dispatches an access. The handling methods that only move data
+// around are lowered to plain fields of the handler when it is registered, so
+// that Read() and Write() can be inlined into their callers without making any
+// indirect call. Only complex methods are called through a std::function.
+enum class DispatchKind : u8
+{
+  Complex,
+  Constant,
+  Nop,
+  Direct,
+};
+
 // These classes are INTERNAL. Do not use outside of the MMIO implementation
 // code. Unfortunately, because we want to make Read() and Write() fast and
 // inlinable, we need to provide some of the implementation of these two
@@ -140,7 +153,15 @@ public:
     if (!m_Method)
       InitializeInvalid();
 
-    return m_ReadFunc(addr);
+    switch (m_Kind)
+    {
+    case DispatchKind::Constant:
+      return m_Value;
+    case DispatchKind::Direct:
+      return static_cast<T>(*m_Ptr & m_Mask);
+    default:
+      return m_ReadFunc(addr);
+    }
   }
 
   // Internal method called when changing the internal method object. Its
@@ -152,6 +173,12 @@ private:
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid() { ResetMethod(InvalidRead<T>()); }
   std::unique_ptr<ReadHandlingMethod<T>> m_Method;
+
+  // Flattened form of m_Method. Only complex methods go through m_ReadFunc.
+  DispatchKind m_Kind = DispatchKind::Complex;
+  T m_Value = 0;
+  const T* m_Ptr = nullptr;
+  u32 m_Mask = 0;
   std::function<T(u32)> m_ReadFunc;
 };
 template <typename T>
@@ -176,7 +203,17 @@ public:
     if (!m_Method)
       InitializeInvalid();
 
-    m_WriteFunc(addr, val);
+    switch (m_Kind)
+    {
+    case DispatchKind::Nop:
+      break;
+    case DispatchKind::Direct:
+      *m_Ptr = static_cast<T>(val & m_Mask);
+      break;
+    default:
+      m_WriteFunc(addr, val);
+      break;
+    }
   }
 
   // Internal method called when changing the internal method object. Its
@@ -189,6 +226,11 @@ private:
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid() { ResetMethod(InvalidWrite<T>()); }
   std::unique_ptr<WriteHandlingMethod<T>> m_Method;
+
+  // Flattened form of m_Method. Only complex methods go through m_WriteFunc.
+  DispatchKind m_Kind = DispatchKind::Complex;
+  T* m_Ptr = nullptr;
+  u32 m_Mask = 0;
   std::function<void(u32, T)> m_WriteFunc;
 };
 
@@ -13,10 +13,12 @@
 #include <cstring>
 #include <memory>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/Swap.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/AudioInterface.h"
@@ -181,11 +183,16 @@ void Init()
     flags |= PhysicalMemoryRegion::WII_ONLY;
   if (bFakeVMEM)
     flags |= PhysicalMemoryRegion::FAKE_VMEM;
+  // Huge pages can only back a view if its position in the shared memory is aligned like its
+  // address, which is always aligned to the huge page size.
+  const bool huge_pages = SConfig::GetInstance().bHugePages;
   u32 mem_size = 0;
   for (PhysicalMemoryRegion& region : physical_regions)
   {
     if ((flags & region.flags) != region.flags)
       continue;
+    if (huge_pages)
+      mem_size = Common::AlignUp(mem_size, Common::HUGE_PAGE_SIZE);
     region.shm_position = mem_size;
     mem_size += region.size;
   }
@@ -205,6 +212,10 @@ void Init()
       PanicAlert("MemoryMap_Setup: Failed finding a memory base.");
       exit(0);
     }
+
+    // The logical views are mapped in BAT-sized pieces, which are too small for huge pages.
+    if (huge_pages)
+      Common::AdviseHugePages(*region.out_pointer, region.size);
   }
 
 #ifndef _ARCH_32
@@ -266,14 +277,14 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
-  p.DoArray(m_pRAM, RAM_SIZE);
-  p.DoArray(m_pL1Cache, L1_CACHE_SIZE);
+  p.DoBulkArray(m_pRAM, RAM_SIZE);
+  p.DoBulkArray(m_pL1Cache, L1_CACHE_SIZE);
   p.DoMarker("Memory RAM");
   if (m_pFakeVMEM)
-    p.DoArray(m_pFakeVMEM, FAKEVMEM_SIZE);
+    p.DoBulkArray(m_pFakeVMEM, FAKEVMEM_SIZE);
   p.DoMarker("Memory FakeVMEM");
   if (wii)
-    p.DoArray(m_pEXRAM, EXRAM_SIZE);
+    p.DoBulkArray(m_pEXRAM, EXRAM_SIZE);
   p.DoMarker("Memory EXRAM");
 }
 
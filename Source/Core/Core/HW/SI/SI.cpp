@@ -13,6 +13,7 @@
 #include "Common/CommonTypes.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/GCPad.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI_DeviceGBA.h"
@@ -566,9 +567,10 @@ void ChangeDeviceDeterministic(SIDevices device, int channel)
 
 void UpdateDevices()
 {
-  // Update inputs at the rate of SI
+  // Update inputs at the rate of SI, unless a thread of their own already does
   // Typically 120hz but is variable
-  g_controller_interface.UpdateInput();
+  if (!Pad::IsPolling())
+    g_controller_interface.UpdateInput();
 
   // Update channels and set the status bit if there's new data
   s_status_reg.RDST0 =
@@ -17,27 +17,18 @@ static s32 histl2;
 static s32 histr1;
 static s32 histr2;
 
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+// The filter coefficients for the history, selected by the upper bits of the header of a block.
+// Filters past the fourth don't use the history.
+static constexpr s32 FILTER_COEFFICIENTS[16][2] = {
+    {0, 0}, {0x3c, 0}, {0x73, -0x34}, {0x62, -0x37},
+};
+
+static s16 ADPDecodeSample(s32 bits, s32 shift, const s32* coefficients, s32& hist1, s32& hist2)
 {
-  s32 hist = 0;
-  switch (q >> 4)
-  {
-  case 0:
-    hist = 0;
-    break;
-  case 1:
-    hist = (hist1 * 0x3c);
-    break;
-  case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
-  case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
-  }
+  s32 hist = hist1 * coefficients[0] + hist2 * coefficients[1];
   hist = MathUtil::Clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
 
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+  s32 cur = (((s16)(bits << 12) >> shift) << 6) + hist;
 
   hist2 = hist1;
   hist1 = cur;
@@ -58,12 +49,17 @@ void InitFilter()
 
 void DecodeBlock(s16* pcm, const u8* adpcm)
 {
+  // The header is the same for the whole block, so decode it only once per channel.
+  const s32* coefficients_l = FILTER_COEFFICIENTS[adpcm[0] >> 4];
+  const s32* coefficients_r = FILTER_COEFFICIENTS[adpcm[1] >> 4];
+  const s32 shift_l = adpcm[0] & 0xf;
+  const s32 shift_r = adpcm[1] & 0xf;
+  const u8* data = adpcm + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK);
+
   for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
   {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-                                 histl1, histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-                                     histr1, histr2);
+    pcm[i * 2] = ADPDecodeSample(data[i] & 0xf, shift_l, coefficients_l, histl1, histl2);
+    pcm[i * 2 + 1] = ADPDecodeSample(data[i] >> 4, shift_r, coefficients_r, histr1, histr2);
   }
 }
 }
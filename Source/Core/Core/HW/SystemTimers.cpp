@@ -45,6 +45,11 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 
 #include "Core/HW/SystemTimers.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "AudioCommon/AudioCommon.h"
 #include "Common/Atomic.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -61,7 +66,9 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Core/IOS/IOS.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/RunAhead.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/StageTimings.h"
 
 namespace SystemTimers
 {
@@ -192,32 +199,88 @@ static void PatchEngineCallback(u64 userdata, s64 cycles_late)
   CoreTiming::ScheduleEvent(next_schedule, et_PatchEngine, cycles_pruned);
 }
 
-static void ThrottleCallback(u64 last_time, s64 cyclesLate)
+// Lets the audio backend pace the emulation: the CPU thread waits while more audio is buffered
+// than the mixer aims for, and the mixer's resampler absorbs the remaining clock drift. Returns
+// false if the game isn't playing DMA audio or if the backend doesn't take the audio in time,
+// so that the wall clock is used instead.
+static bool PaceToAudio(const SConfig& config)
+{
+  if (!config.m_audio_pacing || config.m_audio_stretch || config.m_EmulationSpeed != 1.0f ||
+      config.sBackend == BACKEND_NULLSOUND || !g_sound_stream)
+  {
+    return false;
+  }
+
+  const Mixer* mixer = g_sound_stream->GetMixer();
+  if (mixer->GetDMABufferFill() == 0.0f)
+    return false;
+
+  const u64 wait_start = Common::Timer::GetTimeUs();
+  const u64 timeout_us = static_cast<u64>(config.iTimingVariance) * 1000;
+  bool drained = true;
+  while (mixer->GetDMABufferFill() > 1.0f)
+  {
+    if (Common::Timer::GetTimeUs() - wait_start > timeout_us)
+    {
+      drained = false;
+      break;
+    }
+    Common::SleepCurrentThread(1);
+  }
+  StageTimings::AddCPUWaitTime(Common::Timer::GetTimeUs() - wait_start);
+  return drained;
+}
+
+static void ThrottleCallback(u64 deadline_ns, s64 cyclesLate)
 {
   // Allow the GPU thread to sleep. Setting this flag here limits the wakeups to 1 kHz.
   Fifo::GpuMaySleep();
 
-  u32 time = Common::Timer::GetTimeMs();
-
-  int diff = (u32)last_time - time;
+  const u64 time_ns = Common::Timer::GetTimeUs() * 1000;
+  const s64 diff_ns = static_cast<s64>(deadline_ns - time_ns);
   const SConfig& config = SConfig::GetInstance();
-  bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled();
-  u32 next_event = GetTicksPerSecond() / 1000;
+  // The fields that are run ahead are rolled back along with the deadline, so only the ones that
+  // are emulated for real are paced.
+  bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled() &&
+                       !RunAhead::IsRunningAhead();
+
+  // Throttle about once per millisecond, but a whole number of times per field, so that the end
+  // of every field falls on a throttle point and the frames are paced evenly.
+  const u64 ticks_per_field =
+      std::max<u64>(VideoInterface::GetTicksPerField(), GetTicksPerSecond() / 1000);
+  const u64 throttles_per_field = std::max<u64>(
+      1, std::llround(ticks_per_field * 1000.0 / static_cast<double>(GetTicksPerSecond())));
+  const u64 ticks = CoreTiming::GetTicks() - cyclesLate;
+  const u64 next_point = (ticks * throttles_per_field / ticks_per_field + 1) * ticks_per_field /
+                         throttles_per_field;
+  const s64 next_event = static_cast<s64>(next_point - ticks);
+  u64 period_ns = static_cast<u64>(next_event) * 1000000000 / GetTicksPerSecond();
+
   if (frame_limiter)
   {
     if (config.m_EmulationSpeed != 1.0f)
-      next_event = u32(next_event * config.m_EmulationSpeed);
-    const int max_fallback = config.iTimingVariance;
-    if (abs(diff) > max_fallback)
+      period_ns = static_cast<u64>(period_ns / config.m_EmulationSpeed);
+    const s64 max_fallback_ns = static_cast<s64>(config.iTimingVariance) * 1000000;
+    if (PaceToAudio(config))
+    {
+      // Keep the wall clock reference current, so that switching back to it doesn't cause a jump.
+      deadline_ns = Common::Timer::GetTimeUs() * 1000;
+    }
+    else if (std::llabs(diff_ns) > max_fallback_ns)
+    {
+      DEBUG_LOG(COMMON, "system too %s, %lld ms skipped", diff_ns < 0 ? "slow" : "fast",
+                static_cast<long long>((std::llabs(diff_ns) - max_fallback_ns) / 1000000));
+      deadline_ns = time_ns - max_fallback_ns;
+    }
+    else if (diff_ns > 0)
     {
-      DEBUG_LOG(COMMON, "system too %s, %d ms skipped", diff < 0 ? "slow" : "fast",
-                abs(diff) - max_fallback);
-      last_time = time - max_fallback;
+      const u64 sleep_start = Common::Timer::GetTimeUs();
+      Common::SleepCurrentThreadUntil(deadline_ns / 1000,
+                                      static_cast<u64>(std::max(config.iThrottleSpinTime, 0)));
+      StageTimings::AddCPUWaitTime(Common::Timer::GetTimeUs() - sleep_start);
     }
-    else if (diff > 0)
-      Common::SleepCurrentThread(diff);
   }
-  CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, last_time + 1);
+  CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, deadline_ns + period_ns);
 }
 
 // split from Init to break a circular dependency between VideoInterface::Init and
@@ -279,7 +342,7 @@ void Init()
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerHalfLine(), et_VI);
   CoreTiming::ScheduleEvent(0, et_DSP);
   CoreTiming::ScheduleEvent(s_audio_dma_period, et_AudioDMA);
-  CoreTiming::ScheduleEvent(0, et_Throttle, Common::Timer::GetTimeMs());
+  CoreTiming::ScheduleEvent(0, et_Throttle, Common::Timer::GetTimeUs() * 1000);
 
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerField(), et_PatchEngine);
 
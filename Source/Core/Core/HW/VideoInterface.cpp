@@ -22,6 +22,9 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SystemTimers.h"
+#include "Core/Movie.h"
+#include "Core/Rewind.h"
+#include "Core/RunAhead.h"
 
 #include "DiscIO/Enums.h"
 
@@ -713,11 +716,19 @@ static void BeginField(FieldType field, u64 ticks)
   // to VI during scanout and delay outputting the frame till then.
   if (xfbAddr)
     g_video_backend->Video_BeginField(xfbAddr, fbWidth, fbStride, fbHeight, ticks);
+
+  RunAhead::FieldBegin();
 }
 
 static void EndField()
 {
+  // The fields that are run ahead get emulated again for real.
+  if (RunAhead::IsRunningAhead())
+    return;
+
   Core::VideoThrottle();
+  Rewind::FieldEnd();
+  Movie::FieldEnd();
 }
 
 // Purpose: Send VI interrupt when triggered
@@ -4,11 +4,12 @@
 
 #pragma once
 
-#include <mbedtls/aes.h>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 
 class CWiiSaveCrypted
 {
@@ -38,7 +39,7 @@ private:
   static const u8 s_md5_blanker[16];
   static const u32 s_ng_id;
 
-  mbedtls_aes_context m_aes_ctx;
+  std::unique_ptr<Common::AES::Context> m_aes_ctx;
   u8 m_sd_iv[0x10];
   std::vector<std::string> m_files_list;
 
@@ -46,8 +47,6 @@ private:
 
   std::string m_wii_title_path;
 
-  u8 m_iv[0x10];
-
   u32 m_files_list_size;
   u32 m_size_of_files;
   u32 m_total_size;
@@ -515,44 +515,10 @@ inline void LowPassFilter(double& var, double newval, double period)
   var = newval * alpha + var * (1.0 - alpha);
 }
 
-void Wiimote::GetIRData(u8* const data, bool use_accel)
+void Wiimote::ProjectIRPoints(ControlState xx, ControlState yy, ControlState zz, u16* x, u16* y)
 {
-  u16 x[4], y[4];
-  memset(x, 0xFF, sizeof(x));
-
-  ControlState xx = 10000, yy = 0, zz = 0;
-  double nsin, ncos;
-
-  if (use_accel)
-  {
-    double ax, az, len;
-    ax = m_accel.x;
-    az = m_accel.z;
-    len = sqrt(ax * ax + az * az);
-    if (len)
-    {
-      ax /= len;
-      az /= len;  // normalizing the vector
-      nsin = ax;
-      ncos = az;
-    }
-    else
-    {
-      nsin = 0;
-      ncos = 1;
-    }
-  }
-  else
-  {
-    // TODO m_tilt stuff
-    nsin = 0;
-    ncos = 1;
-  }
-
-  LowPassFilter(ir_sin, nsin, 1.0 / 60);
-  LowPassFilter(ir_cos, ncos, 1.0 / 60);
-
-  m_ir->GetState(&xx, &yy, &zz, true);
+  // Points outside of the camera's view are left at 0xFFFF.
+  std::fill_n(x, 4, 0xFFFF);
 
   Vertex v[4];
 
@@ -598,6 +564,60 @@ void Wiimote::GetIRData(u8* const data, bool use_accel)
     x[i] = (u16)lround((v[i].x + 1) / 2 * (camWidth - 1));
     y[i] = (u16)lround((v[i].y + 1) / 2 * (camHeight - 1));
   }
+}
+
+void Wiimote::GetIRData(u8* const data, bool use_accel)
+{
+  ControlState xx = 10000, yy = 0, zz = 0;
+  double nsin, ncos;
+
+  if (use_accel)
+  {
+    double ax, az, len;
+    ax = m_accel.x;
+    az = m_accel.z;
+    len = sqrt(ax * ax + az * az);
+    if (len)
+    {
+      ax /= len;
+      az /= len;  // normalizing the vector
+      nsin = ax;
+      ncos = az;
+    }
+    else
+    {
+      nsin = 0;
+      ncos = 1;
+    }
+  }
+  else
+  {
+    // TODO m_tilt stuff
+    nsin = 0;
+    ncos = 1;
+  }
+
+  LowPassFilter(ir_sin, nsin, 1.0 / 60);
+  LowPassFilter(ir_cos, ncos, 1.0 / 60);
+
+  m_ir->GetState(&xx, &yy, &zz, true);
+
+  IRProjection& proj = m_ir_projection;
+  if (!proj.valid || proj.x != xx || proj.y != yy || proj.z != zz || proj.sin != ir_sin ||
+      proj.cos != ir_cos || proj.sensor_bar_on_top != m_sensor_bar_on_top)
+  {
+    ProjectIRPoints(xx, yy, zz, proj.points_x, proj.points_y);
+    proj.valid = true;
+    proj.x = xx;
+    proj.y = yy;
+    proj.z = zz;
+    proj.sin = ir_sin;
+    proj.cos = ir_cos;
+    proj.sensor_bar_on_top = m_sensor_bar_on_top;
+  }
+  const u16* const x = proj.points_x;
+  const u16* const y = proj.points_y;
+
   // Fill report with valid data when full handshake was done
   if (m_reg_ir.data[0x30])
     // ir mode
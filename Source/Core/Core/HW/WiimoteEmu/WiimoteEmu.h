@@ -219,6 +219,7 @@ protected:
 
   void GetButtonData(u8* const data);
   void GetAccelData(u8* const data, const ReportFeatures& rptf);
+  void ProjectIRPoints(ControlState xx, ControlState yy, ControlState zz, u16* x, u16* y);
   void GetIRData(u8* const data, bool use_accel);
   void GetExtData(u8* const data);
 
@@ -267,6 +268,17 @@ private:
 
   double ir_sin, ir_cos;  // for the low pass filter
 
+  // The IR camera points of the last report, and what they were projected from. The pointer
+  // usually rests between reports, so the projection can often be reused.
+  struct IRProjection
+  {
+    bool valid = false;
+    ControlState x, y, z;
+    double sin, cos;
+    bool sensor_bar_on_top;
+    u16 points_x[4], points_y[4];
+  } m_ir_projection;
+
   bool m_rumble_on;
   bool m_speaker_mute;
   bool m_motion_plus_present;
@@ -5,6 +5,7 @@
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <mutex>
 #include <queue>
@@ -532,14 +533,27 @@ bool WiimoteScanner::IsReady() const
                      [](const auto& backend) { return backend->IsReady(); });
 }
 
-static void CheckForDisconnectedWiimotes()
+// Returns whether any Wii Remote was disconnected.
+static bool CheckForDisconnectedWiimotes()
 {
   std::lock_guard<std::mutex> lk(g_wiimotes_mutex);
+  bool disconnected = false;
   for (unsigned int i = 0; i < MAX_BBMOTES; ++i)
+  {
     if (g_wiimotes[i] && !g_wiimotes[i]->IsConnected())
+    {
       HandleWiimoteDisconnect(i);
+      disconnected = true;
+    }
+  }
+  return disconnected;
 }
 
+// Inquiries can disturb the Wii Remotes which are already connected, so while there are some and
+// nothing new is found, the time between scans is doubled up to the maximum.
+constexpr std::chrono::milliseconds MIN_SCAN_INTERVAL{500};
+constexpr std::chrono::milliseconds MAX_SCAN_INTERVAL{16000};
+
 void WiimoteScanner::ThreadFunc()
 {
   Common::SetCurrentThreadName("Wiimote Scanning Thread");
@@ -560,22 +574,36 @@ void WiimoteScanner::ThreadFunc()
     m_backends.emplace_back(std::make_unique<WiimoteScannerHidapi>());
   }
 
+  std::chrono::milliseconds scan_interval = MIN_SCAN_INTERVAL;
+  auto next_scan = std::chrono::steady_clock::now();
+
   while (m_scan_thread_running.IsSet())
   {
-    m_scan_mode_changed_event.WaitFor(std::chrono::milliseconds(500));
+    // A changed scan mode means the user asked for a scan, and a disconnected Wii Remote is likely
+    // to be reconnected soon, so neither should wait.
+    if (m_scan_mode_changed_event.WaitFor(MIN_SCAN_INTERVAL))
+      scan_interval = MIN_SCAN_INTERVAL;
 
-    CheckForDisconnectedWiimotes();
+    if (CheckForDisconnectedWiimotes())
+      scan_interval = MIN_SCAN_INTERVAL;
 
     if (m_scan_mode.load() == WiimoteScanMode::DO_NOT_SCAN)
       continue;
 
+    const auto now = std::chrono::steady_clock::now();
+    const bool scan_due = scan_interval == MIN_SCAN_INTERVAL || now >= next_scan;
+    bool scanned = false;
+    bool found_any = false;
+
     for (const auto& backend : m_backends)
     {
-      if (CalculateWantedWiimotes() != 0 || CalculateWantedBB() != 0)
+      if (scan_due && (CalculateWantedWiimotes() != 0 || CalculateWantedBB() != 0))
       {
         std::vector<Wiimote*> found_wiimotes;
         Wiimote* found_board = nullptr;
         backend->FindWiimotes(found_wiimotes, found_board);
+        scanned = true;
+        found_any |= !found_wiimotes.empty() || found_board;
         {
           if (!g_real_wiimotes_initialized)
             continue;
@@ -591,7 +619,16 @@ void WiimoteScanner::ThreadFunc()
       }
     }
 
-    if (m_scan_mode.load() == WiimoteScanMode::SCAN_ONCE)
+    if (scanned)
+    {
+      if (found_any || CalculateConnectedWiimotes() == 0)
+        scan_interval = MIN_SCAN_INTERVAL;
+      else
+        scan_interval = std::min(scan_interval * 2, MAX_SCAN_INTERVAL);
+      next_scan = std::chrono::steady_clock::now() + scan_interval;
+    }
+
+    if (scan_due && m_scan_mode.load() == WiimoteScanMode::SCAN_ONCE)
       m_scan_mode.store(WiimoteScanMode::DO_NOT_SCAN);
   }
 
@@ -11,9 +11,8 @@
 #include <utility>
 #include <vector>
 
-#include <mbedtls/sha1.h>
-
 #include "Common/ChunkFile.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -25,6 +24,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/FileIO.h"
 #include "Core/IOS/IOSC.h"
 #include "Core/ec_wii.h"
 #include "DiscIO/NANDContentLoader.h"
@@ -345,6 +345,8 @@ void ES::DoState(PointerWrap& p)
 
   for (auto& context : m_contexts)
     context.DoState(p);
+
+  InvalidateTitleCache();
 }
 
 ES::ContextArray::iterator ES::FindActiveContext(s32 fd)
@@ -391,6 +393,8 @@ ReturnCode ES::Close(u32 fd)
 IPCCommandResult ES::IOCtlV(const IOCtlVRequest& request)
 {
   DEBUG_LOG(IOS_ES, "%s (0x%x)", GetDeviceName().c_str(), request.request);
+  // ES accesses the NAND directly, bypassing the FS.
+  FinishQueuedFileIO();
   auto context = FindActiveContext(request.fd);
   if (context == m_contexts.end())
     return GetDefaultReply(ES_EINVAL);
@@ -658,6 +662,7 @@ s32 ES::DIVerify(const IOS::ES::TMDReader& tmd, const IOS::ES::TicketReader& tic
   // DI_VERIFY writes to title.tmd, which is read and cached inside the NAND Content Manager.
   // clear the cache to avoid content access mismatches.
   DiscIO::NANDContentManager::Access().ClearCache();
+  GetIOS()->GetES()->InvalidateTitleCache();
 
   if (!UpdateUIDAndGID(*GetIOS(), s_title_context.tmd))
   {
@@ -922,9 +927,8 @@ ReturnCode ES::VerifyContainer(VerifyContainerType type, VerifyMode mode,
   // Calculate the SHA1 of the signed blob.
   const size_t skip = type == VerifyContainerType::Device ? offsetof(SignatureECC, issuer) :
                                                             offsetof(SignatureRSA2048, issuer);
-  std::array<u8, 20> sha1;
-  mbedtls_sha1(signed_blob.GetBytes().data() + skip, signed_blob.GetBytes().size() - skip,
-               sha1.data());
+  const Common::SHA1::Digest sha1 = Common::SHA1::CalculateDigest(
+      signed_blob.GetBytes().data() + skip, signed_blob.GetBytes().size() - skip);
 
   // Verify the signature.
   const std::vector<u8> signature = signed_blob.GetSignatureData();
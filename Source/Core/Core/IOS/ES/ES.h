@@ -6,6 +6,8 @@
 
 #include <array>
 #include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -99,6 +101,10 @@ public:
   u32 GetSharedContentsCount() const;
   std::vector<std::array<u8, 20>> GetSharedContents() const;
 
+  // Drops everything that was cached about the installed titles. Must be called whenever
+  // titles, tickets or shared contents may have changed on the NAND.
+  void InvalidateTitleCache() const;
+
   // Title contents
   s32 OpenContent(const IOS::ES::TMDReader& tmd, u16 content_index, u32 uid);
   ReturnCode CloseContent(u32 cfd, u32 uid);
@@ -335,6 +341,21 @@ private:
 
   static const DiscIO::NANDContentLoader& AccessContentDevice(u64 title_id);
 
+  const IOS::ES::SharedContentMap& GetSharedContentMap() const;
+  const std::set<std::string>& GetFileNamesInDirectory(const std::string& path) const;
+
+  // What the title queries found on the NAND, so that the System Menu and channels listing the
+  // same titles over and over don't rescan the NAND and reread every TMD each time.
+  struct TitleCache
+  {
+    std::optional<std::vector<u64>> installed_titles;
+    std::optional<std::vector<u64>> titles_with_tickets;
+    std::map<u64, IOS::ES::TMDReader> installed_tmds;
+    std::optional<IOS::ES::SharedContentMap> shared_content_map;
+    // The names of the files in a directory, keyed by its host path.
+    std::map<std::string, std::set<std::string>> file_names;
+  };
+
   // TODO: reuse the FS code.
   struct OpenedContent
   {
@@ -349,6 +370,8 @@ private:
   ContentTable m_content_table;
 
   ContextArray m_contexts;
+
+  mutable TitleCache m_title_cache;
 };
 }  // namespace Device
 }  // namespace HLE
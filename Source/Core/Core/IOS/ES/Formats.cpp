@@ -13,6 +13,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -491,19 +492,35 @@ SharedContentMap::SharedContentMap(Common::FromWhichRoot root) : m_root(root)
     m_entries.push_back(entry);
     m_last_id++;
   }
+  BuildIndex();
 }
 
 SharedContentMap::~SharedContentMap() = default;
 
+size_t SharedContentMap::SHA1Hash::operator()(const std::array<u8, 20>& sha1) const
+{
+  size_t hash;
+  std::memcpy(&hash, sha1.data(), sizeof(hash));
+  return hash;
+}
+
+void SharedContentMap::BuildIndex()
+{
+  m_index.clear();
+  // If a hash is listed more than once, the first entry is the one that is used.
+  for (size_t i = 0; i < m_entries.size(); ++i)
+    m_index.emplace(m_entries[i].sha1, i);
+}
+
 std::optional<std::string>
 SharedContentMap::GetFilenameFromSHA1(const std::array<u8, 20>& sha1) const
 {
-  const auto it = std::find_if(m_entries.begin(), m_entries.end(),
-                               [&sha1](const auto& entry) { return entry.sha1 == sha1; });
-  if (it == m_entries.end())
+  const auto it = m_index.find(sha1);
+  if (it == m_index.end())
     return {};
 
-  const std::string id_string(it->id.begin(), it->id.end());
+  const Entry& entry = m_entries[it->second];
+  const std::string id_string(entry.id.begin(), entry.id.end());
   return Common::RootUserPath(m_root) + StringFromFormat("/shared1/%s.app", id_string.c_str());
 }
 
@@ -527,6 +544,7 @@ std::string SharedContentMap::AddSharedContent(const std::array<u8, 20>& sha1)
   Entry entry;
   std::copy(id.cbegin(), id.cend(), entry.id.begin());
   entry.sha1 = sha1;
+  m_index.emplace(sha1, m_entries.size());
   m_entries.push_back(entry);
 
   WriteEntries();
@@ -540,6 +558,7 @@ bool SharedContentMap::DeleteSharedContent(const std::array<u8, 20>& sha1)
   m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
                                  [&sha1](const auto& entry) { return entry.sha1 == sha1; }),
                   m_entries.end());
+  BuildIndex();
   return WriteEntries();
 }
 
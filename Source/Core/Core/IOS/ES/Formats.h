@@ -12,6 +12,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -257,12 +258,21 @@ public:
 
 private:
   bool WriteEntries() const;
+  void BuildIndex();
 
   struct Entry;
+  // SHA1 hashes are already uniformly distributed, so a part of one is as good a hash as any.
+  struct SHA1Hash
+  {
+    size_t operator()(const std::array<u8, 20>& sha1) const;
+  };
+
   Common::FromWhichRoot m_root;
   u32 m_last_id = 0;
   std::string m_file_path;
   std::vector<Entry> m_entries;
+  // Maps the hashes to indices into m_entries, so that lookups don't go through every entry.
+  std::unordered_map<std::array<u8, 20>, size_t, SHA1Hash> m_index;
 };
 
 class UIDSys final
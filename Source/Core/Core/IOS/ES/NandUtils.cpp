@@ -8,6 +8,7 @@
 #include <cinttypes>
 #include <functional>
 #include <iterator>
+#include <set>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -17,9 +18,11 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/NandPaths.h"
+#include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/FS.h"
 
 namespace IOS
 {
@@ -47,7 +50,46 @@ IOS::ES::TMDReader ES::FindImportTMD(u64 title_id) const
 
 IOS::ES::TMDReader ES::FindInstalledTMD(u64 title_id) const
 {
-  return FindTMD(title_id, Common::GetTMDFileName(title_id, Common::FROM_SESSION_ROOT));
+  const auto it = m_title_cache.installed_tmds.find(title_id);
+  if (it != m_title_cache.installed_tmds.end())
+    return it->second;
+
+  IOS::ES::TMDReader tmd =
+      FindTMD(title_id, Common::GetTMDFileName(title_id, Common::FROM_SESSION_ROOT));
+  m_title_cache.installed_tmds.emplace(title_id, tmd);
+  return tmd;
+}
+
+void ES::InvalidateTitleCache() const
+{
+  m_title_cache.installed_titles.reset();
+  m_title_cache.titles_with_tickets.reset();
+  m_title_cache.installed_tmds.clear();
+  m_title_cache.shared_content_map.reset();
+  m_title_cache.file_names.clear();
+  m_ios.GetFS()->InvalidateCache();
+}
+
+const IOS::ES::SharedContentMap& ES::GetSharedContentMap() const
+{
+  if (!m_title_cache.shared_content_map)
+    m_title_cache.shared_content_map.emplace(Common::FROM_SESSION_ROOT);
+  return *m_title_cache.shared_content_map;
+}
+
+const std::set<std::string>& ES::GetFileNamesInDirectory(const std::string& path) const
+{
+  const auto it = m_title_cache.file_names.find(path);
+  if (it != m_title_cache.file_names.end())
+    return it->second;
+
+  std::set<std::string> names;
+  for (const File::FSTEntry& entry : File::ScanDirectoryTree(path, false).children)
+  {
+    if (!entry.isDirectory)
+      names.insert(entry.virtualName);
+  }
+  return m_title_cache.file_names.emplace(path, std::move(names)).first->second;
 }
 
 static bool IsValidPartOfTitleID(const std::string& string)
@@ -101,7 +143,12 @@ static std::vector<u64> GetTitlesInTitleOrImport(const std::string& titles_dir)
 
 std::vector<u64> ES::GetInstalledTitles() const
 {
-  return GetTitlesInTitleOrImport(Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/title");
+  if (!m_title_cache.installed_titles)
+  {
+    m_title_cache.installed_titles =
+        GetTitlesInTitleOrImport(Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/title");
+  }
+  return *m_title_cache.installed_titles;
 }
 
 std::vector<u64> ES::GetTitleImports() const
@@ -111,6 +158,9 @@ std::vector<u64> ES::GetTitleImports() const
 
 std::vector<u64> ES::GetTitlesWithTickets() const
 {
+  if (m_title_cache.titles_with_tickets)
+    return *m_title_cache.titles_with_tickets;
+
   const std::string tickets_dir = Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/ticket";
   if (!File::IsDirectory(tickets_dir))
   {
@@ -146,6 +196,7 @@ std::vector<u64> ES::GetTitlesWithTickets() const
     }
   }
 
+  m_title_cache.titles_with_tickets = title_ids;
   return title_ids;
 }
 
@@ -154,21 +205,23 @@ std::vector<IOS::ES::Content> ES::GetStoredContentsFromTMD(const IOS::ES::TMDRea
   if (!tmd.IsValid())
     return {};
 
-  const IOS::ES::SharedContentMap shared{Common::FROM_SESSION_ROOT};
+  const IOS::ES::SharedContentMap& shared = GetSharedContentMap();
+  const std::set<std::string>& shared_files =
+      GetFileNamesInDirectory(Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/shared1");
+  const std::set<std::string>& title_files = GetFileNamesInDirectory(
+      Common::GetTitleContentPath(tmd.GetTitleId(), Common::FROM_SESSION_ROOT));
   const std::vector<IOS::ES::Content> contents = tmd.GetContents();
 
   std::vector<IOS::ES::Content> stored_contents;
 
   std::copy_if(contents.begin(), contents.end(), std::back_inserter(stored_contents),
-               [&tmd, &shared](const auto& content) {
+               [&shared, &shared_files, &title_files](const auto& content) {
                  if (content.IsShared())
                  {
                    const auto path = shared.GetFilenameFromSHA1(content.sha1);
-                   return path && File::Exists(*path);
+                   return path && shared_files.count(path->substr(path->rfind('/') + 1)) != 0;
                  }
-                 return File::Exists(
-                     Common::GetTitleContentPath(tmd.GetTitleId(), Common::FROM_SESSION_ROOT) +
-                     StringFromFormat("%08x.app", content.id));
+                 return title_files.count(StringFromFormat("%08x.app", content.id)) != 0;
                });
 
   return stored_contents;
@@ -176,19 +229,16 @@ std::vector<IOS::ES::Content> ES::GetStoredContentsFromTMD(const IOS::ES::TMDRea
 
 u32 ES::GetSharedContentsCount() const
 {
-  const std::string shared1_path = Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/shared1";
-  const auto entries = File::ScanDirectoryTree(shared1_path, false);
-  return static_cast<u32>(
-      std::count_if(entries.children.begin(), entries.children.end(), [](const auto& entry) {
-        return !entry.isDirectory && entry.virtualName.size() == 12 &&
-               entry.virtualName.compare(8, 4, ".app") == 0;
-      }));
+  const std::set<std::string>& names =
+      GetFileNamesInDirectory(Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/shared1");
+  return static_cast<u32>(std::count_if(names.begin(), names.end(), [](const auto& name) {
+    return name.size() == 12 && name.compare(8, 4, ".app") == 0;
+  }));
 }
 
 std::vector<std::array<u8, 20>> ES::GetSharedContents() const
 {
-  const IOS::ES::SharedContentMap map{Common::FROM_SESSION_ROOT};
-  return map.GetHashes();
+  return GetSharedContentMap().GetHashes();
 }
 
 bool ES::InitImport(u64 title_id)
@@ -281,6 +331,8 @@ void ES::FinishStaleImport(u64 title_id)
 
 void ES::FinishAllStaleImports()
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   const std::vector<u64> titles = GetTitleImports();
   for (const u64& title_id : titles)
     FinishStaleImport(title_id);
@@ -10,13 +10,13 @@
 #include <utility>
 #include <vector>
 
-#include <mbedtls/sha1.h>
-
 #include "Common/Align.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/NandPaths.h"
+#include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/CommonTitles.h"
 #include "Core/HW/Memmap.h"
@@ -58,6 +58,8 @@ void ES::TitleImportExportContext::DoState(PointerWrap& p)
 
 ReturnCode ES::ImportTicket(const std::vector<u8>& ticket_bytes, const std::vector<u8>& cert_chain)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   IOS::ES::TicketReader ticket{ticket_bytes};
   if (!ticket.IsValid())
     return ES_EINVAL;
@@ -139,6 +141,8 @@ static void ResetTitleImportContext(ES::Context* context, IOSC& iosc)
 
 ReturnCode ES::ImportTmd(Context& context, const std::vector<u8>& tmd_bytes)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   // Ioctlv 0x2b writes the TMD to /tmp/title.tmd (for imports) and doesn't seem to write it
   // to either /import or /title. So here we simply have to set the import TMD.
   ResetTitleImportContext(&context, m_ios.GetIOSC());
@@ -202,6 +206,8 @@ static ReturnCode InitTitleImportKey(const std::vector<u8>& ticket_bytes, IOSC&
 ReturnCode ES::ImportTitleInit(Context& context, const std::vector<u8>& tmd_bytes,
                                const std::vector<u8>& cert_chain)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   INFO_LOG(IOS_ES, "ImportTitleInit");
   ResetTitleImportContext(&context, m_ios.GetIOSC());
   context.title_import_export.tmd.SetBytes(tmd_bytes);
@@ -335,9 +341,7 @@ IPCCommandResult ES::ImportContentData(Context& context, const IOCtlVRequest& re
 
 static bool CheckIfContentHashMatches(const std::vector<u8>& content, const IOS::ES::Content& info)
 {
-  std::array<u8, 20> sha1;
-  mbedtls_sha1(content.data(), info.size, sha1.data());
-  return sha1 == info.sha1;
+  return Common::SHA1::CalculateDigest(content.data(), info.size) == info.sha1;
 }
 
 static std::string GetImportContentPath(u64 title_id, u32 content_id)
@@ -347,6 +351,8 @@ static std::string GetImportContentPath(u64 title_id, u32 content_id)
 
 ReturnCode ES::ImportContentEnd(Context& context, u32 content_fd)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   INFO_LOG(IOS_ES, "ImportContentEnd: content fd %08x", content_fd);
 
   if (!context.title_import_export.valid || !context.title_import_export.content.valid)
@@ -417,6 +423,8 @@ IPCCommandResult ES::ImportContentEnd(Context& context, const IOCtlVRequest& req
 
 ReturnCode ES::ImportTitleDone(Context& context)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   if (!context.title_import_export.valid || context.title_import_export.content.valid)
     return ES_EINVAL;
 
@@ -461,6 +469,8 @@ IPCCommandResult ES::ImportTitleDone(Context& context, const IOCtlVRequest& requ
 
 ReturnCode ES::ImportTitleCancel(Context& context)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   // The TMD buffer can exist without a valid title import context.
   if (context.title_import_export.tmd.GetBytes().empty() ||
       context.title_import_export.content.valid)
@@ -493,6 +503,8 @@ static bool CanDeleteTitle(u64 title_id)
 
 ReturnCode ES::DeleteTitle(u64 title_id)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   if (!CanDeleteTitle(title_id))
     return ES_EINVAL;
 
@@ -522,6 +534,8 @@ IPCCommandResult ES::DeleteTitle(const IOCtlVRequest& request)
 
 ReturnCode ES::DeleteTicket(const u8* ticket_view)
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   const u64 title_id = Common::swap64(ticket_view + offsetof(IOS::ES::TicketView, title_id));
 
   if (!CanDeleteTitle(title_id))
@@ -569,6 +583,8 @@ IPCCommandResult ES::DeleteTicket(const IOCtlVRequest& request)
 
 ReturnCode ES::DeleteTitleContent(u64 title_id) const
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   if (!CanDeleteTitle(title_id))
     return ES_EINVAL;
 
@@ -594,6 +610,8 @@ IPCCommandResult ES::DeleteTitleContent(const IOCtlVRequest& request)
 
 ReturnCode ES::DeleteContent(u64 title_id, u32 content_id) const
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   if (!CanDeleteTitle(title_id))
     return ES_EINVAL;
 
@@ -786,6 +804,8 @@ IPCCommandResult ES::ExportTitleDone(Context& context, const IOCtlVRequest& requ
 
 ReturnCode ES::DeleteSharedContent(const std::array<u8, 20>& sha1) const
 {
+  const Common::ScopeGuard invalidate_guard{[this] { InvalidateTitleCache(); }};
+
   IOS::ES::SharedContentMap map{Common::FromWhichRoot::FROM_SESSION_ROOT};
   const auto content_path = map.GetFilenameFromSHA1(sha1);
   if (!content_path)
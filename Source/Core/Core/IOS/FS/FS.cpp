@@ -8,6 +8,7 @@
 #include <cstring>
 #include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "Common/Assert.h"
@@ -46,6 +47,7 @@ FS::FS(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
 void FS::DoState(PointerWrap& p)
 {
   DoStateShared(p);
+  InvalidateCache();
 
   // handle /tmp
 
@@ -159,8 +161,22 @@ static u64 ComputeTotalFileSize(const File::FSTEntry& parentEntry)
   return sizeOfFiles;
 }
 
+void FS::InvalidateCache()
+{
+  m_directory_cache.clear();
+  m_usage_cache.clear();
+}
+
 IPCCommandResult FS::IOCtl(const IOCtlRequest& request)
 {
+  FinishQueuedFileIO();
+  // All of the other IOCtls modify the NAND, which might change the titles ES knows about.
+  if (request.request != IOCTL_GET_STATS && request.request != IOCTL_GET_ATTR)
+  {
+    InvalidateCache();
+    m_ios.GetES()->InvalidateTitleCache();
+  }
+
   Memory::Memset(request.buffer_out, 0, request.buffer_out_size);
 
   switch (request.request)
@@ -191,6 +207,8 @@ IPCCommandResult FS::IOCtl(const IOCtlRequest& request)
 
 IPCCommandResult FS::IOCtlV(const IOCtlVRequest& request)
 {
+  FinishQueuedFileIO();
+
   switch (request.request)
   {
   case IOCTLV_READ_DIR:
@@ -538,35 +556,27 @@ IPCCommandResult FS::ReadDirectory(const IOCtlVRequest& request)
 
   INFO_LOG(IOS_FILEIO, "FS: IOCTL_READ_DIR %s", DirName.c_str());
 
-  const File::FileInfo file_info(DirName);
-
-  if (!file_info.Exists())
+  auto cached_entry = m_directory_cache.find(DirName);
+  if (cached_entry == m_directory_cache.end())
   {
-    WARN_LOG(IOS_FILEIO, "FS: Search not found: %s", DirName.c_str());
-    return GetFSReply(FS_ENOENT);
-  }
+    const File::FileInfo file_info(DirName);
 
-  if (!file_info.IsDirectory())
-  {
-    // It's not a directory, so error.
-    // Games don't usually seem to care WHICH error they get, as long as it's <
-    // Well the system menu CARES!
-    WARN_LOG(IOS_FILEIO, "\tNot a directory - return FS_EINVAL");
-    return GetFSReply(FS_EINVAL);
-  }
-
-  File::FSTEntry entry = File::ScanDirectoryTree(DirName, false);
+    if (!file_info.Exists())
+    {
+      WARN_LOG(IOS_FILEIO, "FS: Search not found: %s", DirName.c_str());
+      return GetFSReply(FS_ENOENT);
+    }
 
-  // it is one
-  if ((request.in_vectors.size() == 1) && (request.io_vectors.size() == 1))
-  {
-    size_t numFile = entry.children.size();
-    INFO_LOG(IOS_FILEIO, "\t%zu files found", numFile);
+    if (!file_info.IsDirectory())
+    {
+      // It's not a directory, so error.
+      // Games don't usually seem to care WHICH error they get, as long as it's <
+      // Well the system menu CARES!
+      WARN_LOG(IOS_FILEIO, "\tNot a directory - return FS_EINVAL");
+      return GetFSReply(FS_EINVAL);
+    }
 
-    Memory::Write_U32((u32)numFile, request.io_vectors[0].address);
-  }
-  else
-  {
+    File::FSTEntry entry = File::ScanDirectoryTree(DirName, false);
     for (File::FSTEntry& child : entry.children)
     {
       // Decode escaped invalid file system characters so that games (such as
@@ -579,6 +589,20 @@ IPCCommandResult FS::ReadDirectory(const IOCtlVRequest& request)
                 return one.virtualName < two.virtualName;
               });
 
+    cached_entry = m_directory_cache.emplace(DirName, std::move(entry)).first;
+  }
+  const File::FSTEntry& entry = cached_entry->second;
+
+  // it is one
+  if ((request.in_vectors.size() == 1) && (request.io_vectors.size() == 1))
+  {
+    size_t numFile = entry.children.size();
+    INFO_LOG(IOS_FILEIO, "\t%zu files found", numFile);
+
+    Memory::Write_U32((u32)numFile, request.io_vectors[0].address);
+  }
+  else
+  {
     u32 MaxEntries = Memory::Read_U32(request.in_vectors[0].address);
 
     memset(Memory::GetPointer(request.io_vectors[0].address), 0, request.io_vectors[0].size);
@@ -627,7 +651,13 @@ IPCCommandResult FS::GetUsage(const IOCtlVRequest& request)
   u32 iNodes = 0;
 
   INFO_LOG(IOS_FILEIO, "IOCTL_GETUSAGE %s", path.c_str());
-  if (File::IsDirectory(path))
+  const auto cached_usage = m_usage_cache.find(path);
+  if (cached_usage != m_usage_cache.end())
+  {
+    fsBlocks = cached_usage->second.fs_blocks;
+    iNodes = cached_usage->second.inodes;
+  }
+  else if (File::IsDirectory(path))
   {
     File::FSTEntry parentDir = File::ScanDirectoryTree(path, true);
     // add one for the folder itself
@@ -638,6 +668,7 @@ IPCCommandResult FS::GetUsage(const IOCtlVRequest& request)
     fsBlocks = (u32)(totalSize / (16 * 1024));  // one bock is 16kb
 
     INFO_LOG(IOS_FILEIO, "FS: fsBlock: %i, iNodes: %i", fsBlocks, iNodes);
+    m_usage_cache.emplace(path, Usage{fsBlocks, iNodes});
   }
   else
   {
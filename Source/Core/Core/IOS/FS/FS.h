@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <map>
 #include <string>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
 
@@ -40,6 +42,9 @@ public:
   IPCCommandResult IOCtl(const IOCtlRequest& request) override;
   IPCCommandResult IOCtlV(const IOCtlVRequest& request) override;
 
+  // Drops the cached directory listings and usage. Must be called whenever the NAND is modified.
+  void InvalidateCache();
+
 private:
   enum
   {
@@ -68,6 +73,17 @@ private:
 
   IPCCommandResult ReadDirectory(const IOCtlVRequest& request);
   IPCCommandResult GetUsage(const IOCtlVRequest& request);
+
+  struct Usage
+  {
+    u32 fs_blocks;
+    u32 inodes;
+  };
+
+  // Keyed by host path. Games list and measure the same directories over and over, and scanning
+  // them on the host is slow.
+  std::map<std::string, File::FSTEntry> m_directory_cache;
+  std::map<std::string, Usage> m_usage_cache;
 };
 }  // namespace Device
 }  // namespace HLE
@@ -4,11 +4,17 @@
 
 #include "Core/IOS/FS/FileIO.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -16,15 +22,206 @@
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/NandPaths.h"
+#include "Common/Thread.h"
 #include "Core/CommonTitles.h"
+#include "Core/CoreTiming.h"
 #include "Core/HW/Memmap.h"
+#include "Core/IOS/FS/FS.h"
 #include "Core/IOS/IOS.h"
 
 namespace IOS
 {
 namespace HLE
 {
-static std::map<std::string, std::weak_ptr<File::IOFile>> openFiles;
+// A host file which is opened by one or more FileIO devices. Its size is cached, because it only
+// changes through writes from these devices, so that seeks and reads don't have to ask the host.
+struct OpenedFile
+{
+  explicit OpenedFile(const std::string& path)
+      : file(path, "r+b"), size(static_cast<u32>(file.GetSize()))
+  {
+  }
+
+  File::IOFile file;
+  u32 size;
+};
+
+static std::map<std::string, std::weak_ptr<OpenedFile>> openFiles;
+
+// A read or write which waits for the worker thread, keyed by the address of its request.
+// The reply is sent after the usual delay no matter how long the host takes, which keeps the
+// emulation deterministic. The CPU thread only waits if the host is slower than that.
+// The file is only let go of on the CPU thread, since its deleter modifies openFiles.
+struct QueuedOperation
+{
+  std::shared_ptr<OpenedFile> file;
+  u32 offset = 0;
+  u32 buffer = 0;
+  bool is_write = false;
+  // The data to write, or the data that was read.
+  std::vector<u8> data;
+  s32 return_value = 0;
+  bool done = false;
+};
+
+static std::mutex s_operations_mutex;
+static std::condition_variable s_queue_cv;
+static std::condition_variable s_done_cv;
+static std::map<u32, QueuedOperation> s_operations;
+static std::deque<QueuedOperation*> s_queue;
+static size_t s_unfinished_operations = 0;
+static bool s_exit_thread = false;
+static std::thread s_thread;
+static CoreTiming::EventType* s_event_finish_operation;
+
+static void RunOperation(QueuedOperation* operation)
+{
+  File::IOFile& file = operation->file->file;
+  // The file might be opened by several devices, so always seek first.
+  file.Seek(operation->offset, SEEK_SET);
+
+  if (operation->is_write)
+  {
+    const u32 size = static_cast<u32>(operation->data.size());
+    operation->return_value =
+        file.WriteBytes(operation->data.data(), size) ? static_cast<s32>(size) : FS_EACCESS;
+    std::vector<u8>().swap(operation->data);
+    return;
+  }
+
+  const size_t bytes_read =
+      fread(operation->data.data(), 1, operation->data.size(), file.GetHandle());
+  if (bytes_read != operation->data.size() && ferror(file.GetHandle()))
+  {
+    operation->return_value = FS_EACCESS;
+    operation->data.clear();
+    return;
+  }
+
+  operation->return_value = static_cast<s32>(bytes_read);
+  operation->data.resize(bytes_read);
+}
+
+static void OperationThread()
+{
+  Common::SetCurrentThreadName("IOS FileIO");
+
+  std::unique_lock<std::mutex> lk(s_operations_mutex);
+  while (true)
+  {
+    s_queue_cv.wait(lk, [] { return s_exit_thread || !s_queue.empty(); });
+    if (s_queue.empty())
+      return;
+
+    QueuedOperation* operation = s_queue.front();
+    s_queue.pop_front();
+    lk.unlock();
+    RunOperation(operation);
+    lk.lock();
+
+    operation->done = true;
+    --s_unfinished_operations;
+    s_done_cv.notify_all();
+  }
+}
+
+static void FinishOperation(u64 request_address, s64 cycles_late)
+{
+  std::unique_lock<std::mutex> lk(s_operations_mutex);
+  const auto it = s_operations.find(static_cast<u32>(request_address));
+  if (it == s_operations.end())
+    return;
+
+  s_done_cv.wait(lk, [&it] { return it->second.done; });
+  QueuedOperation operation = std::move(it->second);
+  s_operations.erase(it);
+  lk.unlock();
+
+  if (!operation.is_write && !operation.data.empty())
+    Memory::CopyToEmu(operation.buffer, operation.data.data(), operation.data.size());
+
+  if (EmulationKernel* ios = GetIOS())
+    ios->EnqueueIPCReply(Request{static_cast<u32>(request_address)}, operation.return_value);
+}
+
+void InitFileIOThread()
+{
+  s_event_finish_operation = CoreTiming::RegisterEvent("FileIOFinish", FinishOperation);
+
+  s_exit_thread = false;
+  s_thread = std::thread(OperationThread);
+}
+
+void ShutdownFileIOThread()
+{
+  CancelQueuedFileIO();
+
+  {
+    std::lock_guard<std::mutex> lk(s_operations_mutex);
+    s_exit_thread = true;
+  }
+  s_queue_cv.notify_all();
+  if (s_thread.joinable())
+    s_thread.join();
+}
+
+void FinishQueuedFileIO()
+{
+  std::unique_lock<std::mutex> lk(s_operations_mutex);
+  s_done_cv.wait(lk, [] { return s_unfinished_operations == 0; });
+
+  // Results are kept until their replies are due, but the files can be closed now.
+  for (auto& entry : s_operations)
+    entry.second.file.reset();
+}
+
+void CancelQueuedFileIO()
+{
+  FinishQueuedFileIO();
+
+  std::lock_guard<std::mutex> lk(s_operations_mutex);
+  s_operations.clear();
+  if (s_event_finish_operation)
+    CoreTiming::RemoveAllEvents(s_event_finish_operation);
+}
+
+void DoFileIOState(PointerWrap& p)
+{
+  FinishQueuedFileIO();
+
+  std::lock_guard<std::mutex> lk(s_operations_mutex);
+  u32 count = static_cast<u32>(s_operations.size());
+  p.Do(count);
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    s_operations.clear();
+    for (u32 i = 0; i < count; ++i)
+    {
+      u32 request_address = 0;
+      QueuedOperation operation;
+      p.Do(request_address);
+      p.Do(operation.buffer);
+      p.Do(operation.is_write);
+      p.Do(operation.data);
+      p.Do(operation.return_value);
+      operation.done = true;
+      s_operations.emplace(request_address, std::move(operation));
+    }
+  }
+  else
+  {
+    for (auto& entry : s_operations)
+    {
+      u32 request_address = entry.first;
+      p.Do(request_address);
+      p.Do(entry.second.buffer);
+      p.Do(entry.second.is_write);
+      p.Do(entry.second.data);
+      p.Do(entry.second.return_value);
+    }
+  }
+}
 
 // This is used by several of the FileIO and /dev/fs functions
 std::string BuildFilename(const std::string& wii_path)
@@ -145,27 +342,27 @@ void FileIO::OpenFile()
   {
     std::string path = m_name;
     // This code will be called when all references to the shared pointer below have been removed.
-    auto deleter = [path](File::IOFile* ptr) {
+    auto deleter = [path](OpenedFile* ptr) {
       delete ptr;             // IOFile's deconstructor closes the file.
       openFiles.erase(path);  // erase the weak pointer from the list of open files.
     };
 
     // All files are opened read/write. Actual access rights will be controlled per handle by the
     // read/write functions below
-    m_file = std::shared_ptr<File::IOFile>(new File::IOFile(m_filepath, "r+b"),
-                                           deleter);  // Use the custom deleter from above.
+    m_file = std::shared_ptr<OpenedFile>(new OpenedFile(m_filepath),
+                                         deleter);  // Use the custom deleter from above.
 
     // Store a weak pointer to our newly opened file in the cache.
-    openFiles[path] = std::weak_ptr<File::IOFile>(m_file);
+    openFiles[path] = std::weak_ptr<OpenedFile>(m_file);
   }
 }
 
 IPCCommandResult FileIO::Seek(const SeekRequest& request)
 {
-  if (!m_file->IsOpen())
+  if (!m_file->file.IsOpen())
     return GetDefaultReply(FS_ENOENT);
 
-  const u32 file_size = static_cast<u32>(m_file->GetSize());
+  const u32 file_size = m_file->size;
   DEBUG_LOG(IOS_FILEIO, "FileIO: Seek Pos: 0x%08x, Mode: %i (%s, Length=0x%08x)", request.offset,
             request.mode, m_name.c_str(), file_size);
 
@@ -197,7 +394,7 @@ IPCCommandResult FileIO::Seek(const SeekRequest& request)
 
 IPCCommandResult FileIO::Read(const ReadWriteRequest& request)
 {
-  if (!m_file->IsOpen())
+  if (!m_file->file.IsOpen())
   {
     ERROR_LOG(IOS_FILEIO, "Failed to read from %s (Addr=0x%08x Size=0x%x) - file could "
                           "not be opened or does not exist",
@@ -213,30 +410,20 @@ IPCCommandResult FileIO::Read(const ReadWriteRequest& request)
   }
 
   u32 requested_read_length = request.size;
-  const u32 file_size = static_cast<u32>(m_file->GetSize());
+  const u32 file_size = m_file->size;
   // IOS has this check in the read request handler.
   if (requested_read_length + m_SeekPos > file_size)
     requested_read_length = file_size - m_SeekPos;
 
   DEBUG_LOG(IOS_FILEIO, "Read 0x%x bytes to 0x%08x from %s", request.size, request.buffer,
             m_name.c_str());
-  m_file->Seek(m_SeekPos, SEEK_SET);  // File might be opened twice, need to seek before we read
-  const u32 number_of_bytes_read = static_cast<u32>(
-      fread(Memory::GetPointer(request.buffer), 1, requested_read_length, m_file->GetHandle()));
-
-  if (number_of_bytes_read != requested_read_length && ferror(m_file->GetHandle()))
-    return GetDefaultReply(FS_EACCESS);
-
-  // IOS returns the number of bytes read and adds that value to the seek position,
-  // instead of adding the *requested* read length.
-  m_SeekPos += number_of_bytes_read;
-  return GetDefaultReply(number_of_bytes_read);
+  return QueueOperation(request, false, std::vector<u8>(requested_read_length));
 }
 
 IPCCommandResult FileIO::Write(const ReadWriteRequest& request)
 {
   s32 return_value = FS_EACCESS;
-  if (m_file->IsOpen())
+  if (m_file->file.IsOpen())
   {
     if (m_Mode == IOS_OPEN_READ)
     {
@@ -248,13 +435,10 @@ IPCCommandResult FileIO::Write(const ReadWriteRequest& request)
     {
       DEBUG_LOG(IOS_FILEIO, "FileIO: Write 0x%04x bytes from 0x%08x to %s", request.size,
                 request.buffer, m_name.c_str());
-      m_file->Seek(m_SeekPos,
-                   SEEK_SET);  // File might be opened twice, need to seek before we write
-      if (m_file->WriteBytes(Memory::GetPointer(request.buffer), request.size))
-      {
-        return_value = request.size;
-        m_SeekPos += request.size;
-      }
+      std::vector<u8> data(request.size);
+      Memory::CopyFromEmu(data.data(), request.buffer, request.size);
+      m_ios.GetFS()->InvalidateCache();
+      return QueueOperation(request, true, std::move(data));
     }
   }
   else
@@ -308,15 +492,50 @@ void FileIO::DoState(PointerWrap& p)
 
 IPCCommandResult FileIO::GetFileStats(const IOCtlRequest& request)
 {
-  if (!m_file->IsOpen())
+  if (!m_file->file.IsOpen())
     return GetDefaultReply(FS_ENOENT);
 
-  DEBUG_LOG(IOS_FILEIO, "File: %s, Length: %" PRIu64 ", Pos: %u", m_name.c_str(), m_file->GetSize(),
-            m_SeekPos);
-  Memory::Write_U32(static_cast<u32>(m_file->GetSize()), request.buffer_out);
+  DEBUG_LOG(IOS_FILEIO, "File: %s, Length: %u, Pos: %u", m_name.c_str(), m_file->size, m_SeekPos);
+  Memory::Write_U32(m_file->size, request.buffer_out);
   Memory::Write_U32(m_SeekPos, request.buffer_out + 4);
   return GetDefaultReply(IPC_SUCCESS);
 }
+
+// The seek position and the cached file size are updated right away, as if the host succeeds,
+// so that later requests on this file don't have to wait for this one.
+IPCCommandResult FileIO::QueueOperation(const ReadWriteRequest& request, bool is_write,
+                                        std::vector<u8> data)
+{
+  QueuedOperation operation;
+  operation.file = m_file;
+  operation.offset = m_SeekPos;
+  operation.buffer = request.buffer;
+  operation.is_write = is_write;
+  operation.data = std::move(data);
+
+  m_SeekPos += static_cast<u32>(operation.data.size());
+  if (is_write)
+    m_file->size = std::max(m_file->size, m_SeekPos);
+
+  {
+    std::unique_lock<std::mutex> lk(s_operations_mutex);
+    // Games can't reuse a request before it's replied to, but don't pull the operation out from
+    // under the worker if one does.
+    s_done_cv.wait(lk, [&request] {
+      const auto it = s_operations.find(request.address);
+      return it == s_operations.end() || it->second.done;
+    });
+
+    QueuedOperation& queued = s_operations[request.address] = std::move(operation);
+    s_queue.push_back(&queued);
+    ++s_unfinished_operations;
+  }
+  s_queue_cv.notify_one();
+
+  CoreTiming::ScheduleEvent(static_cast<int>(GetDefaultReply(IPC_SUCCESS).reply_delay_ticks),
+                            s_event_finish_operation, request.address);
+  return GetNoReply();
+}
 }  // namespace Device
 }  // namespace HLE
 }  // namespace IOS
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -13,18 +15,26 @@
 
 class PointerWrap;
 
-namespace File
-{
-class IOFile;
-}
-
 namespace IOS
 {
 namespace HLE
 {
+struct OpenedFile;
+
 std::string BuildFilename(const std::string& wii_path);
 void CreateVirtualFATFilesystem();
 
+// Reads and writes of FileIO devices are done on a worker thread, which is started and stopped
+// together with the emulated IOS.
+void InitFileIOThread();
+void ShutdownFileIOThread();
+// Waits for the queued reads and writes to be done. Must be called on the CPU thread before
+// anything other than a FileIO device accesses the files of the emulated NAND.
+void FinishQueuedFileIO();
+// Drops the queued reads and writes without replying to them, for when IOS is reloaded.
+void CancelQueuedFileIO();
+void DoFileIOState(PointerWrap& p);
+
 namespace Device
 {
 class FileIO : public Device
@@ -71,12 +81,14 @@ private:
   };
 
   IPCCommandResult GetFileStats(const IOCtlRequest& request);
+  IPCCommandResult QueueOperation(const ReadWriteRequest& request, bool is_write,
+                                  std::vector<u8> data);
 
   u32 m_Mode = 0;
   u32 m_SeekPos = 0;
 
   std::string m_filepath;
-  std::shared_ptr<File::IOFile> m_file;
+  std::shared_ptr<OpenedFile> m_file;
 };
 }  // namespace Device
 }  // namespace HLE
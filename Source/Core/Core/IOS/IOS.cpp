@@ -18,6 +18,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Core/Boot/DolReader.h"
 #include "Core/CommonTitles.h"
 #include "Core/ConfigManager.h"
@@ -230,6 +231,7 @@ EmulationKernel::EmulationKernel(u64 title_id) : Kernel(title_id)
 
 EmulationKernel::~EmulationKernel()
 {
+  CancelQueuedFileIO();
   CoreTiming::RemoveAllEvents(s_event_enqueue);
 }
 
@@ -474,7 +476,9 @@ IPCCommandResult Kernel::HandleIPCCommand(const Request& request)
 void Kernel::ExecuteIPCCommand(const u32 address)
 {
   Request request{address};
+  TRACE_EVENT(IPCRequestBegin, address, request.command);
   IPCCommandResult result = HandleIPCCommand(request);
+  TRACE_EVENT(IPCRequestEnd, address, request.command);
 
   if (!result.send_reply)
     return;
@@ -542,6 +546,7 @@ void Kernel::UpdateIPC()
 
   if (m_reply_queue.size())
   {
+    TRACE_EVENT(IPCReply, m_reply_queue.front(), 0);
     GenerateReply(m_reply_queue.front());
     DEBUG_LOG(IOS, "<<-- Reply to IPC Request @ 0x%08x", m_reply_queue.front());
     m_reply_queue.pop_front();
@@ -598,6 +603,8 @@ void Kernel::DoState(PointerWrap& p)
   if (m_title_id == Titles::MIOS)
     return;
 
+  DoFileIOState(p);
+
   // We need to make sure all file handles are closed so IOS::HLE::Device::FS::DoState can
   // successfully save or re-create /tmp
   for (auto& descriptor : m_fdmap)
@@ -685,6 +692,8 @@ void Init()
       device->EventNotify();
   });
 
+  InitFileIOThread();
+
   // Start with IOS80 to simulate part of the Wii boot process.
   s_ios = std::make_unique<EmulationKernel>(Titles::SYSTEM_MENU_IOS);
   // On a Wii, boot2 launches the system menu IOS, which then launches the system menu
@@ -698,6 +707,7 @@ void Init()
 void Shutdown()
 {
   s_ios.reset();
+  ShutdownFileIOThread();
 }
 
 EmulationKernel* GetIOS()
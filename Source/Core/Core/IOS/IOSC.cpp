@@ -14,11 +14,11 @@
 
 #include <mbedtls/md.h>
 #include <mbedtls/rsa.h>
-#include <mbedtls/sha1.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Crypto/AES.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/Crypto/ec.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
@@ -163,8 +163,8 @@ ReturnCode IOSC::ComputeSharedKey(Handle dest_handle, Handle private_handle, Han
   std::array<u8, 0x3c> shared_secret;
   point_mul(shared_secret.data(), private_entry->data.data(), public_entry->data.data());
 
-  std::array<u8, 20> sha1;
-  mbedtls_sha1(shared_secret.data(), shared_secret.size() / 2, sha1.data());
+  const Common::SHA1::Digest sha1 =
+      Common::SHA1::CalculateDigest(shared_secret.data(), shared_secret.size() / 2);
 
   dest_entry->data.resize(AES128_KEY_SIZE);
   std::copy_n(sha1.cbegin(), AES128_KEY_SIZE, dest_entry->data.begin());
@@ -317,8 +317,8 @@ ReturnCode IOSC::ImportCertificate(const u8* cert, Handle signer_handle, Handle
   if (ret != IPC_SUCCESS)
     return ret;
 
-  std::array<u8, 20> sha1;
-  mbedtls_sha1(cert + parameters.offset, parameters.size, sha1.data());
+  const Common::SHA1::Digest sha1 =
+      Common::SHA1::CalculateDigest(cert + parameters.offset, parameters.size);
 
   if (VerifyPublicKeySign(sha1, signer_handle, cert + parameters.signature_offset, pid) !=
       IPC_SUCCESS)
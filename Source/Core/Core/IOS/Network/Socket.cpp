@@ -203,11 +203,40 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
   return ret;
 }
 
+bool WiiSocket::IsWaitingForData(const sockop& op) const
+{
+  // Only receiving is skipped while the host socket has nothing to read. Connecting has to be
+  // attempted at least once before the socket can become writable, and an operation that should
+  // behave as non-blocking has to be answered right away.
+  if (nonBlock || op.is_ssl)
+    return false;
+
+  if (op.request.command == IPC_CMD_IOCTL)
+    return op.net_type == IOCTL_SO_ACCEPT;
+
+  if (op.request.command == IPC_CMD_IOCTLV && op.net_type == IOCTLV_SO_RECVFROM)
+  {
+    const IOCtlVRequest ioctlv{op.request.address};
+    if (ioctlv.in_vectors.empty())
+      return false;
+    const u32 flags = Memory::Read_U32(ioctlv.in_vectors[0].address + 0x04);
+    return (flags & SO_MSG_NONBLOCK) != SO_MSG_NONBLOCK;
+  }
+
+  return false;
+}
+
 void WiiSocket::Update(bool read, bool write, bool except)
 {
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
+    if (!read && !except && IsWaitingForData(*it))
+    {
+      ++it;
+      continue;
+    }
+
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
     IPCCommandType ct = it->request.command;
@@ -696,10 +725,15 @@ void WiiSockMan::Update()
     WiiSocket& sock = socket_iter->second;
     if (sock.IsValid())
     {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
+      // Sockets without pending operations have nothing to be woken up for, so the (usually
+      // many) idle ones are left out of the select call.
+      if (sock.HasPendingOperations())
+      {
+        FD_SET(sock.fd, &read_fds);
+        FD_SET(sock.fd, &write_fds);
+        FD_SET(sock.fd, &except_fds);
+        nfds = std::max(nfds, sock.fd + 1);
+      }
       ++socket_iter;
     }
     else
@@ -708,22 +742,27 @@ void WiiSockMan::Update()
       socket_iter = WiiSockets.erase(socket_iter);
     }
   }
+
+  if (nfds == 0)
+    return;
+
   s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
 
-  if (ret >= 0)
+  for (auto& pair : WiiSockets)
   {
-    for (auto& pair : WiiSockets)
+    WiiSocket& sock = pair.second;
+    if (!sock.HasPendingOperations())
+      continue;
+
+    // If select failed, every operation is attempted, as the host socket call reports the error.
+    if (ret >= 0)
     {
-      WiiSocket& sock = pair.second;
       sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
                   FD_ISSET(sock.fd, &except_fds) != 0);
     }
-  }
-  else
-  {
-    for (auto& elem : WiiSockets)
+    else
     {
-      elem.second.Update(false, false, false);
+      sock.Update(true, true, true);
     }
   }
 }
@@ -199,7 +199,10 @@ private:
 
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
+  // Operations which only wait for incoming data are skipped unless read or except is set.
   void Update(bool read, bool write, bool except);
+  bool IsWaitingForData(const sockop& op) const;
+  bool HasPendingOperations() const { return !pending_sockops.empty(); }
   bool IsValid() const { return fd >= 0; }
 public:
   WiiSocket() : fd(-1), nonBlock(false) {}
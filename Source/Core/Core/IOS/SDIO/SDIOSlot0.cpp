@@ -4,6 +4,8 @@
 
 #include "Core/IOS/SDIO/SDIOSlot0.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <cstdio>
 #include <cstring>
 #include <memory>
@@ -15,6 +17,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/SDCardUtil.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/IOS.h"
@@ -50,9 +53,16 @@ SDIOSlot0::SDIOSlot0(Kernel& ios, const std::string& device_name)
 {
 }
 
+SDIOSlot0::~SDIOSlot0()
+{
+  FlushCard();
+}
+
 void SDIOSlot0::DoState(PointerWrap& p)
 {
   DoStateShared(p);
+  // The card image isn't part of the state, so make it current on disk before the state is saved.
+  FlushCard();
   if (p.GetMode() == PointerWrap::MODE_READ)
   {
     OpenInternal();
@@ -81,6 +91,10 @@ void SDIOSlot0::EventNotify()
 
 void SDIOSlot0::OpenInternal()
 {
+  FlushCard();
+  for (CachedChunk& chunk : m_cache)
+    chunk = CachedChunk();
+
   const std::string filename = File::GetUserPath(F_WIISDCARD_IDX);
   m_card.Open(filename, "r+b");
   if (!m_card)
@@ -97,6 +111,118 @@ void SDIOSlot0::OpenInternal()
                         "from a read-only directory?");
     }
   }
+  m_card_size = m_card ? m_card.GetSize() : 0;
+  m_last_flush_time = Common::Timer::GetTimeMs();
+}
+
+bool SDIOSlot0::ReadCard(u64 address, u8* buffer, u32 size)
+{
+  if (address + size > m_card_size)
+    return false;
+
+  while (size != 0)
+  {
+    CachedChunk* chunk = GetCachedChunk(address / CACHE_CHUNK_SIZE, true);
+    if (!chunk)
+      return false;
+    const u64 offset = address % CACHE_CHUNK_SIZE;
+    const u32 copy_size = static_cast<u32>(std::min<u64>(size, chunk->data.size() - offset));
+    std::memcpy(buffer, chunk->data.data() + offset, copy_size);
+    address += copy_size;
+    buffer += copy_size;
+    size -= copy_size;
+  }
+
+  if (Common::Timer::GetTimeMs() - m_last_flush_time >= CACHE_FLUSH_INTERVAL_MS)
+    FlushCard();
+  return true;
+}
+
+bool SDIOSlot0::WriteCard(u64 address, const u8* buffer, u32 size)
+{
+  if (address + size > m_card_size)
+  {
+    // This grows the image, which the cache doesn't handle.
+    FlushCard();
+    for (CachedChunk& chunk : m_cache)
+      chunk = CachedChunk();
+    const bool success = m_card.Seek(address, SEEK_SET) && m_card.WriteBytes(buffer, size);
+    m_card_size = m_card.GetSize();
+    return success;
+  }
+
+  while (size != 0)
+  {
+    const u64 offset = address % CACHE_CHUNK_SIZE;
+    // Chunks that are overwritten entirely don't need to be read first.
+    const bool whole_chunk =
+        offset == 0 && size >= std::min(CACHE_CHUNK_SIZE, m_card_size - address);
+    CachedChunk* chunk = GetCachedChunk(address / CACHE_CHUNK_SIZE, !whole_chunk);
+    if (!chunk)
+      return false;
+    const u32 copy_size = static_cast<u32>(std::min<u64>(size, chunk->data.size() - offset));
+    std::memcpy(chunk->data.data() + offset, buffer, copy_size);
+    chunk->dirty = true;
+    address += copy_size;
+    buffer += copy_size;
+    size -= copy_size;
+  }
+
+  if (Common::Timer::GetTimeMs() - m_last_flush_time >= CACHE_FLUSH_INTERVAL_MS)
+    FlushCard();
+  return true;
+}
+
+SDIOSlot0::CachedChunk* SDIOSlot0::GetCachedChunk(u64 index, bool load)
+{
+  CachedChunk& chunk = m_cache[index % m_cache.size()];
+  if (chunk.index == index)
+    return &chunk;
+
+  if (chunk.dirty && !WriteBackChunk(chunk))
+    return nullptr;
+
+  const u64 address = index * CACHE_CHUNK_SIZE;
+  chunk.index = UINT64_MAX;
+  chunk.data.resize(static_cast<size_t>(std::min(CACHE_CHUNK_SIZE, m_card_size - address)));
+  if (load && (!m_card.Seek(address, SEEK_SET) ||
+               !m_card.ReadBytes(chunk.data.data(), chunk.data.size())))
+  {
+    ERROR_LOG(IOS_SD, "Read Failed - error: %i, eof: %i", ferror(m_card.GetHandle()),
+              feof(m_card.GetHandle()));
+    return nullptr;
+  }
+  chunk.index = index;
+  return &chunk;
+}
+
+bool SDIOSlot0::WriteBackChunk(CachedChunk& chunk)
+{
+  if (!m_card.Seek(chunk.index * CACHE_CHUNK_SIZE, SEEK_SET) ||
+      !m_card.WriteBytes(chunk.data.data(), chunk.data.size()))
+  {
+    ERROR_LOG(IOS_SD, "Write Failed - error: %i, eof: %i", ferror(m_card.GetHandle()),
+              feof(m_card.GetHandle()));
+    return false;
+  }
+  chunk.dirty = false;
+  return true;
+}
+
+void SDIOSlot0::FlushCard()
+{
+  m_last_flush_time = Common::Timer::GetTimeMs();
+  if (!m_card)
+    return;
+
+  bool wrote = false;
+  for (CachedChunk& chunk : m_cache)
+  {
+    if (chunk.dirty)
+      wrote |= WriteBackChunk(chunk);
+  }
+  if (wrote)
+    m_card.Flush();
 }
 
 ReturnCode SDIOSlot0::Open(const OpenRequest& request)
@@ -111,6 +237,7 @@ ReturnCode SDIOSlot0::Open(const OpenRequest& request)
 
 ReturnCode SDIOSlot0::Close(u32 fd)
 {
+  FlushCard();
   m_card.Close();
   m_block_length = 0;
   m_bus_width = 0;
@@ -271,17 +398,13 @@ s32 SDIOSlot0::ExecuteCommand(const Request& request, u32 _BufferIn, u32 _Buffer
       u32 size = req.bsize * req.blocks;
       u64 address = GetAddressFromRequest(req.arg);
 
-      if (!m_card.Seek(address, SEEK_SET))
-        ERROR_LOG(IOS_SD, "Seek failed WTF");
-
-      if (m_card.ReadBytes(Memory::GetPointer(req.addr), size))
+      if (ReadCard(address, Memory::GetPointer(req.addr), size))
       {
         DEBUG_LOG(IOS_SD, "Outbuffer size %i got %i", _rwBufferSize, size);
       }
       else
       {
-        ERROR_LOG(IOS_SD, "Read Failed - error: %i, eof: %i", ferror(m_card.GetHandle()),
-                  feof(m_card.GetHandle()));
+        ERROR_LOG(IOS_SD, "Failed to read %u bytes at 0x%" PRIx64, size, address);
         ret = RET_FAIL;
       }
     }
@@ -301,13 +424,9 @@ s32 SDIOSlot0::ExecuteCommand(const Request& request, u32 _BufferIn, u32 _Buffer
       u32 size = req.bsize * req.blocks;
       u64 address = GetAddressFromRequest(req.arg);
 
-      if (!m_card.Seek(address, SEEK_SET))
-        ERROR_LOG(IOS_SD, "fseeko failed WTF");
-
-      if (!m_card.WriteBytes(Memory::GetPointer(req.addr), size))
+      if (!WriteCard(address, Memory::GetPointer(req.addr), size))
       {
-        ERROR_LOG(IOS_SD, "Write Failed - error: %i, eof: %i", ferror(m_card.GetHandle()),
-                  feof(m_card.GetHandle()));
+        ERROR_LOG(IOS_SD, "Failed to write %u bytes at 0x%" PRIx64, size, address);
         ret = RET_FAIL;
       }
     }
@@ -439,7 +558,7 @@ IPCCommandResult SDIOSlot0::GetStatus(const IOCtlRequest& request)
   // Since IOS does the SD initialization itself, we just say we're always initialized.
   if (m_card)
   {
-    if (m_card.GetSize() < SDHC_BYTES)
+    if (m_card_size < SDHC_BYTES)
     {
       // No further initialization required.
       m_status |= CARD_INITIALIZED;
@@ -505,7 +624,7 @@ u32 SDIOSlot0::GetOCRegister() const
 
 std::array<u32, 4> SDIOSlot0::GetCSDv1() const
 {
-  u64 size = m_card.GetSize();
+  u64 size = m_card_size;
 
   // 2048 bytes/sector
   // We could make this dynamic to support a wider range of file sizes
@@ -587,7 +706,7 @@ std::array<u32, 4> SDIOSlot0::GetCSDv1() const
 
 std::array<u32, 4> SDIOSlot0::GetCSDv2() const
 {
-  const u64 size = m_card.GetSize();
+  const u64 size = m_card_size;
 
   if (size % (512 * 1024) != 0)
     WARN_LOG(IOS_SD, "SDHC Card size cannot be divided by 1024 * 512");
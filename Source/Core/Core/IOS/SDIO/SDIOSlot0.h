@@ -8,6 +8,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
@@ -27,6 +28,7 @@ class SDIOSlot0 : public Device
 {
 public:
   SDIOSlot0(Kernel& ios, const std::string& device_name);
+  ~SDIOSlot0() override;
 
   void DoState(PointerWrap& p) override;
 
@@ -121,6 +123,21 @@ private:
   // Number of bytes to trigger using SDHC instead of SDSC
   static constexpr u32 SDHC_BYTES = 0x80000000;
 
+  // The card image is accessed through a cache of chunks this large, because titles mostly read
+  // and write it a few blocks at a time.
+  static constexpr u64 CACHE_CHUNK_SIZE = 0x10000;
+  static constexpr size_t CACHE_CHUNKS = 32;
+  // Written chunks are written back on the first access this long after the last write back, when
+  // they are evicted and when the card is closed.
+  static constexpr u32 CACHE_FLUSH_INTERVAL_MS = 1000;
+
+  struct CachedChunk
+  {
+    u64 index = UINT64_MAX;
+    bool dirty = false;
+    std::vector<u8> data;
+  };
+
   struct Event
   {
     Event(EventType type_, Request request_) : type(type_), request(request_) {}
@@ -151,6 +168,12 @@ private:
 
   u64 GetAddressFromRequest(u32 arg) const;
 
+  bool ReadCard(u64 address, u8* buffer, u32 size);
+  bool WriteCard(u64 address, const u8* buffer, u32 size);
+  CachedChunk* GetCachedChunk(u64 index, bool load);
+  bool WriteBackChunk(CachedChunk& chunk);
+  void FlushCard();
+
   // TODO: do we need more than one?
   std::unique_ptr<Event> m_event;
 
@@ -167,6 +190,9 @@ private:
   std::array<u32, 0x200 / sizeof(u32)> m_registers;
 
   File::IOFile m_card;
+  u64 m_card_size = 0;
+  std::array<CachedChunk, CACHE_CHUNKS> m_cache;
+  u32 m_last_flush_time = 0;
 };
 }  // namespace Device
 }  // namespace HLE
@@ -250,7 +250,10 @@ IPCCommandResult BluetoothReal::IOCtlV(const IOCtlVRequest& request)
         return GetNoReply();
       }
     }
-    auto buffer = cmd->MakeBuffer(cmd->length);
+    // Incoming data overwrites the buffer anyway, so only outgoing data is copied from the guest.
+    auto buffer = GetTransferBuffer(cmd->length);
+    if (!(cmd->endpoint & LIBUSB_ENDPOINT_IN))
+      Memory::CopyFromEmu(buffer.get(), cmd->data_address, cmd->length);
     libusb_transfer* transfer = libusb_alloc_transfer(0);
     transfer->buffer = buffer.get();
     transfer->callback = [](libusb_transfer* tr) {
@@ -679,12 +682,36 @@ void BluetoothReal::HandleBulkOrIntrTransfer(libusb_transfer* tr)
     }
   }
 
-  const auto& command = m_current_transfers.at(tr).command;
-  command->FillBuffer(tr->buffer, tr->actual_length);
+  auto& pending_transfer = m_current_transfers.at(tr);
+  const auto& command = pending_transfer.command;
+  if (tr->endpoint & LIBUSB_ENDPOINT_IN)
+    command->FillBuffer(tr->buffer, tr->actual_length);
   m_ios.EnqueueIPCReply(command->ios_request, tr->actual_length, 0,
                         CoreTiming::FromThread::NON_CPU);
+  ReleaseTransferBuffer(std::move(pending_transfer.buffer), tr->length);
   m_current_transfers.erase(tr);
 }
+
+// Needs m_transfers_mutex to be locked.
+std::unique_ptr<u8[]> BluetoothReal::GetTransferBuffer(u32 size)
+{
+  if (size > POOLED_BUFFER_SIZE)
+    return std::make_unique<u8[]>(size);
+
+  if (m_buffer_pool.empty())
+    return std::make_unique<u8[]>(POOLED_BUFFER_SIZE);
+
+  std::unique_ptr<u8[]> buffer = std::move(m_buffer_pool.back());
+  m_buffer_pool.pop_back();
+  return buffer;
+}
+
+// Needs m_transfers_mutex to be locked.
+void BluetoothReal::ReleaseTransferBuffer(std::unique_ptr<u8[]> buffer, u32 size)
+{
+  if (size <= POOLED_BUFFER_SIZE)
+    m_buffer_pool.push_back(std::move(buffer));
+}
 }  // namespace Device
 }  // namespace HLE
 }  // namespace IOS
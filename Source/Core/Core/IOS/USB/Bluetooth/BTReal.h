@@ -12,6 +12,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
@@ -93,6 +94,13 @@ private:
   };
   std::map<libusb_transfer*, PendingTransfer> m_current_transfers;
 
+  // There is a bulk or interrupt transfer for every HCI event and ACL packet, so their buffers
+  // are reused. Transfers which are larger than this get a buffer of their own.
+  static constexpr u32 POOLED_BUFFER_SIZE = 1024;
+  std::vector<std::unique_ptr<u8[]>> m_buffer_pool;
+  std::unique_ptr<u8[]> GetTransferBuffer(u32 size);
+  void ReleaseTransferBuffer(std::unique_ptr<u8[]> buffer, u32 size);
+
   // Set when we received a command to which we need to fake a reply
   Common::Flag m_fake_read_buffer_size_reply;
   Common::Flag m_fake_vendor_command_reply;
@@ -18,6 +18,7 @@
 
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
@@ -28,6 +29,9 @@ namespace HLE
 {
 namespace USB
 {
+// How many isochronous IN transfers are kept in flight ahead of the guest's.
+constexpr size_t NUM_ISO_READ_AHEAD = 2;
+
 LibusbDevice::LibusbDevice(Kernel& ios, libusb_device* device,
                            const libusb_device_descriptor& descriptor)
     : m_ios(ios), m_device(device)
@@ -45,6 +49,19 @@ LibusbDevice::LibusbDevice(Kernel& ios, libusb_device* device,
 
 LibusbDevice::~LibusbDevice()
 {
+  // The callbacks of the cancelled read-ahead transfers still need this device, so give the event
+  // thread some time to run them.
+  StopReadAhead();
+  for (int i = 0; i < 100; ++i)
+  {
+    if (std::none_of(m_transfer_endpoints.begin(), m_transfer_endpoints.end(),
+                     [](auto& endpoint) { return endpoint.second.HasPendingReadAhead(); }))
+    {
+      break;
+    }
+    Common::SleepCurrentThread(10);
+  }
+
   if (m_device_attached)
     DetachInterface();
   if (m_handle != nullptr)
@@ -167,6 +184,7 @@ int LibusbDevice::ChangeInterface(const u8 interface)
 
   INFO_LOG(IOS_USB, "[%04x:%04x %d] Changing interface to %d", m_vid, m_pid, m_active_interface,
            interface);
+  StopReadAhead();
   const int ret = DetachInterface();
   if (ret < 0)
     return ret;
@@ -180,6 +198,7 @@ int LibusbDevice::SetAltSetting(const u8 alt_setting)
 
   INFO_LOG(IOS_USB, "[%04x:%04x %d] Setting alt setting %d", m_vid, m_pid, m_active_interface,
            alt_setting);
+  StopReadAhead();
   return libusb_set_interface_alt_setting(m_handle, m_active_interface, alt_setting);
 }
 
@@ -262,6 +281,26 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
   if (!m_device_attached)
     return LIBUSB_ERROR_NOT_FOUND;
 
+  const bool read_ahead = (cmd->endpoint & LIBUSB_ENDPOINT_IN) != 0;
+  if (read_ahead)
+  {
+    TransferEndpoint& endpoint = m_transfer_endpoints[cmd->endpoint];
+    if (libusb_transfer* completed = endpoint.TakeReadAhead(cmd, m_handle, this))
+    {
+      endpoint.HandleTransfer(completed, [&](const auto& taken_cmd) {
+        return GetTransferResult(completed, taken_cmd);
+      });
+      return LIBUSB_SUCCESS;
+    }
+    // The command now waits for a read-ahead transfer which is still in flight.
+    if (!cmd)
+      return LIBUSB_SUCCESS;
+  }
+
+  const u8 endpoint = cmd->endpoint;
+  std::vector<u16> packet_sizes = cmd->packet_sizes;
+  const u16 length = cmd->length;
+
   libusb_transfer* transfer = libusb_alloc_transfer(cmd->num_packets);
   transfer->buffer = cmd->MakeBuffer(cmd->length).release();
   transfer->callback = TransferCallback;
@@ -276,7 +315,13 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
   transfer->type = LIBUSB_TRANSFER_TYPE_ISOCHRONOUS;
   transfer->user_data = this;
   m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  const int ret = libusb_submit_transfer(transfer);
+  if (ret == LIBUSB_SUCCESS && read_ahead)
+  {
+    m_transfer_endpoints[endpoint].StartReadAhead(endpoint, std::move(packet_sizes), length,
+                                                  m_handle, this);
+  }
+  return ret;
 }
 
 void LibusbDevice::CtrlTransferCallback(libusb_transfer* transfer)
@@ -289,27 +334,41 @@ void LibusbDevice::CtrlTransferCallback(libusb_transfer* transfer)
   });
 }
 
+s32 LibusbDevice::GetTransferResult(libusb_transfer* transfer, const TransferCommand& cmd)
+{
+  switch (transfer->type)
+  {
+  case LIBUSB_TRANSFER_TYPE_ISOCHRONOUS:
+  {
+    auto& iso_msg = static_cast<const IsoMessage&>(cmd);
+    cmd.FillBuffer(transfer->buffer, iso_msg.length);
+    for (size_t i = 0; i < iso_msg.num_packets; ++i)
+      iso_msg.SetPacketReturnValue(i, transfer->iso_packet_desc[i].actual_length);
+    // Note: isochronous transfers *must* return 0 as the return value. Anything else
+    // (such as the number of bytes transferred) is considered as a failure.
+    return static_cast<s32>(IPC_SUCCESS);
+  }
+  default:
+    cmd.FillBuffer(transfer->buffer, transfer->actual_length);
+    return static_cast<s32>(transfer->actual_length);
+  }
+}
+
 void LibusbDevice::TransferCallback(libusb_transfer* transfer)
 {
   auto* device = static_cast<LibusbDevice*>(transfer->user_data);
-  device->m_transfer_endpoints[transfer->endpoint].HandleTransfer(transfer, [&](const auto& cmd) {
-    switch (transfer->type)
-    {
-    case LIBUSB_TRANSFER_TYPE_ISOCHRONOUS:
-    {
-      auto& iso_msg = static_cast<const IsoMessage&>(cmd);
-      cmd.FillBuffer(transfer->buffer, iso_msg.length);
-      for (size_t i = 0; i < iso_msg.num_packets; ++i)
-        iso_msg.SetPacketReturnValue(i, transfer->iso_packet_desc[i].actual_length);
-      // Note: isochronous transfers *must* return 0 as the return value. Anything else
-      // (such as the number of bytes transferred) is considered as a failure.
-      return static_cast<s32>(IPC_SUCCESS);
-    }
-    default:
-      cmd.FillBuffer(transfer->buffer, transfer->actual_length);
-      return static_cast<s32>(transfer->actual_length);
-    }
-  });
+  TransferEndpoint& endpoint = device->m_transfer_endpoints[transfer->endpoint];
+  if (endpoint.HandleReadAhead(transfer))
+    return;
+
+  endpoint.HandleTransfer(
+      transfer, [&](const auto& cmd) { return GetTransferResult(transfer, cmd); });
+}
+
+void LibusbDevice::StopReadAhead()
+{
+  for (auto& endpoint : m_transfer_endpoints)
+    endpoint.second.StopReadAhead();
 }
 
 static const std::map<u8, const char*> s_transfer_types = {
@@ -362,11 +421,17 @@ void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
   }
   cmd.OnTransferComplete(return_value);
   m_transfers.erase(transfer);
+
+  // Read-ahead transfers are freed here instead of by libusb, since they may have to outlive
+  // their callback until the guest asks for them.
+  if (!(transfer->flags & LIBUSB_TRANSFER_FREE_TRANSFER))
+    libusb_free_transfer(transfer);
 }
 
 void LibusbDevice::TransferEndpoint::CancelTransfers()
 {
   std::lock_guard<std::mutex> lk(m_transfers_mutex);
+  StopReadAheadLockNeeded();
   if (m_transfers.empty())
     return;
   INFO_LOG(IOS_USB, "Cancelling %ld transfer(s)", m_transfers.size());
@@ -374,6 +439,122 @@ void LibusbDevice::TransferEndpoint::CancelTransfers()
     libusb_cancel_transfer(pending_transfer.first);
 }
 
+libusb_transfer* LibusbDevice::TransferEndpoint::TakeReadAhead(std::unique_ptr<IsoMessage>& cmd,
+                                                              libusb_device_handle* handle,
+                                                              void* user_data)
+{
+  std::lock_guard<std::mutex> lk{m_transfers_mutex};
+  if (m_read_ahead.empty() || cmd->packet_sizes != m_read_ahead_packet_sizes ||
+      cmd->length != m_read_ahead_length)
+  {
+    StopReadAheadLockNeeded();
+    return nullptr;
+  }
+
+  const ReadAheadTransfer read_ahead = m_read_ahead.front();
+  m_read_ahead.pop_front();
+  m_transfers.emplace(read_ahead.transfer, std::move(cmd));
+  SubmitReadAhead(handle, user_data);
+  return read_ahead.completed ? read_ahead.transfer : nullptr;
+}
+
+void LibusbDevice::TransferEndpoint::StartReadAhead(u8 endpoint, std::vector<u16> packet_sizes,
+                                                    u16 length, libusb_device_handle* handle,
+                                                    void* user_data)
+{
+  std::lock_guard<std::mutex> lk{m_transfers_mutex};
+  StopReadAheadLockNeeded();
+  m_read_ahead_endpoint = endpoint;
+  m_read_ahead_packet_sizes = std::move(packet_sizes);
+  m_read_ahead_length = length;
+  SubmitReadAhead(handle, user_data);
+}
+
+void LibusbDevice::TransferEndpoint::SubmitReadAhead(libusb_device_handle* handle,
+                                                     void* user_data)
+{
+  const int num_packets = static_cast<int>(m_read_ahead_packet_sizes.size());
+  while (m_read_ahead.size() < NUM_ISO_READ_AHEAD)
+  {
+    libusb_transfer* transfer = libusb_alloc_transfer(num_packets);
+    transfer->buffer = std::make_unique<u8[]>(m_read_ahead_length).release();
+    transfer->callback = TransferCallback;
+    transfer->dev_handle = handle;
+    transfer->endpoint = m_read_ahead_endpoint;
+    for (int i = 0; i < num_packets; ++i)
+      transfer->iso_packet_desc[i].length = m_read_ahead_packet_sizes[i];
+    transfer->length = m_read_ahead_length;
+    transfer->num_iso_packets = num_packets;
+    transfer->timeout = 0;
+    transfer->type = LIBUSB_TRANSFER_TYPE_ISOCHRONOUS;
+    transfer->user_data = user_data;
+    if (libusb_submit_transfer(transfer) != LIBUSB_SUCCESS)
+    {
+      delete[] transfer->buffer;
+      libusb_free_transfer(transfer);
+      break;
+    }
+    m_read_ahead.push_back({transfer, false});
+  }
+}
+
+void LibusbDevice::TransferEndpoint::StopReadAhead()
+{
+  std::lock_guard<std::mutex> lk{m_transfers_mutex};
+  StopReadAheadLockNeeded();
+}
+
+void LibusbDevice::TransferEndpoint::StopReadAheadLockNeeded()
+{
+  for (const ReadAheadTransfer& read_ahead : m_read_ahead)
+  {
+    if (read_ahead.completed)
+    {
+      delete[] read_ahead.transfer->buffer;
+      libusb_free_transfer(read_ahead.transfer);
+    }
+    else
+    {
+      // Freed by HandleReadAhead once the cancellation has gone through.
+      libusb_cancel_transfer(read_ahead.transfer);
+      m_cancelled_read_ahead.push_back(read_ahead.transfer);
+    }
+  }
+  m_read_ahead.clear();
+}
+
+bool LibusbDevice::TransferEndpoint::HandleReadAhead(libusb_transfer* transfer)
+{
+  std::lock_guard<std::mutex> lk{m_transfers_mutex};
+  const auto read_ahead =
+      std::find_if(m_read_ahead.begin(), m_read_ahead.end(),
+                   [transfer](const auto& entry) { return entry.transfer == transfer; });
+  if (read_ahead != m_read_ahead.end())
+  {
+    // Kept until the guest asks for it.
+    read_ahead->completed = true;
+    return true;
+  }
+
+  const auto cancelled =
+      std::find(m_cancelled_read_ahead.begin(), m_cancelled_read_ahead.end(), transfer);
+  if (cancelled != m_cancelled_read_ahead.end())
+  {
+    m_cancelled_read_ahead.erase(cancelled);
+    delete[] transfer->buffer;
+    libusb_free_transfer(transfer);
+    return true;
+  }
+
+  return false;
+}
+
+bool LibusbDevice::TransferEndpoint::HasPendingReadAhead()
+{
+  std::lock_guard<std::mutex> lk{m_transfers_mutex};
+  return !m_read_ahead.empty() || !m_cancelled_read_ahead.empty();
+}
+
 int LibusbDevice::GetNumberOfAltSettings(const u8 interface_number)
 {
   return m_config_descriptors[0]->Get()->interface[interface_number].num_altsetting;
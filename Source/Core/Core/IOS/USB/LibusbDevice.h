@@ -6,6 +6,7 @@
 
 #if defined(__LIBUSB__)
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -80,13 +81,45 @@ private:
     void HandleTransfer(libusb_transfer* tr, std::function<s32(const TransferCommand&)> function);
     void CancelTransfers();
 
+    // Isochronous IN transfers are submitted ahead of the guest, so that what the device sends
+    // while the guest is still busy with its previous transfer isn't lost.
+    //
+    // Hands the oldest read-ahead transfer over to the command if it has the same packet sizes.
+    // The returned transfer has already completed and must be handled by the caller. Returns
+    // nullptr otherwise, in which case cmd is left alone if it couldn't be taken.
+    libusb_transfer* TakeReadAhead(std::unique_ptr<IsoMessage>& cmd, libusb_device_handle* handle,
+                                   void* user_data);
+    // Starts reading ahead with the given packet sizes.
+    void StartReadAhead(u8 endpoint, std::vector<u16> packet_sizes, u16 length,
+                        libusb_device_handle* handle, void* user_data);
+    void StopReadAhead();
+    // Returns whether the transfer was a read-ahead one, which is then taken care of.
+    bool HandleReadAhead(libusb_transfer* transfer);
+    bool HasPendingReadAhead();
+
   private:
+    void SubmitReadAhead(libusb_device_handle* handle, void* user_data);
+    void StopReadAheadLockNeeded();
+
+    struct ReadAheadTransfer
+    {
+      libusb_transfer* transfer;
+      bool completed;
+    };
+
     std::mutex m_transfers_mutex;
     std::map<libusb_transfer*, std::unique_ptr<TransferCommand>> m_transfers;
+    std::deque<ReadAheadTransfer> m_read_ahead;
+    std::vector<libusb_transfer*> m_cancelled_read_ahead;
+    std::vector<u16> m_read_ahead_packet_sizes;
+    u16 m_read_ahead_length = 0;
+    u8 m_read_ahead_endpoint = 0;
   };
   std::map<u8, TransferEndpoint> m_transfer_endpoints;
   static void CtrlTransferCallback(libusb_transfer* transfer);
   static void TransferCallback(libusb_transfer* transfer);
+  static s32 GetTransferResult(libusb_transfer* transfer, const TransferCommand& cmd);
+  void StopReadAhead();
 
   int AttachInterface(u8 interface);
   int DetachInterface();
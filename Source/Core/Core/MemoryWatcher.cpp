@@ -2,13 +2,17 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <fcntl.h>
 #include <fstream>
-#include <iostream>
 #include <memory>
+#include <new>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
@@ -42,18 +46,17 @@ MemoryWatcher::MemoryWatcher()
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
-    return;
-  m_running = true;
+  const bool socket_open = OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX));
+  const bool shared_open = OpenSharedMemory(File::GetUserPath(F_MEMORYWATCHERVALUES_IDX));
+  m_running = socket_open || shared_open;
 }
 
 MemoryWatcher::~MemoryWatcher()
 {
-  if (!m_running)
-    return;
-
   m_running = false;
-  close(m_fd);
+  if (m_fd >= 0)
+    close(m_fd);
+  CloseSharedMemory();
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -66,19 +69,28 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return m_values.size() > 0;
+  return m_watches.size() > 0;
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  // Every address is only watched once.
+  if (std::any_of(m_watches.begin(), m_watches.end(),
+                  [&line](const Watch& watch) { return watch.line == line; }))
+  {
+    return;
+  }
+
+  Watch watch;
+  watch.line = line;
 
   std::stringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
+
+  m_watches.push_back(std::move(watch));
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -91,19 +103,63 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  const size_t size = sizeof(SharedHeader) + m_watches.size() * sizeof(u32);
+
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return false;
+
+  void* memory = MAP_FAILED;
+  if (ftruncate(fd, size) == 0)
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the file descriptor is closed.
+  close(fd);
+  if (memory == MAP_FAILED)
+    return false;
+
+  m_shared_size = size;
+  m_shared = new (memory) SharedHeader();
+  m_shared->magic = SHARED_MAGIC;
+  m_shared->version = SHARED_VERSION;
+  m_shared->num_values = static_cast<u32>(m_watches.size());
+  m_shared->padding = 0;
+  m_shared->sequence.store(0, std::memory_order_relaxed);
+  m_shared_values = reinterpret_cast<u32*>(m_shared + 1);
+  std::fill_n(m_shared_values, m_watches.size(), 0);
+  return true;
+}
+
+void MemoryWatcher::CloseSharedMemory()
+{
+  if (!m_shared)
+    return;
+
+  m_shared->~SharedHeader();
+  munmap(m_shared, m_shared_size);
+  m_shared = nullptr;
+  m_shared_values = nullptr;
+}
+
+u32 MemoryWatcher::ChasePointer(const Watch& watch)
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
     value = Memory::Read_U32(value + offset);
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessage(const std::string& line, u32 value)
+void MemoryWatcher::SendMessage(const Watch& watch)
 {
-  std::stringstream message_stream;
-  message_stream << line << '\n' << std::hex << value;
-  return message_stream.str();
+  if (m_fd < 0)
+    return;
+
+  m_message = watch.line;
+  m_message += '\n';
+  m_message += StringFromFormat("%x", watch.value);
+  sendto(m_fd, m_message.c_str(), m_message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+         sizeof(m_addr));
 }
 
 void MemoryWatcher::Step()
@@ -111,19 +167,28 @@ void MemoryWatcher::Step()
   if (!m_running)
     return;
 
-  for (auto& entry : m_values)
+  bool changed = false;
+  for (size_t i = 0; i < m_watches.size(); ++i)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    Watch& watch = m_watches[i];
+    const u32 new_value = ChasePointer(watch);
+    if (new_value == watch.value)
+      continue;
 
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    if (!changed && m_shared)
     {
-      // Update the value
-      current_value = new_value;
-      std::string message = ComposeMessage(address, new_value);
-      sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-             sizeof(m_addr));
+      m_shared->sequence.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
     }
+    changed = true;
+
+    // Update the value
+    watch.value = new_value;
+    if (m_shared)
+      m_shared_values[i] = new_value;
+    SendMessage(watch);
   }
+
+  if (changed && m_shared)
+    m_shared->sequence.fetch_add(1, std::memory_order_release);
 }
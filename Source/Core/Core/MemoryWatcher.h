@@ -4,11 +4,15 @@
 
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <cstddef>
+#include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
@@ -17,9 +21,28 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// All values are also written to a file in the same directory, which other processes can map
+// into their memory to read them without going through the socket. It starts with a
+// SharedHeader, followed by one u32 for every line of the input file, in the same order and in
+// host byte order.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 SHARED_MAGIC = 0x574D4C44;  // "DLMW"
+  static constexpr u32 SHARED_VERSION = 1;
+
+  struct SharedHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 num_values;
+    u32 padding;
+    // Incremented before and after the values are updated, so it is odd while they are written.
+    // Readers should read it, copy the values, and retry if it was odd or has changed since.
+    std::atomic<u64> sequence;
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step();
@@ -28,20 +51,33 @@ public:
   static void Shutdown();
 
 private:
+  struct Watch
+  {
+    // Address as stored in the file
+    std::string line;
+    // The offsets to follow
+    std::vector<u32> offsets;
+    u32 value = 0;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
+  void CloseSharedMemory();
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
-  std::string ComposeMessage(const std::string& line, u32 value);
+  static u32 ChasePointer(const Watch& watch);
+  void SendMessage(const Watch& watch);
 
   bool m_running;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr;
+  std::string m_message;
+
+  std::vector<Watch> m_watches;
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  SharedHeader* m_shared = nullptr;
+  u32* m_shared_values = nullptr;
+  size_t m_shared_size = 0;
 };
@@ -7,6 +7,9 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cinttypes>
+#include <condition_variable>
+#include <deque>
 #include <iomanip>
 #include <iterator>
 #include <mbedtls/config.h>
@@ -17,6 +20,7 @@
 #include <utility>
 #include <variant>
 #include <vector>
+#include <xxhash.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -27,6 +31,7 @@
 #include "Common/Hash.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 
 #include "Core/Boot/Boot.h"
@@ -40,6 +45,7 @@
 #include "Core/HW/CPU.h"
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/Wiimote.h"
@@ -102,7 +108,29 @@ static WiiManipFunction s_wii_manip_func;
 
 static std::string s_current_file_name;
 
+// While recording, the input is also appended to a file in the background, along with an updated
+// header, so that a crash doesn't lose the whole recording.
+struct BackupWrite
+{
+  DTMHeader header;
+  u64 offset;
+  std::vector<u8> data;
+};
+static const u32 BACKUP_INTERVAL_MS = 1000;
+static std::mutex s_backup_mutex;
+static std::condition_variable s_backup_cv;
+static std::deque<BackupWrite> s_backup_queue;
+static std::thread s_backup_thread;
+static bool s_backup_exit = false;
+static u64 s_backed_up_bytes = 0;
+static u32 s_last_backup_time = 0;
+
+static File::IOFile s_ram_hash_log;
+static u32 s_ram_hash_interval = 1;
+static u64 s_field_count = 0;
+
 static void GetSettings();
+static void BackUpRecording(bool force);
 static bool IsMovieHeader(u8 magic[4])
 {
   return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
@@ -200,6 +228,30 @@ void FrameUpdate()
   s_bPolled = false;
 }
 
+void FieldEnd()
+{
+  if (!s_ram_hash_log)
+    return;
+
+  if (++s_field_count % s_ram_hash_interval != 0)
+    return;
+
+  u64 hash = XXH64(Memory::m_pRAM, Memory::RAM_SIZE, 0);
+  if (SConfig::GetInstance().bWii)
+    hash = XXH64(Memory::m_pEXRAM, Memory::EXRAM_SIZE, hash);
+  const std::string line = StringFromFormat("%" PRIu64 " %016" PRIx64 "\n", s_field_count, hash);
+  s_ram_hash_log.WriteBytes(line.data(), line.size());
+}
+
+void SetRAMHashLog(const std::string& path, u32 interval)
+{
+  s_ram_hash_log.Close();
+  s_ram_hash_interval = std::max<u32>(interval, 1);
+  s_field_count = 0;
+  if (!path.empty() && !s_ram_hash_log.Open(path, "w"))
+    PanicAlertT("Failed to open the RAM hash log %s.", path.c_str());
+}
+
 static void CheckMD5();
 static void GetMD5();
 
@@ -559,6 +611,7 @@ bool BeginRecordingInput(int controllers)
     s_temp_input.clear();
 
     s_currentByte = 0;
+    s_backed_up_bytes = 0;
 
     if (Core::IsRunning())
       Core::UpdateWantDeterminism();
@@ -824,6 +877,8 @@ void RecordInput(GCPadStatus* PadStatus, int controllerID)
   s_temp_input.resize(s_currentByte + sizeof(ControllerState));
   memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
+
+  BackUpRecording(false);
 }
 
 // NOTE: CPU Thread
@@ -846,6 +901,8 @@ void RecordWiimote(int wiimote, u8* data, u8 size)
   s_temp_input[s_currentByte++] = size;
   memcpy(&s_temp_input[s_currentByte], data, size);
   s_currentByte += size;
+
+  BackUpRecording(false);
 }
 
 // NOTE: EmuThread / Host Thread
@@ -944,6 +1001,9 @@ void DoState(PointerWrap& p)
 // NOTE: Host Thread
 void LoadInput(const std::string& filename)
 {
+  // The input before the current position can change too, so the backup is written anew.
+  s_backed_up_bytes = 0;
+
   File::IOFile t_record;
   if (!t_record.Open(filename, "r+b"))
   {
@@ -1305,11 +1365,8 @@ void EndPlayInput(bool cont)
   }
 }
 
-// NOTE: Save State + Host Thread
-void SaveRecording(const std::string& filename)
+static DTMHeader CreateHeader()
 {
-  File::IOFile save_record(filename, "wb");
-  // Create the real header now and write it
   DTMHeader header;
   memset(&header, 0, sizeof(DTMHeader));
 
@@ -1346,6 +1403,88 @@ void SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
+  return header;
+}
+
+static void BackupThread()
+{
+  Common::SetCurrentThreadName("Movie Backup");
+
+  const std::string filename = File::GetUserPath(D_STATESAVES_IDX) + "recording.dtm";
+  File::IOFile file;
+  std::unique_lock<std::mutex> lk(s_backup_mutex);
+  while (true)
+  {
+    s_backup_cv.wait(lk, [] { return s_backup_exit || !s_backup_queue.empty(); });
+    if (s_backup_queue.empty())
+      return;
+
+    BackupWrite write = std::move(s_backup_queue.front());
+    s_backup_queue.pop_front();
+    lk.unlock();
+
+    // Writes from the start replace the file, since the input may have changed after a
+    // savestate was loaded.
+    if (write.offset == 0 || !file.IsOpen())
+      file.Open(filename, "wb");
+
+    const u64 end = sizeof(DTMHeader) + write.offset + write.data.size();
+    file.Seek(sizeof(DTMHeader) + write.offset, SEEK_SET);
+    file.WriteBytes(write.data.data(), write.data.size());
+    file.Resize(end);
+    file.Seek(0, SEEK_SET);
+    file.WriteArray(&write.header, 1);
+    file.Flush();
+
+    lk.lock();
+  }
+}
+
+// NOTE: CPU Thread
+static void BackUpRecording(bool force)
+{
+  const u32 now = Common::Timer::GetTimeMs();
+  if (!force && now - s_last_backup_time < BACKUP_INTERVAL_MS)
+    return;
+  s_last_backup_time = now;
+
+  if (s_backed_up_bytes > s_currentByte)
+    s_backed_up_bytes = 0;
+
+  BackupWrite write;
+  write.header = CreateHeader();
+  write.offset = s_backed_up_bytes;
+  write.data.assign(s_temp_input.begin() + s_backed_up_bytes,
+                    s_temp_input.begin() + std::min<u64>(s_currentByte, s_temp_input.size()));
+  s_backed_up_bytes += write.data.size();
+
+  std::lock_guard<std::mutex> lk(s_backup_mutex);
+  if (!s_backup_thread.joinable())
+  {
+    s_backup_exit = false;
+    s_backup_thread = std::thread(BackupThread);
+  }
+  s_backup_queue.push_back(std::move(write));
+  s_backup_cv.notify_one();
+}
+
+static void StopBackupThread()
+{
+  {
+    std::lock_guard<std::mutex> lk(s_backup_mutex);
+    s_backup_exit = true;
+    s_backup_cv.notify_one();
+  }
+  if (s_backup_thread.joinable())
+    s_backup_thread.join();
+}
+
+// NOTE: Save State + Host Thread
+void SaveRecording(const std::string& filename)
+{
+  File::IOFile save_record(filename, "wb");
+  // Create the real header now and write it
+  const DTMHeader header = CreateHeader();
   save_record.WriteArray(&header, 1);
 
   bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size());
@@ -1498,6 +1637,11 @@ static void GetMD5()
 // NOTE: EmuThread
 void Shutdown()
 {
+  if (IsRecordingInput())
+    BackUpRecording(true);
+  StopBackupThread();
+  s_backed_up_bytes = 0;
+
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
   s_temp_input.clear();
 }
@@ -112,6 +112,8 @@ static_assert(sizeof(DTMHeader) == 256, "DTMHeader should be 256 bytes");
 
 void FrameUpdate();
 void InputUpdate();
+// Called on the CPU thread at the end of every VI field.
+void FieldEnd();
 void Init(const BootParameters& boot);
 
 void SetPolledDevice();
@@ -169,6 +171,11 @@ void CheckPadStatus(GCPadStatus* PadStatus, int controllerID);
 void CheckWiimoteStatus(int wiimote, u8* data, const struct WiimoteEmu::ReportFeatures& rptf,
                         int ext, const wiimote_key key);
 
+// Writes the field number and a hash of emulated RAM to a text file every interval fields, so
+// that the logs of two runs of a movie can be compared to find where they desynced.
+// An empty path stops the logging.
+void SetRAMHashLog(const std::string& path, u32 interval);
+
 std::string GetInputDisplay();
 std::string GetRTCDisplay();
 
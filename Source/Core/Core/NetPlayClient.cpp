@@ -5,6 +5,7 @@
 #include "Core/NetPlayClient.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <mutex>
@@ -17,6 +18,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/ENetUtil.h"
+#include "Common/FileUtil.h"
 #include "Common/MD5.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
@@ -36,6 +38,8 @@
 
 static std::mutex crit_netplay_client;
 static NetPlayClient* netplay_client = nullptr;
+// Waiting for inputs for longer than this is reported on the OSD as a stall.
+static constexpr u32 STALL_THRESHOLD_MS = 20;
 NetSettings g_NetPlaySettings;
 
 // called from ---GUI--- thread
@@ -321,14 +325,13 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 
   case NP_MSG_PAD_DATA:
   {
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-        pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
+    PadStateList pads;
+    if (!NetPlay::ReadPadStates(packet, &pads, &m_received_pad_history))
+      break;
 
-    // Trusting server for good map value (>=0 && <4)
-    // add to pad buffer
-    m_pad_buffer.at(map).Push(pad);
+    // add to pad buffers
+    for (const auto& entry : pads)
+      m_pad_buffer[entry.first].Push(entry.second);
     m_gc_pad_event.Set();
   }
   break;
@@ -491,6 +494,19 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
   }
   break;
 
+  case NP_MSG_MEMCARD_HASH:
+  {
+    PlayerId pid;
+    std::array<u32, 2> hashes;
+    packet >> pid >> hashes[0] >> hashes[1];
+
+    std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
+    m_remote_memcard_hashes[pid] = hashes;
+    if (m_memcard_hashes_ready)
+      CompareMemcardHashes(pid, hashes);
+  }
+  break;
+
   case NP_MSG_SYNC_GC_SRAM:
   {
     u8 sram[sizeof(g_SRAM.p_SRAM)];
@@ -581,6 +597,19 @@ void NetPlayClient::DisplayPlayersPing()
                        OSD::Color::CYAN);
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::DisplayStall(u32 stall_ms)
+{
+  ++m_stall_count;
+  if (!g_ActiveConfig.bShowNetPlayMessages)
+    return;
+
+  OSD::AddTypedMessage(OSD::MessageType::NetPlayStall,
+                       StringFromFormat("Waited %u ms for inputs (%u stalls, buffer %u)", stall_ms,
+                                        m_stall_count, m_target_buffer_size),
+                       OSD::Duration::NORMAL, OSD::Color::RED);
+}
+
 u32 NetPlayClient::GetPlayersMaxPing() const
 {
   return std::max_element(
@@ -745,17 +774,68 @@ void NetPlayClient::SendChatMessage(const std::string& msg)
 }
 
 // called from ---CPU--- thread
-void NetPlayClient::SendPadState(const int in_game_pad, const GCPadStatus& pad)
+void NetPlayClient::SendPadStates(const PadStateList& pads)
 {
   sf::Packet packet;
   packet << static_cast<MessageId>(NP_MSG_PAD_DATA);
-  packet << static_cast<PadMapping>(in_game_pad);
-  packet << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-         << pad.substickY << pad.triggerLeft << pad.triggerRight;
+  NetPlay::WritePadStates(packet, pads, &m_sent_pad_history);
 
   SendAsync(std::move(packet));
 }
 
+// called from ---GUI--- thread
+void NetPlayClient::SendMemcardHashes()
+{
+  // Instead of transferring the memory cards, which would hold up the start of the game, every
+  // player's cards are compared by hash so that differences can be pointed out.
+  const std::array<std::string, 2> paths = {
+      {SConfig::GetInstance().m_strMemoryCardA, SConfig::GetInstance().m_strMemoryCardB}};
+  std::array<u32, 2> hashes{};
+  for (size_t slot = 0; slot < paths.size(); ++slot)
+  {
+    // Zero for slots without a raw memory card or with an unreadable one.
+    if (g_NetPlaySettings.m_EXIDevice[slot] != ExpansionInterface::EXIDEVICE_MEMORYCARD)
+      continue;
+
+    std::string data;
+    if (File::ReadFileToString(paths[slot], data))
+    {
+      std::array<u8, 16> md5;
+      mbedtls_md5(reinterpret_cast<const u8*>(data.data()), data.size(), md5.data());
+      std::memcpy(&hashes[slot], md5.data(), sizeof(u32));
+    }
+  }
+
+  sf::Packet packet;
+  packet << static_cast<MessageId>(NP_MSG_MEMCARD_HASH);
+  packet << hashes[0] << hashes[1];
+
+  SendAsync(std::move(packet));
+
+  std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
+  m_memcard_hashes = hashes;
+  m_memcard_hashes_ready = true;
+  for (const auto& entry : m_remote_memcard_hashes)
+    CompareMemcardHashes(entry.first, entry.second);
+}
+
+void NetPlayClient::CompareMemcardHashes(PlayerId pid, const std::array<u32, 2>& hashes)
+{
+  const auto it = m_players.find(pid);
+  if (it == m_players.end())
+    return;
+
+  for (size_t slot = 0; slot < hashes.size(); ++slot)
+  {
+    if (hashes[slot] != m_memcard_hashes[slot])
+    {
+      m_dialog->AppendChat(StringFromFormat(
+          "The memory card in slot %c of %s differs from yours. This may cause desyncs.",
+          'A' + static_cast<char>(slot), it->second.name.c_str()));
+    }
+  }
+}
+
 // called from ---CPU--- thread
 void NetPlayClient::SendWiimoteState(const int in_game_pad, const NetWiimote& nw)
 {
@@ -803,6 +883,9 @@ bool NetPlayClient::StartGame(const std::string& path)
   }
 
   m_timebase_frame = 0;
+  m_stall_count = 0;
+
+  SendMemcardHashes();
 
   m_is_running.Set();
   NetPlay_Enable(this);
@@ -889,6 +972,9 @@ void NetPlayClient::ClearBuffers()
     while (m_wiimote_buffer[i].Size())
       m_wiimote_buffer[i].Pop();
   }
+
+  NetPlay::ResetPadStatusHistory(&m_sent_pad_history);
+  NetPlay::ResetPadStatusHistory(&m_received_pad_history);
 }
 
 // called from ---NETPLAY--- thread
@@ -966,6 +1052,8 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
   // clients.
   if (IsFirstInGamePad(pad_nb))
   {
+    // All of the states are sent to the server in one message.
+    PadStateList sent_pads;
     const int num_local_pads = NumLocalPads();
     for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
     {
@@ -989,14 +1077,17 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
         // add to buffer
         m_pad_buffer[ingame_pad].Push(*pad_status);
 
-        // send
-        SendPadState(ingame_pad, *pad_status);
+        sent_pads.emplace_back(static_cast<PadMapping>(ingame_pad), *pad_status);
       }
     }
+
+    if (!sent_pads.empty())
+      SendPadStates(sent_pads);
   }
 
   // Now, we either use the data pushed earlier, or wait for the
   // other clients to send it to us
+  const u32 wait_start = Common::Timer::GetTimeMs();
   while (m_pad_buffer[pad_nb].Size() == 0)
   {
     if (!m_is_running.IsSet())
@@ -1007,6 +1098,10 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
     m_gc_pad_event.Wait();
   }
 
+  const u32 stall_ms = Common::Timer::GetTimeMs() - wait_start;
+  if (stall_ms >= STALL_THRESHOLD_MS)
+    DisplayStall(stall_ms);
+
   m_pad_buffer[pad_nb].Pop(*pad_status);
 
   if (Movie::IsRecordingInput())
@@ -1101,6 +1196,12 @@ bool NetPlayClient::StopGame()
 {
   m_is_running.Clear();
 
+  {
+    std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
+    m_memcard_hashes_ready = false;
+    m_remote_memcard_hashes.clear();
+  }
+
   // stop waiting for input
   m_gc_pad_event.Set();
   m_wii_pad_event.Set();
@@ -1331,6 +1432,83 @@ bool NetPlay::IsNetPlayRunning()
   return netplay_client != nullptr;
 }
 
+void NetPlay::ResetPadStatusHistory(PadStatusHistory* history)
+{
+  history->fill(GCPadStatus{});
+}
+
+// Calls function with each field of GCPadStatus that is sent, and the same field of previous,
+// in the order of the bits of the change mask.
+template <typename Function>
+static void ForEachPadField(GCPadStatus& pad, const GCPadStatus& previous, Function function)
+{
+  function(pad.button, previous.button);
+  function(pad.analogA, previous.analogA);
+  function(pad.analogB, previous.analogB);
+  function(pad.stickX, previous.stickX);
+  function(pad.stickY, previous.stickY);
+  function(pad.substickX, previous.substickX);
+  function(pad.substickY, previous.substickY);
+  function(pad.triggerLeft, previous.triggerLeft);
+  function(pad.triggerRight, previous.triggerRight);
+}
+
+void NetPlay::WritePadStates(sf::Packet& packet, const PadStateList& pads,
+                             PadStatusHistory* history)
+{
+  packet << static_cast<u8>(pads.size());
+  for (const auto& entry : pads)
+  {
+    GCPadStatus& previous = history->at(entry.first);
+    GCPadStatus pad = entry.second;
+
+    u16 changed = 0;
+    int bit = 0;
+    ForEachPadField(pad, previous, [&](auto& field, const auto& previous_field) {
+      if (field != previous_field)
+        changed |= 1 << bit;
+      ++bit;
+    });
+
+    packet << entry.first << changed;
+    bit = 0;
+    ForEachPadField(pad, previous, [&](auto& field, const auto&) {
+      if (changed & (1 << bit++))
+        packet << field;
+    });
+
+    previous = pad;
+  }
+}
+
+bool NetPlay::ReadPadStates(sf::Packet& packet, PadStateList* pads, PadStatusHistory* history)
+{
+  u8 count = 0;
+  packet >> count;
+  for (u8 i = 0; i < count; ++i)
+  {
+    PadMapping map = 0;
+    u16 changed = 0;
+    packet >> map >> changed;
+    if (!packet || map < 0 || map >= static_cast<PadMapping>(history->size()))
+      return false;
+
+    GCPadStatus pad = (*history)[map];
+    int bit = 0;
+    ForEachPadField(pad, pad, [&](auto& field, const auto&) {
+      if (changed & (1 << bit++))
+        packet >> field;
+    });
+    if (!packet)
+      return false;
+
+    (*history)[map] = pad;
+    pads->emplace_back(map, pad);
+  }
+
+  return true;
+}
+
 void NetPlay_Enable(NetPlayClient* const np)
 {
   std::lock_guard<std::mutex> lk(crit_netplay_client);
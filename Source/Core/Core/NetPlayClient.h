@@ -112,6 +112,8 @@ protected:
   Common::FifoQueue<sf::Packet, false> m_async_queue;
 
   std::array<Common::FifoQueue<GCPadStatus>, 4> m_pad_buffer;
+  NetPlay::PadStatusHistory m_sent_pad_history{};
+  NetPlay::PadStatusHistory m_received_pad_history{};
   std::array<Common::FifoQueue<NetWiimote>, 4> m_wiimote_buffer;
 
   NetPlayUI* m_dialog = nullptr;
@@ -152,7 +154,9 @@ private:
   void SendStopGamePacket();
 
   void UpdateDevices();
-  void SendPadState(int in_game_pad, const GCPadStatus& np);
+  void SendPadStates(const PadStateList& pads);
+  void SendMemcardHashes();
+  void CompareMemcardHashes(PlayerId pid, const std::array<u32, 2>& hashes);
   void SendWiimoteState(int in_game_pad, const NetWiimote& nw);
   unsigned int OnData(sf::Packet& packet);
   void Send(const sf::Packet& packet);
@@ -161,6 +165,7 @@ private:
   void ComputeMD5(const std::string& file_identifier);
   void DisplayPlayersPing();
   u32 GetPlayersMaxPing() const;
+  void DisplayStall(u32 stall_ms);
 
   bool m_is_connected = false;
   ConnectionState m_connection_state = ConnectionState::Failure;
@@ -175,6 +180,11 @@ private:
   bool m_should_compute_MD5 = false;
   Common::Event m_gc_pad_event;
   Common::Event m_wii_pad_event;
+  u32 m_stall_count = 0;
+  // The hashes of the other players' memory cards can arrive before ours are computed.
+  std::array<u32, 2> m_memcard_hashes{};
+  bool m_memcard_hashes_ready = false;
+  std::map<PlayerId, std::array<u32, 2>> m_remote_memcard_hashes;
 
   u32 m_timebase_frame = 0;
 };
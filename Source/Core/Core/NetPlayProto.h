@@ -5,9 +5,16 @@
 #pragma once
 
 #include <array>
+#include <utility>
 #include <vector>
 #include "Common/CommonTypes.h"
 #include "Core/HW/EXI/EXI_Device.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace sf
+{
+class Packet;
+}
 
 struct NetSettings
 {
@@ -87,6 +94,7 @@ enum
   NP_MSG_PLAYER_PING_DATA = 0xE2,
 
   NP_MSG_SYNC_GC_SRAM = 0xF0,
+  NP_MSG_MEMCARD_HASH = 0xF1,
 };
 
 enum
@@ -102,8 +110,20 @@ using PlayerId = u8;
 using FrameNum = u32;
 using PadMapping = s8;
 using PadMappingArray = std::array<PadMapping, 4>;
+using PadStateList = std::vector<std::pair<PadMapping, GCPadStatus>>;
 
 namespace NetPlay
 {
 bool IsNetPlayRunning();
+
+// NP_MSG_PAD_DATA carries all of the pad states a player has polled at once, for all of their
+// pads. Each state only contains the fields which differ from the previous state of the same
+// in-game pad. The sender, the server and every client keep track of those previous states in
+// a PadStatusHistory, which is reset when a game starts. Since all messages go through one
+// reliable and ordered channel, they all see the same states in the same order.
+using PadStatusHistory = std::array<GCPadStatus, 4>;
+void ResetPadStatusHistory(PadStatusHistory* history);
+void WritePadStates(sf::Packet& packet, const PadStateList& pads, PadStatusHistory* history);
+// Returns false if the message is malformed.
+bool ReadPadStates(sf::Packet& packet, PadStateList* pads, PadStatusHistory* history);
 }
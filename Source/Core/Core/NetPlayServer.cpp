@@ -37,6 +37,11 @@
 
 u64 g_netplay_initial_rtc = 1272737767;
 
+// How many pings of each player the automatic pad buffer looks at.
+static constexpr size_t PING_HISTORY_SIZE = 10;
+// How many ping rounds in a row the automatic pad buffer has to be too large before it shrinks.
+static constexpr u32 PAD_BUFFER_SHRINK_ROUNDS = 5;
+
 NetPlayServer::~NetPlayServer()
 {
   if (is_connected)
@@ -120,6 +125,9 @@ void NetPlayServer::ThreadFunc()
     // update pings every so many seconds
     if ((m_ping_timer.GetTimeElapsed() > 1000) || m_update_pings)
     {
+      if (m_automatic_pad_buffer)
+        UpdateAutomaticPadBuffer();
+
       m_ping_key = Common::Timer::GetTimeMs();
 
       sf::Packet spac;
@@ -474,6 +482,69 @@ void NetPlayServer::AdjustPadBufferSize(unsigned int size)
   SendAsyncToClients(std::move(spac));
 }
 
+// called from ---GUI--- thread
+void NetPlayServer::SetAutomaticPadBuffer(bool enabled)
+{
+  m_automatic_pad_buffer = enabled;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::UpdateAutomaticPadBuffer()
+{
+  std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
+  if (!m_is_running)
+    return;
+
+  // An input travels from one player through the server to another, which takes about as long
+  // as the largest ping. Inputs which arrive later than usual stall the game, so the ping of each
+  // player is taken as its average plus twice its jitter (the mean deviation from the average).
+  u32 latency = 0;
+  {
+    std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
+    for (const auto& player : m_players)
+    {
+      const std::deque<u32>& pings = player.second.ping_history;
+      if (pings.empty())
+        continue;
+
+      u64 sum = 0;
+      for (u32 ping : pings)
+        sum += ping;
+      const u32 average = static_cast<u32>(sum / pings.size());
+
+      u64 deviation_sum = 0;
+      for (u32 ping : pings)
+        deviation_sum += ping > average ? ping - average : average - ping;
+      const u32 jitter = static_cast<u32>(deviation_sum / pings.size());
+
+      latency = std::max(latency, average + 2 * jitter);
+    }
+  }
+
+  // The buffer has to cover the pad polls in that time, which happen about 120 times per second.
+  const unsigned int size = (latency * 120 + 999) / 1000 + 1;
+
+  // Grow right away to stop stalls, but only shrink once the smaller size has been enough for a
+  // while, so that the buffer doesn't keep changing.
+  if (size > m_target_buffer_size)
+  {
+    m_pad_buffer_shrink_rounds = 0;
+    AdjustPadBufferSize(size);
+  }
+  else if (size < m_target_buffer_size)
+  {
+    if (++m_pad_buffer_shrink_rounds >= PAD_BUFFER_SHRINK_ROUNDS)
+    {
+      m_pad_buffer_shrink_rounds = 0;
+      AdjustPadBufferSize(m_target_buffer_size - 1);
+    }
+  }
+  else
+  {
+    m_pad_buffer_shrink_rounds = 0;
+  }
+}
+
 void NetPlayServer::SendAsyncToClients(sf::Packet&& packet)
 {
   {
@@ -515,25 +586,20 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (player.current_game != m_current_game)
       break;
 
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-        pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
+    PadStateList pads;
+    if (!NetPlay::ReadPadStates(packet, &pads, &m_pad_history))
+      return 1;
 
     // If the data is not from the correct player,
     // then disconnect them.
-    if (m_pad_map.at(map) != player.pid)
+    for (const auto& entry : pads)
     {
-      return 1;
+      if (m_pad_map[entry.first] != player.pid)
+        return 1;
     }
 
-    // Relay to clients
-    sf::Packet spac;
-    spac << (MessageId)NP_MSG_PAD_DATA;
-    spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
-         << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight;
-
-    SendToClients(spac, player.pid);
+    // Relay to clients. The states are relative to the same previous states for them as for us.
+    SendToClients(packet, player.pid);
   }
   break;
 
@@ -578,6 +644,9 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (m_ping_key == ping_key)
     {
       player.ping = ping;
+      player.ping_history.push_back(ping);
+      if (player.ping_history.size() > PING_HISTORY_SIZE)
+        player.ping_history.pop_front();
     }
 
     sf::Packet spac;
@@ -672,6 +741,20 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case NP_MSG_MEMCARD_HASH:
+  {
+    std::array<u32, 2> hashes;
+    packet >> hashes[0] >> hashes[1];
+
+    // Relay to clients, which compare them with their own
+    sf::Packet spac;
+    spac << static_cast<MessageId>(NP_MSG_MEMCARD_HASH);
+    spac << player.pid << hashes[0] << hashes[1];
+
+    SendToClients(spac, player.pid);
+  }
+  break;
+
   case NP_MSG_MD5_PROGRESS:
   {
     int progress;
@@ -795,6 +878,7 @@ bool NetPlayServer::StartGame()
   m_desync_detected = false;
   std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
   m_current_game = Common::Timer::GetTimeMs();
+  NetPlay::ResetPadStatusHistory(&m_pad_history);
 
   // no change, just update with clients
   AdjustPadBufferSize(m_target_buffer_size);
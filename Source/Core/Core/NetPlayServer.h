@@ -5,6 +5,8 @@
 #pragma once
 
 #include <SFML/Network/Packet.hpp>
+#include <atomic>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -47,6 +49,8 @@ public:
   void SetWiimoteMapping(const PadMappingArray& mappings);
 
   void AdjustPadBufferSize(unsigned int size);
+  // Keeps the pad buffer as small as the pings of the players allow while a game is running.
+  void SetAutomaticPadBuffer(bool enabled);
 
   void KickPlayer(PlayerId player);
 
@@ -69,6 +73,8 @@ private:
 
     ENetPeer* socket;
     u32 ping;
+    // The most recent pings, which the automatic pad buffer uses to estimate jitter.
+    std::deque<u32> ping_history;
     u32 current_game;
 
     bool operator==(const Client& other) const { return this == &other; }
@@ -85,6 +91,7 @@ private:
   void OnConnectFailed(u8) override {}
   void UpdatePadMapping();
   void UpdateWiimoteMapping();
+  void UpdateAutomaticPadBuffer();
   std::vector<std::pair<std::string, std::string>> GetInterfaceListInternal() const;
 
   NetSettings m_settings;
@@ -96,7 +103,10 @@ private:
   bool m_update_pings = false;
   u32 m_current_game = 0;
   unsigned int m_target_buffer_size = 0;
+  std::atomic<bool> m_automatic_pad_buffer{false};
+  u32 m_pad_buffer_shrink_rounds = 0;
   PadMappingArray m_pad_map;
+  NetPlay::PadStatusHistory m_pad_history{};
   PadMappingArray m_wiimote_map;
 
   std::map<PlayerId, Client> m_players;
@@ -176,6 +176,7 @@ void MemChecks::Add(const TMemCheck& memory_check)
     bool had_any = HasAny();
     Core::RunAsCPUThread([&] {
       m_mem_checks.push_back(memory_check);
+      UpdateWatchedPages();
       // If this is the first one, clear the JIT cache so it can switch to
       // watchpoint-compatible code.
       if (!had_any && g_jit)
@@ -193,6 +194,7 @@ void MemChecks::Remove(u32 address)
     {
       Core::RunAsCPUThread([&] {
         m_mem_checks.erase(i);
+        UpdateWatchedPages();
         if (!HasAny() && g_jit)
           g_jit->ClearCache();
         PowerPC::DBATUpdated();
@@ -202,8 +204,32 @@ void MemChecks::Remove(u32 address)
   }
 }
 
+void MemChecks::Clear()
+{
+  m_mem_checks.clear();
+  m_watched_pages.reset();
+}
+
+void MemChecks::UpdateWatchedPages()
+{
+  m_watched_pages.reset();
+  for (const TMemCheck& mc : m_mem_checks)
+  {
+    const u32 first_page = mc.start_address >> WATCH_PAGE_SHIFT;
+    const u32 last_page = std::max(mc.start_address, mc.end_address) >> WATCH_PAGE_SHIFT;
+    for (u32 page = first_page; page <= last_page; ++page)
+      m_watched_pages[page] = true;
+  }
+}
+
 TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
 {
+  // Nearly all accesses are to pages without any memchecks, so reject those before walking the
+  // list. An access can't span more than two pages.
+  const u32 last_address = static_cast<u32>(address + size - 1);
+  if (!IsPageWatched(address) && !IsPageWatched(last_address))
+    return nullptr;
+
   for (TMemCheck& mc : m_mem_checks)
   {
     if (mc.end_address >= address && address + size - 1 >= mc.start_address)
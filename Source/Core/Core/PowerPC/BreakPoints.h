@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <bitset>
 #include <cstddef>
 #include <string>
 #include <vector>
@@ -91,10 +92,20 @@ public:
   bool OverlapsMemcheck(u32 address, u32 length);
   void Remove(u32 address);
 
-  void Clear() { m_mem_checks.clear(); }
+  // Whether any memcheck covers part of the 4 KiB page containing the address. Accesses to other
+  // pages can skip the checks altogether.
+  bool IsPageWatched(u32 address) const { return m_watched_pages[address >> WATCH_PAGE_SHIFT]; }
+
+  void Clear();
   bool HasAny() const { return !m_mem_checks.empty(); }
 private:
+  static constexpr u32 WATCH_PAGE_SHIFT = 12;
+  static constexpr size_t NUM_WATCH_PAGES = size_t{1} << (32 - WATCH_PAGE_SHIFT);
+
+  void UpdateWatchedPages();
+
   TMemChecks m_mem_checks;
+  std::bitset<NUM_WATCH_PAGES> m_watched_pages;
 };
 
 class Watches
@@ -4,8 +4,11 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <cstring>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Swap.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -31,10 +34,27 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  explicit Instruction(const CompareBranch* c)
+      : compare_branch(c), data(0), type(INSTRUCTION_TYPE_COMPARE_BRANCH)
+  {
+  }
+
+  // A block exit to exit_address, which jumps straight to the block there once it is linked.
+  static Instruction Link(u32 exit_address)
+  {
+    Instruction link;
+    link.link_target = nullptr;
+    link.data = exit_address;
+    link.type = INSTRUCTION_TYPE_LINK;
+    return link;
+  }
+
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const CompareBranch* const compare_branch;
+    const Instruction* link_target;
   };
   u32 data;
   enum
@@ -42,9 +62,22 @@ struct CachedInterpreter::Instruction
     INSTRUCTION_ABORT,
     INSTRUCTION_TYPE_COMMON,
     INSTRUCTION_TYPE_CONDITIONAL,
+    INSTRUCTION_TYPE_COMPARE_BRANCH,
+    INSTRUCTION_TYPE_LINK,
   } type;
 };
 
+// A compare immediately followed by a conditional branch on its result.
+struct CachedInterpreter::CompareBranch
+{
+  Interpreter::Instruction compare;
+  UGeckoInstruction compare_inst;
+  u32 condition_bit;
+  u32 condition_value;
+  u32 taken_address;
+  u32 not_taken_address;
+};
+
 CachedInterpreter::CachedInterpreter() : code_buffer(32000)
 {
 }
@@ -55,7 +88,7 @@ void CachedInterpreter::Init()
 {
   m_code.reserve(CODE_SIZE / sizeof(Instruction));
 
-  jo.enableBlocklink = false;
+  jo.enableBlocklink = !SConfig::GetInstance().bJITNoBlockLinking;
 
   m_block_cache.Init();
   UpdateMemoryOptions();
@@ -86,7 +119,7 @@ void CachedInterpreter::ExecuteOneBlock()
 
   const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
 
-  for (; code->type != Instruction::INSTRUCTION_ABORT; ++code)
+  while (code->type != Instruction::INSTRUCTION_ABORT)
   {
     switch (code->type)
     {
@@ -99,13 +132,42 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::INSTRUCTION_TYPE_COMPARE_BRANCH:
+    {
+      const CompareBranch& cb = *code->compare_branch;
+      cb.compare(cb.compare_inst);
+      if (GetCRBit(cb.condition_bit) == cb.condition_value)
+        NPC = cb.taken_address;
+      else
+        NPC = cb.not_taken_address;
+      break;
+    }
+
+    case Instruction::INSTRUCTION_TYPE_LINK:
+      if (code->link_target && PC == code->data)
+      {
+        code = code->link_target;
+        continue;
+      }
+      break;
+
     default:
       ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", code->type);
       break;
     }
+    ++code;
   }
 }
 
+void CachedInterpreter::WriteLink(u8* exit_ptr, const u8* entry)
+{
+  Instruction* link = reinterpret_cast<Instruction*>(exit_ptr);
+  link->link_target = reinterpret_cast<const Instruction*>(entry);
+}
+
+// Stepping must stop at the end of the block, so links are not followed while doing it.
+static bool s_single_stepping = false;
+
 void CachedInterpreter::Run()
 {
   while (CPU::GetState() == CPU::State::Running)
@@ -125,7 +187,9 @@ void CachedInterpreter::SingleStep()
 {
   // Enter new timing slice
   CoreTiming::Advance();
+  s_single_stepping = true;
   ExecuteOneBlock();
+  s_single_stepping = false;
 }
 
 static void EndBlock(UGeckoInstruction data)
@@ -169,6 +233,104 @@ static bool CheckDSI(u32 data)
   return false;
 }
 
+// Comes before the links of a block. Going on to a linked block is only allowed if the dispatcher
+// would have picked it as well, and the timing slice isn't over yet.
+static bool CheckLinks(u32 msr_bits)
+{
+  return s_single_stepping || PowerPC::ppcState.downcount <= 0 ||
+         (MSR & JitBaseBlockCache::JIT_CACHE_MSR_MASK) != msr_bits;
+}
+
+// Accesses which go to memory through a BAT don't need any of the checks the interpreter does.
+// Everything else falls back to the interpreter.
+template <typename T, Interpreter::Instruction fallback>
+static void LoadFast(UGeckoInstruction inst)
+{
+  const u32 address = (inst.RA ? rGPR[inst.RA] : 0) + inst.SIMM_16;
+  const u8* ptr = PowerPC::GetOptimizableRAMPointer(address, sizeof(T));
+  if (!ptr)
+  {
+    fallback(inst);
+    return;
+  }
+
+  T value;
+  std::memcpy(&value, ptr, sizeof(T));
+  rGPR[inst.RD] = Common::FromBigEndian(value);
+}
+
+template <typename T, Interpreter::Instruction fallback>
+static void StoreFast(UGeckoInstruction inst)
+{
+  const u32 address = (inst.RA ? rGPR[inst.RA] : 0) + inst.SIMM_16;
+  u8* ptr = PowerPC::GetOptimizableRAMPointer(address, sizeof(T));
+  if (!ptr)
+  {
+    fallback(inst);
+    return;
+  }
+
+  const T value = Common::FromBigEndian(static_cast<T>(rGPR[inst.RS]));
+  std::memcpy(ptr, &value, sizeof(T));
+}
+
+static Interpreter::Instruction GetFastInterpreterOp(UGeckoInstruction inst)
+{
+  switch (inst.OPCD)
+  {
+  case 32:
+    return LoadFast<u32, Interpreter::lwz>;
+  case 34:
+    return LoadFast<u8, Interpreter::lbz>;
+  case 40:
+    return LoadFast<u16, Interpreter::lhz>;
+  case 36:
+    return StoreFast<u32, Interpreter::stw>;
+  case 38:
+    return StoreFast<u8, Interpreter::stb>;
+  case 44:
+    return StoreFast<u16, Interpreter::sth>;
+  default:
+    return GetInterpreterOp(inst);
+  }
+}
+
+static bool IsCompare(UGeckoInstruction inst)
+{
+  return inst.OPCD == 10 || inst.OPCD == 11 ||
+         (inst.OPCD == 31 && (inst.SUBOP10 == 0 || inst.SUBOP10 == 32));
+}
+
+bool CachedInterpreter::CanFuseCompareBranch(const PPCAnalyst::CodeOp* ops, u32 index) const
+{
+  // Only a branch which ends the block, so that nothing else needs PC to be up to date.
+  if (index + 2 != code_block.m_num_instructions)
+    return false;
+
+  const PPCAnalyst::CodeOp& compare = ops[index];
+  const PPCAnalyst::CodeOp& branch = ops[index + 1];
+  if (compare.skip || branch.skip || !IsCompare(compare.inst))
+    return false;
+  if (HLE::GetFirstFunctionIndex(branch.address) != 0)
+    return false;
+
+  // A bc which only tests the bit of the CR field written by the compare. The interpreter looks
+  // for idle loops ending in "beq -8", so leave those alone.
+  const UGeckoInstruction bc = branch.inst;
+  return bc.OPCD == 16 && !bc.LK && (bc.BO & BO_DONT_DECREMENT_FLAG) && !(bc.BO & 0x10) &&
+         (bc.BI >> 2) == compare.inst.CRFD && bc.hex != 0x4182fff8;
+}
+
+void CachedInterpreter::WriteExits(JitBlock* b, const std::vector<u32>& exits)
+{
+  m_code.emplace_back(CheckLinks, b->msrBits);
+  for (u32 exit : exits)
+  {
+    m_code.push_back(Instruction::Link(exit));
+    b->linkData.push_back({reinterpret_cast<u8*>(&m_code.back()), exit, false, false});
+  }
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -202,6 +364,7 @@ void CachedInterpreter::Jit(u32 address)
   b->normalEntry = GetCodePtr();
   b->runCount = 0;
 
+  std::vector<u32> exits;
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     js.downcountAmount += ops[i].opinfo->numCycles;
@@ -240,20 +403,55 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
+      if (CanFuseCompareBranch(ops, i))
+      {
+        const PPCAnalyst::CodeOp& branch = ops[i + 1];
+        const u32 displacement = SignExt16(branch.inst.BD << 2);
+        const u32 target = branch.inst.AA ? displacement : branch.address + displacement;
+        m_compare_branches.push_back({GetInterpreterOp(ops[i].inst), ops[i].inst, branch.inst.BI,
+                                      (branch.inst.BO >> 3) & 1u, target, branch.address + 4});
+        m_code.emplace_back(&m_compare_branches.back());
+
+        i++;
+        js.downcountAmount += branch.opinfo->numCycles;
+        m_code.emplace_back(EndBlock, js.downcountAmount);
+        exits = {target, branch.address + 4};
+        break;
+      }
+
       if (endblock || memcheck)
         m_code.emplace_back(WritePC, ops[i].address);
-      m_code.emplace_back(GetInterpreterOp(ops[i].inst), ops[i].inst);
+      m_code.emplace_back(GetFastInterpreterOp(ops[i].inst), ops[i].inst);
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (endblock)
+      {
         m_code.emplace_back(EndBlock, js.downcountAmount);
+
+        // Where the block can go next, as far as we know it at this point.
+        const UGeckoInstruction inst = ops[i].inst;
+        if (inst.OPCD == 18)
+        {
+          const u32 displacement = SignExt26(inst.LI << 2);
+          exits.push_back(inst.AA ? displacement : ops[i].address + displacement);
+        }
+        else if (inst.OPCD == 16)
+        {
+          const u32 displacement = SignExt16(inst.BD << 2);
+          exits.push_back(inst.AA ? displacement : ops[i].address + displacement);
+          exits.push_back(ops[i].address + 4);
+        }
+      }
     }
   }
   if (code_block.m_broken)
   {
     m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
     m_code.emplace_back(EndBlock, js.downcountAmount);
+    exits = {nextPC};
   }
+  if (!exits.empty())
+    WriteExits(b, exits);
   m_code.emplace_back();
 
   b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
@@ -265,6 +463,7 @@ void CachedInterpreter::Jit(u32 address)
 void CachedInterpreter::ClearCache()
 {
   m_code.clear();
+  m_compare_branches.clear();
   m_block_cache.Clear();
   UpdateMemoryOptions();
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -31,13 +32,25 @@ public:
   JitBaseBlockCache* GetBlockCache() override { return &m_block_cache; }
   const char* GetName() override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
+  // Points the block link at exit_ptr to the given block entry, or unlinks it if entry is null.
+  static void WriteLink(u8* exit_ptr, const u8* entry);
+
 private:
   struct Instruction;
+  struct CompareBranch;
 
   const u8* GetCodePtr() const;
   void ExecuteOneBlock();
 
+  // Whether ops[index] is a compare followed by a conditional branch on its result, which can be
+  // run by a single Instruction.
+  bool CanFuseCompareBranch(const PPCAnalyst::CodeOp* ops, u32 index) const;
+  void WriteExits(JitBlock* b, const std::vector<u32>& exits);
+
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
+  // Operands of the fused compare and branch instructions. A deque, so that the Instructions can
+  // keep pointers to them.
+  std::deque<CompareBranch> m_compare_branches;
   PPCAnalyst::CodeBuffer code_buffer;
 };
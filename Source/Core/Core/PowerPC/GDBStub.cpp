@@ -4,6 +4,7 @@
 
 // Originally written by Sven Peter <sven@fail0verflow.com> for anergistic.
 
+#include <algorithm>
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
@@ -30,6 +31,8 @@
 
 #define GDB_BFR_MAX 10000
 #define GDB_MAX_BP 10
+// How many instructions run between checks for an interrupt request from gdb
+#define GDB_POLL_INTERVAL 0x10000
 
 #define GDB_STUB_START '$'
 #define GDB_STUB_END '#'
@@ -42,6 +45,16 @@ static int sock = -1;
 static u8 cmd_bfr[GDB_BFR_MAX];
 static u32 cmd_len;
 
+// Data received from gdb which hasn't been parsed yet
+static u8 recv_bfr[GDB_BFR_MAX];
+static u32 recv_pos = 0;
+static u32 recv_len = 0;
+static u32 poll_counter = 0;
+
+static const char target_xml[] =
+    "<?xml version=\"1.0\"?><!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+    "<target version=\"1.0\"><architecture>powerpc:common</architecture></target>";
+
 static u32 sig = 0;
 static u32 send_signal = 0;
 static u32 step_break = 0;
@@ -104,17 +117,21 @@ static void hex2mem(u8* dst, u8* src, u32 len)
 
 static u8 gdb_read_byte()
 {
-  ssize_t res;
-  u8 c = '+';
-
-  res = recv(sock, &c, 1, MSG_WAITALL);
-  if (res != 1)
+  // Receive as much as is available at once rather than a byte at a time.
+  if (recv_pos == recv_len)
   {
-    ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
-    gdb_deinit();
+    ssize_t res = recv(sock, recv_bfr, sizeof recv_bfr, 0);
+    if (res <= 0)
+    {
+      ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
+      gdb_deinit();
+      return '+';
+    }
+    recv_pos = 0;
+    recv_len = static_cast<u32>(res);
   }
 
-  return c;
+  return recv_bfr[recv_pos++];
 }
 
 static u8 gdb_calc_chksum()
@@ -293,16 +310,19 @@ static void gdb_read_command()
   gdb_ack();
 }
 
-static int gdb_data_available()
+static int gdb_data_available(long timeout_us)
 {
   struct timeval t;
   fd_set _fds, *fds = &_fds;
 
+  if (recv_pos != recv_len)
+    return 1;
+
   FD_ZERO(fds);
   FD_SET(sock, fds);
 
   t.tv_sec = 0;
-  t.tv_usec = 20;
+  t.tv_usec = timeout_us;
 
   if (select(sock + 1, fds, nullptr, nullptr, &t) < 0)
   {
@@ -358,6 +378,29 @@ static void gdb_reply(const char* reply)
   }
 }
 
+static void gdb_handle_xfer_features()
+{
+  static char reply[GDB_BFR_MAX - 4];
+  const char* annex = (const char*)(cmd_bfr + strlen("qXfer:features:read:"));
+  if (strncmp(annex, "target.xml:", strlen("target.xml:")))
+    return gdb_reply("E00");
+
+  u32 offset = 0;
+  u32 len = 0;
+  if (sscanf(annex + strlen("target.xml:"), "%x,%x", &offset, &len) != 2)
+    return gdb_reply("E01");
+
+  const u32 size = sizeof(target_xml) - 1;
+  if (offset >= size)
+    return gdb_reply("l");
+
+  len = std::min({len, size - offset, static_cast<u32>(sizeof reply - 2)});
+  reply[0] = offset + len == size ? 'l' : 'm';
+  memcpy(reply + 1, target_xml + offset, len);
+  reply[len + 1] = '\0';
+  gdb_reply(reply);
+}
+
 static void gdb_handle_query()
 {
   DEBUG_LOG(GDB_STUB, "gdb: query '%s'", cmd_bfr + 1);
@@ -367,6 +410,17 @@ static void gdb_handle_query()
     return gdb_reply("T0");
   }
 
+  if (!strncmp((const char*)cmd_bfr, "qSupported", strlen("qSupported")))
+  {
+    // Let gdb send and request as much memory per packet as fits into the buffers.
+    char reply[64];
+    snprintf(reply, sizeof reply, "PacketSize=%x;qXfer:features:read+", (GDB_BFR_MAX - 4) / 2);
+    return gdb_reply(reply);
+  }
+
+  if (!strncmp((const char*)cmd_bfr, "qXfer:features:read:", strlen("qXfer:features:read:")))
+    return gdb_handle_xfer_features();
+
   gdb_reply("");
 }
 
@@ -578,6 +632,33 @@ static void gdb_write_register()
   gdb_reply("OK");
 }
 
+// Copies memory from or to an effective address, translating it a page at a time, since
+// consecutive pages don't have to be consecutive in physical memory.
+static bool gdb_access_mem(u32 addr, u8* data, u32 len, bool write)
+{
+  constexpr u32 page_size = 0x1000;
+  while (len > 0)
+  {
+    const u32 chunk = std::min(len, page_size - (addr & (page_size - 1)));
+    if (!PowerPC::HostIsRAMAddress(addr))
+      return false;
+
+    const PowerPC::TranslateResult translated = PowerPC::HostTranslateAddress(addr);
+    if (!translated.valid)
+      return false;
+
+    if (write)
+      Memory::CopyToEmu(translated.address, data, chunk);
+    else
+      Memory::CopyFromEmu(data, translated.address, chunk);
+
+    addr += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+  return true;
+}
+
 static void gdb_read_mem()
 {
   static u8 reply[GDB_BFR_MAX - 4];
@@ -595,10 +676,10 @@ static void gdb_read_mem()
     len = (len << 4) | hex2char(cmd_bfr[i++]);
   DEBUG_LOG(GDB_STUB, "gdb: read memory: %08x bytes from %08x", len, addr);
 
-  if (len * 2 > sizeof reply)
-    gdb_reply("E01");
-  u8* data = Memory::GetPointer(addr);
-  if (!data)
+  static u8 data[sizeof reply / 2];
+  if (len * 2 >= sizeof reply)
+    return gdb_reply("E01");
+  if (!gdb_access_mem(addr, data, len, false))
     return gdb_reply("E0");
   mem2hex(reply, data, len);
   reply[len * 2] = '\0';
@@ -621,10 +702,48 @@ static void gdb_write_mem()
     len = (len << 4) | hex2char(cmd_bfr[i++]);
   DEBUG_LOG(GDB_STUB, "gdb: write memory: %08x bytes to %08x", len, addr);
 
-  u8* dst = Memory::GetPointer(addr);
-  if (!dst)
+  static u8 data[GDB_BFR_MAX / 2];
+  if (i + 1 + len * 2 > cmd_len)
+    return gdb_reply("E01");
+  hex2mem(data, cmd_bfr + i + 1, len);
+  if (!gdb_access_mem(addr, data, len, true))
+    return gdb_reply("E00");
+  gdb_reply("OK");
+}
+
+// Same as gdb_write_mem, but the data is sent in binary, with '#', '$', '}' and '*' escaped
+// as '}' followed by the character xor 0x20.
+static void gdb_write_mem_binary()
+{
+  static u8 data[GDB_BFR_MAX];
+  u32 addr, len;
+  u32 i;
+
+  i = 1;
+  addr = 0;
+  while (cmd_bfr[i] != ',')
+    addr = (addr << 4) | hex2char(cmd_bfr[i++]);
+  i++;
+
+  len = 0;
+  while (cmd_bfr[i] != ':')
+    len = (len << 4) | hex2char(cmd_bfr[i++]);
+  i++;
+  DEBUG_LOG(GDB_STUB, "gdb: write binary memory: %08x bytes to %08x", len, addr);
+
+  u32 size = 0;
+  while (i < cmd_len && size < sizeof data)
+  {
+    u8 c = cmd_bfr[i++];
+    if (c == '}' && i < cmd_len)
+      c = cmd_bfr[i++] ^ 0x20;
+    data[size++] = c;
+  }
+
+  if (size != len)
+    return gdb_reply("E01");
+  if (!gdb_access_mem(addr, data, len, true))
     return gdb_reply("E00");
-  hex2mem(dst, cmd_bfr + i + 1, len);
   gdb_reply("OK");
 }
 
@@ -741,7 +860,8 @@ void gdb_handle_exception()
 {
   while (gdb_active())
   {
-    if (!gdb_data_available())
+    // The CPU is stopped anyway, so wait for gdb rather than spinning.
+    if (!gdb_data_available(100000))
       continue;
     gdb_read_command();
     if (cmd_len == 0)
@@ -782,6 +902,11 @@ void gdb_handle_exception()
       PowerPC::ppcState.iCache.Reset();
       Host_UpdateDisasmDialog();
       break;
+    case 'X':
+      gdb_write_mem_binary();
+      PowerPC::ppcState.iCache.Reset();
+      Host_UpdateDisasmDialog();
+      break;
     case 's':
       gdb_step();
       return;
@@ -859,6 +984,8 @@ static void gdb_init_generic(int domain, const sockaddr* server_addr, socklen_t
   memset(bp_r, 0, sizeof bp_r);
   memset(bp_w, 0, sizeof bp_w);
   memset(bp_a, 0, sizeof bp_a);
+  recv_pos = recv_len = 0;
+  poll_counter = 0;
 
   tmpsock = socket(domain, SOCK_STREAM, 0);
   if (tmpsock == -1)
@@ -937,6 +1064,24 @@ int gdb_bp_x(u32 addr)
     return 1;
   }
 
+  // gdb interrupts the target by sending 0x03 while it runs. Check for that every so often
+  // without waiting, and stop as if a breakpoint was hit.
+  if (++poll_counter >= GDB_POLL_INTERVAL)
+  {
+    poll_counter = 0;
+    if (gdb_data_available(0))
+    {
+      if (gdb_read_byte() == 0x03)
+      {
+        send_signal = 1;
+        return 1;
+      }
+      // Leave anything else for gdb_handle_exception, unless the connection was lost.
+      if (sock != -1)
+        recv_pos--;
+    }
+  }
+
   return gdb_bp_check(addr, GDB_BP_TYPE_X);
 }
 
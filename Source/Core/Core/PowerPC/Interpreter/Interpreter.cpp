@@ -4,13 +4,16 @@
 
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cinttypes>
+#include <memory>
 #include <string>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/FlatHashMap.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -30,6 +33,45 @@
 namespace
 {
 u32 last_pc;
+
+// Instructions are decoded the first time they run, and stored by physical address along with
+// the handler from the opcode tables. Running them again then takes a single indirect call,
+// without fetching the instruction or walking the opcode tables.
+struct DecodedInstruction
+{
+  Interpreter::Instruction func;  // nullptr if not decoded yet.
+  UGeckoInstruction inst;
+  u16 cycles;
+  bool uses_fpu;
+  // Whether the instruction has to go through SingleStepInner, e.g. because of HLE.
+  bool slow;
+};
+
+constexpr u32 DECODED_PAGE_SHIFT = 12;
+constexpr u32 DECODED_PAGE_SIZE = 1 << DECODED_PAGE_SHIFT;
+constexpr u32 INVALID_DECODED_PAGE = 0xFFFFFFFF;
+using DecodedPage = std::array<DecodedInstruction, DECODED_PAGE_SIZE / 4>;
+
+Common::FlatHashMap<u32, std::unique_ptr<DecodedPage>> s_decoded_pages;
+// The page the last instruction was in, which saves the hash lookup for straight-line code.
+u32 s_last_page_index = INVALID_DECODED_PAGE;
+DecodedPage* s_last_page = nullptr;
+
+Interpreter::Instruction GetHandler(UGeckoInstruction inst)
+{
+  const Interpreter::Instruction func = Interpreter::m_op_table[inst.OPCD];
+  if (func == Interpreter::RunTable4)
+    return Interpreter::m_op_table4[inst.SUBOP10];
+  if (func == Interpreter::RunTable19)
+    return Interpreter::m_op_table19[inst.SUBOP10];
+  if (func == Interpreter::RunTable31)
+    return Interpreter::m_op_table31[inst.SUBOP10];
+  if (func == Interpreter::RunTable59)
+    return Interpreter::m_op_table59[inst.SUBOP5];
+  if (func == Interpreter::RunTable63)
+    return Interpreter::m_op_table63[inst.SUBOP10];
+  return func;
+}
 }
 
 bool Interpreter::m_end_block;
@@ -68,10 +110,12 @@ void Interpreter::Init()
   InitializeInstructionTables();
   m_reserve = false;
   m_end_block = false;
+  ClearDecodedInstructions();
 }
 
 void Interpreter::Shutdown()
 {
+  ClearDecodedInstructions();
 }
 
 static int startTrace = 0;
@@ -197,6 +241,102 @@ int Interpreter::SingleStepInner()
   return opinfo->numCycles;
 }
 
+int Interpreter::SingleStepDecoded()
+{
+#ifdef USE_GDBSTUB
+  if (gdb_active())
+    return SingleStepInner();
+#endif
+
+  const auto translated = PowerPC::JitCache_TranslateAddress(PC);
+  if (!translated.valid)
+    return SingleStepInner();
+
+  const u32 page_index = translated.address >> DECODED_PAGE_SHIFT;
+  if (page_index != s_last_page_index)
+  {
+    std::unique_ptr<DecodedPage>& page = s_decoded_pages[page_index];
+    if (!page)
+      page = std::make_unique<DecodedPage>();
+    s_last_page = page.get();
+    s_last_page_index = page_index;
+  }
+
+  DecodedInstruction& decoded =
+      (*s_last_page)[(translated.address & (DECODED_PAGE_SIZE - 1)) >> 2];
+  if (!decoded.func)
+  {
+    const PowerPC::TryReadInstResult result = PowerPC::TryReadInstruction(PC);
+    if (!result.valid || result.hex == 0)
+      return SingleStepInner();
+
+    decoded.inst.hex = result.hex;
+    decoded.func = GetHandler(decoded.inst);
+    decoded.cycles = GetOpInfo(decoded.inst)->numCycles;
+    decoded.uses_fpu = PPCTables::UsesFPU(decoded.inst);
+    decoded.slow = HLE::GetFunctionIndex(PC) != 0;
+  }
+
+  if (decoded.slow)
+    return SingleStepInner();
+
+  // The instruction may clear the cache, so don't touch the entry after running it.
+  const int cycles = decoded.cycles;
+  NPC = PC + sizeof(UGeckoInstruction);
+  if (decoded.uses_fpu && !UReg_MSR(MSR).FP)
+  {
+    PowerPC::ppcState.Exceptions |= EXCEPTION_FPU_UNAVAILABLE;
+    PowerPC::CheckExceptions();
+    m_end_block = true;
+  }
+  else
+  {
+    decoded.func(decoded.inst);
+    if (PowerPC::ppcState.Exceptions & EXCEPTION_DSI)
+    {
+      PowerPC::CheckExceptions();
+      m_end_block = true;
+    }
+  }
+  last_pc = PC;
+  PC = NPC;
+
+  return cycles;
+}
+
+void Interpreter::InvalidateDecodedInstructions(u32 address, u32 size)
+{
+  if (s_decoded_pages.Empty() || size == 0)
+    return;
+
+  const auto translated = PowerPC::JitCache_TranslateAddress(address);
+  if (!translated.valid)
+    return;
+
+  const u32 start = translated.address & ~3;
+  const u32 end = translated.address + size;
+  for (u32 page_index = start >> DECODED_PAGE_SHIFT; page_index <= (end - 1) >> DECODED_PAGE_SHIFT;
+       ++page_index)
+  {
+    std::unique_ptr<DecodedPage>* page = s_decoded_pages.Find(page_index);
+    if (!page)
+      continue;
+
+    const u32 page_start = page_index << DECODED_PAGE_SHIFT;
+    const u32 first = std::max(start, page_start);
+    const u32 last = std::min(end - 1, page_start + DECODED_PAGE_SIZE - 1);
+    for (u32 i = first; i <= last; i += 4)
+      (**page)[(i & (DECODED_PAGE_SIZE - 1)) >> 2].func = nullptr;
+  }
+}
+
+void Interpreter::ClearDecodedInstructions()
+{
+  s_decoded_pages.Clear();
+  s_last_page_index = INVALID_DECODED_PAGE;
+  s_last_page = nullptr;
+}
+
 void Interpreter::SingleStep()
 {
   // Declare start of new slice
@@ -205,7 +345,7 @@ void Interpreter::SingleStep()
   SingleStepInner();
 
   // The interpreter ignores instruction timing information outside the 'fast runloop'.
-  CoreTiming::g.slice_length = 1;
+  CoreTiming::GetGlobals().slice_length = 1;
   PowerPC::ppcState.downcount = 0;
 
   if (PowerPC::ppcState.Exceptions)
@@ -294,14 +434,21 @@ void Interpreter::Run()
     else
     {
       // "fast" version of inner loop. well, it's not so fast.
+      const bool predecode = SConfig::GetInstance().bInterpreterPredecode;
       while (PowerPC::ppcState.downcount > 0)
       {
         m_end_block = false;
 
         int cycles = 0;
-        while (!m_end_block)
+        if (predecode)
+        {
+          while (!m_end_block)
+            cycles += SingleStepDecoded();
+        }
+        else
         {
-          cycles += SingleStepInner();
+          while (!m_end_block)
+            cycles += SingleStepInner();
         }
         PowerPC::ppcState.downcount -= cycles;
       }
@@ -327,7 +474,7 @@ void Interpreter::unknown_instruction(UGeckoInstruction inst)
 
 void Interpreter::ClearCache()
 {
-  // Do nothing.
+  ClearDecodedInstructions();
 }
 
 const char* Interpreter::GetName()
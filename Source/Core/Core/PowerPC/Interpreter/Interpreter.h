@@ -17,6 +17,14 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Like SingleStepInner, but runs the instruction from the decoded instruction cache, decoding
+  // it first if needed. Anything the cache can't handle goes through SingleStepInner.
+  int SingleStepDecoded();
+
+  // Drops the decoded instructions. These are called whenever the JIT would invalidate its blocks,
+  // so the decoded instruction cache follows the same rules as the JIT block cache.
+  void InvalidateDecodedInstructions(u32 address, u32 size);
+  void ClearDecodedInstructions();
 
   void Run() override;
   void ClearCache() override;
@@ -326,6 +326,7 @@ void Interpreter::dcbf(UGeckoInstruction inst)
   // should use icbi consistently, but games aren't portable.)
   u32 address = Helper_Get_EA_X(inst);
   JitInterface::InvalidateICache(address & ~0x1f, 32, false);
+  PowerPC::FlushCacheLine(address & ~0x1f);
 }
 
 void Interpreter::dcbi(UGeckoInstruction inst)
@@ -338,6 +339,7 @@ void Interpreter::dcbi(UGeckoInstruction inst)
   // should use icbi consistently, but games aren't portable.)
   u32 address = Helper_Get_EA_X(inst);
   JitInterface::InvalidateICache(address & ~0x1f, 32, false);
+  PowerPC::InvalidateCacheLine(address & ~0x1f);
 }
 
 void Interpreter::dcbst(UGeckoInstruction inst)
@@ -350,6 +352,7 @@ void Interpreter::dcbst(UGeckoInstruction inst)
   // should use icbi consistently, but games aren't portable.)
   u32 address = Helper_Get_EA_X(inst);
   JitInterface::InvalidateICache(address & ~0x1f, 32, false);
+  PowerPC::StoreCacheLine(address & ~0x1f);
 }
 
 void Interpreter::dcbt(UGeckoInstruction inst)
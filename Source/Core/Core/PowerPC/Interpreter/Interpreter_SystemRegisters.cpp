@@ -176,6 +176,7 @@ static void SetSR(int index, u32 value)
   DEBUG_LOG(POWERPC, "%08x: MMU: Segment register %i set to %08x", PowerPC::ppcState.pc, index,
             value);
   PowerPC::ppcState.sr[index] = value;
+  PowerPC::InvalidateSoftwareTLB();
 }
 
 void Interpreter::mtsr(UGeckoInstruction inst)
@@ -294,6 +295,12 @@ void Interpreter::mtspr(UGeckoInstruction inst)
       // most games do it only once during initialization
       PowerPC::ppcState.iCache.Reset();
     }
+    if (HID0.DCFI)
+    {
+      HID0.DCFI = 0;
+      INFO_LOG(POWERPC, "Flush Data Cache! DCE=%d", (int)HID0.DCE);
+      PowerPC::ppcState.dCache.Reset();
+    }
   }
   break;
   case SPR_HID2:  // HID2
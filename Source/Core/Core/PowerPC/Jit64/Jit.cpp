@@ -4,6 +4,8 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <string>
 
@@ -226,10 +228,17 @@ void Jit64::Init()
   const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
   AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  if (SConfig::GetInstance().bHugePages)
+    Common::AdviseHugePages(region, total_region_size);
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
   m_const_pool.Init(AllocChildCodeSpace(constpool_size), constpool_size);
+  m_code_segments = GetWritableCodePtr();
+  m_far_code_segments = m_far_code.GetWritableCodePtr();
+  m_code_segment_size = CODE_SIZE / CODE_SEGMENTS;
+  m_far_code_segment_size = farcode_size / CODE_SEGMENTS;
+  m_code_segment = 0;
 
   // BLR optimization has the same consequences as block linking, as well as
   // depending on the fault handler to be safe in the event of excessive BL.
@@ -253,7 +262,14 @@ void Jit64::Init()
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
   code_block.m_fpa = &js.fpa;
+  analyzer.SetLikelyTakenBranches(&js.likelyTakenBranches);
   EnableOptimization();
+
+  if (SConfig::GetInstance().bJITBlockDiskCache)
+    m_block_disk_cache.Open(GetName());
+
+  // JitInterface fills in the list right after this.
+  m_warmup_pending = !SConfig::GetInstance().m_strJITWarmupList.empty();
 }
 
 void Jit64::ClearCache()
@@ -265,10 +281,42 @@ void Jit64::ClearCache()
   ClearCodeSpace();
   Clear();
   UpdateMemoryOptions();
+  m_code_segment = 0;
+}
+
+bool Jit64::IsCodeSegmentAlmostFull() const
+{
+  // Like CodeBlock::IsAlmostFull, this should be bigger than the biggest block ever.
+  constexpr size_t MIN_SPACE = 0x10000;
+  const u8* code_end = m_code_segments + (m_code_segment + 1) * m_code_segment_size;
+  const u8* far_code_end = m_far_code_segments + (m_code_segment + 1) * m_far_code_segment_size;
+  return GetCodePtr() + MIN_SPACE > code_end || m_far_code.GetCodePtr() + MIN_SPACE > far_code_end;
+}
+
+void Jit64::StartNextCodeSegment()
+{
+  m_code_segment = (m_code_segment + 1) % CODE_SEGMENTS;
+  u8* code_start = m_code_segments + m_code_segment * m_code_segment_size;
+  u8* far_code_start = m_far_code_segments + m_code_segment * m_far_code_segment_size;
+  INFO_LOG(DYNA_REC, "Reusing JIT code segment %zu", m_code_segment);
+
+  // This is only called from Jit, which the dispatcher enters with a reset stack, so no
+  // return addresses into the evicted blocks are left. Blocks in other segments which were
+  // linked to them go through the dispatcher again until they are recompiled.
+  blocks.EraseHostCodeRange(code_start, code_start + m_code_segment_size);
+  ClearRange(code_start, code_start + m_code_segment_size);
+  ClearRange(far_code_start, far_code_start + m_far_code_segment_size);
+
+  // Fill the segments with breakpoints, like ClearCodeSpace does.
+  std::memset(code_start, 0xCC, m_code_segment_size);
+  std::memset(far_code_start, 0xCC, m_far_code_segment_size);
+  SetCodePtr(code_start);
+  m_far_code.SetCodePtr(far_code_start);
 }
 
 void Jit64::Shutdown()
 {
+  m_block_disk_cache.Close();
   FreeStack();
   FreeCodeSpace();
 
@@ -281,6 +329,8 @@ void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
 {
   gpr.Flush();
   fpr.Flush();
+  // The interpreter's mtfs* set the host rounding mode themselves.
+  js.fpscrRoundingMode = -1;
   if (js.op->opinfo->flags & FL_ENDBLOCK)
   {
     MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
@@ -558,11 +608,12 @@ void Jit64::Jit(u32 em_address)
 #endif
   }
 
-  if (IsAlmostFull() || m_far_code.IsAlmostFull() || trampolines.IsAlmostFull() ||
-      SConfig::GetInstance().bJITNoBlockCache)
-  {
+  // Trampolines are shared between the blocks of all segments, so they can only be freed by
+  // clearing everything. They are only generated for backpatched accesses, though.
+  if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
     ClearCache();
-  }
+  else if (IsCodeSegmentAlmostFull())
+    StartNextCodeSegment();
 
   int blockSize = code_buffer.GetSize();
 
@@ -586,16 +637,41 @@ void Jit64::Jit(u32 em_address)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_FOLLOW_LIKELY_BRANCHES);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROSS_BLOCK_LIVENESS);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_SPIN_LOOP_DETECTION);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_LOAD_FORWARDING);
       }
       Trace();
     }
   }
 
+  // With tiered compilation, a block is first compiled as a sequence of interpreter calls, which
+  // is much cheaper to generate. It is only optimized once it has proven to be hot.
+  js.interpretedBlock = SConfig::GetInstance().bJITTieredCompilation &&
+                        !SConfig::GetInstance().bEnableDebugging &&
+                        js.hotBlockAddresses.find(em_address) == js.hotBlockAddresses.end();
+  if (js.interpretedBlock)
+  {
+    // None of these help the interpreter, and following branches would only make the block exit
+    // early through the dispatcher.
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_FOLLOW_LIKELY_BRANCHES);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROSS_BLOCK_LIVENESS);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_SPIN_LOOP_DETECTION);
+  }
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
   u32 nextPC = analyzer.Analyze(em_address, &code_block, &code_buffer, blockSize);
 
+  if (js.interpretedBlock)
+    EnableOptimization();
+
   if (code_block.m_memory_exception)
   {
     // Address of instruction could not be translated
@@ -609,12 +685,130 @@ void Jit64::Jit(u32 em_address)
   JitBlock* b = blocks.AllocateBlock(em_address);
   DoJit(em_address, &code_buffer, b, nextPC);
   blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+
+  if (m_block_disk_cache.IsOpen() && blockSize == code_buffer.GetSize() && !js.interpretedBlock)
+  {
+    m_block_disk_cache.Record(em_address, b->msrBits, code_block, code_buffer);
+
+    // Do this while the CPU thread has to wait for the JIT anyway, which at boot is right after
+    // the first block of the title has been compiled.
+    if (m_block_disk_cache.HasPendingEntries())
+      PrecompileCachedBlocks();
+  }
+
+  // Same as above: the title has been loaded, but hasn't rendered anything yet.
+  if (m_warmup_pending)
+  {
+    m_warmup_pending = false;
+    PrecompileWarmupBlocks();
+  }
+}
+
+bool Jit64::IsCodeSpaceAlmostFull()
+{
+  return IsCodeSegmentAlmostFull() || trampolines.IsAlmostFull();
+}
+
+Jit64::PrecompileResult Jit64::PrecompileBlock(u32 em_address, u32 msr_bits,
+                                               const JitBlockDiskCache::Entry* entry)
+{
+  // The analyzer and the block cache both look at MSR for address translation.
+  const u32 old_msr = MSR;
+  MSR = (old_msr & ~JitBaseBlockCache::JIT_CACHE_MSR_MASK) | msr_bits;
+
+  PrecompileResult result = PrecompileResult::AlreadyCompiled;
+  if (!blocks.GetBlockFromStartAddress(em_address, MSR))
+  {
+    const u32 nextPC =
+        analyzer.Analyze(em_address, &code_block, &code_buffer, code_buffer.GetSize());
+    if (code_block.m_memory_exception ||
+        (entry && !JitBlockDiskCache::Matches(*entry, code_block, code_buffer)))
+    {
+      result = PrecompileResult::Stale;
+    }
+    else
+    {
+      // These blocks were already hot in a previous session, so don't tier them again.
+      js.interpretedBlock = false;
+      JitBlock* b = blocks.AllocateBlock(em_address);
+      DoJit(em_address, &code_buffer, b, nextPC);
+      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+      result = PrecompileResult::Compiled;
+    }
+  }
+
+  MSR = old_msr;
+  return result;
+}
+
+void Jit64::PrecompileCachedBlocks()
+{
+  if (SConfig::GetInstance().bEnableDebugging)
+    return;
+
+  u32 precompiled = 0;
+  u32 discarded = 0;
+
+  for (const JitBlockDiskCache::Entry& entry : m_block_disk_cache.TakePendingEntries())
+  {
+    if (IsCodeSpaceAlmostFull())
+      break;
+
+    switch (PrecompileBlock(entry.effective_address, entry.msr_bits, &entry))
+    {
+    case PrecompileResult::Compiled:
+      ++precompiled;
+      break;
+    case PrecompileResult::Stale:
+      ++discarded;
+      break;
+    case PrecompileResult::AlreadyCompiled:
+      break;
+    }
+  }
+
+  NOTICE_LOG(DYNA_REC, "Precompiled %u cached blocks, discarded %u stale ones", precompiled,
+             discarded);
+}
+
+void Jit64::PrecompileWarmupBlocks()
+{
+  if (SConfig::GetInstance().bEnableDebugging)
+    return;
+
+  u32 precompiled = 0;
+  u32 skipped = 0;
+
+  for (const JitInterface::BlockEntryPoint& entry_point : js.warmupBlocks)
+  {
+    if (IsCodeSpaceAlmostFull())
+      break;
+
+    // Unlike the disk cache, the list doesn't say what the code looked like, so a block might
+    // come from an overlay which isn't loaded yet. That's harmless though: it gets invalidated
+    // along with the memory it was compiled from.
+    switch (PrecompileBlock(entry_point.effective_address, entry_point.msr_bits, nullptr))
+    {
+    case PrecompileResult::Compiled:
+      ++precompiled;
+      break;
+    case PrecompileResult::Stale:
+      ++skipped;
+      break;
+    case PrecompileResult::AlreadyCompiled:
+      break;
+    }
+  }
+
+  NOTICE_LOG(DYNA_REC, "Precompiled %u blocks from the warm-up list, skipped %u unmapped ones",
+             precompiled, skipped);
 }
 
 const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock* b, u32 nextPC)
 {
   js.firstFPInstructionFound = false;
   js.isLastInstruction = false;
+  js.fpscrRoundingMode = -1;
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -626,6 +820,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
 
   const u8* start =
       AlignCode4();  // TODO: Test if this or AlignCode16 make a difference from GetCodePtr
+  const u8* far_start = m_far_code.GetCodePtr();
   b->checkedEntry = start;
   b->runCount = 0;
 
@@ -658,11 +853,37 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
     // get start tic
     PROFILER_QUERY_PERFORMANCE_COUNTER(&b->ticStart);
   }
+  if (Profiler::g_SampleBlocks)
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(&Profiler::g_sampled_block_address));
+    MOV(32, MatR(RSCRATCH), Imm32(js.blockStart));
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
 #endif
 
+  if (js.interpretedBlock)
+  {
+    // Count down the executions of the block, and request an optimized recompile once it is
+    // hot. This works like the other compile exception checks, which invalidate the block and
+    // return to the dispatcher.
+    b->tierUpCountdown = std::max(SConfig::GetInstance().iJITTierUpThreshold, 1);
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tierUpCountdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch hot = J_CC(CC_Z, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcherNoCheck, true);
+    SwitchToNearCode();
+  }
+
   // Start up the register allocators
   // They use the information in gpa/fpa to preload commonly used registers.
   gpr.Start();
@@ -678,7 +899,8 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
   // loads and stores,
   // which are significantly faster when inlined (especially in MMU mode, where this lets them use
   // fastmem).
-  if (js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
+  if (!js.interpretedBlock &&
+      js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
     // If there are GQRs used but not set, we'll treat those as constant and optimize them
     BitSet8 gqr_static = ComputeStaticGQRs(code_block);
@@ -706,8 +928,8 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
     }
   }
 
-  if (js.noSpeculativeConstantsAddresses.find(js.blockStart) ==
-      js.noSpeculativeConstantsAddresses.end())
+  if (!js.interpretedBlock && js.noSpeculativeConstantsAddresses.find(js.blockStart) ==
+                                   js.noSpeculativeConstantsAddresses.end())
   {
     IntializeSpeculativeConstants();
   }
@@ -855,29 +1077,36 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
         SetJumpTarget(noBreakpoint);
       }
 
-      // If we have an input register that is going to be used again, load it pre-emptively,
-      // even if the instruction doesn't strictly need it in a register, to avoid redundant
-      // loads later. Of course, don't do this if we're already out of registers.
-      // As a bit of a heuristic, make sure we have at least one register left over for the
-      // output, which needs to be bound in the actual instruction compilation.
-      // TODO: make this smarter in the case that we're actually register-starved, i.e.
-      // prioritize the more important registers.
-      for (int reg : ops[i].regsIn)
+      if (js.interpretedBlock)
       {
-        if (gpr.NumFreeRegisters() < 2)
-          break;
-        if (ops[i].gprInReg[reg] && !gpr.R(reg).IsImm())
-          gpr.BindToRegister(reg, true, false);
+        FallBackToInterpreter(ops[i].inst);
       }
-      for (int reg : ops[i].fregsIn)
+      else
       {
-        if (fpr.NumFreeRegisters() < 2)
-          break;
-        if (ops[i].fprInXmm[reg])
-          fpr.BindToRegister(reg, true, false);
-      }
+        // If we have an input register that is going to be used again, load it pre-emptively,
+        // even if the instruction doesn't strictly need it in a register, to avoid redundant
+        // loads later. Of course, don't do this if we're already out of registers.
+        // As a bit of a heuristic, make sure we have at least one register left over for the
+        // output, which needs to be bound in the actual instruction compilation.
+        // TODO: make this smarter in the case that we're actually register-starved, i.e.
+        // prioritize the more important registers.
+        for (int reg : ops[i].regsIn)
+        {
+          if (gpr.NumFreeRegisters() < 2)
+            break;
+          if (ops[i].gprInReg[reg] && !gpr.R(reg).IsImm())
+            gpr.BindToRegister(reg, true, false);
+        }
+        for (int reg : ops[i].fregsIn)
+        {
+          if (fpr.NumFreeRegisters() < 2)
+            break;
+          if (ops[i].fprInXmm[reg])
+            fpr.BindToRegister(reg, true, false);
+        }
 
-      CompileInstruction(ops[i]);
+        CompileInstruction(ops[i]);
+      }
 
       if (jo.memcheck && (opinfo->flags & FL_LOADSTORE))
       {
@@ -952,6 +1181,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
   }
 
   b->codeSize = (u32)(GetCodePtr() - start);
+  b->farCodeSize = (u32)(m_far_code.GetCodePtr() - far_start);
   b->originalSize = code_block.m_num_instructions;
 
 #ifdef JIT_LOG_X86
@@ -993,6 +1223,23 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  if (SConfig::GetInstance().bJITSuperblocks)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_FOLLOW_LIKELY_BRANCHES);
+  else
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_FOLLOW_LIKELY_BRANCHES);
+  // Registers which are left stale in ppcState would confuse the debugger.
+  if (SConfig::GetInstance().bJITCrossBlockLiveness && !SConfig::GetInstance().bEnableDebugging)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROSS_BLOCK_LIVENESS);
+  else
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROSS_BLOCK_LIVENESS);
+  if (SConfig::GetInstance().bJITSpinLoopDetection)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_SPIN_LOOP_DETECTION);
+  else
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_SPIN_LOOP_DETECTION);
+  if (SConfig::GetInstance().bJITLoadForwarding)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_LOAD_FORWARDING);
+  else
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_LOAD_FORWARDING);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -26,6 +26,7 @@
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/Jit64Base.h"
+#include "Core/PowerPC/JitCommon/JitBlockDiskCache.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
@@ -71,11 +72,24 @@ public:
   void JustWriteExit(u32 destination, bool bl, u32 after);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
   void WriteBLRExit();
+  // Like WriteExitDestInRSCRATCH, but for bcctr: if the branch usually goes to the same target,
+  // compare against it and exit through a linked jump, only using the dispatcher on a miss.
+  void WriteIndirectBranchExit(bool bl, u32 after);
   void WriteExceptionExit();
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   bool Cleanup();
 
+  // The number of times a conditional branch is profiled before deciding whether superblocks
+  // should follow it.
+  static constexpr u32 SUPERBLOCK_PROFILE_EXECUTIONS = 1000;
+  void ProfileBranchExecution(JitBase::BranchStats* stats);
+
+  // The number of dispatched executions of an indirect branch after which a new target is
+  // considered for its inline cache, and how often that can happen before it's given up.
+  static constexpr u32 INDIRECT_BRANCH_PROFILE_MISSES = 64;
+  static constexpr u32 INDIRECT_BRANCH_MAX_RETARGETS = 4;
+
   void GenerateConstantOverflow(bool overflow);
   void GenerateConstantOverflow(s64 val);
   void GenerateOverflow();
@@ -119,6 +133,7 @@ public:
                         bool preserve_inputs, bool roundRHS = false);
   void FloatCompare(UGeckoInstruction inst, bool upper = false);
   void UpdateMXCSR();
+  void SetFPSCRRoundingMode(u32 mode);
 
   // OPCODES
   using Instruction = void (Jit64::*)(UGeckoInstruction instCode);
@@ -237,6 +252,30 @@ private:
   void AllocStack();
   void FreeStack();
 
+  enum class PrecompileResult
+  {
+    Compiled,
+    AlreadyCompiled,
+    // The code couldn't be read, or with a disk cache entry, no longer matches it.
+    Stale
+  };
+
+  // The near code and the far code are split into the same number of segments, which are filled
+  // one after the other. Once the last one is full, the blocks in the oldest segment are thrown
+  // away and it is reused, which is much cheaper than recompiling everything after ClearCache.
+  static constexpr size_t CODE_SEGMENTS = 4;
+  bool IsCodeSegmentAlmostFull() const;
+  void StartNextCodeSegment();
+
+  bool IsCodeSpaceAlmostFull();
+  // Compiles the block at em_address as if MSR had the given bits, without running it.
+  PrecompileResult PrecompileBlock(u32 em_address, u32 msr_bits,
+                                   const JitBlockDiskCache::Entry* entry);
+  // Compiles the blocks recorded by a previous boot of the running title.
+  void PrecompileCachedBlocks();
+  // Compiles the blocks from the warm-up list given on the command line.
+  void PrecompileWarmupBlocks();
+
   GPRRegCache gpr{*this};
   FPURegCache fpr{*this};
 
@@ -244,8 +283,16 @@ private:
   // large chunk of memory for each recompiled block.
   PPCAnalyst::CodeBuffer code_buffer;
   Jit64AsmRoutineManager asm_routines;
+  JitBlockDiskCache m_block_disk_cache;
 
   bool m_enable_blr_optimization;
   bool m_cleanup_after_stackfault;
+  bool m_warmup_pending = false;
   u8* m_stack;
+
+  u8* m_code_segments = nullptr;
+  u8* m_far_code_segments = nullptr;
+  size_t m_code_segment_size = 0;
+  size_t m_far_code_segment_size = 0;
+  size_t m_code_segment = 0;
 };
@@ -3,7 +3,9 @@
 // Refer to the license.txt file included.
 
 #include "Core/PowerPC/Jit64/Jit.h"
+#include "Common/PerformanceCounter.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Profiler.h"
 
 static Jit64::Instruction dynaOpTable[64];
 static Jit64::Instruction dynaOpTable4[1024];
@@ -362,9 +364,28 @@ const GekkoOPTemplate table63_2[] = {
 
 void Jit64::CompileInstruction(PPCAnalyst::CodeOp& op)
 {
-  (this->*dynaOpTable[op.inst.OPCD])(op.inst);
-
   GekkoOPInfo* info = op.opinfo;
+  if (Profiler::g_ProfileBlocks && info)
+  {
+    const u8* near_start = GetCodePtr();
+    const u8* far_start = m_far_code.GetCodePtr();
+    u64 ticks_start;
+    QueryPerformanceCounter((LARGE_INTEGER*)&ticks_start);
+
+    (this->*dynaOpTable[op.inst.OPCD])(op.inst);
+
+    u64 ticks_end;
+    QueryPerformanceCounter((LARGE_INTEGER*)&ticks_end);
+    info->emittedBytes += GetCodePtr() - near_start;
+    info->emittedFarBytes += m_far_code.GetCodePtr() - far_start;
+    info->emitCount++;
+    info->emitTicks += ticks_end - ticks_start;
+  }
+  else
+  {
+    (this->*dynaOpTable[op.inst.OPCD])(op.inst);
+  }
+
   if (info)
   {
 #ifdef OPLOG
@@ -15,6 +15,7 @@
 #include "Core/PowerPC/Jit64/Jit.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/Profiler.h"
 
 using namespace Gen;
 
@@ -57,6 +58,9 @@ void Jit64AsmRoutineManager::Generate()
   MOV(64, MDisp(RSP, 8), Imm32((u32)-1));
 
   const u8* outerLoop = GetCodePtr();
+  // Don't let the sampling profiler attribute CoreTiming to the last block.
+  MOV(64, R(RSCRATCH), ImmPtr(&Profiler::g_sampled_block_address));
+  MOV(32, MatR(RSCRATCH), Imm32(0));
   ABI_PushRegistersAndAdjustStack({}, 0);
   ABI_CallFunction(CoreTiming::Advance);
   ABI_PopRegistersAndAdjustStack({}, 0);
@@ -70,6 +70,20 @@ void RegCache::DiscardRegContentsIfCached(size_t preg)
   }
 }
 
+void RegCache::Discard(BitSet32 pregs)
+{
+  for (unsigned int i : pregs)
+  {
+    if (m_regs[i].locked)
+      PanicAlert("Someone forgot to unlock PPC reg %u (X64 reg %i).", i, RX(i));
+
+    DiscardRegContentsIfCached(i);
+    // Immediates aren't bound to a register, but are still "away".
+    m_regs[i].away = false;
+    m_regs[i].location = GetDefaultLocation(i);
+  }
+}
+
 void RegCache::SetEmitter(XEmitter* emitter)
 {
   m_emitter = emitter;
@@ -48,6 +48,9 @@ public:
   void Start();
 
   void DiscardRegContentsIfCached(size_t preg);
+  // Forgets the values of the given registers without writing them back, for registers which are
+  // known to be overwritten before being read again.
+  void Discard(BitSet32 pregs);
   void SetEmitter(Gen::XEmitter* emitter);
 
   void Flush(FlushMode mode = FlushMode::All, BitSet32 regsToFlush = BitSet32::AllTrue(32));
@@ -10,6 +10,7 @@
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/Jit64/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -84,6 +85,7 @@ void Jit64::bx(UGeckoInstruction inst)
     return;
   }
 
+  gpr.Discard(js.op->gprDeadAtTarget);
   gpr.Flush();
   fpr.Flush();
 
@@ -96,7 +98,7 @@ void Jit64::bx(UGeckoInstruction inst)
   if (inst.LK)
     AND(32, PPCSTATE(cr), Imm32(~(0xFF000000)));
 #endif
-  if (destination == js.compilerPC)
+  if (destination == js.compilerPC || js.op->spinLoopBranch)
   {
     ABI_PushRegistersAndAdjustStack({}, 0);
     ABI_CallFunction(CoreTiming::Idle);
@@ -108,6 +110,70 @@ void Jit64::bx(UGeckoInstruction inst)
   WriteExit(destination, inst.LK, js.compilerPC + 4);
 }
 
+void Jit64::ProfileBranchExecution(JitBase::BranchStats* stats)
+{
+  // Once the branch has run often enough, let JitInterface decide whether the block should be
+  // recompiled with the branch followed. Nothing here depends on the flags, since bcx tests the
+  // condition itself.
+  MOV(64, R(RSCRATCH), ImmPtr(&stats->executed));
+  ADD(32, MatR(RSCRATCH), Imm8(1));
+  CMP(32, MatR(RSCRATCH), Imm32(SUPERBLOCK_PROFILE_EXECUTIONS));
+  FixupBranch profiled = J_CC(CC_E, true);
+
+  SwitchToFarCode();
+  SetJumpTarget(profiled);
+  BitSet32 registersInUse = CallerSavedRegistersInUse();
+  ABI_PushRegistersAndAdjustStack(registersInUse, 0);
+  ABI_CallFunctionC(JitInterface::ProfileBranch, js.compilerPC);
+  ABI_PopRegistersAndAdjustStack(registersInUse, 0);
+  FixupBranch done = J(true);
+  SwitchToNearCode();
+
+  SetJumpTarget(done);
+}
+
+void Jit64::WriteIndirectBranchExit(bool bl, u32 after)
+{
+  // The inline cache only pays off if the hit can be linked to the target block.
+  JitBase::IndirectBranchStats* stats = &js.indirectBranchStats[js.compilerPC];
+  if (!jo.enableBlocklink || stats->retargets > INDIRECT_BRANCH_MAX_RETARGETS)
+  {
+    WriteExitDestInRSCRATCH(bl, after);
+    return;
+  }
+
+  const u32 target = stats->target;
+  if (target != 0)
+  {
+    CMP(32, R(RSCRATCH), Imm32(target));
+    FixupBranch miss = J_CC(CC_NE, true);
+    MOV(64, R(RSCRATCH), ImmPtr(&stats->hits));
+    ADD(64, MatR(RSCRATCH), Imm8(1));
+    WriteExit(target, bl, after);
+
+    SwitchToFarCode();
+    SetJumpTarget(miss);
+  }
+
+  // Count the executions which go through the dispatcher, and let JitInterface pick a new target
+  // every INDIRECT_BRANCH_PROFILE_MISSES of them.
+  MOV(32, PPCSTATE(pc), R(RSCRATCH));
+  MOV(64, R(RSCRATCH2), ImmPtr(&stats->misses));
+  ADD(64, MatR(RSCRATCH2), Imm8(1));
+  TEST(32, MatR(RSCRATCH2), Imm32(INDIRECT_BRANCH_PROFILE_MISSES - 1));
+  FixupBranch no_profile = J_CC(CC_NZ);
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  MOV(32, R(ABI_PARAM2), R(RSCRATCH));
+  ABI_CallFunctionC(JitInterface::ProfileIndirectBranch, js.compilerPC);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  MOV(32, R(RSCRATCH), PPCSTATE(pc));
+  SetJumpTarget(no_profile);
+  WriteExitDestInRSCRATCH(bl, after);
+
+  if (target != 0)
+    SwitchToNearCode();
+}
+
 // TODO - optimize to hell and beyond
 // TODO - make nice easy to optimize special cases for the most common
 // variants of this instruction.
@@ -118,6 +184,21 @@ void Jit64::bcx(UGeckoInstruction inst)
 
   // USES_CR
 
+  // With superblocks, profile the branch until we know whether it's worth following.
+  const bool conditional =
+      (inst.BO & BO_DONT_DECREMENT_FLAG) == 0 || (inst.BO & BO_DONT_CHECK_CONDITION) == 0;
+  JitBase::BranchStats* stats = nullptr;
+  if (conditional && !js.op->likelyTaken &&
+      analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_FOLLOW_LIKELY_BRANCHES) &&
+      js.likelyTakenBranches.find(js.compilerPC) == js.likelyTakenBranches.end())
+  {
+    stats = &js.branchStats[js.compilerPC];
+    if (stats->executed < SUPERBLOCK_PROFILE_EXECUTIONS)
+      ProfileBranchExecution(stats);
+    else
+      stats = nullptr;
+  }
+
   FixupBranch pCTRDontBranch;
   if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)  // Decrement and test CTR
   {
@@ -135,6 +216,29 @@ void Jit64::bcx(UGeckoInstruction inst)
         JumpIfCRFieldBit(inst.BI >> 2, 3 - (inst.BI & 3), !(inst.BO_2 & BO_BRANCH_IF_TRUE));
   }
 
+  if (js.op->likelyTaken)
+  {
+    // The analyzer continued the block at the branch target, so only the fall-through path
+    // needs to leave the block. The register caches carry over into the rest of the trace.
+    SwitchToFarCode();
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+
+    gpr.Flush(RegCache::FlushMode::MaintainState);
+    fpr.Flush(RegCache::FlushMode::MaintainState);
+    WriteExit(js.compilerPC + 4);
+    SwitchToNearCode();
+    return;
+  }
+
+  if (stats)
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(&stats->taken));
+    ADD(32, MatR(RSCRATCH), Imm8(1));
+  }
+
   if (inst.LK)
     MOV(32, PPCSTATE_LR, Imm32(js.compilerPC + 4));
 
@@ -160,9 +264,22 @@ void Jit64::bcx(UGeckoInstruction inst)
   else
     destination = js.compilerPC + SignExt16(inst.BD << 2);
 
-  gpr.Flush(RegCache::FlushMode::MaintainState);
+  // The fall-through path still needs the registers which are dead at the branch target.
+  gpr.Flush(RegCache::FlushMode::MaintainState, ~js.op->gprDeadAtTarget);
   fpr.Flush(RegCache::FlushMode::MaintainState);
-  WriteExit(destination, inst.LK, js.compilerPC + 4);
+  if (js.op->spinLoopBranch)
+  {
+    // Another iteration would read the same values again, so wait for the next event.
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunction(CoreTiming::Idle);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    MOV(32, PPCSTATE(pc), Imm32(destination));
+    WriteExceptionExit();
+  }
+  else
+  {
+    WriteExit(destination, inst.LK, js.compilerPC + 4);
+  }
 
   if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
     SetJumpTarget(pConditionDontBranch);
@@ -198,7 +315,7 @@ void Jit64::bcctrx(UGeckoInstruction inst)
     if (inst.LK_3)
       MOV(32, PPCSTATE_LR, Imm32(js.compilerPC + 4));  // LR = PC + 4;
     AND(32, R(RSCRATCH), Imm32(0xFFFFFFFC));
-    WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+    WriteIndirectBranchExit(inst.LK_3, js.compilerPC + 4);
   }
   else
   {
@@ -217,7 +334,7 @@ void Jit64::bcctrx(UGeckoInstruction inst)
 
     gpr.Flush(RegCache::FlushMode::MaintainState);
     fpr.Flush(RegCache::FlushMode::MaintainState);
-    WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+    WriteIndirectBranchExit(inst.LK_3, js.compilerPC + 4);
     // Would really like to continue the block here, but it ends. TODO.
     SetJumpTarget(b);
 
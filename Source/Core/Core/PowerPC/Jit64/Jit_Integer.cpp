@@ -347,6 +347,10 @@ bool Jit64::CheckMergedBranch(u32 crf)
   if (!CanMergeNextInstructions(1))
     return false;
 
+  // Superblocks continue at the target of a likely taken branch, which merging doesn't handle.
+  if (js.op[1].likelyTaken)
+    return false;
+
   const UGeckoInstruction& next = js.op[1].inst;
   return (((next.OPCD == 16 /* bcx */) ||
            ((next.OPCD == 19) && (next.SUBOP10 == 528) /* bcctrx */) ||
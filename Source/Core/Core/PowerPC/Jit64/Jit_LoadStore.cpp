@@ -108,6 +108,20 @@ void Jit64::lXXx(UGeckoInstruction inst)
     PanicAlert("Invalid instruction");
   }
 
+  // The value is still in a register from an earlier access to the same stack slot.
+  if (js.op->loadForwardedFrom >= 0 && !jo.memcheck)
+  {
+    const int s = js.op->loadForwardedFrom;
+    if (s != d)
+    {
+      gpr.Lock(d, s);
+      gpr.BindToRegister(d, false, true);
+      MOV(32, gpr.R(d), gpr.R(s));
+      gpr.UnlockAll();
+    }
+    return;
+  }
+
   // PowerPC has no 8-bit sign extended load, but x86 does, so merge extsb with the load if we find
   // it.
   if (CanMergeNextInstructions(1) && accessSize == 8 && js.op[1].inst.OPCD == 31 &&
@@ -271,6 +285,7 @@ void Jit64::dcbx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITLoadStoreOff);
+  FALLBACK_IF(jo.accurateCpuCache);
 
   X64Reg addr = RSCRATCH;
   X64Reg value = RSCRATCH2;
@@ -318,8 +333,9 @@ void Jit64::dcbt(UGeckoInstruction inst)
   // This is important because invalidating the block cache when we don't
   // need to is terrible for performance.
   // (Invalidating the jit block cache on dcbst is a heuristic.)
-  if (CanMergeNextInstructions(1) && js.op[1].inst.OPCD == 31 && js.op[1].inst.SUBOP10 == 54 &&
-      js.op[1].inst.RA == inst.RA && js.op[1].inst.RB == inst.RB)
+  // With data cache emulation, the dcbst has to write the line back, so it can't be skipped.
+  if (!jo.accurateCpuCache && CanMergeNextInstructions(1) && js.op[1].inst.OPCD == 31 &&
+      js.op[1].inst.SUBOP10 == 54 && js.op[1].inst.RA == inst.RA && js.op[1].inst.RB == inst.RB)
   {
     js.skipInstructions = 1;
   }
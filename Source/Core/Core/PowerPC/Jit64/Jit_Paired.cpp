@@ -45,7 +45,15 @@ void Jit64::ps_sum(UGeckoInstruction inst)
   switch (inst.SUBOP5)
   {
   case 10:  // ps_sum0: {a.ps0 + b.ps1, c.ps1}
-    UNPCKHPD(tmp, fpr.R(c));
+    if (cpu_info.bAVX && !SConfig::GetInstance().bAccurateNaNs)
+    {
+      VUNPCKHPD(fpr.RX(d), tmp, fpr.R(c));
+      tmp = fpr.RX(d);
+    }
+    else
+    {
+      UNPCKHPD(tmp, fpr.R(c));
+    }
     break;
   case 11:  // ps_sum1: {c.ps0, a.ps0 + b.ps1}
     if (fpr.R(c).IsSimpleReg())
@@ -99,6 +107,16 @@ void Jit64::ps_muls(UGeckoInstruction inst)
   }
   if (round_input)
     Force25BitPrecision(XMM1, R(XMM1), XMM0);
+  if (cpu_info.bAVX && !SConfig::GetInstance().bAccurateNaNs)
+  {
+    // Without the NaN fixup, the product can be written to d directly.
+    fpr.BindToRegister(d, d == a);
+    VMULPD(fpr.RX(d), XMM1, fpr.R(a));
+    ForceSinglePrecision(fpr.RX(d), fpr.R(d));
+    SetFPRFIfNeeded(fpr.RX(d));
+    fpr.UnlockAll();
+    return;
+  }
   MULPD(XMM1, fpr.R(a));
   fpr.BindToRegister(d, false);
   HandleNaNs(inst, fpr.RX(d), XMM1);
@@ -238,6 +238,8 @@ void Jit64::mtspr(UGeckoInstruction inst)
 
   case SPR_HID0:
   {
+    // The interpreter handles HID0[DCFI] for the emulated data cache.
+    FALLBACK_IF(jo.accurateCpuCache);
     gpr.BindToRegister(d, true, false);
     BTR(32, gpr.R(d), Imm8(31 - 20));  // ICFI
     MOV(32, PPCSTATE(spr[iIndex]), gpr.R(d));
@@ -254,6 +256,16 @@ void Jit64::mtspr(UGeckoInstruction inst)
     FALLBACK_IF(true);
   }
 
+  // Games usually set a GQR from a constant right before the paired loads and stores using it.
+  // The rest of the block can then specialize them without having to guess the value.
+  if (iIndex >= SPR_GQR0 && iIndex < SPR_GQR0 + 8)
+  {
+    if (gpr.R(d).IsImm())
+      js.constantGqr[iIndex - SPR_GQR0] = gpr.R(d).Imm32();
+    else
+      js.constantGqr.erase(iIndex - SPR_GQR0);
+  }
+
   // OK, this is easy.
   if (!gpr.R(d).IsImm())
   {
@@ -284,7 +296,7 @@ void Jit64::mfspr(UGeckoInstruction inst)
     gpr.FlushLockX(RDX, RAX);
     gpr.FlushLockX(RCX);
 
-    MOV(64, R(RCX), ImmPtr(&CoreTiming::g));
+    MOV(64, R(RCX), ImmPtr(&CoreTiming::GetGlobals()));
 
     // An inline implementation of CoreTiming::GetFakeTimeBase, since in timer-heavy games the
     // cost of calling out to C for this is actually significant.
@@ -671,6 +683,18 @@ void Jit64::UpdateMXCSR()
   LEA(64, RSCRATCH2, MConst(s_fpscr_to_mxcsr));
   AND(32, R(RSCRATCH), Imm32(7));
   LDMXCSR(MComplex(RSCRATCH2, RSCRATCH, SCALE_4, 0));
+  js.fpscrRoundingMode = -1;
+}
+
+// LDMXCSR is slow, so only emit it if the mode actually changes. Some games rewrite FPSCR in hot
+// loops with the mode it already has.
+void Jit64::SetFPSCRRoundingMode(u32 mode)
+{
+  if (js.fpscrRoundingMode == static_cast<int>(mode))
+    return;
+
+  LDMXCSR(MConst(s_fpscr_to_mxcsr, mode));
+  js.fpscrRoundingMode = mode;
 }
 
 void Jit64::mtfsb0x(UGeckoInstruction inst)
@@ -684,12 +708,19 @@ void Jit64::mtfsb0x(UGeckoInstruction inst)
   {
     AND(32, PPCSTATE(fpscr), Imm32(mask));
   }
+  else if (js.fpscrRoundingMode >= 0)
+  {
+    AND(32, PPCSTATE(fpscr), Imm32(mask));
+    SetFPSCRRoundingMode(js.fpscrRoundingMode & mask);
+  }
   else
   {
     MOV(32, R(RSCRATCH), PPCSTATE(fpscr));
-    AND(32, R(RSCRATCH), Imm32(mask));
+    BTR(32, R(RSCRATCH), Imm32(31 - inst.CRBD));
+    FixupBranch unchanged = J_CC(CC_NC);
     MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
     UpdateMXCSR();
+    SetJumpTarget(unchanged);
   }
 }
 
@@ -700,6 +731,13 @@ void Jit64::mtfsb1x(UGeckoInstruction inst)
   FALLBACK_IF(inst.Rc);
 
   u32 mask = 0x80000000 >> inst.CRBD;
+  if (inst.CRBD >= 29 && js.fpscrRoundingMode >= 0)
+  {
+    OR(32, PPCSTATE(fpscr), Imm32(mask));
+    SetFPSCRRoundingMode(js.fpscrRoundingMode | mask);
+    return;
+  }
+
   MOV(32, R(RSCRATCH), PPCSTATE(fpscr));
   if (mask & FPSCR_ANY_X)
   {
@@ -707,14 +745,21 @@ void Jit64::mtfsb1x(UGeckoInstruction inst)
     FixupBranch dont_set_fx = J_CC(CC_C);
     OR(32, R(RSCRATCH), Imm32(1u << 31));
     SetJumpTarget(dont_set_fx);
+    MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
+  }
+  else if (inst.CRBD >= 29)
+  {
+    BTS(32, R(RSCRATCH), Imm32(31 - inst.CRBD));
+    FixupBranch unchanged = J_CC(CC_C);
+    MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
+    UpdateMXCSR();
+    SetJumpTarget(unchanged);
   }
   else
   {
     OR(32, R(RSCRATCH), Imm32(mask));
+    MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
   }
-  MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
-  if (inst.CRBD >= 29)
-    UpdateMXCSR();
 }
 
 void Jit64::mtfsfix(UGeckoInstruction inst)
@@ -734,7 +779,7 @@ void Jit64::mtfsfix(UGeckoInstruction inst)
 
   // Field 7 contains NI and RN.
   if (inst.CRFD == 7)
-    LDMXCSR(MConst(s_fpscr_to_mxcsr, imm & 7));
+    SetFPSCRRoundingMode(imm & 7);
 }
 
 void Jit64::mtfsfx(UGeckoInstruction inst)
@@ -760,8 +805,20 @@ void Jit64::mtfsfx(UGeckoInstruction inst)
   AND(32, R(RSCRATCH), Imm32(mask));
   AND(32, R(RSCRATCH2), Imm32(~mask));
   OR(32, R(RSCRATCH), R(RSCRATCH2));
-  MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
 
   if (inst.FM & 1)
+  {
+    // Skip the MXCSR update if NI and RN stay the same.
+    MOV(32, R(RSCRATCH2), R(RSCRATCH));
+    XOR(32, R(RSCRATCH2), PPCSTATE(fpscr));
+    MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
+    TEST(32, R(RSCRATCH2), Imm32(7));
+    FixupBranch unchanged = J_CC(CC_Z);
     UpdateMXCSR();
+    SetJumpTarget(unchanged);
+  }
+  else
+  {
+    MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
+  }
 }
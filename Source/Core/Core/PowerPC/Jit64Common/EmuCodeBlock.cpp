@@ -4,7 +4,9 @@
 
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <limits>
 
 #include "Common/Assert.h"
@@ -114,6 +116,55 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   return J_CC(CC_Z, m_far_code.Enabled());
 }
 
+FixupBranch EmuCodeBlock::SoftwareTLBAccess(X64Reg reg_addr, int access_size, bool write,
+                                            BitSet32 reserved,
+                                            const std::function<void(const OpArg&)>& access)
+{
+  static_assert(sizeof(PowerPC::SoftwareTLBEntry) == 16, "Entries are indexed with a shift");
+  constexpr int table_offset =
+      static_cast<int>(offsetof(PowerPC::PowerPCState, software_tlb)) - 0x80;
+  const int tag_offset = write ? offsetof(PowerPC::SoftwareTLBEntry, write_tag) :
+                                 offsetof(PowerPC::SoftwareTLBEntry, read_tag);
+
+  // Get ourselves two registers which aren't involved in the access.
+  reserved[reg_addr] = true;
+  X64Reg temps[2];
+  size_t num_temps = 0;
+  for (X64Reg reg : {RSCRATCH, RSCRATCH2, RSCRATCH_EXTRA, RSI})
+  {
+    if (num_temps < 2 && !reserved[reg])
+      temps[num_temps++] = reg;
+  }
+  const X64Reg entry = temps[0];
+  const X64Reg tag = temps[1];
+  PUSH(entry);
+  PUSH(tag);
+
+  MOV(32, R(entry), R(reg_addr));
+  SHR(32, R(entry), Imm8(12));
+  AND(32, R(entry), Imm32(PowerPC::SOFTWARE_TLB_SIZE - 1));
+  SHL(32, R(entry), Imm8(4));
+
+  // Misaligned accesses keep some of the low bits, so they fail the tag check and take the slow
+  // path. This also catches accesses which cross into the next page.
+  MOV(32, R(tag), R(reg_addr));
+  AND(32, R(tag), Imm32(~0xFFFu | static_cast<u32>(access_size / 8 - 1)));
+  CMP(32, R(tag), MComplex(RPPCSTATE, entry, SCALE_1, table_offset + tag_offset));
+  FixupBranch miss = J_CC(CC_NE);
+
+  MOV(64, R(entry), MComplex(RPPCSTATE, entry, SCALE_1,
+                             table_offset + offsetof(PowerPC::SoftwareTLBEntry, host_offset)));
+  access(MRegSum(entry, reg_addr));
+  POP(tag);
+  POP(entry);
+  FixupBranch hit = J(true);
+
+  SetJumpTarget(miss);
+  POP(tag);
+  POP(entry);
+  return hit;
+}
+
 void EmuCodeBlock::UnsafeLoadRegToReg(X64Reg reg_addr, X64Reg reg_value, int accessSize, s32 offset,
                                       bool signExtend)
 {
@@ -398,6 +449,19 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
       exit = J(true);
     SetJumpTarget(slow);
   }
+
+  // Pages with memchecks never get a software TLB entry, so a hit can skip them.
+  FixupBranch tlb_hit;
+  bool probe_tlb = dr_set;
+  if (probe_tlb)
+  {
+    BitSet32 reserved;
+    reserved[reg_value] = true;
+    tlb_hit = SoftwareTLBAccess(reg_addr, accessSize, false, reserved, [&](const OpArg& src) {
+      LoadAndSwap(accessSize, reg_value, src, signExtend);
+    });
+  }
+
   size_t rsp_alignment = (flags & SAFE_LOADSTORE_NO_PROLOG) ? 8 : 0;
   ABI_PushRegistersAndAdjustStack(registersInUse, rsp_alignment);
   switch (accessSize)
@@ -428,6 +492,9 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     MOVZX(64, accessSize, reg_value, R(ABI_RETURN));
   }
 
+  if (probe_tlb)
+    SetJumpTarget(tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -554,6 +621,24 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
     SetJumpTarget(slow);
   }
 
+  // Pages with memchecks never get a software TLB entry, so a hit can skip them.
+  FixupBranch tlb_hit;
+  bool probe_tlb = dr_set;
+  if (probe_tlb)
+  {
+    BitSet32 reserved;
+    if (reg_value.IsSimpleReg())
+      reserved[reg_value.GetSimpleReg()] = true;
+    tlb_hit = SoftwareTLBAccess(reg_addr, accessSize, true, reserved, [&](const OpArg& dest) {
+      if (reg_value.IsImm())
+        MOV(accessSize, dest, swap ? SwapImmediate(accessSize, reg_value) : reg_value);
+      else if (swap)
+        SwapAndStore(accessSize, dest, reg_value.GetSimpleReg());
+      else
+        MOV(accessSize, dest, reg_value);
+    });
+  }
+
   // PC is used by memory watchpoints (if enabled) or to print accurate PC locations in debug logs
   MOV(32, PPCSTATE(pc), Imm32(g_jit->js.compilerPC));
 
@@ -591,6 +676,9 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   MemoryExceptionCheck();
 
+  if (probe_tlb)
+    SetJumpTarget(tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -613,6 +701,95 @@ bool EmuCodeBlock::WriteClobbersRegValue(int accessSize, bool swap)
   return swap && !cpu_info.bMOVBE && accessSize > 8;
 }
 
+// Visitor that generates code to write a MMIO value.
+template <typename T>
+class MMIOWriteCodeGenerator : public MMIO::WriteHandlingMethodVisitor<T>
+{
+public:
+  MMIOWriteCodeGenerator(Gen::X64CodeBlock* code, BitSet32 registers_in_use,
+                         const Gen::OpArg& value, u32 address)
+      : m_code(code), m_registers_in_use(registers_in_use), m_value(value), m_address(address)
+  {
+  }
+
+  void VisitNop() override {}
+  void VisitDirect(T* addr, u32 mask) override { StoreToAddrMask(8 * sizeof(T), addr, mask); }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    CallLambda(8 * sizeof(T), lambda);
+  }
+
+private:
+  void StoreToAddrMask(int sbits, void* ptr, u32 mask)
+  {
+    Gen::OpArg value = m_value;
+    u32 all_ones = (1ULL << sbits) - 1;
+    if (value.IsImm())
+    {
+      const u32 imm = value.AsImm32().Imm32() & mask;
+      if (sbits == 8)
+        value = Imm8(static_cast<u8>(imm));
+      else if (sbits == 16)
+        value = Imm16(static_cast<u16>(imm));
+      else
+        value = Imm32(imm);
+    }
+    else if ((all_ones & mask) != all_ones || !value.IsSimpleReg() ||
+             value.IsSimpleReg(RSCRATCH2))
+    {
+      m_code->MOV(sbits, R(RSCRATCH), value);
+      if ((all_ones & mask) != all_ones)
+        m_code->AND(32, R(RSCRATCH), Imm32(mask));
+      value = R(RSCRATCH);
+    }
+
+    // MMIO registers are kept in host byte order, so no swap is needed.
+    m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+    m_code->MOV(sbits, MatR(RSCRATCH2), value);
+  }
+
+  void CallLambda(int sbits, const std::function<void(u32, T)>* lambda)
+  {
+    // Helps external systems know which instruction triggered the write
+    m_code->MOV(32, PPCSTATE(pc), Imm32(g_jit->js.compilerPC));
+
+    m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
+    m_code->ABI_CallLambdaCA(sbits, lambda, m_address, m_value);
+    m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
+  }
+
+  Gen::X64CodeBlock* m_code;
+  BitSet32 m_registers_in_use;
+  Gen::OpArg m_value;
+  u32 m_address;
+};
+
+void EmuCodeBlock::MMIOWriteToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value,
+                                   BitSet32 registers_in_use, u32 address, int access_size)
+{
+  switch (access_size)
+  {
+  case 8:
+  {
+    MMIOWriteCodeGenerator<u8> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u8>(address).Visit(gen);
+    break;
+  }
+  case 16:
+  {
+    MMIOWriteCodeGenerator<u16> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u16>(address).Visit(gen);
+    break;
+  }
+  case 32:
+  {
+    MMIOWriteCodeGenerator<u32> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u32>(address).Visit(gen);
+    break;
+  }
+  }
+}
+
 bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
                                        BitSet32 registersInUse)
 {
@@ -633,6 +810,13 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
   }
+  else if (accessSize != 64 && PowerPC::IsOptimizableMMIOAccess(address, accessSize))
+  {
+    // MMIO writes can't raise a DSI, so there is no exception to check for afterwards.
+    MMIOWriteToAddr(Memory::mmio_mapping.get(), arg, registersInUse,
+                    PowerPC::IsOptimizableMMIOAccess(address, accessSize), accessSize);
+    return false;
+  }
   else
   {
     // Helps external systems know which instruction triggered the write
@@ -1146,3 +1330,13 @@ void EmuCodeBlock::Clear()
   m_back_patch_info.clear();
   m_exception_handler_at_loc.clear();
 }
+
+void EmuCodeBlock::ClearRange(const u8* start, const u8* end)
+{
+  const auto in_range = [start, end](const u8* ptr) { return ptr >= start && ptr < end; };
+
+  for (auto it = m_back_patch_info.begin(); it != m_back_patch_info.end();)
+    it = in_range(it->first) ? m_back_patch_info.erase(it) : std::next(it);
+  for (auto it = m_exception_handler_at_loc.begin(); it != m_exception_handler_at_loc.end();)
+    it = in_range(it->first) ? m_exception_handler_at_loc.erase(it) : std::next(it);
+}
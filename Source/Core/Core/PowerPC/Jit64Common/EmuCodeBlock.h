@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <functional>
 #include <unordered_map>
 
 #include "Common/BitSet.h"
@@ -49,6 +50,12 @@ public:
 
   Gen::FixupBranch CheckIfSafeAddress(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
                                       BitSet32 registers_in_use);
+  // Looks up reg_addr in the software TLB of page table translations. On a hit, access is called
+  // with the host memory operand and the returned branch is taken afterwards. A miss falls
+  // through with all registers intact. Registers in reserved are left alone either way.
+  Gen::FixupBranch SoftwareTLBAccess(Gen::X64Reg reg_addr, int access_size, bool write,
+                                     BitSet32 reserved,
+                                     const std::function<void(const Gen::OpArg&)>& access);
   void UnsafeLoadRegToReg(Gen::X64Reg reg_addr, Gen::X64Reg reg_value, int accessSize,
                           s32 offset = 0, bool signExtend = false);
   void UnsafeLoadRegToRegNoSwap(Gen::X64Reg reg_addr, Gen::X64Reg reg_value, int accessSize,
@@ -67,6 +74,8 @@ public:
   // call for known addresses in MMIO range (MMIO::IsMMIOAddress).
   void MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value, BitSet32 registers_in_use,
                      u32 address, int access_size, bool sign_extend);
+  void MMIOWriteToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value, BitSet32 registers_in_use,
+                       u32 address, int access_size);
 
   enum SafeLoadStoreFlags
   {
@@ -122,6 +131,8 @@ public:
   void ConvertDoubleToSingle(Gen::X64Reg dst, Gen::X64Reg src);
   void SetFPRF(Gen::X64Reg xmm);
   void Clear();
+  // Forgets the fastmem accesses within [start, end), whose code is about to be reused.
+  void ClearRange(const u8* start, const u8* end);
 
 protected:
   ConstantPool m_const_pool;
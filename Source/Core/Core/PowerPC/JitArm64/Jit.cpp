@@ -10,6 +10,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/MemoryUtil.h"
 #include "Common/PerformanceCounter.h"
 #include "Common/StringUtil.h"
 
@@ -51,6 +52,8 @@ void JitArm64::Init()
 
   size_t child_code_size = SConfig::GetInstance().bMMU ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   AllocCodeSpace(CODE_SIZE + child_code_size);
+  if (SConfig::GetInstance().bHugePages)
+    Common::AdviseHugePages(region, total_region_size);
   AddChildCodeSpace(&farcode, child_code_size);
   jo.enableBlocklink = true;
   jo.optimizeGatherPipe = true;
@@ -65,6 +68,10 @@ void JitArm64::Init()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  if (SConfig::GetInstance().bJITSpinLoopDetection)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_SPIN_LOOP_DETECTION);
+  if (SConfig::GetInstance().bJITLoadForwarding)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_LOAD_FORWARDING);
 
   m_enable_blr_optimization = jo.enableBlocklink && SConfig::GetInstance().bFastmem &&
                               !SConfig::GetInstance().bEnableDebugging;
@@ -600,6 +607,10 @@ void JitArm64::Jit(u32)
 #endif
   }
 
+  for (u32 address : m_pending_slowmem_recompiles)
+    blocks.InvalidateICache(address, 4, true);
+  m_pending_slowmem_recompiles.clear();
+
   if (IsAlmostFull() || farcode.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
   {
     ClearCache();
@@ -644,7 +655,7 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
 
   js.isLastInstruction = false;
   js.firstFPInstructionFound = false;
-  js.assumeNoPairedQuantize = false;
+  js.constantGqr.clear();
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -656,6 +667,7 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
   PPCAnalyst::CodeOp* ops = code_buf->codebuffer;
 
   const u8* start = GetCodePtr();
+  const u8* far_start = farcode.GetCodePtr();
   b->checkedEntry = start;
   b->runCount = 0;
 
@@ -685,28 +697,55 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
     // get start tic
     BeginTimeProfile(b);
   }
+  if (Profiler::g_SampleBlocks)
+  {
+    ARM64Reg WA = gpr.GetReg();
+    ARM64Reg WB = gpr.GetReg();
+    ARM64Reg XA = EncodeRegTo64(WA);
+    MOVP2R(XA, &Profiler::g_sampled_block_address);
+    MOVI2R(WB, js.blockStart);
+    STR(INDEX_UNSIGNED, WB, XA, 0);
+    gpr.Unlock(WA, WB);
+  }
 
-  if (code_block.m_gqr_used.Count() == 1 &&
+  // Assume that GQRs which are used but not set by the block keep the values they have now, which
+  // lets paired loads and stores be specialized for them. The guess is checked on entry, and the
+  // block is recompiled without it if it turns out wrong.
+  const BitSet8 gqr_static = code_block.m_gqr_used & ~code_block.m_gqr_modified;
+  if (gqr_static &&
       js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
-    int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(gqr))
+    // W0 accumulates the differences from the expected values.
+    bool first = true;
+    for (int gqr : gqr_static)
     {
-      LDR(INDEX_UNSIGNED, W0, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0]) + gqr * 4);
-      FixupBranch no_fail = CBZ(W0);
-      FixupBranch fail = B();
-      SwitchToFarCode();
-      SetJumpTarget(fail);
-      MOVI2R(DISPATCHER_PC, js.blockStart);
-      STR(INDEX_UNSIGNED, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-      MOVI2R(W0, static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
-      MOVP2R(X1, &JitInterface::CompileExceptionCheck);
-      BLR(X1);
-      B(dispatcher);
-      SwitchToNearCode();
-      SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+      const u32 value = GQR(gqr);
+      js.constantGqr[gqr] = value;
+
+      ARM64Reg WA = first ? W0 : W1;
+      LDR(INDEX_UNSIGNED, WA, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0]) + gqr * 4);
+      if (value != 0)
+      {
+        MOVI2R(W2, value);
+        EOR(WA, WA, W2);
+      }
+      if (!first)
+        ORR(W0, W0, W1);
+      first = false;
     }
+
+    FixupBranch no_fail = CBZ(W0);
+    FixupBranch fail = B();
+    SwitchToFarCode();
+    SetJumpTarget(fail);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(INDEX_UNSIGNED, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVI2R(W0, static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
+    MOVP2R(X1, &JitInterface::CompileExceptionCheck);
+    BLR(X1);
+    B(dispatcher);
+    SwitchToNearCode();
+    SetJumpTarget(no_fail);
   }
 
   gpr.Start(js.gpa);
@@ -854,6 +893,7 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
   }
 
   b->codeSize = (u32)(GetCodePtr() - start);
+  b->farCodeSize = (u32)(farcode.GetCodePtr() - far_start);
   b->originalSize = code_block.m_num_instructions;
 
   FlushIcache();
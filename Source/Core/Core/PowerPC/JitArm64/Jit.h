@@ -7,10 +7,12 @@
 #include <cstddef>
 #include <map>
 #include <tuple>
+#include <vector>
 
 #include "Common/Arm64Emitter.h"
 
 #include "Core/PowerPC/CPUCoreBase.h"
+#include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/JitArm64/JitArm64Cache.h"
 #include "Core/PowerPC/JitArm64/JitArm64_RegCache.h"
 #include "Core/PowerPC/JitArmCommon/BackPatch.h"
@@ -105,9 +107,7 @@ public:
   void mcrf(UGeckoInstruction inst);
   void mcrxr(UGeckoInstruction inst);
   void mfsr(UGeckoInstruction inst);
-  void mtsr(UGeckoInstruction inst);
   void mfsrin(UGeckoInstruction inst);
-  void mtsrin(UGeckoInstruction inst);
   void twx(UGeckoInstruction inst);
   void mfspr(UGeckoInstruction inst);
   void mftb(UGeckoInstruction inst);
@@ -144,10 +144,11 @@ public:
   void ps_mulsX(UGeckoInstruction inst);
   void ps_sel(UGeckoInstruction inst);
   void ps_sumX(UGeckoInstruction inst);
+  void ps_cmpXX(UGeckoInstruction inst);
 
   // Loadstore paired
-  void psq_l(UGeckoInstruction inst);
-  void psq_st(UGeckoInstruction inst);
+  void psq_lXX(UGeckoInstruction inst);
+  void psq_stXX(UGeckoInstruction inst);
 
 private:
   struct SlowmemHandler
@@ -169,6 +170,8 @@ private:
   {
     u32 length;
     const u8* slowmem_code;
+    // The PPC instruction the access belongs to.
+    u32 guest_address;
   };
 
   static void InitializeInstructionTables();
@@ -215,6 +218,10 @@ private:
   void GenerateAsm();
   void GenerateCommonAsm();
 
+  // Loads and dequantizes one or two integers from the address in X1 to D0, multiplying them by
+  // the factor for scale, or for the scale in X0 if it is -1. Clobbers X0, X1 and Q1.
+  void GenerateQuantizedLoad(bool single, EQuantizeType type, int scale);
+
   // Profiling
   void BeginTimeProfile(JitBlock* b);
   void EndTimeProfile(JitBlock* b);
@@ -229,6 +236,9 @@ private:
 
   FixupBranch JumpIfCRFieldBit(int field, int bit, bool jump_if_set);
 
+  // Used by fcmpX and ps_cmpXX, upper compares the second elements of the pairs.
+  void FloatCompare(UGeckoInstruction inst, bool upper = false);
+
   void ComputeRC0(Arm64Gen::ARM64Reg reg);
   void ComputeRC0(u64 imm);
   void ComputeCarry(bool Carry);
@@ -258,6 +268,9 @@ private:
 
   bool m_enable_blr_optimization;
   bool m_cleanup_after_stackfault = false;
+  // Instructions which crossed the backpatch threshold; their blocks get recompiled on the next
+  // call to Jit(), since they may still be running when the fault is handled.
+  std::vector<u32> m_pending_slowmem_recompiles;
   u8* m_stack_base = nullptr;
   u8* m_stack_pointer = nullptr;
   u8* m_saved_stack_pointer = nullptr;
@@ -19,6 +19,10 @@
 
 using namespace Arm64Gen;
 
+// How many times the fastmem access of an instruction may be backpatched to slowmem before its
+// block is recompiled with an explicit check for non-RAM addresses.
+constexpr u32 BACKPATCH_SLOWMEM_CHECK_THRESHOLD = 2;
+
 void JitArm64::DoBacktrace(uintptr_t access_address, SContext* ctx)
 {
   for (int i = 0; i < 30; i += 2)
@@ -50,6 +54,20 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
                                     ARM64Reg addr, BitSet32 gprs_to_push, BitSet32 fprs_to_push)
 {
   bool in_far_code = false;
+
+  // Instructions which keep faulting mostly access MMIO, so only let addresses in the cached RAM
+  // mirrors (0x8xxxxxxx and 0x9xxxxxxx) take the fastmem path, and call the slowmem handler
+  // directly for the rest instead of going through a fault.
+  const bool check_address =
+      fastmem && do_farcode && js.slowmemCheckAddresses.count(js.compilerPC) != 0;
+  FixupBranch slowmem_branch;
+  if (check_address)
+  {
+    LSR(W30, DecodeReg(addr), 29);
+    CMP(W30, 4);
+    slowmem_branch = B(CC_NEQ);
+  }
+
   const u8* fastmem_start = GetCodePtr();
 
   if (fastmem)
@@ -154,6 +172,7 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
       handler.flags = flags;
 
       FastmemArea* fastmem_area = &m_fault_to_handler[fastmem_start];
+      fastmem_area->guest_address = js.compilerPC;
       auto handler_loc_iter = m_handler_to_loc.find(handler);
 
       if (handler_loc_iter == m_handler_to_loc.end())
@@ -164,12 +183,28 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
         m_handler_to_loc[handler] = handler_loc;
         fastmem_area->slowmem_code = handler_loc;
         fastmem_area->length = fastmem_end - fastmem_start;
+        if (check_address)
+        {
+          SwitchToNearCode();
+          FixupBranch done = B();
+          SetJumpTarget(slowmem_branch);
+          BL(handler_loc);
+          SetJumpTarget(done);
+          SwitchToFarCode();
+        }
       }
       else
       {
         const u8* handler_loc = handler_loc_iter->second;
         fastmem_area->slowmem_code = handler_loc;
         fastmem_area->length = fastmem_end - fastmem_start;
+        if (check_address)
+        {
+          FixupBranch done = B();
+          SetJumpTarget(slowmem_branch);
+          BL(handler_loc);
+          SetJumpTarget(done);
+        }
         return;
       }
     }
@@ -317,9 +352,18 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
   for (u32 i = 0; i < num_insts_max; ++i)
     emitter.HINT(HINT_NOP);
 
+  const u32 guest_address = slow_handler_iter->second.guest_address;
+  const u8* fault_location = slow_handler_iter->first;
   m_fault_to_handler.erase(slow_handler_iter);
 
+  // If this instruction keeps ending up in slowmem, recompile its block with the address check.
+  if (++js.backpatchCounts[guest_address] >= BACKPATCH_SLOWMEM_CHECK_THRESHOLD &&
+      js.slowmemCheckAddresses.insert(guest_address).second)
+  {
+    m_pending_slowmem_recompiles.push_back(guest_address);
+  }
+
   emitter.FlushIcache();
-  ctx->CTX_PC = (u64)slow_handler_iter->first;
+  ctx->CTX_PC = (u64)fault_location;
   return true;
 }
@@ -252,21 +252,43 @@ void JitArm64::frspx(UGeckoInstruction inst)
   }
 }
 
-void JitArm64::fcmpX(UGeckoInstruction inst)
+void JitArm64::FloatCompare(UGeckoInstruction inst, bool upper)
 {
-  INSTRUCTION_START
-  JITDISABLE(bJITFloatingPointOff);
-  FALLBACK_IF(SConfig::GetInstance().bFPRF && js.op->wantsFPRF);
-
   u32 a = inst.FA, b = inst.FB;
   int crf = inst.CRFD;
 
-  bool singles = fpr.IsSingle(a, true) && fpr.IsSingle(b, true);
-  RegType type = singles ? REG_LOWER_PAIR_SINGLE : REG_LOWER_PAIR;
+  bool singles = fpr.IsSingle(a, !upper) && fpr.IsSingle(b, !upper);
   ARM64Reg (*reg_encoder)(ARM64Reg) = singles ? EncodeRegToSingle : EncodeRegToDouble;
 
-  ARM64Reg VA = reg_encoder(fpr.R(a, type));
-  ARM64Reg VB = reg_encoder(fpr.R(b, type));
+  ARM64Reg VA, VB;
+  ARM64Reg V0 = INVALID_REG, V1 = INVALID_REG;
+  if (upper)
+  {
+    // Move the second elements down to the first element of temporaries, which FCMP compares.
+    RegType type = singles ? REG_REG_SINGLE : REG_REG;
+    u8 size = singles ? 32 : 64;
+    ARM64Reg (*vector_encoder)(ARM64Reg) = singles ? EncodeRegToDouble : EncodeRegToQuad;
+
+    V0 = fpr.GetReg();
+    m_float_emit.DUP(size, vector_encoder(V0), vector_encoder(fpr.R(a, type)), 1);
+    VA = reg_encoder(V0);
+    if (a != b)
+    {
+      V1 = fpr.GetReg();
+      m_float_emit.DUP(size, vector_encoder(V1), vector_encoder(fpr.R(b, type)), 1);
+      VB = reg_encoder(V1);
+    }
+    else
+    {
+      VB = VA;
+    }
+  }
+  else
+  {
+    RegType type = singles ? REG_LOWER_PAIR_SINGLE : REG_LOWER_PAIR;
+    VA = reg_encoder(fpr.R(a, type));
+    VB = reg_encoder(fpr.R(b, type));
+  }
 
   gpr.BindCRToRegister(crf, false);
   ARM64Reg XA = gpr.CR(crf);
@@ -312,6 +334,20 @@ void JitArm64::fcmpX(UGeckoInstruction inst)
     SetJumpTarget(continue3);
   }
   SetJumpTarget(continue1);
+
+  if (V0 != INVALID_REG)
+    fpr.Unlock(V0);
+  if (V1 != INVALID_REG)
+    fpr.Unlock(V1);
+}
+
+void JitArm64::fcmpX(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITFloatingPointOff);
+  FALLBACK_IF(SConfig::GetInstance().bFPRF && js.op->wantsFPRF);
+
+  FloatCompare(inst);
 }
 
 void JitArm64::fctiwzx(UGeckoInstruction inst)
@@ -353,6 +353,25 @@ void JitArm64::lXX(UGeckoInstruction inst)
     break;
   }
 
+  // The value is still in a register from an earlier access to the same stack slot.
+  if (js.op->loadForwardedFrom >= 0)
+  {
+    const u32 s = js.op->loadForwardedFrom;
+    if (s != d)
+    {
+      if (gpr.IsImm(s))
+      {
+        gpr.SetImmediate(d, gpr.GetImm(s));
+      }
+      else
+      {
+        gpr.BindToRegister(d, false);
+        MOV(gpr.R(d), gpr.R(s));
+      }
+    }
+    return;
+  }
+
   SafeLoadToReg(d, update ? a : (a ? a : -1), offsetReg, flags, offset, update);
 
   // LWZ idle skipping
@@ -562,6 +581,7 @@ void JitArm64::dcbx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITLoadStoreOff);
+  FALLBACK_IF(jo.accurateCpuCache);
 
   gpr.Lock(W30);
 
@@ -627,8 +647,9 @@ void JitArm64::dcbt(UGeckoInstruction inst)
   // This is important because invalidating the block cache when we don't
   // need to is terrible for performance.
   // (Invalidating the jit block cache on dcbst is a heuristic.)
-  if (CanMergeNextInstructions(1) && js.op[1].inst.OPCD == 31 && js.op[1].inst.SUBOP10 == 54 &&
-      js.op[1].inst.RA == inst.RA && js.op[1].inst.RB == inst.RB)
+  // With data cache emulation, the dcbst has to write the line back, so it can't be skipped.
+  if (!jo.accurateCpuCache && CanMergeNextInstructions(1) && js.op[1].inst.OPCD == 31 &&
+      js.op[1].inst.SUBOP10 == 54 && js.op[1].inst.RA == inst.RA && js.op[1].inst.RB == inst.RB)
   {
     js.skipInstructions = 1;
   }
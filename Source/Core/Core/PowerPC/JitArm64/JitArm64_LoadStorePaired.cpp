@@ -16,7 +16,7 @@
 
 using namespace Arm64Gen;
 
-void JitArm64::psq_l(UGeckoInstruction inst)
+void JitArm64::psq_lXX(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
@@ -31,8 +31,18 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   // X2 is a temporary
   // Q0 is the return register
   // Q1 is a temporary
-  bool update = inst.OPCD == 57;
+  bool indexed = inst.OPCD == 4;
+  bool update = inst.OPCD == 57 || (indexed && !!(inst.SUBOP6 & 32));
   s32 offset = inst.SIMM_12;
+  int i = indexed ? inst.Ix : inst.I;
+  int w = indexed ? inst.Wx : inst.W;
+
+  auto it = js.constantGqr.find(i);
+  bool gqr_is_constant = it != js.constantGqr.end();
+  u32 gqr_value = gqr_is_constant ? it->second >> 16 : 0;
+  EQuantizeType type = static_cast<EQuantizeType>(gqr_value & 0x7);
+  bool type_is_valid =
+      type != QUANTIZE_INVALID1 && type != QUANTIZE_INVALID2 && type != QUANTIZE_INVALID3;
 
   gpr.Lock(W0, W1, W2, W30);
   fpr.Lock(Q0, Q1);
@@ -43,7 +53,14 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   ARM64Reg type_reg = W2;
   ARM64Reg VS;
 
-  if (inst.RA || update)  // Always uses the register on update
+  if (indexed)
+  {
+    if (inst.RA || update)  // Always uses the register on update
+      ADD(addr_reg, arm_addr, gpr.R(inst.RB));
+    else
+      MOV(addr_reg, gpr.R(inst.RB));
+  }
+  else if (inst.RA || update)  // Always uses the register on update
   {
     if (offset >= 0)
       ADD(addr_reg, arm_addr, offset);
@@ -61,10 +78,10 @@ void JitArm64::psq_l(UGeckoInstruction inst)
     MOV(arm_addr, addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (gqr_is_constant && type == QUANTIZE_FLOAT)
   {
     VS = fpr.RW(inst.RS, REG_REG_SINGLE);
-    if (!inst.W)
+    if (!w)
     {
       ADD(EncodeRegTo64(addr_reg), EncodeRegTo64(addr_reg), MEM_REG);
       m_float_emit.LD1(32, 1, EncodeRegToDouble(VS), EncodeRegTo64(addr_reg));
@@ -77,19 +94,27 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   }
   else
   {
-    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
-    UBFM(type_reg, scale_reg, 16, 18);   // Type
-    UBFM(scale_reg, scale_reg, 24, 29);  // Scale
+    if (gqr_is_constant && type_is_valid)
+    {
+      // The dequantization is emitted inline for the known type and scale.
+      GenerateQuantizedLoad(w == 1, type, (gqr_value >> 8) & 0x3F);
+    }
+    else
+    {
+      LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0]) + i * 4);
+      UBFM(type_reg, scale_reg, 16, 18);   // Type
+      UBFM(scale_reg, scale_reg, 24, 29);  // Scale
 
-    MOVP2R(X30, inst.W ? singleLoadQuantized : pairedLoadQuantized);
-    LDR(X30, X30, ArithOption(EncodeRegTo64(type_reg), true));
-    BLR(X30);
+      MOVP2R(X30, w ? singleLoadQuantized : pairedLoadQuantized);
+      LDR(X30, X30, ArithOption(EncodeRegTo64(type_reg), true));
+      BLR(X30);
+    }
 
     VS = fpr.RW(inst.RS, REG_REG_SINGLE);
     m_float_emit.ORR(EncodeRegToDouble(VS), D0, D0);
   }
 
-  if (inst.W)
+  if (w)
   {
     m_float_emit.FMOV(S0, 0x70);  // 1.0 as a Single
     m_float_emit.INS(32, VS, 1, Q0, 0);
@@ -99,7 +124,7 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   fpr.Unlock(Q0, Q1);
 }
 
-void JitArm64::psq_st(UGeckoInstruction inst)
+void JitArm64::psq_stXX(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
@@ -113,8 +138,16 @@ void JitArm64::psq_st(UGeckoInstruction inst)
   // X1 is the address
   // Q0 is the store register
 
-  bool update = inst.OPCD == 61;
+  bool indexed = inst.OPCD == 4;
+  bool update = inst.OPCD == 61 || (indexed && !!(inst.SUBOP6 & 32));
   s32 offset = inst.SIMM_12;
+  int i = indexed ? inst.Ix : inst.I;
+  int w = indexed ? inst.Wx : inst.W;
+
+  auto it = js.constantGqr.find(i);
+  bool gqr_is_constant = it != js.constantGqr.end();
+  u32 gqr_value = gqr_is_constant ? it->second & 0xFFFF : 0;
+  u32 type = gqr_value & 0x7;
 
   gpr.Lock(W0, W1, W2, W30);
   fpr.Lock(Q0, Q1);
@@ -135,7 +168,14 @@ void JitArm64::psq_st(UGeckoInstruction inst)
   gprs_in_use &= BitSet32(~7);
   fprs_in_use &= BitSet32(~3);
 
-  if (inst.RA || update)  // Always uses the register on update
+  if (indexed)
+  {
+    if (inst.RA || update)  // Always uses the register on update
+      ADD(addr_reg, gpr.R(inst.RA), gpr.R(inst.RB));
+    else
+      MOV(addr_reg, gpr.R(inst.RB));
+  }
+  else if (inst.RA || update)  // Always uses the register on update
   {
     if (offset >= 0)
       ADD(addr_reg, gpr.R(inst.RA), offset);
@@ -153,14 +193,14 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     MOV(arm_addr, addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (gqr_is_constant && type == QUANTIZE_FLOAT)
   {
     u32 flags = BackPatchInfo::FLAG_STORE;
 
     if (single)
-      flags |= (inst.W ? BackPatchInfo::FLAG_SIZE_F32I : BackPatchInfo::FLAG_SIZE_F32X2I);
+      flags |= (w ? BackPatchInfo::FLAG_SIZE_F32I : BackPatchInfo::FLAG_SIZE_F32X2I);
     else
-      flags |= (inst.W ? BackPatchInfo::FLAG_SIZE_F32 : BackPatchInfo::FLAG_SIZE_F32X2);
+      flags |= (w ? BackPatchInfo::FLAG_SIZE_F32 : BackPatchInfo::FLAG_SIZE_F32X2);
 
     EmitBackpatchRoutine(flags, jo.fastmem, jo.fastmem, VS, EncodeRegTo64(addr_reg), gprs_in_use,
                          fprs_in_use);
@@ -173,15 +213,23 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     }
     else
     {
-      if (inst.W)
+      if (w)
         m_float_emit.FCVT(32, 64, D0, VS);
       else
         m_float_emit.FCVTN(32, D0, VS);
     }
 
-    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
-    UBFM(type_reg, scale_reg, 0, 2);    // Type
-    UBFM(scale_reg, scale_reg, 8, 13);  // Scale
+    if (gqr_is_constant)
+    {
+      // With a known type, the routine for it is called directly.
+      MOVI2R(scale_reg, (gqr_value >> 8) & 0x3F);
+    }
+    else
+    {
+      LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0]) + i * 4);
+      UBFM(type_reg, scale_reg, 0, 2);    // Type
+      UBFM(scale_reg, scale_reg, 8, 13);  // Scale
+    }
 
     // Inline address check
     // FIXME: This doesn't correctly account for the BAT configuration.
@@ -192,8 +240,15 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     SwitchToFarCode();
     SetJumpTarget(fail);
     // Slow
-    MOVP2R(X30, &pairedStoreQuantized[16 + inst.W * 8]);
-    LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
+    if (gqr_is_constant)
+    {
+      MOVP2R(EncodeRegTo64(type_reg), pairedStoreQuantized[16 + w * 8 + type]);
+    }
+    else
+    {
+      MOVP2R(X30, &pairedStoreQuantized[16 + w * 8]);
+      LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
+    }
 
     ABI_PushRegisters(gprs_in_use);
     m_float_emit.ABI_PushRegisters(fprs_in_use, X30);
@@ -205,8 +260,15 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     SetJumpTarget(pass);
 
     // Fast
-    MOVP2R(X30, &pairedStoreQuantized[inst.W * 8]);
-    LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
+    if (gqr_is_constant)
+    {
+      MOVP2R(EncodeRegTo64(type_reg), pairedStoreQuantized[w * 8 + type]);
+    }
+    else
+    {
+      MOVP2R(X30, &pairedStoreQuantized[w * 8]);
+      LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
+    }
     BLR(EncodeRegTo64(type_reg));
 
     SetJumpTarget(continue1);
@@ -224,3 +224,13 @@ void JitArm64::ps_sumX(UGeckoInstruction inst)
 
   fpr.Unlock(V0);
 }
+
+void JitArm64::ps_cmpXX(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITPairedOff);
+  FALLBACK_IF(SConfig::GetInstance().bFPRF && js.op->wantsFPRF);
+
+  // ps_cmpu1 and ps_cmpo1 compare the second elements.
+  FloatCompare(inst, !!(inst.SUBOP10 & 64));
+}
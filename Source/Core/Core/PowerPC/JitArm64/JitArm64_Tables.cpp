@@ -5,8 +5,10 @@
 #include "Core/PowerPC/JitArm64/Jit.h"
 
 #include <cstring>
+#include "Common/PerformanceCounter.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/PPCTables.h"
+#include "Core/PowerPC/Profiler.h"
 
 // Should be moved in to the Jit class
 typedef void (JitArm64::*_Instruction)(UGeckoInstruction instCode);
@@ -111,28 +113,28 @@ constexpr GekkoOPTemplate primarytable[] = {
     {54, &JitArm64::stfXX},  // stfd
     {55, &JitArm64::stfXX},  // stfdu
 
-    {56, &JitArm64::psq_l},   // psq_l
-    {57, &JitArm64::psq_l},   // psq_lu
-    {60, &JitArm64::psq_st},  // psq_st
-    {61, &JitArm64::psq_st},  // psq_stu
+    {56, &JitArm64::psq_lXX},   // psq_l
+    {57, &JitArm64::psq_lXX},   // psq_lu
+    {60, &JitArm64::psq_stXX},  // psq_st
+    {61, &JitArm64::psq_stXX},  // psq_stu
 
     // missing: 0, 1, 2, 5, 6, 9, 22, 30, 62, 58
 };
 
 constexpr GekkoOPTemplate table4[] = {
     // SUBOP10
-    {0, &JitArm64::FallBackToInterpreter},   // ps_cmpu0
-    {32, &JitArm64::FallBackToInterpreter},  // ps_cmpo0
-    {40, &JitArm64::fp_logic},               // ps_neg
-    {136, &JitArm64::fp_logic},              // ps_nabs
-    {264, &JitArm64::fp_logic},              // ps_abs
-    {64, &JitArm64::FallBackToInterpreter},  // ps_cmpu1
-    {72, &JitArm64::fp_logic},               // ps_mr
-    {96, &JitArm64::FallBackToInterpreter},  // ps_cmpo1
-    {528, &JitArm64::ps_mergeXX},            // ps_merge00
-    {560, &JitArm64::ps_mergeXX},            // ps_merge01
-    {592, &JitArm64::ps_mergeXX},            // ps_merge10
-    {624, &JitArm64::ps_mergeXX},            // ps_merge11
+    {0, &JitArm64::ps_cmpXX},      // ps_cmpu0
+    {32, &JitArm64::ps_cmpXX},     // ps_cmpo0
+    {40, &JitArm64::fp_logic},     // ps_neg
+    {136, &JitArm64::fp_logic},    // ps_nabs
+    {264, &JitArm64::fp_logic},    // ps_abs
+    {64, &JitArm64::ps_cmpXX},     // ps_cmpu1
+    {72, &JitArm64::fp_logic},     // ps_mr
+    {96, &JitArm64::ps_cmpXX},     // ps_cmpo1
+    {528, &JitArm64::ps_mergeXX},  // ps_merge00
+    {560, &JitArm64::ps_mergeXX},  // ps_merge01
+    {592, &JitArm64::ps_mergeXX},  // ps_merge10
+    {624, &JitArm64::ps_mergeXX},  // ps_merge11
 
     {1014, &JitArm64::FallBackToInterpreter},  // dcbz_l
 };
@@ -158,10 +160,10 @@ constexpr GekkoOPTemplate table4_2[] = {
 };
 
 constexpr GekkoOPTemplate table4_3[] = {
-    {6, &JitArm64::FallBackToInterpreter},   // psq_lx
-    {7, &JitArm64::FallBackToInterpreter},   // psq_stx
-    {38, &JitArm64::FallBackToInterpreter},  // psq_lux
-    {39, &JitArm64::FallBackToInterpreter},  // psq_stux
+    {6, &JitArm64::psq_lXX},    // psq_lx
+    {7, &JitArm64::psq_stXX},   // psq_stx
+    {38, &JitArm64::psq_lXX},   // psq_lux
+    {39, &JitArm64::psq_stXX},  // psq_stux
 };
 
 constexpr GekkoOPTemplate table19[] = {
@@ -303,8 +305,8 @@ constexpr GekkoOPTemplate table31[] = {
     {83, &JitArm64::mfmsr},    // mfmsr
     {144, &JitArm64::mtcrf},   // mtcrf
     {146, &JitArm64::mtmsr},   // mtmsr
-    {210, &JitArm64::mtsr},    // mtsr
-    {242, &JitArm64::mtsrin},  // mtsrin
+    {210, &JitArm64::FallBackToInterpreter},  // mtsr
+    {242, &JitArm64::FallBackToInterpreter},  // mtsrin
     {339, &JitArm64::mfspr},   // mfspr
     {467, &JitArm64::mtspr},   // mtspr
     {371, &JitArm64::mftb},    // mftb
@@ -370,9 +372,28 @@ constexpr GekkoOPTemplate table63_2[] = {
 
 void JitArm64::CompileInstruction(PPCAnalyst::CodeOp& op)
 {
-  (this->*dynaOpTable[op.inst.OPCD])(op.inst);
-
   GekkoOPInfo* info = op.opinfo;
+  if (Profiler::g_ProfileBlocks && info)
+  {
+    const u8* near_start = GetCodePtr();
+    const u8* far_start = farcode.GetCodePtr();
+    u64 ticks_start;
+    QueryPerformanceCounter((LARGE_INTEGER*)&ticks_start);
+
+    (this->*dynaOpTable[op.inst.OPCD])(op.inst);
+
+    u64 ticks_end;
+    QueryPerformanceCounter((LARGE_INTEGER*)&ticks_end);
+    info->emittedBytes += GetCodePtr() - near_start;
+    info->emittedFarBytes += farcode.GetCodePtr() - far_start;
+    info->emitCount++;
+    info->emitTicks += ticks_end - ticks_start;
+  }
+  else
+  {
+    (this->*dynaOpTable[op.inst.OPCD])(op.inst);
+  }
+
   if (info)
   {
 #ifdef OPLOG
@@ -13,6 +13,7 @@
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/Profiler.h"
 
 using namespace Arm64Gen;
 
@@ -162,6 +163,9 @@ void JitArm64::GenerateAsm()
   FixupBranch Exit = B(CC_NEQ);
 
   SetJumpTarget(to_start_of_timing_slice);
+  // Don't let the sampling profiler attribute CoreTiming to the last block.
+  MOVP2R(X30, &Profiler::g_sampled_block_address);
+  STR(INDEX_UNSIGNED, WZR, X30, 0);
   MOVP2R(X30, &CoreTiming::Advance);
   BLR(X30);
 
@@ -189,6 +193,57 @@ void JitArm64::GenerateAsm()
   FlushIcache();
 }
 
+void JitArm64::GenerateQuantizedLoad(bool single, EQuantizeType type, int scale)
+{
+  ARM64Reg addr_reg = X1;
+  ARM64Reg scale_reg = X0;
+  const bool is_signed = type == QUANTIZE_S8 || type == QUANTIZE_S16;
+
+  ADD(addr_reg, addr_reg, MEM_REG);
+  if (type == QUANTIZE_U8 || type == QUANTIZE_S8)
+  {
+    m_float_emit.LDR(single ? 8 : 16, INDEX_UNSIGNED, D0, addr_reg, 0);
+    if (is_signed)
+      m_float_emit.SXTL(8, D0, D0);
+    else
+      m_float_emit.UXTL(8, D0, D0);
+  }
+  else
+  {
+    if (single)
+      m_float_emit.LDR(16, INDEX_UNSIGNED, D0, addr_reg, 0);
+    else
+      m_float_emit.LD1(16, 1, D0, addr_reg);
+    m_float_emit.REV16(8, D0, D0);
+  }
+
+  if (is_signed)
+  {
+    m_float_emit.SXTL(16, D0, D0);
+    m_float_emit.SCVTF(32, D0, D0);
+  }
+  else
+  {
+    m_float_emit.UXTL(16, D0, D0);
+    m_float_emit.UCVTF(32, D0, D0);
+  }
+
+  if (scale == -1)
+  {
+    MOVP2R(addr_reg, &m_dequantizeTableS);
+    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
+    m_float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
+    m_float_emit.FMUL(32, D0, D0, D1, 0);
+  }
+  else if (scale != 0)
+  {
+    // The factor for a scale of zero is 1.
+    MOVP2R(addr_reg, &m_dequantizeTableS[scale * 2]);
+    m_float_emit.LDR(32, INDEX_UNSIGNED, D1, addr_reg, 0);
+    m_float_emit.FMUL(32, D0, D0, D1, 0);
+  }
+}
+
 void JitArm64::GenerateCommonAsm()
 {
   // X0 is the scale
@@ -214,58 +269,22 @@ void JitArm64::GenerateCommonAsm()
   }
   const u8* loadPairedU8Two = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LDR(16, INDEX_UNSIGNED, D0, addr_reg, 0);
-    float_emit.UXTL(8, D0, D0);
-    float_emit.UXTL(16, D0, D0);
-    float_emit.UCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(false, QUANTIZE_U8, -1);
     RET(X30);
   }
   const u8* loadPairedS8Two = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LDR(16, INDEX_UNSIGNED, D0, addr_reg, 0);
-    float_emit.SXTL(8, D0, D0);
-    float_emit.SXTL(16, D0, D0);
-    float_emit.SCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(false, QUANTIZE_S8, -1);
     RET(X30);
   }
   const u8* loadPairedU16Two = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LD1(16, 1, D0, addr_reg);
-    float_emit.REV16(8, D0, D0);
-    float_emit.UXTL(16, D0, D0);
-    float_emit.UCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(false, QUANTIZE_U16, -1);
     RET(X30);
   }
   const u8* loadPairedS16Two = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LD1(16, 1, D0, addr_reg);
-    float_emit.REV16(8, D0, D0);
-    float_emit.SXTL(16, D0, D0);
-    float_emit.SCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(false, QUANTIZE_S16, -1);
     RET(X30);
   }
 
@@ -278,58 +297,22 @@ void JitArm64::GenerateCommonAsm()
   }
   const u8* loadPairedU8One = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LDR(8, INDEX_UNSIGNED, D0, addr_reg, 0);
-    float_emit.UXTL(8, D0, D0);
-    float_emit.UXTL(16, D0, D0);
-    float_emit.UCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(true, QUANTIZE_U8, -1);
     RET(X30);
   }
   const u8* loadPairedS8One = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LDR(8, INDEX_UNSIGNED, D0, addr_reg, 0);
-    float_emit.SXTL(8, D0, D0);
-    float_emit.SXTL(16, D0, D0);
-    float_emit.SCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(true, QUANTIZE_S8, -1);
     RET(X30);
   }
   const u8* loadPairedU16One = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LDR(16, INDEX_UNSIGNED, D0, addr_reg, 0);
-    float_emit.REV16(8, D0, D0);
-    float_emit.UXTL(16, D0, D0);
-    float_emit.UCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(true, QUANTIZE_U16, -1);
     RET(X30);
   }
   const u8* loadPairedS16One = GetCodePtr();
   {
-    ADD(addr_reg, addr_reg, MEM_REG);
-    float_emit.LDR(16, INDEX_UNSIGNED, D0, addr_reg, 0);
-    float_emit.REV16(8, D0, D0);
-    float_emit.SXTL(16, D0, D0);
-    float_emit.SCVTF(32, D0, D0);
-
-    MOVP2R(addr_reg, &m_dequantizeTableS);
-    ADD(scale_reg, addr_reg, scale_reg, ArithOption(scale_reg, ST_LSL, 3));
-    float_emit.LDR(32, INDEX_UNSIGNED, D1, scale_reg, 0);
-    float_emit.FMUL(32, D0, D0, D1, 0);
+    GenerateQuantizedLoad(true, QUANTIZE_S16, -1);
     RET(X30);
   }
 
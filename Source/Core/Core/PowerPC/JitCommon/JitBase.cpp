@@ -46,6 +46,10 @@ bool JitBase::CanMergeNextInstructions(int count) const
 void JitBase::UpdateMemoryOptions()
 {
   bool any_watchpoints = PowerPC::memchecks.HasAny();
-  jo.fastmem = SConfig::GetInstance().bFastmem && (UReg_MSR(MSR).DR || !any_watchpoints);
-  jo.memcheck = SConfig::GetInstance().bMMU || any_watchpoints;
+  // Loads and stores have to reach the MMU to go through the emulated data cache, so it needs the
+  // same paths as memchecks.
+  jo.accurateCpuCache = SConfig::GetInstance().bAccurateCPUCache;
+  jo.fastmem = SConfig::GetInstance().bFastmem && !jo.accurateCpuCache &&
+               (UReg_MSR(MSR).DR || !any_watchpoints);
+  jo.memcheck = SConfig::GetInstance().bMMU || any_watchpoints || jo.accurateCpuCache;
 }
@@ -9,7 +9,9 @@
 //#define JIT_LOG_FPR     // Enables logging of the PPC floating point regs
 
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
@@ -18,6 +20,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 // Use these to control the instruction selection
@@ -52,7 +55,27 @@ protected:
     bool accurateSinglePrecision;
     bool fastmem;
     bool memcheck;
+    bool accurateCpuCache;
   };
+  // Execution counts of a conditional branch, used to find branches which are worth following
+  // when forming superblocks.
+  struct BranchStats
+  {
+    u32 executed = 0;
+    u32 taken = 0;
+  };
+  // The targets of an indirect branch (bcctr), used to compile it with an inline cache for the
+  // target it usually goes to. Hits and misses are counted since the target was last chosen.
+  struct IndirectBranchStats
+  {
+    // The expected target, or 0 if the branch hasn't been profiled yet.
+    u32 target = 0;
+    // How often a new target was chosen. Branches which need too many aren't cached any more.
+    u32 retargets = 0;
+    u64 hits = 0;
+    u64 misses = 0;
+  };
+
   struct JitState
   {
     u32 compilerPC;
@@ -74,15 +97,20 @@ protected:
     int revertGprLoad;
     int revertFprLoad;
 
-    bool assumeNoPairedQuantize;
     std::map<u8, u32> constantGqr;
     bool firstFPInstructionFound;
     bool isLastInstruction;
     int skipInstructions;
     bool carryFlagSet;
     bool carryFlagInverted;
+    // The FPSCR NI and RN bits (which determine the host rounding and flush-to-zero mode) as
+    // last set by the block, or -1 if they aren't known at this point.
+    int fpscrRoundingMode;
 
     bool generatingTrampoline = false;
+    // Set when compiling the first tier of a block with tiered compilation: every instruction
+    // falls back to the interpreter, and the block counts its executions before it's recompiled.
+    bool interpretedBlock = false;
     u8* trampolineExceptionHandler;
 
     bool mustCheckFifo;
@@ -99,6 +127,21 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // With tiered compilation, blocks which have run often enough to be worth optimizing.
+    std::unordered_set<u32> hotBlockAddresses;
+    // With superblocks, the profile of conditional branches, and the ones which turned out to be
+    // nearly always taken.
+    std::unordered_map<u32, BranchStats> branchStats;
+    std::unordered_set<u32> likelyTakenBranches;
+    // The inline caches of indirect branches, see Jit64::WriteIndirectBranchExit.
+    std::unordered_map<u32, IndirectBranchStats> indirectBranchStats;
+    // How often the fastmem access of each instruction faulted and was backpatched to slowmem,
+    // and the instructions which did so often enough to be compiled with a check for non-RAM
+    // addresses instead.
+    std::unordered_map<u32, u32> backpatchCounts;
+    std::unordered_set<u32> slowmemCheckAddresses;
+    // The warm-up list the session started with; see JitInterface::ReadWarmupList.
+    std::vector<JitInterface::BlockEntryPoint> warmupBlocks;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -0,0 +1,126 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitBlockDiskCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+
+class JitBlockDiskCache::Reader final : public LinearDiskCacheReader<Entry, u8>
+{
+public:
+  explicit Reader(JitBlockDiskCache& cache) : m_cache(cache) {}
+  void Read(const Entry& key, const u8* value, u32 value_size) override
+  {
+    if (m_cache.m_known_entries.insert(GetKey(key)).second)
+      m_cache.m_pending.push_back(key);
+  }
+
+private:
+  JitBlockDiskCache& m_cache;
+};
+
+std::string JitBlockDiskCache::GetFileName(const std::string& jit_name)
+{
+  const std::string dir = File::GetUserPath(D_CACHE_IDX) + JITCACHE_DIR DIR_SEP;
+  if (!File::Exists(dir))
+    File::CreateDir(dir);
+
+  return dir + jit_name + '-' + SConfig::GetInstance().GetGameID() + ".cache";
+}
+
+void JitBlockDiskCache::Open(const std::string& jit_name)
+{
+  Close();
+
+  Reader reader(*this);
+  const std::string filename = GetFileName(jit_name);
+  const u32 count = m_file.OpenAndRead(filename, reader);
+  m_is_open = true;
+
+  // Group the entries by MSR bits, but keep them in the order they were first compiled in.
+  std::stable_sort(m_pending.begin(), m_pending.end(),
+                   [](const Entry& a, const Entry& b) { return a.msr_bits < b.msr_bits; });
+
+  INFO_LOG(DYNA_REC, "Loaded %u JIT block cache entries from %s", count, filename.c_str());
+}
+
+void JitBlockDiskCache::Close()
+{
+  if (m_is_open)
+  {
+    m_file.Sync();
+    m_file.Close();
+  }
+
+  m_known_entries.clear();
+  m_pending.clear();
+  m_is_open = false;
+}
+
+void JitBlockDiskCache::Record(u32 em_address, u32 msr_bits, const PPCAnalyst::CodeBlock& block,
+                               const PPCAnalyst::CodeBuffer& buffer)
+{
+  if (!m_is_open)
+    return;
+
+  const Entry entry = MakeEntry(em_address, msr_bits, block, buffer);
+  if (m_known_entries.insert(GetKey(entry)).second)
+    m_file.Append(entry, nullptr, 0);
+}
+
+std::vector<JitBlockDiskCache::Entry> JitBlockDiskCache::TakePendingEntries()
+{
+  std::vector<Entry> entries;
+  entries.swap(m_pending);
+  return entries;
+}
+
+bool JitBlockDiskCache::Matches(const Entry& entry, const PPCAnalyst::CodeBlock& block,
+                                const PPCAnalyst::CodeBuffer& buffer)
+{
+  const Entry current = MakeEntry(entry.effective_address, entry.msr_bits, block, buffer);
+  return std::memcmp(&current, &entry, sizeof(Entry)) == 0;
+}
+
+JitBlockDiskCache::Entry JitBlockDiskCache::MakeEntry(u32 em_address, u32 msr_bits,
+                                                      const PPCAnalyst::CodeBlock& block,
+                                                      const PPCAnalyst::CodeBuffer& buffer)
+{
+  // Include the addresses as well as the instructions, so that a block which follows a branch
+  // to a different location is not mistaken for the original one.
+  std::vector<u32> code;
+  code.reserve(block.m_num_instructions * 2);
+  for (u32 i = 0; i < block.m_num_instructions; ++i)
+  {
+    code.push_back(buffer.codebuffer[i].address);
+    code.push_back(buffer.codebuffer[i].inst.hex);
+  }
+
+  Entry entry = {};
+  entry.effective_address = em_address;
+  entry.msr_bits = msr_bits;
+  entry.num_instructions = block.m_num_instructions;
+  entry.code_hash =
+      HashAdler32(reinterpret_cast<const u8*>(code.data()), code.size() * sizeof(u32));
+  entry.gqr_used = block.m_gqr_used.m_val;
+  entry.gqr_modified = block.m_gqr_modified.m_val;
+  entry.broken = block.m_broken;
+  return entry;
+}
+
+JitBlockDiskCache::EntryKey JitBlockDiskCache::GetKey(const Entry& entry)
+{
+  return std::make_tuple(entry.effective_address, entry.msr_bits, entry.num_instructions,
+                         entry.code_hash);
+}
@@ -0,0 +1,78 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+namespace PPCAnalyst
+{
+class CodeBuffer;
+struct CodeBlock;
+}
+
+// Remembers which blocks the JIT compiled for a given title, so that the next boot of the same
+// title can compile them up front instead of stalling on the first execution of each of them.
+//
+// Only the block entry points and a summary of the analysis are stored. The guest code is always
+// re-analyzed before compiling, and a block is only compiled if the result still matches what was
+// recorded, so stale entries (e.g. overlays that have since been replaced) are harmless.
+class JitBlockDiskCache
+{
+public:
+  struct Entry
+  {
+    // The effective address (PC) for the beginning of the block.
+    u32 effective_address;
+    // The MSR bits the block was compiled with; see JitBaseBlockCache::JIT_CACHE_MSR_MASK.
+    u32 msr_bits;
+    // The number of PPC instructions the analyzer put in the block.
+    u32 num_instructions;
+    // Hash of the addresses and instruction words of the block.
+    u32 code_hash;
+    u8 gqr_used;
+    u8 gqr_modified;
+    u8 broken;
+    u8 padding;
+  };
+
+  // Opens (or creates) the cache file for the running title and loads its entries. The file
+  // stays open so that newly compiled blocks can be appended to it.
+  void Open(const std::string& jit_name);
+  void Close();
+  bool IsOpen() const { return m_is_open; }
+
+  // Appends the block to the cache file, unless an identical entry is already known.
+  void Record(u32 em_address, u32 msr_bits, const PPCAnalyst::CodeBlock& block,
+              const PPCAnalyst::CodeBuffer& buffer);
+
+  bool HasPendingEntries() const { return !m_pending.empty(); }
+  // Returns the loaded entries which haven't been handed out yet, grouped by MSR bits.
+  std::vector<Entry> TakePendingEntries();
+
+  // Checks whether a fresh analysis of the guest code still matches the recorded entry.
+  static bool Matches(const Entry& entry, const PPCAnalyst::CodeBlock& block,
+                      const PPCAnalyst::CodeBuffer& buffer);
+  static Entry MakeEntry(u32 em_address, u32 msr_bits, const PPCAnalyst::CodeBlock& block,
+                         const PPCAnalyst::CodeBuffer& buffer);
+
+  static std::string GetFileName(const std::string& jit_name);
+
+private:
+  class Reader;
+
+  using EntryKey = std::tuple<u32, u32, u32, u32>;
+  static EntryKey GetKey(const Entry& entry);
+
+  LinearDiskCache<Entry, u8> m_file;
+  std::set<EntryKey> m_known_entries;
+  std::vector<Entry> m_pending;
+  bool m_is_open = false;
+};
@@ -13,9 +13,10 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
+#include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
@@ -64,17 +65,18 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
-  for (auto& e : block_map)
-  {
-    DestroyBlock(e.second);
-  }
-  block_map.clear();
-  links_to.clear();
-  block_range_map.clear();
+  block_map.ForEach([this](u32, std::vector<std::unique_ptr<JitBlock>>& blocks) {
+    for (auto& block : blocks)
+      DestroyBlock(*block);
+  });
+  block_map.Clear();
+  links_to.Clear();
+  block_range_map.Clear();
 
   valid_block.ClearAll();
 
   fast_block_map.fill(nullptr);
+  m_rollback_addresses.clear();
 }
 
 void JitBaseBlockCache::Reset()
@@ -90,14 +92,18 @@ JitBlock** JitBaseBlockCache::GetFastBlockMap()
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  block_map.ForEach([&f](u32, const std::vector<std::unique_ptr<JitBlock>>& blocks) {
+    for (const auto& block : blocks)
+      f(*block);
+  });
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   u32 physicalAddress = PowerPC::JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physicalAddress, JitBlock())->second;
+  auto& blocks = block_map[physicalAddress];
+  blocks.push_back(std::make_unique<JitBlock>());
+  JitBlock& b = *blocks.back();
   b.effectiveAddress = em_address;
   b.physicalAddress = physicalAddress;
   b.msrBits = MSR & JIT_CACHE_MSR_MASK;
@@ -114,19 +120,27 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   block.fast_block_map_index = index;
 
   block.physical_addresses = physical_addresses;
+  if (m_track_rollback)
+  {
+    m_rollback_addresses.insert(m_rollback_addresses.end(), physical_addresses.begin(),
+                                physical_addresses.end());
+  }
 
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   for (u32 addr : physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+    // The addresses are sorted, so the block can only already be in the last slot.
+    std::vector<JitBlock*>& macro_block = block_range_map[addr & range_mask];
+    if (macro_block.empty() || macro_block.back() != &block)
+      macro_block.push_back(&block);
   }
 
   if (block_link)
   {
     for (const auto& e : block.linkData)
     {
-      links_to.emplace(e.exitAddress, &block);
+      links_to[e.exitAddress].push_back(&block);
     }
 
     LinkBlock(block);
@@ -153,12 +167,14 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  const auto* blocks = block_map.Find(translated_addr);
+  if (!blocks)
+    return nullptr;
+
+  for (const auto& b : *blocks)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
+    if (b->effectiveAddress == addr && b->msrBits == (msr & JIT_CACHE_MSR_MASK))
+      return b.get();
   }
 
   return nullptr;
@@ -209,57 +225,142 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
       {
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
+        m_jit.js.likelyTakenBranches.erase(i);
+        m_jit.js.slowmemCheckAddresses.erase(i);
+        // The JIT keeps pointers to the branch profile, so reset it instead of erasing it.
+        auto stats = m_jit.js.branchStats.find(i);
+        if (stats != m_jit.js.branchStats.end())
+          stats->second = {};
+        auto indirect_stats = m_jit.js.indirectBranchStats.find(i);
+        if (indirect_stats != m_jit.js.indirectBranchStats.end())
+          indirect_stats->second = {};
       }
     }
   }
 }
 
+void JitBaseBlockCache::SetRollbackPoint()
+{
+  m_track_rollback = true;
+  m_rollback_addresses.clear();
+}
+
+void JitBaseBlockCache::EraseBlocksSinceRollbackPoint()
+{
+  // The blocks from before the rollback point match the code in the savestate, unless they were
+  // invalidated since, in which case they are gone already. The newer ones might not.
+  std::sort(m_rollback_addresses.begin(), m_rollback_addresses.end());
+  auto end = std::unique(m_rollback_addresses.begin(), m_rollback_addresses.end());
+  for (auto it = m_rollback_addresses.begin(); it != end; ++it)
+    ErasePhysicalRange(*it, 4);
+
+  m_track_rollback = false;
+  m_rollback_addresses.clear();
+}
+
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  // Collect all macro blocks which overlap the given range. Usually the range is small, so just
+  // step through it, but if it covers more macro blocks than there are in use, filter those.
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  const u32 start = address & range_mask;
+  const u64 end = static_cast<u64>(address) + length;
+  std::vector<u32> macro_blocks;
+  if ((end - start) / BLOCK_RANGE_MAP_ELEMENTS < block_range_map.Size())
+  {
+    for (u64 macro_address = start; macro_address < end; macro_address += BLOCK_RANGE_MAP_ELEMENTS)
+      macro_blocks.push_back(static_cast<u32>(macro_address));
+  }
+  else
   {
+    block_range_map.ForEach([&](u32 macro_address, const std::vector<JitBlock*>&) {
+      if (macro_address >= start && macro_address < end)
+        macro_blocks.push_back(macro_address);
+    });
+  }
+
+  for (u32 macro_address : macro_blocks)
+  {
+    // Only lookups are done on block_range_map until the macro block is dropped, so this pointer
+    // stays valid.
+    std::vector<JitBlock*>* macro_block = block_range_map.Find(macro_address);
+    if (!macro_block)
+      continue;
+
     // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    size_t i = 0;
+    while (i < macro_block->size())
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
+      JitBlock* block = (*macro_block)[i];
+      if (!block->OverlapsPhysicalRange(address, length))
       {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
+        i++;
+        continue;
       }
-      else
+
+      // If the block overlaps, also remove all other occupied slots in the other macro blocks.
+      // This will leak empty macro blocks, but they may be reused or cleared later on.
+      u32 last_other = macro_address;
+      for (u32 addr : block->physical_addresses)
       {
-        iter++;
+        const u32 other = addr & range_mask;
+        if (other == macro_address || other == last_other)
+          continue;
+        last_other = other;
+        if (std::vector<JitBlock*>* other_block = block_range_map.Find(other))
+          other_block->erase(std::remove(other_block->begin(), other_block->end(), block),
+                             other_block->end());
       }
+
+      // And remove the block.
+      (*macro_block)[i] = macro_block->back();
+      macro_block->pop_back();
+      DestroyBlock(*block);
+      FreeBlock(block);
     }
 
     // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    if (macro_block->empty())
+      block_range_map.Erase(macro_address);
+  }
+}
+
+void JitBaseBlockCache::EraseHostCodeRange(const u8* start, const u8* end)
+{
+  std::vector<JitBlock*> erased_blocks;
+  block_map.ForEach([&](u32, std::vector<std::unique_ptr<JitBlock>>& blocks) {
+    for (auto& block : blocks)
+    {
+      if (block->checkedEntry >= start && block->checkedEntry < end)
+        erased_blocks.push_back(block.get());
+    }
+  });
+
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  for (JitBlock* block : erased_blocks)
+  {
+    u32 last_macro_address = 0;
+    bool first = true;
+    for (u32 addr : block->physical_addresses)
+    {
+      const u32 macro_address = addr & range_mask;
+      if (!first && macro_address == last_macro_address)
+        continue;
+      first = false;
+      last_macro_address = macro_address;
+
+      std::vector<JitBlock*>* macro_block = block_range_map.Find(macro_address);
+      if (!macro_block)
+        continue;
+      macro_block->erase(std::remove(macro_block->begin(), macro_block->end(), block),
+                         macro_block->end());
+      if (macro_block->empty())
+        block_range_map.Erase(macro_address);
+    }
+
+    DestroyBlock(*block);
+    FreeBlock(block);
   }
 }
 
@@ -297,13 +398,14 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
 void JitBaseBlockCache::LinkBlock(JitBlock& block)
 {
   LinkBlockExits(block);
-  auto ppp = links_to.equal_range(block.effectiveAddress);
+  const auto* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
+    return;
 
-  for (auto iter = ppp.first; iter != ppp.second; ++iter)
+  for (JitBlock* b2 : *sources)
   {
-    JitBlock& b2 = *iter->second;
-    if (block.msrBits == b2.msrBits)
-      LinkBlockExits(b2);
+    if (block.msrBits == b2->msrBits)
+      LinkBlockExits(*b2);
   }
 }
 
@@ -316,10 +418,13 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   }
 
   // Unlink all exits of other blocks which points to this block
-  auto ppp = links_to.equal_range(block.effectiveAddress);
-  for (auto iter = ppp.first; iter != ppp.second; ++iter)
+  const auto* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
+    return;
+
+  for (JitBlock* source : *sources)
   {
-    JitBlock& sourceBlock = *iter->second;
+    JitBlock& sourceBlock = *source;
     if (sourceBlock.msrBits != block.msrBits)
       continue;
 
@@ -344,20 +449,29 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
   // Delete linking addresses
   for (const auto& e : block.linkData)
   {
-    auto it = links_to.equal_range(e.exitAddress);
-    while (it.first != it.second)
-    {
-      if (it.first->second == &block)
-        it.first = links_to.erase(it.first);
-      else
-        it.first++;
-    }
+    auto* sources = links_to.Find(e.exitAddress);
+    if (!sources)
+      continue;
+
+    sources->erase(std::remove(sources->begin(), sources->end(), &block), sources->end());
+    if (sources->empty())
+      links_to.Erase(e.exitAddress);
   }
 
   // Raise an signal if we are going to call this block again
   WriteDestroyBlock(block);
 }
 
+void JitBaseBlockCache::FreeBlock(JitBlock* block)
+{
+  const u32 physical_address = block->physicalAddress;
+  auto& blocks = *block_map.Find(physical_address);
+  blocks.erase(std::find_if(blocks.begin(), blocks.end(),
+                            [block](const auto& b) { return b.get() == block; }));
+  if (blocks.empty())
+    block_map.Erase(physical_address);
+}
+
 JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, u32 msr)
 {
   JitBlock* block = GetBlockFromStartAddress(addr, msr);
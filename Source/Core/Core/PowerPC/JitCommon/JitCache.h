@@ -8,12 +8,12 @@
 #include <bitset>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <memory>
 #include <set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FlatHashMap.h"
 
 class JitBase;
 
@@ -46,10 +46,16 @@ struct JitBlock
   // The number of bytes of JIT'ed code contained in this block. Mostly
   // useful for logging.
   u32 codeSize;
+  // The number of bytes of far code (see FarCodeCache) emitted for this block, which isn't
+  // included in codeSize. Mostly useful for logging.
+  u32 farCodeSize;
   // The number of PPC instructions represented by this block. Mostly
   // useful for logging.
   u32 originalSize;
   int runCount;  // for profiling.
+  // With tiered compilation, the number of executions left before an interpreted block is
+  // recompiled with optimizations.
+  int tierUpCountdown;
 
   // Information about exits to a known address from this block.
   // This is used to implement block linking.
@@ -146,6 +152,14 @@ public:
 
   void InvalidateICache(u32 address, u32 length, bool forced);
   void ErasePhysicalRange(u32 address, u32 length);
+  // Destroys all blocks whose code starts within [start, end), so that the JIT can reuse that
+  // part of its code space without clearing the whole cache.
+  void EraseHostCodeRange(const u8* start, const u8* end);
+
+  // Starts recording the code of the blocks that get compiled, so that they can be erased again
+  // when the emulation goes back to a savestate taken at this point.
+  void SetRollbackPoint();
+  void EraseBlocksSinceRollbackPoint();
 
   u32* GetBlockBitSet() const;
 
@@ -160,6 +174,8 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void DestroyBlock(JitBlock& block);
+  // Removes a destroyed block from block_map, which frees it.
+  void FreeBlock(JitBlock* block);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
@@ -168,17 +184,18 @@ private:
 
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
-  std::multimap<u32, JitBlock*> links_to;  // destination_PC -> number
+  Common::FlatHashMap<u32, std::vector<JitBlock*>> links_to;  // destination_PC -> number
 
   // Map indexed by the physical address of the entry point.
   // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  // The blocks are allocated separately, so that pointers to them stay valid.
+  Common::FlatHashMap<u32, std::vector<std::unique_ptr<JitBlock>>> block_map;
 
   // Range of overlapping code indexed by a masked physical address.
   // This is used for invalidation of memory regions. The range is grouped
   // in macro blocks of each 0x100 bytes.
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::set<JitBlock*>> block_range_map;
+  Common::FlatHashMap<u32, std::vector<JitBlock*>> block_range_map;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
@@ -187,4 +204,8 @@ private:
   // This array is indexed with the masked PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
   std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map;  // start_addr & mask -> number
+
+  // The physical addresses of the code compiled since SetRollbackPoint.
+  bool m_track_rollback = false;
+  std::vector<u32> m_rollback_addresses;
 };
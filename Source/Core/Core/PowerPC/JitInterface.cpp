@@ -7,8 +7,13 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -19,13 +24,18 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
 
@@ -39,10 +49,17 @@
 
 namespace JitInterface
 {
+static bool s_keep_cache_on_load = false;
+
 void DoState(PointerWrap& p)
 {
-  if (g_jit && p.GetMode() == PointerWrap::MODE_READ)
+  if (p.GetMode() != PointerWrap::MODE_READ)
+    return;
+
+  if (g_jit && !s_keep_cache_on_load)
     g_jit->ClearCache();
+  s_keep_cache_on_load = false;
+  Interpreter::getInstance()->ClearDecodedInstructions();
 }
 CPUCoreBase* InitJitCore(int core)
 {
@@ -70,6 +87,14 @@ CPUCoreBase* InitJitCore(int core)
   }
   g_jit = static_cast<JitBase*>(ptr);
   g_jit->Init();
+
+  if (Profiler::g_SampleBlocks)
+    Profiler::StartSampling();
+
+  const std::string& warmup_list = SConfig::GetInstance().m_strJITWarmupList;
+  if (!warmup_list.empty())
+    g_jit->js.warmupBlocks = ReadWarmupList(warmup_list);
+
   return ptr;
 }
 
@@ -78,6 +103,54 @@ CPUCoreBase* GetCore()
   return g_jit;
 }
 
+std::vector<BlockEntryPoint> ReadWarmupList(const std::string& filename)
+{
+  std::vector<BlockEntryPoint> entry_points;
+  std::ifstream ifs;
+  File::OpenFStream(ifs, filename, std::ios_base::in);
+  if (!ifs)
+  {
+    INFO_LOG(DYNA_REC, "No JIT warm-up list at %s yet", filename.c_str());
+    return entry_points;
+  }
+
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    std::istringstream iss(line);
+    BlockEntryPoint entry_point;
+    if (iss >> std::hex >> entry_point.effective_address >> entry_point.msr_bits)
+      entry_points.push_back(entry_point);
+  }
+
+  INFO_LOG(DYNA_REC, "Loaded %zu JIT warm-up entries from %s", entry_points.size(),
+           filename.c_str());
+  return entry_points;
+}
+
+void WriteWarmupList(const std::string& filename)
+{
+  if (!g_jit)
+    return;
+
+  std::set<std::pair<u32, u32>> entry_points;
+  for (const BlockEntryPoint& entry_point : g_jit->js.warmupBlocks)
+    entry_points.emplace(entry_point.effective_address, entry_point.msr_bits);
+  g_jit->GetBlockCache()->RunOnBlocks([&entry_points](const JitBlock& block) {
+    entry_points.emplace(block.effectiveAddress, block.msrBits);
+  });
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG(DYNA_REC, "Failed to write the JIT warm-up list to %s", filename.c_str());
+    return;
+  }
+
+  for (const auto& entry_point : entry_points)
+    fprintf(f.GetHandle(), "%08x %08x\n", entry_point.first, entry_point.second);
+}
+
 void WriteProfileResults(const std::string& filename)
 {
   ProfileStats prof_stats;
@@ -90,16 +163,79 @@ void WriteProfileResults(const std::string& filename)
     return;
   }
   fprintf(f.GetHandle(), "origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAlli"
-                         "nBlkTime(ms)\tblkCodeSize\n");
+                         "nBlkTime(ms)\tblkCodeSize\tblkFarCodeSize\n");
   for (auto& stat : prof_stats.block_stats)
   {
     std::string name = g_symbolDB.GetDescription(stat.addr);
     double percent = 100.0 * (double)stat.cost / (double)prof_stats.cost_sum;
     double timePercent = 100.0 * (double)stat.tick_counter / (double)prof_stats.timecost_sum;
     fprintf(f.GetHandle(),
-            "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%i\n", stat.addr,
-            name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent, timePercent,
-            (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec, stat.block_size);
+            "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%u\t%u\n",
+            stat.addr, name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent,
+            timePercent, (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec,
+            stat.block_size, stat.far_code_size);
+  }
+
+  if (!prof_stats.backpatch_stats.empty())
+  {
+    fprintf(f.GetHandle(), "\norigAddr\tfuncName\tbackpatchCount\n");
+    for (auto& stat : prof_stats.backpatch_stats)
+    {
+      std::string name = g_symbolDB.GetDescription(stat.addr);
+      fprintf(f.GetHandle(), "%08x\t%s\t%u\n", stat.addr, name.c_str(), stat.count);
+    }
+  }
+
+  if (!prof_stats.indirect_branch_stats.empty())
+  {
+    u64 total_hits = 0;
+    u64 total_misses = 0;
+    for (const auto& stat : prof_stats.indirect_branch_stats)
+    {
+      total_hits += stat.hits;
+      total_misses += stat.misses;
+    }
+
+    fprintf(f.GetHandle(), "\nIndirect branches: %" PRIu64 " inline cache hits, %" PRIu64
+                           " dispatches (%.2f%% hit)\n",
+            total_hits, total_misses,
+            100.0 * total_hits / std::max<u64>(total_hits + total_misses, 1));
+    fprintf(f.GetHandle(), "origAddr\tfuncName\ttarget\thits\tdispatches\n");
+    for (const auto& stat : prof_stats.indirect_branch_stats)
+    {
+      std::string name = g_symbolDB.GetDescription(stat.addr);
+      fprintf(f.GetHandle(), "%08x\t%s\t%08x\t%" PRIu64 "\t%" PRIu64 "\n", stat.addr,
+              name.c_str(), stat.target, stat.hits, stat.misses);
+    }
+  }
+
+  if (prof_stats.emitter_stats.empty())
+    return;
+
+  u64 total_bytes = 0;
+  u64 total_far_bytes = 0;
+  u64 total_ticks = 0;
+  for (const auto& stat : prof_stats.emitter_stats)
+  {
+    total_bytes += stat.emitted_bytes;
+    total_far_bytes += stat.emitted_far_bytes;
+    total_ticks += stat.emit_ticks;
+  }
+
+  fprintf(f.GetHandle(), "\nEmitted %" PRIu64 " bytes of near code and %" PRIu64
+                         " bytes of far code (%.2f%% far) in %.2f ms\n",
+          total_bytes, total_far_bytes,
+          100.0 * total_far_bytes / std::max<u64>(total_bytes + total_far_bytes, 1),
+          total_ticks * 1000.0 / prof_stats.countsPerSec);
+  fprintf(f.GetHandle(), "opName\temitCount\tnearBytes\tfarBytes\tbytesPerInst\temitTime(us)"
+                         "\tnsPerInst\n");
+  for (const auto& stat : prof_stats.emitter_stats)
+  {
+    fprintf(f.GetHandle(), "%s\t%u\t%" PRIu64 "\t%" PRIu64 "\t%.1f\t%.1f\t%.1f\n", stat.name,
+            stat.emit_count, stat.emitted_bytes, stat.emitted_far_bytes,
+            (double)(stat.emitted_bytes + stat.emitted_far_bytes) / stat.emit_count,
+            stat.emit_ticks * 1000000.0 / prof_stats.countsPerSec,
+            stat.emit_ticks * 1000000000.0 / prof_stats.countsPerSec / stat.emit_count);
   }
 }
 
@@ -112,6 +248,9 @@ void GetProfileResults(ProfileStats* prof_stats)
   prof_stats->cost_sum = 0;
   prof_stats->timecost_sum = 0;
   prof_stats->block_stats.clear();
+  prof_stats->backpatch_stats.clear();
+  prof_stats->indirect_branch_stats.clear();
+  prof_stats->emitter_stats.clear();
 
   Core::State old_state = Core::GetState();
   if (old_state == Core::State::Running)
@@ -125,12 +264,36 @@ void GetProfileResults(ProfileStats* prof_stats)
     // Todo: tweak.
     if (block.runCount >= 1)
       prof_stats->block_stats.emplace_back(block.effectiveAddress, cost, timecost, block.runCount,
-                                           block.codeSize);
+                                           block.codeSize, block.farCodeSize);
     prof_stats->cost_sum += cost;
     prof_stats->timecost_sum += timecost;
   });
 
   sort(prof_stats->block_stats.begin(), prof_stats->block_stats.end());
+
+  for (const auto& entry : g_jit->js.backpatchCounts)
+    prof_stats->backpatch_stats.emplace_back(entry.first, entry.second);
+  sort(prof_stats->backpatch_stats.begin(), prof_stats->backpatch_stats.end());
+
+  for (const auto& entry : g_jit->js.indirectBranchStats)
+  {
+    const auto& stats = entry.second;
+    if (stats.hits != 0 || stats.misses != 0)
+      prof_stats->indirect_branch_stats.emplace_back(entry.first, stats.target, stats.hits,
+                                                     stats.misses);
+  }
+  sort(prof_stats->indirect_branch_stats.begin(), prof_stats->indirect_branch_stats.end());
+
+  for (size_t i = 0; i < m_numInstructions; ++i)
+  {
+    const GekkoOPInfo* info = m_allInstructions[i];
+    if (info->emitCount != 0)
+    {
+      prof_stats->emitter_stats.emplace_back(info->opname, info->emitCount, info->emittedBytes,
+                                             info->emittedFarBytes, info->emitTicks);
+    }
+  }
+  sort(prof_stats->emitter_stats.begin(), prof_stats->emitter_stats.end());
   if (old_state == Core::State::Running)
     Core::SetState(Core::State::Running);
 }
@@ -199,6 +362,7 @@ void ClearCache()
 {
   if (g_jit)
     g_jit->ClearCache();
+  Interpreter::getInstance()->ClearDecodedInstructions();
 }
 void ClearSafe()
 {
@@ -208,12 +372,27 @@ void ClearSafe()
   // TODO: There's probably a better way to handle this situation.
   if (g_jit)
     g_jit->GetBlockCache()->Clear();
+  Interpreter::getInstance()->ClearDecodedInstructions();
+}
+
+void SetRollbackPoint()
+{
+  if (g_jit)
+    g_jit->GetBlockCache()->SetRollbackPoint();
+}
+
+void PrepareRollback()
+{
+  if (g_jit)
+    g_jit->GetBlockCache()->EraseBlocksSinceRollbackPoint();
+  s_keep_cache_on_load = true;
 }
 
 void InvalidateICache(u32 address, u32 size, bool forced)
 {
   if (g_jit)
     g_jit->GetBlockCache()->InvalidateICache(address, size, forced);
+  Interpreter::getInstance()->InvalidateDecodedInstructions(address, size);
 }
 
 void CompileExceptionCheck(ExceptionType type)
@@ -234,6 +413,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &g_jit->js.hotBlockAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -253,10 +435,49 @@ void CompileExceptionCheck(ExceptionType type)
   }
 }
 
+void ProfileBranch(u32 address)
+{
+  if (!g_jit)
+    return;
+
+  const auto& stats = g_jit->js.branchStats[address];
+  if (u64{stats.taken} * 16 < u64{stats.executed} * 15)
+    return;
+
+  g_jit->js.likelyTakenBranches.insert(address);
+  g_jit->GetBlockCache()->InvalidateICache(address, 4, true);
+}
+
+void ProfileIndirectBranch(u32 address, u32 target)
+{
+  if (!g_jit)
+    return;
+
+  // Keep the current target as long as it's hit the vast majority of the time.
+  auto& stats = g_jit->js.indirectBranchStats[address];
+  if (stats.target != 0 && stats.hits >= stats.misses * 16)
+  {
+    stats.hits = 0;
+    stats.misses = 0;
+    return;
+  }
+
+  stats.target = target;
+  stats.retargets++;
+  stats.hits = 0;
+  stats.misses = 0;
+  g_jit->GetBlockCache()->InvalidateICache(address, 4, true);
+}
+
 void Shutdown()
 {
   if (g_jit)
   {
+    const std::string& warmup_list = SConfig::GetInstance().m_strJITWarmupList;
+    if (!warmup_list.empty())
+      WriteWarmupList(warmup_list);
+
+    Profiler::StopSampling();
     g_jit->Shutdown();
     delete g_jit;
     g_jit = nullptr;
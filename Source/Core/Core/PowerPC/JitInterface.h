@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/MachineContext.h"
@@ -19,7 +20,16 @@ enum class ExceptionType
 {
   FIFOWrite,
   PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  HotBlock
+};
+
+// A block entry point, as stored in warm-up lists.
+struct BlockEntryPoint
+{
+  u32 effective_address;
+  // The MSR bits the block was compiled with; see JitBaseBlockCache::JIT_CACHE_MSR_MASK.
+  u32 msr_bits;
 };
 
 void DoState(PointerWrap& p);
@@ -32,6 +42,13 @@ void WriteProfileResults(const std::string& filename);
 void GetProfileResults(ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
 
+// Warm-up lists hold the entry points of the blocks compiled in a previous session, so that the
+// JIT can compile them before the first frame. Each line is an effective address followed by the
+// MSR bits, both in hex.
+std::vector<BlockEntryPoint> ReadWarmupList(const std::string& filename);
+// Writes the blocks currently in the cache, merged with the list the session started with.
+void WriteWarmupList(const std::string& filename);
+
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
 bool HandleStackFault();
@@ -41,10 +58,24 @@ void ClearCache();
 
 void ClearSafe();
 
+// Run-ahead goes back to a savestate every VI field. Rather than clearing the whole cache when it
+// is loaded, only the code compiled since it was taken is thrown away.
+void SetRollbackPoint();
+void PrepareRollback();
+
 // If "forced" is true, a recompile is being requested on code that hasn't been modified.
 void InvalidateICache(u32 address, u32 size, bool forced);
 
 void CompileExceptionCheck(ExceptionType type);
 
+// Called by the JIT once a conditional branch has run often enough to tell whether it is worth
+// following when forming superblocks. If it is, the block containing it gets recompiled.
+void ProfileBranch(u32 address);
+
+// Called by the JIT every Jit64::INDIRECT_BRANCH_PROFILE_MISSES times an indirect branch didn't
+// go to the target it was compiled to expect. Decides whether the block should be recompiled
+// expecting the given target instead, or without an inline cache.
+void ProfileIndirectBranch(u32 address, u32 target);
+
 void Shutdown();
 }
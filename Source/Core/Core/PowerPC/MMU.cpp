@@ -105,6 +105,8 @@ struct TranslateAddressResult
     PAGE_FAULT
   } result;
   u32 address;
+  // The I bit of the WIMG bits from the BAT or PTE; such accesses bypass the data cache.
+  bool cache_inhibited = false;
   bool Success() const { return result <= PAGE_TABLE_TRANSLATED; }
 };
 template <const XCheckTLBFlag flag>
@@ -165,11 +167,107 @@ BatTable dbat_table;
 
 static void GenerateDSIException(u32 _EffectiveAddress, bool _bWrite);
 
+static SoftwareTLBEntry& GetSoftwareTLBEntry(u32 address)
+{
+  return ppcState.software_tlb[(address >> HW_PAGE_INDEX_SHIFT) & (SOFTWARE_TLB_SIZE - 1)];
+}
+
+// Returns the host address of an access which doesn't cross a page, if the software TLB has it.
+static u8* LookupSoftwareTLB(u32 address, u32 size, bool write)
+{
+  if ((address & (HW_PAGE_SIZE - 1)) > HW_PAGE_SIZE - size)
+    return nullptr;
+
+  const SoftwareTLBEntry& entry = GetSoftwareTLBEntry(address);
+  const u32 tag = address & ~static_cast<u32>(HW_PAGE_SIZE - 1);
+  if ((write ? entry.write_tag : entry.read_tag) != tag)
+    return nullptr;
+
+  return reinterpret_cast<u8*>(entry.host_offset + address);
+}
+
+// Adds a page table translation done for a load or store. Only pages in RAM are cached, since
+// everything else needs the checks in ReadFromHardware and WriteToHardware anyway. Writes only
+// get an entry once the translation has set the C bit, so that it's never skipped. Pages with
+// memchecks are left out too, as the JIT skips the memcheck for accesses which hit the TLB.
+static void UpdateSoftwareTLB(u32 address, u32 physical_address, bool write)
+{
+  // Entries would skip the emulated data cache.
+  if (SConfig::GetInstance().bAccurateCPUCache)
+    return;
+
+  if (PowerPC::memchecks.IsPageWatched(address))
+    return;
+
+  const u32 physical_page = physical_address & ~static_cast<u32>(HW_PAGE_SIZE - 1);
+  u8* host_page;
+  if ((physical_page & 0xF8000000) == 0x00000000)
+    host_page = &Memory::m_pRAM[physical_page & Memory::RAM_MASK];
+  else if (Memory::m_pEXRAM && (physical_page >> 28) == 0x1 &&
+           (physical_page & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+    host_page = &Memory::m_pEXRAM[physical_page & 0x0FFFFFFF];
+  else
+    return;
+
+  SoftwareTLBEntry& entry = GetSoftwareTLBEntry(address);
+  const u32 tag = address & ~static_cast<u32>(HW_PAGE_SIZE - 1);
+  const uintptr_t host_offset = reinterpret_cast<uintptr_t>(host_page) - tag;
+  if (entry.read_tag != tag || entry.host_offset != host_offset)
+    entry.write_tag = SoftwareTLBEntry::INVALID_TAG;
+  entry.read_tag = tag;
+  entry.host_offset = host_offset;
+  if (write)
+    entry.write_tag = tag;
+}
+
+void InvalidateSoftwareTLB()
+{
+  ppcState.software_tlb.fill({});
+}
+
+// With data cache emulation enabled, loads and stores to MEM1 and MEM2 go through the emulated
+// data cache, unless it's disabled in HID0 or the page is cache-inhibited. Host accesses see what
+// is cached without allocating lines. cache_address is the address the DataCache expects.
+template <XCheckTLBFlag flag, typename T>
+static T ReadFromDataCache(u32 cache_address, const u8* memory, bool cache_inhibited)
+{
+  T value;
+  if (IsNoExceptionFlag(flag))
+    ppcState.dCache.HostRead(cache_address, &value, sizeof(T));
+  else if (HID0.DCE && !cache_inhibited)
+    ppcState.dCache.Read(cache_address, &value, sizeof(T));
+  else
+    std::memcpy(&value, memory, sizeof(T));
+  return bswap(value);
+}
+
+template <XCheckTLBFlag flag, typename T>
+static void WriteToDataCache(u32 cache_address, u8* memory, bool cache_inhibited, const T data)
+{
+  const T swapped_data = bswap(data);
+  if (IsNoExceptionFlag(flag))
+    ppcState.dCache.HostWrite(cache_address, &swapped_data, sizeof(T));
+  else if (HID0.DCE && !cache_inhibited)
+    ppcState.dCache.Write(cache_address, &swapped_data, sizeof(T));
+  else
+    std::memcpy(memory, &swapped_data, sizeof(T));
+}
+
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
-static T ReadFromHardware(u32 em_address)
+static T ReadFromHardware(u32 em_address, bool cache_inhibited = false)
 {
   if (!never_translate && UReg_MSR(MSR).DR)
   {
+    if (flag == FLAG_READ)
+    {
+      if (const u8* ptr = LookupSoftwareTLB(em_address, sizeof(T), false))
+      {
+        T value;
+        std::memcpy(&value, ptr, sizeof(T));
+        return bswap(value);
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -177,6 +275,11 @@ static T ReadFromHardware(u32 em_address)
         GenerateDSIException(em_address, false);
       return 0;
     }
+    if (flag == FLAG_READ &&
+        translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    {
+      UpdateSoftwareTLB(em_address, translated_addr.address, false);
+    }
     if ((em_address & (HW_PAGE_SIZE - 1)) > HW_PAGE_SIZE - sizeof(T))
     {
       // This could be unaligned down to the byte level... hopefully this is rare, so doing it this
@@ -193,15 +296,20 @@ static T ReadFromHardware(u32 em_address)
       }
       T var = 0;
       u32 addr_translated = translated_addr.address;
+      cache_inhibited = translated_addr.cache_inhibited;
       for (u32 addr = em_address; addr < em_address + sizeof(T); addr++, addr_translated++)
       {
         if (addr == em_address_next_page)
+        {
           addr_translated = addr_next_page.address;
-        var = (var << 8) | ReadFromHardware<flag, u8, true>(addr_translated);
+          cache_inhibited = addr_next_page.cache_inhibited;
+        }
+        var = (var << 8) | ReadFromHardware<flag, u8, true>(addr_translated, cache_inhibited);
       }
       return var;
     }
     em_address = translated_addr.address;
+    cache_inhibited = translated_addr.cache_inhibited;
   }
 
   // TODO: Make sure these are safe for unaligned addresses.
@@ -211,6 +319,12 @@ static T ReadFromHardware(u32 em_address)
     // Handle RAM; the masking intentionally discards bits (essentially creating
     // mirrors of memory).
     // TODO: Only the first REALRAM_SIZE is supposed to be backed by actual memory.
+    if (SConfig::GetInstance().bAccurateCPUCache)
+    {
+      return ReadFromDataCache<flag, T>(em_address & Memory::RAM_MASK,
+                                        &Memory::m_pRAM[em_address & Memory::RAM_MASK],
+                                        cache_inhibited);
+    }
     T value;
     std::memcpy(&value, &Memory::m_pRAM[em_address & Memory::RAM_MASK], sizeof(T));
     return bswap(value);
@@ -219,6 +333,12 @@ static T ReadFromHardware(u32 em_address)
   if (Memory::m_pEXRAM && (em_address >> 28) == 0x1 &&
       (em_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
   {
+    if (SConfig::GetInstance().bAccurateCPUCache)
+    {
+      return ReadFromDataCache<flag, T>(DCACHE_EXRAM_BIT | (em_address & 0x0FFFFFFF),
+                                        &Memory::m_pEXRAM[em_address & 0x0FFFFFFF],
+                                        cache_inhibited);
+    }
     T value;
     std::memcpy(&value, &Memory::m_pEXRAM[em_address & 0x0FFFFFFF], sizeof(T));
     return bswap(value);
@@ -254,10 +374,20 @@ static T ReadFromHardware(u32 em_address)
 }
 
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
-static void WriteToHardware(u32 em_address, const T data)
+static void WriteToHardware(u32 em_address, const T data, bool cache_inhibited = false)
 {
   if (!never_translate && UReg_MSR(MSR).DR)
   {
+    if (flag == FLAG_WRITE)
+    {
+      if (u8* ptr = LookupSoftwareTLB(em_address, sizeof(T), true))
+      {
+        const T swapped_data = bswap(data);
+        std::memcpy(ptr, &swapped_data, sizeof(T));
+        return;
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -265,6 +395,11 @@ static void WriteToHardware(u32 em_address, const T data)
         GenerateDSIException(em_address, true);
       return;
     }
+    if (flag == FLAG_WRITE &&
+        translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    {
+      UpdateSoftwareTLB(em_address, translated_addr.address, true);
+    }
     if ((em_address & (sizeof(T) - 1)) &&
         (em_address & (HW_PAGE_SIZE - 1)) > HW_PAGE_SIZE - sizeof(T))
     {
@@ -282,15 +417,21 @@ static void WriteToHardware(u32 em_address, const T data)
       }
       T val = bswap(data);
       u32 addr_translated = translated_addr.address;
+      cache_inhibited = translated_addr.cache_inhibited;
       for (size_t i = 0; i < sizeof(T); i++, addr_translated++)
       {
         if (em_address + i == em_address_next_page)
+        {
           addr_translated = addr_next_page.address;
-        WriteToHardware<flag, u8, true>(addr_translated, static_cast<u8>(val >> (i * 8)));
+          cache_inhibited = addr_next_page.cache_inhibited;
+        }
+        WriteToHardware<flag, u8, true>(addr_translated, static_cast<u8>(val >> (i * 8)),
+                                        cache_inhibited);
       }
       return;
     }
     em_address = translated_addr.address;
+    cache_inhibited = translated_addr.cache_inhibited;
   }
 
   // TODO: Make sure these are safe for unaligned addresses.
@@ -300,6 +441,13 @@ static void WriteToHardware(u32 em_address, const T data)
     // Handle RAM; the masking intentionally discards bits (essentially creating
     // mirrors of memory).
     // TODO: Only the first REALRAM_SIZE is supposed to be backed by actual memory.
+    if (SConfig::GetInstance().bAccurateCPUCache)
+    {
+      WriteToDataCache<flag, T>(em_address & Memory::RAM_MASK,
+                                &Memory::m_pRAM[em_address & Memory::RAM_MASK], cache_inhibited,
+                                data);
+      return;
+    }
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pRAM[em_address & Memory::RAM_MASK], &swapped_data, sizeof(T));
     return;
@@ -308,6 +456,12 @@ static void WriteToHardware(u32 em_address, const T data)
   if (Memory::m_pEXRAM && (em_address >> 28) == 0x1 &&
       (em_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
   {
+    if (SConfig::GetInstance().bAccurateCPUCache)
+    {
+      WriteToDataCache<flag, T>(DCACHE_EXRAM_BIT | (em_address & 0x0FFFFFFF),
+                                &Memory::m_pEXRAM[em_address & 0x0FFFFFFF], cache_inhibited, data);
+      return;
+    }
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pEXRAM[em_address & 0x0FFFFFFF], &swapped_data, sizeof(T));
     return;
@@ -619,20 +773,40 @@ std::string HostGetString(u32 address, size_t size)
 
 bool IsOptimizableRAMAddress(const u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
-    return false;
-
   if (!UReg_MSR(MSR).DR)
     return false;
 
   // TODO: This API needs to take an access size
   //
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. This is also where pages with memchecks are excluded, see UpdateBATs.
   u32 bat_result = dbat_table[address >> BAT_INDEX_SHIFT];
   return (bat_result & BAT_PHYSICAL_BIT) != 0;
 }
 
+u8* GetOptimizableRAMPointer(u32 address, u32 size)
+{
+  if (!IsOptimizableRAMAddress(address))
+    return nullptr;
+
+  // The next BAT page could map somewhere else entirely.
+  if ((address & (BAT_PAGE_SIZE - 1)) > BAT_PAGE_SIZE - size)
+    return nullptr;
+
+  TranslateBatAddess(dbat_table, &address);
+
+  // These match the regions for which BAT_PHYSICAL_BIT is set, see UpdateBATs.
+  if (Memory::m_pFakeVMEM && (address & 0xFE000000) == 0x7E000000)
+    return &Memory::m_pFakeVMEM[address & Memory::RAM_MASK];
+  if (address < Memory::REALRAM_SIZE)
+    return &Memory::m_pRAM[address];
+  if ((address >> 28) == 0x1)
+    return &Memory::m_pEXRAM[address & 0x0FFFFFFF];
+  if ((address & 0x0FFFFFFF) + size <= Memory::L1_CACHE_SIZE)
+    return &Memory::m_pL1Cache[address & 0x0FFFFFFF];
+  return nullptr;
+}
+
 template <XCheckTLBFlag flag>
 static bool IsRAMAddress(u32 address, bool translate)
 {
@@ -739,9 +913,28 @@ void DMA_MemoryToLC(const u32 cacheAddr, const u32 memAddr, const u32 numBlocks)
   memcpy(dst, src, 32 * numBlocks);
 }
 
+// Returns whether a physical address is in MEM1 or MEM2, the only memory the data cache covers,
+// along with the address the DataCache expects for it.
+static bool GetDataCacheAddress(u32 physical_address, u32* cache_address)
+{
+  if ((physical_address & 0xF8000000) == 0x00000000)
+  {
+    *cache_address = physical_address & Memory::RAM_MASK;
+    return true;
+  }
+  if (Memory::m_pEXRAM && (physical_address >> 28) == 0x1 &&
+      (physical_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+  {
+    *cache_address = DCACHE_EXRAM_BIT | (physical_address & 0x0FFFFFFF);
+    return true;
+  }
+  return false;
+}
+
 void ClearCacheLine(u32 address)
 {
   _dbg_assert_(POWERPC, (address & 0x1F) == 0);
+  bool cache_inhibited = false;
   if (UReg_MSR(MSR).DR)
   {
     auto translated_address = TranslateAddress<FLAG_WRITE>(address);
@@ -759,6 +952,15 @@ void ClearCacheLine(u32 address)
       return;
     }
     address = translated_address.address;
+    cache_inhibited = translated_address.cache_inhibited;
+  }
+
+  u32 cache_address;
+  if (SConfig::GetInstance().bAccurateCPUCache && HID0.DCE && !cache_inhibited &&
+      GetDataCacheAddress(address, &cache_address))
+  {
+    ppcState.dCache.ClearLine(cache_address);
+    return;
   }
 
   // TODO: This isn't precisely correct for non-RAM regions, but the difference
@@ -767,9 +969,43 @@ void ClearCacheLine(u32 address)
     WriteToHardware<FLAG_WRITE, u64, true>(address + i, 0);
 }
 
+// TODO: Raise DSI if translation fails (except for direct-store segments).
+static void DataCacheLineOperation(u32 address, void (DataCache::*operation)(u32))
+{
+  if (!SConfig::GetInstance().bAccurateCPUCache)
+    return;
+
+  if (UReg_MSR(MSR).DR)
+  {
+    auto translated_address = TranslateAddress<FLAG_NO_EXCEPTION>(address);
+    if (!translated_address.Success())
+      return;
+    address = translated_address.address;
+  }
+
+  u32 cache_address;
+  if (GetDataCacheAddress(address, &cache_address))
+    (ppcState.dCache.*operation)(cache_address);
+}
+
+void FlushCacheLine(u32 address)
+{
+  DataCacheLineOperation(address, &DataCache::FlushLine);
+}
+
+void StoreCacheLine(u32 address)
+{
+  DataCacheLineOperation(address, &DataCache::StoreLine);
+}
+
+void InvalidateCacheLine(u32 address)
+{
+  DataCacheLineOperation(address, &DataCache::InvalidateLine);
+}
+
 u32 IsOptimizableMMIOAccess(u32 address, u32 accessSize)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.IsPageWatched(address))
     return 0;
 
   if (!UReg_MSR(MSR).DR)
@@ -791,7 +1027,7 @@ u32 IsOptimizableMMIOAccess(u32 address, u32 accessSize)
 
 bool IsOptimizableGatherPipeWrite(u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.IsPageWatched(address))
     return false;
 
   if (!UReg_MSR(MSR).DR)
@@ -823,6 +1059,19 @@ TranslateResult JitCache_TranslateAddress(u32 address)
   return TranslateResult{true, from_bat, tlb_addr.address};
 }
 
+TranslateResult HostTranslateAddress(u32 address)
+{
+  if (!UReg_MSR(MSR).DR)
+    return TranslateResult{true, true, address};
+
+  auto tlb_addr = TranslateAddress<FLAG_NO_EXCEPTION>(address);
+  if (!tlb_addr.Success())
+    return TranslateResult{false, false, 0};
+
+  bool from_bat = tlb_addr.result == TranslateAddressResult::BAT_TRANSLATED;
+  return TranslateResult{true, from_bat, tlb_addr.address};
+}
+
 // *********************************************************************************
 // Warning: Test Area
 //
@@ -958,6 +1207,7 @@ void SDRUpdated()
   }
   PowerPC::ppcState.pagetable_base = htaborg << 16;
   PowerPC::ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+  InvalidateSoftwareTLB();
 }
 
 enum TLBLookupResult
@@ -967,7 +1217,8 @@ enum TLBLookupResult
   TLB_UPDATE_C
 };
 
-static TLBLookupResult LookupTLBPageAddress(const XCheckTLBFlag flag, const u32 vpa, u32* paddr)
+static TLBLookupResult LookupTLBPageAddress(const XCheckTLBFlag flag, const u32 vpa, u32* paddr,
+                                            bool* cache_inhibited)
 {
   const u32 tag = vpa >> HW_PAGE_INDEX_SHIFT;
   TLBEntry& tlbe = ppcState.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
@@ -991,6 +1242,7 @@ static TLBLookupResult LookupTLBPageAddress(const XCheckTLBFlag flag, const u32
       tlbe.recent = 0;
 
     *paddr = tlbe.paddr[0] | (vpa & 0xfff);
+    *cache_inhibited = (PTE2_WIMG(tlbe.pte[0]) & 0x4) != 0;
 
     return TLB_FOUND;
   }
@@ -1013,6 +1265,7 @@ static TLBLookupResult LookupTLBPageAddress(const XCheckTLBFlag flag, const u32
       tlbe.recent = 1;
 
     *paddr = tlbe.paddr[1] | (vpa & 0xfff);
+    *cache_inhibited = (PTE2_WIMG(tlbe.pte[1]) & 0x4) != 0;
 
     return TLB_FOUND;
   }
@@ -1044,6 +1297,10 @@ void InvalidateTLBEntry(u32 address)
   TLBEntry& tlbe_i = ppcState.tlb[1][entry_index];
   tlbe_i.tag[0] = TLBEntry::INVALID_TAG;
   tlbe_i.tag[1] = TLBEntry::INVALID_TAG;
+
+  // tlbie drops every entry of the congruence class, regardless of the segment.
+  for (u32 i = entry_index; i < SOFTWARE_TLB_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+    ppcState.software_tlb[i] = {};
 }
 
 // Page Address Translation
@@ -1054,9 +1311,13 @@ static TranslateAddressResult TranslatePageAddress(const u32 address, const XChe
   // benefit
   // much from optimization.
   u32 translatedAddress = 0;
-  TLBLookupResult res = LookupTLBPageAddress(flag, address, &translatedAddress);
+  bool cache_inhibited = false;
+  TLBLookupResult res = LookupTLBPageAddress(flag, address, &translatedAddress, &cache_inhibited);
   if (res == TLB_FOUND)
-    return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED, translatedAddress};
+  {
+    return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED, translatedAddress,
+                                  cache_inhibited};
+  }
 
   u32 sr = PowerPC::ppcState.sr[EA_SR(address)];
 
@@ -1129,7 +1390,7 @@ static TranslateAddressResult TranslatePageAddress(const u32 address, const XChe
           UpdateTLBEntry(flag, PTE2, address);
 
         return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED,
-                                      (PTE2.RPN << 12) | offset};
+                                      (PTE2.RPN << 12) | offset, (PTE2.WIMG & 0x4) != 0};
       }
     }
   }
@@ -1186,13 +1447,15 @@ static void UpdateBATs(BatTable& bat_table, u32 base_spr)
 
         // The bottom bit is whether the translation is valid; the second
         // bit from the bottom is whether we can use the fastmem arena.
+        // MEM1 and MEM2 can't be when the data cache is emulated.
         u32 valid_bit = BAT_MAPPED_BIT;
+        const bool cached_ram = SConfig::GetInstance().bAccurateCPUCache;
         if (Memory::m_pFakeVMEM && (physical_address & 0xFE000000) == 0x7E000000)
           valid_bit |= BAT_PHYSICAL_BIT;
-        else if (physical_address < Memory::REALRAM_SIZE)
+        else if (physical_address < Memory::REALRAM_SIZE && !cached_ram)
           valid_bit |= BAT_PHYSICAL_BIT;
         else if (Memory::m_pEXRAM && physical_address >> 28 == 0x1 &&
-                 (physical_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+                 (physical_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE && !cached_ram)
           valid_bit |= BAT_PHYSICAL_BIT;
         else if (physical_address >> 28 == 0xE &&
                  physical_address < 0xE0000000 + Memory::L1_CACHE_SIZE)
@@ -1202,6 +1465,9 @@ static void UpdateBATs(BatTable& bat_table, u32 base_spr)
         if (PowerPC::memchecks.OverlapsMemcheck(virtual_address, BAT_PAGE_SIZE))
           valid_bit &= ~BAT_PHYSICAL_BIT;
 
+        if (batl.WIMG & 0x4)
+          valid_bit |= BAT_CACHE_INHIBITED_BIT;
+
         // (BEPI | j) == (BEPI & ~BL) | (j & BL).
         bat_table[virtual_address >> BAT_INDEX_SHIFT] = physical_address | valid_bit;
       }
@@ -1244,6 +1510,9 @@ void DBATUpdated()
   Memory::UpdateLogicalMemory(dbat_table);
 #endif
 
+  // BATs take priority over the page table, and memchecks must not be skipped.
+  InvalidateSoftwareTLB();
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   JitInterface::ClearSafe();
 }
@@ -1271,8 +1540,11 @@ void IBATUpdated()
 template <const XCheckTLBFlag flag>
 static TranslateAddressResult TranslateAddress(u32 address)
 {
-  if (TranslateBatAddess(IsOpcodeFlag(flag) ? ibat_table : dbat_table, &address))
-    return TranslateAddressResult{TranslateAddressResult::BAT_TRANSLATED, address};
+  const BatTable& bat_table = IsOpcodeFlag(flag) ? ibat_table : dbat_table;
+  const bool cache_inhibited =
+      (bat_table[address >> BAT_INDEX_SHIFT] & BAT_CACHE_INHIBITED_BIT) != 0;
+  if (TranslateBatAddess(bat_table, &address))
+    return TranslateAddressResult{TranslateAddressResult::BAT_TRANSLATED, address, cache_inhibited};
 
   return TranslatePageAddress(address, flag);
 }
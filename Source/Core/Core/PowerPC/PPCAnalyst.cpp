@@ -15,6 +15,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
+#include "Core/HLE/HLE.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -39,8 +40,15 @@ constexpr int CODEBUFFER_SIZE = 32000;
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
+// The maximum number of likely taken conditional branches to follow in a single block.
+constexpr u32 LIKELY_BRANCH_FOLLOWING_THRESHOLD = 4;
+
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
+// The maximum number of instructions to look at when searching a branch target for overwritten
+// registers.
+constexpr u32 LIVENESS_SCAN_LENGTH = 32;
+
 CodeBuffer::CodeBuffer(int size)
 {
   codebuffer = new PPCAnalyst::CodeOp[size];
@@ -455,6 +463,154 @@ void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
   INFO_LOG(OSHLE, "Average size: %i (leaf), %i (nice), %i(unnice)", leafSize, niceSize, unniceSize);
 }
 
+// Checks whether code[0] up to the branch at code[branch] form a loop which does nothing but poll
+// memory. Every iteration then computes the same values from the same loads, so once the loop
+// branches back, it keeps spinning until something else changes memory, which only happens
+// through scheduled events (or the GPU thread, which CoreTiming::Idle syncs with).
+static bool IsSpinLoop(const CodeOp* code, u32 branch)
+{
+  const CodeOp& back_edge = code[branch];
+  // Calls and counting loops make progress by themselves.
+  if (back_edge.inst.LK || back_edge.likelyTaken ||
+      (back_edge.inst.OPCD == 16 && (back_edge.inst.BO & BO_DONT_DECREMENT_FLAG) == 0))
+  {
+    return false;
+  }
+
+  BitSet32 gpr_written;
+  for (u32 i = 0; i < branch; i++)
+    gpr_written |= code[i].regsOut;
+
+  BitSet32 gpr_defined;
+  bool ca_defined = false;
+  for (u32 i = 0; i <= branch; i++)
+  {
+    const CodeOp& op = code[i];
+
+    // HLE functions replace the guest code with arbitrary host code.
+    if (HLE::GetFirstFunctionIndex(op.address) != 0)
+      return false;
+
+    if (i == branch)
+      break;
+
+    if (op.opinfo->flags & FL_EVIL)
+      return false;
+
+    switch (op.opinfo->type)
+    {
+    case OPTYPE_INTEGER:
+    case OPTYPE_LOAD:
+      break;
+    case OPTYPE_BRANCH:
+      // Leaving the loop is fine, as long as the branch doesn't do anything else.
+      if (op.inst.OPCD != 16 || op.inst.LK || op.likelyTaken ||
+          (op.inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      {
+        return false;
+      }
+      break;
+    default:
+      // Stores, system registers, cache operations, floating point and so on.
+      return false;
+    }
+
+    // A value carried over from the previous iteration (like an update form load's base
+    // register) would make each iteration different.
+    if (op.regsIn & gpr_written & ~gpr_defined)
+      return false;
+    if ((op.opinfo->flags & FL_READ_CA) && !ca_defined)
+      return false;
+
+    gpr_defined |= op.regsOut;
+    ca_defined |= (op.opinfo->flags & FL_SET_CA) != 0;
+  }
+
+  return true;
+}
+
+// Finds the lwz from the stack which reload a value that an earlier instruction in the block
+// stored to or loaded from the same stack slot, with neither the slot nor the register holding it
+// changed in between. Only accesses based on r1 are considered: the stack is always RAM, so
+// unlike MMIO, reading it back has no side effects and returns what was written.
+static void FindForwardedLoads(CodeOp* code, u32 num_instructions)
+{
+  // The register holding the value of each tracked stack slot, by offset from r1.
+  std::map<s16, u8> slots;
+  for (u32 i = 0; i < num_instructions; i++)
+  {
+    CodeOp& op = code[i];
+    const UGeckoInstruction inst = op.inst;
+    const bool stack_lwz = inst.OPCD == 32 && inst.RA == 1;
+    const bool stack_stw = inst.OPCD == 36 && inst.RA == 1;
+
+    if (HLE::GetFirstFunctionIndex(op.address) != 0 || (op.opinfo->flags & FL_EVIL))
+    {
+      // HLE functions replace the guest code with arbitrary host code.
+      slots.clear();
+    }
+    else if (stack_lwz)
+    {
+      const auto slot = slots.find(inst.SIMM_16);
+      if (slot != slots.end())
+        op.loadForwardedFrom = slot->second;
+    }
+    else if (stack_stw)
+    {
+      // Forget the slots which overlap the stored word.
+      for (auto it = slots.begin(); it != slots.end();)
+      {
+        if (it->first > inst.SIMM_16 - 4 && it->first < inst.SIMM_16 + 4)
+          it = slots.erase(it);
+        else
+          ++it;
+      }
+    }
+    else
+    {
+      switch (op.opinfo->type)
+      {
+      case OPTYPE_INTEGER:
+      case OPTYPE_CR:
+      case OPTYPE_LOAD:
+      case OPTYPE_LOADFP:
+      case OPTYPE_LOADPS:
+      case OPTYPE_SINGLEFP:
+      case OPTYPE_DOUBLEFP:
+      case OPTYPE_PS:
+      case OPTYPE_BRANCH:
+        break;
+      default:
+        // Stores through other pointers might point into the stack, and system registers, cache
+        // operations and the like can change memory in other ways.
+        slots.clear();
+        break;
+      }
+    }
+
+    // Forget the slots held by the registers this instruction overwrites.
+    if (op.regsOut[1])
+    {
+      slots.clear();
+    }
+    else
+    {
+      for (auto it = slots.begin(); it != slots.end();)
+      {
+        if (op.regsOut[it->second])
+          it = slots.erase(it);
+        else
+          ++it;
+      }
+    }
+
+    if (stack_stw)
+      slots[inst.SIMM_16] = static_cast<u8>(inst.RS);
+    else if (stack_lwz && inst.RD != 1)
+      slots[inst.SIMM_16] = static_cast<u8>(inst.RD);
+  }
+}
+
 static bool isCmp(const CodeOp& a)
 {
   return (a.inst.OPCD == 10 || a.inst.OPCD == 11) ||
@@ -710,6 +866,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
   bool found_call = false;
   size_t caller = 0;
   u32 numFollows = 0;
+  u32 numLikelyFollows = 0;
   u32 num_inst = 0;
 
   for (u32 i = 0; i < blockSize; ++i)
@@ -733,6 +890,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
     code[i].branchTo = UINT32_MAX;
     code[i].branchToIndex = UINT32_MAX;
     code[i].skip = false;
+    code[i].loadForwardedFrom = -1;
     block->m_stats->numCycles += opinfo->numCycles;
     block->m_physical_addresses.insert(result.physical_address);
 
@@ -804,6 +962,25 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
       }
     }
 
+    if (!follow && HasOption(OPTION_FOLLOW_LIKELY_BRANCHES) && m_likely_taken_branches &&
+        numLikelyFollows < LIKELY_BRANCH_FOLLOWING_THRESHOLD && inst.OPCD == 16 && !inst.LK &&
+        blockSize > 1 && m_likely_taken_branches->count(address))
+    {
+      // Don't unroll loops back to the start of the block; block linking handles those fine.
+      const u32 target = SignExt16(inst.BD << 2) + (inst.AA ? 0 : address);
+      if (target != block->m_address)
+      {
+        follow = true;
+        destination = target;
+        code[i].likelyTaken = true;
+        numLikelyFollows++;
+
+        // The fall-through path leaves the block, so we can't guarantee to get the matching
+        // CALL/RET pair either.
+        found_call = false;
+      }
+    }
+
     if (HasOption(OPTION_CONDITIONAL_CONTINUE))
     {
       if (inst.OPCD == 16 &&
@@ -833,8 +1010,9 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
 
     if (follow)
     {
-      // Follow the unconditional branch.
-      numFollows++;
+      // Follow the unconditional (or likely taken) branch.
+      if (!code[i].likelyTaken)
+        numFollows++;
       address = destination;
     }
     else
@@ -968,7 +1146,102 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
   block->m_gqr_used = gqrUsed;
   block->m_gqr_modified = gqrModified;
   block->m_gpr_inputs = gprBlockInputs;
+
+  if (HasOption(OPTION_CROSS_BLOCK_LIVENESS))
+  {
+    for (u32 i = 0; i < block->m_num_instructions; i++)
+    {
+      const UGeckoInstruction inst = code[i].inst;
+      const bool last = i == block->m_num_instructions - 1;
+      u32 target;
+      if (inst.OPCD == 18 && last)
+      {
+        target = SignExt26(inst.LI << 2) + (inst.AA ? 0 : code[i].address);
+      }
+      else if (inst.OPCD == 16 && !code[i].likelyTaken &&
+               (last || (inst.BO & BO_DONT_DECREMENT_FLAG) == 0 ||
+                (inst.BO & BO_DONT_CHECK_CONDITION) == 0))
+      {
+        target = SignExt16(inst.BD << 2) + (inst.AA ? 0 : code[i].address);
+      }
+      else
+      {
+        // Either not a static branch, or one which the block follows.
+        continue;
+      }
+
+      code[i].gprDeadAtTarget = FindGPRsOverwrittenAt(target, &block->m_physical_addresses);
+    }
+  }
+
+  if (HasOption(OPTION_LOAD_FORWARDING))
+    FindForwardedLoads(code, block->m_num_instructions);
+
+  if (HasOption(OPTION_SPIN_LOOP_DETECTION))
+  {
+    for (u32 i = 0; i < block->m_num_instructions; i++)
+    {
+      const UGeckoInstruction inst = code[i].inst;
+      u32 target;
+      if (inst.OPCD == 16)
+        target = SignExt16(inst.BD << 2) + (inst.AA ? 0 : code[i].address);
+      else if (inst.OPCD == 18 && i == block->m_num_instructions - 1)
+        target = SignExt26(inst.LI << 2) + (inst.AA ? 0 : code[i].address);
+      else
+        continue;
+
+      // The first branch back to the start closes the loop.
+      if (target == block->m_address)
+      {
+        code[i].spinLoopBranch = IsSpinLoop(code, i);
+        break;
+      }
+    }
+  }
+
   return address;
 }
 
+BitSet32 PPCAnalyzer::FindGPRsOverwrittenAt(u32 address, std::set<u32>* physical_addresses)
+{
+  BlockRegStats gpa, fpa;
+  CodeBlock scratch_block;
+  scratch_block.m_gpa = &gpa;
+  scratch_block.m_fpa = &fpa;
+  gpa.Clear();
+  fpa.Clear();
+
+  BitSet32 read, overwritten;
+  for (u32 i = 0; i < LIVENESS_SCAN_LENGTH; ++i, address += 4)
+  {
+    // HLE functions read their arguments from ppcState.
+    if (HLE::GetFirstFunctionIndex(address) != 0)
+      break;
+
+    const PowerPC::TryReadInstResult result = PowerPC::TryReadInstruction(address);
+    if (!result.valid)
+      break;
+
+    CodeOp op = {};
+    op.inst = result.hex;
+    op.address = address;
+    GekkoOPInfo* opinfo = GetOpInfo(op.inst);
+    if (!opinfo || opinfo->type == OPTYPE_INVALID || opinfo->type == OPTYPE_UNKNOWN)
+      break;
+
+    op.opinfo = opinfo;
+    SetInstructionStats(&scratch_block, &op, opinfo, i);
+    physical_addresses->insert(result.physical_address);
+
+    read |= op.regsIn;
+    overwritten |= op.regsOut & ~read;
+
+    // Past this point, the registers may be read by code we don't know about.
+    if (opinfo->flags & FL_ENDBLOCK)
+      break;
+  }
+
+  return overwritten;
+}
+
 }  // namespace
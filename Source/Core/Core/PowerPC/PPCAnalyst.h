@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -44,6 +45,18 @@ struct CodeOp  // 16B
   bool canEndBlock;
   bool skipLRStack;
   bool skip;  // followed BL-s for example
+  // A conditional branch which the block follows, because it's nearly always taken. Only the
+  // fall-through path leaves the block.
+  bool likelyTaken;
+  // For a branch leaving the block, the GPRs which the code at the branch target overwrites
+  // before reading them. They don't need to be written back when taking the branch.
+  BitSet32 gprDeadAtTarget;
+  // A branch back to the start of the block, where the loop in between only polls memory (see
+  // OPTION_SPIN_LOOP_DETECTION). Taking it means nothing can change until the next event.
+  bool spinLoopBranch;
+  // For a lwz from the stack, a GPR which already holds the loaded value, because an earlier
+  // instruction in the block stored or loaded it (see OPTION_LOAD_FORWARDING). -1 if there is none.
+  s8 loadForwardedFrom;
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
   BitSet32 gprInUse;
@@ -177,9 +190,11 @@ private:
   void ReorderInstructionsCore(u32 instructions, CodeOp* code, bool reverse, ReorderType type);
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
+  BitSet32 FindGPRsOverwrittenAt(u32 address, std::set<u32>* physical_addresses);
 
   // Options
   u32 m_options;
+  const std::unordered_set<u32>* m_likely_taken_branches = nullptr;
 
 public:
   enum AnalystOption
@@ -218,6 +233,27 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Follow conditional branches which the JIT has profiled as nearly always taken, forming
+    // superblocks out of what would otherwise be chains of linked blocks.
+    // Requires JIT support for side exits on the fall-through path.
+    OPTION_FOLLOW_LIKELY_BRANCHES = (1 << 7),
+
+    // Look at the start of the blocks that static branches leave to, and find the registers which
+    // are overwritten there before being read (see CodeOp::gprDeadAtTarget).
+    // The scanned code is added to the block's physical addresses, so that the block gets
+    // invalidated along with it.
+    OPTION_CROSS_BLOCK_LIVENESS = (1 << 8),
+
+    // Detect loops back to the start of the block which have no effects besides polling memory,
+    // so that the JIT can skip ahead to the next event instead of spinning (see
+    // CodeOp::spinLoopBranch). This catches more shapes than the hardcoded idle loop patterns.
+    OPTION_SPIN_LOOP_DETECTION = (1 << 9),
+
+    // Find the reloads of stack slots whose value is still in a register (see
+    // CodeOp::loadForwardedFrom), so that the JIT can emit a register copy instead of the load.
+    // Requires JIT support, which must not use it while memchecks are active.
+    OPTION_LOAD_FORWARDING = (1 << 10),
   };
 
   PPCAnalyzer() : m_options(0) {}
@@ -225,6 +261,11 @@ public:
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  // The addresses of the conditional branches to follow with OPTION_FOLLOW_LIKELY_BRANCHES.
+  void SetLikelyTakenBranches(const std::unordered_set<u32>* branches)
+  {
+    m_likely_taken_branches = branches;
+  }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32 blockSize);
 };
 
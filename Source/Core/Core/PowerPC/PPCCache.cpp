@@ -4,6 +4,7 @@
 
 #include "Core/PowerPC/PPCCache.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "Common/ChunkFile.h"
@@ -17,7 +18,7 @@ namespace PowerPC
 static const u32 s_plru_mask[8] = {11, 11, 19, 19, 37, 37, 69, 69};
 static const u32 s_plru_value[8] = {11, 3, 17, 1, 36, 4, 64, 0};
 
-InstructionCache::InstructionCache()
+static void InitWayTables(u32 (&way_from_valid)[255], u32 (&way_from_plru)[128])
 {
   for (u32 m = 0; m < 0xff; m++)
   {
@@ -56,6 +57,11 @@ InstructionCache::InstructionCache()
   }
 }
 
+InstructionCache::InstructionCache()
+{
+  InitWayTables(way_from_valid, way_from_plru);
+}
+
 void InstructionCache::Reset()
 {
   memset(valid, 0, sizeof(valid));
@@ -163,4 +169,231 @@ void InstructionCache::DoState(PointerWrap& p)
   p.DoArray(lookup_table_ex);
   p.DoArray(lookup_table_vmem);
 }
+
+static u8* GetMemoryLine(u32 addr)
+{
+  if (addr & DCACHE_EXRAM_BIT)
+    return &Memory::m_pEXRAM[addr & ~DCACHE_EXRAM_BIT & ~(DCACHE_BLOCK_SIZE - 1)];
+  return &Memory::m_pRAM[addr & ~(DCACHE_BLOCK_SIZE - 1)];
+}
+
+static u32 GetSet(u32 addr)
+{
+  return (addr >> 5) & (DCACHE_SETS - 1);
+}
+
+DataCache::DataCache()
+{
+  InitWayTables(way_from_valid, way_from_plru);
+}
+
+void DataCache::Init()
+{
+  memset(data, 0, sizeof(data));
+  memset(addrs, 0, sizeof(addrs));
+
+  Reset();
+}
+
+void DataCache::Reset()
+{
+  memset(valid, 0, sizeof(valid));
+  memset(modified, 0, sizeof(modified));
+  memset(plru, 0, sizeof(plru));
+  memset(lookup_table, 0xff, sizeof(lookup_table));
+  memset(lookup_table_ex, 0xff, sizeof(lookup_table_ex));
+}
+
+u8& DataCache::LookupEntry(u32 addr)
+{
+  if (addr & DCACHE_EXRAM_BIT)
+    return lookup_table_ex[(addr & ~DCACHE_EXRAM_BIT) >> 5];
+  return lookup_table[addr >> 5];
+}
+
+void DataCache::WriteBackLine(u32 set, u32 way)
+{
+  if (!(modified[set] & (1 << way)))
+    return;
+  memcpy(GetMemoryLine(addrs[set][way]), data[set][way], DCACHE_BLOCK_SIZE);
+  modified[set] &= ~(1 << way);
+}
+
+void DataCache::EvictLine(u32 set, u32 way)
+{
+  LookupEntry(addrs[set][way]) = 0xff;
+  valid[set] &= ~(1 << way);
+  modified[set] &= ~(1 << way);
+}
+
+u32 DataCache::AllocateLine(u32 addr, bool fill)
+{
+  const u32 set = GetSet(addr);
+  u32 way;
+  if (valid[set] != 0xff)
+    way = way_from_valid[valid[set]];
+  else
+    way = way_from_plru[plru[set]];
+
+  if (valid[set] & (1 << way))
+  {
+    WriteBackLine(set, way);
+    EvictLine(set, way);
+  }
+
+  if (fill)
+    memcpy(data[set][way], GetMemoryLine(addr), DCACHE_BLOCK_SIZE);
+  addrs[set][way] = addr & ~(DCACHE_BLOCK_SIZE - 1);
+  valid[set] |= 1 << way;
+  LookupEntry(addr) = static_cast<u8>(way);
+  return way;
+}
+
+// Splits an access into the parts which fall into each cache line.
+template <typename Function>
+static void ForEachLine(u32 addr, u32 size, Function function)
+{
+  while (size != 0)
+  {
+    const u32 offset = addr & (DCACHE_BLOCK_SIZE - 1);
+    const u32 length = std::min(size, DCACHE_BLOCK_SIZE - offset);
+    function(addr, offset, length);
+    addr += length;
+    size -= length;
+  }
+}
+
+void DataCache::Read(u32 addr, void* buffer, u32 size)
+{
+  u8* dst = static_cast<u8*>(buffer);
+  ForEachLine(addr, size, [&](u32 line_addr, u32 offset, u32 length) {
+    const u32 set = GetSet(line_addr);
+    u32 way = LookupEntry(line_addr);
+    if (way == 0xff && HID0.DLOCK)
+    {
+      memcpy(dst, GetMemoryLine(line_addr) + offset, length);
+    }
+    else
+    {
+      if (way == 0xff)
+        way = AllocateLine(line_addr, true);
+      plru[set] = (plru[set] & ~s_plru_mask[way]) | s_plru_value[way];
+      memcpy(dst, &data[set][way][offset], length);
+    }
+    dst += length;
+  });
+}
+
+void DataCache::Write(u32 addr, const void* buffer, u32 size)
+{
+  const u8* src = static_cast<const u8*>(buffer);
+  ForEachLine(addr, size, [&](u32 line_addr, u32 offset, u32 length) {
+    const u32 set = GetSet(line_addr);
+    u32 way = LookupEntry(line_addr);
+    if (way == 0xff && HID0.DLOCK)
+    {
+      memcpy(GetMemoryLine(line_addr) + offset, src, length);
+    }
+    else
+    {
+      if (way == 0xff)
+        way = AllocateLine(line_addr, true);
+      plru[set] = (plru[set] & ~s_plru_mask[way]) | s_plru_value[way];
+      memcpy(&data[set][way][offset], src, length);
+      modified[set] |= 1 << way;
+    }
+    src += length;
+  });
+}
+
+void DataCache::HostRead(u32 addr, void* buffer, u32 size)
+{
+  u8* dst = static_cast<u8*>(buffer);
+  ForEachLine(addr, size, [&](u32 line_addr, u32 offset, u32 length) {
+    const u32 way = LookupEntry(line_addr);
+    if (way == 0xff)
+      memcpy(dst, GetMemoryLine(line_addr) + offset, length);
+    else
+      memcpy(dst, &data[GetSet(line_addr)][way][offset], length);
+    dst += length;
+  });
+}
+
+void DataCache::HostWrite(u32 addr, const void* buffer, u32 size)
+{
+  const u8* src = static_cast<const u8*>(buffer);
+  ForEachLine(addr, size, [&](u32 line_addr, u32 offset, u32 length) {
+    const u32 way = LookupEntry(line_addr);
+    if (way != 0xff)
+      memcpy(&data[GetSet(line_addr)][way][offset], src, length);
+    memcpy(GetMemoryLine(line_addr) + offset, src, length);
+    src += length;
+  });
+}
+
+void DataCache::ClearLine(u32 addr)
+{
+  const u32 set = GetSet(addr);
+  u32 way = LookupEntry(addr);
+  if (way == 0xff)
+  {
+    if (HID0.DLOCK)
+    {
+      memset(GetMemoryLine(addr), 0, DCACHE_BLOCK_SIZE);
+      return;
+    }
+    // dcbz establishes the line without reading it from memory.
+    way = AllocateLine(addr, false);
+  }
+  plru[set] = (plru[set] & ~s_plru_mask[way]) | s_plru_value[way];
+  memset(data[set][way], 0, DCACHE_BLOCK_SIZE);
+  modified[set] |= 1 << way;
+}
+
+void DataCache::FlushLine(u32 addr)
+{
+  const u32 way = LookupEntry(addr);
+  if (way == 0xff)
+    return;
+  WriteBackLine(GetSet(addr), way);
+  EvictLine(GetSet(addr), way);
+}
+
+void DataCache::StoreLine(u32 addr)
+{
+  const u32 way = LookupEntry(addr);
+  if (way != 0xff)
+    WriteBackLine(GetSet(addr), way);
+}
+
+void DataCache::InvalidateLine(u32 addr)
+{
+  const u32 way = LookupEntry(addr);
+  if (way != 0xff)
+    EvictLine(GetSet(addr), way);
+}
+
+void DataCache::DoState(PointerWrap& p)
+{
+  p.DoArray(data);
+  p.DoArray(addrs);
+  p.DoArray(plru);
+  p.DoArray(valid);
+  p.DoArray(modified);
+
+  // The lookup tables are large and can be rebuilt from the tags.
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    memset(lookup_table, 0xff, sizeof(lookup_table));
+    memset(lookup_table_ex, 0xff, sizeof(lookup_table_ex));
+    for (u32 set = 0; set < DCACHE_SETS; set++)
+    {
+      for (u32 way = 0; way < DCACHE_WAYS; way++)
+      {
+        if (valid[set] & (1 << way))
+          LookupEntry(addrs[set][way]) = static_cast<u8>(way);
+      }
+    }
+  }
+}
 }  // namespace PowerPC
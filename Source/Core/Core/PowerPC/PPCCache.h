@@ -18,6 +18,15 @@ const u32 ICACHE_BLOCK_SIZE = 8;
 const u32 ICACHE_EXRAM_BIT = 0x10000000;
 const u32 ICACHE_VMEM_BIT = 0x20000000;
 
+const u32 DCACHE_SETS = 128;
+const u32 DCACHE_WAYS = 8;
+// size of a data cache block in bytes
+const u32 DCACHE_BLOCK_SIZE = 32;
+
+// The data cache only covers MEM1 and MEM2. Addresses passed to it are physical, with MEM1
+// addresses already masked to RAM_MASK and MEM2 addresses marked by this bit.
+const u32 DCACHE_EXRAM_BIT = 0x10000000;
+
 struct InstructionCache
 {
   u32 data[ICACHE_SETS][ICACHE_WAYS][ICACHE_BLOCK_SIZE];
@@ -39,4 +48,48 @@ struct InstructionCache
   void Reset();
   void DoState(PointerWrap& p);
 };
+
+// Write-back L1 data cache, only used when data cache emulation is enabled. Lines are kept in
+// guest byte order, and finding the way holding a line is a single lookup table access, so hits
+// are about as cheap as going to memory directly.
+struct DataCache
+{
+  u8 data[DCACHE_SETS][DCACHE_WAYS][DCACHE_BLOCK_SIZE];
+  u32 addrs[DCACHE_SETS][DCACHE_WAYS];
+  u32 plru[DCACHE_SETS];
+  u32 valid[DCACHE_SETS];
+  u32 modified[DCACHE_SETS];
+
+  u32 way_from_valid[255];
+  u32 way_from_plru[128];
+
+  u8 lookup_table[1 << 20];
+  u8 lookup_table_ex[1 << 21];
+
+  DataCache();
+  void Init();
+  // Drops every line without writing it back, like HID0[DCFI].
+  void Reset();
+
+  // Loads and stores. A miss allocates a line unless the cache is locked.
+  void Read(u32 addr, void* buffer, u32 size);
+  void Write(u32 addr, const void* buffer, u32 size);
+  // Debugger and other host accesses. These see cached lines but never allocate, and writes go
+  // to memory as well so that the cache and memory stay consistent.
+  void HostRead(u32 addr, void* buffer, u32 size);
+  void HostWrite(u32 addr, const void* buffer, u32 size);
+
+  void ClearLine(u32 addr);       // dcbz
+  void FlushLine(u32 addr);       // dcbf
+  void StoreLine(u32 addr);       // dcbst
+  void InvalidateLine(u32 addr);  // dcbi
+
+  void DoState(PointerWrap& p);
+
+private:
+  u8& LookupEntry(u32 addr);
+  u32 AllocateLine(u32 addr, bool fill);
+  void WriteBackLine(u32 set, u32 way);
+  void EvictLine(u32 set, u32 way);
+};
 }  // namespace PowerPC
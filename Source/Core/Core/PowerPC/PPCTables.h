@@ -94,6 +94,13 @@ struct GekkoOPInfo
   u64 runCount;
   int compileCount;
   u32 lastUse;
+  // Collected by the JITs while block profiling is enabled: the host code emitted for this
+  // instruction, split into the near code and the far code (rarely taken paths), and the host
+  // ticks spent emitting it, over emitCount compilations.
+  u32 emitCount;
+  u64 emittedBytes;
+  u64 emittedFarBytes;
+  u64 emitTicks;
 };
 extern std::array<GekkoOPInfo*, 64> m_infoTable;
 extern std::array<GekkoOPInfo*, 1024> m_infoTable4;
@@ -94,6 +94,7 @@ void DoState(PointerWrap& p)
   p.Do(ppcState.pagetable_hashmask);
 
   ppcState.iCache.DoState(p);
+  ppcState.dCache.DoState(p);
 
   if (p.GetMode() == PointerWrap::MODE_READ)
   {
@@ -219,6 +220,7 @@ void Init(int cpu_core)
 
   InitializeCPUCore(cpu_core);
   ppcState.iCache.Init();
+  ppcState.dCache.Init();
 
   if (SConfig::GetInstance().bEnableDebugging)
     breakpoints.ClearAllTemporary();
@@ -232,6 +234,7 @@ void Reset()
 
   ResetRegisters();
   ppcState.iCache.Reset();
+  ppcState.dCache.Reset();
 }
 
 void ScheduleInvalidateCacheThreadSafe(u32 address)
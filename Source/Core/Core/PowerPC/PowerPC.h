@@ -52,6 +52,23 @@ struct TLBEntry
   u8 recent = 0;
 };
 
+// Host-side cache of page table translations which end up in RAM, looked up before the BATs and
+// the TLB above. It is much larger than the emulated TLB and maps straight to host memory, so the
+// JIT can probe it inline. It isn't part of the emulated state; entries are only added for plain
+// loads and stores, and the whole cache is dropped whenever a mapping may have changed.
+constexpr u32 SOFTWARE_TLB_SIZE = 4096;
+
+struct SoftwareTLBEntry
+{
+  // Tags are page-aligned effective addresses, so this never matches.
+  static constexpr u32 INVALID_TAG = 0xfff;
+
+  u32 read_tag = INVALID_TAG;
+  u32 write_tag = INVALID_TAG;
+  // The host address of the page minus its effective address.
+  uintptr_t host_offset = 0;
+};
+
 // This contains the entire state of the emulated PowerPC "Gekko" CPU.
 struct PowerPCState
 {
@@ -122,6 +139,9 @@ struct PowerPCState
   u32 pagetable_hashmask;
 
   InstructionCache iCache;
+  DataCache dCache;
+
+  std::array<SoftwareTLBEntry, SOFTWARE_TLB_SIZE> software_tlb;
 };
 
 #if _M_X86_64
@@ -270,17 +290,26 @@ void Write_F64(double var, u32 address);
 void DMA_LCToMemory(u32 memAddr, u32 cacheAddr, u32 numBlocks);
 void DMA_MemoryToLC(u32 cacheAddr, u32 memAddr, u32 numBlocks);
 void ClearCacheLine(u32 address);  // Zeroes 32 bytes; address should be 32-byte-aligned
+// These only do something when the data cache is emulated.
+void FlushCacheLine(u32 address);       // dcbf
+void StoreCacheLine(u32 address);       // dcbst
+void InvalidateCacheLine(u32 address);  // dcbi
 
 // TLB functions
 void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
 void DBATUpdated();
 void IBATUpdated();
+void InvalidateSoftwareTLB();
 
 // Result changes based on the BAT registers and MSR.DR.  Returns whether
 // it's safe to optimize a read or write to this address to an unguarded
 // memory access.  Does not consider page tables.
 bool IsOptimizableRAMAddress(u32 address);
+// Returns a host pointer for an access of <size> bytes to an address for
+// which IsOptimizableRAMAddress is true, or nullptr if the access can't skip
+// the regular checks (including when it crosses into the next BAT page).
+u8* GetOptimizableRAMPointer(u32 address, u32 size);
 u32 IsOptimizableMMIOAccess(u32 address, u32 accessSize);
 bool IsOptimizableGatherPipeWrite(u32 address);
 
@@ -291,12 +320,15 @@ struct TranslateResult
   u32 address;
 };
 TranslateResult JitCache_TranslateAddress(u32 address);
+// Translates a data address for the debugger, without raising an exception if that fails.
+TranslateResult HostTranslateAddress(u32 address);
 
 constexpr int BAT_INDEX_SHIFT = 17;
 constexpr u32 BAT_PAGE_SIZE = 1 << BAT_INDEX_SHIFT;
 constexpr u32 BAT_MAPPED_BIT = 0x1;
 constexpr u32 BAT_PHYSICAL_BIT = 0x2;
-constexpr u32 BAT_RESULT_MASK = UINT32_C(~0x3);
+constexpr u32 BAT_CACHE_INHIBITED_BIT = 0x4;
+constexpr u32 BAT_RESULT_MASK = UINT32_C(~0x7);
 using BatTable = std::array<u32, 1 << (32 - BAT_INDEX_SHIFT)>;  // 128 KB
 extern BatTable ibat_table;
 extern BatTable dbat_table;
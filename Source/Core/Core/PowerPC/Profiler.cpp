@@ -4,16 +4,197 @@
 
 #include "Core/PowerPC/Profiler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/File.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/SymbolDB.h"
+#include "Common/Thread.h"
+#include "Core/HW/CPU.h"
 #include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
 
 namespace Profiler
 {
 bool g_ProfileBlocks;
+bool g_SampleBlocks;
+u32 g_sampled_block_address;
+
+// Host timers only get this precise on some platforms, which is fine, since each sample is
+// weighted by the time that actually passed.
+static constexpr std::chrono::milliseconds SAMPLE_INTERVAL{1};
+static constexpr size_t TOP_FUNCTIONS = 50;
+
+static std::thread s_sampler_thread;
+static Common::Event s_sampler_stop;
+static std::mutex s_samples_lock;
+// Host ticks by block address. Address 0 collects the time spent outside of JIT blocks.
+static std::map<u32, u64> s_samples;
+static u64 s_sampled_ticks;
+
+static void SamplerThread()
+{
+  Common::SetCurrentThreadName("JIT sampler");
+
+  u64 last_ticks;
+  QueryPerformanceCounter((LARGE_INTEGER*)&last_ticks);
+  while (!s_sampler_stop.WaitFor(SAMPLE_INTERVAL))
+  {
+    u64 ticks;
+    QueryPerformanceCounter((LARGE_INTEGER*)&ticks);
+    const u64 elapsed = ticks - last_ticks;
+    last_ticks = ticks;
+
+    // Time spent paused or stepping isn't interesting.
+    if (CPU::GetState() != CPU::State::Running)
+      continue;
+
+    const u32 address = g_sampled_block_address;
+    std::lock_guard<std::mutex> lk(s_samples_lock);
+    s_samples[address] += elapsed;
+    s_sampled_ticks += elapsed;
+  }
+}
+
+void StartSampling()
+{
+  StopSampling();
+
+  {
+    std::lock_guard<std::mutex> lk(s_samples_lock);
+    s_samples.clear();
+    s_sampled_ticks = 0;
+  }
+
+  g_sampled_block_address = 0;
+  s_sampler_stop.Reset();
+  s_sampler_thread = std::thread(SamplerThread);
+}
+
+void StopSampling()
+{
+  if (!s_sampler_thread.joinable())
+    return;
+
+  s_sampler_stop.Set();
+  s_sampler_thread.join();
+}
+
+static std::string GetFunctionName(u32 address, u32* function_address)
+{
+  if (address == 0)
+  {
+    *function_address = 0;
+    return "[outside JIT blocks]";
+  }
+
+  const Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (!symbol)
+  {
+    *function_address = address;
+    return StringFromFormat("[unknown %08x]", address);
+  }
+
+  *function_address = symbol->address;
+  return symbol->name;
+}
 
 void WriteProfileResults(const std::string& filename)
 {
   JitInterface::WriteProfileResults(filename);
+
+  std::map<u32, u64> samples;
+  u64 sampled_ticks;
+  {
+    std::lock_guard<std::mutex> lk(s_samples_lock);
+    samples = s_samples;
+    sampled_ticks = s_sampled_ticks;
+  }
+
+  if (samples.empty())
+    return;
+
+  // Summed up by function, with the name kept alongside for printing.
+  std::map<u32, std::pair<std::string, u64>> functions;
+  for (const auto& sample : samples)
+  {
+    u32 function_address;
+    std::string name = GetFunctionName(sample.first, &function_address);
+    auto& function = functions[function_address];
+    function.first = std::move(name);
+    function.second += sample.second;
+  }
+
+  std::vector<std::pair<u32, std::pair<std::string, u64>>> sorted(functions.begin(),
+                                                                  functions.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.second.second > b.second.second;
+  });
+  if (sorted.size() > TOP_FUNCTIONS)
+    sorted.resize(TOP_FUNCTIONS);
+
+  File::IOFile f(filename, "a");
+  if (!f)
+  {
+    ERROR_LOG(POWERPC, "Failed to append the sampled profile to %s", filename.c_str());
+    return;
+  }
+
+  u64 counts_per_sec;
+  QueryPerformanceFrequency((LARGE_INTEGER*)&counts_per_sec);
+
+  fprintf(f.GetHandle(), "\nfuncAddr\tfuncName\tsampledTicks\tpercent\tsampledTime(ms)\n");
+  for (const auto& function : sorted)
+  {
+    const u64 ticks = function.second.second;
+    fprintf(f.GetHandle(), "%08x\t%s\t%" PRIu64 "\t%.2f\t%.2f\n", function.first,
+            function.second.first.c_str(), ticks, 100.0 * ticks / sampled_ticks,
+            ticks * 1000.0 / counts_per_sec);
+  }
+}
+
+void WriteCollapsedStacks(const std::string& filename)
+{
+  std::map<u32, u64> samples;
+  {
+    std::lock_guard<std::mutex> lk(s_samples_lock);
+    samples = s_samples;
+  }
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG(POWERPC, "Failed to open %s", filename.c_str());
+    return;
+  }
+
+  for (const auto& sample : samples)
+  {
+    u32 function_address;
+    std::string name = GetFunctionName(sample.first, &function_address);
+    // Semicolons separate the frames, and the count comes after the last space.
+    std::replace(name.begin(), name.end(), ';', ':');
+    if (sample.first == 0)
+      fprintf(f.GetHandle(), "%s %" PRIu64 "\n", name.c_str(), sample.second);
+    else
+      fprintf(f.GetHandle(), "%s;%08x %" PRIu64 "\n", name.c_str(), sample.first, sample.second);
+  }
 }
 
 }  // namespace
@@ -43,8 +43,9 @@
 
 struct BlockStat
 {
-  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size)
-      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size)
+  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size, u32 far_size)
+      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size),
+        far_code_size(far_size)
   {
   }
   u32 addr;
@@ -52,12 +53,62 @@ struct BlockStat
   u64 tick_counter;
   u64 run_count;
   u32 block_size;
+  u32 far_code_size;
 
   bool operator<(const BlockStat& other) const { return cost > other.cost; }
 };
+struct BackpatchStat
+{
+  BackpatchStat(u32 _addr, u32 _count) : addr(_addr), count(_count) {}
+  u32 addr;
+  u32 count;
+
+  bool operator<(const BackpatchStat& other) const { return count > other.count; }
+};
+// The inline cache of an indirect branch, counted since its target was last chosen.
+struct IndirectBranchStat
+{
+  IndirectBranchStat(u32 _addr, u32 _target, u64 _hits, u64 _misses)
+      : addr(_addr), target(_target), hits(_hits), misses(_misses)
+  {
+  }
+  u32 addr;
+  u32 target;
+  u64 hits;
+  u64 misses;
+
+  bool operator<(const IndirectBranchStat& other) const
+  {
+    return hits + misses > other.hits + other.misses;
+  }
+};
+// The host code the JIT emitted for one kind of PPC instruction.
+struct EmitterStat
+{
+  EmitterStat(const char* _name, u32 count, u64 near_bytes, u64 far_bytes, u64 ticks)
+      : name(_name), emit_count(count), emitted_bytes(near_bytes), emitted_far_bytes(far_bytes),
+        emit_ticks(ticks)
+  {
+  }
+  const char* name;
+  u32 emit_count;
+  u64 emitted_bytes;
+  u64 emitted_far_bytes;
+  u64 emit_ticks;
+
+  bool operator<(const EmitterStat& other) const
+  {
+    return emitted_bytes + emitted_far_bytes > other.emitted_bytes + other.emitted_far_bytes;
+  }
+};
 struct ProfileStats
 {
   std::vector<BlockStat> block_stats;
+  // Instructions whose fastmem accesses were backpatched to slowmem.
+  std::vector<BackpatchStat> backpatch_stats;
+  // Indirect branches with an inline cache. Misses are the executions which used the dispatcher.
+  std::vector<IndirectBranchStat> indirect_branch_stats;
+  std::vector<EmitterStat> emitter_stats;
   u64 cost_sum;
   u64 timecost_sum;
   u64 countsPerSec;
@@ -67,5 +118,22 @@ namespace Profiler
 {
 extern bool g_ProfileBlocks;
 
+// The sampling profiler. Unlike g_ProfileBlocks, it doesn't time every block execution, which
+// distorts the results for short blocks. Instead, the JIT stores the address of each block it
+// enters in g_sampled_block_address (and the dispatcher clears it before running CoreTiming),
+// and a separate thread periodically attributes the host time since its last sample to the
+// block found there.
+extern bool g_SampleBlocks;
+extern u32 g_sampled_block_address;
+
+// Called by JitInterface when the JIT core is created and shut down. Starting discards the
+// samples of the previous session.
+void StartSampling();
+void StopSampling();
+
+// Writes the block profile, followed by the functions with the most sampled host time.
 void WriteProfileResults(const std::string& filename);
+// Writes the sampled host time as "function;block ticks" lines, which is the collapsed stack
+// format that flame graph tools take as input.
+void WriteCollapsedStacks(const std::string& filename);
 }
@@ -11,10 +11,13 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
+#include "Common/WorkerPool.h"
 
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -115,6 +118,11 @@ bool Compare(u32 address, u32 size, const MEGASignature& sig)
   }
   return true;
 }
+
+u64 GetIndexKey(u32 size, u32 first_instruction)
+{
+  return static_cast<u64>(size) << 32 | first_instruction;
+}
 }  // Anonymous namespace
 
 MEGASignatureDB::MEGASignatureDB() = default;
@@ -123,6 +131,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -141,6 +150,9 @@ bool MEGASignatureDB::Load(const std::string& file_path)
 
     if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
     {
+      const u32 size = static_cast<u32>(sig.code.size() * sizeof(u32));
+      const u32 first_instruction = sig.code.empty() ? 0 : sig.code[0];
+      m_index[GetIndexKey(size, first_instruction)].push_back(m_signatures.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -157,22 +169,54 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
   return false;
 }
 
-void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
+// Returns the first loaded signature which matches the function, like going through all of them
+// in order would, but only compares the ones with the same size and first instruction, and the
+// ones starting with a wildcard.
+const MEGASignature* MEGASignatureDB::FindSignature(u32 address, u32 size) const
 {
-  for (auto& it : symbol_db->AccessSymbols())
+  static const std::vector<size_t> no_signatures;
+  const auto find = [this](u64 key) -> const std::vector<size_t>& {
+    const auto it = m_index.find(key);
+    return it != m_index.end() ? it->second : no_signatures;
+  };
+
+  const std::vector<size_t>& exact = find(GetIndexKey(size, PowerPC::HostRead_U32(address)));
+  const std::vector<size_t>& wildcard = find(GetIndexKey(size, 0));
+
+  auto exact_it = exact.begin();
+  auto wildcard_it = wildcard.begin();
+  while (exact_it != exact.end() || wildcard_it != wildcard.end())
   {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
-    {
-      if (Compare(symbol.address, symbol.size, sig))
-      {
-        symbol.name = sig.name;
-        INFO_LOG(OSHLE, "Found %s at %08x (size: %08x)!", sig.name.c_str(), symbol.address,
-                 symbol.size);
-        break;
-      }
-    }
+    size_t index;
+    if (wildcard_it == wildcard.end() || (exact_it != exact.end() && *exact_it < *wildcard_it))
+      index = *exact_it++;
+    else
+      index = *wildcard_it++;
+
+    if (Compare(address, size, m_signatures[index]))
+      return &m_signatures[index];
   }
+  return nullptr;
+}
+
+void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
+{
+  std::vector<Symbol*> symbols;
+  for (auto& it : symbol_db->AccessSymbols())
+    symbols.push_back(&it.second);
+
+  // Matching only reads the memory of each function and renames its own symbol.
+  Common::WorkerPool pool(Common::ThreadPool::GetNumThreads());
+  pool.Run(symbols.size(), [this, &symbols](size_t i) {
+    Symbol& symbol = *symbols[i];
+    const MEGASignature* sig = FindSignature(symbol.address, symbol.size);
+    if (!sig)
+      return;
+
+    symbol.name = sig->name;
+    INFO_LOG(OSHLE, "Found %s at %08x (size: %08x)!", sig->name.c_str(), symbol.address,
+             symbol.size);
+  });
   symbol_db->Index();
 }
 
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -53,5 +55,10 @@ public:
   bool Add(u32 startAddr, u32 size, const std::string& name) override;
 
 private:
+  const MEGASignature* FindSignature(u32 address, u32 size) const;
+
   std::vector<MEGASignature> m_signatures;
+  // Indices of the signatures of each size and first instruction, in the order they were loaded.
+  // Signatures which start with a wildcard are stored under a first instruction of 0.
+  std::unordered_map<u64, std::vector<size_t>> m_index;
 };
@@ -0,0 +1,325 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/Rewind.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/Movie.h"
+#include "Core/NetPlayClient.h"
+#include "Core/State.h"
+
+namespace Rewind
+{
+// Savestates are compared in blocks of this size. Most of a savestate is emulated memory, of
+// which games only change a small part every second.
+static constexpr size_t BLOCK_SIZE = 0x1000;
+static constexpr size_t INDEX_BITS = 20;
+
+struct DeltaOp
+{
+  // literal_size bytes from the literals, followed by copy_size bytes from the newer savestate.
+  u32 literal_size;
+  u32 copy_size;
+  u64 copy_offset;
+};
+
+// The difference between a savestate and the one taken after it.
+struct Delta
+{
+  size_t size;
+  std::vector<DeltaOp> ops;
+  std::vector<u8> literals;
+
+  size_t GetMemoryUsage() const { return ops.size() * sizeof(DeltaOp) + literals.size(); }
+};
+
+// The weak checksum of rsync, which can be moved along the data one byte at a time. It is used
+// to find blocks of the newer savestate in the older one even if data before them has changed
+// size, which happens whenever one of the variable-sized parts of a savestate changes.
+class RollingChecksum
+{
+public:
+  void Init(const u8* data)
+  {
+    m_a = 0;
+    m_b = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; ++i)
+    {
+      m_a += data[i];
+      m_b += static_cast<u32>(BLOCK_SIZE - i) * data[i];
+    }
+  }
+
+  void Roll(u8 out, u8 in)
+  {
+    m_a += in - out;
+    m_b += m_a - static_cast<u32>(BLOCK_SIZE) * out;
+  }
+
+  u32 Get() const { return (m_a & 0xffff) | (m_b << 16); }
+
+private:
+  u32 m_a = 0;
+  u32 m_b = 0;
+};
+
+// Maps the checksums of the blocks of the newest savestate to block numbers (plus one, so that
+// zero means empty). Collisions simply replace each other, since every match is verified.
+class BlockIndex
+{
+public:
+  void Build(const std::vector<u8>& state)
+  {
+    m_table.assign(size_t(1) << INDEX_BITS, 0);
+    RollingChecksum checksum;
+    for (size_t block = 0; (block + 1) * BLOCK_SIZE <= state.size(); ++block)
+    {
+      checksum.Init(state.data() + block * BLOCK_SIZE);
+      m_table[Slot(checksum.Get())] = static_cast<u32>(block + 1);
+    }
+  }
+
+  // Returns the block number plus one, or zero.
+  u32 Find(u32 checksum) const { return m_table[Slot(checksum)]; }
+
+private:
+  static size_t Slot(u32 checksum) { return (checksum * 0x9E3779B1u) >> (32 - INDEX_BITS); }
+
+  std::vector<u32> m_table;
+};
+
+// Describes older in terms of newer.
+static Delta Encode(const std::vector<u8>& older, const std::vector<u8>& newer,
+                    const BlockIndex& index)
+{
+  Delta delta;
+  delta.size = older.size();
+
+  const u8* data = older.data();
+  const size_t size = older.size();
+  size_t position = 0;
+  size_t literal_start = 0;
+  bool checksum_valid = false;
+  RollingChecksum checksum;
+
+  auto add_op = [&](u64 copy_offset, size_t copy_size) {
+    delta.ops.push_back(DeltaOp{static_cast<u32>(position - literal_start),
+                                static_cast<u32>(copy_size), copy_offset});
+    delta.literals.insert(delta.literals.end(), data + literal_start, data + position);
+  };
+
+  while (position + BLOCK_SIZE <= size)
+  {
+    if (!checksum_valid)
+    {
+      checksum.Init(data + position);
+      checksum_valid = true;
+    }
+
+    const u32 block = index.Find(checksum.Get());
+    const u64 copy_offset = static_cast<u64>(block - 1) * BLOCK_SIZE;
+    if (block && std::memcmp(data + position, newer.data() + copy_offset, BLOCK_SIZE) == 0)
+    {
+      // Unchanged data comes in long runs, which are extended block by block.
+      size_t copy_size = BLOCK_SIZE;
+      while (position + copy_size + BLOCK_SIZE <= size &&
+             copy_offset + copy_size + BLOCK_SIZE <= newer.size() &&
+             copy_size + BLOCK_SIZE <= UINT32_MAX &&
+             std::memcmp(data + position + copy_size, newer.data() + copy_offset + copy_size,
+                         BLOCK_SIZE) == 0)
+      {
+        copy_size += BLOCK_SIZE;
+      }
+
+      add_op(copy_offset, copy_size);
+      position += copy_size;
+      literal_start = position;
+      checksum_valid = false;
+      continue;
+    }
+
+    if (position + BLOCK_SIZE < size)
+      checksum.Roll(data[position], data[position + BLOCK_SIZE]);
+    ++position;
+
+    // Keep the literal size within the range of DeltaOp.
+    if (position - literal_start == UINT32_MAX)
+    {
+      add_op(0, 0);
+      literal_start = position;
+    }
+  }
+
+  position = size;
+  add_op(0, 0);
+  return delta;
+}
+
+static std::vector<u8> Apply(const std::vector<u8>& newer, const Delta& delta)
+{
+  std::vector<u8> older(delta.size);
+  u8* out = older.data();
+  const u8* literals = delta.literals.data();
+  for (const DeltaOp& op : delta.ops)
+  {
+    out = std::copy_n(literals, op.literal_size, out);
+    literals += op.literal_size;
+    out = std::copy_n(newer.data() + op.copy_offset, op.copy_size, out);
+  }
+  return older;
+}
+
+static std::atomic<u32> s_fields_since_snapshot{0};
+static std::atomic<bool> s_snapshot_pending{false};
+
+static std::mutex s_mutex;
+static std::condition_variable s_idle_cv;
+static bool s_encoding = false;
+static std::thread s_encode_thread;
+
+// The newest savestate, and the deltas which lead back from it, newest first.
+static std::vector<u8> s_newest;
+static std::deque<Delta> s_history;
+static size_t s_history_usage = 0;
+// The memory of the savestate before the newest one, which the next snapshot is written to.
+// Writing to memory that is already mapped in is much faster than having a fresh allocation
+// zeroed and faulted in, page by page, while the emulation is paused.
+static std::vector<u8> s_spare;
+
+static bool IsAllowed()
+{
+  // Loading savestates desyncs netplay, and movies would need their input to be rewound too.
+  return SConfig::GetInstance().bRewind && !NetPlay::IsNetPlayRunning() &&
+         !Movie::IsMovieActive();
+}
+
+// Requires s_mutex to be held.
+static void TrimHistory()
+{
+  const size_t budget = static_cast<size_t>(std::max(SConfig::GetInstance().iRewindMemoryMB, 0))
+                        << 20;
+  while (!s_history.empty() && s_newest.size() + s_history_usage > budget)
+  {
+    s_history_usage -= s_history.back().GetMemoryUsage();
+    s_history.pop_back();
+  }
+}
+
+static void EncodeSnapshot(std::vector<u8> state)
+{
+  Common::SetCurrentThreadName("Rewind Encoder");
+
+  std::vector<u8> previous;
+  {
+    std::lock_guard<std::mutex> lk(s_mutex);
+    previous = std::move(s_newest);
+  }
+
+  Delta delta;
+  const bool has_previous = !previous.empty();
+  if (has_previous)
+  {
+    BlockIndex index;
+    index.Build(state);
+    delta = Encode(previous, state, index);
+  }
+
+  std::lock_guard<std::mutex> lk(s_mutex);
+  s_spare = std::move(previous);
+  s_newest = std::move(state);
+  if (has_previous)
+  {
+    s_history_usage += delta.GetMemoryUsage();
+    s_history.push_front(std::move(delta));
+  }
+  TrimHistory();
+  s_encoding = false;
+  s_idle_cv.notify_all();
+}
+
+// Called on the host thread, since taking a savestate needs the emulation to be paused.
+static void TakeSnapshot()
+{
+  s_snapshot_pending = false;
+  if (!Core::IsRunning() || !IsAllowed())
+    return;
+
+  std::unique_lock<std::mutex> lk(s_mutex);
+  // Skip this snapshot if the previous one is still being encoded.
+  if (s_encoding)
+    return;
+  s_encoding = true;
+  std::vector<u8> state = std::move(s_spare);
+  lk.unlock();
+
+  State::SaveToBuffer(state);
+
+  // Comparing the savestates takes a while, so it doesn't hold up the emulation.
+  if (s_encode_thread.joinable())
+    s_encode_thread.join();
+  s_encode_thread = std::thread(EncodeSnapshot, std::move(state));
+}
+
+void FieldEnd()
+{
+  if (!SConfig::GetInstance().bRewind)
+    return;
+
+  const u32 interval = static_cast<u32>(std::max(SConfig::GetInstance().iRewindInterval, 1));
+  if (++s_fields_since_snapshot < interval || s_snapshot_pending)
+    return;
+
+  s_fields_since_snapshot = 0;
+  s_snapshot_pending = true;
+  Core::QueueHostJob(TakeSnapshot);
+}
+
+bool StepBack()
+{
+  if (!IsAllowed())
+    return false;
+
+  std::unique_lock<std::mutex> lk(s_mutex);
+  s_idle_cv.wait(lk, [] { return !s_encoding; });
+  if (s_history.empty())
+  {
+    Core::DisplayMessage("Rewind: There is no earlier state.", 2000);
+    return false;
+  }
+
+  s_newest = Apply(s_newest, s_history.front());
+  s_history_usage -= s_history.front().GetMemoryUsage();
+  s_history.pop_front();
+
+  State::LoadFromBuffer(s_newest);
+  s_fields_since_snapshot = 0;
+  return true;
+}
+
+void Clear()
+{
+  if (s_encode_thread.joinable())
+    s_encode_thread.join();
+
+  std::lock_guard<std::mutex> lk(s_mutex);
+  std::vector<u8>().swap(s_newest);
+  std::vector<u8>().swap(s_spare);
+  s_history.clear();
+  s_history_usage = 0;
+  s_fields_since_snapshot = 0;
+}
+}
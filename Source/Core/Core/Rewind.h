@@ -0,0 +1,24 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Rewinding, using savestates which are taken at a regular interval while a game runs.
+//
+// Only the newest savestate is kept in full. Every older one is stored as the difference from
+// the savestate taken after it, which is mostly made up of references to unchanged 4 KiB blocks,
+// so that many seconds of history fit into the memory budget.
+
+#pragma once
+
+namespace Rewind
+{
+// Called on the CPU thread at the end of every VI field.
+void FieldEnd();
+
+// Loads the savestate taken before the newest one, and drops the newest one.
+// Returns false if there is no history to go back to.
+bool StepBack();
+
+// Drops all of the history.
+void Clear();
+}
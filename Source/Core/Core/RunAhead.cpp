@@ -0,0 +1,129 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/RunAhead.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
+#include "Core/CoreTiming.h"
+#include "Core/Movie.h"
+#include "Core/NetPlayClient.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/State.h"
+
+namespace RunAhead
+{
+// Every field costs a savestate load plus one emulated field per frame run ahead, so there is
+// little point in going further than most games' own lag.
+static constexpr int MAX_FRAMES = 6;
+
+static CoreTiming::EventType* s_event_field_begin;
+
+static std::vector<u8> s_state;
+// The number of fields run ahead of s_state so far.
+static int s_fields_ahead = 0;
+static std::atomic<bool> s_running_ahead{false};
+static std::atomic<bool> s_frame_hidden{false};
+static bool s_warned_dual_core = false;
+
+static int GetFrames()
+{
+  const SConfig& config = SConfig::GetInstance();
+  if (config.iRunAheadFrames <= 0)
+    return 0;
+
+  // With dual core, the GPU thread would have to be rolled back too, and loading savestates
+  // desyncs netplay and movies.
+  if (config.bCPUThread)
+  {
+    if (!s_warned_dual_core)
+      WARN_LOG(CORE, "Run-ahead is only available in single core mode.");
+    s_warned_dual_core = true;
+    return 0;
+  }
+  if (NetPlay::IsNetPlayRunning() || Movie::IsMovieActive())
+    return 0;
+
+  return std::min(config.iRunAheadFrames, MAX_FRAMES);
+}
+
+// This runs as its own event rather than from the VI event, which reschedules itself only after
+// the field has begun and would be missing from the savestate.
+static void FieldBeginCallback(u64 userdata, s64 cycles_late)
+{
+  const int frames = GetFrames();
+
+  if (s_running_ahead)
+  {
+    ++s_fields_ahead;
+    if (frames != 0 && s_fields_ahead < frames)
+    {
+      // Only the last field run ahead is shown.
+      s_frame_hidden = s_fields_ahead + 1 < frames;
+      return;
+    }
+
+    // The last field run ahead has just been output, so go back and emulate the next field for
+    // real. Its own output is out of date and never shown.
+    JitInterface::PrepareRollback();
+    State::LoadFromBuffer(s_state);
+    s_frame_hidden = frames != 0;
+    return;
+  }
+
+  if (frames == 0)
+  {
+    s_frame_hidden = false;
+    std::vector<u8>().swap(s_state);
+    return;
+  }
+
+  State::SaveToBuffer(s_state);
+  JitInterface::SetRollbackPoint();
+  s_fields_ahead = 0;
+  s_running_ahead = true;
+  s_frame_hidden = frames > 1;
+}
+
+void Init()
+{
+  s_event_field_begin = CoreTiming::RegisterEvent("RunAheadFieldBegin", FieldBeginCallback);
+  s_warned_dual_core = false;
+  Reset();
+}
+
+void Shutdown()
+{
+  Reset();
+  std::vector<u8>().swap(s_state);
+}
+
+void FieldBegin()
+{
+  if (s_running_ahead || SConfig::GetInstance().iRunAheadFrames > 0)
+    CoreTiming::ScheduleEvent(0, s_event_field_begin);
+}
+
+void Reset()
+{
+  s_fields_ahead = 0;
+  s_running_ahead = false;
+  s_frame_hidden = false;
+}
+
+bool IsRunningAhead()
+{
+  return s_running_ahead;
+}
+
+bool IsFrameHidden()
+{
+  return s_frame_hidden;
+}
+}
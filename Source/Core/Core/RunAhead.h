@@ -0,0 +1,31 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Run-ahead, which hides the input lag that games have on top of the emulator's.
+//
+// At the start of every VI field, a savestate is taken in memory. The emulation then runs
+// iRunAheadFrames more fields with the current input, of which only the last one is shown, and
+// goes back to the savestate. The next field is then emulated for real, without being shown, and
+// the cycle starts over. The fields that are only run ahead are muted and not throttled, so the
+// game keeps its normal speed and sound, but responds that many fields earlier.
+
+#pragma once
+
+namespace RunAhead
+{
+void Init();
+void Shutdown();
+
+// Called on the CPU thread at the start of every VI field, after the field has been output.
+void FieldBegin();
+
+// Forgets where the fields being run ahead started, for when a savestate is loaded.
+void Reset();
+
+// Whether the current field is only being run ahead and will be rolled back.
+bool IsRunningAhead();
+
+// Whether the frames output during the current field shouldn't be presented.
+bool IsFrameHidden();
+}
@@ -4,6 +4,8 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
@@ -11,6 +13,7 @@
 #include <thread>
 #include <utility>
 #include <vector>
+#include <zlib.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -22,6 +25,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/WorkerPool.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -33,6 +37,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/RunAhead.h"
 
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -50,12 +55,35 @@ static const u32 IN_LEN = 128 * 1024u;
 
 static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
-static unsigned char __LZO_MMODEL out[OUT_LEN];
+// Compressed savestates are split into chunks which are compressed and decompressed in
+// parallel. Older savestates are a stream of LZO blocks of IN_LEN bytes instead, which starts
+// with the size of the first block, which is always smaller than CHUNKED_STATE_MAGIC.
+static const u32 CHUNKED_STATE_MAGIC = 0x4B484344;  // "DCHK"
+static const u32 CHUNK_SIZE = 1024 * 1024;
+// Set in the size of a chunk which didn't get smaller and is stored uncompressed.
+static const u32 CHUNK_STORED_FLAG = 0x80000000;
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
+enum class ChunkCompression : u32
+{
+  LZO = 0,
+  Zlib = 1,
+};
+
+struct ChunkedStateHeader
+{
+  u32 magic;
+  ChunkCompression compression;
+  u32 chunk_size;
+  u32 num_chunks;
+  // Followed by the stored size of each chunk, and then by the chunks.
+};
 
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+// Only used by the compression thread, and when loading, which waits for that thread first.
+static Common::WorkerPool& GetCompressionPool()
+{
+  static Common::WorkerPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+  return pool;
+}
 
 static std::string g_last_filename;
 
@@ -73,7 +101,7 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 static std::thread g_save_thread;
 
 // Don't forget to increase this after doing changes on the savestate system
-static const u32 STATE_VERSION = 89;  // Last changed in PR 5890
+static const u32 STATE_VERSION = 91;  // Last changed for data cache emulation
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -192,6 +220,10 @@ static std::string DoState(PointerWrap& p)
   Gecko::DoState(p);
   p.DoMarker("Gecko");
 
+  // Fields that were being run ahead of the old state mustn't be rolled back to it.
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    RunAhead::Reset();
+
 #if defined(HAVE_FFMPEG)
   AVIDump::DoState();
 #endif
@@ -199,6 +231,71 @@ static std::string DoState(PointerWrap& p)
   return version_created_by;
 }
 
+// Writes a savestate into the buffer that p points to, up to the end set with SetWriteEnd.
+// The copies of emulated memory are split up and done on several threads, which shortens the
+// time the emulation is paused for.
+static void DoStateWrite(PointerWrap& p)
+{
+  static Common::WorkerPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1,
+                                 Common::TaskPriority::High);
+  static const size_t COPY_PIECE_SIZE = 1024 * 1024;
+
+  std::vector<PointerWrap::DeferredCopy> copies;
+  p.SetMode(PointerWrap::MODE_WRITE);
+  p.SetDeferredCopies(&copies);
+  DoState(p);
+  p.SetDeferredCopies(nullptr);
+  if (p.WriteOverflowed())
+    return;
+
+  std::vector<PointerWrap::DeferredCopy> pieces;
+  for (const PointerWrap::DeferredCopy& copy : copies)
+  {
+    for (size_t offset = 0; offset < copy.size; offset += COPY_PIECE_SIZE)
+    {
+      pieces.push_back({copy.dest + offset, copy.src + offset,
+                        std::min(COPY_PIECE_SIZE, copy.size - offset)});
+    }
+  }
+
+  pool.Run(pieces.size(), [&pieces](size_t i) {
+    std::copy_n(pieces[i].src, pieces[i].size, pieces[i].dest);
+  });
+}
+
+// Writes a savestate into buffer and resizes it to fit. Savestates usually keep the same size
+// from one save to the next, so the buffer is sized after the last savestate with some room to
+// grow, which saves measuring the state before writing it. Only when it doesn't fit is the
+// state written again, into a buffer of the size that was measured by the first attempt.
+static bool DoStateToBuffer(std::vector<u8>& buffer)
+{
+  static size_t s_last_state_size = 0;
+  static const size_t STATE_SIZE_SLACK = 64 * 1024;
+
+  size_t buffer_size = std::max(buffer.capacity(), s_last_state_size + STATE_SIZE_SLACK);
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+  while (true)
+  {
+    // The old contents get overwritten, so don't let a reallocation copy them over.
+    if (buffer_size > buffer.capacity())
+      buffer.clear();
+    buffer.resize(buffer_size);
+
+    ptr = buffer.data();
+    p.SetWriteEnd(ptr + buffer.size());
+    DoStateWrite(p);
+    if (!p.WriteOverflowed())
+      break;
+    buffer_size = static_cast<size_t>(ptr - buffer.data());
+  }
+  p.SetWriteEnd(nullptr);
+
+  buffer.resize(static_cast<size_t>(ptr - buffer.data()));
+  s_last_state_size = buffer.size();
+  return p.GetMode() == PointerWrap::MODE_WRITE;
+}
+
 void LoadFromBuffer(std::vector<u8>& buffer)
 {
   if (NetPlay::IsNetPlayRunning())
@@ -216,18 +313,7 @@ void LoadFromBuffer(std::vector<u8>& buffer)
 
 void SaveToBuffer(std::vector<u8>& buffer)
 {
-  Core::RunAsCPUThread([&] {
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-
-    DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-    buffer.resize(buffer_size);
-
-    ptr = &buffer[0];
-    p.SetMode(PointerWrap::MODE_WRITE);
-    DoState(p);
-  });
+  Core::RunAsCPUThread([&] { DoStateToBuffer(buffer); });
 }
 
 void VerifyBuffer(std::vector<u8>& buffer)
@@ -354,33 +440,56 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
+    ChunkedStateHeader chunked_header;
+    chunked_header.magic = CHUNKED_STATE_MAGIC;
+    chunked_header.compression =
+        SConfig::GetInstance().bSmallSavestates ? ChunkCompression::Zlib : ChunkCompression::LZO;
+    chunked_header.chunk_size = CHUNK_SIZE;
+    chunked_header.num_chunks = static_cast<u32>((buffer_size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    std::vector<std::vector<u8>> chunks(chunked_header.num_chunks);
+    std::vector<u32> chunk_sizes(chunked_header.num_chunks);
+    GetCompressionPool().Run(chunks.size(), [&](size_t i) {
+      const u8* in = buffer_data + i * CHUNK_SIZE;
+      const size_t in_len = std::min<size_t>(CHUNK_SIZE, buffer_size - i * CHUNK_SIZE);
+      std::vector<u8>& chunk = chunks[i];
+
+      bool compressed;
+      if (chunked_header.compression == ChunkCompression::Zlib)
       {
-        cur_len = (lzo_uint32)(buffer_size - i);
+        uLongf out_len = compressBound(static_cast<uLong>(in_len));
+        chunk.resize(out_len);
+        compressed = compress2(chunk.data(), &out_len, in, static_cast<uLong>(in_len),
+                               Z_DEFAULT_COMPRESSION) == Z_OK;
+        chunk.resize(out_len);
       }
       else
       {
-        cur_len = IN_LEN;
+        std::vector<lzo_align_t> work_memory((LZO1X_1_MEM_COMPRESS + sizeof(lzo_align_t) - 1) /
+                                             sizeof(lzo_align_t));
+        lzo_uint out_len = 0;
+        chunk.resize(in_len + in_len / 16 + 64 + 3);
+        compressed =
+            lzo1x_1_compress(in, static_cast<lzo_uint>(in_len), chunk.data(), &out_len,
+                             work_memory.data()) == LZO_E_OK;
+        chunk.resize(out_len);
       }
 
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
+      if (compressed && chunk.size() < in_len)
+      {
+        chunk_sizes[i] = static_cast<u32>(chunk.size());
+      }
+      else
+      {
+        chunk.assign(in, in + in_len);
+        chunk_sizes[i] = static_cast<u32>(in_len) | CHUNK_STORED_FLAG;
+      }
+    });
 
-      i += cur_len;
-    }
+    f.WriteArray(&chunked_header, 1);
+    f.WriteArray(chunk_sizes.data(), chunk_sizes.size());
+    for (const std::vector<u8>& chunk : chunks)
+      f.WriteBytes(chunk.data(), chunk.size());
   }
   else  // uncompressed
   {
@@ -394,22 +503,13 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 void SaveAs(const std::string& filename, bool wait)
 {
   Core::RunAsCPUThread([&] {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-    DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
+    bool success;
     {
       std::lock_guard<std::mutex> lk(g_cs_current_buffer);
-      g_current_buffer.resize(buffer_size);
-      ptr = &g_current_buffer[0];
-      p.SetMode(PointerWrap::MODE_WRITE);
-      DoState(p);
+      success = DoStateToBuffer(g_current_buffer);
     }
 
-    if (p.GetMode() == PointerWrap::MODE_WRITE)
+    if (success)
     {
       Core::DisplayMessage("Saving State...", 1000);
 
@@ -460,6 +560,99 @@ std::string GetInfoStringOfSlot(int slot, bool translate)
   return Common::Timer::GetDateTimeFormatted(header.time);
 }
 
+static bool DecompressChunkedState(File::IOFile& f, const ChunkedStateHeader& chunked_header,
+                                   std::vector<u8>* buffer)
+{
+  const u64 chunk_size = chunked_header.chunk_size;
+  if (chunk_size == 0 ||
+      chunked_header.num_chunks != (buffer->size() + chunk_size - 1) / chunk_size)
+  {
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(chunked_header.num_chunks);
+  if (!f.ReadArray(chunk_sizes.data(), chunk_sizes.size()))
+    return false;
+
+  std::vector<u64> offsets(chunk_sizes.size() + 1, 0);
+  for (size_t i = 0; i < chunk_sizes.size(); ++i)
+    offsets[i + 1] = offsets[i] + (chunk_sizes[i] & ~CHUNK_STORED_FLAG);
+
+  std::vector<u8> data(offsets.back());
+  if (!f.ReadBytes(data.data(), data.size()))
+    return false;
+
+  std::atomic<bool> success{true};
+  GetCompressionPool().Run(chunk_sizes.size(), [&](size_t i) {
+    const u8* in = data.data() + offsets[i];
+    const size_t in_len = static_cast<size_t>(offsets[i + 1] - offsets[i]);
+    u8* out = buffer->data() + i * chunk_size;
+    const size_t out_len = std::min<size_t>(chunk_size, buffer->size() - i * chunk_size);
+
+    size_t decompressed_len;
+    if (chunk_sizes[i] & CHUNK_STORED_FLAG)
+    {
+      decompressed_len = std::min(in_len, out_len);
+      std::copy_n(in, decompressed_len, out);
+    }
+    else if (chunked_header.compression == ChunkCompression::Zlib)
+    {
+      uLongf len = static_cast<uLongf>(out_len);
+      if (uncompress(out, &len, in, static_cast<uLong>(in_len)) != Z_OK)
+        len = 0;
+      decompressed_len = len;
+    }
+    else
+    {
+      lzo_uint len = static_cast<lzo_uint>(out_len);
+      if (lzo1x_decompress_safe(in, static_cast<lzo_uint>(in_len), out, &len, nullptr) !=
+          LZO_E_OK)
+      {
+        len = 0;
+      }
+      decompressed_len = len;
+    }
+
+    if (decompressed_len != out_len)
+      success = false;
+  });
+
+  return success;
+}
+
+// Savestates from before chunked compression.
+static bool DecompressLZOStream(File::IOFile& f, std::vector<u8>* buffer)
+{
+  std::vector<u8> in(OUT_LEN);
+  lzo_uint i = 0;
+  while (true)
+  {
+    lzo_uint32 cur_len = 0;  // number of bytes to read
+    lzo_uint new_len = 0;    // number of bytes to write
+
+    if (!f.ReadArray(&cur_len, 1))
+      break;
+
+    if (cur_len > in.size() || !f.ReadBytes(in.data(), cur_len))
+      return false;
+
+    new_len = static_cast<lzo_uint>(buffer->size() - i);
+    const int res = lzo1x_decompress_safe(in.data(), cur_len, &(*buffer)[i], &new_len, nullptr);
+    if (res != LZO_E_OK)
+    {
+      // This doesn't seem to happen anymore.
+      PanicAlertT("Internal LZO Error - decompression failed (%d) (%li, %li) \n"
+                  "Try loading the state again",
+                  res, i, new_len);
+      return false;
+    }
+
+    i += new_len;
+  }
+
+  return true;
+}
+
 static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
 {
   Flush();
@@ -488,27 +681,18 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     buffer.resize(header.size);
 
-    lzo_uint i = 0;
-    while (true)
+    ChunkedStateHeader chunked_header;
+    if (f.ReadArray(&chunked_header, 1) && chunked_header.magic == CHUNKED_STATE_MAGIC)
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
-
-      if (!f.ReadArray(&cur_len, 1))
-        break;
-
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
+      if (!DecompressChunkedState(f, chunked_header, &buffer))
       {
-        // This doesn't seem to happen anymore.
-        PanicAlertT("Internal LZO Error - decompression failed (%d) (%li, %li) \n"
-                    "Try loading the state again",
-                    res, i, new_len);
+        PanicAlertT("Failed to decompress the state.");
         return;
       }
-
-      i += new_len;
+    }
+    else if (!f.Seek(sizeof(StateHeader), SEEK_SET) || !DecompressLZOStream(f, &buffer))
+    {
+      return;
     }
   }
   else  // uncompressed
@@ -49,6 +49,8 @@ void SaveAs(const std::string& filename, bool wait = false);
 void LoadAs(const std::string& filename);
 void VerifyAt(const std::string& filename);
 
+// Reuses the memory of the buffer if it's large enough, so that saving repeatedly to the same
+// buffer doesn't have to allocate and zero a new one every time.
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 void VerifyBuffer(std::vector<u8>& buffer);
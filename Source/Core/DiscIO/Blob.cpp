@@ -19,7 +19,9 @@
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/DriveBlob.h"
 #include "DiscIO/FileBlob.h"
+#include "DiscIO/ReadAheadBlob.h"
 #include "DiscIO/TGCBlob.h"
+#include "DiscIO/WCZBlob.h"
 #include "DiscIO/WbfsBlob.h"
 
 namespace DiscIO
@@ -104,6 +106,24 @@ bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
   {
     block = offset / m_block_size;
 
+    // Reads which cover several whole chunks bypass the cache, so that the blob can read all of
+    // the blocks at once (and decompress them in parallel) straight into the output.
+    u64 whole_blocks = position_in_block == 0 ? remain / m_block_size : 0;
+    const u64 end_block = GetDataSize() / m_block_size;
+    if (end_block)
+      whole_blocks = std::min(whole_blocks, end_block - std::min(block, end_block));
+    if (whole_blocks >= std::max<u64>(m_chunk_blocks, 2) && !FindCacheLine(block))
+    {
+      if (!ReadMultipleAlignedBlocks(block, whole_blocks, out_ptr))
+        return false;
+
+      const u64 was_read = whole_blocks * m_block_size;
+      offset += was_read;
+      out_ptr += was_read;
+      remain -= was_read;
+      continue;
+    }
+
     const Cache* cache = GetCacheLine(block);
     if (!cache)
       return false;
@@ -192,16 +212,19 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
   // that assumption is wrong, the volume code that runs later will notice the error
   // because the blob won't provide the right data when reading the GC/Wii disc header.
 
+  // Reading the compressed formats is slow enough that it's worth reading ahead of the caller.
   switch (magic)
   {
   case CISO_MAGIC:
-    return CISOFileReader::Create(std::move(file));
+    return ReadAheadBlobReader::Create(CISOFileReader::Create(std::move(file)));
   case GCZ_MAGIC:
-    return CompressedBlobReader::Create(std::move(file), filename);
+    return ReadAheadBlobReader::Create(CompressedBlobReader::Create(std::move(file), filename));
   case TGC_MAGIC:
     return TGCFileReader::Create(std::move(file));
   case WBFS_MAGIC:
-    return WbfsFileReader::Create(std::move(file), filename);
+    return ReadAheadBlobReader::Create(WbfsFileReader::Create(std::move(file), filename));
+  case WCZ_MAGIC:
+    return ReadAheadBlobReader::Create(WCZFileReader::Create(std::move(file)));
   default:
     if (auto directory_blob = DirectoryBlobReader::Create(filename))
       return std::move(directory_blob);
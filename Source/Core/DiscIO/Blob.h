@@ -34,7 +34,8 @@ enum class BlobType
   GCZ,
   CISO,
   WBFS,
-  TGC
+  TGC,
+  WCZ
 };
 
 class BlobReader
@@ -62,6 +63,11 @@ public:
     return false;
   }
 
+  // Returns a pointer to the data if the blob has it in memory (for instance because the file is
+  // memory-mapped), or nullptr. The data stays valid for as long as the returned pointer is held,
+  // even if the blob is destroyed.
+  virtual std::shared_ptr<const u8> GetDirectPointer(u64 offset, u64 size) { return nullptr; }
+
 protected:
   BlobReader() {}
 };
@@ -164,5 +170,11 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
                         void* arg = nullptr);
 bool DecompressBlobToFile(const std::string& infile_path, const std::string& outfile_path,
                           CompressCB callback = nullptr, void* arg = nullptr);
+bool ConvertToWCZ(const std::string& infile_path, const std::string& outfile_path,
+                  CompressCB callback = nullptr, void* arg = nullptr);
+bool ConvertToCISO(const std::string& infile_path, const std::string& outfile_path,
+                   CompressCB callback = nullptr, void* arg = nullptr);
+bool ConvertToWBFS(const std::string& infile_path, const std::string& outfile_path,
+                   CompressCB callback = nullptr, void* arg = nullptr);
 
 }  // namespace
@@ -5,11 +5,16 @@
 #include <algorithm>
 #include <cstdio>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/CISOBlob.h"
+#include "DiscIO/ScrubbedBlockReader.h"
 
 namespace DiscIO
 {
@@ -79,4 +84,99 @@ bool CISOFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   return true;
 }
 
+bool ConvertToCISO(const std::string& infile_path, const std::string& outfile_path,
+                   CompressCB callback, void* arg)
+{
+  // Large enough for the map to cover a dual-layer Wii disc.
+  static constexpr u32 BLOCK_SIZE = 0x200000;
+
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  if (reader->GetDataSize() > static_cast<u64>(CISO_MAP_SIZE) * BLOCK_SIZE)
+  {
+    PanicAlertT("\"%s\" is too large to be converted to CISO.", infile_path.c_str());
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  if (callback)
+    callback(GetStringT("Files opened, ready to convert."), 0, arg);
+
+  // Unused blocks and blocks of zeroes are left out, since the reader fills both in with zeroes.
+  ScrubbedBlockReader blocks(infile_path, reader.get(), BLOCK_SIZE, true);
+
+  auto header = std::make_unique<CISOHeader>();
+  header->magic = CISO_MAGIC;
+  header->block_size = BLOCK_SIZE;
+  std::fill(std::begin(header->map), std::end(header->map), 0);
+
+  // seek past the header (we will write it at the end)
+  outfile.Seek(CISO_HEADER_SIZE, SEEK_SET);
+
+  const u64 num_blocks = blocks.GetNumBlocks();
+  const u64 progress_monitor = std::max<u64>(1, num_blocks / 1000);
+  u64 num_stored = 0;
+  bool success = true;
+
+  u64 index;
+  while (const u8* data = blocks.GetNextBlock(&index))
+  {
+    if (callback && num_stored % progress_monitor == 0)
+    {
+      const std::string text = StringFromFormat(
+          GetStringT("Block %i of %i. %i blocks stored.").c_str(), static_cast<int>(index),
+          static_cast<int>(num_blocks), static_cast<int>(num_stored));
+      if (!callback(text, static_cast<float>(index) / num_blocks, arg))
+      {
+        success = false;
+        break;
+      }
+    }
+
+    if (!outfile.WriteBytes(data, BLOCK_SIZE))
+    {
+      PanicAlertT("Failed to write the output file \"%s\".\n"
+                  "Check that you have enough space available on the target drive.",
+                  outfile_path.c_str());
+      success = false;
+      break;
+    }
+
+    header->map[index] = 1;
+    ++num_stored;
+  }
+
+  if (success && blocks.ReadFailed())
+  {
+    PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+    success = false;
+  }
+
+  if (!success || !outfile.Seek(0, SEEK_SET) || !outfile.WriteArray(header.get(), 1))
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  if (callback)
+    callback(GetStringT("Done converting disc image."), 1.0f, arg);
+  return true;
+}
+
 }  // namespace
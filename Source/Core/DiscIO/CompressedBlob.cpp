@@ -8,11 +8,16 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <zlib.h>
@@ -24,6 +29,8 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Common/WorkerPool.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/CompressedBlob.h"
 #include "DiscIO/DiscScrubber.h"
@@ -85,34 +92,85 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
   return 0;
 }
 
-bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+u64 CompressedBlobReader::GetBlockFileOffset(u64 block_num) const
 {
-  bool uncompressed = false;
-  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
-  u64 offset = m_block_pointers[block_num] + m_data_offset;
+  return (m_block_pointers[block_num] & ~(1ULL << 63)) + m_data_offset;
+}
 
-  if (offset & (1ULL << 63))
+bool CompressedBlobReader::ReadStoredData(u64 offset, u64 size, u8* out_ptr)
+{
+  m_file.Seek(offset, SEEK_SET);
+  if (!m_file.ReadBytes(out_ptr, size))
   {
-    if (comp_block_size != m_header.block_size)
-      PanicAlert("Uncompressed block with wrong size");
-    uncompressed = true;
-    offset &= ~(1ULL << 63);
+    PanicAlertT("The disc image \"%s\" is truncated, some of the data is missing.",
+                m_file_name.c_str());
+    m_file.Clear();
+    return false;
   }
+  return true;
+}
+
+bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  const u32 comp_block_size = static_cast<u32>(GetBlockCompressedSize(block_num));
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
   memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
 
-  m_file.Seek(offset, SEEK_SET);
-  if (!m_file.ReadBytes(m_zlib_buffer.data(), comp_block_size))
+  if (!ReadStoredData(GetBlockFileOffset(block_num), comp_block_size, m_zlib_buffer.data()))
+    return false;
+
+  return DecompressBlock(block_num, m_zlib_buffer.data(), comp_block_size, out_ptr);
+}
+
+bool CompressedBlobReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  if (num_blocks < 2 || block_num + num_blocks > m_header.num_blocks)
+    return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+
+  // The blocks are normally stored one after another, which lets all of them be read at once.
+  const u64 start = GetBlockFileOffset(block_num);
+  std::vector<u64> stored_offsets(num_blocks + 1);
+  for (u64 i = 0; i < num_blocks; ++i)
   {
-    PanicAlertT("The disc image \"%s\" is truncated, some of the data is missing.",
-                m_file_name.c_str());
-    m_file.Clear();
+    if (GetBlockFileOffset(block_num + i) != start + stored_offsets[i])
+      return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+    stored_offsets[i + 1] = stored_offsets[i] + GetBlockCompressedSize(block_num + i);
+  }
+
+  m_multi_block_buffer.resize(stored_offsets[num_blocks]);
+  if (!ReadStoredData(start, stored_offsets[num_blocks], m_multi_block_buffer.data()))
     return false;
+
+  // Inflating is what makes reading GCZ slow, so large reads inflate their blocks in parallel.
+  if (!m_decompression_pool)
+  {
+    const size_t num_workers = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    m_decompression_pool =
+        std::make_unique<Common::WorkerPool>(num_workers, Common::TaskPriority::High);
   }
 
+  std::atomic<bool> success{true};
+  m_decompression_pool->Run(num_blocks, [&](size_t i) {
+    const u32 size = static_cast<u32>(stored_offsets[i + 1] - stored_offsets[i]);
+    if (!DecompressBlock(block_num + i, m_multi_block_buffer.data() + stored_offsets[i], size,
+                         out_ptr + i * m_header.block_size))
+    {
+      success.store(false);
+    }
+  });
+  return success.load();
+}
+
+bool CompressedBlobReader::DecompressBlock(u64 block_num, const u8* data, u32 comp_block_size,
+                                           u8* out_ptr) const
+{
+  const bool uncompressed = (m_block_pointers[block_num] & (1ULL << 63)) != 0;
+  if (uncompressed && comp_block_size != m_header.block_size)
+    PanicAlert("Uncompressed block with wrong size");
+
   // First, check hash.
-  u32 block_hash = HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  u32 block_hash = HashAdler32(data, comp_block_size);
   if (block_hash != m_hashes[block_num])
     PanicAlertT("The disc image \"%s\" is corrupt.\n"
                 "Hash of block %" PRIu64 " is %08x instead of %08x.",
@@ -120,12 +178,12 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    std::copy(data, data + comp_block_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
+    z.next_in = const_cast<u8*>(data);
     z.avail_in = comp_block_size;
     if (z.avail_in > m_header.block_size)
     {
@@ -152,6 +210,39 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
   return true;
 }
 
+namespace
+{
+struct CompressionBlock
+{
+  std::vector<u8> in_buf;
+  std::vector<u8> out_buf;
+  int compressed_size = 0;
+  bool stored = false;
+  bool failed = false;
+  bool compressed = false;
+};
+}
+
+static void CompressBlock(z_stream* z, CompressionBlock* block, int block_size)
+{
+  int retval = deflateReset(z);
+  z->next_in = block->in_buf.data();
+  z->avail_in = block_size;
+  z->next_out = block->out_buf.data();
+  z->avail_out = block_size;
+
+  if (retval != Z_OK)
+  {
+    block->failed = true;
+    return;
+  }
+
+  int status = deflate(z, Z_FINISH);
+  block->compressed_size = block_size - z->avail_out;
+  block->stored = (status != Z_STREAM_END) || (z->avail_out < 10);
+  block->failed = false;
+}
+
 bool CompressFileToBlob(const std::string& infile_path, const std::string& outfile_path,
                         u32 sub_type, int block_size, CompressCB callback, void* arg)
 {
@@ -193,10 +284,6 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
     scrubbing = true;
   }
 
-  z_stream z = {};
-  if (deflateInit(&z, 9) != Z_OK)
-    return false;
-
   callback(GetStringT("Files opened, ready to compress."), 0, arg);
 
   CompressedBlobHeader header;
@@ -210,8 +297,6 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
 
   std::vector<u64> offsets(header.num_blocks);
   std::vector<u32> hashes(header.num_blocks);
-  std::vector<u8> out_buf(block_size);
-  std::vector<u8> in_buf(block_size);
 
   // seek past the header (we will write it at the end)
   outfile.Seek(sizeof(CompressedBlobHeader), SEEK_CUR);
@@ -220,18 +305,94 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
   // seek to the start of the input file to make sure we get everything
   infile.Seek(0, SEEK_SET);
 
+  // This thread reads the blocks and writes them out in order, while the workers compress them.
+  // Each block is compressed on its own, so the output doesn't depend on the number of workers.
+  const u32 num_workers = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<CompressionBlock> blocks(num_workers * 2);
+  for (CompressionBlock& block : blocks)
+  {
+    block.in_buf.resize(block_size);
+    block.out_buf.resize(block_size);
+  }
+
+  std::mutex mutex;
+  std::condition_variable work_available;
+  std::condition_variable work_done;
+  std::deque<CompressionBlock*> queue;
+  bool stop_workers = false;
+
+  std::vector<std::thread> workers;
+  for (u32 i = 0; i < num_workers; i++)
+  {
+    workers.emplace_back([&] {
+      Common::SetCurrentThreadName("GCZ Compressor");
+
+      z_stream z = {};
+      const bool initialized = deflateInit(&z, 9) == Z_OK;
+
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true)
+      {
+        work_available.wait(lock, [&] { return stop_workers || !queue.empty(); });
+        if (stop_workers)
+          break;
+
+        CompressionBlock* block = queue.front();
+        queue.pop_front();
+        lock.unlock();
+
+        if (initialized)
+          CompressBlock(&z, block, block_size);
+        else
+          block->failed = true;
+
+        lock.lock();
+        block->compressed = true;
+        work_done.notify_one();
+      }
+
+      if (initialized)
+        deflateEnd(&z);
+    });
+  }
+
   // Now we are ready to write compressed data!
   u64 position = 0;
-  int num_compressed = 0;
-  int num_stored = 0;
   int progress_monitor = std::max<int>(1, header.num_blocks / 1000);
   bool success = true;
+  u32 num_read = 0;
 
+  std::unique_lock<std::mutex> lock(mutex);
   for (u32 i = 0; i < header.num_blocks; i++)
   {
+    // Keep all blocks busy by reading ahead of the block which is written next.
+    while (num_read < header.num_blocks && num_read - i < blocks.size())
+    {
+      CompressionBlock& block = blocks[num_read % blocks.size()];
+      lock.unlock();
+
+      size_t read_bytes;
+      if (scrubbing)
+        read_bytes = disc_scrubber.GetNextBlock(infile, block.in_buf.data());
+      else
+        infile.ReadArray(block.in_buf.data(), header.block_size, &read_bytes);
+      if (read_bytes < header.block_size)
+        std::fill(block.in_buf.begin() + read_bytes, block.in_buf.begin() + header.block_size, 0);
+
+      lock.lock();
+      block.compressed = false;
+      queue.push_back(&block);
+      work_available.notify_one();
+      num_read++;
+    }
+
+    CompressionBlock& block = blocks[i % blocks.size()];
+    work_done.wait(lock, [&] { return block.compressed; });
+    lock.unlock();
+
     if (i % progress_monitor == 0)
     {
-      const u64 inpos = infile.Tell();
+      const u64 inpos = static_cast<u64>(i) * block_size;
       int ratio = 0;
       if (inpos != 0)
         ratio = (int)(100 * position / inpos);
@@ -247,50 +408,29 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
       }
     }
 
-    offsets[i] = position;
-
-    size_t read_bytes;
-    if (scrubbing)
-      read_bytes = disc_scrubber.GetNextBlock(infile, in_buf.data());
-    else
-      infile.ReadArray(in_buf.data(), header.block_size, &read_bytes);
-    if (read_bytes < header.block_size)
-      std::fill(in_buf.begin() + read_bytes, in_buf.begin() + header.block_size, 0);
-
-    int retval = deflateReset(&z);
-    z.next_in = in_buf.data();
-    z.avail_in = header.block_size;
-    z.next_out = out_buf.data();
-    z.avail_out = block_size;
-
-    if (retval != Z_OK)
+    if (block.failed)
     {
       ERROR_LOG(DISCIO, "Deflate failed");
       success = false;
       break;
     }
 
-    int status = deflate(&z, Z_FINISH);
-    int comp_size = block_size - z.avail_out;
+    offsets[i] = position;
 
-    u8* write_buf;
+    const u8* write_buf;
     int write_size;
-    if ((status != Z_STREAM_END) || (z.avail_out < 10))
+    if (block.stored)
     {
-      // PanicAlert("%i %i Store %i", i*block_size, position, comp_size);
       // let's store uncompressed
-      write_buf = in_buf.data();
+      write_buf = block.in_buf.data();
       offsets[i] |= 0x8000000000000000ULL;
       write_size = block_size;
-      num_stored++;
     }
     else
     {
       // let's store compressed
-      // PanicAlert("Comp %i to %i", block_size, comp_size);
-      write_buf = out_buf.data();
-      write_size = comp_size;
-      num_compressed++;
+      write_buf = block.out_buf.data();
+      write_size = block.compressed_size;
     }
 
     if (!outfile.WriteBytes(write_buf, write_size))
@@ -305,8 +445,18 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
     position += write_size;
 
     hashes[i] = HashAdler32(write_buf, write_size);
+    lock.lock();
   }
 
+  // Blocks which were read ahead are still in the queue after an error, and are dropped.
+  if (!lock.owns_lock())
+    lock.lock();
+  stop_workers = true;
+  work_available.notify_all();
+  lock.unlock();
+  for (std::thread& worker : workers)
+    worker.join();
+
   header.compressed_data_size = position;
 
   if (!success)
@@ -324,9 +474,6 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
     outfile.WriteArray(hashes.data(), header.num_blocks);
   }
 
-  // Cleanup
-  deflateEnd(&z);
-
   if (success)
   {
     callback(GetStringT("Done compressing disc image."), 1.0f, arg);
@@ -21,6 +21,11 @@
 #include "Common/File.h"
 #include "DiscIO/Blob.h"
 
+namespace Common
+{
+class WorkerPool;
+}
+
 namespace DiscIO
 {
 static constexpr u32 GCZ_MAGIC = 0xB10BC001;
@@ -54,9 +59,17 @@ public:
   u64 GetBlockCompressedSize(u64 block_num) const;
   bool GetBlock(u64 block_num, u8* out_ptr) override;
 
+protected:
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
+
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  u64 GetBlockFileOffset(u64 block_num) const;
+  bool ReadStoredData(u64 offset, u64 size, u8* out_ptr);
+  // Thread-safe.
+  bool DecompressBlock(u64 block_num, const u8* data, u32 comp_block_size, u8* out_ptr) const;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -64,6 +77,8 @@ private:
   File::IOFile m_file;
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
+  std::vector<u8> m_multi_block_buffer;
+  std::unique_ptr<Common::WorkerPool> m_decompression_pool;
   std::string m_file_name;
 };
 
@@ -6,10 +6,20 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
+#include <deque>
 #include <locale>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Filesystem.h"
@@ -61,25 +71,129 @@ u64 ReadFile(const Volume& volume, const Partition& partition, const FileInfo* f
   return read_length;
 }
 
-bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u64 size,
-                const std::string& export_filename)
+namespace
+{
+// Data is read and written in chunks of this size, so that writing one chunk overlaps with reading
+// and decrypting the next one.
+constexpr u64 EXPORT_CHUNK_SIZE = 4 * 1024 * 1024;
+// Limits the memory taken by chunks which have been read but not written yet.
+constexpr size_t MAX_QUEUED_CHUNKS = 4;
+
+// Writes exported files on a thread of its own. Volumes can only be read from one thread at a
+// time, but that thread doesn't have to wait for the writes.
+class AsyncWriter
+{
+public:
+  AsyncWriter() : m_thread([this] { WriterThread(); }) {}
+
+  // Finishes the queued writes.
+  ~AsyncWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_exit = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+  }
+
+  // Returns a buffer of a written chunk, so that the chunks don't have to be allocated every time.
+  std::vector<u8> GetBuffer()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_free_buffers.empty())
+      return {};
+
+    std::vector<u8> buffer = std::move(m_free_buffers.back());
+    m_free_buffers.pop_back();
+    return buffer;
+  }
+
+  // Appends the data to the file, waiting while too many chunks are queued. The writer keeps the
+  // file open until its last queued chunk has been written.
+  void Write(std::shared_ptr<File::IOFile> file, const std::string& path, std::vector<u8> data)
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_cv.wait(lk, [this] { return m_chunks.size() < MAX_QUEUED_CHUNKS; });
+    m_chunks.push_back({std::move(file), path, std::move(data)});
+    m_cv.notify_all();
+  }
+
+  // Waits for the queued chunks to be written. Returns false if any write since the last call
+  // failed.
+  bool Flush()
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_cv.wait(lk, [this] { return m_chunks.empty() && !m_writing; });
+    return !std::exchange(m_failed, false);
+  }
+
+private:
+  struct Chunk
+  {
+    std::shared_ptr<File::IOFile> file;
+    std::string path;
+    std::vector<u8> data;
+  };
+
+  void WriterThread()
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+      m_cv.wait(lk, [this] { return !m_chunks.empty() || m_exit; });
+      if (m_chunks.empty())
+        return;
+
+      Chunk chunk = std::move(m_chunks.front());
+      m_chunks.pop_front();
+      m_writing = true;
+      lk.unlock();
+      m_cv.notify_all();
+
+      const bool success = chunk.file->WriteBytes(chunk.data.data(), chunk.data.size());
+      if (!success)
+        ERROR_LOG(DISCIO, "Could not write %s", chunk.path.c_str());
+      chunk.file.reset();
+
+      lk.lock();
+      m_failed |= !success;
+      m_writing = false;
+      if (m_free_buffers.size() < MAX_QUEUED_CHUNKS)
+        m_free_buffers.push_back(std::move(chunk.data));
+      m_cv.notify_all();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Chunk> m_chunks;
+  std::vector<std::vector<u8>> m_free_buffers;
+  bool m_writing = false;
+  bool m_failed = false;
+  bool m_exit = false;
+  std::thread m_thread;
+};
+
+// Reads the data into chunks and queues them on the writer. Only failures to read or to create
+// the file are returned, failed writes are reported by the writer.
+bool QueueExport(const Volume& volume, const Partition& partition, u64 offset, u64 size,
+                 const std::string& export_filename, AsyncWriter* writer)
 {
-  File::IOFile f(export_filename, "wb");
-  if (!f)
+  auto file = std::make_shared<File::IOFile>(export_filename, "wb");
+  if (!*file)
     return false;
 
   while (size)
   {
-    // Limit read size to 128 MB
-    const size_t read_size = static_cast<size_t>(std::min<u64>(size, 0x08000000));
-
-    std::vector<u8> buffer(read_size);
+    const size_t read_size = static_cast<size_t>(std::min(size, EXPORT_CHUNK_SIZE));
+    std::vector<u8> buffer = writer->GetBuffer();
+    buffer.resize(read_size);
 
     if (!volume.Read(offset, read_size, buffer.data(), partition))
       return false;
 
-    if (!f.WriteBytes(buffer.data(), read_size))
-      return false;
+    writer->Write(file, export_filename, std::move(buffer));
 
     size -= read_size;
     offset += read_size;
@@ -88,6 +202,74 @@ bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u6
   return true;
 }
 
+struct FileToExport
+{
+  u64 offset;
+  u64 size;
+  std::string path;
+  std::string export_path;
+};
+
+// Creates the directories and lists the files which have to be exported. Returns false if the
+// extraction was cancelled.
+bool ListFilesToExport(const FileInfo& directory, bool recursive,
+                       const std::string& filesystem_path, const std::string& export_folder,
+                       const std::function<bool(const std::string& path)>& update_progress,
+                       std::vector<FileToExport>* files)
+{
+  File::CreateFullPath(export_folder + '/');
+
+  for (const FileInfo& file_info : directory)
+  {
+    const std::string name = file_info.GetName() + (file_info.IsDirectory() ? "/" : "");
+    const std::string path = filesystem_path + name;
+    const std::string export_path = export_folder + '/' + name;
+
+    if (!file_info.IsDirectory())
+    {
+      // The progress of files is updated when they are exported.
+      if (!File::Exists(export_path))
+      {
+        files->push_back({file_info.GetOffset(), file_info.GetSize(), path, export_path});
+        continue;
+      }
+
+      NOTICE_LOG(DISCIO, "%s already exists", export_path.c_str());
+    }
+
+    if (update_progress(path))
+      return false;
+
+    if (file_info.IsDirectory() && recursive &&
+        !ListFilesToExport(file_info, recursive, path, export_path, update_progress, files))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // Anonymous namespace
+
+bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u64 size,
+                const std::string& export_filename)
+{
+  if (size <= EXPORT_CHUNK_SIZE)
+  {
+    File::IOFile f(export_filename, "wb");
+    if (!f)
+      return false;
+
+    std::vector<u8> buffer(static_cast<size_t>(size));
+    return volume.Read(offset, size, buffer.data(), partition) &&
+           f.WriteBytes(buffer.data(), buffer.size());
+  }
+
+  AsyncWriter writer;
+  const bool read_success = QueueExport(volume, partition, offset, size, export_filename, &writer);
+  return writer.Flush() && read_success;
+}
+
 bool ExportFile(const Volume& volume, const Partition& partition, const FileInfo* file_info,
                 const std::string& export_filename)
 {
@@ -103,30 +285,28 @@ void ExportDirectory(const Volume& volume, const Partition partition, const File
                      const std::string& export_folder,
                      const std::function<bool(const std::string& path)>& update_progress)
 {
-  File::CreateFullPath(export_folder + '/');
-
-  for (const FileInfo& file_info : directory)
+  std::vector<FileToExport> files;
+  if (!ListFilesToExport(directory, recursive, filesystem_path, export_folder, update_progress,
+                         &files))
   {
-    const std::string name = file_info.GetName() + (file_info.IsDirectory() ? "/" : "");
-    const std::string path = filesystem_path + name;
-    const std::string export_path = export_folder + '/' + name;
+    return;
+  }
 
-    if (update_progress(path))
+  // Exporting the files in the order they are stored in keeps the reads from the disc sequential.
+  std::stable_sort(files.begin(), files.end(), [](const FileToExport& a, const FileToExport& b) {
+    return a.offset < b.offset;
+  });
+
+  AsyncWriter writer;
+  for (const FileToExport& file : files)
+  {
+    if (update_progress(file.path))
       return;
 
-    DEBUG_LOG(DISCIO, "%s", export_path.c_str());
+    DEBUG_LOG(DISCIO, "%s", file.export_path.c_str());
 
-    if (!file_info.IsDirectory())
-    {
-      if (File::Exists(export_path))
-        NOTICE_LOG(DISCIO, "%s already exists", export_path.c_str());
-      else if (!ExportFile(volume, partition, &file_info, export_path))
-        ERROR_LOG(DISCIO, "Could not export %s", export_path.c_str());
-    }
-    else if (recursive)
-    {
-      ExportDirectory(volume, partition, file_info, recursive, path, export_path, update_progress);
-    }
+    if (!QueueExport(volume, partition, file.offset, file.size, file.export_path, &writer))
+      ERROR_LOG(DISCIO, "Could not export %s", file.export_path.c_str());
   }
 }
 
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <optional>
+#include <string>
 
 #include "Common/CommonTypes.h"
 
@@ -27,6 +28,8 @@ bool ExportFile(const Volume& volume, const Partition& partition, const FileInfo
 // update_progress is called once for each child (file or directory).
 // If update_progress returns true, the extraction gets cancelled.
 // filesystem_path is supposed to be the path corresponding to the directory argument.
+// The files are exported in the order they are stored on the disc, while the previously read data
+// is written to the disk on another thread.
 void ExportDirectory(const Volume& volume, const Partition partition, const FileInfo& directory,
                      bool recursive, const std::string& filesystem_path,
                      const std::string& export_folder,
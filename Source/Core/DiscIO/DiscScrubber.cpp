@@ -18,6 +18,7 @@
 #include "Common/Logging/Log.h"
 
 #include "DiscIO/DiscExtractor.h"
+#include "DiscIO/Enums.h"
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/Volume.h"
 
@@ -44,6 +45,13 @@ bool DiscScrubber::SetupScrub(const std::string& filename, int block_size)
   if (!m_disc)
     return false;
 
+  // Only the partitions of Wii discs are parsed, so everything else would be scrubbed away.
+  if (m_disc->GetVolumeType() != Platform::WII_DISC)
+  {
+    m_disc.reset();
+    return false;
+  }
+
   m_file_size = m_disc->GetSize();
 
   const size_t num_clusters = static_cast<size_t>(m_file_size / CLUSTER_SIZE);
@@ -92,6 +100,21 @@ size_t DiscScrubber::GetNextBlock(File::IOFile& in, u8* buffer)
   return read_bytes;
 }
 
+bool DiscScrubber::CanBlockBeScrubbed(u64 offset, u64 size) const
+{
+  if (!m_is_scrubbing)
+    return false;
+
+  const u64 end = std::min(offset + size, m_file_size);
+  for (u64 cluster = offset / CLUSTER_SIZE;
+       cluster * CLUSTER_SIZE < end && cluster < m_free_table.size(); ++cluster)
+  {
+    if (!m_free_table[cluster])
+      return false;
+  }
+  return true;
+}
+
 void DiscScrubber::MarkAsUsed(u64 offset, u64 size)
 {
   u64 current_offset = offset;
@@ -38,6 +38,9 @@ public:
   bool SetupScrub(const std::string& filename, int block_size);
   size_t GetNextBlock(File::IOFile& in, u8* buffer);
 
+  // Returns true if none of the data in the range is used. Only valid after SetupScrub succeeded.
+  bool CanBlockBeScrubbed(u64 offset, u64 size) const;
+
 private:
   struct PartitionHeader final
   {
@@ -0,0 +1,236 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/DiscVerifier.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mbedtls/md5.h>
+#include <mbedtls/sha1.h>
+#include <pugixml.hpp>
+#include <zlib.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Common/WorkerPool.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+static constexpr u64 CHUNK_SIZE = 0x400000;
+// Chunks which have been read but not hashed yet, per read thread.
+static constexpr size_t CHUNKS_PER_THREAD = 2;
+static constexpr size_t NO_CHUNK = SIZE_MAX;
+
+std::optional<DiscHashes> ComputeDiscHashes(const std::string& path,
+                                            const std::function<bool(int)>& report_progress)
+{
+  const size_t num_readers = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 4);
+  std::vector<std::unique_ptr<BlobReader>> readers;
+  for (size_t i = 0; i < num_readers; ++i)
+  {
+    std::unique_ptr<BlobReader> reader = CreateBlobReader(path);
+    if (!reader)
+      return {};
+    readers.push_back(std::move(reader));
+  }
+
+  const u64 size = readers[0]->GetDataSize();
+  const size_t num_chunks = static_cast<size_t>((size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+  const size_t num_slots = num_readers * CHUNKS_PER_THREAD;
+
+  struct Slot
+  {
+    std::vector<u8> data;
+    size_t chunk = NO_CHUNK;
+  };
+  std::vector<Slot> slots(num_slots);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t next_chunk_to_hash = 0;
+  bool stop = false;
+  bool read_failed = false;
+
+  // Reader i reads every num_readers-th chunk, starting with chunk i, into slot
+  // chunk % num_slots once the hashing has moved past the chunk that was there before.
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_readers; ++i)
+  {
+    threads.emplace_back([&, i] {
+      Common::SetCurrentThreadName("Disc Hash Reader");
+      for (size_t chunk = i; chunk < num_chunks; chunk += num_readers)
+      {
+        Slot& slot = slots[chunk % num_slots];
+        {
+          std::unique_lock<std::mutex> lk(mutex);
+          cv.wait(lk, [&] { return stop || chunk < next_chunk_to_hash + num_slots; });
+          if (stop)
+            return;
+        }
+
+        const u64 offset = chunk * CHUNK_SIZE;
+        const u64 chunk_size = std::min(CHUNK_SIZE, size - offset);
+        slot.data.resize(chunk_size);
+        const bool success = readers[i]->Read(offset, chunk_size, slot.data.data());
+
+        {
+          std::lock_guard<std::mutex> lk(mutex);
+          if (success)
+            slot.chunk = chunk;
+          else
+            read_failed = true;
+        }
+        cv.notify_all();
+        if (!success)
+          return;
+      }
+    });
+  }
+
+  mbedtls_md5_context md5_context;
+  mbedtls_md5_init(&md5_context);
+  mbedtls_md5_starts(&md5_context);
+  mbedtls_sha1_context sha1_context;
+  mbedtls_sha1_init(&sha1_context);
+  mbedtls_sha1_starts(&sha1_context);
+  uLong crc = crc32(0, nullptr, 0);
+
+  // MD5 and SHA-1 are the slowest hashes and have to be computed in order, so they get a thread
+  // each. CRC32 is fast enough to share the calling thread with whichever finishes first.
+  Common::WorkerPool hash_pool(1, Common::TaskPriority::Low);
+
+  bool success = true;
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    Slot& slot = slots[chunk % num_slots];
+    {
+      std::unique_lock<std::mutex> lk(mutex);
+      cv.wait(lk, [&] { return read_failed || slot.chunk == chunk; });
+      if (slot.chunk != chunk)
+      {
+        success = false;
+        break;
+      }
+    }
+
+    const u8* data = slot.data.data();
+    const size_t data_size = slot.data.size();
+    hash_pool.Run(3, [&](size_t hash) {
+      if (hash == 0)
+        mbedtls_md5_update(&md5_context, data, data_size);
+      else if (hash == 1)
+        mbedtls_sha1_update(&sha1_context, data, data_size);
+      else
+        crc = crc32(crc, data, static_cast<uInt>(data_size));
+    });
+
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      slot.chunk = NO_CHUNK;
+      next_chunk_to_hash = chunk + 1;
+    }
+    cv.notify_all();
+
+    if (!report_progress(static_cast<int>((chunk + 1) * 100 / num_chunks)))
+    {
+      success = false;
+      break;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  DiscHashes hashes;
+  hashes.size = size;
+  hashes.crc32 = static_cast<u32>(crc);
+  mbedtls_md5_finish(&md5_context, hashes.md5.data());
+  mbedtls_md5_free(&md5_context);
+  mbedtls_sha1_finish(&sha1_context, hashes.sha1.data());
+  mbedtls_sha1_free(&sha1_context);
+
+  if (!success)
+    return {};
+  return hashes;
+}
+
+std::string HashToString(const u8* hash, size_t size)
+{
+  std::string str;
+  for (size_t i = 0; i < size; ++i)
+    str += StringFromFormat("%02x", hash[i]);
+  return str;
+}
+
+template <size_t N>
+static bool ParseHash(const char* str, std::array<u8, N>* hash)
+{
+  if (std::strlen(str) != N * 2)
+    return false;
+
+  for (size_t i = 0; i < N; ++i)
+  {
+    const char byte[3] = {str[i * 2], str[i * 2 + 1], '\0'};
+    char* end;
+    (*hash)[i] = static_cast<u8>(std::strtoul(byte, &end, 16));
+    if (end != byte + 2)
+      return false;
+  }
+  return true;
+}
+
+bool DiscDatabase::Load(const std::string& path)
+{
+  pugi::xml_document doc;
+  if (!doc.load_file(path.c_str()))
+    return false;
+
+  for (const pugi::xml_node& game : doc.child("datafile").children("game"))
+  {
+    for (const pugi::xml_node& rom : game.children("rom"))
+    {
+      Entry entry;
+      entry.name = game.attribute("name").as_string();
+      entry.hashes.size = rom.attribute("size").as_ullong();
+      std::array<u8, 4> crc;
+      if (!ParseHash(rom.attribute("crc").as_string(), &crc) ||
+          !ParseHash(rom.attribute("md5").as_string(), &entry.hashes.md5) ||
+          !ParseHash(rom.attribute("sha1").as_string(), &entry.hashes.sha1))
+      {
+        continue;
+      }
+      entry.hashes.crc32 = crc[0] << 24 | crc[1] << 16 | crc[2] << 8 | crc[3];
+      m_entries.push_back(std::move(entry));
+    }
+  }
+
+  return true;
+}
+
+std::string DiscDatabase::Find(const DiscHashes& hashes) const
+{
+  const auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& entry) {
+    return entry.hashes.size == hashes.size && entry.hashes.crc32 == hashes.crc32 &&
+           entry.hashes.md5 == hashes.md5 && entry.hashes.sha1 == hashes.sha1;
+  });
+  return it != m_entries.end() ? it->name : std::string();
+}
+
+}  // namespace
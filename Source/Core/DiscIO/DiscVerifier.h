@@ -0,0 +1,55 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+struct DiscHashes
+{
+  u64 size;
+  u32 crc32;
+  std::array<u8, 16> md5;
+  std::array<u8, 20> sha1;
+};
+
+// Reads a disc image once and computes all of its hashes at the same time. The image is read
+// by several threads, each with a blob reader of its own so that decompression isn't limited
+// to one core, while the hashes are updated in parallel on the calling thread and a worker.
+// report_progress gets a percentage and can return false to cancel. Returns nullopt if the
+// image couldn't be read or if the computation was cancelled.
+std::optional<DiscHashes> ComputeDiscHashes(const std::string& path,
+                                            const std::function<bool(int)>& report_progress);
+
+std::string HashToString(const u8* hash, size_t size);
+
+// Known good dumps, loaded from DAT files in the Logiqx XML format that Redump uses.
+class DiscDatabase
+{
+public:
+  // Adds the dumps listed in a DAT file. Can be called once per system.
+  bool Load(const std::string& path);
+
+  // Returns the name of the dump which matches, or an empty string if there is none.
+  std::string Find(const DiscHashes& hashes) const;
+
+private:
+  struct Entry
+  {
+    std::string name;
+    DiscHashes hashes;
+  };
+
+  std::vector<Entry> m_entries;
+};
+
+}  // namespace
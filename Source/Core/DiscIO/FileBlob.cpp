@@ -2,17 +2,60 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <cstdio>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Logging/Log.h"
 #include "DiscIO/FileBlob.h"
 
 namespace DiscIO
 {
+// Maps the whole file into memory, read-only. The mapping stays valid after the file is closed.
+static std::shared_ptr<const u8> MapFile(File::IOFile& file, u64 size)
+{
+  if (size == 0 || size > std::numeric_limits<size_t>::max())
+    return nullptr;
+
+#ifdef _WIN32
+  const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle())));
+  const HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+    return nullptr;
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view)
+    return nullptr;
+  return std::shared_ptr<const u8>(static_cast<const u8*>(view),
+                                   [](const u8* ptr) { UnmapViewOfFile(ptr); });
+#else
+  void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fileno(file.GetHandle()), 0);
+  if (view == MAP_FAILED)
+    return nullptr;
+  return std::shared_ptr<const u8>(static_cast<const u8*>(view), [size](const u8* ptr) {
+    munmap(const_cast<u8*>(ptr), static_cast<size_t>(size));
+  });
+#endif
+}
+
 PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+  m_mapping = MapFile(m_file, m_size);
+  if (!m_mapping)
+    WARN_LOG(DISCIO, "Failed to map the disc image into memory, falling back to file reads");
 }
 
 std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
@@ -25,6 +68,15 @@ std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapping)
+  {
+    if (offset > static_cast<u64>(m_size) || nbytes > m_size - offset)
+      return false;
+
+    std::memcpy(out_ptr, m_mapping.get() + offset, static_cast<size_t>(nbytes));
+    return true;
+  }
+
   if (m_file.Seek(offset, SEEK_SET) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -36,4 +88,13 @@ bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   }
 }
 
+std::shared_ptr<const u8> PlainFileReader::GetDirectPointer(u64 offset, u64 size)
+{
+  if (!m_mapping || offset > static_cast<u64>(m_size) || size > m_size - offset)
+    return nullptr;
+
+  // Shares ownership of the mapping, so it outlives this reader if it has to.
+  return std::shared_ptr<const u8>(m_mapping, m_mapping.get() + offset);
+}
+
 }  // namespace
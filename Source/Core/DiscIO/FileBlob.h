@@ -23,12 +23,15 @@ public:
   u64 GetDataSize() const override { return m_size; }
   u64 GetRawSize() const override { return m_size; }
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  std::shared_ptr<const u8> GetDirectPointer(u64 offset, u64 size) override;
 
 private:
   PlainFileReader(File::IOFile file);
 
   File::IOFile m_file;
   s64 m_size;
+  // The whole file, if it could be mapped into memory. Reads then don't need any system calls.
+  std::shared_ptr<const u8> m_mapping;
 };
 
 }  // namespace
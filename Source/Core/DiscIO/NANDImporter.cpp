@@ -8,6 +8,8 @@
 #include <array>
 #include <cinttypes>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "Common/Crypto/AES.h"
 #include "Common/File.h"
@@ -16,6 +18,8 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
+#include "Common/WorkerPool.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/NANDContentLoader.h"
 
@@ -24,6 +28,30 @@ namespace DiscIO
 constexpr size_t NAND_SIZE = 0x20000000;
 constexpr size_t NAND_KEYS_SIZE = 0x400;
 
+// Every page of the dump is followed by its ECC bytes.
+constexpr size_t NAND_TOTAL_PAGES = 0x40000;
+constexpr size_t NAND_PAGE_SIZE = 0x800;
+constexpr size_t NAND_ECC_SIZE = 0x40;
+constexpr size_t NAND_BIN_SIZE =
+    (NAND_PAGE_SIZE + NAND_ECC_SIZE) * NAND_TOTAL_PAGES + NAND_KEYS_SIZE;  // 0x21000400
+
+constexpr size_t NAND_SUPERBLOCK_START = 0x1fc00000;
+constexpr size_t NAND_SUPERBLOCK_SIZE = 0x40000;
+constexpr size_t NAND_FAT_OFFSET = 0xC;
+constexpr size_t NAND_FST_OFFSET = NAND_FAT_OFFSET + 0x10000;
+
+constexpr size_t NAND_CLUSTER_SIZE = 0x4000;
+constexpr size_t NAND_TOTAL_CLUSTERS = NAND_SIZE / NAND_CLUSTER_SIZE;
+// Files are decrypted in batches of this many clusters, which is all that is kept in memory.
+constexpr size_t CLUSTERS_PER_BATCH = 64;
+constexpr size_t CLUSTERS_PER_DECRYPTION_JOB = 4;
+
+static Common::WorkerPool& GetDecryptionPool()
+{
+  static Common::WorkerPool pool(Common::ThreadPool::GetNumThreads());
+  return pool;
+}
+
 NANDImporter::NANDImporter() = default;
 NANDImporter::~NANDImporter() = default;
 
@@ -40,10 +68,14 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
   if (nand_root.back() == '/')
     m_nand_root_length++;
 
-  FindSuperblock();
-  ProcessEntry(0, nand_root);
-  ExportKeys(nand_root);
-  ExtractCertificates(nand_root);
+  if (FindSuperblock())
+  {
+    ProcessEntry(0, nand_root);
+    ExportKeys(nand_root);
+    ExtractCertificates(nand_root);
+  }
+  m_nand_bin.Close();
+  m_superblock.clear();
 
   // We have to clear the cache so the new NAND takes effect
   DiscIO::NANDContentManager::Access().ClearCache();
@@ -51,51 +83,48 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
 
 bool NANDImporter::ReadNANDBin(const std::string& path_to_bin)
 {
-  constexpr size_t NAND_TOTAL_BLOCKS = 0x40000;
-  constexpr size_t NAND_BLOCK_SIZE = 0x800;
-  constexpr size_t NAND_ECC_BLOCK_SIZE = 0x40;
-  constexpr size_t NAND_BIN_SIZE =
-      (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * NAND_TOTAL_BLOCKS + NAND_KEYS_SIZE;  // 0x21000400
-
-  File::IOFile file(path_to_bin, "rb");
-  if (file.GetSize() != NAND_BIN_SIZE)
+  m_update_callback();
+
+  if (!m_nand_bin.Open(path_to_bin) || m_nand_bin.GetSize() != NAND_BIN_SIZE)
   {
-    PanicAlertT("This file does not look like a BootMii NAND backup. (0x%" PRIx64
-                " does not equal 0x%zx)",
-                file.GetSize(), NAND_BIN_SIZE);
+    PanicAlertT("This file does not look like a BootMii NAND backup. (0x%zx does not equal 0x%zx)",
+                m_nand_bin.GetSize(), NAND_BIN_SIZE);
+    m_nand_bin.Close();
     return false;
   }
 
-  m_nand.resize(NAND_SIZE);
+  const u8* keys = m_nand_bin.GetData() + NAND_BIN_SIZE - NAND_KEYS_SIZE;
+  m_nand_keys.assign(keys, keys + NAND_KEYS_SIZE);
+  return true;
+}
 
-  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i++)
+void NANDImporter::ReadNAND(size_t offset, u8* out, size_t size) const
+{
+  while (size > 0)
   {
-    // Instead of updating on every cycle, we only update every 1000 cycles for a balance between
-    // not updating fast enough vs updating too fast
-    if (i % 1000 == 0)
-      m_update_callback();
-
-    file.ReadBytes(&m_nand[i * NAND_BLOCK_SIZE], NAND_BLOCK_SIZE);
-    file.Seek(NAND_ECC_BLOCK_SIZE, SEEK_CUR);  // We don't care about the ECC blocks
+    const size_t page = offset / NAND_PAGE_SIZE;
+    const size_t offset_in_page = offset % NAND_PAGE_SIZE;
+    const size_t copy_size = std::min(size, NAND_PAGE_SIZE - offset_in_page);
+    std::memcpy(out,
+                m_nand_bin.GetData() + page * (NAND_PAGE_SIZE + NAND_ECC_SIZE) + offset_in_page,
+                copy_size);
+    offset += copy_size;
+    out += copy_size;
+    size -= copy_size;
   }
-
-  m_nand_keys.resize(NAND_KEYS_SIZE);
-  file.ReadBytes(m_nand_keys.data(), NAND_KEYS_SIZE);
-  return true;
 }
 
-void NANDImporter::FindSuperblock()
+bool NANDImporter::FindSuperblock()
 {
-  constexpr size_t NAND_SUPERBLOCK_START = 0x1fc00000;
-  constexpr size_t NAND_SUPERBLOCK_SIZE = 0x40000;
-
   size_t superblock = 0;
   u32 newest_version = 0;
   for (size_t pos = NAND_SUPERBLOCK_START; pos < NAND_SIZE; pos += NAND_SUPERBLOCK_SIZE)
   {
-    if (!memcmp(m_nand.data() + pos, "SFFS", 4))
+    std::array<u8, 8> header;
+    ReadNAND(pos, header.data(), header.size());
+    if (!memcmp(header.data(), "SFFS", 4))
     {
-      u32 version = Common::swap32(&m_nand[pos + 4]);
+      u32 version = Common::swap32(&header[4]);
       INFO_LOG(DISCIO, "Found superblock at 0x%zx with version 0x%x", pos, version);
       if (superblock == 0 || version > newest_version)
       {
@@ -105,10 +134,16 @@ void NANDImporter::FindSuperblock()
     }
   }
 
-  m_nand_fat_offset = superblock + 0xC;
-  m_nand_fst_offset = m_nand_fat_offset + 0x10000;
-  INFO_LOG(DISCIO, "Using superblock version 0x%x at position 0x%zx. FAT/FST offset: 0x%zx/0x%zx",
-           newest_version, superblock, m_nand_fat_offset, m_nand_fst_offset);
+  if (superblock == 0)
+  {
+    ERROR_LOG(DISCIO, "Could not find a superblock");
+    return false;
+  }
+
+  m_superblock.resize(NAND_SUPERBLOCK_SIZE);
+  ReadNAND(superblock, m_superblock.data(), m_superblock.size());
+  INFO_LOG(DISCIO, "Using superblock version 0x%x at position 0x%zx", newest_version, superblock);
+  return true;
 }
 
 std::string NANDImporter::GetPath(const NANDFSTEntry& entry, const std::string& parent_path)
@@ -133,9 +168,15 @@ std::string NANDImporter::FormatDebugString(const NANDFSTEntry& entry)
 
 void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path)
 {
+  const size_t entry_offset = NAND_FST_OFFSET + sizeof(NANDFSTEntry) * Common::swap16(entry_number);
+  if (entry_offset + sizeof(NANDFSTEntry) > m_superblock.size())
+  {
+    ERROR_LOG(DISCIO, "Invalid FST entry: 0x%04x", Common::swap16(entry_number));
+    return;
+  }
+
   NANDFSTEntry entry;
-  memcpy(&entry, &m_nand[m_nand_fst_offset + sizeof(NANDFSTEntry) * Common::swap16(entry_number)],
-         sizeof(NANDFSTEntry));
+  memcpy(&entry, &m_superblock[entry_offset], sizeof(NANDFSTEntry));
 
   if (entry.sib != 0xffff)
     ProcessEntry(entry.sib, parent_path);
@@ -165,28 +206,54 @@ void NANDImporter::ProcessDirectory(const NANDFSTEntry& entry, const std::string
 void NANDImporter::ProcessFile(const NANDFSTEntry& entry, const std::string& parent_path)
 {
   constexpr size_t NAND_AES_KEY_OFFSET = 0x158;
-  constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
 
   m_update_callback();
   INFO_LOG(DISCIO, "File: %s", FormatDebugString(entry).c_str());
 
+  // Follow the FAT chain first, so that the clusters can then be decrypted in parallel.
+  const u32 file_size = Common::swap32(entry.size);
+  std::vector<u16> clusters;
+  u16 sub = Common::swap16(entry.sub);
+  for (u32 remaining_bytes = file_size; remaining_bytes > 0;)
+  {
+    if (sub >= NAND_TOTAL_CLUSTERS)
+    {
+      ERROR_LOG(DISCIO, "Invalid cluster 0x%04x in file %s", sub,
+                FormatDebugString(entry).c_str());
+      break;
+    }
+    clusters.push_back(sub);
+    remaining_bytes -= std::min<u32>(remaining_bytes, NAND_CLUSTER_SIZE);
+    sub = Common::swap16(&m_superblock[NAND_FAT_OFFSET + 2 * sub]);
+  }
+
   const std::string path = GetPath(entry, parent_path);
   File::IOFile file(path, "wb");
-  std::array<u8, 16> key{};
-  std::copy(&m_nand_keys[NAND_AES_KEY_OFFSET], &m_nand_keys[NAND_AES_KEY_OFFSET + key.size()],
-            key.begin());
-  u16 sub = Common::swap16(entry.sub);
-  u32 remaining_bytes = Common::swap32(entry.size);
+  const std::unique_ptr<Common::AES::Context> aes =
+      Common::AES::CreateContextDecrypt(&m_nand_keys[NAND_AES_KEY_OFFSET]);
+  std::vector<u8> buffer(std::min(clusters.size(), CLUSTERS_PER_BATCH) * NAND_CLUSTER_SIZE);
+  u32 remaining_bytes = file_size;
 
-  while (remaining_bytes > 0)
+  for (size_t first = 0; first < clusters.size(); first += CLUSTERS_PER_BATCH)
   {
-    std::array<u8, 16> iv{};
-    std::vector<u8> block = Common::AES::Decrypt(
-        key.data(), iv.data(), &m_nand[NAND_FAT_BLOCK_SIZE * sub], NAND_FAT_BLOCK_SIZE);
-    u32 size = remaining_bytes < NAND_FAT_BLOCK_SIZE ? remaining_bytes : NAND_FAT_BLOCK_SIZE;
-    file.WriteBytes(block.data(), size);
-    remaining_bytes -= size;
-    sub = Common::swap16(&m_nand[m_nand_fat_offset + 2 * sub]);
+    const size_t batch_size = std::min(CLUSTERS_PER_BATCH, clusters.size() - first);
+    const size_t num_jobs =
+        (batch_size + CLUSTERS_PER_DECRYPTION_JOB - 1) / CLUSTERS_PER_DECRYPTION_JOB;
+    GetDecryptionPool().Run(num_jobs, [&](size_t job) {
+      const size_t end = std::min(batch_size, (job + 1) * CLUSTERS_PER_DECRYPTION_JOB);
+      for (size_t i = job * CLUSTERS_PER_DECRYPTION_JOB; i < end; ++i)
+      {
+        // Each cluster is encrypted on its own, with a zero IV.
+        u8* cluster = &buffer[i * NAND_CLUSTER_SIZE];
+        ReadNAND(clusters[first + i] * NAND_CLUSTER_SIZE, cluster, NAND_CLUSTER_SIZE);
+        const std::array<u8, Common::AES::BLOCK_SIZE> iv{};
+        aes->Crypt(iv.data(), cluster, cluster, NAND_CLUSTER_SIZE);
+      }
+    });
+
+    const size_t write_size = std::min<size_t>(remaining_bytes, batch_size * NAND_CLUSTER_SIZE);
+    file.WriteBytes(buffer.data(), write_size);
+    remaining_bytes -= static_cast<u32>(write_size);
   }
 }
 
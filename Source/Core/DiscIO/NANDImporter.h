@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
 
 namespace DiscIO
 {
@@ -39,7 +40,8 @@ private:
 #pragma pack(pop)
 
   bool ReadNANDBin(const std::string& path_to_bin);
-  void FindSuperblock();
+  void ReadNAND(size_t offset, u8* out, size_t size) const;
+  bool FindSuperblock();
   std::string GetPath(const NANDFSTEntry& entry, const std::string& parent_path);
   std::string FormatDebugString(const NANDFSTEntry& entry);
   void ProcessEntry(u16 entry_number, const std::string& parent_path);
@@ -47,10 +49,11 @@ private:
   void ProcessDirectory(const NANDFSTEntry& entry, const std::string& parent_path);
   void ExportKeys(const std::string& nand_root);
 
-  std::vector<u8> m_nand;
+  // The dump is mapped rather than read, and only the superblock is copied out of it, since the
+  // data of the dump is interleaved with ECC bytes anyway.
+  Common::MappedFile m_nand_bin;
+  std::vector<u8> m_superblock;
   std::vector<u8> m_nand_keys;
-  size_t m_nand_fat_offset = 0;
-  size_t m_nand_fst_offset = 0;
   std::function<void()> m_update_callback;
   size_t m_nand_root_length = 0;
 };
@@ -0,0 +1,206 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/ReadAheadBlob.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// Reading ahead starts once this many bytes have been read sequentially.
+static constexpr u64 SEQUENTIAL_THRESHOLD = 0x10000;
+// Reads which skip forward by no more than this still count as sequential.
+static constexpr u64 MAX_SEQUENTIAL_GAP = 0x8000;
+// The read ahead thread reads in pieces of MIN_READ_AHEAD, so that it can be stopped quickly
+// when the caller seeks elsewhere.
+static constexpr u32 MIN_READ_AHEAD = 0x40000;
+static constexpr u32 MAX_READ_AHEAD = 0x400000;
+
+ReadAheadBlobReader::ReadAheadBlobReader(std::unique_ptr<BlobReader> reader)
+    : m_reader(std::move(reader)), m_read_ahead_size(MIN_READ_AHEAD)
+{
+}
+
+std::unique_ptr<ReadAheadBlobReader> ReadAheadBlobReader::Create(std::unique_ptr<BlobReader> reader)
+{
+  if (!reader)
+    return nullptr;
+
+  return std::unique_ptr<ReadAheadBlobReader>(new ReadAheadBlobReader(std::move(reader)));
+}
+
+ReadAheadBlobReader::~ReadAheadBlobReader()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_exit = true;
+    m_cancel_request = true;
+  }
+  m_request_cv.notify_one();
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+bool ReadAheadBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  std::unique_lock<std::mutex> lk(m_mutex);
+  UpdateAccessPattern(offset, size);
+
+  bool used_read_ahead = false;
+  while (size > 0)
+  {
+    // Wait for data that is being read ahead instead of reading it a second time.
+    m_done_cv.wait(lk, [&] {
+      return !m_request_pending || offset < m_request_offset ||
+             offset >= m_request_offset + m_request_size;
+    });
+
+    auto it = std::find_if(m_buffers.begin(), m_buffers.end(),
+                           [&](const Buffer& buffer) { return buffer.Contains(offset); });
+    if (it == m_buffers.end())
+      break;
+
+    const u64 bytes_to_copy = std::min(size, it->End() - offset);
+    std::copy_n(it->data.begin() + (offset - it->offset), bytes_to_copy, out_ptr);
+    offset += bytes_to_copy;
+    size -= bytes_to_copy;
+    out_ptr += bytes_to_copy;
+    used_read_ahead = true;
+  }
+
+  if (size > 0)
+  {
+    std::lock_guard<std::mutex> reader_lk(m_reader_mutex);
+    if (!m_reader->Read(offset, size, out_ptr))
+      return false;
+  }
+
+  if (used_read_ahead)
+    m_read_ahead_size = std::min(m_read_ahead_size * 2, MAX_READ_AHEAD);
+
+  if (m_sequential_bytes >= SEQUENTIAL_THRESHOLD)
+    RequestReadAhead(m_sequential_end);
+
+  return true;
+}
+
+bool ReadAheadBlobReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
+                                           u64 partition_offset)
+{
+  std::lock_guard<std::mutex> reader_lk(m_reader_mutex);
+  return m_reader->ReadWiiDecrypted(offset, size, out_ptr, partition_offset);
+}
+
+void ReadAheadBlobReader::UpdateAccessPattern(u64 offset, u64 size)
+{
+  if (offset >= m_sequential_end && offset - m_sequential_end <= MAX_SEQUENTIAL_GAP)
+  {
+    m_sequential_bytes += size;
+  }
+  else
+  {
+    m_sequential_bytes = size;
+    m_read_ahead_size = MIN_READ_AHEAD;
+    if (m_request_pending &&
+        (offset < m_request_offset || offset >= m_request_offset + m_request_size))
+    {
+      m_cancel_request = true;
+    }
+  }
+  m_sequential_end = offset + size;
+}
+
+void ReadAheadBlobReader::RequestReadAhead(u64 position)
+{
+  if (m_request_pending)
+    return;
+
+  // Continue after the data which has already been read ahead.
+  u64 start = position;
+  for (size_t i = 0; i < m_buffers.size(); ++i)
+  {
+    for (const Buffer& buffer : m_buffers)
+    {
+      if (buffer.Contains(start))
+        start = buffer.End();
+    }
+  }
+
+  const u64 data_size = m_reader->GetDataSize();
+  if (start - position >= m_read_ahead_size || start >= data_size)
+    return;
+
+  // Don't replace the buffer which the caller is currently reading from.
+  m_request_buffer = m_buffers[0].Contains(position) ? 1 : 0;
+  m_request_offset = start;
+  m_request_size = std::min<u64>(m_read_ahead_size, data_size - start);
+  m_request_pending = true;
+  m_cancel_request = false;
+
+  if (!m_thread.joinable())
+    m_thread = std::thread(&ReadAheadBlobReader::ThreadLoop, this);
+  m_request_cv.notify_one();
+}
+
+void ReadAheadBlobReader::ThreadLoop()
+{
+  Common::SetCurrentThreadName("Blob Read Ahead");
+
+  while (true)
+  {
+    u64 offset;
+    u64 size;
+    size_t index;
+    std::vector<u8> data;
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_request_cv.wait(lk, [this] { return m_exit || m_request_pending; });
+      if (m_exit)
+        return;
+
+      offset = m_request_offset;
+      size = m_request_size;
+      index = m_request_buffer;
+      // Reuse the memory of the buffer that is being replaced.
+      data = std::move(m_buffers[index].data);
+      m_buffers[index].data.clear();
+    }
+
+    data.resize(size);
+    u64 bytes_read = 0;
+    while (bytes_read < size)
+    {
+      {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_cancel_request)
+          break;
+      }
+
+      const u64 piece_size = std::min<u64>(size - bytes_read, MIN_READ_AHEAD);
+      std::lock_guard<std::mutex> reader_lk(m_reader_mutex);
+      if (!m_reader->Read(offset + bytes_read, piece_size, data.data() + bytes_read))
+        break;
+      bytes_read += piece_size;
+    }
+    data.resize(bytes_read);
+
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_buffers[index].offset = offset;
+      m_buffers[index].data = std::move(data);
+      m_request_pending = false;
+    }
+    m_done_cv.notify_all();
+  }
+}
+
+}  // namespace
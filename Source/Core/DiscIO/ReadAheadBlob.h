@@ -0,0 +1,82 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// Wraps a blob whose reads are slow (because of decompression or because the file is on a
+// network share) and reads ahead of the caller on a background thread once it notices that the
+// caller is reading sequentially, like the DVD thread does while a game streams audio or video.
+// The amount that is read ahead grows while the reads stay sequential and is reset by a seek.
+// The background thread is only started the first time that reading ahead is useful.
+class ReadAheadBlobReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<ReadAheadBlobReader> Create(std::unique_ptr<BlobReader> reader);
+  ~ReadAheadBlobReader();
+
+  BlobType GetBlobType() const override { return m_reader->GetBlobType(); }
+  u64 GetRawSize() const override { return m_reader->GetRawSize(); }
+  u64 GetDataSize() const override { return m_reader->GetDataSize(); }
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+  bool SupportsReadWiiDecrypted() const override { return m_reader->SupportsReadWiiDecrypted(); }
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_offset) override;
+
+private:
+  struct Buffer
+  {
+    u64 offset = 0;
+    std::vector<u8> data;
+
+    u64 End() const { return offset + data.size(); }
+    bool Contains(u64 position) const { return position >= offset && position < End(); }
+  };
+
+  explicit ReadAheadBlobReader(std::unique_ptr<BlobReader> reader);
+
+  // Both require m_mutex to be held.
+  void UpdateAccessPattern(u64 offset, u64 size);
+  void RequestReadAhead(u64 position);
+
+  void ThreadLoop();
+
+  std::unique_ptr<BlobReader> m_reader;
+  // Held while m_reader is used. Never locked by the read ahead thread while it holds m_mutex.
+  std::mutex m_reader_mutex;
+
+  std::mutex m_mutex;
+  std::condition_variable m_request_cv;
+  std::condition_variable m_done_cv;
+  std::thread m_thread;
+  bool m_exit = false;
+
+  // The data that has been read ahead, in two buffers so that the caller can keep reading from
+  // one while the other is being filled.
+  std::array<Buffer, 2> m_buffers;
+
+  // The range that the thread is reading, or has been asked to read.
+  bool m_request_pending = false;
+  bool m_cancel_request = false;
+  u64 m_request_offset = 0;
+  u64 m_request_size = 0;
+  size_t m_request_buffer = 0;
+
+  u64 m_sequential_end = 0;
+  u64 m_sequential_bytes = 0;
+  u32 m_read_ahead_size;
+};
+
+}  // namespace
@@ -0,0 +1,114 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/ScrubbedBlockReader.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DiscScrubber.h"
+
+namespace DiscIO
+{
+ScrubbedBlockReader::ScrubbedBlockReader(const std::string& path, BlobReader* reader,
+                                         u32 block_size, bool skip_zero_blocks)
+    : m_reader(reader), m_block_size(block_size), m_skip_zero_blocks(skip_zero_blocks)
+{
+  m_num_blocks = (reader->GetDataSize() + block_size - 1) / block_size;
+  for (size_t i = 0; i < NUM_BUFFERS; ++i)
+    m_free_buffers.emplace_back(block_size);
+
+  m_thread = std::thread(&ScrubbedBlockReader::ThreadLoop, this, path);
+}
+
+ScrubbedBlockReader::~ScrubbedBlockReader()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_exit = true;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+const u8* ScrubbedBlockReader::GetNextBlock(u64* index)
+{
+  std::unique_lock<std::mutex> lk(m_mutex);
+  if (!m_current_block.data.empty())
+  {
+    m_free_buffers.push_back(std::move(m_current_block.data));
+    m_current_block.data.clear();
+    m_cv.notify_all();
+  }
+
+  m_cv.wait(lk, [this] { return m_done || !m_filled_blocks.empty(); });
+  if (m_filled_blocks.empty())
+    return nullptr;
+
+  m_current_block = std::move(m_filled_blocks.front());
+  m_filled_blocks.pop_front();
+  *index = m_current_block.index;
+  return m_current_block.data.data();
+}
+
+void ScrubbedBlockReader::ThreadLoop(std::string path)
+{
+  Common::SetCurrentThreadName("Scrubbed Block Reader");
+
+  // Discs which can't be scrubbed, like GameCube discs, simply have all of their blocks stored.
+  DiscScrubber scrubber;
+  scrubber.SetupScrub(path, 0x8000);
+
+  const u64 data_size = m_reader->GetDataSize();
+  bool success = true;
+  for (u64 index = 0; index < m_num_blocks; ++index)
+  {
+    const u64 offset = index * m_block_size;
+    if (scrubber.CanBlockBeScrubbed(offset, m_block_size))
+      continue;
+
+    std::vector<u8> buffer;
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_cv.wait(lk, [this] { return m_exit || !m_free_buffers.empty(); });
+      if (m_exit)
+        return;
+      buffer = std::move(m_free_buffers.back());
+      m_free_buffers.pop_back();
+    }
+
+    const u64 read_size = std::min<u64>(m_block_size, data_size - offset);
+    std::fill(buffer.begin() + read_size, buffer.end(), 0);
+    if (!m_reader->Read(offset, read_size, buffer.data()))
+    {
+      success = false;
+      break;
+    }
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_skip_zero_blocks &&
+        std::all_of(buffer.begin(), buffer.end(), [](u8 byte) { return byte == 0; }))
+    {
+      m_free_buffers.push_back(std::move(buffer));
+    }
+    else
+    {
+      m_filled_blocks.push_back(Block{index, std::move(buffer)});
+      m_cv.notify_all();
+    }
+  }
+
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_done = true;
+  m_read_failed = !success;
+  m_cv.notify_all();
+}
+
+}  // namespace
@@ -0,0 +1,71 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+class BlobReader;
+
+// Hands out the blocks of a disc image which have to be stored when converting it to a sparse
+// format, in order. A background thread first scrubs the disc (which only works for Wii discs)
+// to find the blocks that aren't used, and then reads the remaining blocks ahead of the caller
+// while the caller writes. At most NUM_BUFFERS blocks are held in memory at a time.
+class ScrubbedBlockReader final
+{
+public:
+  // reader must stay valid until this object is destroyed. If skip_zero_blocks is set, blocks
+  // which only contain zeroes are skipped as well.
+  ScrubbedBlockReader(const std::string& path, BlobReader* reader, u32 block_size,
+                      bool skip_zero_blocks);
+  ~ScrubbedBlockReader();
+
+  u64 GetNumBlocks() const { return m_num_blocks; }
+
+  // Returns the data of the next block to store and sets index to its index, or returns nullptr
+  // once there are no more blocks. The last block is padded with zeroes to the full block size.
+  // The data stays valid until the next call.
+  const u8* GetNextBlock(u64* index);
+
+  // Whether GetNextBlock stopped because of a read error.
+  bool ReadFailed() const { return m_read_failed; }
+
+private:
+  static constexpr size_t NUM_BUFFERS = 4;
+
+  struct Block
+  {
+    u64 index;
+    std::vector<u8> data;
+  };
+
+  void ThreadLoop(std::string path);
+
+  BlobReader* m_reader;
+  u32 m_block_size;
+  bool m_skip_zero_blocks;
+  u64 m_num_blocks;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Block> m_filled_blocks;
+  std::vector<std::vector<u8>> m_free_buffers;
+  Block m_current_block;
+  bool m_done = false;
+  bool m_read_failed = false;
+  bool m_exit = false;
+
+  std::thread m_thread;
+};
+
+}  // namespace
@@ -43,6 +43,15 @@ bool VolumeGC::Read(u64 _Offset, u64 _Length, u8* _pBuffer, const Partition& par
   return m_pReader->Read(_Offset, _Length, _pBuffer);
 }
 
+std::shared_ptr<const u8> VolumeGC::GetDirectPointer(u64 offset, u64 length,
+                                                     const Partition& partition) const
+{
+  if (partition != PARTITION_NONE)
+    return nullptr;
+
+  return m_pReader->GetDirectPointer(offset, length);
+}
+
 std::string VolumeGC::GetGameID(const Partition& partition) const
 {
   static const std::string NO_UID("NO_UID");
@@ -9,7 +9,6 @@
 #include <cstddef>
 #include <cstring>
 #include <map>
-#include <mbedtls/aes.h>
 #include <mbedtls/sha1.h>
 #include <memory>
 #include <optional>
@@ -19,9 +18,12 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
+#include "Common/WorkerPool.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscExtractor.h"
@@ -32,10 +34,20 @@
 namespace DiscIO
 {
 constexpr u64 PARTITION_DATA_OFFSET = 0x20000;
+// The most blocks that Read decrypts at once without going through the cache (one hash group).
+constexpr u64 MAX_BULK_READ_BLOCKS = 64;
+// Bulk reads are decrypted on several threads, in groups of this many blocks.
+constexpr u64 BLOCKS_PER_DECRYPTION_JOB = 8;
+
+static Common::WorkerPool& GetDecryptionPool()
+{
+  static Common::WorkerPool pool(Common::ThreadPool::GetNumThreads());
+  return pool;
+}
 
 VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
     : m_pReader(std::move(reader)), m_game_partition(PARTITION_NONE),
-      m_last_decrypted_block(UINT64_MAX)
+      m_cached_blocks(CACHED_BLOCKS)
 {
   _assert_(m_pReader);
 
@@ -101,18 +113,16 @@ VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
         return IOS::ES::TMDReader{std::move(tmd_buffer)};
       };
 
-      auto get_key = [this, partition]() -> std::unique_ptr<mbedtls_aes_context> {
+      auto get_key = [this, partition]() -> std::unique_ptr<Common::AES::Context> {
         const IOS::ES::TicketReader& ticket = *m_partitions[partition].ticket;
         if (!ticket.IsValid())
           return nullptr;
         const std::array<u8, 16> key = ticket.GetTitleKey();
-        std::unique_ptr<mbedtls_aes_context> aes_context = std::make_unique<mbedtls_aes_context>();
-        mbedtls_aes_setkey_dec(aes_context.get(), key.data(), 128);
-        return aes_context;
+        return Common::AES::CreateContextDecrypt(key.data());
       };
 
       m_partitions.emplace(
-          partition, PartitionDetails{Common::Lazy<std::unique_ptr<mbedtls_aes_context>>(get_key),
+          partition, PartitionDetails{Common::Lazy<std::unique_ptr<Common::AES::Context>>(get_key),
                                       Common::Lazy<IOS::ES::TicketReader>(get_ticket),
                                       Common::Lazy<IOS::ES::TMDReader>(get_tmd), *partition_type});
     }
@@ -135,11 +145,10 @@ bool VolumeWii::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, const Partition
   auto it = m_partitions.find(partition);
   if (it == m_partitions.end())
     return false;
-  mbedtls_aes_context* aes_context = it->second.key->get();
+  const Common::AES::Context* aes_context = it->second.key->get();
   if (!aes_context)
     return false;
 
-  std::vector<u8> read_buffer(BLOCK_TOTAL_SIZE);
   while (_Length > 0)
   {
     // Calculate offsets
@@ -147,30 +156,61 @@ bool VolumeWii::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, const Partition
         partition.offset + PARTITION_DATA_OFFSET + _ReadOffset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
     u64 data_offset_in_block = _ReadOffset % BLOCK_DATA_SIZE;
 
-    if (m_last_decrypted_block != block_offset_on_disc)
+    auto cached = std::find_if(
+        m_cached_blocks.begin(), m_cached_blocks.end(),
+        [block_offset_on_disc](const CachedBlock& b) { return b.offset == block_offset_on_disc; });
+
+    // Reads of several whole blocks, like when extracting files, are read from the blob at once
+    // and decrypted straight into the output without going through the cache.
+    const u64 whole_blocks =
+        data_offset_in_block == 0 ? std::min(_Length / BLOCK_DATA_SIZE, MAX_BULK_READ_BLOCKS) : 0;
+    if (whole_blocks >= 2 && cached == m_cached_blocks.end())
     {
-      // Read the current block
-      if (!m_pReader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.data()))
+      m_read_buffer.resize(whole_blocks * BLOCK_TOTAL_SIZE);
+      if (!m_pReader->Read(block_offset_on_disc, m_read_buffer.size(), m_read_buffer.data()))
         return false;
+      const u64 num_jobs =
+          (whole_blocks + BLOCKS_PER_DECRYPTION_JOB - 1) / BLOCKS_PER_DECRYPTION_JOB;
+      GetDecryptionPool().Run(static_cast<size_t>(num_jobs), [&](size_t i) {
+        const u64 first_block = i * BLOCKS_PER_DECRYPTION_JOB;
+        DecryptBlocksData(&m_read_buffer[first_block * BLOCK_TOTAL_SIZE],
+                          _pBuffer + first_block * BLOCK_DATA_SIZE,
+                          std::min(BLOCKS_PER_DECRYPTION_JOB, whole_blocks - first_block),
+                          *aes_context);
+      });
+
+      const u64 copy_size = whole_blocks * BLOCK_DATA_SIZE;
+      _Length -= copy_size;
+      _pBuffer += copy_size;
+      _ReadOffset += copy_size;
+      continue;
+    }
 
-      // Decrypt the block's data.
-      // 0x3D0 - 0x3DF in read_buffer will be overwritten,
-      // but that won't affect anything, because we won't
-      // use the content of read_buffer anymore after this
-      mbedtls_aes_crypt_cbc(aes_context, MBEDTLS_AES_DECRYPT, BLOCK_DATA_SIZE, &read_buffer[0x3D0],
-                            &read_buffer[BLOCK_HEADER_SIZE], m_last_decrypted_block_data);
-      m_last_decrypted_block = block_offset_on_disc;
+    if (cached == m_cached_blocks.end())
+    {
+      // Replace the least recently used block
+      cached = std::min_element(
+          m_cached_blocks.begin(), m_cached_blocks.end(),
+          [](const CachedBlock& a, const CachedBlock& b) { return a.last_used < b.last_used; });
+      cached->offset = UINT64_MAX;
+
+      // Read the current block
+      m_read_buffer.resize(BLOCK_TOTAL_SIZE);
+      if (!m_pReader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, m_read_buffer.data()))
+        return false;
 
       // The only thing we currently use from the 0x000 - 0x3FF part
       // of the block is the IV (at 0x3D0), but it also contains SHA-1
       // hashes that IOS uses to check that discs aren't tampered with.
       // http://wiibrew.org/wiki/Wii_Disc#Encrypted
+      DecryptBlocksData(m_read_buffer.data(), cached->data.data(), 1, *aes_context);
+      cached->offset = block_offset_on_disc;
     }
+    cached->last_used = ++m_cache_counter;
 
     // Copy the decrypted data
     u64 copy_size = std::min(_Length, BLOCK_DATA_SIZE - data_offset_in_block);
-    memcpy(_pBuffer, &m_last_decrypted_block_data[data_offset_in_block],
-           static_cast<size_t>(copy_size));
+    memcpy(_pBuffer, &cached->data[data_offset_in_block], static_cast<size_t>(copy_size));
 
     // Update offsets
     _Length -= copy_size;
@@ -181,6 +221,28 @@ bool VolumeWii::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, const Partition
   return true;
 }
 
+std::shared_ptr<const u8> VolumeWii::GetDirectPointer(u64 offset, u64 length,
+                                                      const Partition& partition) const
+{
+  // Data in partitions has to be decrypted, so only the unencrypted parts can be used directly.
+  if (partition != PARTITION_NONE)
+    return nullptr;
+
+  return m_pReader->GetDirectPointer(offset, length);
+}
+
+void VolumeWii::DecryptBlocksData(const u8* in, u8* out, size_t num_blocks,
+                                  const Common::AES::Context& key)
+{
+  for (size_t i = 0; i < num_blocks; ++i)
+  {
+    // The data is encrypted with part of the encrypted hash block as the IV.
+    const u8* block = in + i * BLOCK_TOTAL_SIZE;
+    key.Crypt(block + 0x3D0, block + BLOCK_HEADER_SIZE, out + i * BLOCK_DATA_SIZE,
+              BLOCK_DATA_SIZE);
+  }
+}
+
 std::vector<Partition> VolumeWii::GetPartitions() const
 {
   std::vector<Partition> partitions;
@@ -351,7 +413,7 @@ bool VolumeWii::CheckIntegrity(const Partition& partition) const
   auto it = m_partitions.find(partition);
   if (it == m_partitions.end())
     return false;
-  mbedtls_aes_context* aes_context = it->second.key->get();
+  const Common::AES::Context* aes_context = it->second.key->get();
   if (!aes_context)
     return false;
 
@@ -374,7 +436,7 @@ bool VolumeWii::CheckIntegrity(const Partition& partition) const
       WARN_LOG(DISCIO, "Integrity Check: fail at cluster %d: could not read metadata", clusterID);
       return false;
     }
-    mbedtls_aes_crypt_cbc(aes_context, MBEDTLS_AES_DECRYPT, 0x400, IV, clusterMDCrypted, clusterMD);
+    aes_context->Crypt(IV, clusterMDCrypted, clusterMD, 0x400);
 
     // Some clusters have invalid data and metadata because they aren't
     // meant to be read by the game (for example, holes between files). To
@@ -4,14 +4,15 @@
 
 #pragma once
 
+#include <array>
 #include <map>
-#include <mbedtls/aes.h>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 #include "Common/Lazy.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/Volume.h"
@@ -33,6 +34,8 @@ public:
   VolumeWii(std::unique_ptr<BlobReader> reader);
   ~VolumeWii();
   bool Read(u64 _Offset, u64 _Length, u8* _pBuffer, const Partition& partition) const override;
+  std::shared_ptr<const u8> GetDirectPointer(u64 offset, u64 length,
+                                             const Partition& partition) const override;
   std::vector<Partition> GetPartitions() const override;
   Partition GetGamePartition() const override;
   std::optional<u32> GetPartitionType(const Partition& partition) const override;
@@ -64,12 +67,17 @@ public:
   static constexpr unsigned int BLOCK_DATA_SIZE = 0x7C00;
   static constexpr unsigned int BLOCK_TOTAL_SIZE = BLOCK_HEADER_SIZE + BLOCK_DATA_SIZE;
 
+  // Decrypts the data of num_blocks consecutive encrypted blocks (BLOCK_TOTAL_SIZE each) into
+  // num_blocks * BLOCK_DATA_SIZE bytes. Can be called from any thread.
+  static void DecryptBlocksData(const u8* in, u8* out, size_t num_blocks,
+                                const Common::AES::Context& key);
+
 protected:
   u32 GetOffsetShift() const override { return 2; }
 private:
   struct PartitionDetails
   {
-    Common::Lazy<std::unique_ptr<mbedtls_aes_context>> key;
+    Common::Lazy<std::unique_ptr<Common::AES::Context>> key;
     Common::Lazy<IOS::ES::TicketReader> ticket;
     Common::Lazy<IOS::ES::TMDReader> tmd;
     u32 type;
@@ -79,8 +87,19 @@ private:
   std::map<Partition, PartitionDetails> m_partitions;
   Partition m_game_partition;
 
-  mutable u64 m_last_decrypted_block;
-  mutable u8 m_last_decrypted_block_data[BLOCK_DATA_SIZE];
+  struct CachedBlock
+  {
+    u64 offset = UINT64_MAX;
+    u64 last_used = 0;
+    std::array<u8, BLOCK_DATA_SIZE> data;
+  };
+
+  // Recently decrypted blocks, so that reads which go back and forth between a few blocks
+  // (like the FST and the file data it points to) don't decrypt the same blocks over and over.
+  static constexpr size_t CACHED_BLOCKS = 16;
+  mutable std::vector<CachedBlock> m_cached_blocks;
+  mutable u64 m_cache_counter = 0;
+  mutable std::vector<u8> m_read_buffer;
 };
 
 }  // namespace
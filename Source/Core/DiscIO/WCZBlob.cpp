@@ -0,0 +1,473 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/WCZBlob.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+#include <mbedtls/sha1.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/Enums.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeWii.h"
+
+namespace DiscIO
+{
+constexpr u32 CLUSTER_SIZE = VolumeWii::BLOCK_TOTAL_SIZE;
+constexpr u32 CLUSTER_HEADER_SIZE = VolumeWii::BLOCK_HEADER_SIZE;
+constexpr u32 CLUSTER_DATA_SIZE = VolumeWii::BLOCK_DATA_SIZE;
+constexpr u32 CLUSTERS_PER_SUBGROUP = 8;
+constexpr u32 CLUSTERS_PER_GROUP = 64;
+constexpr u32 GROUP_SIZE = CLUSTER_SIZE * CLUSTERS_PER_GROUP;
+
+// Data outside of partitions is stored in blocks of the same size as a hash group.
+constexpr u32 RAW_BLOCK_SIZE = GROUP_SIZE;
+
+// Layout of the hash block at the start of each cluster.
+constexpr u32 SHA1_SIZE = 20;
+constexpr u32 H0_OFFSET = 0x000;
+constexpr u32 H0_COUNT = CLUSTER_DATA_SIZE / 0x400;
+constexpr u32 H1_OFFSET = 0x280;
+constexpr u32 H2_OFFSET = 0x340;
+constexpr u32 IV_OFFSET = 0x3D0;
+
+static u32 GetDecompressedSize(const WCZBlockEntry& block)
+{
+  return block.partition ? block.size / CLUSTER_SIZE * CLUSTER_DATA_SIZE : block.size;
+}
+
+// Turns the decrypted data of the clusters of a hash group back into the clusters on the disc,
+// by regenerating the hashes and encrypting both the hashes and the data.
+static void EncryptGroup(const u8* data, u32 num_clusters, const Common::AES::Context& key,
+                         u8* out)
+{
+  // The hash blocks are built in place before they are encrypted.
+  for (u32 i = 0; i < num_clusters; i++)
+  {
+    u8* hash_block = out + i * CLUSTER_SIZE;
+    std::fill(hash_block, hash_block + CLUSTER_HEADER_SIZE, 0);
+    for (u32 j = 0; j < H0_COUNT; j++)
+    {
+      mbedtls_sha1(data + i * CLUSTER_DATA_SIZE + j * 0x400, 0x400,
+                   hash_block + H0_OFFSET + j * SHA1_SIZE);
+    }
+  }
+
+  // Every cluster of a subgroup has the hashes of the H0 tables of all clusters in the subgroup.
+  for (u32 i = 0; i < num_clusters; i++)
+  {
+    u8 h1[SHA1_SIZE];
+    mbedtls_sha1(out + i * CLUSTER_SIZE + H0_OFFSET, H0_COUNT * SHA1_SIZE, h1);
+
+    const u32 subgroup_start = i / CLUSTERS_PER_SUBGROUP * CLUSTERS_PER_SUBGROUP;
+    const u32 subgroup_end = std::min(subgroup_start + CLUSTERS_PER_SUBGROUP, num_clusters);
+    for (u32 j = subgroup_start; j < subgroup_end; j++)
+    {
+      std::copy(h1, h1 + SHA1_SIZE,
+                out + j * CLUSTER_SIZE + H1_OFFSET + (i % CLUSTERS_PER_SUBGROUP) * SHA1_SIZE);
+    }
+  }
+
+  // Every cluster of the group has the hashes of the H1 tables of all subgroups.
+  for (u32 i = 0; i < num_clusters; i += CLUSTERS_PER_SUBGROUP)
+  {
+    u8 h2[SHA1_SIZE];
+    mbedtls_sha1(out + i * CLUSTER_SIZE + H1_OFFSET, CLUSTERS_PER_SUBGROUP * SHA1_SIZE, h2);
+    for (u32 j = 0; j < num_clusters; j++)
+    {
+      std::copy(h2, h2 + SHA1_SIZE,
+                out + j * CLUSTER_SIZE + H2_OFFSET + i / CLUSTERS_PER_SUBGROUP * SHA1_SIZE);
+    }
+  }
+
+  for (u32 i = 0; i < num_clusters; i++)
+  {
+    u8* cluster = out + i * CLUSTER_SIZE;
+
+    const std::array<u8, Common::AES::BLOCK_SIZE> iv = {};
+    key.Crypt(iv.data(), cluster, cluster, CLUSTER_HEADER_SIZE);
+
+    // The data is encrypted with part of the encrypted hash block as the IV.
+    key.Crypt(cluster + IV_OFFSET, data + i * CLUSTER_DATA_SIZE, cluster + CLUSTER_HEADER_SIZE,
+              CLUSTER_DATA_SIZE);
+  }
+}
+
+WCZFileReader::WCZFileReader(File::IOFile file) : m_file(std::move(file))
+{
+  m_file_size = m_file.GetSize();
+}
+
+WCZFileReader::~WCZFileReader()
+{
+}
+
+std::unique_ptr<WCZFileReader> WCZFileReader::Create(File::IOFile file)
+{
+  std::unique_ptr<WCZFileReader> reader(new WCZFileReader(std::move(file)));
+  if (!reader->Initialize())
+    return nullptr;
+
+  return reader;
+}
+
+bool WCZFileReader::Initialize()
+{
+  if (!m_file.Seek(0, SEEK_SET) || !m_file.ReadArray(&m_header, 1) ||
+      m_header.magic != WCZ_MAGIC)
+  {
+    return false;
+  }
+
+  if (m_header.version != WCZ_VERSION || m_header.compression > WCZCompression::Zlib)
+  {
+    ERROR_LOG(DISCIO, "Unsupported WCZ file (version %u, compression %u)", m_header.version,
+              static_cast<u32>(m_header.compression));
+    return false;
+  }
+
+  m_partitions.resize(m_header.num_partitions);
+  m_blocks.resize(m_header.num_blocks);
+  if (!m_file.ReadArray(m_partitions.data(), m_partitions.size()) ||
+      !m_file.ReadArray(m_blocks.data(), m_blocks.size()))
+  {
+    return false;
+  }
+
+  // The blocks must cover the disc image in order, and be no larger than a hash group.
+  u64 offset = 0;
+  for (const WCZBlockEntry& block : m_blocks)
+  {
+    if (block.offset != offset || block.size > GROUP_SIZE ||
+        block.partition > m_partitions.size() ||
+        (block.partition && block.size % CLUSTER_SIZE != 0))
+    {
+      ERROR_LOG(DISCIO, "Invalid WCZ block table");
+      return false;
+    }
+    offset += block.size;
+  }
+  if (offset != m_header.data_size)
+    return false;
+
+  for (const WCZPartitionEntry& partition : m_partitions)
+    m_partition_keys.push_back(Common::AES::CreateContextEncrypt(partition.title_key));
+
+  return true;
+}
+
+bool WCZFileReader::LoadBlock(size_t index)
+{
+  if (index == m_cached_block)
+    return true;
+
+  const WCZBlockEntry& block = m_blocks[index];
+  m_stored_data.resize(block.stored_size);
+  if (!m_file.Seek(block.file_offset, SEEK_SET) ||
+      !m_file.ReadBytes(m_stored_data.data(), block.stored_size))
+  {
+    m_file.Clear();
+    return false;
+  }
+
+  const u32 decompressed_size = GetDecompressedSize(block);
+  const u8* data = m_stored_data.data();
+  if (block.compressed)
+  {
+    m_decompressed_data.resize(decompressed_size);
+    uLongf size = decompressed_size;
+    if (uncompress(m_decompressed_data.data(), &size, m_stored_data.data(), block.stored_size) !=
+            Z_OK ||
+        size != decompressed_size)
+    {
+      ERROR_LOG(DISCIO, "Failed to decompress WCZ block at %" PRIx64, block.offset);
+      return false;
+    }
+    data = m_decompressed_data.data();
+  }
+  else if (block.stored_size != decompressed_size)
+  {
+    return false;
+  }
+
+  m_cached_block = SIZE_MAX;
+  m_cached_data.resize(block.size);
+  if (block.partition)
+  {
+    EncryptGroup(data, block.size / CLUSTER_SIZE, *m_partition_keys[block.partition - 1],
+                 m_cached_data.data());
+  }
+  else
+  {
+    std::copy_n(data, block.size, m_cached_data.begin());
+  }
+
+  m_cached_block = index;
+  return true;
+}
+
+bool WCZFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
+{
+  while (nbytes != 0)
+  {
+    // The last block that starts at or before the offset.
+    auto it = std::upper_bound(
+        m_blocks.begin(), m_blocks.end(), offset,
+        [](u64 value, const WCZBlockEntry& block) { return value < block.offset; });
+    if (it == m_blocks.begin())
+      return false;
+
+    const size_t index = it - m_blocks.begin() - 1;
+    const u64 offset_in_block = offset - m_blocks[index].offset;
+    if (offset_in_block >= m_blocks[index].size || !LoadBlock(index))
+      return false;
+
+    const u64 bytes_to_read = std::min<u64>(m_blocks[index].size - offset_in_block, nbytes);
+    std::copy_n(m_cached_data.begin() + offset_in_block, bytes_to_read, out_ptr);
+
+    out_ptr += bytes_to_read;
+    offset += bytes_to_read;
+    nbytes -= bytes_to_read;
+  }
+
+  return true;
+}
+
+static std::vector<WCZPartitionEntry> GetWiiPartitions(const std::string& infile_path,
+                                                       BlobReader* reader)
+{
+  std::vector<WCZPartitionEntry> partitions;
+
+  std::unique_ptr<Volume> volume = CreateVolumeFromFilename(infile_path);
+  if (!volume || volume->GetVolumeType() != Platform::WII_DISC)
+    return partitions;
+
+  for (const Partition& partition : volume->GetPartitions())
+  {
+    const std::optional<u32> data_offset = reader->ReadSwapped<u32>(partition.offset + 0x2B8);
+    const std::optional<u32> data_size = reader->ReadSwapped<u32>(partition.offset + 0x2BC);
+    if (!data_offset || !data_size)
+      continue;
+
+    WCZPartitionEntry entry = {};
+    entry.data_offset = partition.offset + (static_cast<u64>(*data_offset) << 2);
+    entry.data_size = (static_cast<u64>(*data_size) << 2) / CLUSTER_SIZE * CLUSTER_SIZE;
+    if (entry.data_offset + entry.data_size > reader->GetDataSize())
+      continue;
+
+    const std::array<u8, 16> title_key = volume->GetTicket(partition).GetTitleKey();
+    std::copy(title_key.begin(), title_key.end(), entry.title_key);
+    partitions.push_back(entry);
+  }
+
+  std::sort(partitions.begin(), partitions.end(),
+            [](const WCZPartitionEntry& a, const WCZPartitionEntry& b) {
+              return a.data_offset < b.data_offset;
+            });
+
+  // Overlapping partitions only happen on broken images, which are then partly stored raw.
+  u64 end = 0;
+  auto overlapping = [&end](const WCZPartitionEntry& partition) {
+    if (partition.data_offset < end)
+      return true;
+    end = partition.data_offset + partition.data_size;
+    return false;
+  };
+  partitions.erase(std::remove_if(partitions.begin(), partitions.end(), overlapping),
+                   partitions.end());
+
+  return partitions;
+}
+
+bool ConvertToWCZ(const std::string& infile_path, const std::string& outfile_path,
+                  CompressCB callback, void* arg)
+{
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  if (reader->GetBlobType() == BlobType::WCZ)
+  {
+    PanicAlertT("\"%s\" is already compressed! Cannot compress it further.", infile_path.c_str());
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  callback(GetStringT("Files opened, ready to compress."), 0, arg);
+
+  const std::vector<WCZPartitionEntry> partitions = GetWiiPartitions(infile_path, reader.get());
+  std::vector<std::unique_ptr<Common::AES::Context>> decryption_keys;
+  std::vector<std::unique_ptr<Common::AES::Context>> encryption_keys;
+  for (const WCZPartitionEntry& partition : partitions)
+  {
+    decryption_keys.push_back(Common::AES::CreateContextDecrypt(partition.title_key));
+    encryption_keys.push_back(Common::AES::CreateContextEncrypt(partition.title_key));
+  }
+
+  std::vector<WCZBlockEntry> blocks;
+  auto add_blocks = [&blocks](u64 offset, u64 end, u32 max_size, u32 partition) {
+    while (offset < end)
+    {
+      WCZBlockEntry block = {};
+      block.offset = offset;
+      block.size = static_cast<u32>(std::min<u64>(max_size, end - offset));
+      block.partition = partition;
+      blocks.push_back(block);
+      offset += block.size;
+    }
+  };
+
+  u64 raw_offset = 0;
+  for (size_t i = 0; i < partitions.size(); i++)
+  {
+    const u64 end = partitions[i].data_offset + partitions[i].data_size;
+    add_blocks(raw_offset, partitions[i].data_offset, RAW_BLOCK_SIZE, 0);
+    add_blocks(partitions[i].data_offset, end, GROUP_SIZE, static_cast<u32>(i + 1));
+    raw_offset = end;
+  }
+  add_blocks(raw_offset, reader->GetDataSize(), RAW_BLOCK_SIZE, 0);
+
+  WCZHeader header = {};
+  header.magic = WCZ_MAGIC;
+  header.version = WCZ_VERSION;
+  header.compression = WCZCompression::Zlib;
+  header.num_partitions = static_cast<u32>(partitions.size());
+  header.num_blocks = static_cast<u32>(blocks.size());
+  header.data_size = reader->GetDataSize();
+
+  // seek past the header and the tables (we will write them at the end)
+  u64 position = sizeof(WCZHeader) + sizeof(WCZPartitionEntry) * partitions.size() +
+                 sizeof(WCZBlockEntry) * blocks.size();
+  outfile.Seek(position, SEEK_SET);
+
+  std::vector<u8> raw_data(GROUP_SIZE);
+  std::vector<u8> decrypted_data(CLUSTERS_PER_GROUP * CLUSTER_DATA_SIZE);
+  std::vector<u8> encrypted_data(GROUP_SIZE);
+  std::vector<u8> compressed_data(compressBound(GROUP_SIZE));
+
+  const u64 data_start = position;
+  int progress_monitor = std::max<int>(1, header.num_blocks / 1000);
+  bool success = true;
+
+  for (u32 i = 0; i < header.num_blocks; i++)
+  {
+    WCZBlockEntry& block = blocks[i];
+
+    if (i % progress_monitor == 0)
+    {
+      int ratio = 0;
+      if (block.offset != 0)
+        ratio = (int)(100 * (position - data_start) / block.offset);
+
+      std::string temp =
+          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(), i,
+                           header.num_blocks, ratio);
+      bool was_cancelled = !callback(temp, (float)i / (float)header.num_blocks, arg);
+      if (was_cancelled)
+      {
+        success = false;
+        break;
+      }
+    }
+
+    if (!reader->Read(block.offset, block.size, raw_data.data()))
+    {
+      PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+      success = false;
+      break;
+    }
+
+    const u8* data = raw_data.data();
+    u32 data_size = block.size;
+    if (block.partition)
+    {
+      const u32 num_clusters = block.size / CLUSTER_SIZE;
+      VolumeWii::DecryptBlocksData(raw_data.data(), decrypted_data.data(), num_clusters,
+                                   *decryption_keys[block.partition - 1]);
+      EncryptGroup(decrypted_data.data(), num_clusters, *encryption_keys[block.partition - 1],
+                   encrypted_data.data());
+
+      // Groups whose hashes can't be regenerated from the data, e.g. on discs with invalid
+      // hashes or garbage in the padding of the hash blocks, are stored as they are.
+      if (std::equal(raw_data.begin(), raw_data.begin() + block.size, encrypted_data.begin()))
+      {
+        data = decrypted_data.data();
+        data_size = num_clusters * CLUSTER_DATA_SIZE;
+      }
+      else
+      {
+        block.partition = 0;
+      }
+    }
+
+    uLongf compressed_size = static_cast<uLongf>(compressed_data.size());
+    if (compress2(compressed_data.data(), &compressed_size, data, data_size, 9) == Z_OK &&
+        compressed_size < data_size)
+    {
+      data = compressed_data.data();
+      data_size = static_cast<u32>(compressed_size);
+      block.compressed = 1;
+    }
+
+    if (!outfile.WriteBytes(data, data_size))
+    {
+      PanicAlertT("Failed to write the output file \"%s\".\n"
+                  "Check that you have enough space available on the target drive.",
+                  outfile_path.c_str());
+      success = false;
+      break;
+    }
+
+    block.file_offset = position;
+    block.stored_size = data_size;
+    position += data_size;
+  }
+
+  if (!success)
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  // Okay, go back and fill in headers
+  outfile.Seek(0, SEEK_SET);
+  outfile.WriteArray(&header, 1);
+  outfile.WriteArray(partitions.data(), partitions.size());
+  outfile.WriteArray(blocks.data(), blocks.size());
+
+  callback(GetStringT("Done compressing disc image."), 1.0f, arg);
+  return true;
+}
+
+}  // namespace
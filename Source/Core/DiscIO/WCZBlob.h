@@ -0,0 +1,103 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// WARNING Code not big-endian safe.
+
+// To create new WCZ files, use ConvertToWCZ.
+
+// Unlike GCZ, WCZ stores the data of Wii partitions decrypted and without the hashes, which
+// makes it compress about as well as the files on the disc. The hashes and the encryption are
+// regenerated when reading, so the disc image that is read is identical to the original.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+#include "Common/File.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+static constexpr u32 WCZ_MAGIC = 0x015A4357;  // "WCZ\x01" (byteswapped to little endian)
+static constexpr u32 WCZ_VERSION = 1;
+
+// WCZ file structure:
+// WCZHeader
+// WCZPartitionEntry[num_partitions]
+// WCZBlockEntry[num_blocks]
+// block data
+
+enum class WCZCompression : u32
+{
+  None = 0,
+  Zlib = 1,
+};
+
+struct WCZHeader
+{
+  u32 magic;
+  u32 version;
+  WCZCompression compression;
+  u32 num_partitions;
+  u32 num_blocks;
+  u32 pad;
+  u64 data_size;
+};
+
+struct WCZPartitionEntry
+{
+  // The partition data, which consists of encrypted clusters with hashes.
+  u64 data_offset;
+  u64 data_size;
+  u8 title_key[16];
+};
+
+// The blocks cover the whole disc image in order. Blocks of partition data are one hash group
+// (64 clusters) in size, and only contain the decrypted data part of each cluster.
+struct WCZBlockEntry
+{
+  u64 offset;
+  u64 file_offset;
+  u32 size;
+  u32 stored_size;
+  // Index + 1 of the partition which the block is decrypted data of, or 0 for raw data.
+  u32 partition;
+  u32 compressed;
+};
+
+class WCZFileReader : public BlobReader
+{
+public:
+  static std::unique_ptr<WCZFileReader> Create(File::IOFile file);
+  ~WCZFileReader();
+
+  BlobType GetBlobType() const override { return BlobType::WCZ; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  u64 GetRawSize() const override { return m_file_size; }
+  bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+
+private:
+  explicit WCZFileReader(File::IOFile file);
+  bool Initialize();
+  bool LoadBlock(size_t index);
+
+  File::IOFile m_file;
+  u64 m_file_size = 0;
+  WCZHeader m_header;
+  std::vector<WCZPartitionEntry> m_partitions;
+  std::vector<std::unique_ptr<Common::AES::Context>> m_partition_keys;
+  std::vector<WCZBlockEntry> m_blocks;
+
+  // The most recently read block, as stored in the disc image.
+  size_t m_cached_block = SIZE_MAX;
+  std::vector<u8> m_cached_data;
+  std::vector<u8> m_stored_data;
+  std::vector<u8> m_decompressed_data;
+};
+
+}  // namespace
@@ -16,8 +16,13 @@
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "DiscIO/Enums.h"
+#include "DiscIO/ScrubbedBlockReader.h"
+#include "DiscIO/Volume.h"
 
 namespace DiscIO
 {
@@ -180,4 +185,125 @@ std::unique_ptr<WbfsFileReader> WbfsFileReader::Create(File::IOFile file, const
   return reader;
 }
 
+bool ConvertToWBFS(const std::string& infile_path, const std::string& outfile_path,
+                   CompressCB callback, void* arg)
+{
+  // The sector sizes that USB loaders use by default for WBFS files.
+  static constexpr u8 HD_SECTOR_SHIFT = 9;
+  static constexpr u8 WBFS_SECTOR_SHIFT = 21;
+  static constexpr u32 WBFS_SECTOR_SIZE = 1 << WBFS_SECTOR_SHIFT;
+  static constexpr u64 BLOCKS_PER_DISC =
+      (WII_SECTOR_COUNT * WII_SECTOR_SIZE + WBFS_SECTOR_SIZE - 1) / WBFS_SECTOR_SIZE;
+
+  std::unique_ptr<Volume> volume = CreateVolumeFromFilename(infile_path);
+  if (!volume || volume->GetVolumeType() != Platform::WII_DISC)
+  {
+    PanicAlertT("\"%s\" is not a Wii disc. Only Wii discs can be converted to WBFS.",
+                infile_path.c_str());
+    return false;
+  }
+  volume.reset();
+
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  if (reader->GetDataSize() > WII_SECTOR_COUNT * WII_SECTOR_SIZE)
+  {
+    PanicAlertT("\"%s\" is too large to be converted to WBFS.", infile_path.c_str());
+    return false;
+  }
+
+  std::vector<u8> disc_info(
+      Common::AlignUp(WII_DISC_HEADER_SIZE + BLOCKS_PER_DISC * sizeof(u16), 1 << HD_SECTOR_SHIFT));
+  if (!reader->Read(0, WII_DISC_HEADER_SIZE, disc_info.data()))
+  {
+    PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  if (callback)
+    callback(GetStringT("Files opened, ready to convert."), 0, arg);
+
+  ScrubbedBlockReader blocks(infile_path, reader.get(), WBFS_SECTOR_SIZE, false);
+
+  // The first WBFS sector holds the header, the disc info and the table of free sectors, which
+  // stays zeroed since a WBFS file has no free sectors. The disc's blocks are stored after it.
+  outfile.Seek(WBFS_SECTOR_SIZE, SEEK_SET);
+
+  u16* wlba_table = reinterpret_cast<u16*>(disc_info.data() + WII_DISC_HEADER_SIZE);
+  const u64 num_blocks = blocks.GetNumBlocks();
+  const u64 progress_monitor = std::max<u64>(1, num_blocks / 1000);
+  u16 num_sectors = 1;
+  bool success = true;
+
+  u64 index;
+  while (const u8* data = blocks.GetNextBlock(&index))
+  {
+    if (callback && num_sectors % progress_monitor == 0)
+    {
+      const std::string text = StringFromFormat(
+          GetStringT("Block %i of %i. %i blocks stored.").c_str(), static_cast<int>(index),
+          static_cast<int>(num_blocks), num_sectors - 1);
+      if (!callback(text, static_cast<float>(index) / num_blocks, arg))
+      {
+        success = false;
+        break;
+      }
+    }
+
+    if (!outfile.WriteBytes(data, WBFS_SECTOR_SIZE))
+    {
+      PanicAlertT("Failed to write the output file \"%s\".\n"
+                  "Check that you have enough space available on the target drive.",
+                  outfile_path.c_str());
+      success = false;
+      break;
+    }
+
+    wlba_table[index] = Common::swap16(num_sectors++);
+  }
+
+  if (success && blocks.ReadFailed())
+  {
+    PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+    success = false;
+  }
+
+  WbfsHeader header = {};
+  header.magic = WBFS_MAGIC;
+  header.hd_sector_count =
+      Common::swap32(static_cast<u32>(num_sectors) << (WBFS_SECTOR_SHIFT - HD_SECTOR_SHIFT));
+  header.hd_sector_shift = HD_SECTOR_SHIFT;
+  header.wbfs_sector_shift = WBFS_SECTOR_SHIFT;
+  header.disc_table[0] = 1;
+
+  if (!success || !outfile.Seek(0, SEEK_SET) || !outfile.WriteArray(&header, 1) ||
+      !outfile.Seek(1 << HD_SECTOR_SHIFT, SEEK_SET) ||
+      !outfile.WriteBytes(disc_info.data(), disc_info.size()))
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  if (callback)
+    callback(GetStringT("Done converting disc image."), 1.0f, arg);
+  return true;
+}
+
 }  // namespace
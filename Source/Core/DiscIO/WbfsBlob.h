@@ -16,6 +16,18 @@ namespace DiscIO
 {
 static constexpr u32 WBFS_MAGIC = 0x53464257;  // "WBFS" (byteswapped to little endian)
 
+#pragma pack(1)
+struct WbfsHeader
+{
+  u32 magic;
+  u32 hd_sector_count;
+  u8 hd_sector_shift;
+  u8 wbfs_sector_shift;
+  u8 padding[2];
+  u8 disc_table[500];
+};
+#pragma pack()
+
 class WbfsFileReader : public BlobReader
 {
 public:
@@ -62,17 +74,7 @@ private:
   u64 m_wbfs_sector_count;
   u64 m_disc_info_size;
 
-#pragma pack(1)
-  struct WbfsHeader
-  {
-    u32 magic;
-    u32 hd_sector_count;
-    u8 hd_sector_shift;
-    u8 wbfs_sector_shift;
-    u8 padding[2];
-    u8 disc_table[500];
-  } m_header;
-#pragma pack()
+  WbfsHeader m_header;
 
   std::vector<u16> m_wlba_table;
   u64 m_blocks_per_disc;
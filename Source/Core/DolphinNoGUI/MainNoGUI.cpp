@@ -20,11 +20,14 @@
 #include "Core/Analytics.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/STM/STM.h"
+#include "Core/Movie.h"
 #include "Core/State.h"
 
 #include "UICommon/CommandLineParse.h"
@@ -38,6 +41,14 @@ static bool rendererIsFullscreen = false;
 static Common::Flag s_running{true};
 static Common::Flag s_shutdown_requested{false};
 static Common::Flag s_tried_graceful_shutdown{false};
+static bool s_exit_at_movie_end = false;
+
+// Stops once the movie that was passed on the command line has been played back.
+static void CheckMovieEnd()
+{
+  if (s_exit_at_movie_end && !Movie::IsPlayingInput())
+    s_running.Clear();
+}
 
 static void signal_handler(int)
 {
@@ -63,6 +74,7 @@ public:
     while (s_running.IsSet())
     {
       Core::HostDispatchJobs();
+      CheckMovieEnd();
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
   }
@@ -214,6 +226,7 @@ class PlatformX11 : public Platform
     // The actual loop
     while (s_running.IsSet())
     {
+      CheckMovieEnd();
       if (s_shutdown_requested.TestAndClear())
       {
         const auto ios = IOS::HLE::GetIOS();
@@ -357,6 +370,31 @@ static Platform* GetPlatform()
 int main(int argc, char* argv[])
 {
   auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
+  parser->add_option("--frame-stats")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write the host and GPU time and the statistics of every frame to a CSV file");
+  parser->add_option("--fifo-playbacks")
+      .action("store")
+      .metavar("<count>")
+      .type("int")
+      .help("Play back a FIFO log this many times, then exit");
+  parser->add_option("--turbo")
+      .action("store_true")
+      .help("Run as fast as possible without video or audio output, and exit at the end of the "
+            "movie given with --movie");
+  parser->add_option("--ram-hashes")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write a hash of emulated RAM to a file at the end of every VI field");
+  parser->add_option("--hash-interval")
+      .action("store")
+      .metavar("<fields>")
+      .type("int")
+      .set_default(1)
+      .help("Only write a RAM hash every this many fields");
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
@@ -392,6 +430,42 @@ int main(int argc, char* argv[])
   UICommon::SetUserDirectory(user_directory);
   UICommon::Init();
 
+  if (options.is_set("jit_warmup"))
+    SConfig::GetInstance().m_strJITWarmupList = static_cast<const char*>(options.get("jit_warmup"));
+
+  // Together, these replay a FIFO log a fixed number of times as a benchmark.
+  if (options.is_set("frame_stats"))
+  {
+    Config::SetBase(Config::GFX_FRAME_STATS_LOG_PATH,
+                    std::string(static_cast<const char*>(options.get("frame_stats"))));
+  }
+  if (options.is_set("fifo_playbacks"))
+    FifoPlayer::GetInstance().SetPlaybackCount(static_cast<int>(options.get("fifo_playbacks")));
+
+  // Together, these check a movie for desyncs as quickly as possible: the RAM hashes of two
+  // runs can be compared to find the field where they first differ.
+  if (options.get("turbo"))
+  {
+    SConfig::GetInstance().m_EmulationSpeed = 0.0f;
+    SConfig::GetInstance().m_strVideoBackend = "Null";
+    SConfig::GetInstance().sBackend = BACKEND_NULLSOUND;
+  }
+  if (options.is_set("ram_hashes"))
+  {
+    Movie::SetRAMHashLog(static_cast<const char*>(options.get("ram_hashes")),
+                         static_cast<u32>(static_cast<int>(options.get("hash_interval"))));
+  }
+  if (options.is_set("movie"))
+  {
+    const std::string movie_path = static_cast<const char*>(options.get("movie"));
+    if (!Movie::PlayInput(movie_path))
+    {
+      fprintf(stderr, "Could not play %s\n", movie_path.c_str());
+      return 1;
+    }
+    s_exit_at_movie_end = options.get("turbo");
+  }
+
   Core::SetOnStoppedCallback([]() { s_running.Clear(); });
   platform->Init();
 
@@ -41,6 +41,8 @@ void AdvancedWidget::CreateWidgets()
 
   m_enable_wireframe = new GraphicsBool(tr("Enable Wireframe"), Config::GFX_ENABLE_WIREFRAME);
   m_show_statistics = new GraphicsBool(tr("Show Statistics"), Config::GFX_OVERLAY_STATS);
+  m_show_stage_timings =
+      new GraphicsBool(tr("Show Stage Timings"), Config::GFX_OVERLAY_STAGE_TIMINGS);
   m_enable_format_overlay =
       new GraphicsBool(tr("Texture Format Overlay"), Config::GFX_TEXFMT_OVERLAY_ENABLE);
   m_enable_api_validation =
@@ -50,6 +52,7 @@ void AdvancedWidget::CreateWidgets()
   debugging_layout->addWidget(m_show_statistics, 0, 1);
   debugging_layout->addWidget(m_enable_format_overlay, 1, 0);
   debugging_layout->addWidget(m_enable_api_validation, 1, 1);
+  debugging_layout->addWidget(m_show_stage_timings, 2, 0);
 
   // Utility
   auto* utility_box = new QGroupBox(tr("Utility"));
@@ -60,6 +63,8 @@ void AdvancedWidget::CreateWidgets()
   m_load_custom_textures = new GraphicsBool(tr("Load Custom Textures"), Config::GFX_HIRES_TEXTURES);
   m_prefetch_custom_textures =
       new GraphicsBool(tr("Prefetch Custom Textures"), Config::GFX_CACHE_HIRES_TEXTURES);
+  m_async_custom_textures =
+      new GraphicsBool(tr("Load Custom Textures Asynchronously"), Config::GFX_ASYNC_HIRES_TEXTURES);
   m_use_fullres_framedumps = new GraphicsBool(tr("Full Resolution Frame Dumps"),
                                               Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
   m_dump_efb_target = new GraphicsBool(tr("Dump EFB Target"), Config::GFX_DUMP_EFB_TARGET);
@@ -72,8 +77,9 @@ void AdvancedWidget::CreateWidgets()
   utility_layout->addWidget(m_use_fullres_framedumps, 1, 1);
   utility_layout->addWidget(m_dump_efb_target, 2, 0);
   utility_layout->addWidget(m_enable_freelook, 2, 1);
+  utility_layout->addWidget(m_async_custom_textures, 3, 0);
 #if defined(HAVE_FFMPEG)
-  utility_layout->addWidget(m_dump_use_ffv1, 3, -1);
+  utility_layout->addWidget(m_dump_use_ffv1, 4, -1);
 #endif
 
   // Misc.
@@ -110,12 +116,14 @@ void AdvancedWidget::ConnectWidgets()
 void AdvancedWidget::LoadSettings()
 {
   m_prefetch_custom_textures->setEnabled(Config::Get(Config::GFX_HIRES_TEXTURES));
+  m_async_custom_textures->setEnabled(Config::Get(Config::GFX_HIRES_TEXTURES));
 }
 
 void AdvancedWidget::SaveSettings()
 {
   const auto hires_enabled = Config::Get(Config::GFX_HIRES_TEXTURES);
   m_prefetch_custom_textures->setEnabled(hires_enabled);
+  m_async_custom_textures->setEnabled(hires_enabled);
 }
 
 void AdvancedWidget::OnBackendChanged()
@@ -135,6 +143,10 @@ void AdvancedWidget::AddDescriptions()
       QT_TR_NOOP("Render the scene as a wireframe.\n\nIf unsure, leave this unchecked.");
   static const char* TR_SHOW_STATS_DESCRIPTION =
       QT_TR_NOOP("Show various rendering statistics.\n\nIf unsure, leave this unchecked.");
+  static const char* TR_SHOW_STAGE_TIMINGS_DESCRIPTION = QT_TR_NOOP(
+      "Show how long the CPU emulation, FIFO processing, vertex loading, texture decoding, shader "
+      "compilation, command submission and presentation took in recent frames, to find out what "
+      "limits the frame rate.\n\nIf unsure, leave this unchecked.");
   static const char* TR_TEXTURE_FORMAT_DECRIPTION =
       QT_TR_NOOP("Modify textures to show the format they're encoded in. Needs an emulation reset "
                  "in most cases.\n\nIf unsure, leave this unchecked.");
@@ -150,6 +162,10 @@ void AdvancedWidget::AddDescriptions()
   static const char* TR_CACHE_CUSTOM_TEXTURE_DESCRIPTION =
       QT_TR_NOOP("Cache custom textures to system RAM on startup.\nThis can require exponentially "
                  "more RAM but fixes possible stuttering.\n\nIf unsure, leave this unchecked.");
+  static const char* TR_ASYNC_CUSTOM_TEXTURE_DESCRIPTION = QT_TR_NOOP(
+      "Load custom textures on a separate thread, and show the original textures until they are "
+      "ready.\nThis prevents stuttering when a custom texture is used for the first time, and "
+      "only keeps as many custom textures in RAM as fit.\n\nIf unsure, leave this unchecked.");
   static const char* TR_DUMP_EFB_DESCRIPTION =
       QT_TR_NOOP("Dump the contents of EFB copies to User/Dump/Textures/.\n\nIf unsure, leave this "
                  "unchecked.");
@@ -189,11 +205,13 @@ void AdvancedWidget::AddDescriptions()
 
   AddDescription(m_enable_wireframe, TR_WIREFRAME_DESCRIPTION);
   AddDescription(m_show_statistics, TR_SHOW_STATS_DESCRIPTION);
+  AddDescription(m_show_stage_timings, TR_SHOW_STAGE_TIMINGS_DESCRIPTION);
   AddDescription(m_enable_format_overlay, TR_TEXTURE_FORMAT_DECRIPTION);
   AddDescription(m_enable_api_validation, TR_VALIDATION_LAYER_DESCRIPTION);
   AddDescription(m_dump_textures, TR_DUMP_TEXTURE_DESCRIPTION);
   AddDescription(m_load_custom_textures, TR_LOAD_CUSTOM_TEXTURE_DESCRIPTION);
   AddDescription(m_prefetch_custom_textures, TR_CACHE_CUSTOM_TEXTURE_DESCRIPTION);
+  AddDescription(m_async_custom_textures, TR_ASYNC_CUSTOM_TEXTURE_DESCRIPTION);
   AddDescription(m_dump_efb_target, TR_DUMP_EFB_DESCRIPTION);
   AddDescription(m_use_fullres_framedumps, TR_INTERNAL_RESOLUTION_FRAME_DUMPING_DESCRIPTION);
 #ifdef HAVE_FFMPEG
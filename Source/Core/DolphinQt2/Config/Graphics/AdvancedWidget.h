@@ -28,12 +28,14 @@ private:
   // Debugging
   QCheckBox* m_enable_wireframe;
   QCheckBox* m_show_statistics;
+  QCheckBox* m_show_stage_timings;
   QCheckBox* m_enable_format_overlay;
   QCheckBox* m_enable_api_validation;
 
   // Utility
   QCheckBox* m_dump_textures;
   QCheckBox* m_prefetch_custom_textures;
+  QCheckBox* m_async_custom_textures;
   QCheckBox* m_dump_efb_target;
   QCheckBox* m_dump_use_ffv1;
   QCheckBox* m_load_custom_textures;
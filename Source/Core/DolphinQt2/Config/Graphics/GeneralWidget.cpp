@@ -94,6 +94,7 @@ void GeneralWidget::CreateWidgets()
   m_autoadjust_window_size = new QCheckBox(tr("Auto-Adjust Window Size"));
   m_show_messages =
       new GraphicsBool(tr("Show NetPlay Messages"), Config::GFX_SHOW_NETPLAY_MESSAGES);
+  m_show_audio_stats = new GraphicsBool(tr("Show Audio Statistics"), Config::GFX_SHOW_AUDIO_STATS);
   m_keep_window_top = new QCheckBox(tr("Keep Window on Top"));
   m_hide_cursor = new QCheckBox(tr("Hide Mouse Cursor"));
   m_render_main_window = new QCheckBox(tr("Render to Main Window"));
@@ -112,6 +113,8 @@ void GeneralWidget::CreateWidgets()
   m_options_layout->addWidget(m_hide_cursor, 3, 0);
   m_options_layout->addWidget(m_render_main_window, 3, 1);
 
+  m_options_layout->addWidget(m_show_audio_stats, 4, 0);
+
   main_layout->addWidget(m_video_box);
   main_layout->addWidget(m_options_box);
 
@@ -286,6 +289,9 @@ void GeneralWidget::AddDescriptions()
   static const char* TR_SHOW_NETPLAY_PING_DESCRIPTION =
       QT_TR_NOOP("Show the players' maximum Ping while playing on "
                  "NetPlay.\n\nIf unsure, leave this unchecked.");
+  static const char* TR_SHOW_AUDIO_STATS_DESCRIPTION =
+      QT_TR_NOOP("Show how full the audio buffer is, the audio latency and how many times the "
+                 "buffer ran empty.\n\nIf unsure, leave this unchecked.");
   static const char* TR_LOG_RENDERTIME_DESCRIPTION =
       QT_TR_NOOP("Log the render time of every frame to User/Logs/render_time.txt. Use this "
                  "feature when you want to measure the performance of Dolphin.\n\nIf "
@@ -307,6 +313,7 @@ void GeneralWidget::AddDescriptions()
   AddDescription(m_enable_vsync, TR_VSYNC_DESCRIPTION);
   AddDescription(m_show_fps, TR_SHOW_FPS_DESCRIPTION);
   AddDescription(m_show_ping, TR_SHOW_NETPLAY_PING_DESCRIPTION);
+  AddDescription(m_show_audio_stats, TR_SHOW_AUDIO_STATS_DESCRIPTION);
   AddDescription(m_log_render_time, TR_LOG_RENDERTIME_DESCRIPTION);
   AddDescription(m_show_messages, TR_SHOW_FPS_DESCRIPTION);
   AddDescription(m_keep_window_top, TR_KEEP_WINDOW_ON_TOP_DESCRIPTION);
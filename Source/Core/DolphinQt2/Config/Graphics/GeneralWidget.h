@@ -50,6 +50,7 @@ private:
   QCheckBox* m_log_render_time;
   QCheckBox* m_autoadjust_window_size;
   QCheckBox* m_show_messages;
+  QCheckBox* m_show_audio_stats;
   QCheckBox* m_keep_window_top;
   QCheckBox* m_hide_cursor;
   QCheckBox* m_render_main_window;
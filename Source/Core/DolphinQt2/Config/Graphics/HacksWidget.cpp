@@ -34,14 +34,20 @@ void HacksWidget::CreateWidgets()
   efb_box->setLayout(efb_layout);
   m_skip_efb_cpu =
       new GraphicsBool(tr("Skip EFB Access from CPU"), Config::GFX_HACK_EFB_ACCESS_ENABLE, true);
+  m_defer_efb_invalidation = new GraphicsBool(tr("Defer EFB Cache Invalidation"),
+                                              Config::GFX_HACK_EFB_DEFER_INVALIDATION);
   m_ignore_format_changes = new GraphicsBool(tr("Ignore Format Changes"),
                                              Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES, true);
   m_store_efb_copies = new GraphicsBool(tr("Store EFB Copies to Texture Only"),
                                         Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
+  m_defer_efb_copies =
+      new GraphicsBool(tr("Defer EFB Copies to RAM"), Config::GFX_HACK_DEFER_EFB_COPIES);
 
   efb_layout->addWidget(m_skip_efb_cpu, 0, 0);
   efb_layout->addWidget(m_ignore_format_changes, 0, 1);
   efb_layout->addWidget(m_store_efb_copies, 1, 0);
+  efb_layout->addWidget(m_defer_efb_copies, 1, 1);
+  efb_layout->addWidget(m_defer_efb_invalidation, 2, 0);
 
   // Texture Cache
   auto* texture_cache_box = new QGroupBox(tr("Texture Cache"));
@@ -164,6 +170,10 @@ void HacksWidget::AddDescriptions()
       QT_TR_NOOP("Ignore any requests from the CPU to read from or write to the EFB.\nImproves "
                  "performance in some games, but might disable some gameplay-related features or "
                  "graphical effects.\n\nIf unsure, leave this unchecked.");
+  static const char* TR_DEFER_EFB_INVALIDATION_DESCRIPTION = QT_TR_NOOP(
+      "Keeps the results of EFB reads from the CPU until the end of the frame, instead of reading "
+      "the EFB again after every draw.\nImproves performance in games which read the EFB a lot, "
+      "but may return outdated values in a few others.\n\nIf unsure, leave this unchecked.");
   static const char* TR_IGNORE_FORMAT_CHANGE_DESCRIPTION = QT_TR_NOOP(
       "Ignore any changes to the EFB format.\nImproves performance in many games without "
       "any negative effect. Causes graphical defects in a small number of other "
@@ -173,6 +183,9 @@ void HacksWidget::AddDescriptions()
       "in a small number of games.\n\nEnabled = EFB Copies to Texture\nDisabled = EFB Copies to "
       "RAM "
       "(and Texture)\n\nIf unsure, leave this checked.");
+  static const char* TR_DEFER_EFB_COPIES_DESCRIPTION = QT_TR_NOOP(
+      "Writes EFB Copies to RAM once the game needs them, instead of waiting for the GPU after "
+      "every copy. Only works in Direct3D 11 and Vulkan.\n\nIf unsure, leave this checked.");
   static const char* TR_ACCUARCY_DESCRIPTION = QT_TR_NOOP(
       "The \"Safe\" setting eliminates the likelihood of the GPU missing texture updates "
       "from RAM.\nLower accuracies cause in-game text to appear garbled in certain "
@@ -211,8 +224,10 @@ void HacksWidget::AddDescriptions()
                  "resolution is used.\n\nIf unsure, leave this unchecked.");
 
   AddDescription(m_skip_efb_cpu, TR_SKIP_EFB_CPU_ACCESS_DESCRIPTION);
+  AddDescription(m_defer_efb_invalidation, TR_DEFER_EFB_INVALIDATION_DESCRIPTION);
   AddDescription(m_ignore_format_changes, TR_IGNORE_FORMAT_CHANGE_DESCRIPTION);
   AddDescription(m_store_efb_copies, TR_STORE_EFB_TO_TEXTURE_DESCRIPTION);
+  AddDescription(m_defer_efb_copies, TR_DEFER_EFB_COPIES_DESCRIPTION);
   AddDescription(m_accuracy, TR_ACCUARCY_DESCRIPTION);
   AddDescription(m_disable_xfb, TR_DISABLE_XFB_DESCRIPTION);
   AddDescription(m_virtual_xfb, TR_VIRTUAL_XFB_DESCRIPTION);
@@ -25,8 +25,10 @@ private:
 
   // EFB
   QCheckBox* m_skip_efb_cpu;
+  QCheckBox* m_defer_efb_invalidation;
   QCheckBox* m_ignore_format_changes;
   QCheckBox* m_store_efb_copies;
+  QCheckBox* m_defer_efb_copies;
 
   // Texture Cache
   QSlider* m_accuracy;
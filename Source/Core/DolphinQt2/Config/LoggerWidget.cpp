@@ -168,6 +168,7 @@ void LoggerWidget::CreateWidgets()
   m_out_file = new QCheckBox(tr("Write to File"));
   m_out_console = new QCheckBox(tr("Write to Console"));
   m_out_window = new QCheckBox(tr("Write to Window"));
+  m_out_async = new QCheckBox(tr("Write Asynchronously"));
 
   auto* config_types = new QGroupBox(tr("Log Types"));
   auto* types_layout = new QVBoxLayout;
@@ -193,6 +194,7 @@ void LoggerWidget::CreateWidgets()
   outputs_layout->addWidget(m_out_file);
   outputs_layout->addWidget(m_out_console);
   outputs_layout->addWidget(m_out_window);
+  outputs_layout->addWidget(m_out_async);
 
   config_layout->addWidget(config_types);
   types_layout->addWidget(m_types_toggle);
@@ -221,6 +223,7 @@ void LoggerWidget::ConnectWidgets()
   connect(m_out_file, &QCheckBox::toggled, this, &LoggerWidget::SaveSettings);
   connect(m_out_console, &QCheckBox::toggled, this, &LoggerWidget::SaveSettings);
   connect(m_out_window, &QCheckBox::toggled, this, &LoggerWidget::SaveSettings);
+  connect(m_out_async, &QCheckBox::toggled, this, &LoggerWidget::SaveSettings);
 
   connect(m_types_toggle, &QPushButton::clicked, [this] {
     m_all_enabled = !m_all_enabled;
@@ -264,6 +267,7 @@ void LoggerWidget::LoadSettings()
   m_out_file->setChecked(logmanager->IsListenerEnabled(LogListener::FILE_LISTENER));
   m_out_console->setChecked(logmanager->IsListenerEnabled(LogListener::CONSOLE_LISTENER));
   m_out_window->setChecked(logmanager->IsListenerEnabled(LogListener::LOG_WINDOW_LISTENER));
+  m_out_async->setChecked(logmanager->IsAsync());
 
   // Config - Log Types
   for (int i = 0; i < LogTypes::NUMBER_OF_LOGS; ++i)
@@ -317,6 +321,7 @@ void LoggerWidget::SaveSettings()
                                             m_out_console->isChecked());
   LogManager::GetInstance()->EnableListener(LogListener::LOG_WINDOW_LISTENER,
                                             m_out_window->isChecked());
+  LogManager::GetInstance()->SetAsync(m_out_async->isChecked());
   // Config - Log Types
   for (int i = 0; i < LogTypes::NUMBER_OF_LOGS; ++i)
   {
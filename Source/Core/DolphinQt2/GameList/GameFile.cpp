@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <memory>
+
 #include <QCryptographicHash>
 #include <QDataStream>
 #include <QDir>
@@ -85,7 +87,12 @@ QString GameFile::GetCacheFileName() const
   return folder + m_file_name + hash;
 }
 
-void GameFile::ReadBanner(const DiscIO::Volume& volume)
+QString GameFile::GetBannerCacheFileName() const
+{
+  return GetCacheFileName() + QStringLiteral(".png");
+}
+
+QImage GameFile::ReadBanner(const DiscIO::Volume& volume)
 {
   int width, height;
   std::vector<u32> buffer = volume.GetBanner(&width, &height);
@@ -96,11 +103,42 @@ void GameFile::ReadBanner(const DiscIO::Volume& volume)
     banner.setPixel(x, y, qRgb((buffer[i] & 0xFF0000) >> 16, (buffer[i] & 0x00FF00) >> 8,
                                (buffer[i] & 0x0000FF) >> 0));
   }
+  return banner;
+}
 
+QImage GameFile::LoadBanner() const
+{
+  if (m_platform == DiscIO::Platform::ELF_DOL)
+    return QImage();
+
+  const QString cache_path = GetBannerCacheFileName();
+  const QFileInfo cache_info(cache_path);
+  if (cache_info.exists() && cache_info.lastModified() >= m_last_modified)
+  {
+    QImage banner;
+    if (banner.load(cache_path, "PNG"))
+      return banner;
+  }
+
+  std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolumeFromFilename(m_path.toStdString()));
+  if (!volume)
+    return QImage();
+
+  const QImage banner = ReadBanner(*volume);
   if (!banner.isNull())
-    m_banner = QPixmap::fromImage(banner);
-  else
-    m_banner = Resources::GetMisc(Resources::BANNER_MISSING);
+  {
+    File::CreateFullPath(cache_path.toStdString());
+    banner.save(cache_path, "PNG");
+  }
+  return banner;
+}
+
+QPixmap GameFile::GetBanner() const
+{
+  const QImage banner = LoadBanner();
+  if (banner.isNull())
+    return Resources::GetMisc(Resources::BANNER_MISSING);
+  return QPixmap::fromImage(banner);
 }
 
 bool GameFile::LoadFileInfo(const QString& path)
@@ -180,8 +218,6 @@ bool GameFile::TryLoadVolume()
   m_raw_size = volume->GetRawSize();
   m_apploader_date = QString::fromStdString(volume->GetApploaderDate());
 
-  ReadBanner(*volume);
-
   SaveCache();
   return true;
 }
@@ -197,7 +233,6 @@ bool GameFile::TryLoadElfDol()
   m_country = DiscIO::Country::COUNTRY_UNKNOWN;
   m_blob_type = DiscIO::BlobType::DIRECTORY;
   m_raw_size = m_size;
-  m_banner = Resources::GetMisc(Resources::BANNER_MISSING);
   m_rating = 0;
 
   return true;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <QDateTime>
+#include <QImage>
 #include <QMap>
 #include <QPixmap>
 #include <QString>
@@ -44,7 +45,11 @@ public:
   QString GetUniqueID() const;
   u8 GetDiscNumber() const { return m_disc_number; }
   u64 GetRawSize() const { return m_raw_size; }
-  QPixmap GetBanner() const { return m_banner; }
+  // Banners aren't kept in memory, because most of them are never shown. LoadBanner reads the
+  // banner from a cache on disk or from the volume, so it can be called from any thread. The
+  // image is null if the game has no banner.
+  QImage LoadBanner() const;
+  QPixmap GetBanner() const;
   QString GetIssues() const { return m_issues; }
   int GetRating() const { return m_rating; }
   QString GetApploaderDate() const { return m_apploader_date; }
@@ -77,7 +82,8 @@ private:
   QString GetBannerString(const QMap<DiscIO::Language, QString>& m) const;
 
   QString GetCacheFileName() const;
-  void ReadBanner(const DiscIO::Volume& volume);
+  QString GetBannerCacheFileName() const;
+  static QImage ReadBanner(const DiscIO::Volume& volume);
   bool LoadFileInfo(const QString& path);
   void LoadState();
   bool IsElfOrDol();
@@ -112,7 +118,6 @@ private:
   DiscIO::Country m_country;
   DiscIO::BlobType m_blob_type;
   u64 m_raw_size = 0;
-  QPixmap m_banner;
   QString m_issues;
   int m_rating = 0;
   QString m_apploader_date;
@@ -3,15 +3,44 @@
 // Refer to the license.txt file included.
 
 #include "DolphinQt2/GameList/GameListModel.h"
+
+#include <QRunnable>
+
 #include "Core/ConfigManager.h"
 #include "DiscIO/Enums.h"
 #include "DolphinQt2/Resources.h"
 #include "DolphinQt2/Settings.h"
 
 const QSize GAMECUBE_BANNER_SIZE(96, 32);
+// The number of banners kept in memory. This is a few screens' worth of the grid view.
+constexpr int MAX_CACHED_BANNERS = 512;
+
+namespace
+{
+class LoadBannerTask final : public QRunnable
+{
+public:
+  LoadBannerTask(GameListModel* model, QSharedPointer<GameFile> game)
+      : m_model(model), m_game(std::move(game))
+  {
+  }
+
+  void run() override { emit m_model->BannerLoaded(m_game->GetFilePath(), m_game->LoadBanner()); }
+
+private:
+  GameListModel* m_model;
+  QSharedPointer<GameFile> m_game;
+};
+}  // namespace
 
 GameListModel::GameListModel(QObject* parent) : QAbstractTableModel(parent)
 {
+  m_banners.setMaxCost(MAX_CACHED_BANNERS);
+  // Loading a banner mostly waits for the disc image to be read.
+  m_banner_pool.setMaxThreadCount(2);
+  connect(this, &GameListModel::BannerLoaded, this, &GameListModel::OnBannerLoaded,
+          Qt::QueuedConnection);
+
   connect(&m_tracker, &GameTracker::GameLoaded, this, &GameListModel::UpdateGame);
   connect(&m_tracker, &GameTracker::GameRemoved, this, &GameListModel::RemoveGame);
   connect(&Settings::Instance(), &Settings::PathAdded, &m_tracker, &GameTracker::AddDirectory);
@@ -60,12 +89,8 @@ QVariant GameListModel::data(const QModelIndex& index, int role) const
   case COL_BANNER:
     if (role == Qt::DecorationRole)
     {
-      // GameCube banners are 96x32, but Wii banners are 192x64.
       // TODO: use custom banners from rom directory like DolphinWX?
-      QPixmap banner = game->GetBanner();
-      banner.setDevicePixelRatio(std::max(banner.width() / GAMECUBE_BANNER_SIZE.width(),
-                                          banner.height() / GAMECUBE_BANNER_SIZE.height()));
-      return banner;
+      return GetBanner(game);
     }
     break;
   case COL_TITLE:
@@ -230,6 +255,7 @@ void GameListModel::RemoveGame(const QString& path)
   beginRemoveRows(QModelIndex(), entry, entry);
   m_games.removeAt(entry);
   endRemoveRows();
+  m_banners.remove(path);
 }
 
 int GameListModel::FindGame(const QString& path) const
@@ -241,3 +267,35 @@ int GameListModel::FindGame(const QString& path) const
   }
   return -1;
 }
+
+QPixmap GameListModel::GetBanner(const QSharedPointer<GameFile>& game) const
+{
+  const QString path = game->GetFilePath();
+  if (const QPixmap* banner = m_banners.object(path))
+    return *banner;
+
+  if (!m_loading_banners.contains(path))
+  {
+    m_loading_banners.insert(path);
+    m_banner_pool.start(new LoadBannerTask(const_cast<GameListModel*>(this), game));
+  }
+  return QPixmap();
+}
+
+void GameListModel::OnBannerLoaded(const QString& path, const QImage& image)
+{
+  m_loading_banners.remove(path);
+  const int entry = FindGame(path);
+  if (entry < 0)
+    return;
+
+  QPixmap banner = image.isNull() ? Resources::GetMisc(Resources::BANNER_MISSING) :
+                                    QPixmap::fromImage(image);
+  // GameCube banners are 96x32, but Wii banners are 192x64.
+  banner.setDevicePixelRatio(std::max(banner.width() / GAMECUBE_BANNER_SIZE.width(),
+                                      banner.height() / GAMECUBE_BANNER_SIZE.height()));
+  m_banners.insert(path, new QPixmap(std::move(banner)));
+
+  // The grid view shows the banner in the first column.
+  emit dataChanged(index(entry, 0), index(entry, COL_BANNER), {Qt::DecorationRole});
+}
@@ -5,7 +5,12 @@
 #pragma once
 
 #include <QAbstractTableModel>
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
 #include <QString>
+#include <QThreadPool>
 
 #include "Core/TitleDatabase.h"
 #include "DolphinQt2/GameList/GameFile.h"
@@ -48,11 +53,25 @@ public:
   void UpdateGame(QSharedPointer<GameFile> game);
   void RemoveGame(const QString& path);
 
+signals:
+  // Emitted from the thread which loaded the banner.
+  void BannerLoaded(const QString& path, const QImage& banner);
+
 private:
   // Index in m_games, or -1 if it isn't found
   int FindGame(const QString& path) const;
 
+  // Returns the banner if it has been loaded, or starts loading it in the background.
+  QPixmap GetBanner(const QSharedPointer<GameFile>& game) const;
+  void OnBannerLoaded(const QString& path, const QImage& banner);
+
   GameTracker m_tracker;
   QList<QSharedPointer<GameFile>> m_games;
   Core::TitleDatabase m_title_database;
+
+  // Banners are only loaded once a view asks for them, and only the recently shown ones are kept.
+  mutable QCache<QString, QPixmap> m_banners;
+  mutable QSet<QString> m_loading_banners;
+  // Declared last, so that it waits for the loads to finish before the rest is destroyed.
+  mutable QThreadPool m_banner_pool;
 };
@@ -2,9 +2,12 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
+#include <QRunnable>
 
 #include "DiscIO/DirectoryBlob.h"
 #include "DolphinQt2/GameList/GameTracker.h"
@@ -13,7 +16,8 @@
 static const QStringList game_filters{
     QStringLiteral("*.gcm"),  QStringLiteral("*.iso"), QStringLiteral("*.tgc"),
     QStringLiteral("*.ciso"), QStringLiteral("*.gcz"), QStringLiteral("*.wbfs"),
-    QStringLiteral("*.wad"),  QStringLiteral("*.elf"), QStringLiteral("*.dol")};
+    QStringLiteral("*.wcz"),  QStringLiteral("*.wad"), QStringLiteral("*.elf"),
+    QStringLiteral("*.dol")};
 
 GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 {
@@ -136,12 +140,40 @@ void GameTracker::UpdateFile(const QString& file)
   }
 }
 
-void GameLoader::LoadGame(const QString& path)
+namespace
 {
-  if (!DiscIO::ShouldHideFromGameList(path.toStdString()))
+class LoadGameTask final : public QRunnable
+{
+public:
+  LoadGameTask(GameLoader* loader, const QString& path) : m_loader(loader), m_path(path) {}
+
+  void run() override
   {
-    auto game = QSharedPointer<GameFile>::create(path);
+    auto game = QSharedPointer<GameFile>::create(m_path);
     if (game->IsValid())
-      emit GameLoaded(game);
+      emit m_loader->GameLoaded(game);
   }
+
+private:
+  GameLoader* m_loader;
+  QString m_path;
+};
+}  // namespace
+
+GameLoader::GameLoader()
+{
+  // Even hosts with few cores benefit from waiting on several files at once, especially when the
+  // files are on a network share.
+  m_pool.setMaxThreadCount(std::max(QThread::idealThreadCount(), 4));
+}
+
+GameLoader::~GameLoader()
+{
+  m_pool.waitForDone();
+}
+
+void GameLoader::LoadGame(const QString& path)
+{
+  if (!DiscIO::ShouldHideFromGameList(path.toStdString()))
+    m_pool.start(new LoadGameTask(this, path));
 }
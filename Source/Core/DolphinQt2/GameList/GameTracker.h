@@ -11,6 +11,7 @@
 #include <QString>
 #include <QStringList>
 #include <QThread>
+#include <QThreadPool>
 
 #include "DolphinQt2/GameList/GameFile.h"
 
@@ -49,15 +50,22 @@ private:
   GameLoader* m_loader;
 };
 
+// Loads several games at once, since loading mostly waits for the files to be read.
 class GameLoader final : public QObject
 {
   Q_OBJECT
 
 public:
+  GameLoader();
+  ~GameLoader();
+
   void LoadGame(const QString& path);
 
 signals:
   void GameLoaded(QSharedPointer<GameFile> game);
+
+private:
+  QThreadPool m_pool;
 };
 
 Q_DECLARE_METATYPE(QSharedPointer<GameFile>)
@@ -8,9 +8,11 @@
 #include "DolphinQt2/GameList/GridProxyModel.h"
 
 const QSize LARGE_BANNER_SIZE(144, 48);
+constexpr int MAX_SCALED_BANNERS = 512;
 
 GridProxyModel::GridProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
+  m_scaled_banners.setMaxCost(MAX_SCALED_BANNERS);
   setSortCaseSensitivity(Qt::CaseInsensitive);
   sort(GameListModel::COL_TITLE);
 }
@@ -29,8 +31,15 @@ QVariant GridProxyModel::data(const QModelIndex& i, int role) const
                       ->data(sourceModel()->index(source_index.row(), GameListModel::COL_BANNER),
                              Qt::DecorationRole)
                       .value<QPixmap>();
-    return pixmap.scaled(LARGE_BANNER_SIZE * pixmap.devicePixelRatio(), Qt::KeepAspectRatio,
-                         Qt::SmoothTransformation);
+    if (pixmap.isNull())
+      return pixmap;
+
+    if (const QPixmap* scaled = m_scaled_banners.object(pixmap.cacheKey()))
+      return *scaled;
+    QPixmap scaled = pixmap.scaled(LARGE_BANNER_SIZE * pixmap.devicePixelRatio(),
+                                   Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    m_scaled_banners.insert(pixmap.cacheKey(), new QPixmap(scaled));
+    return scaled;
   }
   return QVariant();
 }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <QCache>
+#include <QPixmap>
 #include <QSortFilterProxyModel>
 
 // This subclass of QSortFilterProxyModel transforms the raw data into a
@@ -16,4 +18,8 @@ public:
   explicit GridProxyModel(QObject* parent = nullptr);
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
   bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+
+private:
+  // Scaled banners by the cache key of the original, so that they aren't scaled on every repaint.
+  mutable QCache<qint64, QPixmap> m_scaled_banners;
 };
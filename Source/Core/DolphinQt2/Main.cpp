@@ -11,6 +11,7 @@
 #include "Common/MsgHandler.h"
 #include "Core/Analytics.h"
 #include "Core/BootManager.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "DolphinQt2/Host.h"
 #include "DolphinQt2/InDevelopmentWarning.h"
@@ -69,6 +70,9 @@ int main(int argc, char* argv[])
   UICommon::Init();
   Resources::Init();
 
+  if (options.is_set("jit_warmup"))
+    SConfig::GetInstance().m_strJITWarmupList = static_cast<const char*>(options.get("jit_warmup"));
+
   // Hook up alerts from core
   RegisterMsgAlertHandler(QtMsgAlertHandler);
 
@@ -61,6 +61,7 @@ void NetPlayDialog::CreateMainLayout()
   m_md5_box = new QComboBox;
   m_start_button = new QPushButton(tr("Start"));
   m_buffer_size_box = new QSpinBox;
+  m_auto_buffer_box = new QCheckBox(tr("Auto"));
   m_save_sd_box = new QCheckBox(tr("Write save/SD data"));
   m_load_wii_box = new QCheckBox(tr("Load Wii Save"));
   m_record_input_box = new QCheckBox(tr("Record inputs"));
@@ -84,6 +85,7 @@ void NetPlayDialog::CreateMainLayout()
   options_widget->addWidget(m_start_button);
   options_widget->addWidget(m_buffer_label);
   options_widget->addWidget(m_buffer_size_box);
+  options_widget->addWidget(m_auto_buffer_box);
   options_widget->addWidget(m_save_sd_box);
   options_widget->addWidget(m_load_wii_box);
   options_widget->addWidget(m_record_input_box);
@@ -173,6 +175,10 @@ void NetPlayDialog::ConnectWidgets()
             if (Settings::Instance().GetNetPlayServer() != nullptr)
               Settings::Instance().GetNetPlayServer()->AdjustPadBufferSize(value);
           });
+  connect(m_auto_buffer_box, &QCheckBox::toggled, [](bool checked) {
+    if (Settings::Instance().GetNetPlayServer() != nullptr)
+      Settings::Instance().GetNetPlayServer()->SetAutomaticPadBuffer(checked);
+  });
 
   connect(m_start_button, &QPushButton::clicked, this, &NetPlayDialog::OnStart);
   connect(m_quit_button, &QPushButton::clicked, this, &NetPlayDialog::reject);
@@ -309,6 +315,7 @@ void NetPlayDialog::show(std::string nickname, bool use_traversal)
   m_load_wii_box->setHidden(!is_hosting);
   m_buffer_size_box->setHidden(!is_hosting);
   m_buffer_label->setHidden(!is_hosting);
+  m_auto_buffer_box->setHidden(!is_hosting);
   m_kick_button->setHidden(!is_hosting);
   m_assign_ports_button->setHidden(!is_hosting);
   m_md5_box->setHidden(!is_hosting);
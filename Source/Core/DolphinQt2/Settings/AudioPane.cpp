@@ -69,6 +69,7 @@ void AudioPane::CreateWidgets()
   m_latency_label = new QLabel(tr("Latency:"));
   m_dolby_pro_logic = new QCheckBox(tr("Dolby Pro Logic II decoder"));
   m_latency_spin = new QSpinBox();
+  m_audio_pacing = new QCheckBox(tr("Sync Emulation Speed to Audio"));
 
   m_latency_spin->setMinimum(0);
   m_latency_spin->setMaximum(30);
@@ -80,7 +81,13 @@ void AudioPane::CreateWidgets()
 
   backend_layout->addRow(m_backend_label, m_backend_combo);
   backend_layout->addRow(m_latency_label, m_latency_spin);
+  m_audio_pacing->setToolTip(
+      tr("Runs the emulation as fast as the audio backend plays the audio, and resamples the "
+         "audio slightly to absorb the difference between the clocks. Gives smooth audio with "
+         "low latency on variable refresh rate displays. Has no effect with audio stretching."));
+
   backend_layout->addRow(m_dolby_pro_logic);
+  backend_layout->addRow(m_audio_pacing);
 
   auto* stretching_box = new QGroupBox(tr("Audio Stretching Settings"));
   auto* stretching_layout = new QGridLayout;
@@ -123,6 +130,7 @@ void AudioPane::ConnectWidgets()
           &AudioPane::SaveSettings);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_audio_pacing, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_hle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_lle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
@@ -164,6 +172,9 @@ void AudioPane::LoadSettings()
   // Latency
   m_latency_spin->setValue(SConfig::GetInstance().iLatency);
 
+  // Pacing
+  m_audio_pacing->setChecked(SConfig::GetInstance().m_audio_pacing);
+
   // Stretch
   m_stretching_enable->setChecked(SConfig::GetInstance().m_audio_stretch);
   m_stretching_buffer_slider->setValue(SConfig::GetInstance().m_audio_stretch_max_latency);
@@ -203,6 +214,9 @@ void AudioPane::SaveSettings()
   // Latency
   SConfig::GetInstance().iLatency = m_latency_spin->value();
 
+  // Pacing
+  SConfig::GetInstance().m_audio_pacing = m_audio_pacing->isChecked();
+
   // Stretch
   SConfig::GetInstance().m_audio_stretch = m_stretching_enable->isChecked();
   SConfig::GetInstance().m_audio_stretch_max_latency = m_stretching_buffer_slider->value();
@@ -50,6 +50,7 @@ private:
   QCheckBox* m_dolby_pro_logic;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QCheckBox* m_audio_pacing;
 
   // Audio Stretching
   QCheckBox* m_stretching_enable;
@@ -47,6 +47,7 @@ void AudioConfigPane::InitializeGUI()
   m_audio_latency_spinctrl =
       new wxSpinCtrl(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 0, 200);
   m_audio_latency_label = new wxStaticText(this, wxID_ANY, _("Latency (ms):"));
+  m_pacing_checkbox = new wxCheckBox(this, wxID_ANY, _("Sync Emulation Speed to Audio"));
 
   m_stretch_checkbox = new wxCheckBox(this, wxID_ANY, _("Enable Audio Stretching"));
   m_stretch_label = new wxStaticText(this, wxID_ANY, _("Buffer Size:"));
@@ -58,6 +59,10 @@ void AudioConfigPane::InitializeGUI()
                                          "crackling. Certain backends only."));
   m_dpl2_decoder_checkbox->SetToolTip(
       _("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
+  m_pacing_checkbox->SetToolTip(
+      _("Runs the emulation as fast as the audio backend plays the audio, and resamples the "
+        "audio slightly to absorb the difference between the clocks. Gives smooth audio with "
+        "low latency on variable refresh rate displays. Has no effect with audio stretching."));
   m_stretch_checkbox->SetToolTip(_("Enables stretching of the audio to match emulation speed."));
   m_stretch_slider->SetToolTip(_("Size of stretch buffer in milliseconds. "
                                  "Values too low may cause audio crackling."));
@@ -80,6 +85,8 @@ void AudioConfigPane::InitializeGUI()
                           wxALIGN_CENTER_VERTICAL);
   backend_grid_sizer->Add(m_audio_latency_spinctrl, wxGBPosition(2, 1), wxDefaultSpan,
                           wxALIGN_CENTER_VERTICAL);
+  backend_grid_sizer->Add(m_pacing_checkbox, wxGBPosition(3, 0), wxGBSpan(1, 2),
+                          wxALIGN_CENTER_VERTICAL);
 
   wxStaticBoxSizer* const backend_static_box_sizer =
       new wxStaticBoxSizer(wxVERTICAL, this, _("Backend Settings"));
@@ -140,6 +147,7 @@ void AudioConfigPane::LoadGUIValues()
   m_volume_text->SetLabel(wxString::Format("%d %%", SConfig::GetInstance().m_Volume));
   m_dpl2_decoder_checkbox->SetValue(startup_params.bDPL2Decoder);
   m_audio_latency_spinctrl->SetValue(startup_params.iLatency);
+  m_pacing_checkbox->SetValue(startup_params.m_audio_pacing);
   m_stretch_checkbox->SetValue(startup_params.m_audio_stretch);
   m_stretch_slider->Enable(startup_params.m_audio_stretch);
   m_stretch_slider->SetValue(startup_params.m_audio_stretch_max_latency);
@@ -178,6 +186,8 @@ void AudioConfigPane::BindEvents()
   m_audio_latency_spinctrl->Bind(wxEVT_SPINCTRL, &AudioConfigPane::OnLatencySpinCtrlChanged, this);
   m_audio_latency_spinctrl->Bind(wxEVT_UPDATE_UI, &WxEventUtils::OnEnableIfCoreNotRunning);
 
+  m_pacing_checkbox->Bind(wxEVT_CHECKBOX, &AudioConfigPane::OnPacingCheckBoxChanged, this);
+
   m_stretch_checkbox->Bind(wxEVT_CHECKBOX, &AudioConfigPane::OnStretchCheckBoxChanged, this);
   m_stretch_slider->Bind(wxEVT_SLIDER, &AudioConfigPane::OnStretchSliderChanged, this);
 }
@@ -216,6 +226,11 @@ void AudioConfigPane::OnLatencySpinCtrlChanged(wxCommandEvent& event)
   SConfig::GetInstance().iLatency = m_audio_latency_spinctrl->GetValue();
 }
 
+void AudioConfigPane::OnPacingCheckBoxChanged(wxCommandEvent&)
+{
+  SConfig::GetInstance().m_audio_pacing = m_pacing_checkbox->IsChecked();
+}
+
 void AudioConfigPane::OnStretchCheckBoxChanged(wxCommandEvent& event)
 {
   const bool stretch_enabled = m_stretch_checkbox->GetValue();
@@ -33,6 +33,7 @@ private:
   void OnVolumeSliderChanged(wxCommandEvent&);
   void OnAudioBackendChanged(wxCommandEvent&);
   void OnLatencySpinCtrlChanged(wxCommandEvent&);
+  void OnPacingCheckBoxChanged(wxCommandEvent&);
   void OnStretchCheckBoxChanged(wxCommandEvent&);
   void OnStretchSliderChanged(wxCommandEvent&);
 
@@ -46,6 +47,7 @@ private:
   wxChoice* m_audio_backend_choice;
   wxSpinCtrl* m_audio_latency_spinctrl;
   wxStaticText* m_audio_latency_label;
+  wxCheckBox* m_pacing_checkbox;
   wxCheckBox* m_stretch_checkbox;
   wxStaticText* m_stretch_label;
   DolphinSlider* m_stretch_slider;
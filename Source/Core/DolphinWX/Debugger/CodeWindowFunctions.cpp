@@ -136,6 +136,20 @@ void CCodeWindow::OnProfilerMenu(wxCommandEvent& event)
     Profiler::g_ProfileBlocks = GetParentMenuBar()->IsChecked(IDM_PROFILE_BLOCKS);
     Core::SetState(Core::State::Running);
     break;
+  case IDM_SAMPLE_BLOCKS:
+    Profiler::g_SampleBlocks = GetParentMenuBar()->IsChecked(IDM_SAMPLE_BLOCKS);
+    if (!Core::IsRunning())
+      break;
+
+    Core::SetState(Core::State::Paused);
+    // The blocks need to be recompiled with or without storing their address.
+    JitInterface::ClearCache();
+    if (Profiler::g_SampleBlocks)
+      Profiler::StartSampling();
+    else
+      Profiler::StopSampling();
+    Core::SetState(Core::State::Running);
+    break;
   case IDM_WRITE_PROFILE:
     if (Core::GetState() == Core::State::Running)
       Core::SetState(Core::State::Paused);
@@ -145,6 +159,7 @@ void CCodeWindow::OnProfilerMenu(wxCommandEvent& event)
       std::string filename = File::GetUserPath(D_DUMP_IDX) + "Debug/profiler.txt";
       File::CreateFullPath(filename);
       Profiler::WriteProfileResults(filename);
+      Profiler::WriteCollapsedStacks(File::GetUserPath(D_DUMP_IDX) + "Debug/profiler.folded");
 
       wxFileType* filetype = wxTheMimeTypesManager->GetFileTypeFromExtension("txt");
       if (!filetype)
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -168,6 +169,15 @@ void FifoPlayerDlg::CreateGUIControls()
     m_FramesToRecordCtrl =
         new wxSpinCtrl(m_RecordPage, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize,
                        wxSP_ARROW_KEYS, 0, 10000, m_FramesToRecord);
+    m_CompressFrames = new wxCheckBox(m_RecordPage, wxID_ANY, _("Compress Frames"));
+    m_CompressFrames->SetToolTip(
+        _("Saves every frame compressed. Compressed files are streamed from disk while they are "
+          "played back, so long recordings don't have to fit into memory."));
+    m_RecordToFile = new wxCheckBox(m_RecordPage, wxID_ANY, _("Record to File"));
+    m_RecordToFile->SetToolTip(
+        _("Writes compressed frames to a file while recording instead of keeping them in memory. "
+          "This slows the game down less, and the length of the recording isn't limited by "
+          "memory."));
 
     wxStaticBoxSizer* sRecordInfo =
         new wxStaticBoxSizer(wxVERTICAL, m_RecordPage, _("Recording Info"));
@@ -192,6 +202,11 @@ void FifoPlayerDlg::CreateGUIControls()
     sRecordingOptions->Add(m_FramesToRecordCtrl, 0, wxALIGN_CENTER_VERTICAL | wxTOP | wxBOTTOM,
                            space5);
     sRecordingOptions->AddSpacer(space5);
+    sRecordingOptions->Add(m_CompressFrames, 0, wxALIGN_CENTER_VERTICAL | wxTOP | wxBOTTOM,
+                           space5);
+    sRecordingOptions->AddSpacer(space5);
+    sRecordingOptions->Add(m_RecordToFile, 0, wxALIGN_CENTER_VERTICAL | wxTOP | wxBOTTOM, space5);
+    sRecordingOptions->AddSpacer(space5);
 
     wxBoxSizer* sRecordPage = new wxBoxSizer(wxVERTICAL);
     sRecordPage->Add(sRecordInfo, 0, wxEXPAND);
@@ -382,7 +397,7 @@ void FifoPlayerDlg::OnSaveFile(wxCommandEvent& WXUNUSED(event))
     {
       // Attempt to save the file to the path the user chose
       wxBeginBusyCursor();
-      bool result = file->Save(WxStrToStr(path));
+      bool result = file->Save(WxStrToStr(path), m_CompressFrames->IsChecked());
       wxEndBusyCursor();
 
       // Wasn't able to save the file, shit's whack, yo.
@@ -405,6 +420,20 @@ void FifoPlayerDlg::OnRecordStop(wxCommandEvent& WXUNUSED(event))
     // and change the button label accordingly.
     m_RecordStop->SetLabel(_("Record"));
   }
+  else if (m_RecordToFile->IsChecked())
+  {
+    wxString path = wxSaveFileSelector(_("Dolphin FIFO"), "dff", wxEmptyString, this);
+    if (path.empty())
+      return;
+
+    if (!recorder.StartRecordingToFile(WxStrToStr(path), m_FramesToRecord, RecordingFinished))
+    {
+      WxUtils::ShowErrorDialog(_("Error saving file."));
+      return;
+    }
+
+    m_RecordStop->SetLabel(_("Stop"));
+  }
   else  // Recorder is actually about to start recording
   {
     // So start recording
@@ -457,7 +486,9 @@ void FifoPlayerDlg::OnBeginSearch(wxCommandEvent& event)
   int const frame_idx = m_framesList->GetSelection();
   FifoPlayer& player = FifoPlayer::GetInstance();
   const AnalyzedFrameInfo& frame = player.GetAnalyzedFrameInfo(frame_idx);
-  const FifoFrameInfo& fifo_frame = player.GetFile()->GetFrame(frame_idx);
+  const std::shared_ptr<const FifoFrameInfo> fifo_frame_data =
+      player.GetFile()->GetFrame(frame_idx);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_data;
 
   // TODO: Support searching through the last object... How do we know were the cmd data ends?
   // TODO: Support searching for bit patterns
@@ -621,7 +652,9 @@ void FifoPlayerDlg::OnObjectListSelectionChanged(wxCommandEvent& event)
   if (frame_idx != -1 && object_idx != -1)
   {
     const AnalyzedFrameInfo& frame = player.GetAnalyzedFrameInfo(frame_idx);
-    const FifoFrameInfo& fifo_frame = player.GetFile()->GetFrame(frame_idx);
+    const std::shared_ptr<const FifoFrameInfo> fifo_frame_data =
+        player.GetFile()->GetFrame(frame_idx);
+    const FifoFrameInfo& fifo_frame = *fifo_frame_data;
     const u8* objectdata_start = &fifo_frame.fifoData[frame.objectStarts[object_idx]];
     const u8* objectdata_end = &fifo_frame.fifoData[frame.objectEnds[object_idx]];
     u8* objectdata = (u8*)objectdata_start;
@@ -758,7 +791,9 @@ void FifoPlayerDlg::OnObjectCmdListSelectionChanged(wxCommandEvent& event)
 
   FifoPlayer& player = FifoPlayer::GetInstance();
   const AnalyzedFrameInfo& frame = player.GetAnalyzedFrameInfo(frame_idx);
-  const FifoFrameInfo& fifo_frame = player.GetFile()->GetFrame(frame_idx);
+  const std::shared_ptr<const FifoFrameInfo> fifo_frame_data =
+      player.GetFile()->GetFrame(frame_idx);
+  const FifoFrameInfo& fifo_frame = *fifo_frame_data;
   const u8* cmddata =
       &fifo_frame.fifoData[frame.objectStarts[object_idx]] + m_objectCmdOffsets[event.GetInt()];
 
@@ -910,7 +945,7 @@ wxString FifoPlayerDlg::CreateRecordingFifoSizeLabel() const
   {
     size_t fifoBytes = 0;
     for (size_t i = 0; i < file->GetFrameCount(); ++i)
-      fifoBytes += file->GetFrame(i).fifoData.size();
+      fifoBytes += file->GetFrame(i)->fifoData.size();
 
     return wxString::Format(_("%zu FIFO bytes"), fifoBytes);
   }
@@ -927,8 +962,8 @@ wxString FifoPlayerDlg::CreateRecordingMemSizeLabel() const
     size_t memBytes = 0;
     for (size_t frameNum = 0; frameNum < file->GetFrameCount(); ++frameNum)
     {
-      const std::vector<MemoryUpdate>& memUpdates = file->GetFrame(frameNum).memoryUpdates;
-      for (const auto& memUpdate : memUpdates)
+      const std::shared_ptr<const FifoFrameInfo> frame = file->GetFrame(frameNum);
+      for (const auto& memUpdate : frame->memoryUpdates)
         memBytes += memUpdate.data.size();
     }
 
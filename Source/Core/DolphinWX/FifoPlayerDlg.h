@@ -97,6 +97,8 @@ private:
   wxButton* m_Save;
   wxStaticText* m_FramesToRecordLabel;
   wxSpinCtrl* m_FramesToRecordCtrl;
+  wxCheckBox* m_CompressFrames;
+  wxCheckBox* m_RecordToFile;
 
   wxPanel* m_AnalyzePage;
   wxListBox* m_framesList;
@@ -10,6 +10,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -45,6 +46,7 @@
 #include "Common/StringUtil.h"
 #include "Common/SysConf.h"
 #include "Common/Thread.h"
+#include "Common/WorkerPool.h"
 #include "Core/Boot/Boot.h"
 #include "Core/Config/NetplaySettings.h"
 #include "Core/ConfigManager.h"
@@ -82,7 +84,7 @@ public:
   wxProgressDialog* dialog;
 };
 
-static constexpr u32 CACHE_REVISION = 3;  // Last changed in PR 5573
+static constexpr u32 CACHE_REVISION = 4;  // Last changed for the file size and time checks
 
 static bool sorted = false;
 
@@ -757,8 +759,8 @@ void GameListCtrl::RescanList()
 
   post_status(_("Scanning..."));
 
-  const std::vector<std::string> search_extensions = {".gcm",  ".tgc", ".iso", ".ciso", ".gcz",
-                                                      ".wbfs", ".wad", ".dol", ".elf"};
+  const std::vector<std::string> search_extensions = {".gcm", ".tgc", ".iso", ".ciso", ".gcz",
+                                                      ".wcz", ".wbfs", ".wad", ".dol", ".elf"};
   // TODO This could process paths iteratively as they are found
   auto search_results = Common::DoFileSearch(SConfig::GetInstance().m_ISOFolder, search_extensions,
                                              SConfig::GetInstance().m_RecursiveISOFolder);
@@ -782,14 +784,29 @@ void GameListCtrl::RescanList()
   std::set_difference(search_results.cbegin(), search_results.cend(), cached_paths.cbegin(),
                       cached_paths.cend(), std::back_inserter(new_paths));
 
+  // Files which have been replaced or modified since they were scanned are scanned again.
+  {
+    std::unique_lock<std::mutex> lk(m_cache_mutex);
+    for (const auto& file : m_cached_files)
+    {
+      if (std::binary_search(search_results.cbegin(), search_results.cend(),
+                             file->GetFileName()) &&
+          file->FileChanged())
+      {
+        removed_paths.push_back(file->GetFileName());
+        new_paths.push_back(file->GetFileName());
+      }
+    }
+  }
+
   // Reload the TitleDatabase
   {
     std::unique_lock<std::mutex> lk(m_title_database_mutex);
     m_title_database = {};
   }
 
-  // For now, only scan new_paths. This could cause false negatives (file actively being written),
-  // but otherwise should be fine.
+  // Only new and changed files are scanned. This could cause false negatives (file actively being
+  // written), but otherwise should be fine.
   bool cache_changed = false;
   {
     std::unique_lock<std::mutex> lk(m_cache_mutex);
@@ -805,21 +822,47 @@ void GameListCtrl::RescanList()
         m_cached_files.erase(it);
       }
     }
-    for (const auto& path : new_paths)
+  }
+
+  // Scanning a file mostly waits for it to be read, which is slow on network shares, so several
+  // files are scanned at once even on hosts with few cores. The list is refreshed after each
+  // batch so that large libraries show up gradually instead of all at the end.
+  if (!new_paths.empty())
+  {
+    static constexpr size_t SCAN_BATCH_SIZE = 256;
+    Common::WorkerPool pool(std::max(std::thread::hardware_concurrency(), 4u) - 1,
+                            Common::TaskPriority::Low);
+    std::vector<std::shared_ptr<GameListItem>> scanned_files;
+    for (size_t start = 0; start < new_paths.size(); start += SCAN_BATCH_SIZE)
     {
-      auto file = std::make_shared<GameListItem>(path);
-      if (file->IsValid())
+      const size_t count = std::min(SCAN_BATCH_SIZE, new_paths.size() - start);
+      scanned_files.assign(count, nullptr);
+      pool.Run(count, [&](size_t i) {
+        scanned_files[i] = std::make_shared<GameListItem>(new_paths[start + i]);
+      });
+
+      std::unique_lock<std::mutex> lk(m_cache_mutex);
+      for (auto& file : scanned_files)
       {
-        cache_changed = true;
-        m_cached_files.push_back(std::move(file));
+        if (file->IsValid())
+        {
+          cache_changed = true;
+          m_cached_files.push_back(std::move(file));
+        }
       }
+      lk.unlock();
+
+      if (cache_changed)
+        QueueEvent(new wxCommandEvent(DOLPHIN_EVT_REFRESH_GAMELIST));
     }
   }
   // The common case is that just a file has been added/removed, so trigger a refresh ASAP with the
   // assumption that other properties of files will not change at the same time (which will be fine
   // and just causes a double refresh).
-  if (cache_changed)
+  else if (cache_changed)
+  {
     QueueEvent(new wxCommandEvent(DOLPHIN_EVT_REFRESH_GAMELIST));
+  }
 
   // If any cached files need updates, apply the updates to a copy and delete the original - this
   // makes the UI thread's use of cached files safe. Note however, it is assumed that RefreshList
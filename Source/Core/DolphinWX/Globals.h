@@ -252,6 +252,7 @@ enum
 
   // Profiler
   IDM_PROFILE_BLOCKS,
+  IDM_SAMPLE_BLOCKS,
   IDM_WRITE_PROFILE,
   // --------------------------------------------------------------
 
@@ -65,6 +65,10 @@ GameListItem::GameListItem(const std::string& filename)
     : m_file_name(filename), m_region(DiscIO::Region::UNKNOWN_REGION),
       m_country(DiscIO::Country::COUNTRY_UNKNOWN)
 {
+  const File::FileInfo file_info(m_file_name);
+  m_file_stat_size = file_info.GetSize();
+  m_file_modification_time = file_info.GetModificationTime();
+
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolumeFromFilename(m_file_name));
     if (volume != nullptr)
@@ -139,6 +143,13 @@ bool GameListItem::IsValid() const
   return true;
 }
 
+bool GameListItem::FileChanged() const
+{
+  const File::FileInfo file_info(m_file_name);
+  return file_info.GetSize() != m_file_stat_size ||
+         file_info.GetModificationTime() != m_file_modification_time;
+}
+
 bool GameListItem::CustomNameChanged(const Core::TitleDatabase& title_database)
 {
   const auto type = m_platform == DiscIO::Platform::WII_WAD ?
@@ -183,6 +194,8 @@ void GameListItem::DoState(PointerWrap& p)
 {
   p.Do(m_valid);
   p.Do(m_file_name);
+  p.Do(m_file_stat_size);
+  p.Do(m_file_modification_time);
   p.Do(m_file_size);
   p.Do(m_volume_size);
   p.Do(m_names);
@@ -62,6 +62,8 @@ public:
   // NOTE: Banner image is at the original resolution, use WxUtils::ScaleImageToBitmap
   //   to display it
   const wxImage& GetBannerImage() const { return m_banner_wx; }
+  // Whether the file's size or modification time differs from when it was scanned
+  bool FileChanged() const;
   void DoState(PointerWrap& p);
   bool BannerChanged();
   void BannerCommit();
@@ -104,6 +106,9 @@ private:
 
   bool m_valid{};
   std::string m_file_name{};
+  // The size and modification time of the file itself, which identify the version that was scanned
+  u64 m_file_stat_size{};
+  u64 m_file_modification_time{};
 
   u64 m_file_size{};
   u64 m_volume_size{};
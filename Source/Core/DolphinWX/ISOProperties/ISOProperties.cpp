@@ -267,6 +267,11 @@ void CISOProperties::CreateGUIControls()
                            wxDefaultSize, GetElementStyle("Core", "DCBZ"));
   DCBZOFF->SetToolTip(_("Bypass the clearing of the data cache by the DCBZ instruction. Usually "
                         "leave this option disabled."));
+  AccurateCPUCache =
+      new wxCheckBox(m_GameConfig, ID_ACCURATE_CPU_CACHE, _("Emulate Data Cache"),
+                     wxDefaultPosition, wxDefaultSize, GetElementStyle("Core", "AccurateCPUCache"));
+  AccurateCPUCache->SetToolTip(_("Emulates the CPU's L1 data cache, needed for a few games which "
+                                 "rely on stale cache contents. (ON = Compatible, OFF = Fast)"));
   FPRF = new wxCheckBox(m_GameConfig, ID_FPRF, _("Enable FPRF"), wxDefaultPosition, wxDefaultSize,
                         GetElementStyle("Core", "FPRF"));
   FPRF->SetToolTip(_("Enables Floating Point Result Flag calculation, needed for a few games. (ON "
@@ -346,6 +351,7 @@ void CISOProperties::CreateGUIControls()
   sbCoreOverrides->Add(CPUThread, 0, wxLEFT | wxRIGHT, space5);
   sbCoreOverrides->Add(MMU, 0, wxLEFT | wxRIGHT, space5);
   sbCoreOverrides->Add(DCBZOFF, 0, wxLEFT | wxRIGHT, space5);
+  sbCoreOverrides->Add(AccurateCPUCache, 0, wxLEFT | wxRIGHT, space5);
   sbCoreOverrides->Add(FPRF, 0, wxLEFT | wxRIGHT, space5);
   sbCoreOverrides->Add(SyncGPU, 0, wxLEFT | wxRIGHT, space5);
   sbCoreOverrides->Add(FastDiscSpeed, 0, wxLEFT | wxRIGHT, space5);
@@ -504,6 +510,7 @@ void CISOProperties::LoadGameConfig()
   SetCheckboxValueFromGameini("Core", "CPUThread", CPUThread);
   SetCheckboxValueFromGameini("Core", "MMU", MMU);
   SetCheckboxValueFromGameini("Core", "DCBZ", DCBZOFF);
+  SetCheckboxValueFromGameini("Core", "AccurateCPUCache", AccurateCPUCache);
   SetCheckboxValueFromGameini("Core", "FPRF", FPRF);
   SetCheckboxValueFromGameini("Core", "SyncGPU", SyncGPU);
   SetCheckboxValueFromGameini("Core", "FastDiscSpeed", FastDiscSpeed);
@@ -600,6 +607,7 @@ bool CISOProperties::SaveGameConfig()
   SaveGameIniValueFrom3StateCheckbox("Core", "CPUThread", CPUThread);
   SaveGameIniValueFrom3StateCheckbox("Core", "MMU", MMU);
   SaveGameIniValueFrom3StateCheckbox("Core", "DCBZ", DCBZOFF);
+  SaveGameIniValueFrom3StateCheckbox("Core", "AccurateCPUCache", AccurateCPUCache);
   SaveGameIniValueFrom3StateCheckbox("Core", "FPRF", FPRF);
   SaveGameIniValueFrom3StateCheckbox("Core", "SyncGPU", SyncGPU);
   SaveGameIniValueFrom3StateCheckbox("Core", "FastDiscSpeed", FastDiscSpeed);
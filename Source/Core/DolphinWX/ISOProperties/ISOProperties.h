@@ -67,7 +67,7 @@ private:
   PHackData m_PHack_Data;
 
   // Core
-  wxCheckBox *CPUThread, *MMU, *DCBZOFF, *FPRF;
+  wxCheckBox *CPUThread, *MMU, *DCBZOFF, *AccurateCPUCache, *FPRF;
   wxCheckBox *SyncGPU, *FastDiscSpeed, *DSPHLE;
 
   wxArrayString arrayStringFor_GPUDeterminism;
@@ -107,6 +107,7 @@ private:
     ID_USEDUALCORE,
     ID_MMU,
     ID_DCBZOFF,
+    ID_ACCURATE_CPU_CACHE,
     ID_FPRF,
     ID_SYNCGPU,
     ID_DISCSPEED,
@@ -18,6 +18,7 @@
 #include <wx/filedlg.h>
 #include <wx/gbsizer.h>
 #include <wx/menu.h>
+#include <wx/msgdlg.h>
 #include <wx/progdlg.h>
 #include <wx/sizer.h>
 #include <wx/statbmp.h>
@@ -25,10 +26,12 @@
 #include <wx/textctrl.h>
 #include <wx/utils.h>
 
-#include "Common/MD5.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/IOS/ES/Formats.h"
+#include "DiscIO/DiscVerifier.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
 #include "DolphinWX/ISOFile.h"
@@ -332,14 +335,38 @@ void InfoPanel::OnComputeMD5(wxCommandEvent& WXUNUSED(event))
                                        wxPD_ELAPSED_TIME | wxPD_ESTIMATED_TIME |
                                        wxPD_REMAINING_TIME | wxPD_SMOOTH);
 
-  const auto result = MD5::MD5Sum(m_game_list_item.GetFileName(), [&progress_dialog](int progress) {
-    return progress_dialog.Update(progress);
-  });
+  const std::optional<DiscIO::DiscHashes> hashes = DiscIO::ComputeDiscHashes(
+      m_game_list_item.GetFileName(),
+      [&progress_dialog](int progress) { return progress_dialog.Update(progress); });
 
-  if (progress_dialog.WasCancelled())
+  if (progress_dialog.WasCancelled() || !hashes)
     return;
 
-  m_md5_sum->SetValue(result);
+  m_md5_sum->SetValue(DiscIO::HashToString(hashes->md5.data(), hashes->md5.size()));
+
+  // The MD5 alone doesn't say whether the dump is good, so compare all of the hashes against
+  // the Redump DAT files which the user has placed in Load/Redump, if there are any.
+  DiscIO::DiscDatabase database;
+  bool database_loaded = false;
+  for (const std::string& path :
+       Common::DoFileSearch({File::GetUserPath(D_LOAD_IDX) + "Redump"}, {".dat"}))
+  {
+    database_loaded |= database.Load(path);
+  }
+  if (!database_loaded)
+    return;
+
+  const std::string name = database.Find(*hashes);
+  if (name.empty())
+  {
+    wxMessageBox(_("This dump doesn't match any known good dump in the Redump database."),
+                 _("Verify"), wxOK | wxICON_WARNING, this);
+  }
+  else
+  {
+    wxMessageBox(wxString::Format(_("This is a good dump of %s."), StrToWxStr(name)),
+                 _("Verify"), wxOK | wxICON_INFORMATION, this);
+  }
 }
 
 void InfoPanel::OnChangeBannerLanguage(wxCommandEvent& event)
@@ -56,6 +56,11 @@ void LogConfigWindow::CreateGUIControls()
   m_writeConsoleCB->Bind(wxEVT_CHECKBOX, &LogConfigWindow::OnWriteConsoleChecked, this);
   m_writeWindowCB = new wxCheckBox(this, wxID_ANY, _("Write to Window"));
   m_writeWindowCB->Bind(wxEVT_CHECKBOX, &LogConfigWindow::OnWriteWindowChecked, this);
+  m_writeAsyncCB = new wxCheckBox(this, wxID_ANY, _("Write Asynchronously"));
+  m_writeAsyncCB->SetToolTip(_("Writes the log from a separate thread, so that slow outputs "
+                               "don't slow down emulation as much. Messages that haven't been "
+                               "written yet are lost if Dolphin crashes."));
+  m_writeAsyncCB->Bind(wxEVT_CHECKBOX, &LogConfigWindow::OnWriteAsyncChecked, this);
 
   wxButton* btn_toggle_all = new wxButton(this, wxID_ANY, _("Toggle All Log Types"),
                                           wxDefaultPosition, wxDefaultSize, wxBU_EXACTFIT);
@@ -73,6 +78,7 @@ void LogConfigWindow::CreateGUIControls()
   sbOutputs->Add(m_writeFileCB, 0);
   sbOutputs->Add(m_writeConsoleCB, 0, wxTOP, space1);
   sbOutputs->Add(m_writeWindowCB, 0, wxTOP, space1);
+  sbOutputs->Add(m_writeAsyncCB, 0, wxTOP, space1);
 
   wxStaticBoxSizer* sbLogTypes = new wxStaticBoxSizer(wxVERTICAL, this, _("Log Types"));
   sbLogTypes->Add(m_checks, 1, wxEXPAND);
@@ -95,6 +101,7 @@ void LogConfigWindow::LoadSettings()
   m_writeFileCB->SetValue(m_LogManager->IsListenerEnabled(LogListener::FILE_LISTENER));
   m_writeConsoleCB->SetValue(m_LogManager->IsListenerEnabled(LogListener::CONSOLE_LISTENER));
   m_writeWindowCB->SetValue(m_LogManager->IsListenerEnabled(LogListener::LOG_WINDOW_LISTENER));
+  m_writeAsyncCB->SetValue(m_LogManager->IsAsync());
 
   // Run through all of the log types and check each checkbox for each logging type
   // depending on its set value within the config ini.
@@ -137,6 +144,11 @@ void LogConfigWindow::OnWriteWindowChecked(wxCommandEvent& event)
   m_LogManager->EnableListener(LogListener::LOG_WINDOW_LISTENER, event.IsChecked());
 }
 
+void LogConfigWindow::OnWriteAsyncChecked(wxCommandEvent& event)
+{
+  m_LogManager->SetAsync(event.IsChecked());
+}
+
 void LogConfigWindow::OnToggleAll(wxCommandEvent& WXUNUSED(event))
 {
   for (int i = 0; i < LogTypes::NUMBER_OF_LOGS; ++i)
@@ -25,7 +25,7 @@ private:
   bool enableAll;
 
   // Controls
-  wxCheckBox *m_writeFileCB, *m_writeConsoleCB, *m_writeWindowCB;
+  wxCheckBox *m_writeFileCB, *m_writeConsoleCB, *m_writeWindowCB, *m_writeAsyncCB;
   wxCheckListBox* m_checks;
   wxRadioBox* m_verbosity;
 
@@ -34,6 +34,7 @@ private:
   void OnWriteFileChecked(wxCommandEvent& event);
   void OnWriteConsoleChecked(wxCommandEvent& event);
   void OnWriteWindowChecked(wxCommandEvent& event);
+  void OnWriteAsyncChecked(wxCommandEvent& event);
   void OnToggleAll(wxCommandEvent& event);
   void ToggleLog(int _logType, bool enable);
   void OnLogCheck(wxCommandEvent& event);
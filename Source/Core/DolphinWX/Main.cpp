@@ -134,6 +134,8 @@ bool DolphinApp::OnInit()
   if (m_select_audio_emulation)
     SConfig::GetInstance().bDSPHLE = (m_audio_emulation_name.Upper() == "HLE");
 
+  SConfig::GetInstance().m_strJITWarmupList = WxStrToStr(m_jit_warmup_file);
+
   VideoBackendBase::ActivateBackend(SConfig::GetInstance().m_strVideoBackend);
 
   DolphinAnalytics::Instance()->ReportDolphinStart("wx");
@@ -195,6 +197,7 @@ void DolphinApp::ParseCommandLine()
   m_movie_file = static_cast<const char*>(options.get("movie"));
 
   m_user_path = static_cast<const char*>(options.get("user"));
+  m_jit_warmup_file = static_cast<const char*>(options.get("jit_warmup"));
 }
 
 #ifdef __APPLE__
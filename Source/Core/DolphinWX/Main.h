@@ -55,6 +55,7 @@ private:
   wxString m_user_path;
   wxString m_file_to_load;
   wxString m_movie_file;
+  wxString m_jit_warmup_file;
   std::unique_ptr<wxLocale> m_locale;
 };
 
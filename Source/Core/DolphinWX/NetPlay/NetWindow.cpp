@@ -255,6 +255,11 @@ wxSizer* NetPlayDialog::CreateBottomGUI(wxWindow* parent)
     padbuf_spin->Bind(wxEVT_SPINCTRL, &NetPlayDialog::OnAdjustBuffer, this);
     padbuf_spin->SetMinSize(WxUtils::GetTextWidgetMinSize(padbuf_spin));
 
+    wxCheckBox* const auto_buffer_chkbox = new wxCheckBox(parent, wxID_ANY, _("Auto"));
+    auto_buffer_chkbox->SetToolTip(
+        _("Keeps the buffer as small as the pings of the players allow during the game."));
+    auto_buffer_chkbox->Bind(wxEVT_CHECKBOX, &NetPlayDialog::OnAutoBuffer, this);
+
     m_memcard_write = new wxCheckBox(parent, wxID_ANY, _("Write save/SD data"));
 
     m_copy_wii_save = new wxCheckBox(parent, wxID_ANY, _("Load Wii Save"));
@@ -262,6 +267,7 @@ wxSizer* NetPlayDialog::CreateBottomGUI(wxWindow* parent)
     bottom_szr->Add(m_start_btn, 0, wxALIGN_CENTER_VERTICAL);
     bottom_szr->Add(buffer_lbl, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, space5);
     bottom_szr->Add(padbuf_spin, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, space5);
+    bottom_szr->Add(auto_buffer_chkbox, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, space5);
     bottom_szr->Add(m_memcard_write, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, space5);
     bottom_szr->Add(m_copy_wii_save, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, space5);
     bottom_szr->AddSpacer(space5);
@@ -438,6 +444,11 @@ void NetPlayDialog::OnAdjustBuffer(wxCommandEvent& event)
   netplay_server->AdjustPadBufferSize(val);
 }
 
+void NetPlayDialog::OnAutoBuffer(wxCommandEvent& event)
+{
+  netplay_server->SetAutomaticPadBuffer(event.IsChecked());
+}
+
 void NetPlayDialog::OnPadBufferChanged(u32 buffer)
 {
   m_pad_buffer = buffer;
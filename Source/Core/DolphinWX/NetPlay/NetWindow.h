@@ -125,6 +125,7 @@ private:
   void OnChangeGame(wxCommandEvent& event);
   void OnMD5ComputeRequested(wxCommandEvent& event);
   void OnAdjustBuffer(wxCommandEvent& event);
+  void OnAutoBuffer(wxCommandEvent& event);
   void OnAssignPads(wxCommandEvent& event);
   void OnKick(wxCommandEvent& event);
   void OnPlayerSelect(wxCommandEvent& event);
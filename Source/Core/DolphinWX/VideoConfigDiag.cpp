@@ -193,6 +193,10 @@ static wxString efb_access_desc =
     wxTRANSLATE("Ignore any requests from the CPU to read from or write to the EFB.\nImproves "
                 "performance in some games, but might disable some gameplay-related features or "
                 "graphical effects.\n\nIf unsure, leave this unchecked.");
+static wxString efb_defer_invalidation_desc = wxTRANSLATE(
+    "Keeps the results of EFB reads from the CPU until the end of the frame, instead of reading "
+    "the EFB again after every draw.\nImproves performance in games which read the EFB a lot, "
+    "but may return outdated values in a few others.\n\nIf unsure, leave this unchecked.");
 static wxString efb_emulate_format_changes_desc =
     wxTRANSLATE("Ignore any changes to the EFB format.\nImproves performance in many games without "
                 "any negative effect. Causes graphical defects in a small number of other "
@@ -201,6 +205,9 @@ static wxString skip_efb_copy_to_ram_desc = wxTRANSLATE(
     "Stores EFB Copies exclusively on the GPU, bypassing system memory. Causes graphical defects "
     "in a small number of games.\n\nEnabled = EFB Copies to Texture\nDisabled = EFB Copies to RAM "
     "(and Texture)\n\nIf unsure, leave this checked.");
+static wxString defer_efb_copies_desc = wxTRANSLATE(
+    "Writes EFB Copies to RAM once the game needs them, instead of waiting for the GPU after every "
+    "copy. Only works in Direct3D 11 and Vulkan.\n\nIf unsure, leave this checked.");
 static wxString stc_desc =
     wxTRANSLATE("The \"Safe\" setting eliminates the likelihood of the GPU missing texture updates "
                 "from RAM.\nLower accuracies cause in-game text to appear garbled in certain "
@@ -223,9 +230,16 @@ static wxString log_render_time_to_file_desc =
                 "unsure, leave this unchecked.");
 static wxString show_stats_desc =
     wxTRANSLATE("Show various rendering statistics.\n\nIf unsure, leave this unchecked.");
+static wxString show_stage_timings_desc = wxTRANSLATE(
+    "Show how long the CPU emulation, FIFO processing, vertex loading, texture decoding, shader "
+    "compilation, command submission and presentation took in recent frames, to find out what "
+    "limits the frame rate.\n\nIf unsure, leave this unchecked.");
 static wxString show_netplay_messages_desc =
     wxTRANSLATE("When playing on NetPlay, show chat messages, buffer changes and "
                 "desync alerts.\n\nIf unsure, leave this unchecked.");
+static wxString show_audio_stats_desc =
+    wxTRANSLATE("Show how full the audio buffer is, the audio latency and how many times the "
+                "buffer ran empty.\n\nIf unsure, leave this unchecked.");
 static wxString texfmt_desc =
     wxTRANSLATE("Modify textures to show the format they're encoded in. Needs an emulation reset "
                 "in most cases.\n\nIf unsure, leave this unchecked.");
@@ -248,6 +262,10 @@ static wxString load_hires_textures_desc = wxTRANSLATE(
 static wxString cache_hires_textures_desc =
     wxTRANSLATE("Cache custom textures to system RAM on startup.\nThis can require exponentially "
                 "more RAM but fixes possible stuttering.\n\nIf unsure, leave this unchecked.");
+static wxString async_hires_textures_desc = wxTRANSLATE(
+    "Load custom textures on a separate thread, and show the original textures until they are "
+    "ready.\nThis prevents stuttering when a custom texture is used for the first time, and only "
+    "keeps as many custom textures in RAM as fit.\n\nIf unsure, leave this unchecked.");
 static wxString dump_efb_desc = wxTRANSLATE(
     "Dump the contents of EFB copies to User/Dump/Textures/.\n\nIf unsure, leave this unchecked.");
 static wxString internal_resolution_frame_dumping_desc = wxTRANSLATE(
@@ -455,6 +473,9 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
         szr_other->Add(CreateCheckBox(page_general, _("Show NetPlay Messages"),
                                       wxGetTranslation(show_netplay_messages_desc),
                                       Config::GFX_SHOW_NETPLAY_MESSAGES));
+        szr_other->Add(CreateCheckBox(page_general, _("Show Audio Statistics"),
+                                      wxGetTranslation(show_audio_stats_desc),
+                                      Config::GFX_SHOW_AUDIO_STATS));
         szr_other->Add(CreateCheckBoxRefBool(page_general, _("Keep Window on Top"),
                                              wxGetTranslation(keep_window_on_top_desc),
                                              SConfig::GetInstance().bKeepWindowOnTop));
@@ -709,6 +730,11 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
                                 Config::GFX_HACK_EFB_ACCESS_ENABLE, true),
                  0, wxLEFT | wxRIGHT, space5);
     szr_efb->AddSpacer(space5);
+    szr_efb->Add(CreateCheckBox(page_hacks, _("Defer EFB Cache Invalidation"),
+                                wxGetTranslation(efb_defer_invalidation_desc),
+                                Config::GFX_HACK_EFB_DEFER_INVALIDATION),
+                 0, wxLEFT | wxRIGHT, space5);
+    szr_efb->AddSpacer(space5);
     szr_efb->Add(CreateCheckBox(page_hacks, _("Ignore Format Changes"),
                                 wxGetTranslation(efb_emulate_format_changes_desc),
                                 Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES, true),
@@ -719,6 +745,11 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
                                 Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM),
                  0, wxLEFT | wxRIGHT, space5);
     szr_efb->AddSpacer(space5);
+    szr_efb->Add(CreateCheckBox(page_hacks, _("Defer EFB Copies to RAM"),
+                                wxGetTranslation(defer_efb_copies_desc),
+                                Config::GFX_HACK_DEFER_EFB_COPIES),
+                 0, wxLEFT | wxRIGHT, space5);
+    szr_efb->AddSpacer(space5);
 
     szr_hacks->AddSpacer(space5);
     szr_hacks->Add(szr_efb, 0, wxEXPAND | wxLEFT | wxRIGHT, space5);
@@ -846,6 +877,9 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
                                     Config::GFX_ENABLE_WIREFRAME));
       szr_debug->Add(CreateCheckBox(page_advanced, _("Show Statistics"),
                                     wxGetTranslation(show_stats_desc), Config::GFX_OVERLAY_STATS));
+      szr_debug->Add(CreateCheckBox(page_advanced, _("Show Stage Timings"),
+                                    wxGetTranslation(show_stage_timings_desc),
+                                    Config::GFX_OVERLAY_STAGE_TIMINGS));
       szr_debug->Add(CreateCheckBox(page_advanced, _("Texture Format Overlay"),
                                     wxGetTranslation(texfmt_desc),
                                     Config::GFX_TEXFMT_OVERLAY_ENABLE));
@@ -876,6 +910,10 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
                                             wxGetTranslation(cache_hires_textures_desc),
                                             Config::GFX_CACHE_HIRES_TEXTURES);
       szr_utility->Add(cache_hires_textures);
+      async_hires_textures = CreateCheckBox(page_advanced, _("Load Custom Textures Asynchronously"),
+                                            wxGetTranslation(async_hires_textures_desc),
+                                            Config::GFX_ASYNC_HIRES_TEXTURES);
+      szr_utility->Add(async_hires_textures);
 
       if (vconfig.backend_info.bSupportsInternalResolutionFrameDumps)
       {
@@ -1111,6 +1149,7 @@ void VideoConfigDiag::OnUpdateUI(wxUpdateUIEvent& ev)
 
   // custom textures
   cache_hires_textures->Enable(vconfig.bHiresTextures);
+  async_hires_textures->Enable(vconfig.bHiresTextures);
 
   // Vertex rounding
   vertex_rounding_checkbox->Enable(vconfig.iEFBScale != 1);
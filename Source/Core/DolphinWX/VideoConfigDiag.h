@@ -164,6 +164,7 @@ protected:
   SettingRadioButton* real_xfb;
 
   SettingCheckBox* cache_hires_textures;
+  SettingCheckBox* async_hires_textures;
 
   wxCheckBox* progressive_scan_checkbox;
   wxCheckBox* vertex_rounding_checkbox;
@@ -83,7 +83,16 @@ void ControllerInterface::RefreshDevices()
 
   {
     std::lock_guard<std::mutex> lk(m_devices_mutex);
+#ifdef CIFACE_USE_EVDEV
+    // evdev keeps its devices up to date through udev, so they are kept instead of opening every
+    // device node again, which would make the emulation stutter.
+    m_devices.erase(
+        std::remove_if(m_devices.begin(), m_devices.end(),
+                       [](const auto& device) { return device->GetSource() != "evdev"; }),
+        m_devices.end());
+#else
     m_devices.clear();
+#endif
   }
 
 #ifdef CIFACE_USE_DINPUT
@@ -6,6 +6,7 @@
 #include <libudev.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unistd.h>
 
 #include <sys/eventfd.h>
@@ -30,22 +31,37 @@ static int s_wakeup_eventfd;
 // There is no easy way to get the device name from only a dev node
 // during a device removed event, since libevdev can't work on removed devices;
 // sysfs is not stable, so this is probably the easiest way to get a name for a node.
+// This is also the list of the nodes that have been added, so that they aren't opened again.
 static std::map<std::string, std::string> s_devnode_name_map;
+static std::mutex s_devnode_name_map_mutex;
 
-static std::string GetName(const std::string& devnode)
+static bool IsDevnodeAdded(const std::string& devnode)
 {
-  int fd = open(devnode.c_str(), O_RDWR | O_NONBLOCK);
-  libevdev* dev = nullptr;
-  int ret = libevdev_new_from_fd(fd, &dev);
-  if (ret != 0)
+  std::lock_guard<std::mutex> lk(s_devnode_name_map_mutex);
+  return s_devnode_name_map.count(devnode) != 0;
+}
+
+// Opens the device node and adds it if it is an evdev device, unless it was already added.
+static bool AddDeviceNode(const char* devnode)
+{
+  // We only care about devices which we have read/write access to.
+  if (access(devnode, W_OK) != 0 || IsDevnodeAdded(devnode))
+    return false;
+
+  // Unfortunately udev gives us no way to filter out the non event device interfaces.
+  // So we open it and see if it works with evdev ioctls or not.
+  auto device = std::make_shared<evdevDevice>(devnode);
+  if (!device->IsInteresting())
+    return false;
+
   {
-    close(fd);
-    return std::string();
+    std::lock_guard<std::mutex> lk(s_devnode_name_map_mutex);
+    if (!s_devnode_name_map.emplace(devnode, device->GetName()).second)
+      return false;
   }
-  std::string res = StripSpaces(libevdev_get_name(dev));
-  libevdev_free(dev);
-  close(fd);
-  return res;
+  NOTICE_LOG(SERIALINTERFACE, "Added device: %s", device->GetName().c_str());
+  g_controller_interface.AddDevice(std::move(device));
+  return true;
 }
 
 static void HotplugThreadFunc()
@@ -83,32 +99,31 @@ static void HotplugThreadFunc()
 
     if (strcmp(action, "remove") == 0)
     {
-      const auto it = s_devnode_name_map.find(devnode);
-      if (it == s_devnode_name_map.end())
-        continue;  // we don't know the name for this device, so it is probably not an evdev device
-      const std::string& name = it->second;
-      g_controller_interface.RemoveDevice([&name](const auto& device) {
-        return device->GetSource() == "evdev" && device->GetName() == name && !device->IsValid();
-      });
-      NOTICE_LOG(SERIALINTERFACE, "Removed device: %s", name.c_str());
-      s_devnode_name_map.erase(devnode);
-      g_controller_interface.InvokeHotplugCallbacks();
-    }
-    // Only react to "device added" events for evdev devices that we can access.
-    else if (strcmp(action, "add") == 0 && access(devnode, W_OK) == 0)
-    {
-      const std::string name = GetName(devnode);
-      if (name.empty())
-        continue;  // probably not an evdev device
-      auto device = std::make_shared<evdevDevice>(devnode);
-      if (device->IsInteresting())
+      std::string name;
       {
-        g_controller_interface.AddDevice(std::move(device));
-        s_devnode_name_map.insert(std::pair<std::string, std::string>(devnode, name));
-        NOTICE_LOG(SERIALINTERFACE, "Added new device: %s", name.c_str());
+        std::lock_guard<std::mutex> lk(s_devnode_name_map_mutex);
+        const auto it = s_devnode_name_map.find(devnode);
+        if (it != s_devnode_name_map.end())
+        {
+          name = std::move(it->second);
+          s_devnode_name_map.erase(it);
+        }
+      }
+      // If we don't know the name for this device, it is probably not an evdev device.
+      if (!name.empty())
+      {
+        g_controller_interface.RemoveDevice([&name](const auto& device) {
+          return device->GetSource() == "evdev" && device->GetName() == name && !device->IsValid();
+        });
+        NOTICE_LOG(SERIALINTERFACE, "Removed device: %s", name.c_str());
         g_controller_interface.InvokeHotplugCallbacks();
       }
     }
+    // Only react to "device added" events for evdev devices that we can access.
+    else if (strcmp(action, "add") == 0 && AddDeviceNode(devnode))
+    {
+      g_controller_interface.InvokeHotplugCallbacks();
+    }
     udev_device_unref(dev);
   }
   NOTICE_LOG(SERIALINTERFACE, "evdev hotplug thread stopped");
@@ -142,10 +157,15 @@ static void StopHotplugThread()
 
 void Init()
 {
-  s_devnode_name_map.clear();
+  {
+    std::lock_guard<std::mutex> lk(s_devnode_name_map_mutex);
+    s_devnode_name_map.clear();
+  }
   StartHotplugThread();
 }
 
+// The hotplug thread keeps the devices up to date, so this only adds the devices which aren't
+// known yet, without opening the others again.
 void PopulateDevices()
 {
   // We use udev to iterate over all /dev/input/event* devices.
@@ -170,20 +190,8 @@ void PopulateDevices()
     udev_device* dev = udev_device_new_from_syspath(udev, path);
 
     const char* devnode = udev_device_get_devnode(dev);
-    // We only care about devices which we have read/write access to.
-    if (devnode && access(devnode, W_OK) == 0)
-    {
-      // Unfortunately udev gives us no way to filter out the non event device interfaces.
-      // So we open it and see if it works with evdev ioctls or not.
-      auto input = std::make_shared<evdevDevice>(devnode);
-
-      if (input->IsInteresting())
-      {
-        g_controller_interface.AddDevice(std::move(input));
-        std::string name = GetName(devnode);
-        s_devnode_name_map.insert(std::pair<std::string, std::string>(devnode, name));
-      }
-    }
+    if (devnode)
+      AddDeviceNode(devnode);
     udev_device_unref(dev);
   }
   udev_enumerate_unref(enumerate);
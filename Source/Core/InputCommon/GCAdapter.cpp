@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <libusb.h>
 #include <mutex>
 
@@ -35,11 +37,17 @@ static u8 s_controller_type[SerialInterface::MAX_SI_CHANNELS] = {
     ControllerTypes::CONTROLLER_NONE, ControllerTypes::CONTROLLER_NONE};
 static u8 s_controller_rumble[4];
 
-static std::mutex s_mutex;
-static u8 s_controller_payload[37];
-static u8 s_controller_payload_swap[37];
-
+// The newest payload is published through a seqlock: the sequence number is odd while it's being
+// written, and readers retry if it was odd or changed while they copied the payload.
+constexpr size_t CONTROLLER_PAYLOAD_SIZE = 37;
+static std::array<std::atomic<u8>, CONTROLLER_PAYLOAD_SIZE> s_controller_payload;
 static std::atomic<int> s_controller_payload_size = {0};
+static std::atomic<u32> s_controller_payload_sequence = {0};
+
+// Several reads are kept in flight, so that the next one is already queued when the adapter
+// sends its next payload.
+constexpr size_t NUM_READ_TRANSFERS = 4;
+static std::atomic<int> s_read_transfers_in_flight = {0};
 
 static std::thread s_adapter_input_thread;
 static std::thread s_adapter_output_thread;
@@ -69,22 +77,85 @@ static u8 s_endpoint_out = 0;
 
 static u64 s_last_init = 0;
 
+// Only called from libusb's event handling, which runs on a single thread at a time.
+static void WritePayload(const u8* payload, int payload_size)
+{
+  const u32 sequence = s_controller_payload_sequence.load(std::memory_order_relaxed);
+  s_controller_payload_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  for (size_t i = 0; i < CONTROLLER_PAYLOAD_SIZE; ++i)
+    s_controller_payload[i].store(payload[i], std::memory_order_relaxed);
+  s_controller_payload_size.store(payload_size, std::memory_order_relaxed);
+
+  s_controller_payload_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+static int ReadPayload(u8* payload)
+{
+  u32 sequence_before, sequence_after;
+  int payload_size;
+  do
+  {
+    sequence_before = s_controller_payload_sequence.load(std::memory_order_acquire);
+    for (size_t i = 0; i < CONTROLLER_PAYLOAD_SIZE; ++i)
+      payload[i] = s_controller_payload[i].load(std::memory_order_relaxed);
+    payload_size = s_controller_payload_size.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    sequence_after = s_controller_payload_sequence.load(std::memory_order_relaxed);
+  } while ((sequence_before & 1) != 0 || sequence_before != sequence_after);
+
+  return payload_size;
+}
+
+static void LIBUSB_CALL ReadCallback(libusb_transfer* transfer)
+{
+  // Failed reads publish an empty payload, which makes Input() reset the adapter.
+  if (transfer->status != LIBUSB_TRANSFER_CANCELLED)
+  {
+    WritePayload(transfer->buffer,
+                 transfer->status == LIBUSB_TRANSFER_COMPLETED ? transfer->actual_length : 0);
+  }
+
+  if (!s_adapter_thread_running.IsSet() || transfer->status == LIBUSB_TRANSFER_CANCELLED ||
+      transfer->status == LIBUSB_TRANSFER_NO_DEVICE || libusb_submit_transfer(transfer) != 0)
+  {
+    --s_read_transfers_in_flight;
+  }
+}
+
 static void Read()
 {
-  int payload_size = 0;
-  while (s_adapter_thread_running.IsSet())
+  Common::SetCurrentThreadName("GC Adapter Read Thread");
+
+  std::array<std::array<u8, CONTROLLER_PAYLOAD_SIZE>, NUM_READ_TRANSFERS> buffers;
+  std::array<libusb_transfer*, NUM_READ_TRANSFERS> transfers;
+  for (size_t i = 0; i < NUM_READ_TRANSFERS; ++i)
   {
-    libusb_interrupt_transfer(s_handle, s_endpoint_in, s_controller_payload_swap,
-                              sizeof(s_controller_payload_swap), &payload_size, 16);
+    transfers[i] = libusb_alloc_transfer(0);
+    libusb_fill_interrupt_transfer(transfers[i], s_handle, s_endpoint_in, buffers[i].data(),
+                                   static_cast<int>(buffers[i].size()), ReadCallback, nullptr, 0);
+    ++s_read_transfers_in_flight;
+    if (libusb_submit_transfer(transfers[i]) != 0)
+      --s_read_transfers_in_flight;
+  }
 
+  // The callbacks resubmit their transfer until the thread is stopped. A callback may still be
+  // resubmitting when that happens, so the cancellation is repeated until all of them are done.
+  while (s_read_transfers_in_flight > 0)
+  {
+    if (!s_adapter_thread_running.IsSet())
     {
-      std::lock_guard<std::mutex> lk(s_mutex);
-      std::swap(s_controller_payload_swap, s_controller_payload);
-      s_controller_payload_size.store(payload_size);
+      for (libusb_transfer* transfer : transfers)
+        libusb_cancel_transfer(transfer);
     }
 
-    Common::YieldCPU();
+    timeval tv = {0, 10000};
+    libusb_handle_events_timeout_completed(s_libusb_context, &tv, nullptr);
   }
+
+  for (libusb_transfer* transfer : transfers)
+    libusb_free_transfer(transfer);
 }
 
 static void Write()
@@ -402,15 +473,8 @@ GCPadStatus Input(int chan)
   if (s_handle == nullptr || !s_detected)
     return {};
 
-  int payload_size = 0;
-  u8 controller_payload_copy[37];
-
-  {
-    std::lock_guard<std::mutex> lk(s_mutex);
-    std::copy(std::begin(s_controller_payload), std::end(s_controller_payload),
-              std::begin(controller_payload_copy));
-    payload_size = s_controller_payload_size.load();
-  }
+  u8 controller_payload_copy[CONTROLLER_PAYLOAD_SIZE];
+  const int payload_size = ReadPayload(controller_payload_copy);
 
   GCPadStatus pad = {};
   if (payload_size != sizeof(controller_payload_copy) ||
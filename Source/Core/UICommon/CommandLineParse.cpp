@@ -73,6 +73,11 @@ std::unique_ptr<optparse::OptionParser> CreateParser(ParserOptions options)
       .metavar("<file>")
       .type("string")
       .help("Load the specified file");
+  parser->add_option("--jit-warmup")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Compile the JIT blocks listed in the file at boot, and add new ones to it on exit");
   parser->add_option("-C", "--config")
       .action("append")
       .metavar("<System>.<Section>.<Key>=<Value>")
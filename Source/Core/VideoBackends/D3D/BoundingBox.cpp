@@ -5,6 +5,7 @@
 #include "VideoBackends/D3D/BoundingBox.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
+#include "VideoBackends/D3D/DeferredDraws.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace DX11
@@ -66,6 +67,7 @@ void BBox::Shutdown()
 
 void BBox::Set(int index, int value)
 {
+  DeferredDraws::Flush();
   D3D11_BOX box{index * sizeof(s32), 0, 0, (index + 1) * sizeof(s32), 1, 1};
   D3D::context->UpdateSubresource(s_bbox_buffer, 0, &box, &value, 0, 0);
 }
@@ -73,6 +75,7 @@ void BBox::Set(int index, int value)
 int BBox::Get(int index)
 {
   int data = 0;
+  DeferredDraws::Flush();
   D3D::context->CopyResource(s_bbox_staging_buffer, s_bbox_buffer);
   D3D11_MAPPED_SUBRESOURCE map;
   HRESULT hr = D3D::context->Map(s_bbox_staging_buffer, 0, D3D11_MAP_READ, 0, &map);
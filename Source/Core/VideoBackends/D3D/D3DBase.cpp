@@ -423,7 +423,7 @@ HRESULT Create(HWND wnd)
   g_Config.backend_info.bSupportsST3CTextures = SupportsS3TCTextures(device);
   g_Config.backend_info.bSupportsBPTCTextures = SupportsBPTCTextures(device);
 
-  stateman = new StateManager;
+  stateman = new StateManager(context);
   return S_OK;
 }
 
@@ -602,6 +602,10 @@ void Present()
   if (swapchain->IsTemporaryMonoSupported() && g_ActiveConfig.iStereoMode != STEREO_QUADBUFFER)
     present_flags = DXGI_PRESENT_STEREO_TEMPORARY_MONO;
 
+  // The frame is dropped if the swap chain is still busy with the previous ones.
+  if (g_ActiveConfig.IsVSync() && g_ActiveConfig.bNonBlockingPresent)
+    present_flags |= DXGI_PRESENT_DO_NOT_WAIT;
+
   // TODO: Is 1 the correct value for vsyncing?
   swapchain->Present((UINT)g_ActiveConfig.IsVSync(), present_flags);
 }
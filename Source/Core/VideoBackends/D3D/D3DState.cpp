@@ -40,9 +40,9 @@ AutoState<T>::~AutoState()
   state = nullptr;
 }
 
-StateManager::StateManager()
-    : m_currentBlendState(nullptr), m_currentDepthState(nullptr), m_currentRasterizerState(nullptr),
-      m_dirtyFlags(~0u), m_pending(), m_current()
+StateManager::StateManager(ID3D11DeviceContext* context)
+    : m_context(context), m_currentBlendState(nullptr), m_currentDepthState(nullptr),
+      m_currentRasterizerState(nullptr), m_dirtyFlags(~0u), m_pending(), m_current()
 {
 }
 
@@ -73,39 +73,87 @@ void StateManager::PopRasterizerState()
 
 void StateManager::Apply()
 {
+  ID3D11BlendState* blend_state = nullptr;
+  ID3D11DepthStencilState* depth_state = nullptr;
+  ID3D11RasterizerState* rasterizer_state = nullptr;
+
   if (!m_blendStates.empty())
-  {
-    if (m_currentBlendState != m_blendStates.top().GetPtr())
-    {
-      m_currentBlendState = (ID3D11BlendState*)m_blendStates.top().GetPtr();
-      D3D::context->OMSetBlendState(m_currentBlendState, nullptr, 0xFFFFFFFF);
-    }
-  }
+    blend_state = (ID3D11BlendState*)m_blendStates.top().GetPtr();
   else
     ERROR_LOG(VIDEO, "Tried to apply without blend state!");
 
   if (!m_depthStates.empty())
-  {
-    if (m_currentDepthState != m_depthStates.top().GetPtr())
-    {
-      m_currentDepthState = (ID3D11DepthStencilState*)m_depthStates.top().GetPtr();
-      D3D::context->OMSetDepthStencilState(m_currentDepthState, 0);
-    }
-  }
+    depth_state = (ID3D11DepthStencilState*)m_depthStates.top().GetPtr();
   else
     ERROR_LOG(VIDEO, "Tried to apply without depth state!");
 
   if (!m_rasterizerStates.empty())
-  {
-    if (m_currentRasterizerState != m_rasterizerStates.top().GetPtr())
-    {
-      m_currentRasterizerState = (ID3D11RasterizerState*)m_rasterizerStates.top().GetPtr();
-      D3D::context->RSSetState(m_currentRasterizerState);
-    }
-  }
+    rasterizer_state = (ID3D11RasterizerState*)m_rasterizerStates.top().GetPtr();
   else
     ERROR_LOG(VIDEO, "Tried to apply without rasterizer state!");
 
+  ApplyStateObjects(blend_state, depth_state, rasterizer_state);
+  ApplyResources();
+}
+
+StateManager::DrawState StateManager::GetDrawState() const
+{
+  DrawState state;
+  state.resources = m_pending;
+  state.blendState =
+      m_blendStates.empty() ? nullptr : (ID3D11BlendState*)m_blendStates.top().GetPtr();
+  state.depthState =
+      m_depthStates.empty() ? nullptr : (ID3D11DepthStencilState*)m_depthStates.top().GetPtr();
+  state.rasterizerState = m_rasterizerStates.empty() ?
+                              nullptr :
+                              (ID3D11RasterizerState*)m_rasterizerStates.top().GetPtr();
+  return state;
+}
+
+void StateManager::ApplyDrawState(const DrawState& state)
+{
+  ApplyStateObjects(state.blendState, state.depthState, state.rasterizerState);
+
+  // Only bindings which differ from the current ones are set, so marking everything dirty is cheap.
+  m_pending = state.resources;
+  m_dirtyFlags = ~0u;
+  ApplyResources();
+}
+
+void StateManager::ForgetCurrentState()
+{
+  m_currentBlendState = nullptr;
+  m_currentDepthState = nullptr;
+  m_currentRasterizerState = nullptr;
+  m_current = {};
+  m_dirtyFlags = ~0u;
+}
+
+void StateManager::ApplyStateObjects(ID3D11BlendState* blend_state,
+                                     ID3D11DepthStencilState* depth_state,
+                                     ID3D11RasterizerState* rasterizer_state)
+{
+  if (blend_state && m_currentBlendState != blend_state)
+  {
+    m_currentBlendState = blend_state;
+    m_context->OMSetBlendState(m_currentBlendState, nullptr, 0xFFFFFFFF);
+  }
+
+  if (depth_state && m_currentDepthState != depth_state)
+  {
+    m_currentDepthState = depth_state;
+    m_context->OMSetDepthStencilState(m_currentDepthState, 0);
+  }
+
+  if (rasterizer_state && m_currentRasterizerState != rasterizer_state)
+  {
+    m_currentRasterizerState = rasterizer_state;
+    m_context->RSSetState(m_currentRasterizerState);
+  }
+}
+
+void StateManager::ApplyResources()
+{
   if (!m_dirtyFlags)
   {
     return;
@@ -135,21 +183,21 @@ void StateManager::Apply()
     if (m_current.pixelConstants[0] != m_pending.pixelConstants[0] ||
         m_current.pixelConstants[1] != m_pending.pixelConstants[1])
     {
-      D3D::context->PSSetConstantBuffers(0, m_pending.pixelConstants[1] ? 2 : 1,
-                                         m_pending.pixelConstants.data());
+      m_context->PSSetConstantBuffers(0, m_pending.pixelConstants[1] ? 2 : 1,
+                                      m_pending.pixelConstants.data());
       m_current.pixelConstants[0] = m_pending.pixelConstants[0];
       m_current.pixelConstants[1] = m_pending.pixelConstants[1];
     }
 
     if (m_current.vertexConstants != m_pending.vertexConstants)
     {
-      D3D::context->VSSetConstantBuffers(0, 1, &m_pending.vertexConstants);
+      m_context->VSSetConstantBuffers(0, 1, &m_pending.vertexConstants);
       m_current.vertexConstants = m_pending.vertexConstants;
     }
 
     if (m_current.geometryConstants != m_pending.geometryConstants)
     {
-      D3D::context->GSSetConstantBuffers(0, 1, &m_pending.geometryConstants);
+      m_context->GSSetConstantBuffers(0, 1, &m_pending.geometryConstants);
       m_current.geometryConstants = m_pending.geometryConstants;
     }
   }
@@ -160,8 +208,8 @@ void StateManager::Apply()
         m_current.vertexBufferStride != m_pending.vertexBufferStride ||
         m_current.vertexBufferOffset != m_pending.vertexBufferOffset)
     {
-      D3D::context->IASetVertexBuffers(0, 1, &m_pending.vertexBuffer, &m_pending.vertexBufferStride,
-                                       &m_pending.vertexBufferOffset);
+      m_context->IASetVertexBuffers(0, 1, &m_pending.vertexBuffer, &m_pending.vertexBufferStride,
+                                    &m_pending.vertexBufferOffset);
       m_current.vertexBuffer = m_pending.vertexBuffer;
       m_current.vertexBufferStride = m_pending.vertexBufferStride;
       m_current.vertexBufferOffset = m_pending.vertexBufferOffset;
@@ -169,19 +217,19 @@ void StateManager::Apply()
 
     if (m_current.indexBuffer != m_pending.indexBuffer)
     {
-      D3D::context->IASetIndexBuffer(m_pending.indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+      m_context->IASetIndexBuffer(m_pending.indexBuffer, DXGI_FORMAT_R16_UINT, 0);
       m_current.indexBuffer = m_pending.indexBuffer;
     }
 
     if (m_current.topology != m_pending.topology)
     {
-      D3D::context->IASetPrimitiveTopology(m_pending.topology);
+      m_context->IASetPrimitiveTopology(m_pending.topology);
       m_current.topology = m_pending.topology;
     }
 
     if (m_current.inputLayout != m_pending.inputLayout)
     {
-      D3D::context->IASetInputLayout(m_pending.inputLayout);
+      m_context->IASetInputLayout(m_pending.inputLayout);
       m_current.inputLayout = m_pending.inputLayout;
     }
   }
@@ -191,7 +239,7 @@ void StateManager::Apply()
     int index = LeastSignificantSetBit(dirtyTextures);
     if (m_current.textures[index] != m_pending.textures[index])
     {
-      D3D::context->PSSetShaderResources(index, 1, &m_pending.textures[index]);
+      m_context->PSSetShaderResources(index, 1, &m_pending.textures[index]);
       m_current.textures[index] = m_pending.textures[index];
     }
 
@@ -203,7 +251,7 @@ void StateManager::Apply()
     int index = LeastSignificantSetBit(dirtySamplers);
     if (m_current.samplers[index] != m_pending.samplers[index])
     {
-      D3D::context->PSSetSamplers(index, 1, &m_pending.samplers[index]);
+      m_context->PSSetSamplers(index, 1, &m_pending.samplers[index]);
       m_current.samplers[index] = m_pending.samplers[index];
     }
 
@@ -214,19 +262,19 @@ void StateManager::Apply()
   {
     if (m_current.pixelShader != m_pending.pixelShader)
     {
-      D3D::context->PSSetShader(m_pending.pixelShader, nullptr, 0);
+      m_context->PSSetShader(m_pending.pixelShader, nullptr, 0);
       m_current.pixelShader = m_pending.pixelShader;
     }
 
     if (m_current.vertexShader != m_pending.vertexShader)
     {
-      D3D::context->VSSetShader(m_pending.vertexShader, nullptr, 0);
+      m_context->VSSetShader(m_pending.vertexShader, nullptr, 0);
       m_current.vertexShader = m_pending.vertexShader;
     }
 
     if (m_current.geometryShader != m_pending.geometryShader)
     {
-      D3D::context->GSSetShader(m_pending.geometryShader, nullptr, 0);
+      m_context->GSSetShader(m_pending.geometryShader, nullptr, 0);
       m_current.geometryShader = m_pending.geometryShader;
     }
   }
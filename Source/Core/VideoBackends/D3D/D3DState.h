@@ -95,7 +95,35 @@ typedef AutoState<ID3D11RasterizerState> AutoRasterizerState;
 class StateManager
 {
 public:
-  StateManager();
+  struct Resources
+  {
+    std::array<ID3D11ShaderResourceView*, 8> textures;
+    std::array<ID3D11SamplerState*, 8> samplers;
+    std::array<ID3D11Buffer*, 2> pixelConstants;
+    ID3D11Buffer* vertexConstants;
+    ID3D11Buffer* geometryConstants;
+    ID3D11Buffer* vertexBuffer;
+    ID3D11Buffer* indexBuffer;
+    u32 vertexBufferStride;
+    u32 vertexBufferOffset;
+    D3D11_PRIMITIVE_TOPOLOGY topology;
+    ID3D11InputLayout* inputLayout;
+    ID3D11PixelShader* pixelShader;
+    ID3D11VertexShader* vertexShader;
+    ID3D11GeometryShader* geometryShader;
+  };
+
+  // Everything a draw depends on which is tracked here, so that it can be replayed on another
+  // context.
+  struct DrawState
+  {
+    Resources resources;
+    ID3D11BlendState* blendState;
+    ID3D11DepthStencilState* depthState;
+    ID3D11RasterizerState* rasterizerState;
+  };
+
+  explicit StateManager(ID3D11DeviceContext* context);
 
   // call any of these to change the affected states
   void PushBlendState(const ID3D11BlendState* state);
@@ -194,7 +222,7 @@ public:
   void SetPixelShaderDynamic(ID3D11PixelShader* shader, ID3D11ClassInstance* const* classInstances,
                              u32 classInstancesCount)
   {
-    D3D::context->PSSetShader(shader, classInstances, classInstancesCount);
+    m_context->PSSetShader(shader, classInstances, classInstancesCount);
     m_current.pixelShader = shader;
     m_pending.pixelShader = shader;
   }
@@ -223,7 +251,22 @@ public:
   // state changes
   void Apply();
 
+  // The pending resources along with the state objects on top of the stacks.
+  DrawState GetDrawState() const;
+
+  // Applies a state which was captured with GetDrawState, bypassing the state stacks.
+  void ApplyDrawState(const DrawState& state);
+
+  // Call when the state of the context was reset behind our back, e.g. by FinishCommandList.
+  void ForgetCurrentState();
+
 private:
+  void ApplyStateObjects(ID3D11BlendState* blend_state, ID3D11DepthStencilState* depth_state,
+                         ID3D11RasterizerState* rasterizer_state);
+  void ApplyResources();
+
+  ID3D11DeviceContext* m_context;
+
   std::stack<AutoBlendState> m_blendStates;
   std::stack<AutoDepthStencilState> m_depthStates;
   std::stack<AutoRasterizerState> m_rasterizerStates;
@@ -268,24 +311,6 @@ private:
 
   u32 m_dirtyFlags;
 
-  struct Resources
-  {
-    std::array<ID3D11ShaderResourceView*, 8> textures;
-    std::array<ID3D11SamplerState*, 8> samplers;
-    std::array<ID3D11Buffer*, 2> pixelConstants;
-    ID3D11Buffer* vertexConstants;
-    ID3D11Buffer* geometryConstants;
-    ID3D11Buffer* vertexBuffer;
-    ID3D11Buffer* indexBuffer;
-    u32 vertexBufferStride;
-    u32 vertexBufferOffset;
-    D3D11_PRIMITIVE_TOPOLOGY topology;
-    ID3D11InputLayout* inputLayout;
-    ID3D11PixelShader* pixelShader;
-    ID3D11VertexShader* vertexShader;
-    ID3D11GeometryShader* geometryShader;
-  };
-
   Resources m_pending;
   Resources m_current;
 };
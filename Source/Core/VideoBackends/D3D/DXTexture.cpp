@@ -14,6 +14,7 @@
 #include "VideoBackends/D3D/D3DTexture.h"
 #include "VideoBackends/D3D/D3DUtil.h"
 #include "VideoBackends/D3D/DXTexture.h"
+#include "VideoBackends/D3D/DeferredDraws.h"
 #include "VideoBackends/D3D/FramebufferManager.h"
 #include "VideoBackends/D3D/GeometryShaderCache.h"
 #include "VideoBackends/D3D/PixelShaderCache.h"
@@ -22,6 +23,7 @@
 
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/TextureConfig.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace DX11
 {
@@ -80,6 +82,8 @@ DXTexture::DXTexture(const TextureConfig& tex_config) : AbstractTexture(tex_conf
 
 DXTexture::~DXTexture()
 {
+  // Queued draws only hold a plain pointer to the view.
+  DeferredDraws::Flush();
   m_texture->Release();
 }
 
@@ -115,6 +119,7 @@ bool DXTexture::Save(const std::string& filename, unsigned int level)
   }
 
   // Copy the selected mip level to the staging texture.
+  DeferredDraws::Flush();
   CD3D11_BOX src_box(0, 0, 0, mip_width, mip_height, 1);
   D3D::context->CopySubresourceRegion(staging_texture, 0, 0, 0, 0, m_texture->GetTex(),
                                       D3D11CalcSubresource(level, 0, m_config.levels), &src_box);
@@ -129,12 +134,12 @@ bool DXTexture::Save(const std::string& filename, unsigned int level)
     return false;
   }
 
-  bool encode_result =
-      TextureToPng(reinterpret_cast<u8*>(map.pData), map.RowPitch, filename, mip_width, mip_height);
+  TextureToPngAsync(reinterpret_cast<u8*>(map.pData), map.RowPitch, filename, mip_width,
+                    mip_height, true, g_ActiveConfig.iPNGCompressionLevel);
   D3D::context->Unmap(staging_texture, 0);
   staging_texture->Release();
 
-  return encode_result;
+  return true;
 }
 
 void DXTexture::CopyRectangleFromTexture(const AbstractTexture* source,
@@ -152,6 +157,7 @@ void DXTexture::CopyRectangleFromTexture(const AbstractTexture* source,
     srcbox.front = 0;
     srcbox.back = srcentry->m_config.layers;
 
+    DeferredDraws::Flush();
     D3D::context->CopySubresourceRegion(m_texture->GetTex(), 0, dstrect.left, dstrect.top, 0,
                                         srcentry->m_texture->GetTex(), 0, &srcbox);
     return;
@@ -192,6 +198,7 @@ void DXTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
                      size_t buffer_size)
 {
   size_t src_pitch = CalculateHostTextureLevelPitch(m_config.format, row_length);
+  DeferredDraws::Flush();
   D3D::context->UpdateSubresource(m_texture->GetTex(), level, nullptr, buffer,
                                   static_cast<UINT>(src_pitch), 0);
 }
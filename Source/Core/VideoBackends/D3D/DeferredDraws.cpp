@@ -0,0 +1,272 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/D3D/DeferredDraws.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/MsgHandler.h"
+#include "Common/WorkerPool.h"
+
+#include "VideoBackends/D3D/D3DBase.h"
+#include "VideoBackends/D3D/D3DState.h"
+
+#include "VideoCommon/ConstantManager.h"
+#include "VideoCommon/GeometryShaderManager.h"
+#include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DX11
+{
+namespace
+{
+// Splitting the draws further costs more in command list overhead than recording them saves.
+constexpr size_t MINIMUM_DRAWS_PER_COMMAND_LIST = 128;
+
+struct Constants
+{
+  PixelShaderConstants pixel;
+  VertexShaderConstants vertex;
+  GeometryShaderConstants geometry;
+  bool pixel_lighting;
+};
+
+struct Draw
+{
+  D3D::StateManager::DrawState state;
+  D3D11_VIEWPORT viewport;
+  D3D11_RECT scissor;
+  size_t constants_index;
+  u32 index_count;
+  u32 start_index;
+  u32 base_vertex;
+};
+
+// Owns a deferred context along with the constant buffers its draws read from, as the immediate
+// context's ones are updated with WRITE_DISCARD for every change.
+class Recorder
+{
+public:
+  Recorder()
+  {
+    HRESULT hr = D3D::device->CreateDeferredContext(0, &m_context);
+    CHECK(SUCCEEDED(hr), "Create deferred context");
+    m_state = std::make_unique<D3D::StateManager>(m_context);
+
+    m_pixel_constants = CreateConstantBuffer(sizeof(PixelShaderConstants));
+    m_vertex_constants = CreateConstantBuffer(sizeof(VertexShaderConstants));
+    m_geometry_constants = CreateConstantBuffer(sizeof(GeometryShaderConstants));
+  }
+
+  ~Recorder()
+  {
+    SAFE_RELEASE(m_command_list);
+    SAFE_RELEASE(m_pixel_constants);
+    SAFE_RELEASE(m_vertex_constants);
+    SAFE_RELEASE(m_geometry_constants);
+    m_state.reset();
+    SAFE_RELEASE(m_context);
+  }
+
+  void Record(const Draw* draws, size_t num_draws, ID3D11RenderTargetView* rtv,
+              ID3D11DepthStencilView* dsv, const std::vector<Constants>& constants)
+  {
+    m_context->OMSetRenderTargets(1, &rtv, dsv);
+
+    size_t uploaded_constants = constants.size();
+    const D3D11_VIEWPORT* viewport = nullptr;
+    const D3D11_RECT* scissor = nullptr;
+    for (size_t i = 0; i < num_draws; ++i)
+    {
+      const Draw& draw = draws[i];
+      const Constants& draw_constants = constants[draw.constants_index];
+      if (draw.constants_index != uploaded_constants)
+      {
+        Upload(m_pixel_constants, &draw_constants.pixel, sizeof(draw_constants.pixel));
+        Upload(m_vertex_constants, &draw_constants.vertex, sizeof(draw_constants.vertex));
+        Upload(m_geometry_constants, &draw_constants.geometry, sizeof(draw_constants.geometry));
+        uploaded_constants = draw.constants_index;
+      }
+
+      if (!viewport || std::memcmp(viewport, &draw.viewport, sizeof(draw.viewport)))
+      {
+        m_context->RSSetViewports(1, &draw.viewport);
+        viewport = &draw.viewport;
+      }
+      if (!scissor || std::memcmp(scissor, &draw.scissor, sizeof(draw.scissor)))
+      {
+        m_context->RSSetScissorRects(1, &draw.scissor);
+        scissor = &draw.scissor;
+      }
+
+      D3D::StateManager::DrawState state = draw.state;
+      state.resources.pixelConstants[0] = m_pixel_constants;
+      state.resources.pixelConstants[1] =
+          draw_constants.pixel_lighting ? m_vertex_constants : nullptr;
+      state.resources.vertexConstants = m_vertex_constants;
+      state.resources.geometryConstants = m_geometry_constants;
+      m_state->ApplyDrawState(state);
+
+      m_context->DrawIndexed(draw.index_count, draw.start_index, draw.base_vertex);
+    }
+
+    // Leaves the deferred context in its default state, which the state manager has to know.
+    HRESULT hr = m_context->FinishCommandList(FALSE, &m_command_list);
+    CHECK(SUCCEEDED(hr), "Finish command list");
+    m_state->ForgetCurrentState();
+  }
+
+  void Execute()
+  {
+    if (!m_command_list)
+      return;
+
+    // Restoring the state of the immediate context afterwards keeps its state manager valid.
+    D3D::context->ExecuteCommandList(m_command_list, TRUE);
+    SAFE_RELEASE(m_command_list);
+  }
+
+private:
+  static ID3D11Buffer* CreateConstantBuffer(size_t size)
+  {
+    const UINT buffer_size = Common::AlignUp(static_cast<UINT>(size), 16u);
+    D3D11_BUFFER_DESC desc = CD3D11_BUFFER_DESC(buffer_size, D3D11_BIND_CONSTANT_BUFFER,
+                                                D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
+    ID3D11Buffer* buffer = nullptr;
+    HRESULT hr = D3D::device->CreateBuffer(&desc, nullptr, &buffer);
+    CHECK(SUCCEEDED(hr), "Create deferred constant buffer (size=%u)", buffer_size);
+    D3D::SetDebugObjectName(buffer, "constant buffer of a deferred context");
+    return buffer;
+  }
+
+  void Upload(ID3D11Buffer* buffer, const void* data, size_t size)
+  {
+    D3D11_MAPPED_SUBRESOURCE map;
+    m_context->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+    std::memcpy(map.pData, data, size);
+    m_context->Unmap(buffer, 0);
+  }
+
+  ID3D11DeviceContext* m_context = nullptr;
+  std::unique_ptr<D3D::StateManager> m_state;
+  ID3D11Buffer* m_pixel_constants = nullptr;
+  ID3D11Buffer* m_vertex_constants = nullptr;
+  ID3D11Buffer* m_geometry_constants = nullptr;
+  ID3D11CommandList* m_command_list = nullptr;
+};
+}  // Anonymous namespace
+
+static std::unique_ptr<Common::WorkerPool> s_recording_pool;
+static std::vector<std::unique_ptr<Recorder>> s_recorders;
+
+static std::vector<Draw> s_draws;
+static std::vector<Constants> s_constants;
+static ID3D11RenderTargetView* s_render_target;
+static ID3D11DepthStencilView* s_depth_stencil;
+
+void DeferredDraws::Init()
+{
+  UpdateThreads();
+}
+
+void DeferredDraws::Shutdown()
+{
+  Flush();
+  s_recorders.clear();
+  s_recording_pool.reset();
+}
+
+void DeferredDraws::UpdateThreads()
+{
+  const size_t num_workers =
+      static_cast<size_t>(std::max(g_ActiveConfig.iCommandRecordingThreads, 0));
+  if (s_recording_pool && s_recording_pool->GetNumWorkers() == num_workers)
+    return;
+
+  Flush();
+  s_recorders.clear();
+  s_recording_pool.reset();
+  if (num_workers == 0)
+    return;
+
+  // The thread which flushes records a share of the draws as well.
+  s_recording_pool = std::make_unique<Common::WorkerPool>(num_workers, Common::TaskPriority::High);
+  for (size_t i = 0; i < num_workers + 1; ++i)
+    s_recorders.push_back(std::make_unique<Recorder>());
+}
+
+bool DeferredDraws::IsEnabled()
+{
+  return s_recording_pool != nullptr;
+}
+
+void DeferredDraws::QueueDraw(u32 index_count, u32 start_index, u32 base_vertex)
+{
+  // Render targets are only changed by utility draws, which all flush first.
+  if (s_draws.empty())
+    D3D::context->OMGetRenderTargets(1, &s_render_target, &s_depth_stencil);
+
+  // The draws since the last flush use the constants as they were when they were queued. The
+  // dirty flags are consumed here, so Flush marks them again for the immediate context.
+  if (s_constants.empty() || PixelShaderManager::dirty || VertexShaderManager::dirty ||
+      GeometryShaderManager::dirty)
+  {
+    s_constants.push_back({PixelShaderManager::constants, VertexShaderManager::constants,
+                           GeometryShaderManager::constants, g_ActiveConfig.bEnablePixelLighting});
+    PixelShaderManager::dirty = false;
+    VertexShaderManager::dirty = false;
+    GeometryShaderManager::dirty = false;
+
+    ADDSTAT(stats.thisFrame.bytesUniformStreamed, sizeof(Constants));
+  }
+
+  Draw draw;
+  draw.state = D3D::stateman->GetDrawState();
+  UINT num_viewports = 1;
+  D3D::context->RSGetViewports(&num_viewports, &draw.viewport);
+  UINT num_scissors = 1;
+  D3D::context->RSGetScissorRects(&num_scissors, &draw.scissor);
+  draw.constants_index = s_constants.size() - 1;
+  draw.index_count = index_count;
+  draw.start_index = start_index;
+  draw.base_vertex = base_vertex;
+  s_draws.push_back(draw);
+}
+
+void DeferredDraws::Flush()
+{
+  if (s_draws.empty())
+    return;
+
+  const size_t num_lists =
+      std::max(std::min(s_draws.size() / MINIMUM_DRAWS_PER_COMMAND_LIST, s_recorders.size()),
+               size_t(1));
+  const size_t draws_per_list = (s_draws.size() + num_lists - 1) / num_lists;
+  s_recording_pool->Run(num_lists, [draws_per_list](size_t i) {
+    const size_t first = i * draws_per_list;
+    const size_t count = std::min(draws_per_list, s_draws.size() - first);
+    s_recorders[i]->Record(&s_draws[first], count, s_render_target, s_depth_stencil, s_constants);
+  });
+
+  // The command lists are executed in order, so the draws are too.
+  for (size_t i = 0; i < num_lists; ++i)
+    s_recorders[i]->Execute();
+
+  SAFE_RELEASE(s_render_target);
+  SAFE_RELEASE(s_depth_stencil);
+  s_draws.clear();
+  s_constants.clear();
+
+  PixelShaderManager::dirty = true;
+  VertexShaderManager::dirty = true;
+  GeometryShaderManager::dirty = true;
+}
+}  // namespace DX11
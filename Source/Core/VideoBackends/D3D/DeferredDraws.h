@@ -0,0 +1,33 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DX11
+{
+// Queues the draws of the vertex manager instead of submitting them on the immediate context, and
+// records them into command lists on deferred contexts from several threads when flushed.
+// Enabled by iCommandRecordingThreads.
+class DeferredDraws
+{
+public:
+  static void Init();
+  static void Shutdown();
+
+  // Creates or destroys the deferred contexts when the number of threads has been changed.
+  static void UpdateThreads();
+
+  static bool IsEnabled();
+
+  // Queues a draw with the state which is pending in the state manager, the current viewport and
+  // scissor rectangle, and the current shader constants.
+  static void QueueDraw(u32 index_count, u32 start_index, u32 base_vertex);
+
+  // Records and executes the queued draws. Must be called before the immediate context does
+  // anything which the queued draws would observe, or which would observe them.
+  static void Flush();
+};
+}
@@ -11,6 +11,7 @@
 #include "VideoBackends/D3D/D3DBase.h"
 #include "VideoBackends/D3D/D3DState.h"
 #include "VideoBackends/D3D/D3DUtil.h"
+#include "VideoBackends/D3D/DeferredDraws.h"
 #include "VideoBackends/D3D/GeometryShaderCache.h"
 #include "VideoBackends/D3D/PixelShaderCache.h"
 #include "VideoBackends/D3D/Render.h"
@@ -56,6 +57,7 @@ D3DTexture2D*& FramebufferManager::GetResolvedEFBColorTexture()
 {
   if (g_ActiveConfig.iMultisamples > 1)
   {
+    DeferredDraws::Flush();
     for (int i = 0; i < m_efb.slices; i++)
       D3D::context->ResolveSubresource(m_efb.resolved_color_tex->GetTex(),
                                        D3D11CalcSubresource(0, i, 1), m_efb.color_tex->GetTex(),
@@ -152,7 +154,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
                           "EFB color temp texture render target view");
 
   // Render buffer for AccessEFB (color data)
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, 1, D3D11_BIND_RENDER_TARGET);
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, EFB_CACHE_RECT_SIZE,
+                                  EFB_CACHE_RECT_SIZE, 1, 1, D3D11_BIND_RENDER_TARGET);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &buf);
   CHECK(hr == S_OK, "create EFB color read texture (hr=%#x)", hr);
   m_efb.color_read_texture = new D3DTexture2D(buf, D3D11_BIND_RENDER_TARGET);
@@ -164,7 +167,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
       "EFB color read texture render target view (used in Renderer::AccessEFB)");
 
   // AccessEFB - Sysmem buffer used to retrieve the pixel data from depth_read_texture
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, 1, 0, D3D11_USAGE_STAGING,
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, EFB_CACHE_RECT_SIZE,
+                                  EFB_CACHE_RECT_SIZE, 1, 1, 0, D3D11_USAGE_STAGING,
                                   D3D11_CPU_ACCESS_READ);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &m_efb.color_staging_buf);
   CHECK(hr == S_OK, "create EFB color staging buffer (hr=%#x)", hr);
@@ -190,7 +194,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
                           "EFB depth texture shader resource view");
 
   // Render buffer for AccessEFB (depth data)
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, 1, 1, 1, 1, D3D11_BIND_RENDER_TARGET);
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, EFB_CACHE_RECT_SIZE, EFB_CACHE_RECT_SIZE,
+                                  1, 1, D3D11_BIND_RENDER_TARGET);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &buf);
   CHECK(hr == S_OK, "create EFB depth read texture (hr=%#x)", hr);
   m_efb.depth_read_texture = new D3DTexture2D(buf, D3D11_BIND_RENDER_TARGET);
@@ -202,8 +207,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
       "EFB depth read texture render target view (used in Renderer::AccessEFB)");
 
   // AccessEFB - Sysmem buffer used to retrieve the pixel data from depth_read_texture
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, 1, 1, 1, 1, 0, D3D11_USAGE_STAGING,
-                                  D3D11_CPU_ACCESS_READ);
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, EFB_CACHE_RECT_SIZE, EFB_CACHE_RECT_SIZE,
+                                  1, 1, 0, D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &m_efb.depth_staging_buf);
   CHECK(hr == S_OK, "create EFB depth staging buffer (hr=%#x)", hr);
   D3D::SetDebugObjectName((ID3D11DeviceChild*)m_efb.depth_staging_buf,
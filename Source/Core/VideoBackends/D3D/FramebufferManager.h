@@ -60,6 +60,9 @@ struct XFBSource : public XFBSourceBase
 class FramebufferManager : public FramebufferManagerBase
 {
 public:
+  // EFB peeks read back blocks of this many EFB pixels in each direction.
+  static const u32 EFB_CACHE_RECT_SIZE = 64;
+
   FramebufferManager(int target_width, int target_height);
   ~FramebufferManager();
 
@@ -4,6 +4,8 @@
 
 #include "VideoBackends/D3D/PSTextureEncoder.h"
 
+#include <memory>
+
 #include "Common/Logging/Log.h"
 #include "Core/HW/Memmap.h"
 #include "VideoBackends/D3D/D3DBase.h"
@@ -28,6 +30,34 @@ struct EFBEncodeParams
   DWORD ScaleFactor;
 };
 
+class PSTextureEncoder::PendingEncode final : public TextureCacheBase::PendingEFBCopy
+{
+public:
+  PendingEncode(PSTextureEncoder* encoder, ID3D11Texture2D* staging_texture, u8* dst,
+                u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride)
+      : m_encoder(encoder), m_staging_texture(staging_texture), m_dst(dst),
+        m_bytes_per_row(bytes_per_row), m_num_blocks_y(num_blocks_y), m_memory_stride(memory_stride)
+  {
+  }
+
+  ~PendingEncode() override { m_encoder->m_deferred_stages.push_back(m_staging_texture); }
+
+  // Mapping the staging texture waits for the GPU to finish the copy.
+  void Flush() override
+  {
+    ReadStagingTexture(m_staging_texture, m_dst, m_bytes_per_row, m_num_blocks_y,
+                       m_memory_stride);
+  }
+
+private:
+  PSTextureEncoder* m_encoder;
+  ID3D11Texture2D* m_staging_texture;
+  u8* m_dst;
+  u32 m_bytes_per_row;
+  u32 m_num_blocks_y;
+  u32 m_memory_stride;
+};
+
 PSTextureEncoder::PSTextureEncoder()
     : m_ready(false), m_out(nullptr), m_outRTV(nullptr), m_outStage(nullptr),
       m_encodeParams(nullptr)
@@ -55,12 +85,7 @@ void PSTextureEncoder::Init()
   D3D::SetDebugObjectName(m_outRTV, "efb encoder output rtv");
 
   // Create output staging buffer
-  t2dd.Usage = D3D11_USAGE_STAGING;
-  t2dd.BindFlags = 0;
-  t2dd.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-  hr = D3D::device->CreateTexture2D(&t2dd, nullptr, &m_outStage);
-  CHECK(SUCCEEDED(hr), "create efb encode output staging buffer");
-  D3D::SetDebugObjectName(m_outStage, "efb encoder output staging buffer");
+  m_outStage = CreateStagingTexture();
 
   // Create constant buffer for uploading data to shaders
   D3D11_BUFFER_DESC bd = CD3D11_BUFFER_DESC(sizeof(EFBEncodeParams), D3D11_BIND_CONSTANT_BUFFER);
@@ -81,12 +106,31 @@ void PSTextureEncoder::Shutdown()
   }
   m_encoding_shaders.clear();
 
+  for (ID3D11Texture2D* staging_texture : m_deferred_stages)
+    staging_texture->Release();
+  m_deferred_stages.clear();
+
   SAFE_RELEASE(m_encodeParams);
   SAFE_RELEASE(m_outStage);
   SAFE_RELEASE(m_outRTV);
   SAFE_RELEASE(m_out);
 }
 
+ID3D11Texture2D* PSTextureEncoder::CreateStagingTexture()
+{
+  D3D11_TEXTURE2D_DESC t2dd = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_B8G8R8A8_UNORM, EFB_WIDTH * 4,
+                                                    EFB_HEIGHT / 4, 1, 1, 0, D3D11_USAGE_STAGING,
+                                                    D3D11_CPU_ACCESS_READ);
+  ID3D11Texture2D* staging_texture = nullptr;
+  HRESULT hr = D3D::device->CreateTexture2D(&t2dd, nullptr, &staging_texture);
+  CHECK(SUCCEEDED(hr), "create efb encode output staging buffer");
+  if (FAILED(hr))
+    return nullptr;
+
+  D3D::SetDebugObjectName(staging_texture, "efb encoder output staging buffer");
+  return staging_texture;
+}
+
 void PSTextureEncoder::Encode(u8* dst, const EFBCopyParams& params, u32 native_width,
                               u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
                               const EFBRectangle& src_rect, bool scale_by_half)
@@ -94,8 +138,43 @@ void PSTextureEncoder::Encode(u8* dst, const EFBCopyParams& params, u32 native_w
   if (!m_ready)  // Make sure we initialized OK
     return;
 
-  HRESULT hr;
+  EncodeToStagingTexture(m_outStage, params, native_width, bytes_per_row, num_blocks_y, src_rect,
+                         scale_by_half);
+  ReadStagingTexture(m_outStage, dst, bytes_per_row, num_blocks_y, memory_stride);
+}
+
+std::unique_ptr<TextureCacheBase::PendingEFBCopy>
+PSTextureEncoder::EncodeDeferred(u8* dst, const EFBCopyParams& params, u32 native_width,
+                                 u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+                                 const EFBRectangle& src_rect, bool scale_by_half)
+{
+  if (!m_ready)
+    return nullptr;
+
+  ID3D11Texture2D* staging_texture;
+  if (!m_deferred_stages.empty())
+  {
+    staging_texture = m_deferred_stages.back();
+    m_deferred_stages.pop_back();
+  }
+  else
+  {
+    staging_texture = CreateStagingTexture();
+    if (!staging_texture)
+      return nullptr;
+  }
 
+  EncodeToStagingTexture(staging_texture, params, native_width, bytes_per_row, num_blocks_y,
+                         src_rect, scale_by_half);
+  return std::make_unique<PendingEncode>(this, staging_texture, dst, bytes_per_row, num_blocks_y,
+                                         memory_stride);
+}
+
+void PSTextureEncoder::EncodeToStagingTexture(ID3D11Texture2D* staging_texture,
+                                              const EFBCopyParams& params, u32 native_width,
+                                              u32 bytes_per_row, u32 num_blocks_y,
+                                              const EFBRectangle& src_rect, bool scale_by_half)
+{
   // Resolve MSAA targets before copying.
   // FIXME: Instead of resolving EFB, it would be better to pick out a
   // single sample from each pixel. The game may break if it isn't
@@ -143,23 +222,7 @@ void PSTextureEncoder::Encode(u8* dst, const EFBCopyParams& params, u32 native_w
 
     // Copy to staging buffer
     D3D11_BOX srcBox = CD3D11_BOX(0, 0, 0, words_per_row, num_blocks_y, 1);
-    D3D::context->CopySubresourceRegion(m_outStage, 0, 0, 0, 0, m_out, 0, &srcBox);
-
-    // Transfer staging buffer to GameCube/Wii RAM
-    D3D11_MAPPED_SUBRESOURCE map = {0};
-    hr = D3D::context->Map(m_outStage, 0, D3D11_MAP_READ, 0, &map);
-    CHECK(SUCCEEDED(hr), "map staging buffer (0x%x)", hr);
-
-    u8* src = (u8*)map.pData;
-    u32 readStride = std::min(bytes_per_row, map.RowPitch);
-    for (unsigned int y = 0; y < num_blocks_y; ++y)
-    {
-      memcpy(dst, src, readStride);
-      dst += memory_stride;
-      src += map.RowPitch;
-    }
-
-    D3D::context->Unmap(m_outStage, 0);
+    D3D::context->CopySubresourceRegion(staging_texture, 0, 0, 0, 0, m_out, 0, &srcBox);
   }
 
   // Restore API
@@ -168,6 +231,26 @@ void PSTextureEncoder::Encode(u8* dst, const EFBCopyParams& params, u32 native_w
                                    FramebufferManager::GetEFBDepthTexture()->GetDSV());
 }
 
+void PSTextureEncoder::ReadStagingTexture(ID3D11Texture2D* staging_texture, u8* dst,
+                                          u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride)
+{
+  // Transfer staging buffer to GameCube/Wii RAM
+  D3D11_MAPPED_SUBRESOURCE map = {0};
+  HRESULT hr = D3D::context->Map(staging_texture, 0, D3D11_MAP_READ, 0, &map);
+  CHECK(SUCCEEDED(hr), "map staging buffer (0x%x)", hr);
+
+  u8* src = (u8*)map.pData;
+  u32 readStride = std::min(bytes_per_row, map.RowPitch);
+  for (unsigned int y = 0; y < num_blocks_y; ++y)
+  {
+    memcpy(dst, src, readStride);
+    dst += memory_stride;
+    src += map.RowPitch;
+  }
+
+  D3D::context->Unmap(staging_texture, 0);
+}
+
 ID3D11PixelShader* PSTextureEncoder::GetEncodingPixelShader(const EFBCopyParams& params)
 {
   auto iter = m_encoding_shaders.find(params);
@@ -5,8 +5,11 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureConversionShader.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -35,9 +38,23 @@ public:
   void Encode(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
               u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
               bool scale_by_half);
+  // Like Encode, but doesn't wait for the GPU. The copy only reaches dst once the returned object
+  // is flushed.
+  std::unique_ptr<TextureCacheBase::PendingEFBCopy>
+  EncodeDeferred(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
+                 u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
+                 bool scale_by_half);
 
 private:
+  class PendingEncode;
+
   ID3D11PixelShader* GetEncodingPixelShader(const EFBCopyParams& params);
+  ID3D11Texture2D* CreateStagingTexture();
+  void EncodeToStagingTexture(ID3D11Texture2D* staging_texture, const EFBCopyParams& params,
+                              u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
+                              const EFBRectangle& src_rect, bool scale_by_half);
+  static void ReadStagingTexture(ID3D11Texture2D* staging_texture, u8* dst, u32 bytes_per_row,
+                                 u32 num_blocks_y, u32 memory_stride);
 
   bool m_ready;
 
@@ -46,5 +63,7 @@ private:
   ID3D11Texture2D* m_outStage;
   ID3D11Buffer* m_encodeParams;
   std::map<EFBCopyParams, ID3D11PixelShader*> m_encoding_shaders;
+  // Staging textures for deferred copies which aren't in use.
+  std::vector<ID3D11Texture2D*> m_deferred_stages;
 };
 }
@@ -7,6 +7,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "VideoBackends/D3D/D3DBase.h"
+#include "VideoBackends/D3D/DeferredDraws.h"
 #include "VideoCommon/RenderBase.h"
 
 namespace DX11
@@ -49,8 +50,11 @@ void PerfQuery::EnableQuery(PerfQueryGroup type)
   {
     auto& entry = m_query_buffer[(m_query_read_pos + m_query_count) % m_query_buffer.size()];
 
+    // Only the draws after this one may be counted.
+    DeferredDraws::Flush();
     D3D::context->Begin(entry.query);
     entry.query_type = type;
+    entry.period = AddPendingQuery();
 
     ++m_query_count;
   }
@@ -63,14 +67,26 @@ void PerfQuery::DisableQuery(PerfQueryGroup type)
   {
     auto& entry = m_query_buffer[(m_query_read_pos + m_query_count + m_query_buffer.size() - 1) %
                                  m_query_buffer.size()];
+    DeferredDraws::Flush();
     D3D::context->End(entry.query);
   }
 }
 
 void PerfQuery::ResetQuery()
 {
-  m_query_count = 0;
-  std::fill_n(m_results, ArraySize(m_results), 0);
+  // In delayed mode, the queries of the current period are left running. Only the ones from
+  // before the previous reset are waited for, and those have had a whole period to complete.
+  if (ShouldDelayResults())
+  {
+    while (IsPreviousPeriodPending() && !IsFlushed())
+      FlushOne();
+  }
+  else
+  {
+    m_query_count = 0;
+  }
+
+  BeginPeriod();
 }
 
 u32 PerfQuery::GetQueryResult(PerfQueryType type)
@@ -78,13 +94,13 @@ u32 PerfQuery::GetQueryResult(PerfQueryType type)
   u32 result = 0;
 
   if (type == PQ_ZCOMP_INPUT_ZCOMPLOC || type == PQ_ZCOMP_OUTPUT_ZCOMPLOC)
-    result = m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP_ZCOMPLOC);
   else if (type == PQ_ZCOMP_INPUT || type == PQ_ZCOMP_OUTPUT)
-    result = m_results[PQG_ZCOMP];
+    result = GetResult(PQG_ZCOMP);
   else if (type == PQ_BLEND_INPUT)
-    result = m_results[PQG_ZCOMP] + m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP) + GetResult(PQG_ZCOMP_ZCOMPLOC);
   else if (type == PQ_EFB_COPY_CLOCKS)
-    result = m_results[PQG_EFB_COPY_CLOCKS];
+    result = GetResult(PQG_EFB_COPY_CLOCKS);
 
   return result;
 }
@@ -104,8 +120,9 @@ void PerfQuery::FlushOne()
   // NOTE: Reported pixel metrics should be referenced to native resolution
   // TODO: Dropping the lower 2 bits from this count should be closer to actual
   // hardware behavior when drawing triangles.
-  m_results[entry.query_type] += (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() *
-                                       EFB_HEIGHT / g_renderer->GetTargetHeight());
+  AddResult(entry.period, entry.query_type,
+            (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() * EFB_HEIGHT /
+                  g_renderer->GetTargetHeight()));
 
   m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
   --m_query_count;
@@ -131,8 +148,9 @@ void PerfQuery::WeakFlush()
     if (hr == S_OK)
     {
       // NOTE: Reported pixel metrics should be referenced to native resolution
-      m_results[entry.query_type] += (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() *
-                                           EFB_HEIGHT / g_renderer->GetTargetHeight());
+      AddResult(entry.period, entry.query_type,
+                (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() * EFB_HEIGHT /
+                      g_renderer->GetTargetHeight()));
 
       m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
       --m_query_count;
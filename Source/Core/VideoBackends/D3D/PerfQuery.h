@@ -29,6 +29,7 @@ private:
   {
     ID3D11Query* query;
     PerfQueryGroup query_type;
+    u32 period;
   };
 
   void WeakFlush();
@@ -4,6 +4,7 @@
 
 #include "VideoBackends/D3D/Render.h"
 
+#include <algorithm>
 #include <array>
 #include <cinttypes>
 #include <cmath>
@@ -13,6 +14,7 @@
 #include <strsafe.h>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -24,6 +26,7 @@
 #include "VideoBackends/D3D/D3DBase.h"
 #include "VideoBackends/D3D/D3DState.h"
 #include "VideoBackends/D3D/D3DUtil.h"
+#include "VideoBackends/D3D/DeferredDraws.h"
 #include "VideoBackends/D3D/FramebufferManager.h"
 #include "VideoBackends/D3D/GeometryShaderCache.h"
 #include "VideoBackends/D3D/PixelShaderCache.h"
@@ -37,6 +40,7 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/SamplerCommon.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
@@ -82,6 +86,15 @@ static D3DTexture2D* s_3d_vision_texture = nullptr;
 static GXPipelineState s_gx_state;
 static StateCache s_gx_state_cache;
 
+static const u32 EFB_CACHE_RECT_SIZE = FramebufferManager::EFB_CACHE_RECT_SIZE;
+static const u32 EFB_CACHE_WIDTH = (EFB_WIDTH + EFB_CACHE_RECT_SIZE - 1) / EFB_CACHE_RECT_SIZE;
+static const u32 EFB_CACHE_HEIGHT = (EFB_HEIGHT + EFB_CACHE_RECT_SIZE - 1) / EFB_CACHE_RECT_SIZE;
+// Index 0 is for PeekZ, index 1 for PeekColor. The cache holds the whole EFB, but only the blocks
+// which have been read back are valid.
+static std::array<std::array<bool, EFB_CACHE_WIDTH * EFB_CACHE_HEIGHT>, 2> s_efb_cache_valid;
+static std::array<std::vector<u32>, 2> s_efb_cache;
+static bool s_efb_cache_is_cleared = false;
+
 static void SetupDeviceObjects()
 {
   s_television.Init();
@@ -242,6 +255,7 @@ Renderer::Renderer() : ::Renderer(D3D::GetBackBufferWidth(), D3D::GetBackBufferH
   s_last_stereo_mode = g_ActiveConfig.iStereoMode > 0;
   s_last_xfb_mode = g_ActiveConfig.bUseRealXFB;
   s_last_fullscreen_mode = D3D::GetFullscreenState();
+  ClearEFBCache();
 
   g_framebuffer_manager = std::make_unique<FramebufferManager>(m_target_width, m_target_height);
   SetupDeviceObjects();
@@ -329,6 +343,16 @@ void Renderer::SetScissorRect(const EFBRectangle& rc)
   D3D::context->RSSetScissorRects(1, trc.AsRECT());
 }
 
+void ClearEFBCache()
+{
+  if (!s_efb_cache_is_cleared)
+  {
+    s_efb_cache_is_cleared = true;
+    for (auto& valid : s_efb_cache_valid)
+      valid.fill(false);
+  }
+}
+
 void Renderer::SetColorMask()
 {
   // Only enable alpha channel if it's supported by the current EFB format
@@ -360,36 +384,74 @@ void Renderer::SetColorMask()
 //  - GX_PokeZMode (TODO)
 u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 {
-  // Convert EFB dimensions to the ones of our render target
-  EFBRectangle efbPixelRc;
-  efbPixelRc.left = x;
-  efbPixelRc.top = y;
-  efbPixelRc.right = x + 1;
-  efbPixelRc.bottom = y + 1;
-  TargetRectangle targetPixelRc = Renderer::ConvertEFBRectangle(efbPixelRc);
-
-  // Take the mean of the resulting dimensions; TODO: Don't use the center pixel, compute the
-  // average color instead
-  D3D11_RECT RectToLock;
-  if (type == EFBAccessType::PeekColor || type == EFBAccessType::PeekZ)
+  // Coordinates outside of the EFB read the closest pixel inside of it.
+  x = std::min<u32>(x, EFB_WIDTH - 1);
+  y = std::min<u32>(y, EFB_HEIGHT - 1);
+
+  const u32 cache_type = type == EFBAccessType::PeekZ ? 0 : 1;
+  const u32 cache_rect_idx = (y / EFB_CACHE_RECT_SIZE) * EFB_CACHE_WIDTH + x / EFB_CACHE_RECT_SIZE;
+  if (!s_efb_cache_valid[cache_type][cache_rect_idx])
+    UpdateEFBCache(type, x, y);
+
+  // Convert the framebuffer data to the format the game is expecting to receive.
+  u32 ret;
+  if (type == EFBAccessType::PeekColor)
   {
-    RectToLock.left = (targetPixelRc.left + targetPixelRc.right) / 2;
-    RectToLock.top = (targetPixelRc.top + targetPixelRc.bottom) / 2;
-    RectToLock.right = RectToLock.left + 1;
-    RectToLock.bottom = RectToLock.top + 1;
+    u32 val = s_efb_cache[cache_type][y * EFB_WIDTH + x];
+
+    // check what to do with the alpha channel (GX_PokeAlphaRead)
+    PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
+
+    if (bpmem.zcontrol.pixel_format == PEControl::RGBA6_Z24)
+    {
+      val = RGBA8ToRGBA6ToRGBA8(val);
+    }
+    else if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
+    {
+      val = RGBA8ToRGB565ToRGBA8(val);
+    }
+    if (bpmem.zcontrol.pixel_format != PEControl::RGBA6_Z24)
+    {
+      val |= 0xFF000000;
+    }
+
+    if (alpha_read_mode.ReadMode == 2)
+      ret = val;  // GX_READ_NONE
+    else if (alpha_read_mode.ReadMode == 1)
+      ret = (val | 0xFF000000);  // GX_READ_FF
+    else                         /*if(alpha_read_mode.ReadMode == 0)*/
+      ret = (val & 0x00FFFFFF);  // GX_READ_00
   }
-  else
+  else  // type == EFBAccessType::PeekZ
   {
-    RectToLock.left = targetPixelRc.left;
-    RectToLock.right = targetPixelRc.right;
-    RectToLock.top = targetPixelRc.top;
-    RectToLock.bottom = targetPixelRc.bottom;
+    ret = s_efb_cache[cache_type][y * EFB_WIDTH + x];
+
+    // if Z is in 16 bit format you must return a 16 bit integer
+    if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
+      ret >>= 8;
   }
 
+  return ret;
+}
+
+// Reads back the block of the EFB which contains the pixel at x, y with a single copy.
+void Renderer::UpdateEFBCache(EFBAccessType type, u32 x, u32 y)
+{
+  EFBRectangle efb_rc;
+  efb_rc.left = (x / EFB_CACHE_RECT_SIZE) * EFB_CACHE_RECT_SIZE;
+  efb_rc.top = (y / EFB_CACHE_RECT_SIZE) * EFB_CACHE_RECT_SIZE;
+  efb_rc.right = std::min<u32>(efb_rc.left + EFB_CACHE_RECT_SIZE, EFB_WIDTH);
+  efb_rc.bottom = std::min<u32>(efb_rc.top + EFB_CACHE_RECT_SIZE, EFB_HEIGHT);
+  const u32 width = efb_rc.GetWidth();
+  const u32 height = efb_rc.GetHeight();
+  TargetRectangle target_rc = Renderer::ConvertEFBRectangle(efb_rc);
+
   // Reset any game specific settings.
   ResetAPIState();
-  D3D11_VIEWPORT vp = CD3D11_VIEWPORT(0.f, 0.f, 1.f, 1.f);
+  D3D11_VIEWPORT vp = CD3D11_VIEWPORT(0.f, 0.f, static_cast<float>(width),
+                                      static_cast<float>(height));
   D3D::context->RSSetViewports(1, &vp);
+  // Point sampling reads the pixel closest to the center of each EFB pixel at higher resolutions.
   D3D::SetPointCopySampler();
 
   // Select copy and read textures depending on if we are doing a color or depth read (since they
@@ -417,9 +479,9 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
   else
     copy_pixel_shader = PixelShaderCache::GetColorCopyProgram(true);
 
-  // Draw a quad to grab the texel we want to read.
+  // Draw a quad to downscale the block to one texel per EFB pixel.
   D3D::context->OMSetRenderTargets(1, &read_tex->GetRTV(), nullptr);
-  D3D::drawShadedTexQuad(source_tex->GetSRV(), &RectToLock, Renderer::GetTargetWidth(),
+  D3D::drawShadedTexQuad(source_tex->GetSRV(), target_rc.AsRECT(), Renderer::GetTargetWidth(),
                          Renderer::GetTargetHeight(), copy_pixel_shader,
                          VertexShaderCache::GetSimpleVertexShader(),
                          VertexShaderCache::GetSimpleInputLayout());
@@ -429,71 +491,54 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
                                    FramebufferManager::GetEFBDepthTexture()->GetDSV());
   RestoreAPIState();
 
-  // Copy the pixel from the renderable to cpu-readable buffer.
-  D3D11_BOX box = CD3D11_BOX(0, 0, 0, 1, 1, 1);
+  // Copy the block from the renderable to cpu-readable buffer.
+  D3D11_BOX box = CD3D11_BOX(0, 0, 0, width, height, 1);
   D3D::context->CopySubresourceRegion(staging_tex, 0, 0, 0, 0, read_tex->GetTex(), 0, &box);
   D3D11_MAPPED_SUBRESOURCE map;
   CHECK(D3D::context->Map(staging_tex, 0, D3D11_MAP_READ, 0, &map) == S_OK,
         "Map staging buffer failed");
 
-  // Convert the framebuffer data to the format the game is expecting to receive.
-  u32 ret;
-  if (type == EFBAccessType::PeekColor)
-  {
-    u32 val;
-    memcpy(&val, map.pData, sizeof(val));
-
-    // our buffers are RGBA, yet a BGRA value is expected
-    val = ((val & 0xFF00FF00) | ((val >> 16) & 0xFF) | ((val << 16) & 0xFF0000));
-
-    // check what to do with the alpha channel (GX_PokeAlphaRead)
-    PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
-
-    if (bpmem.zcontrol.pixel_format == PEControl::RGBA6_Z24)
-    {
-      val = RGBA8ToRGBA6ToRGBA8(val);
-    }
-    else if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
-    {
-      val = RGBA8ToRGB565ToRGBA8(val);
-    }
-    if (bpmem.zcontrol.pixel_format != PEControl::RGBA6_Z24)
-    {
-      val |= 0xFF000000;
-    }
+  const u32 cache_type = type == EFBAccessType::PeekZ ? 0 : 1;
+  std::vector<u32>& cache = s_efb_cache[cache_type];
+  if (cache.empty())
+    cache.resize(EFB_WIDTH * EFB_HEIGHT);
 
-    if (alpha_read_mode.ReadMode == 2)
-      ret = val;  // GX_READ_NONE
-    else if (alpha_read_mode.ReadMode == 1)
-      ret = (val | 0xFF000000);  // GX_READ_FF
-    else                         /*if(alpha_read_mode.ReadMode == 0)*/
-      ret = (val & 0x00FFFFFF);  // GX_READ_00
-  }
-  else  // type == EFBAccessType::PeekZ
+  for (u32 row = 0; row < height; ++row)
   {
-    float val;
-    memcpy(&val, map.pData, sizeof(val));
-
-    // depth buffer is inverted in the d3d backend
-    val = 1.0f - val;
-
-    if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
+    const u8* src = static_cast<const u8*>(map.pData) + row * map.RowPitch;
+    u32* dst = &cache[(efb_rc.top + row) * EFB_WIDTH + efb_rc.left];
+    for (u32 col = 0; col < width; ++col)
     {
-      // if Z is in 16 bit format you must return a 16 bit integer
-      ret = MathUtil::Clamp<u32>(static_cast<u32>(val * 65536.0f), 0, 0xFFFF);
-    }
-    else
-    {
-      ret = MathUtil::Clamp<u32>(static_cast<u32>(val * 16777216.0f), 0, 0xFFFFFF);
+      if (type == EFBAccessType::PeekColor)
+      {
+        u32 val;
+        memcpy(&val, src + col * sizeof(u32), sizeof(val));
+
+        // our buffers are RGBA, yet a BGRA value is expected
+        dst[col] = ((val & 0xFF00FF00) | ((val >> 16) & 0xFF) | ((val << 16) & 0xFF0000));
+      }
+      else
+      {
+        float val;
+        memcpy(&val, src + col * sizeof(float), sizeof(val));
+
+        // depth buffer is inverted in the d3d backend
+        val = 1.0f - val;
+        dst[col] = MathUtil::Clamp<u32>(static_cast<u32>(val * 16777216.0f), 0, 0xFFFFFF);
+      }
     }
   }
 
   D3D::context->Unmap(staging_tex, 0);
-  return ret;
+
+  const u32 cache_rect_idx = (y / EFB_CACHE_RECT_SIZE) * EFB_CACHE_WIDTH + x / EFB_CACHE_RECT_SIZE;
+  s_efb_cache_valid[cache_type][cache_rect_idx] = true;
+  s_efb_cache_is_cleared = false;
 }
 
 void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points)
 {
+  ClearEFBCache();
   ResetAPIState();
 
   if (type == EFBAccessType::PokeColor)
@@ -588,6 +633,7 @@ void Renderer::SetViewport()
 void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaEnable, bool zEnable,
                            u32 color, u32 z)
 {
+  ClearEFBCache();
   ResetAPIState();
 
   if (colorEnable && alphaEnable)
@@ -642,6 +688,7 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
   }
 
   // convert data and set the target texture as our new EFB
+  ClearEFBCache();
   ResetAPIState();
 
   D3D11_VIEWPORT vp = CD3D11_VIEWPORT(0.f, 0.f, static_cast<float>(GetTargetWidth()),
@@ -709,6 +756,9 @@ void Renderer::SetBlendMode(bool forceUpdate)
 void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
                         const EFBRectangle& rc, u64 ticks, float Gamma)
 {
+  // Peeks are only cached across draws for the rest of the frame.
+  ClearEFBCache();
+
   if ((!m_xfb_written && !g_ActiveConfig.RealXFBEnabled()) || !fbWidth || !fbHeight)
   {
     Core::Callback_VideoCopiedToXFB(false);
@@ -817,7 +867,6 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
     AVIDump::Frame state = AVIDump::FetchState(ticks);
     DumpFrameData(reinterpret_cast<const u8*>(map.pData), source_width, source_height, map.RowPitch,
                   state);
-    FinishFrameData();
 
     D3D::context->Unmap(s_screenshot_texture, 0);
   }
@@ -838,6 +887,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   UpdateActiveConfig();
   g_texture_cache->OnConfigChanged(g_ActiveConfig);
   VertexShaderCache::RetreiveAsyncShaders();
+  DeferredDraws::UpdateThreads();
 
   SetWindowSize(fbStride, fbHeight);
 
@@ -858,7 +908,10 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   }
 
   // Flip/present backbuffer to frontbuffer here
-  D3D::Present();
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::PresentWait);
+    D3D::Present();
+  }
 
   // Resize the back buffers NOW to avoid flickering
   if (CalculateTargetSize() || xfbchanged || window_resized || fs_changed ||
@@ -913,6 +966,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 // ALWAYS call RestoreAPIState for each ResetAPIState call you're doing
 void Renderer::ResetAPIState()
 {
+  DeferredDraws::Flush();
   D3D::stateman->PushBlendState(s_reset_blend_state);
   D3D::stateman->PushDepthState(s_reset_depth_state);
   D3D::stateman->PushRasterizerState(s_reset_rast_state);
@@ -952,13 +1006,6 @@ void Renderer::ApplyState()
     SetBlendMode(false);
     SetLogicOpMode();
   }
-
-  ID3D11Buffer* vertexConstants = VertexShaderCache::GetConstantBuffer();
-
-  D3D::stateman->SetPixelConstants(PixelShaderCache::GetConstantBuffer(),
-                                   g_ActiveConfig.bEnablePixelLighting ? vertexConstants : nullptr);
-  D3D::stateman->SetVertexConstants(vertexConstants);
-  D3D::stateman->SetGeometryConstants(GeometryShaderCache::GetConstantBuffer());
 }
 
 void Renderer::RestoreState()
@@ -13,6 +13,8 @@ namespace DX11
 {
 class D3DTexture2D;
 
+void ClearEFBCache();
+
 class Renderer : public ::Renderer
 {
 public:
@@ -62,6 +64,8 @@ public:
   bool CheckForResize();
 
 private:
+  void UpdateEFBCache(EFBAccessType type, u32 x, u32 y);
+
   void BlitScreen(TargetRectangle src, TargetRectangle dst, D3DTexture2D* src_texture,
                   u32 src_width, u32 src_height, float Gamma);
 };
@@ -46,6 +46,15 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyParams& params, u32 native_widt
                     scale_by_half);
 }
 
+std::unique_ptr<TextureCacheBase::PendingEFBCopy>
+TextureCache::CopyEFBDeferred(u8* dst, const EFBCopyParams& params, u32 native_width,
+                              u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+                              const EFBRectangle& src_rect, bool scale_by_half)
+{
+  return g_encoder->EncodeDeferred(dst, params, native_width, bytes_per_row, num_blocks_y,
+                                   memory_stride, src_rect, scale_by_half);
+}
+
 const char palette_shader[] =
     R"HLSL(
 sampler samp0 : register(s0);
@@ -214,6 +223,9 @@ TextureCache::TextureCache()
 
 TextureCache::~TextureCache()
 {
+  // The pending copies use the staging textures of the encoder.
+  FlushEFBCopies();
+
   for (unsigned int k = 0; k < MAX_COPY_BUFFERS; ++k)
     SAFE_RELEASE(s_efbcopycbuf[k]);
 
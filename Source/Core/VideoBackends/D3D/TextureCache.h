@@ -35,6 +35,12 @@ private:
                u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
                bool scale_by_half) override;
 
+  std::unique_ptr<PendingEFBCopy> CopyEFBDeferred(u8* dst, const EFBCopyParams& params,
+                                                  u32 native_width, u32 bytes_per_row,
+                                                  u32 num_blocks_y, u32 memory_stride,
+                                                  const EFBRectangle& src_rect,
+                                                  bool scale_by_half) override;
+
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
                            bool scale_by_half, unsigned int cbuf_id, const float* colmat) override;
 
@@ -11,6 +11,7 @@
 #include "VideoBackends/D3D/BoundingBox.h"
 #include "VideoBackends/D3D/D3DBase.h"
 #include "VideoBackends/D3D/D3DState.h"
+#include "VideoBackends/D3D/DeferredDraws.h"
 #include "VideoBackends/D3D/GeometryShaderCache.h"
 #include "VideoBackends/D3D/PixelShaderCache.h"
 #include "VideoBackends/D3D/Render.h"
@@ -21,6 +22,7 @@
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -32,6 +34,11 @@ const u32 MAX_IBUFFER_SIZE = VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 8;
 const u32 MAX_VBUFFER_SIZE = VertexManager::MAXVBUFFERSIZE;
 const u32 MAX_BUFFER_SIZE = MAX_IBUFFER_SIZE + MAX_VBUFFER_SIZE;
 
+static bool IsBBoxActive()
+{
+  return g_ActiveConfig.backend_info.bSupportsBBox && BoundingBox::active;
+}
+
 void VertexManager::CreateDeviceObjects()
 {
   D3D11_BUFFER_DESC bufdesc =
@@ -96,10 +103,12 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
   D3D11_MAP MapType = D3D11_MAP_WRITE_NO_OVERWRITE;
   if (cursor + totalBufferSize >= MAX_BUFFER_SIZE)
   {
-    // Wrap around
+    // Wrap around. Queued draws have to read the buffer before it is discarded.
+    DeferredDraws::Flush();
     m_currentBuffer = (m_currentBuffer + 1) % MAX_BUFFER_COUNT;
     cursor = 0;
     MapType = D3D11_MAP_WRITE_DISCARD;
+    INCSTAT(stats.thisFrame.numStreamBufferWraps);
   }
 
   m_vertexDrawOffset = cursor;
@@ -142,8 +151,22 @@ void VertexManager::Draw(u32 stride)
     break;
   }
 
-  D3D::stateman->Apply();
-  D3D::context->DrawIndexed(indices, startIndex, baseVertex);
+  if (DeferredDraws::IsEnabled() && !IsBBoxActive())
+  {
+    DeferredDraws::QueueDraw(indices, startIndex, baseVertex);
+  }
+  else
+  {
+    ID3D11Buffer* vertexConstants = VertexShaderCache::GetConstantBuffer();
+    D3D::stateman->SetPixelConstants(PixelShaderCache::GetConstantBuffer(),
+                                     g_ActiveConfig.bEnablePixelLighting ? vertexConstants :
+                                                                           nullptr);
+    D3D::stateman->SetVertexConstants(vertexConstants);
+    D3D::stateman->SetGeometryConstants(GeometryShaderCache::GetConstantBuffer());
+
+    D3D::stateman->Apply();
+    D3D::context->DrawIndexed(indices, startIndex, baseVertex);
+  }
 
   INCSTAT(stats.thisFrame.numDrawCalls);
 
@@ -153,28 +176,33 @@ void VertexManager::Draw(u32 stride)
 
 void VertexManager::vFlush()
 {
-  if (!PixelShaderCache::SetShader())
   {
-    GFX_DEBUGGER_PAUSE_LOG_AT(NEXT_ERROR, true, { printf("Fail to set pixel shader\n"); });
-    return;
+    StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderCompileWait);
+    if (!PixelShaderCache::SetShader())
+    {
+      GFX_DEBUGGER_PAUSE_LOG_AT(NEXT_ERROR, true, { printf("Fail to set pixel shader\n"); });
+      return;
+    }
+
+    D3DVertexFormat* vertex_format =
+        static_cast<D3DVertexFormat*>(VertexLoaderManager::GetCurrentVertexFormat());
+    if (!VertexShaderCache::SetShader(vertex_format))
+    {
+      GFX_DEBUGGER_PAUSE_LOG_AT(NEXT_ERROR, true, { printf("Fail to set pixel shader\n"); });
+      return;
+    }
+
+    if (!GeometryShaderCache::SetShader(m_current_primitive_type))
+    {
+      GFX_DEBUGGER_PAUSE_LOG_AT(NEXT_ERROR, true, { printf("Fail to set pixel shader\n"); });
+      return;
+    }
   }
 
-  D3DVertexFormat* vertex_format =
-      static_cast<D3DVertexFormat*>(VertexLoaderManager::GetCurrentVertexFormat());
-  if (!VertexShaderCache::SetShader(vertex_format))
-  {
-    GFX_DEBUGGER_PAUSE_LOG_AT(NEXT_ERROR, true, { printf("Fail to set pixel shader\n"); });
-    return;
-  }
-
-  if (!GeometryShaderCache::SetShader(m_current_primitive_type))
-  {
-    GFX_DEBUGGER_PAUSE_LOG_AT(NEXT_ERROR, true, { printf("Fail to set pixel shader\n"); });
-    return;
-  }
-
-  if (g_ActiveConfig.backend_info.bSupportsBBox && BoundingBox::active)
+  if (IsBBoxActive())
   {
+    // The UAV is bound on the immediate context, so these draws can't be deferred.
+    DeferredDraws::Flush();
     D3D::context->OMSetRenderTargetsAndUnorderedAccessViews(
         D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr, 2, 1, &BBox::GetUAV(),
         nullptr);
@@ -189,6 +217,9 @@ void VertexManager::vFlush()
   Draw(stride);
 
   g_renderer->RestoreState();
+
+  if (!g_ActiveConfig.bEFBAccessDeferInvalidation)
+    ClearEFBCache();
 }
 
 void VertexManager::ResetBuffer(u32 stride)
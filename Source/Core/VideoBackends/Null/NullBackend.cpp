@@ -7,6 +7,16 @@
 // This backend tries not to do anything in the backend,
 // but everything in VideoCommon.
 
+// Without any host GPU work, the stage timings only measure the CPU cost of the video emulation,
+// so a profile of them is taken for every run and written to the logs directory at the end. Played
+// back with the FIFO player, this compares that cost between builds free of driver noise.
+
+#include <string>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
 #include "VideoBackends/Null/FramebufferManager.h"
 #include "VideoBackends/Null/PerfQuery.h"
 #include "VideoBackends/Null/Render.h"
@@ -15,6 +25,7 @@
 #include "VideoBackends/Null/VertexManager.h"
 #include "VideoBackends/Null/VideoBackend.h"
 
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -36,6 +47,7 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsBindingLayout = true;
   g_Config.backend_info.bSupportsBBox = true;
   g_Config.backend_info.bSupportsGSInstancing = true;
+  g_Config.backend_info.bSupportsVertexShaderLayer = false;
   g_Config.backend_info.bSupportsPostProcessing = false;
   g_Config.backend_info.bSupportsPaletteConversion = true;
   g_Config.backend_info.bSupportsClipControl = true;
@@ -45,6 +57,7 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsMultithreading = false;
   g_Config.backend_info.bSupportsInternalResolutionFrameDumps = false;
   g_Config.backend_info.bSupportsGPUTextureDecoding = false;
+  g_Config.backend_info.bSupportsGPUTimers = false;
   g_Config.backend_info.bSupportsST3CTextures = false;
   g_Config.backend_info.bSupportsBPTCTextures = false;
 
@@ -73,6 +86,8 @@ void VideoBackend::Video_Prepare()
   VertexShaderCache::s_instance = std::make_unique<VertexShaderCache>();
   GeometryShaderCache::s_instance = std::make_unique<GeometryShaderCache>();
   PixelShaderCache::s_instance = std::make_unique<PixelShaderCache>();
+
+  StageTimings::StartProfile();
 }
 
 void VideoBackend::Shutdown()
@@ -82,6 +97,15 @@ void VideoBackend::Shutdown()
 
 void VideoBackend::Video_Cleanup()
 {
+  StageTimings::StopProfile();
+  const std::string report = StageTimings::GetProfileReport();
+  if (!report.empty())
+  {
+    const std::string path = File::GetUserPath(D_LOGS_IDX) + NULL_VIDEO_PROFILE;
+    File::WriteStringToFile(report, path);
+    NOTICE_LOG(VIDEO, "Video emulation profile written to %s:\n%s", path.c_str(), report.c_str());
+  }
+
   CleanupShared();
   PixelShaderCache::s_instance.reset();
   VertexShaderCache::s_instance.reset();
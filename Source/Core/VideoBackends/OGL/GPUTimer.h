@@ -84,6 +84,20 @@ public:
     return m_result;
   }
 
+  // Returns whether the time can be read without waiting for the GPU.
+  bool IsResultAvailable()
+  {
+    if (m_has_result)
+      return true;
+
+    if (m_started)
+      End();
+
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(m_query_id, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available != GL_FALSE;
+  }
+
 private:
   void GetResult()
   {
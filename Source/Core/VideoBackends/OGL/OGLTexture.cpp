@@ -15,6 +15,7 @@
 
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/TextureConfig.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace OGL
 {
@@ -79,7 +80,9 @@ bool SaveTexture(const std::string& filename, u32 textarget, u32 tex, int virtua
   glGetTexImage(textarget, level, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
   OGLTexture::SetStage();
 
-  return TextureToPng(data.data(), width * 4, filename, width, height, true);
+  TextureToPngAsync(data.data(), width * 4, filename, width, height, true,
+                    g_ActiveConfig.iPNGCompressionLevel);
+  return true;
 }
 
 OGLTexture::OGLTexture(const TextureConfig& tex_config) : AbstractTexture(tex_config)
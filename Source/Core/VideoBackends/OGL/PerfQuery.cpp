@@ -55,8 +55,19 @@ void PerfQuery::FlushResults()
 
 void PerfQuery::ResetQuery()
 {
-  m_query_count = 0;
-  std::fill_n(m_results, ArraySize(m_results), 0);
+  // In delayed mode, the queries of the current period are left running. Only the ones from
+  // before the previous reset are waited for, and those have had a whole period to complete.
+  if (ShouldDelayResults())
+  {
+    while (IsPreviousPeriodPending() && !IsFlushed())
+      FlushOne();
+  }
+  else
+  {
+    m_query_count = 0;
+  }
+
+  BeginPeriod();
 }
 
 u32 PerfQuery::GetQueryResult(PerfQueryType type)
@@ -65,19 +76,19 @@ u32 PerfQuery::GetQueryResult(PerfQueryType type)
 
   if (type == PQ_ZCOMP_INPUT_ZCOMPLOC || type == PQ_ZCOMP_OUTPUT_ZCOMPLOC)
   {
-    result = m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_ZCOMP_INPUT || type == PQ_ZCOMP_OUTPUT)
   {
-    result = m_results[PQG_ZCOMP];
+    result = GetResult(PQG_ZCOMP);
   }
   else if (type == PQ_BLEND_INPUT)
   {
-    result = m_results[PQG_ZCOMP] + m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP) + GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_EFB_COPY_CLOCKS)
   {
-    result = m_results[PQG_EFB_COPY_CLOCKS];
+    result = GetResult(PQG_EFB_COPY_CLOCKS);
   }
 
   return result;
@@ -115,6 +126,7 @@ void PerfQueryGL::EnableQuery(PerfQueryGroup type)
 
     glBeginQuery(m_query_type, entry.query_id);
     entry.query_type = type;
+    entry.period = AddPendingQuery();
 
     ++m_query_count;
   }
@@ -165,7 +177,7 @@ void PerfQueryGL::FlushOne()
   if (g_ActiveConfig.iMultisamples > 1)
     result /= g_ActiveConfig.iMultisamples;
 
-  m_results[entry.query_type] += result;
+  AddResult(entry.period, entry.query_type, result);
 
   m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
   --m_query_count;
@@ -209,6 +221,7 @@ void PerfQueryGLESNV::EnableQuery(PerfQueryGroup type)
 
     glBeginOcclusionQueryNV(entry.query_id);
     entry.query_type = type;
+    entry.period = AddPendingQuery();
 
     ++m_query_count;
   }
@@ -252,8 +265,9 @@ void PerfQueryGLESNV::FlushOne()
   // NOTE: Reported pixel metrics should be referenced to native resolution
   // TODO: Dropping the lower 2 bits from this count should be closer to actual
   // hardware behavior when drawing triangles.
-  m_results[entry.query_type] += static_cast<u64>(result) * EFB_WIDTH * EFB_HEIGHT /
-                                 (g_renderer->GetTargetWidth() * g_renderer->GetTargetHeight());
+  AddResult(entry.period, entry.query_type,
+            static_cast<u32>(static_cast<u64>(result) * EFB_WIDTH * EFB_HEIGHT /
+                             (g_renderer->GetTargetWidth() * g_renderer->GetTargetHeight())));
 
   m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
   --m_query_count;
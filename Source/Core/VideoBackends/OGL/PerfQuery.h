@@ -32,8 +32,12 @@ protected:
   {
     GLuint query_id;
     PerfQueryGroup query_type;
+    u32 period;
   };
 
+  // Only use when non-empty
+  virtual void FlushOne() {}
+
   // when testing in SMS: 64 was too small, 128 was ok
   static const u32 PERF_QUERY_BUFFER_SIZE = 512;
 
@@ -59,8 +63,7 @@ public:
 
 private:
   void WeakFlush();
-  // Only use when non-empty
-  void FlushOne();
+  void FlushOne() override;
 
   GLenum m_query_type;
 };
@@ -77,8 +80,7 @@ public:
 
 private:
   void WeakFlush();
-  // Only use when non-empty
-  void FlushOne();
+  void FlushOne() override;
 };
 
 }  // namespace
@@ -4,6 +4,9 @@
 
 #include "VideoBackends/OGL/PostProcessing.h"
 
+#include <algorithm>
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLUtil.h"
 #include "Common/Logging/Log.h"
@@ -20,12 +23,20 @@
 
 namespace OGL
 {
+// Each instance draws to one of the destination rectangles, which are relative to the viewport.
+// This lets both eyes of the side-by-side and top-and-bottom stereo modes share a draw call.
 static const char s_vertex_shader[] = "out vec2 uv0;\n"
+                                      "flat out int layer;\n"
                                       "uniform vec4 src_rect;\n"
+                                      "uniform vec4 dst_rects[2];\n"
+                                      "uniform int src_layer;\n"
                                       "void main(void) {\n"
-                                      "	vec2 rawpos = vec2(gl_VertexID&1, gl_VertexID&2);\n"
-                                      "	gl_Position = vec4(rawpos*2.0-1.0, 0.0, 1.0);\n"
+                                      "	vec2 rawpos = vec2(gl_VertexID&1, (gl_VertexID>>1)&1);\n"
+                                      "	vec4 dst_rect = dst_rects[gl_InstanceID];\n"
+                                      "	gl_Position = vec4((dst_rect.xy + rawpos * dst_rect.zw)*2.0-1.0, "
+                                      "0.0, 1.0);\n"
                                       "	uv0 = rawpos * src_rect.zw + src_rect.xy;\n"
+                                      "	layer = src_layer + gl_InstanceID;\n"
                                       "}\n";
 
 OpenGLPostProcessing::OpenGLPostProcessing() : m_initialized(false)
@@ -41,10 +52,46 @@ OpenGLPostProcessing::~OpenGLPostProcessing()
 void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle dst,
                                            int src_texture, int src_width, int src_height,
                                            int layer)
+{
+  DrawRectangles(src, &dst, 1, src_texture, src_width, src_height, layer);
+}
+
+void OpenGLPostProcessing::BlitStereoFromTexture(TargetRectangle src, TargetRectangle left_dst,
+                                                 TargetRectangle right_dst, int src_texture,
+                                                 int src_width, int src_height)
+{
+  const std::array<TargetRectangle, 2> dst = {{left_dst, right_dst}};
+  DrawRectangles(src, dst.data(), static_cast<int>(dst.size()), src_texture, src_width,
+                 src_height, 0);
+}
+
+void OpenGLPostProcessing::DrawRectangles(const TargetRectangle& src, const TargetRectangle* dst,
+                                          int num_dst, int src_texture, int src_width,
+                                          int src_height, int layer)
 {
   ApplyShader();
 
-  glViewport(dst.left, dst.bottom, dst.GetWidth(), dst.GetHeight());
+  // The viewport covers all destination rectangles, and each instance is placed within it.
+  TargetRectangle viewport = dst[0];
+  for (int i = 1; i < num_dst; i++)
+  {
+    viewport.left = std::min(viewport.left, dst[i].left);
+    viewport.bottom = std::min(viewport.bottom, dst[i].bottom);
+    viewport.right = std::max(viewport.right, dst[i].right);
+    viewport.top = std::max(viewport.top, dst[i].top);
+  }
+  const float viewport_width = static_cast<float>(viewport.GetWidth());
+  const float viewport_height = static_cast<float>(viewport.GetHeight());
+  std::array<float, 8> dst_rects = {};
+  for (int i = 0; i < num_dst; i++)
+  {
+    dst_rects[i * 4 + 0] = (dst[i].left - viewport.left) / viewport_width;
+    dst_rects[i * 4 + 1] = (dst[i].bottom - viewport.bottom) / viewport_height;
+    dst_rects[i * 4 + 2] = dst[i].GetWidth() / viewport_width;
+    dst_rects[i * 4 + 3] = dst[i].GetHeight() / viewport_height;
+  }
+
+  glViewport(viewport.left, viewport.bottom, viewport.GetWidth(), viewport.GetHeight());
 
   OpenGL_BindAttributelessVAO();
 
@@ -54,6 +101,7 @@ void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle
               1.0f / (float)src_height);
   glUniform4f(m_uniform_src_rect, src.left / (float)src_width, src.bottom / (float)src_height,
               src.GetWidth() / (float)src_width, src.GetHeight() / (float)src_height);
+  glUniform4fv(m_uniform_dst_rects, num_dst, dst_rects.data());
   glUniform1ui(m_uniform_time, (GLuint)m_timer.GetTimeElapsed());
   glUniform1i(m_uniform_layer, layer);
 
@@ -120,7 +168,7 @@ void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle
   glActiveTexture(GL_TEXTURE9);
   glBindTexture(GL_TEXTURE_2D_ARRAY, src_texture);
   g_sampler_cache->BindLinearSampler(9);
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, num_dst);
 }
 
 void OpenGLPostProcessing::ApplyShader()
@@ -150,7 +198,8 @@ void OpenGLPostProcessing::ApplyShader()
   m_uniform_resolution = glGetUniformLocation(m_shader.glprogid, "resolution");
   m_uniform_time = glGetUniformLocation(m_shader.glprogid, "time");
   m_uniform_src_rect = glGetUniformLocation(m_shader.glprogid, "src_rect");
-  m_uniform_layer = glGetUniformLocation(m_shader.glprogid, "layer");
+  m_uniform_dst_rects = glGetUniformLocation(m_shader.glprogid, "dst_rects");
+  m_uniform_layer = glGetUniformLocation(m_shader.glprogid, "src_layer");
 
   for (const auto& it : m_config.GetOptions())
   {
@@ -177,8 +226,8 @@ void OpenGLPostProcessing::CreateHeader()
       "uniform float4 resolution;\n"
       // Time
       "uniform uint time;\n"
-      // Layer
-      "uniform int layer;\n"
+      // Layer, which is set per instance when both eyes are drawn at once
+      "flat in int layer;\n"
 
       // Interfacing functions
       "float4 Sample()\n"
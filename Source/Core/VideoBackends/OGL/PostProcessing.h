@@ -24,6 +24,11 @@ public:
 
   void BlitFromTexture(TargetRectangle src, TargetRectangle dst, int src_texture, int src_width,
                        int src_height, int layer);
+  // Draws the left eye to left_dst and the right eye to right_dst with a single draw call, for
+  // the side-by-side and top-and-bottom stereoscopic 3D modes.
+  void BlitStereoFromTexture(TargetRectangle src, TargetRectangle left_dst,
+                             TargetRectangle right_dst, int src_texture, int src_width,
+                             int src_height);
   void ApplyShader();
 
 private:
@@ -31,12 +36,15 @@ private:
   SHADER m_shader;
   GLuint m_uniform_resolution;
   GLuint m_uniform_src_rect;
+  GLuint m_uniform_dst_rects;
   GLuint m_uniform_time;
   GLuint m_uniform_layer;
   std::string m_glsl_header;
 
   std::unordered_map<std::string, GLuint> m_uniform_bindings;
 
+  void DrawRectangles(const TargetRectangle& src, const TargetRectangle* dst, int num_dst,
+                      int src_texture, int src_width, int src_height, int layer);
   void CreateHeader();
   std::string LoadShaderOptions();
 };
@@ -7,6 +7,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <tuple>
 
 #include "Common/Align.h"
 #include "Common/CommonTypes.h"
@@ -51,6 +52,13 @@ u32 ProgramShaderCache::s_last_VAO = INVALID_VAO;
 static std::unique_ptr<StreamBuffer> s_buffer;
 static int num_failures = 0;
 
+// The constants as last uploaded. The managers flag their constants dirty on many register writes
+// which don't change them, and draws after those can keep using the bound copies.
+static PixelShaderConstants s_uploaded_ps_constants;
+static VertexShaderConstants s_uploaded_vs_constants;
+static GeometryShaderConstants s_uploaded_gs_constants;
+static bool s_constants_uploaded = false;
+
 static LinearDiskCache<SHADERUID, u8> s_program_disk_cache;
 static LinearDiskCache<UBERSHADERUID, u8> s_uber_program_disk_cache;
 static GLuint CurrentProgram = 0;
@@ -62,6 +70,17 @@ SHADERUID ProgramShaderCache::last_uid;
 UBERSHADERUID ProgramShaderCache::last_uber_uid;
 static std::string s_glsl_header = "";
 
+// What the kept programs were compiled for, when the cache is suspended.
+using ProgramsKey = std::tuple<std::string, u32, bool, bool>;
+static bool s_suspended = false;
+static ProgramsKey s_suspended_key;
+
+static ProgramsKey GetProgramsKey()
+{
+  return ProgramsKey(SConfig::GetInstance().GetGameID(), ShaderHostConfig::GetCurrent().bits,
+                     g_ActiveConfig.bShaderCache, g_ActiveConfig.CanPrecompileUberShaders());
+}
+
 static std::string GetGLSLVersionString()
 {
   GLSL_VERSION v = g_ogl_config.eSupportedGLSLVersion;
@@ -191,6 +210,20 @@ void ProgramShaderCache::UploadConstants()
 {
   if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty)
   {
+    if (s_constants_uploaded &&
+        !memcmp(&s_uploaded_ps_constants, &PixelShaderManager::constants,
+                sizeof(PixelShaderConstants)) &&
+        !memcmp(&s_uploaded_vs_constants, &VertexShaderManager::constants,
+                sizeof(VertexShaderConstants)) &&
+        !memcmp(&s_uploaded_gs_constants, &GeometryShaderManager::constants,
+                sizeof(GeometryShaderConstants)))
+    {
+      PixelShaderManager::dirty = false;
+      VertexShaderManager::dirty = false;
+      GeometryShaderManager::dirty = false;
+      return;
+    }
+
     auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
 
     memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
@@ -213,6 +246,13 @@ void ProgramShaderCache::UploadConstants()
                           Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
                       sizeof(GeometryShaderConstants));
 
+    memcpy(&s_uploaded_ps_constants, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
+    memcpy(&s_uploaded_vs_constants, &VertexShaderManager::constants,
+           sizeof(VertexShaderConstants));
+    memcpy(&s_uploaded_gs_constants, &GeometryShaderManager::constants,
+           sizeof(GeometryShaderConstants));
+    s_constants_uploaded = true;
+
     PixelShaderManager::dirty = false;
     VertexShaderManager::dirty = false;
     GeometryShaderManager::dirty = false;
@@ -235,6 +275,7 @@ SHADER* ProgramShaderCache::SetShader(u32 primitive_type, const GLVertexFormat*
   // Check if the shader is already set
   if (last_entry && uid == last_uid)
   {
+    INCSTAT(stats.thisFrame.numSpecializedShaderDraws);
     last_entry->shader.Bind();
     BindVertexFormat(vertex_format);
     return &last_entry->shader;
@@ -248,6 +289,7 @@ SHADER* ProgramShaderCache::SetShader(u32 primitive_type, const GLVertexFormat*
     if (entry->pending)
       return SetUberShader(primitive_type, vertex_format);
 
+    INCSTAT(stats.thisFrame.numSpecializedShaderDraws);
     last_uid = uid;
     last_entry = entry;
     BindVertexFormat(vertex_format);
@@ -283,6 +325,7 @@ SHADER* ProgramShaderCache::SetShader(u32 primitive_type, const GLVertexFormat*
 
   INCSTAT(stats.numPixelShadersCreated);
   SETSTAT(stats.numPixelShadersAlive, pshaders.size());
+  INCSTAT(stats.thisFrame.numSpecializedShaderDraws);
 
   last_uid = uid;
   last_entry = &newentry;
@@ -293,6 +336,8 @@ SHADER* ProgramShaderCache::SetShader(u32 primitive_type, const GLVertexFormat*
 
 SHADER* ProgramShaderCache::SetUberShader(u32 primitive_type, const GLVertexFormat* vertex_format)
 {
+  INCSTAT(stats.thisFrame.numUberShaderDraws);
+
   UBERSHADERUID uid;
   std::memset(&uid, 0, sizeof(uid));
   uid.puid = UberShader::GetPixelShaderUid();
@@ -590,6 +635,7 @@ void ProgramShaderCache::Init()
   // So multiply by four to get how many floats we have from vec4s
   // Then once more to get bytes
   s_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, UBO_LENGTH);
+  s_constants_uploaded = false;
 
   // The GPU shader code appears to be context-specific on Mesa/i965.
   // This means that if we compiled the ubershaders asynchronously, they will be recompiled
@@ -682,6 +728,53 @@ void ProgramShaderCache::Shutdown()
   s_buffer.reset();
 }
 
+void ProgramShaderCache::Suspend()
+{
+  if (s_async_compiler)
+  {
+    s_async_compiler->WaitUntilCompletion();
+    s_async_compiler->RetrieveWorkItems();
+  }
+
+  // Write the new programs out now, as the next boot may never come.
+  if (g_ogl_config.bSupportsGLSLCache && g_ActiveConfig.bShaderCache)
+    SaveProgramBinaries();
+
+  // The vertex formats are destroyed along with the emulation.
+  InvalidateVertexFormat();
+  s_suspended_key = GetProgramsKey();
+  s_suspended = true;
+}
+
+bool ProgramShaderCache::Resume()
+{
+  if (!s_suspended)
+    return false;
+
+  s_suspended = false;
+  if (GetProgramsKey() != s_suspended_key)
+  {
+    Shutdown();
+    return false;
+  }
+
+  if (s_async_compiler)
+    s_async_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+
+  s_constants_uploaded = false;
+  CurrentProgram = 0;
+  last_entry = nullptr;
+  last_uber_entry = nullptr;
+  last_uid = {};
+  last_uber_uid = {};
+  return true;
+}
+
+bool ProgramShaderCache::IsSuspended()
+{
+  return s_suspended;
+}
+
 void ProgramShaderCache::BindVertexFormat(const GLVertexFormat* vertex_format)
 {
   u32 new_VAO = vertex_format ? vertex_format->VAO : 0;
@@ -866,6 +959,14 @@ void ProgramShaderCache::CreateHeader()
     break;
   }
 
+  std::string SupportedVertexShaderLayer;
+  if (g_ActiveConfig.backend_info.bSupportsVertexShaderLayer)
+  {
+    SupportedVertexShaderLayer = GLExtensions::Supports("GL_ARB_shader_viewport_layer_array") ?
+                                     "#extension GL_ARB_shader_viewport_layer_array : enable" :
+                                     "#extension GL_AMD_vertex_shader_layer : enable";
+  }
+
   std::string earlyz_string = "";
   if (g_ActiveConfig.backend_info.bSupportsEarlyZ)
   {
@@ -898,6 +999,7 @@ void ProgramShaderCache::CreateHeader()
       "%s\n"  // ES texture buffer
       "%s\n"  // ES dual source blend
       "%s\n"  // shader image load store
+      "%s\n"  // vertex shader layer
 
       // Precision defines for GLSL ES
       "%s\n"
@@ -972,7 +1074,8 @@ void ProgramShaderCache::CreateHeader()
               ((!is_glsles && v < GLSL_430) || (is_glsles && v < GLSLES_310)) ?
           "#extension GL_ARB_shader_image_load_store : enable" :
           "",
-      is_glsles ? "precision highp float;" : "", is_glsles ? "precision highp int;" : "",
+      SupportedVertexShaderLayer.c_str(), is_glsles ? "precision highp float;" : "",
+      is_glsles ? "precision highp int;" : "",
       is_glsles ? "precision highp sampler2DArray;" : "",
       (is_glsles && g_ActiveConfig.backend_info.bSupportsPaletteConversion) ?
           "precision highp usamplerBuffer;" :
@@ -112,6 +112,13 @@ public:
   static void Init();
   static void Reload();
   static void Shutdown();
+
+  // With a persistent session, the programs are kept at the end of a boot instead of destroyed.
+  // Resume() reuses them if neither the game nor the settings which affect shaders have changed
+  // since, and otherwise shuts the cache down so that it can be initialized again.
+  static void Suspend();
+  static bool Resume();
+  static bool IsSuspended();
   static void CreateHeader();
   static void RetrieveAsyncShaders();
   static void PrecompileUberShaders();
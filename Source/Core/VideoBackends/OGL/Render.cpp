@@ -27,6 +27,7 @@
 
 #include "VideoBackends/OGL/BoundingBox.h"
 #include "VideoBackends/OGL/FramebufferManager.h"
+#include "VideoBackends/OGL/GPUTimer.h"
 #include "VideoBackends/OGL/OGLTexture.h"
 #include "VideoBackends/OGL/PostProcessing.h"
 #include "VideoBackends/OGL/ProgramShaderCache.h"
@@ -44,6 +45,7 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
@@ -423,6 +425,9 @@ Renderer::Renderer()
   g_Config.backend_info.bSupportsFragmentStoresAndAtomics =
       GLExtensions::Supports("GL_ARB_shader_storage_buffer_object");
   g_Config.backend_info.bSupportsGSInstancing = GLExtensions::Supports("GL_ARB_gpu_shader5");
+  g_Config.backend_info.bSupportsVertexShaderLayer =
+      GLExtensions::Supports("GL_ARB_shader_viewport_layer_array") ||
+      GLExtensions::Supports("GL_AMD_vertex_shader_layer");
   g_Config.backend_info.bSupportsSSAA = GLExtensions::Supports("GL_ARB_gpu_shader5") &&
                                         GLExtensions::Supports("GL_ARB_sample_shading");
   g_Config.backend_info.bSupportsGeometryShaders =
@@ -479,6 +484,7 @@ Renderer::Renderer()
       GLExtensions::Supports("GL_EXT_texture_compression_s3tc");
   g_Config.backend_info.bSupportsBPTCTextures =
       GLExtensions::Supports("GL_ARB_texture_compression_bptc");
+  g_Config.backend_info.bSupportsGPUTimers = GLExtensions::Supports("GL_ARB_timer_query");
 
   if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
   {
@@ -771,13 +777,14 @@ Renderer::Renderer()
 Renderer::~Renderer()
 {
   FlushFrameDump();
-  FinishFrameData();
   DestroyFrameDumpResources();
 }
 
 void Renderer::Shutdown()
 {
   g_framebuffer_manager.reset();
+  m_frame_timer.reset();
+  m_pending_frame_timers.clear();
 
   UpdateActiveConfig();
 
@@ -832,7 +839,12 @@ TargetRectangle Renderer::ConvertEFBRectangle(const EFBRectangle& rc)
 void Renderer::SetScissorRect(const EFBRectangle& rc)
 {
   TargetRectangle trc = ConvertEFBRectangle(rc);
-  glScissor(trc.left, trc.bottom, trc.GetWidth(), trc.GetHeight());
+  const std::array<GLint, 4> scissor = {{trc.left, trc.bottom, trc.GetWidth(), trc.GetHeight()}};
+  if (m_game_state_valid && m_game_state.scissor == scissor)
+    return;
+
+  glScissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+  m_game_state.scissor = scissor;
 }
 
 void ClearEFBCache()
@@ -1125,14 +1137,19 @@ void Renderer::SetViewport()
   }
 
   // Update the view port
-  if (g_ogl_config.bSupportViewportFloat)
+  const std::array<float, 4> viewport = {{X, Y, Width, Height}};
+  if (!m_game_state_valid || m_game_state.viewport != viewport)
   {
-    glViewportIndexedf(0, X, Y, Width, Height);
-  }
-  else
-  {
-    auto iceilf = [](float f) { return static_cast<GLint>(ceilf(f)); };
-    glViewport(iceilf(X), iceilf(Y), iceilf(Width), iceilf(Height));
+    if (g_ogl_config.bSupportViewportFloat)
+    {
+      glViewportIndexedf(0, X, Y, Width, Height);
+    }
+    else
+    {
+      auto iceilf = [](float f) { return static_cast<GLint>(ceilf(f)); };
+      glViewport(iceilf(X), iceilf(Y), iceilf(Width), iceilf(Height));
+    }
+    m_game_state.viewport = viewport;
   }
 
   if (!g_ActiveConfig.backend_info.bSupportsDepthClamp)
@@ -1160,7 +1177,12 @@ void Renderer::SetViewport()
   }
 
   // Set the reversed depth range.
+  const std::array<float, 2> depth_range = {{max_depth, min_depth}};
+  if (m_game_state_valid && m_game_state.depth_range == depth_range)
+    return;
+
   glDepthRangef(max_depth, min_depth);
+  m_game_state.depth_range = depth_range;
 }
 
 void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaEnable, bool zEnable,
@@ -1209,8 +1231,8 @@ void Renderer::BlitScreen(TargetRectangle src, TargetRectangle dst, GLuint src_t
     else
       std::tie(leftRc, rightRc) = ConvertStereoRectangle(dst);
 
-    post_processor->BlitFromTexture(src, leftRc, src_texture, src_width, src_height, 0);
-    post_processor->BlitFromTexture(src, rightRc, src_texture, src_width, src_height, 1);
+    post_processor->BlitStereoFromTexture(src, leftRc, rightRc, src_texture, src_width,
+                                          src_height);
   }
   else if (g_ActiveConfig.iStereoMode == STEREO_QUADBUFFER)
   {
@@ -1230,6 +1252,7 @@ void Renderer::BlitScreen(TargetRectangle src, TargetRectangle dst, GLuint src_t
 
 void Renderer::ReinterpretPixelData(unsigned int convtype)
 {
+  ClearEFBCache();
   if (convtype == 0 || convtype == 2)
   {
     FramebufferManager::ReinterpretPixelData(convtype);
@@ -1243,8 +1266,13 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
 
 void Renderer::SetBlendMode(bool forceUpdate)
 {
-  BlendingState state;
-  state.Generate(bpmem);
+  // Registers which don't affect the generated state are often written, skip those updates.
+  const u32 state_id = RenderState::GetBlendingStateID();
+  if (!forceUpdate && state_id == m_blending_state_id)
+    return;
+  m_blending_state_id = state_id;
+
+  const BlendingState& state = RenderState::GetBlendingState(state_id);
 
   bool useDualSource =
       state.usedualsrc && g_ActiveConfig.backend_info.bSupportsDualSourceBlend &&
@@ -1322,6 +1350,9 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
       glDisable(GL_DEBUG_OUTPUT);
   }
 
+  // Peeks are only cached across draws for the rest of the frame.
+  ClearEFBCache();
+
   if ((!m_xfb_written && !g_ActiveConfig.RealXFBEnabled()) || !fbWidth || !fbHeight)
   {
     Core::Callback_VideoCopiedToXFB(false);
@@ -1459,7 +1490,11 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 #endif
 
   // Copy the rendered frame to the real window
-  GLInterface->Swap();
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::PresentWait);
+    GLInterface->Swap();
+  }
+  UpdateFrameTimers();
 
   // Clear framebuffer
   glClearColor(0, 0, 0, 0);
@@ -1499,6 +1534,35 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   ClearEFBCache();
 }
 
+void Renderer::UpdateFrameTimers()
+{
+  // Timers of earlier frames are checked before the current one is ended, so that the stats log
+  // has always seen the frames which are reported. Only one GL_TIME_ELAPSED query can be active
+  // at a time, which means that this doesn't work together with TIME_TEXTURE_DECODING.
+  while (!m_pending_frame_timers.empty() &&
+         m_pending_frame_timers.front().second->IsResultAvailable())
+  {
+    m_frame_stats_log.ReportGPUTime(m_pending_frame_timers.front().first,
+                                    m_pending_frame_timers.front().second->GetTimeMilliseconds());
+    m_pending_frame_timers.pop_front();
+  }
+
+  if (!g_ActiveConfig.backend_info.bSupportsGPUTimers || !m_frame_stats_log.IsActive())
+  {
+    m_frame_timer.reset();
+    m_pending_frame_timers.clear();
+    return;
+  }
+
+  if (m_frame_timer)
+  {
+    m_frame_timer->End();
+    m_pending_frame_timers.emplace_back(m_frame_stats_log.GetCurrentFrame(),
+                                        std::move(m_frame_timer));
+  }
+  m_frame_timer = std::make_unique<GPUTimer>();
+}
+
 void Renderer::DrawFrame(GLuint framebuffer, const TargetRectangle& target_rc,
                          const EFBRectangle& source_rc, u32 xfb_addr,
                          const XFBSourceBase* const* xfb_sources, u32 xfb_count, u32 fb_width,
@@ -1610,7 +1674,6 @@ void Renderer::FlushFrameDump()
   if (!m_last_frame_exported)
     return;
 
-  FinishFrameData();
   glBindBuffer(GL_PIXEL_PACK_BUFFER, m_frame_dumping_pbo[0]);
   m_frame_pbo_is_mapped[0] = true;
   void* data = glMapBufferRange(
@@ -1739,6 +1802,8 @@ void Renderer::DestroyFrameDumpResources()
 // ALWAYS call RestoreAPIState for each ResetAPIState call you're doing
 void Renderer::ResetAPIState()
 {
+  m_game_state_valid = false;
+
   // Gets us to a reasonably sane state where it's possible to do things like
   // image copies with textured quads, etc.
   glDisable(GL_SCISSOR_TEST);
@@ -1770,6 +1835,7 @@ void Renderer::RestoreAPIState()
   SetDepthMode();
   SetBlendMode(true);
   SetViewport();
+  m_game_state_valid = true;
 
   ProgramShaderCache::BindLastVertexFormat();
   const VertexManager* const vm = static_cast<VertexManager*>(g_vertex_manager.get());
@@ -1781,16 +1847,32 @@ void Renderer::RestoreAPIState()
 void Renderer::SetGenerationMode()
 {
   // none, ccw, cw, ccw
-  if (bpmem.genMode.cullmode > 0)
+  // TODO: GX_CULL_ALL not supported, yet!
+  ApplyCullEnable(bpmem.genMode.cullmode > 0);
+
+  const GLenum front_face = bpmem.genMode.cullmode == 2 ? GL_CCW : GL_CW;
+  if (!m_game_state_valid || m_game_state.front_face != front_face)
   {
-    // TODO: GX_CULL_ALL not supported, yet!
-    glEnable(GL_CULL_FACE);
-    glFrontFace(bpmem.genMode.cullmode == 2 ? GL_CCW : GL_CW);
+    glFrontFace(front_face);
+    m_game_state.front_face = front_face;
   }
+}
+
+void Renderer::DisableCulling()
+{
+  ApplyCullEnable(false);
+}
+
+void Renderer::ApplyCullEnable(bool enable)
+{
+  if (m_game_state_valid && m_game_state.cull_enable == enable)
+    return;
+
+  if (enable)
+    glEnable(GL_CULL_FACE);
   else
-  {
     glDisable(GL_CULL_FACE);
-  }
+  m_game_state.cull_enable = enable;
 }
 
 void Renderer::SetDepthMode()
@@ -1798,19 +1880,32 @@ void Renderer::SetDepthMode()
   const GLenum glCmpFuncs[8] = {GL_NEVER,   GL_LESS,     GL_EQUAL,  GL_LEQUAL,
                                 GL_GREATER, GL_NOTEQUAL, GL_GEQUAL, GL_ALWAYS};
 
-  if (bpmem.zmode.testenable)
+  // if the test is disabled write is disabled too
+  // TODO: When PE performance metrics are being emulated via occlusion queries, we should
+  // (probably?) enable depth test with depth function ALWAYS here
+  const bool test = bpmem.zmode.testenable;
+  const GLboolean mask = test && bpmem.zmode.updateenable ? GL_TRUE : GL_FALSE;
+
+  if (!m_game_state_valid || m_game_state.depth_test != test)
   {
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(bpmem.zmode.updateenable ? GL_TRUE : GL_FALSE);
-    glDepthFunc(glCmpFuncs[bpmem.zmode.func]);
+    if (test)
+      glEnable(GL_DEPTH_TEST);
+    else
+      glDisable(GL_DEPTH_TEST);
+    m_game_state.depth_test = test;
   }
-  else
+
+  if (!m_game_state_valid || m_game_state.depth_mask != mask)
+  {
+    glDepthMask(mask);
+    m_game_state.depth_mask = mask;
+  }
+
+  const GLenum func = glCmpFuncs[bpmem.zmode.func];
+  if (!m_game_state_valid || m_game_state.depth_func != func)
   {
-    // if the test is disabled write is disabled too
-    // TODO: When PE performance metrics are being emulated via occlusion queries, we should
-    // (probably?) enable depth test with depth function ALWAYS here
-    glDisable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
+    glDepthFunc(func);
+    m_game_state.depth_func = func;
   }
 }
 
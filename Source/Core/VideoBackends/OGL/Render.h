@@ -5,7 +5,11 @@
 #pragma once
 
 #include <array>
+#include <deque>
+#include <limits>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "Common/GL/GLUtil.h"
 #include "VideoCommon/RenderBase.h"
@@ -14,6 +18,8 @@ struct XFBSourceBase;
 
 namespace OGL
 {
+class GPUTimer;
+
 void ClearEFBCache();
 
 enum GLSL_VERSION
@@ -85,6 +91,9 @@ public:
   void SetInterlacingMode() override;
   void SetViewport() override;
 
+  // Disables culling until the next SetGenerationMode, for points and lines.
+  void DisableCulling();
+
   void RenderText(const std::string& text, int left, int top, u32 color) override;
 
   u32 AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data) override;
@@ -134,6 +143,9 @@ private:
                          const XFBSourceBase* const* xfb_sources, u32 xfb_count, u32 fb_width,
                          u32 fb_stride, u32 fb_height, u64 ticks);
 
+  // Times the GPU work between swaps for the frame stats log.
+  void UpdateFrameTimers();
+
   // Frame dumping framebuffer, we render to this, then read it back
   void PrepareFrameDumpRenderTexture(u32 width, u32 height);
   void DestroyFrameDumpResources();
@@ -148,6 +160,32 @@ private:
   std::array<int, 2> m_last_frame_width = {};
   std::array<int, 2> m_last_frame_height = {};
   bool m_last_frame_exported = false;
+
+  // The blending state last applied by SetBlendMode().
+  u32 m_blending_state_id = std::numeric_limits<u32>::max();
+
+  // The game state which was last set, so that writing registers with the values they already
+  // have costs no GL calls. Utility draws change it behind our back, so it is only valid from
+  // RestoreAPIState until the next ResetAPIState, and set unconditionally otherwise.
+  struct GameState
+  {
+    bool cull_enable;
+    GLenum front_face;
+    bool depth_test;
+    GLboolean depth_mask;
+    GLenum depth_func;
+    std::array<GLint, 4> scissor;
+    std::array<float, 4> viewport;
+    std::array<float, 2> depth_range;
+  };
+  void ApplyCullEnable(bool enable);
+  GameState m_game_state = {};
+  bool m_game_state_valid = false;
   AVIDump::Frame m_last_frame_state;
+
+  // The timer of the frame being rendered, and the timers of earlier frames which haven't
+  // completed yet, along with the numbers of those frames.
+  std::unique_ptr<GPUTimer> m_frame_timer;
+  std::deque<std::pair<u64, std::unique_ptr<GPUTimer>>> m_pending_frame_timers;
 };
 }
@@ -13,6 +13,7 @@
 
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/Statistics.h"
 
 namespace OGL
 {
@@ -25,12 +26,8 @@ static u32 GenBuffer()
 }
 
 StreamBuffer::StreamBuffer(u32 type, u32 size)
-    : m_buffer(GenBuffer()), m_buffertype(type), m_size(ROUND_UP_POW2(size)),
-      m_bit_per_slot(IntLog2(ROUND_UP_POW2(size) / SYNC_POINTS))
+    : m_buffer(GenBuffer()), m_buffertype(type), m_size(ROUND_UP_POW2(size)), m_ring(m_size)
 {
-  m_iterator = 0;
-  m_used_iterator = 0;
-  m_free_iterator = 0;
 }
 
 StreamBuffer::~StreamBuffer()
@@ -40,85 +37,48 @@ StreamBuffer::~StreamBuffer()
 
 /* Shared synchronization code for ring buffers
  *
- * The next three functions are to create/delete/use the OpenGL synchronization.
  * ARB_sync (OpenGL 3.2) is used and required.
  *
- * To reduce overhead, the complete buffer is splitted up into SYNC_POINTS chunks.
- * For each of this chunks, there is a fence which checks if this chunk is still in use.
- *
- * As our API allows to alloc more memory then it has to use, we have to catch how much is already
- * written.
- *
- * m_iterator      - writing position
- * m_free_iterator - last position checked if free
- * m_used_iterator - last position known to be written
- *
- * So on alloc, we have to wait for all slots between m_free_iterator and m_iterator (and set
- * m_free_iterator to m_iterator afterwards).
- *
- * We also assume that this buffer is accessed by the GPU between the Unmap and Map function,
- * so we may create the fences on the start of mapping.
- * Some here, new fences for the chunks between m_used_iterator and m_iterator (also update
- * m_used_iterator).
- *
- * As ring buffers have an ugly behavior on rollover, have fun to read this code ;)
+ * The buffer is accessed by the GPU between the Unmap and Map function, so the fences for what
+ * was written before are created on the start of mapping. To reduce overhead, that only happens
+ * once a part of the buffer has been filled, or when the GPU has to be waited for anyway.
+ * StreamRingAllocator decides which fence to wait for when the buffer is full.
  */
 
-void StreamBuffer::CreateFences()
-{
-  for (int i = 0; i < SYNC_POINTS; i++)
-  {
-    m_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-  }
-}
 void StreamBuffer::DeleteFences()
 {
-  for (int i = Slot(m_free_iterator) + 1; i < SYNC_POINTS; i++)
-  {
-    glDeleteSync(m_fences[i]);
-  }
-  for (int i = 0; i < Slot(m_iterator); i++)
-  {
-    glDeleteSync(m_fences[i]);
-  }
+  m_ring.ReleaseFences([](GLsync fence) { glDeleteSync(fence); });
 }
-void StreamBuffer::AllocMemory(u32 size)
-{
-  // insert waiting slots for used memory
-  for (int i = Slot(m_used_iterator); i < Slot(m_iterator); i++)
-  {
-    m_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-  }
-  m_used_iterator = m_iterator;
 
-  // wait for new slots to end of buffer
-  for (int i = Slot(m_free_iterator) + 1; i <= Slot(m_iterator + size) && i < SYNC_POINTS; i++)
-  {
-    glClientWaitSync(m_fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
-    glDeleteSync(m_fences[i]);
-  }
-  m_free_iterator = m_iterator + size;
-
-  // if buffer is full
-  if (m_iterator + size >= m_size)
-  {
-    // insert waiting slots in unused space at the end of the buffer
-    for (int i = Slot(m_used_iterator); i < SYNC_POINTS; i++)
-    {
-      m_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-    }
-
-    // move to the start
-    m_used_iterator = m_iterator = 0;  // offset 0 is always aligned
-
-    // wait for space at the start
-    for (int i = 0; i <= Slot(m_iterator + size); i++)
-    {
-      glClientWaitSync(m_fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
-      glDeleteSync(m_fences[i]);
-    }
-    m_free_iterator = m_iterator + size;
-  }
+void StreamBuffer::AllocMemory(u32 size, u32 stride)
+{
+  const auto create_fence = [this]() {
+    m_ring.AddFence(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+  };
+
+  if (m_ring.NeedsFence() && m_ring.GetUnfencedBytes() >= m_size / SYNC_POINTS)
+    create_fence();
+
+  if (m_ring.TryAllocate(size, stride))
+    return;
+
+  // Everything written so far has to be covered by a fence before waiting for the GPU.
+  if (m_ring.NeedsFence())
+    create_fence();
+
+  const auto wait_for_fence = [](GLsync fence) {
+    glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+  };
+  const auto delete_fence = [](GLsync fence) { glDeleteSync(fence); };
+  if (m_ring.WaitForSpace(size, stride, wait_for_fence, delete_fence))
+    return;
+
+  // The GPU has caught up without a fence telling us so, start over at the beginning.
+  m_ring.ReleaseFences([&](GLsync fence) {
+    wait_for_fence(fence);
+    delete_fence(fence);
+  });
+  m_ring.Reset(m_size);
 }
 
 /* The usual way to stream data to the GPU.
@@ -138,12 +98,14 @@ public:
   }
 
   ~MapAndOrphan() {}
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
+    m_iterator = Common::AlignUp(m_iterator, stride);
     if (m_iterator + size >= m_size)
     {
       glBufferData(m_buffertype, m_size, nullptr, GL_STREAM_DRAW);
       m_iterator = 0;
+      INCSTAT(stats.thisFrame.numStreamBufferWraps);
     }
     u8* pointer = (u8*)glMapBufferRange(m_buffertype, m_iterator, size,
                                         GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT |
@@ -157,6 +119,9 @@ public:
     glUnmapBuffer(m_buffertype);
     m_iterator += used_size;
   }
+
+private:
+  u32 m_iterator = 0;
 };
 
 /* A modified streaming way without reallocation
@@ -171,26 +136,26 @@ class MapAndSync : public StreamBuffer
 public:
   MapAndSync(u32 type, u32 size) : StreamBuffer(type, size)
   {
-    CreateFences();
     glBindBuffer(m_buffertype, m_buffer);
     glBufferData(m_buffertype, m_size, nullptr, GL_STREAM_DRAW);
   }
 
   ~MapAndSync() { DeleteFences(); }
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
-    AllocMemory(size);
-    u8* pointer = (u8*)glMapBufferRange(m_buffertype, m_iterator, size,
+    AllocMemory(size, stride);
+    const u32 offset = static_cast<u32>(m_ring.GetCurrentOffset());
+    u8* pointer = (u8*)glMapBufferRange(m_buffertype, offset, size,
                                         GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT |
                                             GL_MAP_UNSYNCHRONIZED_BIT);
-    return std::make_pair(pointer, m_iterator);
+    return std::make_pair(pointer, offset);
   }
 
   void Unmap(u32 used_size) override
   {
     glFlushMappedBufferRange(m_buffertype, 0, used_size);
     glUnmapBuffer(m_buffertype);
-    m_iterator += used_size;
+    m_ring.Commit(used_size);
   }
 };
 
@@ -213,7 +178,6 @@ public:
   BufferStorage(u32 type, u32 size, bool _coherent = false)
       : StreamBuffer(type, size), coherent(_coherent)
   {
-    CreateFences();
     glBindBuffer(m_buffertype, m_buffer);
 
     // PERSISTANT_BIT to make sure that the buffer can be used while mapped
@@ -234,17 +198,18 @@ public:
     glBindBuffer(m_buffertype, 0);
   }
 
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
-    AllocMemory(size);
-    return std::make_pair(m_pointer + m_iterator, m_iterator);
+    AllocMemory(size, stride);
+    const u32 offset = static_cast<u32>(m_ring.GetCurrentOffset());
+    return std::make_pair(m_pointer + offset, offset);
   }
 
   void Unmap(u32 used_size) override
   {
     if (!coherent)
-      glFlushMappedBufferRange(m_buffertype, m_iterator, used_size);
-    m_iterator += used_size;
+      glFlushMappedBufferRange(m_buffertype, m_ring.GetCurrentOffset(), used_size);
+    m_ring.Commit(used_size);
   }
 
   u8* m_pointer;
@@ -263,7 +228,6 @@ class PinnedMemory : public StreamBuffer
 public:
   PinnedMemory(u32 type, u32 size) : StreamBuffer(type, size)
   {
-    CreateFences();
     m_pointer = static_cast<u8*>(Common::AllocateAlignedMemory(
         Common::AlignUp(m_size, ALIGN_PINNED_MEMORY), ALIGN_PINNED_MEMORY));
     glBindBuffer(GL_EXTERNAL_VIRTUAL_MEMORY_BUFFER_AMD, m_buffer);
@@ -282,13 +246,14 @@ public:
     m_pointer = nullptr;
   }
 
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
-    AllocMemory(size);
-    return std::make_pair(m_pointer + m_iterator, m_iterator);
+    AllocMemory(size, stride);
+    const u32 offset = static_cast<u32>(m_ring.GetCurrentOffset());
+    return std::make_pair(m_pointer + offset, offset);
   }
 
-  void Unmap(u32 used_size) override { m_iterator += used_size; }
+  void Unmap(u32 used_size) override { m_ring.Commit(used_size); }
   u8* m_pointer;
   static const u32 ALIGN_PINNED_MEMORY = 4096;
 };
@@ -309,7 +274,7 @@ public:
   }
 
   ~BufferSubData() { delete[] m_pointer; }
-  std::pair<u8*, u32> Map(u32 size) override { return std::make_pair(m_pointer, 0); }
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override { return std::make_pair(m_pointer, 0); }
   void Unmap(u32 used_size) override { glBufferSubData(m_buffertype, 0, used_size, m_pointer); }
   u8* m_pointer;
 };
@@ -329,7 +294,7 @@ public:
   }
 
   ~BufferData() { delete[] m_pointer; }
-  std::pair<u8*, u32> Map(u32 size) override { return std::make_pair(m_pointer, 0); }
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override { return std::make_pair(m_pointer, 0); }
   void Unmap(u32 used_size) override
   {
     glBufferData(m_buffertype, used_size, m_pointer, GL_STREAM_DRAW);
@@ -4,12 +4,12 @@
 
 #pragma once
 
-#include <array>
 #include <memory>
 #include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLUtil.h"
+#include "VideoCommon/StreamRingAllocator.h"
 
 namespace OGL
 {
@@ -27,39 +27,26 @@ public:
    * Mapping invalidates the current buffer content,
    * so it isn't allowed to access the old content any more.
    */
-  virtual std::pair<u8*, u32> Map(u32 size) = 0;
+  virtual std::pair<u8*, u32> Map(u32 size, u32 stride) = 0;
   virtual void Unmap(u32 used_size) = 0;
 
-  std::pair<u8*, u32> Map(u32 size, u32 stride)
-  {
-    u32 padding = m_iterator % stride;
-    if (padding)
-    {
-      m_iterator += stride - padding;
-    }
-    return Map(size);
-  }
-
+  std::pair<u8*, u32> Map(u32 size) { return Map(size, 1); }
   const u32 m_buffer;
 
 protected:
   StreamBuffer(u32 type, u32 size);
-  void CreateFences();
   void DeleteFences();
-  void AllocMemory(u32 size);
+  void AllocMemory(u32 size, u32 stride);
 
   const u32 m_buffertype;
   const u32 m_size;
 
-  u32 m_iterator;
-  u32 m_used_iterator;
-  u32 m_free_iterator;
+  // Offsets and fences of the buffers which are written while the GPU reads them
+  StreamRingAllocator<GLsync> m_ring;
 
 private:
-  static constexpr int SYNC_POINTS = 16;
-  int Slot(u32 x) const { return x >> m_bit_per_slot; }
-  const int m_bit_per_slot;
-
-  std::array<GLsync, SYNC_POINTS> m_fences{};
+  // Unless the GPU has to be waited for, a fence is only created once 1 / SYNC_POINTS of the
+  // buffer has been written since the last one.
+  static constexpr u32 SYNC_POINTS = 16;
 };
 }
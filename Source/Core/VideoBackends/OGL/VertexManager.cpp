@@ -21,6 +21,7 @@
 #include "VideoCommon/BoundingBox.h"
 
 #include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -106,11 +107,11 @@ void VertexManager::Draw(u32 stride)
   {
   case PRIMITIVE_POINTS:
     primitive_mode = GL_POINTS;
-    glDisable(GL_CULL_FACE);
+    static_cast<Renderer*>(g_renderer.get())->DisableCulling();
     break;
   case PRIMITIVE_LINES:
     primitive_mode = GL_LINES;
-    glDisable(GL_CULL_FACE);
+    static_cast<Renderer*>(g_renderer.get())->DisableCulling();
     break;
   case PRIMITIVE_TRIANGLES:
     primitive_mode =
@@ -118,7 +119,21 @@ void VertexManager::Draw(u32 stride)
     break;
   }
 
-  if (g_ogl_config.bSupportsGLBaseVertex)
+  if (UseInstancedStereo())
+  {
+    // The vertex shader sends each instance to the layer of one eye.
+    if (g_ogl_config.bSupportsGLBaseVertex)
+    {
+      glDrawElementsInstancedBaseVertex(primitive_mode, index_size, GL_UNSIGNED_SHORT,
+                                        (u8*)nullptr + s_index_offset, 2, (GLint)s_baseVertex);
+    }
+    else
+    {
+      glDrawElementsInstanced(primitive_mode, index_size, GL_UNSIGNED_SHORT,
+                              (u8*)nullptr + s_index_offset, 2);
+    }
+  }
+  else if (g_ogl_config.bSupportsGLBaseVertex)
   {
     glDrawRangeElementsBaseVertex(primitive_mode, 0, max_index, index_size, GL_UNSIGNED_SHORT,
                                   (u8*)nullptr + s_index_offset, (GLint)s_baseVertex);
@@ -140,7 +155,10 @@ void VertexManager::vFlush()
   GLVertexFormat* nativeVertexFmt = (GLVertexFormat*)VertexLoaderManager::GetCurrentVertexFormat();
   u32 stride = nativeVertexFmt->GetVertexStride();
 
-  ProgramShaderCache::SetShader(m_current_primitive_type, nativeVertexFmt);
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderCompileWait);
+    ProgramShaderCache::SetShader(m_current_primitive_type, nativeVertexFmt);
+  }
 
   PrepareDrawBuffers(stride);
 
@@ -161,7 +179,8 @@ void VertexManager::vFlush()
   }
 
   g_Config.iSaveTargetId++;
-  ClearEFBCache();
+  if (!g_ActiveConfig.bEFBAccessDeferInvalidation)
+    ClearEFBCache();
 }
 
 }  // namespace
@@ -13,6 +13,7 @@ class VideoBackend : public VideoBackendBase
 {
   bool Initialize(void*) override;
   void Shutdown() override;
+  void ReleasePersistentState() override;
 
   std::string GetName() const override;
   std::string GetDisplayName() const override;
@@ -27,5 +28,9 @@ class VideoBackend : public VideoBackendBase
 private:
   bool InitializeGLExtensions();
   bool FillBackendInfo();
+
+  // What the current GL context was created for.
+  void* m_window_handle = nullptr;
+  bool m_quad_buffer = false;
 };
 }
@@ -166,11 +166,22 @@ bool VideoBackend::Initialize(void* window_handle)
   InitBackendInfo();
   InitializeShared();
 
+  // A context kept from the last boot is reused, if it was created for the same window.
+  const bool quad_buffer = g_ActiveConfig.iStereoMode == STEREO_QUADBUFFER;
+  if (GLInterface && window_handle == m_window_handle && quad_buffer == m_quad_buffer)
+    return true;
+  ReleasePersistentState();
+
   InitInterface();
   GLInterface->SetMode(GLInterfaceMode::MODE_DETECT);
-  if (!GLInterface->Create(window_handle, g_ActiveConfig.iStereoMode == STEREO_QUADBUFFER))
+  if (!GLInterface->Create(window_handle, quad_buffer))
+  {
+    GLInterface.reset();
     return false;
+  }
 
+  m_window_handle = window_handle;
+  m_quad_buffer = quad_buffer;
   return true;
 }
 
@@ -190,7 +201,8 @@ void VideoBackend::Video_Prepare()
 
   g_vertex_manager = std::make_unique<VertexManager>();
   g_perf_query = GetPerfQuery();
-  ProgramShaderCache::Init();
+  if (!ProgramShaderCache::Resume())
+    ProgramShaderCache::Init();
   g_texture_cache = std::make_unique<TextureCache>();
   g_sampler_cache = std::make_unique<SamplerCache>();
   static_cast<Renderer*>(g_renderer.get())->Init();
@@ -200,9 +212,26 @@ void VideoBackend::Video_Prepare()
 
 void VideoBackend::Shutdown()
 {
+  if (!IsPersistentSession())
+    ReleasePersistentState();
+  ShutdownShared();
+}
+
+void VideoBackend::ReleasePersistentState()
+{
+  if (!GLInterface)
+    return;
+
+  if (ProgramShaderCache::IsSuspended())
+  {
+    GLInterface->MakeCurrent();
+    ProgramShaderCache::Shutdown();
+    GLInterface->ClearCurrent();
+  }
+
   GLInterface->Shutdown();
   GLInterface.reset();
-  ShutdownShared();
+  m_window_handle = nullptr;
 }
 
 void VideoBackend::Video_Cleanup()
@@ -215,7 +244,10 @@ void VideoBackend::Video_Cleanup()
   TextureConverter::Shutdown();
   g_sampler_cache.reset();
   g_texture_cache.reset();
-  ProgramShaderCache::Shutdown();
+  if (IsPersistentSession())
+    ProgramShaderCache::Suspend();
+  else
+    ProgramShaderCache::Shutdown();
   g_perf_query.reset();
   g_vertex_manager.reset();
   g_renderer.reset();
@@ -65,16 +65,10 @@ void Init()
 
 enum
 {
-  SKIP_FLAG = -1,
-  CLIP_POS_X_BIT = 0x01,
-  CLIP_NEG_X_BIT = 0x02,
-  CLIP_POS_Y_BIT = 0x04,
-  CLIP_NEG_Y_BIT = 0x08,
-  CLIP_POS_Z_BIT = 0x10,
-  CLIP_NEG_Z_BIT = 0x20
+  SKIP_FLAG = -1
 };
 
-static inline int CalcClipMask(const OutputVertexData* v)
+int CalcClipMask(const OutputVertexData* v)
 {
   int cmask = 0;
   Vec4 pos = v->projectedPosition;
@@ -189,11 +183,8 @@ static inline void AddInterpolatedVertex(float t, int out, int in, int* numVerti
 
 static void ClipTriangle(int* indices, int* numIndices)
 {
-  int mask = 0;
-
-  mask |= CalcClipMask(Vertices[0]);
-  mask |= CalcClipMask(Vertices[1]);
-  mask |= CalcClipMask(Vertices[2]);
+  // Triangles which are inside of all planes are accepted without clipping.
+  const int mask = Vertices[0]->clipMask | Vertices[1]->clipMask | Vertices[2]->clipMask;
 
   if (mask != 0)
   {
@@ -244,7 +235,7 @@ static void ClipLine(int* indices)
 
   for (int i = 0; i < 2; ++i)
   {
-    clip_mask[i] = CalcClipMask(Vertices[i]);
+    clip_mask[i] = Vertices[i]->clipMask;
     mask |= clip_mask[i];
   }
 
@@ -408,11 +399,8 @@ void ProcessLine(OutputVertexData* lineV0, OutputVertexData* lineV1)
 bool CullTest(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
               bool& backface)
 {
-  int mask = CalcClipMask(v0);
-  mask &= CalcClipMask(v1);
-  mask &= CalcClipMask(v2);
-
-  if (mask)
+  // Triangles which are outside of the same plane with all vertices are rejected.
+  if (v0->clipMask & v1->clipMask & v2->clipMask)
   {
     INCSTAT(stats.thisFrame.numTrianglesRejected)
     return false;
@@ -8,8 +8,21 @@ struct OutputVertexData;
 
 namespace Clipper
 {
+enum
+{
+  CLIP_POS_X_BIT = 0x01,
+  CLIP_NEG_X_BIT = 0x02,
+  CLIP_POS_Y_BIT = 0x04,
+  CLIP_NEG_Y_BIT = 0x08,
+  CLIP_POS_Z_BIT = 0x10,
+  CLIP_NEG_Z_BIT = 0x20
+};
+
 void Init();
 
+// Returns the planes which the projected position of the vertex is outside of.
+int CalcClipMask(const OutputVertexData* v);
+
 void ProcessTriangle(OutputVertexData* v0, OutputVertexData* v1, OutputVertexData* v2);
 
 void ProcessLine(OutputVertexData* v0, OutputVertexData* v1);
@@ -43,6 +43,9 @@ struct OutputVertexData
   Vec3 normal[3] = {};
   u8 color[2][4] = {};
   Vec3 texCoords[8] = {};
+  // The Clipper::CLIP_*_BIT planes which the projected position is outside of. Only the
+  // transform unit sets it, the vertices which the clipper interpolates don't have it.
+  int clipMask = 0;
 
   void Lerp(float t, const OutputVertexData* a, const OutputVertexData* b)
   {
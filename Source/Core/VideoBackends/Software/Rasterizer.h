@@ -11,9 +11,13 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
+// Triangles may be drawn on other threads, after this returns. They have to be drawn before the
+// state changes, so Flush() has to be called at the end of every batch.
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+void Flush();
 
 void SetTevReg(int reg, int comp, s16 color);
 
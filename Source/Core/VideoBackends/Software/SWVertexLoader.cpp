@@ -14,6 +14,7 @@
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoBackends/Software/TransformUnit.h"
 
 #include "VideoCommon/DataReader.h"
@@ -55,6 +56,7 @@ void SWVertexLoader::ResetBuffer(u32 stride)
 
 void SWVertexLoader::vFlush()
 {
+  TextureSampler::InvalidateCache();
   DebugUtil::OnObjectBegin();
 
   u8 primitiveType = 0;
@@ -84,6 +86,29 @@ void SWVertexLoader::vFlush()
     Rasterizer::SetTevReg(i, Tev::ALP_C, PixelShaderManager::constants.kcolors[i][3]);
   }
 
+  // Super Mario Sunshine requires the colors to be zero for those debug boxes.
+  memset(&m_Vertex, 0, sizeof(m_Vertex));
+  SetFormat(g_main_cp_state.last_id, primitiveType);
+
+  // parse the videocommon format to our own struct format
+  const PortableVertexDeclaration& vdec =
+      VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration();
+  const u32 num_vertices = IndexGenerator::GetNumVerts();
+  m_InputVertices.resize(num_vertices);
+  for (u32 i = 0; i < num_vertices; i++)
+  {
+    m_InputVertices[i] = m_Vertex;
+    ParseVertex(vdec, i, &m_InputVertices[i]);
+  }
+
+  // transform the vertices so that they can be used for rasterization
+  m_OutputVertices.resize(num_vertices);
+  memset(m_OutputVertices.data(), 0, num_vertices * sizeof(OutputVertexData));
+  TransformUnit::TransformVertices(
+      m_InputVertices.data(), m_OutputVertices.data(), num_vertices,
+      (VertexLoaderManager::g_current_components & VB_HAS_NRM0) != 0,
+      (VertexLoaderManager::g_current_components & VB_HAS_NRM2) != 0, m_TexGenSpecialCase);
+
   for (u32 i = 0; i < IndexGenerator::GetIndexLen(); i++)
   {
     u16 index = LocalIBuffer[i];
@@ -94,26 +119,8 @@ void SWVertexLoader::vFlush()
       m_SetupUnit.Init(primitiveType);
       continue;
     }
-    memset(&m_Vertex, 0, sizeof(m_Vertex));
 
-    // Super Mario Sunshine requires those to be zero for those debug boxes.
-    memset(&m_Vertex.color, 0, sizeof(m_Vertex.color));
-
-    // parse the videocommon format to our own struct format (m_Vertex)
-    SetFormat(g_main_cp_state.last_id, primitiveType);
-    ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
-
-    // transform this vertex so that it can be used for rasterization (outVertex)
-    OutputVertexData* outVertex = m_SetupUnit.GetVertex();
-    TransformUnit::TransformPosition(&m_Vertex, outVertex);
-    memset(&outVertex->normal, 0, sizeof(outVertex->normal));
-    if (VertexLoaderManager::g_current_components & VB_HAS_NRM0)
-    {
-      TransformUnit::TransformNormal(
-          &m_Vertex, (VertexLoaderManager::g_current_components & VB_HAS_NRM2) != 0, outVertex);
-    }
-    TransformUnit::TransformColor(&m_Vertex, outVertex);
-    TransformUnit::TransformTexCoord(&m_Vertex, outVertex, m_TexGenSpecialCase);
+    *m_SetupUnit.GetVertex() = m_OutputVertices[index];
 
     // assemble and rasterize the primitive
     m_SetupUnit.SetupVertex();
@@ -121,6 +128,8 @@ void SWVertexLoader::vFlush()
     INCSTAT(stats.thisFrame.numVerticesLoaded)
   }
 
+  Rasterizer::Flush();
+
   DebugUtil::OnObjectEnd();
 }
 
@@ -211,33 +220,34 @@ static void ReadVertexAttribute(T* dst, DataReader src, const AttributeFormat& f
   }
 }
 
-void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index)
+void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index,
+                                 InputVertexData* vertex)
 {
   DataReader src(LocalVBuffer.data(), LocalVBuffer.data() + LocalVBuffer.size());
   src.Skip(index * vdec.stride);
 
-  ReadVertexAttribute<float>(&m_Vertex.position[0], src, vdec.position, 0, 3, false);
+  ReadVertexAttribute<float>(&vertex->position[0], src, vdec.position, 0, 3, false);
 
   for (int i = 0; i < 3; i++)
   {
-    ReadVertexAttribute<float>(&m_Vertex.normal[i][0], src, vdec.normals[i], 0, 3, false);
+    ReadVertexAttribute<float>(&vertex->normal[i][0], src, vdec.normals[i], 0, 3, false);
   }
 
   for (int i = 0; i < 2; i++)
   {
-    ReadVertexAttribute<u8>(m_Vertex.color[i], src, vdec.colors[i], 0, 4, true);
+    ReadVertexAttribute<u8>(vertex->color[i], src, vdec.colors[i], 0, 4, true);
   }
 
   for (int i = 0; i < 8; i++)
   {
-    ReadVertexAttribute<float>(m_Vertex.texCoords[i], src, vdec.texcoords[i], 0, 2, false);
+    ReadVertexAttribute<float>(vertex->texCoords[i], src, vdec.texcoords[i], 0, 2, false);
 
     // the texmtr is stored as third component of the texCoord
     if (vdec.texcoords[i].components >= 3)
     {
-      ReadVertexAttribute<u8>(&m_Vertex.texMtx[i], src, vdec.texcoords[i], 2, 1, false);
+      ReadVertexAttribute<u8>(&vertex->texMtx[i], src, vdec.texcoords[i], 2, 1, false);
     }
   }
 
-  ReadVertexAttribute<u8>(&m_Vertex.posMtx, src, vdec.posmtx, 0, 1, false);
+  ReadVertexAttribute<u8>(&vertex->posMtx, src, vdec.posmtx, 0, 1, false);
 }
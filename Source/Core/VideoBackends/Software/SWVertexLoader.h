@@ -31,9 +31,14 @@ private:
   std::vector<u8> LocalVBuffer;
   std::vector<u16> LocalIBuffer;
 
+  // The attributes which come from the registers rather than the vertex data.
   InputVertexData m_Vertex;
 
-  void ParseVertex(const PortableVertexDeclaration& vdec, int index);
+  // Every vertex of the buffer is transformed once, rather than for every index which uses it.
+  std::vector<InputVertexData> m_InputVertices;
+  std::vector<OutputVertexData> m_OutputVertices;
+
+  void ParseVertex(const PortableVertexDeclaration& vdec, int index, InputVertexData* vertex);
 
   SetupUnit m_SetupUnit;
 
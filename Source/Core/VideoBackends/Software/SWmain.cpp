@@ -120,6 +120,7 @@ void VideoSoftware::InitBackendInfo()
   g_Config.backend_info.bSupportsComputeShaders = false;
   g_Config.backend_info.bSupportsInternalResolutionFrameDumps = false;
   g_Config.backend_info.bSupportsGPUTextureDecoding = false;
+  g_Config.backend_info.bSupportsGPUTimers = false;
   g_Config.backend_info.bSupportsST3CTextures = false;
   g_Config.backend_info.bSupportsBPTCTextures = false;
 
@@ -155,6 +156,7 @@ void VideoSoftware::Video_Cleanup()
 
   SWRenderer::Shutdown();
   DebugUtil::Shutdown();
+  Rasterizer::Shutdown();
   // The following calls are NOT Thread Safe
   // And need to be called from the video thread
   SWRenderer::Shutdown();
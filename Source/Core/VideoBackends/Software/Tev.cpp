@@ -2,10 +2,13 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "VideoBackends/Software/DebugUtil.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/Tev.h"
@@ -14,7 +17,6 @@
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
@@ -157,6 +159,8 @@ void Tev::Init()
   m_ScaleRShiftLUT[1] = 0;
   m_ScaleRShiftLUT[2] = 0;
   m_ScaleRShiftLUT[3] = 1;
+
+  ResetCounters();
 }
 
 static inline s16 Clamp255(s16 in)
@@ -374,6 +378,96 @@ void Tev::DrawAlphaCompare(TevStageCombiner::AlphaCombiner& ac, const InputRegTy
   }
 }
 
+#ifdef _M_X86
+// Evaluates both regular combiners of a stage at once, with the alpha and the three color
+// components in a lane each. Gives the same results as DrawColorRegular() and DrawAlphaRegular()
+// followed by the clamping in Draw().
+void Tev::DrawRegularSSE2(const TevStageCombiner::ColorCombiner& cc,
+                          const TevStageCombiner::AlphaCombiner& ac)
+{
+  // Lanes are in the same ABGR order as the registers.
+  __m128i a = _mm_setr_epi16(*m_AlphaInputLUT[ac.a], *m_ColorInputLUT[cc.a][BLU_INP],
+                             *m_ColorInputLUT[cc.a][GRN_INP], *m_ColorInputLUT[cc.a][RED_INP], 0,
+                             0, 0, 0);
+  __m128i b = _mm_setr_epi16(*m_AlphaInputLUT[ac.b], *m_ColorInputLUT[cc.b][BLU_INP],
+                             *m_ColorInputLUT[cc.b][GRN_INP], *m_ColorInputLUT[cc.b][RED_INP], 0,
+                             0, 0, 0);
+  __m128i c = _mm_setr_epi16(*m_AlphaInputLUT[ac.c], *m_ColorInputLUT[cc.c][BLU_INP],
+                             *m_ColorInputLUT[cc.c][GRN_INP], *m_ColorInputLUT[cc.c][RED_INP], 0,
+                             0, 0, 0);
+  __m128i d = _mm_setr_epi16(*m_AlphaInputLUT[ac.d], *m_ColorInputLUT[cc.d][BLU_INP],
+                             *m_ColorInputLUT[cc.d][GRN_INP], *m_ColorInputLUT[cc.d][RED_INP], 0,
+                             0, 0, 0);
+
+  // Same truncation as InputRegType: a, b and c are unsigned 8 bit, d is signed 11 bit.
+  const __m128i mask_u8 = _mm_set1_epi16(0xFF);
+  a = _mm_and_si128(a, mask_u8);
+  b = _mm_and_si128(b, mask_u8);
+  c = _mm_and_si128(c, mask_u8);
+  d = _mm_srai_epi16(_mm_slli_epi16(d, 5), 5);
+
+  // c goes from 0 to 256
+  c = _mm_add_epi16(c, _mm_srli_epi16(c, 7));
+
+  const s16 alpha_scale = 1 << m_ScaleLShiftLUT[ac.shift];
+  const s16 color_scale = 1 << m_ScaleLShiftLUT[cc.shift];
+  const __m128i scale =
+      _mm_setr_epi16(alpha_scale, color_scale, color_scale, color_scale, 0, 0, 0, 0);
+
+  // temp = (a * (256 - c) + b * c) << shift, the weights are scaled instead of the sum.
+  const __m128i weight_a = _mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(256), c), scale);
+  const __m128i weight_b = _mm_mullo_epi16(c, scale);
+  __m128i temp =
+      _mm_madd_epi16(_mm_unpacklo_epi16(a, b), _mm_unpacklo_epi16(weight_a, weight_b));
+
+  // The rounding and the sign are applied differently for color and alpha.
+  const s32 alpha_round = (ac.shift != 3) ? 0 : (ac.op == 1) ? 127 : 128;
+  const s32 color_round = (cc.shift == 3) ? 0 : (cc.op == 1) ? 127 : 128;
+  temp = _mm_add_epi32(temp, _mm_setr_epi32(alpha_round, color_round, color_round, color_round));
+
+  const __m128i negate_before_shift = _mm_setr_epi32(ac.op ? -1 : 0, 0, 0, 0);
+  const s32 color_negate = cc.op ? -1 : 0;
+  const __m128i negate_after_shift = _mm_setr_epi32(0, color_negate, color_negate, color_negate);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before_shift), negate_before_shift);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after_shift), negate_after_shift);
+
+  // result = (((d + bias) << shift) + temp) >> rshift
+  const __m128i bias =
+      _mm_setr_epi16(m_BiasLUT[ac.bias], m_BiasLUT[cc.bias], m_BiasLUT[cc.bias],
+                     m_BiasLUT[cc.bias], 0, 0, 0, 0);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i result = _mm_madd_epi16(_mm_unpacklo_epi16(_mm_add_epi16(d, bias), zero),
+                                  _mm_unpacklo_epi16(scale, zero));
+  result = _mm_add_epi32(result, temp);
+
+  const s32 color_rshift = m_ScaleRShiftLUT[cc.shift] ? -1 : 0;
+  const __m128i rshift_mask =
+      _mm_setr_epi32(m_ScaleRShiftLUT[ac.shift] ? -1 : 0, color_rshift, color_rshift, color_rshift);
+  result = _mm_or_si128(_mm_and_si128(rshift_mask, _mm_srai_epi32(result, 1)),
+                        _mm_andnot_si128(rshift_mask, result));
+
+  // The results always fit into 16 bits, so the saturation never kicks in.
+  result = _mm_packs_epi32(result, result);
+
+  const s16 alpha_min = ac.clamp ? 0 : -1024;
+  const s16 alpha_max = ac.clamp ? 255 : 1023;
+  const s16 color_min = cc.clamp ? 0 : -1024;
+  const s16 color_max = cc.clamp ? 255 : 1023;
+  result = _mm_max_epi16(result, _mm_setr_epi16(alpha_min, color_min, color_min, color_min,
+                                                0, 0, 0, 0));
+  result = _mm_min_epi16(result, _mm_setr_epi16(alpha_max, color_max, color_max, color_max,
+                                                0, 0, 0, 0));
+
+  alignas(16) s16 output[8];
+  _mm_store_si128(reinterpret_cast<__m128i*>(output), result);
+  Reg[ac.dest][ALP_C] = output[ALP_C];
+  Reg[cc.dest][BLU_C] = output[BLU_C];
+  Reg[cc.dest][GRN_C] = output[GRN_C];
+  Reg[cc.dest][RED_C] = output[RED_C];
+}
+#endif
+
 static bool AlphaCompare(int alpha, int ref, AlphaTest::CompareMode comp)
 {
   switch (comp)
@@ -567,7 +661,7 @@ void Tev::Draw()
   _assert_(Position[0] >= 0 && Position[0] < EFB_WIDTH);
   _assert_(Position[1] >= 0 && Position[1] < EFB_HEIGHT);
 
-  INCSTAT(stats.thisFrame.tevPixelsIn);
+  PixelsIn++;
 
   // initial color values
   for (int i = 0; i < 4; i++)
@@ -655,48 +749,57 @@ void Tev::Draw()
     // set color
     SetRasColor(order.getColorChan(stageOdd), ac.rswap * 2);
 
-    // combine inputs
-    InputRegType inputs[4];
-    for (int i = 0; i < 3; i++)
-    {
-      inputs[BLU_C + i].a = *m_ColorInputLUT[cc.a][i];
-      inputs[BLU_C + i].b = *m_ColorInputLUT[cc.b][i];
-      inputs[BLU_C + i].c = *m_ColorInputLUT[cc.c][i];
-      inputs[BLU_C + i].d = *m_ColorInputLUT[cc.d][i];
-    }
-    inputs[ALP_C].a = *m_AlphaInputLUT[ac.a];
-    inputs[ALP_C].b = *m_AlphaInputLUT[ac.b];
-    inputs[ALP_C].c = *m_AlphaInputLUT[ac.c];
-    inputs[ALP_C].d = *m_AlphaInputLUT[ac.d];
-
-    if (cc.bias != 3)
-      DrawColorRegular(cc, inputs);
-    else
-      DrawColorCompare(cc, inputs);
-
-    if (cc.clamp)
+#ifdef _M_X86
+    if (cc.bias != 3 && ac.bias != 3)
     {
-      Reg[cc.dest][RED_C] = Clamp255(Reg[cc.dest][RED_C]);
-      Reg[cc.dest][GRN_C] = Clamp255(Reg[cc.dest][GRN_C]);
-      Reg[cc.dest][BLU_C] = Clamp255(Reg[cc.dest][BLU_C]);
+      DrawRegularSSE2(cc, ac);
     }
     else
+#endif
     {
-      Reg[cc.dest][RED_C] = Clamp1024(Reg[cc.dest][RED_C]);
-      Reg[cc.dest][GRN_C] = Clamp1024(Reg[cc.dest][GRN_C]);
-      Reg[cc.dest][BLU_C] = Clamp1024(Reg[cc.dest][BLU_C]);
+      // combine inputs
+      InputRegType inputs[4];
+      for (int i = 0; i < 3; i++)
+      {
+        inputs[BLU_C + i].a = *m_ColorInputLUT[cc.a][i];
+        inputs[BLU_C + i].b = *m_ColorInputLUT[cc.b][i];
+        inputs[BLU_C + i].c = *m_ColorInputLUT[cc.c][i];
+        inputs[BLU_C + i].d = *m_ColorInputLUT[cc.d][i];
+      }
+      inputs[ALP_C].a = *m_AlphaInputLUT[ac.a];
+      inputs[ALP_C].b = *m_AlphaInputLUT[ac.b];
+      inputs[ALP_C].c = *m_AlphaInputLUT[ac.c];
+      inputs[ALP_C].d = *m_AlphaInputLUT[ac.d];
+
+      if (cc.bias != 3)
+        DrawColorRegular(cc, inputs);
+      else
+        DrawColorCompare(cc, inputs);
+
+      if (cc.clamp)
+      {
+        Reg[cc.dest][RED_C] = Clamp255(Reg[cc.dest][RED_C]);
+        Reg[cc.dest][GRN_C] = Clamp255(Reg[cc.dest][GRN_C]);
+        Reg[cc.dest][BLU_C] = Clamp255(Reg[cc.dest][BLU_C]);
+      }
+      else
+      {
+        Reg[cc.dest][RED_C] = Clamp1024(Reg[cc.dest][RED_C]);
+        Reg[cc.dest][GRN_C] = Clamp1024(Reg[cc.dest][GRN_C]);
+        Reg[cc.dest][BLU_C] = Clamp1024(Reg[cc.dest][BLU_C]);
+      }
+
+      if (ac.bias != 3)
+        DrawAlphaRegular(ac, inputs);
+      else
+        DrawAlphaCompare(ac, inputs);
+
+      if (ac.clamp)
+        Reg[ac.dest][ALP_C] = Clamp255(Reg[ac.dest][ALP_C]);
+      else
+        Reg[ac.dest][ALP_C] = Clamp1024(Reg[ac.dest][ALP_C]);
     }
 
-    if (ac.bias != 3)
-      DrawAlphaRegular(ac, inputs);
-    else
-      DrawAlphaCompare(ac, inputs);
-
-    if (ac.clamp)
-      Reg[ac.dest][ALP_C] = Clamp255(Reg[ac.dest][ALP_C]);
-    else
-      Reg[ac.dest][ALP_C] = Clamp1024(Reg[ac.dest][ALP_C]);
-
 #if ALLOW_TEV_DUMPS
     if (g_ActiveConfig.bDumpTevStages)
     {
@@ -831,23 +934,23 @@ void Tev::Draw()
   if (late_ztest && bpmem.zmode.testenable)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    PerfPixelCounts[PQ_ZCOMP_INPUT]++;
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    PerfPixelCounts[PQ_ZCOMP_OUTPUT]++;
   }
 
   // branchless bounding box update
-  BoundingBox::coords[BoundingBox::LEFT] =
-      std::min((u16)Position[0], BoundingBox::coords[BoundingBox::LEFT]);
-  BoundingBox::coords[BoundingBox::RIGHT] =
-      std::max((u16)Position[0], BoundingBox::coords[BoundingBox::RIGHT]);
-  BoundingBox::coords[BoundingBox::TOP] =
-      std::min((u16)Position[1], BoundingBox::coords[BoundingBox::TOP]);
-  BoundingBox::coords[BoundingBox::BOTTOM] =
-      std::max((u16)Position[1], BoundingBox::coords[BoundingBox::BOTTOM]);
+  BoundingBoxCoords[BoundingBox::LEFT] =
+      std::min((u16)Position[0], BoundingBoxCoords[BoundingBox::LEFT]);
+  BoundingBoxCoords[BoundingBox::RIGHT] =
+      std::max((u16)Position[0], BoundingBoxCoords[BoundingBox::RIGHT]);
+  BoundingBoxCoords[BoundingBox::TOP] =
+      std::min((u16)Position[1], BoundingBoxCoords[BoundingBox::TOP]);
+  BoundingBoxCoords[BoundingBox::BOTTOM] =
+      std::max((u16)Position[1], BoundingBoxCoords[BoundingBox::BOTTOM]);
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
@@ -869,12 +972,25 @@ void Tev::Draw()
   }
 #endif
 
-  INCSTAT(stats.thisFrame.tevPixelsOut);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  PixelsOut++;
+  PerfPixelCounts[PQ_BLEND_INPUT]++;
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
 
+void Tev::ResetCounters()
+{
+  std::fill(std::begin(PerfPixelCounts), std::end(PerfPixelCounts), 0);
+  PixelsIn = 0;
+  PixelsOut = 0;
+
+  // Empty, so that merging it into the global bounding box doesn't change anything.
+  BoundingBoxCoords[BoundingBox::LEFT] = 0xFFFF;
+  BoundingBoxCoords[BoundingBox::RIGHT] = 0;
+  BoundingBoxCoords[BoundingBox::TOP] = 0xFFFF;
+  BoundingBoxCoords[BoundingBox::BOTTOM] = 0;
+}
+
 void Tev::SetRegColor(int reg, int comp, s16 color)
 {
   KonstantColors[reg][comp] = color;
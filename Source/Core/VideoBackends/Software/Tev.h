@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -63,6 +65,10 @@ class Tev
   void DrawColorCompare(TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+#ifdef _M_X86
+  void DrawRegularSSE2(const TevStageCombiner::ColorCombiner& cc,
+                       const TevStageCombiner::AlphaCombiner& ac);
+#endif
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
@@ -75,6 +81,13 @@ public:
   s32 TextureLod[16];
   bool TextureLinear[16];
 
+  // Everything Draw() counts besides the pixels it writes to the EFB. The rasterizer gives each of
+  // its threads a Tev of its own and adds these to the global counters once the threads are done.
+  u32 PerfPixelCounts[PQ_NUM_MEMBERS];
+  u32 PixelsIn;
+  u32 PixelsOut;
+  u16 BoundingBoxCoords[4];
+
   enum
   {
     ALP_C,
@@ -87,5 +100,7 @@ public:
 
   void Draw();
 
+  void ResetCounters();
+
   void SetRegColor(int reg, int comp, s16 color);
 };
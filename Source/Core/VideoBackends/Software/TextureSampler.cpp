@@ -5,9 +5,13 @@
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
@@ -18,6 +22,135 @@
 
 namespace TextureSampler
 {
+namespace
+{
+// Bilinear filtering reads four texels per sample, and neighbouring pixels read mostly the same
+// ones, so decoding every texel on demand repeats most of the work. Instead, whole GX tiles are
+// decoded to RGBA8 once and kept in a small direct-mapped cache. The rasterizer samples from
+// several threads, so each thread has its own cache. Textures only change between draws, and
+// bumping the generation at the start of every draw empties all of them.
+// Enough for a few rows of tiles of a 256 texel wide texture.
+constexpr u32 TILE_CACHE_SIZE = 256;
+// CMPR has the largest tiles, 8x8 texels.
+constexpr int MAX_TILE_TEXELS = 8 * 8;
+
+struct CachedTile
+{
+  const u8* src = nullptr;
+  const u8* src_odd = nullptr;
+  const u8* tlut = nullptr;
+  TextureFormat format = TextureFormat::I4;
+  TLUTFormat tlut_format = TLUTFormat::IA8;
+  u32 generation = 0;
+  std::array<u32, MAX_TILE_TEXELS> texels{};
+};
+
+// Everything needed to find a tile of the texture being sampled.
+struct TileSource
+{
+  const u8* src;
+  // The second TMEM bank of RGBA8 textures, or null for the other ones.
+  const u8* src_odd;
+  const u8* tlut;
+  TextureFormat format;
+  TLUTFormat tlut_format;
+  u32 generation;
+  int width_blocks;
+  int block_width_log2;
+  int block_height_log2;
+  int block_size;
+  // The tile of the previous fetch, which bilinear filtering mostly reads again.
+  int last_block = -1;
+  const CachedTile* last_tile = nullptr;
+};
+
+std::atomic<u32> s_generation{1};
+thread_local std::array<CachedTile, TILE_CACHE_SIZE> t_tiles;
+
+TileSource GetTileSource(const u8* src, const u8* src_odd, const u8* tlut, TextureFormat format,
+                         TLUTFormat tlut_format, int image_width)
+{
+  const int block_width = TexDecoder_GetBlockWidthInTexels(format);
+  const int block_height = TexDecoder_GetBlockHeightInTexels(format);
+
+  TileSource source;
+  source.src = src;
+  source.src_odd = src_odd;
+  source.tlut = tlut;
+  source.format = format;
+  source.tlut_format = tlut_format;
+  source.generation = s_generation.load(std::memory_order_relaxed);
+  // The same tile layout as TexDecoder_DecodeTexel uses.
+  source.width_blocks = image_width / block_width + 1;
+  source.block_width_log2 = IntLog2(block_width);
+  source.block_height_log2 = IntLog2(block_height);
+  // The AR and GB halves of RGBA8 tiles in TMEM are in separate banks, 32 bytes each.
+  source.block_size =
+      src_odd ? 32 : block_width * block_height * TexDecoder_GetTexelSizeInNibbles(format) / 2;
+  return source;
+}
+
+const CachedTile& GetTile(const TileSource& source, int block)
+{
+  const u8* src = source.src + block * source.block_size;
+  const u8* src_odd = source.src_odd ? source.src_odd + block * source.block_size : nullptr;
+
+  // Consecutive tiles of a texture go to consecutive entries.
+  CachedTile& tile = t_tiles[block % TILE_CACHE_SIZE];
+  if (tile.generation == source.generation && tile.src == src && tile.src_odd == src_odd &&
+      tile.tlut == source.tlut && tile.format == source.format &&
+      tile.tlut_format == source.tlut_format)
+  {
+    return tile;
+  }
+
+  const int width = 1 << source.block_width_log2;
+  const int height = 1 << source.block_height_log2;
+  if (src_odd)
+  {
+    u8 interleaved[64];
+    TexDecoder_InterleaveRGBA8FromTmem(interleaved, src, src_odd, width, height);
+    _TexDecoder_DecodeImpl(tile.texels.data(), interleaved, width, height, TextureFormat::RGBA8,
+                           nullptr, source.tlut_format);
+  }
+  else
+  {
+    // Not TexDecoder_Decode, whose format overlay doesn't fit into a single tile.
+    _TexDecoder_DecodeImpl(tile.texels.data(), src, width, height, source.format, source.tlut,
+                           source.tlut_format);
+  }
+  tile.src = src;
+  tile.src_odd = src_odd;
+  tile.tlut = source.tlut;
+  tile.format = source.format;
+  tile.tlut_format = source.tlut_format;
+  tile.generation = source.generation;
+  return tile;
+}
+
+inline void FetchTexel(TileSource& source, int s, int t, u8* texel)
+{
+  const int block_s = s >> source.block_width_log2;
+  const int block_t = t >> source.block_height_log2;
+  const int block = block_t * source.width_blocks + block_s;
+  if (block != source.last_block)
+  {
+    source.last_block = block;
+    source.last_tile = &GetTile(source, block);
+  }
+  const CachedTile& tile = *source.last_tile;
+
+  const int tile_s = s - (block_s << source.block_width_log2);
+  const int tile_t = t - (block_t << source.block_height_log2);
+  std::memcpy(texel, &tile.texels[(tile_t << source.block_width_log2) + tile_s], sizeof(u32));
+}
+}  // Anonymous namespace
+
+void InvalidateCache()
+{
+  s_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
 static inline void WrapCoord(int* coordp, int wrapMode, int imageSize)
 {
   int coord = *coordp;
@@ -162,6 +295,8 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     }
   }
 
+  TileSource source = GetTileSource(imageSrc, imageSrcOdd, tlut, texfmt, tlutfmt, imageWidth);
+
   if (linear)
   {
     // offset linear sampling
@@ -187,42 +322,17 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageSPlus1, tm0.wrap_s, imageWidth);
     WrapCoord(&imageTPlus1, tm0.wrap_t, imageHeight);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].image_type))
-    {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
+    FetchTexel(source, imageS, imageT, sampledTex);
+    SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
 
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
-                                          imageWidth);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
+    FetchTexel(source, imageSPlus1, imageT, sampledTex);
+    AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
 
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
+    FetchTexel(source, imageS, imageTPlus1, sampledTex);
+    AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
 
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
-                                          imageTPlus1, imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
+    FetchTexel(source, imageSPlus1, imageTPlus1, sampledTex);
+    AddTexel(sampledTex, texel, (fractS) * (fractT));
 
     sample[0] = (u8)(texel[0] >> 14);
     sample[1] = (u8)(texel[1] >> 14);
@@ -239,11 +349,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageS, tm0.wrap_s, imageWidth);
     WrapCoord(&imageT, tm0.wrap_t, imageHeight);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].image_type))
-      TexDecoder_DecodeTexel(sample, imageSrc, imageS, imageT, imageWidth, texfmt, tlut, tlutfmt);
-    else
-      TexDecoder_DecodeTexelRGBA8FromTmem(sample, imageSrc, imageSrcOdd, imageS, imageT,
-                                          imageWidth);
+    FetchTexel(source, imageS, imageT, sample);
   }
 }
 }
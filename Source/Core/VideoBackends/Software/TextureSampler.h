@@ -12,6 +12,10 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
 void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
 
+// Drops the decoded texture tiles of all threads. Called before every draw, since texture memory,
+// TMEM and the TLUTs may have changed since the last one.
+void InvalidateCache();
+
 enum
 {
   RED_SMP,
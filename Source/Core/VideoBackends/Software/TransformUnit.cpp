@@ -11,11 +11,13 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 
+#include "VideoBackends/Software/Clipper.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Vec3.h"
 
@@ -90,6 +92,8 @@ void TransformPosition(const InputVertexData* src, OutputVertexData* dst)
   {
     MultipleVec3Ortho(dst->mvPosition, xfmem.projection.rawProjection, dst->projectedPosition);
   }
+
+  dst->clipMask = Clipper::CalcClipMask(dst);
 }
 
 void TransformNormal(const InputVertexData* src, bool nbt, OutputVertexData* dst)
@@ -319,141 +323,662 @@ static void LightAlpha(const Vec3& pos, const Vec3& normal, u8 lightNum, const L
   }
 }
 
+// The ambient color of a channel, which the lights are added to.
+struct ChannelLighting
+{
+  Vec3 color;
+  float alpha;
+};
+
+static ChannelLighting GetAmbientLighting(const InputVertexData* src, u32 chan)
+{
+  ChannelLighting lighting;
+  if (xfmem.color[chan].ambsource)
+  {
+    // vertex
+    lighting.color.x = src->color[chan][1];
+    lighting.color.y = src->color[chan][2];
+    lighting.color.z = src->color[chan][3];
+  }
+  else
+  {
+    const u8* ambColor = reinterpret_cast<u8*>(&xfmem.ambColor[chan]);
+    lighting.color.x = ambColor[1];
+    lighting.color.y = ambColor[2];
+    lighting.color.z = ambColor[3];
+  }
+
+  if (xfmem.alpha[chan].ambsource)
+    lighting.alpha = src->color[chan][0];  // vertex
+  else
+    lighting.alpha = static_cast<float>(xfmem.ambColor[chan] & 0xff);
+
+  return lighting;
+}
+
+// Modulates the material color of the channel with the lighting, if it is enabled.
+static void FinishChannelColor(const InputVertexData* src, u32 chan,
+                               const ChannelLighting& lighting, OutputVertexData* dst)
+{
+  // abgr
+  std::array<u8, 4> matcolor;
+  std::array<u8, 4> chancolor;
+
+  // color
+  const LitChannel& colorchan = xfmem.color[chan];
+  if (colorchan.matsource)
+    std::memcpy(matcolor.data(), src->color[chan], sizeof(u32));  // vertex
+  else
+    std::memcpy(matcolor.data(), &xfmem.matColor[chan], sizeof(u32));
+
+  if (colorchan.enablelighting)
+  {
+    int light_x = MathUtil::Clamp(static_cast<int>(lighting.color.x), 0, 255);
+    int light_y = MathUtil::Clamp(static_cast<int>(lighting.color.y), 0, 255);
+    int light_z = MathUtil::Clamp(static_cast<int>(lighting.color.z), 0, 255);
+    chancolor[1] = (matcolor[1] * (light_x + (light_x >> 7))) >> 8;
+    chancolor[2] = (matcolor[2] * (light_y + (light_y >> 7))) >> 8;
+    chancolor[3] = (matcolor[3] * (light_z + (light_z >> 7))) >> 8;
+  }
+  else
+  {
+    chancolor = matcolor;
+  }
+
+  // alpha
+  const LitChannel& alphachan = xfmem.alpha[chan];
+  if (alphachan.matsource)
+    matcolor[0] = src->color[chan][0];  // vertex
+  else
+    matcolor[0] = xfmem.matColor[chan] & 0xff;
+
+  if (alphachan.enablelighting)
+  {
+    int light_a = MathUtil::Clamp(static_cast<int>(lighting.alpha), 0, 255);
+    chancolor[0] = (matcolor[0] * (light_a + (light_a >> 7))) >> 8;
+  }
+  else
+  {
+    chancolor[0] = matcolor[0];
+  }
+
+  // abgr -> rgba
+  const u32 rgba_color = Common::swap32(chancolor.data());
+  std::memcpy(dst->color[chan], &rgba_color, sizeof(u32));
+}
+
 void TransformColor(const InputVertexData* src, OutputVertexData* dst)
 {
   for (u32 chan = 0; chan < xfmem.numChan.numColorChans; chan++)
   {
-    // abgr
-    std::array<u8, 4> matcolor;
-    std::array<u8, 4> chancolor;
+    ChannelLighting lighting = GetAmbientLighting(src, chan);
 
-    // color
+    // The masks are empty if lighting is disabled.
     const LitChannel& colorchan = xfmem.color[chan];
-    if (colorchan.matsource)
-      std::memcpy(matcolor.data(), src->color[chan], sizeof(u32));  // vertex
-    else
-      std::memcpy(matcolor.data(), &xfmem.matColor[chan], sizeof(u32));
+    const u8 color_mask = colorchan.GetFullLightMask();
+    for (int i = 0; i < 8; ++i)
+    {
+      if (color_mask & (1 << i))
+        LightColor(dst->mvPosition, dst->normal[0], i, colorchan, lighting.color);
+    }
 
-    if (colorchan.enablelighting)
+    const LitChannel& alphachan = xfmem.alpha[chan];
+    const u8 alpha_mask = alphachan.GetFullLightMask();
+    for (int i = 0; i < 8; ++i)
     {
-      Vec3 lightCol;
-      if (colorchan.ambsource)
-      {
-        // vertex
-        lightCol.x = src->color[chan][1];
-        lightCol.y = src->color[chan][2];
-        lightCol.z = src->color[chan][3];
-      }
-      else
-      {
-        const u8* ambColor = reinterpret_cast<u8*>(&xfmem.ambColor[chan]);
-        lightCol.x = ambColor[1];
-        lightCol.y = ambColor[2];
-        lightCol.z = ambColor[3];
-      }
+      if (alpha_mask & (1 << i))
+        LightAlpha(dst->mvPosition, dst->normal[0], i, alphachan, lighting.alpha);
+    }
+
+    FinishChannelColor(src, chan, lighting, dst);
+  }
+}
+
+static void TransformTexGen(u32 coordNum, bool specialCase, const InputVertexData* src,
+                            OutputVertexData* dst)
+{
+  const TexMtxInfo& texinfo = xfmem.texMtxInfo[coordNum];
+
+  switch (texinfo.texgentype)
+  {
+  case XF_TEXGEN_REGULAR:
+    TransformTexCoordRegular(texinfo, coordNum, specialCase, src, dst);
+    break;
+  case XF_TEXGEN_EMBOSS_MAP:
+  {
+    const LightPointer* light = (const LightPointer*)&xfmem.lights[texinfo.embosslightshift];
 
-      u8 mask = colorchan.GetFullLightMask();
+    Vec3 ldir = (light->pos - dst->mvPosition).Normalized();
+    float d1 = ldir * dst->normal[1];
+    float d2 = ldir * dst->normal[2];
+
+    dst->texCoords[coordNum].x = dst->texCoords[texinfo.embosssourceshift].x + d1;
+    dst->texCoords[coordNum].y = dst->texCoords[texinfo.embosssourceshift].y + d2;
+    dst->texCoords[coordNum].z = dst->texCoords[texinfo.embosssourceshift].z;
+  }
+  break;
+  case XF_TEXGEN_COLOR_STRGBC0:
+    _assert_(texinfo.sourcerow == XF_SRCCOLORS_INROW);
+    _assert_(texinfo.inputform == XF_TEXINPUT_AB11);
+    dst->texCoords[coordNum].x = (float)dst->color[0][0] / 255.0f;
+    dst->texCoords[coordNum].y = (float)dst->color[0][1] / 255.0f;
+    dst->texCoords[coordNum].z = 1.0f;
+    break;
+  case XF_TEXGEN_COLOR_STRGBC1:
+    _assert_(texinfo.sourcerow == XF_SRCCOLORS_INROW);
+    _assert_(texinfo.inputform == XF_TEXINPUT_AB11);
+    dst->texCoords[coordNum].x = (float)dst->color[1][0] / 255.0f;
+    dst->texCoords[coordNum].y = (float)dst->color[1][1] / 255.0f;
+    dst->texCoords[coordNum].z = 1.0f;
+    break;
+  default:
+    ERROR_LOG(VIDEO, "Bad tex gen type %i", texinfo.texgentype.Value());
+  }
+}
+
+static void ScaleTexCoords(OutputVertexData* dst)
+{
+  for (u32 coordNum = 0; coordNum < xfmem.numTexGen.numTexGens; coordNum++)
+  {
+    dst->texCoords[coordNum][0] *= (bpmem.texcoords[coordNum].s.scale_minus_1 + 1);
+    dst->texCoords[coordNum][1] *= (bpmem.texcoords[coordNum].t.scale_minus_1 + 1);
+  }
+}
+
+void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst, bool specialCase)
+{
+  for (u32 coordNum = 0; coordNum < xfmem.numTexGen.numTexGens; coordNum++)
+    TransformTexGen(coordNum, specialCase, src, dst);
+
+  ScaleTexCoords(dst);
+}
+
+#ifdef _M_X86
+// The batched transforms work on four vertices at once, with the same component of each vertex
+// in the lanes of a register. They do the same operations in the same order as the functions for
+// a single vertex, so that the results are the same to the bit.
+namespace
+{
+constexpr size_t BATCH_SIZE = 4;
+
+struct Vec3x4
+{
+  __m128 x;
+  __m128 y;
+  __m128 z;
+};
+
+template <typename Getter>
+Vec3x4 LoadVec3(Getter get)
+{
+  const Vec3& v0 = get(0);
+  const Vec3& v1 = get(1);
+  const Vec3& v2 = get(2);
+  const Vec3& v3 = get(3);
+  return {_mm_setr_ps(v0.x, v1.x, v2.x, v3.x), _mm_setr_ps(v0.y, v1.y, v2.y, v3.y),
+          _mm_setr_ps(v0.z, v1.z, v2.z, v3.z)};
+}
+
+template <typename Getter>
+void StoreVec3(const Vec3x4& v, Getter get)
+{
+  alignas(16) float x[BATCH_SIZE];
+  alignas(16) float y[BATCH_SIZE];
+  alignas(16) float z[BATCH_SIZE];
+  _mm_store_ps(x, v.x);
+  _mm_store_ps(y, v.y);
+  _mm_store_ps(z, v.z);
+  for (size_t i = 0; i < BATCH_SIZE; ++i)
+    get(i) = Vec3(x[i], y[i], z[i]);
+}
+
+__m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Same as std::max(0.0f, v), which gives 0 for NaN.
+__m128 MaxZero(__m128 v)
+{
+  return _mm_max_ps(v, _mm_setzero_ps());
+}
+
+__m128 Dot(const Vec3x4& a, const Vec3x4& b)
+{
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)),
+                    _mm_mul_ps(a.z, b.z));
+}
+
+__m128 Dot(const Vec3x4& a, const Vec3& b)
+{
+  return Dot(a, {_mm_set1_ps(b.x), _mm_set1_ps(b.y), _mm_set1_ps(b.z)});
+}
+
+Vec3x4 Scale(const Vec3x4& v, __m128 f)
+{
+  return {_mm_mul_ps(v.x, f), _mm_mul_ps(v.y, f), _mm_mul_ps(v.z, f)};
+}
+
+Vec3x4 Normalized(const Vec3x4& v)
+{
+  const __m128 length = _mm_sqrt_ps(Dot(v, v));
+  return Scale(v, _mm_div_ps(_mm_set1_ps(1.0f), length));
+}
+
+// row[0] * x + row[1] * y + row[2] * z
+__m128 MultiplyRow3(const float* row, const Vec3x4& v)
+{
+  const __m128 xy =
+      _mm_add_ps(_mm_mul_ps(_mm_set1_ps(row[0]), v.x), _mm_mul_ps(_mm_set1_ps(row[1]), v.y));
+  return _mm_add_ps(xy, _mm_mul_ps(_mm_set1_ps(row[2]), v.z));
+}
+
+// row[0] * x + row[1] * y + row[2] * z + row[3]
+__m128 MultiplyRow4(const float* row, const Vec3x4& v)
+{
+  return _mm_add_ps(MultiplyRow3(row, v), _mm_set1_ps(row[3]));
+}
+
+// row[0] * x + row[1] * y + row[2] + row[3]
+__m128 MultiplyRow2(const float* row, const Vec3x4& v)
+{
+  const __m128 xy =
+      _mm_add_ps(_mm_mul_ps(_mm_set1_ps(row[0]), v.x), _mm_mul_ps(_mm_set1_ps(row[1]), v.y));
+  return _mm_add_ps(_mm_add_ps(xy, _mm_set1_ps(row[2])), _mm_set1_ps(row[3]));
+}
+
+Vec3x4 MultiplyVec2Mat24(const Vec3x4& v, const float* mat)
+{
+  return {MultiplyRow2(mat, v), MultiplyRow2(mat + 4, v), _mm_set1_ps(1.0f)};
+}
+
+Vec3x4 MultiplyVec2Mat34(const Vec3x4& v, const float* mat)
+{
+  return {MultiplyRow2(mat, v), MultiplyRow2(mat + 4, v), MultiplyRow2(mat + 8, v)};
+}
+
+Vec3x4 MultiplyVec3Mat33(const Vec3x4& v, const float* mat)
+{
+  return {MultiplyRow3(mat, v), MultiplyRow3(mat + 3, v), MultiplyRow3(mat + 6, v)};
+}
+
+Vec3x4 MultiplyVec3Mat24(const Vec3x4& v, const float* mat)
+{
+  return {MultiplyRow4(mat, v), MultiplyRow4(mat + 4, v), _mm_set1_ps(1.0f)};
+}
+
+Vec3x4 MultiplyVec3Mat34(const Vec3x4& v, const float* mat)
+{
+  return {MultiplyRow4(mat, v), MultiplyRow4(mat + 4, v), MultiplyRow4(mat + 8, v)};
+}
+
+__m128i ClipBit(__m128 outside, int bit)
+{
+  return _mm_and_si128(_mm_castps_si128(outside), _mm_set1_epi32(bit));
+}
+
+void TransformPositionBatch(const InputVertexData* src, OutputVertexData* dst)
+{
+  const float* mat = &xfmem.posMatrices[src->posMtx * 4];
+  const Vec3x4 pos =
+      MultiplyVec3Mat34(LoadVec3([&](size_t i) -> const Vec3& { return src[i].position; }), mat);
+  StoreVec3(pos, [&](size_t i) -> Vec3& { return dst[i].mvPosition; });
+
+  const float* proj = xfmem.projection.rawProjection;
+  __m128 x, y, z, w;
+  if (xfmem.projection.type == GX_PERSPECTIVE)
+  {
+    x = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[0]), pos.x),
+                   _mm_mul_ps(_mm_set1_ps(proj[1]), pos.z));
+    y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[2]), pos.y),
+                   _mm_mul_ps(_mm_set1_ps(proj[3]), pos.z));
+    z = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[4]), pos.z), _mm_set1_ps(proj[5])),
+                   _mm_set1_ps(1.0f - (float)1e-7));
+    w = _mm_xor_ps(pos.z, _mm_set1_ps(-0.0f));
+  }
+  else
+  {
+    x = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[0]), pos.x), _mm_set1_ps(proj[1]));
+    y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[2]), pos.y), _mm_set1_ps(proj[3]));
+    z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[4]), pos.z), _mm_set1_ps(proj[5]));
+    w = _mm_set1_ps(1.0f);
+  }
+
+  // The same tests as Clipper::CalcClipMask.
+  const __m128 zero = _mm_setzero_ps();
+  __m128i mask = ClipBit(_mm_cmplt_ps(_mm_sub_ps(w, x), zero), Clipper::CLIP_POS_X_BIT);
+  mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_add_ps(x, w), zero), Clipper::CLIP_NEG_X_BIT));
+  mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_sub_ps(w, y), zero), Clipper::CLIP_POS_Y_BIT));
+  mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_add_ps(y, w), zero), Clipper::CLIP_NEG_Y_BIT));
+  mask = _mm_or_si128(mask, ClipBit(_mm_cmpgt_ps(_mm_mul_ps(w, z), zero), Clipper::CLIP_POS_Z_BIT));
+  mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_add_ps(z, w), zero), Clipper::CLIP_NEG_Z_BIT));
+  alignas(16) s32 masks[BATCH_SIZE];
+  _mm_store_si128(reinterpret_cast<__m128i*>(masks), mask);
+
+  // Each register holds the x, y, z and w of a vertex after the transpose.
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+  _mm_storeu_ps(&dst[0].projectedPosition.x, x);
+  _mm_storeu_ps(&dst[1].projectedPosition.x, y);
+  _mm_storeu_ps(&dst[2].projectedPosition.x, z);
+  _mm_storeu_ps(&dst[3].projectedPosition.x, w);
+  for (size_t i = 0; i < BATCH_SIZE; ++i)
+    dst[i].clipMask = masks[i];
+}
+
+void TransformNormalBatch(const InputVertexData* src, bool nbt, OutputVertexData* dst)
+{
+  const float* mat = &xfmem.normalMatrices[(src->posMtx & 31) * 3];
+
+  for (int n = 0; n < (nbt ? 3 : 1); ++n)
+  {
+    Vec3x4 normal = MultiplyVec3Mat33(
+        LoadVec3([&](size_t i) -> const Vec3& { return src[i].normal[n]; }), mat);
+    if (n == 0)
+      normal = Normalized(normal);
+    StoreVec3(normal, [&](size_t i) -> Vec3& { return dst[i].normal[n]; });
+  }
+}
+
+__m128 SafeDivide(__m128 n, __m128 d)
+{
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 fallback = _mm_and_ps(_mm_cmpgt_ps(n, zero), _mm_set1_ps(1.0f));
+  return Select(_mm_cmpeq_ps(d, zero), fallback, _mm_div_ps(n, d));
+}
+
+__m128 CalculateLightAttn(const LightPointer* light, Vec3x4* ldir, const Vec3x4& normal,
+                          const LitChannel& chan)
+{
+  switch (chan.attnfunc)
+  {
+  case LIGHTATTN_NONE:
+  case LIGHTATTN_DIR:
+  {
+    *ldir = Normalized(*ldir);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 is_zero =
+        _mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(ldir->x, zero), _mm_cmpeq_ps(ldir->y, zero)),
+                   _mm_cmpeq_ps(ldir->z, zero));
+    ldir->x = Select(is_zero, normal.x, ldir->x);
+    ldir->y = Select(is_zero, normal.y, ldir->y);
+    ldir->z = Select(is_zero, normal.z, ldir->z);
+    return _mm_set1_ps(1.0f);
+  }
+  case LIGHTATTN_SPEC:
+  {
+    *ldir = Normalized(*ldir);
+    const __m128 facing = _mm_cmpge_ps(Dot(*ldir, normal), _mm_setzero_ps());
+    const __m128 attn = _mm_and_ps(facing, MaxZero(Dot(normal, light->dir)));
+    const __m128 attn2 = _mm_mul_ps(attn, attn);
+    const Vec3 cosAttn = light->cosatt;
+    Vec3 distAttn = light->distatt;
+    if (chan.diffusefunc != LIGHTDIF_NONE)
+      distAttn = distAttn.Normalized();
+
+    // The dot products of (1, attn, attn * attn) with the attenuation factors.
+    const __m128 cos_dot =
+        _mm_add_ps(_mm_add_ps(_mm_set1_ps(cosAttn.x), _mm_mul_ps(attn, _mm_set1_ps(cosAttn.y))),
+                   _mm_mul_ps(attn2, _mm_set1_ps(cosAttn.z)));
+    const __m128 dist_dot =
+        _mm_add_ps(_mm_add_ps(_mm_set1_ps(distAttn.x), _mm_mul_ps(attn, _mm_set1_ps(distAttn.y))),
+                   _mm_mul_ps(attn2, _mm_set1_ps(distAttn.z)));
+    return SafeDivide(MaxZero(cos_dot), dist_dot);
+  }
+  case LIGHTATTN_SPOT:
+  default:
+  {
+    const __m128 dist2 = Dot(*ldir, *ldir);
+    const __m128 dist = _mm_sqrt_ps(dist2);
+    *ldir = Scale(*ldir, _mm_div_ps(_mm_set1_ps(1.0f), dist));
+    const __m128 attn = MaxZero(Dot(*ldir, light->dir));
+
+    const __m128 cos_att = _mm_add_ps(
+        _mm_add_ps(_mm_set1_ps(light->cosatt.x), _mm_mul_ps(_mm_set1_ps(light->cosatt.y), attn)),
+        _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(light->cosatt.z), attn), attn));
+    const __m128 dist_att = _mm_add_ps(
+        _mm_add_ps(_mm_set1_ps(light->distatt.x), _mm_mul_ps(_mm_set1_ps(light->distatt.y), dist)),
+        _mm_mul_ps(_mm_set1_ps(light->distatt.z), dist2));
+    return SafeDivide(MaxZero(cos_att), dist_att);
+  }
+  }
+}
+
+// Calculates the attenuation of a light and the diffuse factor, which is only used if the channel
+// has a diffuse function. Returns false for an invalid diffuse function, which adds no light.
+bool CalculateLightScale(const Vec3x4& pos, const Vec3x4& normal, const LightPointer* light,
+                         const LitChannel& chan, __m128* attn, __m128* difAttn)
+{
+  Vec3x4 ldir = {_mm_sub_ps(_mm_set1_ps(light->pos.x), pos.x),
+                 _mm_sub_ps(_mm_set1_ps(light->pos.y), pos.y),
+                 _mm_sub_ps(_mm_set1_ps(light->pos.z), pos.z)};
+  *attn = CalculateLightAttn(light, &ldir, normal, chan);
+
+  *difAttn = Dot(ldir, normal);
+  switch (chan.diffusefunc)
+  {
+  case LIGHTDIF_NONE:
+  case LIGHTDIF_SIGN:
+    return true;
+  case LIGHTDIF_CLAMP:
+    *difAttn = MaxZero(*difAttn);
+    return true;
+  default:
+    return false;
+  }
+}
+
+void LightColorBatch(const Vec3x4& pos, const Vec3x4& normal, u8 lightNum, const LitChannel& chan,
+                     Vec3x4& lightCol)
+{
+  const LightPointer* light = (const LightPointer*)&xfmem.lights[lightNum];
+  __m128 attn, difAttn;
+  if (!CalculateLightScale(pos, normal, light, chan, &attn, &difAttn))
+    return;
+
+  const __m128 scale = chan.diffusefunc == LIGHTDIF_NONE ? attn : _mm_mul_ps(attn, difAttn);
+  lightCol.x = _mm_add_ps(lightCol.x, _mm_mul_ps(_mm_set1_ps(light->color[1]), scale));
+  lightCol.y = _mm_add_ps(lightCol.y, _mm_mul_ps(_mm_set1_ps(light->color[2]), scale));
+  lightCol.z = _mm_add_ps(lightCol.z, _mm_mul_ps(_mm_set1_ps(light->color[3]), scale));
+}
+
+void LightAlphaBatch(const Vec3x4& pos, const Vec3x4& normal, u8 lightNum, const LitChannel& chan,
+                     __m128& lightCol)
+{
+  const LightPointer* light = (const LightPointer*)&xfmem.lights[lightNum];
+  __m128 attn, difAttn;
+  if (!CalculateLightScale(pos, normal, light, chan, &attn, &difAttn))
+    return;
+
+  __m128 value = _mm_mul_ps(_mm_set1_ps(light->color[0]), attn);
+  if (chan.diffusefunc != LIGHTDIF_NONE)
+    value = _mm_mul_ps(value, difAttn);
+  lightCol = _mm_add_ps(lightCol, value);
+}
+
+void TransformColorBatch(const InputVertexData* src, OutputVertexData* dst)
+{
+  const Vec3x4 pos = LoadVec3([&](size_t i) -> const Vec3& { return dst[i].mvPosition; });
+  const Vec3x4 normal = LoadVec3([&](size_t i) -> const Vec3& { return dst[i].normal[0]; });
+
+  for (u32 chan = 0; chan < xfmem.numChan.numColorChans; chan++)
+  {
+    std::array<ChannelLighting, BATCH_SIZE> lighting;
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+      lighting[i] = GetAmbientLighting(&src[i], chan);
+
+    const LitChannel& colorchan = xfmem.color[chan];
+    const u8 color_mask = colorchan.GetFullLightMask();
+    if (color_mask)
+    {
+      Vec3x4 color = LoadVec3([&](size_t i) -> const Vec3& { return lighting[i].color; });
       for (int i = 0; i < 8; ++i)
       {
-        if (mask & (1 << i))
-          LightColor(dst->mvPosition, dst->normal[0], i, colorchan, lightCol);
+        if (color_mask & (1 << i))
+          LightColorBatch(pos, normal, i, colorchan, color);
       }
-
-      int light_x = MathUtil::Clamp(static_cast<int>(lightCol.x), 0, 255);
-      int light_y = MathUtil::Clamp(static_cast<int>(lightCol.y), 0, 255);
-      int light_z = MathUtil::Clamp(static_cast<int>(lightCol.z), 0, 255);
-      chancolor[1] = (matcolor[1] * (light_x + (light_x >> 7))) >> 8;
-      chancolor[2] = (matcolor[2] * (light_y + (light_y >> 7))) >> 8;
-      chancolor[3] = (matcolor[3] * (light_z + (light_z >> 7))) >> 8;
-    }
-    else
-    {
-      chancolor = matcolor;
+      StoreVec3(color, [&](size_t i) -> Vec3& { return lighting[i].color; });
     }
 
-    // alpha
     const LitChannel& alphachan = xfmem.alpha[chan];
-    if (alphachan.matsource)
-      matcolor[0] = src->color[chan][0];  // vertex
-    else
-      matcolor[0] = xfmem.matColor[chan] & 0xff;
-
-    if (xfmem.alpha[chan].enablelighting)
+    const u8 alpha_mask = alphachan.GetFullLightMask();
+    if (alpha_mask)
     {
-      float lightCol;
-      if (alphachan.ambsource)
-        lightCol = src->color[chan][0];  // vertex
-      else
-        lightCol = static_cast<float>(xfmem.ambColor[chan] & 0xff);
-
-      u8 mask = alphachan.GetFullLightMask();
+      __m128 alpha =
+          _mm_setr_ps(lighting[0].alpha, lighting[1].alpha, lighting[2].alpha, lighting[3].alpha);
       for (int i = 0; i < 8; ++i)
       {
-        if (mask & (1 << i))
-          LightAlpha(dst->mvPosition, dst->normal[0], i, alphachan, lightCol);
+        if (alpha_mask & (1 << i))
+          LightAlphaBatch(pos, normal, i, alphachan, alpha);
       }
-
-      int light_a = MathUtil::Clamp(static_cast<int>(lightCol), 0, 255);
-      chancolor[0] = (matcolor[0] * (light_a + (light_a >> 7))) >> 8;
+      alignas(16) float alphas[BATCH_SIZE];
+      _mm_store_ps(alphas, alpha);
+      for (size_t i = 0; i < BATCH_SIZE; ++i)
+        lighting[i].alpha = alphas[i];
     }
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+      FinishChannelColor(&src[i], chan, lighting[i], &dst[i]);
+  }
+}
+
+void TransformTexCoordRegularBatch(const TexMtxInfo& texinfo, int coordNum, bool specialCase,
+                                   const InputVertexData* src, OutputVertexData* dst)
+{
+  Vec3x4 coord;
+  switch (texinfo.sourcerow)
+  {
+  case XF_SRCGEOM_INROW:
+    coord = LoadVec3([&](size_t i) -> const Vec3& { return src[i].position; });
+    break;
+  case XF_SRCNORMAL_INROW:
+    coord = LoadVec3([&](size_t i) -> const Vec3& { return src[i].normal[0]; });
+    break;
+  case XF_SRCBINORMAL_T_INROW:
+    coord = LoadVec3([&](size_t i) -> const Vec3& { return src[i].normal[1]; });
+    break;
+  case XF_SRCBINORMAL_B_INROW:
+    coord = LoadVec3([&](size_t i) -> const Vec3& { return src[i].normal[2]; });
+    break;
+  default:
+  {
+    _assert_(texinfo.sourcerow >= XF_SRCTEX0_INROW && texinfo.sourcerow <= XF_SRCTEX7_INROW);
+    const int row = texinfo.sourcerow - XF_SRCTEX0_INROW;
+    coord.x = _mm_setr_ps(src[0].texCoords[row][0], src[1].texCoords[row][0],
+                          src[2].texCoords[row][0], src[3].texCoords[row][0]);
+    coord.y = _mm_setr_ps(src[0].texCoords[row][1], src[1].texCoords[row][1],
+                          src[2].texCoords[row][1], src[3].texCoords[row][1]);
+    coord.z = _mm_set1_ps(1.0f);
+    break;
+  }
+  }
+
+  const float* mat = &xfmem.posMatrices[src->texMtx[coordNum] * 4];
+  if (texinfo.projection == XF_TEXPROJ_ST)
+  {
+    if (texinfo.inputform == XF_TEXINPUT_AB11 || specialCase)
+      coord = MultiplyVec2Mat24(coord, mat);
     else
-    {
-      chancolor[0] = matcolor[0];
-    }
+      coord = MultiplyVec3Mat24(coord, mat);
+  }
+  else  // texinfo.projection == XF_TEXPROJ_STQ
+  {
+    _assert_(!specialCase);
 
-    // abgr -> rgba
-    const u32 rgba_color = Common::swap32(chancolor.data());
-    std::memcpy(dst->color[chan], &rgba_color, sizeof(u32));
+    if (texinfo.inputform == XF_TEXINPUT_AB11)
+      coord = MultiplyVec2Mat34(coord, mat);
+    else
+      coord = MultiplyVec3Mat34(coord, mat);
   }
+
+  if (xfmem.dualTexTrans.enabled)
+  {
+    const PostMtxInfo& postInfo = xfmem.postMtxInfo[coordNum];
+    const float* postMat = &xfmem.postMatrices[postInfo.index * 4];
+
+    if (specialCase)
+      coord = MultiplyVec2Mat24(coord, postMat);
+    else
+      coord = MultiplyVec3Mat34(postInfo.normalize ? Normalized(coord) : coord, postMat);
+  }
+
+  // The special case for q == 0, see TransformTexCoordRegular.
+  const __m128 q_zero = _mm_cmpeq_ps(coord.z, _mm_setzero_ps());
+  const __m128 two = _mm_set1_ps(2.0f);
+  const __m128 min = _mm_set1_ps(-1.0f);
+  const __m128 max = _mm_set1_ps(1.0f);
+  coord.x = Select(q_zero, _mm_max_ps(_mm_min_ps(_mm_div_ps(coord.x, two), max), min), coord.x);
+  coord.y = Select(q_zero, _mm_max_ps(_mm_min_ps(_mm_div_ps(coord.y, two), max), min), coord.y);
+
+  StoreVec3(coord, [&](size_t i) -> Vec3& { return dst[i].texCoords[coordNum]; });
 }
 
-void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst, bool specialCase)
+void TransformBatch(const InputVertexData* src, OutputVertexData* dst, bool hasNormal, bool nbt,
+                    bool specialCase)
 {
+  // Vertices can have matrices of their own, which the batch has to fall back to a vertex at a
+  // time for.
+  bool same_pos_matrix = true;
+  for (size_t i = 1; i < BATCH_SIZE; ++i)
+    same_pos_matrix &= src[i].posMtx == src[0].posMtx;
+
+  if (same_pos_matrix)
+  {
+    TransformPositionBatch(src, dst);
+    if (hasNormal)
+      TransformNormalBatch(src, nbt, dst);
+  }
+  else
+  {
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+      TransformPosition(&src[i], &dst[i]);
+      if (hasNormal)
+        TransformNormal(&src[i], nbt, &dst[i]);
+    }
+  }
+
+  TransformColorBatch(src, dst);
+
   for (u32 coordNum = 0; coordNum < xfmem.numTexGen.numTexGens; coordNum++)
   {
     const TexMtxInfo& texinfo = xfmem.texMtxInfo[coordNum];
+    bool same_tex_matrix = true;
+    for (size_t i = 1; i < BATCH_SIZE; ++i)
+      same_tex_matrix &= src[i].texMtx[coordNum] == src[0].texMtx[coordNum];
 
-    switch (texinfo.texgentype)
-    {
-    case XF_TEXGEN_REGULAR:
-      TransformTexCoordRegular(texinfo, coordNum, specialCase, src, dst);
-      break;
-    case XF_TEXGEN_EMBOSS_MAP:
+    if (texinfo.texgentype == XF_TEXGEN_REGULAR && same_tex_matrix)
     {
-      const LightPointer* light = (const LightPointer*)&xfmem.lights[texinfo.embosslightshift];
-
-      Vec3 ldir = (light->pos - dst->mvPosition).Normalized();
-      float d1 = ldir * dst->normal[1];
-      float d2 = ldir * dst->normal[2];
-
-      dst->texCoords[coordNum].x = dst->texCoords[texinfo.embosssourceshift].x + d1;
-      dst->texCoords[coordNum].y = dst->texCoords[texinfo.embosssourceshift].y + d2;
-      dst->texCoords[coordNum].z = dst->texCoords[texinfo.embosssourceshift].z;
+      TransformTexCoordRegularBatch(texinfo, coordNum, specialCase, src, dst);
     }
-    break;
-    case XF_TEXGEN_COLOR_STRGBC0:
-      _assert_(texinfo.sourcerow == XF_SRCCOLORS_INROW);
-      _assert_(texinfo.inputform == XF_TEXINPUT_AB11);
-      dst->texCoords[coordNum].x = (float)dst->color[0][0] / 255.0f;
-      dst->texCoords[coordNum].y = (float)dst->color[0][1] / 255.0f;
-      dst->texCoords[coordNum].z = 1.0f;
-      break;
-    case XF_TEXGEN_COLOR_STRGBC1:
-      _assert_(texinfo.sourcerow == XF_SRCCOLORS_INROW);
-      _assert_(texinfo.inputform == XF_TEXINPUT_AB11);
-      dst->texCoords[coordNum].x = (float)dst->color[1][0] / 255.0f;
-      dst->texCoords[coordNum].y = (float)dst->color[1][1] / 255.0f;
-      dst->texCoords[coordNum].z = 1.0f;
-      break;
-    default:
-      ERROR_LOG(VIDEO, "Bad tex gen type %i", texinfo.texgentype.Value());
+    else
+    {
+      for (size_t i = 0; i < BATCH_SIZE; ++i)
+        TransformTexGen(coordNum, specialCase, &src[i], &dst[i]);
     }
   }
 
-  for (u32 coordNum = 0; coordNum < xfmem.numTexGen.numTexGens; coordNum++)
+  for (size_t i = 0; i < BATCH_SIZE; ++i)
+    ScaleTexCoords(&dst[i]);
+}
+}  // Anonymous namespace
+#endif
+
+void TransformVertices(const InputVertexData* src, OutputVertexData* dst, size_t count,
+                       bool hasNormal, bool nbt, bool specialCase)
+{
+  size_t i = 0;
+#ifdef _M_X86
+  for (; i + BATCH_SIZE <= count; i += BATCH_SIZE)
+    TransformBatch(&src[i], &dst[i], hasNormal, nbt, specialCase);
+#endif
+
+  for (; i < count; ++i)
   {
-    dst->texCoords[coordNum][0] *= (bpmem.texcoords[coordNum].s.scale_minus_1 + 1);
-    dst->texCoords[coordNum][1] *= (bpmem.texcoords[coordNum].t.scale_minus_1 + 1);
+    TransformPosition(&src[i], &dst[i]);
+    if (hasNormal)
+      TransformNormal(&src[i], nbt, &dst[i]);
+    TransformColor(&src[i], &dst[i]);
+    TransformTexCoord(&src[i], &dst[i], specialCase);
   }
 }
 }
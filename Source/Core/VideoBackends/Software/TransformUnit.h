@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 struct InputVertexData;
 struct OutputVertexData;
 
@@ -13,4 +15,10 @@ void TransformPosition(const InputVertexData* src, OutputVertexData* dst);
 void TransformNormal(const InputVertexData* src, bool nbt, OutputVertexData* dst);
 void TransformColor(const InputVertexData* src, OutputVertexData* dst);
 void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst, bool specialCase);
+
+// Does all of the above for count vertices, several at a time where the host supports it. The
+// results are the same as with the functions for a single vertex. dst has to be cleared, since
+// only the attributes which are enabled are written.
+void TransformVertices(const InputVertexData* src, OutputVertexData* dst, size_t count,
+                       bool hasNormal, bool nbt, bool specialCase);
 }
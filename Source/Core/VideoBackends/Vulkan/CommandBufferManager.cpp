@@ -125,6 +125,18 @@ void CommandBufferManager::DestroyCommandBuffers()
       it();
     resources.cleanup_resources.clear();
 
+    for (SecondaryCommandPool& pool : resources.secondary_command_pools)
+    {
+      if (!pool.command_buffers.empty())
+      {
+        vkFreeCommandBuffers(device, pool.command_pool,
+                             static_cast<u32>(pool.command_buffers.size()),
+                             pool.command_buffers.data());
+      }
+      vkDestroyCommandPool(device, pool.command_pool, nullptr);
+    }
+    resources.secondary_command_pools.clear();
+
     if (resources.fence != VK_NULL_HANDLE)
     {
       vkDestroyFence(device, resources.fence, nullptr);
@@ -170,6 +182,46 @@ VkDescriptorSet CommandBufferManager::AllocateDescriptorSet(VkDescriptorSetLayou
   return descriptor_set;
 }
 
+VkCommandBuffer CommandBufferManager::AllocateSecondaryCommandBuffer(size_t pool_index)
+{
+  VkDevice device = g_vulkan_context->GetDevice();
+  FrameResources& resources = m_frame_resources[m_current_frame];
+  while (resources.secondary_command_pools.size() <= pool_index)
+  {
+    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
+                                         g_vulkan_context->GetGraphicsQueueFamilyIndex()};
+    VkCommandPool command_pool;
+    VkResult res = vkCreateCommandPool(device, &pool_info, nullptr, &command_pool);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
+      return VK_NULL_HANDLE;
+    }
+
+    resources.secondary_command_pools.push_back({command_pool, {}, 0});
+  }
+
+  // Buffers are kept around after the pool is reset, so reuse one of them if possible.
+  SecondaryCommandPool& pool = resources.secondary_command_pools[pool_index];
+  if (pool.num_used_command_buffers == pool.command_buffers.size())
+  {
+    VkCommandBufferAllocateInfo buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                               nullptr, pool.command_pool,
+                                               VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1};
+    VkCommandBuffer command_buffer;
+    VkResult res = vkAllocateCommandBuffers(device, &buffer_info, &command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+      return VK_NULL_HANDLE;
+    }
+
+    pool.command_buffers.push_back(command_buffer);
+  }
+
+  return pool.command_buffers[pool.num_used_command_buffers++];
+}
+
 bool CommandBufferManager::CreateSubmitThread()
 {
   m_submit_loop = std::make_unique<Common::BlockingLoop>();
@@ -401,6 +453,13 @@ void CommandBufferManager::ActivateCommandBuffer()
   res = vkResetCommandPool(g_vulkan_context->GetDevice(), resources.command_pool, 0);
   if (res != VK_SUCCESS)
     LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+  for (SecondaryCommandPool& pool : resources.secondary_command_pools)
+  {
+    res = vkResetCommandPool(g_vulkan_context->GetDevice(), pool.command_pool, 0);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+    pool.num_used_command_buffers = 0;
+  }
 
   // Enable commands to be recorded to the two buffers again.
   VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
@@ -476,6 +535,12 @@ void CommandBufferManager::DeferImageViewDestruction(VkImageView object)
       [object]() { vkDestroyImageView(g_vulkan_context->GetDevice(), object, nullptr); });
 }
 
+void CommandBufferManager::DeferCleanup(std::function<void()> func)
+{
+  FrameResources& resources = m_frame_resources[m_current_frame];
+  resources.cleanup_resources.push_back(std::move(func));
+}
+
 void CommandBufferManager::AddFencePointCallback(
     const void* key, const CommandBufferQueuedCallback& queued_callback,
     const CommandBufferExecutedCallback& executed_callback)
@@ -51,6 +51,11 @@ public:
   // Allocates a descriptors set from the pool reserved for the current frame.
   VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout set_layout);
 
+  // Allocates a secondary command buffer for the current frame. Each pool index has its own
+  // command pool, so buffers from different pools can be recorded on different threads at once.
+  // Allocation itself must happen on the GPU thread. Returns VK_NULL_HANDLE on failure.
+  VkCommandBuffer AllocateSecondaryCommandBuffer(size_t pool_index);
+
   // Gets the fence that will be signaled when the currently executing command buffer is
   // queued and executed. Do not wait for this fence before the buffer is executed.
   VkFence GetCurrentCommandBufferFence() const { return m_frame_resources[m_current_frame].fence; }
@@ -86,6 +91,8 @@ public:
   void DeferFramebufferDestruction(VkFramebuffer object);
   void DeferImageDestruction(VkImage object);
   void DeferImageViewDestruction(VkImageView object);
+  // Calls the function at the same point, for resources which need more than a destroy call.
+  void DeferCleanup(std::function<void()> func);
 
   // Instruct the manager to fire the specified callback when a fence is flagged to be signaled.
   // This happens when command buffers are executed, and can be tested if signaled, which means
@@ -109,6 +116,13 @@ private:
 
   void OnCommandBufferExecuted(size_t index);
 
+  struct SecondaryCommandPool
+  {
+    VkCommandPool command_pool;
+    std::vector<VkCommandBuffer> command_buffers;
+    size_t num_used_command_buffers;
+  };
+
   struct FrameResources
   {
     // [0] - Init (upload) command buffer, [1] - draw command buffer
@@ -119,6 +133,9 @@ private:
     bool init_command_buffer_used;
     bool needs_fence_wait;
 
+    // Pools for the draws recorded on worker threads, reset along with command_pool.
+    std::vector<SecondaryCommandPool> secondary_command_pools;
+
     std::vector<std::function<void()>> cleanup_resources;
   };
 
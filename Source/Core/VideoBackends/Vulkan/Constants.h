@@ -104,13 +104,17 @@ constexpr VkFormat TEXTURECACHE_TEXTURE_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
 constexpr size_t INITIAL_TEXTURE_UPLOAD_BUFFER_SIZE = 16 * 1024 * 1024;
 constexpr size_t MAXIMUM_TEXTURE_UPLOAD_BUFFER_SIZE = 64 * 1024 * 1024;
 
-// Textures greater than 1024*1024 will be put in staging textures that are released after
-// execution instead. A 2048x2048 texture is 16MB, and we'd only fit four of these in our
-// streaming buffer and be blocking frequently. Games are unlikely to have textures this
-// large anyway, so it's only really an issue for HD texture packs, and memory is not
-// a limiting factor in these scenarios anyway.
+// Textures greater than 1024*1024 will be put in pooled staging buffers instead. A 2048x2048
+// texture is 16MB, and we'd only fit four of these in our streaming buffer and be blocking
+// frequently. Games are unlikely to have textures this large anyway, so it's only really an issue
+// for HD texture packs, and memory is not a limiting factor in these scenarios anyway.
 constexpr size_t STAGING_TEXTURE_UPLOAD_THRESHOLD = 1024 * 1024 * 8;
 
+// Staging buffers for texture uploads are kept for reuse after the GPU is done with them, as long
+// as all of them add up to less than this. Sizes are rounded up to the granularity.
+constexpr size_t MAXIMUM_TEXTURE_UPLOAD_STAGING_POOL_SIZE = 64 * 1024 * 1024;
+constexpr size_t TEXTURE_UPLOAD_STAGING_BUFFER_GRANULARITY = 1024 * 1024;
+
 // Streaming uniform buffer size
 constexpr size_t INITIAL_UNIFORM_STREAM_BUFFER_SIZE = 16 * 1024 * 1024;
 constexpr size_t MAXIMUM_UNIFORM_STREAM_BUFFER_SIZE = 32 * 1024 * 1024;
@@ -124,6 +128,9 @@ constexpr u32 PUSH_CONSTANT_BUFFER_SIZE = 128;
 // Minimum number of draw calls per command buffer when attempting to preempt a readback operation.
 constexpr u32 MINIMUM_DRAW_CALLS_PER_COMMAND_BUFFER_FOR_READBACK = 10;
 
+// Minimum number of draw calls per secondary command buffer when recording on worker threads.
+constexpr size_t MINIMUM_DRAW_CALLS_PER_SECONDARY_COMMAND_BUFFER = 128;
+
 // Rasterization state info
 union RasterizationState
 {
@@ -77,6 +77,8 @@ void PerfQuery::EnableQuery(PerfQueryGroup type)
     u32 index = (m_query_read_pos + m_query_count) % PERF_QUERY_BUFFER_SIZE;
     ActiveQuery& entry = m_query_buffer[index];
     _assert_(!entry.active && !entry.available);
+    entry.query_type = type;
+    entry.period = AddPendingQuery();
     entry.active = true;
     m_query_count++;
 
@@ -111,9 +113,24 @@ void PerfQuery::DisableQuery(PerfQueryGroup type)
 
 void PerfQuery::ResetQuery()
 {
+  // In delayed mode, the queries of the current period are left running. Only the ones from
+  // before the previous reset are waited for, and those have had a whole period to complete.
+  if (ShouldDelayResults())
+  {
+    while (IsPreviousPeriodPending() && !IsFlushed())
+      BlockingPartialFlush();
+
+    BeginPeriod();
+    if (!IsFlushed())
+      return;
+  }
+  else
+  {
+    BeginPeriod();
+  }
+
   m_query_count = 0;
   m_query_read_pos = 0;
-  std::fill_n(m_results, ArraySize(m_results), 0);
 
   // Reset entire query pool, ensuring all queries are ready to write to.
   StateTracker::GetInstance()->EndRenderPass();
@@ -134,19 +151,19 @@ u32 PerfQuery::GetQueryResult(PerfQueryType type)
 
   if (type == PQ_ZCOMP_INPUT_ZCOMPLOC || type == PQ_ZCOMP_OUTPUT_ZCOMPLOC)
   {
-    result = m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_ZCOMP_INPUT || type == PQ_ZCOMP_OUTPUT)
   {
-    result = m_results[PQG_ZCOMP];
+    result = GetResult(PQG_ZCOMP);
   }
   else if (type == PQ_BLEND_INPUT)
   {
-    result = m_results[PQG_ZCOMP] + m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP) + GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_EFB_COPY_CLOCKS)
   {
-    result = m_results[PQG_EFB_COPY_CLOCKS];
+    result = GetResult(PQG_EFB_COPY_CLOCKS);
   }
 
   return result / 4;
@@ -332,9 +349,9 @@ void PerfQuery::ProcessResults(u32 start_index, u32 query_count)
     DEBUG_LOG(VIDEO, "  query result %u", result);
 
     // NOTE: Reported pixel metrics should be referenced to native resolution
-    m_results[entry.query_type] +=
-        static_cast<u32>(static_cast<u64>(result) * EFB_WIDTH / g_renderer->GetTargetWidth() *
-                         EFB_HEIGHT / g_renderer->GetTargetHeight());
+    AddResult(entry.period, entry.query_type,
+              static_cast<u32>(static_cast<u64>(result) * EFB_WIDTH / g_renderer->GetTargetWidth() *
+                               EFB_HEIGHT / g_renderer->GetTargetHeight()));
   }
 
   m_query_read_pos = (m_query_read_pos + query_count) % PERF_QUERY_BUFFER_SIZE;
@@ -35,7 +35,8 @@ public:
 private:
   struct ActiveQuery
   {
-    PerfQueryType query_type;
+    PerfQueryGroup query_type;
+    u32 period;
     VkFence pending_fence;
     bool available;
     bool active;
@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include "VideoBackends/Vulkan/PostProcessing.h"
+#include <algorithm>
+#include <array>
 #include <sstream>
 
 #include "Common/Assert.h"
@@ -45,13 +47,84 @@ void VulkanPostProcessing::BlitFromTexture(const TargetRectangle& dst, const Tar
   // If the source layer is negative we simply copy all available layers.
   VkShaderModule geometry_shader =
       src_layer < 0 ? g_shader_cache->GetPassthroughGeometryShader() : VK_NULL_HANDLE;
-  VkShaderModule fragment_shader =
-      m_fragment_shader != VK_NULL_HANDLE ? m_fragment_shader : m_default_fragment_shader;
+  VkShaderModule fragment_shader = GetFragmentShader();
   UtilityShaderDraw draw(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                          g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_STANDARD), render_pass,
                          g_shader_cache->GetPassthroughVertexShader(), geometry_shader,
                          fragment_shader);
+  SetSourceAndUniforms(draw, fragment_shader, src, src_tex, src_layer);
 
+  draw.DrawQuad(dst.left, dst.top, dst.GetWidth(), dst.GetHeight(), src.left, src.top, src_layer,
+                src.GetWidth(), src.GetHeight(), static_cast<int>(src_tex->GetWidth()),
+                static_cast<int>(src_tex->GetHeight()));
+}
+
+void VulkanPostProcessing::BlitStereoFromTexture(const TargetRectangle& left_dst,
+                                                 const TargetRectangle& right_dst,
+                                                 const TargetRectangle& src,
+                                                 const Texture2D* src_tex,
+                                                 VkRenderPass render_pass)
+{
+  VkShaderModule fragment_shader = GetFragmentShader();
+  UtilityShaderDraw draw(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                         g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_STANDARD), render_pass,
+                         g_shader_cache->GetPassthroughVertexShader(), VK_NULL_HANDLE,
+                         fragment_shader);
+  SetSourceAndUniforms(draw, fragment_shader, src, src_tex, 0);
+
+  // The viewport covers both eyes, and each eye is a quad within it which samples its own layer.
+  const int viewport_left = std::min(left_dst.left, right_dst.left);
+  const int viewport_top = std::min(left_dst.top, right_dst.top);
+  const int viewport_width = std::max(left_dst.right, right_dst.right) - viewport_left;
+  const int viewport_height = std::max(left_dst.bottom, right_dst.bottom) - viewport_top;
+
+  const float u0 = static_cast<float>(src.left) / static_cast<float>(src_tex->GetWidth());
+  const float v0 = static_cast<float>(src.top) / static_cast<float>(src_tex->GetHeight());
+  const float u1 = static_cast<float>(src.right) / static_cast<float>(src_tex->GetWidth());
+  const float v1 = static_cast<float>(src.bottom) / static_cast<float>(src_tex->GetHeight());
+
+  const std::array<const TargetRectangle*, 2> eyes = {{&left_dst, &right_dst}};
+  UtilityShaderVertex* vertices = draw.ReserveVertices(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 12);
+  for (size_t eye = 0; eye < eyes.size(); eye++)
+  {
+    const TargetRectangle& dst = *eyes[eye];
+    const float x0 = (dst.left - viewport_left) * 2.0f / viewport_width - 1.0f;
+    const float y0 = (dst.top - viewport_top) * 2.0f / viewport_height - 1.0f;
+    const float x1 = (dst.right - viewport_left) * 2.0f / viewport_width - 1.0f;
+    const float y1 = (dst.bottom - viewport_top) * 2.0f / viewport_height - 1.0f;
+    const float w = static_cast<float>(eye);
+
+    // Two triangles, in the same order as the triangle strip of DrawQuad.
+    UtilityShaderVertex* quad = vertices + eye * 6;
+    quad[0].SetPosition(x0, y1);
+    quad[0].SetTextureCoordinates(u0, v1, w);
+    quad[1].SetPosition(x1, y1);
+    quad[1].SetTextureCoordinates(u1, v1, w);
+    quad[2].SetPosition(x0, y0);
+    quad[2].SetTextureCoordinates(u0, v0, w);
+    quad[3] = quad[2];
+    quad[4] = quad[1];
+    quad[5].SetPosition(x1, y0);
+    quad[5].SetTextureCoordinates(u1, v0, w);
+    for (size_t i = 0; i < 6; i++)
+      quad[i].SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+  }
+  draw.CommitVertices(12);
+
+  draw.SetViewportAndScissor(viewport_left, viewport_top, viewport_width, viewport_height);
+  draw.Draw();
+}
+
+VkShaderModule VulkanPostProcessing::GetFragmentShader() const
+{
+  return m_fragment_shader != VK_NULL_HANDLE ? m_fragment_shader : m_default_fragment_shader;
+}
+
+void VulkanPostProcessing::SetSourceAndUniforms(UtilityShaderDraw& draw,
+                                                VkShaderModule fragment_shader,
+                                                const TargetRectangle& src,
+                                                const Texture2D* src_tex, int src_layer)
+{
   // Source is always bound.
   draw.SetPSSampler(0, src_tex->GetView(), g_object_cache->GetLinearSampler());
 
@@ -65,10 +138,6 @@ void VulkanPostProcessing::BlitFromTexture(const TargetRectangle& dst, const Tar
     draw.CommitPSUniforms(uniforms_size);
     draw.SetPSSampler(1, m_font_texture->GetView(), g_object_cache->GetLinearSampler());
   }
-
-  draw.DrawQuad(dst.left, dst.top, dst.GetWidth(), dst.GetHeight(), src.left, src.top, src_layer,
-                src.GetWidth(), src.GetHeight(), static_cast<int>(src_tex->GetWidth()),
-                static_cast<int>(src_tex->GetHeight()));
 }
 
 struct BuiltinUniforms
@@ -14,6 +14,7 @@
 namespace Vulkan
 {
 class Texture2D;
+class UtilityShaderDraw;
 
 class VulkanPostProcessing : public PostProcessingShaderImplementation
 {
@@ -26,9 +27,19 @@ public:
   void BlitFromTexture(const TargetRectangle& dst, const TargetRectangle& src,
                        const Texture2D* src_tex, int src_layer, VkRenderPass render_pass);
 
+  // Draws the left eye to left_dst and the right eye to right_dst with a single draw call, for
+  // the side-by-side and top-and-bottom stereoscopic 3D modes.
+  void BlitStereoFromTexture(const TargetRectangle& left_dst, const TargetRectangle& right_dst,
+                             const TargetRectangle& src, const Texture2D* src_tex,
+                             VkRenderPass render_pass);
+
   void UpdateConfig();
 
 private:
+  VkShaderModule GetFragmentShader() const;
+  void SetSourceAndUniforms(UtilityShaderDraw& draw, VkShaderModule fragment_shader,
+                            const TargetRectangle& src, const Texture2D* src_tex, int src_layer);
+
   size_t CalculateUniformsSize() const;
   void FillUniformBuffer(u8* buf, const TargetRectangle& src, const Texture2D* src_tex,
                          int src_layer);
@@ -39,6 +39,7 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/SamplerCommon.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
@@ -56,6 +57,7 @@ Renderer::Renderer(std::unique_ptr<SwapChain> swap_chain)
   // Set to something invalid, forcing all states to be re-initialized.
   for (size_t i = 0; i < m_sampler_states.size(); i++)
     m_sampler_states[i].bits = std::numeric_limits<decltype(m_sampler_states[i].bits)>::max();
+  m_tex_mode_state_ids.fill(std::numeric_limits<u32>::max());
 }
 
 Renderer::~Renderer()
@@ -69,6 +71,9 @@ Renderer::~Renderer()
   DestroyFrameDumpResources();
   DestroyShaders();
   DestroySemaphores();
+
+  if (m_frame_timer_query_pool != VK_NULL_HANDLE)
+    vkDestroyQueryPool(g_vulkan_context->GetDevice(), m_frame_timer_query_pool, nullptr);
 }
 
 Renderer* Renderer::GetInstance()
@@ -123,6 +128,10 @@ bool Renderer::Initialize()
     return false;
   }
 
+  // Frames are only timed for the stats log, so carry on without the timers if this fails.
+  if (g_ActiveConfig.backend_info.bSupportsGPUTimers && !CreateFrameTimerQueryPool())
+    WARN_LOG(VIDEO, "Failed to create frame timer query pool, GPU times will not be logged.");
+
   // Various initialization routines will have executed commands on the command buffer.
   // Execute what we have done before beginning the first frame.
   g_command_buffer_mgr->PrepareToSubmitCommandBuffer();
@@ -336,11 +345,103 @@ void Renderer::BeginFrame()
   StateTracker::GetInstance()->InvalidateDescriptorSets();
   StateTracker::GetInstance()->InvalidateConstants();
   StateTracker::GetInstance()->SetPendingRebind();
+
+  BeginFrameTimer();
+}
+
+bool Renderer::CreateFrameTimerQueryPool()
+{
+  VkQueryPoolCreateInfo info = {
+      VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,  // VkStructureType                  sType
+      nullptr,                                   // const void*                      pNext
+      0,                                         // VkQueryPoolCreateFlags           flags
+      VK_QUERY_TYPE_TIMESTAMP,                   // VkQueryType                      queryType
+      NUM_FRAME_TIMERS * 2,                      // uint32_t                         queryCount
+      0  // VkQueryPipelineStatisticFlags    pipelineStatistics;
+  };
+
+  VkResult res =
+      vkCreateQueryPool(g_vulkan_context->GetDevice(), &info, nullptr, &m_frame_timer_query_pool);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateQueryPool failed: ");
+    m_frame_timer_query_pool = VK_NULL_HANDLE;
+    return false;
+  }
+
+  return true;
+}
+
+void Renderer::BeginFrameTimer()
+{
+  if (m_frame_timer_query_pool == VK_NULL_HANDLE || !m_frame_stats_log.IsActive() ||
+      m_frame_timers[m_current_frame_timer].pending)
+  {
+    return;
+  }
+
+  // Queries have to be reset outside of a render pass, which is the case at the start of a frame.
+  VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  vkCmdResetQueryPool(command_buffer, m_frame_timer_query_pool, m_current_frame_timer * 2, 2);
+  vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_frame_timer_query_pool,
+                      m_current_frame_timer * 2);
+  m_frame_timer_active = true;
+}
+
+void Renderer::EndFrameTimer()
+{
+  if (!m_frame_timer_active)
+    return;
+
+  vkCmdWriteTimestamp(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_frame_timer_query_pool,
+                      m_current_frame_timer * 2 + 1);
+  m_frame_timers[m_current_frame_timer].frame = m_frame_stats_log.GetCurrentFrame();
+  m_frame_timers[m_current_frame_timer].pending = true;
+  m_current_frame_timer = (m_current_frame_timer + 1) % NUM_FRAME_TIMERS;
+  m_frame_timer_active = false;
+}
+
+void Renderer::ReadFrameTimers()
+{
+  if (m_frame_timer_query_pool == VK_NULL_HANDLE)
+    return;
+
+  // The oldest timer is the one the next frame will use. Stop at the first one which hasn't
+  // completed, so that the frames are reported in order.
+  const double ns_per_tick = g_vulkan_context->GetDeviceLimits().timestampPeriod;
+  for (u32 i = 0; i < NUM_FRAME_TIMERS; i++)
+  {
+    const u32 index = (m_current_frame_timer + i) % NUM_FRAME_TIMERS;
+    FrameTimer& timer = m_frame_timers[index];
+    if (!timer.pending)
+      continue;
+
+    std::array<u64, 2> timestamps;
+    VkResult res = vkGetQueryPoolResults(g_vulkan_context->GetDevice(), m_frame_timer_query_pool,
+                                         index * 2, 2, sizeof(timestamps), timestamps.data(),
+                                         sizeof(u64), VK_QUERY_RESULT_64_BIT);
+    if (res == VK_NOT_READY)
+      break;
+
+    if (res == VK_SUCCESS)
+    {
+      const double ticks = static_cast<double>(timestamps[1] - timestamps[0]);
+      m_frame_stats_log.ReportGPUTime(timer.frame, ticks * ns_per_tick / 1000000.0);
+    }
+    else
+    {
+      LOG_VULKAN_ERROR(res, "vkGetQueryPoolResults failed: ");
+    }
+    timer.pending = false;
+  }
 }
 
 void Renderer::ClearScreen(const EFBRectangle& rc, bool color_enable, bool alpha_enable,
                            bool z_enable, u32 color, u32 z)
 {
+  FramebufferManager::GetInstance()->InvalidatePeekCache();
+
   // Native -> EFB coordinates
   TargetRectangle target_rc = Renderer::ConvertEFBRectangle(rc);
 
@@ -479,6 +580,7 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
 {
   StateTracker::GetInstance()->EndRenderPass();
   StateTracker::GetInstance()->SetPendingRebind();
+  FramebufferManager::GetInstance()->InvalidatePeekCache();
   FramebufferManager::GetInstance()->ReinterpretPixelData(convtype);
 
   // EFB framebuffer has now changed, so update accordingly.
@@ -491,6 +593,9 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   // Pending/batched EFB pokes should be included in the final image.
   FramebufferManager::GetInstance()->FlushEFBPokes();
 
+  // Peeks are only cached across draws for the rest of the frame.
+  FramebufferManager::GetInstance()->InvalidatePeekCache();
+
   // Check that we actually have an image to render in XFB-on modes.
   if ((!m_xfb_written && !g_ActiveConfig.RealXFBEnabled()) || !fb_width || !fb_height)
   {
@@ -542,12 +647,17 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   // Ensure the worker thread is not still submitting a previous command buffer.
   // In other words, the last frame has been submitted (otherwise the next call would
   // be a race, as the image may not have been consumed yet).
-  g_command_buffer_mgr->PrepareToSubmitCommandBuffer();
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::PresentWait);
+    g_command_buffer_mgr->PrepareToSubmitCommandBuffer();
+  }
+  ReadFrameTimers();
 
-  // Draw to the screen if we have a swap chain.
-  if (m_swap_chain)
+  // Draw to the screen if we have a swap chain, and it has an image to draw to.
+  if (m_swap_chain && DrawScreen(scaled_efb_rect, xfb_addr, xfb_sources, xfb_count, fb_width,
+                                 fb_stride, fb_height))
   {
-    DrawScreen(scaled_efb_rect, xfb_addr, xfb_sources, xfb_count, fb_width, fb_stride, fb_height);
+    EndFrameTimer();
 
     // Submit the current command buffer, signaling rendering finished semaphore when it's done
     // Because this final command buffer is rendering to the swap chain, we need to wait for
@@ -559,7 +669,8 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   }
   else
   {
-    // No swap chain, just execute command buffer.
+    // No swap chain or no free image, just execute command buffer.
+    EndFrameTimer();
     g_command_buffer_mgr->SubmitCommandBuffer(true);
   }
 
@@ -568,8 +679,12 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   // changes, as the resize methods to not defer the destruction of the framebuffer, the current
   // command buffer will contain references to a now non-existent framebuffer.
 
-  // Prep for the next frame (get command buffer ready) before doing anything else.
-  BeginFrame();
+  // Prep for the next frame (get command buffer ready) before doing anything else. This waits
+  // for the fence of the command buffer which is reused, so it is counted as presentation.
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::PresentWait);
+    BeginFrame();
+  }
 
   // Determine what (if anything) has changed in the config.
   CheckForConfigChanges();
@@ -710,7 +825,7 @@ void Renderer::DrawRealXFB(VkRenderPass render_pass, const TargetRectangle& targ
   }
 }
 
-void Renderer::DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
+bool Renderer::DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
                           const XFBSourceBase* const* xfb_sources, u32 xfb_count, u32 fb_width,
                           u32 fb_stride, u32 fb_height)
 {
@@ -729,6 +844,9 @@ void Renderer::DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
     g_command_buffer_mgr->PrepareToSubmitCommandBuffer();
     res = m_swap_chain->AcquireNextImage(m_image_available_semaphore);
   }
+  // In non-blocking mode, the frame is dropped if all images are still queued for presentation.
+  if (res == VK_NOT_READY || res == VK_TIMEOUT)
+    return false;
   if (res != VK_SUCCESS)
     PanicAlert("Failed to grab image from swap chain");
 
@@ -770,6 +888,7 @@ void Renderer::DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
   // to it have finished before present.
   backbuffer->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                  VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+  return true;
 }
 
 bool Renderer::DrawFrameDump(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
@@ -883,18 +1002,13 @@ void Renderer::WriteFrameDumpImage(size_t index)
 
 StagingTexture2D* Renderer::PrepareFrameDumpImage(u32 width, u32 height, u64 ticks)
 {
-  // Ensure the last frame that was sent to the frame dump has completed encoding before we send
-  // the next image to it.
-  FinishFrameData();
-
-  // If the last image hasn't been written to the frame dump yet, write it now.
-  // This is necessary so that the worker thread is no more than one frame behind, and the pointer
-  // (which is actually the buffer) is safe for us to re-use next time.
+  // Move to the next image buffer. If it still holds a frame which hasn't been written to the
+  // frame dump, that is the oldest frame in flight, so write it now. This way the readbacks lag
+  // FRAME_DUMP_BUFFERED_FRAMES - 1 frames behind, and we rarely have to wait for their fences.
+  m_current_frame_dump_image = (m_current_frame_dump_image + 1) % FRAME_DUMP_BUFFERED_FRAMES;
   if (m_frame_dump_images[m_current_frame_dump_image].pending)
     WriteFrameDumpImage(m_current_frame_dump_image);
 
-  // Move to the next image buffer
-  m_current_frame_dump_image = (m_current_frame_dump_image + 1) % FRAME_DUMP_BUFFERED_FRAMES;
   FrameDumpImage& image = m_frame_dump_images[m_current_frame_dump_image];
 
   // Ensure the dimensions of the readback texture are sufficient.
@@ -926,12 +1040,12 @@ StagingTexture2D* Renderer::PrepareFrameDumpImage(u32 width, u32 height, u64 tic
 void Renderer::FlushFrameDump()
 {
   // We must write frames in order, so this is why we use a counter rather than a range.
+  // The oldest frame is the one after the current image.
   for (size_t i = 0; i < FRAME_DUMP_BUFFERED_FRAMES; i++)
   {
+    m_current_frame_dump_image = (m_current_frame_dump_image + 1) % FRAME_DUMP_BUFFERED_FRAMES;
     if (m_frame_dump_images[m_current_frame_dump_image].pending)
       WriteFrameDumpImage(m_current_frame_dump_image);
-
-    m_current_frame_dump_image = (m_current_frame_dump_image + 1) % FRAME_DUMP_BUFFERED_FRAMES;
   }
 
   // Since everything has been written now, may as well start at index zero.
@@ -949,8 +1063,7 @@ void Renderer::BlitScreen(VkRenderPass render_pass, const TargetRectangle& dst_r
     TargetRectangle right_rect;
     std::tie(left_rect, right_rect) = ConvertStereoRectangle(dst_rect);
 
-    post_processor->BlitFromTexture(left_rect, src_rect, src_tex, 0, render_pass);
-    post_processor->BlitFromTexture(right_rect, src_rect, src_tex, 1, render_pass);
+    post_processor->BlitStereoFromTexture(left_rect, right_rect, src_rect, src_tex, render_pass);
   }
   else if (g_ActiveConfig.iStereoMode == STEREO_QUADBUFFER)
   {
@@ -1102,7 +1215,8 @@ void Renderer::CheckForSurfaceChange()
                                                             m_new_surface_handle);
       if (surface != VK_NULL_HANDLE)
       {
-        m_swap_chain = SwapChain::Create(m_new_surface_handle, surface, g_ActiveConfig.IsVSync());
+        m_swap_chain = SwapChain::Create(m_new_surface_handle, surface, g_ActiveConfig.IsVSync(),
+                                         g_ActiveConfig.bNonBlockingPresent);
         if (!m_swap_chain)
           PanicAlert("Failed to create swap chain.");
       }
@@ -1132,6 +1246,7 @@ void Renderer::CheckForConfigChanges()
   int old_anisotropy = g_ActiveConfig.iMaxAnisotropy;
   int old_aspect_ratio = g_ActiveConfig.iAspectRatio;
   int old_efb_scale = g_ActiveConfig.iEFBScale;
+  bool old_dynamic_resolution = g_ActiveConfig.fDynamicResolutionFrameTime > 0.0f;
   bool old_force_filtering = g_ActiveConfig.bForceFiltering;
   bool old_use_xfb = g_ActiveConfig.bUseXFB;
   bool old_use_realxfb = g_ActiveConfig.bUseRealXFB;
@@ -1152,8 +1267,10 @@ void Renderer::CheckForConfigChanges()
   // Update texture cache settings with any changed options.
   TextureCache::GetInstance()->OnConfigChanged(g_ActiveConfig);
 
-  // Handle settings that can cause the target rectangle to change.
-  if (efb_scale_changed || aspect_changed || use_xfb_changed || use_realxfb_changed)
+  // Handle settings that can cause the target rectangle to change. Dynamic resolution can change
+  // the target size on any frame.
+  if (efb_scale_changed || aspect_changed || use_xfb_changed || use_realxfb_changed ||
+      old_dynamic_resolution || g_ActiveConfig.fDynamicResolutionFrameTime > 0.0f)
   {
     if (CalculateTargetSize())
       ResizeEFBTextures();
@@ -1183,6 +1300,11 @@ void Renderer::CheckForConfigChanges()
     g_command_buffer_mgr->WaitForGPUIdle();
     m_swap_chain->SetVSync(g_ActiveConfig.IsVSync());
   }
+  if (m_swap_chain && g_ActiveConfig.bNonBlockingPresent != m_swap_chain->IsNonBlocking())
+  {
+    g_command_buffer_mgr->WaitForGPUIdle();
+    m_swap_chain->SetNonBlocking(g_ActiveConfig.bNonBlockingPresent);
+  }
 
   // For quad-buffered stereo we need to change the layer count, so recreate the swap chain.
   if (m_swap_chain &&
@@ -1336,17 +1458,26 @@ void Renderer::SetDepthMode()
 
 void Renderer::SetBlendMode(bool force_update)
 {
-  BlendingState state;
-  state.Generate(bpmem);
-
+  const BlendingState& state = RenderState::GetBlendingState(RenderState::GetBlendingStateID());
   StateTracker::GetInstance()->SetBlendState(state);
 }
 
 void Renderer::SetSamplerState(int stage, int texindex, bool custom_tex)
 {
-  const FourTexUnits& tex = bpmem.tex[texindex];
-  const TexMode0& tm0 = tex.texMode0[stage];
-  const TexMode1& tm1 = tex.texMode1[stage];
+  // Skip rebuilding the sampler state if the registers haven't changed since the last draw.
+  size_t bind_index = (texindex * 4) + stage;
+  u32 state_id = RenderState::GetTexModeStateID(static_cast<u32>(bind_index));
+  if (m_tex_mode_state_ids[bind_index] == state_id &&
+      m_sampler_custom_tex[bind_index] == custom_tex)
+  {
+    return;
+  }
+  m_tex_mode_state_ids[bind_index] = state_id;
+  m_sampler_custom_tex[bind_index] = custom_tex;
+
+  const TexModeState& tex_mode = RenderState::GetTexModeState(state_id);
+  const TexMode0& tm0 = tex_mode.tm0;
+  const TexMode1& tm1 = tex_mode.tm1;
   SamplerState new_state = {};
 
   if (g_ActiveConfig.bForceFiltering)
@@ -1387,7 +1518,6 @@ void Renderer::SetSamplerState(int stage, int texindex, bool custom_tex)
   new_state.enable_anisotropic_filtering = SamplerCommon::IsBpTexMode0PointFiltering(tm0) ? 0 : 1;
 
   // Skip lookup if the state hasn't changed.
-  size_t bind_index = (texindex * 4) + stage;
   if (m_sampler_states[bind_index].bits == new_state.bits)
     return;
 
@@ -1413,6 +1543,7 @@ void Renderer::ResetSamplerStates()
   for (size_t i = 0; i < m_sampler_states.size(); i++)
   {
     m_sampler_states[i].bits = std::numeric_limits<decltype(m_sampler_states[i].bits)>::max();
+    m_tex_mode_state_ids[i] = std::numeric_limits<u32>::max();
     StateTracker::GetInstance()->SetSampler(i, g_object_cache->GetPointSampler());
   }
 
@@ -107,7 +107,8 @@ private:
                    u32 fb_stride, u32 fb_height);
 
   // Draw the frame, as well as the OSD to the swap chain.
-  void DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
+  // Returns false if the swap chain had no image to draw to.
+  bool DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
                   const XFBSourceBase* const* xfb_sources, u32 xfb_count, u32 fb_width,
                   u32 fb_stride, u32 fb_height);
 
@@ -144,6 +145,13 @@ private:
   bool ResizeFrameDumpBuffer(u32 new_width, u32 new_height);
   void DestroyFrameDumpResources();
 
+  // Timestamp queries around the GPU work of each frame, for the frame stats log. The results of
+  // earlier frames are read before the current frame is ended, so the log has already seen them.
+  bool CreateFrameTimerQueryPool();
+  void BeginFrameTimer();
+  void EndFrameTimer();
+  void ReadFrameTimers();
+
   VkSemaphore m_image_available_semaphore = VK_NULL_HANDLE;
   VkSemaphore m_rendering_finished_semaphore = VK_NULL_HANDLE;
 
@@ -154,6 +162,11 @@ private:
   // Keep a copy of sampler states to avoid cache lookups every draw
   std::array<SamplerState, NUM_PIXEL_SHADER_SAMPLERS> m_sampler_states = {};
 
+  // The tex mode state IDs the sampler states were generated from, and whether they were generated
+  // for custom textures. Unchanged IDs skip rebuilding the sampler state.
+  std::array<u32, NUM_PIXEL_SHADER_SAMPLERS> m_tex_mode_state_ids = {};
+  std::array<bool, NUM_PIXEL_SHADER_SAMPLERS> m_sampler_custom_tex = {};
+
   // Shaders used for clear/blit.
   VkShaderModule m_clear_fragment_shader = VK_NULL_HANDLE;
 
@@ -162,7 +175,7 @@ private:
   VkFramebuffer m_frame_dump_framebuffer = VK_NULL_HANDLE;
 
   // Readback resources for frame dumping
-  static const size_t FRAME_DUMP_BUFFERED_FRAMES = 2;
+  static const size_t FRAME_DUMP_BUFFERED_FRAMES = 3;
   struct FrameDumpImage
   {
     std::unique_ptr<StagingTexture2D> readback_texture;
@@ -173,5 +186,18 @@ private:
   std::array<FrameDumpImage, FRAME_DUMP_BUFFERED_FRAMES> m_frame_dump_images;
   size_t m_current_frame_dump_image = FRAME_DUMP_BUFFERED_FRAMES - 1;
   bool m_frame_dumping_active = false;
+
+  // Each frame timer uses a pair of queries, for the start and the end of the frame. Frames are
+  // not timed while the next timer in the ring is still waiting for its results.
+  static const u32 NUM_FRAME_TIMERS = 8;
+  struct FrameTimer
+  {
+    u64 frame = 0;
+    bool pending = false;
+  };
+  std::array<FrameTimer, NUM_FRAME_TIMERS> m_frame_timers;
+  VkQueryPool m_frame_timer_query_pool = VK_NULL_HANDLE;
+  u32 m_current_frame_timer = 0;
+  bool m_frame_timer_active = false;
 };
 }
@@ -63,9 +63,7 @@ bool ShaderCache::Initialize()
     return false;
 
   m_async_shader_compiler = std::make_unique<VideoCommon::AsyncShaderCompiler>();
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.CanPrecompileUberShaders() ?
-                                                   g_ActiveConfig.GetShaderPrecompilerThreads() :
-                                                   g_ActiveConfig.GetShaderCompilerThreads());
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
   return true;
 }
 
@@ -239,6 +237,12 @@ GetVulkanColorBlendState(const BlendingState& state,
 }
 
 VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info)
+{
+  return CreatePipeline(info, m_pipeline_cache, VK_NULL_HANDLE, 0);
+}
+
+VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info, VkPipelineCache pipeline_cache,
+                                       VkPipeline base_pipeline, VkPipelineCreateFlags flags)
 {
   // Declare descriptors for empty vertex buffers/attributes
   static const VkPipelineVertexInputStateCreateInfo empty_vertex_input_state = {
@@ -345,7 +349,7 @@ VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info)
   VkGraphicsPipelineCreateInfo pipeline_info = {
       VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
       nullptr,                // VkStructureType sType
-      0,                      // VkPipelineCreateFlags                            flags
+      flags,                  // VkPipelineCreateFlags                            flags
       num_shader_stages,      // uint32_t                                         stageCount
       shader_stages,          // const VkPipelineShaderStageCreateInfo*           pStages
       &vertex_input_state,    // const VkPipelineVertexInputStateCreateInfo*      pVertexInputState
@@ -360,12 +364,12 @@ VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info)
       info.pipeline_layout,  // VkPipelineLayout                                 layout
       info.render_pass,      // VkRenderPass                                     renderPass
       0,                     // uint32_t                                         subpass
-      VK_NULL_HANDLE,        // VkPipeline                                       basePipelineHandle
+      base_pipeline,         // VkPipeline                                       basePipelineHandle
       -1                     // int32_t                                          basePipelineIndex
   };
 
   VkPipeline pipeline;
-  VkResult res = vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), m_pipeline_cache, 1,
+  VkResult res = vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), pipeline_cache, 1,
                                            &pipeline_info, nullptr, &pipeline);
   if (res != VK_SUCCESS)
   {
@@ -376,6 +380,112 @@ VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info)
   return pipeline;
 }
 
+VkPipeline ShaderCache::CreateCachedPipeline(const PipelineInfo& info,
+                                             VkPipelineCache pipeline_cache,
+                                             bool* allows_derivatives)
+{
+  // Pipelines usually differ from the base only in their fixed-function state, which lets the
+  // driver reuse the compiled shaders.
+  VkPipeline base_pipeline = VK_NULL_HANDLE;
+  {
+    std::lock_guard<std::mutex> guard(m_base_pipeline_lock);
+    auto iter = m_base_pipelines.find(std::make_tuple(info.vs, info.gs, info.ps));
+    if (iter != m_base_pipelines.end())
+      base_pipeline = iter->second;
+  }
+
+  *allows_derivatives = base_pipeline == VK_NULL_HANDLE;
+  if (base_pipeline == VK_NULL_HANDLE)
+    return CreatePipeline(info, pipeline_cache, VK_NULL_HANDLE,
+                          VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT);
+
+  return CreatePipeline(info, pipeline_cache, base_pipeline, VK_PIPELINE_CREATE_DERIVATIVE_BIT);
+}
+
+void ShaderCache::AddBasePipeline(const PipelineInfo& info, VkPipeline pipeline)
+{
+  // Only pipelines which are kept in m_pipeline_objects can be bases, as they live until
+  // ClearPipelineCache() is called. If several were created for the same shaders before one of
+  // them was stored, the first one stored wins.
+  if (pipeline == VK_NULL_HANDLE)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_base_pipeline_lock);
+  m_base_pipelines.emplace(std::make_tuple(info.vs, info.gs, info.ps), pipeline);
+}
+
+VkPipelineCache ShaderCache::AcquireWorkerPipelineCache()
+{
+  std::lock_guard<std::mutex> guard(m_worker_pipeline_cache_lock);
+  if (!m_free_worker_pipeline_caches.empty())
+  {
+    VkPipelineCache pipeline_cache = m_free_worker_pipeline_caches.back();
+    m_free_worker_pipeline_caches.pop_back();
+    return pipeline_cache;
+  }
+
+  // Start with the contents of the main cache, so that pipelines loaded from disk are found.
+  std::vector<u8> data;
+  size_t data_size;
+  if (vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size,
+                             nullptr) == VK_SUCCESS)
+  {
+    data.resize(data_size);
+    if (vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size,
+                               data.data()) != VK_SUCCESS)
+    {
+      data.clear();
+    }
+  }
+
+  VkPipelineCacheCreateInfo info = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO, nullptr, 0,
+                                    data.size(), data.data()};
+  VkPipelineCache pipeline_cache;
+  VkResult res =
+      vkCreatePipelineCache(g_vulkan_context->GetDevice(), &info, nullptr, &pipeline_cache);
+  if (res != VK_SUCCESS)
+  {
+    // Fall back to sharing the main cache.
+    LOG_VULKAN_ERROR(res, "vkCreatePipelineCache failed: ");
+    return m_pipeline_cache;
+  }
+
+  m_worker_pipeline_caches.push_back(pipeline_cache);
+  return pipeline_cache;
+}
+
+void ShaderCache::ReleaseWorkerPipelineCache(VkPipelineCache pipeline_cache)
+{
+  if (pipeline_cache == m_pipeline_cache)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_worker_pipeline_cache_lock);
+  m_free_worker_pipeline_caches.push_back(pipeline_cache);
+}
+
+void ShaderCache::MergeWorkerPipelineCaches()
+{
+  // Caches which are in use by a compile in progress are left for the next merge.
+  std::lock_guard<std::mutex> guard(m_worker_pipeline_cache_lock);
+  if (m_free_worker_pipeline_caches.empty())
+    return;
+
+  VkResult res = vkMergePipelineCaches(g_vulkan_context->GetDevice(), m_pipeline_cache,
+                                       static_cast<u32>(m_free_worker_pipeline_caches.size()),
+                                       m_free_worker_pipeline_caches.data());
+  if (res != VK_SUCCESS)
+    LOG_VULKAN_ERROR(res, "vkMergePipelineCaches failed: ");
+}
+
+void ShaderCache::DestroyWorkerPipelineCaches()
+{
+  std::lock_guard<std::mutex> guard(m_worker_pipeline_cache_lock);
+  for (VkPipelineCache pipeline_cache : m_worker_pipeline_caches)
+    vkDestroyPipelineCache(g_vulkan_context->GetDevice(), pipeline_cache, nullptr);
+  m_worker_pipeline_caches.clear();
+  m_free_worker_pipeline_caches.clear();
+}
+
 VkPipeline ShaderCache::GetPipeline(const PipelineInfo& info)
 {
   return GetPipelineWithCacheResult(info).first;
@@ -393,8 +503,11 @@ std::pair<VkPipeline, bool> ShaderCache::GetPipelineWithCacheResult(const Pipeli
       m_pipeline_objects.erase(iter);
   }
 
-  VkPipeline pipeline = CreatePipeline(info);
+  bool allows_derivatives;
+  VkPipeline pipeline = CreateCachedPipeline(info, m_pipeline_cache, &allows_derivatives);
   m_pipeline_objects.emplace(info, std::make_pair(pipeline, false));
+  if (allows_derivatives)
+    AddBasePipeline(info, pipeline);
   _assert_(pipeline != VK_NULL_HANDLE);
   return {pipeline, false};
 }
@@ -458,6 +571,11 @@ void ShaderCache::ClearPipelineCache()
   }
   m_pipeline_objects.clear();
 
+  {
+    std::lock_guard<std::mutex> guard(m_base_pipeline_lock);
+    m_base_pipelines.clear();
+  }
+
   for (const auto& it : m_compute_pipeline_objects)
   {
     if (it.second != VK_NULL_HANDLE)
@@ -621,12 +739,15 @@ bool ShaderCache::ValidatePipelineCache(const u8* data, size_t data_length)
 void ShaderCache::DestroyPipelineCache()
 {
   ClearPipelineCache();
+  DestroyWorkerPipelineCaches();
   vkDestroyPipelineCache(g_vulkan_context->GetDevice(), m_pipeline_cache, nullptr);
   m_pipeline_cache = VK_NULL_HANDLE;
 }
 
 void ShaderCache::SavePipelineCache()
 {
+  MergeWorkerPipelineCaches();
+
   size_t data_size;
   VkResult res =
       vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size, nullptr);
@@ -683,6 +804,9 @@ struct ShaderCacheReader : public LinearDiskCacheReader<Uid, u32>
 
 void ShaderCache::LoadShaderCaches()
 {
+  ShaderCompiler::LoadSPIRVCache(
+      GetDiskShaderCacheFileName(APIType::Vulkan, "SPIRV", false, false));
+
   ShaderCacheReader<VertexShaderUid> vs_reader(m_vs_cache.shader_map);
   m_vs_cache.disk_cache.OpenAndRead(GetDiskShaderCacheFileName(APIType::Vulkan, "VS", true, true),
                                     vs_reader);
@@ -734,6 +858,7 @@ void ShaderCache::DestroyShaderCaches()
 
   DestroyShaderCache(m_uber_vs_cache);
   DestroyShaderCache(m_uber_ps_cache);
+  ShaderCompiler::CloseSPIRVCache();
 
   SETSTAT(stats.numPixelShadersCreated, 0);
   SETSTAT(stats.numPixelShadersAlive, 0);
@@ -1220,6 +1345,7 @@ void ShaderCache::CreateDummyPipeline(const UberShader::VertexShaderUid& vuid,
 
 void ShaderCache::PrecompileUberShaders()
 {
+  StartPrecompiling();
   UberShader::EnumerateVertexShaderUids([&](const UberShader::VertexShaderUid& vuid) {
     UberShader::EnumeratePixelShaderUids([&](const UberShader::PixelShaderUid& puid) {
       // UIDs must have compatible texgens, a mismatching combination will never be queried.
@@ -1235,10 +1361,7 @@ void ShaderCache::PrecompileUberShaders()
     });
   });
 
-  WaitForBackgroundCompilesToComplete();
-
-  // Switch to the runtime/background thread config.
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  FinishPrecompiling();
 }
 
 void ShaderCache::WaitForBackgroundCompilesToComplete()
@@ -1251,6 +1374,19 @@ void ShaderCache::WaitForBackgroundCompilesToComplete()
   Host_UpdateProgressDialog("", -1, -1);
 }
 
+void ShaderCache::StartPrecompiling()
+{
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
+}
+
+void ShaderCache::FinishPrecompiling()
+{
+  WaitForBackgroundCompilesToComplete();
+
+  // Switch to the runtime/background thread config.
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+}
+
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
@@ -1362,7 +1498,9 @@ void ShaderCache::PixelShaderCompilerWorkItem::Retrieve()
 
 bool ShaderCache::PipelineCompilerWorkItem::Compile()
 {
-  m_pipeline = g_shader_cache->CreatePipeline(m_info);
+  VkPipelineCache pipeline_cache = g_shader_cache->AcquireWorkerPipelineCache();
+  m_pipeline = g_shader_cache->CreateCachedPipeline(m_info, pipeline_cache, &m_allows_derivatives);
+  g_shader_cache->ReleaseWorkerPipelineCache(pipeline_cache);
   return true;
 }
 
@@ -1372,6 +1510,8 @@ void ShaderCache::PipelineCompilerWorkItem::Retrieve()
   if (it == g_shader_cache->m_pipeline_objects.end())
   {
     g_shader_cache->m_pipeline_objects.emplace(m_info, std::make_pair(m_pipeline, false));
+    if (m_allows_derivatives)
+      g_shader_cache->AddBasePipeline(m_info, m_pipeline);
     return;
   }
 
@@ -1386,5 +1526,7 @@ void ShaderCache::PipelineCompilerWorkItem::Retrieve()
   // No longer pending.
   it->second.first = m_pipeline;
   it->second.second = false;
+  if (m_allows_derivatives)
+    g_shader_cache->AddBasePipeline(m_info, m_pipeline);
 }
 }
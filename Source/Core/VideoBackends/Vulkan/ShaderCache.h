@@ -8,9 +8,12 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/LinearDiskCache.h"
@@ -154,11 +157,34 @@ public:
   void WaitForBackgroundCompilesToComplete();
   void RetrieveAsyncShaders();
 
+  // Switches the async compiler to the precompiler thread count. FinishPrecompiling() waits for
+  // everything queued in the meantime, showing progress, and switches back.
+  void StartPrecompiling();
+  void FinishPrecompiling();
+
 private:
   bool CreatePipelineCache();
   bool LoadPipelineCache();
   bool ValidatePipelineCache(const u8* data, size_t data_length);
   void DestroyPipelineCache();
+
+  // Creates a pipeline in the given cache, as a derivative of the base pipeline if there is one.
+  VkPipeline CreatePipeline(const PipelineInfo& info, VkPipelineCache pipeline_cache,
+                            VkPipeline base_pipeline, VkPipelineCreateFlags flags);
+
+  // Creates a pipeline which will be stored in m_pipeline_objects. The first pipeline stored for a
+  // set of shaders becomes the base which the later ones with the same shaders derive from, so
+  // pipelines which are created without a base are passed to AddBasePipeline once stored.
+  VkPipeline CreateCachedPipeline(const PipelineInfo& info, VkPipelineCache pipeline_cache,
+                                  bool* allows_derivatives);
+  void AddBasePipeline(const PipelineInfo& info, VkPipeline pipeline);
+
+  // Pipelines compiled in the background go into a cache per thread, as drivers lock the cache
+  // while creating a pipeline. These are merged into the main cache before it is saved.
+  VkPipelineCache AcquireWorkerPipelineCache();
+  void ReleaseWorkerPipelineCache(VkPipelineCache pipeline_cache);
+  void MergeWorkerPipelineCaches();
+  void DestroyWorkerPipelineCaches();
   void LoadShaderCaches();
   void DestroyShaderCaches();
   bool CompileSharedShaders();
@@ -189,6 +215,14 @@ private:
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
   std::string m_pipeline_cache_filename;
 
+  using ShaderSet = std::tuple<VkShaderModule, VkShaderModule, VkShaderModule>;
+  std::map<ShaderSet, VkPipeline> m_base_pipelines;
+  std::mutex m_base_pipeline_lock;
+
+  std::vector<VkPipelineCache> m_worker_pipeline_caches;
+  std::vector<VkPipelineCache> m_free_worker_pipeline_caches;
+  std::mutex m_worker_pipeline_cache_lock;
+
   // Utility/shared shaders
   VkShaderModule m_screen_quad_vertex_shader = VK_NULL_HANDLE;
   VkShaderModule m_passthrough_vertex_shader = VK_NULL_HANDLE;
@@ -232,6 +266,7 @@ private:
   private:
     PipelineInfo m_info;
     VkPipeline m_pipeline;
+    bool m_allows_derivatives = false;
   };
 };
 
@@ -5,18 +5,25 @@
 #include "VideoBackends/Vulkan/ShaderCompiler.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 
 // glslang includes
 #include "GlslangToSpv.h"
 #include "ShaderLang.h"
 #include "disassemble.h"
 
+#include <xxhash.h>
+
 #include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
@@ -38,6 +45,26 @@ static bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage,
                                const char* stage_filename, const char* source_code,
                                size_t source_code_length, const char* header, size_t header_length);
 
+// Key of the SPIR-V cache. Two hashes with different seeds make collisions between the
+// thousands of shaders of a cache unlikely enough to ignore.
+struct SPIRVCacheKey
+{
+  u64 source_hash[2];
+  u32 source_length;
+  u32 stage;
+
+  bool operator<(const SPIRVCacheKey& rhs) const
+  {
+    return std::tie(source_hash[0], source_hash[1], source_length, stage) <
+           std::tie(rhs.source_hash[0], rhs.source_hash[1], rhs.source_length, rhs.stage);
+  }
+};
+
+static std::mutex s_spirv_cache_lock;
+static std::map<SPIRVCacheKey, SPIRVCodeVector> s_spirv_cache;
+static LinearDiskCache<SPIRVCacheKey, u32> s_spirv_disk_cache;
+static bool s_spirv_cache_open = false;
+
 // Copy GLSL source code to a SPIRVCodeVector, for use with VK_NV_glsl_shader.
 static void CopyGLSLToSPVVector(SPIRVCodeVector* out_code, const char* stage_filename,
                                 const char* source_code, size_t source_code_length,
@@ -129,10 +156,25 @@ bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage, const char
     pass_source_code_length = static_cast<int>(full_source_code.length());
   }
 
+  SPIRVCacheKey cache_key = {};
+  cache_key.source_hash[0] = XXH64(pass_source_code, pass_source_code_length, 0);
+  cache_key.source_hash[1] = XXH64(pass_source_code, pass_source_code_length, 1);
+  cache_key.source_length = static_cast<u32>(pass_source_code_length);
+  cache_key.stage = static_cast<u32>(stage);
+  {
+    std::lock_guard<std::mutex> guard(s_spirv_cache_lock);
+    auto iter = s_spirv_cache.find(cache_key);
+    if (iter != s_spirv_cache.end())
+    {
+      *out_code = iter->second;
+      return true;
+    }
+  }
+
   shader->setStringsWithLengths(&pass_source_code, &pass_source_code_length, 1);
 
   auto DumpBadShader = [&](const char* msg) {
-    static int counter = 0;
+    static std::atomic<int> counter{0};
     std::string filename = StringFromFormat(
         "%sbad_%s_%04i.txt", File::GetUserPath(D_DUMP_IDX).c_str(), stage_filename, counter++);
 
@@ -200,7 +242,7 @@ bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage, const char
   // Dump source code of shaders out to file if enabled.
   if (g_ActiveConfig.iLog & CONF_SAVESHADERS)
   {
-    static int counter = 0;
+    static std::atomic<int> counter{0};
     std::string filename = StringFromFormat("%s%s_%04i.txt", File::GetUserPath(D_DUMP_IDX).c_str(),
                                             stage_filename, counter++);
 
@@ -222,6 +264,10 @@ bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage, const char
     }
   }
 
+  std::lock_guard<std::mutex> guard(s_spirv_cache_lock);
+  if (s_spirv_cache.emplace(cache_key, *out_code).second && s_spirv_cache_open)
+    s_spirv_disk_cache.Append(cache_key, out_code->data(), static_cast<u32>(out_code->size()));
+
   return true;
 }
 
@@ -243,7 +289,7 @@ void CopyGLSLToSPVVector(SPIRVCodeVector* out_code, const char* stage_filename,
 
   if (g_ActiveConfig.iLog & CONF_SAVESHADERS)
   {
-    static int counter = 0;
+    static std::atomic<int> counter{0};
     std::string filename = StringFromFormat("%s%s_%04i.txt", File::GetUserPath(D_DUMP_IDX).c_str(),
                                             stage_filename, counter++);
 
@@ -263,20 +309,51 @@ void CopyGLSLToSPVVector(SPIRVCodeVector* out_code, const char* stage_filename,
 
 bool InitializeGlslang()
 {
-  static bool glslang_initialized = false;
-  if (glslang_initialized)
+  // The process-wide state is shared by all threads, each compile has its own TShader/TProgram.
+  static const bool glslang_initialized = []() {
+    if (!glslang::InitializeProcess())
+    {
+      PanicAlert("Failed to initialize glslang shader compiler");
+      return false;
+    }
+
+    std::atexit([]() { glslang::FinalizeProcess(); });
     return true;
+  }();
 
-  if (!glslang::InitializeProcess())
+  return glslang_initialized;
+}
+
+namespace
+{
+class SPIRVCacheReader : public LinearDiskCacheReader<SPIRVCacheKey, u32>
+{
+public:
+  void Read(const SPIRVCacheKey& key, const u32* value, u32 value_size) override
   {
-    PanicAlert("Failed to initialize glslang shader compiler");
-    return false;
+    s_spirv_cache.emplace(key, SPIRVCodeVector(value, value + value_size));
   }
+};
+}
 
-  std::atexit([]() { glslang::FinalizeProcess(); });
+void LoadSPIRVCache(const std::string& filename)
+{
+  std::lock_guard<std::mutex> guard(s_spirv_cache_lock);
+  SPIRVCacheReader reader;
+  s_spirv_disk_cache.OpenAndRead(filename, reader);
+  s_spirv_cache_open = true;
+}
 
-  glslang_initialized = true;
-  return true;
+void CloseSPIRVCache()
+{
+  std::lock_guard<std::mutex> guard(s_spirv_cache_lock);
+  if (!s_spirv_cache_open)
+    return;
+
+  s_spirv_disk_cache.Sync();
+  s_spirv_disk_cache.Close();
+  s_spirv_cache_open = false;
+  s_spirv_cache.clear();
 }
 
 const TBuiltInResource* GetCompilerResourceLimits()
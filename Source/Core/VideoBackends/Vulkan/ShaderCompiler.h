@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -17,6 +18,12 @@ namespace ShaderCompiler
 using SPIRVCodeType = u32;
 using SPIRVCodeVector = std::vector<SPIRVCodeType>;
 
+// SPIR-V compiled with glslang is also cached by a hash of the GLSL source. Unlike the UID caches,
+// the file doesn't depend on the game or the host config, so it can be copied to other machines
+// running the same build. The shaders can be compiled on multiple threads at once.
+void LoadSPIRVCache(const std::string& filename);
+void CloseSPIRVCache();
+
 // Compile a vertex shader to SPIR-V.
 bool CompileVertexShader(SPIRVCodeVector* out_code, const char* source_code,
                          size_t source_code_length);
@@ -4,6 +4,7 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "Common/Align.h"
@@ -21,6 +22,7 @@
 
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
@@ -115,6 +117,8 @@ bool StateTracker::Initialize()
 
   // Set default constants
   UploadAllConstants();
+
+  UpdateRecordingThreads();
   return true;
 }
 
@@ -136,14 +140,14 @@ void StateTracker::ReloadPipelineUIDCache()
   class PipelineInserter final : public LinearDiskCacheReader<SerializedPipelineUID, u32>
   {
   public:
-    explicit PipelineInserter(StateTracker* this_ptr_) : this_ptr(this_ptr_) {}
+    explicit PipelineInserter(std::vector<SerializedPipelineUID>* uids_) : uids(uids_) {}
     void Read(const SerializedPipelineUID& key, const u32* value, u32 value_size)
     {
-      this_ptr->PrecachePipelineUID(key);
+      uids->push_back(key);
     }
 
   private:
-    StateTracker* this_ptr;
+    std::vector<SerializedPipelineUID>* uids;
   };
 
   m_uid_cache.Sync();
@@ -153,8 +157,10 @@ void StateTracker::ReloadPipelineUIDCache()
   std::string filename = GetDiskShaderCacheFileName(APIType::Vulkan, "PipelineUID", true, false);
   if (g_ActiveConfig.bShaderCache)
   {
-    PipelineInserter inserter(this);
+    std::vector<SerializedPipelineUID> uids;
+    PipelineInserter inserter(&uids);
     m_uid_cache.OpenAndRead(filename, inserter);
+    PrecachePipelineUIDs(uids);
   }
 
   // If we were using background compilation, ensure everything is ready before continuing.
@@ -178,9 +184,35 @@ void StateTracker::AppendToPipelineUIDCache(const PipelineInfo& info)
   m_uid_cache.Append(sinfo, &dummy_value, 1);
 }
 
-bool StateTracker::PrecachePipelineUID(const SerializedPipelineUID& uid)
+void StateTracker::PrecachePipelineUIDs(const std::vector<SerializedPipelineUID>& uids)
 {
-  PipelineInfo pinfo = {};
+  if (uids.empty())
+    return;
+
+  g_shader_cache->StartPrecompiling();
+
+  // Most of the time is spent generating and compiling the shaders, which many pipelines share.
+  // Compile them on their own first, so they are spread over all of the threads instead of
+  // being compiled one by one as the pipelines are created.
+  for (const SerializedPipelineUID& uid : uids)
+  {
+    g_shader_cache->GetVertexShaderForUidAsync(uid.vs_uid);
+    g_shader_cache->GetPixelShaderForUidAsync(uid.ps_uid);
+  }
+  g_shader_cache->WaitForBackgroundCompilesToComplete();
+
+  for (const SerializedPipelineUID& uid : uids)
+  {
+    PipelineInfo pinfo = {};
+    if (GetPipelineInfoForUID(uid, &pinfo))
+      g_shader_cache->GetPipelineWithCacheResultAsync(pinfo);
+  }
+  g_shader_cache->FinishPrecompiling();
+}
+
+bool StateTracker::GetPipelineInfoForUID(const SerializedPipelineUID& uid, PipelineInfo* info)
+{
+  PipelineInfo& pinfo = *info;
 
   // Need to create the vertex declaration first, rather than deferring to when a game creates a
   // vertex loader that uses this format, since we need it to create a pipeline.
@@ -215,23 +247,6 @@ bool StateTracker::PrecachePipelineUID(const SerializedPipelineUID& uid)
   pinfo.depth_stencil_state.bits = uid.depth_stencil_state_bits;
   pinfo.blend_state.hex = uid.blend_state_bits;
   pinfo.primitive_topology = uid.primitive_topology;
-
-  if (g_ActiveConfig.bBackgroundShaderCompiling)
-  {
-    // Use async for multithreaded compilation.
-    g_shader_cache->GetPipelineWithCacheResultAsync(pinfo);
-  }
-  else
-  {
-    VkPipeline pipeline = g_shader_cache->GetPipeline(pinfo);
-    if (pipeline == VK_NULL_HANDLE)
-    {
-      WARN_LOG(VIDEO, "Failed to get pipeline from cached UID.");
-      return false;
-    }
-  }
-
-  // We don't need to do anything with this pipeline, just make sure it exists.
   return true;
 }
 
@@ -454,7 +469,17 @@ void StateTracker::ClearShaders()
 
 void StateTracker::UpdateVertexShaderConstants()
 {
-  if (!VertexShaderManager::dirty || !ReserveConstantStorage())
+  if (!VertexShaderManager::dirty)
+    return;
+
+  if (IsConstantUploadRedundant(UBO_DESCRIPTOR_SET_BINDING_VS, &VertexShaderManager::constants,
+                                sizeof(VertexShaderConstants)))
+  {
+    VertexShaderManager::dirty = false;
+    return;
+  }
+
+  if (!ReserveConstantStorage())
     return;
 
   // Buffer allocation changed?
@@ -473,6 +498,8 @@ void StateTracker::UpdateVertexShaderConstants()
   memcpy(m_uniform_stream_buffer->GetCurrentHostPointer(), &VertexShaderManager::constants,
          sizeof(VertexShaderConstants));
   ADDSTAT(stats.thisFrame.bytesUniformStreamed, sizeof(VertexShaderConstants));
+  RecordConstantUpload(UBO_DESCRIPTOR_SET_BINDING_VS, &VertexShaderManager::constants,
+                       sizeof(VertexShaderConstants));
   m_uniform_stream_buffer->CommitMemory(sizeof(VertexShaderConstants));
   VertexShaderManager::dirty = false;
 }
@@ -493,7 +520,17 @@ void StateTracker::UpdateGeometryShaderConstants()
     GeometryShaderManager::dirty = true;
   }
 
-  if (!GeometryShaderManager::dirty || !ReserveConstantStorage())
+  if (!GeometryShaderManager::dirty)
+    return;
+
+  if (IsConstantUploadRedundant(UBO_DESCRIPTOR_SET_BINDING_GS, &GeometryShaderManager::constants,
+                                sizeof(GeometryShaderConstants)))
+  {
+    GeometryShaderManager::dirty = false;
+    return;
+  }
+
+  if (!ReserveConstantStorage())
     return;
 
   // Buffer allocation changed?
@@ -512,13 +549,25 @@ void StateTracker::UpdateGeometryShaderConstants()
   memcpy(m_uniform_stream_buffer->GetCurrentHostPointer(), &GeometryShaderManager::constants,
          sizeof(GeometryShaderConstants));
   ADDSTAT(stats.thisFrame.bytesUniformStreamed, sizeof(GeometryShaderConstants));
+  RecordConstantUpload(UBO_DESCRIPTOR_SET_BINDING_GS, &GeometryShaderManager::constants,
+                       sizeof(GeometryShaderConstants));
   m_uniform_stream_buffer->CommitMemory(sizeof(GeometryShaderConstants));
   GeometryShaderManager::dirty = false;
 }
 
 void StateTracker::UpdatePixelShaderConstants()
 {
-  if (!PixelShaderManager::dirty || !ReserveConstantStorage())
+  if (!PixelShaderManager::dirty)
+    return;
+
+  if (IsConstantUploadRedundant(UBO_DESCRIPTOR_SET_BINDING_PS, &PixelShaderManager::constants,
+                                sizeof(PixelShaderConstants)))
+  {
+    PixelShaderManager::dirty = false;
+    return;
+  }
+
+  if (!ReserveConstantStorage())
     return;
 
   // Buffer allocation changed?
@@ -537,6 +586,8 @@ void StateTracker::UpdatePixelShaderConstants()
   memcpy(m_uniform_stream_buffer->GetCurrentHostPointer(), &PixelShaderManager::constants,
          sizeof(PixelShaderConstants));
   ADDSTAT(stats.thisFrame.bytesUniformStreamed, sizeof(PixelShaderConstants));
+  RecordConstantUpload(UBO_DESCRIPTOR_SET_BINDING_PS, &PixelShaderManager::constants,
+                       sizeof(PixelShaderConstants));
   m_uniform_stream_buffer->CommitMemory(sizeof(PixelShaderConstants));
   PixelShaderManager::dirty = false;
 }
@@ -615,6 +666,13 @@ void StateTracker::UploadAllConstants()
   memcpy(m_uniform_stream_buffer->GetCurrentHostPointer() + geometry_constants_offset,
          &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
 
+  RecordConstantUpload(UBO_DESCRIPTOR_SET_BINDING_PS, &PixelShaderManager::constants,
+                       sizeof(PixelShaderConstants));
+  RecordConstantUpload(UBO_DESCRIPTOR_SET_BINDING_VS, &VertexShaderManager::constants,
+                       sizeof(VertexShaderConstants));
+  RecordConstantUpload(UBO_DESCRIPTOR_SET_BINDING_GS, &GeometryShaderManager::constants,
+                       sizeof(GeometryShaderConstants));
+
   // Finally, flush buffer memory after copying
   m_uniform_stream_buffer->CommitMemory(allocation_size);
 
@@ -624,6 +682,23 @@ void StateTracker::UploadAllConstants()
   PixelShaderManager::dirty = false;
 }
 
+bool StateTracker::IsConstantUploadRedundant(size_t binding, const void* data,
+                                             size_t size) const
+{
+  // The buffer changes when the stream buffer is resized, and the old one goes away.
+  const std::vector<u8>& uploaded = m_uploaded_constants[binding];
+  return uploaded.size() == size &&
+         m_bindings.uniform_buffer_bindings[binding].buffer ==
+             m_uniform_stream_buffer->GetBuffer() &&
+         std::memcmp(uploaded.data(), data, size) == 0;
+}
+
+void StateTracker::RecordConstantUpload(size_t binding, const void* data, size_t size)
+{
+  const u8* bytes = static_cast<const u8*>(data);
+  m_uploaded_constants[binding].assign(bytes, bytes + size);
+}
+
 void StateTracker::SetTexture(size_t index, VkImageView view)
 {
   if (m_bindings.ps_samplers[index].imageView == view)
@@ -690,6 +765,9 @@ void StateTracker::InvalidateDescriptorSets()
 
 void StateTracker::InvalidateConstants()
 {
+  for (std::vector<u8>& uploaded : m_uploaded_constants)
+    uploaded.clear();
+
   VertexShaderManager::dirty = true;
   GeometryShaderManager::dirty = true;
   PixelShaderManager::dirty = true;
@@ -706,7 +784,13 @@ void StateTracker::SetPendingRebind()
 void StateTracker::BeginRenderPass()
 {
   if (InRenderPass())
-    return;
+  {
+    // Commands recorded directly can't be mixed with the deferred draws.
+    if (!m_deferring_draws)
+      return;
+
+    EndDeferredRenderPass();
+  }
 
   m_current_render_pass = m_load_render_pass;
   m_framebuffer_render_area = m_framebuffer_size;
@@ -728,10 +812,175 @@ void StateTracker::EndRenderPass()
   if (!InRenderPass())
     return;
 
+  if (m_deferring_draws)
+  {
+    EndDeferredRenderPass();
+    return;
+  }
+
   vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
   m_current_render_pass = VK_NULL_HANDLE;
 }
 
+void StateTracker::BeginDeferredRenderPass()
+{
+  _assert_(!InRenderPass());
+
+  m_current_render_pass = m_load_render_pass;
+  m_framebuffer_render_area = m_framebuffer_size;
+  m_deferring_draws = true;
+}
+
+void StateTracker::EndDeferredRenderPass()
+{
+  VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+                                      nullptr,
+                                      m_current_render_pass,
+                                      m_framebuffer,
+                                      m_framebuffer_render_area,
+                                      0,
+                                      nullptr};
+
+  // Only split the draws between the threads if each of them gets enough of them to be worth it.
+  const size_t num_draws = m_deferred_draws.size();
+  const size_t num_command_buffers =
+      m_recording_pool ? std::min(m_recording_pool->GetNumWorkers() + 1,
+                                  num_draws / MINIMUM_DRAW_CALLS_PER_SECONDARY_COMMAND_BUFFER) :
+                         0;
+  std::vector<VkCommandBuffer> command_buffers;
+  for (size_t i = 0; i < num_command_buffers; i++)
+  {
+    VkCommandBuffer secondary_command_buffer =
+        g_command_buffer_mgr->AllocateSecondaryCommandBuffer(i);
+    if (secondary_command_buffer == VK_NULL_HANDLE)
+    {
+      // Record everything into the primary command buffer instead.
+      command_buffers.clear();
+      break;
+    }
+    command_buffers.push_back(secondary_command_buffer);
+  }
+
+  if (command_buffers.size() > 1)
+  {
+    VkCommandBufferInheritanceInfo inheritance_info = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        nullptr,
+        m_current_render_pass,
+        0,
+        m_framebuffer,
+        VK_FALSE,
+        0,
+        0};
+    VkCommandBufferBeginInfo command_buffer_begin_info = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+            VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        &inheritance_info};
+
+    // Each command buffer belongs to the pool of its index, so no two threads share a pool.
+    m_recording_pool->Run(command_buffers.size(), [&](size_t i) {
+      const size_t first_draw = num_draws * i / command_buffers.size();
+      const size_t end_draw = num_draws * (i + 1) / command_buffers.size();
+      VkResult res = vkBeginCommandBuffer(command_buffers[i], &command_buffer_begin_info);
+      if (res != VK_SUCCESS)
+        LOG_VULKAN_ERROR(res, "vkBeginCommandBuffer failed: ");
+
+      RecordDeferredDraws(command_buffers[i], m_deferred_draws.data() + first_draw,
+                          end_draw - first_draw);
+
+      res = vkEndCommandBuffer(command_buffers[i]);
+      if (res != VK_SUCCESS)
+        LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+    });
+
+    vkCmdBeginRenderPass(command_buffer, &begin_info,
+                         VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    vkCmdExecuteCommands(command_buffer, static_cast<u32>(command_buffers.size()),
+                         command_buffers.data());
+  }
+  else
+  {
+    vkCmdBeginRenderPass(command_buffer, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+    RecordDeferredDraws(command_buffer, m_deferred_draws.data(), num_draws);
+  }
+
+  vkCmdEndRenderPass(command_buffer);
+  m_current_render_pass = VK_NULL_HANDLE;
+  m_deferring_draws = false;
+  m_deferred_draws.clear();
+
+  // The bindings of the primary command buffer are undefined after executing secondary ones.
+  SetPendingRebind();
+}
+
+void StateTracker::RecordDeferredDraws(VkCommandBuffer command_buffer, const DeferredDraw* draws,
+                                       size_t num_draws)
+{
+  const DeferredDraw* last = nullptr;
+  for (const DeferredDraw* draw = draws; draw != draws + num_draws; last = draw++)
+  {
+    if (!last || draw->vertex_buffer != last->vertex_buffer ||
+        draw->vertex_buffer_offset != last->vertex_buffer_offset)
+    {
+      vkCmdBindVertexBuffers(command_buffer, 0, 1, &draw->vertex_buffer,
+                             &draw->vertex_buffer_offset);
+    }
+
+    if (!last || draw->index_buffer != last->index_buffer ||
+        draw->index_buffer_offset != last->index_buffer_offset ||
+        draw->index_type != last->index_type)
+    {
+      vkCmdBindIndexBuffer(command_buffer, draw->index_buffer, draw->index_buffer_offset,
+                           draw->index_type);
+    }
+
+    if (!last || draw->pipeline != last->pipeline)
+      vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw->pipeline);
+
+    if (!last || draw->pipeline_layout != last->pipeline_layout ||
+        draw->num_descriptor_sets != last->num_descriptor_sets ||
+        !std::equal(draw->descriptor_sets.begin(),
+                    draw->descriptor_sets.begin() + draw->num_descriptor_sets,
+                    last->descriptor_sets.begin()))
+    {
+      vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                              draw->pipeline_layout, 0, draw->num_descriptor_sets,
+                              draw->descriptor_sets.data(), NUM_UBO_DESCRIPTOR_SET_BINDINGS,
+                              draw->uniform_buffer_offsets.data());
+    }
+    else if (draw->uniform_buffer_offsets != last->uniform_buffer_offsets)
+    {
+      vkCmdBindDescriptorSets(
+          command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw->pipeline_layout,
+          DESCRIPTOR_SET_BIND_POINT_UNIFORM_BUFFERS, 1,
+          &draw->descriptor_sets[DESCRIPTOR_SET_BIND_POINT_UNIFORM_BUFFERS],
+          NUM_UBO_DESCRIPTOR_SET_BINDINGS, draw->uniform_buffer_offsets.data());
+    }
+
+    if (!last || memcmp(&draw->viewport, &last->viewport, sizeof(draw->viewport)) != 0)
+      vkCmdSetViewport(command_buffer, 0, 1, &draw->viewport);
+
+    if (!last || memcmp(&draw->scissor, &last->scissor, sizeof(draw->scissor)) != 0)
+      vkCmdSetScissor(command_buffer, 0, 1, &draw->scissor);
+
+    vkCmdDrawIndexed(command_buffer, draw->index_count, 1, draw->base_index, draw->base_vertex,
+                     0);
+  }
+}
+
+void StateTracker::UpdateRecordingThreads()
+{
+  const size_t num_workers =
+      static_cast<size_t>(std::max(g_ActiveConfig.iCommandRecordingThreads, 0));
+  if (num_workers == 0)
+    m_recording_pool.reset();
+  else if (!m_recording_pool || m_recording_pool->GetNumWorkers() != num_workers)
+    m_recording_pool =
+        std::make_unique<Common::WorkerPool>(num_workers, Common::TaskPriority::High);
+}
+
 void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue clear_values[2])
 {
   _assert_(!InRenderPass());
@@ -796,9 +1045,22 @@ bool StateTracker::Bind(bool rebind_all /*= false*/)
     }
   }
 
-  // Start render pass if not already started
+  // Start render pass if not already started. The draws of passes started here can be recorded
+  // on the worker threads, unless a query is active, which would have to be inherited.
   if (!InRenderPass())
-    BeginRenderPass();
+  {
+    if (m_recording_pool && m_allow_background_execution)
+      BeginDeferredRenderPass();
+    else
+      BeginRenderPass();
+  }
+
+  // Deferred draws capture the whole state in DrawIndexed() instead.
+  if (m_deferring_draws)
+  {
+    m_dirty_flags = 0;
+    return true;
+  }
 
   // Re-bind parts of the pipeline
   VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
@@ -837,6 +1099,23 @@ bool StateTracker::Bind(bool rebind_all /*= false*/)
   return true;
 }
 
+void StateTracker::DrawIndexed(u32 index_count, u32 base_index, s32 base_vertex)
+{
+  if (!m_deferring_draws)
+  {
+    vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), index_count, 1, base_index,
+                     base_vertex, 0);
+    return;
+  }
+
+  m_deferred_draws.push_back({m_pipeline_object, m_pipeline_state.pipeline_layout,
+                              m_descriptor_sets, m_num_active_descriptor_sets,
+                              m_bindings.uniform_buffer_offsets, m_vertex_buffer,
+                              m_vertex_buffer_offset, m_index_buffer, m_index_buffer_offset,
+                              m_index_type, m_viewport, m_scissor, index_count, base_index,
+                              base_vertex});
+}
+
 void StateTracker::OnDraw()
 {
   m_draw_counter++;
@@ -867,6 +1146,8 @@ void StateTracker::OnReadback()
 
 void StateTracker::OnEndFrame()
 {
+  UpdateRecordingThreads();
+
   m_draw_counter = 0;
   m_scheduled_command_buffer_kicks.clear();
 
@@ -1013,7 +1294,10 @@ bool StateTracker::UpdatePipeline()
     return false;
 
   // Grab a new pipeline object, this can fail.
-  m_pipeline_object = GetPipelineAndCacheUID();
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderCompileWait);
+    m_pipeline_object = GetPipelineAndCacheUID();
+  }
 
   m_dirty_flags |= DIRTY_FLAG_PIPELINE_BINDING;
   return m_pipeline_object != VK_NULL_HANDLE;
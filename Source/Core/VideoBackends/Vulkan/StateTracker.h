@@ -7,9 +7,11 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/LinearDiskCache.h"
+#include "Common/WorkerPool.h"
 #include "VideoBackends/Vulkan/Constants.h"
 #include "VideoBackends/Vulkan/ShaderCache.h"
 #include "VideoCommon/GeometryShaderGen.h"
@@ -44,6 +46,7 @@ public:
     return m_pipeline_state.depth_stencil_state;
   }
   const BlendingState& GetBlendState() const { return m_pipeline_state.blend_state; }
+  bool IsUsingUberShaders() const { return m_using_ubershaders; }
   void SetVertexBuffer(VkBuffer buffer, VkDeviceSize offset);
   void SetIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType type);
 
@@ -89,6 +92,8 @@ public:
   // Ends a render pass if we're currently in one.
   // When Bind() is next called, the pass will be restarted.
   // Calling this function is allowed even if a pass has not begun.
+  // BeginRenderPass() always leaves a pass open which commands can be recorded into directly,
+  // so it ends the pass first if its draws are being deferred.
   bool InRenderPass() const { return m_current_render_pass != VK_NULL_HANDLE; }
   void BeginRenderPass();
   void EndRenderPass();
@@ -102,6 +107,10 @@ public:
 
   bool Bind(bool rebind_all = false);
 
+  // Draws with the state set up by Bind(). If the render pass was started by Bind() and command
+  // recording threads are enabled, the draw is only recorded when the render pass ends.
+  void DrawIndexed(u32 index_count, u32 base_index, s32 base_vertex);
+
   // CPU Access Tracking
   // Call after a draw call is made.
   void OnDraw();
@@ -172,8 +181,44 @@ private:
   // The info is here so that we can store variations of a UID, e.g. blend state.
   void AppendToPipelineUIDCache(const PipelineInfo& info);
 
-  // Precaches a pipeline based on the UID information.
-  bool PrecachePipelineUID(const SerializedPipelineUID& uid);
+  // Creates the pipelines for all of the UIDs, compiling their shaders first.
+  // Both steps are spread over the shader precompiler threads.
+  void PrecachePipelineUIDs(const std::vector<SerializedPipelineUID>& uids);
+
+  // Fills in a pipeline description from its UID, getting shaders from the shader cache.
+  bool GetPipelineInfoForUID(const SerializedPipelineUID& uid, PipelineInfo* info);
+
+  // Draw state captured for a draw in a deferred render pass.
+  struct DeferredDraw
+  {
+    VkPipeline pipeline;
+    VkPipelineLayout pipeline_layout;
+    std::array<VkDescriptorSet, NUM_DESCRIPTOR_SET_BIND_POINTS> descriptor_sets;
+    u32 num_descriptor_sets;
+    std::array<uint32_t, NUM_UBO_DESCRIPTOR_SET_BINDINGS> uniform_buffer_offsets;
+    VkBuffer vertex_buffer;
+    VkDeviceSize vertex_buffer_offset;
+    VkBuffer index_buffer;
+    VkDeviceSize index_buffer_offset;
+    VkIndexType index_type;
+    VkViewport viewport;
+    VkRect2D scissor;
+    u32 index_count;
+    u32 base_index;
+    s32 base_vertex;
+  };
+
+  // Records the draws into a command buffer, only binding the state which changed between them.
+  // Called on the worker threads, so this must not touch the state tracker.
+  static void RecordDeferredDraws(VkCommandBuffer command_buffer, const DeferredDraw* draws,
+                                  size_t num_draws);
+
+  // Starts the load/store render pass without recording it, the draws are kept until it ends.
+  void BeginDeferredRenderPass();
+  void EndDeferredRenderPass();
+
+  // Recreates the recording threads when their number has been changed.
+  void UpdateRecordingThreads();
 
   // Check that the specified viewport is within the render area.
   // If not, ends the render pass if it is a clear render pass.
@@ -198,6 +243,11 @@ private:
   bool ReserveConstantStorage();
   void UploadAllConstants();
 
+  // The managers flag their constants dirty on many register writes which don't change them.
+  // Such uploads are skipped if the last copy of a stage's constants is still bound.
+  bool IsConstantUploadRedundant(size_t binding, const void* data, size_t size) const;
+  void RecordConstantUpload(size_t binding, const void* data, size_t size);
+
   // Which bindings/state has to be updated before the next draw.
   u32 m_dirty_flags = 0;
 
@@ -235,6 +285,7 @@ private:
   } m_bindings;
   u32 m_num_active_descriptor_sets = 0;
   size_t m_uniform_buffer_reserve_size = 0;
+  std::array<std::vector<u8>, NUM_UBO_DESCRIPTOR_SET_BINDINGS> m_uploaded_constants;
 
   // rasterization
   VkViewport m_viewport = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f};
@@ -251,6 +302,11 @@ private:
   VkRect2D m_framebuffer_render_area = {};
   bool m_bbox_enabled = false;
 
+  // Multi-threaded command recording
+  std::unique_ptr<Common::WorkerPool> m_recording_pool;
+  std::vector<DeferredDraw> m_deferred_draws;
+  bool m_deferring_draws = false;
+
   // CPU access tracking
   u32 m_draw_counter = 0;
   std::vector<u32> m_cpu_accesses_this_frame;
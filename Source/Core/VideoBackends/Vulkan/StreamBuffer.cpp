@@ -133,9 +133,7 @@ bool StreamBuffer::ResizeBuffer(size_t size)
   m_memory = memory;
   m_host_pointer = reinterpret_cast<u8*>(mapped_ptr);
   m_current_size = size;
-  m_current_offset = 0;
-  m_current_gpu_position = 0;
-  m_tracked_fences.clear();
+  m_ring.Reset(size);
   return true;
 }
 
@@ -154,43 +152,11 @@ bool StreamBuffer::ReserveMemory(size_t num_bytes, size_t alignment, bool allow_
     return false;
   }
 
-  // Is the GPU behind or up to date with our current offset?
-  if (m_current_offset >= m_current_gpu_position)
+  // Is there space after the current offset, or behind the GPU?
+  if (m_ring.TryAllocate(num_bytes, alignment, allow_reuse))
   {
-    size_t remaining_bytes = m_current_size - m_current_offset;
-    if (required_bytes <= remaining_bytes)
-    {
-      // Place at the current position, after the GPU position.
-      m_current_offset = Util::AlignBufferOffset(m_current_offset, alignment);
-      m_last_allocation_size = num_bytes;
-      return true;
-    }
-
-    // Check for space at the start of the buffer
-    // We use < here because we don't want to have the case of m_current_offset ==
-    // m_current_gpu_position. That would mean the code above would assume the
-    // GPU has caught up to us, which it hasn't.
-    if (allow_reuse && required_bytes < m_current_gpu_position)
-    {
-      // Reset offset to zero, since we're allocating behind the gpu now
-      m_current_offset = 0;
-      m_last_allocation_size = num_bytes;
-      return true;
-    }
-  }
-
-  // Is the GPU ahead of our current offset?
-  if (m_current_offset < m_current_gpu_position)
-  {
-    // We have from m_current_offset..m_current_gpu_position space to use.
-    size_t remaining_bytes = m_current_gpu_position - m_current_offset;
-    if (required_bytes < remaining_bytes)
-    {
-      // Place at the current position, since this is still behind the GPU.
-      m_current_offset = Util::AlignBufferOffset(m_current_offset, alignment);
-      m_last_allocation_size = num_bytes;
-      return true;
-    }
+    m_last_allocation_size = num_bytes;
+    return true;
   }
 
   // Try to grow the buffer up to the maximum size before waiting.
@@ -207,11 +173,13 @@ bool StreamBuffer::ReserveMemory(size_t num_bytes, size_t alignment, bool allow_
   }
 
   // Can we find a fence to wait on that will give us enough memory?
-  if (allow_reuse && WaitForClearSpace(required_bytes))
+  const auto wait_for_fence = [](VkFence fence) {
+    VkResult res = vkWaitForFences(g_vulkan_context->GetDevice(), 1, &fence, VK_TRUE, UINT64_MAX);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkWaitForFences failed: ");
+  };
+  if (allow_reuse && m_ring.WaitForSpace(num_bytes, alignment, wait_for_fence, [](VkFence) {}))
   {
-    _assert_(m_current_offset == m_current_gpu_position ||
-             (m_current_offset + required_bytes) < m_current_gpu_position);
-    m_current_offset = Util::AlignBufferOffset(m_current_offset, alignment);
     m_last_allocation_size = num_bytes;
     return true;
   }
@@ -232,116 +200,31 @@ bool StreamBuffer::ReserveMemory(size_t num_bytes, size_t alignment, bool allow_
 
 void StreamBuffer::CommitMemory(size_t final_num_bytes)
 {
-  _assert_((m_current_offset + final_num_bytes) <= m_current_size);
+  _assert_((m_ring.GetCurrentOffset() + final_num_bytes) <= m_current_size);
   _assert_(final_num_bytes <= m_last_allocation_size);
 
   // For non-coherent mappings, flush the memory range
   if (!m_coherent_mapping)
   {
     VkMappedMemoryRange range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_memory,
-                                 m_current_offset, final_num_bytes};
+                                 m_ring.GetCurrentOffset(), final_num_bytes};
     vkFlushMappedMemoryRanges(g_vulkan_context->GetDevice(), 1, &range);
   }
 
-  m_current_offset += final_num_bytes;
+  m_ring.Commit(final_num_bytes);
 }
 
 void StreamBuffer::OnCommandBufferQueued(VkCommandBuffer command_buffer, VkFence fence)
 {
-  // Don't create a tracking entry if the GPU is caught up with the buffer.
-  if (m_current_offset == m_current_gpu_position)
-    return;
-
-  // Has the offset changed since the last fence?
-  if (!m_tracked_fences.empty() && m_tracked_fences.back().second == m_current_offset)
-  {
-    // No need to track the new fence, the old one is sufficient.
-    return;
-  }
-
-  m_tracked_fences.emplace_back(fence, m_current_offset);
+  // Only track the fence if anything was written since the last one.
+  if (m_ring.NeedsFence())
+    m_ring.AddFence(fence);
 }
 
 void StreamBuffer::OnCommandBufferExecuted(VkFence fence)
 {
-  // Locate the entry for this fence (if any, we may have been forced to wait already)
-  auto iter = std::find_if(m_tracked_fences.begin(), m_tracked_fences.end(),
-                           [fence](const auto& it) { return it.first == fence; });
-
-  if (iter != m_tracked_fences.end())
-  {
-    // Update the GPU position, and remove any fences before this fence (since
-    // it is implied that they have been signaled as well, though the callback
-    // should have removed them already).
-    m_current_gpu_position = iter->second;
-    m_tracked_fences.erase(m_tracked_fences.begin(), ++iter);
-  }
-}
-
-bool StreamBuffer::WaitForClearSpace(size_t num_bytes)
-{
-  size_t new_offset = 0;
-  size_t new_gpu_position = 0;
-  auto iter = m_tracked_fences.begin();
-  for (; iter != m_tracked_fences.end(); iter++)
-  {
-    // Would this fence bring us in line with the GPU?
-    // This is the "last resort" case, where a command buffer execution has been forced
-    // after no additional data has been written to it, so we can assume that after the
-    // fence has been signaled the entire buffer is now consumed.
-    size_t gpu_position = iter->second;
-    if (m_current_offset == gpu_position)
-    {
-      // Start at the start of the buffer again.
-      new_offset = 0;
-      new_gpu_position = 0;
-      break;
-    }
-
-    // Assuming that we wait for this fence, are we allocating in front of the GPU?
-    if (m_current_offset > gpu_position)
-    {
-      // We can wrap around to the start, behind the GPU, if there is enough space.
-      // We use > here because otherwise we'd end up lining up with the GPU, and then the
-      // allocator would assume that the GPU has consumed what we just wrote.
-      if (gpu_position > num_bytes)
-      {
-        new_offset = 0;
-        new_gpu_position = gpu_position;
-        break;
-      }
-    }
-    else
-    {
-      // We're currently allocating behind the GPU. This would give us between the current
-      // offset and the GPU position worth of space to work with. Again, > because we can't
-      // align the GPU position with the buffer offset.
-      size_t available_space_inbetween = gpu_position - m_current_offset;
-      if (available_space_inbetween > num_bytes)
-      {
-        // Leave the offset as-is, but update the GPU position.
-        new_offset = m_current_offset;
-        new_gpu_position = gpu_position;
-        break;
-      }
-    }
-  }
-
-  // Did any fences satisfy this condition?
-  if (iter == m_tracked_fences.end())
-    return false;
-
-  // Wait until this fence is signaled.
-  VkResult res =
-      vkWaitForFences(g_vulkan_context->GetDevice(), 1, &iter->first, VK_TRUE, UINT64_MAX);
-  if (res != VK_SUCCESS)
-    LOG_VULKAN_ERROR(res, "vkWaitForFences failed: ");
-
-  // Update GPU position, and remove all fences up to (and including) this fence.
-  m_current_offset = new_offset;
-  m_current_gpu_position = new_gpu_position;
-  m_tracked_fences.erase(m_tracked_fences.begin(), ++iter);
-  return true;
+  // We may have been forced to wait for this fence already.
+  m_ring.OnFenceSignaled(fence);
 }
 
 }  // namespace Vulkan
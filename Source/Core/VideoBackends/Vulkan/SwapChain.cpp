@@ -24,8 +24,9 @@
 
 namespace Vulkan
 {
-SwapChain::SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync)
-    : m_native_handle(native_handle), m_surface(surface), m_vsync_enabled(vsync)
+SwapChain::SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync, bool non_blocking)
+    : m_native_handle(native_handle), m_surface(surface), m_vsync_enabled(vsync),
+      m_non_blocking(non_blocking)
 {
 }
 
@@ -127,10 +128,11 @@ VkSurfaceKHR SwapChain::CreateVulkanSurface(VkInstance instance, void* hwnd)
 #endif
 }
 
-std::unique_ptr<SwapChain> SwapChain::Create(void* native_handle, VkSurfaceKHR surface, bool vsync)
+std::unique_ptr<SwapChain> SwapChain::Create(void* native_handle, VkSurfaceKHR surface, bool vsync,
+                                             bool non_blocking)
 {
   std::unique_ptr<SwapChain> swap_chain =
-      std::make_unique<SwapChain>(native_handle, surface, vsync);
+      std::make_unique<SwapChain>(native_handle, surface, vsync, non_blocking);
 
   if (!swap_chain->CreateSwapChain() || !swap_chain->CreateRenderPass() ||
       !swap_chain->SetupSwapChainImages())
@@ -198,6 +200,14 @@ bool SwapChain::SelectPresentMode()
     return it != present_modes.end();
   };
 
+  // Mailbox doesn't tear either, but replaces queued images rather than waiting for them to be
+  // shown, so it's the best fit for vsync without blocking.
+  if (m_vsync_enabled && m_non_blocking && CheckForMode(VK_PRESENT_MODE_MAILBOX_KHR))
+  {
+    m_present_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+    return true;
+  }
+
   // If vsync is enabled, use VK_PRESENT_MODE_FIFO_KHR.
   // This check should not fail with conforming drivers, as the FIFO present mode is mandated by
   // the specification (VK_KHR_swapchain). In case it isn't though, fall through to any other mode.
@@ -441,11 +451,14 @@ void SwapChain::DestroySwapChain()
 
 VkResult SwapChain::AcquireNextImage(VkSemaphore available_semaphore)
 {
-  VkResult res =
-      vkAcquireNextImageKHR(g_vulkan_context->GetDevice(), m_swap_chain, UINT64_MAX,
-                            available_semaphore, VK_NULL_HANDLE, &m_current_swap_chain_image_index);
-  if (res != VK_SUCCESS && res != VK_ERROR_OUT_OF_DATE_KHR && res != VK_SUBOPTIMAL_KHR)
+  VkResult res = vkAcquireNextImageKHR(g_vulkan_context->GetDevice(), m_swap_chain,
+                                       m_non_blocking ? 0 : UINT64_MAX, available_semaphore,
+                                       VK_NULL_HANDLE, &m_current_swap_chain_image_index);
+  if (res != VK_SUCCESS && res != VK_ERROR_OUT_OF_DATE_KHR && res != VK_SUBOPTIMAL_KHR &&
+      res != VK_NOT_READY && res != VK_TIMEOUT)
+  {
     LOG_VULKAN_ERROR(res, "vkAcquireNextImageKHR failed: ");
+  }
 
   return res;
 }
@@ -472,6 +485,15 @@ bool SwapChain::SetVSync(bool enabled)
   return ResizeSwapChain();
 }
 
+bool SwapChain::SetNonBlocking(bool enabled)
+{
+  if (m_non_blocking == enabled)
+    return true;
+
+  m_non_blocking = enabled;
+  return ResizeSwapChain();
+}
+
 bool SwapChain::RecreateSurface(void* native_handle)
 {
   // Destroy the old swap chain, images, and surface.
@@ -19,19 +19,21 @@ class ObjectCache;
 class SwapChain
 {
 public:
-  SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync);
+  SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync, bool non_blocking);
   ~SwapChain();
 
   // Creates a vulkan-renderable surface for the specified window handle.
   static VkSurfaceKHR CreateVulkanSurface(VkInstance instance, void* hwnd);
 
   // Create a new swap chain from a pre-existing surface.
-  static std::unique_ptr<SwapChain> Create(void* native_handle, VkSurfaceKHR surface, bool vsync);
+  static std::unique_ptr<SwapChain> Create(void* native_handle, VkSurfaceKHR surface, bool vsync,
+                                           bool non_blocking);
 
   void* GetNativeHandle() const { return m_native_handle; }
   VkSurfaceKHR GetSurface() const { return m_surface; }
   VkSurfaceFormatKHR GetSurfaceFormat() const { return m_surface_format; }
   bool IsVSyncEnabled() const { return m_vsync_enabled; }
+  bool IsNonBlocking() const { return m_non_blocking; }
   bool IsStereoEnabled() const { return m_layers == 2; }
   VkSwapchainKHR GetSwapChain() const { return m_swap_chain; }
   VkRenderPass GetRenderPass() const { return m_render_pass; }
@@ -51,6 +53,7 @@ public:
     return m_swap_chain_images[m_current_swap_chain_image_index].framebuffer;
   }
 
+  // In non-blocking mode, this returns VK_NOT_READY instead of waiting for an image.
   VkResult AcquireNextImage(VkSemaphore available_semaphore);
 
   bool RecreateSurface(void* native_handle);
@@ -58,6 +61,8 @@ public:
 
   // Change vsync enabled state. This may fail as it causes a swapchain recreation.
   bool SetVSync(bool enabled);
+  // Change whether acquiring an image may wait. This may also recreate the swap chain.
+  bool SetNonBlocking(bool enabled);
 
 private:
   bool SelectSurfaceFormat();
@@ -86,6 +91,7 @@ private:
   VkSurfaceFormatKHR m_surface_format = {};
   VkPresentModeKHR m_present_mode = VK_PRESENT_MODE_RANGE_SIZE_KHR;
   bool m_vsync_enabled;
+  bool m_non_blocking;
 
   VkSwapchainKHR m_swap_chain = VK_NULL_HANDLE;
   std::vector<SwapChainImage> m_swap_chain_images;
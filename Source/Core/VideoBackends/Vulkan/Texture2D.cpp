@@ -13,10 +13,9 @@ namespace Vulkan
 {
 Texture2D::Texture2D(u32 width, u32 height, u32 levels, u32 layers, VkFormat format,
                      VkSampleCountFlagBits samples, VkImageViewType view_type, VkImage image,
-                     VkDeviceMemory device_memory, VkImageView view)
+                     const TextureMemoryAllocator::Allocation& memory, VkImageView view)
     : m_width(width), m_height(height), m_levels(levels), m_layers(layers), m_format(format),
-      m_samples(samples), m_view_type(view_type), m_image(image), m_device_memory(device_memory),
-      m_view(view)
+      m_samples(samples), m_view_type(view_type), m_image(image), m_memory(memory), m_view(view)
 {
 }
 
@@ -25,10 +24,10 @@ Texture2D::~Texture2D()
   g_command_buffer_mgr->DeferImageViewDestruction(m_view);
 
   // If we don't have device memory allocated, the image is not owned by us (e.g. swapchain)
-  if (m_device_memory != VK_NULL_HANDLE)
+  if (m_memory.memory != VK_NULL_HANDLE)
   {
     g_command_buffer_mgr->DeferImageDestruction(m_image);
-    g_command_buffer_mgr->DeferDeviceMemoryDestruction(m_device_memory);
+    g_texture_memory_allocator->DeferFree(m_memory);
   }
 }
 
@@ -61,30 +60,43 @@ std::unique_ptr<Texture2D> Texture2D::Create(u32 width, u32 height, u32 levels,
     return nullptr;
   }
 
-  // Allocate memory to back this texture, we want device local memory in this case
+  // Allocate memory to back this texture, we want device local memory in this case. Linearly tiled
+  // images can't share a block with optimally tiled ones without extra padding, so they get their
+  // own allocation.
   VkMemoryRequirements memory_requirements;
   vkGetImageMemoryRequirements(g_vulkan_context->GetDevice(), image, &memory_requirements);
 
-  VkMemoryAllocateInfo memory_info = {
-      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, memory_requirements.size,
-      g_vulkan_context->GetMemoryType(memory_requirements.memoryTypeBits,
-                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)};
-
-  VkDeviceMemory device_memory;
-  res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &device_memory);
-  if (res != VK_SUCCESS)
+  TextureMemoryAllocator::Allocation memory;
+  if (tiling == VK_IMAGE_TILING_OPTIMAL)
   {
-    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
-    vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
-    return nullptr;
+    if (!g_texture_memory_allocator->Allocate(memory_requirements, &memory))
+    {
+      vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
+      return nullptr;
+    }
+  }
+  else
+  {
+    VkMemoryAllocateInfo memory_info = {
+        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, memory_requirements.size,
+        g_vulkan_context->GetMemoryType(memory_requirements.memoryTypeBits,
+                                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)};
+
+    res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &memory.memory);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+      vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
+      return nullptr;
+    }
   }
 
-  res = vkBindImageMemory(g_vulkan_context->GetDevice(), image, device_memory, 0);
+  res = vkBindImageMemory(g_vulkan_context->GetDevice(), image, memory.memory, memory.offset);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkBindImageMemory failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), device_memory, nullptr);
+    g_texture_memory_allocator->DeferFree(memory);
     return nullptr;
   }
 
@@ -107,12 +119,12 @@ std::unique_ptr<Texture2D> Texture2D::Create(u32 width, u32 height, u32 levels,
   {
     LOG_VULKAN_ERROR(res, "vkCreateImageView failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), device_memory, nullptr);
+    g_texture_memory_allocator->DeferFree(memory);
     return nullptr;
   }
 
   return std::make_unique<Texture2D>(width, height, levels, layers, format, samples, view_type,
-                                     image, device_memory, view);
+                                     image, memory, view);
 }
 
 std::unique_ptr<Texture2D> Texture2D::CreateFromExistingImage(u32 width, u32 height, u32 levels,
@@ -136,7 +148,7 @@ std::unique_ptr<Texture2D> Texture2D::CreateFromExistingImage(u32 width, u32 hei
        0, levels, 0, layers}};
 
   // Memory is managed by the owner of the image.
-  VkDeviceMemory memory = VK_NULL_HANDLE;
+  TextureMemoryAllocator::Allocation memory;
   VkImageView view = VK_NULL_HANDLE;
   VkResult res = vkCreateImageView(g_vulkan_context->GetDevice(), &view_info, nullptr, &view);
   if (res != VK_SUCCESS)
@@ -8,6 +8,7 @@
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
+#include "VideoBackends/Vulkan/TextureMemoryAllocator.h"
 
 namespace Vulkan
 {
@@ -28,7 +29,7 @@ public:
 
   Texture2D(u32 width, u32 height, u32 levels, u32 layers, VkFormat format,
             VkSampleCountFlagBits samples, VkImageViewType view_type, VkImage image,
-            VkDeviceMemory device_memory, VkImageView view);
+            const TextureMemoryAllocator::Allocation& memory, VkImageView view);
   ~Texture2D();
 
   static std::unique_ptr<Texture2D> Create(u32 width, u32 height, u32 levels, u32 layers,
@@ -51,7 +52,7 @@ public:
   VkImageLayout GetLayout() const { return m_layout; }
   VkImageViewType GetViewType() const { return m_view_type; }
   VkImage GetImage() const { return m_image; }
-  VkDeviceMemory GetDeviceMemory() const { return m_device_memory; }
+  VkDeviceMemory GetDeviceMemory() const { return m_memory.memory; }
   VkImageView GetView() const { return m_view; }
   // Used when the render pass is changing the image layout, or to force it to
   // VK_IMAGE_LAYOUT_UNDEFINED, if the existing contents of the image is
@@ -73,7 +74,7 @@ private:
   ComputeImageLayout m_compute_layout = ComputeImageLayout::Undefined;
 
   VkImage m_image;
-  VkDeviceMemory m_device_memory;
+  TextureMemoryAllocator::Allocation m_memory;
   VkImageView m_view;
 };
 }
@@ -6,9 +6,11 @@
 
 #include <algorithm>
 #include <cstring>
+#include <functional>
 #include <string>
 #include <vector>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/Logging/Log.h"
@@ -18,6 +20,7 @@
 #include "VideoBackends/Vulkan/FramebufferManager.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/Renderer.h"
+#include "VideoBackends/Vulkan/StagingBuffer.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
 #include "VideoBackends/Vulkan/Texture2D.h"
@@ -33,10 +36,18 @@ namespace Vulkan
 {
 TextureCache::TextureCache()
 {
+  g_command_buffer_mgr->AddFencePointCallback(
+      this, [](VkCommandBuffer, VkFence) {},
+      std::bind(&TextureCache::OnCommandBufferExecuted, this, std::placeholders::_1));
 }
 
 TextureCache::~TextureCache()
 {
+  g_command_buffer_mgr->RemoveFencePointCallback(this);
+
+  // The pending copies use the staging textures of the texture converter.
+  FlushEFBCopies();
+
   if (m_render_pass != VK_NULL_HANDLE)
     vkDestroyRenderPass(g_vulkan_context->GetDevice(), m_render_pass, nullptr);
   TextureCache::DeleteShaders();
@@ -57,6 +68,66 @@ StreamBuffer* TextureCache::GetTextureUploadBuffer() const
   return m_texture_upload_buffer.get();
 }
 
+StagingBuffer* TextureCache::AllocateUploadStagingBuffer(VkDeviceSize num_bytes)
+{
+  // Use the smallest idle buffer which is large enough.
+  UploadStagingBuffer* best = nullptr;
+  for (UploadStagingBuffer& it : m_upload_staging_buffers)
+  {
+    if (it.pending_fence == VK_NULL_HANDLE && it.buffer->GetSize() >= num_bytes &&
+        (!best || it.buffer->GetSize() < best->buffer->GetSize()))
+    {
+      best = &it;
+    }
+  }
+
+  if (!best)
+  {
+    VkDeviceSize size = Common::AlignUp(num_bytes, TEXTURE_UPLOAD_STAGING_BUFFER_GRANULARITY);
+    std::unique_ptr<StagingBuffer> buffer =
+        StagingBuffer::Create(STAGING_BUFFER_TYPE_UPLOAD, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    if (!buffer || !buffer->Map())
+      return nullptr;
+
+    m_upload_staging_buffers.push_back({std::move(buffer), VK_NULL_HANDLE});
+    best = &m_upload_staging_buffers.back();
+  }
+
+  best->pending_fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+  return best->buffer.get();
+}
+
+void TextureCache::OnCommandBufferExecuted(VkFence fence)
+{
+  VkDeviceSize pool_size = 0;
+  for (UploadStagingBuffer& it : m_upload_staging_buffers)
+  {
+    if (it.pending_fence == fence)
+      it.pending_fence = VK_NULL_HANDLE;
+    pool_size += it.buffer->GetSize();
+  }
+
+  // Release idle buffers while the pool is over budget, the largest ones first.
+  while (pool_size > MAXIMUM_TEXTURE_UPLOAD_STAGING_POOL_SIZE)
+  {
+    auto iter = m_upload_staging_buffers.end();
+    for (auto it = m_upload_staging_buffers.begin(); it != m_upload_staging_buffers.end(); ++it)
+    {
+      if (it->pending_fence == VK_NULL_HANDLE &&
+          (iter == m_upload_staging_buffers.end() ||
+           it->buffer->GetSize() > iter->buffer->GetSize()))
+      {
+        iter = it;
+      }
+    }
+    if (iter == m_upload_staging_buffers.end())
+      break;
+
+    pool_size -= iter->buffer->GetSize();
+    m_upload_staging_buffers.erase(iter);
+  }
+}
+
 TextureCache* TextureCache::GetInstance()
 {
   return static_cast<TextureCache*>(g_texture_cache.get());
@@ -114,6 +185,36 @@ void TextureCache::ConvertTexture(TCacheEntry* destination, TCacheEntry* source,
 void TextureCache::CopyEFB(u8* dst, const EFBCopyParams& params, u32 native_width,
                            u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
                            const EFBRectangle& src_rect, bool scale_by_half)
+{
+  VkImageLayout original_layout;
+  Texture2D* src_texture = PrepareEFBCopySource(params.depth, src_rect, &original_layout);
+
+  m_texture_converter->EncodeTextureToMemory(src_texture->GetView(), dst, params, native_width,
+                                             bytes_per_row, num_blocks_y, memory_stride, src_rect,
+                                             scale_by_half);
+
+  // Transition back to original state
+  src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), original_layout);
+}
+
+std::unique_ptr<TextureCacheBase::PendingEFBCopy>
+TextureCache::CopyEFBDeferred(u8* dst, const EFBCopyParams& params, u32 native_width,
+                              u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+                              const EFBRectangle& src_rect, bool scale_by_half)
+{
+  VkImageLayout original_layout;
+  Texture2D* src_texture = PrepareEFBCopySource(params.depth, src_rect, &original_layout);
+
+  std::unique_ptr<PendingEFBCopy> copy = m_texture_converter->EncodeTextureToMemoryDeferred(
+      src_texture->GetView(), dst, params, native_width, bytes_per_row, num_blocks_y, memory_stride,
+      src_rect, scale_by_half);
+
+  src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), original_layout);
+  return copy;
+}
+
+Texture2D* TextureCache::PrepareEFBCopySource(bool depth, const EFBRectangle& src_rect,
+                                              VkImageLayout* original_layout)
 {
   // Flush EFB pokes first, as they're expected to be included.
   FramebufferManager::GetInstance()->FlushEFBPokes();
@@ -128,7 +229,7 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyParams& params, u32 native_widt
   region = Util::ClampRect2D(region, FramebufferManager::GetInstance()->GetEFBWidth(),
                              FramebufferManager::GetInstance()->GetEFBHeight());
   Texture2D* src_texture;
-  if (params.depth)
+  if (depth)
     src_texture = FramebufferManager::GetInstance()->ResolveEFBDepthTexture(region);
   else
     src_texture = FramebufferManager::GetInstance()->ResolveEFBColorTexture(region);
@@ -140,16 +241,10 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyParams& params, u32 native_widt
   StateTracker::GetInstance()->OnReadback();
 
   // Transition to shader resource before reading.
-  VkImageLayout original_layout = src_texture->GetLayout();
+  *original_layout = src_texture->GetLayout();
   src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-  m_texture_converter->EncodeTextureToMemory(src_texture->GetView(), dst, params, native_width,
-                                             bytes_per_row, num_blocks_y, memory_stride, src_rect,
-                                             scale_by_half);
-
-  // Transition back to original state
-  src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), original_layout);
+  return src_texture;
 }
 
 bool TextureCache::SupportsGPUTextureDecode(TextureFormat format, TLUTFormat palette_format)
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
@@ -12,6 +13,7 @@
 
 namespace Vulkan
 {
+class StagingBuffer;
 class TextureConverter;
 class StateTracker;
 class Texture2D;
@@ -40,6 +42,12 @@ public:
                u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
                bool scale_by_half) override;
 
+  std::unique_ptr<PendingEFBCopy> CopyEFBDeferred(u8* dst, const EFBCopyParams& params,
+                                                  u32 native_width, u32 bytes_per_row,
+                                                  u32 num_blocks_y, u32 memory_stride,
+                                                  const EFBRectangle& src_rect,
+                                                  bool scale_by_half) override;
+
   bool SupportsGPUTextureDecode(TextureFormat format, TLUTFormat palette_format) override;
 
   void DecodeTextureOnGPU(TCacheEntry* entry, u32 dst_level, const u8* data, size_t data_size,
@@ -51,15 +59,34 @@ public:
   VkRenderPass GetTextureCopyRenderPass() const;
   StreamBuffer* GetTextureUploadBuffer() const;
 
+  // Returns a mapped staging buffer of at least num_bytes bytes for texture data which doesn't fit
+  // into the upload buffer. The buffer is only used for the current command buffer, and can be
+  // handed out again once it has been executed.
+  StagingBuffer* AllocateUploadStagingBuffer(VkDeviceSize num_bytes);
+
 private:
+  struct UploadStagingBuffer
+  {
+    std::unique_ptr<StagingBuffer> buffer;
+    VkFence pending_fence;
+  };
+
   bool CreateRenderPasses();
 
+  void OnCommandBufferExecuted(VkFence fence);
+
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
                            bool scale_by_half, unsigned int cbuf_id, const float* colmat) override;
 
+  // Resolves the EFB and transitions it to be read by the encoding shader. Returns the texture to
+  // read from, and the layout it has to be transitioned back to afterwards.
+  Texture2D* PrepareEFBCopySource(bool depth, const EFBRectangle& src_rect,
+                                  VkImageLayout* original_layout);
+
   VkRenderPass m_render_pass = VK_NULL_HANDLE;
 
   std::unique_ptr<StreamBuffer> m_texture_upload_buffer;
+  std::vector<UploadStagingBuffer> m_upload_staging_buffers;
 
   std::unique_ptr<TextureConverter> m_texture_converter;
 
@@ -7,7 +7,9 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
@@ -218,17 +220,122 @@ void TextureConverter::ConvertTexture(TextureCacheBase::TCacheEntry* dst_entry,
   draw.EndRenderPass();
 }
 
+class TextureConverter::PendingEncode final : public TextureCacheBase::PendingEFBCopy
+{
+public:
+  PendingEncode(TextureConverter* converter, std::unique_ptr<StagingTexture2D> texture,
+                VkFence fence, u8* dest_ptr, u32 width, u32 height, u32 memory_stride)
+      : m_converter(converter), m_texture(std::move(texture)), m_fence(fence),
+        m_dest_ptr(dest_ptr), m_width(width), m_height(height), m_memory_stride(memory_stride)
+  {
+  }
+
+  ~PendingEncode() override
+  {
+    m_converter->m_deferred_download_textures.push_back(std::move(m_texture));
+  }
+
+  void Flush() override
+  {
+    // The copy may still be sitting in the command buffer which is being recorded.
+    if (m_fence == g_command_buffer_mgr->GetCurrentCommandBufferFence())
+      Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+    else
+      g_command_buffer_mgr->WaitForFence(m_fence);
+
+    // The cache was invalidated when the copy was recorded, which is too early if the memory
+    // isn't coherent.
+    m_texture->InvalidateCPUCache();
+    m_texture->ReadTexels(0, 0, m_width, m_height, m_dest_ptr, m_memory_stride);
+  }
+
+private:
+  TextureConverter* m_converter;
+  std::unique_ptr<StagingTexture2D> m_texture;
+  VkFence m_fence;
+  u8* m_dest_ptr;
+  u32 m_width;
+  u32 m_height;
+  u32 m_memory_stride;
+};
+
 void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_ptr,
                                              const EFBCopyParams& params, u32 native_width,
                                              u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
                                              const EFBRectangle& src_rect, bool scale_by_half)
+{
+  u32 render_width = bytes_per_row / sizeof(u32);
+  u32 render_height = num_blocks_y;
+  if (!EncodeToRenderTexture(src_texture, params, native_width, render_width, render_height,
+                             src_rect, scale_by_half))
+  {
+    return;
+  }
+
+  m_encoding_download_texture->CopyFromImage(
+      g_command_buffer_mgr->GetCurrentCommandBuffer(), m_encoding_render_texture->GetImage(),
+      VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, render_width, render_height, 0, 0);
+
+  // Block until the GPU has finished copying to the staging texture.
+  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+
+  // Copy from staging texture to the final destination, adjusting pitch if necessary.
+  m_encoding_download_texture->ReadTexels(0, 0, render_width, render_height, dest_ptr,
+                                          memory_stride);
+}
+
+std::unique_ptr<TextureCacheBase::PendingEFBCopy> TextureConverter::EncodeTextureToMemoryDeferred(
+    VkImageView src_texture, u8* dest_ptr, const EFBCopyParams& params, u32 native_width,
+    u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
+    bool scale_by_half)
+{
+  u32 render_width = bytes_per_row / sizeof(u32);
+  u32 render_height = num_blocks_y;
+  if (render_width > ENCODING_TEXTURE_WIDTH || render_height > DEFERRED_DOWNLOAD_TEXTURE_HEIGHT)
+    return nullptr;
+
+  std::unique_ptr<StagingTexture2D> download_texture;
+  if (!m_deferred_download_textures.empty())
+  {
+    download_texture = std::move(m_deferred_download_textures.back());
+    m_deferred_download_textures.pop_back();
+  }
+  else
+  {
+    download_texture =
+        StagingTexture2D::Create(STAGING_BUFFER_TYPE_READBACK, ENCODING_TEXTURE_WIDTH,
+                                 DEFERRED_DOWNLOAD_TEXTURE_HEIGHT, ENCODING_TEXTURE_FORMAT);
+    if (!download_texture || !download_texture->Map())
+      return nullptr;
+  }
+
+  if (!EncodeToRenderTexture(src_texture, params, native_width, render_width, render_height,
+                             src_rect, scale_by_half))
+  {
+    m_deferred_download_textures.push_back(std::move(download_texture));
+    return nullptr;
+  }
+
+  download_texture->CopyFromImage(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                                  m_encoding_render_texture->GetImage(), VK_IMAGE_ASPECT_COLOR_BIT,
+                                  0, 0, render_width, render_height, 0, 0);
+
+  return std::make_unique<PendingEncode>(this, std::move(download_texture),
+                                         g_command_buffer_mgr->GetCurrentCommandBufferFence(),
+                                         dest_ptr, render_width, render_height, memory_stride);
+}
+
+bool TextureConverter::EncodeToRenderTexture(VkImageView src_texture, const EFBCopyParams& params,
+                                             u32 native_width, u32 render_width,
+                                             u32 render_height, const EFBRectangle& src_rect,
+                                             bool scale_by_half)
 {
   VkShaderModule shader = GetEncodingShader(params);
   if (shader == VK_NULL_HANDLE)
   {
     ERROR_LOG(VIDEO, "Missing encoding fragment shader for format %u->%u",
               static_cast<unsigned>(params.efb_format), static_cast<unsigned>(params.copy_format));
-    return;
+    return false;
   }
 
   // Can't do our own draw within a render pass.
@@ -254,8 +361,6 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
   draw.SetPSSampler(0, src_texture, linear_filter ? g_object_cache->GetLinearSampler() :
                                                     g_object_cache->GetPointSampler());
 
-  u32 render_width = bytes_per_row / sizeof(u32);
-  u32 render_height = num_blocks_y;
   Util::SetViewportAndScissor(g_command_buffer_mgr->GetCurrentCommandBuffer(), 0, 0, render_width,
                               render_height);
 
@@ -267,16 +372,7 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
   // Transition the image before copying
   m_encoding_render_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-  m_encoding_download_texture->CopyFromImage(
-      g_command_buffer_mgr->GetCurrentCommandBuffer(), m_encoding_render_texture->GetImage(),
-      VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, render_width, render_height, 0, 0);
-
-  // Block until the GPU has finished copying to the staging texture.
-  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
-
-  // Copy from staging texture to the final destination, adjusting pitch if necessary.
-  m_encoding_download_texture->ReadTexels(0, 0, render_width, render_height, dest_ptr,
-                                          memory_stride);
+  return true;
 }
 
 void TextureConverter::EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride,
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
@@ -41,6 +42,14 @@ public:
                              u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
                              u32 memory_stride, const EFBRectangle& src_rect, bool scale_by_half);
 
+  // Like EncodeTextureToMemory, but doesn't execute the command buffer. The copy only reaches
+  // dest_ptr once the returned object is flushed. Returns nullptr if it can't be deferred.
+  std::unique_ptr<TextureCacheBase::PendingEFBCopy>
+  EncodeTextureToMemoryDeferred(VkImageView src_texture, u8* dest_ptr, const EFBCopyParams& params,
+                                u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
+                                u32 memory_stride, const EFBRectangle& src_rect,
+                                bool scale_by_half);
+
   // Encodes texture to guest memory in XFB (YUYV) format.
   void EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride, u32 dst_height,
                                  Texture2D* src_texture, const MathUtil::Rectangle<int>& src_rect);
@@ -59,6 +68,11 @@ private:
   static const u32 ENCODING_TEXTURE_WIDTH = EFB_WIDTH * 4;
   static const u32 ENCODING_TEXTURE_HEIGHT = 1024;
   static const VkFormat ENCODING_TEXTURE_FORMAT = VK_FORMAT_B8G8R8A8_UNORM;
+
+  // EFB copies are at most a quarter of the EFB height in blocks, XFB copies aren't deferred.
+  static const u32 DEFERRED_DOWNLOAD_TEXTURE_HEIGHT = EFB_HEIGHT / 4;
+
+  class PendingEncode;
   static const size_t NUM_PALETTE_CONVERSION_SHADERS = 3;
 
   // Maximum size of a texture based on BP registers.
@@ -77,6 +91,11 @@ private:
   bool CreateEncodingTexture();
   bool CreateEncodingDownloadTexture();
 
+  // Draws the encoded copy to the encoding texture, and transitions it so it can be copied from.
+  bool EncodeToRenderTexture(VkImageView src_texture, const EFBCopyParams& params,
+                             u32 native_width, u32 render_width, u32 render_height,
+                             const EFBRectangle& src_rect, bool scale_by_half);
+
   bool CreateDecodingTexture();
 
   bool CompileYUYVConversionShaders();
@@ -109,6 +128,8 @@ private:
   std::unique_ptr<Texture2D> m_encoding_render_texture;
   VkFramebuffer m_encoding_render_framebuffer = VK_NULL_HANDLE;
   std::unique_ptr<StagingTexture2D> m_encoding_download_texture;
+  // Staging textures for deferred EFB copies which aren't in use.
+  std::vector<std::unique_ptr<StagingTexture2D>> m_deferred_download_textures;
 
   // Texture decoding - GX format in memory->RGBA8
   struct TextureDecodingPipeline
@@ -0,0 +1,157 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/Vulkan/TextureMemoryAllocator.h"
+
+#include <algorithm>
+
+#include "Common/Assert.h"
+#include "Common/MsgHandler.h"
+
+#include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
+
+#include "VideoCommon/Statistics.h"
+
+namespace Vulkan
+{
+// Images taking more than this have their own allocation.
+constexpr VkDeviceSize MAX_SUB_ALLOCATION_SIZE = 256 * 1024;
+constexpr VkDeviceSize MIN_SLOT_SIZE = 4 * 1024;
+constexpr VkDeviceSize BLOCK_SIZE = 4 * 1024 * 1024;
+
+struct TextureMemoryAllocator::Block
+{
+  VkDeviceMemory memory;
+  u32 memory_type;
+  VkDeviceSize slot_size;
+  u32 num_slots;
+  std::vector<u32> free_slots;
+};
+
+TextureMemoryAllocator::TextureMemoryAllocator() = default;
+
+TextureMemoryAllocator::~TextureMemoryAllocator()
+{
+  for (const auto& block : m_blocks)
+  {
+    _assert_msg_(VIDEO, block->free_slots.size() == block->num_slots,
+                 "Texture memory is still in use");
+    vkFreeMemory(g_vulkan_context->GetDevice(), block->memory, nullptr);
+  }
+}
+
+static VkDeviceSize GetSlotSize(const VkMemoryRequirements& requirements)
+{
+  // Slots are aligned to their size, so power-of-two alignments up to it are met as well.
+  VkDeviceSize slot_size = MIN_SLOT_SIZE;
+  while (slot_size < requirements.size || slot_size < requirements.alignment)
+    slot_size *= 2;
+  return slot_size;
+}
+
+bool TextureMemoryAllocator::Allocate(const VkMemoryRequirements& requirements,
+                                      Allocation* out_allocation)
+{
+  u32 memory_type;
+  if (!g_vulkan_context->GetMemoryType(requirements.memoryTypeBits,
+                                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &memory_type))
+  {
+    PanicAlert("Unable to find memory type for %x", requirements.memoryTypeBits);
+    return false;
+  }
+
+  const VkDeviceSize slot_size = GetSlotSize(requirements);
+  if (slot_size > MAX_SUB_ALLOCATION_SIZE)
+  {
+    VkMemoryAllocateInfo memory_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr,
+                                        requirements.size, memory_type};
+    VkDeviceMemory memory;
+    VkResult res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &memory);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+      return false;
+    }
+
+    INCSTAT(stats.thisFrame.numTextureMemoryAllocations);
+    *out_allocation = {memory, 0, nullptr};
+    return true;
+  }
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto iter = std::find_if(m_blocks.begin(), m_blocks.end(), [&](const auto& block) {
+    return block->memory_type == memory_type && block->slot_size == slot_size &&
+           !block->free_slots.empty();
+  });
+  if (iter == m_blocks.end())
+  {
+    VkMemoryAllocateInfo memory_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr,
+                                        BLOCK_SIZE, memory_type};
+    VkDeviceMemory memory;
+    VkResult res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &memory);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+      return false;
+    }
+
+    auto block = std::make_unique<Block>();
+    block->memory = memory;
+    block->memory_type = memory_type;
+    block->slot_size = slot_size;
+    block->num_slots = static_cast<u32>(BLOCK_SIZE / slot_size);
+    // Hand out the slots from the start of the block first.
+    for (u32 i = block->num_slots; i > 0; i--)
+      block->free_slots.push_back(i - 1);
+
+    INCSTAT(stats.thisFrame.numTextureMemoryAllocations);
+    iter = m_blocks.insert(m_blocks.end(), std::move(block));
+  }
+
+  Block* block = iter->get();
+  const u32 slot = block->free_slots.back();
+  block->free_slots.pop_back();
+
+  INCSTAT(stats.thisFrame.numTextureSubAllocations);
+  *out_allocation = {block->memory, slot * slot_size, block};
+  return true;
+}
+
+void TextureMemoryAllocator::DeferFree(const Allocation& allocation)
+{
+  if (!allocation.block)
+  {
+    g_command_buffer_mgr->DeferDeviceMemoryDestruction(allocation.memory);
+    return;
+  }
+
+  g_command_buffer_mgr->DeferCleanup([this, allocation]() { Free(allocation); });
+}
+
+void TextureMemoryAllocator::Free(const Allocation& allocation)
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  Block* block = allocation.block;
+  block->free_slots.push_back(static_cast<u32>(allocation.offset / block->slot_size));
+  if (block->free_slots.size() != block->num_slots)
+    return;
+
+  // Keep one empty block of each size class around, so that creating and destroying a single
+  // texture over and over doesn't allocate and free a whole block each time.
+  const bool has_other_blocks =
+      std::any_of(m_blocks.begin(), m_blocks.end(), [block](const auto& other) {
+        return other.get() != block && other->memory_type == block->memory_type &&
+               other->slot_size == block->slot_size;
+      });
+  if (!has_other_blocks)
+    return;
+
+  vkFreeMemory(g_vulkan_context->GetDevice(), block->memory, nullptr);
+  m_blocks.erase(std::find_if(m_blocks.begin(), m_blocks.end(),
+                              [block](const auto& other) { return other.get() == block; }));
+}
+
+std::unique_ptr<TextureMemoryAllocator> g_texture_memory_allocator;
+}
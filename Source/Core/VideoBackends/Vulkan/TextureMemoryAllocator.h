@@ -0,0 +1,49 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Vulkan/Constants.h"
+
+namespace Vulkan
+{
+// Allocates the device memory backing textures. Small textures are common and are created and
+// destroyed often, so rather than giving each of them its own allocation, they share large blocks
+// which are split into slots of power-of-two size classes.
+class TextureMemoryAllocator
+{
+public:
+  struct Block;
+
+  struct Allocation
+  {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    // The block the memory was sub-allocated from, or nullptr if it has its own allocation.
+    Block* block = nullptr;
+  };
+
+  TextureMemoryAllocator();
+  ~TextureMemoryAllocator();
+
+  // Allocates device local memory meeting the requirements of an optimally tiled image.
+  bool Allocate(const VkMemoryRequirements& requirements, Allocation* out_allocation);
+
+  // Frees the memory once the GPU has finished with the current command buffer.
+  void DeferFree(const Allocation& allocation);
+
+private:
+  void Free(const Allocation& allocation);
+
+  std::vector<std::unique_ptr<Block>> m_blocks;
+  std::mutex m_mutex;
+};
+
+extern std::unique_ptr<TextureMemoryAllocator> g_texture_memory_allocator;
+}
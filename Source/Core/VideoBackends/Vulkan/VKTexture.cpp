@@ -23,6 +23,7 @@
 
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/TextureConfig.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace Vulkan
 {
@@ -156,15 +157,14 @@ bool VKTexture::Save(const std::string& filename, unsigned int level)
     return false;
   }
 
-  // Write texture out to file.
-  // It's okay to throw this texture away immediately, since we're done with it, and
-  // we blocked until the copy completed on the GPU anyway.
-  bool result = TextureToPng(reinterpret_cast<u8*>(staging_texture->GetMapPointer()),
-                             static_cast<u32>(staging_texture->GetRowStride()), filename,
-                             level_width, level_height);
+  // Write texture out to file. The image is copied out before encoding, so it's okay to throw
+  // this texture away immediately, since we blocked until the copy completed on the GPU anyway.
+  TextureToPngAsync(reinterpret_cast<u8*>(staging_texture->GetMapPointer()),
+                    static_cast<int>(staging_texture->GetRowStride()), filename, level_width,
+                    level_height, true, g_ActiveConfig.iPNGCompressionLevel);
 
   staging_texture->Unmap();
-  return result;
+  return true;
 }
 
 void VKTexture::CopyTextureRectangle(const MathUtil::Rectangle<int>& dst_rect,
@@ -297,25 +297,16 @@ void VKTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   u32 num_rows = Common::AlignUp(height, block_size) / block_size;
   size_t source_pitch = CalculateHostTextureLevelPitch(m_config.format, row_length);
   size_t upload_size = source_pitch * num_rows;
-  std::unique_ptr<StagingBuffer> temp_buffer;
   VkBuffer upload_buffer;
   VkDeviceSize upload_buffer_offset;
 
-  // Does this texture data fit within the streaming buffer?
+  // Does this texture data fit within the streaming buffer? If the buffer is full, a pooled
+  // staging buffer is used instead of executing the command buffer and waiting for space.
+  StreamBuffer* stream_buffer = TextureCache::GetInstance()->GetTextureUploadBuffer();
   if (upload_size <= STAGING_TEXTURE_UPLOAD_THRESHOLD &&
-      upload_size <= MAXIMUM_TEXTURE_UPLOAD_BUFFER_SIZE)
+      upload_size <= MAXIMUM_TEXTURE_UPLOAD_BUFFER_SIZE &&
+      stream_buffer->ReserveMemory(upload_size, upload_alignment))
   {
-    StreamBuffer* stream_buffer = TextureCache::GetInstance()->GetTextureUploadBuffer();
-    if (!stream_buffer->ReserveMemory(upload_size, upload_alignment))
-    {
-      // Execute the command buffer first.
-      WARN_LOG(VIDEO, "Executing command list while waiting for space in texture upload buffer");
-      Util::ExecuteCurrentCommandsAndRestoreState(false);
-
-      // Try allocating again. This may cause a fence wait.
-      if (!stream_buffer->ReserveMemory(upload_size, upload_alignment))
-        PanicAlert("Failed to allocate space in texture upload buffer");
-    }
     // Copy to the streaming buffer.
     upload_buffer = stream_buffer->GetBuffer();
     upload_buffer_offset = stream_buffer->GetCurrentOffset();
@@ -324,19 +315,18 @@ void VKTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   }
   else
   {
-    // Create a temporary staging buffer that is destroyed after the image is copied.
-    temp_buffer = StagingBuffer::Create(STAGING_BUFFER_TYPE_UPLOAD, upload_size,
-                                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-    if (!temp_buffer || !temp_buffer->Map())
+    // Use a staging buffer which is reused once the image has been copied.
+    StagingBuffer* staging_buffer =
+        TextureCache::GetInstance()->AllocateUploadStagingBuffer(upload_size);
+    if (!staging_buffer)
     {
       PanicAlert("Failed to allocate staging texture for large texture upload.");
       return;
     }
 
-    upload_buffer = temp_buffer->GetBuffer();
+    upload_buffer = staging_buffer->GetBuffer();
     upload_buffer_offset = 0;
-    temp_buffer->Write(0, buffer, upload_size, true);
-    temp_buffer->Unmap();
+    staging_buffer->Write(0, buffer, upload_size, true);
   }
 
   // Copy from the streaming buffer to the actual image.
@@ -9,7 +9,6 @@
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Vulkan/BoundingBox.h"
-#include "VideoBackends/Vulkan/CommandBufferManager.h"
 #include "VideoBackends/Vulkan/FramebufferManager.h"
 #include "VideoBackends/Vulkan/Renderer.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
@@ -20,6 +19,7 @@
 
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -162,7 +162,10 @@ void VertexManager::vFlush()
   }
 
   // Check for any shader stage changes
-  StateTracker::GetInstance()->CheckForShaderChanges(m_current_primitive_type);
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderCompileWait);
+    StateTracker::GetInstance()->CheckForShaderChanges(m_current_primitive_type);
+  }
 
   // Update any changed constants
   StateTracker::GetInstance()->UpdateVertexShaderConstants();
@@ -176,7 +179,8 @@ void VertexManager::vFlush()
   PrepareDrawBuffers(vertex_stride);
 
   // Flush all EFB pokes and invalidate the peek cache.
-  FramebufferManager::GetInstance()->InvalidatePeekCache();
+  if (!g_ActiveConfig.bEFBAccessDeferInvalidation)
+    FramebufferManager::GetInstance()->InvalidatePeekCache();
   FramebufferManager::GetInstance()->FlushEFBPokes();
 
   // If bounding box is enabled, we need to flush any changes first, then invalidate what we have.
@@ -202,8 +206,18 @@ void VertexManager::vFlush()
   }
 
   // Execute the draw
-  vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), index_count, 1,
-                   m_current_draw_base_index, m_current_draw_base_vertex, 0);
+  StateTracker::GetInstance()->DrawIndexed(index_count, m_current_draw_base_index,
+                                           m_current_draw_base_vertex);
+
+  INCSTAT(stats.thisFrame.numDrawCalls);
+  if (StateTracker::GetInstance()->IsUsingUberShaders())
+  {
+    INCSTAT(stats.thisFrame.numUberShaderDraws);
+  }
+  else
+  {
+    INCSTAT(stats.thisFrame.numSpecializedShaderDraws);
+  }
 
   StateTracker::GetInstance()->OnDraw();
 }
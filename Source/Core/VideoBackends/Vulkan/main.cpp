@@ -16,6 +16,7 @@
 #include "VideoBackends/Vulkan/StateTracker.h"
 #include "VideoBackends/Vulkan/SwapChain.h"
 #include "VideoBackends/Vulkan/TextureCache.h"
+#include "VideoBackends/Vulkan/TextureMemoryAllocator.h"
 #include "VideoBackends/Vulkan/VertexManager.h"
 #include "VideoBackends/Vulkan/VideoBackend.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
@@ -190,7 +191,8 @@ bool VideoBackend::Initialize(void* window_handle)
   std::unique_ptr<SwapChain> swap_chain;
   if (surface != VK_NULL_HANDLE)
   {
-    swap_chain = SwapChain::Create(window_handle, surface, g_Config.IsVSync());
+    swap_chain =
+        SwapChain::Create(window_handle, surface, g_Config.IsVSync(), g_Config.bNonBlockingPresent);
     if (!swap_chain)
     {
       PanicAlert("Failed to create Vulkan swap chain.");
@@ -201,12 +203,15 @@ bool VideoBackend::Initialize(void* window_handle)
     }
   }
 
+  g_texture_memory_allocator = std::make_unique<TextureMemoryAllocator>();
+
   // Create command buffers. We do this separately because the other classes depend on it.
   g_command_buffer_mgr = std::make_unique<CommandBufferManager>(g_Config.bBackendMultithreading);
   if (!g_command_buffer_mgr->Initialize())
   {
     PanicAlert("Failed to create Vulkan command buffers");
     g_command_buffer_mgr.reset();
+    g_texture_memory_allocator.reset();
     g_vulkan_context.reset();
     ShutdownShared();
     UnloadVulkanLibrary();
@@ -233,6 +238,7 @@ bool VideoBackend::Initialize(void* window_handle)
     g_shader_cache.reset();
     g_object_cache.reset();
     g_command_buffer_mgr.reset();
+    g_texture_memory_allocator.reset();
     g_vulkan_context.reset();
     ShutdownShared();
     UnloadVulkanLibrary();
@@ -257,6 +263,7 @@ bool VideoBackend::Initialize(void* window_handle)
     g_shader_cache.reset();
     g_object_cache.reset();
     g_command_buffer_mgr.reset();
+    g_texture_memory_allocator.reset();
     g_vulkan_context.reset();
     ShutdownShared();
     UnloadVulkanLibrary();
@@ -292,6 +299,7 @@ void VideoBackend::Shutdown()
   g_shader_cache.reset();
   g_object_cache.reset();
   g_command_buffer_mgr.reset();
+  g_texture_memory_allocator.reset();
   g_vulkan_context.reset();
 
   UnloadVulkanLibrary();
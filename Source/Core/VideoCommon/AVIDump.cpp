@@ -63,6 +63,25 @@ static void InitAVCodec()
   }
 }
 
+// Hardware encoders may not take YUV420P frames, but those that can read frames from system memory
+// take NV12 instead.
+static AVPixelFormat GetEncoderPixelFormat(const AVCodec* codec)
+{
+  if (!codec->pix_fmts)
+    return AV_PIX_FMT_YUV420P;
+
+  bool supports_nv12 = false;
+  for (const AVPixelFormat* fmt = codec->pix_fmts; *fmt != AV_PIX_FMT_NONE; ++fmt)
+  {
+    if (*fmt == AV_PIX_FMT_YUV420P)
+      return AV_PIX_FMT_YUV420P;
+    if (*fmt == AV_PIX_FMT_NV12)
+      supports_nv12 = true;
+  }
+
+  return supports_nv12 ? AV_PIX_FMT_NV12 : AV_PIX_FMT_YUV420P;
+}
+
 static bool AVStreamCopyContext(AVStream* stream, AVCodecContext* codec_context)
 {
 #if (LIBAVCODEC_VERSION_MICRO >= 100 && LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 33, 100)) ||  \
@@ -147,19 +166,22 @@ bool AVIDump::CreateVideoFile()
   const std::string& codec_name = g_Config.bUseFFV1 ? "ffv1" : g_Config.sDumpCodec;
 
   AVCodecID codec_id = output_format->video_codec;
+  const AVCodec* codec = nullptr;
 
   if (!codec_name.empty())
   {
+    // Encoders can be picked by name, which allows choosing hardware encoders such as h264_nvenc
+    // or h264_qsv over the default encoder of a codec.
+    codec = avcodec_find_encoder_by_name(codec_name.c_str());
     const AVCodecDescriptor* codec_desc = avcodec_descriptor_get_by_name(codec_name.c_str());
     if (codec_desc)
       codec_id = codec_desc->id;
-    else
+    else if (!codec)
       WARN_LOG(VIDEO, "Invalid codec %s", codec_name.c_str());
   }
 
-  const AVCodec* codec = nullptr;
-
-  codec = avcodec_find_encoder(codec_id);
+  if (!codec)
+    codec = avcodec_find_encoder(codec_id);
   s_codec_context = avcodec_alloc_context3(codec);
   if (!codec || !s_codec_context)
   {
@@ -178,7 +200,7 @@ bool AVIDump::CreateVideoFile()
   s_codec_context->time_base.num = 1;
   s_codec_context->time_base.den = VideoInterface::GetTargetRefreshRate();
   s_codec_context->gop_size = 12;
-  s_codec_context->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGRA : AV_PIX_FMT_YUV420P;
+  s_codec_context->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGRA : GetEncoderPixelFormat(codec);
 
   if (output_format->flags & AVFMT_GLOBALHEADER)
     s_codec_context->flags |= CODEC_FLAG_GLOBAL_HEADER;
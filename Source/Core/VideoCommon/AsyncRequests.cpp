@@ -5,8 +5,10 @@
 #include <mutex>
 
 #include "VideoCommon/AsyncRequests.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -49,6 +51,7 @@ void AsyncRequests::PullEventsInternal()
 
       lock.unlock();
       g_renderer->PokeEFB(t, m_merged_efb_pokes.data(), m_merged_efb_pokes.size());
+      g_texture_cache->OnEFBModified();
       lock.lock();
       continue;
     }
@@ -116,6 +119,7 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   {
     EfbPokeData poke = {e.efb_poke.x, e.efb_poke.y, e.efb_poke.data};
     g_renderer->PokeEFB(EFBAccessType::PokeColor, &poke, 1);
+    g_texture_cache->OnEFBModified();
   }
   break;
 
@@ -123,15 +127,18 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   {
     EfbPokeData poke = {e.efb_poke.x, e.efb_poke.y, e.efb_poke.data};
     g_renderer->PokeEFB(EFBAccessType::PokeZ, &poke, 1);
+    g_texture_cache->OnEFBModified();
   }
   break;
 
   case Event::EFB_PEEK_COLOR:
+    g_renderer->NotifyEFBRead();
     *e.efb_peek.data =
         g_renderer->AccessEFB(EFBAccessType::PeekColor, e.efb_peek.x, e.efb_peek.y, 0);
     break;
 
   case Event::EFB_PEEK_Z:
+    g_renderer->NotifyEFBRead();
     *e.efb_peek.data = g_renderer->AccessEFB(EFBAccessType::PeekZ, e.efb_peek.x, e.efb_peek.y, 0);
     break;
 
@@ -141,8 +148,12 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
     break;
 
   case Event::BBOX_READ:
-    *e.bbox.data = g_renderer->BBoxRead(e.bbox.index);
-    break;
+  {
+    const u16 value = BoundingBox::Read(e.bbox.index);
+    if (e.bbox.data)
+      *e.bbox.data = value;
+  }
+  break;
 
   case Event::PERF_QUERY:
     g_perf_query->FlushResults();
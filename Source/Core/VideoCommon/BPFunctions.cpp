@@ -8,6 +8,8 @@
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/RenderState.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -72,6 +74,7 @@ void SetDepthMode()
 
 void SetBlendMode()
 {
+  RenderState::UpdateBlendingState();
   g_renderer->SetBlendMode(false);
 }
 
@@ -133,6 +136,7 @@ void ClearScreen(const EFBRectangle& rc)
       z = Z24ToZ16ToZ24(z);
     }
     g_renderer->ClearScreen(rc, colorEnable, alphaEnable, zEnable, color, z);
+    g_texture_cache->OnEFBModified();
   }
 }
 
@@ -201,6 +205,7 @@ void OnPixelFormatChange()
   }
 
   g_renderer->ReinterpretPixelData(convtype);
+  g_texture_cache->OnEFBModified();
 
 skip:
   DEBUG_LOG(VIDEO, "pixelfmt: pixel=%d, zc=%d", static_cast<int>(new_format),
@@ -22,8 +22,11 @@
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelEngine.h"
+#include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/RenderState.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/VertexShaderManager.h"
@@ -35,10 +38,42 @@ using namespace BPFunctions;
 
 static const float s_gammaLUT[] = {1.0f, 1.7f, 2.2f, 1.0f};
 
+// Returns the texture unit which a BPMEM_TX_* register belongs to.
+static u32 GetTexUnitFromAddress(u32 address)
+{
+  return (address & 3) | ((address & 0x20) >> 3);
+}
+
+// Returns whether GetPixelShaderUid() reads a BP register.
+static bool AffectsPixelShaderUid(u32 address)
+{
+  switch (address)
+  {
+  case BPMEM_GENMODE:
+  case BPMEM_IREF:
+  case BPMEM_ZMODE:
+  case BPMEM_BLENDMODE:
+  case BPMEM_CONSTANTALPHA:
+  case BPMEM_ZCOMPARE:
+  case BPMEM_FOGRANGE:
+  case BPMEM_FOGPARAM3:
+  case BPMEM_ALPHACOMPARE:
+  case BPMEM_ZTEX2:
+    return true;
+  default:
+    return (address >= BPMEM_IND_CMD && address < BPMEM_IND_CMD + 16) ||
+           (address >= BPMEM_TREF && address < BPMEM_TREF + 8) ||
+           (address >= BPMEM_TEV_COLOR_ENV && address < BPMEM_TEV_COLOR_ENV + 32) ||
+           (address >= BPMEM_TEV_KSEL && address < BPMEM_TEV_KSEL + 8);
+  }
+}
+
 void BPInit()
 {
   memset(&bpmem, 0, sizeof(bpmem));
   bpmem.bpMask = 0xFFFFFF;
+  InvalidatePixelShaderUid();
+  RenderState::Init();
 }
 
 static void BPWritten(const BPCmd& bp)
@@ -76,13 +111,26 @@ static void BPWritten(const BPCmd& bp)
           bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
           bp.address == BPMEM_CLEAR_PIXEL_PERF))
     {
+      INCSTAT(stats.thisFrame.numSkippedFlushes);
       return;
     }
   }
 
+  // These registers don't affect drawing, so the vertices collected so far can still be drawn in
+  // the same batch. The mask register is written before every masked register write.
+  if (bp.address == BPMEM_BP_MASK || bp.address == BPMEM_IND_IMASK ||
+      bp.address == BPMEM_REVBITS)
+  {
+    INCSTAT(stats.thisFrame.numSkippedFlushes);
+    ((u32*)&bpmem)[bp.address] = bp.newvalue;
+    return;
+  }
+
   FlushPipeline();
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
+  if (AffectsPixelShaderUid(bp.address))
+    InvalidatePixelShaderUid();
 
   switch (bp.address)
   {
@@ -186,7 +234,11 @@ static void BPWritten(const BPCmd& bp)
     {
     case 0x02:
       if (!Fifo::UseDeterministicGPUThread())
+      {
+        // The game may read back EFB copies as soon as it sees that drawing is done.
+        g_texture_cache->FlushEFBCopies();
         PixelEngine::SetFinish();  // may generate interrupt
+      }
       DEBUG_LOG(VIDEO, "GXSetDrawDone SetPEFinish (value: 0x%02X)", (bp.newvalue & 0xFFFF));
       return;
 
@@ -197,12 +249,18 @@ static void BPWritten(const BPCmd& bp)
     return;
   case BPMEM_PE_TOKEN_ID:  // Pixel Engine Token ID
     if (!Fifo::UseDeterministicGPUThread())
+    {
+      g_texture_cache->FlushEFBCopies();
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), false);
+    }
     DEBUG_LOG(VIDEO, "SetPEToken 0x%04x", (bp.newvalue & 0xFFFF));
     return;
   case BPMEM_PE_TOKEN_INT_ID:  // Pixel Engine Interrupt Token ID
     if (!Fifo::UseDeterministicGPUThread())
+    {
+      g_texture_cache->FlushEFBCopies();
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), true);
+    }
     DEBUG_LOG(VIDEO, "SetPEToken + INT 0x%04x", (bp.newvalue & 0xFFFF));
     return;
 
@@ -293,6 +351,7 @@ static void BPWritten(const BPCmd& bp)
     if (!SConfig::GetInstance().bWii)
       addr = addr & 0x01FFFFFF;
 
+    g_texture_cache->FlushEFBCopies(addr, tlutXferCount);
     Memory::CopyFromEmu(texMem + tlutTMemAddr, addr, tlutXferCount);
 
     if (g_bRecordFifoData)
@@ -407,8 +466,8 @@ static void BPWritten(const BPCmd& bp)
 
     if (g_ActiveConfig.backend_info.bSupportsBBox && g_ActiveConfig.bBBoxEnable)
     {
-      g_renderer->BBoxWrite(offset, bp.newvalue & 0x3ff);
-      g_renderer->BBoxWrite(offset + 1, bp.newvalue >> 10);
+      BoundingBox::Write(offset, bp.newvalue & 0x3ff);
+      BoundingBox::Write(offset + 1, bp.newvalue >> 10);
     }
   }
     return;
@@ -499,10 +558,13 @@ static void BPWritten(const BPCmd& bp)
         if (tmem_addr_even + bytes_read > TMEM_SIZE)
           bytes_read = TMEM_SIZE - tmem_addr_even;
 
+        g_texture_cache->FlushEFBCopies(src_addr, bytes_read);
         Memory::CopyFromEmu(texMem + tmem_addr_even, src_addr, bytes_read);
       }
       else  // RGBA8 tiles (and CI14, but that might just be stupid libogc!)
       {
+        g_texture_cache->FlushEFBCopies(src_addr,
+                                        tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE * 2);
         u8* src_ptr = Memory::GetPointer(src_addr);
 
         // AR and GB tiles are stored in separate TMEM banks => can't use a single memcpy for
@@ -609,14 +671,20 @@ static void BPWritten(const BPCmd& bp)
   // DiagLoad, Min Filter, Mag Filter, Wrap T, S
   // BPMEM_TX_SETMODE1 - (LOD Stuff) - Max LOD, Min LOD
   // ------------------------
+  // Only the texture unit whose registers were changed needs to be looked up in the texture cache
+  // again, the textures bound to the other units are still valid.
   case BPMEM_TX_SETMODE0:  // (0x90 for linear)
   case BPMEM_TX_SETMODE0_4:
-    TextureCacheBase::InvalidateAllBindPoints();
+    TextureCacheBase::InvalidateBindPoint(GetTexUnitFromAddress(bp.address));
+    if (bp.changes)
+      RenderState::UpdateTexModeState(GetTexUnitFromAddress(bp.address));
     return;
 
   case BPMEM_TX_SETMODE1:
   case BPMEM_TX_SETMODE1_4:
-    TextureCacheBase::InvalidateAllBindPoints();
+    TextureCacheBase::InvalidateBindPoint(GetTexUnitFromAddress(bp.address));
+    if (bp.changes)
+      RenderState::UpdateTexModeState(GetTexUnitFromAddress(bp.address));
     return;
   // --------------------------------------------
   // BPMEM_TX_SETIMAGE0 - Texture width, height, format
@@ -633,7 +701,7 @@ static void BPWritten(const BPCmd& bp)
   case BPMEM_TX_SETIMAGE2_4:
   case BPMEM_TX_SETIMAGE3:
   case BPMEM_TX_SETIMAGE3_4:
-    TextureCacheBase::InvalidateAllBindPoints();
+    TextureCacheBase::InvalidateBindPoint(GetTexUnitFromAddress(bp.address));
     return;
   // -------------------------------
   // Set a TLUT
@@ -641,7 +709,7 @@ static void BPWritten(const BPCmd& bp)
   // -------------------------------
   case BPMEM_TX_SETTLUT:
   case BPMEM_TX_SETTLUT_4:
-    TextureCacheBase::InvalidateAllBindPoints();
+    TextureCacheBase::InvalidateBindPoint(GetTexUnitFromAddress(bp.address));
     return;
 
   default:
@@ -1411,6 +1479,7 @@ void BPReload()
   // restore anything that goes straight to the renderer.
   // let's not risk actually replaying any writes.
   // note that PixelShaderManager is already covered since it has its own DoState.
+  RenderState::Init();
   SetGenerationMode();
   SetScissor();
   SetDepthMode();
@@ -3,8 +3,13 @@
 // Refer to the license.txt file included.
 
 #include "VideoCommon/BoundingBox.h"
+
+#include <array>
+#include <atomic>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "VideoCommon/RenderBase.h"
 
 namespace BoundingBox
 {
@@ -12,11 +17,52 @@ namespace BoundingBox
 bool active = false;
 u16 coords[4] = {0x80, 0xA0, 0x80, 0xA0};
 
+// Whether coords may differ from the values in the backend.
+static bool s_dirty = true;
+
+// Copy of coords for reads from the CPU thread.
+static std::array<std::atomic<u16>, 4> s_last_read_values;
+
+void SetDirty()
+{
+  s_dirty = true;
+}
+
+u16 Read(int index)
+{
+  if (s_dirty)
+  {
+    for (int i = 0; i < 4; i++)
+    {
+      coords[i] = g_renderer->BBoxRead(i);
+      s_last_read_values[i].store(coords[i], std::memory_order_relaxed);
+    }
+    s_dirty = false;
+  }
+
+  return coords[index];
+}
+
+void Write(int index, u16 value)
+{
+  // The backend rounds the value to the target resolution, so it's read back again.
+  g_renderer->BBoxWrite(index, value);
+  s_dirty = true;
+}
+
+u16 GetLastReadValue(int index)
+{
+  return s_last_read_values[index].load(std::memory_order_relaxed);
+}
+
 // Save state
 void DoState(PointerWrap& p)
 {
   p.Do(active);
   p.Do(coords);
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    s_dirty = true;
 }
 
 }  // namespace BoundingBox
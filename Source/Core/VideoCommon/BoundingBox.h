@@ -25,6 +25,17 @@ enum
   BOTTOM = 3
 };
 
+// Called for draws while the bounding box is active, the values read back before may be outdated.
+void SetDirty();
+
+// Returns one of the coordinates. All of them are read back from the backend together, and only
+// if a draw or write may have changed them since they were last read. Called on the GPU thread.
+u16 Read(int index);
+void Write(int index, u16 value);
+
+// Returns the value last read back on the GPU thread, without waiting for it.
+u16 GetLastReadValue(int index);
+
 // Save state
 void DoState(PointerWrap& p);
 
@@ -264,6 +264,8 @@ extern CPState g_preprocess_cp_state;
 
 // Might move this into its own file later.
 void LoadCPReg(u32 SubCmd, u32 Value, bool is_preprocess = false);
+// Only updates the given state, along with the global state if it's the main one.
+void LoadCPReg(u32 SubCmd, u32 Value, CPState* state);
 
 // Fills memory with data from CP regs
 void FillCPMemoryArray(u32* memory);
@@ -191,6 +191,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
   }
 
   mmio->Register(base | STATUS_REGISTER, MMIO::ComplexRead<u16>([](u32) {
+                   Fifo::CountCPStatusRead();
                    SetCpStatusRegister();
                    return m_CPStatusReg.Hex;
                  }),
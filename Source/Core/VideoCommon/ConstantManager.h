@@ -69,6 +69,10 @@ struct VertexShaderConstants
   float pad2[2];      // .zw
 
   uint4 xfmem_pack1[8];  // .x - texMtxInfo, .y - postMtxInfo, [0..1].z = color, [0..1].w = alpha
+
+  // Only used when the vertex shader renders the stereo eyes as instances.
+  // .xy - horizontal offset per eye, .z - convergence, .w - whether the draw is instanced (bool)
+  float4 stereoparams;
 };
 
 struct GeometryShaderConstants
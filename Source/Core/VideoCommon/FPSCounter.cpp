@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 
@@ -35,12 +37,21 @@ void FPSCounter::Update()
 
   m_frame_counter++;
   m_time_since_update += diff;
+  m_frame_time_sum_of_squares += static_cast<double>(diff) * diff;
   m_last_time = time;
 
   if (m_time_since_update >= FPS_REFRESH_INTERVAL)
   {
     m_fps = m_frame_counter / (m_time_since_update / 1000000.0);
+
+    const double mean = static_cast<double>(m_time_since_update) / m_frame_counter;
+    const double variance =
+        std::max(m_frame_time_sum_of_squares / m_frame_counter - mean * mean, 0.0);
+    m_frame_time_mean = static_cast<float>(mean / 1000.0);
+    m_frame_time_std_dev = static_cast<float>(std::sqrt(variance) / 1000.0);
+
     m_frame_counter = 0;
     m_time_since_update = 0;
+    m_frame_time_sum_of_squares = 0;
   }
 }
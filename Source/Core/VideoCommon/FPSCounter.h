@@ -18,11 +18,18 @@ public:
   void Update();
 
   float GetFPS() const { return m_fps; }
+  // The mean and the standard deviation of the frame times, in milliseconds. A steady frame rate
+  // has a low deviation even if the FPS are the same.
+  float GetFrameTimeMean() const { return m_frame_time_mean; }
+  float GetFrameTimeStdDev() const { return m_frame_time_std_dev; }
 private:
   u64 m_last_time = 0;
   u64 m_time_since_update = 0;
   u32 m_frame_counter = 0;
+  double m_frame_time_sum_of_squares = 0;
   float m_fps = 0;
+  float m_frame_time_mean = 0;
+  float m_frame_time_std_dev = 0;
   std::ofstream m_bench_file;
 
   void LogRenderTimeToFile(u64 val);
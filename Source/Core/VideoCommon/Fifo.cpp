@@ -2,8 +2,11 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
+#include <mutex>
 
 #include "Common/Assert.h"
 #include "Common/Atomic.h"
@@ -13,6 +16,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -26,6 +30,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 
@@ -71,6 +76,29 @@ static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
 
+// With adaptive syncing, the distance the CPU may run ahead of the GPU thread is tuned once per
+// window of emulated time, between ADAPTIVE_MIN_DISTANCE and SyncGpuMaxDistance. Games which poll
+// the CP status register often are waiting on the GPU's progress, so the threads are coupled more
+// tightly for them. Otherwise, the distance grows back, faster while the CPU is blocked on the GPU.
+static constexpr int SYNC_WINDOWS_PER_SECOND = 60;
+static constexpr int ADAPTIVE_MIN_DISTANCE = 20000;
+static constexpr u32 ADAPTIVE_POLL_THRESHOLD = 100;
+
+struct AdaptiveSyncWindow
+{
+  int ticks = 0;
+  int peak_backlog = 0;
+  u32 cp_status_reads = 0;
+  u64 wait_time_us = 0;
+};
+
+// Written by the CPU thread, but also read by the GPU thread.
+static std::atomic<int> s_sync_max_distance;
+// Only touched by the CPU thread.
+static AdaptiveSyncWindow s_sync_window;
+static std::mutex s_sync_stats_mutex;
+static SyncStats s_sync_stats;
+
 void DoState(PointerWrap& p)
 {
   p.DoArray(s_video_buffer, FIFO_SIZE);
@@ -117,6 +145,10 @@ void Init()
   if (SConfig::GetInstance().bCPUThread)
     s_gpu_mainloop.Prepare();
   s_sync_ticks.store(0);
+  s_sync_max_distance.store(SConfig::GetInstance().iSyncGpuMaxDistance);
+  s_sync_window = {};
+  std::lock_guard<std::mutex> lk(s_sync_stats_mutex);
+  s_sync_stats = {};
 }
 
 void Shutdown()
@@ -160,7 +192,9 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (s_use_deterministic_gpu_thread)
   {
+    const u64 wait_start = Common::Timer::GetTimeUs();
     s_gpu_mainloop.Wait();
+    StageTimings::AddCPUWaitTime(Common::Timer::GetTimeUs() - wait_start);
     if (!s_gpu_mainloop.IsRunning())
       return;
 
@@ -241,6 +275,33 @@ static void ReadDataFromFifo(u32 readPtr)
   s_video_buffer_write_ptr += len;
 }
 
+// Decodes the chunk at readPtr straight from guest memory when nothing is left over from the
+// previous chunks, so that FIFO data usually isn't copied at all. Only the start of a command which
+// continues in the next chunk is copied into the video buffer. Returns false without decoding
+// anything if the chunk has to go through ReadDataFromFifo instead.
+static bool RunFifoChunkInPlace(u32 readPtr, u32* cycles)
+{
+  if (s_video_buffer_read_ptr != s_video_buffer_write_ptr)
+    return false;
+
+  u8* const chunk = Memory::GetPointer(readPtr);
+  if (!chunk)
+    return false;
+
+  u8* const chunk_end = chunk + 32;
+  u8* end;
+  {
+    StageTimings::ScopedTimer timer(StageTimings::Stage::FifoProcessing);
+    end = OpcodeDecoder::Run(DataReader(chunk, chunk_end), cycles, false);
+  }
+
+  const size_t leftover = chunk_end - end;
+  std::memcpy(s_video_buffer, end, leftover);
+  s_video_buffer_read_ptr = s_video_buffer;
+  s_video_buffer_write_ptr = s_video_buffer + leftover;
+  return true;
+}
+
 // The deterministic_gpu_thread version.
 static void ReadDataFromFifoOnCPU(u32 readPtr)
 {
@@ -287,6 +348,12 @@ void ResetVideoBuffer()
   s_fifo_aux_read_ptr = s_fifo_aux_data;
 }
 
+static int GetSyncMaxDistance()
+{
+  const SConfig& param = SConfig::GetInstance();
+  return param.bSyncGpuAdaptive ? s_sync_max_distance.load() : param.iSyncGpuMaxDistance;
+}
+
 // Description: Main FIFO update loop
 // Purpose: Keep the Core HW updated about the CPU-GPU distance
 void RunGpuLoop()
@@ -314,6 +381,7 @@ void RunGpuLoop()
           // See comment in SyncGPU
           if (write_ptr > seen_ptr)
           {
+            StageTimings::ScopedTimer timer(StageTimings::Stage::FifoProcessing);
             s_video_buffer_read_ptr =
                 OpcodeDecoder::Run(DataReader(s_video_buffer_read_ptr, write_ptr), nullptr, false);
             s_video_buffer_seen_ptr = write_ptr;
@@ -336,7 +404,9 @@ void RunGpuLoop()
 
             u32 cyclesExecuted = 0;
             u32 readPtr = fifo.CPReadPointer;
-            ReadDataFromFifo(readPtr);
+            const bool decoded_in_place = RunFifoChunkInPlace(readPtr, &cyclesExecuted);
+            if (!decoded_in_place)
+              ReadDataFromFifo(readPtr);
 
             if (readPtr == fifo.CPEnd)
               readPtr = fifo.CPBase;
@@ -349,8 +419,12 @@ void RunGpuLoop()
                          fifo.CPReadWriteDistance - 32);
 
             u8* write_ptr = s_video_buffer_write_ptr;
-            s_video_buffer_read_ptr = OpcodeDecoder::Run(
-                DataReader(s_video_buffer_read_ptr, write_ptr), &cyclesExecuted, false);
+            if (!decoded_in_place)
+            {
+              StageTimings::ScopedTimer timer(StageTimings::Stage::FifoProcessing);
+              s_video_buffer_read_ptr = OpcodeDecoder::Run(
+                  DataReader(s_video_buffer_read_ptr, write_ptr), &cyclesExecuted, false);
+            }
 
             Common::AtomicStore(fifo.CPReadPointer, readPtr);
             Common::AtomicAdd(fifo.CPReadWriteDistance, static_cast<u32>(-32));
@@ -362,9 +436,9 @@ void RunGpuLoop()
             if (param.bSyncGPU)
             {
               cyclesExecuted = (int)(cyclesExecuted / param.fSyncGpuOverclock);
+              const int max_distance = GetSyncMaxDistance();
               int old = s_sync_ticks.fetch_sub(cyclesExecuted);
-              if (old >= param.iSyncGpuMaxDistance &&
-                  old - (int)cyclesExecuted < param.iSyncGpuMaxDistance)
+              if (old >= max_distance && old - (int)cyclesExecuted < max_distance)
                 s_sync_wakeup_event.Set();
             }
 
@@ -379,7 +453,7 @@ void RunGpuLoop()
           if (s_sync_ticks.load() > 0)
           {
             int old = s_sync_ticks.exchange(0);
-            if (old >= param.iSyncGpuMaxDistance)
+            if (old >= GetSyncMaxDistance())
               s_sync_wakeup_event.Set();
           }
 
@@ -401,7 +475,9 @@ void FlushGpu()
   if (!param.bCPUThread || s_use_deterministic_gpu_thread)
     return;
 
+  const u64 wait_start = Common::Timer::GetTimeUs();
   s_gpu_mainloop.Wait();
+  StageTimings::AddCPUWaitTime(Common::Timer::GetTimeUs() - wait_start);
 }
 
 void GpuMaySleep()
@@ -458,10 +534,14 @@ static int RunGpuOnCpu(int ticks)
         FPURoundMode::LoadDefaultSIMDState();
         reset_simd_state = true;
       }
-      ReadDataFromFifo(fifo.CPReadPointer);
       u32 cycles = 0;
-      s_video_buffer_read_ptr = OpcodeDecoder::Run(
-          DataReader(s_video_buffer_read_ptr, s_video_buffer_write_ptr), &cycles, false);
+      if (!RunFifoChunkInPlace(fifo.CPReadPointer, &cycles))
+      {
+        ReadDataFromFifo(fifo.CPReadPointer);
+        StageTimings::ScopedTimer timer(StageTimings::Stage::FifoProcessing);
+        s_video_buffer_read_ptr = OpcodeDecoder::Run(
+            DataReader(s_video_buffer_read_ptr, s_video_buffer_write_ptr), &cycles, false);
+      }
       available_ticks -= cycles;
     }
 
@@ -530,6 +610,53 @@ bool UseDeterministicGPUThread()
   return s_use_deterministic_gpu_thread;
 }
 
+void CountCPStatusRead()
+{
+  ++s_sync_window.cp_status_reads;
+}
+
+SyncStats GetSyncStats()
+{
+  std::lock_guard<std::mutex> lk(s_sync_stats_mutex);
+  return s_sync_stats;
+}
+
+static void UpdateSyncWindow(int ticks, int backlog)
+{
+  s_sync_window.ticks += ticks;
+  s_sync_window.peak_backlog = std::max(s_sync_window.peak_backlog, backlog);
+  if (s_sync_window.ticks < static_cast<int>(SystemTimers::GetTicksPerSecond() /
+                                             SYNC_WINDOWS_PER_SECOND))
+  {
+    return;
+  }
+
+  const SConfig& param = SConfig::GetInstance();
+  int distance = param.iSyncGpuMaxDistance;
+  if (param.bSyncGpuAdaptive)
+  {
+    const int ceiling = param.iSyncGpuMaxDistance;
+    const int floor = std::min(ADAPTIVE_MIN_DISTANCE, ceiling);
+    distance = std::clamp(s_sync_max_distance.load(), floor, ceiling);
+    if (s_sync_window.cp_status_reads >= ADAPTIVE_POLL_THRESHOLD)
+      distance = std::max(distance / 2, floor);
+    else if (s_sync_window.wait_time_us > 0 || s_sync_window.peak_backlog >= distance)
+      distance += (ceiling - distance + 1) / 2;
+    else
+      distance += (ceiling - distance + 7) / 8;
+    s_sync_max_distance.store(distance);
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(s_sync_stats_mutex);
+    s_sync_stats.max_distance = distance;
+    s_sync_stats.peak_backlog = s_sync_window.peak_backlog;
+    s_sync_stats.cp_status_reads = s_sync_window.cp_status_reads;
+    s_sync_stats.wait_time_us = s_sync_window.wait_time_us;
+  }
+  s_sync_window = {};
+}
+
 /* This function checks the emulated CPU - GPU distance and may wake up the GPU,
  * or block the CPU if required. It should be called by the CPU thread regularly.
  * @ticks The gone emulated CPU time.
@@ -542,6 +669,9 @@ static int WaitForGpuThread(int ticks)
   int old = s_sync_ticks.fetch_add(ticks);
   int now = old + ticks;
 
+  UpdateSyncWindow(ticks, now);
+  const int max_distance = GetSyncMaxDistance();
+
   // GPU is idle, so stop polling.
   if (old >= 0 && s_gpu_mainloop.IsDone())
     return -1;
@@ -555,8 +685,26 @@ static int WaitForGpuThread(int ticks)
     return GPU_TIME_SLOT_SIZE + param.iSyncGpuMinDistance - now;
 
   // Wait for GPU
-  if (now >= param.iSyncGpuMaxDistance)
-    s_sync_wakeup_event.Wait();
+  if (now >= max_distance)
+  {
+    const u64 wait_start = Common::Timer::GetTimeUs();
+    if (param.bSyncGpuAdaptive)
+    {
+      // The GPU thread may still compare against the distance from before it was lowered, and
+      // then wouldn't wake us when crossing the new one.
+      while (!s_sync_wakeup_event.WaitFor(std::chrono::milliseconds(1)) &&
+             s_sync_ticks.load() >= GetSyncMaxDistance() && s_gpu_mainloop.IsRunning())
+      {
+      }
+    }
+    else
+    {
+      s_sync_wakeup_event.Wait();
+    }
+    const u64 wait_time = Common::Timer::GetTimeUs() - wait_start;
+    s_sync_window.wait_time_us += wait_time;
+    StageTimings::AddCPUWaitTime(wait_time);
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
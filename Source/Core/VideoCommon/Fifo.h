@@ -25,6 +25,7 @@ enum class SyncGPUReason
   Other,
   Wraparound,
   EFBPoke,
+  EFBPeek,
   PerfQuery,
   BBox,
   Swap,
@@ -45,4 +46,18 @@ void EmulatorState(bool running);
 bool AtBreakpoint();
 void ResetVideoBuffer();
 
+// Called by the CPU thread when the emulated CPU reads the CP status register, which games poll
+// while waiting for the GPU.
+void CountCPStatusRead();
+
+// How the GPU syncing of dual core mode behaved during the last window of emulated time.
+struct SyncStats
+{
+  int max_distance = 0;
+  int peak_backlog = 0;
+  u32 cp_status_reads = 0;
+  u64 wait_time_us = 0;
+};
+SyncStats GetSyncStats();
+
 }  // namespace Fifo
@@ -0,0 +1,168 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FrameStatsLog.h"
+
+#include <iomanip>
+
+#include "Common/StringUtil.h"
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoConfig.h"
+
+// Frames which are still waiting for their GPU time after this many frames are written without
+// it, in case the backend dropped the timer.
+static constexpr size_t MAX_PENDING_FRAMES = 16;
+
+// Column names of the stage times, in the order of StageTimings::Stage.
+static constexpr std::array<const char*, StageTimings::NUM_STAGES> STAGE_COLUMNS = {
+    {"cpu_ms", "fifo_ms", "vertex_loading_ms", "texture_decode_ms", "texture_hash_ms",
+     "shader_uid_ms", "shader_wait_ms", "submit_ms", "present_wait_ms"}};
+
+FrameStatsLog::~FrameStatsLog()
+{
+  CloseFile();
+}
+
+void FrameStatsLog::EndFrame()
+{
+  UpdateFile();
+  if (!IsActive())
+    return;
+
+  const u64 time = Common::Timer::GetTimeUs();
+  FrameStats frame;
+  frame.frame = m_current_frame++;
+  frame.host_time_ms = (time - m_last_time) / 1000.0;
+  frame.stage_times_ms = StageTimings::GetLastFrame();
+  frame.num_draw_calls = stats.thisFrame.numDrawCalls;
+  frame.num_prims = stats.thisFrame.numPrims + stats.thisFrame.numDLPrims;
+  frame.num_primitive_joins = stats.thisFrame.numPrimitiveJoins;
+  frame.num_shader_changes = stats.thisFrame.numShaderChanges;
+  frame.num_bp_loads = stats.thisFrame.numBPLoads + stats.thisFrame.numBPLoadsInDL;
+  frame.num_cp_loads = stats.thisFrame.numCPLoads + stats.thisFrame.numCPLoadsInDL;
+  frame.num_xf_loads = stats.thisFrame.numXFLoads + stats.thisFrame.numXFLoadsInDL;
+  frame.num_skipped_flushes = stats.thisFrame.numSkippedFlushes;
+  frame.num_stream_buffer_stalls = stats.thisFrame.numStreamBufferStalls;
+  m_last_time = time;
+
+  if (!g_ActiveConfig.backend_info.bSupportsGPUTimers)
+  {
+    WriteFrame(frame, nullptr);
+    return;
+  }
+
+  m_pending_frames.push_back(frame);
+  if (m_pending_frames.size() > MAX_PENDING_FRAMES)
+  {
+    WriteFrame(m_pending_frames.front(), nullptr);
+    m_pending_frames.pop_front();
+  }
+}
+
+void FrameStatsLog::ReportGPUTime(u64 frame, double milliseconds)
+{
+  while (!m_pending_frames.empty() && m_pending_frames.front().frame <= frame)
+  {
+    const FrameStats& pending = m_pending_frames.front();
+    WriteFrame(pending, pending.frame == frame ? &milliseconds : nullptr);
+    m_pending_frames.pop_front();
+  }
+}
+
+void FrameStatsLog::UpdateFile()
+{
+  if (g_ActiveConfig.sFrameStatsLogPath == m_path)
+    return;
+
+  CloseFile();
+  m_path = g_ActiveConfig.sFrameStatsLogPath;
+  if (m_path.empty())
+    return;
+
+  File::OpenFStream(m_file, m_path, std::ios_base::out | std::ios_base::trunc);
+  if (!m_file.is_open())
+  {
+    ERROR_LOG(VIDEO, "Failed to open frame stats log %s", m_path.c_str());
+    return;
+  }
+
+  m_json = StringEndsWith(m_path, ".json");
+  m_first_frame_written = false;
+  if (m_json)
+  {
+    m_file << "[\n";
+  }
+  else
+  {
+    m_file << "frame,host_ms,gpu_ms";
+    for (const char* column : STAGE_COLUMNS)
+      m_file << ',' << column;
+    m_file << ",draw_calls,primitives,primitive_joins,shader_changes,bp_loads,cp_loads,xf_loads,"
+              "skipped_flushes,stream_buffer_stalls"
+           << std::endl;
+  }
+  m_current_frame = 0;
+  m_last_time = Common::Timer::GetTimeUs();
+}
+
+void FrameStatsLog::WriteFrame(const FrameStats& frame, const double* gpu_time_ms)
+{
+  m_file << std::fixed << std::setprecision(3);
+  if (m_json)
+  {
+    if (m_first_frame_written)
+      m_file << ",\n";
+    m_file << "{\"frame\":" << frame.frame << ",\"host_ms\":" << frame.host_time_ms
+           << ",\"gpu_ms\":";
+    if (gpu_time_ms)
+      m_file << *gpu_time_ms;
+    else
+      m_file << "null";
+    for (size_t i = 0; i < STAGE_COLUMNS.size(); ++i)
+      m_file << ",\"" << STAGE_COLUMNS[i] << "\":" << frame.stage_times_ms[i];
+    m_file << ",\"draw_calls\":" << frame.num_draw_calls << ",\"primitives\":" << frame.num_prims
+           << ",\"primitive_joins\":" << frame.num_primitive_joins
+           << ",\"shader_changes\":" << frame.num_shader_changes
+           << ",\"bp_loads\":" << frame.num_bp_loads << ",\"cp_loads\":" << frame.num_cp_loads
+           << ",\"xf_loads\":" << frame.num_xf_loads
+           << ",\"skipped_flushes\":" << frame.num_skipped_flushes
+           << ",\"stream_buffer_stalls\":" << frame.num_stream_buffer_stalls << '}';
+    m_first_frame_written = true;
+    return;
+  }
+
+  m_file << frame.frame << ',' << frame.host_time_ms << ',';
+  if (gpu_time_ms)
+    m_file << *gpu_time_ms;
+  for (double stage_time_ms : frame.stage_times_ms)
+    m_file << ',' << stage_time_ms;
+  m_file << ',' << frame.num_draw_calls << ',' << frame.num_prims << ','
+         << frame.num_primitive_joins << ',' << frame.num_shader_changes << ','
+         << frame.num_bp_loads << ',' << frame.num_cp_loads << ',' << frame.num_xf_loads << ','
+         << frame.num_skipped_flushes << ',' << frame.num_stream_buffer_stalls << '\n';
+}
+
+void FrameStatsLog::WritePendingFrames()
+{
+  for (const FrameStats& frame : m_pending_frames)
+    WriteFrame(frame, nullptr);
+  m_pending_frames.clear();
+  if (m_file.is_open())
+    m_file.flush();
+}
+
+void FrameStatsLog::CloseFile()
+{
+  WritePendingFrames();
+  if (!m_file.is_open())
+    return;
+
+  if (m_json)
+    m_file << "\n]\n";
+  m_file.close();
+}
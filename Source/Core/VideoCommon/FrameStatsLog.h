@@ -0,0 +1,65 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <deque>
+#include <fstream>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/StageTimings.h"
+
+// Writes a CSV line for every frame to the file set in the config, with the time the host took for
+// the frame, the time the GPU took for it, the time spent in each stage of the frame, and the draw
+// and state change counts from the statistics. This is meant for benchmarking FIFO logs. If the
+// path ends in .json, an array with an object for every frame is written instead.
+//
+// Backends which support GPU timers report the GPU time of a frame once their queries have
+// completed, which is usually a couple of frames later, so the lines are held back until then.
+class FrameStatsLog
+{
+public:
+  ~FrameStatsLog();
+
+  bool IsActive() const { return m_file.is_open(); }
+  // Number of the frame which is currently being rendered, for tagging the GPU timers.
+  u64 GetCurrentFrame() const { return m_current_frame; }
+  // Records the statistics of the current frame, before they are reset for the next one.
+  void EndFrame();
+
+  // Sets how long the GPU took for a frame. As the timers complete in order, any earlier frames
+  // which weren't reported are written without a GPU time.
+  void ReportGPUTime(u64 frame, double milliseconds);
+
+private:
+  struct FrameStats
+  {
+    u64 frame;
+    double host_time_ms;
+    StageTimings::FrameTimes stage_times_ms;
+    int num_draw_calls;
+    int num_prims;
+    int num_primitive_joins;
+    int num_shader_changes;
+    int num_bp_loads;
+    int num_cp_loads;
+    int num_xf_loads;
+    int num_skipped_flushes;
+    int num_stream_buffer_stalls;
+  };
+
+  void UpdateFile();
+  void WriteFrame(const FrameStats& frame, const double* gpu_time_ms);
+  void WritePendingFrames();
+  void CloseFile();
+
+  std::ofstream m_file;
+  std::string m_path;
+  bool m_json = false;
+  bool m_first_frame_written = false;
+  std::deque<FrameStats> m_pending_frames;
+  u64 m_current_frame = 0;
+  u64 m_last_time = 0;
+};
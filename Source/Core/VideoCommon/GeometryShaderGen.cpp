@@ -10,6 +10,7 @@
 #include "Common/CommonTypes.h"
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/LightingShaderGen.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
@@ -20,13 +21,17 @@ static const char* primitives_d3d[] = {"point", "line", "triangle"};
 
 bool geometry_shader_uid_data::IsPassthrough() const
 {
-  const bool stereo = g_ActiveConfig.iStereoMode > 0;
+  // Stereo triangles are left to the vertex shader if it can select the layer.
+  const bool stereo = g_ActiveConfig.iStereoMode > 0 &&
+                      !g_ActiveConfig.backend_info.bSupportsVertexShaderLayer;
   const bool wireframe = g_ActiveConfig.bWireFrame;
   return primitive_type == PRIMITIVE_TRIANGLES && !stereo && !wireframe;
 }
 
 GeometryShaderUid GetGeometryShaderUid(u32 primitive_type)
 {
+  StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderUidGeneration);
+
   ShaderUid<geometry_shader_uid_data> out;
   geometry_shader_uid_data* uid_data = out.GetUidData<geometry_shader_uid_data>();
   memset(uid_data, 0, sizeof(geometry_shader_uid_data));
@@ -105,6 +110,11 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
     out.Write("VARYING_LOCATION(0) in VertexData {\n");
     GenerateVSOutputMembers<ShaderCode>(out, ApiType, uid_data->numTexGens, pixel_lighting,
                                         GetInterpolationQualifier(msaa, ssaa, true, true));
+
+    // The vertex shader's layer is unused here, but the blocks have to match.
+    if (stereo && host_config.backend_vs_layer)
+      out.Write("\tflat int layer;\n");
+
     out.Write("} vs[%d];\n", vertex_in);
 
     out.Write("VARYING_LOCATION(0) out VertexData {\n");
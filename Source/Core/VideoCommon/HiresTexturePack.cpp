@@ -0,0 +1,255 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/HiresTexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include <xxhash.h>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/TextureConfig.h"
+
+// The values of AbstractTextureFormat are stored in the pack directly.
+static_assert(static_cast<u32>(AbstractTextureFormat::RGBA8) == 0 &&
+                  static_cast<u32>(AbstractTextureFormat::DXT1) == 1 &&
+                  static_cast<u32>(AbstractTextureFormat::DXT3) == 2 &&
+                  static_cast<u32>(AbstractTextureFormat::DXT5) == 3 &&
+                  static_cast<u32>(AbstractTextureFormat::BPTC) == 4,
+              "Changing the texture formats breaks existing texture packs");
+
+u64 HiresTexturePack::HashName(const std::string& name)
+{
+  return XXH64(name.data(), name.size(), 0);
+}
+
+size_t HiresTexturePack::CalculateLevelSize(AbstractTextureFormat format, u32 row_length,
+                                            u32 height)
+{
+  const size_t blocks = static_cast<size_t>((row_length + 3) / 4) * ((height + 3) / 4);
+  switch (format)
+  {
+  case AbstractTextureFormat::DXT1:
+    return blocks * 8;
+  case AbstractTextureFormat::DXT3:
+  case AbstractTextureFormat::DXT5:
+  case AbstractTextureFormat::BPTC:
+    return blocks * 16;
+  default:
+    return static_cast<size_t>(row_length) * height * 4;
+  }
+}
+
+bool HiresTexturePack::Open(const std::string& filename)
+{
+  m_textures = nullptr;
+  m_levels = nullptr;
+  m_names = nullptr;
+  m_num_textures = 0;
+
+  if (!m_file.Open(filename))
+    return false;
+
+  if (!Validate())
+  {
+    ERROR_LOG(VIDEO, "%s is not a valid custom texture pack", filename.c_str());
+    m_file.Close();
+    return false;
+  }
+
+  Header header;
+  std::memcpy(&header, m_file.GetData(), sizeof(header));
+  m_textures = reinterpret_cast<const TextureEntry*>(m_file.GetData() + header.textures_offset);
+  m_levels = reinterpret_cast<const LevelEntry*>(m_file.GetData() + header.levels_offset);
+  m_names = reinterpret_cast<const char*>(m_file.GetData() + header.names_offset);
+  m_num_textures = header.num_textures;
+  return true;
+}
+
+// Checks the whole index once, so that lookups don't have to bother with broken packs.
+bool HiresTexturePack::Validate() const
+{
+  const u64 file_size = m_file.GetSize();
+  const auto in_file = [file_size](u64 offset, u64 size) {
+    return offset <= file_size && size <= file_size - offset;
+  };
+
+  if (file_size < sizeof(Header))
+    return false;
+
+  Header header;
+  std::memcpy(&header, m_file.GetData(), sizeof(header));
+  if (header.magic != MAGIC || header.version != VERSION)
+    return false;
+
+  if (header.textures_offset % alignof(TextureEntry) != 0 ||
+      header.levels_offset % alignof(LevelEntry) != 0 ||
+      !in_file(header.textures_offset, u64(header.num_textures) * sizeof(TextureEntry)) ||
+      !in_file(header.levels_offset, u64(header.num_levels) * sizeof(LevelEntry)) ||
+      !in_file(header.names_offset, header.names_size))
+  {
+    return false;
+  }
+
+  const auto* textures =
+      reinterpret_cast<const TextureEntry*>(m_file.GetData() + header.textures_offset);
+  for (u32 i = 0; i < header.num_textures; ++i)
+  {
+    const TextureEntry& texture = textures[i];
+    if ((i > 0 && textures[i - 1].name_hash > texture.name_hash) || texture.num_levels == 0 ||
+        u64(texture.name_offset) + texture.name_size > header.names_size ||
+        u64(texture.first_level) + texture.num_levels > header.num_levels)
+    {
+      return false;
+    }
+  }
+
+  const auto* levels = reinterpret_cast<const LevelEntry*>(m_file.GetData() + header.levels_offset);
+  for (u32 i = 0; i < header.num_levels; ++i)
+  {
+    const LevelEntry& level = levels[i];
+    if (level.format > static_cast<u32>(AbstractTextureFormat::BPTC) ||
+        level.row_length < level.width || !in_file(level.data_offset, level.data_size) ||
+        level.data_size < CalculateLevelSize(static_cast<AbstractTextureFormat>(level.format),
+                                             level.row_length, level.height))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const HiresTexturePack::TextureEntry* HiresTexturePack::Find(const std::string& name) const
+{
+  if (m_num_textures == 0)
+    return nullptr;
+
+  const u64 hash = HashName(name);
+  const TextureEntry* begin = m_textures;
+  const TextureEntry* end = m_textures + m_num_textures;
+  const TextureEntry* iter = std::lower_bound(
+      begin, end, hash, [](const TextureEntry& entry, u64 h) { return entry.name_hash < h; });
+
+  // Different names can have the same hash, so the name itself has to be compared as well.
+  for (; iter != end && iter->name_hash == hash; ++iter)
+  {
+    if (iter->name_size == name.size() &&
+        std::memcmp(m_names + iter->name_offset, name.data(), name.size()) == 0)
+    {
+      return iter;
+    }
+  }
+
+  return nullptr;
+}
+
+std::string HiresTexturePack::GetTextureName(size_t index) const
+{
+  const TextureEntry& texture = m_textures[index];
+  return std::string(m_names + texture.name_offset, texture.name_size);
+}
+
+bool HiresTexturePack::Contains(const std::string& name) const
+{
+  return Find(name) != nullptr;
+}
+
+bool HiresTexturePack::GetLevels(const std::string& name, std::vector<Level>* levels) const
+{
+  const TextureEntry* texture = Find(name);
+  if (!texture)
+    return false;
+
+  levels->clear();
+  for (u32 i = 0; i < texture->num_levels; ++i)
+  {
+    const LevelEntry& level = m_levels[texture->first_level + i];
+    levels->push_back({static_cast<AbstractTextureFormat>(level.format), level.width, level.height,
+                       level.row_length, m_file.GetData() + level.data_offset,
+                       static_cast<size_t>(level.data_size)});
+  }
+  return true;
+}
+
+bool HiresTexturePackWriter::Open(const std::string& filename)
+{
+  m_textures.clear();
+  m_levels.clear();
+  m_names.clear();
+
+  // The header is written by Finish(), once the offsets of the index are known.
+  const HiresTexturePack::Header header = {};
+  return m_file.Open(filename, "wb") && m_file.WriteBytes(&header, sizeof(header));
+}
+
+bool HiresTexturePackWriter::AddTexture(const std::string& name,
+                                        const std::vector<HiresTexturePack::Level>& levels)
+{
+  static const u8 padding[HiresTexturePack::DATA_ALIGNMENT] = {};
+
+  HiresTexturePack::TextureEntry texture;
+  texture.name_hash = HiresTexturePack::HashName(name);
+  texture.name_offset = static_cast<u32>(m_names.size());
+  texture.name_size = static_cast<u32>(name.size());
+  texture.first_level = static_cast<u32>(m_levels.size());
+  texture.num_levels = static_cast<u32>(levels.size());
+
+  for (const HiresTexturePack::Level& level : levels)
+  {
+    const u64 offset = m_file.Tell();
+    const u64 aligned_offset = Common::AlignUp(offset, HiresTexturePack::DATA_ALIGNMENT);
+    if (!m_file.WriteBytes(padding, static_cast<size_t>(aligned_offset - offset)) ||
+        !m_file.WriteBytes(level.data, level.data_size))
+    {
+      return false;
+    }
+
+    m_levels.push_back({static_cast<u32>(level.format), level.width, level.height,
+                        level.row_length, aligned_offset, level.data_size});
+  }
+
+  m_textures.push_back(texture);
+  m_names += name;
+  return true;
+}
+
+bool HiresTexturePackWriter::Finish()
+{
+  static const u8 padding[alignof(HiresTexturePack::LevelEntry)] = {};
+
+  std::sort(m_textures.begin(), m_textures.end(),
+            [](const HiresTexturePack::TextureEntry& a, const HiresTexturePack::TextureEntry& b) {
+              return a.name_hash < b.name_hash;
+            });
+
+  // Both tables only contain 8 byte aligned members, so only the first one needs padding.
+  const u64 offset = m_file.Tell();
+  const u64 textures_offset = Common::AlignUp(offset, sizeof(padding));
+  const u64 levels_offset =
+      textures_offset + m_textures.size() * sizeof(HiresTexturePack::TextureEntry);
+  const u64 names_offset = levels_offset + m_levels.size() * sizeof(HiresTexturePack::LevelEntry);
+
+  HiresTexturePack::Header header;
+  header.magic = HiresTexturePack::MAGIC;
+  header.version = HiresTexturePack::VERSION;
+  header.num_textures = static_cast<u32>(m_textures.size());
+  header.num_levels = static_cast<u32>(m_levels.size());
+  header.textures_offset = textures_offset;
+  header.levels_offset = levels_offset;
+  header.names_offset = names_offset;
+  header.names_size = m_names.size();
+
+  return m_file.WriteBytes(padding, static_cast<size_t>(textures_offset - offset)) &&
+         m_file.WriteArray(m_textures.data(), m_textures.size()) &&
+         m_file.WriteArray(m_levels.data(), m_levels.size()) &&
+         m_file.WriteBytes(m_names.data(), m_names.size()) && m_file.Seek(0, SEEK_SET) &&
+         m_file.WriteBytes(&header, sizeof(header)) && m_file.Close();
+}
@@ -0,0 +1,116 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// A single file which holds all custom textures of a game, including their mipmaps, in the
+// formats which are uploaded to the GPU. Looking a texture up only needs a binary search in the
+// index, and since the file is memory mapped, the texture data can be uploaded straight from it
+// without reading or decoding anything beforehand.
+//
+// Layout of the file, with all values in native (little endian) byte order:
+//   Header
+//   Level data, each level aligned to DATA_ALIGNMENT bytes
+//   TextureEntry[num_textures], sorted by the hash of the texture name
+//   LevelEntry[num_levels]
+//   The texture names, which are not null terminated
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/TextureConfig.h"
+
+class HiresTexturePack
+{
+public:
+  struct Level
+  {
+    AbstractTextureFormat format;
+    u32 width;
+    u32 height;
+    u32 row_length;
+    const u8* data;
+    size_t data_size;
+  };
+
+  // Returns false if the file doesn't exist or isn't a valid texture pack.
+  bool Open(const std::string& filename);
+
+  size_t GetTextureCount() const { return m_num_textures; }
+  std::string GetTextureName(size_t index) const;
+  bool Contains(const std::string& name) const;
+
+  // Returns false if the pack doesn't contain the texture. The data of the levels stays valid for
+  // as long as the pack is open.
+  bool GetLevels(const std::string& name, std::vector<Level>* levels) const;
+
+private:
+  friend class HiresTexturePackWriter;
+
+  static constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+  static constexpr u32 VERSION = 1;
+  static constexpr u64 DATA_ALIGNMENT = 64;
+
+  struct Header
+  {
+    u32 magic;
+    u32 version;
+    u32 num_textures;
+    u32 num_levels;
+    u64 textures_offset;
+    u64 levels_offset;
+    u64 names_offset;
+    u64 names_size;
+  };
+
+  struct TextureEntry
+  {
+    u64 name_hash;
+    u32 name_offset;
+    u32 name_size;
+    u32 first_level;
+    u32 num_levels;
+  };
+
+  struct LevelEntry
+  {
+    u32 format;
+    u32 width;
+    u32 height;
+    u32 row_length;
+    u64 data_offset;
+    u64 data_size;
+  };
+
+  static u64 HashName(const std::string& name);
+  static size_t CalculateLevelSize(AbstractTextureFormat format, u32 row_length, u32 height);
+
+  bool Validate() const;
+  const TextureEntry* Find(const std::string& name) const;
+
+  Common::MappedFile m_file;
+  const TextureEntry* m_textures = nullptr;
+  const LevelEntry* m_levels = nullptr;
+  const char* m_names = nullptr;
+  size_t m_num_textures = 0;
+};
+
+// Writes the textures to a new pack one by one, so that only the index has to be kept in memory.
+class HiresTexturePackWriter
+{
+public:
+  bool Open(const std::string& filename);
+  bool AddTexture(const std::string& name, const std::vector<HiresTexturePack::Level>& levels);
+  // Writes the index. The pack can't be used if this isn't called.
+  bool Finish();
+
+private:
+  File::IOFile m_file;
+  std::vector<HiresTexturePack::TextureEntry> m_textures;
+  std::vector<HiresTexturePack::LevelEntry> m_levels;
+  std::string m_names;
+};
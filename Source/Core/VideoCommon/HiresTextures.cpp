@@ -7,12 +7,18 @@
 #include <SOIL/SOIL.h>
 #include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -27,24 +33,150 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
+namespace
+{
+struct CacheEntry
+{
+  // nullptr if the texture failed to load asynchronously, so that it isn't queued again
+  std::shared_ptr<HiresTexture> texture;
+  size_t size;
+  std::list<std::string>::iterator lru_iter;
+};
+
+struct LoadRequest
+{
+  std::string base_filename;
+  u32 width;
+  u32 height;
+};
+}  // Anonymous namespace
+
 static std::unordered_map<std::string, std::string> s_textureMap;
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
+// Loose texture files in s_textureMap take precedence over the textures in the pack.
+static std::shared_ptr<const HiresTexturePack> s_texturePack;
+static std::unordered_map<std::string, CacheEntry> s_textureCache;
+// The names of the cached textures, starting with the most recently used one
+static std::list<std::string> s_textureCacheLRU;
+static size_t s_textureCacheSize;
+static size_t s_textureCacheBudget;
 static std::mutex s_textureCacheMutex;
 static std::mutex s_textureCacheAquireMutex;  // for high priority access
+// SOIL isn't thread safe, so only one texture can be loaded at a time.
+static std::mutex s_textureLoadMutex;
 static Common::Flag s_textureCacheAbortLoading;
 static bool s_check_native_format;
 static bool s_check_new_format;
 
 static std::thread s_prefetcher;
 
+// Textures which are queued for or being loaded by the asynchronous loader, which are also
+// protected by s_textureCacheMutex.
+static std::thread s_loader;
+static std::deque<LoadRequest> s_loadQueue;
+static std::unordered_set<std::string> s_loading;
+static std::condition_variable s_loadQueueChanged;
+
+// The texture files found by StartIndexing, and the directory they were looked for in.
+static std::mutex s_indexMutex;
+static std::string s_indexDirectory;
+static std::shared_future<std::vector<std::string>> s_index;
+
 static const std::string s_format_prefix = "tex1_";
 
+static std::vector<std::string> FindTextureFiles(const std::string& directory)
+{
+  const std::vector<std::string> extensions{
+      ".png", ".bmp", ".tga", ".dds",
+      ".jpg"  // Why not? Could be useful for large photo-like textures
+  };
+
+  return Common::DoFileSearch({directory}, extensions, /*recursive*/ true);
+}
+
+static std::vector<std::string> TakeIndexedTextureFiles(const std::string& directory)
+{
+  std::shared_future<std::vector<std::string>> index;
+  {
+    std::lock_guard<std::mutex> lk(s_indexMutex);
+    if (s_indexDirectory == directory)
+      index = std::move(s_index);
+    s_index = {};
+    s_indexDirectory.clear();
+  }
+
+  if (!index.valid())
+    return FindTextureFiles(directory);
+
+  return index.get();
+}
+
+static bool HasTexture(const std::string& name)
+{
+  return s_textureMap.find(name) != s_textureMap.end() ||
+         (s_texturePack && s_texturePack->Contains(name));
+}
+
+static size_t GetTextureSize(const HiresTexture* texture)
+{
+  size_t size = 0;
+  if (texture)
+  {
+    for (const HiresTexture::Level& level : texture->m_levels)
+      size += level.data_size;
+  }
+  return size;
+}
+
+// The caller must hold s_textureCacheMutex for all of the cache functions.
+static void EraseFromCache(std::unordered_map<std::string, CacheEntry>::iterator iter)
+{
+  s_textureCacheSize -= iter->second.size;
+  s_textureCacheLRU.erase(iter->second.lru_iter);
+  s_textureCache.erase(iter);
+}
+
+static void ClearCache()
+{
+  s_textureCache.clear();
+  s_textureCacheLRU.clear();
+  s_textureCacheSize = 0;
+}
+
+static void InsertIntoCache(const std::string& base_filename,
+                            std::shared_ptr<HiresTexture> texture)
+{
+  auto iter = s_textureCache.find(base_filename);
+  if (iter != s_textureCache.end())
+    EraseFromCache(iter);
+
+  s_textureCacheLRU.push_front(base_filename);
+  const size_t size = GetTextureSize(texture.get());
+  s_textureCache.emplace(base_filename,
+                         CacheEntry{std::move(texture), size, s_textureCacheLRU.begin()});
+  s_textureCacheSize += size;
+
+  // Evict the least recently used textures until the cache fits in the budget again, but always
+  // keep the new texture, even if it doesn't fit by itself.
+  while (s_textureCacheSize > s_textureCacheBudget && s_textureCacheLRU.size() > 1)
+    EraseFromCache(s_textureCache.find(s_textureCacheLRU.back()));
+}
+
+static size_t CalculateCacheBudget()
+{
+  size_t sys_mem = Common::MemPhysical();
+  size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
+  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
+  return (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+}
+
 HiresTexture::Level::Level() : data(nullptr, SOIL_free_image_data)
 {
 }
@@ -59,48 +191,94 @@ void HiresTexture::Init()
 
 void HiresTexture::Shutdown()
 {
-  if (s_prefetcher.joinable())
+  StopLoading();
+
+  s_textureMap.clear();
+  s_texturePack.reset();
+  ClearCache();
+
+  std::lock_guard<std::mutex> lk(s_indexMutex);
+  s_index = {};
+  s_indexDirectory.clear();
+}
+
+void HiresTexture::StartIndexing(const std::string& game_id)
+{
+  const std::string texture_directory = GetTextureDirectory(game_id);
+  auto files = std::make_shared<std::promise<std::vector<std::string>>>();
+
   {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
+    std::lock_guard<std::mutex> lk(s_indexMutex);
+    s_indexDirectory = texture_directory;
+    s_index = files->get_future().share();
   }
 
-  s_textureMap.clear();
-  s_textureCache.clear();
+  Common::ThreadPool::Submit(Common::TaskPriority::Normal, [files, texture_directory] {
+    files->set_value(FindTextureFiles(texture_directory));
+  });
 }
 
-void HiresTexture::Update()
+void HiresTexture::StopLoading()
 {
-  if (s_prefetcher.joinable())
   {
+    std::lock_guard<std::mutex> lk(s_textureCacheMutex);
     s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
   }
+  s_loadQueueChanged.notify_all();
+
+  if (s_prefetcher.joinable())
+    s_prefetcher.join();
+  if (s_loader.joinable())
+    s_loader.join();
+
+  s_loadQueue.clear();
+  s_loading.clear();
+  s_textureCacheAbortLoading.Clear();
+}
+
+void HiresTexture::Update()
+{
+  StopLoading();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
     s_textureMap.clear();
-    s_textureCache.clear();
+    s_texturePack.reset();
+    ClearCache();
     return;
   }
 
-  if (!g_ActiveConfig.bCacheHiresTextures)
+  if (!g_ActiveConfig.bCacheHiresTextures && !g_ActiveConfig.bAsyncHiresTextures)
   {
-    s_textureCache.clear();
+    ClearCache();
   }
 
+  s_textureCacheBudget = CalculateCacheBudget();
+
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::string texture_directory = GetTextureDirectory(game_id);
-  std::vector<std::string> extensions{
-      ".png", ".bmp", ".tga", ".dds",
-      ".jpg"  // Why not? Could be useful for large photo-like textures
-  };
-
-  std::vector<std::string> filenames =
-      Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
+  const std::vector<std::string> filenames = TakeIndexedTextureFiles(texture_directory);
 
   const std::string code = game_id + "_";
 
+  auto pack = std::make_shared<HiresTexturePack>();
+  if (pack->Open(GetTexturePackFilename(game_id)))
+  {
+    for (size_t i = 0; i < pack->GetTextureCount(); ++i)
+    {
+      const std::string name = pack->GetTextureName(i);
+      if (name.substr(0, code.length()) == code)
+        s_check_native_format = true;
+      if (name.substr(0, s_format_prefix.length()) == s_format_prefix)
+        s_check_new_format = true;
+    }
+    s_texturePack = std::move(pack);
+  }
+  else
+  {
+    s_texturePack.reset();
+  }
+
   for (auto& rFilename : filenames)
   {
     std::string FileName;
@@ -119,25 +297,21 @@ void HiresTexture::Update()
     }
   }
 
-  if (g_ActiveConfig.bCacheHiresTextures)
+  // remove cached but deleted textures
+  auto iter = s_textureCache.begin();
+  while (iter != s_textureCache.end())
   {
-    // remove cached but deleted textures
-    auto iter = s_textureCache.begin();
-    while (iter != s_textureCache.end())
-    {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
-      {
-        iter = s_textureCache.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
-    }
+    auto next = std::next(iter);
+    if (s_textureMap.find(iter->first) == s_textureMap.end() || !iter->second.texture)
+      EraseFromCache(iter);
+    iter = next;
+  }
+
+  if (g_ActiveConfig.bAsyncHiresTextures)
+    s_loader = std::thread(LoaderThread);
 
-    s_textureCacheAbortLoading.Clear();
+  if (g_ActiveConfig.bCacheHiresTextures)
     s_prefetcher = std::thread(Prefetch);
-  }
 }
 
 void HiresTexture::Prefetch()
@@ -145,11 +319,6 @@ void HiresTexture::Prefetch()
   Common::SetCurrentThreadName("Prefetcher");
 
   size_t size_sum = 0;
-  size_t sys_mem = Common::MemPhysical();
-  size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
   u32 starttime = Common::Timer::GetTimeMs();
   for (const auto& entry : s_textureMap)
   {
@@ -163,30 +332,22 @@ void HiresTexture::Prefetch()
       }
       std::unique_lock<std::mutex> lk(s_textureCacheMutex);
 
-      auto iter = s_textureCache.find(base_filename);
-      if (iter == s_textureCache.end())
+      if (s_textureCache.find(base_filename) == s_textureCache.end() &&
+          s_loading.find(base_filename) == s_loading.end())
       {
-        // unlock while loading a texture. This may result in a race condition where we'll load a
-        // texture twice,
-        // but it reduces the stuttering a lot. Notice: The loading library _must_ be thread safe
-        // now.
-        // But bad luck, SOIL isn't, so TODO: remove SOIL usage here and use libpng directly
-        // Also TODO: remove s_textureCacheAquireMutex afterwards. It won't be needed as the main
-        // mutex will be locked rarely
-        // lk.unlock();
-        std::unique_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
-        // lk.lock();
-        if (texture)
+        // Don't block the video thread while loading the texture. This may result in a race
+        // condition where we'll load a texture twice, but it reduces the stuttering a lot.
+        lk.unlock();
+        std::unique_ptr<HiresTexture> texture;
         {
-          std::shared_ptr<HiresTexture> ptr(std::move(texture));
-          iter = s_textureCache.insert(iter, std::make_pair(base_filename, ptr));
+          std::lock_guard<std::mutex> load_lk(s_textureLoadMutex);
+          texture = Load(base_filename, 0, 0);
         }
-      }
-      if (iter != s_textureCache.end())
-      {
-        for (const Level& l : iter->second->m_levels)
+        lk.lock();
+        if (texture)
         {
-          size_sum += l.data_size;
+          size_sum += GetTextureSize(texture.get());
+          InsertIntoCache(base_filename, std::move(texture));
         }
       }
     }
@@ -196,14 +357,14 @@ void HiresTexture::Prefetch()
       return;
     }
 
-    if (size_sum > max_mem)
+    // Prefetching more textures would start evicting the ones which were just loaded. The
+    // remaining ones are loaded when they are used instead.
+    if (size_sum > s_textureCacheBudget)
     {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
       OSD::AddMessage(
-          StringFromFormat(
-              "Custom Textures prefetching after %.1f MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
+          StringFromFormat("Custom Textures prefetching stopped after %.1f MB, not enough RAM "
+                           "available for the remaining textures",
+                           size_sum / (1024.0 * 1024.0)),
           10000);
       return;
     }
@@ -214,6 +375,40 @@ void HiresTexture::Prefetch()
                   10000);
 }
 
+void HiresTexture::LoaderThread()
+{
+  Common::SetCurrentThreadName("Custom texture loader");
+
+  std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  while (true)
+  {
+    s_loadQueueChanged.wait(
+        lk, [] { return !s_loadQueue.empty() || s_textureCacheAbortLoading.IsSet(); });
+    if (s_textureCacheAbortLoading.IsSet())
+      return;
+
+    const LoadRequest request = std::move(s_loadQueue.front());
+    s_loadQueue.pop_front();
+
+    lk.unlock();
+    std::shared_ptr<HiresTexture> texture;
+    {
+      std::lock_guard<std::mutex> load_lk(s_textureLoadMutex);
+      texture = Load(request.base_filename, request.width, request.height);
+    }
+    lk.lock();
+
+    InsertIntoCache(request.base_filename, std::move(texture));
+    s_loading.erase(request.base_filename);
+  }
+}
+
+bool HiresTexture::IsLoading(const std::string& base_filename)
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  return s_loading.find(base_filename) != s_loading.end();
+}
+
 std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                       size_t tlut_size, u32 width, u32 height, TextureFormat format,
                                       bool has_mipmaps, bool dump)
@@ -237,6 +432,11 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
       else
         return name;
     }
+    else if (s_texturePack && s_texturePack->Contains(name))
+    {
+      // Textures in a pack can't be renamed to the new format.
+      return name;
+    }
   }
 
   if (dump || s_check_new_format || convert)
@@ -357,11 +557,11 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
     }
 
     // try to match a wildcard template
-    if (!dump && s_textureMap.find(basename + "_*" + formatname) != s_textureMap.end())
+    if (!dump && HasTexture(basename + "_*" + formatname))
       return basename + "_*" + formatname;
 
     // else generate the complete texture
-    if (dump || s_textureMap.find(fullname) != s_textureMap.end())
+    if (dump || HasTexture(fullname))
       return fullname;
   }
 
@@ -386,25 +586,53 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
 std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t texture_size,
                                                    const u8* tlut, size_t tlut_size, u32 width,
                                                    u32 height, TextureFormat format,
-                                                   bool has_mipmaps)
+                                                   bool has_mipmaps,
+                                                   std::string* pending_basename)
 {
   std::string base_filename =
       GenBaseName(texture, texture_size, tlut, tlut_size, width, height, format, has_mipmaps);
 
+  // Textures from the pack don't have to be decoded, so they are neither cached nor loaded
+  // asynchronously.
+  if (s_textureMap.find(base_filename) == s_textureMap.end())
+    return LoadFromPack(base_filename);
+
   std::lock_guard<std::mutex> lk2(s_textureCacheAquireMutex);
-  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  std::unique_lock<std::mutex> lk(s_textureCacheMutex);
 
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
-    return iter->second;
+    s_textureCacheLRU.splice(s_textureCacheLRU.begin(), s_textureCacheLRU, iter->second.lru_iter);
+    return iter->second.texture;
   }
 
-  std::shared_ptr<HiresTexture> ptr(Load(base_filename, width, height));
+  if (g_ActiveConfig.bAsyncHiresTextures)
+  {
+    if (s_textureMap.find(base_filename) == s_textureMap.end())
+      return nullptr;
+
+    if (s_loading.insert(base_filename).second)
+    {
+      s_loadQueue.push_back({base_filename, width, height});
+      s_loadQueueChanged.notify_one();
+    }
+    if (pending_basename)
+      *pending_basename = base_filename;
+    return nullptr;
+  }
+
+  lk.unlock();
+  std::shared_ptr<HiresTexture> ptr;
+  {
+    std::lock_guard<std::mutex> load_lk(s_textureLoadMutex);
+    ptr = Load(base_filename, width, height);
+  }
+  lk.lock();
 
   if (ptr && g_ActiveConfig.bCacheHiresTextures)
   {
-    s_textureCache[base_filename] = ptr;
+    InsertIntoCache(base_filename, ptr);
   }
 
   return ptr;
@@ -412,10 +640,17 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t tex
 
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
                                                  u32 height)
+{
+  return Load(s_textureMap, base_filename, width, height);
+}
+
+std::unique_ptr<HiresTexture>
+HiresTexture::Load(const std::unordered_map<std::string, std::string>& texture_map,
+                   const std::string& base_filename, u32 width, u32 height)
 {
   // We need to have a level 0 custom texture to even consider loading.
-  auto filename_iter = s_textureMap.find(base_filename);
-  if (filename_iter == s_textureMap.end())
+  auto filename_iter = texture_map.find(base_filename);
+  if (filename_iter == texture_map.end())
     return nullptr;
 
   // Try to load level 0 (and any mipmaps) from a DDS file.
@@ -432,8 +667,8 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     if (mip_level != 0)
       filename += StringFromFormat("_mip%u", mip_level);
 
-    filename_iter = s_textureMap.find(filename);
-    if (filename_iter == s_textureMap.end())
+    filename_iter = texture_map.find(filename);
+    if (filename_iter == texture_map.end())
       break;
 
     // Try loading DDS textures first, that way we maintain compression of DXT formats.
@@ -520,6 +755,83 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   return ret;
 }
 
+std::unique_ptr<HiresTexture> HiresTexture::LoadFromPack(const std::string& base_filename)
+{
+  std::vector<HiresTexturePack::Level> pack_levels;
+  if (!s_texturePack || !s_texturePack->GetLevels(base_filename, &pack_levels))
+    return nullptr;
+
+  // The pack may have been created on a system whose GPU supports more formats.
+  const AbstractTextureFormat format = pack_levels[0].format;
+  if ((format == AbstractTextureFormat::BPTC &&
+       !g_ActiveConfig.backend_info.bSupportsBPTCTextures) ||
+      (format != AbstractTextureFormat::RGBA8 && format != AbstractTextureFormat::BPTC &&
+       !g_ActiveConfig.backend_info.bSupportsST3CTextures))
+  {
+    ERROR_LOG(VIDEO, "Custom texture %s uses a compressed format which isn't supported.",
+              base_filename.c_str());
+    return nullptr;
+  }
+
+  // The levels were already verified when the pack was created, and their data is uploaded
+  // straight from the mapped file.
+  std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
+  ret->m_pack = s_texturePack;
+  for (const HiresTexturePack::Level& pack_level : pack_levels)
+  {
+    Level level;
+    level.data = ImageDataPointer(const_cast<u8*>(pack_level.data), [](unsigned char*) {});
+    level.format = pack_level.format;
+    level.width = pack_level.width;
+    level.height = pack_level.height;
+    level.row_length = pack_level.row_length;
+    level.data_size = pack_level.data_size;
+    ret->m_levels.push_back(std::move(level));
+  }
+
+  return ret;
+}
+
+bool HiresTexture::CreateTexturePack(const std::string& texture_directory,
+                                     const std::string& pack_filename)
+{
+  std::unordered_map<std::string, std::string> texture_map;
+  for (const std::string& filename : FindTextureFiles(texture_directory))
+  {
+    std::string name;
+    SplitPath(filename, nullptr, &name, nullptr);
+    texture_map[name] = filename;
+  }
+
+  HiresTexturePackWriter writer;
+  if (!writer.Open(pack_filename))
+    return false;
+
+  for (const auto& entry : texture_map)
+  {
+    // Mipmaps are stored together with their first level.
+    if (entry.first.find("_mip") != std::string::npos)
+      continue;
+
+    // The size of the native texture is unknown here, so it can only be checked when loading
+    // loose texture files.
+    std::unique_ptr<HiresTexture> texture = Load(texture_map, entry.first, 0, 0);
+    if (!texture)
+      continue;
+
+    std::vector<HiresTexturePack::Level> levels;
+    for (const Level& level : texture->m_levels)
+    {
+      levels.push_back({level.format, level.width, level.height, level.row_length,
+                        level.data.get(), level.data_size});
+    }
+    if (!writer.AddTexture(entry.first, levels))
+      return false;
+  }
+
+  return writer.Finish();
+}
+
 bool HiresTexture::LoadTexture(Level& level, const std::vector<u8>& buffer)
 {
   int channels;
@@ -552,6 +864,17 @@ std::string HiresTexture::GetTextureDirectory(const std::string& game_id)
   return texture_directory;
 }
 
+std::string HiresTexture::GetTexturePackFilename(const std::string& game_id)
+{
+  const std::string pack_filename = File::GetUserPath(D_HIRESTEXTURES_IDX) + game_id + ".texpack";
+
+  // Same as for the texture directory, fall back to the region-free ID
+  if (!File::Exists(pack_filename))
+    return File::GetUserPath(D_HIRESTEXTURES_IDX) + game_id.substr(0, 3) + ".texpack";
+
+  return pack_filename;
+}
+
 HiresTexture::~HiresTexture()
 {
 }
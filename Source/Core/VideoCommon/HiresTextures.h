@@ -6,11 +6,13 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoCommon/TextureConfig.h"
 
+class HiresTexturePack;
 enum class TextureFormat;
 
 class HiresTexture
@@ -22,9 +24,19 @@ public:
   static void Update();
   static void Shutdown();
 
+  // Starts looking for the custom textures of the given game on the shared thread pool, so that
+  // the directory scan overlaps the rest of the boot. Update() uses the result if it is still
+  // looking for textures in the same directory by then.
+  static void StartIndexing(const std::string& game_id);
+
+  // Returns nullptr if there is no custom texture, or if it is still being loaded asynchronously.
+  // In the latter case, its name is written to pending_basename, so that the caller can check
+  // whether it has finished loading with IsLoading().
   static std::shared_ptr<HiresTexture> Search(const u8* texture, size_t texture_size,
                                               const u8* tlut, size_t tlut_size, u32 width,
-                                              u32 height, TextureFormat format, bool has_mipmaps);
+                                              u32 height, TextureFormat format, bool has_mipmaps,
+                                              std::string* pending_basename = nullptr);
+  static bool IsLoading(const std::string& base_filename);
 
   static std::string GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                  size_t tlut_size, u32 width, u32 height, TextureFormat format,
@@ -32,6 +44,12 @@ public:
 
   static u32 CalculateMipCount(u32 width, u32 height);
 
+  // Packs all custom textures in the directory into a single file, which is used instead of the
+  // loose texture files when it is named after the game ID and placed next to its texture
+  // directory. Textures which can't be loaded are skipped.
+  static bool CreateTexturePack(const std::string& texture_directory,
+                                const std::string& pack_filename);
+
   ~HiresTexture();
 
   AbstractTextureFormat GetFormat() const;
@@ -51,12 +69,22 @@ public:
 private:
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
                                             u32 height);
+  static std::unique_ptr<HiresTexture>
+  Load(const std::unordered_map<std::string, std::string>& texture_map,
+       const std::string& base_filename, u32 width, u32 height);
+  static std::unique_ptr<HiresTexture> LoadFromPack(const std::string& base_filename);
   static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
   static bool LoadDDSTexture(Level& level, const std::string& filename);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
   static void Prefetch();
+  static void LoaderThread();
+  static void StopLoading();
 
   static std::string GetTextureDirectory(const std::string& game_id);
+  static std::string GetTexturePackFilename(const std::string& game_id);
 
   HiresTexture() {}
+
+  // Keeps the memory mapping alive for textures whose levels point into a texture pack.
+  std::shared_ptr<const HiresTexturePack> m_pack;
 };
@@ -2,7 +2,12 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -10,6 +15,7 @@
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/ThreadPool.h"
 #include "VideoCommon/ImageWrite.h"
 #include "png.h"
 
@@ -35,7 +41,7 @@ data      : This is an array of RGBA with 8 bits per channel. 4 bytes for each p
 row_stride: Determines the amount of bytes per row of pixels.
 */
 bool TextureToPng(const u8* data, int row_stride, const std::string& filename, int width,
-                  int height, bool saveAlpha)
+                  int height, bool saveAlpha, int compression_level)
 {
   if (!data)
     return false;
@@ -89,6 +95,8 @@ bool TextureToPng(const u8* data, int row_stride, const std::string& filename, i
   // Begin region which may call longjmp
 
   png_init_io(png_ptr, fp.GetHandle());
+  if (compression_level >= 0)
+    png_set_compression_level(png_ptr, std::min(compression_level, 9));
 
   // Write header (8 bit color depth)
   png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
@@ -144,3 +152,55 @@ finalise:
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+
+namespace
+{
+// Enough for a few dozen large textures, so that a burst of dumps doesn't stall, but not so
+// much that dumping a whole texture pack can use up the host's memory.
+constexpr size_t MAX_PENDING_BYTES = 64 * 1024 * 1024;
+
+std::mutex s_pending_mutex;
+std::condition_variable s_pending_cv;
+size_t s_pending_bytes = 0;
+size_t s_pending_images = 0;
+}  // Anonymous namespace
+
+void TextureToPngAsync(const u8* data, int row_stride, const std::string& filename, int width,
+                       int height, bool saveAlpha, int compression_level)
+{
+  if (!data)
+    return;
+
+  // Only copy the pixels of each row, and not the padding of the source.
+  const size_t packed_stride = static_cast<size_t>(width) * 4;
+  const size_t size = packed_stride * height;
+  {
+    // A single image which is larger than the limit is still let through on its own.
+    std::unique_lock<std::mutex> lk(s_pending_mutex);
+    s_pending_cv.wait(lk, [&] {
+      return s_pending_images == 0 || s_pending_bytes + size <= MAX_PENDING_BYTES;
+    });
+    s_pending_bytes += size;
+    ++s_pending_images;
+  }
+
+  auto buffer = std::make_shared<std::vector<u8>>(size);
+  for (int y = 0; y < height; ++y)
+    std::memcpy(buffer->data() + y * packed_stride, data + y * row_stride, packed_stride);
+
+  Common::ThreadPool::Submit(Common::TaskPriority::Normal, [=] {
+    TextureToPng(buffer->data(), static_cast<int>(packed_stride), filename, width, height,
+                 saveAlpha, compression_level);
+
+    std::lock_guard<std::mutex> lk(s_pending_mutex);
+    s_pending_bytes -= size;
+    --s_pending_images;
+    s_pending_cv.notify_all();
+  });
+}
+
+void FlushPngWrites()
+{
+  std::unique_lock<std::mutex> lk(s_pending_mutex);
+  s_pending_cv.wait(lk, [] { return s_pending_images == 0; });
+}
@@ -8,5 +8,17 @@
 #include "Common/CommonTypes.h"
 
 bool SaveData(const std::string& filename, const std::string& data);
+
+// compression_level is the zlib level, from 0 (store) to 9 (smallest), or -1 for the default.
+// The fast levels are several times quicker than the default, for files which are a bit larger.
 bool TextureToPng(const u8* data, int row_stride, const std::string& filename, int width,
-                  int height, bool saveAlpha = true);
+                  int height, bool saveAlpha = true, int compression_level = -1);
+
+// Like TextureToPng, but encodes and writes the image on a thread of the shared thread pool. The
+// data is copied, so the caller can reuse its buffer straight away. If the images which are still
+// waiting to be written take too much memory, this blocks until enough of them are done.
+void TextureToPngAsync(const u8* data, int row_stride, const std::string& filename, int width,
+                       int height, bool saveAlpha = true, int compression_level = -1);
+
+// Waits until all of the images passed to TextureToPngAsync have been written.
+void FlushPngWrites();
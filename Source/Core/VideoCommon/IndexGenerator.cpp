@@ -1,7 +1,4 @@
-// Copyright 2008 Dolphin Emulator Project
-// Licensed under GPLv2+
-// Refer to the license.txt file included.
-
+#include <array>
 #include <cstddef>
 
 #include "Common/Common.h"
@@ -11,6 +8,10 @@
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
 
+#ifdef _M_X86
+#include <emmintrin.h>
+#endif
+
 // Init
 u16* IndexGenerator::index_buffer_current;
 u16* IndexGenerator::BASEIptr;
@@ -18,6 +19,124 @@ u32 IndexGenerator::base_index;
 
 static const u16 s_primitive_restart = UINT16_MAX;
 
+namespace
+{
+// Entries of an index group which aren't an offset from the first vertex of the group.
+constexpr u16 GROUP_RESTART = 0xFFFF;
+constexpr u16 GROUP_CENTER = 0xFFFE;
+
+constexpr size_t GroupsPerRun(size_t group_size)
+{
+  return group_size % 8 == 0 ? 1 : group_size % 4 == 0 ? 2 : group_size % 2 == 0 ? 4 : 8;
+}
+
+// The indices written for each primitive (or few primitives), each copy starting step vertices
+// after the previous one. GROUP_CENTER stands for the center vertex of a fan. For SSE2, enough
+// copies to fill whole vectors are laid out once up front.
+template <size_t N>
+struct IndexGroup
+{
+  IndexGroup(const std::array<u16, N>& entries_, u32 step_) : entries(entries_), step(step_)
+  {
+#ifdef _M_X86
+    alignas(16) std::array<u16, 8 * NUM_VECTORS> lanes[4];
+    for (size_t i = 0; i < 8 * NUM_VECTORS; ++i)
+    {
+      const u16 entry = entries[i % N];
+      const bool restart = entry == GROUP_RESTART;
+      const bool center = entry == GROUP_CENTER;
+      lanes[0][i] = restart || center ? 0 : static_cast<u16>(entry + (i / N) * step);
+      lanes[1][i] = restart || center ? 0xFFFF : 0;
+      lanes[2][i] = restart ? 0xFFFF : 0;
+      lanes[3][i] = center ? 0xFFFF : 0;
+    }
+    for (size_t v = 0; v < NUM_VECTORS; ++v)
+    {
+      offsets[v] = _mm_load_si128(reinterpret_cast<const __m128i*>(&lanes[0][v * 8]));
+      fixed_mask[v] = _mm_load_si128(reinterpret_cast<const __m128i*>(&lanes[1][v * 8]));
+      restart_mask[v] = _mm_load_si128(reinterpret_cast<const __m128i*>(&lanes[2][v * 8]));
+      center_mask[v] = _mm_load_si128(reinterpret_cast<const __m128i*>(&lanes[3][v * 8]));
+    }
+#endif
+  }
+
+  std::array<u16, N> entries;
+  u32 step;
+
+#ifdef _M_X86
+  static constexpr size_t GROUPS_PER_RUN = GroupsPerRun(N);
+  static constexpr size_t NUM_VECTORS = N * GROUPS_PER_RUN / 8;
+  __m128i offsets[NUM_VECTORS];
+  __m128i fixed_mask[NUM_VECTORS];
+  __m128i restart_mask[NUM_VECTORS];
+  __m128i center_mask[NUM_VECTORS];
+#endif
+};
+
+// Writes num_groups copies of the group. Whole runs of vectors are generated with SSE2, the rest
+// one index at a time.
+template <size_t N>
+u16* WriteGroups(u16* Iptr, const IndexGroup<N>& group, u32 num_groups, u32 first_vertex,
+                 u32 center)
+{
+  u32 g = 0;
+
+#ifdef _M_X86
+  constexpr size_t GROUPS_PER_RUN = IndexGroup<N>::GROUPS_PER_RUN;
+  constexpr size_t NUM_VECTORS = IndexGroup<N>::NUM_VECTORS;
+  if (num_groups >= GROUPS_PER_RUN)
+  {
+    __m128i fixed[NUM_VECTORS];
+    const __m128i center_vec = _mm_set1_epi16(static_cast<s16>(center));
+    for (size_t v = 0; v < NUM_VECTORS; ++v)
+    {
+      const __m128i center_lanes = _mm_and_si128(group.center_mask[v], center_vec);
+      fixed[v] = _mm_or_si128(group.restart_mask[v], center_lanes);
+    }
+
+    __m128i base = _mm_set1_epi16(static_cast<s16>(first_vertex));
+    const __m128i run_step = _mm_set1_epi16(static_cast<s16>(group.step * GROUPS_PER_RUN));
+    for (; g + GROUPS_PER_RUN <= num_groups; g += GROUPS_PER_RUN)
+    {
+      for (size_t v = 0; v < NUM_VECTORS; ++v)
+      {
+        const __m128i indices = _mm_add_epi16(base, group.offsets[v]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Iptr),
+                         _mm_or_si128(_mm_andnot_si128(group.fixed_mask[v], indices), fixed[v]));
+        Iptr += 8;
+      }
+      base = _mm_add_epi16(base, run_step);
+    }
+  }
+#endif
+
+  for (; g < num_groups; ++g)
+  {
+    const u32 group_first_vertex = first_vertex + g * group.step;
+    for (u16 entry : group.entries)
+    {
+      if (entry == GROUP_RESTART)
+        *Iptr++ = s_primitive_restart;
+      else if (entry == GROUP_CENTER)
+        *Iptr++ = center;
+      else
+        *Iptr++ = group_first_vertex + entry;
+    }
+  }
+  return Iptr;
+}
+
+const IndexGroup<4> s_triangle_list_pr({{0, 1, 2, GROUP_RESTART}}, 3);
+const IndexGroup<1> s_sequence({{0}}, 1);
+const IndexGroup<6> s_strip_pair({{0, 1, 2, 1, 3, 2}}, 2);
+const IndexGroup<6> s_fan_strip_pr({{0, 1, GROUP_CENTER, 2, 3, GROUP_RESTART}}, 3);
+const IndexGroup<3> s_fan_triangle({{GROUP_CENTER, 0, 1}}, 1);
+const IndexGroup<5> s_quad_pr({{1, 2, 0, 3, GROUP_RESTART}}, 4);
+const IndexGroup<6> s_quad({{0, 1, 2, 0, 2, 3}}, 4);
+const IndexGroup<2> s_line_list({{0, 1}}, 2);
+const IndexGroup<2> s_line_strip({{0, 1}}, 1);
+}  // Anonymous namespace
+
 static u16* (*primitive_table[8])(u16*, u32, u32);
 
 void IndexGenerator::Init()
@@ -71,11 +190,10 @@ __forceinline u16* IndexGenerator::WriteTriangle(u16* Iptr, u32 index1, u32 inde
 template <bool pr>
 u16* IndexGenerator::AddList(u16* Iptr, u32 const numVerts, u32 index)
 {
-  for (u32 i = 2; i < numVerts; i += 3)
-  {
-    Iptr = WriteTriangle<pr>(Iptr, index + i - 2, index + i - 1, index + i);
-  }
-  return Iptr;
+  if (pr)
+    return WriteGroups(Iptr, s_triangle_list_pr, numVerts / 3, index, index);
+  else
+    return WriteGroups(Iptr, s_sequence, numVerts / 3 * 3, index, index);
 }
 
 template <bool pr>
@@ -83,16 +201,22 @@ u16* IndexGenerator::AddStrip(u16* Iptr, u32 const numVerts, u32 index)
 {
   if (pr)
   {
-    for (u32 i = 0; i < numVerts; ++i)
-    {
-      *Iptr++ = index + i;
-    }
+    Iptr = WriteGroups(Iptr, s_sequence, numVerts, index, index);
     *Iptr++ = s_primitive_restart;
   }
   else
   {
+    // Pairs of triangles, the second one with the other winding.
+    u32 i = 2;
+    if (numVerts >= 4)
+    {
+      const u32 num_pairs = (numVerts - 2) / 2;
+      Iptr = WriteGroups(Iptr, s_strip_pair, num_pairs, index, index);
+      i += num_pairs * 2;
+    }
+
     bool wind = false;
-    for (u32 i = 2; i < numVerts; ++i)
+    for (; i < numVerts; ++i)
     {
       Iptr = WriteTriangle<pr>(Iptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -128,14 +252,11 @@ u16* IndexGenerator::AddFan(u16* Iptr, u32 numVerts, u32 index)
 
   if (pr)
   {
-    for (; i + 3 <= numVerts; i += 3)
+    if (numVerts >= 5)
     {
-      *Iptr++ = index + i - 1;
-      *Iptr++ = index + i + 0;
-      *Iptr++ = index;
-      *Iptr++ = index + i + 1;
-      *Iptr++ = index + i + 2;
-      *Iptr++ = s_primitive_restart;
+      const u32 num_groups = (numVerts - 2) / 3;
+      Iptr = WriteGroups(Iptr, s_fan_strip_pr, num_groups, index + 1, index);
+      i += num_groups * 3;
     }
 
     for (; i + 2 <= numVerts; i += 2)
@@ -147,6 +268,11 @@ u16* IndexGenerator::AddFan(u16* Iptr, u32 numVerts, u32 index)
       *Iptr++ = s_primitive_restart;
     }
   }
+  else if (numVerts >= 3)
+  {
+    Iptr = WriteGroups(Iptr, s_fan_triangle, numVerts - 2, index + 1, index);
+    i = numVerts;
+  }
 
   for (; i < numVerts; ++i)
   {
@@ -175,26 +301,14 @@ u16* IndexGenerator::AddFan(u16* Iptr, u32 numVerts, u32 index)
 template <bool pr>
 u16* IndexGenerator::AddQuads(u16* Iptr, u32 numVerts, u32 index)
 {
-  u32 i = 3;
-  for (; i < numVerts; i += 4)
-  {
-    if (pr)
-    {
-      *Iptr++ = index + i - 2;
-      *Iptr++ = index + i - 1;
-      *Iptr++ = index + i - 3;
-      *Iptr++ = index + i - 0;
-      *Iptr++ = s_primitive_restart;
-    }
-    else
-    {
-      Iptr = WriteTriangle<pr>(Iptr, index + i - 3, index + i - 2, index + i - 1);
-      Iptr = WriteTriangle<pr>(Iptr, index + i - 3, index + i - 1, index + i - 0);
-    }
-  }
+  const u32 num_quads = numVerts / 4;
+  if (pr)
+    Iptr = WriteGroups(Iptr, s_quad_pr, num_quads, index, index);
+  else
+    Iptr = WriteGroups(Iptr, s_quad, num_quads, index, index);
 
   // three vertices remaining, so render a triangle
-  if (i == numVerts)
+  if (numVerts % 4 == 3)
   {
     Iptr =
         WriteTriangle<pr>(Iptr, index + numVerts - 3, index + numVerts - 2, index + numVerts - 1);
@@ -212,34 +326,22 @@ u16* IndexGenerator::AddQuads_nonstandard(u16* Iptr, u32 numVerts, u32 index)
 // Lines
 u16* IndexGenerator::AddLineList(u16* Iptr, u32 numVerts, u32 index)
 {
-  for (u32 i = 1; i < numVerts; i += 2)
-  {
-    *Iptr++ = index + i - 1;
-    *Iptr++ = index + i;
-  }
-  return Iptr;
+  return WriteGroups(Iptr, s_line_list, numVerts / 2, index, index);
 }
 
 // shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
 u16* IndexGenerator::AddLineStrip(u16* Iptr, u32 numVerts, u32 index)
 {
-  for (u32 i = 1; i < numVerts; ++i)
-  {
-    *Iptr++ = index + i - 1;
-    *Iptr++ = index + i;
-  }
-  return Iptr;
+  if (numVerts < 2)
+    return Iptr;
+  return WriteGroups(Iptr, s_line_strip, numVerts - 1, index, index);
 }
 
 // Points
 u16* IndexGenerator::AddPoints(u16* Iptr, u32 numVerts, u32 index)
 {
-  for (u32 i = 0; i != numVerts; ++i)
-  {
-    *Iptr++ = index + i;
-  }
-  return Iptr;
+  return WriteGroups(Iptr, s_sequence, numVerts, index, index);
 }
 
 u32 IndexGenerator::GetRemainingIndices()
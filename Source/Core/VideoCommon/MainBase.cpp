@@ -12,6 +12,7 @@
 #include "Core/Host.h"
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPStructs.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Fifo.h"
@@ -86,6 +87,10 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 Inpu
   }
   else
   {
+    // In deterministic GPU thread mode, the GPU thread must have caught up with everything the CPU
+    // sent before the peek, or what it reads would depend on how far it got.
+    Fifo::SyncGPU(Fifo::SyncGPUReason::EFBPeek);
+
     AsyncRequests::Event e;
     u32 result;
     e.type = type == EFBAccessType::PeekColor ? AsyncRequests::Event::EFB_PEEK_COLOR :
@@ -106,6 +111,11 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
+  // The counters of the previous period are read while the GPU thread carries on, so their
+  // queries are resolved whenever they complete rather than when the CPU reads them.
+  if (g_perf_query->ShouldDelayResults())
+    return g_perf_query->GetQueryResult(type);
+
   Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
   AsyncRequests::Event e;
@@ -141,13 +151,24 @@ u16 VideoBackendBase::Video_GetBoundingBox(int index)
     return 0;
   }
 
-  Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
-
   AsyncRequests::Event e;
-  u16 result;
   e.time = 0;
   e.type = AsyncRequests::Event::BBOX_READ;
   e.bbox.index = index;
+
+  // Let the GPU thread read the bounding box back when it gets to the request, and return what it
+  // read for the last one rather than waiting for it. Not in deterministic GPU thread mode, where
+  // the value must only depend on the commands before the read.
+  if (g_ActiveConfig.bBBoxDeferReadback && !Fifo::UseDeterministicGPUThread())
+  {
+    e.bbox.data = nullptr;
+    AsyncRequests::GetInstance()->PushEvent(e, false);
+    return BoundingBox::GetLastReadValue(index);
+  }
+
+  Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
+
+  u16 result;
   e.bbox.data = &result;
   AsyncRequests::GetInstance()->PushEvent(e, true);
 
@@ -204,6 +225,7 @@ void VideoBackendBase::ShutdownShared()
   m_initialized = false;
 
   Fifo::Shutdown();
+  OpcodeDecoder::Shutdown();
 }
 
 void VideoBackendBase::CleanupShared()
@@ -223,6 +245,16 @@ void VideoBackendBase::DoState(PointerWrap& p)
     p.SetMode(PointerWrap::MODE_VERIFY);
   }
 
+  // The GPU thread is paused while the state is saved or loaded. Deferred EFB copies have to be in
+  // RAM before it is saved, and must not overwrite it once it has been loaded.
+  if (g_texture_cache)
+  {
+    if (p.GetMode() == PointerWrap::MODE_READ)
+      g_texture_cache->DiscardEFBCopies();
+    else
+      g_texture_cache->FlushEFBCopies();
+  }
+
   VideoCommon_DoState(p);
   p.DoMarker("VideoCommon");
 
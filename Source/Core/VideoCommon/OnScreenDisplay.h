@@ -24,6 +24,8 @@ enum class MessageType
 {
   NetPlayPing,
   NetPlayBuffer,
+  NetPlayStall,
+  AudioStatistics,
 
   // This entry must be kept last so that persistent typed messages are
   // displayed before other messages
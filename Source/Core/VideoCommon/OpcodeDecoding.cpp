@@ -15,9 +15,23 @@
 // when they are called. The reason is that the vertex format affects the sizes of the vertices.
 
 #include "VideoCommon/OpcodeDecoding.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
+#include "Common/MPSCQueue.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
+#include "Core/ConfigManager.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
 #include "VideoCommon/BPMemory.h"
@@ -36,6 +50,426 @@ namespace OpcodeDecoder
 {
 static bool s_bFifoErrorSeen = false;
 
+namespace
+{
+// A command packet found by the decoder stage. The executor reads the arguments from the stream
+// itself; what it needs from the decoder is where each packet is and how long it is, which for
+// vertex batches depends on the vertex formats set up by the preceding packets.
+struct DecodedCommand
+{
+  enum class Type : u8
+  {
+    // Commands which only take up cycles.
+    Skip,
+    CPReg,
+    XFReg,
+    IndexedXF,
+    BPReg,
+    Vertices,
+    BeginDisplayList,
+    EndDisplayList,
+    Unknown,
+    // The end of the stream. start points to the first byte which couldn't be decoded, and size
+    // holds the cycles of the whole stream.
+    End,
+  };
+
+  u8* start;
+  u32 size;
+  Type type;
+};
+
+// Finds the commands of a stream without executing them, and passes each to emit(type, start,
+// size). CP register loads are applied to the given state, which must start out as the CP state
+// the stream would be executed with. This must stay in sync with Run() below.
+template <typename EmitFunc>
+u8* DecodeStream(DataReader src, bool in_display_list, CPState* cp_state, u32* cycles,
+                 EmitFunc emit)
+{
+  u32 total_cycles = 0;
+  u8* opcode_start;
+  while (true)
+  {
+    opcode_start = src.GetPointer();
+    if (!src.size())
+      break;
+
+    const u8 cmd_byte = src.Read<u8>();
+    switch (cmd_byte)
+    {
+    case GX_NOP:
+    case GX_UNKNOWN_RESET:
+    case GX_CMD_UNKNOWN_METRICS:
+    case GX_CMD_INVL_VC:
+      total_cycles += 6;
+      emit(DecodedCommand::Type::Skip, opcode_start, 1);
+      continue;
+
+    case GX_LOAD_CP_REG:
+    {
+      if (src.size() < 1 + 4)
+        break;
+      total_cycles += 12;
+      const u8 sub_cmd = src.Read<u8>();
+      const u32 value = src.Read<u32>();
+      LoadCPReg(sub_cmd, value, cp_state);
+      emit(DecodedCommand::Type::CPReg, opcode_start, 1 + 1 + 4);
+      continue;
+    }
+
+    case GX_LOAD_XF_REG:
+    {
+      if (src.size() < 4)
+        break;
+      const u32 transfer_size = ((src.Read<u32>() >> 16) & 15) + 1;
+      if (src.size() < transfer_size * sizeof(u32))
+        break;
+      total_cycles += 18 + 6 * transfer_size;
+      src.Skip<u32>(transfer_size);
+      emit(DecodedCommand::Type::XFReg, opcode_start, 1 + 4 + transfer_size * 4);
+      continue;
+    }
+
+    case GX_LOAD_INDX_A:
+    case GX_LOAD_INDX_B:
+    case GX_LOAD_INDX_C:
+    case GX_LOAD_INDX_D:
+      if (src.size() < 4)
+        break;
+      total_cycles += 6;
+      src.Skip<u32>();
+      emit(DecodedCommand::Type::IndexedXF, opcode_start, 1 + 4);
+      continue;
+
+    case GX_CMD_CALL_DL:
+    {
+      if (src.size() < 8)
+        break;
+      const u32 address = src.Read<u32>();
+      const u32 count = src.Read<u32>();
+      total_cycles += 6;
+      if (in_display_list)
+      {
+        INFO_LOG(VIDEO, "recursive display list detected");
+        continue;
+      }
+
+      // Display lists are decoded in place, so the executor runs through them as part of
+      // this stream.
+      u8* start_address = Memory::GetPointer(address);
+      if (start_address)
+      {
+        u32 display_list_cycles = 0;
+        emit(DecodedCommand::Type::BeginDisplayList, start_address, 0);
+        DecodeStream(DataReader(start_address, start_address + count), true, cp_state,
+                     &display_list_cycles, emit);
+        emit(DecodedCommand::Type::EndDisplayList, start_address, 0);
+        total_cycles += display_list_cycles;
+      }
+      continue;
+    }
+
+    case GX_LOAD_BP_REG:
+      if (src.size() < 4)
+        break;
+      total_cycles += 12;
+      src.Skip<u32>();
+      emit(DecodedCommand::Type::BPReg, opcode_start, 1 + 4);
+      continue;
+
+    default:
+      if ((cmd_byte & 0xC0) == 0x80)
+      {
+        if (src.size() < 2)
+          break;
+        const u16 num_vertices = src.Read<u16>();
+        const u32 bytes =
+            num_vertices ?
+                num_vertices * VertexLoaderManager::GetVertexSize(cmd_byte & GX_VAT_MASK,
+                                                                  cp_state) :
+                0;
+        if (src.size() < bytes)
+          break;
+        src.Skip(bytes);
+        total_cycles += num_vertices * 4 * 3 + 6;
+        emit(DecodedCommand::Type::Vertices, opcode_start, 1 + 2 + bytes);
+      }
+      else
+      {
+        total_cycles += 1;
+        emit(DecodedCommand::Type::Unknown, opcode_start, 1);
+      }
+      continue;
+    }
+
+    // Only reached if the command is incomplete.
+    break;
+  }
+
+  *cycles = total_cycles;
+  return opcode_start;
+}
+
+// Decodes command streams on a separate thread, so that parsing (including the display lists
+// they call) overlaps with the execution of the commands decoded so far on the GPU thread.
+//
+// The decoder keeps its own copy of the CP state, taken from the main state when a stream is
+// handed to it, so that it knows the vertex sizes without waiting for the executor. Vertex
+// loading itself stays on the executing thread, since the vertex loaders write straight into the
+// backend's vertex buffer and depend on global state like the cached array pointers.
+class DecoderThread final
+{
+public:
+  DecoderThread() : m_thread(&DecoderThread::ThreadLoop, this) {}
+  ~DecoderThread()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_exit = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+  }
+
+  void Decode(DataReader src, bool in_display_list)
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_cp_state = g_main_cp_state;
+      m_stream = src;
+      m_in_display_list = in_display_list;
+      m_has_stream = true;
+    }
+    m_cv.notify_one();
+  }
+
+  DecodedCommand Next()
+  {
+    DecodedCommand command;
+    while (!m_commands.Pop(command))
+      std::this_thread::yield();
+    return command;
+  }
+
+private:
+  void ThreadLoop()
+  {
+    Common::SetCurrentThreadName("FIFO decoder");
+
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+      m_cv.wait(lk, [this] { return m_has_stream || m_exit; });
+      if (m_exit)
+        return;
+
+      m_has_stream = false;
+      u32 cycles = 0;
+      u8* end = DecodeStream(m_stream, m_in_display_list, &m_cp_state, &cycles,
+                             [this](DecodedCommand::Type type, u8* start, u32 size) {
+                               Emit(type, start, size);
+                             });
+      Emit(DecodedCommand::Type::End, end, cycles);
+    }
+  }
+
+  void Emit(DecodedCommand::Type type, u8* start, u32 size)
+  {
+    while (!m_commands.Push(DecodedCommand{start, size, type}))
+      std::this_thread::yield();
+  }
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_has_stream = false;
+  bool m_exit = false;
+
+  DataReader m_stream;
+  bool m_in_display_list = false;
+  CPState m_cp_state;
+
+  Common::MPSCQueue<DecodedCommand, 4096> m_commands;
+};
+
+// Smaller streams aren't worth the handoff to the decoder thread.
+constexpr size_t MIN_PIPELINED_STREAM_SIZE = 4096;
+
+std::unique_ptr<DecoderThread> s_decoder_thread;
+}  // Anonymous namespace
+
+// Executes a command found by DecodeStream(), other than the end of the stream.
+static void ExecuteCommand(const DecodedCommand& command, bool in_display_list)
+{
+  DataReader args(command.start + 1, command.start + command.size);
+  const u8 cmd_byte = *command.start;
+  TRACE_EVENT(FifoCommand, cmd_byte, in_display_list);
+  switch (command.type)
+  {
+  case DecodedCommand::Type::Skip:
+    break;
+
+  case DecodedCommand::Type::CPReg:
+  {
+    const u8 sub_cmd = args.Read<u8>();
+    LoadCPReg(sub_cmd, args.Read<u32>());
+    INCSTAT(stats.thisFrame.numCPLoads);
+    break;
+  }
+
+  case DecodedCommand::Type::XFReg:
+  {
+    const u32 cmd2 = args.Read<u32>();
+    LoadXFReg(((cmd2 >> 16) & 15) + 1, cmd2 & 0xFFFF, args);
+    INCSTAT(stats.thisFrame.numXFLoads);
+    break;
+  }
+
+  case DecodedCommand::Type::IndexedXF:
+    LoadIndexedXF(args.Read<u32>(), 0xC + ((cmd_byte - GX_LOAD_INDX_A) >> 3));
+    break;
+
+  case DecodedCommand::Type::BPReg:
+    LoadBPReg(args.Read<u32>());
+    INCSTAT(stats.thisFrame.numBPLoads);
+    break;
+
+  case DecodedCommand::Type::Vertices:
+  {
+    const u16 num_vertices = args.Read<u16>();
+    if (VertexLoaderManager::RunVertices(cmd_byte & GX_VAT_MASK,
+                                         (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT,
+                                         num_vertices, args, false) < 0)
+    {
+      ERROR_LOG(VIDEO, "FIFO decoder got the size of a vertex batch wrong");
+    }
+    break;
+  }
+
+  case DecodedCommand::Type::BeginDisplayList:
+    // temporarily swap dl and non-dl (small "hack" for the stats)
+    Statistics::SwapDL();
+    return;
+
+  case DecodedCommand::Type::EndDisplayList:
+    INCSTAT(stats.thisFrame.numDListsCalled);
+    Statistics::SwapDL();
+    return;
+
+  case DecodedCommand::Type::Unknown:
+    if (!s_bFifoErrorSeen)
+      CommandProcessor::HandleUnknownOpcode(cmd_byte, command.start, false);
+    ERROR_LOG(VIDEO, "FIFO: Unknown Opcode(0x%02x @ %p, preprocessing = no)", cmd_byte,
+              command.start);
+    s_bFifoErrorSeen = true;
+    break;
+
+  case DecodedCommand::Type::End:
+    break;
+  }
+
+  if (g_bRecordFifoData)
+    FifoRecorder::GetInstance().WriteGPCommand(command.start, command.size);
+}
+
+static u8* RunPipelined(DataReader src, u32* cycles, bool in_display_list)
+{
+  s_decoder_thread->Decode(src, in_display_list);
+
+  while (true)
+  {
+    const DecodedCommand command = s_decoder_thread->Next();
+    if (command.type == DecodedCommand::Type::End)
+    {
+      if (cycles)
+        *cycles = command.size;
+      return command.start;
+    }
+    ExecuteCommand(command, in_display_list);
+  }
+}
+
+namespace
+{
+// Keeps the commands DecodeStream() found in display lists, since most games call the same
+// display lists over and over. Where the commands are depends on the vertex formats the list is
+// called with, so those are part of an entry as well.
+//
+// There is no way to tell whether the emulated CPU wrote to a display list in the meantime, so the
+// list is hashed on every call. That is still cheaper than parsing it again, and the vertex
+// loaders read the same memory right afterwards anyway.
+class DisplayListCache final
+{
+public:
+  DisplayListCache() { SetHash64Function(); }
+
+  // Executes the display list at start, whose guest address is address, and returns its cycles.
+  u32 Run(u32 address, u32 size, u8* start)
+  {
+    const u64 hash = GetHash64(start, size, 0);
+    const u64 key = static_cast<u64>(address) << 32 | size;
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->second.hash != hash ||
+        it->second.vtx_desc.Hex != g_main_cp_state.vtx_desc.Hex ||
+        std::memcmp(it->second.vtx_attr, g_main_cp_state.vtx_attr, sizeof(VAT) * 8) != 0)
+    {
+      if (m_num_commands >= MAX_COMMANDS)
+        Clear();
+      if (it != m_entries.end())
+        m_num_commands -= it->second.commands.size();
+      it = m_entries.insert_or_assign(key, Decode(start, size, hash)).first;
+      m_num_commands += it->second.commands.size();
+    }
+
+    for (const DecodedCommand& command : it->second.commands)
+      ExecuteCommand(command, true);
+    return it->second.cycles;
+  }
+
+  void Clear()
+  {
+    m_entries.clear();
+    m_num_commands = 0;
+  }
+
+private:
+  // The whole cache is thrown away once it holds more commands than this.
+  static constexpr size_t MAX_COMMANDS = 1024 * 1024;
+
+  struct Entry
+  {
+    u64 hash;
+    TVtxDesc vtx_desc;
+    VAT vtx_attr[8];
+    u32 cycles;
+    std::vector<DecodedCommand> commands;
+  };
+
+  static Entry Decode(u8* start, u32 size, u64 hash)
+  {
+    Entry entry;
+    entry.hash = hash;
+    entry.vtx_desc = g_main_cp_state.vtx_desc;
+    std::memcpy(entry.vtx_attr, g_main_cp_state.vtx_attr, sizeof(entry.vtx_attr));
+    entry.cycles = 0;
+
+    CPState cp_state = g_main_cp_state;
+    DecodeStream(DataReader(start, start + size), true, &cp_state, &entry.cycles,
+                 [&entry](DecodedCommand::Type type, u8* command_start, u32 command_size) {
+                   entry.commands.push_back(DecodedCommand{command_start, command_size, type});
+                 });
+    entry.commands.shrink_to_fit();
+    return entry;
+  }
+
+  std::unordered_map<u64, Entry> m_entries;
+  size_t m_num_commands = 0;
+};
+
+std::unique_ptr<DisplayListCache> s_display_list_cache;
+}  // Anonymous namespace
+
 static u32 InterpretDisplayList(u32 address, u32 size)
 {
   u8* startAddress;
@@ -53,7 +487,12 @@ static u32 InterpretDisplayList(u32 address, u32 size)
     // temporarily swap dl and non-dl (small "hack" for the stats)
     Statistics::SwapDL();
 
-    Run(DataReader(startAddress, startAddress + size), &cycles, true);
+    // The recorder needs the commands as they are parsed, and in deterministic mode the list is
+    // a copy in the aux buffer which is gone by the next call.
+    if (s_display_list_cache && !g_bRecordFifoData && !Fifo::UseDeterministicGPUThread())
+      cycles = s_display_list_cache->Run(address, size, startAddress);
+    else
+      Run(DataReader(startAddress, startAddress + size), &cycles, true);
     INCSTAT(stats.thisFrame.numDListsCalled);
 
     // un-swap
@@ -78,11 +517,33 @@ static void InterpretDisplayListPreprocess(u32 address, u32 size)
 void Init()
 {
   s_bFifoErrorSeen = false;
+
+  s_decoder_thread.reset();
+  if (SConfig::GetInstance().bFifoDecoderThread)
+    s_decoder_thread = std::make_unique<DecoderThread>();
+
+  s_display_list_cache.reset();
+  if (SConfig::GetInstance().bDisplayListCache)
+    s_display_list_cache = std::make_unique<DisplayListCache>();
+}
+
+void Shutdown()
+{
+  s_decoder_thread.reset();
+  s_display_list_cache.reset();
 }
 
 template <bool is_preprocess>
 u8* Run(DataReader src, u32* cycles, bool in_display_list)
 {
+  // In deterministic mode, display lists are read from the aux buffer filled by preprocessing,
+  // which only this path knows how to consume.
+  if (!is_preprocess && s_decoder_thread && src.size() >= MIN_PIPELINED_STREAM_SIZE &&
+      !Fifo::UseDeterministicGPUThread())
+  {
+    return RunPipelined(src, cycles, in_display_list);
+  }
+
   u32 totalCycles = 0;
   u8* opcodeStart;
   while (true)
@@ -93,6 +554,8 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
       goto end;
 
     u8 cmd_byte = src.Read<u8>();
+    if (!is_preprocess)
+      TRACE_EVENT(FifoCommand, cmd_byte, in_display_list);
     int refarray;
     switch (cmd_byte)
     {
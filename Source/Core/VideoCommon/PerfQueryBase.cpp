@@ -4,6 +4,7 @@
 
 #include "VideoCommon/PerfQueryBase.h"
 #include <memory>
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/VideoConfig.h"
 
 std::unique_ptr<PerfQueryBase> g_perf_query;
@@ -12,3 +13,58 @@ bool PerfQueryBase::ShouldEmulate()
 {
   return g_ActiveConfig.bPerfQueriesEnable;
 }
+
+bool PerfQueryBase::ShouldDelayResults()
+{
+  // When the delayed results become available depends on the timing of the GPU thread.
+  return g_ActiveConfig.bPerfQueriesDelayed && !Fifo::UseDeterministicGPUThread();
+}
+
+u32 PerfQueryBase::AddPendingQuery()
+{
+  m_pending_queries++;
+  return m_period;
+}
+
+void PerfQueryBase::BeginPeriod()
+{
+  m_period++;
+  for (int i = 0; i < PQG_NUM_MEMBERS; i++)
+  {
+    m_previous_results[i] = m_results[i];
+    m_results[i] = 0;
+  }
+
+  // Outside of delayed mode, the backends drop the pending queries.
+  m_previous_pending_queries = ShouldDelayResults() ? m_pending_queries : 0;
+  m_pending_queries = 0;
+  if (m_previous_pending_queries == 0)
+    PublishPreviousResults();
+}
+
+void PerfQueryBase::AddResult(u32 period, PerfQueryGroup group, u32 value)
+{
+  if (period == m_period)
+  {
+    m_results[group] += value;
+    if (m_pending_queries != 0)
+      m_pending_queries--;
+  }
+  else if (period == m_period - 1 && m_previous_pending_queries != 0)
+  {
+    m_previous_results[group] += value;
+    if (--m_previous_pending_queries == 0)
+      PublishPreviousResults();
+  }
+}
+
+u32 PerfQueryBase::GetResult(PerfQueryGroup group) const
+{
+  return ShouldDelayResults() ? m_delayed_results[group] : m_results[group];
+}
+
+void PerfQueryBase::PublishPreviousResults()
+{
+  for (int i = 0; i < PQG_NUM_MEMBERS; i++)
+    m_delayed_results[i] = m_previous_results[i];
+}
@@ -34,6 +34,10 @@ public:
   // Checks if performance queries are enabled in the gameini configuration.
   // NOTE: Called from CPU+GPU thread
   static bool ShouldEmulate();
+  // Checks if the results of the previous period between counter resets should be returned, so
+  // that reading the counters doesn't have to wait for the GPU.
+  // NOTE: Called from CPU+GPU thread
+  static bool ShouldDelayResults();
 
   // Begin querying the specified value for the following host GPU commands
   virtual void EnableQuery(PerfQueryGroup type) {}
@@ -51,9 +55,31 @@ public:
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
 protected:
+  // The results are counted per period between two resets of the counters by the game. In
+  // delayed mode, the queries of a period are left running after the reset, and the counters read
+  // the results of the last period whose queries have all completed. Backends wait for the queries
+  // of the previous period at the next reset, so the results are at most one period late.
+
+  // Called when a query is started, returns the period it belongs to.
+  u32 AddPendingQuery();
+  bool IsPreviousPeriodPending() const { return m_previous_pending_queries != 0; }
+  void BeginPeriod();
+  void AddResult(u32 period, PerfQueryGroup group, u32 value);
+  // Returns the counter of a query group, as it will be read by the CPU.
+  u32 GetResult(PerfQueryGroup group) const;
+
   // TODO: sloppy
   volatile u32 m_query_count;
   volatile u32 m_results[PQG_NUM_MEMBERS];
+
+private:
+  void PublishPreviousResults();
+
+  u32 m_period = 0;
+  u32 m_pending_queries = 0;
+  u32 m_previous_pending_queries = 0;
+  u32 m_previous_results[PQG_NUM_MEMBERS] = {};
+  volatile u32 m_delayed_results[PQG_NUM_MEMBERS] = {};
 };
 
 extern std::unique_ptr<PerfQueryBase> g_perf_query;
@@ -7,6 +7,10 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -16,6 +20,8 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/LightingShaderGen.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/StageTimings.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -158,7 +164,7 @@ static const char* tevAOutputTable[] = {"prev.a", "c0.a", "c1.a", "c2.a"};
 // leak
 //        into this UID; This is really unhelpful if these UIDs ever move from one machine to
 //        another.
-PixelShaderUid GetPixelShaderUid()
+static PixelShaderUid BuildPixelShaderUid()
 {
   PixelShaderUid out;
   pixel_shader_uid_data* uid_data = out.GetUidData<pixel_shader_uid_data>();
@@ -321,8 +327,66 @@ PixelShaderUid GetPixelShaderUid()
   return out;
 }
 
-void WritePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texgens,
-                                  bool per_pixel_lighting, bool bounding_box)
+namespace
+{
+// The state besides BP and XF memory which the UID is built from. This is cheaper to compare on
+// every draw than to track, since it changes with the vertex format and the config.
+struct PixelShaderUidInputs
+{
+  u32 components;
+  bool per_pixel_lighting;
+  bool bounding_box;
+  bool force_true_color;
+  bool fast_depth_calc;
+  bool supports_early_z;
+
+  bool operator==(const PixelShaderUidInputs& rhs) const
+  {
+    return std::tie(components, per_pixel_lighting, bounding_box, force_true_color,
+                    fast_depth_calc, supports_early_z) ==
+           std::tie(rhs.components, rhs.per_pixel_lighting, rhs.bounding_box,
+                    rhs.force_true_color, rhs.fast_depth_calc, rhs.supports_early_z);
+  }
+};
+}
+
+static PixelShaderUid s_cached_uid;
+static PixelShaderUidInputs s_cached_inputs;
+static bool s_cached_uid_valid = false;
+
+PixelShaderUid GetPixelShaderUid()
+{
+  StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderUidGeneration);
+
+  const PixelShaderUidInputs inputs = {
+      VertexLoaderManager::g_current_components & (VB_HAS_COL0 | VB_HAS_COL1),
+      g_ActiveConfig.bEnablePixelLighting,
+      g_ActiveConfig.BBoxUseFragmentShaderImplementation() && g_ActiveConfig.bBBoxEnable &&
+          BoundingBox::active,
+      g_ActiveConfig.bForceTrueColor,
+      g_ActiveConfig.bFastDepthCalc,
+      g_ActiveConfig.backend_info.bSupportsEarlyZ};
+
+  if (s_cached_uid_valid && inputs == s_cached_inputs)
+  {
+    INCSTAT(stats.thisFrame.numShaderUidsReused);
+    return s_cached_uid;
+  }
+
+  INCSTAT(stats.thisFrame.numShaderUidsBuilt);
+  s_cached_uid = BuildPixelShaderUid();
+  s_cached_inputs = inputs;
+  s_cached_uid_valid = true;
+  return s_cached_uid;
+}
+
+void InvalidatePixelShaderUid()
+{
+  s_cached_uid_valid = false;
+}
+
+static void GeneratePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texgens,
+                                            bool per_pixel_lighting, bool bounding_box)
 {
   // dot product for integer vectors
   out.Write("int idot(int3 x, int3 y)\n"
@@ -425,6 +489,27 @@ void WritePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texg
   out.Write("};\n");
 }
 
+void WritePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texgens,
+                                  bool per_pixel_lighting, bool bounding_box)
+{
+  // The header is a large part of every pixel shader, but only depends on the arguments, so it is
+  // generated once for each combination. Shaders can be generated on multiple threads.
+  static std::mutex s_header_lock;
+  static std::map<std::tuple<APIType, u32, bool, bool>, std::string> s_headers;
+
+  std::lock_guard<std::mutex> guard(s_header_lock);
+  std::string& header =
+      s_headers[std::make_tuple(ApiType, num_texgens, per_pixel_lighting, bounding_box)];
+  if (header.empty())
+  {
+    ShaderCode code;
+    GeneratePixelShaderCommonHeader(code, ApiType, num_texgens, per_pixel_lighting, bounding_box);
+    header = code.GetBuffer();
+  }
+
+  out.Append(header);
+}
+
 static void WriteStage(ShaderCode& out, const pixel_shader_uid_data* uid_data, int n,
                        APIType ApiType, bool stereo);
 static void WriteTevRegular(ShaderCode& out, const char* components, int bias, int op, int clamp,
@@ -163,3 +163,7 @@ void WritePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texg
                                   bool per_pixel_lighting, bool bounding_box);
 ShaderCode GeneratePixelShaderCode(APIType ApiType, const pixel_shader_uid_data* uid_data);
 PixelShaderUid GetPixelShaderUid();
+
+// Marks the pixel shader UID as outdated, so that the next GetPixelShaderUid() call rebuilds it.
+// Called when a BP or XF register which the UID is built from changes.
+void InvalidatePixelShaderUid();
@@ -16,6 +16,7 @@
 
 #include <cinttypes>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -42,9 +43,11 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
+#include "Core/RunAhead.h"
 
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Debugger.h"
@@ -52,9 +55,11 @@
 #include "VideoCommon/FramebufferManagerBase.h"
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -175,6 +180,10 @@ bool Renderer::CalculateTargetSize()
   if (max_size < EFB_WIDTH * m_efb_scale)
     m_efb_scale = max_size / EFB_WIDTH;
 
+  m_configured_efb_scale = m_efb_scale;
+  if (g_ActiveConfig.fDynamicResolutionFrameTime > 0.0f)
+    m_efb_scale = std::min(m_efb_scale, m_dynamic_efb_scale);
+
   int new_efb_width = 0;
   int new_efb_height = 0;
   std::tie(new_efb_width, new_efb_height) = CalculateTargetScale(EFB_WIDTH, EFB_HEIGHT);
@@ -264,7 +273,12 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bShowFPS || SConfig::GetInstance().m_ShowFrameCount)
   {
     if (g_ActiveConfig.bShowFPS)
-      final_cyan += StringFromFormat("FPS: %.2f", m_fps_counter.GetFPS());
+    {
+      // The on-screen font is ASCII only.
+      final_cyan += StringFromFormat("FPS: %.2f (%.2f +/- %.2f ms)", m_fps_counter.GetFPS(),
+                                     m_fps_counter.GetFrameTimeMean(),
+                                     m_fps_counter.GetFrameTimeStdDev());
+    }
 
     if (g_ActiveConfig.bShowFPS && SConfig::GetInstance().m_ShowFrameCount)
       final_cyan += " - ";
@@ -380,6 +394,9 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bOverlayProjStats)
     final_cyan += Statistics::ToStringProj();
 
+  if (g_ActiveConfig.bOverlayStageTimings)
+    final_cyan += StageTimings::ToString();
+
   // and then the text
   RenderText(final_cyan, 20, 20, 0xFF00FFFF);
   RenderText(final_yellow, 20, 20, 0xFFFFFF00);
@@ -562,9 +579,12 @@ void Renderer::SetWindowSize(int width, int height)
   width = std::max(width, 1);
   height = std::max(height, 1);
 
-  // Scale the window size by the EFB scale.
+  // Scale the window size by the EFB scale. Dynamic resolution doesn't resize the window.
   if (g_ActiveConfig.iEFBScale != EFB_SCALE_AUTO_INTEGRAL)
-    std::tie(width, height) = CalculateTargetScale(width, height);
+  {
+    width *= static_cast<int>(m_configured_efb_scale);
+    height *= static_cast<int>(m_configured_efb_scale);
+  }
 
   float scaled_width, scaled_height;
   std::tie(scaled_width, scaled_height) = ScaleToDisplayAspectRatio(width, height);
@@ -642,6 +662,10 @@ void Renderer::RecordVideoMemory()
 void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const EFBRectangle& rc,
                     u64 ticks, float Gamma)
 {
+  // Don't let deferred EFB copies wait for longer than a frame. The texture cache also compares
+  // the hashes of EFB copies against RAM when it is cleaned up.
+  g_texture_cache->FlushEFBCopies();
+
   // Heuristic to detect if a GameCube game is in 16:9 anamorphic widescreen mode.
   if (!SConfig::GetInstance().bWii)
   {
@@ -658,12 +682,22 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
       m_aspect_wide = flush_count_anamorphic > 0.75 * flush_total;
   }
 
+  // Of the frames that run-ahead emulates, only those of the last field run ahead are presented.
+  const bool hidden = RunAhead::IsFrameHidden();
+
   // TODO: merge more generic parts into VideoCommon
-  SwapImpl(xfbAddr, fbWidth, fbStride, fbHeight, rc, ticks, Gamma);
+  if (!m_skip_current_frame && !hidden)
+    SwapImpl(xfbAddr, fbWidth, fbStride, fbHeight, rc, ticks, Gamma);
 
-  if (m_xfb_written)
+  if (m_xfb_written && !hidden)
     m_fps_counter.Update();
 
+  const u64 swap_time = Common::Timer::GetTimeUs();
+  StageTimings::EndFrame(swap_time - m_last_swap_time);
+  UpdateDynamicResolution(swap_time - m_last_swap_time);
+  m_last_swap_time = swap_time;
+  m_frame_stats_log.EndFrame();
+
   frameCount++;
   GFX_DEBUGGER_PAUSE_AT(NEXT_FRAME, true);
 
@@ -675,6 +709,111 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
   Core::Callback_VideoCopiedToXFB(m_xfb_written ||
                                   (g_ActiveConfig.bUseXFB && g_ActiveConfig.bUseRealXFB));
   m_xfb_written = false;
+
+  UpdateFrameSkip();
+}
+
+void Renderer::NotifyEFBRead()
+{
+  // The draws of the rest of this frame can still be made visible to the CPU.
+  m_efb_read_this_frame = true;
+  m_skip_current_frame = false;
+}
+
+void Renderer::UpdateDynamicResolution(u64 frame_time_us)
+{
+  // Frames over this many are measured together, so a single slow frame doesn't change the scale.
+  static constexpr u32 FRAMES_PER_PERIOD = 30;
+  // The scale is raised again after this many periods in budget, multiplied by the delay.
+  static constexpr u32 PERIODS_BEFORE_RAISE = 4;
+  static constexpr u32 MAX_RAISE_DELAY = 16;
+
+  const float target_ms = g_ActiveConfig.fDynamicResolutionFrameTime;
+  if (target_ms <= 0.0f)
+  {
+    m_dynamic_efb_scale = std::numeric_limits<unsigned int>::max();
+    m_dynamic_resolution_raise_delay = 1;
+    m_dynamic_resolution_raised = false;
+    return;
+  }
+
+  // Frames taking far too long were held up by a pause or loading, not by rendering.
+  const u64 target_us = static_cast<u64>(target_ms * 1000.0f);
+  const bool fast_forward =
+      SConfig::GetInstance().m_EmulationSpeed <= 0.0f || Core::GetIsThrottlerTempDisabled();
+  if (fast_forward || m_skip_current_frame || frame_time_us > target_us * 10)
+    return;
+
+  m_dynamic_resolution_time_us += frame_time_us;
+  if (++m_dynamic_resolution_frames < FRAMES_PER_PERIOD)
+    return;
+
+  const u64 average_us = m_dynamic_resolution_time_us / m_dynamic_resolution_frames;
+  m_dynamic_resolution_time_us = 0;
+  m_dynamic_resolution_frames = 0;
+
+  // Frame times jitter around the target when the game runs at full speed.
+  if (average_us > target_us + target_us / 10)
+  {
+    m_dynamic_resolution_periods_in_budget = 0;
+    if (m_efb_scale <= 1)
+      return;
+
+    // If raising the scale was what took us over budget, wait for longer before trying again.
+    if (m_dynamic_resolution_raised)
+    {
+      m_dynamic_resolution_raise_delay =
+          std::min(m_dynamic_resolution_raise_delay * 2, MAX_RAISE_DELAY);
+    }
+    m_dynamic_resolution_raised = false;
+    m_dynamic_efb_scale = m_efb_scale - 1;
+    INFO_LOG(VIDEO, "Dynamic resolution: Lowered the EFB scale to %u (%" PRIu64 " us per frame)",
+             m_dynamic_efb_scale, average_us);
+    return;
+  }
+
+  if (m_dynamic_resolution_raised)
+  {
+    m_dynamic_resolution_raised = false;
+    m_dynamic_resolution_raise_delay = std::max(m_dynamic_resolution_raise_delay / 2, 1u);
+  }
+
+  // Frames which are held back by the speed limit don't show how much time is left over, so the
+  // only way to find out whether a higher scale fits is to try it.
+  if (m_efb_scale >= m_configured_efb_scale ||
+      ++m_dynamic_resolution_periods_in_budget <
+          PERIODS_BEFORE_RAISE * m_dynamic_resolution_raise_delay)
+  {
+    return;
+  }
+
+  m_dynamic_resolution_periods_in_budget = 0;
+  m_dynamic_resolution_raised = true;
+  m_dynamic_efb_scale = m_efb_scale + 1;
+  INFO_LOG(VIDEO, "Dynamic resolution: Raised the EFB scale to %u", m_dynamic_efb_scale);
+}
+
+void Renderer::UpdateFrameSkip()
+{
+  const SConfig& config = SConfig::GetInstance();
+  const bool fast_forward = config.m_EmulationSpeed <= 0.0f || Core::GetIsThrottlerTempDisabled();
+
+  // Games which read back from the EFB, through peeks, bounding boxes or perf queries, usually do
+  // so every frame, and would see stale data from skipped frames.
+  const bool can_skip = fast_forward && !m_efb_read_this_frame && !BoundingBox::active &&
+                        !PerfQueryBase::ShouldEmulate() && !IsFrameDumping();
+  m_efb_read_this_frame = false;
+
+  if (can_skip && m_frames_skipped < config.m_FrameSkip)
+  {
+    m_skip_current_frame = true;
+    ++m_frames_skipped;
+  }
+  else
+  {
+    m_skip_current_frame = false;
+    m_frames_skipped = 0;
+  }
 }
 
 bool Renderer::IsFrameDumping()
@@ -696,7 +835,7 @@ void Renderer::ShutdownFrameDumping()
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  FinishFrameData();
+  // The thread writes the frames which are still queued before it exits.
   m_frame_dump_thread_running.Clear();
   m_frame_dump_start.Set();
 }
@@ -704,9 +843,39 @@ void Renderer::ShutdownFrameDumping()
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state,
                              bool swap_upside_down)
 {
-  FinishFrameData();
+  QueuedFrameDump frame;
+  {
+    std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+    while (m_frame_dump_queue.size() >= MAX_QUEUED_FRAME_DUMPS)
+    {
+      lk.unlock();
+      m_frame_dump_done.Wait();
+      lk.lock();
+    }
 
-  m_frame_dump_config = FrameDumpConfig{data, w, h, stride, swap_upside_down, state};
+    if (!m_frame_dump_free_buffers.empty())
+    {
+      frame.data = std::move(m_frame_dump_free_buffers.back());
+      m_frame_dump_free_buffers.pop_back();
+    }
+  }
+
+  // Copy the frame out of the readback buffer, flipping it here rather than on the dump thread.
+  const size_t row_size = static_cast<size_t>(w) * 4;
+  frame.data.resize(row_size * h);
+  for (int y = 0; y < h; ++y)
+  {
+    const int src_y = swap_upside_down ? h - 1 - y : y;
+    std::memcpy(&frame.data[y * row_size], data + src_y * stride, row_size);
+  }
+  frame.width = w;
+  frame.height = h;
+  frame.state = state;
+
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_queue.push_back(std::move(frame));
+  }
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -717,16 +886,6 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVI
   }
 
   m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
-}
-
-void Renderer::FinishFrameData()
-{
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
 }
 
 void Renderer::RunFrameDumps()
@@ -748,56 +907,27 @@ void Renderer::RunFrameDumps()
   while (true)
   {
     m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
-
-    auto config = m_frame_dump_config;
 
-    if (config.upside_down)
+    QueuedFrameDump frame;
+    while (true)
     {
-      config.data = config.data + (config.height - 1) * config.stride;
-      config.stride = -config.stride;
-    }
-
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
-    {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (TextureToPng(config.data, config.stride, m_screenshot_name, config.width, config.height,
-                       false))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
-
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
-
-    if (SConfig::GetInstance().m_DumpFrames)
-    {
-      if (!frame_dump_started)
       {
-        if (dump_to_avi)
-          frame_dump_started = StartFrameDumpToAVI(config);
-        else
-          frame_dump_started = StartFrameDumpToImage(config);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          SConfig::GetInstance().m_DumpFrames = false;
+        std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+        if (!frame.data.empty())
+          m_frame_dump_free_buffers.push_back(std::move(frame.data));
+        if (m_frame_dump_queue.empty())
+          break;
+
+        frame = std::move(m_frame_dump_queue.front());
+        m_frame_dump_queue.pop_front();
       }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
-      {
-        if (dump_to_avi)
-          DumpFrameToAVI(config);
-        else
-          DumpFrameToImage(config);
-      }
+      m_frame_dump_done.Set();
+      DumpQueuedFrame(frame, dump_to_avi, &frame_dump_started);
     }
 
-    m_frame_dump_done.Set();
+    if (!m_frame_dump_thread_running.IsSet())
+      break;
   }
 
   if (frame_dump_started)
@@ -808,6 +938,51 @@ void Renderer::RunFrameDumps()
   }
 }
 
+void Renderer::DumpQueuedFrame(const QueuedFrameDump& frame, bool dump_to_avi,
+                               bool* frame_dump_started)
+{
+  const FrameDumpConfig config{frame.data.data(), frame.width, frame.height, frame.width * 4,
+                               frame.state};
+
+  // Save screenshot
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+
+    if (TextureToPng(config.data, config.stride, m_screenshot_name, config.width, config.height,
+                     false, g_ActiveConfig.iPNGCompressionLevel))
+      OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+
+    // Reset settings
+    m_screenshot_name.clear();
+    m_screenshot_completed.Set();
+  }
+
+  if (SConfig::GetInstance().m_DumpFrames)
+  {
+    if (!*frame_dump_started)
+    {
+      if (dump_to_avi)
+        *frame_dump_started = StartFrameDumpToAVI(config);
+      else
+        *frame_dump_started = StartFrameDumpToImage(config);
+
+      // Stop frame dumping if we fail to start.
+      if (!*frame_dump_started)
+        SConfig::GetInstance().m_DumpFrames = false;
+    }
+
+    // If we failed to start frame dumping, don't write a frame.
+    if (*frame_dump_started)
+    {
+      if (dump_to_avi)
+        DumpFrameToAVI(config);
+      else
+        DumpFrameToImage(config);
+    }
+  }
+}
+
 #if defined(HAVE_FFMPEG)
 
 bool Renderer::StartFrameDumpToAVI(const FrameDumpConfig& config)
@@ -870,7 +1045,8 @@ bool Renderer::StartFrameDumpToImage(const FrameDumpConfig& config)
 void Renderer::DumpFrameToImage(const FrameDumpConfig& config)
 {
   std::string filename = GetFrameDumpNextImageFileName();
-  TextureToPng(config.data, config.stride, filename, config.width, config.height, false);
+  TextureToPng(config.data, config.stride, filename, config.width, config.height, false,
+               g_ActiveConfig.iPNGCompressionLevel);
   m_frame_dump_image_counter++;
 }
 
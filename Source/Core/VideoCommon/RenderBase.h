@@ -15,6 +15,8 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -29,6 +31,7 @@
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/FrameStatsLog.h"
 #include "VideoCommon/VideoCommon.h"
 
 class PostProcessingShaderImplementation;
@@ -81,6 +84,7 @@ public:
   // Ideal internal resolution - multiple of the native EFB resolution
   int GetTargetWidth() const { return m_target_width; }
   int GetTargetHeight() const { return m_target_height; }
+  unsigned int GetEFBScale() const { return m_efb_scale; }
   // Display resolution
   int GetBackbufferWidth() const { return m_backbuffer_width; }
   int GetBackbufferHeight() const { return m_backbuffer_height; }
@@ -134,6 +138,14 @@ public:
   virtual void SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
                         const EFBRectangle& rc, u64 ticks, float Gamma = 1.0f) = 0;
 
+  // While fast-forwarding with frame skipping, the draws of skipped frames aren't submitted to
+  // the backend, and the frame isn't presented. EFB copies still happen, but see what was drawn
+  // up to the last frame which wasn't skipped.
+  bool IsSkippingFrame() const { return m_skip_current_frame; }
+  // Called when the emulated CPU reads back from the EFB, so that the frames which follow are
+  // drawn again.
+  void NotifyEFBRead();
+
   PEControl::PixelFormat GetPrevPixelFormat() const { return m_prev_efb_format; }
   void StorePixelFormat(PEControl::PixelFormat new_format) { m_prev_efb_format = new_format; }
   PostProcessingShaderImplementation* GetPostProcessor() const { return m_post_processor.get(); }
@@ -152,9 +164,12 @@ protected:
   void RecordVideoMemory();
 
   bool IsFrameDumping();
+  void UpdateFrameSkip();
+  void UpdateDynamicResolution(u64 frame_time_us);
+  // Copies the frame into the frame dump queue, so the data can be released as soon as this
+  // returns. Only waits for the encoder when it is a full queue of frames behind.
   void DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state,
                      bool swap_upside_down = false);
-  void FinishFrameData();
 
   Common::Flag m_screenshot_request;
   Common::Event m_screenshot_completed;
@@ -173,6 +188,12 @@ protected:
   bool m_xfb_written = false;
 
   FPSCounter m_fps_counter;
+  FrameStatsLog m_frame_stats_log;
+  u64 m_last_swap_time = 0;
+
+  bool m_skip_current_frame = false;
+  bool m_efb_read_this_frame = false;
+  u32 m_frames_skipped = 0;
 
   std::unique_ptr<PostProcessingShaderImplementation> m_post_processor;
 
@@ -190,29 +211,50 @@ private:
 
   PEControl::PixelFormat m_prev_efb_format = PEControl::INVALID_FMT;
   unsigned int m_efb_scale = 1;
+  // The scale chosen by the config, which dynamic resolution stays below.
+  unsigned int m_configured_efb_scale = 1;
+
+  // Dynamic resolution caps the EFB scale, and measures the frame time over periods of frames.
+  unsigned int m_dynamic_efb_scale = std::numeric_limits<unsigned int>::max();
+  u64 m_dynamic_resolution_time_us = 0;
+  u32 m_dynamic_resolution_frames = 0;
+  u32 m_dynamic_resolution_periods_in_budget = 0;
+  u32 m_dynamic_resolution_raise_delay = 1;
+  bool m_dynamic_resolution_raised = false;
 
   // These will be set on the first call to SetWindowSize.
   int m_last_window_request_width = 0;
   int m_last_window_request_height = 0;
 
   // frame dumping
+  static constexpr size_t MAX_QUEUED_FRAME_DUMPS = 3;
   std::thread m_frame_dump_thread;
   Common::Event m_frame_dump_start;
   Common::Event m_frame_dump_done;
   Common::Flag m_frame_dump_thread_running;
   u32 m_frame_dump_image_counter = 0;
-  bool m_frame_dump_frame_running = false;
   struct FrameDumpConfig
   {
     const u8* data;
     int width;
     int height;
     int stride;
-    bool upside_down;
     AVIDump::Frame state;
-  } m_frame_dump_config;
+  };
+  struct QueuedFrameDump
+  {
+    std::vector<u8> data;
+    int width;
+    int height;
+    AVIDump::Frame state;
+  };
+  std::mutex m_frame_dump_lock;
+  std::deque<QueuedFrameDump> m_frame_dump_queue;
+  // Buffers of frames which have been encoded, kept to avoid reallocating them every frame.
+  std::vector<std::vector<u8>> m_frame_dump_free_buffers;
 
   // NOTE: The methods below are called on the framedumping thread.
+  void DumpQueuedFrame(const QueuedFrameDump& frame, bool dump_to_avi, bool* frame_dump_started);
   bool StartFrameDumpToAVI(const FrameDumpConfig& config);
   void DumpFrameToAVI(const FrameDumpConfig& config);
   void StopFrameDumpToAVI();
@@ -4,6 +4,8 @@
 
 #include "VideoCommon/RenderState.h"
 
+#include <array>
+
 // If the framebuffer format has no alpha channel, it is assumed to
 // ONE on blending. As the backends may emulate this framebuffer
 // configuration with an alpha channel, we just drop all references
@@ -127,3 +129,60 @@ void BlendingState::Generate(const BPMemory& bp)
     }
   }
 }
+
+void TexModeState::Generate(const BPMemory& bp, u32 index)
+{
+  const FourTexUnits& tex = bp.tex[index >> 2];
+  hex = 0;
+  tm0 = tex.texMode0[index & 3];
+  tm1 = tex.texMode1[index & 3];
+}
+
+namespace RenderState
+{
+static StateInterner<BlendingState> s_blending_states;
+static StateInterner<TexModeState> s_tex_mode_states;
+static u32 s_blending_state_id;
+static std::array<u32, 8> s_tex_mode_state_ids;
+
+void Init()
+{
+  UpdateBlendingState();
+  for (u32 i = 0; i < s_tex_mode_state_ids.size(); i++)
+    UpdateTexModeState(i);
+}
+
+void UpdateBlendingState()
+{
+  BlendingState state;
+  state.Generate(bpmem);
+  s_blending_state_id = s_blending_states.GetID(state);
+}
+
+void UpdateTexModeState(u32 index)
+{
+  TexModeState state;
+  state.Generate(bpmem, index);
+  s_tex_mode_state_ids[index] = s_tex_mode_states.GetID(state);
+}
+
+u32 GetBlendingStateID()
+{
+  return s_blending_state_id;
+}
+
+u32 GetTexModeStateID(u32 index)
+{
+  return s_tex_mode_state_ids[index];
+}
+
+const BlendingState& GetBlendingState(u32 id)
+{
+  return s_blending_states.GetState(id);
+}
+
+const TexModeState& GetTexModeState(u32 id)
+{
+  return s_tex_mode_states.GetState(id);
+}
+}
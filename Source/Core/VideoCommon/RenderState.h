@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "Common/BitField.h"
+#include "Common/CommonTypes.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BPStructs.h"
@@ -29,3 +33,53 @@ union BlendingState
 
   u32 hex;
 };
+
+// The sampler registers of one of the eight texture units.
+union TexModeState
+{
+  void Generate(const BPMemory& bp, u32 index);
+
+  struct
+  {
+    TexMode0 tm0;
+    TexMode1 tm1;
+  };
+
+  u64 hex;
+};
+
+// Gives each unique state a small ID the first time it is seen. IDs are never reused, so the
+// backends can compare them rather than whole states to find out whether anything changed.
+template <typename State>
+class StateInterner
+{
+public:
+  u32 GetID(const State& state)
+  {
+    const auto result = m_ids.emplace(state.hex, static_cast<u32>(m_states.size()));
+    if (result.second)
+      m_states.push_back(state);
+    return result.first->second;
+  }
+
+  const State& GetState(u32 id) const { return m_states[id]; }
+  size_t GetSize() const { return m_states.size(); }
+
+private:
+  std::unordered_map<decltype(State::hex), u32> m_ids;
+  std::vector<State> m_states;
+};
+
+// IDs of the states currently set by the BP registers. BPStructs updates them when the registers
+// they are generated from are written, so they don't have to be rebuilt for every draw.
+namespace RenderState
+{
+void Init();
+void UpdateBlendingState();
+void UpdateTexModeState(u32 index);
+
+u32 GetBlendingStateID();
+u32 GetTexModeStateID(u32 index);
+const BlendingState& GetBlendingState(u32 id);
+const TexModeState& GetTexModeState(u32 id);
+}
@@ -32,6 +32,7 @@ ShaderHostConfig ShaderHostConfig::GetCurrent()
   bits.backend_bitfield = g_ActiveConfig.backend_info.bSupportsBitfield;
   bits.backend_dynamic_sampler_indexing =
       g_ActiveConfig.backend_info.bSupportsDynamicSamplerIndexing;
+  bits.backend_vs_layer = g_ActiveConfig.backend_info.bSupportsVertexShaderLayer;
   return bits;
 }
 
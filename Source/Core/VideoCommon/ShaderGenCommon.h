@@ -116,12 +116,22 @@ public:
       __attribute__((format(printf, 2, 3)))
 #endif
   {
+    // Most writes are plain code without any format specifiers, which can be copied directly.
+    if (!std::strchr(fmt, '%'))
+    {
+      m_buffer += fmt;
+      return;
+    }
+
     va_list arglist;
     va_start(arglist, fmt);
-    m_buffer += StringFromFormatV(fmt, arglist);
+    AppendFromFormatV(&m_buffer, fmt, arglist);
     va_end(arglist);
   }
 
+  // Appends code which was already generated, e.g. a cached part of a shader.
+  void Append(const std::string& code) { m_buffer += code; }
+
 protected:
   std::string m_buffer;
 };
@@ -178,7 +188,8 @@ union ShaderHostConfig
     u32 backend_reversed_depth_range : 1;
     u32 backend_bitfield : 1;
     u32 backend_dynamic_sampler_indexing : 1;
-    u32 pad : 12;
+    u32 backend_vs_layer : 1;
+    u32 pad : 11;
   };
 
   static ShaderHostConfig GetCurrent();
@@ -313,6 +324,7 @@ inline const char* GetInterpolationQualifier(bool msaa, bool ssaa,
 #define I_POSTTRANSFORMMATRICES "cpostmtx"
 #define I_PIXELCENTERCORRECTION "cpixelcenter"
 #define I_VIEWPORT_SIZE "cviewport"
+#define I_VSSTEREOPARAMS "cvsstereo"
 
 #define I_STEREOPARAMS "cstereo"
 #define I_LINEPTPARAMS "clinept"
@@ -332,6 +344,7 @@ static const char s_shader_uniforms[] = "\tuint    components;\n"
                                         "\tfloat4 " I_PIXELCENTERCORRECTION ";\n"
                                         "\tfloat2 " I_VIEWPORT_SIZE ";\n"
                                         "\tuint4   xfmem_pack1[8];\n"
+                                        "\tfloat4 " I_VSSTEREOPARAMS ";\n"
                                         "\t#define xfmem_texMtxInfo(i) (xfmem_pack1[(i)].x)\n"
                                         "\t#define xfmem_postMtxInfo(i) (xfmem_pack1[(i)].y)\n"
                                         "\t#define xfmem_color(i) (xfmem_pack1[(i)].z)\n"
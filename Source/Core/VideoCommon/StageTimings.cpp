@@ -0,0 +1,242 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/StageTimings.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "Core/ConfigManager.h"
+#include "VideoCommon/Fifo.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace StageTimings
+{
+// Frames kept for the averages and peaks, and the number of those shown in the graphs.
+static constexpr size_t HISTORY_FRAMES = 120;
+static constexpr size_t GRAPH_FRAMES = 40;
+
+static std::atomic<bool> s_enabled{false};
+static std::array<std::atomic<u64>, NUM_STAGES> s_stage_time_us;
+static std::array<std::atomic<u64>, NUM_STAGES> s_stage_calls;
+static std::atomic<u64> s_cpu_wait_time_us{0};
+static thread_local ScopedTimer* s_current_timer = nullptr;
+
+static std::array<FrameTimes, HISTORY_FRAMES> s_history;
+static size_t s_history_position = 0;
+static size_t s_history_count = 0;
+
+static bool s_profiling = false;
+static std::array<u64, NUM_STAGES> s_profile_time_us;
+static std::array<u64, NUM_STAGES> s_profile_calls;
+static u64 s_profile_frame_time_us = 0;
+static u64 s_profile_frames = 0;
+
+static void AddTime(Stage stage, u64 time_us)
+{
+  s_stage_time_us[static_cast<size_t>(stage)].fetch_add(time_us, std::memory_order_relaxed);
+}
+
+ScopedTimer::ScopedTimer(Stage stage) : m_stage(stage)
+{
+  if (!s_enabled.load(std::memory_order_relaxed))
+    return;
+
+  m_active = true;
+  s_stage_calls[static_cast<size_t>(stage)].fetch_add(1, std::memory_order_relaxed);
+  m_start_time = Common::Timer::GetTimeUs();
+  m_parent = s_current_timer;
+  if (m_parent)
+    AddTime(m_parent->m_stage, m_start_time - m_parent->m_start_time);
+  s_current_timer = this;
+}
+
+ScopedTimer::~ScopedTimer()
+{
+  if (!m_active)
+    return;
+
+  const u64 time = Common::Timer::GetTimeUs();
+  AddTime(m_stage, time - m_start_time);
+  s_current_timer = m_parent;
+  if (m_parent)
+    m_parent->m_start_time = time;
+}
+
+bool IsEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+void AddCPUWaitTime(u64 time_us)
+{
+  if (IsEnabled())
+    s_cpu_wait_time_us.fetch_add(time_us, std::memory_order_relaxed);
+}
+
+void EndFrame(u64 frame_time_us)
+{
+  const bool was_enabled = IsEnabled();
+  s_enabled.store(g_ActiveConfig.bOverlayStageTimings ||
+                      !g_ActiveConfig.sFrameStatsLogPath.empty() || s_profiling,
+                  std::memory_order_relaxed);
+
+  std::array<u64, NUM_STAGES> times_us;
+  std::array<u64, NUM_STAGES> calls;
+  for (size_t i = 0; i < NUM_STAGES; ++i)
+  {
+    times_us[i] = s_stage_time_us[i].exchange(0, std::memory_order_relaxed);
+    calls[i] = s_stage_calls[i].exchange(0, std::memory_order_relaxed);
+  }
+  const u64 cpu_wait_time_us = s_cpu_wait_time_us.exchange(0, std::memory_order_relaxed);
+  if (!was_enabled)
+  {
+    s_history_count = 0;
+    return;
+  }
+
+  // Whatever the CPU thread didn't spend waiting was spent emulating. In single core mode, the
+  // other stages run on the CPU thread as well.
+  u64 cpu_busy_time_us = frame_time_us - std::min(frame_time_us, cpu_wait_time_us);
+  if (!SConfig::GetInstance().bCPUThread)
+  {
+    for (size_t i = 0; i < NUM_STAGES; ++i)
+      cpu_busy_time_us -= std::min(cpu_busy_time_us, times_us[i]);
+  }
+  times_us[static_cast<size_t>(Stage::CPUEmulation)] = cpu_busy_time_us;
+
+  if (s_profiling)
+  {
+    for (size_t i = 0; i < NUM_STAGES; ++i)
+    {
+      s_profile_time_us[i] += times_us[i];
+      s_profile_calls[i] += calls[i];
+    }
+    s_profile_frame_time_us += frame_time_us;
+    ++s_profile_frames;
+  }
+
+  s_history_position = (s_history_position + 1) % HISTORY_FRAMES;
+  s_history_count = std::min(s_history_count + 1, HISTORY_FRAMES);
+  for (size_t i = 0; i < NUM_STAGES; ++i)
+    s_history[s_history_position][i] = times_us[i] / 1000.0;
+}
+
+const char* GetStageName(Stage stage)
+{
+  static constexpr std::array<const char*, NUM_STAGES> names = {
+      {"CPU emulation", "FIFO processing", "Vertex loading", "Texture decode", "Texture hash",
+       "Shader UIDs", "Shader compile wait", "Backend submit", "Present wait"}};
+  return names[static_cast<size_t>(stage)];
+}
+
+const FrameTimes& GetLastFrame()
+{
+  static const FrameTimes no_times = {};
+  return s_history_count ? s_history[s_history_position] : no_times;
+}
+
+std::string ToString()
+{
+  if (s_history_count == 0)
+    return "";
+
+  // Frames from oldest to newest.
+  auto frame = [](size_t i) -> const FrameTimes& {
+    return s_history[(s_history_position + HISTORY_FRAMES + 1 - s_history_count + i) %
+                     HISTORY_FRAMES];
+  };
+
+  // All stages share the scale of the graphs, so that they can be compared with each other.
+  const size_t graph_frames = std::min(s_history_count, GRAPH_FRAMES);
+  double graph_max = 0.0;
+  for (size_t i = s_history_count - graph_frames; i < s_history_count; ++i)
+    graph_max = std::max(graph_max, *std::max_element(frame(i).begin(), frame(i).end()));
+
+  static constexpr char levels[] = " .:-=+*#%@";
+  static constexpr size_t num_levels = sizeof(levels) - 1;
+
+  std::string str = StringFromFormat("%-20s %6s %6s %6s (ms, graph max %.2f)\n", "Stage", "last",
+                                     "avg", "max", graph_max);
+  for (size_t stage = 0; stage < NUM_STAGES; ++stage)
+  {
+    double sum = 0.0;
+    double max = 0.0;
+    for (size_t i = 0; i < s_history_count; ++i)
+    {
+      sum += frame(i)[stage];
+      max = std::max(max, frame(i)[stage]);
+    }
+
+    std::string graph;
+    for (size_t i = s_history_count - graph_frames; i < s_history_count; ++i)
+    {
+      const size_t level =
+          graph_max > 0.0 ? static_cast<size_t>(frame(i)[stage] / graph_max * (num_levels - 1)) :
+                            0;
+      graph += levels[std::min(level, num_levels - 1)];
+    }
+
+    str += StringFromFormat("%-20s %6.2f %6.2f %6.2f |%s|\n",
+                            GetStageName(static_cast<Stage>(stage)), GetLastFrame()[stage],
+                            sum / s_history_count, max, graph.c_str());
+  }
+
+  const SConfig& param = SConfig::GetInstance();
+  if (param.bCPUThread && param.bSyncGPU && !Fifo::UseDeterministicGPUThread())
+  {
+    const Fifo::SyncStats sync = Fifo::GetSyncStats();
+    str += StringFromFormat("GPU sync (1/60 s): distance %d, peak backlog %d, CPU waited %.2f ms, "
+                            "%u CP polls\n",
+                            sync.max_distance, sync.peak_backlog, sync.wait_time_us / 1000.0,
+                            sync.cp_status_reads);
+  }
+
+  return str;
+}
+
+void StartProfile()
+{
+  s_profiling = true;
+  s_profile_time_us = {};
+  s_profile_calls = {};
+  s_profile_frame_time_us = 0;
+  s_profile_frames = 0;
+
+  // Takes effect with the next frame, so the first one is only partially measured.
+  s_enabled.store(true, std::memory_order_relaxed);
+}
+
+void StopProfile()
+{
+  s_profiling = false;
+}
+
+std::string GetProfileReport()
+{
+  if (s_profile_frames == 0)
+    return "";
+
+  std::string str = StringFromFormat("%llu frames, %.2f ms per frame\n",
+                                     static_cast<unsigned long long>(s_profile_frames),
+                                     s_profile_frame_time_us / 1000.0 / s_profile_frames);
+  str += StringFromFormat("%-20s %12s %12s %10s %10s %7s\n", "Stage", "total ms", "entries",
+                          "us/entry", "ms/frame", "share");
+  for (size_t stage = 0; stage < NUM_STAGES; ++stage)
+  {
+    const u64 time_us = s_profile_time_us[stage];
+    const u64 calls = s_profile_calls[stage];
+    str += StringFromFormat(
+        "%-20s %12.2f %12llu %10.2f %10.3f %6.1f%%\n", GetStageName(static_cast<Stage>(stage)),
+        time_us / 1000.0, static_cast<unsigned long long>(calls),
+        calls ? static_cast<double>(time_us) / calls : 0.0, time_us / 1000.0 / s_profile_frames,
+        s_profile_frame_time_us ? 100.0 * time_us / s_profile_frame_time_us : 0.0);
+  }
+
+  return str;
+}
+}
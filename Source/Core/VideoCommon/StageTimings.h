@@ -0,0 +1,77 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Measures how long the host spends in each stage of a frame, to find the stage which limits the
+// frame rate. The timers only run while the stage timing overlay is shown, the frame stats log is
+// written, or a profile is being taken.
+namespace StageTimings
+{
+enum class Stage
+{
+  CPUEmulation,
+  FifoProcessing,
+  VertexLoading,
+  TextureDecode,
+  TextureHash,
+  ShaderUidGeneration,
+  ShaderCompileWait,
+  BackendSubmit,
+  PresentWait,
+  Count
+};
+
+constexpr size_t NUM_STAGES = static_cast<size_t>(Stage::Count);
+
+// Milliseconds spent in each stage during one frame.
+using FrameTimes = std::array<double, NUM_STAGES>;
+
+// Adds the time until it goes out of scope to a stage. Timers nest on the same thread, and the
+// time spent in an inner stage is not counted towards the outer one.
+class ScopedTimer final
+{
+public:
+  explicit ScopedTimer(Stage stage);
+  ~ScopedTimer();
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  Stage m_stage;
+  bool m_active = false;
+  u64 m_start_time = 0;
+  ScopedTimer* m_parent = nullptr;
+};
+
+bool IsEnabled();
+
+// Time the CPU thread spends sleeping for the speed limit or waiting for the GPU thread, which
+// isn't counted as CPU emulation.
+void AddCPUWaitTime(u64 time_us);
+
+// Called by the renderer once per frame, with the host time since the previous frame.
+void EndFrame(u64 frame_time_us);
+
+const char* GetStageName(Stage stage);
+const FrameTimes& GetLastFrame();
+
+// Accumulates the time and number of entries of each stage over all frames until the profile is
+// stopped, independently of the overlay and the frame stats log.
+void StartProfile();
+void StopProfile();
+
+// The cost of each stage over the whole profile, in total, per entry and per frame.
+std::string GetProfileReport();
+
+// Lines for the overlay, with the average and peak of each stage and a graph of recent frames.
+std::string ToString();
+}
@@ -54,7 +54,21 @@ std::string Statistics::ToString()
   str += StringFromFormat("shaders changes: %i\n", stats.thisFrame.numShaderChanges);
   str += StringFromFormat("dlists called: %i\n", stats.thisFrame.numDListsCalled);
   str += StringFromFormat("Primitive joins: %i\n", stats.thisFrame.numPrimitiveJoins);
+  str += StringFromFormat("Skipped flushes: %i\n", stats.thisFrame.numSkippedFlushes);
   str += StringFromFormat("Draw calls: %i\n", stats.thisFrame.numDrawCalls);
+  str += StringFromFormat("Ubershader draws: %i\n", stats.thisFrame.numUberShaderDraws);
+  str += StringFromFormat("Specialized shader draws: %i\n",
+                          stats.thisFrame.numSpecializedShaderDraws);
+  str += StringFromFormat("Shader UIDs built: %i (%i reused)\n", stats.thisFrame.numShaderUidsBuilt,
+                          stats.thisFrame.numShaderUidsReused);
+  str += StringFromFormat("EFB copies: %i (%i repeats skipped)\n", stats.thisFrame.numEFBCopies,
+                          stats.thisFrame.numEFBCopiesSkipped);
+  str += StringFromFormat("Textures allocated: %i (%i from pool, %i evicted)\n",
+                          stats.thisFrame.numTexturesCreated, stats.thisFrame.numTexturesRecycled,
+                          stats.thisFrame.numTexturePoolEvictions);
+  str += StringFromFormat("Texture memory allocations: %i (%i sub-allocated)\n",
+                          stats.thisFrame.numTextureMemoryAllocations,
+                          stats.thisFrame.numTextureSubAllocations);
   str += StringFromFormat("Primitives: %i\n", stats.thisFrame.numPrims);
   str += StringFromFormat("Primitives (DL): %i\n", stats.thisFrame.numDLPrims);
   str += StringFromFormat("XF loads: %i\n", stats.thisFrame.numXFLoads);
@@ -66,6 +80,10 @@ std::string Statistics::ToString()
   str += StringFromFormat("Vertex streamed: %i kB\n", stats.thisFrame.bytesVertexStreamed / 1024);
   str += StringFromFormat("Index streamed: %i kB\n", stats.thisFrame.bytesIndexStreamed / 1024);
   str += StringFromFormat("Uniform streamed: %i kB\n", stats.thisFrame.bytesUniformStreamed / 1024);
+  str += StringFromFormat("Stream buffer wraps: %i\n", stats.thisFrame.numStreamBufferWraps);
+  str += StringFromFormat("Stream buffer stalls: %i (%i us)\n",
+                          stats.thisFrame.numStreamBufferStalls,
+                          stats.thisFrame.streamBufferStallTimeUs);
   str += StringFromFormat("Vertex Loaders: %i\n", stats.numVertexLoaders);
 
   std::string vertex_list = VertexLoaderManager::VertexLoadersToString();
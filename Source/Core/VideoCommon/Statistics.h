@@ -43,7 +43,20 @@ struct Statistics
     int numShaderChanges;
 
     int numPrimitiveJoins;
+    int numSkippedFlushes;
     int numDrawCalls;
+    int numUberShaderDraws;
+    int numSpecializedShaderDraws;
+    int numShaderUidsBuilt;
+    int numShaderUidsReused;
+    int numEFBCopies;
+    int numEFBCopiesSkipped;
+
+    int numTexturesCreated;
+    int numTexturesRecycled;
+    int numTexturePoolEvictions;
+    int numTextureMemoryAllocations;
+    int numTextureSubAllocations;
 
     int numDListsCalled;
 
@@ -51,6 +64,10 @@ struct Statistics
     int bytesIndexStreamed;
     int bytesUniformStreamed;
 
+    int numStreamBufferWraps;
+    int numStreamBufferStalls;
+    int streamBufferStallTimeUs;
+
     int numTrianglesClipped;
     int numTrianglesIn;
     int numTrianglesRejected;
@@ -0,0 +1,201 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+#include "VideoCommon/Statistics.h"
+
+// Hands out space in a ring buffer which the GPU reads from, and keeps track of how far the GPU
+// has got with a list of fences. The backends add a fence whenever commands using the buffer are
+// submitted, and wait for the one picked by WaitForSpace() when the writer catches up with the
+// GPU. Wrap-arounds and waits are counted in the per-frame statistics.
+template <typename Fence>
+class StreamRingAllocator
+{
+public:
+  explicit StreamRingAllocator(size_t size = 0) : m_size(size) {}
+
+  size_t GetSize() const { return m_size; }
+  size_t GetCurrentOffset() const { return m_current_offset; }
+  size_t GetGPUPosition() const { return m_gpu_position; }
+  size_t GetNumFences() const { return m_fences.size(); }
+
+  // Starts over with an empty buffer, dropping all of the fences.
+  void Reset(size_t size)
+  {
+    m_size = size;
+    m_current_offset = 0;
+    m_gpu_position = 0;
+    m_fences.clear();
+  }
+
+  // Places the next allocation of num_bytes bytes at the given alignment, if that is possible
+  // without waiting for the GPU. If allow_wrap is false, only the space after the current offset
+  // is used.
+  bool TryAllocate(size_t num_bytes, size_t alignment, bool allow_wrap = true)
+  {
+    const size_t required_bytes = num_bytes + alignment;
+
+    // Is the GPU behind or up to date with our current offset?
+    if (m_current_offset >= m_gpu_position)
+    {
+      if (required_bytes <= m_size - m_current_offset)
+      {
+        m_current_offset = AlignOffset(m_current_offset, alignment);
+        return true;
+      }
+
+      // Check for space at the start of the buffer. We use < here because m_current_offset ==
+      // m_gpu_position would mean that the GPU has caught up with us, which it hasn't.
+      if (allow_wrap && required_bytes < m_gpu_position)
+      {
+        m_current_offset = 0;
+        INCSTAT(stats.thisFrame.numStreamBufferWraps);
+        return true;
+      }
+
+      return false;
+    }
+
+    // The GPU is ahead of us, so there is space up to its position.
+    if (required_bytes < m_gpu_position - m_current_offset)
+    {
+      m_current_offset = AlignOffset(m_current_offset, alignment);
+      return true;
+    }
+
+    return false;
+  }
+
+  // Waits for the oldest fence after which num_bytes bytes at the given alignment are free, and
+  // places the next allocation there. All fences up to that one are passed to release() as they
+  // have been signaled as well. Returns false if none of the fences would free enough space.
+  template <typename WaitFunc, typename ReleaseFunc>
+  bool WaitForSpace(size_t num_bytes, size_t alignment, WaitFunc wait, ReleaseFunc release)
+  {
+    const size_t required_bytes = num_bytes + alignment;
+    size_t new_offset = 0;
+    size_t new_gpu_position = 0;
+    auto iter = m_fences.begin();
+    for (; iter != m_fences.end(); iter++)
+    {
+      // Would this fence bring us in line with the GPU? Then the whole buffer is free after it.
+      const size_t gpu_position = iter->second;
+      if (m_current_offset == gpu_position)
+      {
+        new_offset = 0;
+        new_gpu_position = 0;
+        break;
+      }
+
+      if (m_current_offset > gpu_position)
+      {
+        // We can wrap around to the start, behind the GPU, if there is enough space. Again, >
+        // because lining up with the GPU would mean that it has consumed what we just wrote.
+        if (gpu_position > required_bytes)
+        {
+          new_offset = 0;
+          new_gpu_position = gpu_position;
+          break;
+        }
+      }
+      else
+      {
+        // We're allocating behind the GPU, which leaves the space up to its position.
+        if (gpu_position - m_current_offset > required_bytes)
+        {
+          new_offset = m_current_offset;
+          new_gpu_position = gpu_position;
+          break;
+        }
+      }
+    }
+
+    if (iter == m_fences.end())
+      return false;
+
+    const u64 start_time = Common::Timer::GetTimeUs();
+    wait(iter->first);
+    INCSTAT(stats.thisFrame.numStreamBufferStalls);
+    ADDSTAT(stats.thisFrame.streamBufferStallTimeUs,
+            static_cast<int>(Common::Timer::GetTimeUs() - start_time));
+    if (new_offset < m_current_offset)
+      INCSTAT(stats.thisFrame.numStreamBufferWraps);
+
+    m_current_offset = AlignOffset(new_offset, alignment);
+    m_gpu_position = new_gpu_position;
+    ++iter;
+    std::for_each(m_fences.begin(), iter, [&release](const auto& it) { release(it.first); });
+    m_fences.erase(m_fences.begin(), iter);
+    return true;
+  }
+
+  // Moves past the data written to the last allocation.
+  void Commit(size_t num_bytes) { m_current_offset += num_bytes; }
+
+  // Returns whether anything was written since the last fence, or since the GPU caught up.
+  bool NeedsFence() const
+  {
+    return m_current_offset != m_gpu_position &&
+           (m_fences.empty() || m_fences.back().second != m_current_offset);
+  }
+
+  // Returns how many bytes were written since the last fence. Skipped space at the end of the
+  // buffer counts as written.
+  size_t GetUnfencedBytes() const
+  {
+    const size_t fenced_offset = m_fences.empty() ? m_gpu_position : m_fences.back().second;
+    if (m_current_offset >= fenced_offset)
+      return m_current_offset - fenced_offset;
+    return m_size - fenced_offset + m_current_offset;
+  }
+
+  // The GPU is done with everything written before the fence once it is signaled.
+  void AddFence(Fence fence) { m_fences.emplace_back(fence, m_current_offset); }
+
+  // Moves the GPU position forward for a fence which has been signaled. Fences the allocator
+  // doesn't know about, or has already waited for, are ignored.
+  void OnFenceSignaled(Fence fence)
+  {
+    auto iter = std::find_if(m_fences.begin(), m_fences.end(),
+                             [fence](const auto& it) { return it.first == fence; });
+    if (iter == m_fences.end())
+      return;
+
+    // Any fences before this one are implied to be signaled as well.
+    m_gpu_position = iter->second;
+    m_fences.erase(m_fences.begin(), ++iter);
+  }
+
+  // Passes every remaining fence to release(), and forgets about them.
+  template <typename ReleaseFunc>
+  void ReleaseFences(ReleaseFunc release)
+  {
+    for (const auto& it : m_fences)
+      release(it.first);
+    m_fences.clear();
+  }
+
+private:
+  // An offset of zero is assumed to be aligned to any value.
+  static size_t AlignOffset(size_t offset, size_t alignment)
+  {
+    return offset == 0 ? 0 : Common::AlignUp(offset, alignment);
+  }
+
+  size_t m_size;
+  size_t m_current_offset = 0;
+  size_t m_gpu_position = 0;
+
+  // Fences and the offsets written up to when they were added.
+  std::deque<std::pair<Fence, size_t>> m_fences;
+};
@@ -25,10 +25,13 @@
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/Debugger.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/FramebufferManagerBase.h"
 #include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/SamplerCommon.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -39,6 +42,8 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Textures are evicted from the pool early when it grows beyond this many bytes.
+static const size_t TEXTURE_POOL_MEMORY_BUDGET = 256 * 1024 * 1024;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
@@ -84,6 +89,8 @@ TextureCacheBase::TextureCacheBase()
 
 void TextureCacheBase::Invalidate()
 {
+  FlushEFBCopies();
+
   InvalidateAllBindPoints();
   for (size_t i = 0; i < bound_textures.size(); ++i)
   {
@@ -95,15 +102,20 @@ void TextureCacheBase::Invalidate()
     delete tex.second;
   }
   textures_by_address.clear();
-  textures_by_hash.clear();
+  textures_by_hash.Clear();
+  efb_copy_records.clear();
 
   texture_pool.clear();
+  texture_pool_size = 0;
 }
 
 TextureCacheBase::~TextureCacheBase()
 {
   HiresTexture::Shutdown();
   Invalidate();
+  // The backend's textures are gone after this, but the images of any dumps still have to be
+  // written before the thread pool goes away at exit.
+  FlushPngWrites();
   Common::FreeAlignedMemory(temp);
   temp = nullptr;
 }
@@ -111,7 +123,8 @@ TextureCacheBase::~TextureCacheBase()
 void TextureCacheBase::OnConfigChanged(VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bAsyncHiresTextures != backup_config.async_hires_textures)
   {
     HiresTexture::Update();
   }
@@ -150,6 +163,15 @@ void TextureCacheBase::Cleanup(int _frameCount)
     {
       iter = InvalidateTexture(iter);
     }
+    else if (!iter->second->pending_hires_texture.empty() &&
+             !HiresTexture::IsLoading(iter->second->pending_hires_texture))
+    {
+      // The custom texture has finished loading, so drop the native texture which was used in
+      // the meantime. The next lookup creates a new entry from the custom texture.
+      iter->second->pending_hires_texture.clear();
+      iter = InvalidateTexture(iter);
+      InvalidateAllBindPoints();
+    }
     else if (iter->second->frameCount == FRAMECOUNT_INVALID)
     {
       iter->second->frameCount = _frameCount;
@@ -194,13 +216,15 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
     if (_frameCount > TEXTURE_POOL_KILL_THRESHOLD + iter2->second.frameCount)
     {
-      iter2 = texture_pool.erase(iter2);
+      iter2 = RemoveFromPool(iter2);
     }
     else
     {
       ++iter2;
     }
   }
+
+  EvictFromPool();
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -221,6 +245,7 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.async_hires_textures = config.bAsyncHiresTextures;
   backup_config.stereo_3d = config.iStereoMode > 0;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
@@ -278,10 +303,9 @@ void TextureCacheBase::ScaleTextureCacheEntryTo(TextureCacheBase::TCacheEntry* e
                                           new_texture->GetConfig().GetRect());
     entry->texture.swap(new_texture);
 
-    auto config = new_texture->GetConfig();
     // At this point new_texture has the old texture in it,
     // we can potentially reuse this, so let's move it back to the pool
-    texture_pool.emplace(config, TexPoolEntry(std::move(new_texture)));
+    ReturnToPool(std::move(new_texture));
   }
   else
   {
@@ -433,17 +457,19 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
 void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level)
 {
   std::string szDir = File::GetUserPath(D_DUMPTEXTURES_IDX) + SConfig::GetInstance().GetGameID();
-
-  // make sure that the directory exists
-  if (!File::IsDirectory(szDir))
-    File::CreateDir(szDir);
-
   if (level > 0)
   {
     basename += StringFromFormat("_mip%i", level);
   }
   std::string filename = szDir + "/" + basename + ".png";
 
+  if (!dumped_textures.insert(filename).second)
+    return;
+
+  // make sure that the directory exists
+  if (!File::IsDirectory(szDir))
+    File::CreateDir(szDir);
+
   if (!File::Exists(filename))
     entry->texture->Save(filename, level);
 }
@@ -551,6 +577,9 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     return nullptr;
   }
 
+  if (!from_tmem)
+    FlushEFBCopies(address, texture_size + additional_mips_size);
+
   // If we are recording a FifoLog, keep track of what memory we read.
   // FifiRecorder does it's own memory modification tracking independant of the texture hashing
   // below.
@@ -558,19 +587,23 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     FifoRecorder::GetInstance().UseMemory(address, texture_size + additional_mips_size,
                                           MemoryUpdate::TEXTURE_MAP);
 
-  // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
-  // from the low tmem bank than it should)
-  base_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
   u32 palette_size = 0;
-  if (isPaletteTexture)
-  {
-    palette_size = TexDecoder_GetPaletteSize(texformat);
-    full_hash = base_hash ^ GetHash64(&texMem[tlutaddr], palette_size,
-                                      g_ActiveConfig.iSafeTextureCache_ColorSamples);
-  }
-  else
   {
-    full_hash = base_hash;
+    StageTimings::ScopedTimer hash_timer(StageTimings::Stage::TextureHash);
+
+    // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more
+    // data from the low tmem bank than it should)
+    base_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
+    if (isPaletteTexture)
+    {
+      palette_size = TexDecoder_GetPaletteSize(texformat);
+      full_hash = base_hash ^ GetHash64(&texMem[tlutaddr], palette_size,
+                                        g_ActiveConfig.iSafeTextureCache_ColorSamples);
+    }
+    else
+    {
+      full_hash = base_hash;
+    }
   }
 
   // Search the texture cache for textures by address
@@ -710,20 +743,19 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       std::max(texture_size, palette_size) <=
           (u32)g_ActiveConfig.iSafeTextureCache_ColorSamples * 8)
   {
-    auto hash_range = textures_by_hash.equal_range(full_hash);
-    TexHashCache::iterator hash_iter = hash_range.first;
-    while (hash_iter != hash_range.second)
+    if (const std::vector<TCacheEntry*>* hash_entries = textures_by_hash.Find(full_hash))
     {
-      TCacheEntry* entry = hash_iter->second;
-      // All parameters, except the address, need to match here
-      if (entry->format == full_format && entry->native_levels >= tex_levels &&
-          entry->native_width == nativeW && entry->native_height == nativeH)
+      for (TCacheEntry* entry : *hash_entries)
       {
-        entry = DoPartialTextureUpdates(hash_iter->second, &texMem[tlutaddr], tlutfmt);
+        // All parameters, except the address, need to match here
+        if (entry->format == full_format && entry->native_levels >= tex_levels &&
+            entry->native_width == nativeW && entry->native_height == nativeH)
+        {
+          entry = DoPartialTextureUpdates(entry, &texMem[tlutaddr], tlutfmt);
 
-        return ReturnEntry(stage, entry);
+          return ReturnEntry(stage, entry);
+        }
       }
-      ++hash_iter;
     }
   }
 
@@ -735,10 +767,11 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  std::string pending_hires_texture;
   if (g_ActiveConfig.bHiresTextures)
   {
     hires_tex = HiresTexture::Search(src_data, texture_size, &texMem[tlutaddr], palette_size, width,
-                                     height, texformat, use_mipmaps);
+                                     height, texformat, use_mipmaps, &pending_hires_texture);
 
     if (hires_tex)
     {
@@ -757,13 +790,8 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   const u32 texLevels = hires_tex ? (u32)hires_tex->m_levels.size() : tex_levels;
 
   // We can decode on the GPU if it is a supported format and the flag is enabled.
-  // Currently we don't decode RGBA8 textures from Tmem, as that would require copying from both
-  // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
-  // there's no conversion between formats. In the future this could be extended with a separate
-  // shader, however.
   bool decode_on_gpu = !hires_tex && g_ActiveConfig.UseGPUTextureDecoding() &&
-                       g_texture_cache->SupportsGPUTextureDecode(texformat, tlutfmt) &&
-                       !(from_tmem && texformat == TextureFormat::RGBA8);
+                       g_texture_cache->SupportsGPUTextureDecode(texformat, tlutfmt);
 
   // create the entry/texture
   TextureConfig config;
@@ -778,6 +806,9 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   if (!entry)
     return nullptr;
 
+  // Covers decoding and uploading all levels of the new texture.
+  StageTimings::ScopedTimer decode_timer(StageTimings::Stage::TextureDecode);
+
   const u8* tlut = &texMem[tlutaddr];
   if (hires_tex)
   {
@@ -788,9 +819,23 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
 
   if (!hires_tex && decode_on_gpu)
   {
+    // RGBA8 textures in TMEM are split across both banks. Putting the halves of each block back
+    // together lets the same shader decode them as textures from RAM.
+    const u8* gpu_src_data = src_data;
+    if (from_tmem && texformat == TextureFormat::RGBA8)
+    {
+      CheckTempSize(texture_size);
+      const u8* src_data_gb =
+          &texMem[bpmem.tex[stage / 4].texImage2[stage % 4].tmem_odd * TMEM_LINE_SIZE];
+      TexDecoder_InterleaveRGBA8FromTmem(temp, src_data, src_data_gb, expandedWidth,
+                                         expandedHeight);
+      gpu_src_data = temp;
+    }
+
     u32 row_stride = bytes_per_block * (expandedWidth / bsw);
-    g_texture_cache->DecodeTextureOnGPU(entry, 0, src_data, texture_size, texformat, width, height,
-                                        expandedWidth, expandedHeight, row_stride, tlut, tlutfmt);
+    g_texture_cache->DecodeTextureOnGPU(entry, 0, gpu_src_data, texture_size, texformat, width,
+                                        height, expandedWidth, expandedHeight, row_stride, tlut,
+                                        tlutfmt);
   }
   else if (!hires_tex)
   {
@@ -815,7 +860,8 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       std::max(texture_size, palette_size) <=
           (u32)g_ActiveConfig.iSafeTextureCache_ColorSamples * 8)
   {
-    entry->textures_by_hash_iter = textures_by_hash.emplace(full_hash, entry);
+    textures_by_hash[full_hash].push_back(entry);
+    entry->in_textures_by_hash = true;
   }
 
   entry->SetGeneralParameters(address, texture_size, full_format);
@@ -823,6 +869,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   entry->SetHashes(base_hash, full_hash);
   entry->is_efb_copy = false;
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->pending_hires_texture = std::move(pending_hires_texture);
 
   std::string basename = "";
   if (g_ActiveConfig.bDumpTextures && !hires_tex)
@@ -1225,6 +1272,32 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstF
   unsigned int scaled_tex_h =
       g_ActiveConfig.bCopyEFBScaled ? g_renderer->EFBToScaledY(tex_h) : tex_h;
 
+  INCSTAT(stats.thisFrame.numEFBCopies);
+
+  bool copy_to_ram = !g_ActiveConfig.bSkipEFBCopyToRam;
+  bool copy_to_vram = true;
+
+  // Games often make the same copy several times in a row, e.g. for each pass of a blur. If the EFB
+  // hasn't changed since, neither has the result, which is still in RAM and in its entry.
+  EFBCopyKey key = {srcRect,
+                    dstFormat,
+                    dstStride,
+                    bpmem.zcontrol.hex,
+                    bpmem.triggerEFBCopy.Hex,
+                    {bpmem.copyfilter[0], bpmem.copyfilter[1]},
+                    scaled_tex_w,
+                    scaled_tex_h,
+                    is_depth_copy,
+                    isIntensity,
+                    scaleByHalf,
+                    copy_to_ram,
+                    efb_modification_count};
+  if (!g_bRecordFifoData && FindRepeatedEFBCopy(dstAddr, key))
+  {
+    INCSTAT(stats.thisFrame.numEFBCopiesSkipped);
+    return;
+  }
+
   // Remove all texture cache entries at dstAddr
   //   It's not possible to have two EFB copies at the same address, this makes sure any old efb
   //   copies
@@ -1260,16 +1333,29 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstF
   const u32 bytes_per_row = num_blocks_x * bytes_per_block;
   const u32 covered_range = num_blocks_y * dstStride;
 
-  bool copy_to_ram = !g_ActiveConfig.bSkipEFBCopyToRam;
-  bool copy_to_vram = true;
-
+  // The deterministic GPU thread mode needs the copy to be in RAM by the time the CPU reaches the
+  // next sync point, which deferred copies can't guarantee.
+  std::unique_ptr<PendingEFBCopy> deferred_copy;
   if (copy_to_ram)
   {
     EFBCopyParams format(srcFormat, dstFormat, is_depth_copy, isIntensity);
-    CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, srcRect, scaleByHalf);
+    if (g_ActiveConfig.bDeferEFBCopies && !Fifo::UseDeterministicGPUThread())
+    {
+      deferred_copy = CopyEFBDeferred(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride,
+                                      srcRect, scaleByHalf);
+    }
+
+    if (!deferred_copy)
+    {
+      // Older copies to the same memory must not overwrite this one when they're flushed.
+      FlushEFBCopies(dstAddr, covered_range);
+      CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, srcRect, scaleByHalf);
+    }
   }
   else
   {
+    FlushEFBCopies(dstAddr, covered_range);
+
     // Hack: Most games don't actually need the correct texture data in RAM
     //       and we can just keep a copy in VRAM. We zero the memory so we
     //       can check it hasn't changed before using our copy in VRAM.
@@ -1329,6 +1415,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstF
     ++iter.first;
   }
 
+  TCacheEntry* copy_entry = nullptr;
   if (copy_to_vram)
   {
     // create the texture
@@ -1351,8 +1438,12 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstF
 
       CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, cbufid, colmat);
 
-      u64 hash = entry->CalculateHash();
-      entry->SetHashes(hash, hash);
+      // The hash of a deferred copy is calculated once it has been written to RAM.
+      if (!deferred_copy)
+      {
+        u64 hash = entry->CalculateHash();
+        entry->SetHashes(hash, hash);
+      }
 
       if (g_ActiveConfig.bDumpEFBTarget)
       {
@@ -1364,8 +1455,79 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstF
       }
 
       textures_by_address.emplace(dstAddr, entry);
+      efb_copy_records[dstAddr] = {key, entry};
+      copy_entry = entry;
     }
   }
+
+  if (deferred_copy)
+  {
+    deferred_efb_copies.push_back({dstAddr, covered_range, copy_entry, std::move(deferred_copy)});
+    if (deferred_efb_copies.size() > MAX_DEFERRED_EFB_COPIES)
+      FlushOldestEFBCopies(deferred_efb_copies.size() - MAX_DEFERRED_EFB_COPIES);
+  }
+}
+
+TextureCacheBase::TCacheEntry* TextureCacheBase::FindRepeatedEFBCopy(u32 address,
+                                                                     const EFBCopyKey& key)
+{
+  auto record = efb_copy_records.find(address);
+  if (record == efb_copy_records.end())
+    return nullptr;
+
+  if (!(record->second.key == key))
+  {
+    efb_copy_records.erase(record);
+    return nullptr;
+  }
+
+  // The entry is only hashed once a deferred copy is in RAM, and the copy will overwrite anything
+  // written there until then anyway.
+  TCacheEntry* entry = record->second.entry;
+  auto pending = std::find_if(deferred_efb_copies.begin(), deferred_efb_copies.end(),
+                              [entry](const DeferredEFBCopy& copy) { return copy.entry == entry; });
+  if (pending == deferred_efb_copies.end() && entry->CalculateHash() != entry->hash)
+  {
+    efb_copy_records.erase(record);
+    return nullptr;
+  }
+
+  return entry;
+}
+
+void TextureCacheBase::FlushEFBCopies()
+{
+  FlushOldestEFBCopies(deferred_efb_copies.size());
+}
+
+void TextureCacheBase::FlushEFBCopies(u32 address, u32 size)
+{
+  auto iter = std::find_if(
+      deferred_efb_copies.rbegin(), deferred_efb_copies.rend(),
+      [address, size](const DeferredEFBCopy& copy) {
+        return copy.address < address + size && address < copy.address + copy.size;
+      });
+  FlushOldestEFBCopies(static_cast<size_t>(deferred_efb_copies.rend() - iter));
+}
+
+void TextureCacheBase::FlushOldestEFBCopies(size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    DeferredEFBCopy& copy = deferred_efb_copies.front();
+    copy.copy->Flush();
+    if (copy.entry)
+    {
+      u64 hash = copy.entry->CalculateHash();
+      copy.entry->SetHashes(hash, hash);
+    }
+    deferred_efb_copies.pop_front();
+  }
+}
+
+void TextureCacheBase::DiscardEFBCopies()
+{
+  deferred_efb_copies.clear();
 }
 
 TextureCacheBase::TCacheEntry* TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
@@ -1377,7 +1539,6 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::AllocateCacheEntry(const Textur
     return nullptr;
   }
   TCacheEntry* cacheEntry = new TCacheEntry(std::move(texture));
-  cacheEntry->textures_by_hash_iter = textures_by_hash.end();
   return cacheEntry;
 }
 
@@ -1388,7 +1549,8 @@ std::unique_ptr<AbstractTexture> TextureCacheBase::AllocateTexture(const Texture
   if (iter != texture_pool.end())
   {
     entry = std::move(iter->second.texture);
-    texture_pool.erase(iter);
+    RemoveFromPool(iter);
+    INCSTAT(stats.thisFrame.numTexturesRecycled);
   }
   else
   {
@@ -1397,6 +1559,7 @@ std::unique_ptr<AbstractTexture> TextureCacheBase::AllocateTexture(const Texture
       return nullptr;
 
     INCSTAT(stats.numTexturesCreated);
+    INCSTAT(stats.thisFrame.numTexturesCreated);
   }
 
   return entry;
@@ -1458,12 +1621,19 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter)
 
   TCacheEntry* entry = iter->second;
 
-  if (entry->textures_by_hash_iter != textures_by_hash.end())
+  if (entry->in_textures_by_hash)
   {
-    textures_by_hash.erase(entry->textures_by_hash_iter);
-    entry->textures_by_hash_iter = textures_by_hash.end();
+    std::vector<TCacheEntry*>& hash_entries = textures_by_hash[entry->hash];
+    hash_entries.erase(std::find(hash_entries.begin(), hash_entries.end(), entry));
+    if (hash_entries.empty())
+      textures_by_hash.Erase(entry->hash);
+    entry->in_textures_by_hash = false;
   }
 
+  auto record = efb_copy_records.find(entry->addr);
+  if (record != efb_copy_records.end() && record->second.entry == entry)
+    efb_copy_records.erase(record);
+
   for (size_t i = 0; i < bound_textures.size(); ++i)
   {
     // If the entry is currently bound and not invalidated, keep it, but mark it as invalidated.
@@ -1476,12 +1646,45 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter)
     }
   }
 
-  auto config = entry->texture->GetConfig();
-  texture_pool.emplace(config, TexPoolEntry(std::move(entry->texture)));
+  for (DeferredEFBCopy& copy : deferred_efb_copies)
+  {
+    if (copy.entry == entry)
+      copy.entry = nullptr;
+  }
+
+  ReturnToPool(std::move(entry->texture));
 
   return textures_by_address.erase(iter);
 }
 
+void TextureCacheBase::ReturnToPool(std::unique_ptr<AbstractTexture> texture)
+{
+  const TextureConfig config = texture->GetConfig();
+  texture_pool_size += config.GetMemorySize();
+  texture_pool.emplace(config, TexPoolEntry(std::move(texture)));
+}
+
+TextureCacheBase::TexPool::iterator TextureCacheBase::RemoveFromPool(TexPool::iterator iter)
+{
+  texture_pool_size -= iter->first.GetMemorySize();
+  return texture_pool.erase(iter);
+}
+
+void TextureCacheBase::EvictFromPool()
+{
+  // Games which churn through render targets of many sizes can fill the pool with textures which
+  // are never reused before they expire, so drop the ones which have been unused the longest.
+  while (texture_pool_size > TEXTURE_POOL_MEMORY_BUDGET)
+  {
+    auto oldest = std::min_element(texture_pool.begin(), texture_pool.end(),
+                                   [](const auto& a, const auto& b) {
+                                     return a.second.frameCount < b.second.frameCount;
+                                   });
+    RemoveFromPool(oldest);
+    INCSTAT(stats.thisFrame.numTexturePoolEvictions);
+  }
+}
+
 u32 TextureCacheBase::TCacheEntry::BytesPerRow() const
 {
   const u32 blockW = TexDecoder_GetBlockWidthInTexels(format.texfmt);
@@ -6,13 +6,17 @@
 
 #include <array>
 #include <bitset>
+#include <deque>
 #include <map>
 #include <memory>
+#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FlatHashMap.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
@@ -83,6 +87,10 @@ public:
     bool may_have_overlapping_textures = true;
     bool tmem_only = false;  // indicates that this texture only exists in the tmem cache
 
+    // The name of the custom texture which is still being loaded, while this entry holds the
+    // native texture in the meantime.
+    std::string pending_hires_texture;
+
     unsigned int native_width,
         native_height;  // Texture dimensions from the GameCube's point of view
     unsigned int native_levels;
@@ -90,9 +98,8 @@ public:
     // used to delete textures which haven't been used for TEXTURE_KILL_THRESHOLD frames
     int frameCount = FRAMECOUNT_INVALID;
 
-    // Keep an iterator to the entry in textures_by_hash, so it does not need to be searched when
-    // removing the cache entry
-    std::multimap<u64, TCacheEntry*>::iterator textures_by_hash_iter;
+    // Whether the entry was added to textures_by_hash, under its full hash
+    bool in_textures_by_hash = false;
 
     // This is used to keep track of both:
     //   * efb copies used by this partially updated texture
@@ -150,6 +157,17 @@ public:
     AbstractTextureFormat GetFormat() const { return texture->GetConfig().format; }
   };
 
+  // An EFB copy to RAM which has been encoded on the GPU, but hasn't been written to guest memory
+  // yet, so that the GPU thread doesn't have to wait for the GPU after every copy.
+  class PendingEFBCopy
+  {
+  public:
+    virtual ~PendingEFBCopy() = default;
+
+    // Waits for the GPU to finish the copy if necessary, and writes it to guest memory.
+    virtual void Flush() = 0;
+  };
+
   virtual ~TextureCacheBase();  // needs virtual for DX11 dtor
 
   void OnConfigChanged(VideoConfig& config);
@@ -164,11 +182,35 @@ public:
                        u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
                        bool scale_by_half) = 0;
 
+  // Like CopyEFB, but doesn't wait for the GPU to finish the copy. dst must not be accessed until
+  // the returned copy has been flushed. Backends which can't defer copies return nullptr, and
+  // CopyEFB is used instead.
+  virtual std::unique_ptr<PendingEFBCopy>
+  CopyEFBDeferred(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
+                  u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
+                  bool scale_by_half)
+  {
+    return nullptr;
+  }
+
+  // Writes all deferred EFB copies to guest memory.
+  void FlushEFBCopies();
+  // Writes the deferred EFB copies which overlap the range to guest memory, along with all copies
+  // made before them, so that overlapping copies land in the right order.
+  void FlushEFBCopies(u32 address, u32 size);
+  // Drops the deferred EFB copies without writing them, for when guest memory is replaced.
+  void DiscardEFBCopies();
+
+  // Must be called whenever the EFB is drawn to, cleared, poked or reinterpreted, as repeating an
+  // EFB copy from before then would not give the same result.
+  void OnEFBModified() { ++efb_modification_count; }
+
   virtual bool CompileShaders() = 0;
   virtual void DeleteShaders() = 0;
 
   TCacheEntry* Load(const u32 stage);
   static void InvalidateAllBindPoints() { valid_bind_points.reset(); }
+  static void InvalidateBindPoint(u32 i) { valid_bind_points.reset(i); }
   static bool IsValidBindPoint(u32 i) { return valid_bind_points.test(i); }
   void BindTextures();
   void CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstFormat, u32 dstStride,
@@ -213,7 +255,9 @@ private:
     TexPoolEntry(std::unique_ptr<AbstractTexture> tex) : texture(std::move(tex)) {}
   };
   typedef std::multimap<u32, TCacheEntry*> TexAddrCache;
-  typedef std::multimap<u64, TCacheEntry*> TexHashCache;
+  // Hashes are looked up far more often than entries are added or removed, and there are rarely
+  // multiple entries with the same hash, so keep them in small vectors in a flat hash map.
+  typedef Common::FlatHashMap<u64, std::vector<TCacheEntry*>> TexHashCache;
   typedef std::unordered_multimap<TextureConfig, TexPoolEntry, TextureConfig::Hasher> TexPool;
 
   void SetBackupConfig(const VideoConfig& config);
@@ -230,6 +274,11 @@ private:
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
   std::unique_ptr<AbstractTexture> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
+  // Moves a texture which is no longer used by any entry into the pool.
+  void ReturnToPool(std::unique_ptr<AbstractTexture> texture);
+  TexPool::iterator RemoveFromPool(TexPool::iterator iter);
+  // Destroys the pooled textures which have been unused the longest until the pool fits its budget.
+  void EvictFromPool();
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
   // Return all possible overlapping textures. As addr+size of the textures is not
@@ -248,9 +297,75 @@ private:
 
   TCacheEntry* ReturnEntry(unsigned int stage, TCacheEntry* entry);
 
+  // Flushes the first count deferred EFB copies, in the order they were made.
+  void FlushOldestEFBCopies(size_t count);
+
+  // Everything which determines the result of an EFB copy to a given address.
+  struct EFBCopyKey
+  {
+    EFBRectangle src_rect;
+    EFBCopyFormat dst_format;
+    u32 dst_stride;
+    u32 pixel_format;
+    u32 copy_params;
+    u32 copy_filter[2];
+    u32 scaled_width;
+    u32 scaled_height;
+    bool is_depth_copy;
+    bool is_intensity;
+    bool scale_by_half;
+    bool copy_to_ram;
+    u64 efb_modification_count;
+
+    bool operator==(const EFBCopyKey& rhs) const
+    {
+      return std::tie(src_rect, dst_format, dst_stride, pixel_format, copy_params, copy_filter[0],
+                      copy_filter[1], scaled_width, scaled_height, is_depth_copy, is_intensity,
+                      scale_by_half, copy_to_ram, efb_modification_count) ==
+             std::tie(rhs.src_rect, rhs.dst_format, rhs.dst_stride, rhs.pixel_format,
+                      rhs.copy_params, rhs.copy_filter[0], rhs.copy_filter[1], rhs.scaled_width,
+                      rhs.scaled_height, rhs.is_depth_copy, rhs.is_intensity, rhs.scale_by_half,
+                      rhs.copy_to_ram, rhs.efb_modification_count);
+    }
+  };
+
+  // Returns the entry of the last EFB copy to the address if it was made with the same key and
+  // neither it nor its data in RAM have changed since, so repeating the copy can be skipped.
+  TCacheEntry* FindRepeatedEFBCopy(u32 address, const EFBCopyKey& key);
+
   TexAddrCache textures_by_address;
   TexHashCache textures_by_hash;
   TexPool texture_pool;
+  // Approximate memory taken by the textures in the pool, in bytes.
+  size_t texture_pool_size = 0;
+
+  // Only this many EFB copies are deferred at a time, which bounds the memory used for staging
+  // the copies in the backends.
+  static constexpr size_t MAX_DEFERRED_EFB_COPIES = 16;
+
+  struct DeferredEFBCopy
+  {
+    u32 address;
+    u32 size;
+    // The entry which holds the same copy in VRAM, whose hash can only be calculated once the copy
+    // is in RAM. nullptr if there is none, or if it has been invalidated since.
+    TCacheEntry* entry;
+    std::unique_ptr<PendingEFBCopy> copy;
+  };
+  std::deque<DeferredEFBCopy> deferred_efb_copies;
+
+  // The last EFB copy to each address which still has an entry.
+  struct EFBCopyRecord
+  {
+    EFBCopyKey key;
+    TCacheEntry* entry;
+  };
+  std::unordered_map<u32, EFBCopyRecord> efb_copy_records;
+  u64 efb_modification_count = 0;
+
+  // The files which have already been dumped, or were there already, so that dumping a texture
+  // again doesn't have to ask the file system.
+  std::unordered_set<std::string> dumped_textures;
 
   // Backup configuration values
   struct BackupConfig
@@ -260,6 +375,7 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool async_hires_textures;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
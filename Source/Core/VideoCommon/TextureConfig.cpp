@@ -4,6 +4,7 @@
 
 #include "VideoCommon/TextureConfig.h"
 
+#include <algorithm>
 #include <tuple>
 
 bool TextureConfig::operator==(const TextureConfig& o) const
@@ -16,3 +17,34 @@ MathUtil::Rectangle<int> TextureConfig::GetRect() const
 {
   return {0, 0, static_cast<int>(width), static_cast<int>(height)};
 }
+
+size_t TextureConfig::GetMemorySize() const
+{
+  size_t size = 0;
+  u32 level_width = width;
+  u32 level_height = height;
+  for (u32 level = 0; level < levels; level++)
+  {
+    // Compressed formats are stored in blocks of 4x4 pixels.
+    const size_t blocks = ((level_width + 3) / 4) * ((level_height + 3) / 4);
+    switch (format)
+    {
+    case AbstractTextureFormat::DXT1:
+      size += blocks * 8;
+      break;
+    case AbstractTextureFormat::DXT3:
+    case AbstractTextureFormat::DXT5:
+    case AbstractTextureFormat::BPTC:
+      size += blocks * 16;
+      break;
+    default:
+      size += static_cast<size_t>(level_width) * level_height * 4;
+      break;
+    }
+
+    level_width = std::max(level_width / 2, 1u);
+    level_height = std::max(level_height / 2, 1u);
+  }
+
+  return size * layers;
+}
@@ -24,6 +24,8 @@ struct TextureConfig
   constexpr TextureConfig() = default;
   bool operator==(const TextureConfig& o) const;
   MathUtil::Rectangle<int> GetRect() const;
+  // Approximate amount of memory taken by a texture with this config, in bytes.
+  size_t GetMemorySize() const;
 
   u32 width = 0;
   u32 height = 0;
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
@@ -644,6 +645,22 @@ void TexDecoder_DecodeTexelRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* sr
   dst[2] = val_addr_gb[1];  // B
 }
 
+void TexDecoder_InterleaveRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
+                                        int height)
+{
+  // Each 4x4 block is stored as 32 bytes of AR followed by 32 bytes of GB in main memory, while
+  // TMEM keeps the halves of consecutive blocks in separate banks.
+  const int num_blocks = (width / 4) * (height / 4);
+  for (int i = 0; i < num_blocks; ++i)
+  {
+    std::memcpy(dst, src_ar, 32);
+    std::memcpy(dst + 32, src_gb, 32);
+    dst += 64;
+    src_ar += 32;
+    src_gb += 32;
+  }
+}
+
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height)
 {
@@ -161,6 +161,58 @@ static inline void DecodeBytes_IA4(u32* dst, const u8* src)
   }
 }
 
+// Decodes the first num_colors entries of the TLUT, so that paletted textures can be decoded with a
+// single lookup per texel.
+static void DecodePalette(u32* dst, const u8* tlut_, TLUTFormat tlutfmt, int num_colors)
+{
+  const u16* tlut = (u16*)tlut_;
+  switch (tlutfmt)
+  {
+  case TLUTFormat::IA8:
+    for (int i = 0; i < num_colors; i++)
+      dst[i] = DecodePixel_IA8(tlut[i]);
+    break;
+
+  case TLUTFormat::RGB565:
+    for (int i = 0; i < num_colors; i++)
+      dst[i] = DecodePixel_RGB565(Common::swap16(tlut[i]));
+    break;
+
+  case TLUTFormat::RGB5A3:
+    for (int i = 0; i < num_colors; i++)
+      dst[i] = DecodePixel_RGB5A3(Common::swap16(tlut[i]));
+    break;
+
+  default:
+    break;
+  }
+}
+
+// Expands the eight 4-bit values of 4 bytes (high nibble first) to the 32-bit lanes of the result.
+FUNCTION_TARGET_AVX2
+static inline __m256i ExpandNibbles_AVX2(__m128i bytes)
+{
+  const __m256i shifts = _mm256_set_epi32(0, 4, 0, 4, 0, 4, 0, 4);
+  const __m256i doubled = _mm256_cvtepu8_epi32(_mm_unpacklo_epi8(bytes, bytes));
+  return _mm256_and_si256(_mm256_srlv_epi32(doubled, shifts), _mm256_set1_epi32(0xf));
+}
+
+// Converts 8 big-endian 16-bit values to the 32-bit lanes of the result.
+FUNCTION_TARGET_AVX2
+static inline __m256i LoadSwapped16_AVX2(const u8* src)
+{
+  const __m128i swap16 = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  return _mm256_cvtepu16_epi32(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), swap16));
+}
+
+// Stores the 4 texels in each half of the value to two rows of the destination.
+FUNCTION_TARGET_AVX2
+static inline void StoreTwoRows_AVX2(u32* row0, u32* row1, __m256i texels)
+{
+  _mm_storeu_si128((__m128i*)row0, _mm256_castsi256_si128(texels));
+  _mm_storeu_si128((__m128i*)row1, _mm256_extracti128_si256(texels, 1));
+}
+
 #ifdef CHECK
 static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
 {
@@ -250,6 +302,60 @@ static void TexDecoder_DecodeImpl_C4(u32* dst, const u8* src, int width, int hei
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  if (!IsValidTLUTFormat(tlutfmt))
+    return;
+
+  alignas(32) u32 palette[16];
+  DecodePalette(palette, tlut, tlutfmt, 16);
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 8; iy += 2, xStep++)
+      {
+        // Each 64-bit read contains the indices of two rows.
+        const __m128i r0 = _mm_loadl_epi64((const __m128i*)(src + 8 * xStep));
+        const __m256i row0 = ExpandNibbles_AVX2(r0);
+        const __m256i row1 = ExpandNibbles_AVX2(_mm_srli_si128(r0, 4));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x),
+                            _mm256_i32gather_epi32((const int*)palette, row0, 4));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy + 1) * width + x),
+                            _mm256_i32gather_epi32((const int*)palette, row1, 4));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Replicate each 4-bit intensity to all 8 nibbles of the texel.
+  const __m256i kReplicate = _mm256_set1_epi32(0x11111111);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 8; iy += 2, xStep++)
+      {
+        const __m128i r0 = _mm_loadl_epi64((const __m128i*)(src + 8 * xStep));
+        const __m256i row0 = _mm256_mullo_epi32(ExpandNibbles_AVX2(r0), kReplicate);
+        const __m256i row1 =
+            _mm256_mullo_epi32(ExpandNibbles_AVX2(_mm_srli_si128(r0, 4)), kReplicate);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), row0);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy + 1) * width + x), row1);
+      }
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_I4_SSSE3(u32* dst, const u8* src, int width, int height,
                                            TextureFormat texformat, const u8* tlut,
@@ -390,6 +496,26 @@ static void TexDecoder_DecodeImpl_I4(u32* dst, const u8* src, int width, int hei
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i kReplicate = _mm256_set1_epi32(0x01010101);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; ++iy, xStep++)
+      {
+        const __m128i r = _mm_loadl_epi64((const __m128i*)(src + 8 * xStep));
+        const __m256i rgba = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(r), kReplicate);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), rgba);
+      }
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_I8_SSSE3(u32* dst, const u8* src, int width, int height,
                                            TextureFormat texformat, const u8* tlut,
@@ -575,6 +701,81 @@ static void TexDecoder_DecodeImpl_IA4(u32* dst, const u8* src, int width, int he
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  if (!IsValidTLUTFormat(tlutfmt))
+    return;
+
+  alignas(32) u32 palette[256];
+  DecodePalette(palette, tlut, tlutfmt, 256);
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        const __m128i r = _mm_loadl_epi64((const __m128i*)(src + 8 * xStep));
+        const __m256i rgba =
+            _mm256_i32gather_epi32((const int*)palette, _mm256_cvtepu8_epi32(r), 4);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), rgba);
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA4_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // The low nibble is the intensity, which goes to R, G and B, the high nibble is the alpha.
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0f);
+  const __m256i kReplicateI = _mm256_set1_epi32(0x00111111);
+  const __m256i kReplicateA = _mm256_set1_epi32(0x11000000);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        const __m256i val =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + 8 * xStep)));
+        const __m256i i = _mm256_mullo_epi32(_mm256_and_si256(val, kMask_x0f), kReplicateI);
+        const __m256i a = _mm256_mullo_epi32(_mm256_srli_epi32(val, 4), kReplicateA);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), _mm256_or_si256(i, a));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Expands each zero-extended 16-bit "IA" to a 32-bit "AIII", in both 128-bit lanes.
+  const __m256i mask = _mm256_set_epi8(12, 13, 13, 13, 8, 9, 9, 9, 4, 5, 5, 5, 0, 1, 1, 1, 12, 13,
+                                       13, 13, 8, 9, 9, 9, 4, 5, 5, 5, 0, 1, 1, 1);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        // Each 128-bit read contains two rows.
+        const __m256i r0 =
+            _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + 8 * xStep)));
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, dst + (y + iy + 1) * width + x,
+                          _mm256_shuffle_epi8(r0, mask));
+      }
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_IA8_SSSE3(u32* dst, const u8* src, int width, int height,
                                             TextureFormat texformat, const u8* tlut,
@@ -770,6 +971,96 @@ static void TexDecoder_DecodeImpl_RGB565(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB565_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x1f);
+  const __m256i kMask_x3f = _mm256_set1_epi32(0x3f);
+  const __m256i kAlpha = _mm256_set1_epi32(0xFF000000);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m256i val = LoadSwapped16_AVX2(src + 8 * xStep);
+
+        // Swizzle bits: 00012345 -> 12345123 and 00123456 -> 12345612
+        const __m256i tmpr = _mm256_srli_epi32(val, 11);
+        const __m256i r = _mm256_or_si256(_mm256_slli_epi32(tmpr, 3), _mm256_srli_epi32(tmpr, 2));
+        const __m256i tmpg = _mm256_and_si256(_mm256_srli_epi32(val, 5), kMask_x3f);
+        const __m256i g = _mm256_or_si256(_mm256_slli_epi32(tmpg, 2), _mm256_srli_epi32(tmpg, 4));
+        const __m256i tmpb = _mm256_and_si256(val, kMask_x1f);
+        const __m256i b = _mm256_or_si256(_mm256_slli_epi32(tmpb, 3), _mm256_srli_epi32(tmpb, 2));
+
+        const __m256i rgba = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                             _mm256_or_si256(_mm256_slli_epi32(b, 16), kAlpha));
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, dst + (y + iy + 1) * width + x, rgba);
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB5A3_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x1f);
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0f);
+  const __m256i kMask_x07 = _mm256_set1_epi32(0x07);
+  const __m256i kAlpha = _mm256_set1_epi32(0xFF000000);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m256i val = LoadSwapped16_AVX2(src + 8 * xStep);
+
+        // Decode all texels as both RGB555 and RGBA4443, then select the right one per texel,
+        // which is cheaper than branching on mixed blocks.
+
+        // RGB555: Swizzle bits: 00012345 -> 12345123
+        const __m256i tmpr5 = _mm256_and_si256(_mm256_srli_epi32(val, 10), kMask_x1f);
+        const __m256i r5 =
+            _mm256_or_si256(_mm256_slli_epi32(tmpr5, 3), _mm256_srli_epi32(tmpr5, 2));
+        const __m256i tmpg5 = _mm256_and_si256(_mm256_srli_epi32(val, 5), kMask_x1f);
+        const __m256i g5 =
+            _mm256_or_si256(_mm256_slli_epi32(tmpg5, 3), _mm256_srli_epi32(tmpg5, 2));
+        const __m256i tmpb5 = _mm256_and_si256(val, kMask_x1f);
+        const __m256i b5 =
+            _mm256_or_si256(_mm256_slli_epi32(tmpb5, 3), _mm256_srli_epi32(tmpb5, 2));
+        const __m256i rgb555 =
+            _mm256_or_si256(_mm256_or_si256(r5, _mm256_slli_epi32(g5, 8)),
+                            _mm256_or_si256(_mm256_slli_epi32(b5, 16), kAlpha));
+
+        // RGBA4443: Swizzle bits: 00001234 -> 12341234 and 00000123 -> 12312312
+        const __m256i r4 = _mm256_and_si256(_mm256_srli_epi32(val, 8), kMask_x0f);
+        const __m256i g4 = _mm256_and_si256(_mm256_srli_epi32(val, 4), kMask_x0f);
+        const __m256i b4 = _mm256_and_si256(val, kMask_x0f);
+        const __m256i tmpa3 = _mm256_and_si256(_mm256_srli_epi32(val, 12), kMask_x07);
+        const __m256i a3 = _mm256_or_si256(
+            _mm256_slli_epi32(tmpa3, 5),
+            _mm256_or_si256(_mm256_slli_epi32(tmpa3, 2), _mm256_srli_epi32(tmpa3, 1)));
+        // Each color nibble is in its own byte, so they can all be replicated with a single shift.
+        const __m256i rgb444 = _mm256_or_si256(_mm256_or_si256(r4, _mm256_slli_epi32(g4, 8)),
+                                               _mm256_slli_epi32(b4, 16));
+        const __m256i rgba4443 =
+            _mm256_or_si256(_mm256_or_si256(rgb444, _mm256_slli_epi32(rgb444, 4)),
+                            _mm256_slli_epi32(a3, 24));
+
+        // Bit 15 selects the RGB555 encoding.
+        const __m256i is_rgb555 = _mm256_srai_epi32(_mm256_slli_epi32(val, 16), 31);
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, dst + (y + iy + 1) * width + x,
+                          _mm256_blendv_epi8(rgba4443, rgb555, is_rgb555));
+      }
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGB5A3_SSSE3(u32* dst, const u8* src, int width, int height,
                                                TextureFormat texformat, const u8* tlut,
@@ -997,6 +1288,32 @@ static void TexDecoder_DecodeImpl_RGB5A3(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGBA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i mask0312 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(12, 15, 13, 14, 8, 11, 9, 10, 4, 7, 5, 6, 0, 3, 1, 2));
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      // The AR and GB halves of the block each fit in a single register.
+      const u8* src2 = src + 64 * yStep;
+      const __m256i ar = _mm256_loadu_si256((const __m256i*)src2);
+      const __m256i gb = _mm256_loadu_si256((const __m256i*)src2 + 1);
+
+      // Rows 0 and 2, and rows 1 and 3.
+      const __m256i rgba02 = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(ar, gb), mask0312);
+      const __m256i rgba13 = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(ar, gb), mask0312);
+
+      StoreTwoRows_AVX2(dst + (y + 0) * width + x, dst + (y + 2) * width + x, rgba02);
+      StoreTwoRows_AVX2(dst + (y + 1) * width + x, dst + (y + 3) * width + x, rgba13);
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGBA8_SSSE3(u32* dst, const u8* src, int width, int height,
                                               TextureFormat texformat, const u8* tlut,
@@ -1418,11 +1735,18 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   switch (texformat)
   {
   case TextureFormat::C4:
-    TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::I4:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I4_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1430,7 +1754,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::I8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1438,15 +1765,27 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C8:
-    TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::IA4:
-    TexDecoder_DecodeImpl_IA4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else
+      TexDecoder_DecodeImpl_IA4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                Wsteps8);
     break;
 
   case TextureFormat::IA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_IA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                       Wsteps8);
     else
@@ -1460,12 +1799,19 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGB565:
-    TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                 Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB565_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else
+      TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                   Wsteps8);
     break;
 
   case TextureFormat::RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB5A3_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1474,7 +1820,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGBA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGBA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGBA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                         Wsteps8);
     else
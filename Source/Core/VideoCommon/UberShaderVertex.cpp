@@ -30,6 +30,8 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
   const bool ssaa = host_config.ssaa;
   const bool per_pixel_lighting = host_config.per_pixel_lighting;
   const bool vertex_rounding = host_config.vertex_rounding;
+  // Stereo can be done without a geometry shader if the vertex shader can select the layer.
+  const bool stereo = host_config.stereo && host_config.backend_vs_layer;
   const u32 numTexgen = uid_data->num_texgens;
   ShaderCode out;
 
@@ -69,6 +71,8 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
       out.Write("VARYING_LOCATION(0) out VertexData {\n");
       GenerateVSOutputMembers(out, ApiType, numTexgen, per_pixel_lighting,
                               GetInterpolationQualifier(msaa, ssaa, true, false));
+      if (stereo)
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
     }
     else
@@ -254,9 +258,26 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
 
   if (ApiType == APIType::OpenGL || ApiType == APIType::Vulkan)
   {
+    if (stereo)
+    {
+      // Triangles render the eyes as two instances, with the same offset the geometry shader
+      // applies otherwise. Other primitives are duplicated by the geometry shader, which ignores
+      // the layer.
+      out.Write("int eye = %s;\n",
+                ApiType == APIType::Vulkan ? "gl_InstanceIndex" : "gl_InstanceID");
+      out.Write("if (" I_VSSTEREOPARAMS ".w != 0.0)\n");
+      out.Write("{\n");
+      out.Write("\tfloat hoffset = (eye == 0) ? " I_VSSTEREOPARAMS ".x : " I_VSSTEREOPARAMS
+                ".y;\n");
+      out.Write("\to.pos.x += hoffset * (o.pos.w - " I_VSSTEREOPARAMS ".z);\n");
+      out.Write("}\n");
+    }
+
     if (host_config.backend_geometry_shaders || ApiType == APIType::Vulkan)
     {
       AssignVSOutputMembers(out, "vs", "o", numTexgen, per_pixel_lighting);
+      if (stereo)
+        out.Write("vs.layer = eye;\n");
     }
     else
     {
@@ -280,6 +301,9 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
       out.Write("gl_ClipDistance[1] = o.clipDist1;\n");
     }
 
+    if (stereo)
+      out.Write("gl_Layer = eye;\n");
+
     // Vulkan NDC space has Y pointing down (right-handed NDC space).
     if (ApiType == APIType::Vulkan)
       out.Write("gl_Position = float4(o.pos.x, -o.pos.y, o.pos.z, o.pos.w);\n");
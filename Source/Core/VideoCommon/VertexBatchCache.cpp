@@ -0,0 +1,223 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/VertexBatchCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/Swap.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+
+static int GetComponentSize(int format)
+{
+  static constexpr int sizes[] = {1, 1, 2, 2, 4};
+  return format <= FORMAT_FLOAT ? sizes[format] : 4;
+}
+
+static int GetColorSize(int format)
+{
+  static constexpr int sizes[] = {2, 3, 4, 2, 3, 4};
+  return format <= FORMAT_32B_8888 ? sizes[format] : 4;
+}
+
+static u64 CombineHash(u64 hash, u64 value)
+{
+  return (hash ^ value) * 0x100000001B3ULL;
+}
+
+VertexBatchCache::VertexBatchCache()
+{
+  SetHash64Function();
+}
+
+int VertexBatchCache::ConvertVertices(VertexLoaderBase* loader, DataReader src, DataReader dst,
+                                      int count)
+{
+  const Layout& layout = GetLayout(loader);
+  if (!layout.cacheable || count < MIN_VERTICES)
+    return VertexLoaderManager::ConvertVertices(loader, src, dst, count);
+
+  u64 arrays_hash;
+  if (!HashArrays(layout, src.GetPointer(), loader->m_VertexSize, count, &arrays_hash))
+    return VertexLoaderManager::ConvertVertices(loader, src, dst, count);
+
+  const u32 src_size = static_cast<u32>(count * loader->m_VertexSize);
+  u64 key = GetHash64(src.GetPointer(), src_size, 0);
+  key = CombineHash(key, reinterpret_cast<uintptr_t>(loader));
+  key = CombineHash(key, static_cast<u64>(count));
+
+  auto it = m_entries.find(key);
+  if (it != m_entries.end() && it->second.loader == loader && it->second.input_count == count &&
+      it->second.arrays_hash == arrays_hash)
+  {
+    const Entry& entry = it->second;
+    std::memcpy(dst.GetPointer(), entry.data.data(), entry.data.size());
+    std::memcpy(VertexLoaderManager::position_cache, entry.position_cache,
+                sizeof(entry.position_cache));
+    std::memcpy(VertexLoaderManager::position_matrix_index, entry.position_matrix_index,
+                sizeof(entry.position_matrix_index));
+    loader->m_numLoadedVertices += count;
+    return entry.output_count;
+  }
+
+  const int output_count = VertexLoaderManager::ConvertVertices(loader, src, dst, count);
+  const size_t output_size = output_count * loader->m_native_vtx_decl.stride;
+
+  if (it != m_entries.end())
+  {
+    m_size -= it->second.data.size();
+  }
+  else if (m_size + output_size > MAX_SIZE)
+  {
+    m_entries.clear();
+    m_size = 0;
+  }
+
+  Entry& entry = m_entries[key];
+  entry.loader = loader;
+  entry.input_count = count;
+  entry.arrays_hash = arrays_hash;
+  entry.output_count = output_count;
+  entry.data.assign(dst.GetPointer(), dst.GetPointer() + output_size);
+  std::memcpy(entry.position_cache, VertexLoaderManager::position_cache,
+              sizeof(entry.position_cache));
+  std::memcpy(entry.position_matrix_index, VertexLoaderManager::position_matrix_index,
+              sizeof(entry.position_matrix_index));
+  m_size += output_size;
+
+  return output_count;
+}
+
+void VertexBatchCache::Clear()
+{
+  m_layouts.clear();
+  m_entries.clear();
+  m_size = 0;
+}
+
+const VertexBatchCache::Layout& VertexBatchCache::GetLayout(const VertexLoaderBase* loader)
+{
+  auto it = m_layouts.find(loader);
+  if (it == m_layouts.end())
+    it = m_layouts.emplace(loader, ComputeLayout(loader)).first;
+  return it->second;
+}
+
+VertexBatchCache::Layout VertexBatchCache::ComputeLayout(const VertexLoaderBase* loader)
+{
+  TVtxDesc vtx_desc = loader->GetVtxDesc();
+  const TVtxAttr& vtx_attr = loader->GetVtxAttr();
+  Layout layout;
+
+  // The matrix indices come first, one byte each.
+  int offset = 0;
+  for (int i = 0; i < 9; ++i)
+    offset += (vtx_desc.Hex >> i) & 1;
+
+  for (int i = 0; i < 12; ++i)
+  {
+    const u32 status = vtx_desc.GetVertexArrayStatus(i);
+    if (status == NOT_PRESENT)
+      continue;
+
+    int element_size;
+    int num_indices = 1;
+    if (i == ARRAY_POSITION)
+    {
+      element_size = GetComponentSize(vtx_attr.PosFormat) * (vtx_attr.PosElements ? 3 : 2);
+    }
+    else if (i == ARRAY_NORMAL)
+    {
+      // With NormalIndex3, the normal, binormal and tangent each have their own index.
+      const int normal_size = GetComponentSize(vtx_attr.NormalFormat) * 3;
+      const bool nbt = vtx_attr.NormalElements != 0;
+      num_indices = nbt && vtx_attr.NormalIndex3 && status != DIRECT ? 3 : 1;
+      element_size = nbt && num_indices == 1 ? normal_size * 3 : normal_size;
+    }
+    else if (i < ARRAY_TEXCOORD0)
+    {
+      element_size = GetColorSize(vtx_attr.color[i - ARRAY_COLOR].Comp);
+    }
+    else
+    {
+      const TexAttr& tex = vtx_attr.texCoord[i - ARRAY_TEXCOORD0];
+      element_size = GetComponentSize(tex.Format) * (tex.Elements ? 2 : 1);
+    }
+
+    if (status == DIRECT)
+    {
+      offset += element_size;
+      continue;
+    }
+
+    const int index_size = status == INDEX8 ? 1 : 2;
+    for (int j = 0; j < num_indices; ++j)
+    {
+      layout.attributes.push_back({i, offset, index_size, j * element_size, element_size});
+      offset += index_size;
+    }
+  }
+
+  // Only batches which reference arrays are worth caching. If the layout doesn't add up, some
+  // format isn't handled like the loaders do, so leave those alone too.
+  layout.cacheable = !layout.attributes.empty() && offset == loader->m_VertexSize;
+  return layout;
+}
+
+bool VertexBatchCache::HashArrays(const Layout& layout, const u8* src, int vertex_size,
+                                  int count, u64* hash)
+{
+  u64 result = 0;
+  for (const IndexedAttribute& attr : layout.attributes)
+  {
+    // Position indices with all bits set skip the vertex without reading the arrays.
+    const u32 skip_index = attr.array == ARRAY_POSITION ? (1u << (attr.index_size * 8)) - 1 : ~0u;
+    u32 min_index = ~0u;
+    u32 max_index = 0;
+    const u8* index_ptr = src + attr.offset;
+    for (int i = 0; i < count; ++i, index_ptr += vertex_size)
+    {
+      u32 index;
+      if (attr.index_size == 1)
+      {
+        index = *index_ptr;
+      }
+      else
+      {
+        u16 value;
+        std::memcpy(&value, index_ptr, sizeof(value));
+        index = Common::swap16(value);
+      }
+
+      if (index == skip_index)
+        continue;
+      min_index = std::min(min_index, index);
+      max_index = std::max(max_index, index);
+    }
+
+    if (min_index > max_index)
+      continue;
+
+    const u8* base = VertexLoaderManager::cached_arraybases[attr.array];
+    const u32 stride = g_main_cp_state.array_strides[attr.array];
+    const size_t range = (max_index - min_index) * stride + attr.element_size;
+    if (!base || range > MAX_ARRAY_RANGE)
+      return false;
+
+    result = CombineHash(result, g_main_cp_state.array_bases[attr.array]);
+    result = CombineHash(result, stride);
+    result = CombineHash(result, min_index);
+    result = CombineHash(result, GetHash64(base + min_index * stride + attr.element_offset,
+                                           static_cast<u32>(range), 0));
+  }
+
+  *hash = result;
+  return true;
+}
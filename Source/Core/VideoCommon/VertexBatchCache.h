@@ -0,0 +1,79 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// Keeps the output of the vertex loaders around for batches which are drawn again and again
+// from the same, unchanged vertex arrays, like static scenery.
+//
+// There is no way to tell whether the emulated CPU wrote to the vertex arrays in the meantime,
+// so a cached batch is only reused if the hashes of its raw vertex data and of every array range
+// its indices refer to still match. Checking those is a lot cheaper than running the loader for
+// vertices with many indexed attributes.
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class DataReader;
+class VertexLoaderBase;
+
+class VertexBatchCache
+{
+public:
+  VertexBatchCache();
+
+  // Converts count vertices from src to dst like VertexLoaderManager::ConvertVertices(), but
+  // copies the result of an earlier identical batch instead if there is one.
+  // Returns the number of vertices written.
+  int ConvertVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count);
+
+  // Must be called before any vertex loader is destroyed.
+  void Clear();
+
+private:
+  // Batches smaller than this are converted straight away.
+  static constexpr int MIN_VERTICES = 32;
+  // The whole cache is thrown away once there is more converted data than this.
+  static constexpr size_t MAX_SIZE = 64 * 1024 * 1024;
+  // Batches whose indices span more array memory than this are not worth hashing.
+  static constexpr size_t MAX_ARRAY_RANGE = 1024 * 1024;
+
+  struct IndexedAttribute
+  {
+    int array;
+    int offset;
+    int index_size;
+    int element_offset;
+    int element_size;
+  };
+
+  struct Layout
+  {
+    bool cacheable;
+    std::vector<IndexedAttribute> attributes;
+  };
+
+  struct Entry
+  {
+    const VertexLoaderBase* loader;
+    int input_count;
+    u64 arrays_hash;
+    int output_count;
+    std::vector<u8> data;
+    float position_cache[3][4];
+    u32 position_matrix_index[4];
+  };
+
+  const Layout& GetLayout(const VertexLoaderBase* loader);
+  static Layout ComputeLayout(const VertexLoaderBase* loader);
+  static bool HashArrays(const Layout& layout, const u8* src, int vertex_size, int count,
+                         u64* hash);
+
+  std::unordered_map<const VertexLoaderBase*, Layout> m_layouts;
+  std::unordered_map<u64, Entry> m_entries;
+  size_t m_size = 0;
+};
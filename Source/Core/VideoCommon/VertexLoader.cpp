@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 
@@ -65,12 +67,102 @@ static void SkipVertex(VertexLoader* loader)
   }
 }
 
+namespace
+{
+// A pipeline with its stages known at compile time, so that they are inlined into a single loop
+// instead of being called through m_PipelineStages once per attribute and vertex.
+template <TPipelineFunction... stages>
+struct SpecializedPipeline
+{
+  static constexpr TPipelineFunction functions[] = {stages...};
+
+  static void Run(VertexLoader* loader, int count)
+  {
+    for (loader->m_counter = count - 1; loader->m_counter >= 0; loader->m_counter--)
+    {
+      loader->m_tcIndex = 0;
+      loader->m_colIndex = 0;
+      loader->m_texmtxwrite = loader->m_texmtxread = 0;
+      (stages(loader), ...);
+      PRIM_LOG("\n");
+    }
+  }
+};
+
+struct SpecializedPipelineEntry
+{
+  const TPipelineFunction* stages;
+  int num_stages;
+  VertexLoader::TSpecializedPipeline run;
+};
+
+template <TPipelineFunction... stages>
+constexpr SpecializedPipelineEntry Specialize()
+{
+  using Pipeline = SpecializedPipeline<stages...>;
+  return {Pipeline::functions, static_cast<int>(sizeof...(stages)), Pipeline::Run};
+}
+
+// The most common vertex formats, keyed by the pipeline CompileVertexTranslator builds for them.
+// Formats which only differ in ways that don't change the stages (like the fractional bits) share
+// an entry.
+constexpr SpecializedPipelineEntry s_specialized_pipelines[] = {
+    // Direct float positions, optionally with a color and a texture coordinate, as used for 2D
+    // and full screen passes.
+    Specialize<Pos_ReadDirect<float, 3>>(),
+    Specialize<Pos_ReadDirect<float, 3>, Color_ReadDirect_32b_8888>(),
+    Specialize<Pos_ReadDirect<float, 3>, Color_ReadDirect_32b_8888,
+               TexCoord_ReadDirect<float, 2>>(),
+    Specialize<Pos_ReadDirect<float, 3>, TexCoord_ReadDirect<float, 2>>(),
+
+    // Quantized indexed models: s16 positions, s8 normals, a color and s16 texture coordinates.
+    Specialize<PosMtx_ReadDirect_UByte, Pos_ReadIndex<u16, s16, 3>,
+               Normal_Index<u16, s8, 1>::function, Color_ReadIndex16_32b_8888,
+               TexCoord_ReadIndex<u16, s16, 2>, SkipVertex>(),
+    Specialize<Pos_ReadIndex<u16, s16, 3>, Normal_Index<u16, s8, 1>::function,
+               Color_ReadIndex16_32b_8888, TexCoord_ReadIndex<u16, s16, 2>, SkipVertex>(),
+    Specialize<PosMtx_ReadDirect_UByte, Pos_ReadIndex<u16, s16, 3>,
+               Normal_Index<u16, s8, 1>::function, TexCoord_ReadIndex<u16, s16, 2>, SkipVertex>(),
+
+    // Indexed float models.
+    Specialize<Pos_ReadIndex<u16, float, 3>, Normal_Index<u16, float, 1>::function,
+               TexCoord_ReadIndex<u16, float, 2>, SkipVertex>(),
+    Specialize<PosMtx_ReadDirect_UByte, Pos_ReadIndex<u16, float, 3>,
+               Normal_Index<u16, float, 1>::function, Color_ReadIndex16_32b_8888,
+               TexCoord_ReadIndex<u16, float, 2>, SkipVertex>(),
+    Specialize<PosMtx_ReadDirect_UByte, TexMtx_ReadDirect_UByte, TexMtx_ReadDirect_UByte,
+               Pos_ReadIndex<u16, float, 3>, Normal_Index<u16, float, 3>::function,
+               Color_ReadIndex16_32b_8888, Color_ReadIndex16_32b_8888,
+               TexCoord_ReadIndex<u16, float, 2>, TexMtx_Write_Float,
+               TexCoord_ReadIndex<u16, float, 2>, TexMtx_Write_Float, SkipVertex>(),
+
+    // Metroid Prime: P I16-flt N I16-s16 T0 I16-u16 T1 I16-flt
+    Specialize<Pos_ReadIndex<u16, float, 3>, Normal_Index<u16, s16, 1>::function,
+               TexCoord_ReadIndex<u16, u16, 2>, TexCoord_ReadIndex<u16, float, 2>, SkipVertex>(),
+};
+
+VertexLoader::TSpecializedPipeline FindSpecializedPipeline(const TPipelineFunction* stages,
+                                                           int num_stages)
+{
+  for (const SpecializedPipelineEntry& entry : s_specialized_pipelines)
+  {
+    if (entry.num_stages == num_stages &&
+        std::equal(entry.stages, entry.stages + num_stages, stages))
+    {
+      return entry.run;
+    }
+  }
+  return nullptr;
+}
+}  // Anonymous namespace
+
 VertexLoader::VertexLoader(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
     : VertexLoaderBase(vtx_desc, vtx_attr)
 {
   VertexLoader_Normal::Init();
 
   CompileVertexTranslator();
+  m_specialized_pipeline = FindSpecializedPipeline(m_PipelineStages, m_numPipelineStages);
 
   // generate frac factors
   m_posScale = 1.0f / (1U << m_VtxAttr.PosFrac);
@@ -408,14 +500,21 @@ int VertexLoader::RunVertices(DataReader src, DataReader dst, int count)
   m_numLoadedVertices += count;
   m_skippedVertices = 0;
 
-  for (m_counter = count - 1; m_counter >= 0; m_counter--)
+  if (m_specialized_pipeline)
+  {
+    m_specialized_pipeline(this, count);
+  }
+  else
   {
-    m_tcIndex = 0;
-    m_colIndex = 0;
-    m_texmtxwrite = m_texmtxread = 0;
-    for (int i = 0; i < m_numPipelineStages; i++)
-      m_PipelineStages[i](this);
-    PRIM_LOG("\n");
+    for (m_counter = count - 1; m_counter >= 0; m_counter--)
+    {
+      m_tcIndex = 0;
+      m_colIndex = 0;
+      m_texmtxwrite = m_texmtxread = 0;
+      for (int i = 0; i < m_numPipelineStages; i++)
+        m_PipelineStages[i](this);
+      PRIM_LOG("\n");
+    }
   }
 
   return count - m_skippedVertices;
@@ -21,6 +21,8 @@ class VertexLoader : public VertexLoaderBase
 public:
   VertexLoader(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
 
+  typedef void (*TSpecializedPipeline)(VertexLoader* loader, int count);
+
   int RunVertices(DataReader src, DataReader dst, int count) override;
   std::string GetName() const override { return "OldLoader"; }
   bool IsInitialized() override { return true; }  // This vertex loader supports all formats
@@ -44,6 +46,8 @@ private:
   // Pipeline.
   TPipelineFunction m_PipelineStages[64];  // TODO - figure out real max. it's lower.
   int m_numPipelineStages;
+  // Compiled in for common vertex formats, nullptr if m_PipelineStages has to be used.
+  TSpecializedPipeline m_specialized_pipeline;
 
   void CompileVertexTranslator();
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -66,11 +67,19 @@ public:
 
   virtual bool IsInitialized() = 0;
 
+  // Whether RunVertices() may be called on different parts of a batch from several threads at
+  // once. The only state the JIT loaders carry from one vertex to the next is the zfreeze
+  // position cache, which is written for the last three vertices of each call.
+  virtual bool IsThreadSafe() const { return false; }
+
   // For debugging / profiling
   std::string ToString() const;
 
   virtual std::string GetName() const = 0;
 
+  const TVtxDesc& GetVtxDesc() const { return m_VtxDesc; }
+  const TVtxAttr& GetVtxAttr() const { return m_VtxAttr; }
+
   // per loader public state
   int m_VertexSize = 0;  // number of bytes of a raw GC vertex
   PortableVertexDeclaration m_native_vtx_decl{};
@@ -78,7 +87,7 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  std::atomic<int> m_numLoadedVertices{0};
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -13,17 +14,21 @@
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
+#include "VideoCommon/VertexBatchCache.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace VertexLoaderManager
 {
@@ -44,6 +49,10 @@ static VertexLoaderMap s_vertex_loader_map;
 
 u8* cached_arraybases[12];
 
+// Only used by the thread which runs the vertex loaders.
+static std::unique_ptr<Common::WorkerPool> s_converter_pool;
+static std::unique_ptr<VertexBatchCache> s_batch_cache;
+
 void Init()
 {
   MarkAllDirty();
@@ -59,6 +68,8 @@ void Clear()
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
+  s_converter_pool.reset();
+  s_batch_cache.reset();
 }
 
 void UpdateVertexArrayPointers()
@@ -195,9 +206,9 @@ NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl)
   return GetOrCreateMatchingFormat(new_decl);
 }
 
-static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = false)
+static VertexLoaderBase* RefreshLoader(int vtx_attr_group, CPState* state)
 {
-  CPState* state = preprocess ? &g_preprocess_cp_state : &g_main_cp_state;
+  const bool preprocess = state != &g_main_cp_state;
   state->last_id = vtx_attr_group;
 
   VertexLoaderBase* loader;
@@ -253,7 +264,8 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   if (!count)
     return 0;
 
-  VertexLoaderBase* loader = RefreshLoader(vtx_attr_group, is_preprocess);
+  VertexLoaderBase* loader =
+      RefreshLoader(vtx_attr_group, is_preprocess ? &g_preprocess_cp_state : &g_main_cp_state);
 
   int size = count * loader->m_VertexSize;
   if ((int)src.size() < size)
@@ -262,6 +274,8 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   if (is_preprocess)
     return size;
 
+  StageTimings::ScopedTimer timer(StageTimings::Stage::VertexLoading);
+
   // If the native vertex format changed, force a flush.
   if (loader->m_native_vertex_format != s_current_vtx_fmt ||
       loader->m_native_components != g_current_components)
@@ -280,7 +294,18 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  SetVertexLoaderThreads(static_cast<u32>(std::max(g_ActiveConfig.iVertexLoaderThreads, 0)));
+  if (g_ActiveConfig.bVertexLoaderCache)
+  {
+    if (!s_batch_cache)
+      s_batch_cache = std::make_unique<VertexBatchCache>();
+    count = s_batch_cache->ConvertVertices(loader, src, dst, count);
+  }
+  else
+  {
+    s_batch_cache.reset();
+    count = ConvertVertices(loader, src, dst, count);
+  }
 
   IndexGenerator::AddIndices(primitive, count);
 
@@ -291,6 +316,70 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   return size;
 }
 
+void SetVertexLoaderThreads(u32 num_threads)
+{
+  const size_t current = s_converter_pool ? s_converter_pool->GetNumWorkers() : 0;
+  if (num_threads == current)
+    return;
+
+  s_converter_pool.reset();
+  if (num_threads > 0)
+    s_converter_pool =
+        std::make_unique<Common::WorkerPool>(num_threads, Common::TaskPriority::High);
+}
+
+int ConvertVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  if (!s_converter_pool || count < MIN_PARALLEL_VERTICES || !loader->IsThreadSafe())
+    return loader->RunVertices(src, dst, count);
+
+  // The loaders write the zfreeze position cache for the last three vertices of every call, so
+  // every chunk clobbers it. Convert the tail of the batch last, on this thread, to leave the
+  // cache as if the batch had been converted in one go.
+  constexpr int TAIL_VERTICES = 3;
+  const int parallel_count = count - TAIL_VERTICES;
+  const size_t num_chunks = (s_converter_pool->GetNumWorkers() + 1) * 2;
+  const int chunk_size = static_cast<int>((parallel_count + num_chunks - 1) / num_chunks);
+  const int src_stride = loader->m_VertexSize;
+  const int dst_stride = loader->m_native_vtx_decl.stride;
+
+  // Each chunk is converted to the place it would have in the output if no vertices were
+  // skipped, so the chunks don't need to know about each other.
+  std::vector<int> written(num_chunks, 0);
+  s_converter_pool->Run(num_chunks, [&](size_t chunk) {
+    const int first = static_cast<int>(chunk) * chunk_size;
+    const int chunk_count = std::min(chunk_size, parallel_count - first);
+    if (chunk_count <= 0)
+      return;
+
+    DataReader chunk_src(src.GetPointer() + first * src_stride, nullptr);
+    DataReader chunk_dst(dst.GetPointer() + first * dst_stride, nullptr);
+    written[chunk] = loader->RunVertices(chunk_src, chunk_dst, chunk_count);
+  });
+
+  // Close the gaps left by skipped vertices, which are rare.
+  int total = 0;
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    const int first = static_cast<int>(chunk) * chunk_size;
+    if (total != first && written[chunk] > 0)
+    {
+      std::memmove(dst.GetPointer() + total * dst_stride, dst.GetPointer() + first * dst_stride,
+                   written[chunk] * dst_stride);
+    }
+    total += written[chunk];
+  }
+
+  DataReader tail_src(src.GetPointer() + parallel_count * src_stride, nullptr);
+  DataReader tail_dst(dst.GetPointer() + total * dst_stride, nullptr);
+  return total + loader->RunVertices(tail_src, tail_dst, TAIL_VERTICES);
+}
+
+int GetVertexSize(int vtx_attr_group, CPState* state)
+{
+  return RefreshLoader(vtx_attr_group, state)->m_VertexSize;
+}
+
 NativeVertexFormat* GetCurrentVertexFormat()
 {
   return s_current_vtx_fmt;
@@ -300,8 +389,12 @@ NativeVertexFormat* GetCurrentVertexFormat()
 
 void LoadCPReg(u32 sub_cmd, u32 value, bool is_preprocess)
 {
-  bool update_global_state = !is_preprocess;
-  CPState* state = is_preprocess ? &g_preprocess_cp_state : &g_main_cp_state;
+  LoadCPReg(sub_cmd, value, is_preprocess ? &g_preprocess_cp_state : &g_main_cp_state);
+}
+
+void LoadCPReg(u32 sub_cmd, u32 value, CPState* state)
+{
+  bool update_global_state = state == &g_main_cp_state;
   switch (sub_cmd & 0xF0)
   {
   case 0x30:
@@ -12,6 +12,8 @@
 
 class DataReader;
 class NativeVertexFormat;
+class VertexLoaderBase;
+struct CPState;
 struct PortableVertexDeclaration;
 
 namespace VertexLoaderManager
@@ -37,6 +39,21 @@ NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 // Returns -1 if buf_size is insufficient, else the amount of bytes consumed
 int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess);
 
+// Batches with at least this many vertices are split up between the vertex loader threads.
+constexpr int MIN_PARALLEL_VERTICES = 4096;
+
+// Sets the number of threads which help converting large batches. 0 converts everything on
+// the calling thread.
+void SetVertexLoaderThreads(u32 num_threads);
+
+// Converts count vertices from src to dst like loader->RunVertices(), but splits large batches
+// up between the vertex loader threads. Returns the number of vertices written.
+int ConvertVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count);
+
+// Returns the size of a vertex of the given group in state, which is neither the main nor the
+// preprocessing CP state if called from another thread.
+int GetVertexSize(int vtx_attr_group, CPState* state);
+
 // For debugging
 std::string VertexLoadersToString();
 
@@ -4,8 +4,17 @@
 
 #pragma once
 
+#include <limits>
+#include <type_traits>
+
 #include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+
+#include "VideoCommon/DataReader.h"
 #include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoaderUtils.h"
+#include "VideoCommon/VideoCommon.h"
 
 class VertexLoader_Position
 {
@@ -16,3 +25,64 @@ public:
   // GetFunction
   static TPipelineFunction GetFunction(u64 _type, unsigned int _format, unsigned int _elements);
 };
+
+// The loaders are defined here so that VertexLoader can inline them into its specialized
+// pipelines.
+template <typename T>
+float PosScale(T val, float scale)
+{
+  return val * scale;
+}
+
+template <>
+inline float PosScale(float val, float scale)
+{
+  return val;
+}
+
+template <typename T, int N>
+void Pos_ReadDirect(VertexLoader* loader)
+{
+  static_assert(N <= 3, "N > 3 is not sane!");
+  auto const scale = loader->m_posScale;
+  DataReader dst(g_vertex_manager_write_ptr, nullptr);
+  DataReader src(g_video_buffer_read_ptr, nullptr);
+
+  for (int i = 0; i < N; ++i)
+  {
+    float value = PosScale(src.Read<T>(), scale);
+    if (loader->m_counter < 3)
+      VertexLoaderManager::position_cache[loader->m_counter][i] = value;
+    dst.Write(value);
+  }
+
+  g_vertex_manager_write_ptr = dst.GetPointer();
+  g_video_buffer_read_ptr = src.GetPointer();
+  LOG_VTX();
+}
+
+template <typename I, typename T, int N>
+void Pos_ReadIndex(VertexLoader* loader)
+{
+  static_assert(std::is_unsigned<I>::value, "Only unsigned I is sane!");
+  static_assert(N <= 3, "N > 3 is not sane!");
+
+  auto const index = DataRead<I>();
+  loader->m_vertexSkip = index == std::numeric_limits<I>::max();
+  auto const data =
+      reinterpret_cast<const T*>(VertexLoaderManager::cached_arraybases[ARRAY_POSITION] +
+                                 (index * g_main_cp_state.array_strides[ARRAY_POSITION]));
+  auto const scale = loader->m_posScale;
+  DataReader dst(g_vertex_manager_write_ptr, nullptr);
+
+  for (int i = 0; i < N; ++i)
+  {
+    float value = PosScale(Common::FromBigEndian(data[i]), scale);
+    if (loader->m_counter < 3)
+      VertexLoaderManager::position_cache[loader->m_counter][i] = value;
+    dst.Write(value);
+  }
+
+  g_vertex_manager_write_ptr = dst.GetPointer();
+  LOG_VTX();
+}
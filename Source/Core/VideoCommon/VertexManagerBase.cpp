@@ -14,6 +14,7 @@
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/GeometryShaderManager.h"
@@ -23,6 +24,7 @@
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
@@ -184,6 +186,15 @@ std::pair<size_t, size_t> VertexManagerBase::ResetFlushAspectRatioCount()
   return val;
 }
 
+bool VertexManagerBase::UseInstancedStereo() const
+{
+  // Lines, points and wireframes still go through the geometry shader, see
+  // geometry_shader_uid_data::IsPassthrough().
+  return g_ActiveConfig.iStereoMode > 0 &&
+         g_ActiveConfig.backend_info.bSupportsVertexShaderLayer &&
+         m_current_primitive_type == PRIMITIVE_TRIANGLES && !g_ActiveConfig.bWireFrame;
+}
+
 void VertexManagerBase::Flush()
 {
   if (m_is_flushed)
@@ -233,8 +244,9 @@ void VertexManagerBase::Flush()
 #endif
 
   // If the primitave is marked CullAll. All we need to do is update the vertex constants and
-  // calculate the zfreeze refrence slope
-  if (!m_cull_all)
+  // calculate the zfreeze refrence slope. The same goes for the draws of skipped frames.
+  const bool draw = !m_cull_all && !g_renderer->IsSkippingFrame();
+  if (draw)
   {
     BitSet32 usedtextures;
     for (u32 i = 0; i < bpmem.genMode.numtevstages + 1u; ++i)
@@ -296,15 +308,26 @@ void VertexManagerBase::Flush()
     m_zslope.dirty = false;
   }
 
-  if (!m_cull_all)
+  if (draw)
   {
     // set the rest of the global constants
     GeometryShaderManager::SetConstants();
     PixelShaderManager::SetConstants();
+    if (g_ActiveConfig.iStereoMode > 0 && g_ActiveConfig.backend_info.bSupportsVertexShaderLayer)
+    {
+      VertexShaderManager::SetStereoParams(GeometryShaderManager::constants.stereoparams,
+                                           UseInstancedStereo());
+    }
 
     if (PerfQueryBase::ShouldEmulate())
       g_perf_query->EnableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
-    g_vertex_manager->vFlush();
+    {
+      StageTimings::ScopedTimer timer(StageTimings::Stage::BackendSubmit);
+      g_vertex_manager->vFlush();
+    }
+    g_texture_cache->OnEFBModified();
+    if (BoundingBox::active)
+      BoundingBox::SetDirty();
     if (PerfQueryBase::ShouldEmulate())
       g_perf_query->DisableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
   }
@@ -63,6 +63,10 @@ public:
 
   std::pair<size_t, size_t> ResetFlushAspectRatioCount();
 
+  // Whether the current draw renders both stereo eyes as instances, which the vertex shader sends
+  // to separate layers, rather than duplicating the primitives in the geometry shader.
+  bool UseInstancedStereo() const;
+
 protected:
   virtual void vDoState(PointerWrap& p) {}
   PrimitiveType m_current_primitive_type = PrimitiveType::PRIMITIVE_POINTS;
@@ -9,13 +9,15 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/LightingShaderGen.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/StageTimings.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
-VertexShaderUid GetVertexShaderUid()
+static VertexShaderUid BuildVertexShaderUid()
 {
   VertexShaderUid out;
   vertex_shader_uid_data* uid_data = out.GetUidData<vertex_shader_uid_data>();
@@ -76,6 +78,33 @@ VertexShaderUid GetVertexShaderUid()
   return out;
 }
 
+static VertexShaderUid s_cached_uid;
+static u32 s_cached_components;
+static bool s_cached_uid_valid = false;
+
+VertexShaderUid GetVertexShaderUid()
+{
+  StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderUidGeneration);
+
+  // The vertex format changes too often to be worth tracking, so it is compared instead.
+  if (s_cached_uid_valid && s_cached_components == VertexLoaderManager::g_current_components)
+  {
+    INCSTAT(stats.thisFrame.numShaderUidsReused);
+    return s_cached_uid;
+  }
+
+  INCSTAT(stats.thisFrame.numShaderUidsBuilt);
+  s_cached_uid = BuildVertexShaderUid();
+  s_cached_components = VertexLoaderManager::g_current_components;
+  s_cached_uid_valid = true;
+  return s_cached_uid;
+}
+
+void InvalidateVertexShaderUid()
+{
+  s_cached_uid_valid = false;
+}
+
 ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& host_config,
                                     const vertex_shader_uid_data* uid_data)
 {
@@ -85,6 +114,8 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
   const bool msaa = host_config.msaa;
   const bool ssaa = host_config.ssaa;
   const bool vertex_rounding = host_config.vertex_rounding;
+  // Stereo can be done without a geometry shader if the vertex shader can select the layer.
+  const bool stereo = host_config.stereo && host_config.backend_vs_layer;
 
   out.Write("%s", s_lighting_struct);
 
@@ -134,6 +165,8 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
       out.Write("VARYING_LOCATION(0) out VertexData {\n");
       GenerateVSOutputMembers(out, api_type, uid_data->numTexGens, per_pixel_lighting,
                               GetInterpolationQualifier(msaa, ssaa, true, false));
+      if (stereo)
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
     }
     else
@@ -486,9 +519,26 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
 
   if (api_type == APIType::OpenGL || api_type == APIType::Vulkan)
   {
+    if (stereo)
+    {
+      // Triangles render the eyes as two instances, with the same offset the geometry shader
+      // applies otherwise. Other primitives are duplicated by the geometry shader, which ignores
+      // the layer.
+      out.Write("int eye = %s;\n",
+                api_type == APIType::Vulkan ? "gl_InstanceIndex" : "gl_InstanceID");
+      out.Write("if (" I_VSSTEREOPARAMS ".w != 0.0)\n");
+      out.Write("{\n");
+      out.Write("\tfloat hoffset = (eye == 0) ? " I_VSSTEREOPARAMS ".x : " I_VSSTEREOPARAMS
+                ".y;\n");
+      out.Write("\to.pos.x += hoffset * (o.pos.w - " I_VSSTEREOPARAMS ".z);\n");
+      out.Write("}\n");
+    }
+
     if (host_config.backend_geometry_shaders || api_type == APIType::Vulkan)
     {
       AssignVSOutputMembers(out, "vs", "o", uid_data->numTexGens, per_pixel_lighting);
+      if (stereo)
+        out.Write("vs.layer = eye;\n");
     }
     else
     {
@@ -512,6 +562,9 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
       out.Write("gl_ClipDistance[1] = o.clipDist1;\n");
     }
 
+    if (stereo)
+      out.Write("gl_Layer = eye;\n");
+
     // Vulkan NDC space has Y pointing down (right-handed NDC space).
     if (api_type == APIType::Vulkan)
       out.Write("gl_Position = float4(o.pos.x, -o.pos.y, o.pos.z, o.pos.w);\n");
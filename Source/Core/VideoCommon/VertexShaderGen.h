@@ -65,5 +65,9 @@ struct vertex_shader_uid_data
 typedef ShaderUid<vertex_shader_uid_data> VertexShaderUid;
 
 VertexShaderUid GetVertexShaderUid();
+
+// Marks the vertex shader UID as outdated, so that the next GetVertexShaderUid() call rebuilds it.
+// Called when an XF register which the UID is built from changes.
+void InvalidateVertexShaderUid();
 ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& host_config,
                                     const vertex_shader_uid_data* uid_data);
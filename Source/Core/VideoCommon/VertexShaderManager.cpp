@@ -18,9 +18,11 @@
 #include "Core/Core.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
+#include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
+#include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -198,6 +200,8 @@ void VertexShaderManager::Init()
   bLightingConfigChanged = false;
 
   std::memset(&xfmem, 0, sizeof(xfmem));
+  InvalidateVertexShaderUid();
+  InvalidatePixelShaderUid();
   constants = {};
   ResetView();
 
@@ -807,6 +811,22 @@ void VertexShaderManager::SetLightingConfigChanged()
   bLightingConfigChanged = true;
 }
 
+void VertexShaderManager::SetStereoParams(const float4& params, bool instanced)
+{
+  const float instanced_flag = instanced ? 1.0f : 0.0f;
+  if (constants.stereoparams[0] == params[0] && constants.stereoparams[1] == params[1] &&
+      constants.stereoparams[2] == params[2] && constants.stereoparams[3] == instanced_flag)
+  {
+    return;
+  }
+
+  constants.stereoparams[0] = params[0];
+  constants.stereoparams[1] = params[1];
+  constants.stereoparams[2] = params[2];
+  constants.stereoparams[3] = instanced_flag;
+  dirty = true;
+}
+
 void VertexShaderManager::TransformToClipSpace(const float* data, float* out, u32 MtxIdx)
 {
   const float* world_matrix = &xfmem.posMatrices[(MtxIdx & 0x3f) * 4];
@@ -39,6 +39,9 @@ public:
   static void SetVertexFormat(u32 components);
   static void SetTexMatrixInfoChanged(int index);
   static void SetLightingConfigChanged();
+  // Sets the stereo offsets for when the vertex shader renders the eyes as two instances, and
+  // whether the next draw does so rather than leaving it to the geometry shader.
+  static void SetStereoParams(const float4& params, bool instanced);
 
   // data: 3 floats representing the X, Y and Z vertex model coordinates and the posmatrix index.
   // out:  4 floats which will be initialized with the corresponding clip space coordinates
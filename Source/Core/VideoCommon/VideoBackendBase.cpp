@@ -18,6 +18,7 @@
 #include "VideoBackends/Vulkan/VideoBackend.h"
 #endif
 
+#include "Core/ConfigManager.h"
 #include "VideoCommon/VideoBackendBase.h"
 
 std::vector<std::unique_ptr<VideoBackendBase>> g_available_video_backends;
@@ -66,16 +67,26 @@ void VideoBackendBase::ClearList()
 
 void VideoBackendBase::ActivateBackend(const std::string& name)
 {
+  VideoBackendBase* selected = g_video_backend;
+
   // If empty, set it to the default backend (expected behavior)
   if (name.empty())
-    g_video_backend = s_default_backend;
+    selected = s_default_backend;
 
   const auto iter =
       std::find_if(g_available_video_backends.begin(), g_available_video_backends.end(),
                    [&name](const auto& backend) { return name == backend->GetName(); });
 
-  if (iter == g_available_video_backends.end())
-    return;
+  if (iter != g_available_video_backends.end())
+    selected = iter->get();
 
-  g_video_backend = iter->get();
+  // A device kept by the previous backend won't be used again.
+  if (g_video_backend && g_video_backend != selected)
+    g_video_backend->ReleasePersistentState();
+  g_video_backend = selected;
+}
+
+bool VideoBackendBase::IsPersistentSession()
+{
+  return SConfig::GetInstance().bPersistentSession;
 }
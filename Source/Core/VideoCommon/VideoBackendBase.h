@@ -40,6 +40,11 @@ public:
   virtual bool Initialize(void* window_handle) = 0;
   virtual void Shutdown() = 0;
 
+  // With SConfig::bPersistentSession, Shutdown() may keep the host device alive, along with
+  // anything else that doesn't depend on the game, for the next Initialize() on the same window.
+  // This releases it for good.
+  virtual void ReleasePersistentState() {}
+
   virtual std::string GetName() const = 0;
   virtual std::string GetDisplayName() const { return GetName(); }
   void ShowConfig(void*);
@@ -66,6 +71,8 @@ public:
   void CheckInvalidState();
 
 protected:
+  static bool IsPersistentSession();
+
   void InitializeShared();
   void ShutdownShared();
   void CleanupShared();
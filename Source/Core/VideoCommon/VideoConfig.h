@@ -62,6 +62,9 @@ struct VideoConfig final
 
   // General
   bool bVSync;
+  // With vsync, drops frames which can't be shown yet instead of waiting for the swap chain, so
+  // that presentation never holds up the GPU thread.
+  bool bNonBlockingPresent;
   bool bWidescreenHack;
   int iAspectRatio;
   bool bCrop;  // Aspect ratio controls.
@@ -73,6 +76,8 @@ struct VideoConfig final
   u32 iMultisamples;
   bool bSSAA;
   int iEFBScale;
+  // Lowers the EFB scale while frames take longer than this many milliseconds, 0 to disable.
+  float fDynamicResolutionFrameTime;
   bool bForceFiltering;
   int iMaxAnisotropy;
   std::string sPostProcessingShader;
@@ -82,11 +87,14 @@ struct VideoConfig final
   bool bShowFPS;
   bool bShowNetPlayPing;
   bool bShowNetPlayMessages;
+  bool bShowAudioStats;
   bool bOverlayStats;
+  bool bOverlayStageTimings;
   bool bOverlayProjStats;
   bool bTexFmtOverlayEnable;
   bool bTexFmtOverlayCenter;
   bool bLogRenderTimeToFile;
+  std::string sFrameStatsLogPath;  // CSV file for per-frame timings, empty to disable
 
   // Render
   bool bWireFrame;
@@ -97,6 +105,8 @@ struct VideoConfig final
   bool bHiresTextures;
   bool bConvertHiresTextures;
   bool bCacheHiresTextures;
+  bool bAsyncHiresTextures;
+  int iPNGCompressionLevel;
   bool bDumpEFBTarget;
   bool bDumpFramesAsImages;
   bool bUseFFV1;
@@ -111,14 +121,21 @@ struct VideoConfig final
 
   // Hacks
   bool bEFBAccessEnable;
+  // Keeps EFB peeks cached across draws until the end of the frame, or until the EFB is cleared.
+  bool bEFBAccessDeferInvalidation;
   bool bPerfQueriesEnable;
+  // Returns the perf counters of the previous period instead of waiting for the GPU.
+  bool bPerfQueriesDelayed;
   bool bBBoxEnable;
   bool bBBoxPreferStencilImplementation;  // OpenGL-only, to see how slow it is compared to SSBOs
+  // Returns the bounding box read back for the previous request instead of waiting for the GPU.
+  bool bBBoxDeferReadback;
   bool bForceProgressive;
 
   bool bEFBEmulateFormatChanges;
   bool bSkipEFBCopyToRam;
   bool bCopyEFBScaled;
+  bool bDeferEFBCopies;
   int iSafeTextureCache_ColorSamples;
   ProjectionHackConfig phack;
   float fAspectRatioHackW, fAspectRatioHackH;
@@ -148,6 +165,8 @@ struct VideoConfig final
   bool bDumpObjects;
   bool bDumpTevStages;
   bool bDumpTevTextureFetches;
+  // Number of additional threads drawing the tiles of the EFB. 0 disables it.
+  int iSWRasterizerThreads;
 
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer;
@@ -159,6 +178,11 @@ struct VideoConfig final
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval;
 
+  // Number of additional threads recording the draws of a render pass into secondary command
+  // buffers, or into command lists on deferred contexts with D3D. 0 records them on the GPU
+  // thread. Currently only supported with Vulkan and D3D.
+  int iCommandRecordingThreads;
+
   // The following options determine the ubershader mode:
   //   No ubershaders:
   //     - bBackgroundShaderCompiling = false
@@ -185,6 +209,12 @@ struct VideoConfig final
   int iShaderCompilerThreads;
   int iShaderPrecompilerThreads;
 
+  // Number of additional threads converting very large vertex batches. 0 disables it.
+  int iVertexLoaderThreads;
+
+  // Reuse the converted vertices of batches whose source data is unchanged.
+  bool bVertexLoaderCache;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -210,6 +240,7 @@ struct VideoConfig final
     bool bSupportsBindingLayout;  // Needed by ShaderGen, so must stay in VideoCommon
     bool bSupportsBBox;
     bool bSupportsGSInstancing;  // Needed by GeometryShaderGen, so must stay in VideoCommon
+    bool bSupportsVertexShaderLayer;  // Needed by VertexShaderGen, so must stay in VideoCommon
     bool bSupportsPostProcessing;
     bool bSupportsPaletteConversion;
     bool bSupportsClipControl;  // Needed by VertexShaderGen, so must stay in VideoCommon
@@ -224,6 +255,7 @@ struct VideoConfig final
     bool bSupportsBitfield;                // Needed by UberShaders, so must stay in VideoCommon
     bool bSupportsDynamicSamplerIndexing;  // Needed by UberShaders, so must stay in VideoCommon
     bool bSupportsBPTCTextures;
+    bool bSupportsGPUTimers;  // Whether the GPU time of frames is reported to the stats log
   } backend_info;
 
   // Utility
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
@@ -12,11 +14,43 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/GeometryShaderManager.h"
+#include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
+#include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/XFMemory.h"
 
+// Returns whether the size words starting at address would be written with different values.
+// Games often load the same matrices and registers again, which don't need a flush.
+static bool XFDataChanged(u32 size, u32 address, DataReader src, u32 dataIndex = 0)
+{
+  for (u32 i = 0; i < size; i++)
+  {
+    if (((u32*)&xfmem)[address + i] != src.Peek<u32>((dataIndex + i) * sizeof(u32)))
+      return true;
+  }
+
+  INCSTAT(stats.thisFrame.numSkippedFlushes);
+  return false;
+}
+
+// Same as above for the registers from address up to end, which are handled as one block.
+static bool XFRegBlockChanged(u32 address, u32 end, int transferSize, DataReader src,
+                              u32 dataIndex)
+{
+  const u32 size = std::min(end - address, static_cast<u32>(transferSize));
+  return XFDataChanged(size, address, src, dataIndex);
+}
+
+// Both shader UIDs are built from the lighting and texture coordinate generation registers.
+static void InvalidateShaderUids()
+{
+  InvalidateVertexShaderUid();
+  InvalidatePixelShaderUid();
+}
+
 static void XFMemWritten(u32 transferSize, u32 baseAddress)
 {
   g_vertex_manager->Flush();
@@ -55,7 +89,10 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
 
     case XFMEM_SETNUMCHAN:
       if (xfmem.numChan.numColorChans != (newValue & 3))
+      {
         g_vertex_manager->Flush();
+        InvalidateShaderUids();
+      }
       VertexShaderManager::SetLightingConfigChanged();
       break;
 
@@ -88,13 +125,19 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETCHAN0_ALPHA:  // Channel Alpha
     case XFMEM_SETCHAN1_ALPHA:
       if (((u32*)&xfmem)[address] != (newValue & 0x7fff))
+      {
         g_vertex_manager->Flush();
+        InvalidateShaderUids();
+      }
       VertexShaderManager::SetLightingConfigChanged();
       break;
 
     case XFMEM_DUALTEX:
       if (xfmem.dualTexTrans.enabled != (newValue & 1))
+      {
         g_vertex_manager->Flush();
+        InvalidateVertexShaderUid();
+      }
       VertexShaderManager::SetTexMatrixInfoChanged(-1);
       break;
 
@@ -113,10 +156,13 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetViewportChanged();
-      PixelShaderManager::SetViewportChanged();
-      GeometryShaderManager::SetViewportChanged();
+      if (XFRegBlockChanged(address, XFMEM_SETVIEWPORT + 6, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetViewportChanged();
+        PixelShaderManager::SetViewportChanged();
+        GeometryShaderManager::SetViewportChanged();
+      }
 
       nextAddress = XFMEM_SETVIEWPORT + 6;
       break;
@@ -128,16 +174,22 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetProjectionChanged();
-      GeometryShaderManager::SetProjectionChanged();
+      if (XFRegBlockChanged(address, XFMEM_SETPROJECTION + 7, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetProjectionChanged();
+        GeometryShaderManager::SetProjectionChanged();
+      }
 
       nextAddress = XFMEM_SETPROJECTION + 7;
       break;
 
     case XFMEM_SETNUMTEXGENS:  // GXSetNumTexGens
       if (xfmem.numTexGen.numTexGens != (newValue & 15))
+      {
         g_vertex_manager->Flush();
+        InvalidateVertexShaderUid();
+      }
       break;
 
     case XFMEM_SETTEXMTXINFO:
@@ -148,8 +200,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      if (XFRegBlockChanged(address, XFMEM_SETTEXMTXINFO + 8, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+        InvalidateShaderUids();
+      }
 
       nextAddress = XFMEM_SETTEXMTXINFO + 8;
       break;
@@ -162,8 +218,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPOSMTXINFO + 5:
     case XFMEM_SETPOSMTXINFO + 6:
     case XFMEM_SETPOSMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSMTXINFO);
+      if (XFRegBlockChanged(address, XFMEM_SETPOSMTXINFO + 8, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSMTXINFO);
+        InvalidateVertexShaderUid();
+      }
 
       nextAddress = XFMEM_SETPOSMTXINFO + 8;
       break;
@@ -237,7 +297,8 @@ void LoadXFReg(u32 transferSize, u32 baseAddress, DataReader src)
       transferSize = 0;
     }
 
-    XFMemWritten(xfMemTransferSize, xfMemBase);
+    if (XFDataChanged(xfMemTransferSize, xfMemBase, src))
+      XFMemWritten(xfMemTransferSize, xfMemBase);
     for (u32 i = 0; i < xfMemTransferSize; i++)
     {
       ((u32*)&xfmem)[xfMemBase + i] = src.Read<u32>();
@@ -289,6 +350,10 @@ void LoadIndexedXF(u32 val, int refarray)
     for (int i = 0; i < size; ++i)
       currData[i] = Common::swap32(newData[i]);
   }
+  else
+  {
+    INCSTAT(stats.thisFrame.numSkippedFlushes);
+  }
 }
 
 void PreprocessIndexedXF(u32 val, int refarray)
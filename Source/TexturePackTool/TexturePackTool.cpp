@@ -0,0 +1,53 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+#include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/VideoConfig.h"
+
+int main(int argc, const char* argv[])
+{
+  if (argc != 3 || !strcmp(argv[1], "--help") || !strcmp(argv[1], "-?"))
+  {
+    printf("USAGE: TexturePackTool <TEXTURE DIRECTORY> <PACK FILE>\n");
+    printf("Packs the custom textures of a game into a single file. To use it, name it after the\n"
+           "game ID, like the texture directory, and give it the extension .texpack, for example\n"
+           "Load/Textures/GALE01.texpack\n");
+    return argc == 1 ? 0 : 1;
+  }
+
+  const std::string texture_directory = argv[1];
+  const std::string pack_filename = argv[2];
+  if (!File::IsDirectory(texture_directory))
+  {
+    fprintf(stderr, "%s is not a directory\n", texture_directory.c_str());
+    return 1;
+  }
+
+  // Compressed DDS textures are only loaded if the GPU supports them. Keep all of them in the
+  // pack, they are checked again when it is used.
+  g_ActiveConfig.backend_info.bSupportsST3CTextures = true;
+  g_ActiveConfig.backend_info.bSupportsBPTCTextures = true;
+
+  if (!HiresTexture::CreateTexturePack(texture_directory, pack_filename))
+  {
+    fprintf(stderr, "Failed to write %s\n", pack_filename.c_str());
+    return 1;
+  }
+
+  HiresTexturePack pack;
+  if (!pack.Open(pack_filename))
+  {
+    fprintf(stderr, "Failed to read back %s\n", pack_filename.c_str());
+    return 1;
+  }
+
+  printf("Packed %zu textures into %s\n", pack.GetTextureCount(), pack_filename.c_str());
+  return 0;
+}
@@ -0,0 +1,130 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/Common.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "UICommon/UICommon.h"
+
+namespace Benchmark
+{
+// Each measurement runs for at least this long, and the fastest of them is reported, which is
+// the one least disturbed by the rest of the system.
+static constexpr double MIN_SECONDS = 0.25;
+static constexpr int REPETITIONS = 5;
+
+static std::vector<Case>& GetCases()
+{
+  static std::vector<Case> cases;
+  return cases;
+}
+
+void Register(Case benchmark_case)
+{
+  GetCases().push_back(std::move(benchmark_case));
+}
+
+void DoNotOptimize(const void* pointer)
+{
+  static const void* volatile s_sink;
+  s_sink = pointer;
+}
+
+static double Measure(const Case& benchmark_case, u64 iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  benchmark_case.run(iterations);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+static std::string EscapeJSON(const std::string& text)
+{
+  std::string escaped;
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+static void RunCase(const Case& benchmark_case)
+{
+  // Find an iteration count which takes long enough to be measured accurately. This also warms up
+  // the caches, and the JIT for the CPU benchmarks.
+  u64 iterations = 1;
+  double seconds = Measure(benchmark_case, iterations);
+  while (seconds < MIN_SECONDS)
+  {
+    const double factor = seconds > 0 ? std::min(MIN_SECONDS * 1.2 / seconds, 100.0) : 100.0;
+    iterations = std::max<u64>(iterations + 1, static_cast<u64>(iterations * factor));
+    seconds = Measure(benchmark_case, iterations);
+  }
+
+  double best = seconds;
+  for (int i = 1; i < REPETITIONS; ++i)
+    best = std::min(best, Measure(benchmark_case, iterations));
+
+  const double ns_per_iteration = best * 1e9 / iterations;
+  const double throughput = benchmark_case.units_per_iteration * iterations / best;
+  printf("{\"revision\": \"%s\", \"name\": \"%s\", \"iterations\": %llu, "
+         "\"ns_per_iteration\": %.3f, \"unit\": \"%s\", \"per_second\": %.1f}\n",
+         EscapeJSON(scm_rev_git_str).c_str(), EscapeJSON(benchmark_case.name).c_str(),
+         static_cast<unsigned long long>(iterations), ns_per_iteration,
+         EscapeJSON(benchmark_case.unit).c_str(), throughput);
+  fflush(stdout);
+}
+}
+
+// Runs every benchmark whose name contains one of the arguments, or all of them if there are
+// none. --list prints the names instead.
+int main(int argc, char** argv)
+{
+  std::vector<std::string> filters(argv + 1, argv + argc);
+  const bool list = std::find(filters.begin(), filters.end(), "--list") != filters.end();
+  filters.erase(std::remove(filters.begin(), filters.end(), "--list"), filters.end());
+
+  std::vector<Benchmark::Case> cases = Benchmark::GetCases();
+  std::sort(cases.begin(), cases.end(),
+            [](const Benchmark::Case& a, const Benchmark::Case& b) { return a.name < b.name; });
+
+  // The defaults are used for all settings, not whatever the user has configured.
+  const std::string profile_path = File::CreateTempDir();
+  UICommon::SetUserDirectory(profile_path);
+  Config::Init();
+  SConfig::Init();
+
+  for (const Benchmark::Case& benchmark_case : cases)
+  {
+    const bool selected =
+        filters.empty() || std::any_of(filters.begin(), filters.end(), [&](const std::string& f) {
+          return benchmark_case.name.find(f) != std::string::npos;
+        });
+    if (!selected)
+      continue;
+
+    if (list)
+      printf("%s\n", benchmark_case.name.c_str());
+    else
+      Benchmark::RunCase(benchmark_case);
+  }
+
+  SConfig::Shutdown();
+  Config::Shutdown();
+  File::DeleteDirRecursively(profile_path);
+  return 0;
+}
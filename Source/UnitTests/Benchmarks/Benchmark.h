@@ -0,0 +1,38 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// A minimal harness for microbenchmarks, whose results are printed as one JSON object per line so
+// that they can be collected and compared across commits.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+
+namespace Benchmark
+{
+struct Case
+{
+  std::string name;
+  // What one iteration processes, for the throughput, e.g. "bytes" or "vertices".
+  std::string unit;
+  double units_per_iteration;
+  // Runs the given number of iterations. Anything that shouldn't be measured has to be done
+  // outside of it, or at least be cheap compared to the iterations.
+  std::function<void(u64 iterations)> run;
+};
+
+void Register(Case benchmark_case);
+
+// Keeps the compiler from optimizing away a result which is otherwise unused.
+void DoNotOptimize(const void* pointer);
+
+struct Registration
+{
+  explicit Registration(Case benchmark_case) { Register(std::move(benchmark_case)); }
+};
+}
@@ -0,0 +1,123 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/EXI/EXI.h"
+#include "Core/HW/EXI/EXI_Device.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#include "Benchmark.h"
+
+namespace
+{
+constexpr u64 CYCLES_PER_ITERATION = 1000000;
+
+constexpr u32 CODE_ADDRESS = 0x00003100;
+constexpr u32 DATA_ADDRESS = 0x00010000;
+
+constexpr u32 DForm(u32 opcode, u32 d, u32 a, s32 imm)
+{
+  return opcode << 26 | d << 21 | a << 16 | (static_cast<u32>(imm) & 0xFFFF);
+}
+
+constexpr u32 XForm(u32 opcode, u32 d, u32 a, u32 b, u32 subop)
+{
+  return opcode << 26 | d << 21 | a << 16 | b << 11 | subop << 1;
+}
+
+// A loop like the inner loops of games, with integer and floating point arithmetic, loads and
+// stores to the same data and a counted branch. The program runs in real mode, so that the
+// addresses are physical.
+constexpr std::array<u32, 15> PROGRAM{{
+    DForm(15, 4, 0, DATA_ADDRESS >> 16),  // lis r4, DATA_ADDRESS@h
+    DForm(14, 5, 0, 64),                  // li r5, 64
+    XForm(31, 5, 9, 0, 467),              // mtctr r5
+    DForm(48, 1, 4, 0),                   // lfs f1, 0(r4)
+    DForm(48, 2, 4, 4),                   // lfs f2, 4(r4)
+    DForm(32, 6, 4, 8),                   // loop: lwz r6, 8(r4)
+    DForm(14, 6, 6, 1),                   // addi r6, r6, 1
+    DForm(36, 6, 4, 8),                   // stw r6, 8(r4)
+    XForm(31, 7, 7, 6, 266),              // add r7, r7, r6
+    XForm(21, 7, 8, 3, 28) | 0 << 6,      // rlwinm r8, r7, 3, 0, 28
+    XForm(31, 8, 9, 9, 316),              // xor r9, r8, r9
+    XForm(63, 3, 1, 3, 29) | 2 << 6,      // fmadd f3, f1, f2, f3
+    DForm(52, 3, 4, 12),                  // stfs f3, 12(r4)
+    DForm(16, 16, 0, -8 * 4),             // bdnz loop
+    18u << 26 | (-14 * 4 & 0x03FFFFFC),   // b start
+}};
+
+void Stop(u64 userdata, s64 cycles_late)
+{
+  CPU::Break();
+}
+
+// Runs the program with the given CPU core for the given number of emulated cycles. Setting up
+// the core is part of the measurement, but takes a few milliseconds at most.
+void Run(PowerPC::CPUCore core, u64 iterations)
+{
+  // Only Memory needs the expansion interface, for the MMIOs of its devices.
+  SConfig& config = SConfig::GetInstance();
+  std::array<ExpansionInterface::TEXIDevices, 3> exi_devices;
+  for (size_t i = 0; i < exi_devices.size(); ++i)
+  {
+    exi_devices[i] = config.m_EXIDevice[i];
+    config.m_EXIDevice[i] = ExpansionInterface::EXIDEVICE_NONE;
+  }
+
+  Core::DeclareAsCPUThread();
+  CoreTiming::Init();
+  ExpansionInterface::Init();
+  Memory::Init();
+  CPU::Init(core);
+
+  for (size_t i = 0; i < PROGRAM.size(); ++i)
+    Memory::Write_U32(PROGRAM[i], CODE_ADDRESS + static_cast<u32>(i * 4));
+  PowerPC::ppcState.pc = CODE_ADDRESS;
+  PowerPC::ppcState.npc = CODE_ADDRESS;
+  // Floating point available, address translation off.
+  PowerPC::ppcState.msr = 0x2000;
+
+  CoreTiming::EventType* stop = CoreTiming::RegisterEvent("BenchmarkStop", Stop);
+  CoreTiming::ScheduleEvent(static_cast<s64>(iterations * CYCLES_PER_ITERATION), stop);
+  CPU::EnableStepping(false);
+  PowerPC::RunLoop();
+
+  CPU::Shutdown();
+  Memory::Shutdown();
+  ExpansionInterface::Shutdown();
+  CoreTiming::Shutdown();
+  Core::UndeclareAsCPUThread();
+
+  for (size_t i = 0; i < exi_devices.size(); ++i)
+    config.m_EXIDevice[i] = exi_devices[i];
+}
+
+void RegisterCore(const std::string& name, PowerPC::CPUCore core)
+{
+  Benchmark::Register({"CPU/" + name, "cycles", CYCLES_PER_ITERATION,
+                       [core](u64 iterations) { Run(core, iterations); }});
+}
+
+bool RegisterCores()
+{
+  RegisterCore("Interpreter", PowerPC::CORE_INTERPRETER);
+  RegisterCore("CachedInterpreter", PowerPC::CORE_CACHEDINTERPRETER);
+#if _M_X86_64
+  RegisterCore("Jit64", PowerPC::CORE_JIT64);
+#elif _M_ARM_64
+  RegisterCore("JitArm64", PowerPC::CORE_JITARM64);
+#endif
+  return true;
+}
+
+const bool s_registered = RegisterCores();
+}  // Anonymous namespace
@@ -0,0 +1,49 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/CommonTypes.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#include "Benchmark.h"
+
+namespace
+{
+constexpr u64 EVENTS_PER_ITERATION = 16;
+
+void Callback(u64 userdata, s64 cycles_late)
+{
+}
+
+// Schedules a batch of events, like the hardware does after an MMIO write, and advances through
+// them one slice at a time, like the CPU does.
+void ScheduleAndAdvance(u64 iterations)
+{
+  Core::DeclareAsCPUThread();
+  PowerPC::Init(PowerPC::CORE_INTERPRETER);
+  CoreTiming::Init();
+  CoreTiming::EventType* event = CoreTiming::RegisterEvent("Benchmark", Callback);
+
+  for (u64 i = 0; i < iterations; ++i)
+  {
+    for (u64 j = 0; j < EVENTS_PER_ITERATION; ++j)
+      CoreTiming::ScheduleEvent(100 + static_cast<s64>(j * 61 % 1000), event, j);
+
+    for (u64 j = 0; j < EVENTS_PER_ITERATION; ++j)
+    {
+      // Pretend the whole slice was executed.
+      PowerPC::ppcState.downcount = 0;
+      CoreTiming::Advance();
+    }
+  }
+
+  CoreTiming::Shutdown();
+  PowerPC::Shutdown();
+  Core::UndeclareAsCPUThread();
+}
+
+const Benchmark::Registration s_schedule_and_advance{
+    {"CoreTiming/ScheduleAndAdvance", "events", EVENTS_PER_ITERATION, ScheduleAndAdvance}};
+}  // Anonymous namespace
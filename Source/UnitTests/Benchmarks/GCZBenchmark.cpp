@@ -0,0 +1,69 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "DiscIO/Blob.h"
+
+#include "Benchmark.h"
+
+namespace
+{
+constexpr u64 IMAGE_SIZE = 16 * 1024 * 1024;
+// The size of the reads of the DVD thread.
+constexpr u64 READ_SIZE = 32 * 1024;
+
+// A GCZ file of made-up data which compresses about as well as a typical disc, with half of every
+// block random and half zeroes.
+class GCZImage
+{
+public:
+  GCZImage() : m_directory(File::CreateTempDir())
+  {
+    const std::string iso_path = m_directory + "/image.iso";
+    const std::string gcz_path = m_directory + "/image.gcz";
+
+    std::mt19937 rng(1234);
+    std::vector<u8> data(IMAGE_SIZE);
+    for (u64 i = 0; i < IMAGE_SIZE; ++i)
+      data[i] = (i / 1024) % 2 ? static_cast<u8>(rng()) : 0;
+
+    File::IOFile(iso_path, "wb").WriteBytes(data.data(), data.size());
+    DiscIO::CompressFileToBlob(iso_path, gcz_path);
+    m_reader = DiscIO::CreateBlobReader(gcz_path);
+  }
+
+  ~GCZImage()
+  {
+    m_reader.reset();
+    File::DeleteDirRecursively(m_directory);
+  }
+
+  // Reads the whole image, which is larger than the cache of the reader.
+  void ReadAll()
+  {
+    for (u64 offset = 0; offset < IMAGE_SIZE; offset += READ_SIZE)
+      m_reader->Read(offset, READ_SIZE, m_buffer.data());
+    Benchmark::DoNotOptimize(m_buffer.data());
+  }
+
+private:
+  std::string m_directory;
+  std::unique_ptr<DiscIO::BlobReader> m_reader;
+  std::vector<u8> m_buffer = std::vector<u8>(READ_SIZE);
+};
+
+const Benchmark::Registration s_read{
+    {"GCZ/SequentialRead", "bytes", IMAGE_SIZE, [](u64 iterations) {
+       static GCZImage image;
+       for (u64 i = 0; i < iterations; ++i)
+         image.ReadAll();
+     }}};
+}  // Anonymous namespace
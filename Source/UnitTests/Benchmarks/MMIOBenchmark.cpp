@@ -0,0 +1,95 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <memory>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/MMIO.h"
+
+#include "Benchmark.h"
+
+namespace
+{
+constexpr u32 ACCESSES_PER_ITERATION = 1024;
+
+// A few registers of the processor interface, one for each kind of handler that is common.
+constexpr std::array<u32, 4> ADDRESSES{{0x0C003000, 0x0C003004, 0x0C003008, 0x0C00300C}};
+
+class MMIOBenchmark
+{
+public:
+  MMIOBenchmark() : m_mmio(std::make_unique<MMIO::Mapping>())
+  {
+    m_mmio->Register(ADDRESSES[0], MMIO::DirectRead<u32>(&m_direct),
+                     MMIO::DirectWrite<u32>(&m_direct));
+    m_mmio->Register(ADDRESSES[1], MMIO::ComplexRead<u32>([this](u32) { return m_complex; }),
+                     MMIO::ComplexWrite<u32>([this](u32, u32 value) { m_complex = value; }));
+    m_mmio->Register(ADDRESSES[2], MMIO::Constant<u32>(0x12345678), MMIO::Nop<u32>());
+    m_mmio->Register(ADDRESSES[3], MMIO::DirectRead<u32>(&m_direct, 0xFFFF),
+                     MMIO::DirectWrite<u32>(&m_direct, 0xFFFF));
+
+    // 16 bit reads of the same registers, the way the processor interface maps them.
+    for (u32 address : ADDRESSES)
+    {
+      m_mmio->Register(address, MMIO::ReadToLarger<u16>(m_mmio.get(), address, 16),
+                       MMIO::InvalidWrite<u16>());
+      m_mmio->Register(address + 2, MMIO::ReadToLarger<u16>(m_mmio.get(), address, 0),
+                       MMIO::InvalidWrite<u16>());
+    }
+  }
+
+  void Read(u64 iterations)
+  {
+    u32 sum = 0;
+    for (u64 i = 0; i < iterations; ++i)
+    {
+      for (u32 j = 0; j < ACCESSES_PER_ITERATION; ++j)
+        sum += m_mmio->Read<u32>(ADDRESSES[j % ADDRESSES.size()]);
+    }
+    Benchmark::DoNotOptimize(&sum);
+  }
+
+  void Read16(u64 iterations)
+  {
+    u32 sum = 0;
+    for (u64 i = 0; i < iterations; ++i)
+    {
+      for (u32 j = 0; j < ACCESSES_PER_ITERATION; ++j)
+        sum += m_mmio->Read<u16>(ADDRESSES[j % ADDRESSES.size()] + (j & 2));
+    }
+    Benchmark::DoNotOptimize(&sum);
+  }
+
+  void Write(u64 iterations)
+  {
+    for (u64 i = 0; i < iterations; ++i)
+    {
+      for (u32 j = 0; j < ACCESSES_PER_ITERATION; ++j)
+        m_mmio->Write<u32>(ADDRESSES[j % ADDRESSES.size()], j);
+    }
+    Benchmark::DoNotOptimize(&m_direct);
+  }
+
+private:
+  std::unique_ptr<MMIO::Mapping> m_mmio;
+  u32 m_direct = 0;
+  u32 m_complex = 0;
+};
+
+MMIOBenchmark& GetMMIOBenchmark()
+{
+  static MMIOBenchmark benchmark;
+  return benchmark;
+}
+
+const Benchmark::Registration s_read{{"MMIO/Read32", "accesses", ACCESSES_PER_ITERATION,
+                                      [](u64 iterations) { GetMMIOBenchmark().Read(iterations); }}};
+const Benchmark::Registration s_read16{
+    {"MMIO/Read16ToLarger", "accesses", ACCESSES_PER_ITERATION,
+     [](u64 iterations) { GetMMIOBenchmark().Read16(iterations); }}};
+const Benchmark::Registration s_write{
+    {"MMIO/Write32", "accesses", ACCESSES_PER_ITERATION,
+     [](u64 iterations) { GetMMIOBenchmark().Write(iterations); }}};
+}  // Anonymous namespace
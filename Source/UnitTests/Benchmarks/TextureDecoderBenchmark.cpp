@@ -0,0 +1,87 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+#include "Benchmark.h"
+
+namespace
+{
+constexpr int WIDTH = 256;
+constexpr int HEIGHT = 256;
+// Large enough for the 14-bit indices of C14X2.
+constexpr size_t TLUT_SIZE = 0x4000 * sizeof(u16);
+
+struct DecoderCase
+{
+  const char* name;
+  TextureFormat format;
+  TLUTFormat tlut_format;
+};
+
+// The formats games use the most. The throughput is in bytes of source data.
+constexpr DecoderCase DECODER_CASES[] = {
+    {"I4", TextureFormat::I4, TLUTFormat::IA8},
+    {"I8", TextureFormat::I8, TLUTFormat::IA8},
+    {"IA8", TextureFormat::IA8, TLUTFormat::IA8},
+    {"RGB565", TextureFormat::RGB565, TLUTFormat::IA8},
+    {"RGB5A3", TextureFormat::RGB5A3, TLUTFormat::IA8},
+    {"RGBA8", TextureFormat::RGBA8, TLUTFormat::IA8},
+    {"C4_RGB5A3", TextureFormat::C4, TLUTFormat::RGB5A3},
+    {"C8_RGB5A3", TextureFormat::C8, TLUTFormat::RGB5A3},
+    {"CMPR", TextureFormat::CMPR, TLUTFormat::IA8},
+};
+
+struct TextureData
+{
+  TextureData()
+  {
+    std::mt19937 rng(1234);
+    src.resize(TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, TextureFormat::RGBA8));
+    for (u8& byte : src)
+      byte = static_cast<u8>(rng());
+    tlut.resize(TLUT_SIZE);
+    for (u8& byte : tlut)
+      byte = static_cast<u8>(rng());
+    dst.resize(WIDTH * HEIGHT);
+  }
+
+  std::vector<u8> src;
+  std::vector<u8> tlut;
+  std::vector<u32> dst;
+};
+
+TextureData& GetTextureData()
+{
+  static TextureData data;
+  return data;
+}
+
+bool RegisterDecoders()
+{
+  for (const DecoderCase& c : DECODER_CASES)
+  {
+    Benchmark::Register(
+        {std::string("TextureDecoder/") + c.name, "bytes",
+         static_cast<double>(TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, c.format)),
+         [c](u64 iterations) {
+           TextureData& data = GetTextureData();
+           for (u64 i = 0; i < iterations; ++i)
+           {
+             TexDecoder_Decode(reinterpret_cast<u8*>(data.dst.data()), data.src.data(), WIDTH,
+                               HEIGHT, c.format, data.tlut.data(), c.tlut_format);
+           }
+           Benchmark::DoNotOptimize(data.dst.data());
+         }});
+  }
+  return true;
+}
+
+const bool s_registered = RegisterDecoders();
+}  // Anonymous namespace
@@ -0,0 +1,114 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+
+#include "Benchmark.h"
+
+namespace
+{
+constexpr int VERTICES_PER_ITERATION = 1000;
+// Enough for the largest vertex format below, or its arrays.
+constexpr size_t BUFFER_SIZE = 1024 * 1024;
+
+// The source data is all zeroes, which makes indexed attributes read the first element of their
+// arrays.
+void RegisterLoader(const std::string& name, std::function<void(TVtxDesc&, VAT&)> setup)
+{
+  Benchmark::Register(
+      {"VertexLoader/" + name, "vertices", VERTICES_PER_ITERATION, [setup](u64 iterations) {
+         static std::vector<u8> input(BUFFER_SIZE);
+         static std::vector<u8> arrays(BUFFER_SIZE);
+         static std::vector<u8> output(BUFFER_SIZE * 4);
+
+         TVtxDesc vtx_desc;
+         VAT vtx_attr;
+         std::memset(&vtx_desc, 0, sizeof(vtx_desc));
+         std::memset(&vtx_attr, 0, sizeof(vtx_attr));
+         setup(vtx_desc, vtx_attr);
+
+         for (int i = 0; i < 12; ++i)
+         {
+           VertexLoaderManager::cached_arraybases[i] = arrays.data();
+           g_main_cp_state.array_strides[i] = 64;
+         }
+
+         std::unique_ptr<VertexLoaderBase> loader =
+             VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+         for (u64 i = 0; i < iterations; ++i)
+         {
+           DataReader src(input.data(), input.data() + input.size());
+           DataReader dst(output.data(), output.data() + output.size());
+           loader->RunVertices(src, dst, VERTICES_PER_ITERATION);
+         }
+         Benchmark::DoNotOptimize(output.data());
+       }});
+}
+
+bool RegisterLoaders()
+{
+  RegisterLoader("PositionFloatXYZ", [](TVtxDesc& vtx_desc, VAT& vtx_attr) {
+    vtx_desc.Position = DIRECT;
+    vtx_attr.g0.PosElements = 1;
+    vtx_attr.g0.PosFormat = FORMAT_FLOAT;
+  });
+
+  // The usual format of models: quantized positions and normals with a color and a texture
+  // coordinate, all indexed.
+  RegisterLoader("Index16Model", [](TVtxDesc& vtx_desc, VAT& vtx_attr) {
+    vtx_desc.PosMatIdx = 1;
+    vtx_desc.Position = INDEX16;
+    vtx_desc.Normal = INDEX16;
+    vtx_desc.Color0 = INDEX16;
+    vtx_desc.Tex0Coord = INDEX16;
+    vtx_attr.g0.PosElements = 1;
+    vtx_attr.g0.PosFormat = FORMAT_SHORT;
+    vtx_attr.g0.PosFrac = 8;
+    vtx_attr.g0.NormalFormat = FORMAT_BYTE;
+    vtx_attr.g0.Color0Elements = 1;
+    vtx_attr.g0.Color0Comp = FORMAT_32B_8888;
+    vtx_attr.g0.Tex0CoordElements = 1;
+    vtx_attr.g0.Tex0CoordFormat = FORMAT_SHORT;
+    vtx_attr.g0.Tex0Frac = 10;
+    vtx_attr.g0.ByteDequant = true;
+  });
+
+  RegisterLoader("LargeFloatVertex", [](TVtxDesc& vtx_desc, VAT& vtx_attr) {
+    vtx_desc.PosMatIdx = 1;
+    vtx_desc.Tex0MatIdx = 1;
+    vtx_desc.Tex1MatIdx = 1;
+    vtx_desc.Position = INDEX16;
+    vtx_desc.Normal = INDEX16;
+    vtx_desc.Color0 = INDEX16;
+    vtx_desc.Color1 = INDEX16;
+    vtx_desc.Tex0Coord = INDEX16;
+    vtx_desc.Tex1Coord = INDEX16;
+    vtx_attr.g0.PosElements = 1;
+    vtx_attr.g0.PosFormat = FORMAT_FLOAT;
+    vtx_attr.g0.NormalElements = 1;
+    vtx_attr.g0.NormalFormat = FORMAT_FLOAT;
+    vtx_attr.g0.Color0Elements = 1;
+    vtx_attr.g0.Color0Comp = FORMAT_32B_8888;
+    vtx_attr.g0.Color1Elements = 1;
+    vtx_attr.g0.Color1Comp = FORMAT_32B_8888;
+    vtx_attr.g0.Tex0CoordElements = 1;
+    vtx_attr.g0.Tex0CoordFormat = FORMAT_FLOAT;
+    vtx_attr.g1.Tex1CoordElements = 1;
+    vtx_attr.g1.Tex1CoordFormat = FORMAT_FLOAT;
+  });
+  return true;
+}
+
+const bool s_registered = RegisterLoaders();
+}  // Anonymous namespace
@@ -0,0 +1,62 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "Common/Config/Config.h"
+
+namespace
+{
+const Config::ConfigInfo<int> TEST_INT{{Config::System::Main, "Test", "Int"}, 5};
+const Config::ConfigInfo<bool> TEST_BOOL{{Config::System::Main, "Test", "Bool"}, false};
+
+class ConfigTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::Init();
+    Config::AddLayer(std::make_unique<Config::Layer>(Config::LayerType::Base));
+  }
+
+  void TearDown() override { Config::Shutdown(); }
+};
+}  // namespace
+
+TEST_F(ConfigTest, CachedValueFollowsChanges)
+{
+  const Config::CachedValue<int> cached_int{TEST_INT};
+  const Config::CachedValue<bool> cached_bool{TEST_BOOL};
+  EXPECT_EQ(5, cached_int.Get());
+  EXPECT_FALSE(cached_bool.Get());
+
+  Config::SetBase(TEST_INT, -3);
+  EXPECT_EQ(-3, cached_int.Get());
+  EXPECT_FALSE(cached_bool.Get());
+
+  Config::SetCurrent(TEST_BOOL, true);
+  EXPECT_EQ(-3, cached_int.Get());
+  EXPECT_TRUE(cached_bool.Get());
+
+  Config::ClearCurrentRunLayer();
+  EXPECT_FALSE(cached_bool.Get());
+}
+
+TEST_F(ConfigTest, UnchangedValuesDoNotInvokeCallbacks)
+{
+  int calls = 0;
+  Config::AddConfigChangedCallback([&calls] { ++calls; });
+
+  Config::SetBase(TEST_INT, 7);
+  EXPECT_EQ(1, calls);
+
+  const u32 version = Config::GetConfigVersion();
+  Config::SetBase(TEST_INT, 7);
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(version, Config::GetConfigVersion());
+
+  Config::SetBase(TEST_INT, 8);
+  EXPECT_EQ(2, calls);
+}
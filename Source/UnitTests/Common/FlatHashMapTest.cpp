@@ -0,0 +1,73 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+#include "Common/CommonTypes.h"
+#include "Common/FlatHashMap.h"
+
+TEST(FlatHashMap, Simple)
+{
+  Common::FlatHashMap<u32, int> map;
+
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(nullptr, map.Find(0x80000000));
+  EXPECT_FALSE(map.Erase(0x80000000));
+
+  map[0x80000000] = 1;
+  map[0x80000004] = 2;
+  EXPECT_EQ(2u, map.Size());
+  ASSERT_NE(nullptr, map.Find(0x80000000));
+  EXPECT_EQ(1, *map.Find(0x80000000));
+  EXPECT_EQ(2, map[0x80000004]);
+  EXPECT_FALSE(map.Contains(0x80000008));
+
+  EXPECT_TRUE(map.Erase(0x80000000));
+  EXPECT_FALSE(map.Contains(0x80000000));
+  EXPECT_TRUE(map.Contains(0x80000004));
+  EXPECT_EQ(1u, map.Size());
+
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+  EXPECT_FALSE(map.Contains(0x80000004));
+}
+
+TEST(FlatHashMap, MatchesStdMap)
+{
+  Common::FlatHashMap<u32, u32> map;
+  std::map<u32, u32> reference;
+
+  // Use a small key space, so that there are plenty of collisions and erased keys get reused.
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<u32> dist(0, 0x3FFF);
+  for (int i = 0; i < 100000; ++i)
+  {
+    const u32 key = 0x80000000 | (dist(rng) << 2);
+    if (rng() % 3 == 0)
+    {
+      EXPECT_EQ(reference.erase(key) != 0, map.Erase(key));
+    }
+    else
+    {
+      map[key] = i;
+      reference[key] = i;
+    }
+  }
+
+  EXPECT_EQ(reference.size(), map.Size());
+  for (const auto& e : reference)
+  {
+    ASSERT_NE(nullptr, map.Find(e.first));
+    EXPECT_EQ(e.second, *map.Find(e.first));
+  }
+
+  size_t count = 0;
+  map.ForEach([&](u32 key, u32 value) {
+    EXPECT_EQ(reference[key], value);
+    count++;
+  });
+  EXPECT_EQ(reference.size(), count);
+}
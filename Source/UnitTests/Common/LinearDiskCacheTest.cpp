@@ -0,0 +1,98 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+class Reader final : public LinearDiskCacheReader<u32, u16>
+{
+public:
+  void Read(const u32& key, const u16* value, u32 value_size) override
+  {
+    entries[key].assign(value, value + value_size);
+  }
+
+  std::map<u32, std::vector<u16>> entries;
+};
+
+class LinearDiskCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    m_filename = m_directory + "/test.cache";
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  void AppendEntries(u32 first_key, u32 count)
+  {
+    Reader reader;
+    LinearDiskCache<u32, u16> cache;
+    cache.OpenAndRead(m_filename, reader);
+    for (u32 key = first_key; key < first_key + count; ++key)
+    {
+      const std::vector<u16> value(key, static_cast<u16>(key));
+      cache.Append(key, value.data(), key);
+    }
+    cache.Close();
+  }
+
+  std::string m_directory;
+  std::string m_filename;
+};
+}  // Anonymous namespace
+
+TEST_F(LinearDiskCacheTest, AppendAndRead)
+{
+  AppendEntries(0, 4);
+
+  Reader reader;
+  LinearDiskCache<u32, u16> cache;
+  EXPECT_EQ(4u, cache.OpenAndRead(m_filename, reader));
+  ASSERT_EQ(4u, reader.entries.size());
+  EXPECT_TRUE(reader.entries[0].empty());
+  EXPECT_EQ(std::vector<u16>(3, 3), reader.entries[3]);
+}
+
+TEST_F(LinearDiskCacheTest, IncompleteEntryIsDropped)
+{
+  AppendEntries(0, 4);
+
+  // Cut off the number of the last entry, as if Dolphin had exited while appending it.
+  {
+    File::IOFile file(m_filename, "r+b");
+    ASSERT_TRUE(file.Resize(file.GetSize() - 2));
+  }
+
+  AppendEntries(10, 1);
+
+  Reader reader;
+  LinearDiskCache<u32, u16> cache;
+  EXPECT_EQ(4u, cache.OpenAndRead(m_filename, reader));
+  EXPECT_EQ(0u, reader.entries.count(3));
+  EXPECT_EQ(std::vector<u16>(10, 10), reader.entries[10]);
+}
+
+TEST_F(LinearDiskCacheTest, BadHeaderClearsCache)
+{
+  AppendEntries(0, 2);
+  ASSERT_TRUE(File::WriteStringToFile("not a cache", m_filename));
+
+  Reader reader;
+  LinearDiskCache<u32, u16> cache;
+  EXPECT_EQ(0u, cache.OpenAndRead(m_filename, reader));
+  EXPECT_TRUE(reader.entries.empty());
+}
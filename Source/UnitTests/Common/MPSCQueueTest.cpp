@@ -0,0 +1,77 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32, 4> q;
+
+  u32 v;
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  for (u32 i = 0; i < 4; ++i)
+    EXPECT_TRUE(q.Push(i));
+  EXPECT_FALSE(q.Push(4u));
+  EXPECT_FALSE(q.Empty());
+
+  // Popping frees up a cell for the next lap.
+  ASSERT_TRUE(q.Pop(v));
+  EXPECT_EQ(0u, v);
+  EXPECT_TRUE(q.Push(4u));
+
+  for (u32 i = 1; i < 5; ++i)
+  {
+    ASSERT_TRUE(q.Pop(v));
+    EXPECT_EQ(i, v);
+  }
+  EXPECT_TRUE(q.Empty());
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 NUM_WRITERS = 4;
+  constexpr u32 NUM_VALUES = 25000;
+  Common::MPSCQueue<u32, 256> q;
+
+  auto inserter = [&q](u32 writer) {
+    for (u32 i = 0; i < NUM_VALUES; ++i)
+    {
+      while (!q.Push(writer * NUM_VALUES + i))
+        std::this_thread::yield();
+    }
+  };
+
+  std::vector<std::thread> inserter_threads;
+  for (u32 i = 0; i < NUM_WRITERS; ++i)
+    inserter_threads.emplace_back(inserter, i);
+
+  // The values of each writer must come out in the order they were pushed.
+  std::vector<u32> next(NUM_WRITERS, 0);
+  for (u32 count = 0; count < NUM_WRITERS * NUM_VALUES;)
+  {
+    u32 v;
+    if (!q.Pop(v))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const u32 writer = v / NUM_VALUES;
+    ASSERT_LT(writer, NUM_WRITERS);
+    EXPECT_EQ(next[writer], v % NUM_VALUES);
+    next[writer] = v % NUM_VALUES + 1;
+    count++;
+  }
+  EXPECT_TRUE(q.Empty());
+
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+}
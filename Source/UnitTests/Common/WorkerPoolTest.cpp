@@ -0,0 +1,41 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/ThreadPool.h"
+#include "Common/WorkerPool.h"
+
+TEST(WorkerPool, RunsEveryIndexOnce)
+{
+  Common::WorkerPool pool(4);
+  std::vector<std::atomic<int>> runs(1000);
+  for (auto& count : runs)
+    count = 0;
+
+  pool.Run(runs.size(), [&runs](size_t i) { ++runs[i]; });
+
+  for (const auto& count : runs)
+    EXPECT_EQ(1, count.load());
+}
+
+TEST(WorkerPool, NestedRuns)
+{
+  // Every thread of the shared pool can be busy with an outer job while the inner ones run.
+  Common::WorkerPool outer_pool(Common::ThreadPool::GetNumThreads());
+  Common::WorkerPool inner_pool(Common::ThreadPool::GetNumThreads(), Common::TaskPriority::High);
+  std::atomic<int> total{0};
+
+  outer_pool.Run(16, [&](size_t) { inner_pool.Run(16, [&](size_t) { ++total; }); });
+
+  EXPECT_EQ(16 * 16, total.load());
+}
+
+TEST(WorkerPool, EmptyRun)
+{
+  Common::WorkerPool pool(2);
+  pool.Run(0, [](size_t) { FAIL(); });
+}
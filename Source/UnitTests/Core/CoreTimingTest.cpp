@@ -5,8 +5,14 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -265,9 +271,9 @@ TEST(CoreTiming, ScheduleIntoPast)
   // the stale value, i.e. effectively half-way through the previous slice.
   // NOTE: We're only testing that the scheduler doesn't break, not whether this makes sense.
   Core::UndeclareAsCPUThread();
-  CoreTiming::g.global_timer -= 1000;
+  CoreTiming::GetGlobals().global_timer -= 1000;
   CoreTiming::ScheduleEvent(0, cb_b, CB_IDS[1], CoreTiming::FromThread::NON_CPU);
-  CoreTiming::g.global_timer += 1000;
+  CoreTiming::GetGlobals().global_timer += 1000;
   Core::DeclareAsCPUThread();
   AdvanceAndCheck(1, MAX_SLICE_LENGTH, MAX_SLICE_LENGTH + 1000);
 
@@ -347,3 +353,129 @@ TEST(CoreTiming, Overclocking)
   SConfig::GetInstance().m_OCFactor = 1.0;
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, SeparateInstances)
+{
+  ScopeInit guard;
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::ScheduleEvent(100, cb_a, CB_IDS[0]);
+  const std::string default_summary = CoreTiming::GetScheduledEventsSummary();
+
+  CoreTiming::Instance* instance = CoreTiming::CreateInstance();
+  CoreTiming::SetCurrentInstance(instance);
+  CoreTiming::Init();
+  EXPECT_EQ(instance, CoreTiming::GetCurrentInstance());
+  EXPECT_EQ(std::string::npos, CoreTiming::GetScheduledEventsSummary().find("callbackA"));
+
+  CoreTiming::EventType* cb_b = CoreTiming::RegisterEvent("callbackB", CallbackTemplate<1>);
+  CoreTiming::ScheduleEvent(200, cb_b, CB_IDS[1]);
+  EXPECT_NE(std::string::npos, CoreTiming::GetScheduledEventsSummary().find("callbackB"));
+  CoreTiming::Shutdown();
+
+  // Switching back leaves the events of the default instance as they were.
+  CoreTiming::SetCurrentInstance(nullptr);
+  CoreTiming::DestroyInstance(instance);
+  EXPECT_EQ(default_summary, CoreTiming::GetScheduledEventsSummary());
+}
+
+namespace ThroughputTest
+{
+static constexpr int EVENTS_PER_FRAME = 4096;
+static constexpr int NUM_FRAMES = 32;
+// Roughly the number of cycles in a 60 Hz frame.
+static constexpr s64 FRAME_CYCLES = 8100000;
+
+static std::atomic<int> s_events_ran{0};
+static s64 s_last_time = 0;
+
+static void CountCallback(u64 userdata, s64 lateness)
+{
+  // Events must come out in time order.
+  const s64 now = CoreTiming::GetTicks() - lateness;
+  EXPECT_LE(s_last_time, now);
+  s_last_time = now;
+  s_events_ran++;
+}
+
+static void RunUntil(int expected_events)
+{
+  s_last_time = 0;
+  while (s_events_ran < expected_events)
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+}
+}
+
+#define AS_NS(diff)                                                                                \
+  ((unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count())
+
+TEST(CoreTiming, ScheduleThroughput)
+{
+  using namespace ThroughputTest;
+
+  ScopeInit guard;
+
+  CoreTiming::EventType* cb = CoreTiming::RegisterEvent("callbackCount", CountCallback);
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<s64> dist(0, FRAME_CYCLES);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  s_events_ran = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int frame = 0; frame < NUM_FRAMES; ++frame)
+  {
+    for (int i = 0; i < EVENTS_PER_FRAME; ++i)
+      CoreTiming::ScheduleEvent(dist(rng), cb, i);
+    RunUntil((frame + 1) * EVENTS_PER_FRAME);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  EXPECT_EQ(NUM_FRAMES * EVENTS_PER_FRAME, s_events_ran);
+
+  printf("CoreTiming CPU thread scheduling: %llu ns/event\n",
+         AS_NS(end - start) / (NUM_FRAMES * EVENTS_PER_FRAME));
+}
+
+TEST(CoreTiming, CrossThreadScheduleThroughput)
+{
+  using namespace ThroughputTest;
+  constexpr int NUM_THREADS = 4;
+
+  ScopeInit guard;
+
+  CoreTiming::EventType* cb = CoreTiming::RegisterEvent("callbackCount", CountCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  s_events_ran = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int frame = 0; frame < NUM_FRAMES; ++frame)
+  {
+    // Each frame schedules more events than fit in the lock-free ring, so that the overflow path
+    // gets exercised as well.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t)
+    {
+      threads.emplace_back([cb, t] {
+        std::mt19937 rng(t);
+        std::uniform_int_distribution<s64> dist(0, FRAME_CYCLES);
+        for (int i = 0; i < EVENTS_PER_FRAME / NUM_THREADS; ++i)
+          CoreTiming::ScheduleEvent(dist(rng), cb, i, CoreTiming::FromThread::NON_CPU);
+      });
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+
+    RunUntil((frame + 1) * EVENTS_PER_FRAME);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  EXPECT_EQ(NUM_FRAMES * EVENTS_PER_FRAME, s_events_ran);
+
+  printf("CoreTiming cross-thread scheduling: %llu ns/event\n",
+         AS_NS(end - start) / (NUM_FRAMES * EVENTS_PER_FRAME));
+}
@@ -0,0 +1,69 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <gtest/gtest.h>
+#include <random>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Core/DSP/DSPAccelerator.h"
+
+namespace
+{
+// Straightforward one sample at a time decoder, like the accelerator.
+s16 DecodeReference(const u8* frame, u32 nibble, const s16* coefs, u16 pred_scale, s16* yn1,
+                    s16* yn2)
+{
+  int scale = 1 << (pred_scale & 0xF);
+  int coef_idx = (pred_scale >> 4) & 0x7;
+  s32 coef1 = coefs[coef_idx * 2 + 0];
+  s32 coef2 = coefs[coef_idx * 2 + 1];
+
+  int temp = (nibble & 1) ? (frame[nibble >> 1] & 0xF) : (frame[nibble >> 1] >> 4);
+  if (temp >= 8)
+    temp -= 16;
+
+  int val = (scale * temp) + ((0x400 + coef1 * *yn1 + coef2 * *yn2) >> 11);
+  val = MathUtil::Clamp(val, -0x7FFF, 0x7FFF);
+  *yn2 = *yn1;
+  *yn1 = val;
+  return val;
+}
+}  // namespace
+
+TEST(DSPAccelerator, DecodeADPCMFrameMatchesReference)
+{
+  std::mt19937 rng(1234);
+  std::array<s16, 16> coefs;
+  for (int i = 0; i < 10000; ++i)
+  {
+    for (s16& coef : coefs)
+      coef = static_cast<s16>(rng());
+    u8 frame[8];
+    for (u8& byte : frame)
+      byte = static_cast<u8>(rng());
+
+    const u16 pred_scale = rng() & 0x7F;
+    const u32 first = 2 + rng() % 14;
+    const u32 count = 1 + rng() % (16 - first);
+    const s16 start_yn1 = static_cast<s16>(rng() % 0xFFFF - 0x7FFF);
+    const s16 start_yn2 = static_cast<s16>(rng() % 0xFFFF - 0x7FFF);
+
+    s16 ref_yn1 = start_yn1, ref_yn2 = start_yn2;
+    std::array<s16, 14> expected;
+    for (u32 j = 0; j < count; ++j)
+      expected[j] = DecodeReference(frame, first + j, coefs.data(), pred_scale, &ref_yn1, &ref_yn2);
+
+    s16 yn1 = start_yn1, yn2 = start_yn2;
+    std::array<s16, 14> decoded;
+    DSP::DecodeADPCMFrame(decoded.data(), frame, first, count, coefs.data(), pred_scale, &yn1,
+                          &yn2);
+
+    for (u32 j = 0; j < count; ++j)
+      ASSERT_EQ(expected[j], decoded[j]) << "iteration " << i << " sample " << j;
+    EXPECT_EQ(ref_yn1, yn1);
+    EXPECT_EQ(ref_yn2, yn2);
+  }
+}
@@ -0,0 +1,118 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCodeUtil.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+
+// After the DSP headers, since the x64 emitter has a function called TEST.
+#include <gtest/gtest.h>
+
+namespace
+{
+// Loops at 0x0000, 0x0002, 0x0008, 0x000e, 0x0014 and 0x001b.
+constexpr char LOOPS[] = R"(
+dead_loop:
+	jmp		dead_loop
+
+wait_for_dsp_mbox:
+	lrs		$AC1.M, @DMBH
+	andcf	$AC1.M, #0x8000
+	jlz		wait_for_dsp_mbox
+	ret
+
+wait_for_cpu_mbox:
+	lrs		$AC1.M, @CMBH
+	andcf	$AC1.M, #0x8000
+	jlnz	wait_for_cpu_mbox
+	ret
+
+wait_dma:
+	lrs		$AC1.M, @DSCR
+	andcf	$AC1.M, #0x0004
+	jlz		wait_dma
+	ret
+
+count_until_mail:
+	inc		$ACC0
+	lrs		$AC1.M, @CMBH
+	andcf	$AC1.M, #0x8000
+	jlnz	count_until_mail
+	ret
+
+wait_for_cpu_mbox_lr:
+	lr		$AC0.M, @CMBH
+	andcf	$AC0.M, #0x8000
+	jlnz	wait_for_cpu_mbox_lr
+	ret
+)";
+
+class DSPAnalyzerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    DSP::InitInstructionTable();
+    m_iram.fill(0);
+    m_irom.fill(0);
+    m_old_iram = DSP::g_dsp.iram;
+    m_old_irom = DSP::g_dsp.irom;
+    DSP::g_dsp.iram = m_iram.data();
+    DSP::g_dsp.irom = m_irom.data();
+  }
+
+  void TearDown() override
+  {
+    DSP::g_dsp.iram = m_old_iram;
+    DSP::g_dsp.irom = m_old_irom;
+  }
+
+  void Load(const char* text)
+  {
+    std::vector<u16> code;
+    ASSERT_TRUE(DSP::Assemble(text, code));
+    std::copy(code.begin(), code.end(), m_iram.begin());
+    DSP::Analyzer::Analyze();
+  }
+
+  static bool IsIdleSkip(u16 address)
+  {
+    return (DSP::Analyzer::GetCodeFlags(address) & DSP::Analyzer::CODE_IDLE_SKIP) != 0;
+  }
+
+private:
+  std::array<u16, DSP::DSP_IRAM_SIZE> m_iram;
+  std::array<u16, DSP::DSP_IROM_SIZE> m_irom;
+  u16* m_old_iram;
+  u16* m_old_irom;
+};
+}  // Anonymous namespace
+
+TEST_F(DSPAnalyzerTest, FindsWaitLoops)
+{
+  Load(LOOPS);
+
+  EXPECT_TRUE(IsIdleSkip(0x0000));
+  EXPECT_TRUE(IsIdleSkip(0x0002));
+  EXPECT_TRUE(IsIdleSkip(0x0008));
+  EXPECT_TRUE(IsIdleSkip(0x001b));
+}
+
+TEST_F(DSPAnalyzerTest, IgnoresLoopsWithSideEffects)
+{
+  Load(LOOPS);
+
+  // Reading the DMA status isn't polling for mail, and the counter changes with every iteration.
+  EXPECT_FALSE(IsIdleSkip(0x000e));
+  EXPECT_FALSE(IsIdleSkip(0x0014));
+  // Only the starts of the loops are marked.
+  EXPECT_FALSE(IsIdleSkip(0x0003));
+  EXPECT_FALSE(IsIdleSkip(0x0004));
+}
@@ -138,3 +138,63 @@ TEST_F(MappingTest, ReadWriteComplex)
   EXPECT_TRUE(read_called);
   EXPECT_TRUE(write_called);
 }
+
+TEST_F(MappingTest, ReadWriteToSmallerDirect)
+{
+  u32 target = 0;
+
+  m_mapping->Register(0x0C001234, MMIO::DirectRead<u16>(MMIO::Utils::HighPart(&target)),
+                      MMIO::DirectWrite<u16>(MMIO::Utils::HighPart(&target)));
+  m_mapping->Register(0x0C001236, MMIO::DirectRead<u16>(MMIO::Utils::LowPart(&target), 0xFF),
+                      MMIO::DirectWrite<u16>(MMIO::Utils::LowPart(&target), 0xFF));
+  m_mapping->Register(0x0C001234, MMIO::ReadToSmaller<u32>(m_mapping, 0x0C001234, 0x0C001236),
+                      MMIO::WriteToSmaller<u32>(m_mapping, 0x0C001234, 0x0C001236));
+
+  m_mapping->Write<u32>(0x0C001234, 0x12345678);
+  EXPECT_EQ(0x12340078u, target);
+  EXPECT_EQ(0x12340078u, m_mapping->Read<u32>(0x0C001234));
+
+  target = 0xdeadbeef;
+  EXPECT_EQ(0xdead00efu, m_mapping->Read<u32>(0x0C001234));
+  EXPECT_EQ(0xdeadu, m_mapping->Read<u16>(0x0C001234));
+}
+
+TEST_F(MappingTest, ReadToSmallerMixed)
+{
+  u16 target = 0x5678;
+
+  m_mapping->Register(0x0C001234, MMIO::Constant<u16>(0x1234), MMIO::Nop<u16>());
+  m_mapping->Register(0x0C001236, MMIO::DirectRead<u16>(&target), MMIO::DirectWrite<u16>(&target));
+  m_mapping->Register(0x0C001234, MMIO::ReadToSmaller<u32>(m_mapping, 0x0C001234, 0x0C001236),
+                      MMIO::WriteToSmaller<u32>(m_mapping, 0x0C001234, 0x0C001236));
+
+  EXPECT_EQ(0x12345678u, m_mapping->Read<u32>(0x0C001234));
+  m_mapping->Write<u32>(0x0C001234, 0xdeadbeef);
+  EXPECT_EQ(0xbeef, target);
+  EXPECT_EQ(0x1234beefu, m_mapping->Read<u32>(0x0C001234));
+}
+
+TEST_F(MappingTest, ReadToLarger)
+{
+  u16 target = 0x1234;
+
+  m_mapping->Register(0x0C001234, MMIO::DirectRead<u16>(&target, 0xFF0F), MMIO::Nop<u16>());
+  m_mapping->Register(0x0C001236, MMIO::Constant<u16>(0xbeef), MMIO::Nop<u16>());
+  m_mapping->Register(0x0C001234, MMIO::ReadToLarger<u8>(m_mapping, 0x0C001234, 8),
+                      MMIO::Nop<u8>());
+  m_mapping->Register(0x0C001235, MMIO::ReadToLarger<u8>(m_mapping, 0x0C001234, 0),
+                      MMIO::Nop<u8>());
+  m_mapping->Register(0x0C001236, MMIO::ReadToLarger<u8>(m_mapping, 0x0C001236, 8),
+                      MMIO::Nop<u8>());
+  m_mapping->Register(0x0C001237, MMIO::ReadToLarger<u8>(m_mapping, 0x0C001236, 0),
+                      MMIO::Nop<u8>());
+
+  EXPECT_EQ(0x12, m_mapping->Read<u8>(0x0C001234));
+  EXPECT_EQ(0x04, m_mapping->Read<u8>(0x0C001235));
+  EXPECT_EQ(0xbe, m_mapping->Read<u8>(0x0C001236));
+  EXPECT_EQ(0xef, m_mapping->Read<u8>(0x0C001237));
+
+  target = 0xabcd;
+  EXPECT_EQ(0xab, m_mapping->Read<u8>(0x0C001234));
+  EXPECT_EQ(0x0d, m_mapping->Read<u8>(0x0C001235));
+}
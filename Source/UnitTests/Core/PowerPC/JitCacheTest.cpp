@@ -0,0 +1,161 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+class JitCacheFakeJit : public JitBase
+{
+public:
+  // CPUCoreBase methods
+  void Init() override {}
+  void Shutdown() override {}
+  void ClearCache() override {}
+  void Run() override {}
+  void SingleStep() override {}
+  const char* GetName() override { return nullptr; }
+  // JitBase methods
+  JitBaseBlockCache* GetBlockCache() override { return nullptr; }
+  void Jit(u32 em_address) override {}
+  const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
+  bool HandleFault(uintptr_t access_address, SContext* ctx) override { return false; }
+};
+
+class FakeBlockCache : public JitBaseBlockCache
+{
+public:
+  explicit FakeBlockCache(JitBase& jit) : JitBaseBlockCache{jit} {}
+  int m_links_written = 0;
+
+private:
+  void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override
+  {
+    if (dest)
+      m_links_written++;
+  }
+};
+
+// Adds a block covering [address, address + size) with the given exits.
+JitBlock* AddBlock(FakeBlockCache& cache, u32 address, u32 size, const std::vector<u32>& exits)
+{
+  JitBlock* block = cache.AllocateBlock(address);
+  block->checkedEntry = nullptr;
+  block->normalEntry = nullptr;
+  block->codeSize = 0;
+  block->originalSize = size / 4;
+  for (u32 exit : exits)
+    block->linkData.push_back({nullptr, exit, false, false});
+
+  std::set<u32> physical_addresses;
+  for (u32 i = 0; i < size; i += 4)
+    physical_addresses.insert(address + i);
+  cache.FinalizeBlock(*block, true, physical_addresses);
+  return block;
+}
+}  // Anonymous namespace
+
+#define AS_NS(diff)                                                                                \
+  ((unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count())
+
+TEST(JitCache, LookupLinkAndInvalidate)
+{
+  JitCacheFakeJit jit;
+  FakeBlockCache cache(jit);
+  cache.Clear();
+
+  JitBlock* a = AddBlock(cache, 0x80000000, 0x20, {0x80000100});
+  EXPECT_FALSE(a->linkData[0].linkStatus);
+
+  JitBlock* b = AddBlock(cache, 0x80000100, 0x20, {0x80000000});
+  EXPECT_TRUE(a->linkData[0].linkStatus);
+  EXPECT_TRUE(b->linkData[0].linkStatus);
+  EXPECT_EQ(2, cache.m_links_written);
+
+  // This block straddles two macro blocks of the invalidation map.
+  JitBlock* c = AddBlock(cache, 0x800001F0, 0x20, {});
+
+  EXPECT_EQ(a, cache.GetBlockFromStartAddress(0x80000000, 0));
+  EXPECT_EQ(b, cache.GetBlockFromStartAddress(0x80000100, 0));
+  EXPECT_EQ(c, cache.GetBlockFromStartAddress(0x800001F0, 0));
+  EXPECT_EQ(nullptr, cache.GetBlockFromStartAddress(0x80000004, 0));
+  EXPECT_EQ(nullptr,
+            cache.GetBlockFromStartAddress(0x80000000, JitBaseBlockCache::JIT_CACHE_MSR_MASK));
+
+  cache.InvalidateICache(0x80000100, 0x20, false);
+  EXPECT_EQ(nullptr, cache.GetBlockFromStartAddress(0x80000100, 0));
+  EXPECT_EQ(c, cache.GetBlockFromStartAddress(0x800001F0, 0));
+  EXPECT_FALSE(a->linkData[0].linkStatus);
+
+  cache.InvalidateICache(0x80000200, 0x20, false);
+  EXPECT_EQ(nullptr, cache.GetBlockFromStartAddress(0x800001F0, 0));
+  EXPECT_EQ(a, cache.GetBlockFromStartAddress(0x80000000, 0));
+
+  // Recompiling the destination links the remaining block to it again.
+  b = AddBlock(cache, 0x80000100, 0x20, {});
+  EXPECT_TRUE(a->linkData[0].linkStatus);
+
+  // Invalidating a range larger than the cache has macro blocks takes a different path.
+  cache.InvalidateICache(0x80000000, 0x01000000, false);
+  EXPECT_EQ(nullptr, cache.GetBlockFromStartAddress(0x80000000, 0));
+  EXPECT_EQ(nullptr, cache.GetBlockFromStartAddress(0x80000100, 0));
+
+  int count = 0;
+  cache.RunOnBlocks([&count](const JitBlock&) { count++; });
+  EXPECT_EQ(0, count);
+}
+
+TEST(JitCache, LookupAndInvalidationRate)
+{
+  constexpr u32 BASE = 0x80000000;
+  constexpr u32 BLOCK_SIZE = 0x40;
+  constexpr u32 NUM_BLOCKS = 0x4000;
+  constexpr int LOOKUP_ROUNDS = 64;
+
+  JitCacheFakeJit jit;
+  FakeBlockCache cache(jit);
+  cache.Clear();
+
+  // Each block exits to the next one, like straight-line code split into blocks.
+  for (u32 i = 0; i < NUM_BLOCKS; ++i)
+    AddBlock(cache, BASE + i * BLOCK_SIZE, BLOCK_SIZE, {BASE + (i + 1) * BLOCK_SIZE});
+
+  auto start = std::chrono::high_resolution_clock::now();
+  u32 found = 0;
+  for (int round = 0; round < LOOKUP_ROUNDS; ++round)
+  {
+    for (u32 i = 0; i < NUM_BLOCKS; ++i)
+      found += cache.GetBlockFromStartAddress(BASE + i * BLOCK_SIZE, 0) != nullptr;
+  }
+  auto lookup_end = std::chrono::high_resolution_clock::now();
+  EXPECT_EQ(NUM_BLOCKS * LOOKUP_ROUNDS, found);
+
+  // Invalidate the blocks in an interleaved order, so that both linked and unlinked neighbours
+  // get destroyed.
+  for (u32 i = 0; i < NUM_BLOCKS; i += 2)
+    cache.InvalidateICache(BASE + i * BLOCK_SIZE, BLOCK_SIZE, false);
+  for (u32 i = 1; i < NUM_BLOCKS; i += 2)
+    cache.InvalidateICache(BASE + i * BLOCK_SIZE, BLOCK_SIZE, false);
+  auto invalidate_end = std::chrono::high_resolution_clock::now();
+
+  int count = 0;
+  cache.RunOnBlocks([&count](const JitBlock&) { count++; });
+  EXPECT_EQ(0, count);
+
+  const unsigned long long lookup_ns = AS_NS(lookup_end - start);
+  const unsigned long long invalidate_ns = AS_NS(invalidate_end - lookup_end);
+  printf("JIT block cache timing:\n");
+  printf("lookup                 %llu ns/block\n", lookup_ns / (NUM_BLOCKS * LOOKUP_ROUNDS));
+  printf("invalidation           %llu ns/block\n", invalidate_ns / NUM_BLOCKS);
+}
@@ -0,0 +1,108 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+
+namespace
+{
+class HiresTexturePackTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    m_filename = m_directory + "/test.texpack";
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+  std::string m_filename;
+};
+}  // Anonymous namespace
+
+TEST_F(HiresTexturePackTest, WriteAndRead)
+{
+  // A 4x4 RGBA8 texture with a 2x2 mipmap, and an 8x4 DXT1 texture.
+  std::vector<u8> rgba_level0(4 * 4 * 4);
+  std::vector<u8> rgba_level1(2 * 2 * 4);
+  std::vector<u8> dxt1(2 * 8);
+  for (size_t i = 0; i < rgba_level0.size(); ++i)
+    rgba_level0[i] = static_cast<u8>(i);
+  for (size_t i = 0; i < rgba_level1.size(); ++i)
+    rgba_level1[i] = static_cast<u8>(0x80 + i);
+  for (size_t i = 0; i < dxt1.size(); ++i)
+    dxt1[i] = static_cast<u8>(0xF0 - i);
+
+  {
+    HiresTexturePackWriter writer;
+    ASSERT_TRUE(writer.Open(m_filename));
+    ASSERT_TRUE(writer.AddTexture(
+        "tex1_4x4_m_0123456789abcdef_6",
+        {{AbstractTextureFormat::RGBA8, 4, 4, 4, rgba_level0.data(), rgba_level0.size()},
+         {AbstractTextureFormat::RGBA8, 2, 2, 2, rgba_level1.data(), rgba_level1.size()}}));
+    ASSERT_TRUE(
+        writer.AddTexture("tex1_8x4_fedcba9876543210_14",
+                          {{AbstractTextureFormat::DXT1, 8, 4, 8, dxt1.data(), dxt1.size()}}));
+    ASSERT_TRUE(writer.Finish());
+  }
+
+  HiresTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_filename));
+  EXPECT_EQ(2u, pack.GetTextureCount());
+  EXPECT_TRUE(pack.Contains("tex1_8x4_fedcba9876543210_14"));
+  EXPECT_FALSE(pack.Contains("tex1_8x4_fedcba9876543210_1"));
+  EXPECT_FALSE(pack.Contains(""));
+
+  std::vector<HiresTexturePack::Level> levels;
+  ASSERT_TRUE(pack.GetLevels("tex1_4x4_m_0123456789abcdef_6", &levels));
+  ASSERT_EQ(2u, levels.size());
+  EXPECT_EQ(AbstractTextureFormat::RGBA8, levels[0].format);
+  EXPECT_EQ(4u, levels[0].width);
+  EXPECT_EQ(2u, levels[1].height);
+  ASSERT_EQ(rgba_level0.size(), levels[0].data_size);
+  EXPECT_EQ(rgba_level0, std::vector<u8>(levels[0].data, levels[0].data + levels[0].data_size));
+  EXPECT_EQ(rgba_level1, std::vector<u8>(levels[1].data, levels[1].data + levels[1].data_size));
+
+  ASSERT_TRUE(pack.GetLevels("tex1_8x4_fedcba9876543210_14", &levels));
+  ASSERT_EQ(1u, levels.size());
+  EXPECT_EQ(AbstractTextureFormat::DXT1, levels[0].format);
+  EXPECT_EQ(dxt1, std::vector<u8>(levels[0].data, levels[0].data + levels[0].data_size));
+}
+
+TEST_F(HiresTexturePackTest, RejectsInvalidFiles)
+{
+  HiresTexturePack pack;
+  EXPECT_FALSE(pack.Open(m_filename));
+
+  // A pack which was never finished has no header.
+  std::vector<u8> rgba(4 * 4 * 4);
+  {
+    HiresTexturePackWriter writer;
+    ASSERT_TRUE(writer.Open(m_filename));
+    ASSERT_TRUE(writer.AddTexture(
+        "tex1_4x4_0123456789abcdef_6",
+        {{AbstractTextureFormat::RGBA8, 4, 4, 4, rgba.data(), rgba.size()}}));
+  }
+  EXPECT_FALSE(pack.Open(m_filename));
+
+  // Level data which is too small for the size of the texture.
+  {
+    HiresTexturePackWriter writer;
+    ASSERT_TRUE(writer.Open(m_filename));
+    ASSERT_TRUE(writer.AddTexture(
+        "tex1_4x4_0123456789abcdef_6",
+        {{AbstractTextureFormat::RGBA8, 8, 8, 8, rgba.data(), rgba.size()}}));
+    ASSERT_TRUE(writer.Finish());
+  }
+  EXPECT_FALSE(pack.Open(m_filename));
+}
@@ -0,0 +1,42 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "VideoCommon/RenderState.h"
+
+TEST(StateInterner, GivesEqualStatesTheSameID)
+{
+  StateInterner<BlendingState> interner;
+  BlendingState a;
+  a.hex = 0;
+  a.blendenable = true;
+  BlendingState b;
+  b.hex = 0;
+  b.logicopenable = true;
+
+  const u32 a_id = interner.GetID(a);
+  const u32 b_id = interner.GetID(b);
+  EXPECT_EQ(0u, a_id);
+  EXPECT_EQ(1u, b_id);
+  EXPECT_EQ(a_id, interner.GetID(a));
+  EXPECT_EQ(2u, interner.GetSize());
+
+  EXPECT_EQ(a.hex, interner.GetState(a_id).hex);
+  EXPECT_EQ(b.hex, interner.GetState(b_id).hex);
+}
+
+TEST(StateInterner, ComparesWholeTexModeState)
+{
+  StateInterner<TexModeState> interner;
+  TexModeState a;
+  a.hex = 0;
+  a.tm1.max_lod = 16;
+  TexModeState b = a;
+  b.tm0.wrap_s = 1;
+
+  EXPECT_NE(interner.GetID(a), interner.GetID(b));
+  EXPECT_EQ(16u, interner.GetState(interner.GetID(b)).tm1.max_lod);
+  EXPECT_EQ(1u, interner.GetState(interner.GetID(b)).tm0.wrap_s);
+}
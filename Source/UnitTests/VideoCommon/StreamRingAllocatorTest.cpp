@@ -0,0 +1,112 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "VideoCommon/StreamRingAllocator.h"
+
+TEST(StreamRingAllocator, AllocatesAfterCurrentOffset)
+{
+  StreamRingAllocator<int> ring(1024);
+  ASSERT_TRUE(ring.TryAllocate(100, 4));
+  EXPECT_EQ(0u, ring.GetCurrentOffset());
+  ring.Commit(98);
+
+  // Offsets other than zero are aligned, including to values which aren't powers of two.
+  ASSERT_TRUE(ring.TryAllocate(100, 12));
+  EXPECT_EQ(108u, ring.GetCurrentOffset());
+  ring.Commit(100);
+  EXPECT_EQ(208u, ring.GetCurrentOffset());
+}
+
+TEST(StreamRingAllocator, WrapsBehindGPU)
+{
+  StreamRingAllocator<int> ring(1024);
+  ASSERT_TRUE(ring.TryAllocate(600, 1));
+  ring.Commit(600);
+  ring.AddFence(1);
+
+  // Nothing is known to be free at the start until the fence is signaled.
+  EXPECT_FALSE(ring.TryAllocate(500, 1));
+  ring.OnFenceSignaled(1);
+  EXPECT_EQ(600u, ring.GetGPUPosition());
+  EXPECT_EQ(0u, ring.GetNumFences());
+
+  EXPECT_FALSE(ring.TryAllocate(500, 1, false));
+  ASSERT_TRUE(ring.TryAllocate(500, 1));
+  EXPECT_EQ(0u, ring.GetCurrentOffset());
+
+  // The writer can't catch up with the GPU position.
+  ring.Commit(500);
+  EXPECT_FALSE(ring.TryAllocate(99, 1));
+  EXPECT_TRUE(ring.TryAllocate(98, 1));
+}
+
+TEST(StreamRingAllocator, WaitsForOldestSufficientFence)
+{
+  StreamRingAllocator<int> ring(1024);
+  for (int i = 1; i <= 4; ++i)
+  {
+    ASSERT_TRUE(ring.TryAllocate(200, 1));
+    ring.Commit(200);
+    EXPECT_TRUE(ring.NeedsFence());
+    ring.AddFence(i);
+    EXPECT_FALSE(ring.NeedsFence());
+  }
+  EXPECT_EQ(800u, ring.GetCurrentOffset());
+  EXPECT_FALSE(ring.TryAllocate(300, 1));
+
+  // Wrapping around needs more than the 200 bytes freed by the first fence.
+  std::vector<int> waited;
+  std::vector<int> released;
+  ASSERT_TRUE(ring.WaitForSpace(300, 1, [&](int fence) { waited.push_back(fence); },
+                                [&](int fence) { released.push_back(fence); }));
+  EXPECT_EQ(std::vector<int>{2}, waited);
+  EXPECT_EQ((std::vector<int>{1, 2}), released);
+  EXPECT_EQ(0u, ring.GetCurrentOffset());
+  EXPECT_EQ(400u, ring.GetGPUPosition());
+  EXPECT_EQ(2u, ring.GetNumFences());
+
+  // Signaling a fence which was already waited for does nothing.
+  ring.OnFenceSignaled(2);
+  EXPECT_EQ(400u, ring.GetGPUPosition());
+}
+
+TEST(StreamRingAllocator, WaitingForLastFenceFreesWholeBuffer)
+{
+  StreamRingAllocator<int> ring(1024);
+  ASSERT_TRUE(ring.TryAllocate(1000, 1));
+  ring.Commit(1000);
+  ring.AddFence(1);
+
+  ASSERT_TRUE(ring.WaitForSpace(1000, 1, [](int) {}, [](int) {}));
+  EXPECT_EQ(0u, ring.GetCurrentOffset());
+  EXPECT_EQ(0u, ring.GetGPUPosition());
+  EXPECT_EQ(0u, ring.GetNumFences());
+
+  // Without any fences, there is nothing to wait for.
+  ring.Commit(10);
+  EXPECT_FALSE(ring.WaitForSpace(1000, 1, [](int) {}, [](int) {}));
+}
+
+TEST(StreamRingAllocator, CountsUnfencedBytes)
+{
+  StreamRingAllocator<int> ring(1024);
+  ASSERT_TRUE(ring.TryAllocate(100, 1));
+  ring.Commit(100);
+  EXPECT_EQ(100u, ring.GetUnfencedBytes());
+  ring.AddFence(1);
+  EXPECT_EQ(0u, ring.GetUnfencedBytes());
+
+  ASSERT_TRUE(ring.TryAllocate(50, 1));
+  ring.Commit(50);
+  EXPECT_EQ(50u, ring.GetUnfencedBytes());
+
+  std::vector<int> released;
+  ring.ReleaseFences([&](int fence) { released.push_back(fence); });
+  EXPECT_EQ(std::vector<int>{1}, released);
+  EXPECT_EQ(0u, ring.GetNumFences());
+}
@@ -0,0 +1,205 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+struct DecoderCase
+{
+  const char* name;
+  TextureFormat format;
+  TLUTFormat tlut_format;
+};
+
+constexpr DecoderCase DECODER_CASES[] = {
+    {"I4", TextureFormat::I4, TLUTFormat::IA8},
+    {"I8", TextureFormat::I8, TLUTFormat::IA8},
+    {"IA4", TextureFormat::IA4, TLUTFormat::IA8},
+    {"IA8", TextureFormat::IA8, TLUTFormat::IA8},
+    {"RGB565", TextureFormat::RGB565, TLUTFormat::IA8},
+    {"RGB5A3", TextureFormat::RGB5A3, TLUTFormat::IA8},
+    {"RGBA8", TextureFormat::RGBA8, TLUTFormat::IA8},
+    {"C4/IA8", TextureFormat::C4, TLUTFormat::IA8},
+    {"C4/RGB565", TextureFormat::C4, TLUTFormat::RGB565},
+    {"C4/RGB5A3", TextureFormat::C4, TLUTFormat::RGB5A3},
+    {"C8/IA8", TextureFormat::C8, TLUTFormat::IA8},
+    {"C8/RGB565", TextureFormat::C8, TLUTFormat::RGB565},
+    {"C8/RGB5A3", TextureFormat::C8, TLUTFormat::RGB5A3},
+    {"C14X2/IA8", TextureFormat::C14X2, TLUTFormat::IA8},
+    {"C14X2/RGB565", TextureFormat::C14X2, TLUTFormat::RGB565},
+    {"C14X2/RGB5A3", TextureFormat::C14X2, TLUTFormat::RGB5A3},
+    {"CMPR", TextureFormat::CMPR, TLUTFormat::IA8},
+};
+
+// The decoders which are picked based on the instruction sets the host supports.
+struct DecoderPath
+{
+  const char* name;
+  bool ssse3;
+  bool avx2;
+};
+
+constexpr DecoderPath DECODER_PATHS[] = {
+    {"SSE2", false, false},
+    {"SSSE3", true, false},
+    {"AVX2", true, true},
+};
+
+constexpr int WIDTH = 256;
+constexpr int HEIGHT = 256;
+// Large enough for the 14-bit indices of C14X2.
+constexpr size_t TLUT_SIZE = 0x4000 * sizeof(u16);
+
+class TextureDecoderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_ssse3 = cpu_info.bSSSE3;
+    m_avx2 = cpu_info.bAVX2;
+
+    std::mt19937 rng(1234);
+    m_src.resize(TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, TextureFormat::RGBA8));
+    for (u8& byte : m_src)
+      byte = static_cast<u8>(rng());
+    m_tlut.resize(TLUT_SIZE);
+    for (u8& byte : m_tlut)
+      byte = static_cast<u8>(rng());
+  }
+
+  void TearDown() override
+  {
+    cpu_info.bSSSE3 = m_ssse3;
+    cpu_info.bAVX2 = m_avx2;
+  }
+
+  // Returns false if the host doesn't support the instruction sets of this path.
+  bool SelectPath(const DecoderPath& path)
+  {
+    if ((path.ssse3 && !m_ssse3) || (path.avx2 && !m_avx2))
+      return false;
+
+    cpu_info.bSSSE3 = path.ssse3;
+    cpu_info.bAVX2 = path.avx2;
+    return true;
+  }
+
+  std::vector<u32> Decode(const DecoderCase& c)
+  {
+    std::vector<u32> dst(WIDTH * HEIGHT);
+    TexDecoder_Decode(reinterpret_cast<u8*>(dst.data()), m_src.data(), WIDTH, HEIGHT, c.format,
+                      m_tlut.data(), c.tlut_format);
+    return dst;
+  }
+
+  std::vector<u32> DecodeTexels(const DecoderCase& c)
+  {
+    std::vector<u32> dst(WIDTH * HEIGHT);
+    for (int t = 0; t < HEIGHT; ++t)
+    {
+      for (int s = 0; s < WIDTH; ++s)
+      {
+        TexDecoder_DecodeTexel(reinterpret_cast<u8*>(&dst[t * WIDTH + s]), m_src.data(), s, t,
+                               WIDTH - 1, c.format, m_tlut.data(), c.tlut_format);
+      }
+    }
+    return dst;
+  }
+
+  std::vector<u8> m_src;
+  std::vector<u8> m_tlut;
+  bool m_ssse3;
+  bool m_avx2;
+};
+}  // Anonymous namespace
+
+TEST_F(TextureDecoderTest, MatchesTexelDecoder)
+{
+  for (const DecoderCase& c : DECODER_CASES)
+  {
+    const std::vector<u32> expected = DecodeTexels(c);
+    for (const DecoderPath& path : DECODER_PATHS)
+    {
+      if (!SelectPath(path))
+        continue;
+
+      SCOPED_TRACE(std::string(c.name) + " " + path.name);
+      const std::vector<u32> decoded = Decode(c);
+      for (size_t i = 0; i < decoded.size(); ++i)
+      {
+        ASSERT_EQ(expected[i], decoded[i]) << "at texel " << i % WIDTH << ", " << i / WIDTH;
+      }
+    }
+  }
+}
+
+TEST_F(TextureDecoderTest, InterleavedTmemRGBA8MatchesTmemDecoder)
+{
+  // Use the two halves of the source data as the TMEM banks.
+  const size_t bank_size = m_src.size() / 2;
+  const u8* src_ar = m_src.data();
+  const u8* src_gb = m_src.data() + bank_size;
+
+  std::vector<u32> expected(WIDTH * HEIGHT);
+  TexDecoder_DecodeRGBA8FromTmem(reinterpret_cast<u8*>(expected.data()), src_ar, src_gb, WIDTH,
+                                 HEIGHT);
+
+  std::vector<u8> interleaved(m_src.size());
+  TexDecoder_InterleaveRGBA8FromTmem(interleaved.data(), src_ar, src_gb, WIDTH, HEIGHT);
+  std::vector<u32> decoded(WIDTH * HEIGHT);
+  TexDecoder_Decode(reinterpret_cast<u8*>(decoded.data()), interleaved.data(), WIDTH, HEIGHT,
+                    TextureFormat::RGBA8, m_tlut.data(), TLUTFormat::IA8);
+  for (size_t i = 0; i < decoded.size(); ++i)
+  {
+    ASSERT_EQ(expected[i], decoded[i]) << "at texel " << i % WIDTH << ", " << i / WIDTH;
+  }
+}
+
+TEST_F(TextureDecoderTest, Throughput)
+{
+  constexpr int ITERATIONS = 200;
+
+  printf("Texture decoding throughput in MB/s of source data:\n");
+  printf("%-14s", "");
+  for (const DecoderPath& path : DECODER_PATHS)
+    printf("%10s", path.name);
+  printf("\n");
+
+  for (const DecoderCase& c : DECODER_CASES)
+  {
+    const double size = TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, c.format);
+    printf("%-14s", c.name);
+    for (const DecoderPath& path : DECODER_PATHS)
+    {
+      if (!SelectPath(path))
+      {
+        printf("%10s", "-");
+        continue;
+      }
+
+      std::vector<u32> dst(WIDTH * HEIGHT);
+      const auto start = std::chrono::high_resolution_clock::now();
+      for (int i = 0; i < ITERATIONS; ++i)
+      {
+        TexDecoder_Decode(reinterpret_cast<u8*>(dst.data()), m_src.data(), WIDTH, HEIGHT, c.format,
+                          m_tlut.data(), c.tlut_format);
+      }
+      const std::chrono::duration<double> elapsed =
+          std::chrono::high_resolution_clock::now() - start;
+      printf("%10.0f", size * ITERATIONS / elapsed.count() / (1024 * 1024));
+    }
+    printf("\n");
+  }
+}
@@ -2,11 +2,16 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <gtest/gtest.h>  // NOLINT
 
@@ -14,9 +19,13 @@
 #include "Common/MathUtil.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexBatchCache.h"
+#include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 
 TEST(VertexLoaderUID, UniqueEnough)
 {
@@ -245,6 +254,167 @@ TEST_F(VertexLoaderTest, PositionIndex16FloatXY)
   ExpectOut(2);
 }
 
+TEST_F(VertexLoaderTest, SoftwareLoaderIndex16Model)
+{
+  // Indexed model vertices, which the software loader has a specialized pipeline for. Its output
+  // has to match the default loader, including skipped vertices.
+  m_vtx_desc.PosMatIdx = 1;
+  m_vtx_desc.Position = INDEX16;
+  m_vtx_desc.Normal = INDEX16;
+  m_vtx_desc.Color0 = INDEX16;
+  m_vtx_desc.Tex0Coord = INDEX16;
+  m_vtx_attr.g0.PosElements = 1;
+  m_vtx_attr.g0.PosFormat = FORMAT_SHORT;
+  m_vtx_attr.g0.PosFrac = 8;
+  m_vtx_attr.g0.NormalFormat = FORMAT_BYTE;
+  m_vtx_attr.g0.Color0Elements = 1;
+  m_vtx_attr.g0.Color0Comp = FORMAT_32B_8888;
+  m_vtx_attr.g0.Tex0CoordElements = 1;
+  m_vtx_attr.g0.Tex0CoordFormat = FORMAT_SHORT;
+  m_vtx_attr.g0.Tex0Frac = 10;
+  CreateAndCheckSizes(9, 40);
+
+  constexpr int NUM_VERTICES = 1000;
+  constexpr int NUM_SKIPPED = NUM_VERTICES / 8;
+  constexpr int NUM_ELEMENTS = 64;
+  for (int i = 0; i < NUM_VERTICES; ++i)
+  {
+    Input<u8>(i & 0x3f);
+    for (int j = 0; j < 4; ++j)
+      Input<u16>(i % 8 == 3 && j == 0 ? 0xFFFF : (i * 5 + j) % NUM_ELEMENTS);
+  }
+  u8* const arrays = m_src.GetPointer();
+  for (int i = 0; i < NUM_ELEMENTS * 16; ++i)
+    Input<u8>(static_cast<u8>(i * 37 + 11));
+  for (int i = 0; i < 12; ++i)
+  {
+    VertexLoaderManager::cached_arraybases[i] = arrays;
+    g_main_cp_state.array_strides[i] = 16;
+  }
+
+  RunVertices(NUM_VERTICES, NUM_VERTICES - NUM_SKIPPED);
+  const int size = (NUM_VERTICES - NUM_SKIPPED) * m_loader->m_native_vtx_decl.stride;
+  std::vector<u8> expected(output_memory, output_memory + size);
+
+  m_loader = std::make_unique<VertexLoader>(m_vtx_desc, m_vtx_attr);
+  memset(output_memory, 0xFF, size);
+  RunVertices(NUM_VERTICES, NUM_VERTICES - NUM_SKIPPED);
+  EXPECT_EQ(0, memcmp(expected.data(), output_memory, size));
+}
+
+TEST_F(VertexLoaderTest, ParallelConversion)
+{
+  constexpr int NUM_VERTICES = 200000;
+  constexpr int NUM_POSITIONS = 1024;
+  constexpr int ROUNDS = 20;
+
+  m_vtx_desc.Position = INDEX16;
+  m_vtx_attr.g0.PosElements = 1;  // XYZ
+  m_vtx_attr.g0.PosFormat = FORMAT_FLOAT;
+  CreateAndCheckSizes(sizeof(u16), 3 * sizeof(float));
+
+  // Skip a few vertices, including the last one before the serially converted tail.
+  for (int i = 0; i < NUM_VERTICES; ++i)
+  {
+    const bool skip = i % 997 == 0 || i == NUM_VERTICES - 4;
+    Input<u16>(skip ? 0xFFFF : i % NUM_POSITIONS);
+  }
+  VertexLoaderManager::cached_arraybases[ARRAY_POSITION] = m_src.GetPointer();
+  g_main_cp_state.array_strides[ARRAY_POSITION] = 3 * sizeof(float);
+  for (int i = 0; i < NUM_POSITIONS * 3; ++i)
+    Input(static_cast<float>(i));
+
+  ResetPointers();
+  const int expected_count = m_loader->RunVertices(m_src, m_dst, NUM_VERTICES);
+  const size_t output_size = expected_count * m_loader->m_native_vtx_decl.stride;
+  float expected_cache[3][4];
+  std::memcpy(expected_cache, VertexLoaderManager::position_cache, sizeof(expected_cache));
+
+  std::vector<u8> output(output_size);
+  printf("Vertex loader throughput:\n");
+  for (u32 threads : {0, 1, 2, 4})
+  {
+    VertexLoaderManager::SetVertexLoaderThreads(threads);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    int count = 0;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+      std::memset(VertexLoaderManager::position_cache, 0, sizeof(expected_cache));
+      DataReader dst(output.data(), output.data() + output.size());
+      count = VertexLoaderManager::ConvertVertices(m_loader.get(), m_src, dst, NUM_VERTICES);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(expected_count, count);
+    EXPECT_EQ(0, std::memcmp(output_memory, output.data(), output_size));
+    EXPECT_EQ(0, std::memcmp(expected_cache, VertexLoaderManager::position_cache,
+                             sizeof(expected_cache)));
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    printf("%u extra threads         %.1f Mvertices/s\n", threads,
+           NUM_VERTICES * ROUNDS / seconds / 1000000.0);
+  }
+  VertexLoaderManager::SetVertexLoaderThreads(0);
+}
+
+TEST_F(VertexLoaderTest, BatchCache)
+{
+  constexpr int NUM_VERTICES = 1000;
+  constexpr int NUM_POSITIONS = 64;
+
+  m_vtx_desc.Position = INDEX16;
+  m_vtx_desc.Color0 = INDEX8;
+  m_vtx_attr.g0.PosElements = 1;  // XYZ
+  m_vtx_attr.g0.PosFormat = FORMAT_FLOAT;
+  m_vtx_attr.g0.Color0Elements = 1;  // Has Alpha
+  m_vtx_attr.g0.Color0Comp = FORMAT_32B_8888;
+  CreateAndCheckSizes(sizeof(u16) + sizeof(u8), 3 * sizeof(float) + sizeof(u32));
+
+  for (int i = 0; i < NUM_VERTICES; ++i)
+  {
+    Input<u16>(i % 5 == 0 ? 0xFFFF : i % NUM_POSITIONS);
+    Input<u8>(i % 7);
+  }
+  u8* positions = m_src.GetPointer();
+  VertexLoaderManager::cached_arraybases[ARRAY_POSITION] = positions;
+  g_main_cp_state.array_strides[ARRAY_POSITION] = 3 * sizeof(float);
+  for (int i = 0; i < NUM_POSITIONS * 3; ++i)
+    Input(static_cast<float>(i));
+  u8* colors = m_src.GetPointer();
+  VertexLoaderManager::cached_arraybases[ARRAY_COLOR] = colors;
+  g_main_cp_state.array_strides[ARRAY_COLOR] = sizeof(u32);
+  for (int i = 0; i < 7; ++i)
+    Input<u32>(0x11223300 | i);
+
+  VertexBatchCache cache;
+  const size_t stride = m_loader->m_native_vtx_decl.stride;
+  std::vector<u8> expected(NUM_VERTICES * stride);
+  std::vector<u8> output(NUM_VERTICES * stride);
+  auto check = [&] {
+    ResetPointers();
+    DataReader expected_dst(expected.data(), expected.data() + expected.size());
+    const int expected_count = m_loader->RunVertices(m_src, expected_dst, NUM_VERTICES);
+
+    std::fill(output.begin(), output.end(), 0);
+    DataReader dst(output.data(), output.data() + output.size());
+    EXPECT_EQ(expected_count, cache.ConvertVertices(m_loader.get(), m_src, dst, NUM_VERTICES));
+    EXPECT_EQ(0, std::memcmp(expected.data(), output.data(), expected_count * stride));
+  };
+
+  // Convert, then hit the cache.
+  check();
+  check();
+
+  // Changing any referenced array element has to invalidate the cached batch.
+  positions[NUM_POSITIONS * 3 * sizeof(float) - 1] ^= 1;
+  check();
+  colors[3] ^= 1;
+  check();
+  g_main_cp_state.array_strides[ARRAY_COLOR] = 0;
+  check();
+}
+
 class VertexLoaderSpeedTest : public VertexLoaderTest,
                               public ::testing::WithParamInterface<std::tuple<int, int>>
 {
@@ -355,3 +525,122 @@ TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
   for (int i = 0; i < 100; ++i)
     RunVertices(100000);
 }
+
+static std::vector<u16> GenerateIndices(bool primitive_restart, int primitive, u32 first_vertex,
+                                        u32 num_vertices)
+{
+  g_Config.backend_info.bSupportsPrimitiveRestart = primitive_restart;
+  IndexGenerator::Init();
+
+  std::vector<u16> indices(4 * num_vertices + 16);
+  IndexGenerator::Start(indices.data());
+  IndexGenerator::AddIndices(OpcodeDecoder::GX_DRAW_POINTS, first_vertex);
+  const u32 skipped = IndexGenerator::GetIndexLen();
+  IndexGenerator::AddIndices(primitive, num_vertices);
+  indices.resize(IndexGenerator::GetIndexLen());
+  indices.erase(indices.begin(), indices.begin() + skipped);
+  return indices;
+}
+
+TEST(IndexGenerator, LongPrimitives)
+{
+  // Long enough for both whole vector runs and a remainder.
+  constexpr u32 NUM_VERTICES = 27;
+  constexpr u32 FIRST = 5;
+  constexpr u16 R = UINT16_MAX;
+
+  std::vector<u16> expected;
+  for (u32 i = 0; i < NUM_VERTICES; ++i)
+    expected.push_back(FIRST + i);
+  expected.push_back(R);
+  EXPECT_EQ(expected,
+            GenerateIndices(true, OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, FIRST, NUM_VERTICES));
+
+  expected.clear();
+  for (u32 i = 2; i < NUM_VERTICES; ++i)
+  {
+    const bool odd = (i % 2) != 0;
+    expected.insert(expected.end(), {static_cast<u16>(FIRST + i - 2),
+                                     static_cast<u16>(FIRST + i - !odd),
+                                     static_cast<u16>(FIRST + i - odd)});
+  }
+  EXPECT_EQ(expected,
+            GenerateIndices(false, OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, FIRST, NUM_VERTICES));
+
+  expected.clear();
+  for (u32 i = 2; i < NUM_VERTICES; ++i)
+  {
+    expected.insert(expected.end(), {static_cast<u16>(FIRST), static_cast<u16>(FIRST + i - 1),
+                                     static_cast<u16>(FIRST + i)});
+  }
+  EXPECT_EQ(expected,
+            GenerateIndices(false, OpcodeDecoder::GX_DRAW_TRIANGLE_FAN, FIRST, NUM_VERTICES));
+
+  // Fans are drawn as strips of three triangles, with a single triangle for the last vertex.
+  expected.clear();
+  for (u32 i = 2; i + 3 <= NUM_VERTICES; i += 3)
+  {
+    expected.insert(expected.end(),
+                    {static_cast<u16>(FIRST + i - 1), static_cast<u16>(FIRST + i),
+                     static_cast<u16>(FIRST), static_cast<u16>(FIRST + i + 1),
+                     static_cast<u16>(FIRST + i + 2), R});
+  }
+  expected.insert(expected.end(), {static_cast<u16>(FIRST), static_cast<u16>(FIRST + 25),
+                                   static_cast<u16>(FIRST + 26), R});
+  EXPECT_EQ(expected,
+            GenerateIndices(true, OpcodeDecoder::GX_DRAW_TRIANGLE_FAN, FIRST, NUM_VERTICES));
+
+  // The three vertices left over after the quads make a triangle.
+  expected.clear();
+  for (u32 i = 0; i + 4 <= NUM_VERTICES; i += 4)
+  {
+    expected.insert(expected.end(),
+                    {static_cast<u16>(FIRST + i + 1), static_cast<u16>(FIRST + i + 2),
+                     static_cast<u16>(FIRST + i), static_cast<u16>(FIRST + i + 3), R});
+  }
+  expected.insert(expected.end(), {static_cast<u16>(FIRST + 24), static_cast<u16>(FIRST + 25),
+                                   static_cast<u16>(FIRST + 26), R});
+  EXPECT_EQ(expected, GenerateIndices(true, OpcodeDecoder::GX_DRAW_QUADS, FIRST, NUM_VERTICES));
+
+  expected.clear();
+  for (u32 i = 1; i < NUM_VERTICES; ++i)
+    expected.insert(expected.end(), {static_cast<u16>(FIRST + i - 1), static_cast<u16>(FIRST + i)});
+  EXPECT_EQ(expected,
+            GenerateIndices(false, OpcodeDecoder::GX_DRAW_LINE_STRIP, FIRST, NUM_VERTICES));
+}
+
+TEST(IndexGenerator, Speed)
+{
+  static const char* const primitive_names[] = {"quads",     "quads_2",     "triangles",
+                                                "tri_strip", "tri_fan",     "lines",
+                                                "line_strip", "points"};
+  // Batches of 64 vertex primitives, as large strips and fans are what this is about.
+  constexpr u32 PRIMITIVE_SIZE = 64;
+  constexpr u32 NUM_BATCHES = 2000;
+  std::vector<u16> indices(4 * 65536);
+
+  for (bool primitive_restart : {false, true})
+  {
+    g_Config.backend_info.bSupportsPrimitiveRestart = primitive_restart;
+    IndexGenerator::Init();
+    for (int primitive = 0; primitive < 8; ++primitive)
+    {
+      // Only differs by logging a warning.
+      if (primitive == OpcodeDecoder::GX_DRAW_QUADS_2)
+        continue;
+
+      u64 num_indices = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (u32 batch = 0; batch < NUM_BATCHES; ++batch)
+      {
+        IndexGenerator::Start(indices.data());
+        while (IndexGenerator::GetRemainingIndices() >= PRIMITIVE_SIZE)
+          IndexGenerator::AddIndices(primitive, PRIMITIVE_SIZE);
+        num_indices += IndexGenerator::GetIndexLen();
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      printf("%-10s primitive restart: %d, %.0f M indices/s\n", primitive_names[primitive],
+             primitive_restart, num_indices / elapsed.count() / 1e6);
+    }
+  }
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+
+# Converts a binary trace written by Dolphin (Core/WriteTrace = True in Dolphin.ini, which writes
+# Logs/dolphin.trace) into the Trace Event JSON format, which can be opened in chrome://tracing
+# or https://ui.perfetto.dev.
+#
+# $ python3 Tools/trace-to-json.py ~/.local/share/dolphin-emu/Logs/dolphin.trace > trace.json
+#
+# The format is described in Source/Core/Common/Logging/Trace.cpp, and the events in Trace.h.
+
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x43525444
+TRACE_VERSION = 1
+
+CHUNK_RECORDS = 0
+CHUNK_NAME = 1
+
+RECORD = struct.Struct("<QQIHH")
+
+# Event ID: (name, category, phase), where the phase is "B" or "E" for the beginning or the end
+# of a duration and "i" for an instant event.
+EVENTS = {
+    0: ("CoreTiming", "CoreTiming", "B"),
+    1: ("CoreTiming", "CoreTiming", "E"),
+    2: ("MMIO read", "MMIO", "i"),
+    3: ("MMIO write", "MMIO", "i"),
+    4: ("IPC request", "IOS", "B"),
+    5: ("IPC request", "IOS", "E"),
+    6: ("IPC reply", "IOS", "i"),
+    7: ("DVD request", "DVD", "i"),
+    8: ("DVD read", "DVD", "B"),
+    9: ("DVD read", "DVD", "E"),
+    10: ("FIFO command", "FIFO", "i"),
+}
+
+CORETIMING_BEGIN = 0
+
+
+def read_trace(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    magic, version = struct.unpack_from("<II", data, 0)
+    if magic != TRACE_MAGIC:
+        sys.exit("%s is not a Dolphin trace" % path)
+    if version != TRACE_VERSION:
+        sys.exit("Unsupported trace version %d" % version)
+
+    records = []
+    names = {}
+    offset = 8
+    while offset + 8 <= len(data):
+        chunk_type, size = struct.unpack_from("<II", data, offset)
+        offset += 8
+        if chunk_type == CHUNK_RECORDS:
+            for i in range(size):
+                records.append(RECORD.unpack_from(data, offset + i * RECORD.size))
+            offset += size * RECORD.size
+        elif chunk_type == CHUNK_NAME:
+            event, name_id = struct.unpack_from("<II", data, offset)
+            offset += 8
+            names[(event, name_id)] = data[offset:offset + size].decode("utf-8", "replace")
+            offset += size
+        else:
+            sys.exit("Unknown chunk type %d at offset %d" % (chunk_type, offset - 8))
+
+    # Every thread writes its records in order, but the chunks of different threads are mixed.
+    records.sort(key=lambda record: record[0])
+    return records, names
+
+
+def format_args(event, arg0, arg1):
+    if event in (0, 1):
+        return {"userdata": hex(arg0)}
+    if event in (2, 3):
+        return {"address": "0x%08x" % arg0, "value": "0x%x" % arg1}
+    if event in (4, 5):
+        return {"request": "0x%08x" % arg0, "command": arg1}
+    if event == 6:
+        return {"request": "0x%08x" % arg0}
+    if event in (7, 8, 9):
+        return {"offset": "0x%x" % arg0, "length": "0x%x" % arg1}
+    if event == 10:
+        return {"opcode": "0x%02x" % arg0, "display_list": bool(arg1)}
+    return {"arg0": arg0, "arg1": arg1}
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("Usage: %s <trace file>" % sys.argv[0])
+
+    records, names = read_trace(sys.argv[1])
+
+    events = []
+    for time_ns, arg0, arg1, event, thread in records:
+        name, category, phase = EVENTS.get(event, ("Unknown event %d" % event, "Unknown", "i"))
+        if category == "CoreTiming":
+            name = names.get((CORETIMING_BEGIN, arg1), "CoreTiming event %d" % arg1)
+        trace_event = {
+            "name": name,
+            "cat": category,
+            "ph": phase,
+            "ts": time_ns / 1000.0,
+            "pid": 0,
+            "tid": thread,
+            "args": format_args(event, arg0, arg1),
+        }
+        if phase == "i":
+            trace_event["s"] = "t"
+        events.append(trace_event)
+
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()